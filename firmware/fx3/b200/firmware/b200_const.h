@@ -14,7 +14,7 @@
 #include "cyu3usbconst.h"
 
 #define FX3_COMPAT_MAJOR            (uint8_t)(8)
-#define FX3_COMPAT_MINOR            (uint8_t)(0)
+#define FX3_COMPAT_MINOR            (uint8_t)(1)
 
 /* GPIO Pins */
 #define GPIO_FPGA_RESET             (uint32_t)(26)  // CTL[9]
@@ -48,6 +48,14 @@
 #define USB2_PACKETS_PER_BURST          (1)
 #define DMA_SIZE_INFINITE               (0)
 
+/* Limits of the data DMA buffers that the host can ask for. Both directions
+ * get the same buffers, and they have to fit next to everything else in the
+ * DMA buffer memory. */
+#define DATA_DMA_MIN_BUFFER_SIZE        (1024)
+#define DATA_DMA_MAX_BUFFER_SIZE        (32768)
+#define DATA_DMA_MAX_BUFFER_COUNT       (8)
+#define DATA_DMA_MAX_TOTAL_SIZE         (128*1024)
+
 #define APP_THREAD_STACK_SIZE           (0x0800)
 #define THREAD_PRIORITY                 (8)
 
@@ -70,6 +78,7 @@
 #define B200_VREQ_WRITE_SB              (uint8_t)(0x29)
 #define B200_VREQ_SET_SB_BAUD_DIV       (uint8_t)(0x30)
 #define B200_VREQ_FLUSH_DATA_EPS        (uint8_t)(0x31)
+#define B200_VREQ_SET_DATA_DMA          (uint8_t)(0x32)
 #define B200_VREQ_FPGA_CONFIG           (uint8_t)(0x55)
 #define B200_VREQ_TOGGLE_FPGA_RESET     (uint8_t)(0x62)
 #define B200_VREQ_TOGGLE_GPIF_RESET     (uint8_t)(0x72)
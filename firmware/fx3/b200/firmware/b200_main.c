@@ -257,6 +257,7 @@ static CONFIG g_config = {
     434*2   // sb_baud_div
 };
 static CONFIG_MOD g_config_mod;
+static CyBool_t g_data_dma_reconfig = CyFalse; // Reported as busy until the DMA channels are rebuilt
 
 #define REG_LNK_PHY_ERROR_STATUS 0xE0033044
 
@@ -1999,8 +2000,31 @@ CyBool_t usb_setup_callback(uint32_t data0, uint32_t data1) {
                 break;
             }
 
+            case B200_VREQ_SET_DATA_DMA: {
+                CyU3PUsbGetEP0Data(g_vendor_req_buff_size, g_vendor_req_buffer, \
+                        &read_count);
+
+                // wValue: buffer size in KB, wIndex: buffer count
+                const int size = ((int)wValue) * 1024;
+                const int count = wIndex;
+                if ((size < DATA_DMA_MIN_BUFFER_SIZE) || (size > DATA_DMA_MAX_BUFFER_SIZE) ||
+                    (count < 1) || (count > DATA_DMA_MAX_BUFFER_COUNT) ||
+                    (2 * size * count > DATA_DMA_MAX_TOTAL_SIZE)) {
+                    msg("! Invalid data DMA config: %d x %d", count, size);
+                    break;
+                }
+
+                // Rebuilt by the re-config thread, like B200_VREQ_SET_CONFIG
+                g_config_mod.flags = CF_DMA_BUFFER_SIZE | CF_DMA_BUFFER_COUNT;
+                g_config_mod.config.dma_buffer_size = size;
+                g_config_mod.config.dma_buffer_count = count;
+                g_data_dma_reconfig = CyTrue;
+                CyU3PEventSet(&g_event_usb_config, EVENT_RE_ENUM, CYU3P_EVENT_OR);
+                break;
+            }
+
             case B200_VREQ_GET_STATUS: {
-                g_vendor_req_buffer[0] = g_fx3_state;
+                g_vendor_req_buffer[0] = (g_data_dma_reconfig ? STATE_BUSY : g_fx3_state);
                 CyU3PUsbSendEP0Data(1, g_vendor_req_buffer);
                 break;
             }
@@ -2783,6 +2807,8 @@ void thread_re_enum_entry(uint32_t input) {
                         msg("! Failed to bring link up");
                 }
 
+                g_data_dma_reconfig = CyFalse;
+
                 counters_reset_usb_errors();
         }
         else {
@@ -127,6 +127,37 @@ static void handle_udp_data_packet(
     setup_framer(eth_mac_dst, *ethernet_mac_addr(), dst_addr, src_addr, which);
 }
 
+/*
+ * Run one register action. Returns the peeked data,
+ * or the poked data for pokes.
+ */
+static uint32_t handle_reg_action(uint32_t action, uint32_t addr, uint32_t data){
+    switch(action){
+        case USRP2_REG_ACTION_FPGA_PEEK32:
+            return *((uint32_t *) addr);
+
+        case USRP2_REG_ACTION_FPGA_PEEK16:
+            return *((uint16_t *) addr);
+
+        case USRP2_REG_ACTION_FPGA_POKE32:
+            *((uint32_t *) addr) = (uint32_t)data;
+            break;
+
+        case USRP2_REG_ACTION_FPGA_POKE16:
+            *((uint16_t *) addr) = (uint16_t)data;
+            break;
+
+        case USRP2_REG_ACTION_FW_PEEK32:
+            return fw_regs[addr];
+
+        case USRP2_REG_ACTION_FW_POKE32:
+            fw_regs[addr] = data;
+            break;
+
+    }
+    return data;
+}
+
 #define OTW_GPIO_BANK_TO_NUM(bank) \
     (((bank) == USRP2_DIR_RX)? (GPIO_RX_BANK) : (GPIO_TX_BANK))
 
@@ -222,35 +253,32 @@ static void handle_udp_ctrl_packet(
      * Peek and Poke Register
      ******************************************************************/
     case USRP2_CTRL_ID_GET_THIS_REGISTER_FOR_ME_BRO:
-        switch(ctrl_data_in->data.reg_args.action){
-            case USRP2_REG_ACTION_FPGA_PEEK32:
-                ctrl_data_out.data.reg_args.data = *((uint32_t *) ctrl_data_in->data.reg_args.addr);
-                break;
-
-            case USRP2_REG_ACTION_FPGA_PEEK16:
-                ctrl_data_out.data.reg_args.data = *((uint16_t *) ctrl_data_in->data.reg_args.addr);
-                break;
-
-            case USRP2_REG_ACTION_FPGA_POKE32:
-                *((uint32_t *) ctrl_data_in->data.reg_args.addr) = (uint32_t)ctrl_data_in->data.reg_args.data;
-                break;
-
-            case USRP2_REG_ACTION_FPGA_POKE16:
-                *((uint16_t *) ctrl_data_in->data.reg_args.addr) = (uint16_t)ctrl_data_in->data.reg_args.data;
-                break;
-
-            case USRP2_REG_ACTION_FW_PEEK32:
-                ctrl_data_out.data.reg_args.data = fw_regs[(ctrl_data_in->data.reg_args.addr)];
-                break;
-
-            case USRP2_REG_ACTION_FW_POKE32:
-                fw_regs[(ctrl_data_in->data.reg_args.addr)] = ctrl_data_in->data.reg_args.data;
-                break;
-
-        }
+        ctrl_data_out.data.reg_args.data = handle_reg_action(
+            ctrl_data_in->data.reg_args.action,
+            ctrl_data_in->data.reg_args.addr,
+            ctrl_data_in->data.reg_args.data
+        );
         ctrl_data_out.id = USRP2_CTRL_ID_OMG_GOT_REGISTER_SO_BAD_DUDE;
         break;
 
+    case USRP2_CTRL_ID_GET_THESE_REGISTERS_FOR_ME_BRO:{
+        static uint32_t reply[(sizeof(usrp2_ctrl_data_t) + USRP2_CTRL_MAX_REG_OPS*sizeof(usrp2_reg_op_t))/sizeof(uint32_t)];
+        const uint32_t num_ops = ctrl_data_in->data.multi_reg_args.num_ops;
+        const size_t reply_len = sizeof(usrp2_ctrl_data_t) + num_ops*sizeof(usrp2_reg_op_t);
+        if (num_ops > USRP2_CTRL_MAX_REG_OPS || payload_len < reply_len) break;
+
+        const usrp2_reg_op_t *ops_in = (const usrp2_reg_op_t *)(ctrl_data_in + 1);
+        usrp2_reg_op_t *ops_out = (usrp2_reg_op_t *)((usrp2_ctrl_data_t *)reply + 1);
+        for (uint32_t i = 0; i < num_ops; i++){
+            ops_out[i] = ops_in[i];
+            ops_out[i].data = handle_reg_action(ops_in[i].action, ops_in[i].addr, ops_in[i].data);
+        }
+        ctrl_data_out.id = USRP2_CTRL_ID_OMG_GOT_REGISTERS_SO_BAD_DUDE;
+        memcpy(reply, &ctrl_data_out, sizeof(ctrl_data_out));
+        send_udp_pkt(USRP2_UDP_CTRL_PORT, src, reply, reply_len);
+        return;
+    }
+
     /*******************************************************************
      * Echo test
      ******************************************************************/
@@ -99,7 +99,8 @@ void u3_net_stack_send_icmp_pkt(
 
 //------------------ entry point ------------------------------------
 
-void u3_net_stack_handle_one(void);
+//! Handle one received packet, return false if there was none
+bool u3_net_stack_handle_one(void);
 
 //------------------ arp handling ------------------------------------
 
@@ -108,6 +109,10 @@ void u3_net_stack_send_arp_request(const uint8_t ethno, const struct ip_addr *ad
 //commented out to make private - do we need cache update outside this module?
 //void u3_net_stack_arp_cache_update(const struct ip_addr *ip_addr, const eth_mac_addr_t *mac_addr, const uint8_t ethno);
 
+//! Look up the mac address of an ip address, NULL if unknown or expired
 const eth_mac_addr_t *u3_net_stack_arp_cache_lookup(const struct ip_addr *ip_addr);
 
+//! Age the arp cache, call this once per second
+void u3_net_stack_arp_cache_tick(void);
+
 #endif /* INCLUDED_U3_NET_STACK_H */
@@ -63,31 +63,88 @@ static uint32_t chksum_buffer(
 
 /***********************************************************************
  * ARP Cache implementation
+ * The cache is a hash table indexed by the IP address. An address can live
+ * in any of ARP_CACHE_NPROBES slots after its hash slot. An update takes the
+ * slot of the address, or else a free or expired slot, or else the oldest
+ * slot. Entries expire ARP_CACHE_MAX_AGE seconds after their last update.
  **********************************************************************/
-#define ARP_CACHE_NENTRIES 32
+#define ARP_CACHE_NENTRIES 64 //power of 2
+#define ARP_CACHE_NPROBES 4
+#define ARP_CACHE_MAX_AGE 300 //seconds
 
-static size_t arp_cache_wr_index;
+typedef struct
+{
+    struct ip_addr ip;
+    eth_mac_addr_t mac;
+    uint8_t ethno;
+    bool valid;
+    uint32_t time;
+} arp_cache_entry_t;
+
+static arp_cache_entry_t arp_cache[ARP_CACHE_NENTRIES];
+
+//seconds since boot, see u3_net_stack_arp_cache_tick
+static uint32_t arp_cache_time;
+
+void u3_net_stack_arp_cache_tick(void)
+{
+    arp_cache_time++;
+}
+
+static size_t arp_cache_hash(const struct ip_addr *ip_addr)
+{
+    uint32_t h;
+    memcpy(&h, ip_addr, sizeof(h));
+    h ^= h >> 16;
+    h ^= h >> 8;
+    return h & (ARP_CACHE_NENTRIES-1);
+}
 
-static struct ip_addr arp_cache_ips[ARP_CACHE_NENTRIES];
-static eth_mac_addr_t arp_cache_macs[ARP_CACHE_NENTRIES];
-static uint8_t arp_cache_eths[ARP_CACHE_NENTRIES];
+static bool arp_cache_entry_live(const arp_cache_entry_t *entry)
+{
+    return entry->valid && arp_cache_time - entry->time < ARP_CACHE_MAX_AGE;
+}
+
+static arp_cache_entry_t *arp_cache_find(const struct ip_addr *ip_addr)
+{
+    const size_t hash = arp_cache_hash(ip_addr);
+    for (size_t i = 0; i < ARP_CACHE_NPROBES; i++)
+    {
+        arp_cache_entry_t *entry = &arp_cache[(hash + i) & (ARP_CACHE_NENTRIES-1)];
+        if (entry->valid && memcmp(ip_addr, &entry->ip, sizeof(struct ip_addr)) == 0)
+        {
+            return entry;
+        }
+    }
+    return NULL;
+}
 
 void u3_net_stack_arp_cache_update(const struct ip_addr *ip_addr, const eth_mac_addr_t *mac_addr, const uint8_t ethno)
 {
-    for (size_t i = 0; i < ARP_CACHE_NENTRIES; i++)
+    arp_cache_entry_t *entry = arp_cache_find(ip_addr);
+    if (entry == NULL)
     {
-        if (memcmp(ip_addr, arp_cache_ips+i, sizeof(struct ip_addr)) == 0)
+        //take the first dead slot, or else evict the oldest one
+        const size_t hash = arp_cache_hash(ip_addr);
+        for (size_t i = 0; i < ARP_CACHE_NPROBES; i++)
         {
-            memcpy(arp_cache_macs+i, mac_addr, sizeof(eth_mac_addr_t));
-            arp_cache_eths[i] = ethno;
-            return;
+            arp_cache_entry_t *slot = &arp_cache[(hash + i) & (ARP_CACHE_NENTRIES-1)];
+            if (!arp_cache_entry_live(slot))
+            {
+                entry = slot;
+                break;
+            }
+            if (entry == NULL || arp_cache_time - slot->time > arp_cache_time - entry->time)
+            {
+                entry = slot;
+            }
         }
+        memcpy(&entry->ip, ip_addr, sizeof(struct ip_addr));
     }
-    if (arp_cache_wr_index >= ARP_CACHE_NENTRIES) arp_cache_wr_index = 0;
-    memcpy(arp_cache_ips+arp_cache_wr_index, ip_addr, sizeof(struct ip_addr));
-    memcpy(arp_cache_macs+arp_cache_wr_index, mac_addr, sizeof(eth_mac_addr_t));
-    arp_cache_eths[arp_cache_wr_index] = ethno;
-    arp_cache_wr_index++;
+    memcpy(&entry->mac, mac_addr, sizeof(eth_mac_addr_t));
+    entry->ethno = ethno;
+    entry->valid = true;
+    entry->time = arp_cache_time;
 }
 
 const eth_mac_addr_t *u3_net_stack_arp_cache_lookup(const struct ip_addr *ip_addr)
@@ -101,12 +158,10 @@ const eth_mac_addr_t *u3_net_stack_arp_cache_lookup(const struct ip_addr *ip_add
         }
     }
     //now check the arp cache
-    for (size_t i = 0; i < ARP_CACHE_NENTRIES; i++)
+    const arp_cache_entry_t *entry = arp_cache_find(ip_addr);
+    if (entry != NULL && arp_cache_entry_live(entry))
     {
-        if (memcmp(ip_addr, arp_cache_ips+i, sizeof(struct ip_addr)) == 0)
-        {
-            return &arp_cache_macs[i];
-        }
+        return &entry->mac;
     }
     return NULL;
 }
@@ -231,6 +286,28 @@ static void send_eth_pkt(
     wb_pkt_iface64_tx_submit(pkt_iface_config, l0 + l1 + l2);
 }
 
+/***********************************************************************
+ * Address classification
+ **********************************************************************/
+static bool is_our_ip(const void *ip_addr)
+{
+    for (size_t e = 0; e < MAX_NETHS; e++)
+    {
+        if (memcmp(ip_addr, u3_net_stack_get_ip_addr(e), sizeof(struct ip_addr)) == 0) return true;
+    }
+    return false;
+}
+
+static bool is_our_ip_or_bcast(const struct ip_addr *ip_addr)
+{
+    if (ip_addr->addr == 0xffffffff) return true;
+    for (size_t e = 0; e < MAX_NETHS; e++)
+    {
+        if (memcmp(ip_addr, u3_net_stack_get_bcast(e), sizeof(struct ip_addr)) == 0) return true;
+    }
+    return is_our_ip(ip_addr);
+}
+
 /***********************************************************************
  * ARP handlers
  **********************************************************************/
@@ -288,8 +365,8 @@ static void handle_arp_packet(const uint8_t ethno, const struct arp_eth_ipv4 *p)
       || p->ar_pln != sizeof(struct ip_addr))
     return;
 
-    //got an arp reply -- injest it into the arp cache
-    if (p->ar_op == ARPOP_REPLY)
+    //got an arp reply to one of our requests -- injest it into the arp cache
+    if (p->ar_op == ARPOP_REPLY && is_our_ip(p->ar_tip))
     {
         UHD_FW_TRACE(DEBUG, "ARPOP_REPLY");
         struct ip_addr ip_addr;
@@ -332,6 +409,15 @@ void u3_net_stack_register_udp_handler(
     }
 }
 
+static int find_udp_handler(const uint16_t port)
+{
+    for (size_t i = 0; i < udp_handlers_index; i++)
+    {
+        if (udp_handler_ports[i] == port) return i;
+    }
+    return -1;
+}
+
 void u3_net_stack_send_udp_pkt(
     const uint8_t ethno,
     const struct ip_addr *dst,
@@ -384,17 +470,15 @@ static void handle_udp_packet(
     const struct udp_hdr *udp,
     const size_t num_bytes
 ){
-    for (size_t i = 0; i < udp_handlers_index; i++)
+    const int i = find_udp_handler(udp->dest);
+    if (i >= 0)
     {
-        if (udp_handler_ports[i] == udp->dest)
-        {
-            udp_handlers[i](
-                ethno, src, u3_net_stack_get_ip_addr(ethno), udp->src, udp->dest,
-                ((const uint8_t *)udp) + sizeof(struct udp_hdr),
-                num_bytes - UDP_HLEN
-            );
-            return;
-        }
+        udp_handlers[i](
+            ethno, src, u3_net_stack_get_ip_addr(ethno), udp->src, udp->dest,
+            ((const uint8_t *)udp) + sizeof(struct udp_hdr),
+            num_bytes - UDP_HLEN
+        );
+        return;
     }
     UHD_FW_TRACE_FSTR(ERROR, "Unhandled UDP packet src=%u, dest=%u", udp->src, udp->dest);
     //TODO send destination unreachable
@@ -457,16 +541,13 @@ static void handle_icmp_dur_packet(
     struct ip_hdr *ip = (struct ip_hdr *)buff;
     struct udp_hdr *udp = (struct udp_hdr *)(((char *)ip) + IP_HLEN);
     if (IPH_PROTO(ip) != IP_PROTO_UDP) return;
-    for (size_t i = 0; i < udp_handlers_index; i++)
+    const int i = find_udp_handler(udp->src);
+    if (i >= 0)
     {
-        if (udp_handler_ports[i] == udp->src)
-        {
-            udp_handlers[i](ethno,
-                src, u3_net_stack_get_ip_addr(ethno),
-                udp->src, udp->dest, NULL, 0
-            );
-            return;
-        }
+        udp_handlers[i](ethno,
+            src, u3_net_stack_get_ip_addr(ethno),
+            udp->src, udp->dest, NULL, 0
+        );
     }
 }
 
@@ -535,13 +616,8 @@ static void handle_eth_packet(const void *buff, const size_t num_bytes)
     const uint8_t *eth_body = ((const uint8_t *)buff) + sizeof(padded_eth_hdr_t);
     UHD_FW_TRACE_FSTR(DEBUG, "handle_eth_packet got ethertype 0x%x", (unsigned)eth_hdr->ethertype);
 
-    if (eth_hdr->ethertype == ETHERTYPE_ARP)
-    {
-        UHD_FW_TRACE(DEBUG, "eth_hdr->ethertype == ETHERTYPE_ARP");
-        const struct arp_eth_ipv4 *arp = (const struct arp_eth_ipv4 *)eth_body;
-        handle_arp_packet(eth_hdr->ethno, arp);
-    }
-    else if (eth_hdr->ethertype == ETHERTYPE_IPV4)
+    //check for IPv4 first, the control and discovery packets are IPv4
+    if (eth_hdr->ethertype == ETHERTYPE_IPV4)
     {
         UHD_FW_TRACE(DEBUG, "eth_hdr->ethertype == ETHERTYPE_IPV4");
         const struct ip_hdr *ip = (const struct ip_hdr *)eth_body;
@@ -549,22 +625,27 @@ static void handle_eth_packet(const void *buff, const size_t num_bytes)
 
         if (IPH_V(ip) != 4 || IPH_HL(ip) != 5) return;// ignore pkts w/ bad version or options
         if (IPH_OFFSET(ip) & (IP_MF | IP_OFFMASK)) return;// ignore fragmented packets
-
-        //TODO -- only handle when the mac is bcast or IP is for us
-
-        u3_net_stack_arp_cache_update(&ip->src, &eth_hdr->src, eth_hdr->ethno);
+        if (!is_our_ip_or_bcast(&ip->dest)) return;// ignore pkts for other hosts
 
         if (IPH_PROTO(ip) == IP_PROTO_UDP)
         {
+            const struct udp_hdr *udp = (const struct udp_hdr *)ip_body;
+            //only learn hosts that talk to our handlers, so that the broadcasts
+            //on a busy network do not churn the arp cache
+            if (find_udp_handler(udp->dest) >= 0)
+            {
+                u3_net_stack_arp_cache_update(&ip->src, &eth_hdr->src, eth_hdr->ethno);
+            }
             handle_udp_packet(
                 eth_hdr->ethno, &ip->src, &ip->dest,
-                (const struct udp_hdr *)ip_body,
+                udp,
                 IPH_LEN(ip) - IP_HLEN
             );
         }
 
         if (IPH_PROTO(ip) == IP_PROTO_ICMP)
         {
+            u3_net_stack_arp_cache_update(&ip->src, &eth_hdr->src, eth_hdr->ethno);
             handle_icmp_packet(
                 eth_hdr->ethno, &ip->src, &ip->dest,
                 (const struct icmp_echo_hdr *)ip_body,
@@ -572,18 +653,24 @@ static void handle_eth_packet(const void *buff, const size_t num_bytes)
             );
         }
     }
+    else if (eth_hdr->ethertype == ETHERTYPE_ARP)
+    {
+        UHD_FW_TRACE(DEBUG, "eth_hdr->ethertype == ETHERTYPE_ARP");
+        const struct arp_eth_ipv4 *arp = (const struct arp_eth_ipv4 *)eth_body;
+        handle_arp_packet(eth_hdr->ethno, arp);
+    }
     else return;    // Not ARP or IPV4, ignore
 }
 
-void u3_net_stack_handle_one(void)
+bool u3_net_stack_handle_one(void)
 {
     size_t num_bytes = 0;
     const void *ptr = wb_pkt_iface64_rx_try_claim(pkt_iface_config, &num_bytes);
-    if (ptr != NULL)
-    {
-        UHD_FW_TRACE_FSTR(DEBUG, "u3_net_stack_handle_one got %u bytes", (unsigned)num_bytes);
-        incr_stat_counts(ptr);
-        handle_eth_packet(ptr, num_bytes);
-        wb_pkt_iface64_rx_release(pkt_iface_config);
-    }
+    if (ptr == NULL) return false;
+
+    UHD_FW_TRACE_FSTR(DEBUG, "u3_net_stack_handle_one got %u bytes", (unsigned)num_bytes);
+    incr_stat_counts(ptr);
+    handle_eth_packet(ptr, num_bytes);
+    wb_pkt_iface64_rx_release(pkt_iface_config);
+    return true;
 }
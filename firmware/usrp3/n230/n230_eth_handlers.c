@@ -103,6 +103,10 @@ void program_udp_framer(
     const uint16_t src_port)
 {
     const eth_mac_addr_t *dst_mac = u3_net_stack_arp_cache_lookup(dst_ip);
+    if (dst_mac == NULL) {
+        UHD_FW_TRACE(WARN, "program_udp_framer arp_cache_lookup fail");
+        return;
+    }
     const size_t vdest = (sid >> 16) & 0xff;
 
     uint32_t framer_base =
@@ -89,6 +89,29 @@ bool process_fw_comm_protocol_pkt(
                 UHD_FW_TRACE_FSTR(DEBUG, "fw_comm_protocol::block_peek32(0x%x,%d)",request->addr,response->data_words);
             } break;
 
+            case FW_COMM_CMD_MULTI_POKE32: {
+                if (request->data_words > FW_COMM_MAX_DATA_WORDS ||
+                    (request->data_words % 2) != 0) {
+                    response->flags |= FW_COMM_ERR_SIZE_ERROR;
+                    break;
+                }
+                UHD_FW_TRACE_FSTR(DEBUG, "fw_comm_protocol::multi_poke32(%d)",request->data_words/2);
+                for (uint32_t i = 0; i < request->data_words; i += 2) {
+                    poke_callback(request->data[i], request->data[i+1]);
+                }
+            } break;
+
+            case FW_COMM_CMD_MULTI_PEEK32: {
+                if (request->data_words > FW_COMM_MAX_DATA_WORDS) {
+                    response->flags |= FW_COMM_ERR_SIZE_ERROR;
+                    break;
+                }
+                for (uint32_t i = 0; i < request->data_words; i++) {
+                    response->data[i] = peek_callback(request->data[i]);
+                }
+                UHD_FW_TRACE_FSTR(DEBUG, "fw_comm_protocol::multi_peek32(%d)",request->data_words);
+            } break;
+
             default: {
                 UHD_FW_TRACE(ERROR, "fw_comm_protocol got an invalid command.");
                 response->flags |= FW_COMM_ERR_CMD_ERROR;
@@ -70,6 +70,7 @@ int main(void)
                 UHD_FW_TRACE_FSTR(INFO, "0.1Hz Heartbeat (%u)", heart_beat);
             }
             heart_beat++;
+            u3_net_stack_arp_cache_tick();
         }
 
         if (cron_job_run_due(PER_MILLISEC_CRON_JOBID)) {
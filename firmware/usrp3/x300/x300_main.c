@@ -30,6 +30,11 @@ void program_udp_framer(
 )
 {
     const eth_mac_addr_t *dst_mac = u3_net_stack_arp_cache_lookup(dst_ip);
+    if (dst_mac == NULL)
+    {
+        UHD_FW_TRACE(WARN, "program_udp_framer arp_cache_lookup fail");
+        return;
+    }
     const size_t ethbase = (ethno == 0)? SR_ETHINT0 : SR_ETHINT1;
     const size_t vdest = (sid >> 16) & 0xff;
     UHD_FW_TRACE_FSTR(INFO, "handle_udp_prog_framer sid %u vdest %u\n", sid, vdest);
@@ -78,6 +83,66 @@ void handle_udp_prog_framer(
 /***********************************************************************
  * Handler for peek and poke host packets
  **********************************************************************/
+static void handle_fw_comms_op(
+    const uint32_t flags, const uint32_t addr, const uint32_t data, uint32_t *reply_data
+)
+{
+    if (flags & X300_FW_COMMS_FLAGS_PEEK32)
+    {
+        if (addr & 0x00100000) {
+            chinch_peek32(addr & 0x000FFFFF, reply_data);
+        } else {
+            *reply_data = wb_peek32(addr);
+        }
+    }
+    if (flags & X300_FW_COMMS_FLAGS_POKE32)
+    {
+        if (addr & 0x00100000) {
+            chinch_poke32(addr & 0x000FFFFF, data);
+        } else {
+            wb_poke32(addr, data);
+        }
+    }
+}
+
+static void handle_fw_comms_multi(
+    const uint8_t ethno,
+    const struct ip_addr *src,
+    const uint16_t src_port, const uint16_t dst_port,
+    const void *buff, const size_t num_bytes
+)
+{
+    static uint32_t reply[(sizeof(x300_fw_comms_t) + X300_FW_COMMS_MAX_OPS*sizeof(x300_fw_comms_op_t))/sizeof(uint32_t)];
+    const x300_fw_comms_t *request = (const x300_fw_comms_t *)buff;
+    const x300_fw_comms_op_t *request_ops = (const x300_fw_comms_op_t *)(request + 1);
+    x300_fw_comms_t *reply_hdr = (x300_fw_comms_t *)reply;
+    x300_fw_comms_op_t *reply_ops = (x300_fw_comms_op_t *)(reply_hdr + 1);
+    const uint32_t num_ops = request->addr;
+    size_t reply_bytes = sizeof(x300_fw_comms_t);
+
+    memcpy(reply_hdr, request, sizeof(x300_fw_comms_t));
+
+    //check for error and set error flag
+    if (num_ops > X300_FW_COMMS_MAX_OPS ||
+        num_bytes < sizeof(x300_fw_comms_t) + num_ops*sizeof(x300_fw_comms_op_t)) {
+        reply_hdr->flags |= X300_FW_COMMS_FLAGS_ERROR;
+    }
+    //otherwise, run the operations in order
+    else {
+        reply_bytes += num_ops*sizeof(x300_fw_comms_op_t);
+        memcpy(reply_ops, request_ops, num_ops*sizeof(x300_fw_comms_op_t));
+        for (uint32_t i = 0; i < num_ops; i++) {
+            handle_fw_comms_op(request_ops[i].flags, request_ops[i].addr,
+                request_ops[i].data, &reply_ops[i].data);
+        }
+    }
+
+    //send a reply if ack requested
+    if (request->flags & X300_FW_COMMS_FLAGS_ACK) {
+        u3_net_stack_send_udp_pkt(ethno, src, dst_port, src_port, reply, reply_bytes);
+    }
+}
+
 void handle_udp_fw_comms(
     const uint8_t ethno,
     const struct ip_addr *src, const struct ip_addr *dst,
@@ -88,6 +153,9 @@ void handle_udp_fw_comms(
     if (buff == NULL) {
      /* We got here from ICMP_DUR undeliverable packet */
     /* Future space for hooks to tear down streaming radios etc */
+    } else if (num_bytes >= sizeof(x300_fw_comms_t) &&
+        (((const x300_fw_comms_t *)buff)->flags & X300_FW_COMMS_FLAGS_MULTI)) {
+        handle_fw_comms_multi(ethno, src, src_port, dst_port, buff, num_bytes);
     } else {
         const x300_fw_comms_t *request = (const x300_fw_comms_t *)buff;
         x300_fw_comms_t reply; memcpy(&reply, buff, sizeof(reply));
@@ -98,22 +166,7 @@ void handle_udp_fw_comms(
         }
         //otherwise, run the actions set by the flags
         else {
-            if (request->flags & X300_FW_COMMS_FLAGS_PEEK32)
-            {
-                if (request->addr & 0x00100000) {
-                    chinch_peek32(request->addr & 0x000FFFFF, &reply.data);
-                } else {
-                    reply.data = wb_peek32(request->addr);
-                }
-            }
-            if (request->flags & X300_FW_COMMS_FLAGS_POKE32)
-            {
-                if (request->addr & 0x00100000) {
-                    chinch_poke32(request->addr & 0x000FFFFF, request->data);
-                } else {
-                    wb_poke32(request->addr, request->data);
-                }
-            }
+            handle_fw_comms_op(request->flags, request->addr, request->data, &reply.data);
         }
 
         //send a reply if ack requested
@@ -328,6 +381,14 @@ static void update_leds(void)
 /***********************************************************************
  * Send periodic GARPs to keep network hardware informed
  **********************************************************************/
+static void age_arp_cache(void)
+{
+    static size_t count = 0;
+    if (count++ < 100) return; //1 second
+    count = 0;
+    u3_net_stack_arp_cache_tick();
+}
+
 static void garp(void)
 {
     static size_t count = 0;
@@ -443,6 +504,8 @@ static void handle_link_state(void)
 /***********************************************************************
  * Main loop runs all the handlers
  **********************************************************************/
+#define NET_STACK_MAX_BURST 8
+
 int main(void)
 {
     x300_init((x300_eeprom_map_t *)&shmem[X300_FW_SHMEM_IDENT]);
@@ -473,11 +536,17 @@ int main(void)
             //handle_link_state(); //deal with router table update
             update_leds(); //run the link and activity leds
             garp(); //send periodic garps
+            age_arp_cache(); //expire old arp entries
             last_cronjob = ticks_now;
         }
 
-        //run the network stack - poll and handle
-        u3_net_stack_handle_one();
+        //run the network stack - poll and handle, and drain the packets that
+        //wait so that control and discovery requests are not held back by
+        //the pollers below on a busy network
+        for (size_t i = 0; i < NET_STACK_MAX_BURST && u3_net_stack_handle_one(); i++)
+        {
+            handle_claim(wb_peek32(SR_ADDR(RB0_BASE, RB_COUNTER)));
+        }
 
         //run the PCIe listener - poll and fwd to wishbone
         forward_pcie_user_xact_to_wb();
@@ -0,0 +1,32 @@
+#
+# Copyright 2019 Ettus Research, a National Instruments Brand
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+# - Find liburing
+# Find the liburing includes and library
+# This module defines
+#  LIBURING_INCLUDE_DIRS, where to find liburing.h
+#  LIBURING_LIBRARIES, the libraries needed by an io_uring user.
+#  LIBURING_FOUND, If false, do not try to use liburing.
+# also defined, but not for general use are
+#  LIBURING_LIBRARY, where to find the liburing library.
+
+find_package(PkgConfig)
+PKG_CHECK_MODULES(PC_LIBURING QUIET liburing)
+
+find_path(LIBURING_INCLUDE_DIR liburing.h
+	HINTS $ENV{LIBURING_DIR}/include ${PC_LIBURING_INCLUDE_DIRS}
+)
+
+find_library(LIBURING_LIBRARY
+	NAMES uring
+	HINTS $ENV{LIBURING_DIR}/lib ${PC_LIBURING_LIBDIR} ${PC_LIBURING_LIBRARY_DIRS}
+)
+
+include(FindPackageHandleStandardArgs)
+FIND_PACKAGE_HANDLE_STANDARD_ARGS(LIBURING DEFAULT_MSG LIBURING_LIBRARY LIBURING_INCLUDE_DIR)
+mark_as_advanced(LIBURING_INCLUDE_DIR LIBURING_LIBRARY)
+
+set(LIBURING_LIBRARIES ${LIBURING_LIBRARY})
+set(LIBURING_INCLUDE_DIRS ${LIBURING_INCLUDE_DIR})
@@ -0,0 +1,40 @@
+#
+# Copyright 2019 Ettus Research, a National Instruments Brand
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+# - Find libxdp
+# Find the libxdp includes and library (AF_XDP socket helpers)
+# This module defines
+#  LIBXDP_INCLUDE_DIRS, where to find xdp/xsk.h
+#  LIBXDP_LIBRARIES, the libraries needed by an AF_XDP user (libxdp, libbpf)
+#  LIBXDP_FOUND, If false, do not try to use libxdp.
+# also defined, but not for general use are
+#  LIBXDP_LIBRARY, where to find the libxdp library.
+#  LIBBPF_LIBRARY, where to find the libbpf library.
+
+find_package(PkgConfig)
+PKG_CHECK_MODULES(PC_LIBXDP QUIET libxdp)
+PKG_CHECK_MODULES(PC_LIBBPF QUIET libbpf)
+
+find_path(LIBXDP_INCLUDE_DIR xdp/xsk.h
+	HINTS $ENV{LIBXDP_DIR}/include ${PC_LIBXDP_INCLUDE_DIRS}
+)
+
+find_library(LIBXDP_LIBRARY
+	NAMES xdp
+	HINTS $ENV{LIBXDP_DIR}/lib ${PC_LIBXDP_LIBDIR} ${PC_LIBXDP_LIBRARY_DIRS}
+)
+
+find_library(LIBBPF_LIBRARY
+	NAMES bpf
+	HINTS $ENV{LIBXDP_DIR}/lib ${PC_LIBBPF_LIBDIR} ${PC_LIBBPF_LIBRARY_DIRS}
+)
+
+include(FindPackageHandleStandardArgs)
+FIND_PACKAGE_HANDLE_STANDARD_ARGS(LIBXDP DEFAULT_MSG
+	LIBXDP_LIBRARY LIBBPF_LIBRARY LIBXDP_INCLUDE_DIR)
+mark_as_advanced(LIBXDP_INCLUDE_DIR LIBXDP_LIBRARY LIBBPF_LIBRARY)
+
+set(LIBXDP_LIBRARIES ${LIBXDP_LIBRARY} ${LIBBPF_LIBRARY})
+set(LIBXDP_INCLUDE_DIRS ${LIBXDP_INCLUDE_DIR})
@@ -6,11 +6,13 @@ if(CMAKE_BUILD_TYPE STREQUAL "Debug")
     set(UHD_LOG_CONSOLE_DISABLE "OFF" CACHE BOOL "Disable UHD logging to stderr")
     set(UHD_LOG_FILE_LEVEL "trace" CACHE STRING "SET UHD file logging level to {trace, debug, info, warning, error, fatal}")
     set(UHD_LOG_CONSOLE_LEVEL "debug" CACHE STRING "SET UHD file logging level to {trace, debug, info, warning, error, fatal}")
+    set(UHD_TRACE_MIN_LEVEL "trace" CACHE STRING "Set fast-path trace level to {trace, debug, info, warning, error, fatal, off}")
 else()
     set(UHD_LOG_MIN_LEVEL "debug" CACHE STRING "Set UHD log level to {trace, debug, info, warning, error, fatal}")
     set(UHD_LOG_CONSOLE_DISABLE "OFF" CACHE BOOL "Disable UHD logging to stderr")
     set(UHD_LOG_FILE_LEVEL "info" CACHE STRING "SET UHD file logging level to {trace, debug, info, warning, error, fatal}")
     set(UHD_LOG_CONSOLE_LEVEL "info" CACHE STRING "SET UHD file logging level to {trace, debug, info, warning, error, fatal}")
+    set(UHD_TRACE_MIN_LEVEL "off" CACHE STRING "Set fast-path trace level to {trace, debug, info, warning, error, fatal, off}")
 endif()
 
 function(UHD_LOG_LEVEL_CONVERT ARG1 ARG2)
@@ -27,6 +29,8 @@ function(UHD_LOG_LEVEL_CONVERT ARG1 ARG2)
         add_definitions(-D${ARG2}=4)
     elseif(LOG_LEVEL_LOWER STREQUAL "fatal")
         add_definitions(-D${ARG2}=5)
+    elseif(LOG_LEVEL_LOWER STREQUAL "off")
+        add_definitions(-D${ARG2}=6)
     else()
         add_definitions(-D${ARG2}=${ARG1})
     endif()
@@ -35,6 +39,15 @@ endfunction()
 UHD_LOG_LEVEL_CONVERT(${UHD_LOG_MIN_LEVEL} "UHD_LOG_MIN_LEVEL")
 UHD_LOG_LEVEL_CONVERT(${UHD_LOG_CONSOLE_LEVEL} "UHD_LOG_CONSOLE_LEVEL")
 UHD_LOG_LEVEL_CONVERT(${UHD_LOG_FILE_LEVEL} "UHD_LOG_FILE_LEVEL")
+UHD_LOG_LEVEL_CONVERT(${UHD_TRACE_MIN_LEVEL} "UHD_TRACE_MIN_LEVEL")
+# Per-component trace levels (see lib/include/uhdlib/utils/trace.hpp), e.g.
+# -DUHD_TRACE_MIN_LEVEL_STREAMER=trace
+foreach(TRACE_COMPONENT STREAMER CTRL_IFACE RADIO_CTRL)
+    if(DEFINED UHD_TRACE_MIN_LEVEL_${TRACE_COMPONENT})
+        UHD_LOG_LEVEL_CONVERT(${UHD_TRACE_MIN_LEVEL_${TRACE_COMPONENT}}
+            "UHD_TRACE_MIN_LEVEL_${TRACE_COMPONENT}")
+    endif()
+endforeach()
 
 if(UHD_LOG_CONSOLE_DISABLE)
     add_definitions(-DUHD_LOG_CONSOLE_DISABLE)
@@ -5,11 +5,14 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 //
 
+#include "latency_histogram.hpp"
 #include <uhd/convert.hpp>
 #include <uhd/usrp/multi_usrp.hpp>
 #include <uhd/utils/safe_main.hpp>
 #include <uhd/utils/thread.hpp>
 #include <boost/algorithm/string.hpp>
+#include <boost/chrono/process_cpu_clocks.hpp>
+#include <boost/chrono/thread_clock.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/format.hpp>
 #include <boost/program_options.hpp>
@@ -18,7 +21,9 @@
 #include <chrono>
 #include <complex>
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <list>
 #include <thread>
 
 namespace po = boost::program_options;
@@ -26,21 +31,83 @@ namespace po = boost::program_options;
 namespace {
 constexpr int64_t CLOCK_TIMEOUT = 1000; // 1000mS timeout for external clock locking
 constexpr float INIT_DELAY      = 0.05; // 50mS initial delay before transmit
+
+//! Results of one streamer and the thread that runs it
+struct stream_stats_t
+{
+    std::string direction;
+    std::vector<size_t> channels;
+    latency_histogram latency;
+    //! CPU time of the streaming thread in seconds, negative if unknown
+    double cpu_time = -1.0;
+
+    std::string channel_str() const
+    {
+        std::vector<std::string> chans;
+        for (const size_t chan : channels) {
+            chans.push_back(std::to_string(chan));
+        }
+        return boost::algorithm::join(chans, ",");
+    }
+};
+
+//! Counters and CPU time at the end of a reporting interval
+struct interval_stats_t
+{
+    double time;
+    unsigned long long rx_samps;
+    unsigned long long tx_samps;
+    unsigned long long overruns;
+    unsigned long long underruns;
+    unsigned long long seqrx_errors;
+    unsigned long long seq_errors;
+    double cpu_time;
+};
+
+//! Process CPU time (user + system) in seconds
+double get_process_cpu_time()
+{
+    const auto times = boost::chrono::process_cpu_clock::now().time_since_epoch().count();
+    return (times.user + times.system) / 1e9;
+}
+
+//! Run \p fn and return the CPU time the calling thread spent in it in seconds
+template <typename fn_type>
+double run_with_thread_cpu_time(fn_type&& fn)
+{
+#ifdef BOOST_CHRONO_HAS_THREAD_CLOCK
+    const auto start = boost::chrono::thread_clock::now();
+    fn();
+    return boost::chrono::duration<double>(boost::chrono::thread_clock::now() - start)
+        .count();
+#else
+    fn();
+    return -1.0;
+#endif
+}
+
+std::string format_latency(const latency_histogram& latency)
+{
+    return str(boost::format("p50 %.1f  p90 %.1f  p99 %.1f  p99.9 %.1f  max %.1f")
+               % latency.percentile(0.5) % latency.percentile(0.9)
+               % latency.percentile(0.99) % latency.percentile(0.999) % latency.max());
+}
 } // namespace
 
 /***********************************************************************
  * Test result variables
  **********************************************************************/
-unsigned long long num_overruns      = 0;
-unsigned long long num_underruns     = 0;
-unsigned long long num_rx_samps      = 0;
-unsigned long long num_tx_samps      = 0;
-unsigned long long num_dropped_samps = 0;
-unsigned long long num_seq_errors    = 0;
-unsigned long long num_seqrx_errors  = 0; // "D"s
-unsigned long long num_late_commands = 0;
-unsigned long long num_timeouts_rx   = 0;
-unsigned long long num_timeouts_tx   = 0;
+// Updated by all streaming threads, and read by the interval reports
+std::atomic<unsigned long long> num_overruns(0);
+std::atomic<unsigned long long> num_underruns(0);
+std::atomic<unsigned long long> num_rx_samps(0);
+std::atomic<unsigned long long> num_tx_samps(0);
+std::atomic<unsigned long long> num_dropped_samps(0);
+std::atomic<unsigned long long> num_seq_errors(0);
+std::atomic<unsigned long long> num_seqrx_errors(0); // "D"s
+std::atomic<unsigned long long> num_late_commands(0);
+std::atomic<unsigned long long> num_timeouts_rx(0);
+std::atomic<unsigned long long> num_timeouts_tx(0);
 
 inline boost::posix_time::time_duration time_delta(
     const boost::posix_time::ptime& ref_time)
@@ -62,8 +129,10 @@ void benchmark_rx_rate(uhd::usrp::multi_usrp::sptr usrp,
     const std::string& rx_cpu,
     uhd::rx_streamer::sptr rx_stream,
     bool random_nsamps,
+    bool stream_now,
     const boost::posix_time::ptime& start_time,
-    std::atomic<bool>& burst_timer_elapsed)
+    std::atomic<bool>& burst_timer_elapsed,
+    latency_histogram& rx_latency)
 {
     uhd::set_thread_priority_safe();
 
@@ -86,7 +155,7 @@ void benchmark_rx_rate(uhd::usrp::multi_usrp::sptr usrp,
 
     uhd::stream_cmd_t cmd(uhd::stream_cmd_t::STREAM_MODE_START_CONTINUOUS);
     cmd.time_spec  = usrp->get_time_now() + uhd::time_spec_t(INIT_DELAY);
-    cmd.stream_now = (buffs.size() == 1);
+    cmd.stream_now = stream_now;
     rx_stream->issue_stream_cmd(cmd);
 
     const float burst_pkt_time =
@@ -106,8 +175,10 @@ void benchmark_rx_rate(uhd::usrp::multi_usrp::sptr usrp,
             rx_stream->issue_stream_cmd(cmd);
         }
         try {
+            const auto recv_start = std::chrono::steady_clock::now();
             num_rx_samps += rx_stream->recv(buffs, max_samps_per_packet, md, recv_timeout)
                             * rx_stream->get_num_channels();
+            rx_latency.add(std::chrono::steady_clock::now() - recv_start);
             recv_timeout = burst_pkt_time;
         } catch (uhd::io_error& e) {
             std::cerr << "[" << NOW() << "] Caught an IO exception. " << std::endl;
@@ -158,7 +229,7 @@ void benchmark_rx_rate(uhd::usrp::multi_usrp::sptr usrp,
                 // Radio core will be in the idle state. Issue stream command to restart
                 // streaming.
                 cmd.time_spec  = usrp->get_time_now() + uhd::time_spec_t(0.05);
-                cmd.stream_now = (buffs.size() == 1);
+                cmd.stream_now = stream_now;
                 rx_stream->issue_stream_cmd(cmd);
                 break;
 
@@ -190,7 +261,9 @@ void benchmark_tx_rate(uhd::usrp::multi_usrp::sptr usrp,
     uhd::tx_streamer::sptr tx_stream,
     std::atomic<bool>& burst_timer_elapsed,
     const boost::posix_time::ptime& start_time,
-    bool random_nsamps = false)
+    bool random_nsamps,
+    bool send_now,
+    latency_histogram& tx_latency)
 {
     uhd::set_thread_priority_safe();
 
@@ -208,7 +281,7 @@ void benchmark_tx_rate(uhd::usrp::multi_usrp::sptr usrp,
         buffs.push_back(&buff.front()); // same buffer for each channel
     // Create the metadata, and populate the time spec at the latest possible moment
     uhd::tx_metadata_t md;
-    md.has_time_spec = (buffs.size() != 1);
+    md.has_time_spec = not send_now;
     md.time_spec     = usrp->get_time_now() + uhd::time_spec_t(INIT_DELAY);
 
     if (random_nsamps) {
@@ -221,17 +294,21 @@ void benchmark_tx_rate(uhd::usrp::multi_usrp::sptr usrp,
             usrp->set_time_now(uhd::time_spec_t(0.0));
             while (num_acc_samps < total_num_samps) {
                 // send a single packet
+                const auto send_start = std::chrono::steady_clock::now();
                 num_tx_samps += tx_stream->send(buffs, max_samps_per_packet, md, timeout)
                                 * tx_stream->get_num_channels();
+                tx_latency.add(std::chrono::steady_clock::now() - send_start);
                 num_acc_samps += std::min(
                     total_num_samps - num_acc_samps, tx_stream->get_max_num_samps());
             }
         }
     } else {
         while (not burst_timer_elapsed) {
+            const auto send_start = std::chrono::steady_clock::now();
             const size_t num_tx_samps_sent_now =
                 tx_stream->send(buffs, max_samps_per_packet, md)
                 * tx_stream->get_num_channels();
+            tx_latency.add(std::chrono::steady_clock::now() - send_start);
             num_tx_samps += num_tx_samps_sent_now;
             if (num_tx_samps_sent_now == 0) {
                 num_timeouts_tx++;
@@ -311,6 +388,8 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
     bool random_nsamps = false;
     std::atomic<bool> burst_timer_elapsed(false);
     size_t overrun_threshold, underrun_threshold, drop_threshold, seq_threshold;
+    double interval;
+    std::string json_file;
 
     // setup the program options
     po::options_description desc("Allowed options");
@@ -342,6 +421,9 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
          "Number of dropped packets (D) which will declare the benchmark a failure.")
         ("seq-threshold", po::value<size_t>(&seq_threshold),
          "Number of dropped packets (D) which will declare the benchmark a failure.")
+        ("multi_streamer", "Create a separate streamer and thread per channel")
+        ("interval", po::value<double>(&interval)->default_value(0.0), "Print the rates, errors and CPU usage every interval seconds (0 disables)")
+        ("json-file", po::value<std::string>(&json_file), "Also write the results to this file as JSON")
     ;
     // clang-format on
     po::variables_map vm;
@@ -507,36 +589,91 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
         usrp->set_time_now(0.0);
     }
 
-    // spawn the receive test thread
+    // With more than one channel, all streamers start at the same time
+    const bool rx_stream_now  = rx_channel_nums.size() <= 1;
+    const bool tx_send_now    = tx_channel_nums.size() <= 1;
+    const bool multi_streamer = vm.count("multi_streamer") > 0;
+    // A list, so the threads can hold references to their elements
+    std::list<stream_stats_t> stream_stats;
+
+    // spawn the receive test threads
     if (vm.count("rx_rate")) {
         usrp->set_rx_rate(rx_rate);
-        // create a receive streamer
-        uhd::stream_args_t stream_args(rx_cpu, rx_otw);
-        stream_args.channels             = rx_channel_nums;
-        uhd::rx_streamer::sptr rx_stream = usrp->get_rx_stream(stream_args);
-        auto rx_thread = thread_group.create_thread([=, &burst_timer_elapsed]() {
-            benchmark_rx_rate(
-                usrp, rx_cpu, rx_stream, random_nsamps, start_time, burst_timer_elapsed);
-        });
-        uhd::set_thread_name(rx_thread, "bmark_rx_stream");
+        std::vector<std::vector<size_t>> streamer_chans;
+        if (multi_streamer) {
+            for (const size_t chan : rx_channel_nums) {
+                streamer_chans.push_back({chan});
+            }
+        } else {
+            streamer_chans.push_back(rx_channel_nums);
+        }
+        for (const auto& chans : streamer_chans) {
+            // create a receive streamer
+            uhd::stream_args_t stream_args(rx_cpu, rx_otw);
+            stream_args.channels             = chans;
+            uhd::rx_streamer::sptr rx_stream = usrp->get_rx_stream(stream_args);
+            stream_stats.emplace_back();
+            stream_stats_t& stats = stream_stats.back();
+            stats.direction       = "RX";
+            stats.channels        = chans;
+            auto rx_fn = [=, &burst_timer_elapsed, &stats]() {
+                stats.cpu_time = run_with_thread_cpu_time([&]() {
+                    benchmark_rx_rate(usrp,
+                        rx_cpu,
+                        rx_stream,
+                        random_nsamps,
+                        rx_stream_now,
+                        start_time,
+                        burst_timer_elapsed,
+                        stats.latency);
+                });
+            };
+            auto rx_thread = thread_group.create_thread(rx_fn);
+            uhd::set_thread_name(rx_thread, "bmark_rx_stream");
+        }
     }
 
-    // spawn the transmit test thread
+    // spawn the transmit test threads
     if (vm.count("tx_rate")) {
         usrp->set_tx_rate(tx_rate);
-        // create a transmit streamer
-        uhd::stream_args_t stream_args(tx_cpu, tx_otw);
-        stream_args.channels             = tx_channel_nums;
-        uhd::tx_streamer::sptr tx_stream = usrp->get_tx_stream(stream_args);
-        auto tx_thread = thread_group.create_thread([=, &burst_timer_elapsed]() {
-            benchmark_tx_rate(
-                usrp, tx_cpu, tx_stream, burst_timer_elapsed, start_time, random_nsamps);
-        });
-        uhd::set_thread_name(tx_thread, "bmark_tx_stream");
-        auto tx_async_thread = thread_group.create_thread([=, &burst_timer_elapsed]() {
-            benchmark_tx_rate_async_helper(tx_stream, start_time, burst_timer_elapsed);
-        });
-        uhd::set_thread_name(tx_async_thread, "bmark_tx_helper");
+        std::vector<std::vector<size_t>> streamer_chans;
+        if (multi_streamer) {
+            for (const size_t chan : tx_channel_nums) {
+                streamer_chans.push_back({chan});
+            }
+        } else {
+            streamer_chans.push_back(tx_channel_nums);
+        }
+        for (const auto& chans : streamer_chans) {
+            // create a transmit streamer
+            uhd::stream_args_t stream_args(tx_cpu, tx_otw);
+            stream_args.channels             = chans;
+            uhd::tx_streamer::sptr tx_stream = usrp->get_tx_stream(stream_args);
+            stream_stats.emplace_back();
+            stream_stats_t& stats = stream_stats.back();
+            stats.direction       = "TX";
+            stats.channels        = chans;
+            auto tx_fn = [=, &burst_timer_elapsed, &stats]() {
+                stats.cpu_time = run_with_thread_cpu_time([&]() {
+                    benchmark_tx_rate(usrp,
+                        tx_cpu,
+                        tx_stream,
+                        burst_timer_elapsed,
+                        start_time,
+                        random_nsamps,
+                        tx_send_now,
+                        stats.latency);
+                });
+            };
+            auto tx_thread = thread_group.create_thread(tx_fn);
+            uhd::set_thread_name(tx_thread, "bmark_tx_stream");
+            auto tx_async_fn = [=, &burst_timer_elapsed]() {
+                benchmark_tx_rate_async_helper(
+                    tx_stream, start_time, burst_timer_elapsed);
+            };
+            auto tx_async_thread = thread_group.create_thread(tx_async_fn);
+            uhd::set_thread_name(tx_async_thread, "bmark_tx_helper");
+        }
     }
 
     // sleep for the required duration
@@ -545,14 +682,56 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
         // send/receive the proper number of samples.
         duration += INIT_DELAY;
     }
-    const int64_t secs = int64_t(duration);
-    const int64_t usecs = int64_t((duration - secs) * 1e6);
-    std::this_thread::sleep_for(
-        std::chrono::seconds(secs) + std::chrono::microseconds(usecs));
+    // report the counters every interval while the benchmark runs
+    typedef std::chrono::steady_clock::duration steady_duration;
+    const auto bench_start = std::chrono::steady_clock::now();
+    const auto bench_end   = bench_start
+                           + std::chrono::duration_cast<steady_duration>(
+                                 std::chrono::duration<double>(duration));
+    const auto interval_time = std::chrono::duration_cast<steady_duration>(
+        std::chrono::duration<double>(interval));
+    const double start_cpu = get_process_cpu_time();
+    interval_stats_t last  = {0.0, 0, 0, 0, 0, 0, 0, start_cpu};
+    auto next_report       = (interval > 0.0) ? bench_start + interval_time : bench_end;
+    std::vector<interval_stats_t> intervals;
+    while (std::chrono::steady_clock::now() < bench_end) {
+        std::this_thread::sleep_until(std::min(next_report, bench_end));
+        if (interval <= 0.0 or std::chrono::steady_clock::now() < next_report) {
+            continue;
+        }
+        next_report += interval_time;
+        const interval_stats_t now = {
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - bench_start)
+                .count(),
+            num_rx_samps,
+            num_tx_samps,
+            num_overruns,
+            num_underruns,
+            num_seqrx_errors,
+            num_seq_errors,
+            get_process_cpu_time()};
+        const double elapsed = now.time - last.time;
+        std::cout << boost::format("[%s] RX %.3f Msps, TX %.3f Msps, O %u, U %u, D %u, "
+                                   "S %u, CPU %.1f%%")
+                         % NOW() % ((now.rx_samps - last.rx_samps) / elapsed / 1e6)
+                         % ((now.tx_samps - last.tx_samps) / elapsed / 1e6)
+                         % (now.overruns - last.overruns)
+                         % (now.underruns - last.underruns)
+                         % (now.seqrx_errors - last.seqrx_errors)
+                         % (now.seq_errors - last.seq_errors)
+                         % (100.0 * (now.cpu_time - last.cpu_time) / elapsed)
+                  << std::endl;
+        intervals.push_back(now);
+        last = now;
+    }
+    const double bench_time =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - bench_start)
+            .count();
 
     // interrupt and join the threads
     burst_timer_elapsed = true;
     thread_group.join_all();
+    const double process_cpu_time = get_process_cpu_time() - start_cpu;
 
     std::cout << "[" << NOW() << "] Benchmark complete." << std::endl << std::endl;
 
@@ -578,10 +757,107 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
                                "  Num late commands:        %u\n"
                                "  Num timeouts (Tx):        %u\n"
                                "  Num timeouts (Rx):        %u\n")
-                     % num_rx_samps % num_dropped_samps % num_overruns % num_tx_samps
-                     % num_seq_errors % num_seqrx_errors % num_underruns
-                     % num_late_commands % num_timeouts_tx % num_timeouts_rx
+                     % num_rx_samps.load() % num_dropped_samps.load()
+                     % num_overruns.load() % num_tx_samps.load() % num_seq_errors.load()
+                     % num_seqrx_errors.load() % num_underruns.load()
+                     % num_late_commands.load() % num_timeouts_tx.load()
+                     % num_timeouts_rx.load()
               << std::endl;
+    // the latency of all streamers of one direction, then of each streamer
+    for (const auto& direction :
+        {std::make_pair("RX", "recv()"), std::make_pair("TX", "send()")}) {
+        latency_histogram latency;
+        size_t num_streams = 0;
+        for (const auto& stats : stream_stats) {
+            if (stats.direction == direction.first) {
+                latency.merge(stats.latency);
+                num_streams++;
+            }
+        }
+        if (latency.count() == 0) {
+            continue;
+        }
+        std::cout << boost::format("  %s %s latency (us):  %s") % direction.first
+                         % direction.second % format_latency(latency)
+                  << std::endl;
+        for (const auto& stats : stream_stats) {
+            if (num_streams > 1 and stats.direction == direction.first) {
+                std::cout << boost::format("  %s %s latency, ch %s (us):  %s")
+                                 % direction.first % direction.second
+                                 % stats.channel_str() % format_latency(stats.latency)
+                          << std::endl;
+            }
+        }
+    }
+    std::cout << boost::format("  Process CPU time:         %.3f s (%.1f%% of a core)")
+                     % process_cpu_time % (100.0 * process_cpu_time / bench_time)
+              << std::endl;
+    for (const auto& stats : stream_stats) {
+        if (stats.cpu_time >= 0.0) {
+            std::cout << boost::format("  %s thread CPU time, ch %s: %.3f s (%.1f%%)")
+                             % stats.direction % stats.channel_str() % stats.cpu_time
+                             % (100.0 * stats.cpu_time / bench_time)
+                      << std::endl;
+        }
+    }
+
+    if (not json_file.empty()) {
+        std::ofstream json(json_file);
+        json << "{\n"
+             << boost::format("  \"args\": \"%s\",\n") % args
+             << boost::format("  \"duration\": %f,\n") % bench_time
+             << boost::format("  \"rx_rate\": %f,\n")
+                    % (vm.count("rx_rate") ? rx_rate : 0.0)
+             << boost::format("  \"tx_rate\": %f,\n")
+                    % (vm.count("tx_rate") ? tx_rate : 0.0)
+             << boost::format("  \"num_rx_samples\": %u,\n") % num_rx_samps.load()
+             << boost::format("  \"num_dropped_samples\": %u,\n")
+                    % num_dropped_samps.load()
+             << boost::format("  \"num_overruns\": %u,\n") % num_overruns.load()
+             << boost::format("  \"num_tx_samples\": %u,\n") % num_tx_samps.load()
+             << boost::format("  \"num_tx_seq_errors\": %u,\n") % num_seq_errors.load()
+             << boost::format("  \"num_rx_seq_errors\": %u,\n")
+                    % num_seqrx_errors.load()
+             << boost::format("  \"num_underruns\": %u,\n") % num_underruns.load()
+             << boost::format("  \"num_late_commands\": %u,\n")
+                    % num_late_commands.load()
+             << boost::format("  \"num_tx_timeouts\": %u,\n") % num_timeouts_tx.load()
+             << boost::format("  \"num_rx_timeouts\": %u,\n") % num_timeouts_rx.load()
+             << boost::format("  \"process_cpu_time\": %f,\n") % process_cpu_time
+             << "  \"streams\": [";
+        size_t stream_idx = 0;
+        for (const auto& stats : stream_stats) {
+            json << (stream_idx++ ? "," : "") << "\n    "
+                 << boost::format("{\"direction\": \"%s\", \"channels\": [%s], "
+                                  "\"thread_cpu_time\": %f, \"calls\": %u, "
+                                  "\"latency_us\": {\"p50\": %f, \"p90\": %f, "
+                                  "\"p99\": %f, \"p99.9\": %f, \"max\": %f}}")
+                        % stats.direction % stats.channel_str() % stats.cpu_time
+                        % stats.latency.count() % stats.latency.percentile(0.5)
+                        % stats.latency.percentile(0.9) % stats.latency.percentile(0.99)
+                        % stats.latency.percentile(0.999) % stats.latency.max();
+        }
+        json << "\n  ],\n  \"intervals\": [";
+        last = {0.0, 0, 0, 0, 0, 0, 0, start_cpu};
+        for (size_t i = 0; i < intervals.size(); i++) {
+            const interval_stats_t& now = intervals[i];
+            const double elapsed        = now.time - last.time;
+            json << (i ? "," : "") << "\n    "
+                 << boost::format("{\"time\": %f, \"rx_rate\": %f, \"tx_rate\": %f, "
+                                  "\"overruns\": %u, \"underruns\": %u, "
+                                  "\"rx_seq_errors\": %u, \"tx_seq_errors\": %u, "
+                                  "\"cpu_usage\": %f}")
+                        % now.time % ((now.rx_samps - last.rx_samps) / elapsed)
+                        % ((now.tx_samps - last.tx_samps) / elapsed)
+                        % (now.overruns - last.overruns)
+                        % (now.underruns - last.underruns)
+                        % (now.seqrx_errors - last.seqrx_errors)
+                        % (now.seq_errors - last.seq_errors)
+                        % ((now.cpu_time - last.cpu_time) / elapsed);
+            last = now;
+        }
+        json << "\n  ]\n}" << std::endl;
+    }
     // finished
     std::cout << std::endl << "Done!" << std::endl << std::endl;
 
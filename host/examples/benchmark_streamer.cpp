@@ -4,6 +4,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 //
 
+#include "latency_histogram.hpp"
 #include <uhd/convert.hpp>
 #include <uhd/device3.hpp>
 #include <uhd/rfnoc/block_ctrl.hpp>
@@ -12,6 +13,7 @@
 #include <uhd/rfnoc/null_block_ctrl.hpp>
 #include <uhd/utils/safe_main.hpp>
 #include <uhd/utils/thread.hpp>
+#include <boost/algorithm/string/join.hpp>
 #include <boost/algorithm/string/trim_all.hpp>
 #include <boost/format.hpp>
 #include <boost/program_options.hpp>
@@ -47,6 +49,7 @@ struct host_measurement_values
     uint64_t num_samples;
     uint64_t num_packets;
     uint64_t spp;
+    latency_histogram latency;
 };
 
 struct test_results
@@ -211,6 +214,36 @@ void print_utilization_statistics(const traffic_counter_values& vals)
               << std::endl;
 }
 
+//! Samples per channel that the null blocks of a stream counted
+double get_fpga_samples(const test_results& results, const bool rx)
+{
+    if (results.traffic_counter.empty()) {
+        return 0.0;
+    }
+    double num_samples = 0.0;
+    for (const auto& tc : results.traffic_counter) {
+        num_samples += rx ? (tc.ce_to_shell_xfer_count - tc.ce_to_shell_pkt_count) * 2
+                          : (tc.shell_to_ce_xfer_count - tc.shell_to_ce_pkt_count) * 2;
+    }
+    return num_samples / results.traffic_counter.size();
+}
+
+void print_host_latency(const test_results& results, const bool rx)
+{
+    const latency_histogram& latency = results.host.latency;
+    std::cout << (rx ? "recv()" : "send()") << " latency:        "
+              << boost::format("p50 %.1f us, p99 %.1f us, p99.9 %.1f us, max %.1f us")
+                     % latency.percentile(0.5) % latency.percentile(0.99)
+                     % latency.percentile(0.999) % latency.max()
+              << std::endl;
+    const double fpga_samples = get_fpga_samples(results, rx);
+    if (fpga_samples > 0) {
+        std::cout << "Host / FPGA samples:   "
+                  << 100.0 * results.host.num_samples / fpga_samples << " %"
+                  << std::endl;
+    }
+}
+
 void print_rx_results(const test_results& results, double bus_clk_freq)
 {
     std::cout << "------------------------------------------------------------------"
@@ -244,6 +277,7 @@ void print_rx_results(const test_results& results, double bus_clk_freq)
     std::cout << "Calculated throughput: "
               << results.host.num_samples / results.host.seconds / 1e6 << " Msps"
               << std::endl;
+    print_host_latency(results, true);
 }
 
 void print_tx_results(const test_results& results, const double bus_clk_freq)
@@ -279,6 +313,39 @@ void print_tx_results(const test_results& results, const double bus_clk_freq)
     std::cout << "Calculated throughput: "
               << results.host.num_samples / results.host.seconds / 1e6 << " Msps"
               << std::endl;
+    print_host_latency(results, false);
+}
+
+//! One line per stream, to compare the streams of a run at a glance
+void print_summary(const std::vector<test_results>& tx_results,
+    const std::vector<test_results>& rx_results,
+    const double bus_clk_freq)
+{
+    std::cout << "---------------------------- Summary -----------------------------"
+              << std::endl;
+    std::cout << "Stream  Host Msps  FPGA Msps  Host/FPGA  p50 us  p99 us  max us"
+              << std::endl;
+    for (const bool rx : {false, true}) {
+        const std::vector<test_results>& results = rx ? rx_results : tx_results;
+        for (size_t i = 0; i < results.size(); i++) {
+            const test_results& r     = results[i];
+            const double fpga_samples = get_fpga_samples(r, rx);
+            const double fpga_seconds =
+                r.traffic_counter.empty()
+                    ? 0.0
+                    : r.traffic_counter.front().clock_cycles / bus_clk_freq;
+            const double fpga_rate =
+                fpga_seconds > 0 ? fpga_samples / fpga_seconds / 1e6 : 0.0;
+            const double host_ratio =
+                fpga_samples > 0 ? 100.0 * r.host.num_samples / fpga_samples : 0.0;
+            std::cout << boost::format("%s %-3u  %9.2f  %9.2f  %8.1f%%  %6.1f  %6.1f  %6.1f")
+                             % (rx ? "RX" : "TX") % i
+                             % (r.host.num_samples / r.host.seconds / 1e6) % fpga_rate
+                             % host_ratio % r.host.latency.percentile(0.5)
+                             % r.host.latency.percentile(0.99) % r.host.latency.max()
+                      << std::endl;
+        }
+    }
 }
 
 void configure_ddc(uhd::device3::sptr usrp, const std::string& ddcid, double ddc_decim)
@@ -304,7 +371,9 @@ uhd::rx_streamer::sptr configure_rx_streamer(uhd::device3::sptr usrp,
     const std::string splitter_id,
     const std::vector<std::vector<noc_block_endpoint>>& noc_blocks,
     const size_t spp,
-    const std::string& format)
+    const std::string& format,
+    const double rate,
+    const double bus_clk_freq)
 {
     std::cout << "Configuring rx stream with" << std::endl;
     std::cout << "    Null ID: " << null_id << std::endl;
@@ -373,7 +442,18 @@ uhd::rx_streamer::sptr configure_rx_streamer(uhd::device3::sptr usrp,
     const size_t otw_bytes_per_item =
         uhd::convert::get_bytes_per_item(stream_args.otw_format);
     const size_t samps_per_packet = rx_stream->get_max_num_samps();
-    null_ctrl->set_arg<int>("line_rate", 0);
+    if (rate > 0) {
+        // The null source produces one line of a packet per line period
+        const double samps_per_line =
+            double(uhd::rfnoc::null_block_ctrl::BYTES_PER_LINE) / otw_bytes_per_item;
+        const double actual_rate =
+            null_ctrl->set_line_rate(rate / samps_per_line, bus_clk_freq)
+            * samps_per_line;
+        std::cout << "    Null source rate: " << actual_rate / 1e6 << " Msps"
+                  << std::endl;
+    } else {
+        null_ctrl->set_arg<int>("line_rate", 0);
+    }
     null_ctrl->set_arg<int>("bpp", samps_per_packet * otw_bytes_per_item);
 
     return rx_stream;
@@ -414,12 +494,15 @@ test_results benchmark_rx_streamer(uhd::device3::sptr usrp,
     uint64_t num_rx_samps   = 0;
     uint64_t num_rx_packets = 0;
     uhd::rx_metadata_t md;
+    latency_histogram latency;
 
     while (current_time - start_time < requested_duration) {
         const size_t packets_per_iteration = 1000;
 
         for (size_t i = 0; i < packets_per_iteration; i++) {
+            const auto recv_start = std::chrono::steady_clock::now();
             num_rx_samps += rx_stream->recv(buffers, samps_per_packet, md, 1.0);
+            latency.add(std::chrono::steady_clock::now() - recv_start);
 
             if (md.error_code != uhd::rx_metadata_t::ERROR_CODE_NONE) {
                 if (md.error_code == uhd::rx_metadata_t::ERROR_CODE_OVERFLOW) {
@@ -452,6 +535,7 @@ test_results benchmark_rx_streamer(uhd::device3::sptr usrp,
     results.host.num_samples = num_rx_samps;
     results.host.num_packets = num_rx_packets;
     results.host.spp         = samps_per_packet;
+    results.host.latency     = latency;
 
     return results;
 }
@@ -513,7 +597,8 @@ test_results benchmark_tx_streamer(uhd::device3::sptr usrp,
     uhd::tx_streamer::sptr tx_stream,
     const std::vector<std::string>& null_ids,
     const double duration,
-    const std::string& format)
+    const std::string& format,
+    const double rate)
 {
     std::vector<boost::shared_ptr<uhd::rfnoc::null_block_ctrl>> null_ctrls;
     for (const auto& id : null_ids) {
@@ -541,6 +626,7 @@ test_results benchmark_tx_streamer(uhd::device3::sptr usrp,
     uint64_t num_tx_samps   = 0;
     uint64_t num_tx_packets = 0;
     uhd::tx_metadata_t md;
+    latency_histogram latency;
 
     const std::chrono::duration<double> requested_duration(duration);
     const auto start_time = std::chrono::steady_clock::now();
@@ -550,7 +636,16 @@ test_results benchmark_tx_streamer(uhd::device3::sptr usrp,
         const size_t packets_per_iteration = 1000;
 
         for (size_t i = 0; i < packets_per_iteration; i++) {
+            const auto send_start = std::chrono::steady_clock::now();
             num_tx_samps += tx_stream->send(buffers, samps_per_packet, md);
+            latency.add(std::chrono::steady_clock::now() - send_start);
+            if (rate > 0) {
+                // Don't get ahead of the requested rate
+                std::this_thread::sleep_until(
+                    start_time
+                    + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                          std::chrono::duration<double>(num_tx_samps / rate)));
+            }
         }
 
         num_tx_packets += packets_per_iteration;
@@ -577,6 +672,7 @@ test_results benchmark_tx_streamer(uhd::device3::sptr usrp,
     results.host.num_samples = num_tx_samps;
     results.host.num_packets = num_tx_packets;
     results.host.spp         = samps_per_packet;
+    results.host.latency     = latency;
 
     return results;
 }
@@ -620,11 +716,11 @@ std::deque<noc_block_endpoint> create_noc_block_queue(const size_t num_blocks,
 int UHD_SAFE_MAIN(int argc, char* argv[])
 {
     // Variables to be set by po
-    bool dma_fifo, ddc, duc, tx_loopback_fifo, rx_loopback_fifo;
+    bool dma_fifo, ddc, duc, tx_loopback_fifo, rx_loopback_fifo, all_null_blocks;
     std::string args, format;
     std::string null_ids, fifo_ids, ddc_ids, duc_ids, split_stream_ids;
     double duration;
-    double ddc_decim, duc_interp, bus_clk_freq;
+    double ddc_decim, duc_interp, bus_clk_freq, rx_rate, tx_rate;
     size_t spp;
     size_t num_tx_streamers, num_rx_streamers, num_tx_channels, num_rx_channels;
 
@@ -642,6 +738,9 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
         ("spp", po::value<size_t>(&spp)->default_value(0), "samples per packet (on FPGA and wire)")
         ("format", po::value<std::string>(&format)->default_value("sc16"), "host sample type: sc16, fc32, or fc64")
         ("bus_clk_freq", po::value<double>(&bus_clk_freq)->default_value(187.5e6), "bus clock frequency for throughput calculation (default: 187.5e6)")
+        ("rx_rate", po::value<double>(&rx_rate)->default_value(0), "sample rate of each null source in sps (default: 0, as fast as possible)")
+        ("tx_rate", po::value<double>(&tx_rate)->default_value(0), "sample rate of each tx streamer in sps (default: 0, as fast as possible)")
+        ("all_null_blocks", po::bool_switch(&all_null_blocks)->default_value(false), "use every null block that isn't used for tx as an rx streamer")
         ("dma_fifo", po::bool_switch(&dma_fifo)->default_value(false), "whether to insert a DMA FIFO in the streaming path")
         ("tx_loopback_fifo", po::bool_switch(&tx_loopback_fifo)->default_value(false), "whether to insert a loopback FIFO in the tx streaming path")
         ("rx_loopback_fifo", po::bool_switch(&rx_loopback_fifo)->default_value(false), "whether to insert a loopback FIFO in the rx streaming path")
@@ -663,7 +762,7 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
     // Print the help message
     const size_t num_streamers = num_rx_streamers + num_tx_streamers;
 
-    if (vm.count("help") or (num_streamers == 0)) {
+    if (vm.count("help") or (num_streamers == 0 and not all_null_blocks)) {
         std::cout << boost::format("UHD - Benchmark Streamer") << std::endl;
         std::cout
             << "    Benchmark streamer connects a null sink/source to a streamer and\n"
@@ -704,6 +803,11 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
                "    with two tx and two rx streams will assign the first two IDs in\n"
                "    the null_ids list to the tx streams and the next two IDs to the\n"
                "    rx streams.\n"
+               "    To find the limits of the host and the transport, specify\n"
+               "    --all_null_blocks to stream from all null blocks of the device at\n"
+               "    once. --rx_rate and --tx_rate limit the rate of each stream. The\n"
+               "    summary compares the throughput measured on the host with the\n"
+               "    FPGA traffic counters, and shows the send() and recv() latency.\n"
             << std::endl
             << desc << std::endl;
         return EXIT_SUCCESS;
@@ -715,6 +819,24 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
               << std::endl;
     uhd::device3::sptr usrp = uhd::device3::make(args);
 
+    if (all_null_blocks) {
+        // Every null block that isn't a tx sink becomes an rx source
+        const auto null_block_ids =
+            usrp->find_blocks<uhd::rfnoc::null_block_ctrl>("NullSrcSink");
+        const size_t num_tx_nulls = num_tx_streamers * num_tx_channels;
+        num_rx_streamers =
+            null_block_ids.size() - std::min(null_block_ids.size(), num_tx_nulls);
+        if (null_ids.empty()) {
+            std::vector<std::string> ids;
+            for (const auto& block_id : null_block_ids) {
+                ids.push_back(block_id.to_string());
+            }
+            null_ids = boost::algorithm::join(ids, ",");
+        }
+        std::cout << "Using " << null_block_ids.size() << " null blocks, "
+                  << num_rx_streamers << " rx streamers" << std::endl;
+    }
+
     // For each block type, calculate the number of blocks needed by the test
     // and create block IDs, accounting for user overrides in program options.
     // Note that for null sources, rx only uses one NULL block per streamer
@@ -830,8 +952,14 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
             splitter_blocks.pop_front();
         }
 
-        rx_streamers.push_back(configure_rx_streamer(
-            usrp, null_blocks.front().block_id, splitter_id, blocks, spp, format));
+        rx_streamers.push_back(configure_rx_streamer(usrp,
+            null_blocks.front().block_id,
+            splitter_id,
+            blocks,
+            spp,
+            format,
+            rx_rate,
+            bus_clk_freq));
 
         // Store the null ids to read traffic counters later
         rx_null_ids.push_back(null_blocks.front().block_id);
@@ -845,10 +973,10 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
         test_results& results             = tx_results[i];
         uhd::tx_streamer::sptr streamer   = tx_streamers[i];
         std::vector<std::string> null_ids = tx_null_ids[i];
-        threads.push_back(
-            std::thread([&results, usrp, streamer, null_ids, duration, format]() {
-                results =
-                    benchmark_tx_streamer(usrp, streamer, null_ids, duration, format);
+        threads.push_back(std::thread(
+            [&results, usrp, streamer, null_ids, duration, format, tx_rate]() {
+                results = benchmark_tx_streamer(
+                    usrp, streamer, null_ids, duration, format, tx_rate);
             }));
     }
 
@@ -878,5 +1006,7 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
         print_rx_results(result, bus_clk_freq);
     }
 
+    print_summary(tx_results, rx_results, bus_clk_freq);
+
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,115 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef LATENCY_HISTOGRAM_HPP
+#define LATENCY_HISTOGRAM_HPP
+
+#include <boost/format.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+/*!
+ * Histogram of latencies, such as the time spent in send() or recv() calls.
+ *
+ * The buckets are an eighth of an octave wide, so percentiles are accurate
+ * to about 9% without storing every value.
+ */
+class latency_histogram
+{
+public:
+    void add(const std::chrono::steady_clock::duration elapsed)
+    {
+        add(std::chrono::duration<double>(elapsed).count());
+    }
+
+    void add(const double seconds)
+    {
+        const double ns = std::max(seconds * 1e9, 1.0);
+        const size_t bucket =
+            std::min<size_t>(size_t(std::log2(ns) * BUCKETS_PER_OCTAVE), NUM_BUCKETS - 1);
+        _buckets[bucket]++;
+        _count++;
+        _max_ns = std::max(_max_ns, ns);
+    }
+
+    size_t count() const
+    {
+        return _count;
+    }
+
+    //! Upper bound of the bucket that holds the \p fraction percentile, in us
+    double percentile(const double fraction) const
+    {
+        const size_t rank = size_t(std::ceil(fraction * _count));
+        size_t seen       = 0;
+        for (size_t i = 0; i < NUM_BUCKETS; i++) {
+            seen += _buckets[i];
+            if (seen >= rank and seen > 0) {
+                return std::min(_upper_ns(i), _max_ns) / 1e3;
+            }
+        }
+        return _max_ns / 1e3;
+    }
+
+    //! Largest value, in us
+    double max() const
+    {
+        return _max_ns / 1e3;
+    }
+
+    void merge(const latency_histogram& other)
+    {
+        for (size_t i = 0; i < NUM_BUCKETS; i++) {
+            _buckets[i] += other._buckets[i];
+        }
+        _count += other._count;
+        _max_ns = std::max(_max_ns, other._max_ns);
+    }
+
+    //! Print the number of values per octave as a bar graph
+    void print(std::ostream& out) const
+    {
+        std::array<size_t, NUM_BUCKETS / BUCKETS_PER_OCTAVE> octaves{};
+        for (size_t i = 0; i < NUM_BUCKETS; i++) {
+            octaves[i / BUCKETS_PER_OCTAVE] += _buckets[i];
+        }
+        const auto first = std::find_if(
+            octaves.begin(), octaves.end(), [](const size_t n) { return n > 0; });
+        const auto last = std::find_if(
+            octaves.rbegin(), octaves.rend(), [](const size_t n) { return n > 0; });
+        if (first == octaves.end()) {
+            return;
+        }
+        const size_t most = *std::max_element(octaves.begin(), octaves.end());
+        for (auto it = first; it != last.base(); ++it) {
+            const size_t octave = it - octaves.begin();
+            out << boost::format("    %9.1f us - %9.1f us: %-40s %u\n")
+                       % (std::exp2(octave) / 1e3) % (std::exp2(octave + 1) / 1e3)
+                       % std::string(40 * *it / most, '#') % *it;
+        }
+    }
+
+private:
+    static constexpr size_t BUCKETS_PER_OCTAVE = 8;
+    //! Up to 2^32 ns, i.e. about four seconds
+    static constexpr size_t NUM_BUCKETS = 32 * BUCKETS_PER_OCTAVE;
+
+    static double _upper_ns(const size_t bucket)
+    {
+        return std::exp2(double(bucket + 1) / BUCKETS_PER_OCTAVE);
+    }
+
+    std::array<size_t, NUM_BUCKETS> _buckets{};
+    size_t _count  = 0;
+    double _max_ns = 0.0;
+};
+
+#endif /* LATENCY_HISTOGRAM_HPP */
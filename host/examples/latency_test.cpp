@@ -5,107 +5,99 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 //
 
+#include "latency_histogram.hpp"
 #include <uhd/usrp/multi_usrp.hpp>
 #include <uhd/utils/safe_main.hpp>
 #include <uhd/utils/thread.hpp>
+#include <boost/algorithm/string.hpp>
 #include <boost/format.hpp>
 #include <boost/program_options.hpp>
+#include <chrono>
 #include <complex>
+#include <fstream>
 #include <iostream>
 
 namespace po = boost::program_options;
 
-int UHD_SAFE_MAIN(int argc, char* argv[])
-{
-    uhd::set_thread_priority_safe();
+namespace {
 
-    // variables to be set by po
-    std::string args;
-    size_t nsamps;
-    double rate;
+//! Outcome of all runs with one RTT value
+struct rtt_result_t
+{
     double rtt;
-    size_t nruns;
+    size_t ack        = 0;
+    size_t time_error = 0;
+    size_t underflow  = 0;
+    size_t other      = 0;
+    size_t timeout    = 0;
+};
 
-    // setup the program options
-    po::options_description desc("Allowed options");
-    // clang-format off
-    desc.add_options()
-        ("help", "help message")
-        ("args",   po::value<std::string>(&args)->default_value(""), "single uhd device address args")
-        ("nsamps", po::value<size_t>(&nsamps)->default_value(100),   "number of samples per run")
-        ("nruns",  po::value<size_t>(&nruns)->default_value(1000),   "number of tests to perform")
-        ("rtt",    po::value<double>(&rtt)->default_value(0.001),    "delay between receive and transmit (seconds)")
-        ("rate",   po::value<double>(&rate)->default_value(100e6/4), "sample rate for receive and transmit (sps)")
-        ("from-eob", "specify to define rtt to not include the time to clock out the RX samples (removes dependence on nsamps and rate)")
-        ("verbose", "specify to enable inner-loop verbose")
-    ;
-    // clang-format on
-    po::variables_map vm;
-    po::store(po::parse_command_line(argc, argv, desc), vm);
-    po::notify(vm);
-
-    // print the help message
-    if (vm.count("help")) {
-        std::cout << boost::format("UHD - Latency Test %s") % desc << std::endl;
-        std::cout
-            << "    Latency test receives a packet at time t,\n"
-               "    and tries to send a packet at time t + rtt,\n"
-               "    where rtt is the round trip time sample time\n"
-               "    from device to host and back to the device.\n"
-               "    This can be used to test latency between UHD and the device.\n"
-               "    If the value rtt is chosen too small, the transmit packet will.\n"
-               "    arrive too late at the device indicate an error.\n"
-               "    The smallest value of rtt that does not indicate an error is an\n"
-               "    approximation for the time it takes for a sample packet to\n"
-               "    go to UHD and back to the device."
-            << std::endl;
-        return EXIT_SUCCESS;
+//! Split a comma separated list, or expand a start:stop:step range
+std::vector<double> parse_values(const std::string& list)
+{
+    std::vector<double> values;
+    std::vector<std::string> items;
+    boost::split(items, list, boost::is_any_of(","), boost::token_compress_on);
+    for (const std::string& item : items) {
+        std::vector<std::string> range;
+        boost::split(range, item, boost::is_any_of(":"));
+        if (range.size() == 3) {
+            const double start = std::stod(range[0]);
+            const double stop  = std::stod(range[1]);
+            const double step  = std::stod(range[2]);
+            if (step <= 0) {
+                throw std::runtime_error("Invalid range step: " + item);
+            }
+            for (size_t i = 0; start + i * step <= stop * (1 + 1e-9); i++) {
+                values.push_back(start + i * step);
+            }
+        } else if (not boost::trim_copy(item).empty()) {
+            values.push_back(std::stod(item));
+        }
     }
+    return values;
+}
 
-    bool verbose  = vm.count("verbose") != 0;
-    bool from_eob = vm.count("from-eob") != 0;
-
-    // create a usrp device
-    std::cout << std::endl;
-    // std::cout << boost::format("Creating the usrp device with: %s...") % args <<
-    // std::endl;
-    uhd::usrp::multi_usrp::sptr usrp = uhd::usrp::multi_usrp::make(args);
-    // std::cout << boost::format("Using Device: %s") % usrp->get_pp_string() <<
-    // std::endl;
-
-    usrp->set_time_now(uhd::time_spec_t(0.0));
+void count_async_msg(const uhd::async_metadata_t& async_md, rtt_result_t& result)
+{
+    switch (async_md.event_code) {
+        case uhd::async_metadata_t::EVENT_CODE_TIME_ERROR:
+            result.time_error++;
+            break;
 
-    // set the tx sample rate
-    usrp->set_tx_rate(rate);
-    std::cout << boost::format("Actual TX Rate: %f Msps...") % (usrp->get_tx_rate() / 1e6)
-              << std::endl;
+        case uhd::async_metadata_t::EVENT_CODE_BURST_ACK:
+            result.ack++;
+            break;
 
-    // set the rx sample rate
-    usrp->set_rx_rate(rate);
-    double actual_rx_rate = usrp->get_rx_rate();
-    std::cout << boost::format("Actual RX Rate: %f Msps...") % (actual_rx_rate / 1e6)
-              << std::endl;
+        case uhd::async_metadata_t::EVENT_CODE_UNDERFLOW:
+            result.underflow++;
+            break;
 
-    double rx_time = nsamps / actual_rx_rate;
-    if (from_eob) {
-        std::cout << boost::format("Will add %f seconds to timespec for RX samples...")
-                         % (rx_time)
-                  << std::endl;
+        default:
+            std::cerr << boost::format("failed:\n    Got unexpected event code 0x%x.\n")
+                             % async_md.event_code
+                      << std::endl;
+            result.other++;
+            break;
     }
+}
 
-    // allocate a buffer to use
-    std::vector<std::complex<float>> buffer(nsamps);
-
-    // create RX and TX streamers
-    uhd::stream_args_t stream_args("fc32"); // complex floats
-    uhd::rx_streamer::sptr rx_stream = usrp->get_rx_stream(stream_args);
-    uhd::tx_streamer::sptr tx_stream = usrp->get_tx_stream(stream_args);
-
-    // initialize result counts
-    int time_error = 0;
-    int ack        = 0;
-    int underflow  = 0;
-    int other      = 0;
+/*!
+ * Receive a packet and send it back \p rtt later, \p nruns times, and count
+ * the async messages of the sent packets.
+ */
+rtt_result_t run_rtt(uhd::usrp::multi_usrp::sptr usrp,
+    uhd::rx_streamer::sptr rx_stream,
+    uhd::tx_streamer::sptr tx_stream,
+    std::vector<std::complex<float>>& buffer,
+    const double rtt,
+    const size_t nruns,
+    const bool verbose,
+    latency_histogram& host_lat,
+    latency_histogram& host_turnaround)
+{
+    rtt_result_t result;
+    result.rtt = rtt;
 
     for (size_t nrun = 0; nrun < nruns; nrun++) {
         /***************************************************************
@@ -122,6 +114,13 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
          **************************************************************/
         uhd::rx_metadata_t rx_md;
         size_t num_rx_samps = rx_stream->recv(&buffer.front(), buffer.size(), rx_md);
+        const auto recv_done = std::chrono::steady_clock::now();
+        if (rx_md.has_host_time_spec) {
+            const double now = std::chrono::duration<double>(
+                std::chrono::system_clock::now().time_since_epoch())
+                                   .count();
+            host_lat.add(now - rx_md.host_time_spec.get_real_secs());
+        }
 
         if (verbose) {
             std::cout << boost::format(
@@ -129,7 +128,7 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
                              % nrun % num_rx_samps % rx_md.time_spec.get_full_secs()
                              % rx_md.time_spec.get_frac_secs()
                       << std::endl;
-        } else {
+        } else if (nrun % 100 == 0) {
             std::cout << "." << std::flush;
         }
 
@@ -141,10 +140,10 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
         tx_md.end_of_burst   = true;
         tx_md.has_time_spec  = true;
         tx_md.time_spec      = rx_md.time_spec + uhd::time_spec_t(rtt);
-        if (from_eob) {
-            tx_md.time_spec += uhd::time_spec_t(rx_time);
-        }
-        size_t num_tx_samps = tx_stream->send(&buffer.front(), buffer.size(), tx_md);
+        size_t num_tx_samps  = tx_stream->send(&buffer.front(), buffer.size(), tx_md);
+        host_turnaround.add(
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - recv_done)
+                .count());
         if (verbose) {
             std::cout << boost::format("Sent %d samples") % num_tx_samps << std::endl;
         }
@@ -156,73 +155,286 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
         if (not tx_stream->recv_async_msg(async_md)) {
             std::cout << boost::format("failed:\n    Async message recv timed out.\n")
                       << std::endl;
+            result.timeout++;
             continue;
         }
-        switch (async_md.event_code) {
-            case uhd::async_metadata_t::EVENT_CODE_TIME_ERROR:
-                time_error++;
-                break;
-
-            case uhd::async_metadata_t::EVENT_CODE_BURST_ACK:
-                ack++;
-                break;
-
-            case uhd::async_metadata_t::EVENT_CODE_UNDERFLOW:
-                underflow++;
-                break;
-
-            default:
-                std::cerr << boost::format(
-                                 "failed:\n    Got unexpected event code 0x%x.\n")
-                                 % async_md.event_code
-                          << std::endl;
-                other++;
-                break;
-        }
+        count_async_msg(async_md, result);
     }
 
-    while (true) {
-        uhd::async_metadata_t async_md;
-        if (not tx_stream->recv_async_msg(async_md)) {
-            break;
-        }
-        switch (async_md.event_code) {
-            case uhd::async_metadata_t::EVENT_CODE_TIME_ERROR:
-                time_error++;
-                break;
-
-            case uhd::async_metadata_t::EVENT_CODE_BURST_ACK:
-                ack++;
-                break;
-
-            case uhd::async_metadata_t::EVENT_CODE_UNDERFLOW:
-                underflow++;
-                break;
-
-            default:
-                std::cerr << boost::format(
-                                 "failed:\n    Got unexpected event code 0x%x.\n")
-                                 % async_md.event_code
-                          << std::endl;
-                other++;
-                break;
-        }
+    uhd::async_metadata_t async_md;
+    while (tx_stream->recv_async_msg(async_md)) {
+        count_async_msg(async_md, result);
     }
     if (!verbose) {
         std::cout << std::endl;
     }
+    return result;
+}
+
+/*!
+ * The turnaround latency percentiles are the smallest RTTs whose fraction of
+ * late packets was at most 1 - percentile. Returns a negative value if no RTT
+ * was large enough.
+ */
+double get_rtt_percentile(const std::vector<rtt_result_t>& results,
+    const size_t nruns,
+    const double fraction)
+{
+    for (const rtt_result_t& result : results) {
+        const size_t late = nruns - result.ack;
+        if (late <= (1.0 - fraction) * nruns) {
+            return result.rtt;
+        }
+    }
+    return -1.0;
+}
+
+void print_turnaround(const std::vector<rtt_result_t>& results, const size_t nruns)
+{
+    std::cout << "Turnaround latency (smallest RTT with at most that many late packets)"
+              << std::endl;
+    for (const double fraction : {0.5, 0.99, 0.999}) {
+        const double rtt = get_rtt_percentile(results, nruns, fraction);
+        std::cout << boost::format("p%-6g           ") % (fraction * 100);
+        if (rtt < 0) {
+            std::cout << "> " << (results.back().rtt * 1e3) << " ms";
+        } else {
+            std::cout << (rtt * 1e3) << " ms";
+        }
+        std::cout << std::endl;
+    }
+    std::cout << std::endl;
+}
 
-    /***************************************************************
-     * Print the summary
-     **************************************************************/
-    std::cout << "Summary\n"
-              << "================\n"
-              << "Number of runs:   " << nruns << std::endl
-              << "RTT value tested: " << (rtt * 1e3) << " ms" << std::endl
-              << "ACKs received:    " << ack << "/" << nruns << std::endl
-              << "Underruns:        " << underflow << std::endl
-              << "Late packets:     " << time_error << std::endl
-              << "Other errors:     " << other << std::endl
+void print_host_latency(
+    const std::string& name, const latency_histogram& latency, const bool histogram)
+{
+    if (latency.count() == 0) {
+        return;
+    }
+    std::cout << name << "\n"
+              << boost::format("p50 %.1f us, p99 %.1f us, p99.9 %.1f us, max %.1f us")
+                     % latency.percentile(0.5) % latency.percentile(0.99)
+                     % latency.percentile(0.999) % latency.max()
               << std::endl;
+    if (histogram) {
+        latency.print(std::cout);
+    }
+    std::cout << std::endl;
+}
+
+} // namespace
+
+int UHD_SAFE_MAIN(int argc, char* argv[])
+{
+    // variables to be set by po
+    std::string args_list;
+    size_t nsamps;
+    double rate;
+    double rtt;
+    size_t nruns;
+    std::string rates_list, rtts_list, spps_list, policies_list, cpu_list, csv_file;
+    float priority;
+
+    // setup the program options
+    po::options_description desc("Allowed options");
+    // clang-format off
+    desc.add_options()
+        ("help", "help message")
+        ("args",   po::value<std::string>(&args_list)->default_value(""), "single uhd device address args, or a list separated by ';' to compare transports")
+        ("nsamps", po::value<size_t>(&nsamps)->default_value(100),   "number of samples per run")
+        ("nruns",  po::value<size_t>(&nruns)->default_value(1000),   "number of tests to perform")
+        ("rtt",    po::value<double>(&rtt)->default_value(0.001),    "delay between receive and transmit (seconds)")
+        ("rate",   po::value<double>(&rate)->default_value(100e6/4), "sample rate for receive and transmit (sps)")
+        ("rtts",   po::value<std::string>(&rtts_list), "RTT values to sweep (seconds), as a list (e.g. 0.0005,0.001) or a range (start:stop:step); overrides --rtt")
+        ("rates",  po::value<std::string>(&rates_list), "sample rates to sweep (sps); overrides --rate")
+        ("spps",   po::value<std::string>(&spps_list)->default_value("0"), "samples per packet to sweep (0: driver default)")
+        ("policies", po::value<std::string>(&policies_list)->default_value("rt"), "thread policies to sweep: rt (realtime scheduling), normal")
+        ("priority", po::value<float>(&priority)->default_value(uhd::default_thread_priority), "thread priority for the rt policy (0 to 1)")
+        ("cpu",    po::value<std::string>(&cpu_list)->default_value(""), "CPUs to pin the test thread to (e.g. 2 or 2,3)")
+        ("csv",    po::value<std::string>(&csv_file), "write the result of every configuration and RTT to this CSV file")
+        ("from-eob", "specify to define rtt to not include the time to clock out the RX samples (removes dependence on nsamps and rate)")
+        ("histogram", "print histograms of the host side latencies")
+        ("verbose", "specify to enable inner-loop verbose")
+    ;
+    // clang-format on
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    // print the help message
+    if (vm.count("help")) {
+        std::cout << boost::format("UHD - Latency Test %s") % desc << std::endl;
+        std::cout
+            << "    Latency test receives a packet at time t,\n"
+               "    and tries to send a packet at time t + rtt,\n"
+               "    where rtt is the round trip time sample time\n"
+               "    from device to host and back to the device.\n"
+               "    This can be used to test latency between UHD and the device.\n"
+               "    If the value rtt is chosen too small, the transmit packet will.\n"
+               "    arrive too late at the device indicate an error.\n"
+               "    The smallest value of rtt that does not indicate an error is an\n"
+               "    approximation for the time it takes for a sample packet to\n"
+               "    go to UHD and back to the device.\n"
+               "\n"
+               "    With a list of RTT values (--rtts), the fraction of late packets\n"
+               "    per RTT is the distribution of the turnaround latency. The test\n"
+               "    then reports the p50, p99 and p99.9 turnaround latency, i.e. the\n"
+               "    smallest RTTs with at most 50%, 1% and 0.1% late packets. Use\n"
+               "    --nruns 10000 or more for a meaningful p99.9. The test can sweep\n"
+               "    the sample rate, the samples per packet, the device args (e.g. to\n"
+               "    compare transports) and the thread policy, and reports every\n"
+               "    combination.\n"
+               "    Example: latency_test --args \"addr=192.168.10.2;resource=RIO0\"\n"
+               "             --rtts 0.0002:0.002:0.0001 --spps 0,64 --nruns 10000"
+            << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    const bool verbose        = vm.count("verbose") != 0;
+    const bool from_eob       = vm.count("from-eob") != 0;
+    const bool histogram      = vm.count("histogram") != 0;
+    const std::vector<double> rtts =
+        vm.count("rtts") ? parse_values(rtts_list) : std::vector<double>{rtt};
+    const std::vector<double> rates =
+        vm.count("rates") ? parse_values(rates_list) : std::vector<double>{rate};
+    const std::vector<double> spps = parse_values(spps_list);
+    std::vector<std::string> args_strs, policies;
+    boost::split(args_strs, args_list, boost::is_any_of(";"));
+    boost::split(policies, policies_list, boost::is_any_of(","));
+    if (rtts.empty() or rates.empty() or spps.empty()) {
+        std::cerr << "ERROR: Empty list of RTTs, rates or spps." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::vector<size_t> cpus;
+    for (const double cpu : parse_values(cpu_list)) {
+        cpus.push_back(size_t(cpu));
+    }
+    uhd::set_thread_affinity(cpus);
+
+    std::ofstream csv;
+    if (vm.count("csv")) {
+        csv.open(csv_file);
+        csv << "args,rate,spp,policy,rtt,runs,acks,late,underflows,other,timeouts\n";
+    }
+
+    for (const std::string& args : args_strs) {
+        // create a usrp device
+        std::cout << std::endl;
+        uhd::usrp::multi_usrp::sptr usrp = uhd::usrp::multi_usrp::make(args);
+
+        for (const std::string& policy : policies) {
+            if (policy == "rt") {
+                uhd::set_thread_priority_safe(priority, true);
+            } else if (policy == "normal") {
+                uhd::set_thread_priority_safe(0.0, false);
+            } else {
+                std::cerr << "ERROR: Unknown thread policy " << policy << std::endl;
+                return EXIT_FAILURE;
+            }
+
+            for (const double config_rate : rates) {
+                usrp->set_time_now(uhd::time_spec_t(0.0));
+
+                // set the tx sample rate
+                usrp->set_tx_rate(config_rate);
+                std::cout << boost::format("Actual TX Rate: %f Msps...")
+                                 % (usrp->get_tx_rate() / 1e6)
+                          << std::endl;
+
+                // set the rx sample rate
+                usrp->set_rx_rate(config_rate);
+                double actual_rx_rate = usrp->get_rx_rate();
+                std::cout << boost::format("Actual RX Rate: %f Msps...")
+                                 % (actual_rx_rate / 1e6)
+                          << std::endl;
+
+                double rx_time = nsamps / actual_rx_rate;
+                if (from_eob) {
+                    std::cout << boost::format(
+                                     "Will add %f seconds to timespec for RX samples...")
+                                     % (rx_time)
+                              << std::endl;
+                }
+
+                for (const double spp : spps) {
+                    // allocate a buffer to use
+                    std::vector<std::complex<float>> buffer(nsamps);
+
+                    // create RX and TX streamers
+                    uhd::stream_args_t stream_args("fc32"); // complex floats
+                    if (spp > 0) {
+                        stream_args.args["spp"] = std::to_string(size_t(spp));
+                    }
+                    uhd::rx_streamer::sptr rx_stream = usrp->get_rx_stream(stream_args);
+                    uhd::tx_streamer::sptr tx_stream = usrp->get_tx_stream(stream_args);
+
+                    // host stack latency, if the transport captures arrival times
+                    latency_histogram host_lat;
+                    // time from recv() returning to send() returning
+                    latency_histogram host_turnaround;
+                    std::vector<rtt_result_t> results;
+
+                    for (const double config_rtt : rtts) {
+                        const rtt_result_t result = run_rtt(usrp,
+                            rx_stream,
+                            tx_stream,
+                            buffer,
+                            config_rtt + (from_eob ? rx_time : 0.0),
+                            nruns,
+                            verbose,
+                            host_lat,
+                            host_turnaround);
+                        results.push_back(result);
+                        results.back().rtt = config_rtt;
+
+                        if (csv.is_open()) {
+                            csv << boost::format(
+                                       "\"%s\",%f,%u,%s,%g,%u,%u,%u,%u,%u,%u\n")
+                                       % args % usrp->get_rx_rate() % size_t(spp)
+                                       % policy % config_rtt % nruns % result.ack
+                                       % result.time_error % result.underflow
+                                       % result.other % result.timeout;
+                        }
+                    }
+
+                    /***********************************************************
+                     * Print the summary
+                     **********************************************************/
+                    std::cout << "Summary\n"
+                              << "================\n"
+                              << "Device args:      " << args << std::endl
+                              << "Sample rate:      " << (usrp->get_rx_rate() / 1e6)
+                              << " Msps" << std::endl
+                              << "Samples/packet:   "
+                              << (spp > 0 ? std::to_string(size_t(spp)) : "default")
+                              << std::endl
+                              << "Thread policy:    " << policy << std::endl
+                              << "Number of runs:   " << nruns << std::endl;
+                    for (const rtt_result_t& result : results) {
+                        std::cout << "RTT value tested: " << (result.rtt * 1e3) << " ms"
+                                  << std::endl
+                                  << "ACKs received:    " << result.ack << "/" << nruns
+                                  << std::endl
+                                  << "Underruns:        " << result.underflow
+                                  << std::endl
+                                  << "Late packets:     " << result.time_error
+                                  << std::endl
+                                  << "Other errors:     " << result.other << std::endl;
+                    }
+                    std::cout << std::endl;
+                    print_turnaround(results, nruns);
+                    print_host_latency("Host turnaround (recv() return to send() return)",
+                        host_turnaround,
+                        histogram);
+                    print_host_latency(
+                        "Host stack latency (packet arrival to recv() return)",
+                        host_lat,
+                        histogram);
+                }
+            }
+        }
+    }
     return EXIT_SUCCESS;
 }
@@ -17,7 +17,6 @@
 #include <boost/format.hpp>
 #include <boost/program_options.hpp>
 #include <csignal>
-#include <fstream>
 #include <thread>
 
 
@@ -55,7 +54,7 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
     ///////////////////////////////////////////////////////////////////////////
     // Handle command line options
 
-    std::string args, radio_args, file, ant, ref;
+    std::string args, radio_args, file, ant, ref, player_args;
     double rate, freq, gain, bw;
     size_t radio_id, radio_chan, replay_id, replay_chan, nsamps;
 
@@ -71,6 +70,7 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
         ("replay_chan", po::value<size_t>(&replay_chan)->default_value(0), "replay channel to use")
         ("nsamps", po::value<size_t>(&nsamps)->default_value(0), "number of samples to play (0 for infinite)")
         ("file", po::value<std::string>(&file)->default_value("usrp_samples.dat"), "name of the file to read binary samples from")
+        ("player-args", po::value<std::string>(&player_args)->default_value(""), "file player args (e.g. \"mode=read\")")
         ("freq", po::value<double>(&freq), "RF center frequency in Hz")
         ("rate", po::value<double>(&rate), "rate of radio block")
         ("gain", po::value<double>(&gain), "gain for the RF chain")
@@ -205,7 +205,6 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
     uhd::device_addr_t streamer_args;
     uhd::stream_args_t stream_args(cpu_format, wire_format);
     uhd::tx_streamer::sptr tx_stream;
-    uhd::tx_metadata_t tx_md;
 
     streamer_args["block_id"]   = replay_ctrl->get_block_id().to_string();
     streamer_args["block_port"] = str(boost::format("%d") % replay_chan);
@@ -227,46 +226,29 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
 
 
     ///////////////////////////////////////////////////////////////////////////
-    // Read the data to replay
+    // Record the file into the Replay block
 
-    // Open the file
-    std::ifstream infile(file.c_str(), std::ifstream::binary);
-    if (!infile.is_open()) {
-        std::cerr << "Could not open specified file" << std::endl;
+    // Set samples per packet for Replay block playback
+    replay_ctrl->set_words_per_packet(replay_spp / samples_per_word, replay_chan);
+
+    // Upload the file into a buffer in the on-board memory at address 0. The
+    // file is rounded down to a multiple of 64-bit words, and the play buffer
+    // is set to the same region. Note that it is allowed to playback a
+    // different size or location from what was recorded.
+    cout << "Sending data to be recorded..." << endl;
+    uint32_t bytes_to_replay;
+    try {
+        bytes_to_replay = replay_ctrl->upload_file(
+            tx_stream, file, 0, replay_chan, uhd::device_addr_t(player_args));
+    } catch (const uhd::exception& ex) {
+        std::cerr << "Could not upload specified file: " << ex.what() << std::endl;
         return EXIT_FAILURE;
     }
 
-    // Get the file size
-    infile.seekg(0, std::ios::end);
-    size_t file_size = infile.tellg();
-    infile.seekg(0, std::ios::beg);
-
     // Calculate the number of 64-bit words and samples to replay
-    size_t words_to_replay   = file_size / replay_word_size;
+    size_t words_to_replay   = size_t(bytes_to_replay / replay_word_size);
     size_t samples_to_replay = words_to_replay * replay_word_size / bytes_per_sample;
 
-    // Create buffer
-    std::vector<char> tx_buffer(words_to_replay * replay_word_size);
-    char* tx_buf_ptr = &tx_buffer[0];
-
-    // Read file into buffer, rounded down to number of words
-    infile.read(tx_buf_ptr, words_to_replay * replay_word_size);
-    infile.close();
-
-
-    ///////////////////////////////////////////////////////////////////////////
-    // Configure replay block
-
-    // Configure a buffer in the on-board memory at address 0 that's equal in
-    // size to the file we want to play back (rounded down to a multiple of
-    // 64-bit words). Note that it is allowed to playback a different size or
-    // location from what was recorded.
-    replay_ctrl->config_record(0, words_to_replay * replay_word_size, replay_chan);
-    replay_ctrl->config_play(0, words_to_replay * replay_word_size, replay_chan);
-
-    // Set samples per packet for Replay block playback
-    replay_ctrl->set_words_per_packet(replay_spp / samples_per_word, replay_chan);
-
     // Display replay configuration
     cout << boost::format("Replay file size:     %d bytes (%d qwords, %d samples)")
                 % (words_to_replay * replay_word_size) % words_to_replay
@@ -289,51 +271,6 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
                 % replay_ctrl->get_play_size(replay_chan)
          << endl;
 
-    // Restart record buffer repeatedly until no new data appears on the Replay
-    // block's input. This will flush any data that was buffered on the input.
-    uint32_t fullness;
-    cout << boost::format("Restarting record buffer...") << endl;
-    do {
-        std::chrono::system_clock::time_point start_time;
-        std::chrono::system_clock::duration time_diff;
-
-        replay_ctrl->record_restart(replay_chan);
-
-        // Make sure the record buffer doesn't start to fill again
-        start_time = std::chrono::system_clock::now();
-        do {
-            fullness = replay_ctrl->get_record_fullness(replay_chan);
-            if (fullness != 0)
-                break;
-            time_diff = std::chrono::system_clock::now() - start_time;
-            time_diff = std::chrono::duration_cast<std::chrono::milliseconds>(time_diff);
-        } while (time_diff.count() < 250);
-    } while (fullness);
-
-
-    ///////////////////////////////////////////////////////////////////////////
-    // Send data to replay (record the data)
-
-    cout << "Sending data to be recorded..." << endl;
-    tx_md.start_of_burst = true;
-    tx_md.end_of_burst   = true;
-    size_t num_tx_samps  = tx_stream->send(tx_buf_ptr, samples_to_replay, tx_md);
-
-    if (num_tx_samps != samples_to_replay) {
-        cout << boost::format("ERROR: Unable to send %d samples") % samples_to_replay
-             << endl;
-        return EXIT_FAILURE;
-    }
-
-
-    ///////////////////////////////////////////////////////////////////////////
-    // Wait for data to be stored in on-board memory
-
-    cout << "Waiting for recording to complete..." << endl;
-    while (replay_ctrl->get_record_fullness(replay_chan)
-           < words_to_replay * replay_word_size)
-        ;
-
 
     ///////////////////////////////////////////////////////////////////////////
     // Start replay of data
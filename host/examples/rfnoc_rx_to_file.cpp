@@ -21,14 +21,15 @@
 #include <uhd/rfnoc/source_block_ctrl_base.hpp>
 #include <uhd/types/sensors.hpp>
 #include <uhd/types/tune_request.hpp>
+#include <uhd/utils/file_recorder.hpp>
 #include <uhd/utils/safe_main.hpp>
 #include <uhd/utils/thread.hpp>
 #include <boost/format.hpp>
 #include <boost/program_options.hpp>
+#include <algorithm>
 #include <chrono>
 #include <complex>
 #include <csignal>
-#include <fstream>
 #include <iostream>
 #include <thread>
 
@@ -45,6 +46,7 @@ void sig_int_handler(int)
 template <typename samp_type>
 void recv_to_file(uhd::rx_streamer::sptr rx_stream,
     const std::string& file,
+    const std::string& recorder_args,
     const size_t samps_per_buff,
     const double rx_rate,
     const unsigned long long num_requested_samples,
@@ -57,10 +59,13 @@ void recv_to_file(uhd::rx_streamer::sptr rx_stream,
     unsigned long long num_total_samps = 0;
 
     uhd::rx_metadata_t md;
+    // The recorder writes the file on a separate thread, so a slow disk
+    // doesn't stall the receive loop. Without a file, we receive into buff.
     std::vector<samp_type> buff(samps_per_buff);
-    std::ofstream outfile;
+    std::vector<void*> buffs{&buff.front()};
+    uhd::file_recorder::sptr recorder;
     if (not file.empty()) {
-        outfile.open(file.c_str(), std::ofstream::binary);
+        recorder = uhd::file_recorder::make({file}, sizeof(samp_type), recorder_args);
     }
     bool overflow_message = true;
 
@@ -92,8 +97,19 @@ void recv_to_file(uhd::rx_streamer::sptr rx_stream,
            and (time_requested == 0.0 or std::chrono::steady_clock::now() <= stop_time)) {
         const auto now = std::chrono::steady_clock::now();
 
+        size_t num_buff_samps = samps_per_buff;
+        if (recorder) {
+            const size_t num_bytes = recorder->get_buffs(buffs, 1.0);
+            if (num_bytes == 0) {
+                std::cerr << "Timeout while waiting for the disk to catch up"
+                          << std::endl;
+                continue;
+            }
+            num_buff_samps = std::min(num_buff_samps, num_bytes / sizeof(samp_type));
+        }
+
         size_t num_rx_samps =
-            rx_stream->recv(&buff.front(), buff.size(), md, 3.0, enable_size_map);
+            rx_stream->recv(buffs, num_buff_samps, md, 3.0, enable_size_map);
 
         if (md.error_code == uhd::rx_metadata_t::ERROR_CODE_TIMEOUT) {
             std::cout << boost::format("Timeout while streaming") << std::endl;
@@ -131,8 +147,8 @@ void recv_to_file(uhd::rx_streamer::sptr rx_stream,
 
         num_total_samps += num_rx_samps;
 
-        if (outfile.is_open()) {
-            outfile.write((const char*)&buff.front(), num_rx_samps * sizeof(samp_type));
+        if (recorder) {
+            recorder->commit(num_rx_samps * sizeof(samp_type));
         }
 
         if (bw_summary) {
@@ -160,8 +176,9 @@ void recv_to_file(uhd::rx_streamer::sptr rx_stream,
         num_post_samps = rx_stream->recv(&buff.front(), buff.size(), md, 3.0);
     } while (num_post_samps and md.error_code == uhd::rx_metadata_t::ERROR_CODE_NONE);
 
-    if (outfile.is_open())
-        outfile.close();
+    if (recorder) {
+        recorder->close();
+    }
 
     if (stats) {
         std::cout << std::endl;
@@ -235,7 +252,7 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
 
     // variables to be set by po
     std::string args, file, format, ant, subdev, ref, wirefmt, streamargs, radio_args,
-        block_id, block_args;
+        block_id, block_args, recorder_args;
     size_t total_num_samps, spb, radio_id, radio_chan;
     double rate, freq, gain, bw, total_time, setup_time;
 
@@ -254,6 +271,7 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
         ("stats", "show average bandwidth on exit")
         ("sizemap", "track packet size and display breakdown on exit")
         ("null", "run without writing to file")
+        ("recorder-args", po::value<std::string>(&recorder_args)->default_value(""), "file recorder args (e.g. \"num_blocks=256,direct_io\")")
         ("continue", "don't abort on a bad packet")
 
         ("args", po::value<std::string>(&args)->default_value(""), "USRP device address args")
@@ -450,6 +468,7 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
 #define recv_to_file_args() \
     (rx_stream,             \
         file,               \
+        recorder_args,      \
         spb,                \
         rate,               \
         total_num_samps,    \
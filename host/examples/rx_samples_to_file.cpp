@@ -8,15 +8,19 @@
 #include <uhd/exception.hpp>
 #include <uhd/types/tune_request.hpp>
 #include <uhd/usrp/multi_usrp.hpp>
+#include <uhd/utils/file_recorder.hpp>
 #include <uhd/utils/safe_main.hpp>
+#include <uhd/utils/sigmf_recorder.hpp>
 #include <uhd/utils/thread.hpp>
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
 #include <boost/format.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/program_options.hpp>
+#include <algorithm>
 #include <chrono>
 #include <complex>
 #include <csignal>
-#include <fstream>
 #include <iostream>
 #include <thread>
 
@@ -28,12 +32,27 @@ void sig_int_handler(int)
     stop_signal_called = true;
 }
 
+std::string generate_out_filename(
+    const std::string& base_fn, size_t n_names, size_t this_name)
+{
+    if (n_names == 1) {
+        return base_fn;
+    }
+
+    boost::filesystem::path base_fn_fp(base_fn);
+    base_fn_fp.replace_extension(boost::filesystem::path(
+        str(boost::format("%02d%s") % this_name % base_fn_fp.extension().string())));
+    return base_fn_fp.string();
+}
+
 template <typename samp_type>
 void recv_to_file(uhd::usrp::multi_usrp::sptr usrp,
     const std::string& cpu_format,
     const std::string& wire_format,
-    const size_t& channel,
+    const std::vector<size_t>& channel_nums,
     const std::string& file,
+    const std::string& recorder_args,
+    const bool sigmf,
     size_t samps_per_buff,
     unsigned long long num_requested_samples,
     double time_requested       = 0.0,
@@ -46,16 +65,43 @@ void recv_to_file(uhd::usrp::multi_usrp::sptr usrp,
     unsigned long long num_total_samps = 0;
     // create a receive streamer
     uhd::stream_args_t stream_args(cpu_format, wire_format);
-    std::vector<size_t> channel_nums;
-    channel_nums.push_back(channel);
     stream_args.channels             = channel_nums;
     uhd::rx_streamer::sptr rx_stream = usrp->get_rx_stream(stream_args);
 
     uhd::rx_metadata_t md;
-    std::vector<samp_type> buff(samps_per_buff);
-    std::ofstream outfile;
-    if (not null)
-        outfile.open(file.c_str(), std::ofstream::binary);
+    // The recorder writes the files on separate threads, so a slow disk
+    // doesn't stall the receive loop. Without a file, we receive into buff.
+    uhd::file_recorder::sptr recorder;
+    uhd::sigmf_recorder::sptr sigmf_recorder;
+    std::vector<std::vector<samp_type>> buff(
+        null ? channel_nums.size() : 0, std::vector<samp_type>(samps_per_buff));
+    std::vector<void*> buffs;
+    for (auto& chan_buff : buff) {
+        buffs.push_back(&chan_buff.front());
+    }
+    if (not null) {
+        std::vector<std::string> files;
+        for (size_t i = 0; i < channel_nums.size(); i++) {
+            files.push_back(generate_out_filename(file, channel_nums.size(), i));
+        }
+        if (sigmf) {
+            // The file names without extension are the bases of the recordings
+            uhd::sigmf_recorder::info_t info;
+            info.cpu_format = cpu_format;
+            info.rate       = usrp->get_rx_rate(channel_nums[0]);
+            info.hw         = usrp->get_mboard_name();
+            for (std::string& file : files) {
+                file = boost::filesystem::path(file).replace_extension().string();
+            }
+            sigmf_recorder = uhd::sigmf_recorder::make(files, info, recorder_args);
+            for (size_t i = 0; i < channel_nums.size(); i++) {
+                sigmf_recorder->set_freq(usrp->get_rx_freq(channel_nums[i]), i);
+            }
+        } else {
+            recorder =
+                uhd::file_recorder::make(files, sizeof(samp_type), recorder_args);
+        }
+    }
     bool overflow_message = true;
 
     // setup streaming
@@ -84,8 +130,21 @@ void recv_to_file(uhd::usrp::multi_usrp::sptr usrp,
            and (time_requested == 0.0 or std::chrono::steady_clock::now() <= stop_time)) {
         const auto now = std::chrono::steady_clock::now();
 
+        size_t num_buff_samps = samps_per_buff;
+        if (recorder or sigmf_recorder) {
+            const size_t num_bytes = sigmf_recorder
+                                         ? sigmf_recorder->get_buffs(buffs, 1.0)
+                                         : recorder->get_buffs(buffs, 1.0);
+            if (num_bytes == 0) {
+                std::cerr << "Timeout while waiting for the disk to catch up"
+                          << std::endl;
+                continue;
+            }
+            num_buff_samps = std::min(num_buff_samps, num_bytes / sizeof(samp_type));
+        }
+
         size_t num_rx_samps =
-            rx_stream->recv(&buff.front(), buff.size(), md, 3.0, enable_size_map);
+            rx_stream->recv(buffs, num_buff_samps, md, 3.0, enable_size_map);
 
         if (md.error_code == uhd::rx_metadata_t::ERROR_CODE_TIMEOUT) {
             std::cout << boost::format("Timeout while streaming") << std::endl;
@@ -101,7 +160,12 @@ void recv_to_file(uhd::usrp::multi_usrp::sptr usrp,
                            "  Dropped samples will not be written to the file.\n"
                            "  Please modify this example for your purposes.\n"
                            "  This message will not appear again.\n")
-                           % (usrp->get_rx_rate(channel) * sizeof(samp_type) / 1e6);
+                           % (usrp->get_rx_rate(channel_nums[0]) * sizeof(samp_type)
+                                 * channel_nums.size() / 1e6);
+            }
+            if (sigmf_recorder) {
+                // Marks the discontinuity in the recording
+                sigmf_recorder->commit(num_rx_samps * sizeof(samp_type), md);
             }
             continue;
         }
@@ -123,8 +187,10 @@ void recv_to_file(uhd::usrp::multi_usrp::sptr usrp,
 
         num_total_samps += num_rx_samps;
 
-        if (outfile.is_open()) {
-            outfile.write((const char*)&buff.front(), num_rx_samps * sizeof(samp_type));
+        if (sigmf_recorder) {
+            sigmf_recorder->commit(num_rx_samps * sizeof(samp_type), md);
+        } else if (recorder) {
+            recorder->commit(num_rx_samps * sizeof(samp_type));
         }
 
         if (bw_summary) {
@@ -145,8 +211,10 @@ void recv_to_file(uhd::usrp::multi_usrp::sptr usrp,
     stream_cmd.stream_mode = uhd::stream_cmd_t::STREAM_MODE_STOP_CONTINUOUS;
     rx_stream->issue_stream_cmd(stream_cmd);
 
-    if (outfile.is_open()) {
-        outfile.close();
+    if (sigmf_recorder) {
+        sigmf_recorder->close();
+    } else if (recorder) {
+        recorder->close();
     }
 
     if (stats) {
@@ -160,6 +228,16 @@ void recv_to_file(uhd::usrp::multi_usrp::sptr usrp,
         const double rate = (double)num_total_samps / actual_duration_seconds;
         std::cout << (rate / 1e6) << " Msps" << std::endl;
 
+        if (recorder or sigmf_recorder) {
+            const uhd::file_recorder::stats_t recorder_stats =
+                recorder ? recorder->get_stats() : sigmf_recorder->get_stats();
+            std::cout << boost::format("Wrote %d bytes, waited for the disk %d times, "
+                                       "at most %d blocks were queued")
+                             % recorder_stats.bytes_written % recorder_stats.num_waits
+                             % recorder_stats.max_blocks_queued
+                      << std::endl;
+        }
+
         if (enable_size_map) {
             std::cout << std::endl;
             std::cout << "Packet size map (bytes: count)" << std::endl;
@@ -218,7 +296,8 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
     uhd::set_thread_priority_safe();
 
     // variables to be set by po
-    std::string args, file, type, ant, subdev, ref, wirefmt;
+    std::string args, file, type, ant, subdev, ref, wirefmt, channel_list;
+    std::string recorder_args;
     size_t channel, total_num_samps, spb;
     double rate, freq, gain, bw, total_time, setup_time, lo_offset;
 
@@ -242,6 +321,9 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
         ("ant", po::value<std::string>(&ant), "antenna selection")
         ("subdev", po::value<std::string>(&subdev), "subdevice specification")
         ("channel", po::value<size_t>(&channel)->default_value(0), "which channel to use")
+        ("channels", po::value<std::string>(&channel_list), "which channels to use, one file per channel (e.g. \"0,1\"), overrides --channel")
+        ("recorder-args", po::value<std::string>(&recorder_args)->default_value(""), "file recorder args (e.g. \"num_blocks=256,direct_io,preallocate=1000000000\")")
+        ("sigmf", "write SigMF recordings with a time index, named like the files without extension")
         ("bw", po::value<double>(&bw), "analog frontend filter bandwidth in Hz")
         ("ref", po::value<std::string>(&ref)->default_value("internal"), "reference source (internal, external, mimo)")
         ("wirefmt", po::value<std::string>(&wirefmt)->default_value("sc16"), "wire format (sc8, sc16 or s16)")
@@ -263,8 +345,8 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
     if (vm.count("help")) {
         std::cout << boost::format("UHD RX samples to file %s") % desc << std::endl;
         std::cout << std::endl
-                  << "This application streams data from a single channel of a USRP "
-                     "device to a file.\n"
+                  << "This application streams data from one or more channels of a "
+                     "USRP device to one file per channel.\n"
                   << std::endl;
         return ~0;
     }
@@ -274,6 +356,19 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
     bool null                   = vm.count("null") > 0;
     bool enable_size_map        = vm.count("sizemap") > 0;
     bool continue_on_bad_packet = vm.count("continue") > 0;
+    bool sigmf                  = vm.count("sigmf") > 0;
+
+    std::vector<size_t> channel_nums{channel};
+    if (vm.count("channels")) {
+        std::vector<std::string> channel_strings;
+        boost::split(channel_strings, channel_list, boost::is_any_of("\"',"));
+        channel_nums.clear();
+        for (const std::string& channel_string : channel_strings) {
+            if (not channel_string.empty()) {
+                channel_nums.push_back(boost::lexical_cast<size_t>(channel_string));
+            }
+        }
+    }
 
     if (enable_size_map)
         std::cout << "Packet size tracking enabled - will only recv one packet at a time!"
@@ -299,64 +394,70 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
         std::cerr << "Please specify a valid sample rate" << std::endl;
         return ~0;
     }
-    std::cout << boost::format("Setting RX Rate: %f Msps...") % (rate / 1e6) << std::endl;
-    usrp->set_rx_rate(rate, channel);
-    std::cout << boost::format("Actual RX Rate: %f Msps...")
-                     % (usrp->get_rx_rate(channel) / 1e6)
-              << std::endl
-              << std::endl;
-
-    // set the center frequency
-    if (vm.count("freq")) { // with default of 0.0 this will always be true
-        std::cout << boost::format("Setting RX Freq: %f MHz...") % (freq / 1e6)
+    for (const size_t channel : channel_nums) {
+        std::cout << boost::format("Setting RX Rate: %f Msps...") % (rate / 1e6)
                   << std::endl;
-        std::cout << boost::format("Setting RX LO Offset: %f MHz...") % (lo_offset / 1e6)
-                  << std::endl;
-        uhd::tune_request_t tune_request(freq, lo_offset);
-        if (vm.count("int-n"))
-            tune_request.args = uhd::device_addr_t("mode_n=integer");
-        usrp->set_rx_freq(tune_request, channel);
-        std::cout << boost::format("Actual RX Freq: %f MHz...")
-                         % (usrp->get_rx_freq(channel) / 1e6)
+        usrp->set_rx_rate(rate, channel);
+        std::cout << boost::format("Actual RX Rate: %f Msps...")
+                         % (usrp->get_rx_rate(channel) / 1e6)
                   << std::endl
                   << std::endl;
-    }
 
-    // set the rf gain
-    if (vm.count("gain")) {
-        std::cout << boost::format("Setting RX Gain: %f dB...") % gain << std::endl;
-        usrp->set_rx_gain(gain, channel);
-        std::cout << boost::format("Actual RX Gain: %f dB...")
-                         % usrp->get_rx_gain(channel)
-                  << std::endl
-                  << std::endl;
-    }
+        // set the center frequency
+        if (vm.count("freq")) { // with default of 0.0 this will always be true
+            std::cout << boost::format("Setting RX Freq: %f MHz...") % (freq / 1e6)
+                      << std::endl;
+            std::cout << boost::format("Setting RX LO Offset: %f MHz...")
+                             % (lo_offset / 1e6)
+                      << std::endl;
+            uhd::tune_request_t tune_request(freq, lo_offset);
+            if (vm.count("int-n"))
+                tune_request.args = uhd::device_addr_t("mode_n=integer");
+            usrp->set_rx_freq(tune_request, channel);
+            std::cout << boost::format("Actual RX Freq: %f MHz...")
+                             % (usrp->get_rx_freq(channel) / 1e6)
+                      << std::endl
+                      << std::endl;
+        }
 
-    // set the IF filter bandwidth
-    if (vm.count("bw")) {
-        std::cout << boost::format("Setting RX Bandwidth: %f MHz...") % (bw / 1e6)
-                  << std::endl;
-        usrp->set_rx_bandwidth(bw, channel);
-        std::cout << boost::format("Actual RX Bandwidth: %f MHz...")
-                         % (usrp->get_rx_bandwidth(channel) / 1e6)
-                  << std::endl
-                  << std::endl;
-    }
+        // set the rf gain
+        if (vm.count("gain")) {
+            std::cout << boost::format("Setting RX Gain: %f dB...") % gain << std::endl;
+            usrp->set_rx_gain(gain, channel);
+            std::cout << boost::format("Actual RX Gain: %f dB...")
+                             % usrp->get_rx_gain(channel)
+                      << std::endl
+                      << std::endl;
+        }
+
+        // set the IF filter bandwidth
+        if (vm.count("bw")) {
+            std::cout << boost::format("Setting RX Bandwidth: %f MHz...") % (bw / 1e6)
+                      << std::endl;
+            usrp->set_rx_bandwidth(bw, channel);
+            std::cout << boost::format("Actual RX Bandwidth: %f MHz...")
+                             % (usrp->get_rx_bandwidth(channel) / 1e6)
+                      << std::endl
+                      << std::endl;
+        }
 
-    // set the antenna
-    if (vm.count("ant"))
-        usrp->set_rx_antenna(ant, channel);
+        // set the antenna
+        if (vm.count("ant"))
+            usrp->set_rx_antenna(ant, channel);
+    }
 
     std::this_thread::sleep_for(std::chrono::milliseconds(int64_t(1000 * setup_time)));
 
     // check Ref and LO Lock detect
     if (not vm.count("skip-lo")) {
-        check_locked_sensor(usrp->get_rx_sensor_names(channel),
-            "lo_locked",
-            [usrp, channel](const std::string& sensor_name) {
-                return usrp->get_rx_sensor(sensor_name, channel);
-            },
-            setup_time);
+        for (const size_t channel : channel_nums) {
+            check_locked_sensor(usrp->get_rx_sensor_names(channel),
+                "lo_locked",
+                [usrp, channel](const std::string& sensor_name) {
+                    return usrp->get_rx_sensor(sensor_name, channel);
+                },
+                setup_time);
+        }
         if (ref == "mimo") {
             check_locked_sensor(usrp->get_mboard_sensor_names(0),
                 "mimo_locked",
@@ -384,8 +485,10 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
     (usrp,                        \
         format,                   \
         wirefmt,                  \
-        channel,                  \
+        channel_nums,             \
         file,                     \
+        recorder_args,            \
+        sigmf,                    \
         spb,                      \
         total_num_samps,          \
         total_time,               \
@@ -5,6 +5,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 //
 
+#include <uhd/convert.hpp>
 #include <uhd/exception.hpp>
 #include <uhd/transport/udp_simple.hpp>
 #include <uhd/types/tune_request.hpp>
@@ -47,6 +48,7 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
         ("addr", po::value<std::string>(&addr)->default_value("192.168.1.10"), "resolvable server address")
         ("ref", po::value<std::string>(&ref)->default_value("internal"), "reference source (internal, external, mimo)")
         ("int-n", "tune USRP with integer-N tuning")
+        ("compress", "send losslessly compressed sc16 blocks instead of complex floats")
     ;
     // clang-format on
     po::variables_map vm;
@@ -144,7 +146,9 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
     }
 
     // create a receive streamer
-    uhd::stream_args_t stream_args("fc32"); // complex floats
+    // complex floats, or complex shorts which are compressed before sending
+    const bool compress = vm.count("compress") > 0;
+    uhd::stream_args_t stream_args(compress ? "sc16" : "fc32");
     uhd::rx_streamer::sptr rx_stream = usrp->get_rx_stream(stream_args);
 
     // setup streaming
@@ -156,12 +160,29 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
     // loop until total number of samples reached
     size_t num_acc_samps = 0; // number of accumulated samples
     uhd::rx_metadata_t md;
-    std::vector<std::complex<float>> buff(rx_stream->get_max_num_samps());
+    const size_t samp_size = compress ? sizeof(std::complex<short>)
+                                      : sizeof(std::complex<float>);
+    const size_t max_samps = rx_stream->get_max_num_samps();
+    std::vector<char> buff(max_samps * samp_size);
     uhd::transport::udp_simple::sptr udp_xport =
         uhd::transport::udp_simple::make_connected(addr, port);
 
+    // Every datagram is one self-contained compressed block, see
+    // uhd::convert::get_max_compressed_size()
+    uhd::convert::converter::sptr compressor;
+    std::vector<char> compressed;
+    if (compress) {
+        uhd::convert::id_type id;
+        id.input_format  = "sc16";
+        id.num_inputs    = 1;
+        id.output_format = "sc16_compressed";
+        id.num_outputs   = 1;
+        compressor       = uhd::convert::get_converter(id)();
+        compressed.resize(uhd::convert::get_max_compressed_size(max_samps));
+    }
+
     while (num_acc_samps < total_num_samps) {
-        size_t num_rx_samps = rx_stream->recv(&buff.front(), buff.size(), md);
+        size_t num_rx_samps = rx_stream->recv(&buff.front(), max_samps, md);
 
         // handle the error codes
         switch (md.error_code) {
@@ -183,8 +204,17 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
                 goto done_loop;
         }
 
-        // send complex single precision floating point samples over udp
-        udp_xport->send(boost::asio::buffer(buff, num_rx_samps * sizeof(buff.front())));
+        if (compressor and num_rx_samps) {
+            // send a block of compressed complex shorts over udp
+            const void* in = &buff.front();
+            void* out      = &compressed.front();
+            compressor->conv(in, out, num_rx_samps);
+            udp_xport->send(boost::asio::buffer(
+                compressed, uhd::convert::get_compressed_size(out)));
+        } else if (not compressor) {
+            // send complex single precision floating point samples over udp
+            udp_xport->send(boost::asio::buffer(buff, num_rx_samps * samp_size));
+        }
 
         num_acc_samps += num_rx_samps;
     }
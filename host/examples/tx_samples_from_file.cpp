@@ -7,14 +7,15 @@
 
 #include <uhd/types/tune_request.hpp>
 #include <uhd/usrp/multi_usrp.hpp>
+#include <uhd/utils/file_player.hpp>
 #include <uhd/utils/safe_main.hpp>
 #include <uhd/utils/thread.hpp>
 #include <boost/format.hpp>
 #include <boost/program_options.hpp>
+#include <algorithm>
 #include <chrono>
 #include <complex>
 #include <csignal>
-#include <fstream>
 #include <iostream>
 #include <thread>
 
@@ -27,27 +28,34 @@ void sig_int_handler(int)
 }
 
 template <typename samp_type>
-void send_from_file(
-    uhd::tx_streamer::sptr tx_stream, const std::string& file, size_t samps_per_buff)
+void send_from_file(uhd::tx_streamer::sptr tx_stream,
+    const std::string& file,
+    size_t samps_per_buff,
+    const uhd::device_addr_t& player_args)
 {
     uhd::tx_metadata_t md;
     md.start_of_burst = false;
     md.end_of_burst   = false;
-    std::vector<samp_type> buff(samps_per_buff);
-    std::ifstream infile(file.c_str(), std::ifstream::binary);
-
-    // loop until the entire file has been read
-
-    while (not md.end_of_burst and not stop_signal_called) {
-        infile.read((char*)&buff.front(), buff.size() * sizeof(samp_type));
-        size_t num_tx_samps = size_t(infile.gcount() / sizeof(samp_type));
-
-        md.end_of_burst = infile.eof();
-
-        tx_stream->send(&buff.front(), num_tx_samps, md);
+    // The player maps the file or reads it ahead on another thread, so send()
+    // doesn't wait for the disk
+    uhd::file_player::sptr player =
+        uhd::file_player::make({file}, sizeof(samp_type), player_args);
+    std::vector<const void*> buffs;
+
+    // loop until the entire file has been sent
+    while (not player->is_done() and not stop_signal_called) {
+        const size_t num_bytes = player->get_buffs(buffs, 1.0);
+        if (num_bytes == 0) {
+            continue;
+        }
+        const size_t num_tx_samps = tx_stream->send(
+            buffs, std::min(samps_per_buff, num_bytes / sizeof(samp_type)), md);
+        player->consume(num_tx_samps * sizeof(samp_type));
     }
 
-    infile.close();
+    // send a mini EOB packet
+    md.end_of_burst = true;
+    tx_stream->send("", 0, md);
 }
 
 int UHD_SAFE_MAIN(int argc, char* argv[])
@@ -55,7 +63,7 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
     uhd::set_thread_priority_safe();
 
     // variables to be set by po
-    std::string args, file, type, ant, subdev, ref, wirefmt, channel;
+    std::string args, file, type, ant, subdev, ref, wirefmt, channel, player_args;
     size_t spb;
     double rate, freq, gain, bw, delay, lo_offset;
 
@@ -83,6 +91,7 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
         ("delay", po::value<double>(&delay)->default_value(0.0), "specify a delay between repeated transmission of file (in seconds)")
         ("channel", po::value<std::string>(&channel)->default_value("0"), "which channel to use")
         ("repeat", "repeatedly transmit file")
+        ("player-args", po::value<std::string>(&player_args)->default_value(""), "file player args (e.g. \"mode=read,num_blocks=256\" or \"lock\")")
         ("int-n", "tune USRP with integer-n tuning")
     ;
     // clang-format on
@@ -216,14 +225,21 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
     stream_args.channels             = channel_nums;
     uhd::tx_streamer::sptr tx_stream = usrp->get_tx_stream(stream_args);
 
+    // Without a delay, the player loops over the file itself, so it doesn't
+    // have to be opened (or read) again for every repetition
+    uhd::device_addr_t file_player_args(player_args);
+    if (repeat and delay <= 0.0) {
+        file_player_args["loop"] = "";
+    }
+
     // send from file
     do {
         if (type == "double")
-            send_from_file<std::complex<double>>(tx_stream, file, spb);
+            send_from_file<std::complex<double>>(tx_stream, file, spb, file_player_args);
         else if (type == "float")
-            send_from_file<std::complex<float>>(tx_stream, file, spb);
+            send_from_file<std::complex<float>>(tx_stream, file, spb, file_player_args);
         else if (type == "short")
-            send_from_file<std::complex<short>>(tx_stream, file, spb);
+            send_from_file<std::complex<short>>(tx_stream, file, spb, file_player_args);
         else
             throw std::runtime_error("Unknown type " + type);
 
@@ -47,13 +47,10 @@ std::string db_sensors_string(
 
     for (size_t chan_idx = 0; chan_idx < num_chans; chan_idx++) {
         ss << "Chan " << chan_idx << ": " << std::endl;
-        const auto sensors = (tx_rx == "RX") ? usrp->get_rx_sensor_names(chan_idx)
-                                             : usrp->get_tx_sensor_names(chan_idx);
+        const auto sensors = (tx_rx == "RX") ? usrp->get_rx_sensors(chan_idx)
+                                             : usrp->get_tx_sensors(chan_idx);
         for (const auto& sensor : sensors) {
-            const auto sensor_value = (tx_rx == "RX")
-                                          ? usrp->get_rx_sensor(sensor, chan_idx)
-                                          : usrp->get_tx_sensor(sensor, chan_idx);
-            ss << "* " << sensor_value.to_pp_string() << std::endl;
+            ss << "* " << sensor.second.to_pp_string() << std::endl;
         }
         ss << std::endl;
     }
@@ -65,10 +62,11 @@ std::string mboard_sensors_string(multi_usrp::sptr usrp, const size_t mb_idx)
 {
     std::stringstream ss;
     ss << "Sensors for motherboard " << mb_idx << ": \n" << std::endl;
-    const auto mboard_sensors = usrp->get_mboard_sensor_names(mb_idx);
+    // Reads all sensors at once, which is a lot faster than reading them one
+    // by one on some devices
+    const auto mboard_sensors = usrp->get_mboard_sensors(mb_idx);
     for (const auto& mboard_sensor : mboard_sensors) {
-        const auto sensor_value = usrp->get_mboard_sensor(mboard_sensor, mb_idx);
-        ss << "* " << sensor_value.to_pp_string() << std::endl;
+        ss << "* " << mboard_sensor.second.to_pp_string() << std::endl;
     }
     ss << make_border(db_sensors_string("RX", usrp, mb_idx)) << std::endl;
     ss << make_border(db_sensors_string("TX", usrp, mb_idx)) << std::endl;
@@ -13,7 +13,9 @@
 #include <boost/function.hpp>
 #include <boost/operators.hpp>
 #include <boost/shared_ptr.hpp>
+#include <stdint.h>
 #include <string>
+#include <vector>
 
 namespace uhd { namespace convert {
 
@@ -50,6 +52,53 @@ private:
         const input_type& in, const output_type& out, const size_t num) = 0;
 };
 
+/*!
+ * Running sums of the samples converted by a stats_converter.
+ *
+ * The sums are in the scaled output units. The mean of the samples (the DC
+ * offset) is sum_i and sum_q over num_samps, and their mean power is sum_sq
+ * over num_samps.
+ */
+struct signal_accum_t
+{
+    //! Number of samples added
+    uint64_t num_samps = 0;
+    //! Sum of the I samples
+    double sum_i = 0.0;
+    //! Sum of the Q samples
+    double sum_q = 0.0;
+    //! Sum of I^2 + Q^2
+    double sum_sq = 0.0;
+    //! Largest magnitude of an I or Q sample
+    double peak = 0.0;
+};
+
+/*!
+ * A converter that also measures the signal it converts.
+ *
+ * The converters with an output format ending in "_stats", e.g.,
+ * "sc16_item32_le" to "fc32_stats", write the same output as the ones without
+ * the suffix. They add every sample to the accumulator in the same pass, so
+ * measuring the signal costs no second pass over the output.
+ */
+class stats_converter : public converter
+{
+public:
+    typedef boost::shared_ptr<stats_converter> sptr;
+
+    /*!
+     * Set the accumulator to add the following conversions to.
+     * \param accum the accumulator, or nullptr to not measure the samples
+     */
+    void set_accum(signal_accum_t* accum)
+    {
+        _accum = accum;
+    }
+
+protected:
+    signal_accum_t* _accum = nullptr;
+};
+
 //! Conversion factory function typedef
 typedef boost::function<converter::sptr(void)> function_type;
 
@@ -90,6 +139,30 @@ UHD_API void register_converter(
  */
 UHD_API function_type get_converter(const id_type& id, const priority_type prio = -1);
 
+/*!
+ * Get the IDs of all registered conversions.
+ * \return every ID for which get_converter() returns a converter
+ */
+UHD_API std::vector<id_type> get_converter_ids(void);
+
+/*!
+ * Enable or disable benchmark mode for get_converter().
+ *
+ * In benchmark mode, get_converter() with prio -1 times every registered
+ * converter for an ID the first time that ID is requested, and returns the
+ * fastest one instead of the one with the highest priority. The winners are
+ * remembered, and stored in the cache file if one is given, so later
+ * sessions don't have to repeat the benchmark.
+ *
+ * Benchmark mode can also be enabled by setting the UHD_CONVERT_BENCHMARK
+ * environment variable to 1 (results are stored in a per-host file in the
+ * .uhd directory of the app path) or to the path of a cache file.
+ *
+ * \param enable true to enable benchmark mode
+ * \param cache_file file to read and store results, empty for none
+ */
+UHD_API void set_benchmark_mode(const bool enable, const std::string& cache_file = "");
+
 /*!
  * Register the size of a particular item.
  * \param format the item format
@@ -100,6 +173,29 @@ UHD_API void register_bytes_per_item(const std::string& format, const size_t siz
 //! Convert an item format to a size in bytes
 UHD_API size_t get_bytes_per_item(const std::string& format);
 
+/*!
+ * Get the size of the output buffer for compressing sc16 samples.
+ *
+ * The "sc16" to "sc16_compressed" converter compresses a block of samples
+ * losslessly. The samples are delta coded and bit packed in groups of 16, so
+ * the compression is fast, and works best on oversampled or narrowband
+ * signals. The unused low bits of sc12 samples in sc16 words are not stored.
+ *
+ * Every call to the converter writes one self-contained block, which starts
+ * with its size. The "sc16_compressed" to "sc16" converter decodes one
+ * block, and must be given the number of samples in it.
+ *
+ * \param num_samps the number of samples to compress
+ * \return the largest possible size of the block in bytes
+ */
+UHD_API size_t get_max_compressed_size(const size_t num_samps);
+
+//! Get the size in bytes of a block of compressed sc16 samples
+UHD_API size_t get_compressed_size(const void* block);
+
+//! Get the number of samples in a block of compressed sc16 samples
+UHD_API size_t get_compressed_num_samps(const void* block);
+
 }} // namespace uhd::convert
 
 #endif /* INCLUDED_UHD_CONVERT_HPP */
@@ -82,6 +82,9 @@ UHD_API std::string get_c_global_error_string();
 
 UHD_API void set_c_global_error_string(const std::string &msg);
 
+//! Set the last error string to "None". This is cheap if it already is.
+UHD_API void clear_c_global_error_string();
+
 /*!
  * This macro runs the given C++ code, and if there are any exceptions
  * thrown, they are caught and converted to the corresponding UHD error
@@ -105,7 +108,7 @@ UHD_API void set_c_global_error_string(const std::string &msg);
         set_c_global_error_string("Unrecognized exception caught."); \
         return UHD_ERROR_UNKNOWN; \
     } \
-    set_c_global_error_string("None"); \
+    clear_c_global_error_string(); \
     return UHD_ERROR_NONE;
 
 /*!
@@ -137,7 +140,7 @@ UHD_API void set_c_global_error_string(const std::string &msg);
         return UHD_ERROR_UNKNOWN; \
     } \
     h->last_error = "None"; \
-    set_c_global_error_string("None"); \
+    clear_c_global_error_string(); \
     return UHD_ERROR_NONE;
 
 extern "C" {
@@ -208,6 +208,46 @@ struct fs_path : std::string
 UHD_API fs_path operator/(const fs_path&, const fs_path&);
 UHD_API fs_path operator/(const fs_path&, size_t);
 
+/*!
+ * Defers the subscribers of property sets on the calling thread.
+ *
+ * While a scope exists, set() on a property only stores the desired value.
+ * When the scope is committed, the desired subscribers, coercer and coerced
+ * subscribers of every property that was set run once, with the last value
+ * set, in the order in which the properties were first set. A bulk
+ * configuration that sets the same properties repeatedly then reconfigures
+ * the hardware only once per property.
+ *
+ * Until the commit, get() returns the previously coerced value, while
+ * get_desired() returns the last value set. Scopes may be nested; only the
+ * outermost one commits. Properties must not be destroyed while their sets
+ * are deferred.
+ */
+class UHD_API property_defer_scope : uhd::noncopyable
+{
+public:
+    property_defer_scope(void);
+
+    //! Commit, unless commit() was called. Errors are logged, not thrown.
+    ~property_defer_scope(void);
+
+    /*!
+     * Run the deferred subscribers. Errors propagate, and the sets which were
+     * not committed yet are dropped. Does nothing on nested scopes.
+     */
+    void commit(void);
+
+    /*!
+     * Internal: If sets are deferred on this thread, queue the commit function
+     * of the property at key, unless it is already queued, and return true.
+     */
+    static bool _defer(const void* key, const boost::function<void(void)>& commit_fn);
+
+private:
+    bool _outermost;
+    bool _committed;
+};
+
 /*!
  * The property tree provides a file system structure for accessing properties.
  */
@@ -243,6 +283,17 @@ public:
     template <typename T>
     property<T>& access(const fs_path& path);
 
+    /*!
+     * Get a handle to a property in the tree
+     *
+     * Unlike access(), the handle refers to the property itself, not to its
+     * path. Store it to skip the path lookup on frequently used properties.
+     * If the property is later removed from the tree, the handle keeps it
+     * alive, but it is no longer reachable through the tree.
+     */
+    template <typename T>
+    boost::shared_ptr<property<T> > access_handle(const fs_path& path);
+
     //! Pop a property off the tree, and returns the property
     template <typename T>
     boost::shared_ptr<property<T> > pop(const fs_path& path);
@@ -256,6 +307,9 @@ private:
 
     //! Internal access property with wild-card type
     virtual boost::shared_ptr<void>& _access(const fs_path& path) const = 0;
+
+    //! Internal access property with wild-card type, returning a copy
+    virtual boost::shared_ptr<void> _access_handle(const fs_path& path) const = 0;
 };
 
 } // namespace uhd
@@ -89,15 +89,8 @@ public:
     property<T>& set(const T& value)
     {
         init_or_set_value(_value, value);
-        BOOST_FOREACH (
-            typename property<T>::subscriber_type& dsub, _desired_subscribers) {
-            dsub(get_value_ref(_value)); // let errors propagate
-        }
-        if (not _coercer.empty()) {
-            _set_coerced(_coercer(get_value_ref(_value)));
-        } else {
-            if (_coerce_mode == property_tree::AUTO_COERCE)
-                uhd::assertion_error("coercer missing for an auto coerced property");
+        if (not property_defer_scope::_defer(this, [this]() { this->_commit(); })) {
+            _commit();
         }
         return *this;
     }
@@ -141,6 +134,21 @@ public:
     }
 
 private:
+    //! Run the subscribers and the coercer for the desired value
+    void _commit(void)
+    {
+        BOOST_FOREACH (
+            typename property<T>::subscriber_type& dsub, _desired_subscribers) {
+            dsub(get_value_ref(_value)); // let errors propagate
+        }
+        if (not _coercer.empty()) {
+            _set_coerced(_coercer(get_value_ref(_value)));
+        } else {
+            if (_coerce_mode == property_tree::AUTO_COERCE)
+                uhd::assertion_error("coercer missing for an auto coerced property");
+        }
+    }
+
     static T DEFAULT_COERCER(const T& value)
     {
         return value;
@@ -192,6 +200,12 @@ property<T>& property_tree::access(const fs_path& path)
     return *boost::static_pointer_cast<property<T> >(this->_access(path));
 }
 
+template <typename T>
+typename boost::shared_ptr<property<T> > property_tree::access_handle(const fs_path& path)
+{
+    return boost::static_pointer_cast<property<T> >(this->_access_handle(path));
+}
+
 template <typename T>
 typename boost::shared_ptr<property<T> > property_tree::pop(const fs_path& path)
 {
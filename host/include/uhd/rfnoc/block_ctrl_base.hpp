@@ -180,6 +180,56 @@ public:
      */
     void sr_write(const std::string& reg, const uint32_t data, const size_t port = 0);
 
+    /*! Write a sequence of values to one settings register.
+     *
+     * Identical to calling sr_write() once per value, but the commands are
+     * sent as a single pipelined batch, which only waits for as many
+     * acknowledgements as it takes to keep the command FIFO from
+     * overflowing. Use this to load coefficients and other long sequences.
+     *
+     * \param reg The settings register to write to.
+     * \param data The values to write, in order.
+     * \param port Port on which to write
+     */
+    void sr_write(
+        const uint32_t reg, const std::vector<uint32_t>& data, const size_t port = 0);
+
+    //! A settings register write at a command time, see sr_write_schedule()
+    struct timed_sr_write_t
+    {
+        //! Command time of the write, or zero for an untimed write
+        time_spec_t time;
+        uint32_t reg;
+        uint32_t data;
+    };
+
+    /*! Write a schedule of timed settings register writes.
+     *
+     * The writes are streamed to the block in order: As many are in flight as
+     * the command FIFO can hold (see get_cmd_fifo_size()), and the next ones
+     * are sent as the block acknowledges earlier ones. This way, long
+     * frequency, gain or GPIO schedules can be handed off at once without
+     * overflowing the command FIFO. The command time set with
+     * set_command_time() is not used, nor changed.
+     *
+     * Returns once the last write was acknowledged. Timed commands are
+     * acknowledged when they are executed, so this blocks until shortly
+     * before the end of the schedule.
+     *
+     * \param writes The writes, sorted by their command times
+     * \param port Port on which to write
+     */
+    void sr_write_schedule(
+        const std::vector<timed_sr_write_t>& writes, const size_t port = 0);
+
+    /*! Return the number of commands that can be in flight on a port
+     *
+     * This is the number of command packets that fit into the command FIFO of
+     * the block. More commands than this block in sr_write() until earlier
+     * ones are acknowledged.
+     */
+    size_t get_cmd_fifo_size(const size_t port = 0);
+
     /*! Allows reading one register on the settings bus (64-Bit version).
      *
      * \param reg The settings register to be read.
@@ -223,6 +273,19 @@ public:
      */
     uint64_t user_reg_read64(const std::string& reg, const size_t port = 0);
 
+    /*! Read several user-defined registers (64-Bit version).
+     *
+     * Identical to calling user_reg_read64() once per address, but all
+     * commands are sent as a single pipelined batch, so this only waits for
+     * one round trip instead of one per register.
+     *
+     * \param addrs The user register addresses.
+     * \param port Port on which to read
+     * \returns the readback values, in the same order as \p addrs.
+     */
+    std::vector<uint64_t> user_reg_read64(
+        const std::vector<uint32_t>& addrs, const size_t port = 0);
+
     /*! Allows reading one user-defined register (32-Bit version).
      *
      * This is a shorthand for setting the requested address
@@ -39,6 +39,9 @@ public:
     //! Returns the depth of the FIFO (in bytes).
     uint32_t get_depth(const size_t chan) const;
 
+    //! Returns the number of bytes currently held by the FIFO.
+    virtual uint32_t get_bytes_occupied(const size_t chan) = 0;
+
 }; /* class dma_fifo_block_ctrl*/
 
 }} /* namespace uhd::rfnoc */
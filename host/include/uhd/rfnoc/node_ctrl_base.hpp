@@ -19,7 +19,11 @@
 #include <boost/shared_ptr.hpp>
 #include <boost/utility.hpp>
 #include <map>
+#include <mutex>
 #include <set>
+#include <tuple>
+#include <typeindex>
+#include <vector>
 
 namespace uhd { namespace usrp {
 // Forward declaration for friend clause
@@ -245,6 +249,14 @@ protected:
      */
     virtual void _register_upstream_node(node_ctrl_base::sptr upstream_node, size_t port);
 
+    /*! Invalidate the cached graph searches of all nodes
+     *
+     * Call this after changing connections or port mappings. Call it with
+     * \p activity_only after toggling streamer activity, which only affects
+     * searches that are limited to active nodes.
+     */
+    static void _graph_changed(const bool activity_only = false);
+
     /*! Initiate the update graph callback
      *
      * Call this from your block when you've changed one of these:
@@ -266,6 +278,8 @@ private:
      * Depending on \p downstream, "child nodes" are either defined as
      * nodes connected downstream or upstream.
      *
+     * Results are cached until the graph changes (see _graph_changed()).
+     *
      * \param downstream Set to true if search goes downstream, false for upstream.
      */
     template <typename T, bool downstream>
@@ -300,6 +314,27 @@ private:
 
     graph_update_cb_t _graph_update_cb;
 
+    //! Return the number of changes to connections and port mappings so far
+    static uint64_t _get_topology_version();
+
+    //! Return the number of changes to streamer activity so far
+    static uint64_t _get_activity_version();
+
+    //! A cached result of _find_child_node()
+    struct search_result_t
+    {
+        uint64_t topology_version;
+        //! Zero unless the search is limited to active nodes
+        uint64_t activity_version;
+        std::vector<wptr> nodes;
+    };
+
+    //! Node type, direction and whether only active nodes were searched
+    typedef std::tuple<std::type_index, bool, bool> search_key_t;
+
+    std::mutex _search_cache_mutex;
+    std::map<search_key_t, search_result_t> _search_cache;
+
 }; /* class node_ctrl_base */
 
 }} /* namespace uhd::rfnoc */
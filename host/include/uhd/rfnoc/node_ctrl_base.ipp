@@ -13,6 +13,8 @@
 #include <uhd/exception.hpp>
 
 #include <boost/shared_ptr.hpp>
+#include <mutex>
+#include <typeinfo>
 #include <vector>
 
 namespace uhd {
@@ -22,6 +24,31 @@ namespace uhd {
     std::vector< boost::shared_ptr<T> > node_ctrl_base::_find_child_node(bool active_only)
     {
         typedef boost::shared_ptr<T> T_sptr;
+        const search_key_t search_key(std::type_index(typeid(T)), downstream, active_only);
+        // Read the versions before searching, so changes during the search
+        // invalidate its result
+        const uint64_t topology_version = _get_topology_version();
+        const uint64_t activity_version = active_only ? _get_activity_version() : 0;
+        {
+            std::lock_guard<std::mutex> lock(_search_cache_mutex);
+            const auto cached = _search_cache.find(search_key);
+            if (cached != _search_cache.end()
+                and cached->second.topology_version == topology_version
+                and cached->second.activity_version == activity_version) {
+                std::vector< T_sptr > results;
+                for (const wptr& node : cached->second.nodes) {
+                    T_sptr node_sptr = boost::dynamic_pointer_cast<T>(node.lock());
+                    if (not node_sptr) {
+                        break;
+                    }
+                    results.push_back(node_sptr);
+                }
+                // Otherwise, a node has expired since, search again
+                if (results.size() == cached->second.nodes.size()) {
+                    return results;
+                }
+            }
+        }
         static const size_t MAX_ITER = 20;
         size_t iters = 0;
         // List of return values:
@@ -109,6 +136,13 @@ namespace uhd {
         }
 
         std::vector< T_sptr > results(results_s.begin(), results_s.end());
+        {
+            std::lock_guard<std::mutex> lock(_search_cache_mutex);
+            search_result_t& result = _search_cache[search_key];
+            result.topology_version = topology_version;
+            result.activity_version = activity_version;
+            result.nodes.assign(results.begin(), results.end());
+        }
         return results;
     }
 
@@ -9,6 +9,9 @@
 
 #include <uhd/rfnoc/sink_block_ctrl_base.hpp>
 #include <uhd/rfnoc/source_block_ctrl_base.hpp>
+#include <uhd/stream.hpp>
+#include <uhd/types/device_addr.hpp>
+#include <string>
 
 namespace uhd { namespace rfnoc {
 
@@ -23,6 +26,17 @@ namespace uhd { namespace rfnoc {
  * - The storage for the replay data can be any
  *   memory, usually an off-chip DRAM.
  *
+ * Waveforms are loaded by streaming them into the block's input while it
+ * records. upload() and upload_file() do this in one call, given a TX
+ * streamer that is connected to the input of the channel:
+ * \code{.cpp}
+ * uhd::stream_args_t stream_args("sc16", "sc16");
+ * stream_args.args["block_id"]   = replay_ctrl->get_block_id().to_string();
+ * stream_args.args["block_port"] = std::to_string(chan);
+ * auto tx_stream = usrp->get_tx_stream(stream_args);
+ * const uint32_t num_bytes =
+ *     replay_ctrl->upload_file(tx_stream, "waveform.dat", 0, chan);
+ * \endcode
  */
 class UHD_RFNOC_API replay_block_ctrl : public source_block_ctrl_base,
                                         public sink_block_ctrl_base
@@ -65,6 +79,51 @@ public:
     //! Halts playback and clears the playback command FIFO
     virtual void play_halt(const size_t chan) = 0;
 
+    /*! Upload samples from host memory into the replay memory
+     *
+     * Configures a record buffer of \p num_bytes at \p base_addr, flushes
+     * stale data from the input, and streams the buffer through \p tx_stream
+     * as one burst in large chunks, so flow control keeps the transport busy.
+     * Returns when get_record_fullness() shows that all of the data is in the
+     * memory. The play buffer is then set to the same region.
+     *
+     * \param tx_stream A TX streamer connected to input \p chan of this block.
+     *                  Its samples must be 4 bytes (e.g. sc16), and its
+     *                  samples per packet a multiple of 2 (one 64-bit word).
+     * \param buff The data to upload
+     * \param num_bytes The number of bytes, a multiple of 8
+     * \param base_addr The address in the replay memory, a multiple of 8
+     * \param chan The channel of the Replay block
+     * \param timeout The timeout for each send() call and for the record
+     *                buffer to fill up, in seconds
+     * \throws uhd::value_error if the size or address are not aligned
+     * \throws uhd::io_error if the data did not arrive in the memory in time
+     */
+    virtual void upload(uhd::tx_streamer::sptr tx_stream,
+        const void* buff,
+        const uint32_t num_bytes,
+        const uint32_t base_addr,
+        const size_t chan,
+        const double timeout = 1.0) = 0;
+
+    /*! Upload a file into the replay memory
+     *
+     * Like upload(), but streams the file through uhd::file_player, so it does
+     * not have to fit into host memory. A partial word at the end of the file
+     * is dropped.
+     *
+     * \param player_args Options for uhd::file_player::make() (loop is not
+     *                    allowed)
+     * \return The number of bytes uploaded
+     * \throws uhd::os_error if the file can't be opened
+     */
+    virtual uint32_t upload_file(uhd::tx_streamer::sptr tx_stream,
+        const std::string& file,
+        const uint32_t base_addr,
+        const size_t chan,
+        const uhd::device_addr_t& player_args = uhd::device_addr_t(),
+        const double timeout = 1.0) = 0;
+
 }; /* class replay_block_ctrl*/
 
 }} /* namespace uhd::rfnoc */
@@ -0,0 +1,115 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHD_RFNOC_SPECTRUM_MONITOR_HPP
+#define INCLUDED_UHD_RFNOC_SPECTRUM_MONITOR_HPP
+
+#include <uhd/config.hpp>
+#include <uhd/device3.hpp>
+#include <uhd/rfnoc/block_id.hpp>
+#include <uhd/stream.hpp>
+#include <uhd/types/device_addr.hpp>
+#include <uhd/types/metadata.hpp>
+#include <uhd/utils/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <vector>
+
+namespace uhd { namespace rfnoc {
+
+/*!
+ * Compute power spectra on the FPGA and receive them on the host
+ *
+ * This sets up a chain of RFNoC blocks behind a source block (usually a
+ * radio or a DDC):
+ * - An FFT block, which outputs the magnitude of every bin
+ * - Optionally a VectorIIR block, which averages the spectra
+ * - Optionally a KeepOneInN block, which only passes every n-th spectrum
+ *
+ * Only the decimated spectra cross the link to the host. They are received
+ * with rx_streamer::recv_raw(), and the magnitudes are converted to dBFS
+ * straight out of the transport's memory, so no samples are copied.
+ *
+ * The blocks are taken from the source block's motherboard, and must not be
+ * connected yet. The following args control the chain:
+ * - fft_size: The number of bins, a power of two (default: 256)
+ * - averaging: The weight of the average in the VectorIIR block, between 0
+ *   and 1. Every new spectrum goes in with a weight of 1 - averaging. Set to
+ *   0 (the default) to not average.
+ * - decim: Keep one in this many spectra (default: 1, which needs no
+ *   KeepOneInN block)
+ * - fft_block, iir_block, keep_block: Hints which block to use, e.g.
+ *   "FFT_1". By default, the first free one is used.
+ *
+ * Example:
+ * \code{.cpp}
+ * auto monitor = uhd::rfnoc::spectrum_monitor::make(
+ *     device, "0/Radio_0", 0, uhd::device_addr_t("averaging=0.9,decim=64"));
+ * monitor->start();
+ * std::vector<float> power_db;
+ * uhd::rx_metadata_t md;
+ * while (monitor->recv(power_db, md)) { ... }
+ * \endcode
+ */
+class UHD_RFNOC_API spectrum_monitor : uhd::noncopyable
+{
+public:
+    typedef boost::shared_ptr<spectrum_monitor> sptr;
+
+    virtual ~spectrum_monitor(void) = 0;
+
+    /*!
+     * \param device the device which holds the blocks
+     * \param source_block the block whose output is analyzed
+     * \param source_port the output port of \p source_block
+     * \param args see above
+     * \throws uhd::value_error if the args are invalid
+     * \throws uhd::runtime_error if a block of the chain is not available
+     */
+    static sptr make(uhd::device3::sptr device,
+        const block_id_t& source_block,
+        const size_t source_port       = 0,
+        const uhd::device_addr_t& args = uhd::device_addr_t());
+
+    //! Return the number of bins per spectrum
+    virtual size_t get_fft_size(void) const = 0;
+
+    //! Return the blocks of the chain, in the order the data passes them
+    virtual std::vector<block_id_t> get_block_ids(void) const = 0;
+
+    //! Start streaming spectra
+    virtual void start(void) = 0;
+
+    //! Stop streaming spectra
+    virtual void stop(void) = 0;
+
+    /*!
+     * Receive the next spectrum
+     *
+     * The bins are in the order given by the FFT block's shift arg. By
+     * default, the negative frequencies come first.
+     *
+     * \param power_db resized to get_fft_size() and filled with the power of
+     *                 every bin, in dB relative to a full scale tone
+     * \param metadata filled like by rx_streamer::recv()
+     * \param timeout the timeout in seconds to wait for a spectrum
+     * \return false on a timeout or an error, see the metadata
+     */
+    virtual bool recv(std::vector<float>& power_db,
+        uhd::rx_metadata_t& metadata,
+        const double timeout = 0.1) = 0;
+
+    /*!
+     * Get the streamer which receives the spectra
+     *
+     * Applications that want to process the raw magnitudes can call its
+     * recv_raw() instead of recv(). Every packet holds one spectrum.
+     */
+    virtual uhd::rx_streamer::sptr get_streamer(void) const = 0;
+};
+
+}} // namespace uhd::rfnoc
+
+#endif /* INCLUDED_UHD_RFNOC_SPECTRUM_MONITOR_HPP */
@@ -7,11 +7,19 @@
 #ifndef INCLUDED_LIBUHD_TRAFFIC_COUNTER_HPP
 #define INCLUDED_LIBUHD_TRAFFIC_COUNTER_HPP
 
+#include <uhd/exception.hpp>
 #include <uhd/property_tree.hpp>
+#include <uhd/utils/log.hpp>
 #include <stdint.h>
-#include <type_traits>
+#include <array>
+#include <chrono>
+#include <condition_variable>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
 namespace uhd { namespace rfnoc {
 
@@ -21,15 +29,60 @@ public:
     typedef std::shared_ptr<traffic_counter> sptr;
     typedef std::function<void(const uint32_t addr, const uint32_t data)> write_reg_fn_t;
     typedef std::function<uint64_t(const uint32_t addr)> read_reg_fn_t;
+    //! Reads several registers at once, returns the values in order
+    typedef std::function<std::vector<uint64_t>(const std::vector<uint32_t>& addrs)>
+        read_regs_fn_t;
+
+    static const size_t NUM_COUNTERS = 9;
+
+    //! All counters of a block, read in one go
+    struct snapshot_t
+    {
+        //! Host time at which the counters were read
+        std::chrono::steady_clock::time_point time;
+        //! Counter values, in the order of get_counter_name()
+        std::array<uint64_t, NUM_COUNTERS> counters;
+    };
 
+    //! Return the name of counter \p index, which is also its property name
+    static const char* get_counter_name(const size_t index)
+    {
+        static const char* counters[] = {"bus_clock_ticks",
+            "xbar_to_shell_xfer_count",
+            "xbar_to_shell_pkt_count",
+            "shell_to_xbar_xfer_count",
+            "shell_to_xbar_pkt_count",
+            "shell_to_ce_xfer_count",
+            "shell_to_ce_pkt_count",
+            "ce_to_shell_xfer_count",
+            "ce_to_shell_pkt_count"};
+        static_assert(std::extent<decltype(counters)>::value == NUM_COUNTERS,
+            "Counter name list has the wrong size");
+        return counters[index];
+    }
+
+    /*!
+     * \param tree Property tree to register the counters in
+     * \param root_path Block root path, the counters go into its
+     *                  traffic_counter subdirectory
+     * \param write_reg_fn Writes a traffic counter register
+     * \param read_reg_fn Reads a traffic counter register
+     * \param read_regs_fn Reads several traffic counter registers in one
+     *                     transaction. If not given, get_snapshot() falls
+     *                     back to one read_reg_fn call per counter.
+     */
     traffic_counter(uhd::property_tree::sptr tree,
         uhd::fs_path root_path,
         write_reg_fn_t write_reg_fn,
-        read_reg_fn_t read_reg_fn)
-        : _write_reg_fn(write_reg_fn), _read_reg_fn(read_reg_fn)
+        read_reg_fn_t read_reg_fn,
+        read_regs_fn_t read_regs_fn = read_regs_fn_t())
+        : _write_reg_fn(write_reg_fn)
+        , _read_reg_fn(read_reg_fn)
+        , _read_regs_fn(read_regs_fn)
+        , _present(false)
     {
         const uint32_t id_reg_offset        = 0;
-        const uint32_t first_counter_offset = 1;
+        const uint32_t first_counter_offset = FIRST_COUNTER_OFFSET;
         const uint64_t traffic_counter_id   = 0x712AFF1C00000000ULL;
 
         // Check traffic counter id to determine if it's present
@@ -37,6 +90,7 @@ public:
 
         // If present, add properties
         if (id == traffic_counter_id) {
+            _present = true;
             tree->create<bool>(root_path / "traffic_counter/enable")
                 .add_coerced_subscriber([this](const bool enable) {
                     uint32_t val = enable ? 1 : 0;
@@ -44,28 +98,136 @@ public:
                 })
                 .set(false);
 
-            const char* counters[] = {"bus_clock_ticks",
-                "xbar_to_shell_xfer_count",
-                "xbar_to_shell_pkt_count",
-                "shell_to_xbar_xfer_count",
-                "shell_to_xbar_pkt_count",
-                "shell_to_ce_xfer_count",
-                "shell_to_ce_pkt_count",
-                "ce_to_shell_xfer_count",
-                "ce_to_shell_pkt_count"};
-
-            for (size_t i = 0; i < std::extent<decltype(counters)>::value; i++) {
-                tree->create<uint64_t>(root_path / "traffic_counter" / counters[i])
+            for (size_t i = 0; i < NUM_COUNTERS; i++) {
+                tree->create<uint64_t>(
+                        root_path / "traffic_counter" / get_counter_name(i))
                     .set_publisher([this, i, first_counter_offset]() {
                         return _read_reg_fn(i + first_counter_offset);
                     });
+                tree->create<double>(
+                        root_path / "traffic_counter/rates" / get_counter_name(i))
+                    .set_publisher([this, i]() {
+                        std::lock_guard<std::mutex> l(_sampler_mutex);
+                        return _rates[i];
+                    });
             }
+
+            // All counters at once, in the order of get_counter_name()
+            tree->create<std::vector<uint64_t>>(root_path / "traffic_counter/snapshot")
+                .set_publisher([this]() {
+                    const snapshot_t snapshot = get_snapshot();
+                    return std::vector<uint64_t>(
+                        snapshot.counters.begin(), snapshot.counters.end());
+                });
+
+            // Period of the background sampler in seconds, 0 stops it
+            tree->create<double>(root_path / "traffic_counter/sample_interval")
+                .add_coerced_subscriber(
+                    [this](const double interval) { _set_sample_interval(interval); })
+                .set(0.0);
         }
     }
 
+    ~traffic_counter()
+    {
+        _set_sample_interval(0.0);
+    }
+
+    //! Return true if the block has a traffic counter
+    bool is_present() const
+    {
+        return _present;
+    }
+
+    /*! Read all counters
+     *
+     * If the block provides a multi-register read, this is a single control
+     * transaction instead of one round trip per counter.
+     */
+    snapshot_t get_snapshot()
+    {
+        snapshot_t snapshot;
+        snapshot.time = std::chrono::steady_clock::now();
+        if (_read_regs_fn) {
+            std::vector<uint32_t> addrs(NUM_COUNTERS);
+            for (size_t i = 0; i < NUM_COUNTERS; i++) {
+                addrs[i] = uint32_t(i + FIRST_COUNTER_OFFSET);
+            }
+            const std::vector<uint64_t> values = _read_regs_fn(addrs);
+            std::copy(values.begin(), values.end(), snapshot.counters.begin());
+        } else {
+            for (size_t i = 0; i < NUM_COUNTERS; i++) {
+                snapshot.counters[i] = _read_reg_fn(uint32_t(i + FIRST_COUNTER_OFFSET));
+            }
+        }
+        return snapshot;
+    }
+
 private:
+    static const uint32_t FIRST_COUNTER_OFFSET = 1;
+
+    //! Start, restart or (with \p interval <= 0) stop the background sampler
+    void _set_sample_interval(const double interval)
+    {
+        {
+            std::lock_guard<std::mutex> l(_sampler_mutex);
+            _sampler_running = false;
+        }
+        _sampler_cond.notify_all();
+        if (_sampler_thread.joinable()) {
+            _sampler_thread.join();
+        }
+        if (interval <= 0.0) {
+            return;
+        }
+        _sampler_running = true;
+        _sampler_thread  = std::thread([this, interval]() { _sampler_loop(interval); });
+    }
+
+    /*! Sample all counters every \p interval seconds and update the rates
+     *
+     * The rates are the counter increments per second of host time, so
+     * they don't depend on knowing the bus clock frequency.
+     */
+    void _sampler_loop(const double interval)
+    {
+        const auto period = std::chrono::microseconds(int64_t(interval * 1e6));
+        snapshot_t last   = get_snapshot();
+        std::unique_lock<std::mutex> l(_sampler_mutex);
+        while (not _sampler_cond.wait_for(
+            l, period, [this] { return not _sampler_running; })) {
+            l.unlock();
+            snapshot_t now;
+            try {
+                now = get_snapshot();
+            } catch (const uhd::exception& ex) {
+                UHD_LOG_WARNING("RFNOC",
+                    "Stopping traffic counter sampler, failed to read counters: "
+                        << ex.what());
+                return;
+            }
+            const double elapsed =
+                std::chrono::duration<double>(now.time - last.time).count();
+            l.lock();
+            if (elapsed > 0.0) {
+                for (size_t i = 0; i < NUM_COUNTERS; i++) {
+                    _rates[i] = double(now.counters[i] - last.counters[i]) / elapsed;
+                }
+            }
+            last = now;
+        }
+    }
+
     write_reg_fn_t _write_reg_fn;
     read_reg_fn_t _read_reg_fn;
+    read_regs_fn_t _read_regs_fn;
+    bool _present;
+
+    std::mutex _sampler_mutex;
+    std::condition_variable _sampler_cond;
+    std::thread _sampler_thread;
+    bool _sampler_running = false;
+    std::array<double, NUM_COUNTERS> _rates = {};
 };
 
 }} /* namespace uhd::rfnoc */
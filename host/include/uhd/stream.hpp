@@ -16,6 +16,7 @@
 #include <uhd/utils/noncopyable.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/utility.hpp>
+#include <stdint.h>
 #include <string>
 #include <vector>
 
@@ -89,6 +90,10 @@ struct UHD_API stream_args_t
      *  - sc16 - Q16 I16
      *  - sc8 - Q8_1 I8_1 Q8_0 I8_0
      *  - sc12 (Only some devices)
+     *  - auto (RFNoC devices only) - The widest of sc16, sc12 and sc8 whose
+     *    channels fit on the link to the device at the stream's sample rate,
+     *    given the stream's blocks and the host converters for cpu_format.
+     *    Packets are made as large as the stream allows. The choice is logged.
      *
      * The following are not implemented, but are listed to demonstrate naming convention:
      *  - s16 - R16_1 R16_0
@@ -131,6 +136,105 @@ struct UHD_API stream_args_t
      *
      * - noclear: Used by tx_dsp_core_200 and rx_dsp_core_200
      *
+     * - host_resample: (RX only, multi_usrp) the sample rate in Sps which
+     * recv() returns. The device streams sc16 samples at the RX rate, and the
+     * host resamples them with a rational polyphase filter while converting
+     * them to fc32, which is the only supported CPU format. Use this to get
+     * rates which the device can't generate from its master clock. The ratio
+     * to the RX rate is approximated by a fraction with terms up to 1024.
+     *
+     * - convert_threads: number of threads that convert the channels of a
+     * multi-channel streamer in parallel, including the thread that calls
+     * recv() or send(). The additional threads poll for work, so only use
+     * this if conversion is the bottleneck and spare CPU cores are
+     * available. Defaults to 1 (no additional threads). Currently only
+     * supported on RFNoC devices (X3x0, N3xx, E3xx).
+     *
+     * - interleave_channels: If set, recv() of a multi-channel streamer
+     * expects a single buffer and writes the samples of all channels into
+     * it, interleaved in the order of the channels (ch0, ch1, ..., ch0, ...).
+     * The buffer must hold nsamps_per_buff samples of every channel. This
+     * saves a separate interleaving pass after recv(). Supports the sc16
+     * and sc8 wire formats with the fc64, fc32 and sc16 CPU formats, for up
+     * to 32 channels. Only supported for RX on RFNoC devices (X3x0, N3xx,
+     * E3xx). convert_threads has no effect with this option.
+     *
+     * - signal_stats: (RX only) If set, the samples of every channel are
+     * measured while they are converted, and their sums and peak are returned
+     * in stream_stats_t::signal_stats. This needs no second pass over the
+     * samples after recv(). Supports the sc16 wire format with the fc32 CPU
+     * format, without interleave_channels. Supported on RFNoC devices (X3x0,
+     * N3xx, E3xx), B2xx and USRP2/N2xx.
+     *
+     * - align_batch: number of packets per channel that a multi-channel
+     * receive streamer time-aligns at once. Once the channels are aligned,
+     * packets that are already waiting on all channels are checked for
+     * alignment right away, and the following recv() calls take them without
+     * going through the alignment logic again. Defaults to 1 (align every
+     * packet on its own). Only supported for RX on RFNoC devices (X3x0,
+     * N3xx, E3xx).
+     *
+     * - fc_adaptive: If set, the host sizes the interval between RX flow
+     * control updates from its consumption rate, so that about one update is
+     * sent every fc_adaptive_period seconds (default: 0.001). The interval
+     * never drops below the default one and never exceeds half of the flow
+     * control window. Only the length field of received packets is used for
+     * the byte count. Only supported for RX on RFNoC devices (X3x0, N3xx,
+     * E3xx).
+     *
+     * - fc_async: If set, TX flow control packets are received by a separate
+     * thread instead of the thread calling send(). send() then never polls
+     * the transport for flow control packets and only blocks when the
+     * device's buffer is full. Only supported for TX on RFNoC devices (X3x0,
+     * N3xx, E3xx).
+     *
+     * - fast_overflow_recovery: (RX only) If set, a multi-channel streamer
+     * recovers from overflows without flushing its transports, so the
+     * samples received before the overflow are not lost. The device time is
+     * read back before the channels are stopped. Streaming restarts twice
+     * the time the stop commands took plus overflow_restart_delay seconds
+     * (default: 0.005) after it, instead of 50 ms after the flush. The time
+     * it takes to recover is reported in stream_stats_t::overflow_recovery_ns.
+     * Only supported on RFNoC devices (X3x0, N3xx, E3xx).
+     *
+     * - auto_buff_ms: If set, the frame size, number of frames and socket
+     * buffer size of each channel's transport are chosen to hold this many
+     * milliseconds of data at the stream's sample rate and otw_format. The
+     * socket buffer is limited to what the kernel allows. Transport args
+     * given in the device args take precedence. The chosen values are logged,
+     * so they can be passed as device args later. Only supported on RFNoC
+     * devices (X3x0, N3xx, E3xx).
+     *
+     * - dram_buffer: If set (and not 0 or false), every channel is routed
+     * through a free port of a DRAM FIFO (DmaFIFO) block on its motherboard,
+     * which absorbs the host falling behind for as long as the FIFO's depth
+     * lasts at the stream's rate. Channels whose block is a DmaFIFO already use
+     * that one. Their fill levels are reported in
+     * stream_stats_t::dram_buffer_bytes, read back every dram_buffer_poll_ms
+     * milliseconds (default: 10). dram_buffer_size sets the depth of each
+     * channel's FIFO in bytes, a power of 2 of at least 8192, which places FIFO
+     * port p at p * dram_buffer_size in the 4 GiB the DmaFIFO can address. Only
+     * supported on RFNoC devices whose FPGA image has a DmaFIFO block (X3x0,
+     * N3xx). Through multi_usrp, TX channels already use the DmaFIFO ports, so
+     * RX channels need the skip_dram device arg.
+     *
+     * - auto_otw_min: The narrowest format otw_format=auto may pick: sc16, sc12
+     * or sc8 (default).
+     *
+     * - lead_time: (TX only) If set to "measure", the streamer learns the
+     * smallest lead time that timed bursts need to not be late, see
+     * tx_streamer::get_lead_time(). If set to "auto", send() also moves the
+     * time spec of every timed start of burst that has less lead time than
+     * that to the earliest safe time. The controller learns from the async
+     * messages, so they must be read with recv_async_msg() or
+     * recv_burst_status(), and bursts must end with an end of burst to be
+     * acknowledged. While it looks for a smaller lead time, the occasional
+     * burst may be late. lead_time_init sets the lead time in seconds until
+     * bursts were measured (default: 0.01), lead_time_min the smallest one
+     * it ever recommends (default: 0), and lead_time_margin the fraction
+     * added to a measured latency (default: 0.25). Only supported on RFNoC
+     * devices (X3x0, N3xx, E3xx).
+     *
      * The following are not implemented, but are listed for conceptual purposes:
      * - function: magnitude or phase/magnitude
      * - units: numeric units like counts or dBm
@@ -162,6 +266,104 @@ struct UHD_API stream_args_t
     std::vector<size_t> channels;
 };
 
+/*!
+ * Statistics of the samples of one RX channel, see stream_stats_t::signal_stats.
+ *
+ * The sums count from the creation of the streamer, in the scaled units of
+ * the samples returned by recv(). Take the difference of two snapshots to get
+ * the mean (DC offset) of I and Q, and the mean power, between them.
+ */
+struct signal_stats_t
+{
+    //! Number of samples measured
+    uint64_t num_samps = 0;
+    //! Sum of the I samples
+    double sum_i = 0.0;
+    //! Sum of the Q samples
+    double sum_q = 0.0;
+    //! Sum of I^2 + Q^2
+    double sum_sq = 0.0;
+    //! Largest magnitude of an I or Q sample in the last packet
+    double peak = 0.0;
+    //! Largest magnitude of an I or Q sample so far
+    double max_peak = 0.0;
+};
+
+/*!
+ * Statistics of a streamer, see rx_streamer::get_stats() and
+ * tx_streamer::get_stats().
+ *
+ * All values count from the creation of the streamer. Multi-channel packets
+ * count once per channel.
+ */
+struct stream_stats_t
+{
+    //! Number of bins in latency_hist
+    static const size_t NUM_LATENCY_BINS = 24;
+
+    //! Number of recv() or send() calls
+    uint64_t num_calls = 0;
+    //! Number of data packets received or sent
+    uint64_t num_packets = 0;
+    //! Number of bytes in these packets, including headers
+    uint64_t num_bytes = 0;
+    //! Number of samples per channel returned by recv() or accepted by send()
+    uint64_t num_samps = 0;
+    //! RX: Number of sequence errors (dropped packets)
+    uint64_t seq_errors = 0;
+    //! RX: Number of overflows
+    uint64_t overflows = 0;
+    //! RX: Time from detecting an overflow until aligned samples arrived
+    // again, summed over all overflows, in nanoseconds
+    uint64_t overflow_recovery_ns = 0;
+    //! RX: Longest time it took to recover from an overflow, in nanoseconds
+    uint64_t max_overflow_recovery_ns = 0;
+    //! RX: Number of packets dropped because they had no sample at the time
+    // that the channels were aligned to
+    uint64_t align_drops = 0;
+    //! RX: Number of samples dropped from the start of packets to align the
+    // channels, summed over all channels
+    uint64_t align_trimmed_samps = 0;
+    //! RX: Largest time difference between channels seen while aligning, in ticks
+    uint64_t max_align_skew_ticks = 0;
+    //! TX: Number of underflows reported by recv_async_msg()
+    uint64_t underflows = 0;
+    //! RX: Number of late stream commands. TX: Number of late packets
+    // reported by recv_async_msg().
+    uint64_t late_packets = 0;
+    //! Number of times waiting for a transport buffer timed out
+    uint64_t timeouts = 0;
+    //! Time spent waiting for transport buffers, in nanoseconds
+    uint64_t blocked_ns = 0;
+    //! Time spent converting samples, in nanoseconds
+    uint64_t convert_ns = 0;
+    /*! Histogram of the durations of recv() or send() calls
+     *
+     * Bin 0 counts calls that took less than 1 us. Bin i counts calls that
+     * took from 2^(i-1) us up to 2^i us. The last bin also counts everything
+     * longer than that.
+     */
+    std::vector<uint64_t> latency_hist = std::vector<uint64_t>(NUM_LATENCY_BINS, 0);
+    /*! RX: Statistics of the samples of every channel
+     *
+     * Empty unless the streamer was created with the `signal_stats` stream
+     * arg. The samples are measured while they are converted, which is
+     * supported for the "fc32" CPU format and the "sc16" wire format.
+     */
+    std::vector<signal_stats_t> signal_stats;
+    /*! Bytes held by the DRAM buffer of every channel
+     *
+     * Empty unless the streamer was created with the `dram_buffer` stream
+     * arg. The fill levels are read from the device every
+     * `dram_buffer_poll_ms` milliseconds, so this is up to that old.
+     */
+    std::vector<uint64_t> dram_buffer_bytes;
+    //! Most bytes held by the DRAM buffer of every channel so far
+    std::vector<uint64_t> dram_buffer_max_bytes;
+    //! Size of the DRAM buffer of every channel, in bytes
+    std::vector<uint64_t> dram_buffer_size;
+};
+
 /*!
  * The RX streamer is the host interface to receiving samples.
  * It represents the layer between the samples on the host
@@ -200,7 +402,9 @@ public:
      * This is a blocking call and will not return until the number
      * of samples returned have been written into each buffer.
      * Under a timeout condition, the number of samples returned
-     * may be less than the number of samples specified.
+     * may be less than the number of samples specified. The timeout
+     * applies to the whole call, however many packets it takes: once it
+     * has passed, only packets that already arrived are received.
      *
      * The one_packet option allows the user to guarantee that
      * the call will return after a single packet has been processed.
@@ -216,7 +420,7 @@ public:
      * \param buffs a vector of writable memory to fill with samples
      * \param nsamps_per_buff the size of each buffer in number of samples
      * \param metadata data to fill describing the buffer
-     * \param timeout the timeout in seconds to wait for a packet
+     * \param timeout the timeout in seconds for the whole call
      * \param one_packet return after the first packet is received
      * \return the number of samples received or 0 on error
      */
@@ -226,6 +430,133 @@ public:
         const double timeout  = 0.1,
         const bool one_packet = false) = 0;
 
+    //! A piece of a receive buffer, see recv_segments()
+    struct segment_t
+    {
+        //! Writable memory for the samples
+        void* buff;
+        //! The number of samples that fit into buff
+        size_t nsamps;
+    };
+
+    //! Typedef for the segments of every buffer that recv() would take
+    typedef std::vector<std::vector<segment_t>> segments_type;
+
+    /*!
+     * Receive into buffers that are made of several segments.
+     *
+     * This works like recv(), but every buffer is a list of segments instead
+     * of one contiguous block of memory, e.g., fixed-size blocks from a
+     * memory pool. The samples are converted straight into the segments, in
+     * order. Samples that don't fit into the rest of a segment continue at
+     * the start of the next one, even within a packet, so the segments
+     * behave like one buffer with the size of all of them.
+     *
+     * The segments of different buffers may have different sizes. Only as
+     * many samples as the smallest buffer holds are received.
+     *
+     * \param segments one list of segments per buffer that recv() takes
+     * \param metadata data to fill describing the buffer
+     * \param timeout the timeout in seconds for the whole call
+     * \param one_packet return after the first packet is received
+     * \return the number of samples received per buffer or 0 on error
+     * \throws uhd::value_error if the number of buffers is wrong
+     * \throws uhd::not_implemented_error if the streamer can't do this
+     */
+    virtual size_t recv_segments(const segments_type& segments,
+        rx_metadata_t& metadata,
+        const double timeout  = 0.1,
+        const bool one_packet = false);
+
+    //! Typedef for the payload pointers handed out by recv_raw()
+    typedef std::vector<const void*> raw_buffs_type;
+
+    /*!
+     * Receive one packet per channel without copying or converting it.
+     *
+     * Instead of converting into user buffers, the pointers in buffs are set
+     * to the payloads of the packets, still in the transport's memory and
+     * in the over-the-wire format (e.g., sc16_item32_le). One pointer per
+     * channel is returned. The packets are time aligned and the metadata is
+     * filled in like for recv() with one_packet set.
+     *
+     * The memory stays valid until release_raw() is called. The next call
+     * to recv() or recv_raw() releases it as well. While it is held, the
+     * transport can't reuse the frame, so release it soon.
+     *
+     * If a previous recv() call only consumed part of a packet, the
+     * pointers point to the remainder of that packet.
+     *
+     * \param buffs filled with the payload pointers, one per channel
+     * \param metadata data to fill describing the packets
+     * \param timeout the timeout in seconds to wait for a packet
+     * \return the number of samples per channel, or 0 on error
+     * \throws uhd::not_implemented_error if the streamer can't do this
+     */
+    virtual size_t recv_raw(
+        raw_buffs_type& buffs, rx_metadata_t& metadata, const double timeout = 0.1);
+
+    //! Release the packets returned by the last call to recv_raw()
+    virtual void release_raw(void);
+
+    /*!
+     * Get the over-the-wire format of the payloads returned by recv_raw()
+     *
+     * \return the format including the item width and byte order, e.g.,
+     *         sc16_item32_le
+     * \throws uhd::not_implemented_error if the streamer can't do this
+     */
+    virtual std::string get_raw_format(void) const;
+
+    /*!
+     * Set up a capture ring, which keeps the last samples without converting
+     * them.
+     *
+     * For triggered recording, where most of the data is discarded, call
+     * capture() instead of recv(). It copies the packets into the ring in the
+     * over-the-wire format. Once a trigger arrives, extract_capture() converts
+     * just the time window of interest. The ring is allocated here.
+     *
+     * \param nsamps the number of samples per channel to keep, 0 frees the ring
+     * \throws uhd::not_implemented_error if the streamer can't do this
+     */
+    virtual void set_capture_ring(const size_t nsamps);
+
+    /*!
+     * Receive the packets that are available into the capture ring.
+     *
+     * Waits for the first packet, then takes what else is there without
+     * waiting, up to a limit. Overflows and other errors are returned in the
+     * metadata. They leave a gap in the ring.
+     *
+     * \param metadata filled with the metadata of the first packet, or of the
+     *                 error
+     * \param timeout the timeout in seconds to wait for the first packet
+     * \return the number of samples per channel captured
+     * \throws uhd::not_implemented_error if the streamer can't do this
+     */
+    virtual size_t capture(rx_metadata_t& metadata, const double timeout = 0.1);
+
+    /*!
+     * Convert samples from the capture ring, starting at a time.
+     *
+     * The samples are taken from the first packet that still holds time_spec
+     * or later samples, up to the next gap or the end of the ring. The time
+     * of the first sample is returned in the metadata. It is later than
+     * time_spec if the ring no longer holds those samples.
+     *
+     * \param buffs the buffers to convert into, like for recv()
+     * \param nsamps_per_buff the number of samples to convert at most
+     * \param time_spec the time of the first sample to convert
+     * \param metadata filled with the time of the first sample
+     * \return the number of samples per channel converted
+     * \throws uhd::not_implemented_error if the streamer can't do this
+     */
+    virtual size_t extract_capture(const buffs_type& buffs,
+        const size_t nsamps_per_buff,
+        const time_spec_t& time_spec,
+        rx_metadata_t& metadata);
+
     /*!
      * Issue a stream command to the usrp device.
      * This tells the usrp to send samples into the host.
@@ -238,6 +569,32 @@ public:
      * \param stream_cmd the stream command to issue
      */
     virtual void issue_stream_cmd(const stream_cmd_t& stream_cmd) = 0;
+
+    /*!
+     * Get the statistics of this streamer.
+     *
+     * The statistics are always collected. Unlike recv(), this may be called
+     * from any thread, also while another thread is in recv().
+     *
+     * \throws uhd::not_implemented_error if the streamer can't do this
+     */
+    virtual stream_stats_t get_stats(void) const;
+
+    /*!
+     * Prepare to wait for received data with poll(), next to other streamers.
+     *
+     * Either the streamer already holds data, or it adds the descriptors that
+     * become readable when data may arrive. Call this again before every
+     * wait, from the thread that calls recv(). A readable descriptor doesn't
+     * guarantee a full set of packets, so call recv() with a short timeout.
+     * uhd::stream_selector does all of this for a set of streamers.
+     *
+     * \param fds the descriptors to wait on are appended to this
+     * \return true if recv() has data without waiting, fds is unchanged then
+     * \throws uhd::not_implemented_error if the streamer or one of its
+     *         transports can't do this
+     */
+    virtual bool prepare_recv_wait(std::vector<int>& fds);
 };
 
 /*!
@@ -274,7 +631,8 @@ public:
      * This is a blocking call and will not return until the number
      * of samples returned have been read out of each buffer.
      * Under a timeout condition, the number of samples returned
-     * may be less than the number of samples specified.
+     * may be less than the number of samples specified. The timeout
+     * applies to the whole call, however many packets it takes.
      *
      * Note on threading: send() is *not* thread-safe, to avoid locking
      * overhead. The application calling send() is responsible for making
@@ -286,7 +644,7 @@ public:
      * \param buffs a vector of read-only memory containing samples
      * \param nsamps_per_buff the number of samples to send, per buffer
      * \param metadata data describing the buffer's contents
-     * \param timeout the timeout in seconds to wait on a packet
+     * \param timeout the timeout in seconds for the whole call
      * \return the number of samples sent
      */
     virtual size_t send(const buffs_type& buffs,
@@ -294,14 +652,171 @@ public:
         const tx_metadata_t& metadata,
         const double timeout = 0.1) = 0;
 
+    //! Typedef for the payload pointers handed out by get_send_buffs()
+    typedef std::vector<void*> raw_buffs_type;
+
+    /*!
+     * Get writable payload memory in the next transport frame of every
+     * channel, to fill it in place instead of calling send().
+     *
+     * The pointers in buffs are set to the payload areas of the frames. The
+     * space for the packet header is already reserved before them. The
+     * application writes the samples in the over-the-wire format (e.g.,
+     * sc16_item32_le) and then calls commit_send_buffs().
+     *
+     * The size of the header depends on whether the packet carries a time
+     * stamp, so this has to be known up front.
+     *
+     * \param buffs filled with the payload pointers, one per channel
+     * \param has_time_spec true if the packet will have a time spec
+     * \param timeout the timeout in seconds to wait for the frames
+     * \return the max number of samples per channel, or 0 on timeout
+     * \throws uhd::not_implemented_error if the streamer can't do this
+     */
+    virtual size_t get_send_buffs(
+        raw_buffs_type& buffs, const bool has_time_spec, const double timeout = 0.1);
+
+    /*!
+     * Send the frames handed out by the last call to get_send_buffs().
+     *
+     * \param nsamps_per_buff the number of samples written to each buffer
+     * \param metadata data describing the packet, its has_time_spec must
+     *        match the one given to get_send_buffs()
+     * \throws uhd::value_error if the samples or the metadata don't fit
+     */
+    virtual void commit_send_buffs(
+        const size_t nsamps_per_buff, const tx_metadata_t& metadata);
+
+    //! A timed burst for send_bursts()
+    struct burst_t
+    {
+        //! Identifies the burst in its status, chosen by the application
+        uint64_t id;
+        //! The samples, one buffer per channel
+        std::vector<const void*> buffs;
+        //! The number of samples in each buffer
+        size_t nsamps_per_buff;
+        //! The time at which the burst starts
+        time_spec_t time_spec;
+    };
+
+    //! The outcome of a burst sent with send_bursts()
+    struct burst_status_t
+    {
+        //! The ID of the burst
+        uint64_t id;
+        //! The samples sent per channel, fewer than in the burst if
+        //  send_bursts() timed out in its middle and ended it early
+        size_t nsamps_sent;
+        //! True if every channel acknowledged the end of the burst
+        bool acked;
+        //! The first error reported for the burst, or EVENT_CODE_BURST_ACK if
+        //  there was none
+        async_metadata_t::event_code_t event_code;
+    };
+
+    /*!
+     * Send a queue of timed bursts in one call.
+     *
+     * Each burst is sent like a send() with start and end of burst and a time
+     * spec, but without the overhead of a call per burst. The bursts are
+     * paced into the transport as its flow control allows. They must be in
+     * time order and must not overlap.
+     *
+     * The buffers must stay valid until the call returns. The outcome of the
+     * bursts is reported by recv_burst_status().
+     *
+     * \param bursts the bursts to send
+     * \param timeout the timeout in seconds for the whole call
+     * \return the number of bursts sent, from the front of bursts. If a burst
+     *         was cut short by the timeout, it is ended early and counted.
+     * \throws uhd::not_implemented_error if the streamer can't do this
+     */
+    virtual size_t send_bursts(
+        const std::vector<burst_t>& bursts, const double timeout = 0.1);
+
+    /*!
+     * Get the outcome of the bursts sent with send_bursts().
+     *
+     * Reads all async messages that are available and attributes them to
+     * the bursts by their time. A burst is done once every channel
+     * acknowledged it or a later burst. The statuses of the bursts that are
+     * done are returned in the order they were sent. Since this consumes the
+     * async messages, don't call recv_async_msg() while bursts are pending.
+     *
+     * \param status cleared and filled with the statuses of the bursts that
+     *               are done
+     * \param timeout the timeout in seconds to wait for the first message
+     * \return the number of statuses
+     * \throws uhd::not_implemented_error if the streamer can't do this
+     */
+    virtual size_t recv_burst_status(
+        std::vector<burst_status_t>& status, const double timeout = 0.1);
+
     /*!
      * Receive and asynchronous message from this TX stream.
+     *
+     * With a timeout of zero, this only checks for a message and is cheap
+     * enough to call after every burst. Don't call it from more than one
+     * thread at a time.
+     *
      * \param async_metadata the metadata to be filled in
      * \param timeout the timeout in seconds to wait for a message
      * \return true when the async_metadata is valid, false for timeout
      */
     virtual bool recv_async_msg(
         async_metadata_t& async_metadata, double timeout = 0.1) = 0;
+
+    /*!
+     * Get a file descriptor that is readable while recv_async_msg() has
+     * messages, to wait for them with poll(), epoll or io_uring.
+     *
+     * Streamers only provide one if the stream args contain "async_msg_fd".
+     * Don't read from or close the descriptor.
+     *
+     * \return the descriptor, or -1 if the streamer doesn't provide one
+     */
+    virtual int get_async_msg_fd(void) const;
+
+    //! The state of the lead time controller, see get_lead_time()
+    struct lead_time_t
+    {
+        //! False until an async message with a time spec was read. Until
+        //  then, time_now is unknown and min_lead_time is the initial one.
+        bool valid;
+        //! The smallest lead time in seconds that timed bursts need
+        double min_lead_time;
+        //! The device time now, estimated from the host clock
+        time_spec_t time_now;
+        //! Number of late bursts that the controller saw
+        uint64_t num_late;
+        //! Number of bursts whose time spec send() moved later
+        uint64_t num_adjusted;
+    };
+
+    /*!
+     * Get the smallest lead time that timed bursts need to not be late.
+     *
+     * The lead time of a burst is how far its time spec is ahead of the
+     * device time when send() hands its first packet to the transport. A
+     * burst that starts now should use a time spec of at least
+     * time_now + min_lead_time. Needs the `lead_time` stream arg.
+     *
+     * \throws uhd::not_implemented_error if the streamer can't do this
+     */
+    virtual lead_time_t get_lead_time(void) const;
+
+    /*!
+     * Get the statistics of this streamer.
+     *
+     * The statistics are always collected. Unlike send(), this may be called
+     * from any thread, also while another thread is in send(). Underflows
+     * and late packets are only counted when they are read with
+     * recv_async_msg().
+     *
+     * \throws uhd::not_implemented_error if the streamer can't do this
+     */
+    virtual stream_stats_t get_stats(void) const;
 };
 
 } // namespace uhd
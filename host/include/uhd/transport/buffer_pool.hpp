@@ -9,6 +9,7 @@
 #define INCLUDED_UHD_TRANSPORT_BUFFER_POOL_HPP
 
 #include <uhd/config.hpp>
+#include <uhd/types/device_addr.hpp>
 #include <uhd/utils/noncopyable.hpp>
 #include <boost/shared_ptr.hpp>
 
@@ -26,6 +27,15 @@ public:
 
     virtual ~buffer_pool(void) = 0;
 
+    //! Placement of the memory that backs a buffer pool
+    struct mem_params_t
+    {
+        //! Size of the hugepages to back the pool with (0: regular heap memory)
+        size_t hugepage_size = 0;
+        //! NUMA node to place the pool on (-1: no preference)
+        int numa_node = -1;
+    };
+
     /*!
      * Make a new buffer pool.
      * \param num_buffs the number of buffers to allocate
@@ -36,6 +46,38 @@ public:
     static sptr make(
         const size_t num_buffs, const size_t buff_size, const size_t alignment = 16);
 
+    /*!
+     * Make a new buffer pool with control over its memory.
+     *
+     * With hugepages, the pool is mapped with MAP_HUGETLB, which needs
+     * hugepages of that size to be reserved on the system. The NUMA node is a
+     * preference: pages come from other nodes if it runs out of memory. If
+     * hugepages or NUMA placement are not available, this falls back to
+     * regular pages and logs a warning instead of failing.
+     *
+     * \param num_buffs the number of buffers to allocate
+     * \param buff_size the size of each buffer in bytes
+     * \param alignment the alignment boundary in bytes
+     * \param mem_params where and how to allocate the memory
+     * \return a new buffer pool buff_size X num_buffs
+     */
+    static sptr make(const size_t num_buffs,
+        const size_t buff_size,
+        const size_t alignment,
+        const mem_params_t& mem_params);
+
+    /*!
+     * Read the memory parameters from transport args.
+     *
+     * - `hugepages`: 2M or 1G for the hugepage size (any other value selects
+     *   2M hugepages)
+     * - `numa_node`: the NUMA node to place the buffers on
+     *
+     * \param hints the transport args
+     * \return the memory parameters, defaults if none are given
+     */
+    static mem_params_t get_mem_params(const device_addr_t& hints);
+
     //! Get a pointer to the buffer start at the specified index
     virtual ptr_type at(const size_t index) const = 0;
 
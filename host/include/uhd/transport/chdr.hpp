@@ -85,6 +85,76 @@ UHD_API void if_hdr_pack_le(uint32_t* packet_buff, if_packet_info_t& if_packet_i
 UHD_API void if_hdr_unpack_le(
     const uint32_t* packet_buff, if_packet_info_t& if_packet_info);
 
+/*!
+ * The unpacked headers of a batch of CHDR packets.
+ *
+ * Only the fields a receiver looks at per packet are kept, and each of them
+ * is an array over the packets (structure of arrays). That way, the batch
+ * unpackers decode all headers in a few tight loops the compiler can
+ * vectorize, instead of filling one if_packet_info_t per packet.
+ */
+struct UHD_API if_hdr_batch_t
+{
+    //! The maximum number of packets in a batch
+    static const size_t max_size = 32;
+
+    if_hdr_batch_t(void) : size(0) {}
+
+    /*!
+     * Fill \p if_packet_info like the single packet unpackers would.
+     * The packet at \p index must be valid.
+     *
+     * \param index the index of the packet in the batch
+     * \param if_packet_info the if packet info (read/write)
+     */
+    void get_if_packet_info(const size_t index, if_packet_info_t& if_packet_info) const;
+
+    //! The number of packets in the batch
+    size_t size;
+    //! False if the length field doesn't fit the packet, the other fields may be bogus
+    bool valid[max_size];
+    //! The packet type, see if_packet_info_t::packet_type_t
+    uint8_t packet_type[max_size];
+    bool has_tsf[max_size];
+    bool eob[max_size];
+    bool error[max_size];
+    bool fc_ack[max_size];
+    //! The 12-bit sequence number
+    uint16_t packet_count[max_size];
+    //! The packet length from the header, in bytes
+    uint16_t num_packet_bytes[max_size];
+    uint32_t sid[max_size];
+    //! The timestamp, zero if has_tsf is false
+    uint64_t tsf[max_size];
+};
+
+/*!
+ * Unpack the CHDR headers of several packets at once (big endian format).
+ *
+ * Unlike if_hdr_unpack_be(), a bad length field doesn't throw, but marks the
+ * packet as invalid in \p batch.
+ *
+ * \param packet_buffs the packets, one pointer per packet
+ * \param num_packet_words32 the size of each packet buffer in 32-bit words
+ * \param num_packets the number of packets, at most if_hdr_batch_t::max_size
+ * \param batch the unpacked headers
+ * \throws uhd::value_error if there are too many packets
+ */
+UHD_API void if_hdr_unpack_batch_be(const uint32_t* const packet_buffs[],
+    const size_t num_packet_words32[],
+    const size_t num_packets,
+    if_hdr_batch_t& batch);
+
+/*!
+ * Unpack the CHDR headers of several packets at once (little endian format).
+ *
+ * See if_hdr_unpack_batch_be().
+ */
+UHD_API void if_hdr_unpack_batch_le(const uint32_t* const packet_buffs[],
+    const size_t num_packet_words32[],
+    const size_t num_packets,
+    if_hdr_batch_t& batch);
+
 } // namespace chdr
 
 }}} // namespace uhd::transport::vrt
@@ -22,6 +22,8 @@ struct UHD_API if_addrs_t
     std::string inet;
     std::string mask;
     std::string bcast;
+    //! Name of the interface, empty if the system doesn't report it
+    std::string name;
 };
 
 /*!
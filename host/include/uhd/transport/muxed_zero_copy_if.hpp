@@ -12,6 +12,7 @@
 #include <uhd/transport/zero_copy.hpp>
 #include <stdint.h>
 #include <boost/function.hpp>
+#include <vector>
 #include <uhd/utils/noncopyable.hpp>
 
 namespace uhd { namespace transport {
@@ -24,6 +25,12 @@ namespace uhd { namespace transport {
  * This class handles demuxing receive streams into the
  * appropriate virtual streams with the given classifier
  * function. A worker therad is spawned to handle the demuxing.
+ *
+ * Alternatively, the demuxing can be done inline: Then there is no worker
+ * thread, and the threads that call get_recv_buff() on the virtual streams
+ * take turns pulling frames from the base transport and pushing them to the
+ * respective streams. Frames for a stream whose owner doesn't receive are
+ * only delivered while some other stream is being received from.
  */
 class muxed_zero_copy_if : private uhd::noncopyable
 {
@@ -54,10 +61,20 @@ public:
     //! Get number of frames dropped due to unregistered streams
     virtual size_t get_num_dropped_frames() const = 0;
 
-    //! Make a new demuxer from a transport and parameters
+    /*!
+     * Make a new demuxer from a transport and parameters
+     * \param base_xport the transport to demux
+     * \param classify_fn the function returning the stream number of a frame
+     * \param max_streams the maximum number of virtual streams
+     * \param inline_demux demux from the receiving threads instead of a
+     *                     worker thread
+     * \param cpu_affinity CPUs to pin the worker thread to
+     */
     static sptr make(zero_copy_if::sptr base_xport,
         stream_classifier_fn classify_fn,
-        size_t max_streams);
+        size_t max_streams,
+        bool inline_demux                       = false,
+        const std::vector<size_t>& cpu_affinity = std::vector<size_t>());
 };
 
 }} // namespace uhd::transport
@@ -34,7 +34,10 @@ nirio_fifo<data_t>::nirio_fifo(
     _actual_depth_in_elements(0),
     _total_elements_acquired(0),
     _frame_size_in_elements(0),
-    _fifo_optimization_option(MINIMIZE_LATENCY)
+    _fifo_optimization_option(MINIMIZE_LATENCY),
+    _polling(false),
+    _release_batch_size(0),
+    _pending_release(0)
 {
     nirio_status status = 0;
     nirio_status_chain(_riok_proxy_ptr->set_attribute(RIO_ADDRESS_SPACE, BUS_INTERFACE), status);
@@ -125,7 +128,17 @@ bool nirio_fifo<data_t>::_acquire_block_from_rio_buffer(
     size_t elements_to_request = 0;
     void* elements_buffer = NULL;
 
-    if (fifo_optimization_option == MAXIMIZE_THROUGHPUT)
+    // Anything left over from the last call is known to be available, so there is
+    // no need to ask the driver how much there is
+    const size_t known_available =
+        _remaining_acquirable_elements - (_remaining_acquirable_elements % _frame_size_in_elements);
+
+    if (fifo_optimization_option == MAXIMIZE_THROUGHPUT && known_available > 0)
+    {
+        // Batch: take all of it in a single call
+        elements_to_request = std::max(elements_requested, known_available);
+    }
+    else if (fifo_optimization_option == MAXIMIZE_THROUGHPUT)
     {
         // We'll maximize throughput by acquiring all the data that is available
         // But this comes at the cost of an extra wait_on_fifo in which we query
@@ -133,13 +146,9 @@ bool nirio_fifo<data_t>::_acquire_block_from_rio_buffer(
           
         // first, see how many are available to acquire
         // by trying to acquire 0
-        nirio_status_chain(_riok_proxy_ptr->wait_on_fifo(
-            _fifo_channel,
+        nirio_status_chain(_wait_on_fifo(
             0, // elements requested
-            static_cast<uint32_t>(_datatype_info.scalar_type),
-            _datatype_info.width * 8,
             0, // timeout
-            _fifo_direction == OUTPUT_FIFO,
             elements_buffer,
             elements_acquired_u32,
             elements_remaining_u32),
@@ -159,18 +168,17 @@ bool nirio_fifo<data_t>::_acquire_block_from_rio_buffer(
         // fifo_optimization_option == MINIMIZE_LATENCY
         // acquire either the minimum amount (frame size) or the amount remaining from the last call 
         // (coerced to a multiple of frames)
-        elements_to_request = std::max(
-            elements_requested,
-            (_remaining_acquirable_elements - (_remaining_acquirable_elements % _frame_size_in_elements)));
+        elements_to_request = std::max(elements_requested, known_available);
     }
-    
-    nirio_status_chain(_riok_proxy_ptr->wait_on_fifo(
-        _fifo_channel,
+
+    // The device can't fill elements which are still waiting to be released
+    if (_pending_release > 0) {
+        nirio_status_chain(_grant(0), status);
+    }
+
+    nirio_status_chain(_wait_on_fifo(
         elements_to_request,
-        static_cast<uint32_t>(_datatype_info.scalar_type),
-        _datatype_info.width * 8,
         timeout_in_ms,
-        _fifo_direction == OUTPUT_FIFO,
         elements_buffer,
         elements_acquired_u32,
         elements_remaining_u32),
@@ -194,6 +202,62 @@ bool nirio_fifo<data_t>::_acquire_block_from_rio_buffer(
 }
 
 
+template <typename data_t>
+nirio_status nirio_fifo<data_t>::_wait_on_fifo(
+    size_t elements_requested,
+    uint64_t timeout_in_ms,
+    void*& elements_buffer,
+    uint32_t& elements_acquired,
+    uint32_t& elements_remaining)
+{
+    //_riok_proxy_ptr must be valid and _mutex must be locked
+
+    if (!_polling || timeout_in_ms == 0) {
+        return _riok_proxy_ptr->wait_on_fifo(
+            _fifo_channel,
+            static_cast<uint32_t>(elements_requested),
+            static_cast<uint32_t>(_datatype_info.scalar_type),
+            _datatype_info.width * 8,
+            static_cast<uint32_t>(timeout_in_ms),
+            _fifo_direction == OUTPUT_FIFO,
+            elements_buffer,
+            elements_acquired,
+            elements_remaining);
+    }
+
+    const std::chrono::steady_clock::time_point deadline =
+        std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_in_ms);
+    nirio_status status = NiRio_Status_Success;
+    do {
+        status = _riok_proxy_ptr->wait_on_fifo(
+            _fifo_channel,
+            static_cast<uint32_t>(elements_requested),
+            static_cast<uint32_t>(_datatype_info.scalar_type),
+            _datatype_info.width * 8,
+            0, // timeout
+            _fifo_direction == OUTPUT_FIFO,
+            elements_buffer,
+            elements_acquired,
+            elements_remaining);
+    } while (status == NiRio_Status_FifoTimeout &&
+             std::chrono::steady_clock::now() < deadline);
+    return status;
+}
+
+template <typename data_t>
+nirio_status nirio_fifo<data_t>::_grant(const size_t elements)
+{
+    //_riok_proxy_ptr must be valid and _mutex must be locked
+
+    const size_t elements_to_grant = _pending_release + elements;
+    _pending_release = 0;
+    nirio_status status = _riok_proxy_ptr->grant_fifo(
+        _fifo_channel,
+        static_cast<uint32_t>(elements_to_grant));
+    _total_elements_acquired -= elements_to_grant;
+    return status;
+}
+
 template <typename data_t>
 nirio_status nirio_fifo<data_t>::start()
 {
@@ -241,8 +305,9 @@ nirio_status nirio_fifo<data_t>::stop()
 
     if (_state == STARTED) {
 
-        // release any remaining acquired elements
-        if (_total_elements_acquired > 0) release(_total_elements_acquired);
+        // release any remaining acquired elements, pending ones included
+        _pending_release = 0;
+        if (_total_elements_acquired > 0) _grant(_total_elements_acquired);
         _total_elements_acquired = 0;
         _remaining_in_claimed_block = 0;
         _remaining_acquirable_elements = 0;
@@ -323,10 +388,11 @@ nirio_status nirio_fifo<data_t>::release(const size_t elements)
     boost::unique_lock<boost::recursive_mutex> lock(_mutex);
 
     if (_state == STARTED) {
-        status = _riok_proxy_ptr->grant_fifo(
-            _fifo_channel,
-            static_cast<uint32_t>(elements));
-        _total_elements_acquired -= elements;
+        if (_pending_release + elements < _release_batch_size) {
+            _pending_release += elements;
+        } else {
+            status = _grant(elements);
+        }
     } else {
         status = NiRio_Status_ResourceNotInitialized;
     }
@@ -334,6 +400,23 @@ nirio_status nirio_fifo<data_t>::release(const size_t elements)
     return status;
 }
 
+template <typename data_t>
+void nirio_fifo<data_t>::set_polling(const bool enable)
+{
+    boost::unique_lock<boost::recursive_mutex> lock(_mutex);
+    _polling = enable;
+}
+
+template <typename data_t>
+void nirio_fifo<data_t>::set_release_batch(const size_t elements)
+{
+    boost::unique_lock<boost::recursive_mutex> lock(_mutex);
+    _release_batch_size = elements;
+    if (_state == STARTED && _pending_release >= _release_batch_size && _pending_release > 0) {
+        _grant(0);
+    }
+}
+
 template <typename data_t>
 nirio_status nirio_fifo<data_t>::read(
     data_t* buf,
@@ -19,6 +19,21 @@ namespace uhd { namespace transport {
  * The zero copy TCP transport.
  * This transport provides the uhd zero copy interface
  * on top of a standard tcp socket from boost asio.
+ *
+ * By default, every frame is sent padded to the full send frame size, and
+ * every receive reads one frame. With the `stream_mode` hint, every frame is
+ * sent as its length (a 32-bit big endian word) followed by its data, and
+ * the other end must use the same framing. Committed frames are then written
+ * in batches of up to `send_batch_size` frames (default: 16) with a single
+ * call, so they go out in large segments; a batch is also written when its
+ * oldest frame has waited `send_batch_timeout` seconds (default: 0.001) and
+ * on flush_send_buffs(). Receives read as much as fits into one ring of
+ * `num_recv_frames` frames and hand out the frames in place. The ring is
+ * reused in order, so a receive buffer that is held much longer than the
+ * ones after it stalls the receives once the ring comes around to it.
+ *
+ * The `recv_buff_size` and `send_buff_size` hints set the socket buffer
+ * sizes, which are otherwise tuned by the OS.
  */
 struct UHD_API tcp_zero_copy : public virtual zero_copy_if
 {
@@ -14,6 +14,7 @@
 #include <boost/intrusive_ptr.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/utility.hpp>
+#include <stdint.h>
 
 namespace uhd { namespace transport {
 
@@ -21,7 +22,12 @@ namespace uhd { namespace transport {
 class UHD_API managed_buffer
 {
 public:
-    managed_buffer(void) : _ref_count(0), _buffer(NULL), _length(0)
+    managed_buffer(void)
+        : _ref_count(0)
+        , _local_ref_count(0)
+        , _single_threaded(false)
+        , _buffer(NULL)
+        , _length(0)
     {
 #ifdef UHD_TXRX_DEBUG_PRINTS
         _mb_num = s_buffer_count;
@@ -75,12 +81,29 @@ public:
         return boost::intrusive_ptr<T>(p);
     }
 
+    /*!
+     * Count the references to this buffer with plain instead of atomic
+     * operations, which saves a locked instruction on every copy and release
+     * of a smart pointer to it. Only for buffers whose smart pointers are
+     * never copied or released by two threads at the same time, handing a
+     * buffer over through a locked queue is fine. Must be called while no
+     * smart pointer to this buffer exists.
+     * \param single_threaded true for plain, false for atomic counting
+     */
+    UHD_INLINE void set_single_threaded(const bool single_threaded)
+    {
+        _single_threaded = single_threaded;
+    }
+
     boost::detail::atomic_count _ref_count;
+    //! Used instead of _ref_count if the buffer is single threaded
+    long _local_ref_count;
+    bool _single_threaded;
     typedef boost::intrusive_ptr<managed_buffer> sptr;
 
     int ref_count()
     {
-        return (int)_ref_count;
+        return _single_threaded ? (int)_local_ref_count : (int)_ref_count;
     }
 
 #ifdef UHD_TXRX_DEBUG_PRINTS
@@ -105,12 +128,15 @@ private:
 
 UHD_INLINE void intrusive_ptr_add_ref(managed_buffer* p)
 {
-    ++(p->_ref_count);
+    if (p->_single_threaded)
+        ++(p->_local_ref_count);
+    else
+        ++(p->_ref_count);
 }
 
 UHD_INLINE void intrusive_ptr_release(managed_buffer* p)
 {
-    if (--(p->_ref_count) == 0)
+    if ((p->_single_threaded ? --(p->_local_ref_count) : --(p->_ref_count)) == 0)
         p->release();
 }
 
@@ -123,6 +149,28 @@ class UHD_API managed_recv_buffer : public managed_buffer
 {
 public:
     typedef boost::intrusive_ptr<managed_recv_buffer> sptr;
+
+    managed_recv_buffer(void) : _rx_timestamp(0) {}
+
+    /*!
+     * Get the time the packet in this buffer arrived at the host.
+     * Transports which capture arrival times (e.g. from the kernel or the
+     * NIC) set it with every packet.
+     * \return nanoseconds since the Unix epoch, or 0 if unknown
+     */
+    UHD_INLINE uint64_t get_rx_timestamp(void) const
+    {
+        return _rx_timestamp;
+    }
+
+    //! Set the arrival time of the packet, see get_rx_timestamp()
+    UHD_INLINE void set_rx_timestamp(const uint64_t ns)
+    {
+        _rx_timestamp = ns;
+    }
+
+protected:
+    uint64_t _rx_timestamp;
 };
 
 /*!
@@ -214,6 +262,41 @@ public:
      * \return frame size in bytes
      */
     virtual size_t get_send_frame_size(void) const = 0;
+
+    /*!
+     * Push out any committed send buffers the transport is holding back.
+     * Transports that batch several send buffers into one operation may
+     * defer the actual send after a buffer is released. This call forces
+     * all pending buffers onto the wire. The default implementation is a
+     * no-op for transports that send on release.
+     */
+    virtual void flush_send_buffs(void) {}
+
+    /*!
+     * Get a file descriptor to wait on with poll() for receive frames.
+     *
+     * The descriptor becomes readable when get_recv_buff() may have a frame.
+     * Transports that hold frames of their own may arm the descriptor in this
+     * call, so call it before every wait, and check has_recv_buff() after
+     * it. Don't read from or close the descriptor.
+     *
+     * \return the descriptor, or -1 if the transport doesn't provide one
+     */
+    virtual int get_recv_fd(void)
+    {
+        return -1;
+    }
+
+    /*!
+     * Check if the transport holds received frames, which get_recv_fd()
+     * doesn't signal. Only call this from the thread that receives.
+     *
+     * \return true if get_recv_buff() has a frame without waiting
+     */
+    virtual bool has_recv_buff(void)
+    {
+        return false;
+    }
 };
 
 }} // namespace uhd::transport
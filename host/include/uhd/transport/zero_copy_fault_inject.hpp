@@ -0,0 +1,68 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHD_TRANSPORT_ZERO_COPY_FAULT_INJECT_HPP
+#define INCLUDED_UHD_TRANSPORT_ZERO_COPY_FAULT_INJECT_HPP
+
+#include <uhd/config.hpp>
+#include <uhd/transport/zero_copy.hpp>
+#include <uhd/types/device_addr.hpp>
+#include <boost/shared_ptr.hpp>
+#include <stdint.h>
+
+namespace uhd { namespace transport {
+
+/*!
+ * Injects faults into the receive path of any zero_copy_if transport, to
+ * test how fast the streamers recover from them.
+ *
+ * The faults are chosen at random for every packet. The following args are
+ * supported, all probabilities default to 0:
+ * - recv_fault_drop: Probability of dropping a packet
+ * - recv_fault_drop_burst: Number of packets that are dropped in a row
+ *   (default: 1)
+ * - recv_fault_reorder: Probability of swapping a packet with the next one
+ * - recv_fault_dup: Probability of returning a packet twice
+ * - recv_fault_delay: Probability of stalling before returning a packet
+ * - recv_fault_delay_time: Duration of a stall in seconds (default: 0.001)
+ * - recv_fault_seed: Seed of the random faults (default: 1)
+ *
+ * Devices add this transport to their receive streamers if any of the
+ * probabilities is given in the device args. Send buffers are passed through.
+ */
+class UHD_API zero_copy_fault_inject : public virtual zero_copy_if
+{
+public:
+    typedef boost::shared_ptr<zero_copy_fault_inject> sptr;
+
+    //! Number of injected faults
+    struct stats_t
+    {
+        uint64_t dropped    = 0;
+        uint64_t reordered  = 0;
+        uint64_t duplicated = 0;
+        uint64_t delayed    = 0;
+    };
+
+    //! Return true if \p args ask for any faults
+    static bool has_faults(const device_addr_t& args);
+
+    /*!
+     * Make a fault injecting transport.
+     *
+     * \param transport a shared pointer to the transport interface
+     * \param args the faults to inject, see above
+     * \throws uhd::value_error if a probability is not within [0, 1]
+     */
+    static sptr make(zero_copy_if::sptr transport, const device_addr_t& args);
+
+    //! Return the faults injected so far
+    virtual stats_t get_stats(void) const = 0;
+};
+
+}} // namespace uhd::transport
+
+#endif /* INCLUDED_UHD_TRANSPORT_ZERO_COPY_FAULT_INJECT_HPP */
@@ -11,6 +11,7 @@
 #include <uhd/config.hpp>
 #include <uhd/transport/zero_copy.hpp>
 #include <boost/shared_ptr.hpp>
+#include <vector>
 
 namespace uhd { namespace transport {
 
@@ -31,8 +32,13 @@ public:
      *
      * \param transport a shared pointer to the transport interface
      * \param timeout a general timeout for pushing and pulling on the bounded buffer
+     * \param cpu_affinity CPUs to pin the receive thread to. Since the
+     *        receive thread is the first to write to the receive buffers of
+     *        a socket-based transport, this also decides their NUMA node.
      */
-    static sptr make(zero_copy_if::sptr transport, const double timeout);
+    static sptr make(zero_copy_if::sptr transport,
+        const double timeout,
+        const std::vector<size_t>& cpu_affinity = std::vector<size_t>());
 };
 
 }} // namespace uhd::transport
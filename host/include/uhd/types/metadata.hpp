@@ -10,6 +10,7 @@
 
 #include <uhd/config.hpp>
 #include <uhd/types/time_spec.hpp>
+#include <uhd/types/time_ticks.hpp>
 #include <stdint.h>
 #include <string>
 
@@ -31,14 +32,17 @@ struct UHD_API rx_metadata_t
     //! Reset values.
     void reset()
     {
-        has_time_spec   = false;
-        time_spec       = time_spec_t(0.0);
-        more_fragments  = false;
-        fragment_offset = 0;
-        start_of_burst  = false;
-        end_of_burst    = false;
-        error_code      = ERROR_CODE_NONE;
-        out_of_sequence = false;
+        has_time_spec      = false;
+        time_spec          = time_spec_t(0.0);
+        time_ticks         = time_ticks_t();
+        more_fragments     = false;
+        fragment_offset    = 0;
+        start_of_burst     = false;
+        end_of_burst       = false;
+        error_code         = ERROR_CODE_NONE;
+        out_of_sequence    = false;
+        has_host_time_spec = false;
+        host_time_spec     = time_spec_t(0.0);
     }
 
     //! Has time specification?
@@ -47,6 +51,13 @@ struct UHD_API rx_metadata_t
     //! Time of the first sample.
     time_spec_t time_spec;
 
+    /*!
+     * Time of the first sample as an exact tick count, at the tick rate of the
+     * device's time base. Streamers that know the tick rate set it along with
+     * time_spec, other sources leave it invalid.
+     */
+    time_ticks_t time_ticks;
+
     /*!
      * Fragmentation flag:
      * Similar to IPv4 fragmentation:
@@ -112,6 +123,18 @@ struct UHD_API rx_metadata_t
     //! of order.
     bool out_of_sequence;
 
+    //! Has host arrival time?
+    bool has_host_time_spec;
+
+    /*!
+     * Time the packet with the first sample arrived at the host, as captured
+     * by the kernel or the NIC, in host time (seconds since the Unix epoch).
+     * Only set by transports which capture arrival times, see the
+     * rx_timestamps transport argument. Comparing it to the time the
+     * receive returns gives the latency of the host stack.
+     */
+    time_spec_t host_time_spec;
+
     /*!
      * Convert a rx_metadata_t into a pretty print string.
      *
@@ -144,6 +167,15 @@ struct UHD_API tx_metadata_t
     //! When to send the first sample.
     time_spec_t time_spec;
 
+    /*!
+     * When to send the first sample, as an exact tick count.
+     * If has_time_spec is set and this is valid, it is used instead of
+     * time_spec. It may be given at any
+     * tick rate, e.g. as a sample index at the sample rate, but is only exact
+     * if it converts to a whole number of device ticks.
+     */
+    time_ticks_t time_ticks;
+
     //! Set start of burst to true for the first packet in the chain.
     bool start_of_burst;
 
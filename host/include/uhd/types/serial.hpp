@@ -154,6 +154,20 @@ public:
      */
     virtual void write_spi(
         int which_slave, const spi_config_t& config, uint32_t data, size_t num_bits);
+
+    /*!
+     * Write several words to the SPI bus, in order.
+     * Identical to calling write_spi() once per word, but interfaces that can
+     * stream the writes don't wait for each one to complete.
+     * \param which_slave the slave device number
+     * \param config spi config args
+     * \param data the words to write, one transaction per word
+     * \param num_bits how many bits in each word
+     */
+    virtual void write_spi_list(int which_slave,
+        const spi_config_t& config,
+        const std::vector<uint32_t>& data,
+        size_t num_bits);
 };
 
 /*!
@@ -0,0 +1,103 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHD_TYPES_TIME_TICKS_HPP
+#define INCLUDED_UHD_TYPES_TIME_TICKS_HPP
+
+#include <uhd/config.hpp>
+#include <uhd/types/time_spec.hpp>
+#include <stdint.h>
+
+namespace uhd {
+
+/*!
+ * A time_ticks_t holds a time as an integer count of ticks at a given rate,
+ * e.g. the timestamp of a packet in ticks of the device's time base, or a
+ * sample index at the sample rate.
+ *
+ * Unlike time_spec_t, there is no floating point math involved, so adding
+ * tick counts is exact however long the device has been running. Converting
+ * between rates is exact as long as both rates are integers and the result
+ * is a whole number of ticks; otherwise, it rounds to the nearest tick. A
+ * time_spec_t is only needed to present the time in seconds.
+ */
+struct UHD_API time_ticks_t
+{
+    //! An invalid time, see is_valid()
+    time_ticks_t(void) : ticks(0), tick_rate(0.0) {}
+
+    /*!
+     * Create a time from a tick count
+     * \param ticks the number of ticks
+     * \param tick_rate the number of ticks per second
+     */
+    time_ticks_t(const int64_t ticks, const double tick_rate)
+        : ticks(ticks), tick_rate(tick_rate)
+    {
+    }
+
+    /*!
+     * Convert a time_spec_t, rounding to the nearest tick
+     * \param time the time to convert
+     * \param tick_rate the number of ticks per second
+     */
+    static time_ticks_t from_time_spec(const time_spec_t& time, const double tick_rate)
+    {
+        return time_ticks_t(time.to_ticks(tick_rate), tick_rate);
+    }
+
+    /*!
+     * Convert a tick count from one rate to another
+     * \param ticks the number of ticks at \p from_rate
+     * \param from_rate the ticks per second of \p ticks
+     * \param to_rate the ticks per second of the result
+     * \return the number of ticks at \p to_rate, rounded to the nearest tick
+     */
+    static int64_t convert(const int64_t ticks, const double from_rate, const double to_rate);
+
+    //! True if the time has a tick rate
+    bool is_valid(void) const
+    {
+        return tick_rate > 0.0;
+    }
+
+    //! Convert the time to seconds
+    time_spec_t to_time_spec(void) const
+    {
+        return time_spec_t::from_ticks(ticks, tick_rate);
+    }
+
+    /*!
+     * Get the same time at another tick rate
+     * \param new_rate the new number of ticks per second
+     * \return the time at \p new_rate, rounded to the nearest tick
+     */
+    time_ticks_t to_rate(const double new_rate) const
+    {
+        return time_ticks_t(convert(ticks, tick_rate, new_rate), new_rate);
+    }
+
+    //! Number of ticks since time zero
+    int64_t ticks;
+
+    //! Number of ticks per second, or 0 if the time is invalid
+    double tick_rate;
+};
+
+//! Equal if both the tick count and the tick rate are
+UHD_INLINE bool operator==(const time_ticks_t& lhs, const time_ticks_t& rhs)
+{
+    return lhs.ticks == rhs.ticks and lhs.tick_rate == rhs.tick_rate;
+}
+
+UHD_INLINE bool operator!=(const time_ticks_t& lhs, const time_ticks_t& rhs)
+{
+    return not(lhs == rhs);
+}
+
+} // namespace uhd
+
+#endif /* INCLUDED_UHD_TYPES_TIME_TICKS_HPP */
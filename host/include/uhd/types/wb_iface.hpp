@@ -12,6 +12,7 @@
 #include <uhd/types/time_spec.hpp>
 #include <stdint.h>
 #include <boost/shared_ptr.hpp>
+#include <vector>
 
 namespace uhd {
 
@@ -64,6 +65,25 @@ public:
      * \return the 16bit data
      */
     virtual uint16_t peek16(const wb_addr_type addr);
+
+    /*!
+     * Write several registers (32 bits), in order.
+     * Identical to calling poke32() once per address, but interfaces that can
+     * carry many operations per transaction only make one round trip.
+     * \param addrs the addresses
+     * \param data the 32bit data, one value per address
+     */
+    virtual void multi_poke32(
+        const std::vector<wb_addr_type>& addrs, const std::vector<uint32_t>& data);
+
+    /*!
+     * Read several registers (32 bits), in order.
+     * Identical to calling peek32() once per address, but interfaces that can
+     * carry many operations per transaction only make one round trip.
+     * \param addrs the addresses
+     * \return the 32bit data, in the same order as \p addrs
+     */
+    virtual std::vector<uint32_t> multi_peek32(const std::vector<wb_addr_type>& addrs);
 };
 
 class UHD_API timed_wb_iface : public wb_iface
@@ -82,6 +102,29 @@ public:
      * \param t the command time
      */
     virtual void set_time(const time_spec_t& t) = 0;
+
+    //! A register write at a command time, see poke32_schedule()
+    struct timed_poke32_t
+    {
+        time_spec_t time;
+        wb_addr_type addr;
+        uint32_t data;
+    };
+
+    /*!
+     * Write a schedule of timed register writes (32 bits), in order.
+     * Identical to calling set_time() and poke32() once per write and
+     * restoring the command time afterwards, but interfaces that pipeline
+     * commands keep as many writes in flight as the command FIFO holds.
+     * \param writes the writes, sorted by their command times
+     */
+    virtual void poke32_schedule(const std::vector<timed_poke32_t>& writes);
+
+    /*!
+     * Get the number of timed commands the device can queue.
+     * \return the command FIFO size, or 0 if unknown
+     */
+    virtual size_t get_cmd_fifo_size(void);
 };
 
 } // namespace uhd
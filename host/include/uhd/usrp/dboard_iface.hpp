@@ -194,6 +194,21 @@ public:
     virtual void write_spi(
         unit_t unit, const spi_config_t& config, uint32_t data, size_t num_bits) = 0;
 
+    /*!
+     * Write several words to SPI bus peripheral, in order.
+     * Identical to calling write_spi() once per word, but interfaces that can
+     * stream the writes don't wait for each one to complete.
+     *
+     * \param unit which unit, rx or tx
+     * \param config configuration settings
+     * \param data the words to write, each MSB first
+     * \param num_bits the number of bits in each word
+     */
+    virtual void write_spi_list(unit_t unit,
+        const spi_config_t& config,
+        const std::vector<uint32_t>& data,
+        size_t num_bits);
+
     /*!
      * Read and write data to SPI bus peripheral.
      *
@@ -39,6 +39,7 @@
 #include <boost/shared_ptr.hpp>
 #include <uhd/utils/noncopyable.hpp>
 #include <complex>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -290,6 +291,11 @@ public:
      * - Step1: wait for the last pps time to transition to catch the edge
      * - Step2: set the time at the next pps (synchronous for all boards)
      *
+     * All boards are armed at the same time, so this also works with many
+     * boards. After the next pps, the time latched by every board is
+     * compared to the one of board 0. If a board took a different edge, a
+     * warning is logged and both steps are repeated once.
+     *
      * \param time_spec the time to latch at the next pps after catching the edge
      */
     virtual void set_time_unknown_pps(const time_spec_t& time_spec) = 0;
@@ -562,6 +568,25 @@ public:
      */
     virtual std::vector<std::string> get_mboard_sensor_names(size_t mboard = 0) = 0;
 
+    /*!
+     * Get the values of all motherboard sensors.
+     *
+     * Devices that can read several sensors in one go do so, e.g. MPM based
+     * devices read all their motherboard sensors in a single RPC call. Other
+     * sensors are read one by one.
+     *
+     * If \p max_age is given, values that were read through this call at
+     * most that many seconds ago are returned again without reading the
+     * sensors. This limits the load on the device when it is polled often.
+     *
+     * \param mboard the motherboard index 0 to M-1
+     * \param max_age the maximum age of cached values in seconds, zero to
+     *                always read the sensors
+     * \return the sensor values, by sensor name
+     */
+    virtual std::map<std::string, sensor_value_t> get_mboard_sensors(
+        size_t mboard = 0, double max_age = 0.0) = 0;
+
     /*!
      * Perform write on the user configuration register bus. These only exist if
      * the user has implemented custom setting registers in the device FPGA.
@@ -663,6 +688,20 @@ public:
     virtual tune_result_t set_rx_freq(
         const tune_request_t& tune_request, size_t chan = 0) = 0;
 
+    /*!
+     * Set the RX center frequency of several channels.
+     *
+     * This is equivalent to calling set_rx_freq() for every channel, but
+     * the channels of different motherboards are tuned concurrently.
+     * Channels of the same motherboard are tuned in the order given.
+     *
+     * \param tune_request tune request instructions
+     * \param chans the channel indexes 0 to N-1
+     * \return the tune results, in the order of chans
+     */
+    virtual std::vector<tune_result_t> set_rx_freq(
+        const tune_request_t& tune_request, const std::vector<size_t>& chans) = 0;
+
     /*!
      * Get the RX center frequency.
      * \param chan the channel index 0 to N-1
@@ -670,6 +709,36 @@ public:
      */
     virtual double get_rx_freq(size_t chan = 0) = 0;
 
+    /*!
+     * Precompute a table of RX tune requests for fast frequency hopping.
+     *
+     * Every request is tuned once, like with set_rx_freq(), and the results
+     * are stored. Afterwards, set_rx_freq_hop() can go to any of the hops
+     * without doing the range and LO offset calculations again. It only
+     * retunes the frontend if the hop needs a different RF frequency than
+     * the current one; hops that share the RF frequency only retune the DSP,
+     * i.e., write a single register. Use a command time
+     * (see set_command_time()) to hop at a given time.
+     *
+     * Calling this again replaces the table of the channel. When this
+     * returns, the channel is tuned to the last hop.
+     *
+     * \param tune_requests the hops, in the order they will be indexed
+     * \param chan the channel index 0 to N-1
+     * \return the tune results of the hops
+     */
+    virtual std::vector<tune_result_t> set_rx_tune_table(
+        const std::vector<tune_request_t>& tune_requests, size_t chan = 0) = 0;
+
+    /*!
+     * Tune to a hop of the table set with set_rx_tune_table().
+     * \param hop the index of the tune request in the table
+     * \param chan the channel index 0 to N-1
+     * \return the tune result of the hop
+     * \throws uhd::index_error if there's no such hop
+     */
+    virtual tune_result_t set_rx_freq_hop(size_t hop, size_t chan = 0) = 0;
+
     /*!
      * Get the RX center frequency range.
      * This range includes the overall tunable range of the RX chain,
@@ -952,6 +1021,19 @@ public:
      */
     virtual void set_rx_gain(double gain, const std::string& name, size_t chan = 0) = 0;
 
+    /*!
+     * Set the RX gain value of several channels.
+     *
+     * This is equivalent to calling set_rx_gain() for every channel, but
+     * the channels of different motherboards are configured concurrently.
+     *
+     * \param gain the gain in dB
+     * \param name the name of the gain element, or ALL_GAINS
+     * \param chans the channel indexes 0 to N-1
+     */
+    virtual void set_rx_gain(
+        double gain, const std::string& name, const std::vector<size_t>& chans) = 0;
+
     /*! Get a list of possible RX gain profile options
      *
      * Example: On the TwinRX, this will return "low-noise", "low-distortion" or
@@ -1131,6 +1213,17 @@ public:
      */
     virtual std::vector<std::string> get_rx_sensor_names(size_t chan = 0) = 0;
 
+    /*!
+     * Get the values of all RX frontend sensors.
+     * See get_mboard_sensors() for how they are read and cached.
+     * \param chan the channel index 0 to N-1
+     * \param max_age the maximum age of cached values in seconds, zero to
+     *                always read the sensors
+     * \return the sensor values, by sensor name
+     */
+    virtual std::map<std::string, sensor_value_t> get_rx_sensors(
+        size_t chan = 0, double max_age = 0.0) = 0;
+
     /*!
      * Enable/disable the automatic RX DC offset correction.
      * The automatic correction subtracts out the long-run average.
@@ -1244,6 +1337,20 @@ public:
     virtual tune_result_t set_tx_freq(
         const tune_request_t& tune_request, size_t chan = 0) = 0;
 
+    /*!
+     * Set the TX center frequency of several channels.
+     *
+     * This is equivalent to calling set_tx_freq() for every channel, but
+     * the channels of different motherboards are tuned concurrently.
+     * Channels of the same motherboard are tuned in the order given.
+     *
+     * \param tune_request tune request instructions
+     * \param chans the channel indexes 0 to N-1
+     * \return the tune results, in the order of chans
+     */
+    virtual std::vector<tune_result_t> set_tx_freq(
+        const tune_request_t& tune_request, const std::vector<size_t>& chans) = 0;
+
     /*!
      * Get the TX center frequency.
      * \param chan the channel index 0 to N-1
@@ -1251,6 +1358,36 @@ public:
      */
     virtual double get_tx_freq(size_t chan = 0) = 0;
 
+    /*!
+     * Precompute a table of TX tune requests for fast frequency hopping.
+     *
+     * Every request is tuned once, like with set_tx_freq(), and the results
+     * are stored. Afterwards, set_tx_freq_hop() can go to any of the hops
+     * without doing the range and LO offset calculations again. It only
+     * retunes the frontend if the hop needs a different RF frequency than
+     * the current one; hops that share the RF frequency only retune the DSP,
+     * i.e., write a single register. Use a command time
+     * (see set_command_time()) to hop at a given time.
+     *
+     * Calling this again replaces the table of the channel. When this
+     * returns, the channel is tuned to the last hop.
+     *
+     * \param tune_requests the hops, in the order they will be indexed
+     * \param chan the channel index 0 to N-1
+     * \return the tune results of the hops
+     */
+    virtual std::vector<tune_result_t> set_tx_tune_table(
+        const std::vector<tune_request_t>& tune_requests, size_t chan = 0) = 0;
+
+    /*!
+     * Tune to a hop of the table set with set_tx_tune_table().
+     * \param hop the index of the tune request in the table
+     * \param chan the channel index 0 to N-1
+     * \return the tune result of the hop
+     * \throws uhd::index_error if there's no such hop
+     */
+    virtual tune_result_t set_tx_freq_hop(size_t hop, size_t chan = 0) = 0;
+
     /*!
      * Get the TX center frequency range.
      * This range includes the overall tunable range of the TX chain,
@@ -1278,6 +1415,19 @@ public:
      */
     virtual void set_tx_gain(double gain, const std::string& name, size_t chan = 0) = 0;
 
+    /*!
+     * Set the TX gain value of several channels.
+     *
+     * This is equivalent to calling set_tx_gain() for every channel, but
+     * the channels of different motherboards are configured concurrently.
+     *
+     * \param gain the gain in dB
+     * \param name the name of the gain element, or ALL_GAINS
+     * \param chans the channel indexes 0 to N-1
+     */
+    virtual void set_tx_gain(
+        double gain, const std::string& name, const std::vector<size_t>& chans) = 0;
+
     /*! Get a list of possible TX gain profile options
      *
      * Example: On the N310, this will return "manual" or "default".
@@ -1441,6 +1591,17 @@ public:
      */
     virtual std::vector<std::string> get_tx_sensor_names(size_t chan = 0) = 0;
 
+    /*!
+     * Get the values of all TX frontend sensors.
+     * See get_mboard_sensors() for how they are read and cached.
+     * \param chan the channel index 0 to N-1
+     * \param max_age the maximum age of cached values in seconds, zero to
+     *                always read the sensors
+     * \return the sensor values, by sensor name
+     */
+    virtual std::map<std::string, sensor_value_t> get_tx_sensors(
+        size_t chan = 0, double max_age = 0.0) = 0;
+
     /*!
      * Set a constant TX DC offset value.
      * The value is complex to control both I and Q.
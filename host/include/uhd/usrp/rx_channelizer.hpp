@@ -0,0 +1,87 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHD_USRP_RX_CHANNELIZER_HPP
+#define INCLUDED_UHD_USRP_RX_CHANNELIZER_HPP
+
+#include <uhd/config.hpp>
+#include <uhd/stream.hpp>
+#include <uhd/utils/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+namespace uhd { namespace usrp {
+
+/*!
+ * Split a wideband RX stream into equally spaced narrowband channels
+ *
+ * This is a critically sampled polyphase FFT filter bank on the host. It
+ * receives fc32 samples from a single channel RX streamer, and splits them
+ * into num_chans channels, each decimated by num_chans. Channel c is centered
+ * at c * samp_rate / num_chans relative to the center of the wideband stream,
+ * where the upper half of the channels are the negative frequencies (like the
+ * bins of an FFT).
+ *
+ * Every channel is received through its own RX streamer, which can be used
+ * from its own thread. The wideband stream is received and split when a
+ * channel streamer runs out of samples, so all channels should be received
+ * at about the same pace. Samples of a channel which is not received are
+ * dropped after max_buffered samples, and its streamer reports an overflow.
+ *
+ * Example:
+ * \code{.cpp}
+ * uhd::stream_args_t stream_args("fc32", "sc16");
+ * auto channelizer = uhd::usrp::rx_channelizer::make(
+ *     usrp->get_rx_stream(stream_args), 16, usrp->get_rx_rate());
+ * uhd::rx_streamer::sptr chan3 = channelizer->get_channel_streamer(3);
+ * \endcode
+ */
+class UHD_API rx_channelizer : uhd::noncopyable
+{
+public:
+    typedef boost::shared_ptr<rx_channelizer> sptr;
+
+    virtual ~rx_channelizer(void) = 0;
+
+    /*!
+     * \param streamer the wideband stream, with one channel and the fc32
+     *                 CPU format
+     * \param num_chans the number of channels, a power of two
+     * \param samp_rate the sample rate of \p streamer
+     * \param num_threads the number of threads which filter the stream,
+     *                    including the one which receives it
+     * \param taps_per_chan the length of the filter, in taps per channel.
+     *                      Longer filters have steeper channel edges.
+     * \param max_buffered the maximum number of samples held per channel
+     * \throws uhd::value_error if the parameters are invalid
+     */
+    static sptr make(uhd::rx_streamer::sptr streamer,
+        const size_t num_chans,
+        const double samp_rate,
+        const size_t num_threads   = 1,
+        const size_t taps_per_chan = 16,
+        const size_t max_buffered  = 1 << 20);
+
+    //! Return the number of channels
+    virtual size_t get_num_chans(void) const = 0;
+
+    //! Return the sample rate of every channel
+    virtual double get_chan_rate(void) const = 0;
+
+    //! Return the center frequency of a channel, relative to the wideband stream
+    virtual double get_chan_freq(const size_t chan) const = 0;
+
+    /*!
+     * Get the streamer of a channel
+     *
+     * Stream commands issued on it are passed on to the wideband streamer,
+     * so they affect all channels.
+     */
+    virtual uhd::rx_streamer::sptr get_channel_streamer(const size_t chan) = 0;
+};
+
+}} // namespace uhd::usrp
+
+#endif /* INCLUDED_UHD_USRP_RX_CHANNELIZER_HPP */
@@ -163,6 +163,29 @@ UHD_API uhd_error uhd_rx_streamer_recv(
     size_t *items_recvd
 );
 
+//! Receive one packet per channel without copying or converting it
+/*!
+ * See uhd::rx_streamer::recv_raw() for more details.
+ *
+ * \param h RX streamer handle
+ * \param buffs array of one pointer per channel, set to the packet payloads
+ * \param md handle to RX metadata in which to receive results
+ * \param timeout timeout in seconds to wait for a packet
+ * \param items_recvd pointer to output variable for number of samples received
+ */
+UHD_API uhd_error uhd_rx_streamer_recv_raw(
+    uhd_rx_streamer_handle h,
+    const void** buffs,
+    uhd_rx_metadata_handle *md,
+    double timeout,
+    size_t *items_recvd
+);
+
+//! Release the packets returned by the last call to uhd_rx_streamer_recv_raw()
+UHD_API uhd_error uhd_rx_streamer_release_raw(
+    uhd_rx_streamer_handle h
+);
+
 //! Issue the given stream command
 /*!
  * See uhd::rx_streamer::issue_stream_cmd() for more details.
@@ -0,0 +1,123 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHD_UTILS_FILE_PLAYER_HPP
+#define INCLUDED_UHD_UTILS_FILE_PLAYER_HPP
+
+#include <uhd/config.hpp>
+#include <uhd/types/device_addr.hpp>
+#include <uhd/utils/noncopyable.hpp>
+#include <stdint.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace uhd {
+
+/*! Plays back one stream of samples per file, without reading on the send thread
+ *
+ * Reading a file in chunks on the thread that calls send() turns every seek
+ * or read stall into an underrun. The file player hands out pointers to
+ * samples that are already in memory:
+ *
+ * - In mmap mode (the default where available), the files are mapped into
+ *   memory. A helper thread faults in the pages ahead of the playback
+ *   position, so send() doesn't wait for the disk. With the lock option,
+ *   the whole files are locked into memory instead, so looped playback never
+ *   goes back to the disk.
+ * - In read mode, one reader thread per file reads ahead into a ring of
+ *   blocks. If a file fits into the ring, it is read once and looped
+ *   playback is served from memory.
+ *
+ * Usage:
+ * \code{.cpp}
+ * auto player = uhd::file_player::make(files, sizeof(std::complex<short>));
+ * std::vector<const void*> buffs;
+ * while (not player->is_done()) {
+ *     const size_t num_bytes = player->get_buffs(buffs, 1.0);
+ *     const size_t num_samps = tx_stream->send(buffs, num_bytes / item_size, md);
+ *     player->consume(num_samps * item_size);
+ * }
+ * \endcode
+ *
+ * get_buffs() and consume() must be called from the same thread.
+ *
+ * The following args are supported:
+ * - mode: mmap or read (default: mmap if the platform supports it)
+ * - loop: If given, continue at the start of the files at their end
+ * - block_size: The most bytes get_buffs() returns at once, and the block
+ *   size of read mode (default: 1 MiB). It is rounded up to a multiple of
+ *   the item size.
+ * - num_blocks: Number of blocks per file in read mode (default: 64)
+ * - readahead: Bytes to fault in ahead of the playback position in mmap
+ *   mode (default: 64 MiB)
+ * - lock: If given, lock the whole files into memory in mmap mode
+ * - reader_cpus: CPUs to pin the reader or prefetch threads to, thread i
+ *   uses entry i % size (e.g. 4:5)
+ *
+ * All files are played back in lockstep. If they have different sizes, the
+ * shortest one determines the length.
+ */
+class UHD_API file_player : uhd::noncopyable
+{
+public:
+    typedef std::shared_ptr<file_player> sptr;
+
+    struct stats_t
+    {
+        //! Bytes played back from each file, summed over all files
+        uint64_t bytes_played = 0;
+        //! Number of times the playback started over at the start of the files
+        uint64_t num_loops = 0;
+        //! Number of times get_buffs() got ahead of the reader or prefetcher
+        uint64_t num_waits = 0;
+    };
+
+    virtual ~file_player(void) = 0;
+
+    /*! Make a new file player
+     *
+     * \param files One file per stream
+     * \param item_size Bytes per sample. The files are played back in whole
+     *                  samples, a partial sample at the end is dropped.
+     * \param args Player options, see above
+     * \throws uhd::os_error if a file can't be opened or mapped
+     */
+    static sptr make(const std::vector<std::string>& files,
+        const size_t item_size,
+        const device_addr_t& args = device_addr_t());
+
+    /*! Get the next samples
+     *
+     * \param buffs Filled with one pointer per file
+     * \param timeout Time to wait for the reader threads in seconds
+     * \return The number of bytes that may be read from each buffer, a
+     *         multiple of the item size. 0 if the timeout expired or the
+     *         playback is done.
+     * \throws uhd::io_error if a reader thread failed
+     */
+    virtual size_t get_buffs(std::vector<const void*>& buffs, const double timeout) = 0;
+
+    /*! Mark \p num_bytes of every buffer from get_buffs() as played
+     *
+     * The buffers from get_buffs() are only valid until the next call to
+     * consume().
+     */
+    virtual void consume(const size_t num_bytes) = 0;
+
+    //! Return true if playback reached the end of the files (never with loop)
+    virtual bool is_done(void) const = 0;
+
+    //! Return the number of bytes played back per file and pass
+    virtual uint64_t get_size(void) const = 0;
+
+    //! Return statistics of the playback so far
+    virtual stats_t get_stats(void) const = 0;
+};
+
+} // namespace uhd
+
+#endif /* INCLUDED_UHD_UTILS_FILE_PLAYER_HPP */
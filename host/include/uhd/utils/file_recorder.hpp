@@ -0,0 +1,130 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHD_UTILS_FILE_RECORDER_HPP
+#define INCLUDED_UHD_UTILS_FILE_RECORDER_HPP
+
+#include <uhd/config.hpp>
+#include <uhd/types/device_addr.hpp>
+#include <uhd/utils/noncopyable.hpp>
+#include <stdint.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace uhd {
+
+/*! Records one stream of samples per file, off the receive thread
+ *
+ * Calling recv() and writing to a file on the same thread turns every stall
+ * of the disk into an overflow. The file recorder hands out large blocks of
+ * memory to receive into and writes them to disk from one writer thread per
+ * file. Between the receive thread and a writer thread, the blocks travel
+ * through lock-free rings, so the receive thread only has to wait if all
+ * blocks are waiting to be written.
+ *
+ * Usage:
+ * \code{.cpp}
+ * auto recorder = uhd::file_recorder::make(files, sizeof(std::complex<short>));
+ * std::vector<void*> buffs;
+ * while (...) {
+ *     const size_t num_bytes = recorder->get_buffs(buffs, 1.0);
+ *     const size_t num_samps = rx_stream->recv(buffs, num_bytes / item_size, md);
+ *     recorder->commit(num_samps * item_size);
+ * }
+ * recorder->close();
+ * \endcode
+ *
+ * get_buffs(), commit() and close() must all be called from the same thread.
+ *
+ * The following args are supported:
+ * - block_size: Bytes per block and file (default: 1 MiB). It is rounded up
+ *   to a multiple of the item size and of the direct I/O alignment.
+ * - num_blocks: Number of blocks per file (default: 64). This is how much
+ *   data can be buffered while the disk is stalled.
+ * - direct_io: If given, open the files with O_DIRECT to bypass the page
+ *   cache. Falls back to buffered writes if the file system does not
+ *   support it.
+ * - io_uring: If given, submit the writes through io_uring, keeping up to
+ *   io_uring_depth writes per file in flight.
+ * - io_uring_depth: Writes in flight per file with io_uring (default: 4)
+ * - preallocate: Bytes to allocate for every file up front (default: 0).
+ *   The files are truncated to the recorded size when they are closed.
+ * - writer_cpus: CPUs to pin the writer threads to, writer i uses entry
+ *   i % size (e.g. 4:5)
+ * - compress: If given, the writer threads compress every block of sc16
+ *   samples losslessly before writing it, see
+ *   uhd::convert::get_max_compressed_size(). The file is a sequence of
+ *   compressed blocks, and bytes_written counts the compressed bytes. Can't
+ *   be combined with direct_io or io_uring.
+ *
+ * Options that the platform does not support are ignored with a warning.
+ */
+class UHD_API file_recorder : uhd::noncopyable
+{
+public:
+    typedef std::shared_ptr<file_recorder> sptr;
+
+    struct stats_t
+    {
+        //! Bytes written to each file, summed over all files
+        uint64_t bytes_written = 0;
+        //! Blocks written, summed over all files
+        uint64_t blocks_written = 0;
+        //! Number of times get_buffs() had to wait for a free block
+        uint64_t num_waits = 0;
+        //! Highest number of blocks of a file that were waiting to be written
+        size_t max_blocks_queued = 0;
+    };
+
+    virtual ~file_recorder(void) = 0;
+
+    /*! Make a new file recorder
+     *
+     * \param files One file per stream, existing files are overwritten
+     * \param item_size Bytes per sample. No sample is split across blocks.
+     * \param args Recorder options, see above
+     * \throws uhd::os_error if a file can't be opened
+     */
+    static sptr make(const std::vector<std::string>& files,
+        const size_t item_size,
+        const device_addr_t& args = device_addr_t());
+
+    /*! Get the memory for the next samples
+     *
+     * Waits until there is a free block if necessary.
+     *
+     * \param buffs Filled with one pointer per file
+     * \param timeout Time to wait for a free block in seconds
+     * \return The number of bytes that may be written to each buffer, a
+     *         multiple of the item size. 0 if the timeout expired.
+     * \throws uhd::io_error if a writer thread failed
+     */
+    virtual size_t get_buffs(std::vector<void*>& buffs, const double timeout) = 0;
+
+    /*! Mark \p num_bytes of every buffer from get_buffs() as written
+     *
+     * Full blocks are handed to the writer threads.
+     */
+    virtual void commit(const size_t num_bytes) = 0;
+
+    /*! Write the remaining data, then close all files
+     *
+     * This is also done on destruction, but close() reports errors.
+     * \throws uhd::io_error if a writer thread failed
+     */
+    virtual void close(void) = 0;
+
+    //! Return the block size in bytes
+    virtual size_t get_block_size(void) const = 0;
+
+    //! Return statistics of the recording so far
+    virtual stats_t get_stats(void) const = 0;
+};
+
+} // namespace uhd
+
+#endif /* INCLUDED_UHD_UTILS_FILE_RECORDER_HPP */
@@ -0,0 +1,150 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHD_UTILS_RX_ASYNC_STREAMER_HPP
+#define INCLUDED_UHD_UTILS_RX_ASYNC_STREAMER_HPP
+
+#include <uhd/config.hpp>
+#include <uhd/stream.hpp>
+#include <uhd/types/device_addr.hpp>
+#include <uhd/types/metadata.hpp>
+#include <uhd/utils/noncopyable.hpp>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace uhd {
+
+/*! Receives from many RX streamers on a small pool of threads
+ *
+ * Calling recv() in a loop needs a thread per streamer, and most of these
+ * threads spend their time waiting in timeouts. The async streamer instead
+ * round-robins all of its streams over a few worker threads. A worker polls a
+ * stream with a short recv() timeout and moves on to the next stream if there
+ * is no data, so no thread is tied to an idle stream.
+ *
+ * Samples are received into buffers from a pool that the application hands
+ * over per stream. Once a buffer is full, or an error or the end of a burst
+ * cut it short, it is delivered either
+ * - to the stream's callback, on a worker thread. The buffer goes back to the
+ *   pool when the callback returns.
+ * - or, without a callback, to the completion queue, see get_completed().
+ *   The buffer goes back to the pool on release(). Event loops can wait for
+ *   the queue with get_completed_fd().
+ *
+ * A stream whose buffers are all out pauses until one is returned, so the
+ * device will eventually overflow if the application can't keep up.
+ *
+ * Usage:
+ * \code{.cpp}
+ * auto async = uhd::rx_async_streamer::make(uhd::device_addr_t("num_threads=2"));
+ * for (auto& rx_stream : rx_streams) {
+ *     async->add_stream(rx_stream, pool, spb, item_size, [](const buffer_t& buffer) {
+ *         process(buffer.buffs, buffer.num_samps, buffer.metadata);
+ *     });
+ * }
+ * async->start();
+ * \endcode
+ *
+ * Streaming itself is started and stopped with stream commands as usual.
+ *
+ * The following args are supported:
+ * - num_threads: Number of worker threads (default: 1)
+ * - poll_timeout: recv() timeout while polling a stream in seconds
+ *   (default: 100e-6). Longer timeouts cost latency on the other streams of
+ *   a worker, shorter ones cost CPU while the streams are idle.
+ * - worker_cpus: CPUs to pin the workers to, worker i uses entry i % size
+ *   (e.g. 4:5)
+ */
+class UHD_API rx_async_streamer : uhd::noncopyable
+{
+public:
+    typedef std::shared_ptr<rx_async_streamer> sptr;
+
+    //! A filled buffer
+    struct buffer_t
+    {
+        //! Index of the stream, as returned by add_stream()
+        size_t stream = 0;
+        //! One pointer per channel, as given to add_stream()
+        std::vector<void*> buffs;
+        //! Samples per channel in the buffer
+        size_t num_samps = 0;
+        //! Metadata of the samples, with the time spec of the first sample
+        rx_metadata_t metadata;
+    };
+
+    //! Called on a worker thread with every filled buffer of a stream
+    typedef std::function<void(const buffer_t&)> callback_t;
+
+    virtual ~rx_async_streamer(void) = 0;
+
+    /*! Make a new async streamer
+     *
+     * \param args Options, see above
+     */
+    static sptr make(const device_addr_t& args = device_addr_t());
+
+    /*! Add a stream
+     *
+     * Must be called before start().
+     *
+     * \param rx_stream The streamer to receive from. No other thread may use
+     *                  it while the async streamer runs.
+     * \param pool The buffers to receive into. Each entry has one pointer per
+     *             channel of the streamer, with room for \p samps_per_buff
+     *             samples in the streamer's CPU format.
+     * \param samps_per_buff Samples per channel and buffer
+     * \param item_size Bytes per sample in the streamer's CPU format
+     * \param callback Called with every filled buffer. If empty, the buffers
+     *                 go to the completion queue instead.
+     * \return The index of the stream
+     * \throws uhd::value_error if the pool is empty or doesn't match the
+     *         number of channels
+     */
+    virtual size_t add_stream(rx_streamer::sptr rx_stream,
+        const std::vector<std::vector<void*>>& pool,
+        const size_t samps_per_buff,
+        const size_t item_size,
+        const callback_t& callback = callback_t()) = 0;
+
+    //! Start the worker threads
+    virtual void start(void) = 0;
+
+    /*! Stop the worker threads
+     *
+     * Partially filled buffers are dropped. This is also done on destruction.
+     */
+    virtual void stop(void) = 0;
+
+    /*! Get the next filled buffer from the completion queue
+     *
+     * Only buffers of streams without a callback end up in the queue.
+     *
+     * \param buffer Set to the buffer
+     * \param timeout Time to wait for a buffer in seconds
+     * \return false if the timeout expired
+     */
+    virtual bool get_completed(buffer_t& buffer, const double timeout) = 0;
+
+    //! Return a buffer from get_completed() to the pool of its stream
+    virtual void release(const buffer_t& buffer) = 0;
+
+    /*! Return a file descriptor that is readable while the completion queue
+     * is not empty
+     *
+     * This lets an event loop (poll, epoll, io_uring) wait for received
+     * samples next to its other descriptors, and then call get_completed()
+     * with a zero timeout. Don't read from or close the descriptor.
+     *
+     * \return The descriptor, or -1 if the platform doesn't support it
+     */
+    virtual int get_completed_fd(void) const = 0;
+};
+
+} // namespace uhd
+
+#endif /* INCLUDED_UHD_UTILS_RX_ASYNC_STREAMER_HPP */
@@ -0,0 +1,198 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHD_UTILS_SHM_STREAM_HPP
+#define INCLUDED_UHD_UTILS_SHM_STREAM_HPP
+
+#include <uhd/config.hpp>
+#include <uhd/stream.hpp>
+#include <uhd/types/device_addr.hpp>
+#include <uhd/types/metadata.hpp>
+#include <uhd/utils/noncopyable.hpp>
+#include <stdint.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace uhd {
+
+/*! Publishes an RX stream to other processes through shared memory
+ *
+ * Only one process can own an RX streamer. To share its samples with other
+ * processes, e.g. a recorder and a spectrum monitor, that process publishes
+ * them into a ring of slots in shared memory (/dev/shm/<name> on Linux).
+ * Any number of rx_stream_subscriber objects, in any process, read the slots
+ * in place.
+ *
+ * The publisher never waits for subscribers. A subscriber that falls more
+ * than a ring behind is told so with ERROR_CODE_OVERFLOW, like a streamer
+ * whose application doesn't keep up, and continues with the newest slot.
+ *
+ * Converted samples are received straight into a slot:
+ * \code{.cpp}
+ * auto publisher = uhd::rx_stream_publisher::make(
+ *     "usrp_rx", num_channels, sizeof(std::complex<float>), spp, "fc32");
+ * std::vector<void*> buffs;
+ * while (...) {
+ *     const size_t nsamps = publisher->get_buffs(buffs);
+ *     publisher->commit(rx_stream->recv(buffs, nsamps, md, 0.1, true), md);
+ * }
+ * \endcode
+ *
+ * publish_raw() instead copies packets from rx_streamer::recv_raw() in the
+ * over-the-wire format, which leaves the conversion to the subscribers.
+ *
+ * All calls must be made from one thread.
+ *
+ * The following args are supported:
+ * - num_slots: Number of slots in the ring (default: 256). This is how far a
+ *   subscriber may fall behind.
+ */
+class UHD_API rx_stream_publisher : uhd::noncopyable
+{
+public:
+    typedef std::shared_ptr<rx_stream_publisher> sptr;
+
+    //! Unlinks the shared memory, subscribers that have it open keep it
+    virtual ~rx_stream_publisher(void) = 0;
+
+    /*! Make a new publisher
+     *
+     * A stale ring of the same name, e.g. from a crashed publisher, is
+     * replaced.
+     *
+     * \param name Name of the ring, without slashes
+     * \param num_channels Number of channels per slot
+     * \param item_size Bytes per sample
+     * \param samps_per_slot Samples per channel that fit in one slot
+     * \param format Format of the samples, e.g. "fc32" or "sc16_item32_le",
+     *        which is passed on to the subscribers. At most 31 characters.
+     * \param args Options, see above
+     * \throws uhd::os_error if the shared memory can't be made
+     * \throws uhd::not_implemented_error if the platform has no shared memory
+     */
+    static sptr make(const std::string& name,
+        const size_t num_channels,
+        const size_t item_size,
+        const size_t samps_per_slot,
+        const std::string& format,
+        const device_addr_t& args = device_addr_t());
+
+    /*! Get the memory of the next slot
+     *
+     * This never waits. The slot is only visible to subscribers after
+     * commit().
+     *
+     * \param buffs Filled with one pointer per channel
+     * \return The number of samples that fit in each buffer
+     */
+    virtual size_t get_buffs(std::vector<void*>& buffs) = 0;
+
+    /*! Publish the slot from get_buffs()
+     *
+     * Metadata with an error is published as well, so subscribers see
+     * overflows and other errors of the stream.
+     *
+     * \param nsamps Samples per channel that were written to the buffers
+     * \param metadata The metadata of the samples
+     */
+    virtual void commit(const size_t nsamps, const rx_metadata_t& metadata) = 0;
+
+    /*! Receive one packet per channel with recv_raw() and publish it
+     *
+     * \param rx_stream The streamer, with item_size matching its
+     *        over-the-wire format
+     * \param metadata Filled with the metadata of the packets
+     * \param timeout Time to wait for a packet in seconds
+     * \return The number of samples per channel. Timeouts aren't published.
+     * \throws uhd::value_error if a packet doesn't fit in a slot
+     */
+    virtual size_t publish_raw(
+        rx_streamer& rx_stream, rx_metadata_t& metadata, const double timeout) = 0;
+
+    //! Return the number of slots published so far
+    virtual uint64_t get_num_published(void) const = 0;
+};
+
+/*! Reads an RX stream that another process publishes with rx_stream_publisher
+ *
+ * Usage:
+ * \code{.cpp}
+ * auto subscriber = uhd::rx_stream_subscriber::make("usrp_rx");
+ * std::vector<const void*> buffs;
+ * while (not subscriber->is_closed()) {
+ *     const size_t nsamps = subscriber->recv(buffs, md, 0.1);
+ *     process(buffs, nsamps, md);
+ *     if (not subscriber->release()) {
+ *         // The publisher overwrote the slot while it was processed
+ *     }
+ * }
+ * \endcode
+ *
+ * All calls must be made from one thread.
+ */
+class UHD_API rx_stream_subscriber : uhd::noncopyable
+{
+public:
+    typedef std::shared_ptr<rx_stream_subscriber> sptr;
+
+    virtual ~rx_stream_subscriber(void) = 0;
+
+    /*! Open a ring made by rx_stream_publisher::make()
+     *
+     * Reading starts with the next slot that is published.
+     *
+     * \param name Name of the ring
+     * \throws uhd::os_error if there is no such ring
+     * \throws uhd::not_implemented_error if the platform has no shared memory
+     */
+    static sptr make(const std::string& name);
+
+    //! Return the number of channels per slot
+    virtual size_t get_num_channels(void) const = 0;
+
+    //! Return the bytes per sample
+    virtual size_t get_item_size(void) const = 0;
+
+    //! Return the samples per channel that fit in one slot
+    virtual size_t get_samps_per_slot(void) const = 0;
+
+    //! Return the format of the samples, as given to the publisher
+    virtual std::string get_format(void) const = 0;
+
+    /*! Get the next slot without copying it
+     *
+     * The pointers stay valid until release() or the next call to recv().
+     * The publisher doesn't wait for subscribers, so a slot that is held
+     * for longer than it takes to publish a ring of slots gets overwritten;
+     * release() reports that.
+     *
+     * \param buffs Filled with one pointer per channel into the shared memory
+     * \param metadata Filled with the metadata of the slot.
+     *        ERROR_CODE_OVERFLOW means slots were skipped because this
+     *        subscriber fell behind. ERROR_CODE_TIMEOUT means nothing was
+     *        published in time.
+     * \param timeout Time to wait for a slot in seconds
+     * \return The number of samples per channel
+     */
+    virtual size_t recv(std::vector<const void*>& buffs,
+        rx_metadata_t& metadata,
+        const double timeout = 0.1) = 0;
+
+    /*! Release the slot of the last recv()
+     *
+     * \return false if the publisher overwrote the slot while it was held,
+     *         so the data that was read may be torn
+     */
+    virtual bool release(void) = 0;
+
+    //! Return true once the publisher is gone
+    virtual bool is_closed(void) const = 0;
+};
+
+} // namespace uhd
+
+#endif /* INCLUDED_UHD_UTILS_SHM_STREAM_HPP */
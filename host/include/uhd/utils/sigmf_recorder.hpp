@@ -0,0 +1,221 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHD_UTILS_SIGMF_RECORDER_HPP
+#define INCLUDED_UHD_UTILS_SIGMF_RECORDER_HPP
+
+#include <uhd/config.hpp>
+#include <uhd/types/device_addr.hpp>
+#include <uhd/types/metadata.hpp>
+#include <uhd/types/time_spec.hpp>
+#include <uhd/utils/file_recorder.hpp>
+#include <uhd/utils/noncopyable.hpp>
+#include <stdint.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace uhd {
+
+/*! Records streams of samples as SigMF recordings with a time index
+ *
+ * Every stream is written to a SigMF recording of three files:
+ * - <base>.sigmf-data: The samples, written by a uhd::file_recorder
+ * - <base>.sigmf-meta: The SigMF metadata. It is written on close(), with
+ *   one capture segment per discontinuity (start, gap in the time stamps,
+ *   overflow, retune) and one annotation per overflow.
+ * - <base>.sigmf-idx: A binary time index, see uhd::sigmf_index. Its
+ *   entries are appended while recording, so a recording that was cut short
+ *   can still be searched up to its last entry.
+ *
+ * The index gets an entry for every discontinuity, and one every
+ * index_interval samples in between. Since the sample rate is constant
+ * between entries, uhd::sigmf_index can map a time to a sample offset with
+ * a binary search over the entries.
+ *
+ * Usage is like uhd::file_recorder, but commit() also takes the metadata of
+ * the recv() call:
+ * \code{.cpp}
+ * uhd::sigmf_recorder::info_t info;
+ * info.cpu_format = "sc16";
+ * info.rate       = rx_stream_rate;
+ * auto recorder   = uhd::sigmf_recorder::make(bases, info);
+ * recorder->set_freq(freq, 0);
+ * while (...) {
+ *     const size_t num_bytes = recorder->get_buffs(buffs, 1.0);
+ *     const size_t num_samps = rx_stream->recv(buffs, num_bytes / item_size, md);
+ *     recorder->commit(num_samps * item_size, md);
+ * }
+ * recorder->close();
+ * \endcode
+ *
+ * Besides the args of uhd::file_recorder (except compress, which SigMF
+ * readers wouldn't understand), the following args are supported:
+ * - index_interval: Samples between two index entries, if there is no
+ *   discontinuity in between (default: 1048576)
+ *
+ * All methods must be called from the same thread.
+ */
+class UHD_API sigmf_recorder : uhd::noncopyable
+{
+public:
+    typedef std::shared_ptr<sigmf_recorder> sptr;
+
+    struct info_t
+    {
+        //! The CPU format of the samples, e.g. "sc16" (SigMF type ci16_le)
+        std::string cpu_format = "sc16";
+        //! The sample rate in Hz
+        double rate = 0.0;
+        //! Goes to core:hw, if not empty
+        std::string hw;
+        //! Goes to core:description, if not empty
+        std::string description;
+    };
+
+    virtual ~sigmf_recorder(void) = 0;
+
+    /*! Make a new SigMF recorder
+     *
+     * \param bases One base path per stream, the extensions are appended.
+     *              Existing recordings are overwritten.
+     * \param info Describes the samples
+     * \param args Recorder options, see above
+     * \throws uhd::value_error if the CPU format has no SigMF type
+     * \throws uhd::os_error if a file can't be opened
+     */
+    static sptr make(const std::vector<std::string>& bases,
+        const info_t& info,
+        const device_addr_t& args = device_addr_t());
+
+    //! See uhd::file_recorder::get_buffs()
+    virtual size_t get_buffs(std::vector<void*>& buffs, const double timeout) = 0;
+
+    /*! Mark \p num_bytes of every buffer from get_buffs() as written
+     *
+     * \param num_bytes Bytes per stream, may be 0
+     * \param metadata The metadata of the recv() call that filled the buffers.
+     *        An overflow is noted at the next sample, even if \p num_bytes is
+     *        0. The time spec of the first sample is compared to the time
+     *        the previous samples imply, to detect gaps.
+     */
+    virtual void commit(const size_t num_bytes, const rx_metadata_t& metadata) = 0;
+
+    /*! Note that stream \p chan was tuned to \p freq
+     *
+     * Starts a new capture segment at the next sample. Before the first
+     * sample, this only sets the frequency of the first capture segment.
+     */
+    virtual void set_freq(const double freq, const size_t chan) = 0;
+
+    /*! Write the remaining data and the metadata, then close all files
+     *
+     * This is also done on destruction, but close() reports errors.
+     * \throws uhd::io_error if a file could not be written
+     */
+    virtual void close(void) = 0;
+
+    //! Return the number of samples per stream recorded so far
+    virtual uint64_t get_num_samps(void) const = 0;
+
+    //! Return statistics of the data files
+    virtual file_recorder::stats_t get_stats(void) const = 0;
+};
+
+/*! Reads the time index of a SigMF recording made by uhd::sigmf_recorder
+ *
+ * The index file starts with a 32 byte header:
+ * - char magic[8]: "UHDSIGX" and a null byte
+ * - uint32_t version: 1
+ * - uint32_t entry_size: 40
+ * - double rate: The sample rate in Hz
+ * - uint32_t item_size: Bytes per sample
+ * - uint32_t reserved
+ *
+ * It is followed by entries of 40 bytes each, in the order of their sample
+ * offset:
+ * - uint64_t sample_offset
+ * - int64_t full_secs, double frac_secs: The time of the sample, if
+ *   INDEX_TIME is set
+ * - double freq: The center frequency in Hz
+ * - uint32_t flags: INDEX_* flags
+ * - uint32_t reserved
+ *
+ * All values are in the byte order of the host that recorded them. Entries
+ * are read from the file as they are needed, so opening the index of a
+ * long recording is fast and lookups take O(log n) reads.
+ *
+ * Lookups by time assume that the device time increased during the
+ * recording, i.e., that it wasn't set while streaming.
+ */
+class UHD_API sigmf_index : uhd::noncopyable
+{
+public:
+    typedef std::shared_ptr<sigmf_index> sptr;
+
+    enum flags_t : uint32_t {
+        //! The entry has a time spec
+        INDEX_TIME = 1 << 0,
+        //! The first sample of the recording
+        INDEX_START = 1 << 1,
+        //! The time stamps jumped, samples are missing before this one
+        INDEX_GAP = 1 << 2,
+        //! The device reported an overflow before this sample
+        INDEX_OVERFLOW = 1 << 3,
+        //! The stream was retuned before this sample
+        INDEX_TUNE = 1 << 4,
+        //! Marks the end of the recording, the offset is the number of samples
+        INDEX_END = 1 << 5
+    };
+
+    struct entry_t
+    {
+        uint64_t sample_offset = 0;
+        time_spec_t time_spec;
+        double freq    = 0.0;
+        uint32_t flags = 0;
+    };
+
+    virtual ~sigmf_index(void) = 0;
+
+    /*! Open the index file \p path, i.e., <base>.sigmf-idx
+     *
+     * \throws uhd::os_error if the file can't be opened
+     * \throws uhd::value_error if it is not an index
+     */
+    static sptr make(const std::string& path);
+
+    //! Return the sample rate of the recording
+    virtual double get_rate(void) const = 0;
+
+    //! Return the bytes per sample
+    virtual size_t get_item_size(void) const = 0;
+
+    //! Return the number of entries
+    virtual size_t get_num_entries(void) const = 0;
+
+    //! Read entry \p index
+    virtual entry_t get_entry(const size_t index) const = 0;
+
+    /*! Return the offset of the sample closest to \p time_spec
+     *
+     * Times in a gap map to the first sample after it, times before the
+     * recording to 0, and times after the end to the end.
+     *
+     * \throws uhd::runtime_error if the recording has no time stamps
+     */
+    virtual uint64_t find(const time_spec_t& time_spec) const = 0;
+
+    /*! Return the time of the sample at \p sample_offset
+     *
+     * \throws uhd::runtime_error if the recording has no time stamps
+     */
+    virtual time_spec_t get_time(const uint64_t sample_offset) const = 0;
+};
+
+} // namespace uhd
+
+#endif /* INCLUDED_UHD_UTILS_SIGMF_RECORDER_HPP */
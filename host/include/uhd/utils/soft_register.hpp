@@ -19,6 +19,7 @@
 #include <boost/tokenizer.hpp>
 #include <boost/unordered_map.hpp>
 #include <list>
+#include <vector>
 
 /*! \file soft_register.hpp
  * Utilities to access and index hardware registers.
@@ -112,6 +113,29 @@ public:
     virtual bool is_readable()                                  = 0;
     virtual bool is_writable()                                  = 0;
 
+    /*!
+     * Get the 32-bit write that flush() would do, so that a register map can
+     * send the writes of many registers in one transaction. Call
+     * mark_flushed32() once the write went through.
+     * \param addr the address of the write
+     * \param data the data of the write
+     * \return the bus of the write, or NULL if flush() has to be called
+     *         instead (nothing to write, or not a 32-bit write)
+     */
+    virtual wb_iface* get_flush32(wb_iface::wb_addr_type& /*addr*/, uint32_t& /*data*/)
+    {
+        return NULL;
+    }
+
+    //! Mark the register clean after \p data from get_flush32() was written
+    virtual void mark_flushed32(const uint32_t /*data*/) {}
+
+    //! Does flush() do anything? False if it would skip a clean register.
+    virtual bool is_flush_needed()
+    {
+        return true;
+    }
+
     /*!
      * Cast the soft_register generic reference to a more specific type
      */
@@ -233,6 +257,31 @@ public:
         }
     }
 
+    UHD_INLINE wb_iface* get_flush32(wb_iface::wb_addr_type& addr, uint32_t& data)
+    {
+        if (writable && _iface && get_bitwidth() == 32
+            && (_flush_mode == ALWAYS_FLUSH || _soft_copy.is_dirty())) {
+            addr = _wr_addr;
+            data = static_cast<uint32_t>(_soft_copy);
+            return _iface;
+        }
+        return NULL;
+    }
+
+    UHD_INLINE void mark_flushed32(const uint32_t data)
+    {
+        // Stays dirty if the soft copy changed in the meantime
+        if (static_cast<uint32_t>(_soft_copy) == data) {
+            _soft_copy.mark_clean();
+        }
+    }
+
+    UHD_INLINE bool is_flush_needed()
+    {
+        return not(writable && _iface) || _flush_mode == ALWAYS_FLUSH
+               || _soft_copy.is_dirty();
+    }
+
     /*!
      * Read the contents of the register from hardware and update the soft copy.
      */
@@ -356,6 +405,24 @@ public:
         soft_register_t<reg_data_t, readable, writable>::flush();
     }
 
+    UHD_INLINE wb_iface* get_flush32(wb_iface::wb_addr_type& addr, uint32_t& data)
+    {
+        boost::lock_guard<boost::mutex> lock(_mutex);
+        return soft_register_t<reg_data_t, readable, writable>::get_flush32(addr, data);
+    }
+
+    UHD_INLINE void mark_flushed32(const uint32_t data)
+    {
+        boost::lock_guard<boost::mutex> lock(_mutex);
+        soft_register_t<reg_data_t, readable, writable>::mark_flushed32(data);
+    }
+
+    UHD_INLINE bool is_flush_needed()
+    {
+        boost::lock_guard<boost::mutex> lock(_mutex);
+        return soft_register_t<reg_data_t, readable, writable>::is_flush_needed();
+    }
+
     UHD_INLINE void refresh()
     {
         boost::lock_guard<boost::mutex> lock(_mutex);
@@ -504,13 +571,38 @@ public:
     /*!
      * Flush all registers to hardware.
      * The order of writing is the same as the order in
-     * which registers were added to the map.
+     * which registers were added to the map. Consecutive 32-bit writes
+     * to the same bus are sent in one transaction with
+     * wb_iface::multi_poke32().
      */
     void flush()
     {
         boost::lock_guard<boost::mutex> lock(_mutex);
+        wb_iface* batch_iface = NULL;
+        std::vector<soft_register_base*> batch_regs;
+        std::vector<wb_iface::wb_addr_type> batch_addrs;
+        std::vector<uint32_t> batch_data;
         BOOST_FOREACH (soft_register_base* reg, _reglist) {
-            reg->flush();
+            if (not reg->is_flush_needed()) {
+                continue;
+            }
+            wb_iface::wb_addr_type addr = 0;
+            uint32_t data               = 0;
+            wb_iface* iface             = reg->get_flush32(addr, data);
+            if (iface != batch_iface and not batch_regs.empty()) {
+                _flush_batch(batch_iface, batch_regs, batch_addrs, batch_data);
+            }
+            if (iface) {
+                batch_iface = iface;
+                batch_regs.push_back(reg);
+                batch_addrs.push_back(addr);
+                batch_data.push_back(data);
+            } else {
+                reg->flush();
+            }
+        }
+        if (not batch_regs.empty()) {
+            _flush_batch(batch_iface, batch_regs, batch_addrs, batch_data);
         }
     }
 
@@ -582,6 +674,20 @@ private:
     typedef boost::unordered_map<std::string, soft_register_base*> regmap_t;
     typedef std::list<soft_register_base*> reglist_t;
 
+    static void _flush_batch(wb_iface* iface,
+        std::vector<soft_register_base*>& regs,
+        std::vector<wb_iface::wb_addr_type>& addrs,
+        std::vector<uint32_t>& data)
+    {
+        iface->multi_poke32(addrs, data);
+        for (size_t i = 0; i < regs.size(); i++) {
+            regs[i]->mark_flushed32(data[i]);
+        }
+        regs.clear();
+        addrs.clear();
+        data.clear();
+    }
+
     const std::string _name;
     regmap_t _regmap; // For lookups
     reglist_t _reglist; // To maintain order
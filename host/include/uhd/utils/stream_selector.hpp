@@ -0,0 +1,94 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHD_UTILS_STREAM_SELECTOR_HPP
+#define INCLUDED_UHD_UTILS_STREAM_SELECTOR_HPP
+
+#include <uhd/config.hpp>
+#include <uhd/stream.hpp>
+#include <uhd/types/device_addr.hpp>
+#include <uhd/utils/noncopyable.hpp>
+#include <memory>
+#include <vector>
+
+namespace uhd {
+
+/*! Waits until any of a set of streamers is ready, like select() on sockets
+ *
+ * Serving many streamers from one thread otherwise means calling recv() on
+ * each of them in turn with a zero timeout, which keeps a CPU core busy
+ * while the streams are idle. The selector instead sleeps in poll() on the
+ * descriptors of the streamers' transports (see
+ * rx_streamer::prepare_recv_wait()) and on the async message descriptors of
+ * TX streamers (see tx_streamer::get_async_msg_fd()).
+ *
+ * An RX streamer whose transports can't be waited on, e.g. on Windows, is
+ * reported as ready once per poll interval. The application then calls
+ * recv() on it with a zero timeout, like it would without a selector.
+ *
+ * Usage:
+ * \code{.cpp}
+ * auto selector = uhd::stream_selector::make();
+ * for (auto& rx_stream : rx_streams) {
+ *     selector->add_rx_streamer(rx_stream);
+ * }
+ * while (running) {
+ *     for (const size_t index : selector->wait(0.1)) {
+ *         rx_streams[index]->recv(buffs, spb, md, 0.0);
+ *     }
+ * }
+ * \endcode
+ *
+ * The streamers must only be used from the thread that calls wait(). A
+ * streamer that is ready can still time out in recv(), e.g. when only some
+ * of its channels have packets, so call recv() with a short timeout.
+ *
+ * The following args are supported:
+ * - poll_interval: Time between reports of streamers that can't be waited
+ *   on, in seconds (default: 1e-3)
+ */
+class UHD_API stream_selector : uhd::noncopyable
+{
+public:
+    typedef std::shared_ptr<stream_selector> sptr;
+
+    virtual ~stream_selector(void) = 0;
+
+    /*! Make a new selector
+     *
+     * \param args Options, see above
+     */
+    static sptr make(const device_addr_t& args = device_addr_t());
+
+    /*! Add an RX streamer, which is ready when recv() has data
+     *
+     * \param rx_stream The streamer
+     * \return The index of the streamer. RX and TX streamers share the
+     *         numbering.
+     */
+    virtual size_t add_rx_streamer(rx_streamer::sptr rx_stream) = 0;
+
+    /*! Add a TX streamer, which is ready when recv_async_msg() has messages
+     *
+     * \param tx_stream The streamer, made with the "async_msg_fd" stream arg
+     * \return The index of the streamer
+     * \throws uhd::value_error if the streamer doesn't provide a descriptor
+     */
+    virtual size_t add_tx_streamer(tx_streamer::sptr tx_stream) = 0;
+
+    /*! Wait until streamers are ready
+     *
+     * \param timeout Time to wait in seconds
+     * \return The indexes of the ready streamers in ascending order, empty if
+     *         the timeout expired
+     * \throws uhd::os_error if poll() fails
+     */
+    virtual std::vector<size_t> wait(const double timeout) = 0;
+};
+
+} // namespace uhd
+
+#endif /* INCLUDED_UHD_UTILS_STREAM_SELECTOR_HPP */
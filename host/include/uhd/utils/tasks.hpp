@@ -36,6 +36,32 @@ public:
      * \return a new task object
      */
     static sptr make(const task_fcn_type& task_fcn, const std::string& name = "");
+
+    /*!
+     * Create a new task object which calls a function periodically.
+     *
+     * Periodic tasks don't get a thread of their own. They share a small pool
+     * of housekeeping threads, so they are meant for things like keeping a
+     * device claimed, not for anything on the streaming path (use make() for
+     * that). The size of the pool defaults to 2 and may be set with the
+     * UHD_HOUSEKEEPING_THREADS environment variable.
+     *
+     * The first call happens right away, the following ones \p period
+     * seconds after the previous call started (or right after it returned,
+     * if it took longer than that). The callback must not block for long,
+     * because it holds up the other periodic tasks on the same thread.
+     * If the callback throws, the error is logged and the task stops.
+     *
+     * Destroying the task waits for a running call to return, and no call
+     * happens afterwards.
+     *
+     * \param task_fcn the task callback function
+     * \param period Time between calls in seconds
+     * \param name Task name. Will be used in error messages.
+     * \return a new task object
+     */
+    static sptr make_periodic(
+        const task_fcn_type& task_fcn, const double period, const std::string& name = "");
 };
 } // namespace uhd
 
@@ -11,6 +11,7 @@
 #include <uhd/config.hpp>
 #include <boost/thread/thread.hpp>
 #include <string>
+#include <vector>
 
 namespace uhd {
 
@@ -48,6 +49,18 @@ UHD_API bool set_thread_priority_safe(
  */
 UHD_API void set_thread_name(boost::thread* thread, const std::string& name);
 
+/*!
+ * Set the affinity of the current thread to a (set of) CPU(s).
+ *
+ * Memory that a thread touches first is usually placed on the NUMA node the
+ * thread runs on. Pinning a thread before it allocates or fills its buffers
+ * therefore also keeps these buffers on the local node.
+ *
+ * Failures are logged, not thrown. An empty list leaves the affinity alone.
+ * \param cpu_affinity_list list of CPU numbers to affinitize the thread to
+ */
+UHD_API void set_thread_affinity(const std::vector<size_t>& cpu_affinity_list);
+
 } // namespace uhd
 
 #endif /* INCLUDED_UHD_UTILS_THREAD_HPP */
@@ -0,0 +1,66 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_avx_common.hpp"
+#include "convert_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+#include <immintrin.h>
+
+using namespace uhd::convert;
+
+template <xtox_t to_host>
+UHD_CONVERT_TARGET_AVX2 static void convert_sc16_item32_1_to_fc32_1_avx2(
+    const item32_t* input,
+    fc32_t* output,
+    const size_t nsamps,
+    const double scale_factor,
+    const uint8_t* shuffle_mask)
+{
+    const __m256 scalar   = _mm256_set1_ps(float(scale_factor));
+    const __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(shuffle_mask));
+
+    size_t i = 0;
+    for (; i + 7 < nsamps; i += 8) {
+        // load 2x4 items and bring the shorts into I, Q order
+        __m128i tmpi0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+        __m128i tmpi1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i + 4));
+        tmpi0         = _mm_shuffle_epi8(tmpi0, shuffle);
+        tmpi1         = _mm_shuffle_epi8(tmpi1, shuffle);
+
+        // sign-extend, convert and scale
+        const __m256 tmp0 =
+            _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(tmpi0)), scalar);
+        const __m256 tmp1 =
+            _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(tmpi1)), scalar);
+
+        // store to output
+        _mm256_storeu_ps(reinterpret_cast<float*>(output + i + 0), tmp0);
+        _mm256_storeu_ps(reinterpret_cast<float*>(output + i + 4), tmp1);
+    }
+
+    // convert any remaining samples
+    item32_sc16_to_xx<to_host>(input + i, output + i, nsamps - i, scale_factor);
+}
+
+DECLARE_CONVERTER_IF(
+    convert_cpu_has_avx2(), sc16_item32_le, 1, fc32, 1, PRIORITY_SIMD_AVX2)
+{
+    const item32_t* input = reinterpret_cast<const item32_t*>(inputs[0]);
+    fc32_t* output        = reinterpret_cast<fc32_t*>(outputs[0]);
+
+    convert_sc16_item32_1_to_fc32_1_avx2<uhd::wtohx>(
+        input, output, nsamps, scale_factor, SC16_LE_SHUFFLE);
+}
+
+DECLARE_CONVERTER_IF(
+    convert_cpu_has_avx2(), sc16_item32_be, 1, fc32, 1, PRIORITY_SIMD_AVX2)
+{
+    const item32_t* input = reinterpret_cast<const item32_t*>(inputs[0]);
+    fc32_t* output        = reinterpret_cast<fc32_t*>(outputs[0]);
+
+    convert_sc16_item32_1_to_fc32_1_avx2<uhd::ntohx>(
+        input, output, nsamps, scale_factor, SC16_BE_SHUFFLE);
+}
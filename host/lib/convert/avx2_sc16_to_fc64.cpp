@@ -0,0 +1,64 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_avx_common.hpp"
+#include "convert_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+#include <immintrin.h>
+
+using namespace uhd::convert;
+
+template <xtox_t to_host>
+UHD_CONVERT_TARGET_AVX2 static void convert_sc16_item32_1_to_fc64_1_avx2(
+    const item32_t* input,
+    fc64_t* output,
+    const size_t nsamps,
+    const double scale_factor,
+    const uint8_t* shuffle_mask)
+{
+    const __m256d scalar  = _mm256_set1_pd(scale_factor);
+    const __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(shuffle_mask));
+
+    size_t i = 0;
+    for (; i + 3 < nsamps; i += 4) {
+        // load 4 items and bring the shorts into I, Q order
+        __m128i tmpi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+        tmpi         = _mm_shuffle_epi8(tmpi, shuffle);
+
+        // sign-extend, convert and scale
+        const __m128i tmpilo = _mm_cvtepi16_epi32(tmpi);
+        const __m128i tmpihi = _mm_cvtepi16_epi32(_mm_srli_si128(tmpi, 8));
+        const __m256d tmplo  = _mm256_mul_pd(_mm256_cvtepi32_pd(tmpilo), scalar);
+        const __m256d tmphi  = _mm256_mul_pd(_mm256_cvtepi32_pd(tmpihi), scalar);
+
+        // store to output
+        _mm256_storeu_pd(reinterpret_cast<double*>(output + i + 0), tmplo);
+        _mm256_storeu_pd(reinterpret_cast<double*>(output + i + 2), tmphi);
+    }
+
+    // convert any remaining samples
+    item32_sc16_to_xx<to_host>(input + i, output + i, nsamps - i, scale_factor);
+}
+
+DECLARE_CONVERTER_IF(
+    convert_cpu_has_avx2(), sc16_item32_le, 1, fc64, 1, PRIORITY_SIMD_AVX2)
+{
+    const item32_t* input = reinterpret_cast<const item32_t*>(inputs[0]);
+    fc64_t* output        = reinterpret_cast<fc64_t*>(outputs[0]);
+
+    convert_sc16_item32_1_to_fc64_1_avx2<uhd::wtohx>(
+        input, output, nsamps, scale_factor, SC16_LE_SHUFFLE);
+}
+
+DECLARE_CONVERTER_IF(
+    convert_cpu_has_avx2(), sc16_item32_be, 1, fc64, 1, PRIORITY_SIMD_AVX2)
+{
+    const item32_t* input = reinterpret_cast<const item32_t*>(inputs[0]);
+    fc64_t* output        = reinterpret_cast<fc64_t*>(outputs[0]);
+
+    convert_sc16_item32_1_to_fc64_1_avx2<uhd::ntohx>(
+        input, output, nsamps, scale_factor, SC16_BE_SHUFFLE);
+}
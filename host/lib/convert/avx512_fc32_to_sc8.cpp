@@ -0,0 +1,61 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_avx_common.hpp"
+#include "convert_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+#include <immintrin.h>
+
+using namespace uhd::convert;
+
+template <xtox_t to_wire>
+UHD_CONVERT_TARGET_AVX512 static void convert_fc32_1_to_sc8_item32_1_avx512(
+    const fc32_t* input,
+    item32_t* output,
+    const size_t nsamps,
+    const double scale_factor,
+    const uint8_t* shuffle_mask)
+{
+    const __m512 scalar   = _mm512_set1_ps(float(scale_factor));
+    const __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(shuffle_mask));
+
+    size_t i = 0, j = 0;
+    for (; i + 7 < nsamps; i += 8, j += 4) {
+        // load from input
+        const __m512 tmp = _mm512_loadu_ps(reinterpret_cast<const float*>(input + i));
+
+        // convert, scale and narrow with saturation, this keeps the order
+        const __m512i tmpi32 = _mm512_cvtps_epi32(_mm512_mul_ps(tmp, scalar));
+        __m128i tmpi         = _mm512_cvtsepi32_epi8(tmpi32);
+        tmpi                 = _mm_shuffle_epi8(tmpi, shuffle);
+
+        // store to output
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + j), tmpi);
+    }
+
+    // convert any remaining samples
+    xx_to_item32_sc8<to_wire>(input + i, output + j, nsamps - i, scale_factor);
+}
+
+DECLARE_CONVERTER_IF(
+    convert_cpu_has_avx512(), fc32, 1, sc8_item32_le, 1, PRIORITY_SIMD_AVX512)
+{
+    const fc32_t* input = reinterpret_cast<const fc32_t*>(inputs[0]);
+    item32_t* output    = reinterpret_cast<item32_t*>(outputs[0]);
+
+    convert_fc32_1_to_sc8_item32_1_avx512<uhd::htowx>(
+        input, output, nsamps, scale_factor, SC8_LE_SHUFFLE);
+}
+
+DECLARE_CONVERTER_IF(
+    convert_cpu_has_avx512(), fc32, 1, sc8_item32_be, 1, PRIORITY_SIMD_AVX512)
+{
+    const fc32_t* input = reinterpret_cast<const fc32_t*>(inputs[0]);
+    item32_t* output    = reinterpret_cast<item32_t*>(outputs[0]);
+
+    convert_fc32_1_to_sc8_item32_1_avx512<uhd::htonx>(
+        input, output, nsamps, scale_factor, SC8_BE_SHUFFLE);
+}
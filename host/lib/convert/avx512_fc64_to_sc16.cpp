@@ -0,0 +1,64 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_avx_common.hpp"
+#include "convert_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+#include <immintrin.h>
+
+using namespace uhd::convert;
+
+template <xtox_t to_wire>
+UHD_CONVERT_TARGET_AVX512 static void convert_fc64_1_to_sc16_item32_1_avx512(
+    const fc64_t* input,
+    item32_t* output,
+    const size_t nsamps,
+    const double scale_factor,
+    const uint8_t* shuffle_mask)
+{
+    const __m512d scalar  = _mm512_set1_pd(scale_factor);
+    const __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(shuffle_mask));
+
+    size_t i = 0;
+    for (; i + 3 < nsamps; i += 4) {
+        // load from input
+        const __m512d tmp = _mm512_loadu_pd(reinterpret_cast<const double*>(input + i));
+
+        // convert and scale
+        const __m256i tmpi32 = _mm512_cvtpd_epi32(_mm512_mul_pd(tmp, scalar));
+
+        // pack with saturation and swap
+        __m128i tmpi = _mm_packs_epi32(
+            _mm256_castsi256_si128(tmpi32), _mm256_extracti128_si256(tmpi32, 1));
+        tmpi = _mm_shuffle_epi8(tmpi, shuffle);
+
+        // store to output
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), tmpi);
+    }
+
+    // convert any remaining samples
+    xx_to_item32_sc16<to_wire>(input + i, output + i, nsamps - i, scale_factor);
+}
+
+DECLARE_CONVERTER_IF(
+    convert_cpu_has_avx512(), fc64, 1, sc16_item32_le, 1, PRIORITY_SIMD_AVX512)
+{
+    const fc64_t* input = reinterpret_cast<const fc64_t*>(inputs[0]);
+    item32_t* output    = reinterpret_cast<item32_t*>(outputs[0]);
+
+    convert_fc64_1_to_sc16_item32_1_avx512<uhd::htowx>(
+        input, output, nsamps, scale_factor, SC16_LE_SHUFFLE);
+}
+
+DECLARE_CONVERTER_IF(
+    convert_cpu_has_avx512(), fc64, 1, sc16_item32_be, 1, PRIORITY_SIMD_AVX512)
+{
+    const fc64_t* input = reinterpret_cast<const fc64_t*>(inputs[0]);
+    item32_t* output    = reinterpret_cast<item32_t*>(outputs[0]);
+
+    convert_fc64_1_to_sc16_item32_1_avx512<uhd::htonx>(
+        input, output, nsamps, scale_factor, SC16_BE_SHUFFLE);
+}
@@ -0,0 +1,67 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_avx_common.hpp"
+#include "convert_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+#include <immintrin.h>
+
+using namespace uhd::convert;
+
+template <xtox_t to_host>
+UHD_CONVERT_TARGET_AVX512 static void convert_sc8_item32_1_to_fc32_1_avx512(
+    const void* input_mem,
+    fc32_t* output,
+    const size_t nsamps,
+    const double scale_factor,
+    const uint8_t* shuffle_mask)
+{
+    const item32_t* input =
+        reinterpret_cast<const item32_t*>(size_t(input_mem) & ~0x3);
+    const __m512 scalar   = _mm512_set1_ps(float(scale_factor));
+    const __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(shuffle_mask));
+
+    size_t num_samps = nsamps;
+    if ((size_t(input_mem) & 0x3) != 0) {
+        item32_sc8_to_xx<to_host>(input++, output++, 1, scale_factor);
+        num_samps--;
+    }
+
+    size_t i = 0, j = 0;
+    for (; j + 7 < num_samps; j += 8, i += 4) {
+        // load 4 items and bring the bytes into I, Q order
+        __m128i tmpi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+        tmpi         = _mm_shuffle_epi8(tmpi, shuffle);
+
+        // sign-extend, convert and scale
+        const __m512 tmp =
+            _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_cvtepi8_epi32(tmpi)), scalar);
+
+        // store to output
+        _mm512_storeu_ps(reinterpret_cast<float*>(output + j), tmp);
+    }
+
+    // convert any remaining samples
+    item32_sc8_to_xx<to_host>(input + i, output + j, num_samps - j, scale_factor);
+}
+
+DECLARE_CONVERTER_IF(
+    convert_cpu_has_avx512(), sc8_item32_le, 1, fc32, 1, PRIORITY_SIMD_AVX512)
+{
+    fc32_t* output = reinterpret_cast<fc32_t*>(outputs[0]);
+
+    convert_sc8_item32_1_to_fc32_1_avx512<uhd::wtohx>(
+        inputs[0], output, nsamps, scale_factor, SC8_LE_SHUFFLE);
+}
+
+DECLARE_CONVERTER_IF(
+    convert_cpu_has_avx512(), sc8_item32_be, 1, fc32, 1, PRIORITY_SIMD_AVX512)
+{
+    fc32_t* output = reinterpret_cast<fc32_t*>(outputs[0]);
+
+    convert_sc8_item32_1_to_fc32_1_avx512<uhd::ntohx>(
+        inputs[0], output, nsamps, scale_factor, SC8_BE_SHUFFLE);
+}
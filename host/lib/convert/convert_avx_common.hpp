@@ -0,0 +1,102 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_LIBUHD_CONVERT_AVX_COMMON_HPP
+#define INCLUDED_LIBUHD_CONVERT_AVX_COMMON_HPP
+
+#include <uhd/config.hpp>
+#include <stdint.h>
+#ifdef _MSC_VER
+#    include <intrin.h>
+#endif
+
+/*
+ * Common definitions for the AVX2 and AVX-512 converters.
+ *
+ * The AVX2 and AVX-512 kernels are not compiled with -mavx2 etc. for the whole
+ * translation unit. Instead, only the kernel functions are tagged with a target
+ * attribute, so that no inline or template code that might get shared with
+ * other translation units is built for an instruction set the host might not
+ * have. The converters are then only registered if the CPU (and the OS, for
+ * saving the wider registers) supports them.
+ */
+#ifdef _MSC_VER
+#    define UHD_CONVERT_TARGET_AVX2
+#    define UHD_CONVERT_TARGET_AVX512
+#else
+#    define UHD_CONVERT_TARGET_AVX2 __attribute__((target("avx2")))
+#    define UHD_CONVERT_TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+
+#ifdef _MSC_VER
+namespace {
+
+UHD_INLINE bool convert_cpuid_check(
+    const int leaf, const int reg, const int bit, const unsigned long long xcr0_mask)
+{
+    int regs[4];
+    __cpuid(regs, 0);
+    if (regs[0] < leaf) {
+        return false;
+    }
+    // OSXSAVE: the OS saves the extended register state on context switches
+    __cpuid(regs, 1);
+    if ((regs[2] & (1 << 27)) == 0) {
+        return false;
+    }
+    if ((_xgetbv(0) & xcr0_mask) != xcr0_mask) {
+        return false;
+    }
+    __cpuidex(regs, leaf, 0);
+    return (regs[reg] & (1 << bit)) != 0;
+}
+
+} // namespace
+#endif
+
+//! Return true if the CPU can run UHD_CONVERT_TARGET_AVX2 code
+UHD_INLINE bool convert_cpu_has_avx2(void)
+{
+#ifdef _MSC_VER
+    // CPUID.7.EBX[5]; XMM and YMM state enabled
+    return convert_cpuid_check(7, 1, 5, 0x6);
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+//! Return true if the CPU can run UHD_CONVERT_TARGET_AVX512 code
+UHD_INLINE bool convert_cpu_has_avx512(void)
+{
+#ifdef _MSC_VER
+    // CPUID.7.EBX[16]; XMM, YMM, opmask and ZMM state enabled
+    return convert_cpuid_check(7, 1, 16, 0xe6);
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx512f");
+#endif
+}
+
+/*
+ * Byte shuffles (source index per output byte) between the wire order of
+ * item32 samples and I, Q order in host memory. Each of them is its own
+ * inverse, so they are used for either direction.
+ * - sc16_item32_le: the shorts of every item32 are swapped
+ * - sc16_item32_be: each short is byteswapped
+ * - sc8_item32_le: the bytes of every item32 are reversed
+ * - sc8_item32_be: already in I, Q order
+ */
+static const uint8_t SC16_LE_SHUFFLE[16] = {
+    2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13};
+static const uint8_t SC16_BE_SHUFFLE[16] = {
+    1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14};
+static const uint8_t SC8_LE_SHUFFLE[16] = {
+    3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12};
+static const uint8_t SC8_BE_SHUFFLE[16] = {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+
+#endif /* INCLUDED_LIBUHD_CONVERT_AVX_COMMON_HPP */
@@ -11,16 +11,49 @@
 #include <uhd/convert.hpp>
 #include <uhd/utils/static.hpp>
 #include <stdint.h>
+#include <algorithm>
+#include <cmath>
 #include <complex>
 
-#define _DECLARE_CONVERTER(name, in_form, num_in, out_form, num_out, prio) \
-    struct name : public uhd::convert::converter{ \
+namespace uhd { namespace convert {
+
+//! A block of converter registrations, see UHD_CONVERT_REGISTRATION
+struct registration_type
+{
+    void (*fcn)(void);
+    const char* name;
+    registration_type* next;
+};
+
+//! Queue a registration block, to be run when the converters are first looked up
+void add_registration(registration_type* registration);
+
+}} // namespace uhd::convert
+
+/*! Defines a block of code that registers converters
+ *
+ * Like UHD_STATIC_BLOCK, but loading the library only queues the block. It
+ * runs when the converters are first looked up, so processes that never
+ * convert samples don't pay for building the converter table.
+ */
+#define UHD_CONVERT_REGISTRATION(_x)                                                \
+    static void _x(void);                                                           \
+    static uhd::convert::registration_type _x##_registration = {&_x, #_x, nullptr}; \
+    UHD_STATIC_BLOCK(_x##_queue)                                                    \
+    {                                                                               \
+        uhd::convert::add_registration(&_x##_registration);                         \
+    }                                                                               \
+    static void _x(void)
+
+#define _DECLARE_CONVERTER_BASE_IF(base, cond, name, in_form, num_in, out_form, num_out, prio) \
+    struct name : public base{ \
         static sptr make(void){return sptr(new name());} \
         double scale_factor; \
         void set_scalar(const double s){scale_factor = s;} \
         void operator()(const input_type&, const output_type&, const size_t); \
     }; \
-    UHD_STATIC_BLOCK(__register_##name##_##prio){ \
+    UHD_CONVERT_REGISTRATION(__register_##name##_##prio){ \
+        if (not (cond)) return; \
         uhd::convert::id_type id; \
         id.input_format = #in_form; \
         id.num_inputs = num_in; \
@@ -32,6 +65,9 @@
         const input_type &inputs, const output_type &outputs, const size_t nsamps \
     )
 
+#define _DECLARE_CONVERTER_IF(cond, name, in_form, num_in, out_form, num_out, prio) \
+    _DECLARE_CONVERTER_BASE_IF(uhd::convert::converter, cond, name, in_form, num_in, out_form, num_out, prio)
+
 /*! Convenience macro to declare a single-function converter
  *
  * Most converters consist of a single for loop, and can make use of
@@ -46,7 +82,25 @@
  * - `scale_factor`: Scaling factor for float conversions
  */
 #define DECLARE_CONVERTER(in_form, num_in, out_form, num_out, prio) \
-    _DECLARE_CONVERTER(__convert_##in_form##_##num_in##_##out_form##_##num_out##_##prio, in_form, num_in, out_form, num_out, prio)
+    _DECLARE_CONVERTER_IF(true, __convert_##in_form##_##num_in##_##out_form##_##num_out##_##prio, in_form, num_in, out_form, num_out, prio)
+
+/*! Like DECLARE_CONVERTER, but only registers the converter if `cond` is true
+ *
+ * The condition is evaluated once when the converters are first looked up. This
+ * is used to
+ * register converters that require CPU features which are not part of the
+ * baseline instruction set the library was compiled for.
+ */
+#define DECLARE_CONVERTER_IF(cond, in_form, num_in, out_form, num_out, prio) \
+    _DECLARE_CONVERTER_IF(cond, __convert_##in_form##_##num_in##_##out_form##_##num_out##_##prio, in_form, num_in, out_form, num_out, prio)
+
+/*! Like DECLARE_CONVERTER, but declares a uhd::convert::stats_converter
+ *
+ * The function block also has `_accum`, the accumulator to add the samples
+ * to. It may be nullptr.
+ */
+#define DECLARE_STATS_CONVERTER(in_form, num_in, out_form, num_out, prio) \
+    _DECLARE_CONVERTER_BASE_IF(uhd::convert::stats_converter, true, __convert_##in_form##_##num_in##_##out_form##_##num_out##_##prio, in_form, num_in, out_form, num_out, prio)
 
 /***********************************************************************
  * Setup priorities
@@ -61,6 +115,9 @@ static const int PRIORITY_TABLE = 1; //tables require large cache, so they are s
 // We used to have ORC, too, so SIMD is 3
 static const int PRIORITY_SIMD = 3;
 static const int PRIORITY_TABLE = 1;
+// Only registered if the CPU supports them, see convert_avx_common.hpp
+static const int PRIORITY_SIMD_AVX2 = 4;
+static const int PRIORITY_SIMD_AVX512 = 5;
 #endif
 
 /***********************************************************************
@@ -147,6 +204,34 @@ UHD_INLINE void item32_sc16_to_xx(
     }
 }
 
+/***********************************************************************
+ * Convert items32 sc16 buffer to fc32, and add the samples to an accumulator
+ **********************************************************************/
+template <xtox_t to_host>
+UHD_INLINE void item32_sc16_to_fc32_accum(
+    const item32_t *input,
+    fc32_t *output,
+    const size_t nsamps,
+    const double scale_factor,
+    uhd::convert::signal_accum_t &accum
+){
+    double sum_i = 0.0, sum_q = 0.0, sum_sq = 0.0;
+    float peak = float(accum.peak);
+    for (size_t i = 0; i < nsamps; i++){
+        const fc32_t samp = item32_sc16_x1_to_xx<float>(to_host(input[i]), scale_factor);
+        output[i] = samp;
+        sum_i += samp.real();
+        sum_q += samp.imag();
+        sum_sq += samp.real()*samp.real() + samp.imag()*samp.imag();
+        peak = std::max(peak, std::max(std::abs(samp.real()), std::abs(samp.imag())));
+    }
+    accum.num_samps += nsamps;
+    accum.sum_i += sum_i;
+    accum.sum_q += sum_q;
+    accum.sum_sq += sum_sq;
+    accum.peak = peak;
+}
+
 /***********************************************************************
  * Convert xx to items32 sc8 buffer
  **********************************************************************/
@@ -5,14 +5,28 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 //
 
+#include "convert_common.hpp"
 #include <uhd/convert.hpp>
 #include <uhd/utils/log.hpp>
 #include <uhd/utils/static.hpp>
 #include <uhd/types/dict.hpp>
 #include <uhd/exception.hpp>
+#include <uhd/utils/paths.hpp>
+#include <uhdlib/utils/hashed_dict.hpp>
 #include <stdint.h>
+#include <boost/asio/ip/host_name.hpp>
+#include <boost/filesystem.hpp>
 #include <boost/format.hpp>
+#include <boost/functional/hash.hpp>
+#include <atomic>
+#include <chrono>
 #include <complex>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <vector>
 
 using namespace uhd;
 
@@ -56,9 +70,67 @@ std::string convert::id_type::to_string(void) const{
 /***********************************************************************
  * Setup the table registry
  **********************************************************************/
-typedef uhd::dict<convert::id_type, uhd::dict<convert::priority_type, convert::function_type> > fcn_table_type;
+struct id_hash
+{
+    size_t operator()(const convert::id_type& id) const
+    {
+        size_t hash = 0;
+        boost::hash_combine(hash, id.input_format);
+        boost::hash_combine(hash, id.num_inputs);
+        boost::hash_combine(hash, id.output_format);
+        boost::hash_combine(hash, id.num_outputs);
+        return hash;
+    }
+};
+
+typedef uhd::hashed_dict<convert::id_type,
+    uhd::dict<convert::priority_type, convert::function_type>,
+    id_hash>
+    fcn_table_type;
 UHD_SINGLETON_FCN(fcn_table_type, get_table);
 
+/***********************************************************************
+ * Queued registrations
+ *  - Loading the library only queues the registration blocks, they run
+ *    on the first access to the table
+ *  - The queue pointers are constant-initialized, so static blocks of any
+ *    translation unit can add to them
+ **********************************************************************/
+static convert::registration_type* registration_queue       = nullptr;
+static convert::registration_type** registration_queue_tail = &registration_queue;
+UHD_SINGLETON_FCN(std::recursive_mutex, get_registration_mutex);
+
+void convert::add_registration(registration_type* registration)
+{
+    std::lock_guard<std::recursive_mutex> lock(get_registration_mutex());
+    registration->next      = nullptr;
+    *registration_queue_tail = registration;
+    registration_queue_tail  = &registration->next;
+}
+
+//! Run the queued registrations, then return the table
+static fcn_table_type& get_registered_table(void)
+{
+    std::lock_guard<std::recursive_mutex> lock(get_registration_mutex());
+    // Registration blocks come back in here through register_converter(), so
+    // each one is dequeued before it runs
+    while (registration_queue != nullptr) {
+        convert::registration_type* registration = registration_queue;
+        registration_queue                        = registration->next;
+        if (registration_queue == nullptr) {
+            registration_queue_tail = &registration_queue;
+        }
+        try {
+            registration->fcn();
+        } catch (const std::exception& ex) {
+            UHD_LOGGER_ERROR("CONVERT")
+                << "Exception in registration " << registration->name << ": "
+                << ex.what();
+        }
+    }
+    return get_table();
+}
+
 /***********************************************************************
  * The registry functions
  **********************************************************************/
@@ -67,13 +139,196 @@ void uhd::convert::register_converter(
     const function_type &fcn,
     const priority_type prio
 ){
-    get_table()[id][prio] = fcn;
+    // Run the queued registrations first, so this one takes precedence
+    get_registered_table()[id][prio] = fcn;
 
     //----------------------------------------------------------------//
     //UHD_LOG_TRACE("CONVERT", boost::format("register_converter: %s prio: %s") % id.to_string() % prio)
     //----------------------------------------------------------------//
 }
 
+/***********************************************************************
+ * Benchmark mode: time all candidates and pick the fastest one
+ **********************************************************************/
+namespace {
+
+//! Number of samples per conversion in the benchmark
+const size_t BENCHMARK_NSAMPS = 4096;
+//! Number of timed runs, the fastest one counts
+const size_t BENCHMARK_RUNS = 5;
+//! Number of conversions per timed run
+const size_t BENCHMARK_ITERATIONS = 20;
+//! Enough bytes per sample for the largest item type (sc64/fc64)
+const size_t BENCHMARK_MAX_ITEM_SIZE = 16;
+
+struct benchmark_state_type
+{
+    benchmark_state_type(void) : enabled(false), loaded(false)
+    {
+        const char* env = std::getenv("UHD_CONVERT_BENCHMARK");
+        if (env == NULL or std::string(env).empty() or std::string(env) == "0") {
+            return;
+        }
+        enabled    = true;
+        cache_file = (std::string(env) == "1") ? get_default_cache_file() : env;
+    }
+
+    static std::string get_default_cache_file(void)
+    {
+        // The winners depend on the CPU, so keep them apart if the home
+        // directory is shared between hosts
+        const boost::filesystem::path path =
+            boost::filesystem::path(uhd::get_app_path()) / ".uhd"
+            / ("convert_benchmark_" + boost::asio::ip::host_name() + ".txt");
+        return path.string();
+    }
+
+    std::atomic<bool> enabled;
+    bool loaded;
+    std::string cache_file;
+    std::map<std::string, convert::priority_type> winners;
+    std::mutex mutex;
+};
+
+UHD_SINGLETON_FCN(benchmark_state_type, get_benchmark_state);
+
+//! Cache file lines are "<input format> <num inputs> <output format> <num outputs> <prio>"
+std::string get_cache_key(const convert::id_type& id)
+{
+    return str(boost::format("%s %d %s %d") % id.input_format % id.num_inputs
+               % id.output_format % id.num_outputs);
+}
+
+void load_cache_file(benchmark_state_type& state)
+{
+    state.loaded = true;
+    if (state.cache_file.empty()) {
+        return;
+    }
+    std::ifstream file(state.cache_file.c_str());
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream line_ss(line);
+        std::string in_fmt, out_fmt;
+        size_t num_in, num_out;
+        convert::priority_type prio;
+        if (line_ss >> in_fmt >> num_in >> out_fmt >> num_out >> prio) {
+            state.winners[str(boost::format("%s %d %s %d") % in_fmt % num_in % out_fmt
+                              % num_out)] = prio;
+        }
+    }
+}
+
+void store_cache_file(const benchmark_state_type& state)
+{
+    if (state.cache_file.empty()) {
+        return;
+    }
+    try {
+        const boost::filesystem::path parent =
+            boost::filesystem::path(state.cache_file).parent_path();
+        if (not parent.empty()) {
+            boost::filesystem::create_directories(parent);
+        }
+    } catch (const boost::filesystem::filesystem_error&) {
+        // Fall through, opening the file will fail below
+    }
+    std::ofstream file(state.cache_file.c_str());
+    if (not file) {
+        UHD_LOGGER_WARNING("CONVERT")
+            << "Cannot write converter benchmark results to " << state.cache_file;
+        return;
+    }
+    for (const auto& winner : state.winners) {
+        file << winner.first << " " << winner.second << std::endl;
+    }
+}
+
+//! Return the duration of the fastest run of converter fcn on zeroed buffers
+double benchmark_converter(const convert::id_type& id, const convert::function_type& fcn)
+{
+    const size_t buff_size = BENCHMARK_NSAMPS * BENCHMARK_MAX_ITEM_SIZE;
+    std::vector<std::vector<uint8_t>> in_buffs(id.num_inputs, std::vector<uint8_t>(buff_size));
+    std::vector<std::vector<uint8_t>> out_buffs(id.num_outputs, std::vector<uint8_t>(buff_size));
+    std::vector<const void*> in_refs;
+    std::vector<void*> out_refs;
+    for (const auto& buff : in_buffs) in_refs.push_back(buff.data());
+    for (auto& buff : out_buffs) out_refs.push_back(buff.data());
+
+    convert::converter::sptr conv = fcn();
+    conv->set_scalar(1.0);
+    // warm up caches and branch predictors
+    conv->conv(in_refs, out_refs, BENCHMARK_NSAMPS);
+
+    double best = 0.0;
+    for (size_t run = 0; run < BENCHMARK_RUNS; run++) {
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < BENCHMARK_ITERATIONS; i++) {
+            conv->conv(in_refs, out_refs, BENCHMARK_NSAMPS);
+        }
+        const double elapsed = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+        if (run == 0 or elapsed < best) best = elapsed;
+    }
+    return best;
+}
+
+//! Return the fastest priority for id, cached or benchmarked
+convert::priority_type get_fastest_prio(
+    const convert::id_type& id,
+    const uhd::dict<convert::priority_type, convert::function_type>& candidates
+){
+    benchmark_state_type& state = get_benchmark_state();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (not state.loaded) load_cache_file(state);
+
+    const std::string key = get_cache_key(id);
+    if (state.winners.count(key) and candidates.has_key(state.winners[key])) {
+        return state.winners[key];
+    }
+
+    convert::priority_type best_prio = -1;
+    double best_time = 0.0;
+    for (const convert::priority_type prio : candidates.keys()) {
+        double elapsed;
+        try {
+            elapsed = benchmark_converter(id, candidates[prio]);
+        } catch (const std::exception& ex) {
+            UHD_LOGGER_DEBUG("CONVERT") << "Benchmark for " << id.to_string() << " prio "
+                                        << prio << " failed: " << ex.what();
+            continue;
+        }
+        UHD_LOGGER_DEBUG("CONVERT") << "Benchmark for " << id.to_string() << " prio "
+                                    << prio << ": " << (elapsed * 1e6) << " us";
+        if (best_prio == -1 or elapsed < best_time) {
+            best_prio = prio;
+            best_time = elapsed;
+        }
+    }
+    if (best_prio == -1) {
+        // Nothing could be benchmarked, fall back to the highest priority
+        for (const convert::priority_type prio : candidates.keys()) {
+            best_prio = std::max(best_prio, prio);
+        }
+        return best_prio;
+    }
+    state.winners[key] = best_prio;
+    store_cache_file(state);
+    return best_prio;
+}
+
+} // namespace
+
+void uhd::convert::set_benchmark_mode(const bool enable, const std::string& cache_file)
+{
+    benchmark_state_type& state = get_benchmark_state();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.enabled    = enable;
+    state.cache_file = cache_file;
+    state.loaded     = false;
+    state.winners.clear();
+}
+
 /***********************************************************************
  * The converter functions
  **********************************************************************/
@@ -81,19 +336,21 @@ convert::function_type convert::get_converter(
     const id_type &id,
     const priority_type prio
 ){
-    if (not get_table().has_key(id)) throw uhd::key_error(
+    fcn_table_type& table = get_registered_table();
+    if (not table.has_key(id)) throw uhd::key_error(
         "Cannot find a conversion routine for " + id.to_pp_string());
+    const uhd::dict<priority_type, function_type>& candidates = table[id];
 
     //find a matching priority
     priority_type best_prio = -1;
-    for(priority_type prio_i:  get_table()[id].keys()){
+    for(priority_type prio_i:  candidates.keys()){
         if (prio_i == prio) {
             //----------------------------------------------------------------//
             UHD_LOGGER_DEBUG("CONVERT") << "get_converter: For converter ID: " << id.to_pp_string()
                                         << " Using prio: " << prio;
             ;
             //----------------------------------------------------------------//
-            return get_table()[id][prio];
+            return candidates[prio];
         }
         best_prio = std::max(best_prio, prio_i);
     }
@@ -102,19 +359,28 @@ convert::function_type convert::get_converter(
     if (prio != -1) throw uhd::key_error(
         "Cannot find a conversion routine [with prio] for " + id.to_pp_string());
 
+    //in benchmark mode, let the fastest one win instead of the highest prio
+    if (get_benchmark_state().enabled and candidates.size() > 1) {
+        best_prio = get_fastest_prio(id, candidates);
+    }
+
     //----------------------------------------------------------------//
     UHD_LOGGER_DEBUG("CONVERT") << "get_converter: For converter ID: " << id.to_pp_string()
                                 << " Using prio: " << best_prio;
     //----------------------------------------------------------------//
 
     //otherwise, return best prio
-    return get_table()[id][best_prio];
+    return candidates[best_prio];
+}
+
+std::vector<convert::id_type> convert::get_converter_ids(void){
+    return get_registered_table().keys();
 }
 
 /***********************************************************************
  * Mappings for item format to byte size for all items we can
  **********************************************************************/
-typedef uhd::dict<std::string, size_t> item_size_type;
+typedef uhd::hashed_dict<std::string, size_t> item_size_type;
 UHD_SINGLETON_FCN(item_size_type, get_item_size_table);
 
 void convert::register_bytes_per_item(
@@ -146,6 +412,9 @@ UHD_STATIC_BLOCK(convert_register_item_sizes){
     convert::register_bytes_per_item("sc32", sizeof(std::complex<int32_t>));
     convert::register_bytes_per_item("sc16", sizeof(std::complex<int16_t>));
     convert::register_bytes_per_item("sc8", sizeof(std::complex<int8_t>));
+    // Not with the sc12 converters, packet sizes are computed before those
+    // are registered
+    convert::register_bytes_per_item("sc12", 3 /*bytes*/);
 
     //register standard real types
     convert::register_bytes_per_item("f64", sizeof(double));
@@ -0,0 +1,132 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_common.hpp"
+#include <uhd/utils/static.hpp>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+using namespace uhd::convert;
+
+/***********************************************************************
+ * Channel-interleaving converters
+ *
+ * These take one item32 wire buffer per channel (num_inputs == number of
+ * channels) and write a single host buffer in which the samples of all
+ * channels are interleaved: ch0[0], ch1[0], ..., chN[0], ch0[1], ...
+ *
+ * Every channel is converted in small blocks with the best single-channel
+ * converter for the same formats, so the SIMD kernels do the arithmetic.
+ * The block stays in L1 cache until it is scattered into the output,
+ * which means every sample is only read once from the packet buffers and
+ * written once to the user's buffer.
+ **********************************************************************/
+static const size_t MAX_INTERLEAVE_CHANS = 32;
+
+//! Number of samples per channel converted into the scratch buffer at once
+static const size_t BLOCK_NSAMPS = 256;
+
+template <size_t item_size>
+static void scatter_items(const uint8_t* block,
+    uint8_t* output,
+    const size_t nsamps,
+    const size_t stride)
+{
+    for (size_t i = 0; i < nsamps; i++) {
+        std::memcpy(output + i * stride, block + i * item_size, item_size);
+    }
+}
+
+class convert_item32_to_interleaved : public converter
+{
+public:
+    convert_item32_to_interleaved(const id_type& id)
+        : _num_chans(id.num_inputs)
+        , _otw_item_size(get_bytes_per_item(id.input_format))
+        , _cpu_item_size(get_bytes_per_item(id.output_format))
+        , _block(BLOCK_NSAMPS * _cpu_item_size)
+    {
+        id_type single_id    = id;
+        single_id.num_inputs = 1;
+        _converter           = get_converter(single_id)();
+    }
+
+    void set_scalar(const double scalar)
+    {
+        _converter->set_scalar(scalar);
+    }
+
+    void operator()(const input_type& inputs, const output_type& outputs, const size_t nsamps)
+    {
+        uint8_t* output     = reinterpret_cast<uint8_t*>(outputs[0]);
+        const size_t stride = _num_chans * _cpu_item_size;
+        void* block_ptr     = _block.data();
+        const output_type block_buffs(&block_ptr, 1);
+
+        for (size_t offset = 0; offset < nsamps; offset += BLOCK_NSAMPS) {
+            const size_t n = std::min(BLOCK_NSAMPS, nsamps - offset);
+            for (size_t ch = 0; ch < _num_chans; ch++) {
+                const void* in_ptr =
+                    reinterpret_cast<const uint8_t*>(inputs[ch]) + offset * _otw_item_size;
+                _converter->conv(input_type(&in_ptr, 1), block_buffs, n);
+
+                uint8_t* out = output + offset * stride + ch * _cpu_item_size;
+                switch (_cpu_item_size) {
+                    case 4:
+                        scatter_items<4>(_block.data(), out, n, stride);
+                        break;
+                    case 8:
+                        scatter_items<8>(_block.data(), out, n, stride);
+                        break;
+                    case 16:
+                        scatter_items<16>(_block.data(), out, n, stride);
+                        break;
+                    default:
+                        for (size_t i = 0; i < n; i++) {
+                            std::memcpy(out + i * stride,
+                                _block.data() + i * _cpu_item_size,
+                                _cpu_item_size);
+                        }
+                }
+            }
+        }
+    }
+
+private:
+    const size_t _num_chans;
+    const size_t _otw_item_size;
+    const size_t _cpu_item_size;
+    std::vector<uint8_t> _block;
+    converter::sptr _converter;
+};
+
+static void register_interleave_converters(
+    const std::string& wire_format, const std::string& cpu_format)
+{
+    id_type id;
+    id.input_format  = wire_format;
+    id.output_format = cpu_format;
+    id.num_outputs   = 1;
+    for (size_t num_chans = 2; num_chans <= MAX_INTERLEAVE_CHANS; num_chans++) {
+        id.num_inputs = num_chans;
+        // The single-channel converters may not be registered yet, so only
+        // look them up when the converter gets made
+        register_converter(id,
+            [id]() { return converter::sptr(new convert_item32_to_interleaved(id)); },
+            PRIORITY_GENERAL);
+    }
+}
+
+UHD_CONVERT_REGISTRATION(register_convert_interleave_channels)
+{
+    for (const char* wire_format :
+        {"sc16_item32_le", "sc16_item32_be", "sc8_item32_le", "sc8_item32_be"}) {
+        for (const char* cpu_format : {"fc64", "fc32", "sc16"}) {
+            register_interleave_converters(wire_format, cpu_format);
+        }
+    }
+}
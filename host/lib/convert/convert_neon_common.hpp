@@ -0,0 +1,122 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_LIBUHD_CONVERT_NEON_COMMON_HPP
+#define INCLUDED_LIBUHD_CONVERT_NEON_COMMON_HPP
+
+#include "convert_common.hpp"
+#include <uhd/config.hpp>
+#include <uhd/utils/byteswap.hpp>
+#include <arm_neon.h>
+
+/*
+ * Common definitions for the NEON converters.
+ *
+ * NEON is only enabled on the 32-bit ARM cores of the embedded devices, which
+ * run little endian. Their NEON unit has no double precision lanes, so the
+ * fc64 converters convert the doubles one value at a time and do everything
+ * else (saturation, packing and byte order) with NEON.
+ */
+
+/*
+ * Byte order of the item32 wire formats:
+ * - swap_sc16() reorders 8 shorts between wire order and I, Q order in host
+ *   memory; the shorts of every little endian item32 are swapped, and each
+ *   short of a big endian item32 is byteswapped.
+ * - swap_sc8() does the same for 16 bytes; the bytes of every little endian
+ *   item32 are reversed, big endian items are already in I, Q order.
+ * - swap_item32() converts 4 item32s between wire and host order.
+ * Each of them is its own inverse, so they are used for either direction.
+ */
+struct neon_item32_le
+{
+    static item32_t to_host(const item32_t item)
+    {
+        return uhd::wtohx(item);
+    }
+    static item32_t to_wire(const item32_t item)
+    {
+        return uhd::htowx(item);
+    }
+    static int16x8_t swap_sc16(const int16x8_t in)
+    {
+        return vrev32q_s16(in);
+    }
+    static int8x16_t swap_sc8(const int8x16_t in)
+    {
+        return vrev32q_s8(in);
+    }
+    static uint32x4_t swap_item32(const uint32x4_t in)
+    {
+        return in;
+    }
+};
+
+struct neon_item32_be
+{
+    static item32_t to_host(const item32_t item)
+    {
+        return uhd::ntohx(item);
+    }
+    static item32_t to_wire(const item32_t item)
+    {
+        return uhd::htonx(item);
+    }
+    static int16x8_t swap_sc16(const int16x8_t in)
+    {
+        return vreinterpretq_s16_s8(vrev16q_s8(vreinterpretq_s8_s16(in)));
+    }
+    static int8x16_t swap_sc8(const int8x16_t in)
+    {
+        return in;
+    }
+    static uint32x4_t swap_item32(const uint32x4_t in)
+    {
+        return vreinterpretq_u32_u8(vrev32q_u8(vreinterpretq_u8_u32(in)));
+    }
+};
+
+//! Scale 8 floats, convert them to int (truncating) and saturate to shorts
+UHD_INLINE int16x8_t neon_scale_f32_to_s16(
+    const float32x4_t in0, const float32x4_t in1, const float32x4_t scalar)
+{
+    return vcombine_s16(vqmovn_s32(vcvtq_s32_f32(vmulq_f32(in0, scalar))),
+        vqmovn_s32(vcvtq_s32_f32(vmulq_f32(in1, scalar))));
+}
+
+//! Convert 4 shorts to float and scale them
+UHD_INLINE float32x4_t neon_scale_s16_to_f32(const int16x4_t in, const float32x4_t scalar)
+{
+    return vmulq_f32(vcvtq_f32_s32(vmovl_s16(in)), scalar);
+}
+
+/*! Load 4 doubles, scale them and convert them to int (truncating)
+ *
+ * This is done in double precision, so the results are the same as the ones
+ * of the generic converters.
+ */
+UHD_INLINE int32x4_t neon_scale_f64_to_s32(const double* in, const double scale_factor)
+{
+    const float scalar   = float(scale_factor);
+    const int32_t tmp[4] = {int32_t(in[0] * scalar),
+        int32_t(in[1] * scalar),
+        int32_t(in[2] * scalar),
+        int32_t(in[3] * scalar)};
+    return vld1q_s32(tmp);
+}
+
+//! Store 4 floats as doubles
+UHD_INLINE void neon_store_f64(double* out, const float32x4_t in)
+{
+    float tmp[4];
+    vst1q_f32(tmp, in);
+    out[0] = tmp[0];
+    out[1] = tmp[1];
+    out[2] = tmp[2];
+    out[3] = tmp[3];
+}
+
+#endif /* INCLUDED_LIBUHD_CONVERT_NEON_COMMON_HPP */
@@ -116,10 +116,8 @@ static converter::sptr make_convert_sc16_1_to_sc12_item32_be_1(void)
     return converter::sptr(new convert_star_1_to_sc12_item32_1<short, uhd::ntohx>());
 }
 
-UHD_STATIC_BLOCK(register_convert_pack_sc12)
+UHD_CONVERT_REGISTRATION(register_convert_pack_sc12)
 {
-    //uhd::convert::register_bytes_per_item("sc12", 3/*bytes*/); //registered in unpack
-
     uhd::convert::id_type id;
     id.num_inputs = 1;
     id.num_outputs = 1;
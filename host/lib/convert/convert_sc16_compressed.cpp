@@ -0,0 +1,245 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_common.hpp"
+#include <uhd/exception.hpp>
+#include <uhd/utils/static.hpp>
+#include <boost/format.hpp>
+#include <algorithm>
+
+using namespace uhd::convert;
+
+/***********************************************************************
+ * Compressed sc16 blocks
+ *
+ * A block is a header of two little endian 32-bit words (the size of the
+ * block in bytes, and the number of samples in it), followed by groups of up
+ * to 16 samples. Within a block, every I and Q value is predicted from the
+ * previous values of the same component, either by the last value (order 1)
+ * or by extrapolating the last two (order 2), whichever needs fewer bits for
+ * the group. Each group stores the residuals with the number of bits that the
+ * largest of them needs, after removing the trailing zero bits that all of
+ * them have in common (so sc12 or sc8 samples in sc16 words don't pay for
+ * their zero bits):
+ *
+ *   byte 0: bits per residual (0 to 16), or GROUP_RAW
+ *   byte 1: common trailing zero bits of the residuals, plus GROUP_ORDER2
+ *   then:   the zig-zag encoded residuals, packed LSB first and padded to a
+ *           whole byte; or with GROUP_RAW, the samples as little endian sc16
+ **********************************************************************/
+namespace {
+
+constexpr size_t HEADER_SIZE       = 8;
+constexpr size_t GROUP_SAMPS       = 16;
+constexpr size_t GROUP_HEADER_SIZE = 2;
+constexpr uint8_t GROUP_RAW        = 0xFF;
+constexpr uint8_t GROUP_ORDER2     = 0x80;
+
+UHD_INLINE void write_u32(uint8_t* p, const uint32_t x)
+{
+    p[0] = uint8_t(x);
+    p[1] = uint8_t(x >> 8);
+    p[2] = uint8_t(x >> 16);
+    p[3] = uint8_t(x >> 24);
+}
+
+UHD_INLINE uint32_t read_u32(const uint8_t* p)
+{
+    return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16)
+           | (uint32_t(p[3]) << 24);
+}
+
+UHD_INLINE uint32_t zigzag(const int32_t x)
+{
+    return (uint32_t(x) << 1) ^ uint32_t(x >> 31);
+}
+
+UHD_INLINE int32_t unzigzag(const uint32_t x)
+{
+    return int32_t(x >> 1) ^ -int32_t(x & 1);
+}
+
+//! Remove the common trailing zeros of residuals and zig-zag encode them
+UHD_INLINE void pack_residuals(
+    int32_t* residuals, const size_t num_vals, uint8_t& width, uint8_t& shift)
+{
+    uint32_t all_bits = 0;
+    for (size_t j = 0; j < num_vals; j++) {
+        all_bits |= uint32_t(residuals[j]);
+    }
+    shift = 0;
+    while (all_bits and not(all_bits & 1)) {
+        all_bits >>= 1;
+        shift++;
+    }
+    uint32_t max_zz = 0;
+    for (size_t j = 0; j < num_vals; j++) {
+        residuals[j] = int32_t(zigzag(residuals[j] >> shift));
+        max_zz |= uint32_t(residuals[j]);
+    }
+    width = 0;
+    while (max_zz >> width) {
+        width++;
+    }
+}
+
+struct convert_sc16_1_to_sc16_compressed_1 : public converter
+{
+    void set_scalar(const double) {}
+
+    void operator()(
+        const input_type& inputs, const output_type& outputs, const size_t nsamps)
+    {
+        const int16_t* in        = reinterpret_cast<const int16_t*>(inputs[0]);
+        uint8_t* const out_start = reinterpret_cast<uint8_t*>(outputs[0]);
+        uint8_t* out             = out_start + HEADER_SIZE;
+
+        // The last two values of I and Q
+        int32_t prev1[2] = {0, 0}, prev2[2] = {0, 0};
+        for (size_t i = 0; i < nsamps; i += GROUP_SAMPS) {
+            const size_t num_vals = 2 * std::min(GROUP_SAMPS, nsamps - i);
+            const int16_t* vals   = in + 2 * i;
+
+            int32_t order1[2 * GROUP_SAMPS], order2[2 * GROUP_SAMPS];
+            for (size_t j = 0; j < num_vals; j++) {
+                const size_t k = j & 1;
+                order1[j]      = vals[j] - prev1[k];
+                order2[j]      = vals[j] - 2 * prev1[k] + prev2[k];
+                prev2[k]       = prev1[k];
+                prev1[k]       = vals[j];
+            }
+            uint8_t width1, shift1, width2, shift2;
+            pack_residuals(order1, num_vals, width1, shift1);
+            pack_residuals(order2, num_vals, width2, shift2);
+            const bool use_order2    = width2 < width1;
+            const int32_t* residuals = use_order2 ? order2 : order1;
+            const uint8_t width      = use_order2 ? width2 : width1;
+            const uint8_t shift      = use_order2 ? shift2 : shift1;
+
+            // Residuals of more than 16 bits are larger than the samples
+            if (width > 16) {
+                *out++ = GROUP_RAW;
+                *out++ = 0;
+                for (size_t j = 0; j < num_vals; j++) {
+                    *out++ = uint8_t(vals[j]);
+                    *out++ = uint8_t(uint16_t(vals[j]) >> 8);
+                }
+                continue;
+            }
+            *out++ = width;
+            *out++ = shift | (use_order2 ? GROUP_ORDER2 : 0);
+            uint64_t acc = 0;
+            size_t nbits = 0;
+            for (size_t j = 0; j < num_vals; j++) {
+                acc |= uint64_t(uint32_t(residuals[j])) << nbits;
+                nbits += width;
+                if (nbits >= 32) {
+                    write_u32(out, uint32_t(acc));
+                    out += 4;
+                    acc >>= 32;
+                    nbits -= 32;
+                }
+            }
+            for (; nbits > 0; nbits -= std::min<size_t>(nbits, 8)) {
+                *out++ = uint8_t(acc);
+                acc >>= 8;
+            }
+        }
+
+        write_u32(out_start, uint32_t(out - out_start));
+        write_u32(out_start + 4, uint32_t(nsamps));
+    }
+};
+
+struct convert_sc16_compressed_1_to_sc16_1 : public converter
+{
+    void set_scalar(const double) {}
+
+    void operator()(
+        const input_type& inputs, const output_type& outputs, const size_t nsamps)
+    {
+        const uint8_t* in = reinterpret_cast<const uint8_t*>(inputs[0]);
+        int16_t* out      = reinterpret_cast<int16_t*>(outputs[0]);
+        if (read_u32(in + 4) != nsamps) {
+            throw uhd::value_error(
+                str(boost::format("Compressed sc16 block holds %u samples, not %u")
+                    % read_u32(in + 4) % nsamps));
+        }
+        in += HEADER_SIZE;
+
+        int32_t prev1[2] = {0, 0}, prev2[2] = {0, 0};
+        for (size_t i = 0; i < nsamps; i += GROUP_SAMPS) {
+            const size_t num_vals = 2 * std::min(GROUP_SAMPS, nsamps - i);
+            int16_t* vals         = out + 2 * i;
+            const uint8_t width   = *in++;
+            const bool use_order2 = (*in & GROUP_ORDER2) != 0;
+            const uint8_t shift   = *in++ & ~GROUP_ORDER2;
+
+            if (width == GROUP_RAW) {
+                for (size_t j = 0; j < num_vals; j++, in += 2) {
+                    vals[j]      = int16_t(uint16_t(in[0]) | (uint16_t(in[1]) << 8));
+                    prev2[j & 1] = prev1[j & 1];
+                    prev1[j & 1] = vals[j];
+                }
+                continue;
+            }
+            const uint32_t mask = (uint32_t(1) << width) - 1;
+            uint64_t acc        = 0;
+            size_t nbits        = 0;
+            for (size_t j = 0; j < num_vals; j++) {
+                while (nbits < width) {
+                    acc |= uint64_t(*in++) << nbits;
+                    nbits += 8;
+                }
+                const int32_t residual = unzigzag(uint32_t(acc) & mask) * (1 << shift);
+                acc >>= width;
+                nbits -= width;
+                const size_t k = j & 1;
+                const int32_t prediction =
+                    use_order2 ? 2 * prev1[k] - prev2[k] : prev1[k];
+                prev2[k] = prev1[k];
+                prev1[k] = prediction + residual;
+                vals[j]  = int16_t(prev1[k]);
+            }
+        }
+    }
+};
+
+} // namespace
+
+size_t uhd::convert::get_max_compressed_size(const size_t num_samps)
+{
+    const size_t num_groups = (num_samps + GROUP_SAMPS - 1) / GROUP_SAMPS;
+    return HEADER_SIZE + num_groups * GROUP_HEADER_SIZE + num_samps * 4;
+}
+
+size_t uhd::convert::get_compressed_size(const void* block)
+{
+    return read_u32(reinterpret_cast<const uint8_t*>(block));
+}
+
+size_t uhd::convert::get_compressed_num_samps(const void* block)
+{
+    return read_u32(reinterpret_cast<const uint8_t*>(block) + 4);
+}
+
+UHD_CONVERT_REGISTRATION(register_convert_sc16_compressed)
+{
+    id_type id;
+    id.num_inputs    = 1;
+    id.num_outputs   = 1;
+    id.input_format  = "sc16";
+    id.output_format = "sc16_compressed";
+    register_converter(id,
+        []() { return converter::sptr(new convert_sc16_1_to_sc16_compressed_1()); },
+        PRIORITY_GENERAL);
+
+    id.input_format  = "sc16_compressed";
+    id.output_format = "sc16";
+    register_converter(id,
+        []() { return converter::sptr(new convert_sc16_compressed_1_to_sc16_1()); },
+        PRIORITY_GENERAL);
+}
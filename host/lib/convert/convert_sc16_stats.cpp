@@ -0,0 +1,26 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+
+using namespace uhd::convert;
+
+#define DECLARE_SC16_STATS_CONVERTER(xe, xxtoh)                                  \
+    DECLARE_STATS_CONVERTER(sc16_item32_##xe, 1, fc32_stats, 1, PRIORITY_GENERAL) \
+    {                                                                             \
+        const item32_t* input = reinterpret_cast<const item32_t*>(inputs[0]);    \
+        fc32_t* output        = reinterpret_cast<fc32_t*>(outputs[0]);           \
+        if (_accum) {                                                             \
+            item32_sc16_to_fc32_accum<xxtoh>(                                     \
+                input, output, nsamps, scale_factor, *_accum);                    \
+        } else {                                                                  \
+            item32_sc16_to_xx<xxtoh>(input, output, nsamps, scale_factor);        \
+        }                                                                         \
+    }
+
+DECLARE_SC16_STATS_CONVERTER(be, uhd::ntohx)
+DECLARE_SC16_STATS_CONVERTER(le, uhd::wtohx)
@@ -126,9 +126,8 @@ static converter::sptr make_convert_sc12_item32_be_1_to_sc16_1(void)
     return converter::sptr(new convert_sc12_item32_1_to_star_1<short, uhd::ntohx>());
 }
 
-UHD_STATIC_BLOCK(register_convert_unpack_sc12)
+UHD_CONVERT_REGISTRATION(register_convert_unpack_sc12)
 {
-    uhd::convert::register_bytes_per_item("sc12", 3/*bytes*/);
     uhd::convert::id_type id;
     id.num_inputs = 1;
     id.num_outputs = 1;
@@ -8,6 +8,9 @@
 #include "convert_common.hpp"
 #include <uhd/utils/byteswap.hpp>
 #include <boost/math/special_functions/round.hpp>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 using namespace uhd::convert;
@@ -16,6 +19,35 @@ static const size_t sc16_table_len = size_t(1 << 16);
 
 typedef uint16_t (*tohost16_type)(uint16_t);
 
+/***********************************************************************
+ * Shared lookup tables
+ *  - All converters of the same type and scalar share one immutable
+ *    table, instead of every channel of every streamer filling its own
+ *  - The cache only holds weak references, so a table is freed with the
+ *    last converter that uses it
+ **********************************************************************/
+template <typename converter_type>
+static std::shared_ptr<const typename converter_type::table_type> get_shared_table(
+    const double scalar)
+{
+    typedef typename converter_type::table_type table_type;
+    static std::mutex cache_mutex;
+    static std::map<double, std::weak_ptr<const table_type>> cache;
+
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    std::shared_ptr<const table_type> table = cache[scalar].lock();
+    if (not table) {
+        auto new_table = std::make_shared<table_type>(sc16_table_len);
+        converter_type::fill_table(*new_table, scalar);
+        table         = new_table;
+        cache[scalar] = table;
+        for (auto it = cache.begin(); it != cache.end();) {
+            it = it->second.expired() ? cache.erase(it) : std::next(it);
+        }
+    }
+    return table;
+}
+
 /***********************************************************************
  * Implementation for sc16 to sc8 lookup table
  *  - Lookup the real and imaginary parts individually
@@ -23,19 +55,28 @@ typedef uint16_t (*tohost16_type)(uint16_t);
 template <bool swap> class convert_sc16_1_to_sc8_item32_1 : public converter
 {
 public:
-    convert_sc16_1_to_sc8_item32_1(void) : _table(sc16_table_len) {}
+    typedef std::vector<uint8_t> table_type;
 
-    void set_scalar(const double scalar)
+    static void fill_table(table_type& table, const double scalar)
     {
         for (size_t i = 0; i < sc16_table_len; i++) {
             const int16_t val = uint16_t(i);
-            _table[i]         = int8_t(boost::math::iround(val * scalar / 32767.));
+            table[i]          = int8_t(boost::math::iround(val * scalar / 32767.));
         }
     }
 
+    void set_scalar(const double scalar)
+    {
+        _table = get_shared_table<convert_sc16_1_to_sc8_item32_1>(scalar);
+        _lut   = _table->data();
+    }
+
     void operator()(
         const input_type& inputs, const output_type& outputs, const size_t nsamps)
     {
+        if (not _table) {
+            set_scalar(0.0);
+        }
         const sc16_t* input = reinterpret_cast<const sc16_t*>(inputs[0]);
         item32_t* output    = reinterpret_cast<item32_t*>(outputs[0]);
 
@@ -53,19 +94,20 @@ public:
     item32_t lookup(const sc16_t& in0, const sc16_t& in1)
     {
         if (swap) { // hope this compiles out, its a template constant
-            return (item32_t(_table[uint16_t(in1.real())]) << 16)
-                   | (item32_t(_table[uint16_t(in1.imag())]) << 24)
-                   | (item32_t(_table[uint16_t(in0.real())]) << 0)
-                   | (item32_t(_table[uint16_t(in0.imag())]) << 8);
+            return (item32_t(_lut[uint16_t(in1.real())]) << 16)
+                   | (item32_t(_lut[uint16_t(in1.imag())]) << 24)
+                   | (item32_t(_lut[uint16_t(in0.real())]) << 0)
+                   | (item32_t(_lut[uint16_t(in0.imag())]) << 8);
         }
-        return (item32_t(_table[uint16_t(in1.real())]) << 8)
-               | (item32_t(_table[uint16_t(in1.imag())]) << 0)
-               | (item32_t(_table[uint16_t(in0.real())]) << 24)
-               | (item32_t(_table[uint16_t(in0.imag())]) << 16);
+        return (item32_t(_lut[uint16_t(in1.real())]) << 8)
+               | (item32_t(_lut[uint16_t(in1.imag())]) << 0)
+               | (item32_t(_lut[uint16_t(in0.real())]) << 24)
+               | (item32_t(_lut[uint16_t(in0.imag())]) << 16);
     }
 
 private:
-    std::vector<uint8_t> _table;
+    std::shared_ptr<const table_type> _table;
+    const uint8_t* _lut = nullptr;
 };
 
 /***********************************************************************
@@ -76,31 +118,40 @@ template <typename type, tohost16_type tohost, size_t re_shift, size_t im_shift>
 class convert_sc16_item32_1_to_fcxx_1 : public converter
 {
 public:
-    convert_sc16_item32_1_to_fcxx_1(void) : _table(sc16_table_len) {}
+    typedef std::vector<type> table_type;
 
-    void set_scalar(const double scalar)
+    static void fill_table(table_type& table, const double scalar)
     {
         for (size_t i = 0; i < sc16_table_len; i++) {
             const uint16_t val = tohost(uint16_t(i & 0xffff));
-            _table[i]          = type(int16_t(val) * scalar);
+            table[i]           = type(int16_t(val) * scalar);
         }
     }
 
+    void set_scalar(const double scalar)
+    {
+        _table = get_shared_table<convert_sc16_item32_1_to_fcxx_1>(scalar);
+    }
+
     void operator()(
         const input_type& inputs, const output_type& outputs, const size_t nsamps)
     {
+        if (not _table) {
+            set_scalar(0.0);
+        }
         const item32_t* input      = reinterpret_cast<const item32_t*>(inputs[0]);
         std::complex<type>* output = reinterpret_cast<std::complex<type>*>(outputs[0]);
+        const type* table          = _table->data();
 
         for (size_t i = 0; i < nsamps; i++) {
             const item32_t item = input[i];
             output[i]           = std::complex<type>(
-                _table[uint16_t(item >> re_shift)], _table[uint16_t(item >> im_shift)]);
+                table[uint16_t(item >> re_shift)], table[uint16_t(item >> im_shift)]);
         }
     }
 
 private:
-    std::vector<type> _table;
+    std::shared_ptr<const table_type> _table;
 };
 
 /***********************************************************************
@@ -111,7 +162,7 @@ template <typename type, tohost16_type tohost, size_t lo_shift, size_t hi_shift>
 class convert_sc8_item32_1_to_fcxx_1 : public converter
 {
 public:
-    convert_sc8_item32_1_to_fcxx_1(void) : _table(sc16_table_len) {}
+    typedef std::vector<std::complex<type>> table_type;
 
     // special case for sc16 type, 32767 undoes float normalization
     static type conv(const int8_t& num, const double scalar)
@@ -122,46 +173,56 @@ public:
         return type(num * scalar);
     }
 
-    void set_scalar(const double scalar)
+    static void fill_table(table_type& table, const double scalar)
     {
         for (size_t i = 0; i < sc16_table_len; i++) {
             const uint16_t val = tohost(uint16_t(i & 0xffff));
             const type real    = conv(int8_t(val >> 8), scalar);
             const type imag    = conv(int8_t(val >> 0), scalar);
-            _table[i]          = std::complex<type>(real, imag);
+            table[i]           = std::complex<type>(real, imag);
         }
     }
 
+    void set_scalar(const double scalar)
+    {
+        _table = get_shared_table<convert_sc8_item32_1_to_fcxx_1>(scalar);
+    }
+
     void operator()(
         const input_type& inputs, const output_type& outputs, const size_t nsamps)
     {
+        if (not _table) {
+            set_scalar(0.0);
+        }
         const item32_t* input =
             reinterpret_cast<const item32_t*>(size_t(inputs[0]) & ~0x3);
         std::complex<type>* output = reinterpret_cast<std::complex<type>*>(outputs[0]);
 
+        const std::complex<type>* table = _table->data();
+
         size_t num_samps = nsamps;
 
         if ((size_t(inputs[0]) & 0x3) != 0) {
             const item32_t item0 = *input++;
-            *output++            = _table[uint16_t(item0 >> hi_shift)];
+            *output++            = table[uint16_t(item0 >> hi_shift)];
             num_samps--;
         }
 
         const size_t num_pairs = num_samps / 2;
         for (size_t i = 0, j = 0; i < num_pairs; i++, j += 2) {
             const item32_t item_i = (input[i]);
-            output[j]             = _table[uint16_t(item_i >> lo_shift)];
-            output[j + 1]         = _table[uint16_t(item_i >> hi_shift)];
+            output[j]             = table[uint16_t(item_i >> lo_shift)];
+            output[j + 1]         = table[uint16_t(item_i >> hi_shift)];
         }
 
         if (num_samps != num_pairs * 2) {
             const item32_t item_n = input[num_pairs];
-            output[num_samps - 1] = _table[uint16_t(item_n >> lo_shift)];
+            output[num_samps - 1] = table[uint16_t(item_n >> lo_shift)];
         }
     }
 
 private:
-    std::vector<std::complex<type>> _table;
+    std::shared_ptr<const table_type> _table;
 };
 
 /***********************************************************************
@@ -250,7 +311,7 @@ static converter::sptr make_convert_sc16_1_to_sc8_item32_le_1(void)
     return converter::sptr(new convert_sc16_1_to_sc8_item32_1<LE_SWAP>());
 }
 
-UHD_STATIC_BLOCK(register_convert_sc16_item32_1_to_fcxx_1)
+UHD_CONVERT_REGISTRATION(register_convert_sc16_item32_1_to_fcxx_1)
 {
     uhd::convert::id_type id;
     id.num_inputs  = 1;
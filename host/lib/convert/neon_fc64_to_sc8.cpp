@@ -0,0 +1,52 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_neon_common.hpp"
+
+using namespace uhd::convert;
+
+template <typename wire>
+static void convert_fc64_1_to_sc8_item32_1_neon(
+    const fc64_t* input, item32_t* output, const size_t nsamps, const double scale_factor)
+{
+    size_t i = 0;
+    for (size_t j = 0; i + 7 < nsamps; i += 8, j += 4) {
+        const double* in = reinterpret_cast<const double*>(input + i);
+
+        // scale, convert and saturate to bytes
+        const int16x8_t lo =
+            vcombine_s16(vqmovn_s32(neon_scale_f64_to_s32(in + 0, scale_factor)),
+                vqmovn_s32(neon_scale_f64_to_s32(in + 4, scale_factor)));
+        const int16x8_t hi =
+            vcombine_s16(vqmovn_s32(neon_scale_f64_to_s32(in + 8, scale_factor)),
+                vqmovn_s32(neon_scale_f64_to_s32(in + 12, scale_factor)));
+        const int8x16_t tmpi = vcombine_s8(vqmovn_s16(lo), vqmovn_s16(hi));
+
+        // bring the bytes into wire order and store 4 items
+        vst1q_s8(reinterpret_cast<int8_t*>(output + j), wire::swap_sc8(tmpi));
+    }
+
+    // convert any remaining samples
+    xx_to_item32_sc8<wire::to_wire>(input + i, output + (i / 2), nsamps - i, scale_factor);
+}
+
+DECLARE_CONVERTER(fc64, 1, sc8_item32_le, 1, PRIORITY_SIMD)
+{
+    const fc64_t* input = reinterpret_cast<const fc64_t*>(inputs[0]);
+    item32_t* output    = reinterpret_cast<item32_t*>(outputs[0]);
+
+    convert_fc64_1_to_sc8_item32_1_neon<neon_item32_le>(
+        input, output, nsamps, scale_factor);
+}
+
+DECLARE_CONVERTER(fc64, 1, sc8_item32_be, 1, PRIORITY_SIMD)
+{
+    const fc64_t* input = reinterpret_cast<const fc64_t*>(inputs[0]);
+    item32_t* output    = reinterpret_cast<item32_t*>(outputs[0]);
+
+    convert_fc64_1_to_sc8_item32_1_neon<neon_item32_be>(
+        input, output, nsamps, scale_factor);
+}
@@ -0,0 +1,220 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_neon_common.hpp"
+#include "convert_pack_sc12.hpp"
+
+/*
+ * The NEON kernel packs 16 samples, 4 blocks of 3 lines, at a time.
+ *
+ * De-interleaving loads put the k-th of the 8 numbers (I0, Q0, ... I3, Q3) of
+ * every block into lane g of iq[k], where g is the block. The lines of all 4
+ * blocks are then computed as in pack() above, and an interleaving store puts
+ * them back into block order.
+ */
+template <typename wire>
+UHD_INLINE void pack_sc12_16x(item32_sc12_3x* output, const uint32x4_t (&in)[8])
+{
+    const uint32x4_t mask = vdupq_n_u32(0xfff);
+    uint32x4_t iq[8];
+    for (size_t k = 0; k < 8; k++) {
+        iq[k] = vandq_u32(in[k], mask);
+    }
+
+    uint32x4x3_t lines;
+    lines.val[0] = vorrq_u32(vorrq_u32(vshlq_n_u32(iq[0], 20), vshlq_n_u32(iq[1], 8)),
+        vshrq_n_u32(iq[2], 4));
+    lines.val[1] = vorrq_u32(vorrq_u32(vshlq_n_u32(iq[2], 28), vshlq_n_u32(iq[3], 16)),
+        vorrq_u32(vshlq_n_u32(iq[4], 4), vshrq_n_u32(iq[5], 8)));
+    lines.val[2] = vorrq_u32(vorrq_u32(vshlq_n_u32(iq[5], 24), vshlq_n_u32(iq[6], 12)),
+        iq[7]);
+    for (size_t l = 0; l < 3; l++) {
+        lines.val[l] = wire::swap_item32(lines.val[l]);
+    }
+    vst3q_u32(reinterpret_cast<uint32_t*>(output), lines);
+}
+
+template <typename wire>
+UHD_INLINE void convert_star_16_to_sc12_item32_12(
+    const std::complex<float>* input, item32_sc12_3x* output, const double scalar)
+{
+    const float32x4_t scale = vdupq_n_f32(float(scalar));
+    const float* in         = reinterpret_cast<const float*>(input);
+    const float32x4x4_t lo  = vld4q_f32(in + 0);
+    const float32x4x4_t hi  = vld4q_f32(in + 16);
+
+    uint32x4_t iq[8];
+    for (size_t k = 0; k < 4; k++) {
+        const float32x4x2_t tmp = vuzpq_f32(lo.val[k], hi.val[k]);
+        iq[k] = vreinterpretq_u32_s32(vcvtq_s32_f32(vmulq_f32(tmp.val[0], scale)));
+        iq[k + 4] = vreinterpretq_u32_s32(vcvtq_s32_f32(vmulq_f32(tmp.val[1], scale)));
+    }
+    pack_sc12_16x<wire>(output, iq);
+}
+
+template <typename wire>
+UHD_INLINE void convert_star_16_to_sc12_item32_12(
+    const std::complex<short>* input, item32_sc12_3x* output, const double)
+{
+    const int16x8x4_t tmpi = vld4q_s16(reinterpret_cast<const int16_t*>(input));
+
+    uint32x4_t iq[8];
+    for (size_t k = 0; k < 4; k++) {
+        const int16x8x2_t tmp = vuzpq_s16(tmpi.val[k], tmpi.val[k]);
+        iq[k] =
+            vreinterpretq_u32_s32(vshrq_n_s32(vmovl_s16(vget_low_s16(tmp.val[0])), 4));
+        iq[k + 4] =
+            vreinterpretq_u32_s32(vshrq_n_s32(vmovl_s16(vget_low_s16(tmp.val[1])), 4));
+    }
+    pack_sc12_16x<wire>(output, iq);
+}
+
+template <typename type, typename wire>
+struct convert_star_1_to_sc12_item32_1_neon : public converter
+{
+    convert_star_1_to_sc12_item32_1_neon(void) : _scalar(0.0)
+    {
+        // NOP
+    }
+
+    void set_scalar(const double scalar)
+    {
+        _scalar = scalar;
+    }
+
+    void operator()(const input_type& inputs, const output_type& outputs, const size_t nsamps)
+    {
+        const std::complex<type>* input =
+            reinterpret_cast<const std::complex<type>*>(inputs[0]);
+
+        // See convert_pack_sc12.cpp for the head and tail cases
+        const size_t head_samps = size_t(outputs[0]) & 0x3;
+        int enable;
+        size_t rewind = 0;
+        switch (head_samps) {
+            case 0:
+                break;
+            case 1:
+                rewind = 9;
+                break;
+            case 2:
+                rewind = 6;
+                break;
+            case 3:
+                rewind = 3;
+                break;
+        }
+        item32_sc12_3x* output =
+            reinterpret_cast<item32_sc12_3x*>(size_t(outputs[0]) - rewind);
+
+        // helper variables
+        size_t i = 0, o = 0;
+
+        // handle the head case
+        switch (head_samps) {
+            case 0:
+                break; // no head
+            case 1:
+                enable = CONVERT12_LINE2;
+                convert_star_4_to_sc12_item32_3<type, wire::to_wire>(
+                    0, 0, 0, input[0], enable, output[o++], _scalar);
+                break;
+            case 2:
+                enable = CONVERT12_LINE2 | CONVERT12_LINE1;
+                convert_star_4_to_sc12_item32_3<type, wire::to_wire>(
+                    0, 0, input[0], input[1], enable, output[o++], _scalar);
+                break;
+            case 3:
+                enable = CONVERT12_LINE2 | CONVERT12_LINE1 | CONVERT12_LINE0;
+                convert_star_4_to_sc12_item32_3<type, wire::to_wire>(
+                    0, input[0], input[1], input[2], enable, output[o++], _scalar);
+                break;
+        }
+        i += head_samps;
+
+        // convert the body, 16 samples at a time with NEON and the rest in
+        // whole blocks
+        for (; i + 15 < nsamps; i += 16, o += 4) {
+            convert_star_16_to_sc12_item32_12<wire>(&input[i], &output[o], _scalar);
+        }
+        for (; i + 3 < nsamps; i += 4, o++) {
+            convert_star_4_to_sc12_item32_3<type, wire::to_wire>(input[i + 0],
+                input[i + 1],
+                input[i + 2],
+                input[i + 3],
+                CONVERT12_LINE_ALL,
+                output[o],
+                _scalar);
+        }
+
+        // handle the tail case
+        const size_t tail_samps = nsamps - i;
+        switch (tail_samps) {
+            case 0:
+                break; // no tail
+            case 1:
+                enable = CONVERT12_LINE0;
+                convert_star_4_to_sc12_item32_3<type, wire::to_wire>(
+                    input[i + 0], 0, 0, 0, enable, output[o], _scalar);
+                break;
+            case 2:
+                enable = CONVERT12_LINE0 | CONVERT12_LINE1;
+                convert_star_4_to_sc12_item32_3<type, wire::to_wire>(
+                    input[i + 0], input[i + 1], 0, 0, enable, output[o], _scalar);
+                break;
+            case 3:
+                enable = CONVERT12_LINE0 | CONVERT12_LINE1 | CONVERT12_LINE2;
+                convert_star_4_to_sc12_item32_3<type, wire::to_wire>(
+                    input[i + 0], input[i + 1], input[i + 2], 0, enable, output[o], _scalar);
+                break;
+        }
+    }
+
+    double _scalar;
+};
+
+static converter::sptr make_convert_fc32_1_to_sc12_item32_le_1(void)
+{
+    return converter::sptr(new convert_star_1_to_sc12_item32_1_neon<float, neon_item32_le>());
+}
+
+static converter::sptr make_convert_fc32_1_to_sc12_item32_be_1(void)
+{
+    return converter::sptr(new convert_star_1_to_sc12_item32_1_neon<float, neon_item32_be>());
+}
+
+static converter::sptr make_convert_sc16_1_to_sc12_item32_le_1(void)
+{
+    return converter::sptr(new convert_star_1_to_sc12_item32_1_neon<short, neon_item32_le>());
+}
+
+static converter::sptr make_convert_sc16_1_to_sc12_item32_be_1(void)
+{
+    return converter::sptr(new convert_star_1_to_sc12_item32_1_neon<short, neon_item32_be>());
+}
+
+UHD_CONVERT_REGISTRATION(register_neon_pack_sc12)
+{
+    uhd::convert::id_type id;
+    id.num_inputs  = 1;
+    id.num_outputs = 1;
+
+    id.input_format  = "fc32";
+    id.output_format = "sc12_item32_le";
+    uhd::convert::register_converter(
+        id, &make_convert_fc32_1_to_sc12_item32_le_1, PRIORITY_SIMD);
+    id.output_format = "sc12_item32_be";
+    uhd::convert::register_converter(
+        id, &make_convert_fc32_1_to_sc12_item32_be_1, PRIORITY_SIMD);
+
+    id.input_format  = "sc16";
+    id.output_format = "sc12_item32_le";
+    uhd::convert::register_converter(
+        id, &make_convert_sc16_1_to_sc12_item32_le_1, PRIORITY_SIMD);
+    id.output_format = "sc12_item32_be";
+    uhd::convert::register_converter(
+        id, &make_convert_sc16_1_to_sc12_item32_be_1, PRIORITY_SIMD);
+}
@@ -0,0 +1,49 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_neon_common.hpp"
+
+using namespace uhd::convert;
+
+template <typename wire>
+static void convert_sc16_item32_1_to_fc64_1_neon(
+    const item32_t* input, fc64_t* output, const size_t nsamps, const double scale_factor)
+{
+    const float32x4_t scalar = vdupq_n_f32(float(scale_factor));
+
+    size_t i = 0;
+    for (; i + 3 < nsamps; i += 4) {
+        // load 4 items and bring the shorts into I, Q order
+        const int16x8_t tmpi =
+            wire::swap_sc16(vld1q_s16(reinterpret_cast<const int16_t*>(input + i)));
+
+        // convert, scale and store to output
+        double* out = reinterpret_cast<double*>(output + i);
+        neon_store_f64(out + 0, neon_scale_s16_to_f32(vget_low_s16(tmpi), scalar));
+        neon_store_f64(out + 4, neon_scale_s16_to_f32(vget_high_s16(tmpi), scalar));
+    }
+
+    // convert any remaining samples
+    item32_sc16_to_xx<wire::to_host>(input + i, output + i, nsamps - i, scale_factor);
+}
+
+DECLARE_CONVERTER(sc16_item32_le, 1, fc64, 1, PRIORITY_SIMD)
+{
+    const item32_t* input = reinterpret_cast<const item32_t*>(inputs[0]);
+    fc64_t* output        = reinterpret_cast<fc64_t*>(outputs[0]);
+
+    convert_sc16_item32_1_to_fc64_1_neon<neon_item32_le>(
+        input, output, nsamps, scale_factor);
+}
+
+DECLARE_CONVERTER(sc16_item32_be, 1, fc64, 1, PRIORITY_SIMD)
+{
+    const item32_t* input = reinterpret_cast<const item32_t*>(inputs[0]);
+    fc64_t* output        = reinterpret_cast<fc64_t*>(outputs[0]);
+
+    convert_sc16_item32_1_to_fc64_1_neon<neon_item32_be>(
+        input, output, nsamps, scale_factor);
+}
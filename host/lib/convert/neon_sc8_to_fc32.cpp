@@ -0,0 +1,59 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_neon_common.hpp"
+
+using namespace uhd::convert;
+
+template <typename wire>
+static void convert_sc8_item32_1_to_fc32_1_neon(
+    const void* input_mem, fc32_t* output, const size_t nsamps, const double scale_factor)
+{
+    const item32_t* input =
+        reinterpret_cast<const item32_t*>(size_t(input_mem) & ~0x3);
+    const float32x4_t scalar = vdupq_n_f32(float(scale_factor));
+
+    size_t num_samps = nsamps;
+    if ((size_t(input_mem) & 0x3) != 0) {
+        item32_sc8_to_xx<wire::to_host>(input++, output++, 1, scale_factor);
+        num_samps--;
+    }
+
+    size_t i = 0, j = 0;
+    for (; j + 7 < num_samps; j += 8, i += 4) {
+        // load 4 items and bring the bytes into I, Q order
+        const int8x16_t tmpi =
+            wire::swap_sc8(vld1q_s8(reinterpret_cast<const int8_t*>(input + i)));
+
+        // sign-extend, convert and scale
+        const int16x8_t lo = vmovl_s8(vget_low_s8(tmpi));
+        const int16x8_t hi = vmovl_s8(vget_high_s8(tmpi));
+        float* out         = reinterpret_cast<float*>(output + j);
+        vst1q_f32(out + 0, neon_scale_s16_to_f32(vget_low_s16(lo), scalar));
+        vst1q_f32(out + 4, neon_scale_s16_to_f32(vget_high_s16(lo), scalar));
+        vst1q_f32(out + 8, neon_scale_s16_to_f32(vget_low_s16(hi), scalar));
+        vst1q_f32(out + 12, neon_scale_s16_to_f32(vget_high_s16(hi), scalar));
+    }
+
+    // convert any remaining samples
+    item32_sc8_to_xx<wire::to_host>(input + i, output + j, num_samps - j, scale_factor);
+}
+
+DECLARE_CONVERTER(sc8_item32_le, 1, fc32, 1, PRIORITY_SIMD)
+{
+    fc32_t* output = reinterpret_cast<fc32_t*>(outputs[0]);
+
+    convert_sc8_item32_1_to_fc32_1_neon<neon_item32_le>(
+        inputs[0], output, nsamps, scale_factor);
+}
+
+DECLARE_CONVERTER(sc8_item32_be, 1, fc32, 1, PRIORITY_SIMD)
+{
+    fc32_t* output = reinterpret_cast<fc32_t*>(outputs[0]);
+
+    convert_sc8_item32_1_to_fc32_1_neon<neon_item32_be>(
+        inputs[0], output, nsamps, scale_factor);
+}
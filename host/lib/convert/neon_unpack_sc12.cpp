@@ -0,0 +1,218 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_neon_common.hpp"
+#include "convert_unpack_sc12.hpp"
+
+/*
+ * The NEON kernel unpacks 16 samples, 4 blocks of 3 lines, at a time.
+ *
+ * A de-interleaving load puts line l of every block into lane g of
+ * lines.val[l], where g is the block. The k-th of the 8 numbers (I0, Q0, ...
+ * I3, Q3) of all 4 blocks is then extracted as in
+ * convert_sc12_item32_3_to_star_4() above, into the upper 12 bits of a short.
+ * Interleaving stores put the numbers back into sample order.
+ */
+template <typename wire>
+UHD_INLINE void unpack_sc12_16x(const item32_sc12_3x* input, int16x4_t (&iq)[8])
+{
+    uint32x4x3_t lines = vld3q_u32(reinterpret_cast<const uint32_t*>(input));
+    for (size_t l = 0; l < 3; l++) {
+        lines.val[l] = wire::swap_item32(lines.val[l]);
+    }
+    const uint32x4_t line0 = lines.val[0];
+    const uint32x4_t line1 = lines.val[1];
+    const uint32x4_t line2 = lines.val[2];
+
+    const uint32x4_t mask = vdupq_n_u32(0xfff0);
+    const uint32x4_t tmp[8] = {
+        vshrq_n_u32(line0, 16),
+        vshrq_n_u32(line0, 4),
+        vorrq_u32(vshlq_n_u32(line0, 8), vshrq_n_u32(line1, 24)),
+        vshrq_n_u32(line1, 12),
+        line1,
+        vorrq_u32(vshlq_n_u32(line1, 12), vshrq_n_u32(line2, 20)),
+        vshrq_n_u32(line2, 8),
+        vshlq_n_u32(line2, 4),
+    };
+    for (size_t k = 0; k < 8; k++) {
+        iq[k] = vreinterpret_s16_u16(vmovn_u32(vandq_u32(tmp[k], mask)));
+    }
+}
+
+template <typename wire>
+UHD_INLINE void convert_sc12_item32_12_to_star_16(
+    const item32_sc12_3x* input, std::complex<float>* output, const double scalar)
+{
+    int16x4_t iq[8];
+    unpack_sc12_16x<wire>(input, iq);
+
+    const float32x4_t scale = vdupq_n_f32(float(scalar));
+    float32x4x4_t lo, hi;
+    for (size_t k = 0; k < 4; k++) {
+        const float32x4x2_t tmp = vzipq_f32(neon_scale_s16_to_f32(iq[k], scale),
+            neon_scale_s16_to_f32(iq[k + 4], scale));
+        lo.val[k] = tmp.val[0];
+        hi.val[k] = tmp.val[1];
+    }
+    float* out = reinterpret_cast<float*>(output);
+    vst4q_f32(out + 0, lo);
+    vst4q_f32(out + 16, hi);
+}
+
+template <typename wire>
+UHD_INLINE void convert_sc12_item32_12_to_star_16(
+    const item32_sc12_3x* input, std::complex<short>* output, const double)
+{
+    int16x4_t iq[8];
+    unpack_sc12_16x<wire>(input, iq);
+
+    int16x8x4_t tmpi;
+    for (size_t k = 0; k < 4; k++) {
+        const int16x4x2_t tmp = vzip_s16(iq[k], iq[k + 4]);
+        tmpi.val[k]           = vcombine_s16(tmp.val[0], tmp.val[1]);
+    }
+    vst4q_s16(reinterpret_cast<int16_t*>(output), tmpi);
+}
+
+template <typename type, typename wire>
+struct convert_sc12_item32_1_to_star_1_neon : public converter
+{
+    convert_sc12_item32_1_to_star_1_neon(void) : _scalar(0.0)
+    {
+        // NOP
+    }
+
+    void set_scalar(const double scalar)
+    {
+        const int unpack_growth = 16;
+        _scalar                 = scalar / unpack_growth;
+    }
+
+    void operator()(const input_type& inputs, const output_type& outputs, const size_t nsamps)
+    {
+        // See convert_unpack_sc12.cpp for the head and tail cases
+        const size_t head_samps = size_t(inputs[0]) & 0x3;
+        size_t rewind           = 0;
+        switch (head_samps) {
+            case 0:
+                break;
+            case 1:
+                rewind = 9;
+                break;
+            case 2:
+                rewind = 6;
+                break;
+            case 3:
+                rewind = 3;
+                break;
+        }
+        const item32_sc12_3x* input =
+            reinterpret_cast<const item32_sc12_3x*>(size_t(inputs[0]) - rewind);
+        std::complex<type>* output = reinterpret_cast<std::complex<type>*>(outputs[0]);
+
+        // helper variables
+        std::complex<type> dummy0, dummy1, dummy2;
+        size_t i = 0, o = 0;
+
+        // handle the head case
+        switch (head_samps) {
+            case 0:
+                break; // no head
+            case 1:
+                convert_sc12_item32_3_to_star_4<type, wire::to_host>(
+                    input[i++], dummy0, dummy1, dummy2, output[0], _scalar);
+                break;
+            case 2:
+                convert_sc12_item32_3_to_star_4<type, wire::to_host>(
+                    input[i++], dummy0, dummy1, output[0], output[1], _scalar);
+                break;
+            case 3:
+                convert_sc12_item32_3_to_star_4<type, wire::to_host>(
+                    input[i++], dummy0, output[0], output[1], output[2], _scalar);
+                break;
+        }
+        o += head_samps;
+
+        // convert the body, 16 samples at a time with NEON and the rest in
+        // whole blocks
+        for (; o + 15 < nsamps; i += 4, o += 16) {
+            convert_sc12_item32_12_to_star_16<wire>(&input[i], &output[o], _scalar);
+        }
+        for (; o + 3 < nsamps; i++, o += 4) {
+            convert_sc12_item32_3_to_star_4<type, wire::to_host>(input[i],
+                output[o + 0],
+                output[o + 1],
+                output[o + 2],
+                output[o + 3],
+                _scalar);
+        }
+
+        // handle the tail case
+        const size_t tail_samps = nsamps - o;
+        switch (tail_samps) {
+            case 0:
+                break; // no tail
+            case 1:
+                convert_sc12_item32_3_to_star_4<type, wire::to_host>(
+                    input[i], output[o + 0], dummy0, dummy1, dummy2, _scalar);
+                break;
+            case 2:
+                convert_sc12_item32_3_to_star_4<type, wire::to_host>(
+                    input[i], output[o + 0], output[o + 1], dummy1, dummy2, _scalar);
+                break;
+            case 3:
+                convert_sc12_item32_3_to_star_4<type, wire::to_host>(
+                    input[i], output[o + 0], output[o + 1], output[o + 2], dummy2, _scalar);
+                break;
+        }
+    }
+
+    double _scalar;
+};
+
+static converter::sptr make_convert_sc12_item32_le_1_to_fc32_1(void)
+{
+    return converter::sptr(new convert_sc12_item32_1_to_star_1_neon<float, neon_item32_le>());
+}
+
+static converter::sptr make_convert_sc12_item32_be_1_to_fc32_1(void)
+{
+    return converter::sptr(new convert_sc12_item32_1_to_star_1_neon<float, neon_item32_be>());
+}
+
+static converter::sptr make_convert_sc12_item32_le_1_to_sc16_1(void)
+{
+    return converter::sptr(new convert_sc12_item32_1_to_star_1_neon<short, neon_item32_le>());
+}
+
+static converter::sptr make_convert_sc12_item32_be_1_to_sc16_1(void)
+{
+    return converter::sptr(new convert_sc12_item32_1_to_star_1_neon<short, neon_item32_be>());
+}
+
+UHD_CONVERT_REGISTRATION(register_neon_unpack_sc12)
+{
+    uhd::convert::id_type id;
+    id.num_inputs  = 1;
+    id.num_outputs = 1;
+
+    id.output_format = "fc32";
+    id.input_format  = "sc12_item32_le";
+    uhd::convert::register_converter(
+        id, &make_convert_sc12_item32_le_1_to_fc32_1, PRIORITY_SIMD);
+    id.input_format = "sc12_item32_be";
+    uhd::convert::register_converter(
+        id, &make_convert_sc12_item32_be_1_to_fc32_1, PRIORITY_SIMD);
+
+    id.output_format = "sc16";
+    id.input_format  = "sc12_item32_le";
+    uhd::convert::register_converter(
+        id, &make_convert_sc12_item32_le_1_to_sc16_1, PRIORITY_SIMD);
+    id.input_format = "sc12_item32_be";
+    uhd::convert::register_converter(
+        id, &make_convert_sc12_item32_be_1_to_sc16_1, PRIORITY_SIMD);
+}
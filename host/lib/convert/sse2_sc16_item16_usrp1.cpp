@@ -0,0 +1,66 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_common.hpp"
+#include <emmintrin.h>
+
+using namespace uhd::convert;
+
+/***********************************************************************
+ * The USRP1 sends little endian 16-bit I and Q values, which is the host
+ * order on every machine with SSE2. The results are the same as with the
+ * generic converters: float to integer conversions truncate.
+ **********************************************************************/
+DECLARE_CONVERTER(sc16_item16_usrp1, 1, fc32, 1, PRIORITY_SIMD)
+{
+    const int16_t* input = reinterpret_cast<const int16_t*>(inputs[0]);
+    fc32_t* output       = reinterpret_cast<fc32_t*>(outputs[0]);
+
+    // the values end up in the upper 16 bits, which undoes the 1 << 16
+    const __m128 scalar = _mm_set_ps1(float(scale_factor) / (1 << 16));
+    const __m128i zeroi = _mm_setzero_si128();
+
+    size_t i = 0;
+    for (; i + 3 < nsamps; i += 4) {
+        const __m128i tmpi =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + 2 * i));
+        const __m128 tmplo =
+            _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(zeroi, tmpi)), scalar);
+        const __m128 tmphi =
+            _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(zeroi, tmpi)), scalar);
+        _mm_storeu_ps(reinterpret_cast<float*>(output + i + 0), tmplo);
+        _mm_storeu_ps(reinterpret_cast<float*>(output + i + 2), tmphi);
+    }
+
+    for (; i < nsamps; i++) {
+        output[i] = fc32_t(input[2 * i + 0] * float(scale_factor),
+            input[2 * i + 1] * float(scale_factor));
+    }
+}
+
+DECLARE_CONVERTER(fc32, 1, sc16_item16_usrp1, 1, PRIORITY_SIMD)
+{
+    const fc32_t* input = reinterpret_cast<const fc32_t*>(inputs[0]);
+    int16_t* output     = reinterpret_cast<int16_t*>(outputs[0]);
+
+    const __m128 scalar = _mm_set_ps1(float(scale_factor));
+
+    size_t i = 0;
+    for (; i + 3 < nsamps; i += 4) {
+        const __m128 tmplo = _mm_loadu_ps(reinterpret_cast<const float*>(input + i));
+        const __m128 tmphi =
+            _mm_loadu_ps(reinterpret_cast<const float*>(input + i + 2));
+        const __m128i tmpilo = _mm_cvttps_epi32(_mm_mul_ps(tmplo, scalar));
+        const __m128i tmpihi = _mm_cvttps_epi32(_mm_mul_ps(tmphi, scalar));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + 2 * i),
+            _mm_packs_epi32(tmpilo, tmpihi));
+    }
+
+    for (; i < nsamps; i++) {
+        output[2 * i + 0] = int16_t(input[i].real() * float(scale_factor));
+        output[2 * i + 1] = int16_t(input[i].imag() * float(scale_factor));
+    }
+}
@@ -0,0 +1,128 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "convert_common.hpp"
+#include <uhd/utils/byteswap.hpp>
+#include <emmintrin.h>
+
+using namespace uhd::convert;
+
+namespace {
+
+//! Most samples to sum up in single precision before adding them to the
+//  accumulator, which keeps the rounding error small
+constexpr size_t BLOCK_NSAMPS = 1024;
+
+//! Add the 4 floats of a vector
+UHD_INLINE double sum_ps(const __m128 v)
+{
+    float f[4];
+    _mm_storeu_ps(f, v);
+    return double(f[0]) + double(f[1]) + double(f[2]) + double(f[3]);
+}
+
+/*! Convert sc16 to fc32 4 samples at a time, and measure the samples on the way
+ *
+ * The samples are still in registers after the conversion, so summing them up
+ * there costs a few instructions, but no extra memory accesses.
+ */
+template <xtox_t to_host, bool swap_bytes>
+void convert_sc16_item32_1_to_fc32_1_stats(const item32_t* input,
+    fc32_t* output,
+    const size_t nsamps,
+    const double scale_factor,
+    signal_accum_t& accum)
+{
+    const __m128 scalar   = _mm_set_ps1(float(scale_factor) / (1 << 16));
+    const __m128i zeroi   = _mm_setzero_si128();
+    const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    __m128 peak           = _mm_setzero_ps();
+
+    size_t i = 0;
+    while (i + 3 < nsamps) {
+        const size_t block_end = std::min(nsamps, i + BLOCK_NSAMPS);
+        // even lanes sum I, odd lanes sum Q
+        __m128 sum    = _mm_setzero_ps();
+        __m128 sum_sq = _mm_setzero_ps();
+        for (; i + 3 < block_end; i += 4) {
+            // load from input
+            __m128i tmpi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+
+            if (swap_bytes) {
+                // byteswap 16 bit words
+                tmpi = _mm_or_si128(_mm_srli_epi16(tmpi, 8), _mm_slli_epi16(tmpi, 8));
+            } else {
+                // swap 16-bit pairs
+                tmpi = _mm_shufflelo_epi16(tmpi, _MM_SHUFFLE(2, 3, 0, 1));
+                tmpi = _mm_shufflehi_epi16(tmpi, _MM_SHUFFLE(2, 3, 0, 1));
+            }
+            // value in upper 16 bits
+            const __m128i tmpilo = _mm_unpacklo_epi16(zeroi, tmpi);
+            const __m128i tmpihi = _mm_unpackhi_epi16(zeroi, tmpi);
+
+            // convert and scale
+            const __m128 tmplo = _mm_mul_ps(_mm_cvtepi32_ps(tmpilo), scalar);
+            const __m128 tmphi = _mm_mul_ps(_mm_cvtepi32_ps(tmpihi), scalar);
+
+            // store to output
+            _mm_storeu_ps(reinterpret_cast<float*>(output + i + 0), tmplo);
+            _mm_storeu_ps(reinterpret_cast<float*>(output + i + 2), tmphi);
+
+            // measure
+            sum    = _mm_add_ps(sum, _mm_add_ps(tmplo, tmphi));
+            sum_sq = _mm_add_ps(sum_sq,
+                _mm_add_ps(_mm_mul_ps(tmplo, tmplo), _mm_mul_ps(tmphi, tmphi)));
+            peak = _mm_max_ps(peak,
+                _mm_max_ps(_mm_and_ps(tmplo, abs_mask), _mm_and_ps(tmphi, abs_mask)));
+        }
+        float sums[4];
+        _mm_storeu_ps(sums, sum);
+        accum.sum_i += double(sums[0]) + double(sums[2]);
+        accum.sum_q += double(sums[1]) + double(sums[3]);
+        accum.sum_sq += sum_ps(sum_sq);
+    }
+    accum.num_samps += i;
+
+    float peaks[4];
+    _mm_storeu_ps(peaks, peak);
+    accum.peak = std::max({accum.peak,
+        double(peaks[0]),
+        double(peaks[1]),
+        double(peaks[2]),
+        double(peaks[3])});
+
+    // convert any remaining samples
+    item32_sc16_to_fc32_accum<to_host>(
+        input + i, output + i, nsamps - i, scale_factor, accum);
+}
+
+} // namespace
+
+DECLARE_STATS_CONVERTER(sc16_item32_le, 1, fc32_stats, 1, PRIORITY_SIMD)
+{
+    const item32_t* input = reinterpret_cast<const item32_t*>(inputs[0]);
+    fc32_t* output        = reinterpret_cast<fc32_t*>(outputs[0]);
+
+    if (_accum) {
+        convert_sc16_item32_1_to_fc32_1_stats<uhd::htowx, false>(
+            input, output, nsamps, scale_factor, *_accum);
+    } else {
+        item32_sc16_to_xx<uhd::htowx>(input, output, nsamps, scale_factor);
+    }
+}
+
+DECLARE_STATS_CONVERTER(sc16_item32_be, 1, fc32_stats, 1, PRIORITY_SIMD)
+{
+    const item32_t* input = reinterpret_cast<const item32_t*>(inputs[0]);
+    fc32_t* output        = reinterpret_cast<fc32_t*>(outputs[0]);
+
+    if (_accum) {
+        convert_sc16_item32_1_to_fc32_1_stats<uhd::htonx, true>(
+            input, output, nsamps, scale_factor, *_accum);
+    } else {
+        item32_sc16_to_xx<uhd::htonx>(input, output, nsamps, scale_factor);
+    }
+}
@@ -218,7 +218,7 @@ static converter::sptr make_convert_sc16_1_to_sc12_item32_le_1(void)
     return converter::sptr(new convert_star_1_to_sc12_item32_2<short, uhd::wtohx>());
 }
 
-UHD_STATIC_BLOCK(register_sse_pack_sc12)
+UHD_CONVERT_REGISTRATION(register_sse_pack_sc12)
 {
     uhd::convert::id_type id;
     id.num_inputs = 1;
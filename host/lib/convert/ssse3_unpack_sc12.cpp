@@ -194,7 +194,7 @@ static converter::sptr make_convert_sc12_item32_le_1_to_sc16_1(void)
     return converter::sptr(new convert_sc12_item32_1_to_star_2<short, uhd::wtohx>());
 }
 
-UHD_STATIC_BLOCK(register_sse_unpack_sc12)
+UHD_CONVERT_REGISTRATION(register_sse_unpack_sc12)
 {
     uhd::convert::id_type id;
     id.num_inputs = 1;
@@ -12,7 +12,11 @@
 
 #include <uhd/utils/static.hpp>
 #include <uhd/utils/algorithm.hpp>
+#include <uhdlib/utils/discovery_cache.hpp>
+#include <uhdlib/utils/hashed_dict.hpp>
+#include <uhdlib/utils/load_modules.hpp>
 #include <uhdlib/utils/prefs.hpp>
+#include <uhdlib/utils/trace_events.hpp>
 
 #include <boost/format.hpp>
 #include <boost/weak_ptr.hpp>
@@ -91,33 +95,95 @@ device::~device(void){
 /***********************************************************************
  * Discover
  **********************************************************************/
-device_addrs_t device::find(const device_addr_t &hint, device_filter_t filter){
-    boost::mutex::scoped_lock lock(_device_mutex);
-
-    device_addrs_t device_addrs;
-    std::vector<std::future<device_addrs_t>> find_tasks;
-    for (const auto& fcn : get_dev_fcn_regs()) {
-        if (filter == ANY or fcn.get<2>() == filter) {
-            find_tasks.emplace_back(std::async(std::launch::async,
+/*!
+ * Run the find function of every registered device that passes the filter.
+ * \return the discovered addresses, one list per registry entry
+ */
+static std::vector<device_addrs_t> find_per_reg(
+    const device_addr_t &hint, device::device_filter_t filter
+){
+    const auto& regs = get_dev_fcn_regs();
+    std::vector<device_addrs_t> reg_addrs(regs.size());
+    std::vector<std::future<device_addrs_t>> find_tasks(regs.size());
+    for (size_t i = 0; i < regs.size(); i++) {
+        const auto& fcn = regs[i];
+        if (filter == device::ANY or fcn.get<2>() == filter) {
+            find_tasks[i] = std::async(std::launch::async,
                 [fcn, hint](){
                     return fcn.get<0>()(hint);
                 }
-            ));
+            );
         }
     }
-    for(auto &find_task : find_tasks) {
+    for (size_t i = 0; i < regs.size(); i++) {
+        if (not find_tasks[i].valid()) {
+            continue;
+        }
         try {
-            device_addrs_t discovered_addrs = find_task.get();
-            device_addrs.insert(
-                device_addrs.begin(),
-                discovered_addrs.begin(),
-                discovered_addrs.end()
-            );
+            reg_addrs[i] = find_tasks[i].get();
         }
         catch (const std::exception &e) {
             UHD_LOGGER_ERROR("UHD") << "Device discovery error: " << e.what();
         }
     }
+    return reg_addrs;
+}
+
+/*!
+ * Like find_per_reg(), but use the discovery cache if the hint enables it.
+ *
+ * Every cached device that matches the hint is looked for at its cached
+ * address. Only if none of them responds do we broadcast, and then update
+ * the cache with whatever was found.
+ */
+static std::vector<device_addrs_t> find_per_reg_cached(
+    const device_addr_t &hint, device::device_filter_t filter
+){
+    if (not discovery_cache::can_use(hint)) {
+        return find_per_reg(hint, filter);
+    }
+    discovery_cache cache(discovery_cache::get_default_path());
+    std::vector<device_addrs_t> reg_addrs(get_dev_fcn_regs().size());
+    bool found_any = false;
+    for (const device_addr_t &dev_hint : cache.get_hints(hint)) {
+        const std::vector<device_addrs_t> dev_addrs = find_per_reg(dev_hint, filter);
+        bool found = false;
+        for (size_t i = 0; i < dev_addrs.size(); i++) {
+            reg_addrs[i].insert(
+                reg_addrs[i].end(), dev_addrs[i].begin(), dev_addrs[i].end());
+            found = found or not dev_addrs[i].empty();
+        }
+        if (not found) {
+            UHD_LOGGER_DEBUG("UHD")
+                << "Cached device did not respond: " << dev_hint.to_string();
+            cache.remove(dev_hint);
+        }
+        found_any = found_any or found;
+    }
+    if (not found_any) {
+        UHD_LOGGER_DEBUG("UHD") << "No cached device found, broadcasting";
+        reg_addrs = find_per_reg(hint, filter);
+    }
+    for (const device_addrs_t &addrs : reg_addrs) {
+        cache.add(addrs);
+    }
+    cache.save();
+    return reg_addrs;
+}
+
+device_addrs_t device::find(const device_addr_t &hint, device_filter_t filter){
+    // Modules can register devices, so they must be loaded first
+    uhd::load_modules();
+    boost::mutex::scoped_lock lock(_device_mutex);
+
+    device_addrs_t device_addrs;
+    for (const device_addrs_t &discovered_addrs : find_per_reg_cached(hint, filter)) {
+        device_addrs.insert(
+            device_addrs.begin(),
+            discovered_addrs.begin(),
+            discovered_addrs.end()
+        );
+    }
 
     return device_addrs;
 }
@@ -126,22 +192,20 @@ device_addrs_t device::find(const device_addr_t &hint, device_filter_t filter){
  * Make
  **********************************************************************/
 device::sptr device::make(const device_addr_t &hint, device_filter_t filter, size_t which){
+    trace_events::start(hint);
+    UHD_TRACE_SPAN("device", "device::make");
+    uhd::load_modules();
     boost::mutex::scoped_lock lock(_device_mutex);
 
     typedef boost::tuple<device_addr_t, make_t> dev_addr_make_t;
     std::vector<dev_addr_make_t> dev_addr_makers;
 
-    for(const dev_fcn_reg_t &fcn:  get_dev_fcn_regs()){
-        try{
-            if(filter == ANY or fcn.get<2>() == filter){
-                for(device_addr_t dev_addr:  fcn.get<0>()(hint)){
-                    //append the discovered address and its factory function
-                    dev_addr_makers.push_back(dev_addr_make_t(dev_addr, fcn.get<1>()));
-                }
-            }
-        }
-        catch(const std::exception &e){
-            UHD_LOGGER_ERROR("UHD") << "Device discovery error: " << e.what() ;
+    const std::vector<device_addrs_t> reg_addrs = find_per_reg_cached(hint, filter);
+    for (size_t i = 0; i < reg_addrs.size(); i++) {
+        for(const device_addr_t &dev_addr:  reg_addrs[i]){
+            //append the discovered address and its factory function
+            dev_addr_makers.push_back(
+                dev_addr_make_t(dev_addr, get_dev_fcn_regs()[i].get<1>()));
         }
     }
 
@@ -172,7 +236,7 @@ device::sptr device::make(const device_addr_t &hint, device_filter_t filter, siz
     }
 
     //map device address hash to created devices
-    static uhd::dict<size_t, boost::weak_ptr<device> > hash_to_device;
+    static uhd::hashed_dict<size_t, boost::weak_ptr<device> > hash_to_device;
 
     //try to find an existing device
     if (hash_to_device.has_key(dev_hash) and not hash_to_device[dev_hash].expired()){
@@ -182,6 +246,7 @@ device::sptr device::make(const device_addr_t &hint, device_filter_t filter, siz
         // Add keys from the config files (note: the user-defined keys will
         // always be applied, see also get_usrp_args()
         // Then, create and register a new device.
+        UHD_TRACE_SPAN("device", "make");
         device::sptr dev = maker(prefs::get_usrp_args(dev_addr));
         hash_to_device[dev_hash] = dev;
         return dev;
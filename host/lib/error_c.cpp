@@ -11,6 +11,7 @@
 
 #include <boost/thread/mutex.hpp>
 
+#include <atomic>
 #include <cstring>
 
 #define MAP_TO_ERROR(exception_type, error_type) \
@@ -41,6 +42,8 @@ uhd_error error_from_uhd_exception(const uhd::exception* e){
 UHD_SINGLETON_FCN(std::string, _c_global_error_string)
 
 static boost::mutex _error_c_mutex;
+// Set if the error string is "None", so clearing it again needs no lock
+static std::atomic<bool> _c_global_error_is_none(false);
 
 std::string get_c_global_error_string(){
     boost::mutex::scoped_lock lock(_error_c_mutex);
@@ -52,6 +55,14 @@ void set_c_global_error_string(
 ){
     boost::mutex::scoped_lock lock(_error_c_mutex);
     _c_global_error_string() = msg;
+    _c_global_error_is_none = (msg == "None");
+}
+
+void clear_c_global_error_string(){
+    if (_c_global_error_is_none) {
+        return;
+    }
+    set_c_global_error_string("None");
 }
 
 uhd_error uhd_get_last_error(
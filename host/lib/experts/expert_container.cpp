@@ -8,6 +8,7 @@
 #include <uhdlib/experts/expert_container.hpp>
 #include <uhd/exception.hpp>
 #include <uhd/utils/log.hpp>
+#include <uhdlib/utils/trace_events.hpp>
 #include <boost/format.hpp>
 #include <boost/function.hpp>
 #include <boost/bind.hpp>
@@ -19,6 +20,10 @@
 #include <boost/graph/depth_first_search.hpp>
 #include <boost/graph/topological_sort.hpp>
 #include <boost/graph/adjacency_list.hpp>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
 
 #ifdef UHD_EXPERT_LOGGING
 #define EX_LOG(depth, str) _log(depth, str)
@@ -40,6 +45,7 @@ typedef boost::adjacency_list<
 
 typedef std::map<std::string, expert_graph_t::vertex_descriptor> vertex_map_t;
 typedef std::list<expert_graph_t::vertex_descriptor>             node_queue_t;
+typedef std::vector<expert_graph_t::vertex_descriptor>           node_list_t;
 
 typedef boost::graph_traits<expert_graph_t>::edge_iterator       edge_iter;
 typedef boost::graph_traits<expert_graph_t>::vertex_iterator     vertex_iter;
@@ -62,7 +68,7 @@ private:    //Visitor class for cycle detection algorithm
 
 public:
     expert_container_impl(const std::string& name):
-        _name(name)
+        _name(name), _resolve_threads(1), _topology_valid(false)
     {
     }
 
@@ -81,28 +87,37 @@ public:
         boost::lock_guard<boost::recursive_mutex> resolve_lock(_resolve_mutex);
         boost::lock_guard<boost::mutex> lock(_mutex);
         EX_LOG(0, str(boost::format("resolve_all(%s)") % (force?"force":"")));
+        const trace_events::scoped_span trace_span(
+            "experts", [this]() { return _name + " resolve_all"; });
         // Do a full resolve of the graph
-        _resolve_helper("", "", force);
+        _update_topology();
+        _resolve_helper(_sorted_nodes, force);
     }
 
-    void resolve_from(const std::string&)
+    void resolve_from(const std::string& node_name)
     {
-        boost::lock_guard<boost::recursive_mutex> resolve_lock(_resolve_mutex);
-        boost::lock_guard<boost::mutex> lock(_mutex);
-        EX_LOG(0, "resolve_from (overridden to resolve_all)");
-        // Do a full resolve of the graph
-        // Not optimizing the traversal using node_name to reduce experts complexity
-        _resolve_helper("", "", false);
+        expert_graph_t::vertex_descriptor vertex;
+        {
+            boost::lock_guard<boost::mutex> lock(_mutex);
+            vertex = _lookup_vertex(node_name);
+        }
+        _resolve_from_vertex(vertex);
     }
 
-    void resolve_to(const std::string&)
+    void resolve_to(const std::string& node_name)
+    {
+        expert_graph_t::vertex_descriptor vertex;
+        {
+            boost::lock_guard<boost::mutex> lock(_mutex);
+            vertex = _lookup_vertex(node_name);
+        }
+        _resolve_to_vertex(vertex);
+    }
+
+    void set_resolve_threads(const size_t num_threads)
     {
         boost::lock_guard<boost::recursive_mutex> resolve_lock(_resolve_mutex);
-        boost::lock_guard<boost::mutex> lock(_mutex);
-        EX_LOG(0, "resolve_to (overridden to resolve_all)");
-        // Do a full resolve of the graph
-        // Not optimizing the traversal using node_name to reduce experts complexity
-        _resolve_helper("", "", false);
+        _resolve_threads = std::max<size_t>(num_threads, 1);
     }
 
     dag_vertex_t& retrieve(const std::string& name) const
@@ -130,6 +145,15 @@ public:
         static const std::string DATA_SHAPE("ellipse");
         static const std::string WORKER_SHAPE("box");
 
+        //Levels are only informative here, so don't fail on a broken graph
+        std::vector<size_t> levels;
+        try {
+            node_queue_t sorted_nodes;
+            boost::topological_sort(_expert_dag, std::front_inserter(sorted_nodes));
+            levels = _get_levels(node_list_t(sorted_nodes.begin(), sorted_nodes.end()));
+        } catch (boost::not_a_dag&) {
+        }
+
         std::string dot_str;
         dot_str += "digraph uhd_experts_" + _name + " {\n rankdir=LR;\n";
         // Iterate through the vertices and print them out
@@ -142,6 +166,10 @@ public:
                 dot_str += str(boost::format(" %d [label=\"%s\",shape=%s,xlabel=\"%s\"];\n") %
                                uint32_t(*vi.first) % vertex.get_name() %
                                DATA_SHAPE % vertex.get_dtype());
+            } else if (not levels.empty()) {
+                dot_str += str(boost::format(" %d [label=\"%s\",shape=%s,xlabel=\"level %d\"];\n") %
+                               uint32_t(*vi.first) % vertex.get_name() % WORKER_SHAPE %
+                               levels[*vi.first]);
             } else {
                 dot_str += str(boost::format(" %d [label=\"%s\",shape=%s];\n") %
                                uint32_t(*vi.first) % vertex.get_name() % WORKER_SHAPE);
@@ -295,15 +323,16 @@ protected:
             expert_graph_t::vertex_descriptor gr_node = boost::add_vertex(data_node, _expert_dag);
             EX_LOG(1, str(boost::format("added vertex %s") % data_node->get_name()));
             _datanode_map.insert(vertex_map_t::value_type(data_node->get_name(), gr_node));
+            _topology_valid = false;
 
             //Add resolve callbacks
             if (resolve_mode == AUTO_RESOLVE_ON_WRITE or resolve_mode == AUTO_RESOLVE_ON_READ_WRITE) {
                 EX_LOG(2, str(boost::format("added write callback")));
-                data_node->set_write_callback(boost::bind(&expert_container_impl::resolve_from, this, _1));
+                data_node->set_write_callback(boost::bind(&expert_container_impl::_resolve_from_vertex, this, gr_node));
             }
             if (resolve_mode == AUTO_RESOLVE_ON_READ or resolve_mode == AUTO_RESOLVE_ON_READ_WRITE) {
                 EX_LOG(2, str(boost::format("added read callback")));
-                data_node->set_read_callback(boost::bind(&expert_container_impl::resolve_to, this, _1));
+                data_node->set_read_callback(boost::bind(&expert_container_impl::_resolve_to_vertex, this, gr_node));
             }
         } catch (...) {
             clear();
@@ -334,6 +363,7 @@ protected:
             expert_graph_t::vertex_descriptor gr_node = boost::add_vertex(worker, _expert_dag);
             EX_LOG(1, str(boost::format("added vertex %s") % worker->get_name()));
             _worker_map.insert(vertex_map_t::value_type(worker->get_name(), gr_node));
+            _topology_valid = false;
 
             //For each input, add an edge from the input to this node
             for(const std::string& node_name:  worker->get_inputs()) {
@@ -396,11 +426,50 @@ protected:
         // Release all nodes in the map
         _worker_map.clear();
         _datanode_map.clear();
+        _topology_valid = false;
     }
 
 private:
-    void _resolve_helper(std::string start, std::string stop, bool force)
+    //! Resolve the nodes that depend on a vertex. Data nodes call this
+    //  directly on a write, so it does no lookup by name.
+    void _resolve_from_vertex(expert_graph_t::vertex_descriptor vertex)
+    {
+        boost::lock_guard<boost::recursive_mutex> resolve_lock(_resolve_mutex);
+        boost::lock_guard<boost::mutex> lock(_mutex);
+        EX_LOG(0, str(boost::format("resolve_from(%s)") % _get_vertex(vertex).get_name()));
+        const trace_events::scoped_span trace_span("experts",
+            [this, vertex]() { return "resolve_from " + _get_vertex(vertex).get_name(); });
+        // Only resolve the nodes that depend on the vertex
+        _update_topology();
+        _resolve_cone(_get_cone(vertex, true));
+    }
+
+    //! Resolve a vertex and the nodes it depends on. Data nodes call this
+    //  directly on a read, so it does no lookup by name.
+    void _resolve_to_vertex(expert_graph_t::vertex_descriptor vertex)
     {
+        boost::lock_guard<boost::recursive_mutex> resolve_lock(_resolve_mutex);
+        boost::lock_guard<boost::mutex> lock(_mutex);
+        EX_LOG(0, str(boost::format("resolve_to(%s)") % _get_vertex(vertex).get_name()));
+        const trace_events::scoped_span trace_span("experts",
+            [this, vertex]() { return "resolve_to " + _get_vertex(vertex).get_name(); });
+        // Only resolve the vertex and the nodes it depends on
+        _update_topology();
+        _resolve_cone(_get_cone(vertex, false));
+    }
+
+    //! Nodes to resolve for a resolve_from() or resolve_to() call
+    struct cone_t
+    {
+        node_list_t nodes;      //The nodes to resolve, in topological order
+        node_list_t boundary;   //Nodes of the cone that are also read outside of it
+    };
+
+    //! Sort the graph and compute the reverse edges, unless that's still valid
+    void _update_topology()
+    {
+        if (_topology_valid) return;
+
         //Sort the graph topologically. This ensures that for all dependencies, the dependant
         //is always after all of its dependencies.
         node_queue_t sorted_nodes;
@@ -419,54 +488,215 @@ private:
                                          "The following back-edges were found:" + edges);
             }
         }
-        if (sorted_nodes.empty()) return;
-
-        //Determine the start and stop node. If one is not explicitly specified then
-        //resolve everything
-        expert_graph_t::vertex_descriptor start_vertex = sorted_nodes.front();
-        expert_graph_t::vertex_descriptor stop_vertex = sorted_nodes.back();
-        if (not start.empty()) start_vertex = _lookup_vertex(start);
-        if (not stop.empty()) stop_vertex = _lookup_vertex(stop);
-
-        //First Pass: Resolve all nodes if they are dirty, in a topological order
-        std::list<dag_vertex_t*> resolved_workers;
-        bool start_node_encountered = false;
-        for (node_queue_t::iterator node_iter = sorted_nodes.begin();
-             node_iter != sorted_nodes.end();
-             ++node_iter
+        _sorted_nodes.assign(sorted_nodes.begin(), sorted_nodes.end());
+
+        //Order the nodes by level. That is still a topological order, and it
+        //makes the nodes of each level contiguous for the parallel resolve.
+        _levels = _get_levels(_sorted_nodes);
+        std::stable_sort(_sorted_nodes.begin(), _sorted_nodes.end(),
+            [this](expert_graph_t::vertex_descriptor a, expert_graph_t::vertex_descriptor b) {
+                return _levels[a] < _levels[b];
+            });
+
+        //The graph only stores out-edges, so keep a list of in-edges for upstream walks
+        const size_t num_vertices = boost::num_vertices(_expert_dag);
+        _in_edges.assign(num_vertices, node_list_t());
+        for (std::pair<edge_iter, edge_iter> ei = boost::edges(_expert_dag);
+             ei.first != ei.second;
+             ++ei.first
         ) {
-            //Determine if we are at or beyond the starting node
-            if (*node_iter == start_vertex) start_node_encountered = true;
-
-            //Only resolve if the starting node has passed
-            if (start_node_encountered) {
-                dag_vertex_t& node = _get_vertex(*node_iter);
-                std::string node_val;
-                if (force or node.is_dirty()) {
-                    node.resolve();
-                    if (node.get_class() == CLASS_WORKER) {
-                        resolved_workers.push_back(&node);
+            _in_edges[boost::target(*(ei.first), _expert_dag)].push_back(
+                boost::source(*(ei.first), _expert_dag));
+        }
+
+        //The cones are computed on demand
+        _downstream_cones.assign(num_vertices, cone_t());
+        _upstream_cones.assign(num_vertices, cone_t());
+        _topology_valid = true;
+    }
+
+    /*!
+     * Return the nodes to resolve for a change of (downstream) or a read of
+     * (upstream) the given vertex, in topological order.
+     *
+     * The upstream cone is the vertex and everything it depends on. The
+     * downstream cone is everything that depends on the vertex, plus the
+     * upstream cones of those nodes so that no worker reads stale inputs.
+     */
+    const cone_t& _get_cone(expert_graph_t::vertex_descriptor vertex, bool downstream)
+    {
+        cone_t& cone = downstream ? _downstream_cones[vertex] : _upstream_cones[vertex];
+        if (not cone.nodes.empty()) return cone;
+
+        std::vector<bool> in_cone(_in_edges.size(), false);
+        node_list_t pending(1, vertex);
+        in_cone[vertex] = true;
+        if (downstream) {
+            while (not pending.empty()) {
+                const expert_graph_t::vertex_descriptor v = pending.back();
+                pending.pop_back();
+                boost::graph_traits<expert_graph_t>::out_edge_iterator ei, ei_end;
+                for (boost::tie(ei, ei_end) = boost::out_edges(v, _expert_dag); ei != ei_end; ++ei) {
+                    const expert_graph_t::vertex_descriptor t = boost::target(*ei, _expert_dag);
+                    if (not in_cone[t]) {
+                        in_cone[t] = true;
+                        pending.push_back(t);
                     }
-                    EX_LOG(1, str(boost::format("resolved node %s (%s) [%s]") %
-                                    node.get_name() % (node.is_dirty()?"dirty":"clean") % node.to_string()));
-                } else {
-                    EX_LOG(1, str(boost::format("skipped node %s (%s) [%s]") %
-                                    node.get_name() % (node.is_dirty()?"dirty":"clean") % node.to_string()));
                 }
             }
+            for (size_t v = 0; v < in_cone.size(); v++) {
+                if (in_cone[v]) pending.push_back(v);
+            }
+        }
+        while (not pending.empty()) {
+            const expert_graph_t::vertex_descriptor v = pending.back();
+            pending.pop_back();
+            for (const expert_graph_t::vertex_descriptor s : _in_edges[v]) {
+                if (not in_cone[s]) {
+                    in_cone[s] = true;
+                    pending.push_back(s);
+                }
+            }
+        }
+
+        for (const expert_graph_t::vertex_descriptor v : _sorted_nodes) {
+            if (not in_cone[v]) continue;
+            cone.nodes.push_back(v);
+            boost::graph_traits<expert_graph_t>::out_edge_iterator ei, ei_end;
+            for (boost::tie(ei, ei_end) = boost::out_edges(v, _expert_dag); ei != ei_end; ++ei) {
+                if (not in_cone[boost::target(*ei, _expert_dag)]) {
+                    cone.boundary.push_back(v);
+                    break;
+                }
+            }
+        }
+        return cone;
+    }
+
+    void _resolve_cone(const cone_t& cone)
+    {
+        //Resolving the cone marks its nodes clean. If one of them is dirty and
+        //also read from outside the cone, those readers would miss the change,
+        //so resolve everything instead.
+        for (const expert_graph_t::vertex_descriptor v : cone.boundary) {
+            if (_get_vertex(v).is_dirty()) {
+                EX_LOG(1, str(boost::format("node %s is dirty and read outside the cone, resolving all") %
+                                _get_vertex(v).get_name()));
+                _resolve_helper(_sorted_nodes, false);
+                return;
+            }
+        }
+        _resolve_helper(cone.nodes, false);
+    }
+
+    //! Length of the longest path from a source node to each vertex
+    std::vector<size_t> _get_levels(const node_list_t& sorted_nodes) const
+    {
+        std::vector<size_t> levels(boost::num_vertices(_expert_dag), 0);
+        for (const expert_graph_t::vertex_descriptor v : sorted_nodes) {
+            boost::graph_traits<expert_graph_t>::out_edge_iterator ei, ei_end;
+            for (boost::tie(ei, ei_end) = boost::out_edges(v, _expert_dag); ei != ei_end; ++ei) {
+                const expert_graph_t::vertex_descriptor t = boost::target(*ei, _expert_dag);
+                levels[t] = std::max(levels[t], levels[v] + 1);
+            }
+        }
+        return levels;
+    }
 
-            //Determine if we are beyond the stop node
-            if (*node_iter == stop_vertex) break;
+    //! Resolve workers of the same level, concurrently if possible
+    void _resolve_workers(const node_list_t& workers)
+    {
+        if (workers.empty()) return;
+        //Workers that write to the same node must run in order
+        if (_resolve_threads > 1 and workers.size() > 1) {
+            std::vector<bool> written(boost::num_vertices(_expert_dag), false);
+            for (const expert_graph_t::vertex_descriptor w : workers) {
+                boost::graph_traits<expert_graph_t>::out_edge_iterator ei, ei_end;
+                for (boost::tie(ei, ei_end) = boost::out_edges(w, _expert_dag); ei != ei_end; ++ei) {
+                    const expert_graph_t::vertex_descriptor t = boost::target(*ei, _expert_dag);
+                    if (written[t]) {
+                        EX_LOG(1, "workers share an output, resolving serially");
+                        return _resolve_workers_serially(workers);
+                    }
+                    written[t] = true;
+                }
+            }
+        } else {
+            return _resolve_workers_serially(workers);
+        }
+
+        //Each thread takes the next unresolved worker until none are left
+        std::vector<std::exception_ptr> errors(workers.size());
+        std::atomic<size_t> next_worker(0);
+        auto resolve_next = [this, &workers, &errors, &next_worker]() {
+            for (size_t i = next_worker++; i < workers.size(); i = next_worker++) {
+                try {
+                    _get_vertex(workers[i]).resolve();
+                } catch (...) {
+                    errors[i] = std::current_exception();
+                }
+            }
+        };
+        std::vector<std::thread> threads;
+        const size_t num_threads = std::min(_resolve_threads, workers.size());
+        for (size_t i = 1; i < num_threads; i++) {
+            threads.emplace_back(resolve_next);
+        }
+        resolve_next();
+        for (std::thread& t : threads) {
+            t.join();
+        }
+        for (const std::exception_ptr& error : errors) {
+            if (error) std::rethrow_exception(error);
+        }
+    }
+
+    void _resolve_workers_serially(const node_list_t& workers)
+    {
+        for (const expert_graph_t::vertex_descriptor w : workers) {
+            _get_vertex(w).resolve();
+        }
+    }
+
+    void _resolve_helper(const node_list_t& sorted_nodes, bool force)
+    {
+        //First Pass: Resolve all nodes if they are dirty, in a topological order.
+        //The nodes are ordered by level, and the workers of one level are
+        //resolved together once the level's dirty state is known.
+        //The lists are members that keep their capacity, so a resolve doesn't
+        //allocate. _mutex is held, so there is only one resolve at a time.
+        std::vector<dag_vertex_t*>& resolved_workers = _resolved_workers;
+        node_list_t& level_workers = _level_workers;
+        resolved_workers.clear();
+        level_workers.clear();
+        for (size_t i = 0; i < sorted_nodes.size(); i++) {
+            const expert_graph_t::vertex_descriptor vertex = sorted_nodes[i];
+            dag_vertex_t& node = _get_vertex(vertex);
+            if (force or node.is_dirty()) {
+                if (node.get_class() == CLASS_WORKER) {
+                    level_workers.push_back(vertex);
+                    resolved_workers.push_back(&node);
+                } else {
+                    node.resolve();
+                }
+                EX_LOG(1, str(boost::format("resolving node %s (%s)") %
+                                node.get_name() % (node.is_dirty()?"dirty":"clean")));
+            } else {
+                EX_LOG(1, str(boost::format("skipped node %s (%s) [%s]") %
+                                node.get_name() % (node.is_dirty()?"dirty":"clean") % node.to_string()));
+            }
+            if (i + 1 == sorted_nodes.size() or
+                    _levels[sorted_nodes[i + 1]] != _levels[vertex]) {
+                _resolve_workers(level_workers);
+                level_workers.clear();
+            }
         }
 
         //Second Pass: Mark all the workers clean. The policy is that a worker will mark all of
         //its dependencies clean so after this step all data nodes that are not consumed by a worker
         //will remain dirty (as they should because no one has consumed their value)
-        for (std::list<dag_vertex_t*>::iterator worker = resolved_workers.begin();
-             worker != resolved_workers.end();
-             ++worker
-        ) {
-            (*worker)->mark_clean();
+        for (dag_vertex_t* worker : resolved_workers) {
+            worker->mark_clean();
         }
     }
 
@@ -513,6 +743,15 @@ private:
     vertex_map_t            _datanode_map;      //A map from vertex name to vertex descriptor for data nodes
     boost::mutex            _mutex;
     boost::recursive_mutex  _resolve_mutex;
+    size_t                  _resolve_threads;   //Max. number of workers to resolve concurrently
+    bool                    _topology_valid;    //False if the graph changed since the caches below were built
+    node_list_t             _sorted_nodes;      //All vertices in topological order, by level
+    std::vector<size_t>     _levels;            //Topological level of each vertex
+    std::vector<node_list_t> _in_edges;         //Sources of the in-edges of each vertex
+    std::vector<cone_t>     _downstream_cones;  //Cached resolve_from() node lists, per vertex
+    std::vector<cone_t>     _upstream_cones;    //Cached resolve_to() node lists, per vertex
+    std::vector<dag_vertex_t*> _resolved_workers; //Scratch lists of _resolve_helper()
+    node_list_t             _level_workers;
 };
 
 expert_container::sptr expert_container::make(const std::string& name)
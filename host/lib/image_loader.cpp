@@ -17,6 +17,7 @@
 #include <uhd/utils/log.hpp>
 
 #include <uhd/utils/static.hpp>
+#include <uhdlib/utils/load_modules.hpp>
 
 namespace fs = boost::filesystem;
 
@@ -47,6 +48,8 @@ void uhd::image_loader::register_image_loader(const std::string &device_type,
  * Actual loading
  */
 bool uhd::image_loader::load(const uhd::image_loader::image_loader_args_t &image_loader_args){
+    // Modules can register image loaders, so they must be loaded first
+    uhd::load_modules();
 
     // If "type=foo" given in args, see if we have an image loader for that
     if(image_loader_args.args.has_key("type")){
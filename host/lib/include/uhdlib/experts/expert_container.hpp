@@ -86,6 +86,24 @@ namespace uhd { namespace experts {
          */
         virtual void resolve_to(const std::string& node_name) = 0;
 
+        /*!
+         * Set the number of threads that may resolve workers concurrently.
+         *
+         * Workers at the same topological level (i.e., with the same length
+         * of the longest path from a source node) can't depend on each
+         * other, so they may run in parallel. Levels whose workers write to
+         * a common node are still resolved serially, so the results do not
+         * depend on the number of threads. If several workers throw, the
+         * exception of the first one in topological order is rethrown.
+         *
+         * Only enable this if all workers of the graph are safe to run
+         * concurrently, including any hardware access they do.
+         *
+         * \param num_threads Maximum number of workers to run at the same
+         *                    time. 1 (the default) resolves serially.
+         */
+        virtual void set_resolve_threads(const size_t num_threads) = 0;
+
         /*!
          * Return a node retriever object for this container
          */
@@ -95,7 +113,8 @@ namespace uhd { namespace experts {
          * Returns a DOT (graph description language) representation
          * of the expert graph. The output has labels for the node
          * name, node type (data or worker) and the underlying
-         * data type for each node.
+         * data type for each node. Workers are also labeled with
+         * their topological level, see set_resolve_threads().
          *
          */
         virtual std::string to_dot() const = 0;
@@ -48,6 +48,7 @@ namespace uhd { namespace experts {
          * \param name The name of the data node
          * \param init_val The initial value of the data node
          * \param mode The auto resolve mode
+         * \return A handle to bind worker accessors to the node
          *
          * Requirements for data_t
          * - Must have a default constructor
@@ -56,13 +57,15 @@ namespace uhd { namespace experts {
          * - Must have an equality operator (==)
          */
         template<typename data_t>
-        inline static void add_data_node(
+        inline static data_node_handle_t<data_t> add_data_node(
             expert_container::sptr container,
             const std::string& name,
             const data_t& init_val,
             const auto_resolve_mode_t mode = AUTO_RESOLVE_OFF
         ) {
-            container->add_data_node(new data_node_t<data_t>(name, init_val), mode);
+            data_node_t<data_t>* node_ptr = new data_node_t<data_t>(name, init_val);
+            container->add_data_node(node_ptr, mode);
+            return data_node_handle_t<data_t>(node_ptr);
         }
 
         /*!
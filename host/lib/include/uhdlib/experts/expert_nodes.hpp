@@ -19,6 +19,7 @@
 #include <boost/core/demangle.hpp>
 #include <memory>
 #include <list>
+#include <vector>
 #include <stdint.h>
 
 namespace uhd { namespace experts {
@@ -36,7 +37,8 @@ namespace uhd { namespace experts {
      */
     class dag_vertex_t : private uhd::noncopyable {
     public:
-        typedef boost::function<void(std::string)> callback_func_t;
+        //! Callbacks are bound to their node, so they take no arguments
+        typedef boost::function<void(void)> callback_func_t;
 
         virtual ~dag_vertex_t() {}
 
@@ -175,7 +177,7 @@ namespace uhd { namespace experts {
             set(value);
             _author = AUTHOR_USER;
             if (is_dirty() and has_write_callback()) {
-                _wr_callback(std::string(get_name()));  //Put the name on the stack before calling
+                _wr_callback();
             }
         }
 
@@ -183,7 +185,7 @@ namespace uhd { namespace experts {
             if (_callback_mutex == NULL) throw uhd::assertion_error("node " + get_name() + " is missing the callback mutex");
             boost::lock_guard<boost::recursive_mutex> lock(*_callback_mutex);
             if (has_read_callback()) {
-                _rd_callback(std::string(get_name()));
+                _rd_callback();
             }
             return get();
         }
@@ -221,6 +223,36 @@ namespace uhd { namespace experts {
         node_author_t           _author;
     };
 
+    /*!---------------------------------------------------------
+     * class data_node_handle_t
+     *
+     * A typed reference to a data node. Accessors that are made
+     * from a handle are bound to the node directly, without a
+     * lookup by name or a run-time type check. Handles are
+     * returned when data nodes are added, or can be looked up
+     * once by name.
+     * ---------------------------------------------------------
+     */
+    template<typename data_t>
+    class data_node_handle_t {
+    public:
+        data_node_handle_t() : _node(NULL) {}
+
+        explicit data_node_handle_t(data_node_t<data_t>* node) : _node(node) {}
+
+        inline bool is_valid() const {
+            return _node != NULL;
+        }
+
+        inline data_node_t<data_t>& node() const {
+            if (_node == NULL) throw uhd::assertion_error("data node handle is not bound");
+            return *_node;
+        }
+
+    private:
+        data_node_t<data_t>* _node;
+    };
+
     /*!---------------------------------------------------------
      * class node_retriever_t
      *
@@ -233,6 +265,18 @@ namespace uhd { namespace experts {
     public:
         virtual ~node_retriever_t() {}
         virtual const dag_vertex_t& lookup(const std::string& name) const = 0;
+
+        //! Look up a data node by name, and check its type
+        template<typename data_t>
+        data_node_handle_t<data_t> get_handle(const std::string& name) const {
+            data_node_t<data_t>* node = dynamic_cast< data_node_t<data_t>* >(&retrieve(name));
+            if (node == NULL) {
+                throw uhd::type_error("Expected data type for node " + name +
+                                      " was " + boost::core::demangle(typeid(data_t).name()) +
+                                      " but got " + lookup(name).get_dtype());
+            }
+            return data_node_handle_t<data_t>(node);
+        }
     private:
         friend class data_accessor_t;
         virtual dag_vertex_t& retrieve(const std::string& name) const = 0;
@@ -255,6 +299,8 @@ namespace uhd { namespace experts {
     protected:
         data_accessor_t(const node_retriever_t& r, const std::string& n):
             _vertex(r.retrieve(n)) {}
+        data_accessor_t(dag_vertex_t& v):
+            _vertex(v) {}
         dag_vertex_t& _vertex;
     };
 
@@ -296,6 +342,9 @@ namespace uhd { namespace experts {
             }
         }
 
+        data_accessor_base(const data_node_handle_t<data_t>& h, const node_access_t a) :
+                data_accessor_t(h.node()), _datanode(&h.node()), _access(a) {}
+
         data_node_t<data_t>*    _datanode;
         const node_access_t     _access;
 
@@ -319,6 +368,9 @@ namespace uhd { namespace experts {
             data_accessor_base<data_t>(
                 retriever, node, ACCESS_READER) {}
 
+        data_reader_t(const data_node_handle_t<data_t>& node) :
+            data_accessor_base<data_t>(node, ACCESS_READER) {}
+
         inline const data_t& get() const {
             return data_accessor_base<data_t>::_datanode->get();
         }
@@ -350,6 +402,9 @@ namespace uhd { namespace experts {
             data_accessor_base<data_t>(
                 retriever, node, ACCESS_WRITER) {}
 
+        data_writer_t(const data_node_handle_t<data_t>& node) :
+            data_accessor_base<data_t>(node, ACCESS_WRITER) {}
+
         inline const data_t& get() const {
             return data_accessor_base<data_t>::_datanode->get();
         }
@@ -421,6 +476,7 @@ namespace uhd { namespace experts {
         void bind_accessor(data_accessor_t& accessor) {
             if (accessor.is_reader()) {
                 _inputs.push_back(&accessor);
+                _input_nodes.push_back(&accessor.node());
             } else if (accessor.is_writer()) {
                 _outputs.push_back(&accessor);
             } else {
@@ -431,16 +487,15 @@ namespace uhd { namespace experts {
     private:
         // Graph resolution specific
         virtual bool is_dirty() const {
-            bool inputs_dirty = false;
-            for(data_accessor_t* acc:  _inputs) {
-                inputs_dirty |= acc->node().is_dirty();
+            for(dag_vertex_t* node:  _input_nodes) {
+                if (node->is_dirty()) return true;
             }
-            return inputs_dirty;
+            return false;
         }
 
         virtual void mark_clean() {
-            for(data_accessor_t* acc:  _inputs) {
-                acc->node().mark_clean();
+            for(dag_vertex_t* node:  _input_nodes) {
+                node->mark_clean();
             }
         }
 
@@ -464,8 +519,10 @@ namespace uhd { namespace experts {
         virtual bool has_read_callback() const { return false; }
         virtual void clear_read_callback() {}
 
-        std::list<data_accessor_t*> _inputs;
-        std::list<data_accessor_t*> _outputs;
+        std::vector<data_accessor_t*> _inputs;
+        std::vector<data_accessor_t*> _outputs;
+        //! The nodes of _inputs, checked on every resolve
+        std::vector<dag_vertex_t*>    _input_nodes;
     };
 
 }}
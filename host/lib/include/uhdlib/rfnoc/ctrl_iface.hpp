@@ -10,7 +10,9 @@
 
 #include "xports.hpp"
 #include <boost/shared_ptr.hpp>
+#include <future>
 #include <string>
+#include <vector>
 
 namespace uhd { namespace rfnoc {
 
@@ -23,6 +25,56 @@ public:
     typedef boost::shared_ptr<ctrl_iface> sptr;
     virtual ~ctrl_iface(void) {}
 
+    /*! A sequence of command packets to send with send_cmd_batch()
+     *
+     * The commands are sent in the order they were added. Readbacks return a
+     * handle to their value, which is available once send_cmd_batch() has
+     * received the matching response.
+     */
+    class cmd_batch
+    {
+    public:
+        //! Handle to the 64-bit response payload of a command in a batch
+        typedef std::shared_future<uint64_t> readback_t;
+
+        struct cmd_t
+        {
+            uint32_t addr;
+            uint32_t data;
+            uint64_t timestamp;
+            bool readback;
+            std::promise<uint64_t> result;
+        };
+
+        //! Add a command whose response payload is not needed
+        void add_cmd(
+            const uint32_t addr, const uint32_t data, const uint64_t timestamp = 0)
+        {
+            _cmds.push_back(cmd_t{addr, data, timestamp, false, {}});
+        }
+
+        //! Add a command and return a handle to its response payload
+        readback_t add_readback(
+            const uint32_t addr, const uint32_t data, const uint64_t timestamp = 0)
+        {
+            _cmds.push_back(cmd_t{addr, data, timestamp, true, {}});
+            return _cmds.back().result.get_future().share();
+        }
+
+        size_t size(void) const
+        {
+            return _cmds.size();
+        }
+
+        std::vector<cmd_t>& get_cmds(void)
+        {
+            return _cmds;
+        }
+
+    private:
+        std::vector<cmd_t> _cmds;
+    };
+
     /*! Make a new control object
      *
      * \param xports Bidirectional transport object to the RFNoC block port.
@@ -60,6 +112,22 @@ public:
             const uint64_t timestamp=0
     ) = 0;
 
+    /*! Send a batch of command packets.
+     *
+     * Unlike calling send_cmd_pkt() once per command, this does not wait for
+     * each readback before sending the next command: As many commands as the
+     * command FIFO can hold are in flight at any time, and the readback
+     * handles of \p batch are filled in as their responses arrive. Returns
+     * once all commands are acknowledged.
+     *
+     * \param batch The commands to send. It can't be sent a second time.
+     *
+     * \throws uhd::io_error if a response is malformed or missing;
+     *         uhd::runtime_error if no packet could be sent. Readback handles
+     *         that are not yet set rethrow the same exception.
+     */
+    virtual void send_cmd_batch(cmd_batch& batch) = 0;
+
     /*! Set the depth of the command FIFO size
      *
      * Note: This is not safe to call during operations. Call this during
@@ -70,6 +138,13 @@ public:
      *                  fit into the command FIFO.
      */
     virtual void set_cmd_fifo_size(const size_t num_lines) = 0;
+
+    /*! Return the number of command packets that may be in flight at once
+     *
+     * This is the number of packets that fit into the command FIFO, limited
+     * by the number of response frames of the transport.
+     */
+    virtual size_t get_cmd_fifo_size(void) const = 0;
 };
 
 }} /* namespace uhd::rfnoc */
@@ -0,0 +1,67 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_RFNOC_DRAM_BUFFER_ARGS_HPP
+#define INCLUDED_UHDLIB_RFNOC_DRAM_BUFFER_ARGS_HPP
+
+#include <uhd/exception.hpp>
+#include <uhd/types/device_addr.hpp>
+#include <uhdlib/usrp/constrained_device_args.hpp>
+#include <boost/format.hpp>
+#include <boost/lexical_cast.hpp>
+#include <stdint.h>
+
+namespace uhd { namespace rfnoc {
+
+//! Smallest depth of a DmaFIFO port in bytes
+static const uint64_t DRAM_BUFFER_MIN_SIZE = 8192;
+//! The DmaFIFO addresses the DRAM with 32 bits
+static const uint64_t DRAM_BUFFER_ADDR_SPACE = uint64_t(1) << 32;
+
+//! True if the dram_buffer stream arg is set, e.g. dram_buffer or dram_buffer=1
+inline bool use_dram_buffer(const device_addr_t& args)
+{
+    if (not args.has_key("dram_buffer")) {
+        return false;
+    }
+    usrp::constrained_device_args_t::bool_arg dram_buffer("dram_buffer", false);
+    dram_buffer.parse(args["dram_buffer"]);
+    return dram_buffer.get();
+}
+
+/*! Return the dram_buffer_size stream arg for DmaFIFO port \p port
+ *
+ * \throws uhd::value_error if the size is not a power of 2 of at least
+ *         DRAM_BUFFER_MIN_SIZE, or if the port would end past the address space
+ *         of the DmaFIFO
+ */
+inline uint32_t get_dram_buffer_size(const device_addr_t& args, const size_t port)
+{
+    uint64_t size = 0;
+    try {
+        size = boost::lexical_cast<uint64_t>(args["dram_buffer_size"]);
+    } catch (const boost::bad_lexical_cast&) {
+        // Rejected below
+    }
+    if (size < DRAM_BUFFER_MIN_SIZE or (size & (size - 1)) != 0) {
+        throw uhd::value_error(
+            str(boost::format("dram_buffer_size must be a power of 2 of at least %d "
+                              "bytes, got %s")
+                % DRAM_BUFFER_MIN_SIZE % args["dram_buffer_size"]));
+    }
+    // The depth is programmed as 32 bits, so the whole address space is too big
+    if (size >= DRAM_BUFFER_ADDR_SPACE or (port + 1) * size > DRAM_BUFFER_ADDR_SPACE) {
+        throw uhd::value_error(
+            str(boost::format("dram_buffer_size: %d bytes at port %d end past the "
+                              "%d bytes the DmaFIFO can address")
+                % size % port % DRAM_BUFFER_ADDR_SPACE));
+    }
+    return uint32_t(size);
+}
+
+}} // namespace uhd::rfnoc
+
+#endif /* INCLUDED_UHDLIB_RFNOC_DRAM_BUFFER_ARGS_HPP */
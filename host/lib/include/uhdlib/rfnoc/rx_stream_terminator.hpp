@@ -14,6 +14,7 @@
 #include <uhd/rfnoc/scalar_node_ctrl.hpp>
 #include <uhd/rfnoc/terminator_node_ctrl.hpp>
 #include <uhd/rfnoc/block_ctrl_base.hpp> // For the block macros
+#include <uhd/types/stream_cmd.hpp>
 #include <mutex>
 
 namespace uhd {
@@ -56,6 +57,26 @@ public:
 
     void handle_overrun(boost::weak_ptr<uhd::rx_streamer>, const size_t);
 
+    /*! Set how handle_overrun() restarts streaming on more than one channel
+     *
+     * By default, all channels are stopped, the transports are flushed, and
+     * streaming restarts 50 ms after the device time that is read back once
+     * the transports are empty.
+     *
+     * In fast mode, the device time is read back first, and the restart
+     * time is computed from it while the channels are stopped. The
+     * transports are not flushed, the packets in them are still received,
+     * and the ones that can't be aligned are dropped.
+     *
+     * \param fast true for fast mode
+     * \param restart_delay how long after the channels are stopped streaming
+     *                      restarts in fast mode, in seconds
+     */
+    void set_overflow_recovery(const bool fast, const double restart_delay);
+
+    //! Default restart delay of the fast overflow recovery, in seconds
+    static const double DEFAULT_FAST_RESTART_DELAY;
+
 protected:
     rx_stream_terminator();
 
@@ -71,6 +92,12 @@ private:
 
     std::mutex _overrun_handler_mutex;
 
+    //! See set_overflow_recovery()
+    bool _fast_overflow_recovery = false;
+    double _overflow_restart_delay;
+    //! The command that restarts streaming, only its time changes
+    stream_cmd_t _restart_cmd;
+
 }; /* class rx_stream_terminator */
 
 }} /* namespace uhd::rfnoc */
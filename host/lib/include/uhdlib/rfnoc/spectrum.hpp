@@ -0,0 +1,45 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_RFNOC_SPECTRUM_HPP
+#define INCLUDED_UHDLIB_RFNOC_SPECTRUM_HPP
+
+#include <uhd/utils/byteswap.hpp>
+#include <stdint.h>
+#include <algorithm>
+#include <cmath>
+
+namespace uhd { namespace rfnoc {
+
+//! Magnitude of a full scale tone at the output of the FFT block
+constexpr float SPECTRUM_FULL_SCALE = 32767.0f;
+
+/*! Convert the magnitudes of an FFT block's output packet to dBFS
+ *
+ * With magnitude_out set to MAGNITUDE, every sc16 item carries an unsigned
+ * magnitude in its I half. Empty bins are reported at the level of one LSB.
+ *
+ * \param items the payload, in sc16_item32_be or sc16_item32_le format
+ * \param num_bins the number of items in the payload
+ * \param big_endian true if the payload is sc16_item32_be
+ * \param power_db filled with num_bins values
+ */
+inline void spectrum_magnitudes_to_db(const void* items,
+    const size_t num_bins,
+    const bool big_endian,
+    float* power_db)
+{
+    const uint32_t* words = static_cast<const uint32_t*>(items);
+    for (size_t i = 0; i < num_bins; i++) {
+        const uint32_t word = big_endian ? uhd::ntohx(words[i]) : uhd::wtohx(words[i]);
+        const float mag     = float(std::max<uint32_t>(word >> 16, 1));
+        power_db[i]         = 20.0f * std::log10(mag / SPECTRUM_FULL_SCALE);
+    }
+}
+
+}} // namespace uhd::rfnoc
+
+#endif /* INCLUDED_UHDLIB_RFNOC_SPECTRUM_HPP */
@@ -40,6 +40,10 @@ public:
     void poke32(const wb_addr_type addr, const uint32_t data);
     uint32_t peek32(const wb_addr_type addr);
     uint64_t peek64(const wb_addr_type addr);
+    void multi_poke32(const std::vector<wb_addr_type> &addrs, const std::vector<uint32_t> &data);
+    std::vector<uint32_t> multi_peek32(const std::vector<wb_addr_type> &addrs);
+    void poke32_schedule(const std::vector<timed_poke32_t> &writes);
+    size_t get_cmd_fifo_size(void) { return _iface->get_cmd_fifo_size(); }
     time_spec_t get_time() { return gettime_functor(); }
     void set_time(const uhd::time_spec_t& t) { settime_functor(t); }
 
@@ -0,0 +1,86 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_TRANSPORT_BUFF_TUNING_HPP
+#define INCLUDED_UHDLIB_TRANSPORT_BUFF_TUNING_HPP
+
+#include <uhd/config.hpp>
+#include <uhd/types/direction.hpp>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <string>
+
+namespace uhd { namespace transport {
+
+//! Frame size and buffering of a data transport, see tune_xport_buffs()
+struct buff_tuning_t
+{
+    size_t frame_size;
+    size_t num_frames;
+    size_t buff_size;
+};
+
+/*! Return the largest socket buffer the kernel allows in direction \p dir
+ *
+ * \return the limit in bytes, or 0 if it is unknown on this platform
+ */
+inline size_t get_max_sock_buff_size(const uhd::direction_t dir)
+{
+#if defined(UHD_PLATFORM_LINUX)
+    std::ifstream sysctl(dir == uhd::RX_DIRECTION ? "/proc/sys/net/core/rmem_max"
+                                                  : "/proc/sys/net/core/wmem_max");
+    size_t max_size = 0;
+    if (sysctl >> max_size) {
+        return max_size;
+    }
+#else
+    (void)dir;
+#endif
+    return 0;
+}
+
+/*! Size a data transport to hold \p buff_ms worth of data
+ *
+ * Frames are as large as \p max_frame_size allows, but slow streams get
+ * smaller frames so that at least \p min_num_frames fill up within the
+ * buffering time. Both the socket buffer and the number of frames cover the
+ * whole buffering time, so transports without socket buffers are covered,
+ * too. The socket buffer is limited to \p max_buff_size.
+ *
+ * \param bytes_per_sec Data rate of the stream
+ * \param buff_ms Buffering time in milliseconds
+ * \param max_frame_size Largest frame size the path allows (MTU)
+ * \param min_num_frames Minimum number of frames
+ * \param max_buff_size Socket buffer limit, or 0 if there is none
+ */
+inline buff_tuning_t tune_xport_buffs(const double bytes_per_sec,
+    const double buff_ms,
+    const size_t max_frame_size,
+    const size_t min_num_frames,
+    const size_t max_buff_size)
+{
+    static const size_t MIN_FRAME_SIZE = 512;
+    static const size_t MAX_NUM_FRAMES = 4096;
+
+    const size_t buff_bytes = size_t(std::ceil(bytes_per_sec * buff_ms / 1000.0));
+    const size_t fill_size  = buff_bytes / std::max<size_t>(min_num_frames, 1);
+    buff_tuning_t tuning;
+    tuning.frame_size =
+        std::min(max_frame_size, std::max(MIN_FRAME_SIZE, fill_size & ~size_t(7)));
+    tuning.num_frames = std::min(MAX_NUM_FRAMES,
+        std::max(min_num_frames,
+            (buff_bytes + tuning.frame_size - 1) / tuning.frame_size));
+    tuning.buff_size = std::max(buff_bytes, tuning.num_frames * tuning.frame_size);
+    if (max_buff_size > 0) {
+        tuning.buff_size = std::min(tuning.buff_size, max_buff_size);
+    }
+    return tuning;
+}
+
+}} // namespace uhd::transport
+
+#endif /* INCLUDED_UHDLIB_TRANSPORT_BUFF_TUNING_HPP */
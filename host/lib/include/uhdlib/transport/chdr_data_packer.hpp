@@ -0,0 +1,72 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_TRANSPORT_CHDR_DATA_PACKER_HPP
+#define INCLUDED_UHDLIB_TRANSPORT_CHDR_DATA_PACKER_HPP
+
+#include <uhd/config.hpp>
+#include <uhd/utils/byteswap.hpp>
+#include <stdint.h>
+
+namespace uhd { namespace transport { namespace vrt { namespace chdr {
+
+//! The fields of a CHDR data packet header that change from packet to packet
+struct data_hdr_t
+{
+    size_t packet_count;
+    size_t num_payload_bytes;
+    bool eob;
+    uint64_t tsf;
+};
+
+//! Convert a word from host to CHDR endianness
+template <bool big_endian>
+UHD_INLINE uint32_t data_hdr_to_otw(const uint32_t word)
+{
+    return big_endian ? uhd::htonx(word) : uhd::htowx(word);
+}
+
+/*!
+ * Pack the header of a CHDR data packet of a fixed shape.
+ *
+ * chdr::if_hdr_pack_be() and chdr::if_hdr_pack_le() take every field from
+ * an if_packet_info_t and check which of them are present. A data stream
+ * knows its shape when it is created: it always has a SID, and a time stamp
+ * or not. Here, the shape and the endianness are template parameters, the
+ * constant header bits are computed at compile time and the SID is passed
+ * in already converted, so only the sequence number, length, EOB flag and
+ * time are patched in.
+ *
+ * \param packet_buff memory to write the header
+ * \param sid_otw the SID in CHDR endianness, see data_hdr_to_otw()
+ * \param hdr the fields of this packet
+ * \return the number of header words
+ */
+template <bool big_endian, bool has_tsf>
+UHD_INLINE size_t pack_data_hdr(
+    uint32_t* packet_buff, const uint32_t sid_otw, const data_hdr_t& hdr)
+{
+    static const size_t num_header_words32 = has_tsf ? 4 : 2;
+    // Packet type is data (0), the time flag is fixed
+    static const uint32_t hdr_template = has_tsf ? (1 << 29) : 0;
+
+    const uint32_t pkt_length = uint32_t(hdr.num_payload_bytes + 4 * num_header_words32);
+    const uint32_t chdr = hdr_template | (hdr.eob ? (1 << 28) : 0)
+                          | ((hdr.packet_count & 0xFFF) << 16) | (pkt_length & 0xFFFF);
+    packet_buff[0] = data_hdr_to_otw<big_endian>(chdr);
+    packet_buff[1] = sid_otw;
+    if (has_tsf) {
+        packet_buff[2] = data_hdr_to_otw<big_endian>(uint32_t(hdr.tsf >> 32));
+        packet_buff[3] = data_hdr_to_otw<big_endian>(uint32_t(hdr.tsf >> 0));
+    }
+    return num_header_words32;
+}
+
+typedef size_t (*data_hdr_packer_type)(uint32_t*, const uint32_t, const data_hdr_t&);
+
+}}}} // namespace uhd::transport::vrt::chdr
+
+#endif /* INCLUDED_UHDLIB_TRANSPORT_CHDR_DATA_PACKER_HPP */
@@ -0,0 +1,57 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_TRANSPORT_DEMUX_TURNS_HPP
+#define INCLUDED_UHDLIB_TRANSPORT_DEMUX_TURNS_HPP
+
+#include <uhdlib/utils/deadline.hpp>
+#include <algorithm>
+#include <stddef.h>
+
+namespace uhd { namespace transport {
+
+//! Longest time a thread demuxes or waits before it checks for a turn
+constexpr double DEMUX_SLICE = 0.001;
+//! Most frames a demuxer drains from the transport in one go
+constexpr size_t DEMUX_BATCH = 16;
+
+/*! Pop an element from a queue that is filled by whichever thread demuxes
+ *
+ * There is no demux thread. Each thread that waits for an element tries to
+ * demux for a slice of its timeout. If another thread is demuxing, it waits
+ * on its queue for that slice instead, and then tries again. Whoever demuxes
+ * pushes the elements of all queues, including its own.
+ *
+ * \param queue a bounded buffer with pop_with_haste() and pop_with_timed_wait()
+ * \param elem the element reference to pop to
+ * \param timeout the time to wait for an element in seconds
+ * \param try_demux demuxes for up to the time slice it is called with, and
+ *        returns false without waiting if another thread is demuxing
+ * \return false if the timeout expired before an element arrived
+ */
+template <typename queue_type, typename elem_type, typename demux_fn_type>
+bool pop_with_demux_turns(
+    queue_type& queue, elem_type& elem, const double timeout, demux_fn_type&& try_demux)
+{
+    const deadline_t deadline(timeout);
+    while (true) {
+        if (queue.pop_with_haste(elem)) {
+            return true;
+        }
+        const double remaining = deadline.remaining();
+        const double slice     = std::min(remaining, DEMUX_SLICE);
+        if (not try_demux(slice) and queue.pop_with_timed_wait(elem, slice)) {
+            return true;
+        }
+        if (remaining <= 0.0) {
+            return queue.pop_with_haste(elem);
+        }
+    }
+}
+
+}} // namespace uhd::transport
+
+#endif /* INCLUDED_UHDLIB_TRANSPORT_DEMUX_TURNS_HPP */
@@ -0,0 +1,254 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_TRANSPORT_MPSC_BOUNDED_BUFFER_HPP
+#define INCLUDED_UHDLIB_TRANSPORT_MPSC_BOUNDED_BUFFER_HPP
+
+#include <uhd/config.hpp>
+#include <uhd/exception.hpp>
+#include <uhdlib/utils/event_fd.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace uhd { namespace transport {
+
+/*!
+ * A lock-free bounded buffer for any number of producers and one consumer.
+ *
+ * Every slot carries a sequence number that tells whose turn it is (the
+ * scheme of D. Vyukov's bounded queue), so producers only contend on one
+ * compare-and-swap and the consumer gets by with loads and stores. Like
+ * spsc_bounded_buffer, a consumer that has to wait polls for a short while
+ * before it parks on a condition variable, and producers only take the mutex
+ * if it actually parked.
+ *
+ * Optionally, the buffer keeps an event_fd in step with its fill level, so
+ * the consumer can wait for it in an event loop.
+ *
+ * Pushes never wait: a full buffer drops the new element. All pop_* calls
+ * must come from the same thread.
+ */
+template <typename elem_type> class mpsc_bounded_buffer
+{
+public:
+    /*!
+     * Create a new MPSC bounded buffer
+     * \param capacity the maximum number of elements in the buffer, rounded up
+     *                 to a power of two
+     * \param with_event_fd true to maintain an event_fd, see get_event_fd()
+     */
+    mpsc_bounded_buffer(size_t capacity, const bool with_event_fd = false)
+        : _mask(_round_up_pow2(capacity) - 1)
+        , _slots(new slot[_mask + 1])
+        , _event_fd(with_event_fd ? new event_fd() : nullptr)
+    {
+        if (capacity == 0) {
+            throw uhd::value_error("mpsc_bounded_buffer: capacity must be non-zero");
+        }
+        for (size_t i = 0; i <= _mask; i++) {
+            _slots[i].seq.store(i, std::memory_order_relaxed);
+        }
+        _enqueue_pos.value.store(0, std::memory_order_relaxed);
+        _dequeue_pos     = 0;
+        _fd_debt         = 0;
+        _consumer_parked = false;
+    }
+
+    /*!
+     * Push a new element into the buffer if there is space.
+     * May be called from any thread.
+     * \param elem the element to push
+     * \return false if the buffer was full and the element was dropped
+     */
+    UHD_INLINE bool push_with_haste(const elem_type& elem)
+    {
+        size_t pos = _enqueue_pos.value.load(std::memory_order_relaxed);
+        slot* s;
+        while (true) {
+            s = &_slots[pos & _mask];
+            const size_t seq = s->seq.load(std::memory_order_acquire);
+            const std::ptrdiff_t diff = std::ptrdiff_t(seq) - std::ptrdiff_t(pos);
+            if (diff == 0) {
+                // The slot is free, claim it
+                if (_enqueue_pos.value.compare_exchange_weak(
+                        pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // The consumer hasn't freed the slot of the previous lap yet
+                return false;
+            } else {
+                pos = _enqueue_pos.value.load(std::memory_order_relaxed);
+            }
+        }
+        s->elem = elem;
+        s->seq.store(pos + 1, std::memory_order_release);
+        if (_event_fd) {
+            _event_fd->post();
+        }
+        _wake();
+        return true;
+    }
+
+    /*!
+     * Pop an element from the buffer immediately.
+     * \param elem the element reference pop to
+     * \return false when the buffer is empty
+     */
+    UHD_INLINE bool pop_with_haste(elem_type& elem)
+    {
+        slot& s = _slots[_dequeue_pos & _mask];
+        if (s.seq.load(std::memory_order_acquire) != _dequeue_pos + 1) {
+            _settle_event_fd();
+            return false;
+        }
+        elem = std::move(s.elem);
+        // Don't hold on to the element after the pop
+        s.elem = elem_type();
+        s.seq.store(_dequeue_pos + _mask + 1, std::memory_order_release);
+        _dequeue_pos++;
+        if (_event_fd) {
+            _fd_debt++;
+            _settle_event_fd();
+        }
+        return true;
+    }
+
+    /*!
+     * Pop an element from the buffer.
+     * Wait until the buffer has at least one element or timeout. With a
+     * timeout of zero, this is as cheap as pop_with_haste().
+     * \param elem the element reference pop to
+     * \param timeout the timeout in seconds
+     * \return false when the operation times out
+     */
+    UHD_INLINE bool pop_with_timed_wait(elem_type& elem, double timeout)
+    {
+        if (pop_with_haste(elem)) {
+            return true;
+        }
+        if (timeout <= 0.0) {
+            return false;
+        }
+        const auto exit_time = std::chrono::steady_clock::now()
+                               + std::chrono::microseconds(int64_t(timeout * 1e6));
+        for (size_t i = 0; i < SPIN_COUNT; i++) {
+            if (_has_data()) {
+                return pop_with_haste(elem);
+            }
+        }
+        std::unique_lock<std::mutex> lock(_mutex);
+        _consumer_parked.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const bool ready = _data_cond.wait_until(lock, exit_time, [this] {
+            return _has_data();
+        });
+        _consumer_parked.store(false, std::memory_order_relaxed);
+        lock.unlock();
+        return ready and pop_with_haste(elem);
+    }
+
+    /*!
+     * Return a file descriptor that is readable while the buffer is not
+     * empty, or -1 if the buffer was made without one or the platform
+     * doesn't support it. Don't read from or close the descriptor.
+     */
+    int get_event_fd(void) const
+    {
+        return _event_fd ? _event_fd->get_fd() : -1;
+    }
+
+    //! Return the maximum number of elements the buffer can hold
+    size_t capacity(void) const
+    {
+        return _mask + 1;
+    }
+
+private:
+    //! Number of polls before the consumer parks on the condition variable
+    static const size_t SPIN_COUNT = 1024;
+
+    //! Assumed cache line size for padding
+    static const size_t CACHE_LINE_SIZE = 64;
+
+    struct slot
+    {
+        //! Equals the position that may write the slot next, or that
+        //  position + 1 once it holds an element
+        std::atomic<size_t> seq;
+        elem_type elem;
+    };
+
+    // Explicit padding instead of alignas(), see spsc_bounded_buffer
+    struct padded_index
+    {
+        std::atomic<size_t> value;
+        char pad[CACHE_LINE_SIZE];
+    };
+
+    static size_t _round_up_pow2(size_t n)
+    {
+        size_t p = 1;
+        while (p < n) {
+            p <<= 1;
+        }
+        return p;
+    }
+
+    UHD_INLINE bool _has_data(void) const
+    {
+        return _slots[_dequeue_pos & _mask].seq.load(std::memory_order_acquire)
+               == _dequeue_pos + 1;
+    }
+
+    // The fence pairs with the one in pop_with_timed_wait(): either the
+    // consumer sees the new element in its predicate, or we see it parked.
+    UHD_INLINE void _wake(void)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (_consumer_parked.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _data_cond.notify_one();
+        }
+    }
+
+    /*! Take the count of the event_fd down for every popped element
+     *
+     * A producer posts after its element is visible, so the consumer may pop
+     * an element before its post arrived. It then owes the count, and pays
+     * on a later pop, so a spurious wakeup only lasts until the next pop.
+     */
+    UHD_INLINE void _settle_event_fd(void)
+    {
+        while (_fd_debt > 0 and _event_fd->try_wait()) {
+            _fd_debt--;
+        }
+    }
+
+    const size_t _mask;
+    std::unique_ptr<slot[]> _slots;
+    std::unique_ptr<event_fd> _event_fd;
+
+    char _pad0[CACHE_LINE_SIZE];
+    // Shared by the producers
+    padded_index _enqueue_pos;
+    // Owned by the consumer
+    size_t _dequeue_pos;
+    size_t _fd_debt;
+
+    // Slow path only
+    std::atomic<bool> _consumer_parked;
+    std::mutex _mutex;
+    std::condition_variable _data_cond;
+};
+
+}} // namespace uhd::transport
+
+#endif /* INCLUDED_UHDLIB_TRANSPORT_MPSC_BOUNDED_BUFFER_HPP */
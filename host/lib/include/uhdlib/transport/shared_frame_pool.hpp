@@ -0,0 +1,96 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_TRANSPORT_SHARED_FRAME_POOL_HPP
+#define INCLUDED_UHDLIB_TRANSPORT_SHARED_FRAME_POOL_HPP
+
+#include <uhd/transport/buffer_pool.hpp>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace uhd { namespace transport {
+
+/*! A pool of frames that several transports draw from
+ *
+ * Transports that own their buffers allocate num_recv_frames and
+ * num_send_frames frames each, most of which sit idle unless the application
+ * falls behind. Transports that share a pool instead take a frame when they
+ * hand out a buffer and give it back when the buffer is released, so the
+ * memory follows the number of frames that are actually in use. Each
+ * transport still hands out at most its number of frames, which is the per
+ * stream limit.
+ *
+ * The pool grows in chunks of CHUNK_FRAMES as needed, up to its maximum
+ * number of frames, and keeps what it allocated until it is destroyed.
+ * acquire() and release() may be called from any thread.
+ */
+class shared_frame_pool
+{
+public:
+    typedef std::shared_ptr<shared_frame_pool> sptr;
+
+    //! Number of frames allocated at once when the pool runs empty
+    static constexpr size_t CHUNK_FRAMES = 64;
+
+    /*!
+     * \param frame_size the size of each frame in bytes
+     * \param max_frames the most frames the pool allocates (0: no limit)
+     * \param mem_params where and how to allocate the frames
+     */
+    shared_frame_pool(const size_t frame_size,
+        const size_t max_frames,
+        const buffer_pool::mem_params_t& mem_params = buffer_pool::mem_params_t());
+
+    /*!
+     * Get the process-wide pool for frames of \p frame_size bytes
+     *
+     * The pool is created by the first caller, with its memory parameters,
+     * and lives as long as anybody holds it. Later callers can raise its
+     * maximum number of frames, but not lower it.
+     */
+    static sptr get(const size_t frame_size,
+        const size_t max_frames,
+        const buffer_pool::mem_params_t& mem_params = buffer_pool::mem_params_t());
+
+    /*!
+     * Take a frame, and allocate more frames if none are free
+     * \param timeout the time to wait for a frame if the pool is at its maximum
+     * \return the frame, or nullptr on timeout
+     */
+    void* acquire(const double timeout);
+
+    //! Give back a frame that was taken with acquire()
+    void release(void* frame);
+
+    size_t get_frame_size(void) const
+    {
+        return _frame_size;
+    }
+
+    //! The number of frames the pool allocated so far
+    size_t get_num_allocated(void) const;
+
+    //! The number of frames that are allocated but not taken
+    size_t get_num_free(void) const;
+
+private:
+    void raise_max_frames(const size_t max_frames);
+
+    const size_t _frame_size;
+    const buffer_pool::mem_params_t _mem_params;
+    mutable std::mutex _mutex;
+    std::condition_variable _frame_released;
+    size_t _max_frames;
+    size_t _num_allocated;
+    std::vector<buffer_pool::sptr> _chunks;
+    std::vector<void*> _free;
+};
+
+}} // namespace uhd::transport
+
+#endif /* INCLUDED_UHDLIB_TRANSPORT_SHARED_FRAME_POOL_HPP */
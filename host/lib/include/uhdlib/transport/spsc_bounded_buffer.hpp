@@ -0,0 +1,309 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_TRANSPORT_SPSC_BOUNDED_BUFFER_HPP
+#define INCLUDED_UHDLIB_TRANSPORT_SPSC_BOUNDED_BUFFER_HPP
+
+#include <uhd/config.hpp>
+#include <uhd/exception.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+namespace uhd { namespace transport {
+
+/*!
+ * A lock-free bounded buffer for exactly one producer and one consumer.
+ *
+ * It has the same push/pop interface as uhd::transport::bounded_buffer, but
+ * the fast path only consists of atomic loads and stores on the head and tail
+ * counters. A side that has to wait first polls for a short while, and only
+ * parks on a condition variable if the other side did not make progress in
+ * the meantime. The other side only takes the mutex to wake it up if it
+ * actually parked.
+ *
+ * All push_* calls must come from the same thread, and all pop_* calls must
+ * come from the same thread. Use bounded_buffer for anything else.
+ */
+template <typename elem_type> class spsc_bounded_buffer
+{
+public:
+    /*!
+     * Create a new SPSC bounded buffer
+     * \param capacity the maximum number of elements in the buffer
+     */
+    spsc_bounded_buffer(size_t capacity)
+        : _capacity(capacity), _mask(_round_up_pow2(capacity) - 1), _slots(_mask + 1)
+    {
+        if (capacity == 0) {
+            throw uhd::value_error("spsc_bounded_buffer: capacity must be non-zero");
+        }
+        _head.value      = 0;
+        _head.cached     = 0;
+        _tail.value      = 0;
+        _tail.cached     = 0;
+        _consumer_parked = false;
+        _producer_parked = false;
+    }
+
+    /*!
+     * Push a new element into the buffer if there is space.
+     * \param elem the element to push
+     * \return true if the element fit without popping for space
+     */
+    UHD_INLINE bool push_with_haste(const elem_type& elem)
+    {
+        if (not _has_space()) {
+            return false;
+        }
+        _push(elem);
+        return true;
+    }
+
+    /*!
+     * Push a new element into the buffer.
+     * Wait until the buffer has space.
+     * \param elem the element to push
+     */
+    UHD_INLINE void push_with_wait(const elem_type& elem)
+    {
+        if (not _has_space()) {
+            _wait(_producer_parked, _space_cond, [this] { return _has_space(); });
+        }
+        _push(elem);
+    }
+
+    /*!
+     * Push a new element into the buffer.
+     * Wait until there is space or timeout.
+     * \param elem the element to push
+     * \param timeout the timeout in seconds
+     * \return false when the operation times out
+     */
+    UHD_INLINE bool push_with_timed_wait(const elem_type& elem, double timeout)
+    {
+        if (not _has_space()
+            and not _timed_wait(_producer_parked, _space_cond, timeout, [this] {
+                    return _has_space();
+                })) {
+            return false;
+        }
+        _push(elem);
+        return true;
+    }
+
+    /*!
+     * Pop an element from the buffer immediately.
+     * \param elem the element reference pop to
+     * \return false when the buffer is empty
+     */
+    UHD_INLINE bool pop_with_haste(elem_type& elem)
+    {
+        if (not _has_data()) {
+            return false;
+        }
+        _pop(elem);
+        return true;
+    }
+
+    /*!
+     * Pop an element from the buffer.
+     * Wait until the buffer has at least one element.
+     * \param elem the element reference pop to
+     */
+    UHD_INLINE void pop_with_wait(elem_type& elem)
+    {
+        if (not _has_data()) {
+            _wait(_consumer_parked, _data_cond, [this] { return _has_data(); });
+        }
+        _pop(elem);
+    }
+
+    /*!
+     * Pop an element from the buffer.
+     * Wait until the buffer has at least one element or timeout.
+     * \param elem the element reference pop to
+     * \param timeout the timeout in seconds
+     * \return false when the operation times out
+     */
+    UHD_INLINE bool pop_with_timed_wait(elem_type& elem, double timeout)
+    {
+        if (not _has_data()
+            and not _timed_wait(_consumer_parked, _data_cond, timeout, [this] {
+                    return _has_data();
+                })) {
+            return false;
+        }
+        _pop(elem);
+        return true;
+    }
+
+    //! Check if the buffer is empty. Only call this from the consumer.
+    UHD_INLINE bool empty(void)
+    {
+        return not _has_data();
+    }
+
+    //! Return the maximum number of elements the buffer can hold
+    size_t capacity(void) const
+    {
+        return _capacity;
+    }
+
+private:
+    //! Number of polls before a waiting side parks on the condition variable
+    static const size_t SPIN_COUNT = 1024;
+
+    //! Assumed cache line size for padding
+    static const size_t CACHE_LINE_SIZE = 64;
+
+    //! Keep an index and its cached counterpart off the other side's cache line.
+    // Explicit padding instead of alignas(), because C++14 operator new does
+    // not honour extended alignment.
+    struct padded_index
+    {
+        std::atomic<size_t> value;
+        size_t cached;
+        char pad[CACHE_LINE_SIZE];
+    };
+
+    static size_t _round_up_pow2(size_t n)
+    {
+        size_t p = 1;
+        while (p < n) {
+            p <<= 1;
+        }
+        return p;
+    }
+
+    // Producer side: only the cached head may be stale, which can only make
+    // the buffer look more full than it is.
+    UHD_INLINE bool _has_space(void)
+    {
+        const size_t tail = _tail.value.load(std::memory_order_relaxed);
+        if (tail - _tail.cached < _capacity) {
+            return true;
+        }
+        _tail.cached = _head.value.load(std::memory_order_acquire);
+        return tail - _tail.cached < _capacity;
+    }
+
+    // Consumer side: only the cached tail may be stale, which can only make
+    // the buffer look more empty than it is.
+    UHD_INLINE bool _has_data(void)
+    {
+        const size_t head = _head.value.load(std::memory_order_relaxed);
+        if (head != _head.cached) {
+            return true;
+        }
+        _head.cached = _tail.value.load(std::memory_order_acquire);
+        return head != _head.cached;
+    }
+
+    UHD_INLINE void _push(const elem_type& elem)
+    {
+        const size_t tail    = _tail.value.load(std::memory_order_relaxed);
+        _slots[tail & _mask] = elem;
+        _tail.value.store(tail + 1, std::memory_order_release);
+        _wake(_consumer_parked, _data_cond);
+    }
+
+    UHD_INLINE void _pop(elem_type& elem)
+    {
+        const size_t head = _head.value.load(std::memory_order_relaxed);
+        elem              = std::move(_slots[head & _mask]);
+        // Don't hold on to the element (e.g. a buffer sptr) after the pop
+        _slots[head & _mask] = elem_type();
+        _head.value.store(head + 1, std::memory_order_release);
+        _wake(_producer_parked, _space_cond);
+    }
+
+    // The fence pairs with the one in _park(): either the parked side sees
+    // the index update in its predicate, or we see its parked flag.
+    UHD_INLINE void _wake(std::atomic<bool>& parked, std::condition_variable& cond)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (parked.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            cond.notify_one();
+        }
+    }
+
+    template <typename predicate_type>
+    static bool _spin(predicate_type pred)
+    {
+        for (size_t i = 0; i < SPIN_COUNT; i++) {
+            if (pred()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template <typename predicate_type>
+    void _wait(std::atomic<bool>& parked,
+        std::condition_variable& cond,
+        predicate_type pred)
+    {
+        if (_spin(pred)) {
+            return;
+        }
+        std::unique_lock<std::mutex> lock(_mutex);
+        _park(parked);
+        cond.wait(lock, pred);
+        parked.store(false, std::memory_order_relaxed);
+    }
+
+    template <typename predicate_type>
+    bool _timed_wait(std::atomic<bool>& parked,
+        std::condition_variable& cond,
+        const double timeout,
+        predicate_type pred)
+    {
+        const auto exit_time = std::chrono::steady_clock::now()
+                               + std::chrono::microseconds(int64_t(timeout * 1e6));
+        if (_spin(pred)) {
+            return true;
+        }
+        if (timeout <= 0.0) {
+            return false;
+        }
+        std::unique_lock<std::mutex> lock(_mutex);
+        _park(parked);
+        const bool ready = cond.wait_until(lock, exit_time, pred);
+        parked.store(false, std::memory_order_relaxed);
+        return ready;
+    }
+
+    static UHD_INLINE void _park(std::atomic<bool>& parked)
+    {
+        parked.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    const size_t _capacity;
+    const size_t _mask;
+    std::vector<elem_type> _slots;
+
+    char _pad0[CACHE_LINE_SIZE];
+    // Owned by the consumer, cached holds its last view of _tail.value
+    padded_index _head;
+    // Owned by the producer, cached holds its last view of _head.value
+    padded_index _tail;
+
+    // Slow path only
+    std::atomic<bool> _consumer_parked;
+    std::atomic<bool> _producer_parked;
+    std::mutex _mutex;
+    std::condition_variable _data_cond;
+    std::condition_variable _space_cond;
+};
+
+}} // namespace uhd::transport
+
+#endif /* INCLUDED_UHDLIB_TRANSPORT_SPSC_BOUNDED_BUFFER_HPP */
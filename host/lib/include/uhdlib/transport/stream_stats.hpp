@@ -0,0 +1,191 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_TRANSPORT_STREAM_STATS_HPP
+#define INCLUDED_UHDLIB_TRANSPORT_STREAM_STATS_HPP
+
+#include <uhd/config.hpp>
+#include <uhd/convert.hpp>
+#include <uhd/stream.hpp>
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+namespace uhd { namespace transport {
+
+/*! Counters behind uhd::stream_stats_t
+ *
+ * The streamer thread updates the counters, any other thread may read them
+ * with get(). Because recv() and send() are not thread-safe, every counter
+ * except the ones updated by recv_async_msg() has a single writer. Those are
+ * updated with a relaxed load and store instead of a locked read-modify-write,
+ * which costs about as much as incrementing a plain integer.
+ */
+class stream_stats_counters
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    //! Add \p n to a counter that only the streamer thread writes to
+    static UHD_INLINE void add(std::atomic<uint64_t>& counter, const uint64_t n = 1)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + n,
+            std::memory_order_relaxed);
+    }
+
+    //! Add \p n to a counter that several threads may write to
+    static UHD_INLINE void add_shared(
+        std::atomic<uint64_t>& counter, const uint64_t n = 1)
+    {
+        counter.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    //! Raise a counter that only the streamer thread writes to to at least \p n
+    static UHD_INLINE void update_max(std::atomic<uint64_t>& counter, const uint64_t n)
+    {
+        if (n > counter.load(std::memory_order_relaxed)) {
+            counter.store(n, std::memory_order_relaxed);
+        }
+    }
+
+    //! Return the nanoseconds that passed since \p start
+    static UHD_INLINE uint64_t ns_since(const clock::time_point& start)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            clock::now() - start)
+            .count();
+    }
+
+    /*! Times a recv() or send() call
+     *
+     * Create one at the start of the call. On destruction, it counts the call
+     * and adds its duration to the latency histogram.
+     */
+    class call_timer
+    {
+    public:
+        call_timer(stream_stats_counters& stats) : _stats(stats), _start(clock::now())
+        {
+        }
+
+        ~call_timer()
+        {
+            add(_stats.num_calls);
+            add(_stats.latency_hist[_get_bin(ns_since(_start) / 1000)]);
+        }
+
+    private:
+        stream_stats_counters& _stats;
+        const clock::time_point _start;
+    };
+
+    //! Counters behind uhd::signal_stats_t
+    struct signal_counters
+    {
+        std::atomic<uint64_t> num_samps{0};
+        std::atomic<double> sum_i{0.0};
+        std::atomic<double> sum_q{0.0};
+        std::atomic<double> sum_sq{0.0};
+        std::atomic<double> peak{0.0};
+        std::atomic<double> max_peak{0.0};
+    };
+
+    //! Keep signal statistics for \p num_chans channels. Call this before
+    //  streaming, get() doesn't expect the channels to change.
+    void enable_signal_stats(const size_t num_chans)
+    {
+        signal = std::vector<signal_counters>(num_chans);
+    }
+
+    //! Store the running sums of channel \p chan, and the peak of its last packet
+    void store_signal(const size_t chan, const uhd::convert::signal_accum_t& accum)
+    {
+        signal_counters& counters = signal[chan];
+        counters.num_samps.store(accum.num_samps, std::memory_order_relaxed);
+        counters.sum_i.store(accum.sum_i, std::memory_order_relaxed);
+        counters.sum_q.store(accum.sum_q, std::memory_order_relaxed);
+        counters.sum_sq.store(accum.sum_sq, std::memory_order_relaxed);
+        counters.peak.store(accum.peak, std::memory_order_relaxed);
+        if (accum.peak > counters.max_peak.load(std::memory_order_relaxed)) {
+            counters.max_peak.store(accum.peak, std::memory_order_relaxed);
+        }
+    }
+
+    //! Return a snapshot of all counters
+    uhd::stream_stats_t get(void) const
+    {
+        uhd::stream_stats_t stats;
+        stats.num_calls            = num_calls.load(std::memory_order_relaxed);
+        stats.num_packets          = num_packets.load(std::memory_order_relaxed);
+        stats.num_bytes            = num_bytes.load(std::memory_order_relaxed);
+        stats.num_samps            = num_samps.load(std::memory_order_relaxed);
+        stats.seq_errors           = seq_errors.load(std::memory_order_relaxed);
+        stats.overflows            = overflows.load(std::memory_order_relaxed);
+        stats.overflow_recovery_ns = overflow_recovery_ns.load(std::memory_order_relaxed);
+        stats.max_overflow_recovery_ns =
+            max_overflow_recovery_ns.load(std::memory_order_relaxed);
+        stats.align_drops          = align_drops.load(std::memory_order_relaxed);
+        stats.align_trimmed_samps  = align_trimmed_samps.load(std::memory_order_relaxed);
+        stats.max_align_skew_ticks = max_align_skew_ticks.load(std::memory_order_relaxed);
+        stats.underflows           = underflows.load(std::memory_order_relaxed);
+        stats.late_packets         = late_packets.load(std::memory_order_relaxed);
+        stats.timeouts             = timeouts.load(std::memory_order_relaxed);
+        stats.blocked_ns           = blocked_ns.load(std::memory_order_relaxed);
+        stats.convert_ns           = convert_ns.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < NUM_LATENCY_BINS; i++) {
+            stats.latency_hist[i] = latency_hist[i].load(std::memory_order_relaxed);
+        }
+        stats.signal_stats.resize(signal.size());
+        for (size_t i = 0; i < signal.size(); i++) {
+            uhd::signal_stats_t& chan = stats.signal_stats[i];
+            chan.num_samps = signal[i].num_samps.load(std::memory_order_relaxed);
+            chan.sum_i     = signal[i].sum_i.load(std::memory_order_relaxed);
+            chan.sum_q     = signal[i].sum_q.load(std::memory_order_relaxed);
+            chan.sum_sq    = signal[i].sum_sq.load(std::memory_order_relaxed);
+            chan.peak      = signal[i].peak.load(std::memory_order_relaxed);
+            chan.max_peak  = signal[i].max_peak.load(std::memory_order_relaxed);
+        }
+        return stats;
+    }
+
+    static const size_t NUM_LATENCY_BINS = uhd::stream_stats_t::NUM_LATENCY_BINS;
+
+    std::atomic<uint64_t> num_calls{0};
+    std::atomic<uint64_t> num_packets{0};
+    std::atomic<uint64_t> num_bytes{0};
+    std::atomic<uint64_t> num_samps{0};
+    std::atomic<uint64_t> seq_errors{0};
+    std::atomic<uint64_t> overflows{0};
+    std::atomic<uint64_t> overflow_recovery_ns{0};
+    std::atomic<uint64_t> max_overflow_recovery_ns{0};
+    std::atomic<uint64_t> align_drops{0};
+    std::atomic<uint64_t> align_trimmed_samps{0};
+    std::atomic<uint64_t> max_align_skew_ticks{0};
+    std::atomic<uint64_t> underflows{0};
+    std::atomic<uint64_t> late_packets{0};
+    std::atomic<uint64_t> timeouts{0};
+    std::atomic<uint64_t> blocked_ns{0};
+    std::atomic<uint64_t> convert_ns{0};
+    std::atomic<uint64_t> latency_hist[NUM_LATENCY_BINS] = {};
+    //! Per channel, empty unless enable_signal_stats() was called
+    std::vector<signal_counters> signal;
+
+private:
+    //! Bin 0 is < 1 us, bin i is [2^(i-1), 2^i) us, the last one is open
+    static UHD_INLINE size_t _get_bin(uint64_t us)
+    {
+        size_t bin = 0;
+        while (us and bin < NUM_LATENCY_BINS - 1) {
+            us >>= 1;
+            bin++;
+        }
+        return bin;
+    }
+};
+
+}} // namespace uhd::transport
+
+#endif /* INCLUDED_UHDLIB_TRANSPORT_STREAM_STATS_HPP */
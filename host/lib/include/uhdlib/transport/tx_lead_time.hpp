@@ -0,0 +1,228 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_TRANSPORT_TX_LEAD_TIME_HPP
+#define INCLUDED_UHDLIB_TRANSPORT_TX_LEAD_TIME_HPP
+
+#include <uhd/stream.hpp>
+#include <uhd/types/metadata.hpp>
+#include <uhd/types/time_spec.hpp>
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
+
+namespace uhd { namespace transport {
+
+/*! Learns the smallest lead time that timed TX bursts need
+ *
+ * The lead time of a burst is how far its time spec is ahead of the device
+ * time when its first packet is handed to the transport, i.e. after waiting
+ * for flow control credits. The device time is estimated from the host clock:
+ * every async message carries the device time of its event, and it can only
+ * arrive after that event. The smallest difference between the host time of
+ * arrival and the device time of the event, over the last two windows of
+ * WINDOW seconds, is used as the offset between the clocks. This
+ * underestimates the device time by the shortest return path latency, so lead
+ * times are overestimated by the same amount. Since the recommended lead time is
+ * applied with the same estimate, that bias cancels.
+ *
+ * The recommended lead time adapts to the async messages:
+ * - A late burst (EVENT_CODE_TIME_ERROR) needed more than its lead time. Its
+ *   message tells when the burst reached the radio, which gives the latency
+ *   from send() to the radio. The recommendation rises to that latency plus
+ *   a margin, if it isn't above it already.
+ * - An acknowledged burst (EVENT_CODE_BURST_ACK) shows that its lead time was
+ *   enough, so the recommendation drops to it if it was smaller.
+ * - After PROBE_ACKS acknowledged bursts in a row that used at most the
+ *   recommendation, the recommendation is lowered by PROBE_STEP to find out if
+ *   less would do. If it wouldn't, one burst ends up late and the
+ *   recommendation goes back up.
+ *
+ * Messages are attributed to the last burst that started before them, like
+ * recv_burst_status() does. All methods are thread-safe.
+ */
+class tx_lead_time_ctrl
+{
+public:
+    using sptr  = std::shared_ptr<tx_lead_time_ctrl>;
+    using clock = std::chrono::steady_clock;
+
+    //! Seconds over which the smallest clock offset is taken
+    static constexpr double WINDOW = 1.0;
+    //! Acknowledged bursts in a row before a lower lead time is tried
+    static constexpr size_t PROBE_ACKS = 100;
+    //! Fraction by which the lead time is lowered to try it
+    static constexpr double PROBE_STEP = 0.05;
+    //! Most bursts that are waiting for a message
+    static constexpr size_t MAX_BURSTS = 1024;
+
+    /*!
+     * \param init_lead the lead time to recommend until bursts were measured
+     * \param min_lead the smallest lead time to ever recommend
+     * \param margin the fraction that is added to a measured latency
+     */
+    tx_lead_time_ctrl(const double init_lead, const double min_lead, const double margin)
+        : _min_lead(min_lead), _margin(margin), _lead(std::max(init_lead, min_lead))
+    {
+    }
+
+    //! Record that the first packet of a burst starting at \p time_spec was sent
+    void on_burst_start(
+        const uhd::time_spec_t& time_spec, const clock::time_point now = clock::now())
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        burst_t burst;
+        burst.time_spec = time_spec.get_real_secs();
+        burst.lead = _has_offset ? burst.time_spec - _device_time(now) : NO_LEAD;
+        if (not _bursts.empty() and burst.time_spec < _bursts.back().time_spec) {
+            // The device time went back, the old bursts are meaningless
+            _bursts.clear();
+        }
+        if (_bursts.size() == MAX_BURSTS) {
+            _bursts.pop_front();
+        }
+        _bursts.push_back(burst);
+    }
+
+    //! Learn from an async message of the streamer
+    void on_async_msg(const uhd::async_metadata_t& async_metadata,
+        const clock::time_point now = clock::now())
+    {
+        if (not async_metadata.has_time_spec) {
+            return;
+        }
+        const double event_time = async_metadata.time_spec.get_real_secs();
+        std::lock_guard<std::mutex> lock(_mutex);
+        _update_offset(_host_time(now) - event_time, now);
+
+        // Find the last burst that started before the event, the earlier ones
+        // are done
+        auto next = std::upper_bound(_bursts.begin(),
+            _bursts.end(),
+            event_time,
+            [](const double time, const burst_t& burst) {
+                return time < burst.time_spec;
+            });
+        if (next == _bursts.begin()) {
+            // No burst started before it, e.g. another channel's message about
+            // a late burst that was counted already
+            return;
+        }
+        next--;
+        const burst_t burst = *next;
+        _bursts.erase(_bursts.begin(), next);
+        if (burst.lead == NO_LEAD) {
+            return;
+        }
+
+        switch (async_metadata.event_code) {
+            case uhd::async_metadata_t::EVENT_CODE_TIME_ERROR: {
+                _num_late++;
+                _num_acks_in_row = 0;
+                // The burst reached the radio at the time of the event
+                const double latency = burst.lead + event_time - burst.time_spec;
+                _lead = std::max(_lead, latency * (1.0 + _margin));
+                // Only count a late burst once, even with several channels
+                _bursts.pop_front();
+                break;
+            }
+            case uhd::async_metadata_t::EVENT_CODE_BURST_ACK:
+                if (burst.lead < _lead) {
+                    _lead = std::max(burst.lead, _min_lead);
+                }
+                if (burst.lead <= _lead * (1.0 + PROBE_STEP)
+                    and ++_num_acks_in_row >= PROBE_ACKS) {
+                    _lead            = std::max(_lead * (1.0 - PROBE_STEP), _min_lead);
+                    _num_acks_in_row = 0;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    //! Return the earliest time spec to use for a burst that starts \p now
+    uhd::time_spec_t get_earliest_time_spec(const clock::time_point now = clock::now())
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return uhd::time_spec_t(_has_offset ? _device_time(now) + _lead : 0.0);
+    }
+
+    //! Count a burst whose time spec was moved to get_earliest_time_spec()
+    void count_adjusted(void)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _num_adjusted++;
+    }
+
+    //! Return the state for tx_streamer::get_lead_time()
+    uhd::tx_streamer::lead_time_t get(const clock::time_point now = clock::now())
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        uhd::tx_streamer::lead_time_t lead_time;
+        lead_time.valid         = _has_offset;
+        lead_time.min_lead_time = _lead;
+        lead_time.time_now = uhd::time_spec_t(_has_offset ? _device_time(now) : 0.0);
+        lead_time.num_late     = _num_late;
+        lead_time.num_adjusted = _num_adjusted;
+        return lead_time;
+    }
+
+private:
+    static constexpr double NO_LEAD = std::numeric_limits<double>::lowest();
+
+    struct burst_t
+    {
+        double time_spec;
+        //! The estimated lead time when it was sent, or NO_LEAD
+        double lead;
+    };
+
+    double _host_time(const clock::time_point now) const
+    {
+        return std::chrono::duration<double>(now - _epoch).count();
+    }
+
+    double _device_time(const clock::time_point now) const
+    {
+        return _host_time(now) - std::min(_offset, _prev_offset);
+    }
+
+    void _update_offset(const double offset, const clock::time_point now)
+    {
+        if (not _has_offset or _host_time(now) - _window_start > WINDOW) {
+            // Keep the last window, in case the new one has no good sample yet
+            _prev_offset  = _has_offset ? _offset : offset;
+            _offset       = offset;
+            _window_start = _host_time(now);
+            _has_offset   = true;
+        } else {
+            _offset = std::min(_offset, offset);
+        }
+    }
+
+    std::mutex _mutex;
+    const clock::time_point _epoch = clock::now();
+    const double _min_lead;
+    const double _margin;
+    double _lead;
+    //! Host time minus device time, over the current and the last window
+    bool _has_offset    = false;
+    double _offset      = 0.0;
+    double _prev_offset = 0.0;
+    double _window_start = 0.0;
+    std::deque<burst_t> _bursts;
+    size_t _num_acks_in_row = 0;
+    uint64_t _num_late      = 0;
+    uint64_t _num_adjusted  = 0;
+};
+
+}} // namespace uhd::transport
+
+#endif /* INCLUDED_UHDLIB_TRANSPORT_TX_LEAD_TIME_HPP */
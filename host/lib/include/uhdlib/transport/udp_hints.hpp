@@ -0,0 +1,67 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_TRANSPORT_UDP_HINTS_HPP
+#define INCLUDED_UHDLIB_TRANSPORT_UDP_HINTS_HPP
+
+#include <uhd/types/device_addr.hpp>
+#include <initializer_list>
+
+namespace uhd { namespace transport {
+
+/*! Make the hints for a udp_zero_copy transport of a device
+ *
+ * The device args hold the transport options of all transports, e.g.
+ * recv_batch_size or shared_frames, while the transport args of a stream
+ * only hold the keys the device filtered for it. Both go to the transport,
+ * the transport args win.
+ *
+ * The frame sizes and counts and the socket buffer sizes are left out. The
+ * device has already resolved them into the default_buff_args for the type of
+ * the transport, e.g. limited by the MTU, and the control transports must not
+ * take the values that are meant for streaming.
+ *
+ * Send batching is only kept for TX data transports. Everywhere else, a
+ * packet that waits for its batch delays a command or a flow control update
+ * that the device waits for.
+ *
+ * \param dev_args the args the device was made with
+ * \param xport_args the args of this transport
+ * \param is_tx_data true if the transport streams TX data
+ */
+inline device_addr_t get_udp_xport_hints(const device_addr_t& dev_args,
+    const device_addr_t& xport_args,
+    const bool is_tx_data)
+{
+    static const char* const BUFF_KEYS[] = {"recv_frame_size",
+        "num_recv_frames",
+        "send_frame_size",
+        "num_send_frames",
+        "recv_buff_size",
+        "send_buff_size"};
+
+    device_addr_t hints = dev_args;
+    for (const std::string& key : xport_args.keys()) {
+        hints[key] = xport_args[key];
+    }
+    for (const char* key : BUFF_KEYS) {
+        if (hints.has_key(key)) {
+            hints.pop(key);
+        }
+    }
+    if (not is_tx_data) {
+        for (const char* key : {"send_batch_size", "send_batch_timeout"}) {
+            if (hints.has_key(key)) {
+                hints.pop(key);
+            }
+        }
+    }
+    return hints;
+}
+
+}} // namespace uhd::transport
+
+#endif /* INCLUDED_UHDLIB_TRANSPORT_UDP_HINTS_HPP */
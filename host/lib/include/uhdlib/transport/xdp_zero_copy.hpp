@@ -0,0 +1,66 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_TRANSPORT_XDP_ZERO_COPY_HPP
+#define INCLUDED_UHDLIB_TRANSPORT_XDP_ZERO_COPY_HPP
+
+#include <uhd/transport/zero_copy.hpp>
+#include <uhd/types/device_addr.hpp>
+#include <boost/shared_ptr.hpp>
+#include <string>
+
+namespace uhd { namespace transport {
+
+/*!
+ * A zero copy UDP transport on top of a Linux AF_XDP socket.
+ *
+ * Frames of the AF_XDP UMEM are handed out directly as managed receive and
+ * send buffers, so no copy between kernel and user space happens. Unlike the
+ * DPDK transport, the NIC stays under control of the kernel: only the
+ * traffic that arrives on the selected NIC queue bypasses the kernel network
+ * stack, and address resolution is done by looking up the kernel's neighbour
+ * table.
+ *
+ * The following hints are understood:
+ * - xdp_if: Name of the network interface (default: interface with a route
+ *   to the remote address)
+ * - xdp_queue: NIC queue to attach to (default: 0)
+ * - xdp_zerocopy: If set, require zero-copy mode from the driver instead of
+ *   letting the kernel fall back to copy mode
+ * - xdp_skb_mode: If set, use the generic (SKB) XDP mode
+ */
+class xdp_zero_copy : public virtual zero_copy_if
+{
+public:
+    typedef boost::shared_ptr<xdp_zero_copy> sptr;
+
+    /*!
+     * Make a new AF_XDP transport.
+     *
+     * \param addr IPv4 address of the remote endpoint
+     * \param remote_port UDP port of the remote endpoint
+     * \param default_buff_args Default values for frame sizes and num frames
+     * \param hints Transport hints (see class description)
+     * \throws uhd::runtime_error if the socket can't be created
+     */
+    static sptr make(const std::string& addr,
+        const std::string& remote_port,
+        const zero_copy_xport_params& default_buff_args,
+        const device_addr_t& hints);
+
+    //! Return the local UDP port in host byte order
+    virtual uint16_t get_local_port(void) const = 0;
+
+    //! Return the local IPv4 address as a dotted string
+    virtual std::string get_local_addr(void) const = 0;
+
+    //! Return the number of received frames that were not meant for us
+    virtual uint32_t get_drop_count(void) const = 0;
+};
+
+}} // namespace uhd::transport
+
+#endif /* INCLUDED_UHDLIB_TRANSPORT_XDP_ZERO_COPY_HPP */
@@ -117,6 +117,19 @@ public:
     //! tune the given frontend, return the exact value
     virtual double tune(const std::string &which, const double value) = 0;
 
+    /*! Record fast-lock profiles for the given frontend
+     *
+     * Tunes to each frequency and stores the synthesizer state. Later tunes
+     * to one of these frequencies only switch to the stored profile, which
+     * is much faster than a regular tune. An empty list disables fast-lock.
+     *
+     * \param which the frontend, e.g. "RX1"
+     * \param freqs up to 8 frequencies
+     * \return the exact frequencies of the profiles
+     */
+    virtual std::vector<double> set_fastlock_profiles(
+        const std::string &which, const std::vector<double> &freqs) = 0;
+
     //! set the DC offset for I and Q manually
     void set_dc_offset(const std::string &, const std::complex<double>)
     {
@@ -14,10 +14,12 @@
 #include <uhd/types/dict.hpp>
 #include <uhd/types/ranges.hpp>
 #include <uhd/utils/log.hpp>
+#include <uhdlib/utils/lru_cache.hpp>
 #include <uhdlib/utils/math.hpp>
 #include <boost/function.hpp>
 #include <boost/math/special_functions/round.hpp>
 #include <boost/thread.hpp>
+#include <tuple>
 #include <vector>
 
 class adf435x_iface
@@ -134,6 +136,7 @@ public:
         , _fb_after_divider(false)
         , _reference_freq(0.0)
         , _N_min(-1)
+        , _tuning_mode(TUNING_MODE_HIGH_RESOLUTION)
     {
     }
 
@@ -354,6 +357,87 @@ public:
     }
 
     double set_frequency(double target_freq, bool int_n_mode, bool flush = false)
+    {
+        // The solution only depends on these settings, so synthesizers of the
+        // same type can share it
+        const solution_key_t key(_reference_freq,
+            target_freq,
+            int_n_mode,
+            _tuning_mode,
+            _fb_after_divider != 0.0,
+            _N_min);
+        solution_t solution;
+        if (not _get_solution_cache().get(key, solution)) {
+            solution = _solve(target_freq, int_n_mode);
+            _get_solution_cache().put(key, solution);
+        }
+
+        _regs.frac_12_bit          = solution.FRAC;
+        _regs.int_16_bit           = solution.N;
+        _regs.mod_12_bit           = solution.MOD;
+        _regs.clock_divider_12_bit = solution.clock_div;
+        _regs.feedback_select      = _fb_after_divider
+                                    ? adf435x_regs_t::FEEDBACK_SELECT_DIVIDED
+                                    : adf435x_regs_t::FEEDBACK_SELECT_FUNDAMENTAL;
+        _regs.clock_div_mode = _fb_after_divider
+                                   ? adf435x_regs_t::CLOCK_DIV_MODE_RESYNC_ENABLE
+                                   : adf435x_regs_t::CLOCK_DIV_MODE_FAST_LOCK;
+        _regs.r_counter_10_bit      = solution.R;
+        _regs.reference_divide_by_2 = solution.T
+                                          ? adf435x_regs_t::REFERENCE_DIVIDE_BY_2_ENABLED
+                                          : adf435x_regs_t::REFERENCE_DIVIDE_BY_2_DISABLED;
+        _regs.reference_doubler = solution.D ? adf435x_regs_t::REFERENCE_DOUBLER_ENABLED
+                                             : adf435x_regs_t::REFERENCE_DOUBLER_DISABLED;
+        _regs.band_select_clock_div = uint8_t(solution.BS);
+        _regs.rf_divider_select =
+            static_cast<typename adf435x_regs_t::rf_divider_select_t>(
+                _get_rfdiv_setting(solution.RFdiv));
+        _regs.ldf = int_n_mode ? adf435x_regs_t::LDF_INT_N : adf435x_regs_t::LDF_FRAC_N;
+
+        if (flush)
+            commit();
+        return solution.actual_freq;
+    }
+
+    void commit()
+    {
+        // reset counters
+        _regs.counter_reset = adf435x_regs_t::COUNTER_RESET_ENABLED;
+        std::vector<uint32_t> regs;
+        regs.push_back(_regs.get_reg(uint32_t(2)));
+        _write_fn(regs);
+        _regs.counter_reset = adf435x_regs_t::COUNTER_RESET_DISABLED;
+
+        // write the registers
+        // correct power-up sequence to write registers (5, 4, 3, 2, 1, 0)
+        regs.clear();
+        for (int addr = 5; addr >= 0; addr--) {
+            regs.push_back(_regs.get_reg(uint32_t(addr)));
+        }
+        _write_fn(regs);
+    }
+
+protected:
+    //! Divider settings for a frequency
+    struct solution_t
+    {
+        uint16_t R, BS, N, FRAC, MOD, RFdiv, clock_div;
+        bool D, T;
+        double actual_freq;
+    };
+
+    //! Reference and target frequency, integer-N mode, tuning mode, feedback
+    //  select and minimum N
+    typedef std::tuple<double, double, bool, int, bool, int> solution_key_t;
+
+    //! Recently used solutions, shared by all instances of the same type
+    static uhd::lru_cache<solution_key_t, solution_t>& _get_solution_cache()
+    {
+        static uhd::lru_cache<solution_key_t, solution_t> cache(1024);
+        return cache;
+    }
+
+    solution_t _solve(double target_freq, bool int_n_mode)
     {
         static const double REF_DOUBLER_THRESH_FREQ = 12.5e6;
         static const double PFD_FREQ_MAX            = 25.0e6;
@@ -477,27 +561,6 @@ public:
             clock_div = uint16_t(std::ceil(PHASE_RESYNC_TIME * pfd_freq / MOD));
         }
 
-        _regs.frac_12_bit          = FRAC;
-        _regs.int_16_bit           = N;
-        _regs.mod_12_bit           = MOD;
-        _regs.clock_divider_12_bit = clock_div;
-        _regs.feedback_select      = _fb_after_divider
-                                    ? adf435x_regs_t::FEEDBACK_SELECT_DIVIDED
-                                    : adf435x_regs_t::FEEDBACK_SELECT_FUNDAMENTAL;
-        _regs.clock_div_mode = _fb_after_divider
-                                   ? adf435x_regs_t::CLOCK_DIV_MODE_RESYNC_ENABLE
-                                   : adf435x_regs_t::CLOCK_DIV_MODE_FAST_LOCK;
-        _regs.r_counter_10_bit      = R;
-        _regs.reference_divide_by_2 = T ? adf435x_regs_t::REFERENCE_DIVIDE_BY_2_ENABLED
-                                        : adf435x_regs_t::REFERENCE_DIVIDE_BY_2_DISABLED;
-        _regs.reference_doubler = D ? adf435x_regs_t::REFERENCE_DOUBLER_ENABLED
-                                    : adf435x_regs_t::REFERENCE_DOUBLER_DISABLED;
-        _regs.band_select_clock_div = uint8_t(BS);
-        _regs.rf_divider_select =
-            static_cast<typename adf435x_regs_t::rf_divider_select_t>(
-                _get_rfdiv_setting(RFdiv));
-        _regs.ldf = int_n_mode ? adf435x_regs_t::LDF_INT_N : adf435x_regs_t::LDF_FRAC_N;
-
         // clang-format off
         UHD_LOG_TRACE("ADF435X", boost::format(
             "ADF 435X Frequencies (MHz): REQUESTED=%0.9f, ACTUAL=%0.9f")
@@ -512,41 +575,31 @@ public:
             % R % BS % N % FRAC % MOD % T % D % RFdiv);
         // clang-format on
 
-        UHD_ASSERT_THROW((_regs.frac_12_bit & ((uint16_t)~0xFFF)) == 0);
-        UHD_ASSERT_THROW((_regs.mod_12_bit & ((uint16_t)~0xFFF)) == 0);
-        UHD_ASSERT_THROW((_regs.clock_divider_12_bit & ((uint16_t)~0xFFF)) == 0);
-        UHD_ASSERT_THROW((_regs.r_counter_10_bit & ((uint16_t)~0x3FF)) == 0);
+        UHD_ASSERT_THROW((FRAC & ((uint16_t)~0xFFF)) == 0);
+        UHD_ASSERT_THROW((MOD & ((uint16_t)~0xFFF)) == 0);
+        UHD_ASSERT_THROW((clock_div & ((uint16_t)~0xFFF)) == 0);
+        UHD_ASSERT_THROW((R & ((uint16_t)~0x3FF)) == 0);
 
         UHD_ASSERT_THROW(vco_freq >= VCO_FREQ_MIN and vco_freq <= VCO_FREQ_MAX);
         UHD_ASSERT_THROW(RFdiv >= static_cast<uint16_t>(rf_divider_range.start()));
         UHD_ASSERT_THROW(RFdiv <= static_cast<uint16_t>(rf_divider_range.stop()));
-        UHD_ASSERT_THROW(_regs.int_16_bit >= static_cast<uint16_t>(int_range.start()));
-        UHD_ASSERT_THROW(_regs.int_16_bit <= static_cast<uint16_t>(int_range.stop()));
-
-        if (flush)
-            commit();
-        return actual_freq;
+        UHD_ASSERT_THROW(N >= static_cast<uint16_t>(int_range.start()));
+        UHD_ASSERT_THROW(N <= static_cast<uint16_t>(int_range.stop()));
+
+        solution_t solution;
+        solution.R           = R;
+        solution.BS          = BS;
+        solution.N           = N;
+        solution.FRAC        = FRAC;
+        solution.MOD         = MOD;
+        solution.RFdiv       = RFdiv;
+        solution.clock_div   = clock_div;
+        solution.D           = D;
+        solution.T           = T;
+        solution.actual_freq = actual_freq;
+        return solution;
     }
 
-    void commit()
-    {
-        // reset counters
-        _regs.counter_reset = adf435x_regs_t::COUNTER_RESET_ENABLED;
-        std::vector<uint32_t> regs;
-        regs.push_back(_regs.get_reg(uint32_t(2)));
-        _write_fn(regs);
-        _regs.counter_reset = adf435x_regs_t::COUNTER_RESET_DISABLED;
-
-        // write the registers
-        // correct power-up sequence to write registers (5, 4, 3, 2, 1, 0)
-        regs.clear();
-        for (int addr = 5; addr >= 0; addr--) {
-            regs.push_back(_regs.get_reg(uint32_t(addr)));
-        }
-        _write_fn(regs);
-    }
-
-protected:
     uhd::range_t _get_rfdiv_range();
     int _get_rfdiv_setting(uint16_t div);
 
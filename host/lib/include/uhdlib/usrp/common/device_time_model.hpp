@@ -0,0 +1,103 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_USRP_COMMON_DEVICE_TIME_MODEL_HPP
+#define INCLUDED_UHDLIB_USRP_COMMON_DEVICE_TIME_MODEL_HPP
+
+#include <uhd/types/time_spec.hpp>
+#include <chrono>
+#include <deque>
+
+namespace uhd { namespace usrp {
+
+/*! A host side model of the time of a device
+ *
+ * The model is a line fit of the device time over the host's steady clock,
+ * calibrated with readbacks of the device time. Every readback is assumed to
+ * have been latched halfway through its round trip, so half the round trip
+ * time is its uncertainty. Offset and drift are fit with weighted least
+ * squares over the last few readbacks, with a prior on the drift of
+ * \p max_drift, so a single readback already gives a usable model.
+ *
+ * get_error() estimates the error of get_time(). It grows with the distance
+ * to the readbacks, so callers can read the device time again once it exceeds
+ * what they accept. A readback that is far off the model means the device
+ * time was changed, and starts the model over.
+ *
+ * This class is not thread safe.
+ */
+class device_time_model
+{
+public:
+    typedef std::chrono::steady_clock clock_type;
+
+    //! Worst case drift between the host clock and the device time
+    static constexpr double DEFAULT_MAX_DRIFT = 100e-6;
+    //! Number of readbacks that are fit
+    static constexpr size_t DEFAULT_MAX_SAMPLES = 16;
+
+    device_time_model(const double max_drift = DEFAULT_MAX_DRIFT,
+        const size_t max_samples             = DEFAULT_MAX_SAMPLES);
+
+    //! Forget all readbacks, e.g., after the device time was set
+    void reset(void);
+
+    /*!
+     * Add a readback of the device time
+     *
+     * \param host_before the host time before the readback was sent
+     * \param host_after the host time after the response was received
+     * \param device_time the time that was read back
+     * \param resolution the resolution of the device time, i.e., a tick
+     * \return false if the readback didn't fit the model, which was reset
+     */
+    bool add_readback(const clock_type::time_point& host_before,
+        const clock_type::time_point& host_after,
+        const uhd::time_spec_t& device_time,
+        const double resolution);
+
+    //! True if there was a readback since the last reset
+    bool is_valid(void) const;
+
+    //! The device time at \p host_time. Must be valid.
+    uhd::time_spec_t get_time(const clock_type::time_point& host_time) const;
+
+    //! The error estimate of get_time() at \p host_time in seconds, infinite
+    //  if the model isn't valid
+    double get_error(const clock_type::time_point& host_time) const;
+
+private:
+    struct sample_t
+    {
+        //! Host time since _host_origin in seconds
+        double host;
+        //! Device time since _device_origin in seconds
+        double device;
+        //! Uncertainty of the device time in seconds
+        double error;
+    };
+
+    double to_host_secs(const clock_type::time_point& host_time) const;
+    void fit(void);
+
+    const double _max_drift;
+    const size_t _max_samples;
+    std::deque<sample_t> _samples;
+    clock_type::time_point _host_origin;
+    uhd::time_spec_t _device_origin;
+
+    // The fit: device = _device_mean + _drift * (host - _host_mean)
+    double _host_mean;
+    double _device_mean;
+    double _drift;
+    //! Variances of _device_mean and _drift
+    double _mean_var;
+    double _drift_var;
+};
+
+}} // namespace uhd::usrp
+
+#endif /* INCLUDED_UHDLIB_USRP_COMMON_DEVICE_TIME_MODEL_HPP */
@@ -0,0 +1,59 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_USRP_COMMON_EEPROM_CACHE_HPP
+#define INCLUDED_UHDLIB_USRP_COMMON_EEPROM_CACHE_HPP
+
+#include <uhd/types/serial.hpp>
+#include <boost/shared_ptr.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace uhd { namespace usrp {
+
+/*! An I2C interface which caches EEPROM contents for the lifetime of the process
+ *
+ * The contents returned by read_eeprom() are cached under a key which
+ * identifies the motherboard, usually its serial, together with the I2C
+ * address and the range that was read. When the same range is read again,
+ * only the check regions are read from the EEPROM, and the cached contents are
+ * returned if these did not change. Otherwise, the whole range is read again.
+ *
+ * This makes reopening a device cheap on slow I2C masters, where reading an
+ * EEPROM takes a transaction per byte. Writes to an address through this
+ * interface drop its cached contents. All other calls are passed through to
+ * the wrapped interface.
+ */
+class eeprom_cache_iface : public uhd::i2c_iface
+{
+public:
+    typedef boost::shared_ptr<eeprom_cache_iface> sptr;
+    //! Offset and length of the regions which are compared to validate
+    //  cached contents
+    typedef std::vector<std::pair<uint16_t, size_t>> check_regions_t;
+
+    //! The magic, ID and checksum bytes of a daughterboard EEPROM
+    static const check_regions_t DB_EEPROM_CHECK_REGIONS;
+
+    virtual ~eeprom_cache_iface(void) = 0;
+
+    /*!
+     * \param iface the interface to the I2C bus of the EEPROMs
+     * \param key identifies the motherboard. If it is empty, nothing is cached.
+     * \param check_regions the regions to compare. Reads which do not cover
+     *                      all of them are not cached.
+     */
+    static sptr make(
+        i2c_iface::sptr iface, const std::string& key, const check_regions_t& check_regions);
+
+    //! Drop all cached contents
+    static void clear(void);
+};
+
+}} // namespace uhd::usrp
+
+#endif /* INCLUDED_UHDLIB_USRP_COMMON_EEPROM_CACHE_HPP */
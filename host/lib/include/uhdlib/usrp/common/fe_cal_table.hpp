@@ -0,0 +1,103 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_USRP_COMMON_FE_CAL_TABLE_HPP
+#define INCLUDED_UHDLIB_USRP_COMMON_FE_CAL_TABLE_HPP
+
+#include <uhdlib/utils/lru_cache.hpp>
+#include <algorithm>
+#include <complex>
+#include <vector>
+
+namespace uhd { namespace usrp {
+
+/*! Frontend calibration data (IQ balance or DC offset) over the LO frequency
+ *
+ * The points are sorted once, when the table is created. A lookup finds the
+ * neighbouring points with a binary search and interpolates linearly between
+ * them. The corrections for the most recently used LO frequencies are cached,
+ * so sweeps that revisit the same frequencies skip the search altogether.
+ */
+class fe_cal_table
+{
+public:
+    //! Frequencies closer than this are treated as the same calibration point
+    static constexpr double FREQ_EPSILON = 0.1;
+    //! Number of LO frequencies whose correction is cached
+    static constexpr size_t CACHE_SIZE = 64;
+
+    struct point_t
+    {
+        double lo_freq;
+        std::complex<double> corr;
+    };
+
+    explicit fe_cal_table(std::vector<point_t> points)
+        : _points(std::move(points)), _cache(CACHE_SIZE)
+    {
+        std::stable_sort(_points.begin(),
+            _points.end(),
+            [](const point_t& a, const point_t& b) { return a.lo_freq < b.lo_freq; });
+    }
+
+    bool empty() const
+    {
+        return _points.empty();
+    }
+
+    size_t size() const
+    {
+        return _points.size();
+    }
+
+    /*! Return the correction at \p lo_freq
+     *
+     * A calibration point within FREQ_EPSILON of \p lo_freq is used as is.
+     * Outside of the calibrated range, and below the second point, the
+     * closest point at the end of the table is used. Must not be called on
+     * an empty table.
+     */
+    std::complex<double> get(const double lo_freq)
+    {
+        std::complex<double> corr;
+        if (not _cache.get(lo_freq, corr)) {
+            corr = lookup(lo_freq);
+            _cache.put(lo_freq, corr);
+        }
+        return corr;
+    }
+
+private:
+    std::complex<double> lookup(const double lo_freq) const
+    {
+        // The first point that is the same as or above lo_freq
+        const auto hi = std::upper_bound(_points.begin(),
+            _points.end(),
+            lo_freq,
+            [](const double freq, const point_t& point) {
+                return freq < point.lo_freq + FREQ_EPSILON;
+            });
+        if (hi == _points.end()) {
+            return _points.back().corr;
+        }
+        if (hi->lo_freq - FREQ_EPSILON < lo_freq) {
+            return hi->corr;
+        }
+        if (hi - _points.begin() <= 1) {
+            return _points.front().corr;
+        }
+        const point_t& lo = *(hi - 1);
+        return lo.corr
+               + (lo_freq - lo.lo_freq) * (hi->corr - lo.corr) / (hi->lo_freq - lo.lo_freq);
+    }
+
+    std::vector<point_t> _points;
+    uhd::lru_cache<double, std::complex<double>> _cache;
+};
+
+}} // namespace uhd::usrp
+
+#endif /* INCLUDED_UHDLIB_USRP_COMMON_FE_CAL_TABLE_HPP */
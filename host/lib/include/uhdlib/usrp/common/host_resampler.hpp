@@ -0,0 +1,109 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_USRP_COMMON_HOST_RESAMPLER_HPP
+#define INCLUDED_UHDLIB_USRP_COMMON_HOST_RESAMPLER_HPP
+
+#include <uhd/stream.hpp>
+#include <stdint.h>
+#include <complex>
+#include <utility>
+#include <vector>
+
+namespace uhd { namespace usrp {
+
+/*! A rational polyphase resampler for sc16 input and fc32 output
+ *
+ * The input is converted to float while it is copied into the filter
+ * history, and the conversion scale is part of the filter taps, so there is
+ * no separate conversion pass. The filter kernel uses SSE2 where available.
+ */
+class polyphase_resampler
+{
+public:
+    /*!
+     * \param interp the interpolation factor L
+     * \param decim the decimation factor M
+     * \param scale the factor which converts the input to the output scale
+     */
+    polyphase_resampler(const size_t interp, const size_t decim, const float scale);
+
+    size_t get_interp(void) const
+    {
+        return _interp;
+    }
+
+    size_t get_decim(void) const
+    {
+        return _decim;
+    }
+
+    //! Number of filter taps per phase
+    size_t get_taps_per_phase(void) const
+    {
+        return _taps_per_phase;
+    }
+
+    //! Add input samples
+    void push(const std::complex<int16_t>* in, const size_t nsamps);
+
+    //! Write up to nsamps output samples, and return how many were written
+    size_t pull(std::complex<float>* out, const size_t nsamps);
+
+    /*!
+     * The position of the next output sample in the input, in input samples
+     * since the last reset(). It includes the delay of the filter, and is
+     * negative for the first samples after a reset.
+     */
+    double get_output_position(void) const;
+
+    //! Drop the filter history and start over
+    void reset(void);
+
+    /*!
+     * Find L/M which approximates \p ratio, where neither is larger than
+     * \p max_factor.
+     */
+    static std::pair<size_t, size_t> approximate_ratio(
+        const double ratio, const size_t max_factor);
+
+private:
+    const size_t _interp;
+    const size_t _decim;
+    const size_t _taps_per_phase;
+    //! Taps of every phase in reverse order, each one twice (for I and Q)
+    std::vector<float> _taps;
+    //! Interleaved I/Q input, the oldest _taps_per_phase-1 samples are history
+    std::vector<float> _history;
+    //! Index of the newest input sample of the next output in _history
+    size_t _in_index;
+    //! Phase of the next output
+    size_t _phase;
+    //! Input samples which have been dropped from _history since reset()
+    int64_t _num_dropped;
+};
+
+/*!
+ * Wrap an RX streamer with a sc16 CPU format into one with fc32 samples at
+ * a different rate
+ *
+ * All channels are resampled by the same ratio. The metadata time specs are
+ * corrected for the resampling. The filter history is reset on errors and at
+ * the end of a burst.
+ *
+ * \param streamer a streamer with the sc16 CPU format
+ * \param input_rate the sample rate of \p streamer
+ * \param output_rate the sample rate to resample to
+ * \param scale the factor which converts sc16 to fc32 samples
+ */
+uhd::rx_streamer::sptr make_resampling_rx_streamer(uhd::rx_streamer::sptr streamer,
+    const double input_rate,
+    const double output_rate,
+    const float scale);
+
+}} // namespace uhd::usrp
+
+#endif /* INCLUDED_UHDLIB_USRP_COMMON_HOST_RESAMPLER_HPP */
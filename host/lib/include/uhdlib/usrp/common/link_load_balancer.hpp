@@ -0,0 +1,126 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_USRP_COMMON_LINK_LOAD_BALANCER_HPP
+#define INCLUDED_UHDLIB_USRP_COMMON_LINK_LOAD_BALANCER_HPP
+
+#include <uhd/exception.hpp>
+#include <uhd/transport/zero_copy.hpp>
+#include <uhd/types/direction.hpp>
+#include <boost/weak_ptr.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace uhd { namespace usrp {
+
+/*! Assigns data transports to the least loaded of several links
+ *
+ * The load of a link in one direction is the number of live data transports
+ * in that direction on it, divided by the link rate. A transport counts for
+ * as long as it exists, so destroying a streamer frees its share of the link.
+ *
+ * This is not thread-safe; devices create their transports with the
+ * transport setup mutex held.
+ */
+class link_load_balancer
+{
+public:
+    /*! Add a link
+     *
+     * \param link_rate Rate of the link in bytes per second
+     * \return the index of the new link
+     */
+    size_t add_link(const double link_rate)
+    {
+        _links.push_back(link_t{link_rate, {}, {}});
+        return _links.size() - 1;
+    }
+
+    size_t get_num_links() const
+    {
+        return _links.size();
+    }
+
+    //! Return the number of live transports in direction \p dir on a link
+    size_t get_num_xports(const size_t link, const uhd::direction_t dir) const
+    {
+        const auto& xports = get_xports(_links.at(link), dir);
+        return std::count_if(xports.begin(),
+            xports.end(),
+            [](const boost::weak_ptr<transport::zero_copy_if>& xport) {
+                return not xport.expired();
+            });
+    }
+
+    /*! Return the least loaded link of \p candidates in direction \p dir
+     *
+     * Ties go to the candidate which comes first, so callers can rotate the
+     * candidates to spread equal loads.
+     */
+    size_t pick(const uhd::direction_t dir, const std::vector<size_t>& candidates) const
+    {
+        if (candidates.empty()) {
+            throw uhd::value_error("link_load_balancer: No link to pick from");
+        }
+        size_t best      = candidates.front();
+        double best_load = get_load(best, dir);
+        for (const size_t link : candidates) {
+            const double load = get_load(link, dir);
+            if (load < best_load) {
+                best      = link;
+                best_load = load;
+            }
+        }
+        return best;
+    }
+
+    //! Count \p xport towards the load of \p link in direction \p dir
+    void add_xport(const size_t link,
+        const uhd::direction_t dir,
+        const transport::zero_copy_if::sptr& xport)
+    {
+        auto& xports = get_xports(_links.at(link), dir);
+        xports.erase(std::remove_if(xports.begin(),
+                         xports.end(),
+                         [](const boost::weak_ptr<transport::zero_copy_if>& old) {
+                             return old.expired();
+                         }),
+            xports.end());
+        xports.push_back(xport);
+    }
+
+private:
+    struct link_t
+    {
+        double rate;
+        std::vector<boost::weak_ptr<transport::zero_copy_if>> rx_xports;
+        std::vector<boost::weak_ptr<transport::zero_copy_if>> tx_xports;
+    };
+
+    static std::vector<boost::weak_ptr<transport::zero_copy_if>>& get_xports(
+        link_t& link, const uhd::direction_t dir)
+    {
+        return dir == uhd::RX_DIRECTION ? link.rx_xports : link.tx_xports;
+    }
+
+    static const std::vector<boost::weak_ptr<transport::zero_copy_if>>& get_xports(
+        const link_t& link, const uhd::direction_t dir)
+    {
+        return dir == uhd::RX_DIRECTION ? link.rx_xports : link.tx_xports;
+    }
+
+    //! The load with one more transport, so a faster link wins among idle ones
+    double get_load(const size_t link, const uhd::direction_t dir) const
+    {
+        return (get_num_xports(link, dir) + 1) / _links.at(link).rate;
+    }
+
+    std::vector<link_t> _links;
+};
+
+}} // namespace uhd::usrp
+
+#endif /* INCLUDED_UHDLIB_USRP_COMMON_LINK_LOAD_BALANCER_HPP */
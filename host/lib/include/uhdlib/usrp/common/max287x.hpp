@@ -16,12 +16,14 @@
 #include <uhd/utils/log.hpp>
 #include <uhd/utils/math.hpp>
 #include <uhd/utils/safe_call.hpp>
+#include <uhdlib/utils/lru_cache.hpp>
 #include <boost/assign.hpp>
 #include <boost/function.hpp>
 #include <boost/math/special_functions/round.hpp>
 #include <vector>
 #include <chrono>
 #include <thread>
+#include <tuple>
 #include <stdint.h>
 
 /**
@@ -255,6 +257,32 @@ protected:
     bool _write_all_regs;
 
 private:
+    //! Divider settings for a frequency
+    struct solution_t
+    {
+        int R, BS, N, FRAC, MOD, RFdiv, clock_div;
+        bool D, T;
+        double pfd_freq;
+        double actual_freq;
+    };
+
+    //! Target, reference and target PFD frequency, integer-N mode and
+    //  feedback select
+    typedef std::tuple<double, double, double, bool, bool> solution_key_t;
+
+    //! Recently used solutions, shared by all instances of the same type
+    static uhd::lru_cache<solution_key_t, solution_t>& _get_solution_cache()
+    {
+        static uhd::lru_cache<solution_key_t, solution_t> cache(1024);
+        return cache;
+    }
+
+    solution_t _solve(double target_freq,
+        double ref_freq,
+        double target_pfd_freq,
+        bool is_int_n,
+        bool feedback_divided);
+
     write_fn _write;
     bool _delay_after_write;
 };
@@ -511,24 +539,13 @@ bool max287x<max287x_regs_t>::is_shutdown(void)
 }
 
 template <typename max287x_regs_t>
-double max287x<max287x_regs_t>::set_frequency(
+typename max287x<max287x_regs_t>::solution_t max287x<max287x_regs_t>::_solve(
     double target_freq,
     double ref_freq,
     double target_pfd_freq,
-    bool is_int_n)
+    bool is_int_n,
+    bool feedback_divided)
 {
-    //map rf divider select output dividers to enums
-    static const uhd::dict<int, typename max287x_regs_t::rf_divider_select_t> rfdivsel_to_enum =
-        boost::assign::map_list_of
-        (1,   max287x_regs_t::RF_DIVIDER_SELECT_DIV1)
-        (2,   max287x_regs_t::RF_DIVIDER_SELECT_DIV2)
-        (4,   max287x_regs_t::RF_DIVIDER_SELECT_DIV4)
-        (8,   max287x_regs_t::RF_DIVIDER_SELECT_DIV8)
-        (16,  max287x_regs_t::RF_DIVIDER_SELECT_DIV16)
-        (32,  max287x_regs_t::RF_DIVIDER_SELECT_DIV32)
-        (64,  max287x_regs_t::RF_DIVIDER_SELECT_DIV64)
-        (128, max287x_regs_t::RF_DIVIDER_SELECT_DIV128);
-
     //map mode setting to valid integer divider (N) values
     static const uhd::range_t int_n_mode_div_range(16,65535,1);
     static const uhd::range_t frac_n_mode_div_range(19,4091,1);
@@ -549,7 +566,6 @@ double max287x<max287x_regs_t>::set_frequency(
     int MOD = 4095;
     int RFdiv = 1;
     double pfd_freq = target_pfd_freq;
-    bool feedback_divided = (_regs.feedback_select == max287x_regs_t::FEEDBACK_SELECT_DIVIDED);
 
     //increase RF divider until acceptable VCO frequency (MIN freq for MAX287x VCO is 3GHz)
     UHD_ASSERT_THROW(target_freq > 0);
@@ -645,6 +661,56 @@ double max287x<max287x_regs_t>::set_frequency(
                % (target_freq / 1e6) % (actual_freq / 1e6) % (vco_freq / 1e6)
                % (pfd_freq / 1e6) % (pfd_freq / BS / 1e6);
 
+    solution_t solution;
+    solution.R           = R;
+    solution.BS          = BS;
+    solution.N           = N;
+    solution.FRAC        = FRAC;
+    solution.MOD         = MOD;
+    solution.RFdiv       = RFdiv;
+    solution.clock_div   = std::max(
+        int(clock_div_range.start()), int(std::ceil(400e-6 * pfd_freq / MOD)));
+    solution.D           = D != 0;
+    solution.T           = T != 0;
+    solution.pfd_freq    = pfd_freq;
+    solution.actual_freq = actual_freq;
+    UHD_ASSERT_THROW(solution.clock_div <= clock_div_range.stop());
+    return solution;
+}
+
+template <typename max287x_regs_t>
+double max287x<max287x_regs_t>::set_frequency(
+    double target_freq,
+    double ref_freq,
+    double target_pfd_freq,
+    bool is_int_n)
+{
+    //map rf divider select output dividers to enums
+    static const uhd::dict<int, typename max287x_regs_t::rf_divider_select_t> rfdivsel_to_enum =
+        boost::assign::map_list_of
+        (1,   max287x_regs_t::RF_DIVIDER_SELECT_DIV1)
+        (2,   max287x_regs_t::RF_DIVIDER_SELECT_DIV2)
+        (4,   max287x_regs_t::RF_DIVIDER_SELECT_DIV4)
+        (8,   max287x_regs_t::RF_DIVIDER_SELECT_DIV8)
+        (16,  max287x_regs_t::RF_DIVIDER_SELECT_DIV16)
+        (32,  max287x_regs_t::RF_DIVIDER_SELECT_DIV32)
+        (64,  max287x_regs_t::RF_DIVIDER_SELECT_DIV64)
+        (128, max287x_regs_t::RF_DIVIDER_SELECT_DIV128);
+
+    // The solution only depends on these settings, so synthesizers of the
+    // same type can share it. Sweeps across the same frequencies skip the
+    // R/N search after the first pass.
+    const bool feedback_divided =
+        (_regs.feedback_select == max287x_regs_t::FEEDBACK_SELECT_DIVIDED);
+    const solution_key_t key(
+        target_freq, ref_freq, target_pfd_freq, is_int_n, feedback_divided);
+    solution_t solution;
+    if (not _get_solution_cache().get(key, solution)) {
+        solution =
+            _solve(target_freq, ref_freq, target_pfd_freq, is_int_n, feedback_divided);
+        _get_solution_cache().put(key, solution);
+    }
+
     //load the register values
     _regs.rf_output_enable = max287x_regs_t::RF_OUTPUT_ENABLE_ENABLED;
 
@@ -658,24 +724,24 @@ double max287x<max287x_regs_t>::set_frequency(
         _regs.int_n_mode = max287x_regs_t::INT_N_MODE_FRAC_N;
     }
 
-    _regs.lds = pfd_freq <= 32e6 ? max287x_regs_t::LDS_SLOW : max287x_regs_t::LDS_FAST;
+    _regs.lds = solution.pfd_freq <= 32e6 ? max287x_regs_t::LDS_SLOW
+                                          : max287x_regs_t::LDS_FAST;
 
-    _regs.frac_12_bit = FRAC;
-    _regs.int_16_bit = N;
-    _regs.mod_12_bit = MOD;
-    _regs.clock_divider_12_bit = std::max(int(clock_div_range.start()), int(std::ceil(400e-6*pfd_freq/MOD)));
-    UHD_ASSERT_THROW(_regs.clock_divider_12_bit <= clock_div_range.stop());
-    _regs.r_counter_10_bit = R;
-    _regs.reference_divide_by_2 = T ?
+    _regs.frac_12_bit = solution.FRAC;
+    _regs.int_16_bit = solution.N;
+    _regs.mod_12_bit = solution.MOD;
+    _regs.clock_divider_12_bit = solution.clock_div;
+    _regs.r_counter_10_bit = solution.R;
+    _regs.reference_divide_by_2 = solution.T ?
         max287x_regs_t::REFERENCE_DIVIDE_BY_2_ENABLED :
         max287x_regs_t::REFERENCE_DIVIDE_BY_2_DISABLED;
-    _regs.reference_doubler = D ?
+    _regs.reference_doubler = solution.D ?
         max287x_regs_t::REFERENCE_DOUBLER_ENABLED :
         max287x_regs_t::REFERENCE_DOUBLER_DISABLED;
-    _regs.band_select_clock_div = BS & 0xFF;
-    _regs.bs_msb = (BS & 0x300) >> 8;
-    UHD_ASSERT_THROW(rfdivsel_to_enum.has_key(RFdiv));
-    _regs.rf_divider_select = rfdivsel_to_enum[RFdiv];
+    _regs.band_select_clock_div = solution.BS & 0xFF;
+    _regs.bs_msb = (solution.BS & 0x300) >> 8;
+    UHD_ASSERT_THROW(rfdivsel_to_enum.has_key(solution.RFdiv));
+    _regs.rf_divider_select = rfdivsel_to_enum[solution.RFdiv];
 
     if (_regs.clock_div_mode == max287x_regs_t::CLOCK_DIV_MODE_FAST_LOCK)
     {
@@ -685,7 +751,7 @@ double max287x<max287x_regs_t>::set_frequency(
         _write_all_regs = true;
     }
 
-    return actual_freq;
+    return solution.actual_freq;
 }
 
 template <typename max287x_regs_t>
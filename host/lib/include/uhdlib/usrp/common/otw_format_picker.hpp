@@ -0,0 +1,56 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_USRP_COMMON_OTW_FORMAT_PICKER_HPP
+#define INCLUDED_UHDLIB_USRP_COMMON_OTW_FORMAT_PICKER_HPP
+
+#include <string>
+#include <vector>
+
+namespace uhd { namespace usrp {
+
+//! Fraction of a link's rate that streams may plan to use
+constexpr double OTW_LINK_HEADROOM = 0.9;
+
+//! The over-the-wire format pick_otw_format() chose, and what it costs
+struct otw_format_choice_t
+{
+    //! The chosen format, e.g. "sc12"
+    std::string otw_format;
+    //! Samples per packet with this format
+    size_t spp;
+    //! Bytes per second on the link, including packet headers
+    double bytes_per_sec;
+    //! False if even this format needs more than the link can carry
+    bool fits;
+};
+
+/*! Pick the widest over-the-wire format whose streams fit on a link
+ *
+ * The streams' bandwidth includes one header per packet, so packets are
+ * assumed to be as large as \p frame_size allows. A stream fits if it needs
+ * no more than OTW_LINK_HEADROOM of \p link_rate. If no format fits, the
+ * narrowest one is returned with fits set to false.
+ *
+ * \param otw_formats The acceptable formats, widest first. Must not be empty.
+ * \param samp_rate Sample rate of each channel
+ * \param num_chans Number of channels that share the link
+ * \param frame_size Largest packet, in bytes
+ * \param header_size Bytes of each packet that aren't samples
+ * \param link_rate Rate of the link in bytes per second, or 0 if unknown, in
+ *        which case the widest format is chosen
+ * \throws uhd::value_error if a packet can't hold a single sample
+ */
+otw_format_choice_t pick_otw_format(const std::vector<std::string>& otw_formats,
+    const double samp_rate,
+    const size_t num_chans,
+    const size_t frame_size,
+    const size_t header_size,
+    const double link_rate);
+
+}} // namespace uhd::usrp
+
+#endif /* INCLUDED_UHDLIB_USRP_COMMON_OTW_FORMAT_PICKER_HPP */
@@ -8,138 +8,214 @@
 #ifndef INCLUDED_LIBUHD_USRP_COMMON_RECV_PACKET_DEMUXER_3000_HPP
 #define INCLUDED_LIBUHD_USRP_COMMON_RECV_PACKET_DEMUXER_3000_HPP
 
-#include <uhdlib/utils/system_time.hpp>
 #include <uhd/config.hpp>
+#include <uhd/exception.hpp>
 #include <uhd/transport/zero_copy.hpp>
-#include <uhd/utils/log.hpp>
-#include <uhd/types/time_spec.hpp>
 #include <uhd/utils/byteswap.hpp>
-#include <boost/thread.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhdlib/transport/demux_turns.hpp>
+#include <uhdlib/transport/spsc_bounded_buffer.hpp>
 #include <boost/enable_shared_from_this.hpp>
-#include <queue>
-#include <map>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <algorithm>
+#include <atomic>
+#include <memory>
 #include <stdint.h>
 
-namespace uhd{ namespace usrp{
-
-    struct recv_packet_demuxer_3000 : boost::enable_shared_from_this<recv_packet_demuxer_3000>
+namespace uhd { namespace usrp {
+
+/*! Demuxes the frames of one transport by SID
+ *
+ * There is no demux thread. A thread that asks for a SID with an empty queue
+ * tries to become the demuxer: If it gets the demux mutex, it drains a batch
+ * of frames from the transport into the queues of their SIDs. If another
+ * thread is demuxing, it waits on its own queue for a short while and then
+ * tries again, see transport::pop_with_demux_turns().
+ *
+ * The per-SID queues are lock-free SPSC buffers: the demux mutex hands the
+ * producer side around, and each SID is received from by one thread. Looking
+ * up a queue doesn't lock either, queues are only ever added.
+ */
+struct recv_packet_demuxer_3000 : boost::enable_shared_from_this<recv_packet_demuxer_3000>
+{
+    typedef boost::shared_ptr<recv_packet_demuxer_3000> sptr;
+    static sptr make(transport::zero_copy_if::sptr xport)
     {
-        typedef boost::shared_ptr<recv_packet_demuxer_3000> sptr;
-        static sptr make(transport::zero_copy_if::sptr xport)
-        {
-            return sptr(new recv_packet_demuxer_3000(xport));
-        }
-
-        recv_packet_demuxer_3000(transport::zero_copy_if::sptr xport):
-            _xport(xport)
-        {/*NOP*/}
+        return sptr(new recv_packet_demuxer_3000(xport));
+    }
 
-        transport::managed_recv_buffer::sptr get_recv_buff(const uint32_t sid, const double timeout)
-        {
-            const time_spec_t exit_time =
-                time_spec_t(timeout) + uhd::get_system_time();
-            transport::managed_recv_buffer::sptr buff;
-            buff = _internal_get_recv_buff(sid, timeout);
-            while (not buff) //loop until timeout
-            {
-                const time_spec_t delta = exit_time - uhd::get_system_time();
-                const double new_timeout = delta.get_real_secs();
-                if (new_timeout < 0.0) break;
-                buff = _internal_get_recv_buff(sid, new_timeout);
-            }
-            return buff;
-        }
+    recv_packet_demuxer_3000(transport::zero_copy_if::sptr xport)
+        : _xport(xport), _num_queues(0)
+    {
+        /*NOP*/
+    }
 
-        transport::managed_recv_buffer::sptr _internal_get_recv_buff(const uint32_t sid, const double timeout)
-        {
-            transport::managed_recv_buffer::sptr buff;
-
-            //----------------------------------------------------------
-            //-- Check the queue to see if we already have a buffer
-            //----------------------------------------------------------
-            {
-                boost::mutex::scoped_lock l(mutex);
-                queue_type_t &queue = _queues[sid];
-                if (not queue.empty())
-                {
-                    buff = queue.front();
-                    queue.front().reset();
-                    queue.pop();
-                    return buff;
-                }
-            }
-            {
-                buff = _xport->get_recv_buff(timeout);
-                if (buff)
-                {
-                    const uint32_t new_sid = uhd::wtohx(buff->cast<const uint32_t *>()[1]);
-                    if (new_sid != sid)
-                    {
-                        boost::mutex::scoped_lock l(mutex);
-                        if (_queues.count(new_sid) == 0) UHD_LOGGER_ERROR("STREAMER")
-                            << "recv packet demuxer unexpected sid 0x" << std::hex << new_sid << std::dec
-                            ;
-                        else _queues[new_sid].push(buff);
-                        buff.reset();
-                    }
+    transport::managed_recv_buffer::sptr get_recv_buff(
+        const uint32_t sid, const double timeout)
+    {
+        transport::managed_recv_buffer::sptr buff;
+        transport::pop_with_demux_turns(
+            _get_queue(sid), buff, timeout, [this](const double slice) {
+                boost::unique_lock<boost::mutex> lock(_demux_mutex, boost::try_to_lock);
+                if (not lock.owns_lock()) {
+                    return false;
                 }
-            }
-            return buff;
-        }
+                _demux(slice);
+                return true;
+            });
+        return buff;
+    }
 
-        void realloc_sid(const uint32_t sid)
-        {
-            boost::mutex::scoped_lock l(mutex);
-            while(not _queues[sid].empty()) //allocated and clears if already allocated
-            {
-                _queues[sid].pop();
-            }
+    //! Drop all frames queued for a SID. Must be called by the thread that
+    // receives from it, or while nobody does.
+    void realloc_sid(const uint32_t sid)
+    {
+        queue_type_t& queue = _get_queue(sid);
+        transport::managed_recv_buffer::sptr buff;
+        while (queue.pop_with_haste(buff)) {
+            /* NOP */
         }
+    }
 
-        transport::zero_copy_if::sptr make_proxy(const uint32_t sid);
+    transport::zero_copy_if::sptr make_proxy(const uint32_t sid);
 
-        typedef std::queue<transport::managed_recv_buffer::sptr> queue_type_t;
-        std::map<uint32_t, queue_type_t> _queues;
-        transport::zero_copy_if::sptr _xport;
-        boost::mutex mutex;
-    };
+private:
+    typedef transport::spsc_bounded_buffer<transport::managed_recv_buffer::sptr>
+        queue_type_t;
 
-    struct recv_packet_demuxer_proxy_3000 : transport::zero_copy_if
+    struct sid_queue_t
     {
-        recv_packet_demuxer_proxy_3000(recv_packet_demuxer_3000::sptr demux, transport::zero_copy_if::sptr xport, const uint32_t sid):
-            _demux(demux), _xport(xport), _sid(sid)
+        sid_queue_t(const uint32_t sid, const size_t capacity) : sid(sid), queue(capacity)
         {
-            _demux->realloc_sid(_sid); //causes clear
         }
+        const uint32_t sid;
+        queue_type_t queue;
+    };
 
-        ~recv_packet_demuxer_proxy_3000(void)
-        {
-            _demux->realloc_sid(_sid); //causes clear
+    //! More SIDs than any of the users of this demuxer will ever stream
+    static const size_t MAX_NUM_SIDS = 32;
+
+    sid_queue_t* _find_queue(const uint32_t sid) const
+    {
+        const size_t num_queues = _num_queues.load(std::memory_order_acquire);
+        for (size_t i = 0; i < num_queues; i++) {
+            if (_queues[i]->sid == sid) {
+                return _queues[i].get();
+            }
         }
+        return nullptr;
+    }
 
-        size_t get_num_recv_frames(void) const {return _xport->get_num_recv_frames();}
-        size_t get_recv_frame_size(void) const {return _xport->get_recv_frame_size();}
-        transport::managed_recv_buffer::sptr get_recv_buff(double timeout)
-        {
-            return _demux->get_recv_buff(_sid, timeout);
+    queue_type_t& _get_queue(const uint32_t sid)
+    {
+        sid_queue_t* sid_queue = _find_queue(sid);
+        if (sid_queue) {
+            return sid_queue->queue;
         }
-        size_t get_num_send_frames(void) const {return _xport->get_num_send_frames();}
-        size_t get_send_frame_size(void) const {return _xport->get_send_frame_size();}
-        transport::managed_send_buffer::sptr get_send_buff(double timeout)
-        {
-            return _xport->get_send_buff(timeout);
+        boost::mutex::scoped_lock l(_queues_mutex);
+        // Someone else may have added it in the meantime
+        sid_queue = _find_queue(sid);
+        if (sid_queue) {
+            return sid_queue->queue;
+        }
+        const size_t num_queues = _num_queues.load(std::memory_order_relaxed);
+        if (num_queues == MAX_NUM_SIDS) {
+            throw uhd::runtime_error("recv packet demuxer: too many SIDs");
         }
+        // A queue can hold all frames of the transport, so pushes never fail
+        _queues[num_queues].reset(new sid_queue_t(
+            sid, std::max<size_t>(_xport->get_num_recv_frames(), 1)));
+        _num_queues.store(num_queues + 1, std::memory_order_release);
+        return _queues[num_queues]->queue;
+    }
 
-        recv_packet_demuxer_3000::sptr _demux;
-        transport::zero_copy_if::sptr _xport;
-        const uint32_t _sid;
-    };
+    /*! Drain up to DEMUX_BATCH frames from the transport into the queues
+     *
+     * Only waits for the first frame. Must hold the demux mutex.
+     */
+    void _demux(const double timeout)
+    {
+        transport::managed_recv_buffer::sptr buff = _xport->get_recv_buff(timeout);
+        for (size_t i = 0; buff and i < transport::DEMUX_BATCH; i++) {
+            // ASSUME that the data is in little endian format
+            const uint32_t new_sid = uhd::wtohx(buff->cast<const uint32_t*>()[1]);
+            sid_queue_t* sid_queue = _find_queue(new_sid);
+            if (not sid_queue) {
+                UHD_LOGGER_ERROR("STREAMER") << "recv packet demuxer unexpected sid 0x"
+                                             << std::hex << new_sid << std::dec;
+            } else {
+                sid_queue->queue.push_with_haste(buff);
+            }
+            buff.reset();
+            if (i + 1 < transport::DEMUX_BATCH) {
+                buff = _xport->get_recv_buff(0.0);
+            }
+        }
+    }
 
-    inline transport::zero_copy_if::sptr recv_packet_demuxer_3000::make_proxy(const uint32_t sid)
+    transport::zero_copy_if::sptr _xport;
+    std::unique_ptr<sid_queue_t> _queues[MAX_NUM_SIDS];
+    //! Number of entries of _queues in use, they are never removed
+    std::atomic<size_t> _num_queues;
+    //! Serializes adding queues
+    boost::mutex _queues_mutex;
+    //! Held by the thread that demuxes
+    boost::mutex _demux_mutex;
+};
+
+struct recv_packet_demuxer_proxy_3000 : transport::zero_copy_if
+{
+    recv_packet_demuxer_proxy_3000(recv_packet_demuxer_3000::sptr demux,
+        transport::zero_copy_if::sptr xport,
+        const uint32_t sid)
+        : _demux(demux), _xport(xport), _sid(sid)
     {
-        return transport::zero_copy_if::sptr(new recv_packet_demuxer_proxy_3000(this->shared_from_this(), _xport, sid));
+        _demux->realloc_sid(_sid); // causes clear
     }
 
-}} //namespace uhd::usrp
+    ~recv_packet_demuxer_proxy_3000(void)
+    {
+        _demux->realloc_sid(_sid); // causes clear
+    }
+
+    size_t get_num_recv_frames(void) const
+    {
+        return _xport->get_num_recv_frames();
+    }
+    size_t get_recv_frame_size(void) const
+    {
+        return _xport->get_recv_frame_size();
+    }
+    transport::managed_recv_buffer::sptr get_recv_buff(double timeout)
+    {
+        return _demux->get_recv_buff(_sid, timeout);
+    }
+    size_t get_num_send_frames(void) const
+    {
+        return _xport->get_num_send_frames();
+    }
+    size_t get_send_frame_size(void) const
+    {
+        return _xport->get_send_frame_size();
+    }
+    transport::managed_send_buffer::sptr get_send_buff(double timeout)
+    {
+        return _xport->get_send_buff(timeout);
+    }
+
+    recv_packet_demuxer_3000::sptr _demux;
+    transport::zero_copy_if::sptr _xport;
+    const uint32_t _sid;
+};
+
+inline transport::zero_copy_if::sptr recv_packet_demuxer_3000::make_proxy(
+    const uint32_t sid)
+{
+    return transport::zero_copy_if::sptr(
+        new recv_packet_demuxer_proxy_3000(this->shared_from_this(), _xport, sid));
+}
+
+}} // namespace uhd::usrp
 
 #endif /* INCLUDED_LIBUHD_USRP_COMMON_RECV_PACKET_DEMUXER_3000_HPP */
@@ -8,8 +8,25 @@
 #ifndef INCLUDED_LIBUHD_DSP_CORE_UTILS_HPP
 #define INCLUDED_LIBUHD_DSP_CORE_UTILS_HPP
 
+#include <uhd/types/time_spec.hpp>
 #include <stdint.h>
 
+/*! A precomputed DSP frequency: the frequency word for the CORDIC, and
+ *  the frequency it results in
+ */
+struct dsp_freq_word_t
+{
+    double freq;
+    int32_t word;
+};
+
+//! A DSP frequency to apply at a command time
+struct dsp_freq_hop_t
+{
+    uhd::time_spec_t time;
+    dsp_freq_word_t freq_word;
+};
+
 /*! For a requested frequency and sampling rate, return the
  *  correct frequency word (to set the CORDIC) and the actual frequency.
  */
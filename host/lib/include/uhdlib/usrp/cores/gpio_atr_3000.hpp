@@ -15,6 +15,7 @@
 #include <uhdlib/usrp/gpio_defs.hpp>
 #include <uhd/types/wb_iface.hpp>
 #include <boost/shared_ptr.hpp>
+#include <vector>
 
 namespace uhd { namespace usrp { namespace gpio_atr {
 
@@ -80,6 +81,37 @@ public:
      */
     virtual void set_gpio_out(const uint32_t value, const uint32_t mask = MASK_SET_ALL) = 0;
 
+    //! One step of a timed GPIO output pattern, see set_gpio_out_sequence()
+    struct sequence_entry_t
+    {
+        uhd::time_spec_t time;
+        uint32_t mask;
+        uint32_t value;
+    };
+
+    /*!
+     * Write a timed pattern to the static GPIO outputs
+     *
+     * Each entry is identical to set_gpio_out(value, mask) at the command
+     * time of the entry, but the writes are streamed to the device at once.
+     * All of them are queued before the first one executes, so the entries
+     * can be as close as the device runs its commands.
+     *
+     * \param entries the pattern, sorted by time, at most
+     *                get_max_sequence_len() entries
+     * \throws uhd::value_error if the entries are not sorted or don't fit
+     *         into the command FIFO
+     */
+    virtual void set_gpio_out_sequence(const std::vector<sequence_entry_t>& entries) = 0;
+
+    /*!
+     * Get the most entries that set_gpio_out_sequence() takes
+     *
+     * \return the size of the command FIFO, or 0 if the register iface
+     *         doesn't report one (then there is no limit)
+     */
+    virtual size_t get_max_sequence_len() = 0;
+
     /*!
      * Read the state of the GPIO pins
      * If a pin is configured as an input, reads the actual value of the pin
@@ -14,6 +14,8 @@
 #include <uhd/types/wb_iface.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/utility.hpp>
+#include <functional>
+#include <future>
 #include <string>
 
 /*!
@@ -35,12 +37,45 @@ public:
         const std::string &name = "0"
     );
 
+    /*! Read a register without waiting for the response
+     *
+     * The readback request is sent right away, and the lock on the control
+     * path is released before the response arrives. Other peeks and pokes may
+     * go out in the meantime. Calling get() on the result blocks until the
+     * response is in.
+     *
+     * The future must not be waited on after this object is destroyed. The
+     * response is kept until get() is called, so don't drop the future.
+     *
+     * \throws uhd::io_error from get() if the response is missing or malformed
+     */
+    virtual std::shared_future<uint32_t> peek32_async(const wb_addr_type addr) = 0;
+
+    //! 64-bit version of peek32_async()
+    virtual std::shared_future<uint64_t> peek64_async(const wb_addr_type addr) = 0;
+
     //! Hold a ref to a task thats feeding push response
     virtual void hold_task(uhd::msg_task::sptr task) = 0;
 
     //! Push a response externall (resp_xport is NULL)
     virtual void push_response(const uint32_t *buff) = 0;
 
+    /*! Pulls responses off a shared transport, see set_response_pump()
+     *
+     * Called with the time it may block. Returns false if it can't pull right
+     * now, e.g. because another thread is doing it.
+     */
+    typedef std::function<bool(double)> response_pump_t;
+
+    /*! Let the waiting thread pull in its own responses (resp_xport is NULL)
+     *
+     * Instead of only waiting for another thread to push_response(), a thread
+     * that waits for a response calls the pump, which is expected to
+     * push_response() what it pulls in. If the pump returns false, the thread
+     * waits for a pushed response instead.
+     */
+    virtual void set_response_pump(const response_pump_t &pump) = 0;
+
     //! Set the command time that will activate
     virtual void set_time(const uhd::time_spec_t &time) = 0;
 
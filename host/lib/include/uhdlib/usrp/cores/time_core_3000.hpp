@@ -47,6 +47,26 @@ public:
 
     virtual void set_time_next_pps(const uhd::time_spec_t &time) = 0;
 
+    /*!
+     * Answer get_time_now() from a host side model of the device time
+     *
+     * The model is calibrated with a readback whenever its error estimate
+     * exceeds max_error, so most calls don't need a round trip. Setting the
+     * time starts the model over.
+     *
+     * \param max_error the largest error estimate to accept in seconds,
+     *                  0 reads the time on every call (the default)
+     */
+    virtual void set_time_model(const double max_error) = 0;
+
+    /*!
+     * Get the error estimate of get_time_now() in seconds
+     *
+     * \return the error estimate of the model right now, or 0 if there is no
+     *         model and every call reads the time
+     */
+    virtual double get_time_error(void) = 0;
+
 };
 
 #endif /* INCLUDED_LIBUHD_USRP_TIME_CORE_3000_HPP */
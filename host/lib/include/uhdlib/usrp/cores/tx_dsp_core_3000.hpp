@@ -14,7 +14,9 @@
 #include <uhd/types/ranges.hpp>
 #include <uhd/types/wb_iface.hpp>
 #include <uhd/utils/noncopyable.hpp>
+#include <uhdlib/usrp/cores/dsp_core_utils.hpp>
 #include <boost/shared_ptr.hpp>
+#include <vector>
 
 class tx_dsp_core_3000 : uhd::noncopyable
 {
@@ -45,6 +47,27 @@ public:
 
     virtual double get_freq(void) = 0;
 
+    /*!
+     * Compute the frequency word for a DSP frequency, see set_freq(). The
+     * result is only valid until the tick rate changes.
+     */
+    virtual dsp_freq_word_t get_freq_word(const double freq) = 0;
+
+    /*!
+     * Retune to a frequency word from get_freq_word(). This is a single
+     * register write, which is timed if the control interface has a command
+     * time set.
+     * \return the new DSP frequency
+     */
+    virtual double set_freq_word(const dsp_freq_word_t& freq_word) = 0;
+
+    /*!
+     * Schedule a list of retunes, a timed register write each. Requires a
+     * timed control interface; its command time is restored afterwards.
+     * get_freq() returns the frequency of the last hop right away.
+     */
+    virtual void set_freq_hops(const std::vector<dsp_freq_hop_t>& hops) = 0;
+
     virtual void setup(const uhd::stream_args_t& stream_args) = 0;
 
     virtual void populate_subtree(uhd::property_tree::sptr subtree) = 0;
@@ -0,0 +1,51 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_UTILS_CPU_AFFINITY_HPP
+#define INCLUDED_UHDLIB_UTILS_CPU_AFFINITY_HPP
+
+#include <string>
+#include <vector>
+
+namespace uhd {
+
+/*!
+ * Parse a list of CPUs, e.g. "3", "2-5" or "0:2:4-7".
+ *
+ * Device args can't contain commas, so both ':' and ',' separate entries.
+ * This also accepts the format of the Linux sysfs cpulist files.
+ *
+ * \param cpu_list the list to parse
+ * \return the CPU numbers in the order given
+ * \throws uhd::value_error if the list is malformed
+ */
+std::vector<size_t> parse_cpu_list(const std::string& cpu_list);
+
+/*!
+ * Return the CPUs that are local to the network interface (i.e., on the
+ * same NUMA node as the NIC) that owns a local IPv4 address.
+ *
+ * \param local_addr a local IPv4 address as a dotted string
+ * \return the CPU numbers, or an empty list if they can't be determined
+ *         (e.g., for virtual interfaces or on systems without sysfs)
+ */
+std::vector<size_t> get_net_local_cpus(const std::string& local_addr);
+
+/*!
+ * Resolve the value of a thread placement arg such as recv_offload_cpu.
+ *
+ * \param arg a CPU list (see parse_cpu_list()), or "nic" for the CPUs local
+ *            to the network interface that owns local_addr
+ * \param local_addr the local IPv4 address of the transport, used for "nic"
+ * \return the CPU numbers, empty if the arg is empty or "nic" can't be
+ *         resolved
+ */
+std::vector<size_t> get_cpu_affinity_arg(
+    const std::string& arg, const std::string& local_addr = "");
+
+} /* namespace uhd */
+
+#endif /* INCLUDED_UHDLIB_UTILS_CPU_AFFINITY_HPP */
@@ -0,0 +1,88 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_UTILS_DEADLINE_HPP
+#define INCLUDED_UHDLIB_UTILS_DEADLINE_HPP
+
+#include <algorithm>
+#include <chrono>
+
+namespace uhd {
+
+/*! The point in time at which a call with a timeout has to return
+ *
+ * API calls take a relative timeout in seconds, but may wait several times
+ * internally, e.g. once per packet. Turning the timeout into a deadline at
+ * the entry of the call, and handing each wait only the time that remains,
+ * keeps the whole call within its timeout.
+ *
+ * Once the deadline has passed, remaining() returns 0.0, so the waits turn
+ * into polls: what is already there is still taken, but nothing is waited
+ * for. A timeout of zero or less makes a poll deadline, which never reads
+ * the clock.
+ */
+class deadline_t
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    //! Longest timeout in seconds, longer ones are cut to it to avoid overflows
+    static constexpr double MAX_TIMEOUT = 365.0 * 24 * 3600;
+
+    //! Make a deadline \p timeout seconds after \p now
+    explicit deadline_t(const double timeout, const clock::time_point now = clock::now())
+        : _poll(not(timeout > 0.0))
+        , _exit_time(_poll ? clock::time_point()
+                           : now
+                                 + std::chrono::duration_cast<clock::duration>(
+                                     std::chrono::duration<double>(
+                                         std::min(timeout, double(MAX_TIMEOUT)))))
+    {
+    }
+
+    //! Make a deadline that has always passed, without reading the clock
+    static deadline_t poll(void)
+    {
+        return deadline_t();
+    }
+
+    //! True if this deadline was made from a timeout of zero or less
+    bool is_poll(void) const
+    {
+        return _poll;
+    }
+
+    //! Return the point in time of the deadline
+    clock::time_point get_exit_time(void) const
+    {
+        return _exit_time;
+    }
+
+    //! True if the deadline has passed
+    bool expired(const clock::time_point now = clock::now()) const
+    {
+        return _poll or now >= _exit_time;
+    }
+
+    //! Return the seconds until the deadline, or 0.0 once it has passed
+    double remaining(const clock::time_point now = clock::now()) const
+    {
+        if (_poll) {
+            return 0.0;
+        }
+        return std::max(0.0, std::chrono::duration<double>(_exit_time - now).count());
+    }
+
+private:
+    deadline_t(void) : _poll(true) {}
+
+    bool _poll;
+    clock::time_point _exit_time;
+};
+
+} // namespace uhd
+
+#endif /* INCLUDED_UHDLIB_UTILS_DEADLINE_HPP */
@@ -0,0 +1,85 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_UTILS_DISCOVERY_CACHE_HPP
+#define INCLUDED_UHDLIB_UTILS_DISCOVERY_CACHE_HPP
+
+#include <uhd/types/device_addr.hpp>
+#include <string>
+
+namespace uhd {
+
+/*! A file of previously discovered network devices
+ *
+ * Device discovery broadcasts on every interface and waits for the full
+ * timeout. If the devices are known from a previous discovery, unicast
+ * requests to their addresses are enough to find them again, and the
+ * finders can return as soon as the device with the requested serial
+ * replies.
+ *
+ * Only devices with a serial and an address (addr or mgmt_addr) are cached.
+ * Entries are keyed on the serial; a newer discovery of the same serial
+ * replaces the old entry.
+ */
+class discovery_cache
+{
+public:
+    //! The device arg that enables the cache
+    static constexpr char ENABLE_KEY[] = "discovery_cache";
+
+    /*! Load the cache file at path, if it exists
+     *
+     * A missing or unreadable file results in an empty cache.
+     */
+    explicit discovery_cache(const std::string& path);
+
+    //! Return the path of the per-user cache file
+    static std::string get_default_path();
+
+    /*! Return true if the cache may be used for discovery with this hint
+     *
+     * It may not if the cache is not enabled, or if the hint already
+     * contains addresses or a resource, i.e., discovery won't broadcast.
+     */
+    static bool can_use(const device_addr_t& hint);
+
+    /*! Return a unicast discovery hint for every cached device that matches
+     *  the given hint
+     *
+     * Each returned hint is the given hint plus the address, serial and, if
+     * not already given, the type of the cached device.
+     */
+    device_addrs_t get_hints(const device_addr_t& hint) const;
+
+    /*! Add discovered devices, replacing any entries with the same serial
+     *
+     * Devices without a serial or address are ignored.
+     */
+    void add(const device_addrs_t& dev_addrs);
+
+    //! Remove the entry for a device that did not respond to its hint
+    void remove(const device_addr_t& dev_hint);
+
+    //! Return the cached devices
+    const device_addrs_t& get_entries() const
+    {
+        return _entries;
+    }
+
+    /*! Write the cache file
+     *
+     * Failures are logged, not thrown; the cache is a speed-up only.
+     */
+    void save() const;
+
+private:
+    const std::string _path;
+    device_addrs_t _entries;
+};
+
+} /* namespace uhd */
+
+#endif /* INCLUDED_UHDLIB_UTILS_DISCOVERY_CACHE_HPP */
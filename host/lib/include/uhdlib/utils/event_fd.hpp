@@ -0,0 +1,51 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_UTILS_EVENT_FD_HPP
+#define INCLUDED_UHDLIB_UTILS_EVENT_FD_HPP
+
+#include <uhd/utils/noncopyable.hpp>
+
+namespace uhd {
+
+/*! A counting semaphore that can be waited on with poll(), epoll or io_uring
+ *
+ * The file descriptor is readable while the count is non-zero, so an event
+ * loop can wait for it next to its own descriptors. This is an eventfd where
+ * available and a pipe on other POSIX systems. On Windows, get_fd() returns
+ * -1 and the other calls do nothing.
+ *
+ * Callers are expected to keep the count in step with a queue of their own,
+ * under the lock of that queue. With a pipe, the count saturates at the pipe
+ * size (usually 64 KiB).
+ */
+class event_fd : uhd::noncopyable
+{
+public:
+    //! \throws uhd::os_error if the descriptor can't be created
+    event_fd(void);
+    ~event_fd(void);
+
+    //! Return the descriptor to poll for readability, or -1 if unsupported
+    int get_fd(void) const
+    {
+        return _read_fd;
+    }
+
+    //! Increment the count
+    void post(void);
+
+    //! Decrement the count, return false if it was zero. Never blocks.
+    bool try_wait(void);
+
+private:
+    int _read_fd  = -1;
+    int _write_fd = -1;
+};
+
+} // namespace uhd
+
+#endif /* INCLUDED_UHDLIB_UTILS_EVENT_FD_HPP */
@@ -0,0 +1,212 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_UTILS_HASHED_DICT_HPP
+#define INCLUDED_UHDLIB_UTILS_HASHED_DICT_HPP
+
+#include <uhd/exception.hpp>
+#include <boost/format.hpp>
+#include <boost/lexical_cast.hpp>
+#include <functional>
+#include <list>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace uhd {
+
+/*! A uhd::dict with hashed lookups
+ *
+ * This has the same interface and behaviour as uhd::dict, including the
+ * insertion order of keys() and vals(), but looks keys up in a hash table
+ * instead of scanning the whole list. Use it for tables which grow with the
+ * size of the system, like registries and per-motherboard tables.
+ *
+ * \tparam Hash Hash function object for Key
+ */
+template <typename Key, typename Val, typename Hash = std::hash<Key>>
+class hashed_dict
+{
+public:
+    hashed_dict(void) = default;
+
+    /*!
+     * Input iterator constructor, see uhd::dict. Later duplicates of a key
+     * overwrite earlier ones.
+     */
+    template <typename InputIterator>
+    hashed_dict(InputIterator first, InputIterator last)
+    {
+        for (; first != last; ++first) {
+            set(first->first, first->second);
+        }
+    }
+
+    hashed_dict(const hashed_dict& other) : _items(other._items)
+    {
+        reindex();
+    }
+
+    hashed_dict& operator=(const hashed_dict& other)
+    {
+        if (this != &other) {
+            _items = other._items;
+            reindex();
+        }
+        return *this;
+    }
+
+    // Moving a std::list keeps its nodes, so the index remains valid
+    hashed_dict(hashed_dict&&) = default;
+    hashed_dict& operator=(hashed_dict&&) = default;
+
+    std::size_t size(void) const
+    {
+        return _items.size();
+    }
+
+    //! Return the keys in insertion order
+    std::vector<Key> keys(void) const
+    {
+        std::vector<Key> keys;
+        keys.reserve(_items.size());
+        for (const pair_t& p : _items) {
+            keys.push_back(p.first);
+        }
+        return keys;
+    }
+
+    //! Return the values in insertion order
+    std::vector<Val> vals(void) const
+    {
+        std::vector<Val> vals;
+        vals.reserve(_items.size());
+        for (const pair_t& p : _items) {
+            vals.push_back(p.second);
+        }
+        return vals;
+    }
+
+    bool has_key(const Key& key) const
+    {
+        return _index.count(key) != 0;
+    }
+
+    //! Return the value at \p key, or \p other if there is none
+    const Val& get(const Key& key, const Val& other) const
+    {
+        const auto it = _index.find(key);
+        return (it == _index.end()) ? other : it->second->second;
+    }
+
+    //! Return the value at \p key, or throw a uhd::key_error
+    const Val& get(const Key& key) const
+    {
+        const auto it = _index.find(key);
+        if (it == _index.end()) {
+            throw_key_not_found(key);
+        }
+        return it->second->second;
+    }
+
+    void set(const Key& key, const Val& val)
+    {
+        (*this)[key] = val;
+    }
+
+    //! Return the value at \p key, or throw a uhd::key_error
+    const Val& operator[](const Key& key) const
+    {
+        return get(key);
+    }
+
+    //! Return a reference to the value at \p key, which is added if needed
+    Val& operator[](const Key& key)
+    {
+        const auto it = _index.find(key);
+        if (it != _index.end()) {
+            return it->second->second;
+        }
+        _items.push_back(std::make_pair(key, Val()));
+        _index.emplace(key, std::prev(_items.end()));
+        return _items.back().second;
+    }
+
+    bool operator==(const hashed_dict& other) const
+    {
+        if (size() != other.size()) {
+            return false;
+        }
+        for (const pair_t& p : _items) {
+            const auto it = other._index.find(p.first);
+            if (it == other._index.end() or not(it->second->second == p.second)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool operator!=(const hashed_dict& other) const
+    {
+        return not(*this == other);
+    }
+
+    //! Remove the item at \p key and return its value, or throw a uhd::key_error
+    Val pop(const Key& key)
+    {
+        const auto it = _index.find(key);
+        if (it == _index.end()) {
+            throw_key_not_found(key);
+        }
+        Val val = it->second->second;
+        _items.erase(it->second);
+        _index.erase(it);
+        return val;
+    }
+
+    //! Copy all items of \p new_dict into this one, see uhd::dict::update()
+    void update(const hashed_dict& new_dict, bool fail_on_conflict = true)
+    {
+        for (const pair_t& p : new_dict._items) {
+            if (fail_on_conflict and has_key(p.first) and get(p.first) != p.second) {
+                throw uhd::value_error(
+                    str(boost::format("Option merge conflict: %s:%s != %s:%s") % p.first
+                        % get(p.first) % p.first % p.second));
+            }
+            set(p.first, p.second);
+        }
+    }
+
+private:
+    typedef std::pair<Key, Val> pair_t;
+    typedef std::list<pair_t> items_type;
+
+    void reindex(void)
+    {
+        _index.clear();
+        for (auto it = _items.begin(); it != _items.end(); ++it) {
+            _index.emplace(it->first, it);
+        }
+    }
+
+    [[noreturn]] static void throw_key_not_found(const Key& key)
+    {
+        throw uhd::key_error(
+            str(boost::format("key \"%s\" not found in hashed_dict(%s, %s)")
+                % boost::lexical_cast<std::string>(key) % typeid(Key).name()
+                % typeid(Val).name()));
+    }
+
+    //! The items in insertion order
+    items_type _items;
+    //! Where to find each key in _items
+    std::unordered_map<Key, typename items_type::iterator, Hash> _index;
+};
+
+} // namespace uhd
+
+#endif /* INCLUDED_UHDLIB_UTILS_HASHED_DICT_HPP */
@@ -0,0 +1,24 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_UTILS_LOAD_MODULES_HPP
+#define INCLUDED_UHDLIB_UTILS_LOAD_MODULES_HPP
+
+namespace uhd {
+
+/*! Load all modules in the module paths (see uhd::get_module_paths())
+ *
+ * The modules are loaded on the first call only, later calls return right
+ * away. Call this before looking up anything that a module can register,
+ * such as devices or image loaders.
+ *
+ * Does not throw, errors loading a module are printed to stderr.
+ */
+void load_modules(void);
+
+} /* namespace uhd */
+
+#endif /* INCLUDED_UHDLIB_UTILS_LOAD_MODULES_HPP */
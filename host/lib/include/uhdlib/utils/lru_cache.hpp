@@ -0,0 +1,99 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_UTILS_LRU_CACHE_HPP
+#define INCLUDED_UHDLIB_UTILS_LRU_CACHE_HPP
+
+#include <list>
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace uhd {
+
+/*! A thread-safe, bounded cache that evicts the least recently used entry
+ *
+ * Keys must be ordered by operator<, e.g. a std::tuple of the inputs of a
+ * calculation whose result is cached.
+ */
+template <typename key_t, typename value_t>
+class lru_cache
+{
+public:
+    /*!
+     * \param capacity the maximum number of entries
+     */
+    explicit lru_cache(const size_t capacity) : _capacity(capacity) {}
+
+    /*! Look up an entry, and mark it as most recently used
+     *
+     * \param key the key of the entry
+     * \param value is set to the cached value if the entry exists
+     * \return true if the entry exists
+     */
+    bool get(const key_t& key, value_t& value)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        const auto it = _index.find(key);
+        if (it == _index.end()) {
+            return false;
+        }
+        _entries.splice(_entries.begin(), _entries, it->second);
+        value = it->second->second;
+        return true;
+    }
+
+    /*! Add or replace an entry, evicting the least recently used entry
+     *  if the cache is full
+     */
+    void put(const key_t& key, const value_t& value)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        const auto it = _index.find(key);
+        if (it != _index.end()) {
+            it->second->second = value;
+            _entries.splice(_entries.begin(), _entries, it->second);
+            return;
+        }
+        if (_capacity == 0) {
+            return;
+        }
+        if (_entries.size() >= _capacity) {
+            _index.erase(_entries.back().first);
+            _entries.pop_back();
+        }
+        _entries.emplace_front(key, value);
+        _index.emplace(key, _entries.begin());
+    }
+
+    //! Return the number of entries
+    size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _entries.size();
+    }
+
+    //! Remove all entries
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _index.clear();
+        _entries.clear();
+    }
+
+private:
+    typedef std::list<std::pair<key_t, value_t>> entry_list_t;
+
+    const size_t _capacity;
+    mutable std::mutex _mutex;
+    //! Entries, most recently used first
+    entry_list_t _entries;
+    std::map<key_t, typename entry_list_t::iterator> _index;
+};
+
+} /* namespace uhd */
+
+#endif /* INCLUDED_UHDLIB_UTILS_LRU_CACHE_HPP */
@@ -0,0 +1,166 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_UTILS_PER_THREAD_QUEUE_HPP
+#define INCLUDED_UHDLIB_UTILS_PER_THREAD_QUEUE_HPP
+
+#include <uhdlib/transport/spsc_bounded_buffer.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace uhd {
+
+/*! A many-producer, single-consumer queue that never blocks the producers
+ *
+ * Every producer thread gets its own lock-free SPSC ring, which is created on
+ * its first push(). Pushing is therefore only a few atomic operations, and
+ * producers never contend with each other. If a thread's ring is full, the
+ * element is dropped and counted instead of waiting for the consumer.
+ *
+ * The consumer periodically calls drain(), which empties all rings, and can
+ * wait for new elements with wait().
+ *
+ * Elements pushed by the same thread are drained in order. There is no order
+ * between elements of different threads.
+ */
+template <typename elem_type> class per_thread_queue
+{
+public:
+    /*!
+     * \param capacity The number of elements that each thread can queue
+     */
+    per_thread_queue(const size_t capacity) : _capacity(capacity), _id(_next_id()) {}
+
+    /*! Queue an element. Never blocks.
+     *
+     * \returns false if this thread's ring was full, and the element was
+     *          dropped.
+     */
+    bool push(const elem_type& elem)
+    {
+        if (not _get_ring()->push_with_haste(elem)) {
+            _dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        _pending.store(true);
+        if (_consumer_waiting.load()) {
+            std::lock_guard<std::mutex> l(_wait_mutex);
+            _wait_cond.notify_one();
+        }
+        return true;
+    }
+
+    /*! Pop all queued elements and pass them to \p handler
+     *
+     * Must only be called from the consumer thread.
+     *
+     * \returns the number of elements that were popped
+     */
+    template <typename handler_type> size_t drain(handler_type handler)
+    {
+        std::vector<ring_sptr> rings;
+        {
+            std::lock_guard<std::mutex> l(_rings_mutex);
+            rings = _rings;
+            // If only _rings and our copy reference a ring, the thread that
+            // owned it has exited, and nothing more can be pushed. Forget
+            // about it, it gets emptied below one last time.
+            for (auto it = _rings.begin(); it != _rings.end();) {
+                if (it->use_count() == 2) {
+                    it = _rings.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+        size_t count = 0;
+        elem_type elem;
+        for (auto& ring : rings) {
+            while (ring->pop_with_haste(elem)) {
+                handler(elem);
+                count++;
+            }
+        }
+        return count;
+    }
+
+    /*! Wait until an element was pushed, or wake() was called, or timeout
+     *
+     * Must only be called from the consumer thread.
+     */
+    void wait(const double timeout)
+    {
+        std::unique_lock<std::mutex> l(_wait_mutex);
+        _consumer_waiting.store(true);
+        _wait_cond.wait_for(l,
+            std::chrono::microseconds(int64_t(timeout * 1e6)),
+            [this] { return _pending.exchange(false); });
+        _consumer_waiting.store(false);
+    }
+
+    //! Wake up the consumer from wait(), e.g. to shut it down
+    void wake()
+    {
+        std::lock_guard<std::mutex> l(_wait_mutex);
+        _pending.store(true);
+        _wait_cond.notify_one();
+    }
+
+    //! Return the number of dropped elements since the last call
+    size_t get_and_reset_dropped()
+    {
+        return _dropped.exchange(0, std::memory_order_relaxed);
+    }
+
+private:
+    using ring_t    = uhd::transport::spsc_bounded_buffer<elem_type>;
+    using ring_sptr = std::shared_ptr<ring_t>;
+
+    //! Return this thread's ring, create and register it if necessary
+    ring_t* _get_ring()
+    {
+        // The owner check allows for more than one queue of the same type.
+        // A thread that alternates between such queues gets a new ring every
+        // time it switches, so keep one queue per element type for hot paths.
+        thread_local uint64_t owner = 0;
+        thread_local ring_sptr ring;
+        if (owner != _id) {
+            ring = std::make_shared<ring_t>(_capacity);
+            std::lock_guard<std::mutex> l(_rings_mutex);
+            _rings.push_back(ring);
+            owner = _id;
+        }
+        return ring.get();
+    }
+
+    static uint64_t _next_id()
+    {
+        static std::atomic<uint64_t> id{1};
+        return id.fetch_add(1);
+    }
+
+    const size_t _capacity;
+    //! Unique ID of this queue, identifies the owner of a thread's ring
+    const uint64_t _id;
+
+    std::mutex _rings_mutex;
+    std::vector<ring_sptr> _rings;
+
+    std::atomic<size_t> _dropped{0};
+
+    std::mutex _wait_mutex;
+    std::condition_variable _wait_cond;
+    std::atomic<bool> _pending{false};
+    std::atomic<bool> _consumer_waiting{false};
+};
+
+} /* namespace uhd */
+
+#endif /* INCLUDED_UHDLIB_UTILS_PER_THREAD_QUEUE_HPP */
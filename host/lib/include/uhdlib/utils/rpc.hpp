@@ -11,7 +11,11 @@
 #include <rpc/rpc_error.h>
 #include <uhd/utils/log.hpp>
 #include <uhd/exception.hpp>
+#include <uhdlib/utils/trace_events.hpp>
 #include <boost/format.hpp>
+#include <chrono>
+#include <future>
+#include <tuple>
 constexpr uint64_t DEFAULT_RPC_TIMEOUT_MS = 2000;
 namespace uhd {
 
@@ -70,6 +74,8 @@ class rpc_client
     template <typename return_type, typename... Args>
     return_type request(std::string const& func_name, Args&&... args)
     {
+        const uhd::trace_events::scoped_span trace_span(
+            "rpc", [&func_name]() { return func_name; });
         std::lock_guard<std::mutex> lock(_mutex);
         try {
             return _client.call(func_name, std::forward<Args>(args)...)
@@ -105,6 +111,8 @@ class rpc_client
     template <typename return_type, typename... Args>
     return_type request(uint64_t timeout_ms, std::string const& func_name, Args&&... args)
     {
+        const uhd::trace_events::scoped_span trace_span(
+            "rpc", [&func_name]() { return func_name; });
         std::lock_guard<std::mutex> lock(_mutex);
         auto holder = rpcc_timeout_holder(&_client, timeout_ms, _default_timeout_ms);
         try {
@@ -235,6 +243,177 @@ class rpc_client
         notify(timeout_ms, func_name, _token, std::forward<Args>(args)...);
     };
 
+    /*! Handle to the result of an asynchronous RPC request.
+     *
+     * Returned by async_request(). The request is already on the wire when
+     * this object is created; get() blocks until the response arrives (or
+     * the timeout expires) and converts it to \p return_type.
+     *
+     * A future must not outlive the rpc_client that created it.
+     */
+    template <typename return_type>
+    class future
+    {
+      public:
+        /*! Wait for the response and return its value.
+         *
+         * May only be called once.
+         *
+         * \throws uhd::runtime_error in case of failure or timeout
+         */
+        return_type get()
+        {
+            if (_future.wait_for(std::chrono::milliseconds(_timeout_ms))
+                == std::future_status::timeout) {
+                throw uhd::runtime_error(str(
+                    boost::format("Timeout during RPC call to `%s' after %d ms.")
+                    % _func_name % _timeout_ms
+                ));
+            }
+            try {
+                return _future.get().template as<return_type>();
+            } catch (const ::rpc::rpc_error &ex) {
+                std::string error;
+                {
+                    std::lock_guard<std::mutex> lock(_parent->_mutex);
+                    error = _parent->_get_last_error_safe();
+                }
+                if (not error.empty()) {
+                    UHD_LOG_ERROR("RPC", error);
+                }
+                throw uhd::runtime_error(str(
+                    boost::format("Error during RPC call to `%s'. Error message: %s")
+                    % _func_name % (error.empty() ? ex.what() : error)
+                ));
+            } catch (const std::bad_cast& ex) {
+                throw uhd::runtime_error(str(
+                    boost::format("Error during RPC call to `%s'. Error message: %s")
+                    % _func_name % ex.what()
+                ));
+            }
+        }
+
+        /*! Return true if the response is in, so get() won't block
+         *
+         * Lets an event loop poll outstanding requests instead of parking a
+         * thread in get().
+         */
+        bool is_ready() const
+        {
+            return _future.wait_for(std::chrono::seconds(0))
+                   == std::future_status::ready;
+        }
+
+      private:
+        friend class rpc_client;
+
+        future(rpc_client* parent,
+            std::future<RPCLIB_MSGPACK::object_handle>&& fut,
+            const std::string& func_name,
+            const uint64_t timeout_ms)
+            : _parent(parent)
+            , _future(std::move(fut))
+            , _func_name(func_name)
+            , _timeout_ms(timeout_ms)
+        {
+            // nop
+        }
+
+        rpc_client* _parent;
+        std::future<RPCLIB_MSGPACK::object_handle> _future;
+        std::string _func_name;
+        uint64_t _timeout_ms;
+    };
+
+    /*! Start an RPC request without waiting for the response.
+     *
+     * Thread safe (locked). The lock is only held while the request is
+     * queued, so any number of requests can be in flight at the same time.
+     * The server answers them in order; call get() on the returned futures to
+     * collect the results.
+     *
+     * \param timeout_ms is time limit for this RPC call, counted from the
+     *                   call to future::get().
+     * \param func_name The function name that is called via RPC
+     * \param args All these arguments are passed to the RPC call
+     *
+     * \throws uhd::runtime_error if the request could not be queued
+     */
+    template <typename return_type, typename... Args>
+    future<return_type> async_request(
+        uint64_t timeout_ms, std::string const& func_name, Args&&... args)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        try {
+            return future<return_type>(this,
+                _client.async_call(func_name, std::forward<Args>(args)...),
+                func_name,
+                timeout_ms);
+        } catch (const std::exception& ex) {
+            throw uhd::runtime_error(str(
+                boost::format("Error during RPC call to `%s'. Error message: %s")
+                % func_name % ex.what()
+            ));
+        }
+    };
+
+    /*! Like async_request(), but uses the default timeout.
+     */
+    template <typename return_type, typename... Args>
+    future<return_type> async_request(std::string const& func_name, Args&&... args)
+    {
+        return async_request<return_type>(
+            _default_timeout_ms, func_name, std::forward<Args>(args)...);
+    };
+
+    /*! Like async_request(), also provides a token.
+     */
+    template <typename return_type, typename... Args>
+    future<return_type> async_request_with_token(
+        std::string const& func_name, Args&&... args)
+    {
+        return async_request<return_type>(func_name, _token, std::forward<Args>(args)...);
+    };
+
+    /*! Like async_request_with_token(), but it can be specified different timeout
+     * than default.
+     */
+    template <typename return_type, typename... Args>
+    future<return_type> async_request_with_token(
+        uint64_t timeout_ms, std::string const& func_name, Args&&... args)
+    {
+        return async_request<return_type>(
+            timeout_ms, func_name, _token, std::forward<Args>(args)...);
+    };
+
+    /*! Run the same RPC function once for every element of \p args, with a
+     * token, in a single RPC call.
+     *
+     * Uses the `batch` call of the MPM RPC server, which checks the token
+     * once and runs all calls back to back. Only works with servers that
+     * provide `batch`. If any call fails, the whole batch fails.
+     *
+     * \param timeout_ms is time limit for the entire batch.
+     * \param func_name The function name that is called for every argument
+     * \param args One argument per call
+     * \returns The results, in the same order as \p args
+     *
+     * \throws uhd::runtime_error in case of failure
+     */
+    template <typename return_type, typename arg_type>
+    std::vector<return_type> request_server_batch_with_token(uint64_t timeout_ms,
+        std::string const& func_name,
+        const std::vector<arg_type>& args)
+    {
+        std::vector<std::tuple<std::string, std::tuple<arg_type>>> calls;
+        calls.reserve(args.size());
+        for (const auto& arg : args) {
+            calls.emplace_back(func_name, std::make_tuple(arg));
+        }
+        return request_with_token<std::vector<return_type>>(
+            timeout_ms, "batch", calls);
+    };
+
     /*! Sets the token value. This is used by the `_with_token` methods.
      */
     void set_token(const std::string &token)
@@ -0,0 +1,91 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_UTILS_STAGED_INIT_HPP
+#define INCLUDED_UHDLIB_UTILS_STAGED_INIT_HPP
+
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace uhd {
+
+/*! Runs the phases of a device initialization, and times them
+ *
+ * A phase runs a function for each of a number of units (e.g., motherboards),
+ * concurrently unless the init is serialized. Phases run one after the
+ * other, so a phase may depend on all units having finished the ones before
+ * it. Units can time their own steps within a phase with time_step().
+ *
+ * get_report() returns how long each phase and step took, including the
+ * slowest unit, which is usually what holds up the others.
+ */
+class staged_init
+{
+public:
+    typedef std::chrono::duration<double> duration_t;
+
+    /*!
+     * \param log_id the log component for the report
+     * \param serialize if true, run the units of every phase one after the
+     *                  other, in order
+     */
+    staged_init(const std::string& log_id, const bool serialize);
+
+    /*! Run a phase for units 0 to num_units - 1
+     *
+     * Errors don't stop the other units. Once all of them are done, the
+     * exception of the lowest failing unit is rethrown.
+     *
+     * \param name the phase name for the report
+     * \param num_units the number of units
+     * \param phase_fn the function to run for each unit index
+     * \param max_threads at most this many units run at the same time, or
+     *                    any number if zero. A unit starts as soon as
+     *                    another one is done.
+     */
+    void run(const std::string& name,
+        const size_t num_units,
+        const std::function<void(size_t)>& phase_fn,
+        const size_t max_threads = 0);
+
+    /*! Run and time a step of the current phase for one unit
+     *
+     * This may be called concurrently from within the phase function.
+     */
+    void time_step(
+        const std::string& name, const size_t unit, const std::function<void()>& step_fn);
+
+    //! Return a human-readable report of all phase and step times
+    std::string get_report() const;
+
+    //! Log the report
+    void log_report() const;
+
+private:
+    struct timing_t
+    {
+        std::string name;
+        bool is_step;
+        //! Wall time of a phase, zero for steps
+        duration_t total;
+        //! Time of each unit
+        std::vector<duration_t> units;
+    };
+
+    void _add_timing(const std::string& name, const size_t unit, const duration_t time);
+
+    const std::string _log_id;
+    const bool _serialize;
+    mutable std::mutex _timings_mutex;
+    std::vector<timing_t> _timings;
+};
+
+} /* namespace uhd */
+
+#endif /* INCLUDED_UHDLIB_UTILS_STAGED_INIT_HPP */
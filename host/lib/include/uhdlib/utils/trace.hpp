@@ -0,0 +1,103 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_UTILS_TRACE_HPP
+#define INCLUDED_UHDLIB_UTILS_TRACE_HPP
+
+#include <uhd/utils/log.hpp>
+
+/*! \file trace.hpp
+ *
+ * Trace points for fast-path code.
+ *
+ * UHD_TRACE() is meant for code like the streamers and the control
+ * interfaces, where even a disabled UHD_LOG_TRACE() is too expensive. Every
+ * component has its own build-time threshold, UHD_TRACE_MIN_LEVEL_<component>,
+ * which defaults to UHD_TRACE_MIN_LEVEL. Trace points below the threshold are
+ * compiled out entirely, including the evaluation of their arguments.
+ *
+ * Trace points that are compiled in are cheap to skip at runtime: the
+ * arguments are passed by reference, and only formatted if the runtime log
+ * level lets the message through. Example:
+ *
+ *     UHD_TRACE(CTRL_IFACE, trace, "poke32 addr=0x", std::hex, addr);
+ *
+ * The thresholds are set with CMake, see cmake/Modules/UHDLog.cmake. They use
+ * the same numbers as UHD_LOG_MIN_LEVEL, plus 6 (off).
+ */
+
+//! Default threshold for all trace components (off)
+#ifndef UHD_TRACE_MIN_LEVEL
+#    define UHD_TRACE_MIN_LEVEL 6
+#endif
+
+//! Streamers (super_recv_packet_handler, super_send_packet_handler)
+#ifndef UHD_TRACE_MIN_LEVEL_STREAMER
+#    define UHD_TRACE_MIN_LEVEL_STREAMER UHD_TRACE_MIN_LEVEL
+#endif
+
+//! RFNoC control interface (ctrl_iface)
+#ifndef UHD_TRACE_MIN_LEVEL_CTRL_IFACE
+#    define UHD_TRACE_MIN_LEVEL_CTRL_IFACE UHD_TRACE_MIN_LEVEL
+#endif
+
+//! Radio control core (radio_ctrl_core_3000)
+#ifndef UHD_TRACE_MIN_LEVEL_RADIO_CTRL
+#    define UHD_TRACE_MIN_LEVEL_RADIO_CTRL UHD_TRACE_MIN_LEVEL
+#endif
+
+/*! Emit a trace point
+ *
+ * \param component Component ID, e.g. STREAMER. Selects the build-time
+ *                  threshold and is also used as the log component.
+ * \param level Severity level without namespace, e.g. trace
+ * \param ... Message parts, they are streamed into the log message in order
+ */
+#define UHD_TRACE(component, level, ...)                          \
+    do {                                                          \
+        if (uhd::log::level >= UHD_TRACE_MIN_LEVEL_##component) { \
+            uhd::_log::trace(uhd::log::level,                     \
+                #component,                                       \
+                __FILE__,                                         \
+                __LINE__,                                         \
+                __VA_ARGS__);                                     \
+        }                                                         \
+    } while (0)
+
+//! \cond
+namespace uhd { namespace _log {
+
+//! Return true if a message of \p level would pass the global log level
+bool is_enabled(const uhd::log::severity_level level);
+
+inline void trace_stream(log&) {}
+
+template <typename T, typename... Args>
+inline void trace_stream(log& logger, const T& arg, const Args&... args)
+{
+    logger << arg;
+    trace_stream(logger, args...);
+}
+
+//! Format and log a trace point, if the runtime log level allows it
+template <typename... Args>
+void trace(const uhd::log::severity_level level,
+    const char* component,
+    const char* file,
+    const unsigned int line,
+    const Args&... args)
+{
+    if (not is_enabled(level)) {
+        return;
+    }
+    log logger(level, file, line, component, boost::this_thread::get_id());
+    trace_stream(logger, args...);
+}
+
+}} // namespace uhd::_log
+//! \endcond
+
+#endif /* INCLUDED_UHDLIB_UTILS_TRACE_HPP */
@@ -0,0 +1,147 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_UTILS_TRACE_EVENTS_HPP
+#define INCLUDED_UHDLIB_UTILS_TRACE_EVENTS_HPP
+
+#include <uhd/config.hpp>
+#include <uhd/types/device_addr.hpp>
+#include <stdint.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <utility>
+
+/*! \file trace_events.hpp
+ *
+ * A timeline of spans and counters across threads, in the Chrome trace event
+ * format. chrome://tracing and the Perfetto UI (ui.perfetto.dev) open the
+ * files.
+ *
+ * Unlike the PROFILE_TIMING() macros of auto_timer.hpp, which log the
+ * duration of one scope as text, this records where the time goes in all
+ * threads at once: device initialization, property sets, expert resolves,
+ * RPC calls, streamer creation and a sample of the streaming calls.
+ *
+ * Recording is started by the UHD_TRACE_FILE environment variable, or by the
+ * trace_file device arg. Either one names the output file, which is written
+ * when the process exits or stop() is called. While nothing is recorded, a
+ * span costs one relaxed atomic load. Example:
+ *
+ *     UHD_TRACE_SPAN("x300", "setup_mb");
+ *     UHD_TRACE_COUNTER("streamer", "rx_overflows", num_overflows);
+ */
+
+//! Record a span from here to the end of the enclosing scope
+#define UHD_TRACE_SPAN(category, name)                           \
+    const uhd::trace_events::scoped_span UHD_TRACE_SPAN_VAR_NAME( \
+        __LINE__)(category, name)
+#define UHD_TRACE_SPAN_VAR_NAME(line) UHD_TRACE_SPAN_VAR_NAME_(line)
+#define UHD_TRACE_SPAN_VAR_NAME_(line) _uhd_trace_span_##line
+
+//! Record the value of a counter at this point in time
+#define UHD_TRACE_COUNTER(category, name, value)             \
+    do {                                                     \
+        if (uhd::trace_events::is_enabled()) {               \
+            uhd::trace_events::counter(category, name, value); \
+        }                                                    \
+    } while (0)
+
+namespace uhd { namespace trace_events {
+
+typedef std::chrono::steady_clock clock;
+
+//! Only every SAMPLE_INTERVAL-th call is recorded by sample()
+static constexpr size_t SAMPLE_INTERVAL = 1024;
+
+//! \cond
+extern UHD_API std::atomic<bool> _enabled;
+//! \endcond
+
+//! Return true while a trace is recorded
+UHD_INLINE bool is_enabled(void)
+{
+    return _enabled.load(std::memory_order_relaxed);
+}
+
+/*! Start recording into a file
+ *
+ * Does nothing if a trace is already recorded.
+ *
+ * \param path the file to write the trace to
+ */
+UHD_API void start(const std::string& path);
+
+//! Start recording if the args contain trace_file
+UHD_API void start(const uhd::device_addr_t& args);
+
+/*! Stop recording and write the file
+ *
+ * \throws uhd::os_error if the file can't be written
+ */
+UHD_API void stop(void);
+
+//! Record a span that started at \p start and ends now
+UHD_API void complete(
+    const char* category, const std::string& name, clock::time_point start);
+
+//! Record the value of a counter
+UHD_API void counter(const char* category, const std::string& name, double value);
+
+/*! Decide if a call on a fast path is recorded
+ *
+ * \param count a counter that belongs to the call site
+ * \return true for every SAMPLE_INTERVAL-th call while a trace is recorded
+ */
+UHD_INLINE bool sample(size_t& count)
+{
+    return is_enabled() and ++count % SAMPLE_INTERVAL == 0;
+}
+
+//! Records a span over its lifetime, if a trace is recorded when it is made
+class scoped_span
+{
+public:
+    scoped_span(const char* category, const char* name, const bool record = true)
+        : _category(record and is_enabled() ? category : nullptr), _name(name)
+    {
+        if (_category) {
+            _start = clock::now();
+        }
+    }
+
+    //! Spans with a name that is only made if a trace is recorded
+    template <typename name_fn_type,
+        typename = decltype(std::string(std::declval<name_fn_type>()()))>
+    scoped_span(const char* category, const name_fn_type& name_fn)
+        : _category(is_enabled() ? category : nullptr), _name(nullptr)
+    {
+        if (_category) {
+            _dyn_name = name_fn();
+            _start    = clock::now();
+        }
+    }
+
+    ~scoped_span(void)
+    {
+        if (_category) {
+            complete(_category, _name ? std::string(_name) : _dyn_name, _start);
+        }
+    }
+
+    scoped_span(const scoped_span&) = delete;
+    scoped_span& operator=(const scoped_span&) = delete;
+
+private:
+    const char* const _category;
+    const char* const _name;
+    std::string _dyn_name;
+    clock::time_point _start;
+};
+
+}} // namespace uhd::trace_events
+
+#endif /* INCLUDED_UHDLIB_UTILS_TRACE_EVENTS_HPP */
@@ -0,0 +1,176 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_UHDLIB_UTILS_WORKER_POOL_HPP
+#define INCLUDED_UHDLIB_UTILS_WORKER_POOL_HPP
+
+#include <uhd/config.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace uhd {
+
+/*!
+ * A small pool of persistent threads to split short, equally sized jobs
+ * (e.g., the per-channel conversion of one packet) across CPU cores.
+ *
+ * run() hands out the indices [0, n) round-robin to the calling thread and
+ * the pool's threads, and returns once all of them are done. The calling
+ * thread is participant 0, the pool's threads are participants 1 through
+ * get_num_workers(). Idle workers poll for new work for a short while before
+ * they go to sleep, so that back-to-back calls to run() don't pay for a
+ * wake-up every time.
+ *
+ * run() must not be called from more than one thread at a time.
+ */
+class worker_pool
+{
+public:
+    typedef std::shared_ptr<worker_pool> sptr;
+
+    /*!
+     * Spawn the worker threads
+     * \param num_workers number of threads in addition to the calling thread
+     */
+    worker_pool(const size_t num_workers)
+        : _generation(0), _pending(0), _num_parked(0), _stop(false)
+    {
+        for (size_t i = 0; i < num_workers; i++) {
+            _threads.emplace_back([this, i]() { _worker_loop(i + 1); });
+        }
+    }
+
+    ~worker_pool(void)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+            _generation++;
+        }
+        _cond.notify_all();
+        for (auto& thread : _threads) {
+            thread.join();
+        }
+    }
+
+    //! Return the number of threads in the pool, excluding the caller
+    size_t get_num_workers(void) const
+    {
+        return _threads.size();
+    }
+
+    /*!
+     * Call fn(index, participant) for every index in [0, n) and wait until
+     * all calls have returned. The participant number can be used to pick
+     * per-thread state, it is smaller than get_num_workers() + 1.
+     *
+     * If any call throws, the first exception is rethrown here once all
+     * participants are done.
+     */
+    template <typename job_type> void run(const size_t n, const job_type& fn)
+    {
+        _job_ctx = &fn;
+        _job_fn  = [](const void* ctx, const size_t index, const size_t participant) {
+            (*static_cast<const job_type*>(ctx))(index, participant);
+        };
+        _num_jobs = n;
+        _error    = nullptr;
+        _pending.store(_threads.size(), std::memory_order_relaxed);
+        _generation.fetch_add(1, std::memory_order_seq_cst);
+        if (_num_parked.load(std::memory_order_seq_cst) > 0) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _cond.notify_all();
+        }
+
+        std::exception_ptr error = _run_share(0);
+
+        size_t polls = 0;
+        while (_pending.load(std::memory_order_acquire) > 0) {
+            if (++polls > SPIN_COUNT) {
+                std::this_thread::yield();
+            }
+        }
+        if (not error) {
+            error = _error;
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+private:
+    //! Number of polls before an idle worker goes to sleep
+    static const size_t SPIN_COUNT = 4096;
+
+    typedef void (*job_fn_type)(const void*, const size_t, const size_t);
+
+    std::exception_ptr _run_share(const size_t participant)
+    {
+        const size_t stride = _threads.size() + 1;
+        try {
+            for (size_t i = participant; i < _num_jobs; i += stride) {
+                _job_fn(_job_ctx, i, participant);
+            }
+        } catch (...) {
+            return std::current_exception();
+        }
+        return nullptr;
+    }
+
+    void _worker_loop(const size_t participant)
+    {
+        size_t seen = 0;
+        while (true) {
+            size_t polls = 0;
+            while (_generation.load(std::memory_order_acquire) == seen) {
+                if (++polls < SPIN_COUNT) {
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock(_mutex);
+                _num_parked.fetch_add(1, std::memory_order_seq_cst);
+                _cond.wait(lock, [this, seen]() {
+                    return _generation.load(std::memory_order_seq_cst) != seen;
+                });
+                _num_parked.fetch_sub(1, std::memory_order_relaxed);
+            }
+            seen = _generation.load(std::memory_order_acquire);
+            if (_stop) {
+                return;
+            }
+            std::exception_ptr error = _run_share(participant);
+            if (error) {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (not _error) {
+                    _error = error;
+                }
+            }
+            _pending.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    // Current job, written by run() before the generation is bumped
+    const void* _job_ctx;
+    job_fn_type _job_fn;
+    size_t _num_jobs;
+    std::exception_ptr _error;
+
+    std::atomic<size_t> _generation;
+    std::atomic<size_t> _pending;
+    std::atomic<size_t> _num_parked;
+    bool _stop;
+    std::mutex _mutex;
+    std::condition_variable _cond;
+    std::vector<std::thread> _threads;
+};
+
+} /* namespace uhd */
+
+#endif /* INCLUDED_UHDLIB_UTILS_WORKER_POOL_HPP */
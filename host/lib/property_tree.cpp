@@ -7,13 +7,27 @@
 //
 
 #include <uhd/property_tree.hpp>
-#include <uhd/types/dict.hpp>
+#include <uhd/utils/safe_call.hpp>
+#include <uhdlib/utils/trace_events.hpp>
 #include <boost/make_shared.hpp>
-#include <boost/thread/mutex.hpp>
+#include <algorithm>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <unordered_set>
 
 using namespace uhd;
 
+namespace {
+
+//! The path of the last property this thread accessed, while tracing. Sets
+// usually come right after an access, so this names their trace spans.
+thread_local std::string last_access_path;
+
+} // namespace
+
 /***********************************************************************
  * Helper function to iterate through paths
  **********************************************************************/
@@ -79,7 +93,6 @@ public:
     sptr subtree(const fs_path& path_) const
     {
         const fs_path path = _root / path_;
-        boost::mutex::scoped_lock lock(_guts->mutex);
 
         property_tree_impl* subtree = new property_tree_impl(path);
         subtree->_guts              = this->_guts; // copy the guts sptr
@@ -88,84 +101,62 @@ public:
 
     void remove(const fs_path& path_)
     {
-        const fs_path path = _root / path_;
-        boost::mutex::scoped_lock lock(_guts->mutex);
+        write_lock_t lock(_guts->mutex);
 
+        std::string leaf;
         node_type* parent = NULL;
-        node_type* node   = &_guts->root;
-        for (const std::string& name : path_tokenizer(path)) {
-            if (not node->has_key(name))
-                throw_path_not_found(path);
-            parent = node;
-            node   = &(*node)[name];
-        }
+        node_type* node   = find_node(path_, &parent, &leaf);
+        if (node == NULL)
+            throw_path_not_found(path_);
         if (parent == NULL)
             throw uhd::runtime_error("Cannot uproot");
-        parent->pop(fs_path(path.leaf()));
+        parent->remove_child(leaf);
     }
 
     bool exists(const fs_path& path_) const
     {
-        const fs_path path = _root / path_;
-        boost::mutex::scoped_lock lock(_guts->mutex);
-
-        node_type* node = &_guts->root;
-        for (const std::string& name : path_tokenizer(path)) {
-            if (not node->has_key(name))
-                return false;
-            node = &(*node)[name];
-        }
-        return true;
+        read_lock_t lock(_guts->mutex);
+        return find_node(path_) != NULL;
     }
 
     std::vector<std::string> list(const fs_path& path_) const
     {
-        const fs_path path = _root / path_;
-        boost::mutex::scoped_lock lock(_guts->mutex);
+        read_lock_t lock(_guts->mutex);
 
-        node_type* node = &_guts->root;
-        for (const std::string& name : path_tokenizer(path)) {
-            if (not node->has_key(name))
-                throw_path_not_found(path);
-            node = &(*node)[name];
-        }
-
-        return node->keys();
+        const node_type* node = find_node(path_);
+        if (node == NULL)
+            throw_path_not_found(path_);
+        return node->keys;
     }
 
     boost::shared_ptr<void> _pop(const fs_path& path_)
     {
-        const fs_path path = _root / path_;
-        boost::mutex::scoped_lock lock(_guts->mutex);
+        write_lock_t lock(_guts->mutex);
 
+        std::string leaf;
         node_type* parent = NULL;
-        node_type* node   = &_guts->root;
-        for (const std::string& name : path_tokenizer(path)) {
-            if (not node->has_key(name))
-                throw_path_not_found(path);
-            parent = node;
-            node   = &(*node)[name];
-        }
-
+        node_type* node   = find_node(path_, &parent, &leaf);
+        if (node == NULL)
+            throw_path_not_found(path_);
         if (node->prop.get() == NULL)
-            throw uhd::runtime_error("Cannot access! Property uninitialized at: " + path);
+            throw uhd::runtime_error(
+                "Cannot access! Property uninitialized at: " + _root / path_);
         if (parent == NULL)
             throw uhd::runtime_error("Cannot pop");
         auto prop = node->prop;
-        parent->pop(fs_path(path.leaf()));
+        parent->remove_child(leaf);
         return prop;
     }
 
     void _create(const fs_path& path_, const boost::shared_ptr<void>& prop)
     {
         const fs_path path = _root / path_;
-        boost::mutex::scoped_lock lock(_guts->mutex);
+        write_lock_t lock(_guts->mutex);
 
         node_type* node = &_guts->root;
         for (const std::string& name : path_tokenizer(path)) {
-            if (not node->has_key(name))
-                (*node)[name] = node_type();
-            node = &(*node)[name];
+            node_type* child = node->find_child(name);
+            node = child ? child : node->add_child(name);
         }
         if (node->prop.get() != NULL)
             throw uhd::runtime_error(
@@ -175,39 +166,120 @@ public:
 
     boost::shared_ptr<void>& _access(const fs_path& path_) const
     {
-        const fs_path path = _root / path_;
-        boost::mutex::scoped_lock lock(_guts->mutex);
+        read_lock_t lock(_guts->mutex);
+        if (trace_events::is_enabled()) {
+            last_access_path = _root / path_;
+        }
+        return access_node(path_)->prop;
+    }
 
-        node_type* node = &_guts->root;
-        for (const std::string& name : path_tokenizer(path)) {
-            if (not node->has_key(name))
-                throw_path_not_found(path);
-            node = &(*node)[name];
+    boost::shared_ptr<void> _access_handle(const fs_path& path_) const
+    {
+        read_lock_t lock(_guts->mutex);
+        if (trace_events::is_enabled()) {
+            last_access_path = _root / path_;
         }
-        if (node->prop.get() == NULL)
-            throw uhd::runtime_error("Cannot access! Property uninitialized at: " + path);
-        return node->prop;
+        return access_node(path_)->prop;
     }
 
 private:
-    void throw_path_not_found(const fs_path& path) const
+    void throw_path_not_found(const fs_path& path_) const
     {
-        throw uhd::lookup_error("Path not found in tree: " + path);
+        throw uhd::lookup_error("Path not found in tree: " + _root / path_);
     }
 
     // basic structural node element
-    struct node_type : uhd::dict<std::string, node_type>
+    struct node_type
     {
         boost::shared_ptr<void> prop;
+        //! Names of the children, in the order they were created
+        std::vector<std::string> keys;
+        std::unordered_map<std::string, std::unique_ptr<node_type>> children;
+
+        node_type* find_child(const std::string& name) const
+        {
+            const auto it = children.find(name);
+            return (it == children.end()) ? NULL : it->second.get();
+        }
+
+        node_type* add_child(const std::string& name)
+        {
+            keys.push_back(name);
+            return (children[name] = std::unique_ptr<node_type>(new node_type)).get();
+        }
+
+        void remove_child(const std::string& name)
+        {
+            keys.erase(std::find(keys.begin(), keys.end(), name));
+            children.erase(name);
+        }
     };
 
+    typedef std::shared_timed_mutex mutex_type;
+    typedef std::shared_lock<mutex_type> read_lock_t;
+    typedef std::unique_lock<mutex_type> write_lock_t;
+
     // tree guts which may be referenced in a subtree
     struct tree_guts_type
     {
         node_type root;
-        boost::mutex mutex;
+        //! Readers (exists, list, access) share this, only changes are exclusive
+        mutable mutex_type mutex;
     };
 
+    /*!
+     * Walk the tree along _root / path_. The caller must hold the lock.
+     *
+     * The path isn't joined or tokenized into new strings, and each level is
+     * a hash lookup, so this is cheap enough for the hot access() path.
+     *
+     * \return the node, or NULL if the path doesn't exist
+     */
+    node_type* find_node(const fs_path& path_,
+        node_type** parent = NULL,
+        std::string* leaf  = NULL) const
+    {
+        node_type* node = &_guts->root;
+        std::string name;
+        for (const std::string* part : {&static_cast<const std::string&>(_root),
+                 &static_cast<const std::string&>(path_)}) {
+            size_t pos = 0;
+            while (pos < part->size()) {
+                size_t end = part->find('/', pos);
+                if (end == std::string::npos) {
+                    end = part->size();
+                }
+                if (end > pos) {
+                    name.assign(*part, pos, end - pos);
+                    if (parent) {
+                        *parent = node;
+                    }
+                    node = node->find_child(name);
+                    if (node == NULL) {
+                        return NULL;
+                    }
+                }
+                pos = end + 1;
+            }
+        }
+        if (leaf) {
+            *leaf = name;
+        }
+        return node;
+    }
+
+    //! Like find_node(), but throws if the path doesn't lead to a property
+    node_type* access_node(const fs_path& path_) const
+    {
+        node_type* node = find_node(path_);
+        if (node == NULL)
+            throw_path_not_found(path_);
+        if (node->prop.get() == NULL)
+            throw uhd::runtime_error(
+                "Cannot access! Property uninitialized at: " + _root / path_);
+        return node;
+    }
+
     // members, the tree and root prefix
     boost::shared_ptr<tree_guts_type> _guts;
     const fs_path _root;
@@ -225,3 +297,70 @@ uhd::property_tree::sptr uhd::property_tree::make(void)
 {
     return sptr(new property_tree_impl());
 }
+
+/***********************************************************************
+ * Deferred property sets
+ **********************************************************************/
+namespace {
+
+struct defer_state_t
+{
+    size_t depth = 0;
+    //! The commit functions, in the order the properties were first set
+    std::vector<boost::function<void(void)>> pending;
+    std::unordered_set<const void*> keys;
+};
+
+thread_local defer_state_t defer_state;
+
+} // namespace
+
+property_defer_scope::property_defer_scope(void)
+    : _outermost(defer_state.depth++ == 0), _committed(false)
+{
+    /* NOP */
+}
+
+property_defer_scope::~property_defer_scope(void)
+{
+    if (not _outermost) {
+        defer_state.depth--;
+        return;
+    }
+    UHD_SAFE_CALL(commit();)
+}
+
+void property_defer_scope::commit(void)
+{
+    if (not _outermost or _committed) {
+        return;
+    }
+    _committed = true;
+    // Sets from within the subscribers take effect immediately
+    defer_state.depth = 0;
+    std::vector<boost::function<void(void)>> pending;
+    pending.swap(defer_state.pending);
+    defer_state.keys.clear();
+    for (const auto& commit_fn : pending) {
+        commit_fn(); // let errors propagate
+    }
+}
+
+bool property_defer_scope::_defer(
+    const void* key, const boost::function<void(void)>& commit_fn)
+{
+    if (defer_state.depth == 0) {
+        if (not trace_events::is_enabled()) {
+            return false;
+        }
+        // Commit right here, under a span
+        const trace_events::scoped_span trace_span(
+            "property_tree", []() { return "set " + last_access_path; });
+        commit_fn();
+        return true;
+    }
+    if (defer_state.keys.insert(key).second) {
+        defer_state.pending.push_back(commit_fn);
+    }
+    return true;
+}
@@ -5,7 +5,6 @@
 //
 
 #include <uhd/exception.hpp>
-#include <uhd/transport/bounded_buffer.hpp>
 #include <uhd/transport/chdr.hpp>
 #include <uhd/transport/zero_copy.hpp>
 #include <uhd/utils/byteswap.hpp>
@@ -13,20 +12,26 @@
 #include <uhd/utils/tasks.hpp>
 #include <uhdlib/rfnoc/async_msg_handler.hpp>
 #include <boost/make_shared.hpp>
+#include <algorithm>
+#include <atomic>
+#include <memory>
 #include <mutex>
+#include <vector>
 
 using namespace uhd;
 using namespace uhd::rfnoc;
 
+namespace {
+
+//! Messages that are dispatched per wakeup of the receive thread, at most
+constexpr size_t ASYNC_MSG_BATCH_SIZE = 32;
+
+} // namespace
+
 template <endianness_t _endianness>
 class async_msg_handler_impl : public async_msg_handler
 {
 public:
-    /************************************************************************
-     * Types
-     ***********************************************************************/
-    typedef uhd::transport::bounded_buffer<async_msg_t> async_md_type;
-
     /************************************************************************
      * Structors
      ***********************************************************************/
@@ -35,6 +40,8 @@ public:
         uhd::sid_t sid)
         : _rx_xport(recv), _tx_xport(send), _sid(sid)
     {
+        _tables.emplace_back(new handler_table_t());
+        _event_handlers.store(_tables.back().get());
         // Launch receive thread
         _recv_msg_task = task::make([=]() { this->handle_async_msgs(); });
     }
@@ -47,16 +54,38 @@ public:
     int register_event_handler(
         const async_msg_t::event_code_t event_code, async_handler_type handler)
     {
-        _event_handlers.insert(std::pair<async_msg_t::event_code_t, async_handler_type>(
-            event_code, handler));
-        return _event_handlers.count(event_code);
+        std::lock_guard<std::mutex> lock(_register_mutex);
+        // Copy on write: Messages that are being dispatched keep using the
+        // old table, which stays valid until this object is destroyed.
+        std::unique_ptr<handler_table_t> table(
+            new handler_table_t(*_event_handlers.load(std::memory_order_relaxed)));
+        table->emplace_back(event_code, handler);
+        const int num_handlers = int(std::count_if(table->cbegin(),
+            table->cend(),
+            [event_code](const handler_table_t::value_type& entry) {
+                return entry.first == event_code;
+            }));
+        _event_handlers.store(table.get(), std::memory_order_release);
+        _tables.push_back(std::move(table));
+        return num_handlers;
     }
 
     void post_async_msg(const async_msg_t& metadata)
     {
-        std::lock_guard<std::mutex> lock(_mutex);
+        dispatch(*_event_handlers.load(std::memory_order_acquire), metadata);
+    }
 
-        for (auto const event_handler : _event_handlers) {
+private: // methods
+    //! Event codes and the handlers registered for them
+    typedef std::vector<std::pair<async_msg_t::event_code_t, async_handler_type>>
+        handler_table_t;
+
+    /************************************************************************
+     * Internals
+     ***********************************************************************/
+    void dispatch(const handler_table_t& event_handlers, const async_msg_t& metadata)
+    {
+        for (auto const& event_handler : event_handlers) {
             // If the event code in the message matches the event code used at
             // registration time, call the event handler
             if ((metadata.event_code & event_handler.first) == event_handler.first) {
@@ -80,11 +109,11 @@ public:
         }
     }
 
-private: // methods
-    /************************************************************************
-     * Internals
-     ***********************************************************************/
     /*! Packet receiver thread call.
+     *
+     * After waiting for one message, this also dispatches the ones that
+     * arrived in the meantime, so bursts of messages (e.g. EOB ACKs of many
+     * short bursts) are handled without waiting in between.
      */
     void handle_async_msgs()
     {
@@ -93,10 +122,31 @@ private: // methods
         if (not buff)
             return;
 
+        const handler_table_t& event_handlers =
+            *_event_handlers.load(std::memory_order_acquire);
+        for (size_t i = 0; buff and i < ASYNC_MSG_BATCH_SIZE; i++) {
+            if (unpack_async_msg(*buff, _metadata)) {
+                dispatch(event_handlers, _metadata);
+            }
+            buff.reset();
+            if (i + 1 < ASYNC_MSG_BATCH_SIZE) {
+                buff = _rx_xport->get_recv_buff(0.0);
+            }
+        }
+    }
+
+    /*! Turn a packet into an async message
+     *
+     * \returns false if the packet is not a valid async message
+     */
+    bool unpack_async_msg(
+        const uhd::transport::managed_recv_buffer& buff, async_msg_t& metadata)
+    {
+        using namespace uhd::transport;
         // Get packet info
         vrt::if_packet_info_t if_packet_info;
-        if_packet_info.num_packet_words32 = buff->size() / sizeof(uint32_t);
-        const uint32_t* packet_buff       = buff->cast<const uint32_t*>();
+        if_packet_info.num_packet_words32 = buff.size() / sizeof(uint32_t);
+        const uint32_t* packet_buff       = buff.cast<const uint32_t*>();
 
         // unpacking can fail
         uint32_t (*endian_conv)(uint32_t) = uhd::ntohx;
@@ -112,17 +162,17 @@ private: // methods
             UHD_LOGGER_ERROR("RFNOC")
                 << "[async message handler] Error parsing async message packet: "
                 << ex.what() << std::endl;
-            return;
+            return false;
         }
 
         // We discard anything that's not actually a command or response packet.
         if (not(if_packet_info.packet_type & vrt::if_packet_info_t::PACKET_TYPE_CMD)
             or if_packet_info.num_packet_words32 == 0) {
-            return;
+            return false;
         }
 
         const uint32_t* payload = packet_buff + if_packet_info.num_header_words32;
-        async_msg_t metadata(if_packet_info.num_payload_words32 - 1);
+        metadata.payload.resize(if_packet_info.num_payload_words32 - 1);
         metadata.has_time_spec = if_packet_info.has_tsf;
         // FIXME: not hardcoding tick rate
         metadata.time_spec  = time_spec_t::from_ticks(if_packet_info.tsf, 1);
@@ -133,8 +183,7 @@ private: // methods
         for (size_t i = 1; i < if_packet_info.num_payload_words32; i++) {
             metadata.payload[i - 1] = endian_conv(payload[i]);
         }
-
-        this->post_async_msg(metadata);
+        return true;
     }
 
     uint32_t get_local_addr() const
@@ -143,9 +192,15 @@ private: // methods
     }
 
 private: // members
-    std::mutex _mutex;
-    //! Store event handlers
-    std::multimap<async_msg_t::event_code_t, async_handler_type> _event_handlers;
+    //! Serializes register_event_handler() calls
+    std::mutex _register_mutex;
+    //! The current handler table, read without locking by the dispatchers
+    std::atomic<const handler_table_t*> _event_handlers;
+    //! All handler tables ever made. Registration is rare, so old tables are
+    //  kept instead of tracking when the dispatchers are done with them.
+    std::vector<std::unique_ptr<handler_table_t>> _tables;
+    //! The message that is being dispatched by the receive thread
+    async_msg_t _metadata;
     //! port that receive messge
     uhd::transport::zero_copy_if::sptr _rx_xport;
 
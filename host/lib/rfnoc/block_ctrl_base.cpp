@@ -318,6 +318,56 @@ void block_ctrl_base::sr_write(
     return sr_write(reg_addr, data, port);
 }
 
+void block_ctrl_base::sr_write(
+    const uint32_t reg, const std::vector<uint32_t>& data, const size_t port)
+{
+    if (not _ctrl_ifaces.count(port)) {
+        throw uhd::key_error(str(boost::format("[%s] sr_write(): No such port: %d")
+                                 % get_block_id().get() % port));
+    }
+    const uint64_t timestamp = _cmd_timespecs[port].to_ticks(_cmd_tickrates[port]);
+    ctrl_iface::cmd_batch batch;
+    for (const uint32_t value : data) {
+        batch.add_cmd(reg, value, timestamp);
+    }
+    try {
+        _ctrl_ifaces[port]->send_cmd_batch(batch);
+    } catch (const std::exception& ex) {
+        throw uhd::io_error(str(boost::format("[%s] sr_write() failed: %s")
+                                % get_block_id().get() % ex.what()));
+    }
+}
+
+void block_ctrl_base::sr_write_schedule(
+    const std::vector<timed_sr_write_t>& writes, const size_t port)
+{
+    if (not _ctrl_ifaces.count(port)) {
+        throw uhd::key_error(
+            str(boost::format("[%s] sr_write_schedule(): No such port: %d")
+                % get_block_id().get() % port));
+    }
+    ctrl_iface::cmd_batch batch;
+    for (const timed_sr_write_t& write : writes) {
+        batch.add_cmd(write.reg, write.data, write.time.to_ticks(_cmd_tickrates[port]));
+    }
+    try {
+        _ctrl_ifaces[port]->send_cmd_batch(batch);
+    } catch (const std::exception& ex) {
+        throw uhd::io_error(str(boost::format("[%s] sr_write_schedule() failed: %s")
+                                % get_block_id().get() % ex.what()));
+    }
+}
+
+size_t block_ctrl_base::get_cmd_fifo_size(const size_t port)
+{
+    if (not _ctrl_ifaces.count(port)) {
+        throw uhd::key_error(
+            str(boost::format("[%s] get_cmd_fifo_size(): No such port: %d")
+                % get_block_id().get() % port));
+    }
+    return _ctrl_ifaces[port]->get_cmd_fifo_size();
+}
+
 uint64_t block_ctrl_base::sr_read64(const settingsbus_reg_t reg, const size_t port)
 {
     if (not _ctrl_ifaces.count(port)) {
@@ -373,6 +423,38 @@ uint64_t block_ctrl_base::user_reg_read64(const std::string& reg, const size_t p
         port);
 }
 
+std::vector<uint64_t> block_ctrl_base::user_reg_read64(
+    const std::vector<uint32_t>& addrs, const size_t port)
+{
+    if (not _ctrl_ifaces.count(port)) {
+        throw uhd::key_error(str(boost::format("[%s] user_reg_read64(): No such port: %d")
+                                 % get_block_id().get() % port));
+    }
+    const uint64_t timestamp = _cmd_timespecs[port].to_ticks(_cmd_tickrates[port]);
+    // Commands are executed in order, so every readback returns the register
+    // selected by the SR_READBACK_ADDR write right before it
+    ctrl_iface::cmd_batch batch;
+    std::vector<ctrl_iface::cmd_batch::readback_t> readbacks;
+    readbacks.reserve(addrs.size());
+    for (const uint32_t addr : addrs) {
+        batch.add_cmd(SR_READBACK_ADDR, addr, timestamp);
+        readbacks.push_back(
+            batch.add_readback(SR_READBACK, SR_READBACK_REG_USER, timestamp));
+    }
+    std::vector<uint64_t> values;
+    values.reserve(addrs.size());
+    try {
+        _ctrl_ifaces[port]->send_cmd_batch(batch);
+        for (auto& readback : readbacks) {
+            values.push_back(readback.get());
+        }
+    } catch (const std::exception& ex) {
+        throw uhd::io_error(str(boost::format("[%s] user_reg_read64() failed: %s")
+                                % get_block_id().get() % ex.what()));
+    }
+    return values;
+}
+
 uint32_t block_ctrl_base::user_reg_read32(const uint32_t addr, const size_t port)
 {
     try {
@@ -8,12 +8,13 @@
 #include <uhd/rfnoc/block_ctrl_base.hpp>
 #include <uhd/rfnoc/blockdef.hpp>
 #include <uhd/utils/log.hpp>
+#include <uhdlib/utils/hashed_dict.hpp>
 #include <boost/format.hpp>
 
 using namespace uhd;
 using namespace uhd::rfnoc;
 
-typedef uhd::dict<std::string, block_ctrl_base::make_t> block_fcn_reg_t;
+typedef uhd::hashed_dict<std::string, block_ctrl_base::make_t> block_fcn_reg_t;
 // Instantiate the block function registry container
 UHD_SINGLETON_FCN(block_fcn_reg_t, get_block_fcn_regs);
 
@@ -10,12 +10,93 @@
 #include <uhd/rfnoc/block_id.hpp>
 #include <uhd/rfnoc/constants.hpp>
 #include <boost/format.hpp>
-#include <boost/lexical_cast.hpp>
-#include <boost/regex.hpp>
+#include <algorithm>
 #include <iostream>
+#include <limits>
 
 using namespace uhd::rfnoc;
 
+namespace {
+
+//! The parts of a block ID string, see parse_block_id()
+struct block_id_parts_t
+{
+    bool has_device_no = false;
+    size_t device_no   = 0;
+    std::string::const_iterator name_begin, name_end;
+    bool has_block_ctr = false;
+    size_t block_ctr   = 0;
+    //! False if the device number doesn't fit a size_t
+    bool in_range = true;
+};
+
+bool is_alpha(const char c)
+{
+    return (c >= 'A' and c <= 'Z') or (c >= 'a' and c <= 'z');
+}
+
+bool is_digit(const char c)
+{
+    return c >= '0' and c <= '9';
+}
+
+//! Match a block name, i.e. VALID_BLOCKNAME_REGEX, and return where it ends
+std::string::const_iterator parse_block_name(
+    std::string::const_iterator it, const std::string::const_iterator end)
+{
+    if (it == end or not is_alpha(*it)) {
+        return it;
+    }
+    while (++it != end and (is_alpha(*it) or is_digit(*it))) {
+    }
+    return it;
+}
+
+/*! Split a block ID like VALID_BLOCKID_REGEX does, without a regex
+ *
+ * The format is "[DEVICE/]NAME[_COUNTER]". Since a name starts with a letter
+ * and has no underscores, each part is found without backtracking.
+ */
+bool parse_block_id(const std::string& block_str, block_id_parts_t& parts)
+{
+    auto it        = block_str.cbegin();
+    const auto end = block_str.cend();
+    if (it != end and is_digit(*it)) {
+        parts.has_device_no = true;
+        for (; it != end and is_digit(*it); ++it) {
+            const size_t digit = size_t(*it - '0');
+            if (parts.device_no > (std::numeric_limits<size_t>::max() - digit) / 10) {
+                parts.in_range = false;
+            }
+            parts.device_no = parts.device_no * 10 + digit;
+        }
+        if (it == end or *it != '/') {
+            return false;
+        }
+        ++it;
+    }
+    parts.name_begin = it;
+    parts.name_end = it = parse_block_name(it, end);
+    if (parts.name_begin == parts.name_end) {
+        return false;
+    }
+    if (it == end) {
+        return true;
+    }
+    // One or two counter digits
+    if (*it != '_' or ++it == end or not is_digit(*it)) {
+        return false;
+    }
+    parts.has_block_ctr = true;
+    parts.block_ctr     = size_t(*it++ - '0');
+    if (it != end and is_digit(*it)) {
+        parts.block_ctr = parts.block_ctr * 10 + size_t(*it++ - '0');
+    }
+    return it == end;
+}
+
+} // namespace
+
 block_id_t::block_id_t() : _device_no(0), _block_name(""), _block_ctr(0) {}
 
 block_id_t::block_id_t(const std::string& block_str)
@@ -37,12 +118,15 @@ block_id_t::block_id_t(
 
 bool block_id_t::is_valid_blockname(const std::string& block_name)
 {
-    return boost::regex_match(block_name, boost::regex(VALID_BLOCKNAME_REGEX));
+    return not block_name.empty()
+           and parse_block_name(block_name.cbegin(), block_name.cend())
+                   == block_name.cend();
 }
 
 bool block_id_t::is_valid_block_id(const std::string& block_name)
 {
-    return boost::regex_match(block_name, boost::regex(VALID_BLOCKID_REGEX));
+    block_id_parts_t parts;
+    return parse_block_id(block_name, parts);
 }
 
 std::string block_id_t::to_string() const
@@ -62,38 +146,29 @@ uhd::fs_path block_id_t::get_tree_root() const
 
 bool block_id_t::match(const std::string& block_str)
 {
-    boost::cmatch matches;
-    if (not boost::regex_match(
-            block_str.c_str(), matches, boost::regex(VALID_BLOCKID_REGEX))) {
+    block_id_parts_t parts;
+    if (not parse_block_id(block_str, parts) or not parts.in_range) {
         return false;
     }
-    try {
-        return (matches[1] == "" or boost::lexical_cast<size_t>(matches[1]) == _device_no)
-               and (matches[2] == "" or matches[2] == _block_name)
-               and (matches[3] == ""
-                       or boost::lexical_cast<size_t>(matches[3]) == _block_ctr)
-               and not(matches[1] == "" and matches[2] == "" and matches[3] == "");
-    } catch (const std::bad_cast& e) {
-        return false;
-    }
-    return false;
+    return (not parts.has_device_no or parts.device_no == _device_no)
+           and parts.name_end - parts.name_begin
+                   == std::ptrdiff_t(_block_name.size())
+           and std::equal(parts.name_begin, parts.name_end, _block_name.cbegin())
+           and (not parts.has_block_ctr or parts.block_ctr == _block_ctr);
 }
 
 bool block_id_t::set(const std::string& new_name)
 {
-    boost::cmatch matches;
-    if (not boost::regex_match(
-            new_name.c_str(), matches, boost::regex(VALID_BLOCKID_REGEX))) {
+    block_id_parts_t parts;
+    if (not parse_block_id(new_name, parts) or not parts.in_range) {
         return false;
     }
-    if (not(matches[1] == "")) {
-        _device_no = boost::lexical_cast<size_t>(matches[1]);
-    }
-    if (not(matches[2] == "")) {
-        _block_name = matches[2];
+    if (parts.has_device_no) {
+        _device_no = parts.device_no;
     }
-    if (not(matches[3] == "")) {
-        _block_ctr = boost::lexical_cast<size_t>(matches[3]);
+    _block_name.assign(parts.name_begin, parts.name_end);
+    if (parts.has_block_ctr) {
+        _block_ctr = parts.block_ctr;
     }
     return true;
 }
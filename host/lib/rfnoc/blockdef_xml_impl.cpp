@@ -17,6 +17,9 @@
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/xml_parser.hpp>
 #include <cstdlib>
+#include <ctime>
+#include <map>
+#include <mutex>
 
 using namespace uhd;
 using namespace uhd::rfnoc;
@@ -194,13 +197,12 @@ public:
         return (rhs.find(lhs) == 0);
     }
 
-    //! Open the file at filename and see if it's a block definition for the given NoC ID
-    static bool has_noc_id(uint64_t noc_id, const fs::path& filename)
+    //! See if a parsed XML file is a block definition for the given NoC ID
+    static bool has_noc_id(
+        uint64_t noc_id, const fs::path& filename, const pt::ptree& propt)
     {
-        pt::ptree propt;
         try {
-            read_xml(filename.string(), propt);
-            for (pt::ptree::value_type& v : propt.get_child("nocblock.ids")) {
+            for (const pt::ptree::value_type& v : propt.get_child("nocblock.ids")) {
                 if (v.first == "id" and match_noc_id(v.second.data(), noc_id)) {
                     return true;
                 }
@@ -213,14 +215,15 @@ public:
         return false;
     }
 
-    blockdef_xml_impl(
-        const fs::path& filename, uint64_t noc_id, xml_repr_t type = DESCRIBES_BLOCK)
-        : _type(type), _noc_id(noc_id)
+    blockdef_xml_impl(const fs::path& filename,
+        const pt::ptree& propt,
+        uint64_t noc_id,
+        xml_repr_t type = DESCRIBES_BLOCK)
+        : _type(type), _noc_id(noc_id), _pt(propt)
     {
         UHD_LOGGER_DEBUG("RFNOC")
-            << boost::format("Reading XML file %s for NOC ID 0x%08X")
+            << boost::format("Using XML file %s for NOC ID 0x%08X")
                    % filename.string().c_str() % noc_id;
-        read_xml(filename.string(), _pt);
         try {
             // Check key is valid
             get_key();
@@ -397,16 +400,81 @@ private:
     pt::ptree _pt;
 };
 
+namespace {
+//! A parsed XML file
+struct xml_file_t
+{
+    fs::path filename;
+    pt::ptree propt;
+};
+
+/*! Process-wide cache of the XML files and the block definitions made from
+ *  them
+ *
+ * The files are parsed once, and every block definition is made once per
+ * NoC ID, no matter how many blocks or devices look it up. Everything is
+ * dropped and reread when the set of block directories (i.e., UHD_RFNOC_DIR)
+ * or the modification time of one of them changes, i.e., when files are
+ * added or removed. Editing a file in place requires restarting the process.
+ */
+struct blockdef_cache_t
+{
+    std::mutex mutex;
+    //! The directories the files were read from, with their modification times
+    std::vector<std::pair<fs::path, std::time_t>> dirs;
+    std::vector<xml_file_t> files;
+    //! Null for NoC IDs without a block definition
+    std::map<uint64_t, blockdef::sptr> blockdefs;
+};
+
+blockdef_cache_t& get_blockdef_cache()
+{
+    static blockdef_cache_t cache;
+    return cache;
+}
+
+//! Parse all XML files in the given directories, in order
+std::vector<xml_file_t> read_xml_files(
+    const std::vector<std::pair<fs::path, std::time_t>>& dirs)
+{
+    std::vector<xml_file_t> files;
+    for (const auto& dir : dirs) {
+        // Iterate over all .xml files
+        fs::directory_iterator end_itr;
+        for (fs::directory_iterator i(dir.first); i != end_itr; ++i) {
+            if (not fs::exists(*i) or fs::is_directory(*i) or fs::is_empty(*i)) {
+                continue;
+            }
+            if (i->path().filename().extension() != XML_EXTENSION) {
+                continue;
+            }
+            xml_file_t file{i->path(), pt::ptree()};
+            try {
+                read_xml(file.filename.string(), file.propt);
+            } catch (const std::exception& e) {
+                UHD_LOGGER_WARNING("RFNOC")
+                    << "Caught exception " << e.what()
+                    << " while parsing file: " << file.filename.string();
+                continue;
+            }
+            files.push_back(std::move(file));
+        }
+    }
+    UHD_LOGGER_DEBUG("RFNOC") << "Read " << files.size() << " XML block definitions";
+    return files;
+}
+} // namespace
+
 blockdef::sptr blockdef::make_from_noc_id(uint64_t noc_id)
 {
     std::vector<fs::path> paths = blockdef_xml_impl::get_xml_paths();
-    std::vector<fs::path> valid;
+    std::vector<std::pair<fs::path, std::time_t>> valid;
 
     // Check if any of the paths exist
     for (const auto& base_path : paths) {
         fs::path this_path = base_path / XML_BLOCKS_SUBDIR;
         if (fs::exists(this_path) and fs::is_directory(this_path)) {
-            valid.push_back(this_path);
+            valid.emplace_back(this_path, fs::last_write_time(this_path));
         }
     }
 
@@ -416,23 +484,27 @@ blockdef::sptr blockdef::make_from_noc_id(uint64_t noc_id)
                                    "to the correct location");
     }
 
-    // Iterate over all paths
-    for (const auto& path : valid) {
-        // Iterate over all .xml files
-        fs::directory_iterator end_itr;
-        for (fs::directory_iterator i(path); i != end_itr; ++i) {
-            if (not fs::exists(*i) or fs::is_directory(*i) or fs::is_empty(*i)) {
-                continue;
-            }
-            if (i->path().filename().extension() != XML_EXTENSION) {
-                continue;
-            }
-            if (blockdef_xml_impl::has_noc_id(noc_id, i->path())) {
-                return blockdef::sptr(new blockdef_xml_impl(i->path(), noc_id));
-            }
-        }
+    blockdef_cache_t& cache = get_blockdef_cache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    if (cache.dirs != valid) {
+        cache.files = read_xml_files(valid);
+        cache.dirs  = valid;
+        cache.blockdefs.clear();
+    }
+    const auto cached = cache.blockdefs.find(noc_id);
+    if (cached != cache.blockdefs.end()) {
+        return cached->second;
     }
 
-    return blockdef::sptr();
+    blockdef::sptr block_def;
+    for (const xml_file_t& file : cache.files) {
+        if (blockdef_xml_impl::has_noc_id(noc_id, file.filename, file.propt)) {
+            block_def = blockdef::sptr(
+                new blockdef_xml_impl(file.filename, file.propt, noc_id));
+            break;
+        }
+    }
+    cache.blockdefs.emplace(noc_id, block_def);
+    return block_def;
 }
 // vim: sw=4 et:
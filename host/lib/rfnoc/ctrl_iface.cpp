@@ -14,12 +14,15 @@
 #include <uhd/utils/byteswap.hpp>
 #include <uhd/utils/safe_call.hpp>
 #include <uhdlib/rfnoc/ctrl_iface.hpp>
+#include <uhdlib/utils/trace.hpp>
 #include <boost/bind.hpp>
 #include <boost/format.hpp>
 #include <boost/make_shared.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/thread.hpp>
+#include <exception>
 #include <queue>
+#include <utility>
 
 using namespace uhd;
 using namespace uhd::rfnoc;
@@ -66,6 +69,35 @@ public:
             readback, bool(timestamp != 0) ? MASSIVE_TIMEOUT : ACK_TIMEOUT);
     }
 
+    void send_cmd_batch(cmd_batch& batch)
+    {
+        boost::mutex::scoped_lock lock(_mutex);
+        double timeout = ACK_TIMEOUT;
+        try {
+            for (auto& cmd : batch.get_cmds()) {
+                if (cmd.timestamp != 0) {
+                    timeout = MASSIVE_TIMEOUT;
+                }
+                if (cmd.readback) {
+                    _pending_readbacks.push(std::make_pair(_seq_out, &cmd.result));
+                }
+                this->send_pkt(cmd.addr, cmd.data, cmd.timestamp);
+                // Only blocks if the command FIFO is full
+                this->wait_for_ack(false, timeout);
+            }
+            if (not _outstanding_seqs.empty()) {
+                this->wait_for_ack(true, timeout);
+            }
+        } catch (...) {
+            const std::exception_ptr ex = std::current_exception();
+            while (not _pending_readbacks.empty()) {
+                _pending_readbacks.front().second->set_exception(ex);
+                _pending_readbacks.pop();
+            }
+            throw;
+        }
+    }
+
     void set_cmd_fifo_size(const size_t num_lines)
     {
         _max_outstanding_acks =
@@ -75,6 +107,11 @@ public:
                            << _max_outstanding_acks);
     }
 
+    size_t get_cmd_fifo_size(void) const
+    {
+        return _max_outstanding_acks;
+    }
+
 private:
     // This is the buffer type for response messages
     struct resp_buff_type
@@ -124,7 +161,7 @@ private:
             pkt[packet_info.num_header_words32 + 1] = uhd::htowx(data);
         }
 
-        // UHD_LOGGER_TRACE("RFNOC") << boost::format("0x%08x, 0x%08x\n") % addr % data;
+        UHD_TRACE(CTRL_IFACE, trace, "addr: 0x", std::hex, addr, " data: 0x", data);
         // send the buffer over the interface
         _outstanding_seqs.push(_seq_out);
         buff->commit(sizeof(uint32_t) * (packet_info.num_packet_words32));
@@ -203,29 +240,43 @@ private:
                         % ex.what()));
             }
 
+            // fill in the readback value of a batch command
+            if (not _pending_readbacks.empty()
+                and _pending_readbacks.front().first == seq_to_ack) {
+                _pending_readbacks.front().second->set_value(
+                    unpack_payload(pkt, packet_info));
+                _pending_readbacks.pop();
+            }
+
             // return the readback value
             if (readback and _outstanding_seqs.empty()) {
-                const uint64_t hi =
-                    (_endianness == uhd::ENDIANNESS_BIG)
-                        ? uhd::ntohx(pkt[packet_info.num_header_words32 + 0])
-                        : uhd::wtohx(pkt[packet_info.num_header_words32 + 0]);
-                const uint64_t lo =
-                    (_endianness == uhd::ENDIANNESS_BIG)
-                        ? uhd::ntohx(pkt[packet_info.num_header_words32 + 1])
-                        : uhd::wtohx(pkt[packet_info.num_header_words32 + 1]);
-                return ((hi << 32) | lo);
+                return unpack_payload(pkt, packet_info);
             }
         }
 
         return 0;
     }
 
+    inline uint64_t unpack_payload(
+        uint32_t const* pkt, const vrt::if_packet_info_t& packet_info)
+    {
+        const uint64_t hi = (_endianness == uhd::ENDIANNESS_BIG)
+                                ? uhd::ntohx(pkt[packet_info.num_header_words32 + 0])
+                                : uhd::wtohx(pkt[packet_info.num_header_words32 + 0]);
+        const uint64_t lo = (_endianness == uhd::ENDIANNESS_BIG)
+                                ? uhd::ntohx(pkt[packet_info.num_header_words32 + 1])
+                                : uhd::wtohx(pkt[packet_info.num_header_words32 + 1]);
+        return ((hi << 32) | lo);
+    }
+
 
     const uhd::both_xports_t _xports;
     const std::string _name;
     size_t _seq_out;
     std::queue<size_t> _outstanding_seqs;
     size_t _max_outstanding_acks;
+    //! Sequence numbers of batched readbacks that still wait for a response
+    std::queue<std::pair<size_t, std::promise<uint64_t>*>> _pending_readbacks;
 
     boost::mutex _mutex;
 };
@@ -90,6 +90,12 @@ public:
         return _perifs[chan].depth;
     }
 
+    uint32_t get_bytes_occupied(const size_t chan)
+    {
+        boost::lock_guard<boost::mutex> lock(_config_mutex);
+        return _perifs[chan].core->get_bytes_occupied();
+    }
+
 private:
     struct fifo_perifs_t
     {
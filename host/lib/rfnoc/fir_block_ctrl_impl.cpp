@@ -53,10 +53,8 @@ public:
             taps.resize(_n_taps, 0);
         }
 
-        // Write taps via the reload bus
-        for (size_t i = 0; i < taps.size() - 1; i++) {
-            sr_write(SR_RELOAD, uint32_t(taps[i]));
-        }
+        // Write taps via the reload bus, as one batch of commands
+        sr_write(SR_RELOAD, std::vector<uint32_t>(taps.begin(), taps.end() - 1));
         // Assert tlast when sending the spinal tap (haha, it's actually the final tap).
         sr_write(SR_RELOAD_TLAST, uint32_t(taps.back()));
         // Send the configuration word to replace the existing coefficients with the new
@@ -187,6 +187,7 @@ public:
 
             update_sample_rate_on_blocks(mboard);
         }
+        cache_chan_info();
     }
 
     ~legacy_compat_impl()
@@ -207,15 +208,7 @@ public:
 
     uhd::fs_path rx_dsp_root(const size_t mboard_idx, const size_t chan)
     {
-        // The DSP index is the same as the radio index
-        size_t dsp_index  = _rx_channel_map[mboard_idx][chan].radio_index;
-        size_t port_index = _rx_channel_map[mboard_idx][chan].port_index;
-
-        if (not _has_ddcs) {
-            return mb_root(mboard_idx) / "rx_dsps" / dsp_index / port_index;
-        }
-
-        return rx_dsp_root(mboard_idx, dsp_index, port_index);
+        return _rx_chan_info[mboard_idx][chan].dsp_root;
     }
 
     inline uhd::fs_path tx_dsp_root(
@@ -228,33 +221,17 @@ public:
 
     uhd::fs_path tx_dsp_root(const size_t mboard_idx, const size_t chan)
     {
-        // The DSP index is the same as the radio index
-        size_t dsp_index  = _tx_channel_map[mboard_idx][chan].radio_index;
-        size_t port_index = _tx_channel_map[mboard_idx][chan].port_index;
-
-        if (not _has_ducs) {
-            return mb_root(mboard_idx) / "tx_dsps" / dsp_index / port_index;
-        }
-
-        return tx_dsp_root(mboard_idx, dsp_index, port_index);
+        return _tx_chan_info[mboard_idx][chan].dsp_root;
     }
 
     uhd::fs_path rx_fe_root(const size_t mboard_idx, const size_t chan)
     {
-        size_t radio_index = _rx_channel_map[mboard_idx][chan].radio_index;
-        size_t port_index  = _rx_channel_map[mboard_idx][chan].port_index;
-        return uhd::fs_path(
-            str(boost::format("/mboards/%d/xbar/%s_%d/rx_fe_corrections/%d/") % mboard_idx
-                % RADIO_BLOCK_NAME % radio_index % port_index));
+        return _rx_chan_info[mboard_idx][chan].fe_root;
     }
 
     uhd::fs_path tx_fe_root(const size_t mboard_idx, const size_t chan)
     {
-        size_t radio_index = _tx_channel_map[mboard_idx][chan].radio_index;
-        size_t port_index  = _tx_channel_map[mboard_idx][chan].port_index;
-        return uhd::fs_path(
-            str(boost::format("/mboards/%d/xbar/%s_%d/tx_fe_corrections/%d/") % mboard_idx
-                % RADIO_BLOCK_NAME % radio_index % port_index));
+        return _tx_chan_info[mboard_idx][chan].fe_root;
     }
     //! Get all legacy blocks from the LEGACY_BLOCK_LIST return in a form of
     //  {BLOCK_NAME: <{source_block_pointer},{sink_block_pointer}>}
@@ -283,15 +260,8 @@ public:
     void issue_stream_cmd(const stream_cmd_t& stream_cmd, size_t mboard, size_t chan)
     {
         UHD_LEGACY_LOG() << "[legacy_compat] issue_stream_cmd() ";
-        const size_t& radio_index = _rx_channel_map[mboard][chan].radio_index;
-        const size_t& port_index  = _rx_channel_map[mboard][chan].port_index;
-        if (_has_ddcs) {
-            get_block_ctrl<ddc_block_ctrl>(mboard, DDC_BLOCK_NAME, radio_index)
-                ->issue_stream_cmd(stream_cmd, port_index);
-        } else {
-            get_block_ctrl<radio_ctrl>(mboard, RADIO_BLOCK_NAME, radio_index)
-                ->issue_stream_cmd(stream_cmd, port_index);
-        }
+        const chan_info_t& info = _rx_chan_info[mboard][chan];
+        info.source_block->issue_stream_cmd(stream_cmd, info.port_index);
     }
 
     //! Sets block_id<N> and block_port<N> in the streamer args, otherwise forwards the
@@ -306,7 +276,7 @@ public:
         UHD_LEGACY_LOG() << "[legacy_compat] rx stream args: " << args.args.to_string();
         uhd::rx_streamer::sptr streamer = _device->get_rx_stream(args);
         for (const size_t chan : args.channels) {
-            _rx_stream_cache[chan] = streamer;
+            _rx_stream_cache[chan] = {streamer, args.channels};
         }
         return streamer;
     }
@@ -325,14 +295,14 @@ public:
         UHD_LEGACY_LOG() << "[legacy_compat] tx stream args: " << args.args.to_string();
         uhd::tx_streamer::sptr streamer = _device->get_tx_stream(args);
         for (const size_t chan : args.channels) {
-            _tx_stream_cache[chan] = streamer;
+            _tx_stream_cache[chan] = {streamer, args.channels};
         }
         return streamer;
     }
 
     double get_tick_rate(const size_t mboard_idx = 0)
     {
-        return _tree->access<double>(mb_root(mboard_idx) / "tick_rate").get();
+        return tick_rate_prop(mboard_idx).get();
     }
 
     uhd::meta_range_t lambda_get_samp_rate_range(const size_t mboard_idx,
@@ -351,7 +321,7 @@ public:
 
     void set_tick_rate(const double tick_rate, const size_t mboard_idx = 0)
     {
-        _tree->access<double>(mb_root(mboard_idx) / "tick_rate").set(tick_rate);
+        tick_rate_prop(mboard_idx).set(tick_rate);
         for (size_t radio = 0; radio < _num_radios_per_board; radio++) {
             auto radio_block_ctrl =
                 get_block_ctrl<radio_ctrl>(mboard_idx, "Radio", radio);
@@ -368,30 +338,21 @@ public:
 
         // Set DDC values:
         if (chan == uhd::usrp::multi_usrp::ALL_CHANS) {
-            for (size_t mboard_idx = 0; mboard_idx < _rx_channel_map.size();
-                 mboard_idx++) {
-                for (size_t chan_idx = 0; chan_idx < _rx_channel_map[mboard_idx].size();
-                     chan_idx++) {
-                    const size_t dsp_index =
-                        _rx_channel_map[mboard_idx][chan_idx].radio_index;
-                    const size_t port_index =
-                        _rx_channel_map[mboard_idx][chan_idx].port_index;
-                    _tree
-                        ->access<double>(
-                            rx_dsp_root(mboard_idx, dsp_index, port_index) / "rate/value")
-                        .set(rate);
+            for (const auto& mb_chan_info : _rx_chan_info) {
+                for (const chan_info_t& info : mb_chan_info) {
+                    info.dsp_rate->set(rate);
                 }
             }
         } else {
+            // All channels of the streamer that includes chan share its rate
             std::set<size_t> chans_to_change{chan};
-            if (_rx_stream_cache.count(chan)) {
-                uhd::rx_streamer::sptr str_ptr = _rx_stream_cache[chan].lock();
-                if (str_ptr) {
-                    for (const rx_stream_map_type::value_type& chan_streamer_pair :
-                        _rx_stream_cache) {
-                        if (chan_streamer_pair.second.lock() == str_ptr) {
-                            chans_to_change.insert(chan_streamer_pair.first);
-                        }
+            const auto cache_it = _rx_stream_cache.find(chan);
+            if (cache_it != _rx_stream_cache.end()
+                and not cache_it->second.streamer.expired()) {
+                const rx_stream_info_t& stream_info = cache_it->second;
+                for (const size_t other_chan : stream_info.channels) {
+                    if (is_same_streamer(_rx_stream_cache, other_chan, stream_info)) {
+                        chans_to_change.insert(other_chan);
                     }
                 }
             }
@@ -399,12 +360,7 @@ public:
                 size_t mboard, mb_chan;
                 chan_to_mcp<uhd::RX_DIRECTION>(
                     this_chan, _rx_channel_map, mboard, mb_chan);
-                const size_t dsp_index  = _rx_channel_map[mboard][mb_chan].radio_index;
-                const size_t port_index = _rx_channel_map[mboard][mb_chan].port_index;
-                _tree
-                    ->access<double>(
-                        rx_dsp_root(mboard, dsp_index, port_index) / "rate/value")
-                    .set(rate);
+                _rx_chan_info[mboard][mb_chan].dsp_rate->set(rate);
             }
         }
     }
@@ -417,30 +373,21 @@ public:
 
         // Set DUC values:
         if (chan == uhd::usrp::multi_usrp::ALL_CHANS) {
-            for (size_t mboard_idx = 0; mboard_idx < _tx_channel_map.size();
-                 mboard_idx++) {
-                for (size_t chan_idx = 0; chan_idx < _tx_channel_map[mboard_idx].size();
-                     chan_idx++) {
-                    const size_t dsp_index =
-                        _tx_channel_map[mboard_idx][chan_idx].radio_index;
-                    const size_t port_index =
-                        _tx_channel_map[mboard_idx][chan_idx].port_index;
-                    _tree
-                        ->access<double>(
-                            tx_dsp_root(mboard_idx, dsp_index, port_index) / "rate/value")
-                        .set(rate);
+            for (const auto& mb_chan_info : _tx_chan_info) {
+                for (const chan_info_t& info : mb_chan_info) {
+                    info.dsp_rate->set(rate);
                 }
             }
         } else {
+            // All channels of the streamer that includes chan share its rate
             std::set<size_t> chans_to_change{chan};
-            if (_tx_stream_cache.count(chan)) {
-                uhd::tx_streamer::sptr str_ptr = _tx_stream_cache[chan].lock();
-                if (str_ptr) {
-                    for (const tx_stream_map_type::value_type& chan_streamer_pair :
-                        _tx_stream_cache) {
-                        if (chan_streamer_pair.second.lock() == str_ptr) {
-                            chans_to_change.insert(chan_streamer_pair.first);
-                        }
+            const auto cache_it = _tx_stream_cache.find(chan);
+            if (cache_it != _tx_stream_cache.end()
+                and not cache_it->second.streamer.expired()) {
+                const tx_stream_info_t& stream_info = cache_it->second;
+                for (const size_t other_chan : stream_info.channels) {
+                    if (is_same_streamer(_tx_stream_cache, other_chan, stream_info)) {
+                        chans_to_change.insert(other_chan);
                     }
                 }
             }
@@ -448,12 +395,7 @@ public:
                 size_t mboard, mb_chan;
                 chan_to_mcp<uhd::TX_DIRECTION>(
                     this_chan, _tx_channel_map, mboard, mb_chan);
-                const size_t dsp_index  = _tx_channel_map[mboard][mb_chan].radio_index;
-                const size_t port_index = _tx_channel_map[mboard][mb_chan].port_index;
-                _tree
-                    ->access<double>(
-                        tx_dsp_root(mboard, dsp_index, port_index) / "rate/value")
-                    .set(rate);
+                _tx_chan_info[mboard][mb_chan].dsp_rate->set(rate);
             }
         }
     }
@@ -473,6 +415,32 @@ private: // types
     // ports and correct order anyway.
     typedef std::vector<std::vector<radio_port_pair_t>> chan_map_t;
 
+    //! What the API calls need to know about a channel. This is looked up
+    // once after the channel maps are known, so the calls neither build
+    // property paths nor look up blocks.
+    struct chan_info_t
+    {
+        uhd::fs_path dsp_root;
+        uhd::fs_path fe_root;
+        //! The rate of the DDC/DUC, or null if there is none
+        boost::shared_ptr<uhd::property<double>> dsp_rate;
+        //! The block which receives stream commands (RX only)
+        source_block_ctrl_base::sptr source_block;
+        size_t port_index;
+    };
+    //! Map: _rx_chan_info[mboard_idx][chan_idx] => chan_info_t
+    typedef std::vector<std::vector<chan_info_t>> chan_info_map_t;
+
+    //! A streamer generated through this API, and all of its channels
+    template <typename streamer_type>
+    struct stream_info_t
+    {
+        boost::weak_ptr<streamer_type> streamer;
+        std::vector<size_t> channels;
+    };
+    typedef stream_info_t<uhd::rx_streamer> rx_stream_info_t;
+    typedef stream_info_t<uhd::tx_streamer> tx_stream_info_t;
+
 private: // methods
     /************************************************************************
      * Private helpers
@@ -520,6 +488,80 @@ private: // methods
         return _device->get_block_ctrl<block_type>(block_id);
     }
 
+    void cache_chan_info()
+    {
+        _rx_chan_info.resize(_num_mboards);
+        _tx_chan_info.resize(_num_mboards);
+        for (size_t mboard = 0; mboard < _num_mboards; mboard++) {
+            _tick_rate.push_back(_tree->exists(mb_root(mboard) / "tick_rate")
+                                     ? _tree->access_handle<double>(
+                                           mb_root(mboard) / "tick_rate")
+                                     : boost::shared_ptr<uhd::property<double>>());
+            for (const radio_port_pair_t& radio_port : _rx_channel_map[mboard]) {
+                const size_t radio_index = radio_port.radio_index;
+                chan_info_t info;
+                info.port_index = radio_port.port_index;
+                info.fe_root    = fe_root(mboard, "rx", radio_index, info.port_index);
+                if (_has_ddcs) {
+                    info.dsp_root = rx_dsp_root(mboard, radio_index, info.port_index);
+                    info.dsp_rate = _tree->access_handle<double>(info.dsp_root / "rate/value");
+                    info.source_block =
+                        get_block_ctrl<ddc_block_ctrl>(mboard, DDC_BLOCK_NAME, radio_index);
+                } else {
+                    info.dsp_root =
+                        mb_root(mboard) / "rx_dsps" / radio_index / info.port_index;
+                    info.source_block = get_block_ctrl<radio_ctrl>(
+                        mboard, RADIO_BLOCK_NAME, radio_index);
+                }
+                _rx_chan_info[mboard].push_back(info);
+            }
+            for (const radio_port_pair_t& radio_port : _tx_channel_map[mboard]) {
+                const size_t radio_index = radio_port.radio_index;
+                chan_info_t info;
+                info.port_index = radio_port.port_index;
+                info.fe_root    = fe_root(mboard, "tx", radio_index, info.port_index);
+                if (_has_ducs) {
+                    info.dsp_root = tx_dsp_root(mboard, radio_index, info.port_index);
+                    info.dsp_rate = _tree->access_handle<double>(info.dsp_root / "rate/value");
+                } else {
+                    info.dsp_root =
+                        mb_root(mboard) / "tx_dsps" / radio_index / info.port_index;
+                }
+                _tx_chan_info[mboard].push_back(info);
+            }
+        }
+    }
+
+    uhd::fs_path fe_root(const size_t mboard_idx,
+        const std::string& dir,
+        const size_t radio_index,
+        const size_t port_index)
+    {
+        return uhd::fs_path(
+            str(boost::format("/mboards/%d/xbar/%s_%d/%s_fe_corrections/%d/") % mboard_idx
+                % RADIO_BLOCK_NAME % radio_index % dir % port_index));
+    }
+
+    uhd::property<double>& tick_rate_prop(const size_t mboard_idx)
+    {
+        if (mboard_idx < _tick_rate.size() and _tick_rate[mboard_idx]) {
+            return *_tick_rate[mboard_idx];
+        }
+        return _tree->access<double>(mb_root(mboard_idx) / "tick_rate");
+    }
+
+    //! Check if chan still belongs to the streamer of stream_info
+    template <typename stream_map_type, typename stream_info_type>
+    static bool is_same_streamer(const stream_map_type& stream_cache,
+        const size_t chan,
+        const stream_info_type& stream_info)
+    {
+        const auto it = stream_cache.find(chan);
+        return it != stream_cache.end()
+               and not it->second.streamer.owner_before(stream_info.streamer)
+               and not stream_info.streamer.owner_before(it->second.streamer);
+    }
+
     template <uhd::direction_t dir>
     inline void chan_to_mcp(const size_t chan,
         const chan_map_t& chan_map,
@@ -1146,11 +1188,16 @@ private: // attributes
     chan_map_t _rx_channel_map;
     chan_map_t _tx_channel_map;
 
+    chan_info_map_t _rx_chan_info;
+    chan_info_map_t _tx_chan_info;
+    //! The tick rate of every motherboard
+    std::vector<boost::shared_ptr<uhd::property<double>>> _tick_rate;
+
     //! Stores a weak pointer for every streamer that's generated through this API.
     // Key is the channel number (same format as e.g. the set_rx_rate() call).
-    typedef std::map<size_t, boost::weak_ptr<uhd::rx_streamer>> rx_stream_map_type;
+    typedef std::map<size_t, rx_stream_info_t> rx_stream_map_type;
     rx_stream_map_type _rx_stream_cache;
-    typedef std::map<size_t, boost::weak_ptr<uhd::tx_streamer>> tx_stream_map_type;
+    typedef std::map<size_t, tx_stream_info_t> tx_stream_map_type;
     tx_stream_map_type _tx_stream_cache;
 
     graph::sptr _graph;
@@ -90,8 +90,11 @@ void block_iface::run_and_check(const std::string& code, const std::string& erro
     boost::mutex::scoped_lock local_interpreter_lock(_lil_mutex);
 
     UHD_NOCSCRIPT_LOG() << "[NocScript] Executing and asserting code: " << code;
-    expression::sptr e        = _parser->create_expr_tree(code);
-    expression_literal result = e->eval();
+    auto expr_it = _expr_cache.find(code);
+    if (expr_it == _expr_cache.end()) {
+        expr_it = _expr_cache.emplace(code, _parser->create_expr_tree(code)).first;
+    }
+    expression_literal result = expr_it->second->eval();
     if (not result.to_bool()) {
         if (error_message.empty()) {
             throw uhd::runtime_error(
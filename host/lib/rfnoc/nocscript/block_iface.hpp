@@ -38,6 +38,9 @@ public:
      * \param error_message If the expression fails, this error message is printed.
      * \throws uhd::runtime_error if the expression returns false.
      * \throws uhd::syntax_error if the expression is invalid.
+     *
+     * \p code is only parsed the first time it is run. The expression tree is
+     * kept, so running it again only evaluates it.
      */
     void run_and_check(const std::string& code, const std::string& error_message = "");
 
@@ -78,6 +81,9 @@ private:
     //! Pointer to the parser object
     parser::sptr _parser;
 
+    //! Expression trees of all code that was run so far, by code
+    std::map<std::string, expression::sptr> _expr_cache;
+
     //! Container for scoped variables
     std::map<std::string, expression_literal> _vars;
 };
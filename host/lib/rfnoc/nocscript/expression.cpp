@@ -324,6 +324,7 @@ void expression_function::add(expression::sptr new_expr)
 {
     expression_container::add(new_expr);
     _arg_types.push_back(new_expr->infer_type());
+    _function.clear();
 }
 
 expression::type_t expression_function::infer_type() const
@@ -333,7 +334,10 @@ expression::type_t expression_function::infer_type() const
 
 expression_literal expression_function::eval()
 {
-    return _func_table->eval(_name, _arg_types, _sub_exprs);
+    if (not _function) {
+        _function = _func_table->get_function(_name, _arg_types);
+    }
+    return _function(_sub_exprs);
 }
 
 
@@ -305,6 +305,8 @@ private:
     std::string _name;
     const boost::shared_ptr<function_table> _func_table;
     std::vector<expression::type_t> _arg_types;
+    //! The function looked up in _func_table, set on the first eval()
+    boost::function<expression_literal(expr_list_type&)> _function;
 };
 
 
@@ -73,13 +73,22 @@ public:
         const expression_function::argtype_list_type& arg_types,
         expression_container::expr_list_type& arguments)
     {
-        if (not function_exists(name, arg_types)) {
-            throw uhd::syntax_error(
-                str(boost::format("Cannot eval() function %s, not a known signature")
-                    % expression_function::to_string(name, arg_types)));
-        }
+        return get_function(name, arg_types)(arguments);
+    }
 
-        return _table[name][arg_types].function(arguments);
+    function_ptr get_function(
+        const std::string& name, const expression_function::argtype_list_type& arg_types)
+    {
+        table_type::const_iterator it = _table.find(name);
+        if (it != _table.end()) {
+            const auto sig_it = it->second.find(arg_types);
+            if (sig_it != it->second.end()) {
+                return sig_it->second.function;
+            }
+        }
+        throw uhd::syntax_error(
+            str(boost::format("Cannot eval() function %s, not a known signature")
+                % expression_function::to_string(name, arg_types)));
     }
 
     void register_function(const std::string& name,
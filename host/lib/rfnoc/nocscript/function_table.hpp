@@ -57,6 +57,21 @@ public:
         const expression_function::argtype_list_type& arg_types,
         expression_container::expr_list_type& arguments) = 0;
 
+    /*! Look up the function \p name for the argument types \p arg_types
+     *
+     * Calling the returned function object is equivalent to calling eval(),
+     * but the lookup only happens once.
+     *
+     * \throws uhd::syntax_error if no such function is found
+     */
+    virtual function_ptr get_function(
+        const std::string& name, const expression_function::argtype_list_type& arg_types)
+    {
+        return [this, name, arg_types](expression_container::expr_list_type& arguments) {
+            return this->eval(name, arg_types, arguments);
+        };
+    }
+
     /*! Register a new function
      *
      * \param name Name of the function (e.g. 'ADD')
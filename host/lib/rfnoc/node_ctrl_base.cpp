@@ -8,9 +8,15 @@
 #include <uhd/rfnoc/node_ctrl_base.hpp>
 #include <uhd/utils/log.hpp>
 #include <boost/range/adaptor/map.hpp>
+#include <atomic>
 
 using namespace uhd::rfnoc;
 
+namespace {
+std::atomic<uint64_t> topology_version(0);
+std::atomic<uint64_t> activity_version(0);
+} // namespace
+
 std::string node_ctrl_base::unique_id() const
 {
     // Most instantiations will override this, so we don't need anything
@@ -24,6 +30,7 @@ void node_ctrl_base::clear()
     // Reset connections:
     _upstream_nodes.clear();
     _downstream_nodes.clear();
+    _graph_changed();
 }
 
 void node_ctrl_base::_register_downstream_node(node_ctrl_base::sptr, size_t)
@@ -47,6 +54,7 @@ void node_ctrl_base::set_downstream_port(const size_t this_port, const size_t re
                 % unique_id() % this_port));
     }
     _downstream_ports[this_port] = remote_port;
+    _graph_changed();
 }
 
 size_t node_ctrl_base::get_downstream_port(const size_t this_port)
@@ -69,6 +77,7 @@ void node_ctrl_base::set_upstream_port(const size_t this_port, const size_t remo
             % unique_id() % this_port));
     }
     _upstream_ports[this_port] = remote_port;
+    _graph_changed();
 }
 
 size_t node_ctrl_base::get_upstream_port(const size_t this_port)
@@ -109,6 +118,7 @@ void node_ctrl_base::disconnect()
     _downstream_ports.clear();
     _upstream_nodes.clear();
     _upstream_ports.clear();
+    _graph_changed();
 }
 
 void node_ctrl_base::disconnect_output_port(const size_t output_port)
@@ -122,6 +132,7 @@ void node_ctrl_base::disconnect_output_port(const size_t output_port)
     }
     _downstream_nodes.erase(output_port);
     _downstream_ports.erase(output_port);
+    _graph_changed();
 }
 
 void node_ctrl_base::disconnect_input_port(const size_t input_port)
@@ -135,4 +146,24 @@ void node_ctrl_base::disconnect_input_port(const size_t input_port)
     }
     _upstream_nodes.erase(input_port);
     _upstream_ports.erase(input_port);
+    _graph_changed();
+}
+
+void node_ctrl_base::_graph_changed(const bool activity_only)
+{
+    if (activity_only) {
+        activity_version++;
+    } else {
+        topology_version++;
+    }
+}
+
+uint64_t node_ctrl_base::_get_topology_version()
+{
+    return topology_version;
+}
+
+uint64_t node_ctrl_base::_get_activity_version()
+{
+    return activity_version;
 }
@@ -34,13 +34,24 @@ public:
             sr_write(addr + traffic_counter_sr_base, data);
         };
 
-        traffic_counter::read_reg_fn_t read = [this](const uint32_t addr) {
-            const uint64_t traffic_counter_rb_base = 64;
+        const uint32_t traffic_counter_rb_base = 64;
+        traffic_counter::read_reg_fn_t read = [this, traffic_counter_rb_base](
+                                                  const uint32_t addr) {
             return user_reg_read64(addr + traffic_counter_rb_base);
         };
 
-        _traffic_counter =
-            std::make_shared<traffic_counter>(_tree, _root_path, write, read);
+        traffic_counter::read_regs_fn_t read_batch =
+            [this, traffic_counter_rb_base](const std::vector<uint32_t>& addrs) {
+                std::vector<uint32_t> rb_addrs;
+                rb_addrs.reserve(addrs.size());
+                for (const uint32_t addr : addrs) {
+                    rb_addrs.push_back(addr + traffic_counter_rb_base);
+                }
+                return user_reg_read64(rb_addrs);
+            };
+
+        _traffic_counter = std::make_shared<traffic_counter>(
+            _tree, _root_path, write, read, read_batch);
     }
 
     void set_line_delay_cycles(int cycles)
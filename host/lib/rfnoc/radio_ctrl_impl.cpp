@@ -428,6 +428,7 @@ void radio_ctrl_impl::set_rx_streamer(bool active, const size_t port)
             % unique_id() % port));
     }
     _rx_streamer_active[port] = active;
+    _graph_changed(true);
     if (not check_radio_config()) {
         throw std::runtime_error(
             str(boost::format("[%s]: Invalid radio configuration.") % unique_id()));
@@ -444,6 +445,7 @@ void radio_ctrl_impl::set_tx_streamer(bool active, const size_t port)
             % unique_id() % port));
     }
     _tx_streamer_active[port] = active;
+    _graph_changed(true);
     if (not check_radio_config()) {
         throw std::runtime_error(
             str(boost::format("[%s]: Invalid radio configuration.") % unique_id()));
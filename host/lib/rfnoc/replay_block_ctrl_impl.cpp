@@ -5,12 +5,27 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 //
 
+#include <uhd/exception.hpp>
 #include <uhd/rfnoc/replay_block_ctrl.hpp>
+#include <uhd/utils/file_player.hpp>
+#include <boost/format.hpp>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <limits>
 #include <mutex>
+#include <thread>
 
 using namespace uhd;
 using namespace uhd::rfnoc;
 
+namespace {
+
+//! Time without new input data after which the record buffer counts as flushed
+const std::chrono::milliseconds FLUSH_QUIET_TIME(250);
+
+} // namespace
+
 class replay_block_ctrl_impl : public replay_block_ctrl
 {
 public:
@@ -20,6 +35,8 @@ public:
     static const uint32_t DEFAULT_BUFFER_SIZE = 32 * 1024 * 1024;
     static const uint32_t DEFAULT_WPP         = 182;
     static const uint32_t DEFAULT_SPP         = DEFAULT_WPP * SAMPLES_PER_WORD;
+    //! Most bytes to hand to a single send() call when uploading
+    static const size_t MAX_UPLOAD_CHUNK = 4 * 1024 * 1024;
 
 
     UHD_RFNOC_BLOCK_CONSTRUCTOR(replay_block_ctrl)
@@ -114,6 +131,58 @@ public:
         sr_write("RX_CTRL_HALT", 1, chan);
     }
 
+    void upload(uhd::tx_streamer::sptr tx_stream,
+        const void* buff,
+        const uint32_t num_bytes,
+        const uint32_t base_addr,
+        const size_t chan,
+        const double timeout)
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(buff);
+        size_t offset        = 0;
+        _upload(tx_stream,
+            num_bytes,
+            base_addr,
+            chan,
+            timeout,
+            [&](const void*& chunk) {
+                chunk = bytes + offset;
+                return num_bytes - offset;
+            },
+            [&](const size_t n) { offset += n; });
+    }
+
+    uint32_t upload_file(uhd::tx_streamer::sptr tx_stream,
+        const std::string& file,
+        const uint32_t base_addr,
+        const size_t chan,
+        const uhd::device_addr_t& player_args,
+        const double timeout)
+    {
+        if (player_args.has_key("loop")) {
+            throw uhd::value_error("Cannot upload a looped file to the Replay block");
+        }
+        auto player = uhd::file_player::make({file}, REPLAY_WORD_SIZE, player_args);
+        if (player->get_size() > std::numeric_limits<uint32_t>::max()) {
+            throw uhd::value_error(
+                str(boost::format("File %s is too large for the Replay block") % file));
+        }
+        const uint32_t num_bytes = uint32_t(player->get_size());
+        std::vector<const void*> buffs;
+        _upload(tx_stream,
+            num_bytes,
+            base_addr,
+            chan,
+            timeout,
+            [&](const void*& chunk) {
+                const size_t n = player->get_buffs(buffs, timeout);
+                chunk          = n ? buffs[0] : nullptr;
+                return n;
+            },
+            [&](const size_t n) { player->consume(n); });
+        return num_bytes;
+    }
+
 
     /***************************************************************************
      * Radio-like Streamer
@@ -183,6 +252,112 @@ public:
     }
 
 private:
+    /*! Record \p num_bytes from \p tx_stream at \p base_addr
+     *
+     * \p get_chunk points its argument at the next data and returns the number
+     * of bytes there, \p consume marks bytes as sent.
+     */
+    void _upload(uhd::tx_streamer::sptr tx_stream,
+        const uint32_t num_bytes,
+        const uint32_t base_addr,
+        const size_t chan,
+        const double timeout,
+        const std::function<size_t(const void*&)>& get_chunk,
+        const std::function<void(size_t)>& consume)
+    {
+        if (num_bytes == 0 or num_bytes % REPLAY_WORD_SIZE != 0
+            or base_addr % REPLAY_WORD_SIZE != 0) {
+            throw uhd::value_error(
+                str(boost::format("Replay upload of %d bytes to 0x%X is not aligned "
+                                  "to %d-byte words")
+                    % num_bytes % base_addr % REPLAY_WORD_SIZE));
+        }
+        // Every packet but the last must end on a word boundary
+        const size_t spp = tx_stream->get_max_num_samps();
+        if (spp % SAMPLES_PER_WORD != 0) {
+            throw uhd::value_error(
+                str(boost::format("Replay upload needs a streamer with a multiple of "
+                                  "%d samples per packet (got %d), set the spp "
+                                  "stream arg")
+                    % SAMPLES_PER_WORD % spp));
+        }
+        UHD_RFNOC_BLOCK_TRACE() << "replay_block_ctrl_impl::upload() " << num_bytes
+                                << " bytes to 0x" << std::hex << base_addr << std::dec
+                                << " on channel " << chan;
+
+        config_record(base_addr, num_bytes, chan);
+        _flush_record(chan, timeout);
+
+        // Send whole packets in large chunks, so flow control can keep the
+        // transport full while send() works through a chunk.
+        const size_t max_chunk_samps =
+            std::max<size_t>(spp, MAX_UPLOAD_CHUNK / BYTES_PER_SAMPLE / spp * spp);
+        uhd::tx_metadata_t md;
+        md.start_of_burst = true;
+        md.end_of_burst   = false;
+        size_t num_sent   = 0;
+        while (num_sent < num_bytes) {
+            const void* chunk      = nullptr;
+            const size_t num_avail =
+                std::min<size_t>(get_chunk(chunk), num_bytes - num_sent);
+            if (num_avail < BYTES_PER_SAMPLE) {
+                throw uhd::io_error("Replay upload timed out waiting for data");
+            }
+            const size_t num_samps =
+                std::min(num_avail / BYTES_PER_SAMPLE, max_chunk_samps);
+            md.end_of_burst = (num_sent + num_samps * BYTES_PER_SAMPLE == num_bytes);
+            const size_t n  = tx_stream->send(chunk, num_samps, md, timeout);
+            consume(n * BYTES_PER_SAMPLE);
+            num_sent += n * BYTES_PER_SAMPLE;
+            md.start_of_burst = false;
+            if (n != num_samps) {
+                throw uhd::io_error(str(
+                    boost::format("Replay upload timed out after sending %d of %d bytes")
+                    % num_sent % num_bytes));
+            }
+        }
+
+        // Data may still be in flight, wait until all of it is in the memory
+        const auto deadline = std::chrono::steady_clock::now()
+                              + std::chrono::duration<double>(timeout);
+        uint32_t fullness;
+        while ((fullness = get_record_fullness(chan)) < num_bytes) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                throw uhd::io_error(
+                    str(boost::format("Replay upload: only %d of %d bytes arrived in "
+                                      "the record buffer")
+                        % fullness % num_bytes));
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        config_play(base_addr, num_bytes, chan);
+    }
+
+    /*! Restart the record buffer until no stale data arrives on the input
+     *
+     * Data that was buffered upstream of the block would otherwise end up in
+     * front of the upload.
+     */
+    void _flush_record(const size_t chan, const double timeout)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + FLUSH_QUIET_TIME
+                              + std::chrono::duration<double>(timeout);
+        uint32_t fullness;
+        do {
+            if (std::chrono::steady_clock::now() > deadline) {
+                throw uhd::io_error("Replay upload: the record input did not go idle");
+            }
+            record_restart(chan);
+            const auto quiet_start = std::chrono::steady_clock::now();
+            do {
+                fullness = get_record_fullness(chan);
+            } while (fullness == 0
+                     and std::chrono::steady_clock::now() - quiet_start
+                             < FLUSH_QUIET_TIME);
+        } while (fullness != 0);
+    }
+
     struct replay_params_t
     {
         size_t words_per_packet;
@@ -5,23 +5,34 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 //
 
-#include "../transport/super_recv_packet_handler.hpp"
+#include "../usrp/device3/device3_impl.hpp"
 #include <uhd/rfnoc/source_node_ctrl.hpp>
 #include <uhd/utils/log.hpp>
 #include <uhdlib/rfnoc/radio_ctrl_impl.hpp>
 #include <uhdlib/rfnoc/rx_stream_terminator.hpp>
 #include <boost/format.hpp>
+#include <chrono>
 
 using namespace uhd::rfnoc;
 
+namespace {
+//! Time between reading the device time and restarting streaming
+constexpr double OVERFLOW_RESTART_DELAY = 0.05;
+} // namespace
+
 size_t rx_stream_terminator::_count = 0;
 
+const double rx_stream_terminator::DEFAULT_FAST_RESTART_DELAY = 0.005;
+
 rx_stream_terminator::rx_stream_terminator()
     : _term_index(_count)
     , _samp_rate(rate_node_ctrl::RATE_UNDEFINED)
     , _tick_rate(tick_node_ctrl::RATE_UNDEFINED)
+    , _overflow_restart_delay(DEFAULT_FAST_RESTART_DELAY)
+    , _restart_cmd(stream_cmd_t::STREAM_MODE_START_CONTINUOUS)
 {
     _count++;
+    _restart_cmd.stream_now = false;
 }
 
 std::string rx_stream_terminator::unique_id() const
@@ -47,6 +58,7 @@ void rx_stream_terminator::set_rx_streamer(bool active, const size_t)
         }
         _rx_streamer_active[upstream_node.first] = active;
     }
+    _graph_changed(true);
 }
 
 void rx_stream_terminator::handle_overrun(
@@ -66,8 +78,8 @@ void rx_stream_terminator::handle_overrun(
     }
 
     UHD_RFNOC_BLOCK_TRACE() << "rx_stream_terminator::handle_overrun()";
-    boost::shared_ptr<uhd::transport::sph::recv_packet_streamer> my_streamer =
-        boost::dynamic_pointer_cast<uhd::transport::sph::recv_packet_streamer>(
+    auto my_streamer =
+        boost::dynamic_pointer_cast<uhd::usrp::device3_recv_packet_streamer>(
             streamer.lock());
     if (not my_streamer)
         return; // If the rx_streamer has expired then overflow handling makes no sense.
@@ -101,6 +113,12 @@ void rx_stream_terminator::handle_overrun(
     /////////////////////////////////////////////////////////////
     // MIMO overflow recovery time
     /////////////////////////////////////////////////////////////
+    const auto start = std::chrono::steady_clock::now();
+    const bool fast_restart = _fast_overflow_recovery and in_continuous_streaming_mode;
+    time_spec_t time_now;
+    if (fast_restart) {
+        time_now = upstream_radio_nodes[0]->get_time_now();
+    }
     for (const boost::shared_ptr<uhd::rfnoc::radio_ctrl_impl>& node :
         upstream_radio_nodes) {
         for (const size_t port : node->get_active_rx_ports()) {
@@ -109,24 +127,48 @@ void rx_stream_terminator::handle_overrun(
             node->issue_stream_cmd(stream_cmd_t::STREAM_MODE_STOP_CONTINUOUS, port);
         }
     }
-    // flush transports
-    my_streamer->flush_all(0.001); // TODO flushing will probably have to go away.
+    // flush transports, unless streaming restarts right away and the
+    // alignment logic drops what is left in them
+    if (not fast_restart) {
+        my_streamer->flush_all(0.001); // TODO flushing will probably have to go away.
+    }
     // restart streaming on all channels
     if (in_continuous_streaming_mode) {
-        stream_cmd_t stream_cmd(stream_cmd_t::STREAM_MODE_START_CONTINUOUS);
-        stream_cmd.stream_now = false;
-        stream_cmd.time_spec =
-            upstream_radio_nodes[0]->get_time_now() + time_spec_t(0.05);
+        if (fast_restart) {
+            // The start commands take about as long as the stop commands did,
+            // the restart delay is the margin on top of that
+            const std::chrono::duration<double> stop_time =
+                std::chrono::steady_clock::now() - start;
+            _restart_cmd.time_spec =
+                time_now + time_spec_t(2 * stop_time.count() + _overflow_restart_delay);
+        } else {
+            _restart_cmd.time_spec = upstream_radio_nodes[0]->get_time_now()
+                                     + time_spec_t(OVERFLOW_RESTART_DELAY);
+        }
 
         for (const boost::shared_ptr<uhd::rfnoc::radio_ctrl_impl>& node :
             upstream_radio_nodes) {
             for (const size_t port : node->get_active_rx_ports()) {
-                node->issue_stream_cmd(stream_cmd, port);
+                node->issue_stream_cmd(_restart_cmd, port);
             }
         }
+        const std::chrono::duration<double, std::milli> handling_time =
+            std::chrono::steady_clock::now() - start;
+        UHD_LOGGER_DEBUG("STREAMER")
+            << boost::format("Overflow handling took %.3f ms, streaming restarts at "
+                             "%.6f s")
+                   % handling_time.count() % _restart_cmd.time_spec.get_real_secs();
     }
 }
 
+void rx_stream_terminator::set_overflow_recovery(
+    const bool fast, const double restart_delay)
+{
+    std::lock_guard<std::mutex> l(_overrun_handler_mutex);
+    _fast_overflow_recovery = fast;
+    _overflow_restart_delay = restart_delay;
+}
+
 rx_stream_terminator::~rx_stream_terminator()
 {
     UHD_RFNOC_BLOCK_TRACE() << "rx_stream_terminator::~rx_stream_terminator() ";
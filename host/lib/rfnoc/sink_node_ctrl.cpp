@@ -51,6 +51,7 @@ void sink_node_ctrl::set_tx_streamer(bool active, const size_t port)
     }
 
     _tx_streamer_active[port] = active;
+    _graph_changed(true);
 }
 
 size_t sink_node_ctrl::_request_input_port(
@@ -77,4 +78,5 @@ void sink_node_ctrl::_register_upstream_node(
     // Alles klar, Herr Kommissar :)
 
     _upstream_nodes[port] = boost::weak_ptr<node_ctrl_base>(upstream_node);
+    _graph_changed();
 }
@@ -50,6 +50,7 @@ void source_node_ctrl::set_rx_streamer(bool active, const size_t port)
     }
 
     _rx_streamer_active[port] = active;
+    _graph_changed(true);
 }
 
 size_t source_node_ctrl::_request_output_port(
@@ -77,4 +78,5 @@ void source_node_ctrl::_register_downstream_node(
     // Alles klar, Herr Kommissar :)
 
     _downstream_nodes[port] = boost::weak_ptr<node_ctrl_base>(downstream_node);
+    _graph_changed();
 }
@@ -0,0 +1,185 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/rfnoc/block_ctrl_base.hpp>
+#include <uhd/rfnoc/graph.hpp>
+#include <uhd/rfnoc/spectrum_monitor.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhd/utils/safe_call.hpp>
+#include <uhdlib/rfnoc/spectrum.hpp>
+#include <boost/format.hpp>
+#include <boost/make_shared.hpp>
+
+using namespace uhd;
+using namespace uhd::rfnoc;
+
+namespace {
+
+constexpr size_t DEFAULT_FFT_SIZE = 256;
+
+bool is_port_free(const node_ctrl_base::node_map_t& nodes)
+{
+    return nodes.count(0) == 0 or nodes.at(0).expired();
+}
+
+//! Find a block on \p mb_index whose ports aren't connected yet
+block_id_t find_free_block(const device3& device,
+    const size_t mb_index,
+    const std::string& block_name,
+    const std::string& hint)
+{
+    for (const block_id_t& block_id : device.find_blocks(str(
+             boost::format("%d/%s") % mb_index % (hint.empty() ? block_name : hint)))) {
+        auto block = device.get_block_ctrl(block_id);
+        if (is_port_free(block->list_upstream_nodes())
+            and is_port_free(block->list_downstream_nodes())) {
+            return block_id;
+        }
+    }
+    throw uhd::runtime_error(
+        str(boost::format("spectrum_monitor: No free %s block on motherboard %d")
+            % (hint.empty() ? block_name : hint) % mb_index));
+}
+
+} // namespace
+
+class spectrum_monitor_impl : public spectrum_monitor
+{
+public:
+    spectrum_monitor_impl(device3::sptr device,
+        const block_id_t& source_block,
+        const size_t source_port,
+        const device_addr_t& args)
+        : _fft_size(args.cast<size_t>("fft_size", DEFAULT_FFT_SIZE))
+    {
+        const double averaging = args.cast<double>("averaging", 0.0);
+        const size_t decim     = args.cast<size_t>("decim", 1);
+        if (averaging < 0.0 or averaging >= 1.0) {
+            throw uhd::value_error(str(
+                boost::format("spectrum_monitor: averaging must be in [0, 1), not %f")
+                % averaging));
+        }
+        if (decim == 0) {
+            throw uhd::value_error("spectrum_monitor: decim must be at least 1");
+        }
+
+        const size_t mb_index = source_block.get_device_no();
+        _block_ids.push_back(
+            find_free_block(*device, mb_index, "FFT", args.get("fft_block", "")));
+        auto fft = device->get_block_ctrl(_block_ids.back());
+        fft->set_arg<int>("spp", int(_fft_size));
+        fft->set_arg<std::string>("magnitude_out", "MAGNITUDE");
+        if (averaging > 0.0) {
+            _block_ids.push_back(find_free_block(
+                *device, mb_index, "VectorIIR", args.get("iir_block", "")));
+            auto iir = device->get_block_ctrl(_block_ids.back());
+            iir->set_arg<int>("spp", int(_fft_size));
+            iir->set_arg<double>("alpha", averaging);
+            iir->set_arg<double>("beta", 1.0 - averaging);
+        }
+        if (decim > 1) {
+            _block_ids.push_back(find_free_block(
+                *device, mb_index, "KeepOneInN", args.get("keep_block", "")));
+            device->get_block_ctrl(_block_ids.back())->set_arg<int>("n", int(decim));
+        }
+
+        // The FFT block takes one spectrum per packet
+        auto source = device->get_block_ctrl(source_block);
+        if (source->get_args(source_port).has_key("spp")) {
+            source->set_arg<int>("spp", int(_fft_size), source_port);
+        }
+        _graph = device->create_graph("spectrum_monitor");
+        _graph->connect(source_block, source_port, _block_ids.front(), 0);
+        for (size_t i = 1; i < _block_ids.size(); i++) {
+            _graph->connect(_block_ids[i - 1], 0, _block_ids[i], 0);
+        }
+
+        stream_args_t stream_args("sc16", "sc16");
+        stream_args.args["block_id"]   = _block_ids.back().to_string();
+        stream_args.args["block_port"] = "0";
+        stream_args.args["spp"]        = str(boost::format("%d") % _fft_size);
+        _streamer                      = device->get_rx_stream(stream_args);
+        _big_endian = _streamer->get_raw_format() == "sc16_item32_be";
+
+        UHD_LOG_INFO("RFNOC",
+            boost::format("Spectrum monitor on %s:%d: %d bins, averaging %f, keeping "
+                          "1 in %d spectra")
+                % source_block.to_string() % source_port % _fft_size % averaging
+                % decim);
+    }
+
+    ~spectrum_monitor_impl(void)
+    {
+        UHD_SAFE_CALL(stop();)
+    }
+
+    size_t get_fft_size(void) const
+    {
+        return _fft_size;
+    }
+
+    std::vector<block_id_t> get_block_ids(void) const
+    {
+        return _block_ids;
+    }
+
+    void start(void)
+    {
+        stream_cmd_t stream_cmd(stream_cmd_t::STREAM_MODE_START_CONTINUOUS);
+        stream_cmd.stream_now = true;
+        _streamer->issue_stream_cmd(stream_cmd);
+    }
+
+    void stop(void)
+    {
+        _streamer->issue_stream_cmd(
+            stream_cmd_t(stream_cmd_t::STREAM_MODE_STOP_CONTINUOUS));
+    }
+
+    bool recv(std::vector<float>& power_db, rx_metadata_t& metadata, const double timeout)
+    {
+        const size_t nsamps = _streamer->recv_raw(_raw_buffs, metadata, timeout);
+        if (nsamps != _fft_size) {
+            _streamer->release_raw();
+            if (nsamps > 0) {
+                metadata.error_code = rx_metadata_t::ERROR_CODE_BAD_PACKET;
+            }
+            return false;
+        }
+        power_db.resize(_fft_size);
+        spectrum_magnitudes_to_db(_raw_buffs[0], _fft_size, _big_endian, power_db.data());
+        _streamer->release_raw();
+        return true;
+    }
+
+    rx_streamer::sptr get_streamer(void) const
+    {
+        return _streamer;
+    }
+
+private:
+    const size_t _fft_size;
+    std::vector<block_id_t> _block_ids;
+    graph::sptr _graph;
+    rx_streamer::sptr _streamer;
+    bool _big_endian;
+    rx_streamer::raw_buffs_type _raw_buffs;
+};
+
+spectrum_monitor::~spectrum_monitor(void)
+{
+    /* NOP */
+}
+
+spectrum_monitor::sptr spectrum_monitor::make(device3::sptr device,
+    const block_id_t& source_block,
+    const size_t source_port,
+    const device_addr_t& args)
+{
+    return boost::make_shared<spectrum_monitor_impl>(
+        device, source_block, source_port, args);
+}
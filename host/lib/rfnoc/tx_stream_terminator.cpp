@@ -44,6 +44,7 @@ void tx_stream_terminator::set_tx_streamer(bool active, const size_t /* port */)
         }
         _tx_streamer_active[downstream_node.first] = active;
     }
+    _graph_changed(true);
 }
 
 tx_stream_terminator::~tx_stream_terminator()
@@ -6,6 +6,7 @@
 //
 
 #include <uhd/rfnoc/constants.hpp>
+#include <uhd/exception.hpp>
 #include <uhdlib/rfnoc/wb_iface_adapter.hpp>
 
 using namespace uhd::rfnoc;
@@ -42,3 +43,48 @@ uint64_t wb_iface_adapter::peek64(const wb_addr_type addr)
     _iface->send_cmd_pkt(SR_READBACK_ADDR, addr / 8, false, timestamp);
     return _iface->send_cmd_pkt(SR_READBACK, SR_READBACK_REG_USER, true, timestamp);
 }
+
+void wb_iface_adapter::multi_poke32(
+    const std::vector<wb_addr_type>& addrs, const std::vector<uint32_t>& data)
+{
+    UHD_ASSERT_THROW(addrs.size() == data.size());
+    const uint64_t timestamp = gettime_functor().to_ticks(gettickrate_functor());
+    ctrl_iface::cmd_batch batch;
+    for (size_t i = 0; i < addrs.size(); i++) {
+        batch.add_cmd(addrs[i] / 4, data[i], timestamp);
+    }
+    _iface->send_cmd_batch(batch);
+}
+
+std::vector<uint32_t> wb_iface_adapter::multi_peek32(
+    const std::vector<wb_addr_type>& addrs)
+{
+    const uint64_t timestamp = gettime_functor().to_ticks(gettickrate_functor());
+    ctrl_iface::cmd_batch batch;
+    std::vector<ctrl_iface::cmd_batch::readback_t> readbacks;
+    for (const wb_addr_type addr : addrs) {
+        batch.add_cmd(SR_READBACK_ADDR, addr / 8, timestamp);
+        readbacks.push_back(
+            batch.add_readback(SR_READBACK, SR_READBACK_REG_USER, timestamp));
+    }
+    _iface->send_cmd_batch(batch);
+
+    std::vector<uint32_t> data;
+    data.reserve(addrs.size());
+    for (size_t i = 0; i < addrs.size(); i++) {
+        const uint64_t reg_value = readbacks[i].get();
+        data.push_back(((addrs[i] / 4) & 0x1) ? uint32_t(reg_value >> 32)
+                                              : uint32_t(reg_value & 0xffffffff));
+    }
+    return data;
+}
+
+void wb_iface_adapter::poke32_schedule(const std::vector<timed_poke32_t>& writes)
+{
+    const double tick_rate = gettickrate_functor();
+    ctrl_iface::cmd_batch batch;
+    for (const timed_poke32_t& write : writes) {
+        batch.add_cmd(write.addr / 4, write.data, write.time.to_ticks(tick_rate));
+    }
+    _iface->send_cmd_batch(batch);
+}
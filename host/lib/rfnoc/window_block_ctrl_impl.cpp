@@ -54,10 +54,8 @@ public:
             coeffs_.push_back(coeffs[i]);
         }
 
-        // Write coefficients via the load bus
-        for (size_t i = 0; i < window_len - 1; i++) {
-            sr_write(AXIS_WINDOW_LOAD, coeffs_[i]);
-        }
+        // Write coefficients via the load bus, as one batch of commands
+        sr_write(AXIS_WINDOW_LOAD, coeffs_);
         // Assert tlast when sending the final coefficient (sorry, no joke here)
         sr_write(AXIS_WINDOW_LOAD_TLAST, coeffs_.back());
         // Set the window length
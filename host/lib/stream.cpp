@@ -5,16 +5,110 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 //
 
+#include <uhd/exception.hpp>
 #include <uhd/stream.hpp>
 
 using namespace uhd;
 
+const size_t stream_stats_t::NUM_LATENCY_BINS;
+
 rx_streamer::~rx_streamer(void)
 {
     //empty
 }
 
+size_t rx_streamer::recv_segments(
+    const segments_type&, rx_metadata_t&, const double, const bool)
+{
+    throw uhd::not_implemented_error(
+        "recv_segments() is not supported by this streamer");
+}
+
+size_t rx_streamer::recv_raw(raw_buffs_type&, rx_metadata_t&, const double)
+{
+    throw uhd::not_implemented_error("recv_raw() is not supported by this streamer");
+}
+
+void rx_streamer::release_raw(void)
+{
+    //nothing held
+}
+
+std::string rx_streamer::get_raw_format(void) const
+{
+    throw uhd::not_implemented_error("recv_raw() is not supported by this streamer");
+}
+
+void rx_streamer::set_capture_ring(const size_t)
+{
+    throw uhd::not_implemented_error(
+        "set_capture_ring() is not supported by this streamer");
+}
+
+size_t rx_streamer::capture(rx_metadata_t&, const double)
+{
+    throw uhd::not_implemented_error("capture() is not supported by this streamer");
+}
+
+size_t rx_streamer::extract_capture(
+    const buffs_type&, const size_t, const time_spec_t&, rx_metadata_t&)
+{
+    throw uhd::not_implemented_error(
+        "extract_capture() is not supported by this streamer");
+}
+
+stream_stats_t rx_streamer::get_stats(void) const
+{
+    throw uhd::not_implemented_error("get_stats() is not supported by this streamer");
+}
+
+bool rx_streamer::prepare_recv_wait(std::vector<int>&)
+{
+    throw uhd::not_implemented_error(
+        "prepare_recv_wait() is not supported by this streamer");
+}
+
 tx_streamer::~tx_streamer(void)
 {
     //empty
 }
+
+size_t tx_streamer::get_send_buffs(raw_buffs_type&, const bool, const double)
+{
+    throw uhd::not_implemented_error(
+        "get_send_buffs() is not supported by this streamer");
+}
+
+void tx_streamer::commit_send_buffs(const size_t, const tx_metadata_t&)
+{
+    throw uhd::not_implemented_error(
+        "commit_send_buffs() is not supported by this streamer");
+}
+
+size_t tx_streamer::send_bursts(const std::vector<burst_t>&, const double)
+{
+    throw uhd::not_implemented_error("send_bursts() is not supported by this streamer");
+}
+
+size_t tx_streamer::recv_burst_status(std::vector<burst_status_t>&, const double)
+{
+    throw uhd::not_implemented_error(
+        "recv_burst_status() is not supported by this streamer");
+}
+
+int tx_streamer::get_async_msg_fd(void) const
+{
+    return -1;
+}
+
+tx_streamer::lead_time_t tx_streamer::get_lead_time(void) const
+{
+    throw uhd::not_implemented_error(
+        "get_lead_time() is not supported by this streamer, set the lead_time stream "
+        "arg");
+}
+
+stream_stats_t tx_streamer::get_stats(void) const
+{
+    throw uhd::not_implemented_error("get_stats() is not supported by this streamer");
+}
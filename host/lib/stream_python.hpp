@@ -138,6 +138,123 @@ static size_t wrap_send(uhd::tx_streamer *tx_stream,
     return result;
 }
 
+/*! Get one pointer per channel into \p np_array, starting at sample \p offset
+ *
+ * Unlike PyArray_FROM_OF(), this never makes a copy, so the samples go
+ * straight into (or come straight from) the caller's array. Returns the
+ * number of samples per channel from \p offset to the end of the array.
+ */
+static size_t get_array_buffs(py::object& np_array,
+    const size_t channels,
+    const size_t offset,
+    const bool writeable,
+    std::vector<void*>& buffs)
+{
+    if (not PyArray_Check(np_array.ptr())) {
+        throw uhd::value_error("Expected a NumPy array");
+    }
+    PyArrayObject* array_type_obj = reinterpret_cast<PyArrayObject*>(np_array.ptr());
+    if (writeable ? not PyArray_ISCARRAY(array_type_obj)
+                  : not PyArray_ISCARRAY_RO(array_type_obj)) {
+        throw uhd::value_error(writeable
+                                   ? "The array must be C-contiguous and writeable"
+                                   : "The array must be C-contiguous");
+    }
+
+    // Check if numpy array sizes are okay
+    const size_t dims     = PyArray_NDIM(array_type_obj);
+    const npy_intp* shape = PyArray_SHAPE(array_type_obj);
+    const size_t input_channels = (dims == 2) ? shape[0] : 1;
+    if (dims < 1 or dims > 2 or input_channels < channels) {
+        throw uhd::runtime_error(str(boost::format(
+            "Number of channels (%d) does not match the dimensions of the data array (%d)")
+            % channels % input_channels));
+    }
+    const size_t nsamps_per_buff =
+        (dims == 2) ? (size_t)shape[1] : (size_t)PyArray_SIZE(array_type_obj);
+    if (offset > nsamps_per_buff) {
+        throw uhd::value_error(str(
+            boost::format("Offset %d is beyond the end of the array (%d samples)")
+            % offset % nsamps_per_buff));
+    }
+
+    // Rows are channels, the last dimension is samples
+    const npy_intp* strides = PyArray_STRIDES(array_type_obj);
+    char* data = PyArray_BYTES(array_type_obj) + offset * strides[dims - 1];
+    buffs.clear();
+    for (size_t i = 0; i < channels; ++i) {
+        buffs.push_back(data + ((dims == 2) ? i * strides[0] : 0));
+    }
+    return nsamps_per_buff - offset;
+}
+
+/*! Receive into \p np_array from sample \p offset until it is full
+ *
+ * Calls recv() as often as needed with the GIL released for the whole time,
+ * so a receive loop doesn't go back to the interpreter for every packet. Stops
+ * early at an error or the end of a burst, which \p metadata reports. The
+ * time spec in \p metadata is that of the first sample.
+ */
+static size_t wrap_recv_fill(uhd::rx_streamer* rx_stream,
+    py::object& np_array,
+    uhd::rx_metadata_t& metadata,
+    const double timeout = 0.1,
+    const size_t offset  = 0)
+{
+    std::vector<void*> channel_storage;
+    const size_t nsamps_per_buff = get_array_buffs(
+        np_array, rx_stream->get_num_channels(), offset, true, channel_storage);
+    const size_t item_size =
+        PyArray_ITEMSIZE(reinterpret_cast<PyArrayObject*>(np_array.ptr()));
+
+    py::gil_scoped_release release;
+    size_t num_recvd = 0;
+    uhd::time_spec_t first_time;
+    uhd::time_ticks_t first_ticks;
+    bool has_first_time = false;
+    while (num_recvd < nsamps_per_buff) {
+        const size_t num_samps = rx_stream->recv(
+            channel_storage, nsamps_per_buff - num_recvd, metadata, timeout);
+        if (num_recvd == 0 and num_samps > 0 and metadata.has_time_spec) {
+            first_time     = metadata.time_spec;
+            first_ticks    = metadata.time_ticks;
+            has_first_time = true;
+        }
+        num_recvd += num_samps;
+        for (void*& buff : channel_storage) {
+            buff = static_cast<char*>(buff) + num_samps * item_size;
+        }
+        if (metadata.error_code != uhd::rx_metadata_t::ERROR_CODE_NONE
+            or metadata.end_of_burst) {
+            break;
+        }
+    }
+    if (has_first_time) {
+        metadata.time_spec     = first_time;
+        metadata.time_ticks    = first_ticks;
+        metadata.has_time_spec = true;
+    }
+    return num_recvd;
+}
+
+/*! Send \p np_array from sample \p offset to the end, without copying it
+ *
+ * Unlike send(), this refuses arrays that would have to be copied first.
+ */
+static size_t wrap_send_from(uhd::tx_streamer* tx_stream,
+    py::object& np_array,
+    uhd::tx_metadata_t& metadata,
+    const double timeout = 0.1,
+    const size_t offset  = 0)
+{
+    std::vector<void*> channel_storage;
+    const size_t nsamps_per_buff = get_array_buffs(
+        np_array, tx_stream->get_num_channels(), offset, false, channel_storage);
+
+    py::gil_scoped_release release;
+    return tx_stream->send(channel_storage, nsamps_per_buff, metadata, timeout);
+}
+
 static bool wrap_recv_async_msg(uhd::tx_streamer *tx_stream,
                                 uhd::async_metadata_t &async_metadata,
                                 double timeout = 0.1)
@@ -169,6 +286,11 @@ void export_stream(py::module& m)
                                     py::arg("np_array"),
                                     py::arg("metadata"),
                                     py::arg("timeout") = 0.1)
+        .def("recv_fill"        , &wrap_recv_fill,
+                                    py::arg("np_array"),
+                                    py::arg("metadata"),
+                                    py::arg("timeout") = 0.1,
+                                    py::arg("offset") = 0)
         .def("get_num_channels" , &uhd::rx_streamer::get_num_channels )
         .def("get_max_num_samps", &uhd::rx_streamer::get_max_num_samps)
         .def("issue_stream_cmd" , &uhd::rx_streamer::issue_stream_cmd )
@@ -180,6 +302,11 @@ void export_stream(py::module& m)
                                     py::arg("np_array"),
                                     py::arg("metadata"),
                                     py::arg("timeout") = 0.1)
+        .def("send_from"        , &wrap_send_from,
+                                    py::arg("np_array"),
+                                    py::arg("metadata"),
+                                    py::arg("timeout") = 0.1,
+                                    py::arg("offset") = 0)
         .def("get_num_channels" , &tx_streamer::get_num_channels  )
         .def("get_max_num_samps", &tx_streamer::get_max_num_samps )
         .def("recv_async_msg"   , &wrap_recv_async_msg,
@@ -5,11 +5,27 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 //
 
+#include <uhd/exception.hpp>
 #include <uhd/transport/buffer_pool.hpp>
 #include <uhd/transport/zero_copy.hpp>
-#include <boost/shared_array.hpp>
+#include <uhd/utils/log.hpp>
+#include <boost/checked_delete.hpp>
+#include <boost/shared_ptr.hpp>
+#include <cerrno>
+#include <cstring>
 #include <vector>
 
+#ifdef HAVE_MMAP_HUGETLB
+#    include <sys/mman.h>
+#    include <unistd.h>
+#endif /* HAVE_MMAP_HUGETLB */
+
+#ifdef HAVE_MBIND
+#    include <linux/mempolicy.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#endif /* HAVE_MBIND */
+
 using namespace uhd::transport;
 
 #ifdef UHD_TXRX_DEBUG_PRINTS
@@ -32,13 +48,105 @@ buffer_pool::~buffer_pool(void)
     /* NOP */
 }
 
+/***********************************************************************
+ * Memory allocation
+ **********************************************************************/
+static constexpr size_t HUGEPAGE_SIZE_2M = size_t(1) << 21;
+static constexpr size_t HUGEPAGE_SIZE_1G = size_t(1) << 30;
+
+#ifdef HAVE_MBIND
+//! Ask the kernel to place the pages of a fresh mapping on a NUMA node
+static void prefer_numa_node(void* mem, const size_t len, const int numa_node)
+{
+    constexpr size_t bits_per_word = 8 * sizeof(unsigned long);
+    std::vector<unsigned long> nodemask(size_t(numa_node) / bits_per_word + 1, 0);
+    nodemask[size_t(numa_node) / bits_per_word] |= 1UL << (numa_node % bits_per_word);
+    // Not BIND: running out of memory on the node must not fail the faults
+    if (syscall(SYS_mbind,
+            mem,
+            len,
+            MPOL_PREFERRED,
+            nodemask.data(),
+            nodemask.size() * bits_per_word,
+            0)
+        != 0) {
+        UHD_LOG_WARNING("BUFFER_POOL",
+            "Can't place buffers on NUMA node " << numa_node << ": "
+                                                << std::strerror(errno));
+    }
+}
+#endif /* HAVE_MBIND */
+
+//! Allocate a block of memory as specified by the memory parameters
+static boost::shared_ptr<char> alloc_mem(
+    const size_t bytes, const buffer_pool::mem_params_t& mem_params)
+{
+    if (mem_params.hugepage_size == 0 and mem_params.numa_node < 0) {
+        return boost::shared_ptr<char>(
+            new char[bytes], boost::checked_array_deleter<char>());
+    }
+
+#ifdef HAVE_MMAP_HUGETLB
+    const int flags  = MAP_PRIVATE | MAP_ANONYMOUS;
+    size_t page_size = size_t(sysconf(_SC_PAGESIZE));
+    void* mem        = MAP_FAILED;
+    if (mem_params.hugepage_size != 0) {
+        const int page_shift = mem_params.hugepage_size == HUGEPAGE_SIZE_1G ? 30 : 21;
+        mem = mmap(nullptr,
+            pad_to_boundary(bytes, mem_params.hugepage_size),
+            PROT_READ | PROT_WRITE,
+            flags | MAP_HUGETLB | (page_shift << MAP_HUGE_SHIFT),
+            -1,
+            0);
+        if (mem == MAP_FAILED) {
+            UHD_LOG_WARNING("BUFFER_POOL",
+                "Can't allocate " << bytes << " bytes in "
+                                  << (mem_params.hugepage_size >> 20)
+                                  << " MB hugepages (" << std::strerror(errno)
+                                  << "), using regular pages. Check "
+                                     "/proc/sys/vm/nr_hugepages.");
+        } else {
+            page_size = mem_params.hugepage_size;
+        }
+    }
+    if (mem == MAP_FAILED) {
+        mem = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, flags, -1, 0);
+        if (mem == MAP_FAILED) {
+            throw uhd::os_error(
+                std::string("Can't allocate buffer pool: ") + std::strerror(errno));
+        }
+    }
+    const size_t len = pad_to_boundary(bytes, page_size);
+
+#    ifdef HAVE_MBIND
+    // The pages aren't touched yet, so the policy applies to all of them
+    if (mem_params.numa_node >= 0) {
+        prefer_numa_node(mem, len, mem_params.numa_node);
+    }
+#    else
+    if (mem_params.numa_node >= 0) {
+        UHD_LOG_WARNING("BUFFER_POOL",
+            "NUMA placement is not supported on this platform, ignoring numa_node");
+    }
+#    endif /* HAVE_MBIND */
+
+    return boost::shared_ptr<char>(
+        static_cast<char*>(mem), [len](char* ptr) { munmap(ptr, len); });
+#else
+    UHD_LOG_WARNING("BUFFER_POOL",
+        "Hugepages and NUMA placement are not supported on this platform, using "
+        "regular heap memory");
+    return boost::shared_ptr<char>(new char[bytes], boost::checked_array_deleter<char>());
+#endif /* HAVE_MMAP_HUGETLB */
+}
+
 /***********************************************************************
  * Buffer pool implementation
  **********************************************************************/
 class buffer_pool_impl : public buffer_pool
 {
 public:
-    buffer_pool_impl(const std::vector<ptr_type>& ptrs, boost::shared_array<char> mem)
+    buffer_pool_impl(const std::vector<ptr_type>& ptrs, boost::shared_ptr<char> mem)
         : _ptrs(ptrs), _mem(mem)
     {
         /* NOP */
@@ -56,7 +164,7 @@ public:
 
 private:
     std::vector<ptr_type> _ptrs;
-    boost::shared_array<char> _mem;
+    boost::shared_ptr<char> _mem;
 };
 
 /***********************************************************************
@@ -64,12 +172,21 @@ private:
  **********************************************************************/
 buffer_pool::sptr buffer_pool::make(
     const size_t num_buffs, const size_t buff_size, const size_t alignment)
+{
+    return make(num_buffs, buff_size, alignment, mem_params_t());
+}
+
+buffer_pool::sptr buffer_pool::make(const size_t num_buffs,
+    const size_t buff_size,
+    const size_t alignment,
+    const mem_params_t& mem_params)
 {
     // 1) pad the buffer size to be a multiple of alignment
     // 2) pad the overall memory size for room after alignment
     // 3) allocate the memory in one block of sufficient size
     const size_t padded_buff_size = pad_to_boundary(buff_size, alignment);
-    boost::shared_array<char> mem(new char[padded_buff_size * num_buffs + alignment - 1]);
+    boost::shared_ptr<char> mem =
+        alloc_mem(padded_buff_size * num_buffs + alignment - 1, mem_params);
 
     // Fill a vector with boundary-aligned points in the memory
     const size_t mem_start = pad_to_boundary(size_t(mem.get()), alignment);
@@ -83,3 +200,14 @@ buffer_pool::sptr buffer_pool::make(
     // - the reference to allocated memory.
     return sptr(new buffer_pool_impl(ptrs, mem));
 }
+
+buffer_pool::mem_params_t buffer_pool::get_mem_params(const device_addr_t& hints)
+{
+    mem_params_t mem_params;
+    if (hints.has_key("hugepages")) {
+        mem_params.hugepage_size = hints.get("hugepages") == "1G" ? HUGEPAGE_SIZE_1G
+                                                                  : HUGEPAGE_SIZE_2M;
+    }
+    mem_params.numa_node = hints.cast<int>("numa_node", mem_params.numa_node);
+    return mem_params;
+}
@@ -8,6 +8,7 @@
 #include <uhd/exception.hpp>
 #include <uhd/transport/chdr.hpp>
 #include <uhd/utils/byteswap.hpp>
+#include <algorithm>
 
 // define the endian macros to convert integers
 #ifdef UHD_BIG_ENDIAN
@@ -166,3 +167,116 @@ void chdr::if_hdr_unpack_le(const uint32_t* packet_buff, if_packet_info_t& if_pa
                              | LE_MACRO(packet_buff[3]);
     }
 }
+
+
+/***************************************************************************/
+/* Batch unpacking                                                         */
+/***************************************************************************/
+const size_t chdr::if_hdr_batch_t::max_size;
+
+void chdr::if_hdr_batch_t::get_if_packet_info(
+    const size_t index, if_packet_info_t& if_packet_info) const
+{
+    if_packet_info.link_type    = if_packet_info_t::LINK_TYPE_CHDR;
+    if_packet_info.has_cid      = false;
+    if_packet_info.has_sid      = true;
+    if_packet_info.has_tsi      = false;
+    if_packet_info.has_tlr      = false;
+    if_packet_info.sob          = false;
+    if_packet_info.has_tsf      = has_tsf[index];
+    if_packet_info.packet_type  = if_packet_info_t::packet_type_t(packet_type[index]);
+    if_packet_info.eob          = eob[index];
+    if_packet_info.error        = error[index];
+    if_packet_info.fc_ack       = fc_ack[index];
+    if_packet_info.packet_count = packet_count[index];
+    if_packet_info.sid          = sid[index];
+    if (has_tsf[index]) {
+        if_packet_info.tsf = tsf[index];
+    }
+
+    if_packet_info.num_header_words32 = has_tsf[index] ? 4 : 2;
+    const size_t pkt_size_bytes       = num_packet_bytes[index];
+    const size_t pkt_size_word32      = (pkt_size_bytes + 3) / 4;
+    if_packet_info.num_payload_bytes =
+        pkt_size_bytes - (4 * if_packet_info.num_header_words32);
+    if_packet_info.num_payload_words32 =
+        pkt_size_word32 - if_packet_info.num_header_words32;
+}
+
+/*! Unpack a batch of headers, \p to_host converts a word to host endianness.
+ *
+ * Only reading the header words from the packets goes packet by packet. The
+ * fields are then decoded in loops over plain arrays, without branches, so
+ * the compiler can turn them into SIMD code.
+ */
+template <typename to_host_type>
+UHD_INLINE void _hdr_unpack_chdr_batch(const uint32_t* const packet_buffs[],
+    const size_t num_packet_words32[],
+    const size_t num_packets,
+    chdr::if_hdr_batch_t& batch,
+    to_host_type to_host)
+{
+    if (num_packets > chdr::if_hdr_batch_t::max_size) {
+        throw uhd::value_error("Too many packets for a CHDR header batch");
+    }
+    batch.size = num_packets;
+
+    uint32_t words0[chdr::if_hdr_batch_t::max_size];
+    uint32_t num_words32[chdr::if_hdr_batch_t::max_size];
+    for (size_t i = 0; i < num_packets; i++) {
+        words0[i]      = to_host(packet_buffs[i][0]);
+        batch.sid[i]   = to_host(packet_buffs[i][1]);
+        num_words32[i] = uint32_t(std::min<size_t>(num_packet_words32[i], 0xFFFF));
+    }
+
+    for (size_t i = 0; i < num_packets; i++) {
+        const uint32_t type  = words0[i] >> 30;
+        const bool flag      = (words0[i] & HDR_FLAG_EOB) != 0;
+        batch.packet_type[i] = uint8_t(type);
+        batch.has_tsf[i]     = (words0[i] & HDR_FLAG_TSF) != 0;
+        batch.eob[i]         = flag & (type == if_packet_info_t::PACKET_TYPE_DATA);
+        batch.error[i]       = flag & (type == if_packet_info_t::PACKET_TYPE_RESP);
+        batch.fc_ack[i]      = flag & (type == if_packet_info_t::PACKET_TYPE_FC);
+        batch.packet_count[i]     = uint16_t((words0[i] >> 16) & 0xFFF);
+        batch.num_packet_bytes[i] = uint16_t(words0[i] & 0xFFFF);
+    }
+
+    // Same checks as _hdr_unpack_chdr(), but they mark the packet instead of throwing
+    for (size_t i = 0; i < num_packets; i++) {
+        const uint32_t hdr_words32 = batch.has_tsf[i] ? 4 : 2;
+        const uint32_t pkt_words32 = (uint32_t(batch.num_packet_bytes[i]) + 3) / 4;
+        batch.valid[i] = (pkt_words32 >= hdr_words32) & (pkt_words32 <= num_words32[i]);
+    }
+
+    for (size_t i = 0; i < num_packets; i++) {
+        batch.tsf[i] = 0;
+        if (batch.has_tsf[i] and batch.valid[i]) {
+            batch.tsf[i] = uint64_t(to_host(packet_buffs[i][2])) << 32
+                           | to_host(packet_buffs[i][3]);
+        }
+    }
+}
+
+void chdr::if_hdr_unpack_batch_be(const uint32_t* const packet_buffs[],
+    const size_t num_packet_words32[],
+    const size_t num_packets,
+    if_hdr_batch_t& batch)
+{
+    _hdr_unpack_chdr_batch(packet_buffs,
+        num_packet_words32,
+        num_packets,
+        batch,
+        [](const uint32_t word) { return BE_MACRO(word); });
+}
+
+void chdr::if_hdr_unpack_batch_le(const uint32_t* const packet_buffs[],
+    const size_t num_packet_words32[],
+    const size_t num_packets,
+    if_hdr_batch_t& batch)
+{
+    _hdr_unpack_chdr_batch(packet_buffs,
+        num_packet_words32,
+        num_packets,
+        batch,
+        [](const uint32_t word) { return LE_MACRO(word); });
+}
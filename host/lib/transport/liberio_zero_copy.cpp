@@ -12,12 +12,29 @@
 #include <liberio/liberio.h>
 #include <sys/syslog.h>
 #include <boost/make_shared.hpp>
+#include <algorithm>
+#include <chrono>
+#include <deque>
 #include <mutex>
 
 namespace uhd { namespace transport {
 
 static const uint64_t USEC = 1000000;
 
+//! Dequeue a buffer of \p chan, polling for up to \p timeout seconds
+static liberio_buf* poll_buf_dequeue(liberio_chan* chan, const double timeout)
+{
+    const auto deadline = std::chrono::steady_clock::now()
+                          + std::chrono::microseconds(int64_t(timeout * USEC));
+    do {
+        liberio_buf* buf = liberio_chan_buf_dequeue(chan, 0);
+        if (buf) {
+            return buf;
+        }
+    } while (std::chrono::steady_clock::now() < deadline);
+    return nullptr;
+}
+
 static void liberio_log_cb(int severity, const char* msg, void*)
 {
     switch (severity) {
@@ -74,12 +91,9 @@ public:
         }
     }
 
-    sptr get_new(double timeout, size_t& index)
+    sptr get_new(liberio_buf* buf, size_t& index)
     {
-        _buf = liberio_chan_buf_dequeue(_chan, timeout * USEC);
-        if (!_buf)
-            return sptr();
-
+        _buf = buf;
         index++;
 
         return make(this, liberio_buf_get_mem(_buf, 0), liberio_buf_get_len(_buf, 0));
@@ -105,12 +119,9 @@ public:
             liberio_chan_buf_enqueue(_chan, _buf);
     }
 
-    sptr get_new(double timeout, size_t& index)
+    sptr get_new(liberio_buf* buf, size_t& index)
     {
-        _buf = liberio_chan_buf_dequeue(_chan, timeout * USEC);
-        if (!_buf)
-            return sptr();
-
+        _buf = buf;
         index++;
 
         return make(this, liberio_buf_get_mem(_buf, 0), liberio_buf_get_payload(_buf, 0));
@@ -126,11 +137,14 @@ class liberio_zero_copy_impl : public liberio_zero_copy
 public:
     liberio_zero_copy_impl(const std::string& tx_path,
         const std::string& rx_path,
-        const zero_copy_xport_params& xport_params)
+        const zero_copy_xport_params& xport_params,
+        const device_addr_t& hints)
         : _tx_buf_size(xport_params.send_frame_size)
         , _rx_buf_size(xport_params.recv_frame_size)
         , _next_recv_buff_index(0)
         , _next_send_buff_index(0)
+        , _batch_size(std::max<size_t>(1, hints.cast<size_t>("dma_batch", 1)))
+        , _poll(hints.has_key("dma_poll"))
     {
         UHD_ASSERT_THROW(xport_params.recv_frame_size > 0);
         UHD_ASSERT_THROW(xport_params.send_frame_size > 0);
@@ -211,9 +225,12 @@ public:
     managed_recv_buffer::sptr get_recv_buff(double timeout = 0.1)
     {
         std::lock_guard<std::mutex> lock(_rx_mutex);
+        liberio_buf* buf = dequeue(_rx_chan, _rx_ready, timeout);
+        if (!buf)
+            return managed_recv_buffer::sptr();
         if (_next_recv_buff_index == _num_recv_bufs)
             _next_recv_buff_index = 0;
-        return _mrb_pool[_next_recv_buff_index]->get_new(timeout, _next_recv_buff_index);
+        return _mrb_pool[_next_recv_buff_index]->get_new(buf, _next_recv_buff_index);
     }
 
     size_t get_num_recv_frames(void) const
@@ -229,9 +246,12 @@ public:
     managed_send_buffer::sptr get_send_buff(double timeout = 0.1)
     {
         std::lock_guard<std::mutex> lock(_tx_mutex);
+        liberio_buf* buf = dequeue(_tx_chan, _tx_ready, timeout);
+        if (!buf)
+            return managed_send_buffer::sptr();
         if (_next_send_buff_index == _num_send_bufs)
             _next_send_buff_index = 0;
-        return _msb_pool[_next_send_buff_index]->get_new(timeout, _next_send_buff_index);
+        return _msb_pool[_next_send_buff_index]->get_new(buf, _next_send_buff_index);
     }
 
     size_t get_num_send_frames(void) const
@@ -245,6 +265,36 @@ public:
     }
 
 private:
+    /*!
+     * Dequeue a buffer of \p chan, or take one that was dequeued earlier
+     *
+     * Once a buffer is available, up to _batch_size - 1 more that are already
+     * done are dequeued along with it. They wait in \p ready for the next
+     * calls, which then don't need to wait on the channel.
+     */
+    liberio_buf* dequeue(
+        liberio_chan* chan, std::deque<liberio_buf*>& ready, const double timeout)
+    {
+        if (ready.empty()) {
+            liberio_buf* buf = _poll ? poll_buf_dequeue(chan, timeout)
+                                     : liberio_chan_buf_dequeue(chan, timeout * USEC);
+            if (!buf) {
+                return nullptr;
+            }
+            ready.push_back(buf);
+            while (ready.size() < _batch_size) {
+                buf = liberio_chan_buf_dequeue(chan, 0);
+                if (!buf) {
+                    break;
+                }
+                ready.push_back(buf);
+            }
+        }
+        liberio_buf* buf = ready.front();
+        ready.pop_front();
+        return buf;
+    }
+
     liberio_chan* _tx_chan;
     const size_t _tx_buf_size;
     size_t _num_send_bufs;
@@ -258,6 +308,11 @@ private:
     size_t _next_send_buff_index;
     std::mutex _rx_mutex;
     std::mutex _tx_mutex;
+    const size_t _batch_size;
+    const bool _poll;
+    //! Buffers dequeued ahead, protected by _rx_mutex and _tx_mutex
+    std::deque<liberio_buf*> _rx_ready;
+    std::deque<liberio_buf*> _tx_ready;
 
     static std::mutex _context_lock;
     static size_t _ref_count;
@@ -270,10 +325,11 @@ std::shared_ptr<liberio_context_holder> liberio_zero_copy_impl::_context_holder{
 
 liberio_zero_copy::sptr liberio_zero_copy::make(const std::string& tx_path,
     const std::string& rx_path,
-    const zero_copy_xport_params& default_buff_args)
+    const zero_copy_xport_params& default_buff_args,
+    const device_addr_t& hints)
 {
     return liberio_zero_copy::sptr(
-        new liberio_zero_copy_impl(tx_path, rx_path, default_buff_args));
+        new liberio_zero_copy_impl(tx_path, rx_path, default_buff_args, hints));
 }
 
 }} // namespace uhd::transport
@@ -25,9 +25,20 @@ class liberio_zero_copy : public virtual zero_copy_if
 public:
     typedef boost::shared_ptr<liberio_zero_copy> sptr;
 
+    /*!
+     * Make a new zero copy transport on a pair of DMA channels
+     *
+     * The hints are:
+     * - dma_batch: Number of buffers to dequeue at once. Whenever a buffer
+     *   becomes available, the ones behind it that are also ready are dequeued
+     *   without waiting, so the following calls don't wait on the channel.
+     * - dma_poll: Poll the channels instead of sleeping while waiting for
+     *   buffers. Lowers the latency at the cost of a busy CPU core.
+     */
     static sptr make(const std::string& tx_path,
         const std::string& rx_path,
-        const zero_copy_xport_params& default_buff_args);
+        const zero_copy_xport_params& default_buff_args,
+        const device_addr_t& hints = device_addr_t());
 };
 
 }} // namespace uhd::transport
@@ -12,6 +12,7 @@
 #include <uhd/utils/log.hpp>
 #include <uhd/utils/tasks.hpp>
 #include <boost/bind.hpp>
+#include <boost/format.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/weak_ptr.hpp>
 #include <cstdlib>
@@ -83,6 +84,22 @@ libusb_session_impl::~libusb_session_impl(void)
     libusb_exit(_context);
 }
 
+libusb::session::sptr libusb::session::get_private_session(const std::string& key)
+{
+    static uhd::dict<std::string, boost::weak_ptr<session>> sessions;
+    static boost::mutex mutex;
+    boost::mutex::scoped_lock lock(mutex);
+
+    if (sessions.has_key(key) and not sessions[key].expired()) {
+        return sessions[key].lock();
+    }
+    UHD_LOGGER_DEBUG("USB") << "Creating libusb session with its own event thread for "
+                            << key;
+    sptr new_session(new libusb_session_impl());
+    sessions[key] = new_session;
+    return new_session;
+}
+
 libusb::session::sptr libusb::session::get_global_session(void)
 {
     static boost::weak_ptr<session> global_session;
@@ -117,9 +134,9 @@ libusb::device::~device(void)
 class libusb_device_impl : public libusb::device
 {
 public:
-    libusb_device_impl(libusb_device* dev)
+    libusb_device_impl(libusb_device* dev, libusb::session::sptr sess)
     {
-        _session = libusb::session::get_global_session();
+        _session = sess;
         _dev     = dev;
     }
 
@@ -151,10 +168,8 @@ libusb::device_list::~device_list(void)
 class libusb_device_list_impl : public libusb::device_list
 {
 public:
-    libusb_device_list_impl(void)
+    libusb_device_list_impl(libusb::session::sptr sess)
     {
-        libusb::session::sptr sess = libusb::session::get_global_session();
-
         // allocate a new list of devices
         libusb_device** dev_list;
         ssize_t ret = libusb_get_device_list(sess->get_context(), &dev_list);
@@ -163,7 +178,8 @@ public:
 
         // fill the vector of device references
         for (size_t i = 0; i < size_t(ret); i++)
-            _devs.push_back(libusb::device::sptr(new libusb_device_impl(dev_list[i])));
+            _devs.push_back(
+                libusb::device::sptr(new libusb_device_impl(dev_list[i], sess)));
 
         // free the device list but dont unref (done in ~device)
         libusb_free_device_list(dev_list, false /*dont unref*/);
@@ -192,7 +208,12 @@ libusb_device_list_impl::~libusb_device_list_impl(void)
 
 libusb::device_list::sptr libusb::device_list::make(void)
 {
-    return sptr(new libusb_device_list_impl());
+    return make(libusb::session::get_global_session());
+}
+
+libusb::device_list::sptr libusb::device_list::make(session::sptr sess)
+{
+    return sptr(new libusb_device_list_impl(sess));
 }
 
 /***********************************************************************
@@ -358,6 +379,22 @@ libusb::device_handle::sptr libusb::device_handle::get_cached_handle(device::spt
     }
 }
 
+libusb::device_handle::sptr libusb::device_handle::get_cached_handle(
+    device::sptr dev, session::sptr sess)
+{
+    const uint8_t bus  = libusb_get_bus_number(dev->get());
+    const uint8_t addr = libusb_get_device_address(dev->get());
+    device_list::sptr dev_list = device_list::make(sess);
+    for (size_t i = 0; i < dev_list->size(); i++) {
+        if (libusb_get_bus_number(dev_list->at(i)->get()) == bus
+            and libusb_get_device_address(dev_list->at(i)->get()) == addr) {
+            return get_cached_handle(dev_list->at(i));
+        }
+    }
+    throw uhd::io_error(str(boost::format("USB device %d:%d not found in session")
+                            % int(bus) % int(addr)));
+}
+
 /***********************************************************************
  * libusb special handle
  **********************************************************************/
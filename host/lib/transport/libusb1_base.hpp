@@ -13,6 +13,7 @@
 #include <libusb.h>
 #include <boost/shared_ptr.hpp>
 #include <uhd/utils/noncopyable.hpp>
+#include <string>
 
 //! Define LIBUSB_CALL when its missing (non-windows)
 #ifndef LIBUSB_CALL
@@ -68,6 +69,14 @@ public:
     //! get a shared pointer to the global session
     static sptr get_global_session(void);
 
+    /*!
+     * Get a session with its own context and event handling thread.
+     * All callers with the same key share a session, as long as any of
+     * them holds a reference to it. Devices which are opened in different
+     * sessions don't wait on each other's events.
+     */
+    static sptr get_private_session(const std::string& key);
+
     //! get the underlying libusb context pointer
     virtual libusb_context* get_context(void) const = 0;
 };
@@ -100,6 +109,9 @@ public:
     //! make a new device list
     static sptr make(void);
 
+    //! make a new device list of the devices seen by a session
+    static sptr make(session::sptr sess);
+
     //! the number of devices in this list
     virtual size_t size() const = 0;
 
@@ -139,6 +151,13 @@ public:
     //! get a cached handle or make a new one given the device
     static sptr get_cached_handle(device::sptr);
 
+    /*!
+     * Get a cached handle to a device, opened in another session.
+     * The device is looked up in the session by bus number and address.
+     * \throws uhd::io_error if the session doesn't see the device
+     */
+    static sptr get_cached_handle(device::sptr, session::sptr sess);
+
     //! get the underlying device handle
     virtual libusb_device_handle* get(void) const = 0;
 
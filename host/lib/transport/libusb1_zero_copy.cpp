@@ -33,6 +33,11 @@ using namespace uhd::transport;
 static const size_t DEFAULT_NUM_XFERS = 16; // num xfers
 static const size_t DEFAULT_XFER_SIZE = 32 * 512; // bytes
 
+//! libusb_dev_mem_alloc() is only in newer API
+#if defined(LIBUSB_API_VERSION) && LIBUSB_API_VERSION >= 0x01000105
+#    define HAVE_LIBUSB_DEV_MEM_ALLOC
+#endif
+
 //! type for sharing the release queue with managed buffers
 class libusb_zero_copy_mb;
 typedef boost::shared_ptr<bounded_buffer<libusb_zero_copy_mb*>> mb_queue_sptr;
@@ -46,6 +51,7 @@ struct lut_result_t
     lut_result_t(void)
     {
         completed     = 0;
+        waiting       = false;
         status        = LIBUSB_TRANSFER_COMPLETED;
         actual_length = 0;
 #ifdef UHD_TXRX_DEBUG_PRINTS
@@ -54,6 +60,8 @@ struct lut_result_t
 #endif
     }
     int completed;
+    //! True while a thread waits for completion, only then it needs a notify
+    bool waiting;
     libusb_transfer_status status;
     int actual_length;
     boost::mutex mut;
@@ -100,8 +108,12 @@ static void LIBUSB_CALL libusb_async_cb(libusb_transfer* lut)
     r->status        = lut->status;
     r->actual_length = lut->actual_length;
     r->completed     = 1;
-    r->usb_transfer_complete.notify_one(); // wake up thread waiting in
-                                           // wait_for_completion() member function below
+    // Wake up the thread waiting in wait_for_completion() below. If no one
+    // waits, the next get_buff() finds the transfer completed anyway, so a
+    // busy streamer doesn't pay for a wakeup per transfer.
+    if (r->waiting) {
+        r->usb_transfer_complete.notify_one();
+    }
 #ifdef UHD_TXRX_DEBUG_PRINTS
     long end_time = boost::get_system_time().time_of_day().total_microseconds();
     libusb1_zerocopy_dbg_print_err(
@@ -184,6 +196,7 @@ public:
     {
         boost::unique_lock<boost::mutex> lock(result.mut);
         if (!result.completed) {
+            result.waiting = true;
             if (timeout < 0.0) {
                 result.usb_transfer_complete.wait(lock);
             } else {
@@ -193,6 +206,7 @@ public:
                 result.usb_transfer_complete.timed_wait(
                     lock, timeout_time, lut_result_completed(result));
             }
+            result.waiting = false;
         }
         return (result.completed > 0);
     }
@@ -221,11 +235,11 @@ public:
         const int interface,
         const unsigned char endpoint,
         const size_t num_frames,
-        const size_t frame_size)
+        const size_t frame_size,
+        const bool use_dev_mem)
         : _handle(handle)
         , _num_frames(num_frames)
         , _frame_size(frame_size)
-        , _buffer_pool(buffer_pool::make(_num_frames, _frame_size))
         , _enqueued(_num_frames)
         , _released(_num_frames)
         , _status(STATUS_RUNNING)
@@ -252,6 +266,15 @@ public:
                     break;
             }
 
+        // Buffers in device memory are mapped to the kernel, so usbfs doesn't
+        // copy the data of each transfer
+        if (use_dev_mem) {
+            alloc_dev_mem(name);
+        }
+        if (_dev_mem.empty()) {
+            _buffer_pool = buffer_pool::make(_num_frames, _frame_size);
+        }
+
         // allocate libusb transfer structs and managed buffers
         for (size_t i = 0; i < get_num_frames(); i++) {
             libusb_transfer* lut = libusb_alloc_transfer(0);
@@ -266,7 +289,8 @@ public:
             libusb_fill_bulk_transfer(lut, // transfer
                 _handle->get(), // dev_handle
                 endpoint, // endpoint
-                static_cast<unsigned char*>(_buffer_pool->at(i)), // buffer
+                _dev_mem.empty() ? static_cast<unsigned char*>(_buffer_pool->at(i))
+                                 : _dev_mem[i], // buffer
                 int(this->get_frame_size()), // length
                 libusb_transfer_cb_fn(&libusb_async_cb), // callback
                 static_cast<void*>(&_mb_pool.back()->result), // user_data
@@ -304,6 +328,7 @@ public:
         for (libusb_transfer* lut : _all_luts) {
             libusb_free_transfer(lut);
         }
+        free_dev_mem();
     }
 
     template <typename buffer_type>
@@ -351,6 +376,8 @@ private:
 
     //! Storage for transfer related objects
     buffer_pool::sptr _buffer_pool;
+    //! Buffers from libusb_dev_mem_alloc(), used instead of _buffer_pool
+    std::vector<unsigned char*> _dev_mem;
     std::vector<boost::shared_ptr<libusb_zero_copy_mb>> _mb_pool;
 
     boost::mutex _queue_mutex;
@@ -388,6 +415,40 @@ private:
 
     //! a list of all transfer structs we allocated
     std::list<libusb_transfer*> _all_luts;
+
+    //! Fill _dev_mem with one buffer per frame, or leave it empty if the
+    // kernel or libusb can't provide them
+    void alloc_dev_mem(const std::string& name)
+    {
+#ifdef HAVE_LIBUSB_DEV_MEM_ALLOC
+        for (size_t i = 0; i < get_num_frames(); i++) {
+            unsigned char* buff = libusb_dev_mem_alloc(_handle->get(), _frame_size);
+            if (buff == NULL) {
+                UHD_LOGGER_DEBUG("USB")
+                    << "usb " << name
+                    << ": libusb_dev_mem_alloc() failed, using host memory";
+                free_dev_mem();
+                return;
+            }
+            _dev_mem.push_back(buff);
+        }
+        UHD_LOGGER_DEBUG("USB") << "usb " << name << ": using " << _dev_mem.size()
+                                << " buffers in device memory";
+#else
+        UHD_LOGGER_DEBUG("USB")
+            << "usb " << name << ": libusb_dev_mem_alloc() is not available";
+#endif
+    }
+
+    void free_dev_mem(void)
+    {
+#ifdef HAVE_LIBUSB_DEV_MEM_ALLOC
+        for (unsigned char* buff : _dev_mem) {
+            libusb_dev_mem_free(_handle->get(), buff, _frame_size);
+        }
+#endif
+        _dev_mem.clear();
+    }
 };
 
 /***********************************************************************
@@ -395,23 +456,27 @@ private:
  **********************************************************************/
 struct libusb_zero_copy_impl : usb_zero_copy
 {
-    libusb_zero_copy_impl(libusb::device_handle::sptr handle,
+    libusb_zero_copy_impl(libusb::device_handle::sptr recv_handle,
         const int recv_interface,
         const unsigned char recv_endpoint,
+        libusb::device_handle::sptr send_handle,
         const int send_interface,
         const unsigned char send_endpoint,
         const device_addr_t& hints)
     {
-        _recv_impl.reset(new libusb_zero_copy_single(handle,
+        const bool use_dev_mem = hints.has_key("use_dev_mem");
+        _recv_impl.reset(new libusb_zero_copy_single(recv_handle,
             recv_interface,
             (recv_endpoint & 0x7f) | 0x80,
             size_t(hints.cast<double>("num_recv_frames", DEFAULT_NUM_XFERS)),
-            size_t(hints.cast<double>("recv_frame_size", DEFAULT_XFER_SIZE))));
-        _send_impl.reset(new libusb_zero_copy_single(handle,
+            size_t(hints.cast<double>("recv_frame_size", DEFAULT_XFER_SIZE)),
+            use_dev_mem));
+        _send_impl.reset(new libusb_zero_copy_single(send_handle,
             send_interface,
             (send_endpoint & 0x7f) | 0x00,
             size_t(hints.cast<double>("num_send_frames", DEFAULT_NUM_XFERS)),
-            size_t(hints.cast<double>("send_frame_size", DEFAULT_XFER_SIZE))));
+            size_t(hints.cast<double>("send_frame_size", DEFAULT_XFER_SIZE)),
+            use_dev_mem));
     }
 
     virtual ~libusb_zero_copy_impl(void);
@@ -473,8 +538,45 @@ usb_zero_copy::sptr usb_zero_copy::make(usb_device_handle::sptr handle,
     const unsigned char send_endpoint,
     const device_addr_t& hints)
 {
-    libusb::device_handle::sptr dev_handle(libusb::device_handle::get_cached_handle(
-        boost::static_pointer_cast<libusb::special_handle>(handle)->get_device()));
-    return sptr(new libusb_zero_copy_impl(
-        dev_handle, recv_interface, recv_endpoint, send_interface, send_endpoint, hints));
+    libusb::device::sptr dev =
+        boost::static_pointer_cast<libusb::special_handle>(handle)->get_device();
+
+    // By default, all devices share the event thread of the global session.
+    // With usb_event_thread=device, each device gets its own session and
+    // event thread, with usb_event_thread=endpoint each endpoint does.
+    const std::string event_thread = hints.get("usb_event_thread", "");
+    if (event_thread.empty()) {
+        libusb::device_handle::sptr dev_handle(
+            libusb::device_handle::get_cached_handle(dev));
+        return sptr(new libusb_zero_copy_impl(dev_handle,
+            recv_interface,
+            recv_endpoint,
+            dev_handle,
+            send_interface,
+            send_endpoint,
+            hints));
+    }
+    if (event_thread != "device" and event_thread != "endpoint") {
+        throw uhd::value_error("Invalid usb_event_thread: " + event_thread);
+    }
+    const std::string dev_key =
+        str(boost::format("%d:%d") % int(libusb_get_bus_number(dev->get()))
+            % int(libusb_get_device_address(dev->get())));
+    // Endpoints sharing an interface can't be claimed by separate handles
+    const bool per_endpoint = event_thread == "endpoint"
+                              and recv_interface != send_interface;
+    auto get_handle = [&dev, &dev_key, per_endpoint](const unsigned char endpoint) {
+        const std::string key =
+            per_endpoint ? str(boost::format("%s/ep%02x") % dev_key % int(endpoint))
+                         : dev_key;
+        return libusb::device_handle::get_cached_handle(
+            dev, libusb::session::get_private_session(key));
+    };
+    return sptr(new libusb_zero_copy_impl(get_handle((recv_endpoint & 0x7f) | 0x80),
+        recv_interface,
+        recv_endpoint,
+        get_handle((send_endpoint & 0x7f) | 0x00),
+        send_interface,
+        send_endpoint,
+        hints));
 }
@@ -6,13 +6,17 @@
 //
 
 #include <uhd/exception.hpp>
-#include <uhd/transport/bounded_buffer.hpp>
 #include <uhd/transport/muxed_zero_copy_if.hpp>
 #include <uhd/utils/safe_call.hpp>
+#include <uhd/utils/thread.hpp>
+#include <uhdlib/transport/demux_turns.hpp>
+#include <uhdlib/transport/spsc_bounded_buffer.hpp>
+#include <uhdlib/utils/event_fd.hpp>
 #include <boost/enable_shared_from_this.hpp>
 #include <boost/make_shared.hpp>
 #include <boost/thread.hpp>
 #include <boost/thread/locks.hpp>
+#include <atomic>
 #include <map>
 
 using namespace uhd;
@@ -27,28 +31,39 @@ public:
 
     muxed_zero_copy_if_impl(zero_copy_if::sptr base_xport,
         stream_classifier_fn classify_fn,
-        size_t max_streams)
+        size_t max_streams,
+        bool inline_demux,
+        const std::vector<size_t>& cpu_affinity)
         : _base_xport(base_xport)
         , _classify(classify_fn)
         , _max_num_streams(max_streams)
+        , _inline_demux(inline_demux)
         , _num_dropped_frames(0)
+        , _streams_gen(0)
+        , _cached_streams_gen(0)
+        , _cpu_affinity(cpu_affinity)
     {
         // Create the receive thread to poll the underlying transport
-        // and classify packets into queues
-        _recv_thread =
-            boost::thread(boost::bind(&muxed_zero_copy_if_impl::_update_queues, this));
+        // and classify packets into queues. In inline mode, the threads
+        // calling get_recv_buff() on the streams take turns doing this.
+        if (not _inline_demux) {
+            _recv_thread = boost::thread(
+                boost::bind(&muxed_zero_copy_if_impl::_update_queues, this));
+        }
     }
 
     virtual ~muxed_zero_copy_if_impl()
     {
         UHD_SAFE_CALL(
-            // Interrupt buffer updater loop
-            _recv_thread.interrupt();
-            // Wait for loop to finish
-            // No timeout on join. The recv loop is guaranteed
-            // to terminate in a reasonable amount of time because
-            // there are no timed blocks on the underlying.
-            _recv_thread.join();
+            if (_recv_thread.joinable()) {
+                // Interrupt buffer updater loop
+                _recv_thread.interrupt();
+                // Wait for loop to finish
+                // No timeout on join. The recv loop is guaranteed
+                // to terminate in a reasonable amount of time because
+                // there are no timed blocks on the underlying.
+                _recv_thread.join();
+            }
             // Flush base transport
             while (_base_xport->get_recv_buff(0.0001)) /*NOP*/;
             // Release child streams
@@ -73,18 +88,20 @@ public:
                 _base_xport->get_num_send_frames(),
                 _base_xport->get_num_recv_frames());
         _streams[stream_num] = stream;
+        _streams_gen.fetch_add(1, std::memory_order_release);
         return stream;
     }
 
     virtual size_t get_num_dropped_frames() const
     {
-        return _num_dropped_frames;
+        return _num_dropped_frames.load(std::memory_order_relaxed);
     }
 
     void remove_stream(const uint32_t stream_num)
     {
         boost::lock_guard<boost::mutex> lock(_mutex);
         _streams.erase(stream_num);
+        _streams_gen.fetch_add(1, std::memory_order_release);
     }
 
 private:
@@ -133,6 +150,7 @@ private:
             , _buff_queue(num_recv_frames)
             , _buffers(num_recv_frames)
             , _buffer_index(0)
+            , _wake_requested(false)
         {
             for (size_t i = 0; i < num_recv_frames; i++) {
                 _buffers[i] = boost::make_shared<stream_mrb>(_recv_frame_size);
@@ -163,6 +181,9 @@ private:
 
         managed_recv_buffer::sptr get_recv_buff(double timeout)
         {
+            if (_muxed_xport->is_inline_demux()) {
+                return _get_recv_buff_inline(timeout);
+            }
             managed_recv_buffer::sptr buff;
             if (_buff_queue.pop_with_timed_wait(buff, timeout)) {
                 return buff;
@@ -176,6 +197,35 @@ private:
             _buff_queue.push_with_wait(
                 _buffers.at(_buffer_index++)->get_new(buff->cast<char*>(), buff->size()));
             _buffer_index %= _buffers.size();
+            // Only wake a waiter that asked for it, see get_recv_fd()
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (_wake_requested.load(std::memory_order_relaxed)
+                and _wake_requested.exchange(false)) {
+                _recv_ready.post();
+            }
+        }
+
+        int get_recv_fd(void)
+        {
+            // Inline, the waiter demuxes the frames itself when it gets
+            // woken up by the base transport
+            if (_muxed_xport->is_inline_demux()) {
+                return _muxed_xport->base_xport()->get_recv_fd();
+            }
+            while (_recv_ready.try_wait()) {
+            }
+            _wake_requested.store(true);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            return _recv_ready.get_fd();
+        }
+
+        bool has_recv_buff(void)
+        {
+            if (not _buff_queue.empty()) {
+                return true;
+            }
+            return _muxed_xport->is_inline_demux()
+                   and _muxed_xport->base_has_recv_buff();
         }
 
         size_t get_num_send_frames(void) const
@@ -193,16 +243,42 @@ private:
             return _muxed_xport->base_xport()->get_send_buff(timeout);
         }
 
+        void flush_send_buffs(void)
+        {
+            _muxed_xport->base_xport()->flush_send_buffs();
+        }
+
     private:
+        /*!
+         * Wait for a frame and demux the base transport while no other
+         * stream does. Whoever demuxes pushes frames for all streams, so
+         * while another stream's thread holds the demuxer, we only wait on
+         * our queue for a short while before we try to take over.
+         */
+        managed_recv_buffer::sptr _get_recv_buff_inline(const double timeout)
+        {
+            managed_recv_buffer::sptr buff;
+            pop_with_demux_turns(_buff_queue, buff, timeout, [this](const double slice) {
+                return _muxed_xport->demux_inline(slice);
+            });
+            return buff;
+        }
+
         const uint32_t _stream_num;
         muxed_zero_copy_if_impl::sptr _muxed_xport;
         const size_t _num_send_frames;
         const size_t _send_frame_size;
         const size_t _num_recv_frames;
         const size_t _recv_frame_size;
-        bounded_buffer<managed_recv_buffer::sptr> _buff_queue;
+        // Only pushed to by the _update_queues() thread, or by whichever
+        // thread holds the demuxer in inline mode
+        spsc_bounded_buffer<managed_recv_buffer::sptr> _buff_queue;
         std::vector<boost::shared_ptr<stream_mrb>> _buffers;
         size_t _buffer_index;
+        // Readable after a frame was pushed while a waiter asked for a
+        // wakeup. Not used with inline demuxing.
+        uhd::event_fd _recv_ready;
+        std::atomic<bool> _wake_requested;
     };
 
     inline zero_copy_if::sptr& base_xport()
@@ -210,8 +286,36 @@ private:
         return _base_xport;
     }
 
+    inline bool is_inline_demux() const
+    {
+        return _inline_demux;
+    }
+
+    /*!
+     * Process the next frame of the base transport from a stream's thread.
+     * \param timeout the time to wait for a frame in seconds
+     * \return false if another thread is demuxing at the moment
+     */
+    bool demux_inline(const double timeout)
+    {
+        boost::unique_lock<boost::mutex> lock(_demux_mutex, boost::try_to_lock);
+        if (not lock.owns_lock()) {
+            return false;
+        }
+        _process_next_buffer(timeout);
+        return true;
+    }
+
+    //! Check the base transport for held frames, unless another thread demuxes
+    bool base_has_recv_buff(void)
+    {
+        boost::unique_lock<boost::mutex> lock(_demux_mutex, boost::try_to_lock);
+        return lock.owns_lock() and _base_xport->has_recv_buff();
+    }
+
     void _update_queues()
     {
+        set_thread_affinity(_cpu_affinity);
         // Run forever:
         // - Pull packets from the base transport
         // - Classify them
@@ -219,7 +323,7 @@ private:
         while (true) {
             { // Uninterruptable block of code
                 boost::this_thread::disable_interruption interrupt_disabler;
-                if (not _process_next_buffer()) {
+                if (not _process_next_buffer(0.0)) {
                     // Be a good citizen and yield if no packet is processed
                     static const size_t MIN_DUR = 1;
                     boost::this_thread::sleep_for(boost::chrono::nanoseconds(MIN_DUR));
@@ -246,23 +350,32 @@ private:
         }
     }
 
-    bool _process_next_buffer()
+    //! Look up a stream without taking the stream mutex, unless the streams
+    // changed since the last call. Must only be called by the demuxer.
+    stream_impl::sptr _find_stream(const uint32_t stream_num)
     {
-        managed_recv_buffer::sptr buff = _base_xport->get_recv_buff(0.0);
+        if (_streams_gen.load(std::memory_order_acquire) != _cached_streams_gen) {
+            boost::lock_guard<boost::mutex> lock(_mutex);
+            _cached_streams     = _streams;
+            _cached_streams_gen = _streams_gen.load(std::memory_order_relaxed);
+        }
+        stream_map_t::const_iterator str_iter = _cached_streams.find(stream_num);
+        if (str_iter == _cached_streams.end()) {
+            return stream_impl::sptr();
+        }
+        // Fails if the stream is going away
+        return str_iter->second.lock();
+    }
+
+    bool _process_next_buffer(const double timeout)
+    {
+        managed_recv_buffer::sptr buff = _base_xport->get_recv_buff(timeout);
         if (buff) {
             stream_impl::sptr stream;
             try {
                 const uint32_t stream_num =
                     _classify(buff->cast<void*>(), _base_xport->get_recv_frame_size());
-                {
-                    // Hold the stream mutex long enough to pull a bounded buffer
-                    // and lock it (increment its ref count).
-                    boost::lock_guard<boost::mutex> lock(_mutex);
-                    stream_map_t::iterator str_iter = _streams.find(stream_num);
-                    if (str_iter != _streams.end()) {
-                        stream = (*str_iter).second.lock();
-                    }
-                }
+                stream = _find_stream(stream_num);
             } catch (std::exception&) {
                 // If _classify throws we simply drop the frame
             }
@@ -271,8 +384,7 @@ private:
             if (stream.get()) {
                 stream->push_recv_buff(buff);
             } else {
-                boost::lock_guard<boost::mutex> lock(_mutex);
-                _num_dropped_frames++;
+                _num_dropped_frames.fetch_add(1, std::memory_order_relaxed);
             }
             // We processed a packet, and there could be more coming
             // Don't yield in the next iteration.
@@ -290,15 +402,28 @@ private:
     stream_classifier_fn _classify;
     stream_map_t _streams;
     const size_t _max_num_streams;
-    size_t _num_dropped_frames;
+    const bool _inline_demux;
+    std::atomic<size_t> _num_dropped_frames;
+    //! Incremented whenever _streams changes
+    std::atomic<size_t> _streams_gen;
+    //! The demuxer's copy of _streams, see _find_stream()
+    stream_map_t _cached_streams;
+    size_t _cached_streams_gen;
+    const std::vector<size_t> _cpu_affinity;
     boost::thread _recv_thread;
+    //! Protects _streams
     boost::mutex _mutex;
+    //! Held by the thread that demuxes in inline mode
+    boost::mutex _demux_mutex;
 };
 
+
 muxed_zero_copy_if::sptr muxed_zero_copy_if::make(zero_copy_if::sptr base_xport,
     muxed_zero_copy_if::stream_classifier_fn classify_fn,
-    size_t max_streams)
+    size_t max_streams,
+    bool inline_demux,
+    const std::vector<size_t>& cpu_affinity)
 {
     return boost::make_shared<muxed_zero_copy_if_impl>(
-        base_xport, classify_fn, max_streams);
+        base_xport, classify_fn, max_streams, inline_demux, cpu_affinity);
 }
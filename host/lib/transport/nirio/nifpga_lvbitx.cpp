@@ -7,44 +7,94 @@
 
 #include <uhd/transport/nirio/nifpga_lvbitx.h>
 #include <cstdlib>
+#include <ctime>
 #include <string>
 #include <fstream>
-#include <streambuf>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <vector>
 #include <boost/algorithm/string.hpp>
-#include <boost/regex.hpp>
+#include <boost/filesystem.hpp>
 
 namespace uhd { namespace niusrprio {
 
+namespace {
+    const std::string MD5_START_TAG = "<BitstreamMD5>";
+    const std::string MD5_END_TAG   = "</BitstreamMD5>";
+    constexpr size_t MD5_LENGTH     = 32;
+    constexpr size_t READ_CHUNK_SIZE = 1 << 20;
+
+    //! Search the file for the MD5 tag, without splitting it into lines
+    //
+    // The bitstream is stored as one huge line of text, so reading the file
+    // in large chunks is much faster than getline().
+    std::string read_bitstream_checksum(const std::string& file_path)
+    {
+        std::ifstream lvbitx_stream(file_path.c_str(), std::ios::binary);
+        if (!lvbitx_stream.is_open()) {
+            return std::string();
+        }
+
+        // Keep the end of the previous chunk, in case the tag straddles two
+        const size_t overlap = MD5_START_TAG.size() + MD5_LENGTH + MD5_END_TAG.size();
+        std::vector<char> chunk(READ_CHUNK_SIZE);
+        std::string window;
+        while (lvbitx_stream) {
+            lvbitx_stream.read(chunk.data(), chunk.size());
+            window.append(chunk.data(), size_t(lvbitx_stream.gcount()));
+
+            const size_t start = boost::ifind_first(window, MD5_START_TAG).begin()
+                                 - window.begin();
+            if (start < window.size()) {
+                const size_t md5_pos = start + MD5_START_TAG.size();
+                if (window.size() < md5_pos + MD5_LENGTH + MD5_END_TAG.size()
+                    && lvbitx_stream) {
+                    // Tag is cut off, read on
+                    continue;
+                }
+                std::string checksum = window.substr(md5_pos, MD5_LENGTH);
+                if (checksum.size() != MD5_LENGTH
+                    || !boost::all(checksum, boost::is_xdigit())
+                    || !boost::istarts_with(
+                           window.substr(md5_pos + MD5_LENGTH), MD5_END_TAG)) {
+                    return std::string();
+                }
+                return checksum;
+            }
+            if (window.size() > overlap) {
+                window.erase(0, window.size() - overlap);
+            }
+        }
+        return std::string();
+    }
+}
+
 std::string nifpga_lvbitx::_get_bitstream_checksum(const std::string& file_path)
 {
-    const boost::regex md5_regex(
-        "<BitstreamMD5>([a-fA-F0-9]{32})<\\/BitstreamMD5>",
-        boost::regex::icase);
+    // Opening a session makes a new lvbitx object every time. The files are
+    // large, so remember their checksums for as long as they are unchanged.
+    typedef std::tuple<std::time_t, boost::uintmax_t> file_stamp_t;
+    static std::mutex cache_mutex;
+    static std::map<std::string, std::pair<file_stamp_t, std::string>> cache;
 
-    std::ifstream lvbitx_stream(file_path.c_str());
-    if (!lvbitx_stream.is_open()) {
+    file_stamp_t stamp;
+    try {
+        stamp = file_stamp_t(boost::filesystem::last_write_time(file_path),
+            boost::filesystem::file_size(file_path));
+    } catch (const boost::filesystem::filesystem_error&) {
         return std::string();
     }
 
-    std::string checksum, line;
-    while (std::getline(lvbitx_stream, line))
-    {
-        try {
-            // short-circuiting the regex search with a simple find is faster
-            // for cases where the tag doesn't exist
-            boost::smatch md5_match;
-            if (line.find("<BitstreamMD5>") != std::string::npos &&
-                boost::regex_search(line, md5_match, md5_regex))
-            {
-                checksum = std::string(md5_match[1].first, md5_match[1].second);
-                break;
-            }
-        }
-        catch (boost::exception&) {
-
-        }
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto cached = cache.find(file_path);
+    if (cached != cache.end() && cached->second.first == stamp) {
+        return cached->second.second;
     }
+
+    std::string checksum = read_bitstream_checksum(file_path);
     boost::to_upper(checksum);
+    cache[file_path] = std::make_pair(stamp, checksum);
     return checksum;
 }
 
@@ -140,7 +140,8 @@ public:
 
     nirio_zero_copy_impl(uhd::niusrprio::niusrprio_session::sptr fpga_session,
         uint32_t instance,
-        const zero_copy_xport_params& xport_params)
+        const zero_copy_xport_params& xport_params,
+        const device_addr_t& hints)
         : _fpga_session(fpga_session)
         , _fifo_instance(instance)
         , _xport_params(xport_params)
@@ -199,14 +200,24 @@ public:
         nirio_status_chain(
             _fpga_session->create_tx_fifo(_fifo_instance, _send_fifo), status);
 
+        // Release received frames in batches of this many. At most half of the
+        // buffer is held back, so the device always has room to keep streaming.
+        const size_t recv_batch =
+            std::min(size_t(hints.cast<double>("pcie_recv_batch", 0)),
+                _xport_params.num_recv_frames / 2);
+
         if ((_recv_fifo.get() != NULL) && (_send_fifo.get() != NULL)) {
-            // Initialize FIFOs
+            // Initialize FIFOs. A batching receiver acquires all available frames
+            // with each driver call.
             nirio_status_chain(_recv_fifo->initialize((_xport_params.recv_frame_size
                                                           * _xport_params.num_recv_frames)
                                                           / sizeof(fifo_data_t),
                                    _xport_params.recv_frame_size / sizeof(fifo_data_t),
                                    actual_depth,
-                                   actual_size),
+                                   actual_size,
+                                   recv_batch > 1
+                                       ? nirio_fifo<fifo_data_t>::MAXIMIZE_THROUGHPUT
+                                       : nirio_fifo<fifo_data_t>::MINIMIZE_LATENCY),
                 status);
             nirio_status_chain(_send_fifo->initialize((_xport_params.send_frame_size
                                                           * _xport_params.num_send_frames)
@@ -218,6 +229,17 @@ public:
 
             _proxy()->get_rio_quirks().add_tx_fifo(_fifo_instance);
 
+            if (hints.has_key("pcie_poll")) {
+                UHD_LOGGER_DEBUG("NIRIO")
+                    << boost::format("Polling PCIe DMA channel %d") % instance;
+                _recv_fifo->set_polling(true);
+                _send_fifo->set_polling(true);
+            }
+            if (recv_batch > 1) {
+                _recv_fifo->set_release_batch(
+                    recv_batch * _xport_params.recv_frame_size / sizeof(fifo_data_t));
+            }
+
             nirio_status_chain(_recv_fifo->start(), status);
             nirio_status_chain(_send_fifo->start(), status);
 
@@ -509,5 +531,5 @@ nirio_zero_copy::sptr nirio_zero_copy::make(
     }
 
     return nirio_zero_copy::sptr(
-        new nirio_zero_copy_impl(fpga_session, instance, xport_params));
+        new nirio_zero_copy_impl(fpga_session, instance, xport_params, hints));
 }
@@ -0,0 +1,107 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/utils/log.hpp>
+#include <uhdlib/transport/shared_frame_pool.hpp>
+#include <algorithm>
+#include <chrono>
+#include <map>
+
+using namespace uhd::transport;
+
+namespace {
+
+constexpr size_t SHARED_FRAME_POOL_ALIGNMENT = 16;
+
+} // namespace
+
+constexpr size_t shared_frame_pool::CHUNK_FRAMES;
+
+shared_frame_pool::shared_frame_pool(const size_t frame_size,
+    const size_t max_frames,
+    const buffer_pool::mem_params_t& mem_params)
+    : _frame_size(frame_size)
+    , _mem_params(mem_params)
+    , _max_frames(max_frames)
+    , _num_allocated(0)
+{
+    /* NOP */
+}
+
+shared_frame_pool::sptr shared_frame_pool::get(const size_t frame_size,
+    const size_t max_frames,
+    const buffer_pool::mem_params_t& mem_params)
+{
+    static std::mutex pools_mutex;
+    static std::map<size_t, std::weak_ptr<shared_frame_pool>> pools;
+
+    std::lock_guard<std::mutex> lock(pools_mutex);
+    sptr pool = pools[frame_size].lock();
+    if (pool) {
+        pool->raise_max_frames(max_frames);
+        return pool;
+    }
+    UHD_LOG_TRACE("TRANSPORT",
+        "Creating shared frame pool for " << frame_size << " byte frames");
+    pool = std::make_shared<shared_frame_pool>(frame_size, max_frames, mem_params);
+    pools[frame_size] = pool;
+    return pool;
+}
+
+void* shared_frame_pool::acquire(const double timeout)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (_free.empty() and (_max_frames == 0 or _num_allocated < _max_frames)) {
+        const size_t num_frames =
+            (_max_frames == 0) ? CHUNK_FRAMES
+                               : std::min(CHUNK_FRAMES, _max_frames - _num_allocated);
+        buffer_pool::sptr chunk = buffer_pool::make(
+            num_frames, _frame_size, SHARED_FRAME_POOL_ALIGNMENT, _mem_params);
+        _chunks.push_back(chunk);
+        for (size_t i = 0; i < num_frames; i++) {
+            _free.push_back(chunk->at(i));
+        }
+        _num_allocated += num_frames;
+    }
+    if (_free.empty()
+        and not _frame_released.wait_for(lock,
+            std::chrono::duration<double>(timeout),
+            [this]() { return not _free.empty(); })) {
+        return nullptr;
+    }
+    void* frame = _free.back();
+    _free.pop_back();
+    return frame;
+}
+
+void shared_frame_pool::release(void* frame)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _free.push_back(frame);
+    }
+    _frame_released.notify_one();
+}
+
+size_t shared_frame_pool::get_num_allocated(void) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _num_allocated;
+}
+
+size_t shared_frame_pool::get_num_free(void) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _free.size();
+}
+
+void shared_frame_pool::raise_max_frames(const size_t max_frames)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_max_frames != 0 and (max_frames == 0 or max_frames > _max_frames)) {
+        _max_frames = max_frames;
+    }
+}
@@ -12,6 +12,7 @@
 #include <uhd/convert.hpp>
 #include <uhd/exception.hpp>
 #include <uhd/stream.hpp>
+#include <uhd/transport/chdr.hpp>
 #include <uhd/transport/vrt_if_packet.hpp>
 #include <uhd/transport/zero_copy.hpp>
 #include <uhd/types/metadata.hpp>
@@ -19,11 +20,24 @@
 #include <uhd/utils/log.hpp>
 #include <uhd/utils/tasks.hpp>
 #include <uhdlib/rfnoc/rx_stream_terminator.hpp>
+#include <uhdlib/transport/stream_stats.hpp>
+#include <uhdlib/utils/deadline.hpp>
+#include <uhdlib/utils/trace.hpp>
+#include <uhdlib/utils/trace_events.hpp>
+#include <uhdlib/utils/worker_pool.hpp>
 #include <boost/dynamic_bitset.hpp>
 #include <boost/format.hpp>
 #include <boost/function.hpp>
 #include <boost/make_shared.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <future>
 #include <iostream>
+#include <limits>
+#include <map>
 #include <vector>
 
 // Included for debugging
@@ -47,21 +61,65 @@ UHD_INLINE uint32_t get_context_code(
 typedef boost::function<void(void)> handle_overflow_type;
 static inline void handle_overflow_nop(void) {}
 
+/***********************************************************************
+ * Receive buffer getter for a zero-copy transport
+ *
+ * Can be used as the get_buff_fn_type of a basic_recv_packet_handler
+ * in place of a type-erased function, so that the per-packet call
+ * into the transport does not go through a boost::function.
+ **********************************************************************/
+struct zero_copy_recv_buff_getter
+{
+    zero_copy_if::sptr xport;
+
+    UHD_INLINE managed_recv_buffer::sptr operator()(const double timeout) const
+    {
+        return xport->get_recv_buff(timeout);
+    }
+
+    explicit operator bool(void) const
+    {
+        return bool(xport);
+    }
+};
+
+/***********************************************************************
+ * Flow control handler for streamers that don't use in-band flow control
+ * updates. Compiles down to nothing.
+ **********************************************************************/
+struct no_recv_flowctrl
+{
+    UHD_INLINE void operator()(const size_t) const {}
+
+    explicit operator bool(void) const
+    {
+        return false;
+    }
+};
+
 /***********************************************************************
  * Super receive packet handler
  *
  * A receive packet handler represents a group of channels.
  * The channel group shares a common sample rate.
  * All channels are received in unison in recv().
+ *
+ * The types of the per-packet callbacks are template parameters: the
+ * recv_packet_handler typedef uses type-erased functions, streamers that
+ * know their transport at compile time can pass function objects such
+ * as zero_copy_recv_buff_getter instead to get them inlined.
  **********************************************************************/
-class recv_packet_handler
+template <typename get_buff_fn_type, typename handle_flowctrl_fn_type>
+class basic_recv_packet_handler
 {
 public:
-    typedef boost::function<managed_recv_buffer::sptr(double)> get_buff_type;
-    typedef boost::function<void(const size_t)> handle_flowctrl_type;
+    typedef get_buff_fn_type get_buff_type;
+    typedef handle_flowctrl_fn_type handle_flowctrl_type;
     typedef std::function<void(const uint32_t*)> handle_flowctrl_ack_type;
     typedef boost::function<void(const stream_cmd_t&)> issue_stream_cmd_type;
     typedef void (*vrt_unpacker_type)(const uint32_t*, vrt::if_packet_info_t&);
+    typedef void (*vrt_batch_unpacker_type)(
+        const uint32_t* const[], const size_t[], size_t, vrt::chdr::if_hdr_batch_t&);
     // typedef boost::function<void(const uint32_t *, vrt::if_packet_info_t &)>
     // vrt_unpacker_type;
 
@@ -69,8 +127,12 @@ public:
      * Make a new packet handler for receive
      * \param size the number of transport channels
      */
-    recv_packet_handler(const size_t size = 1)
-        : _queue_error_for_next_call(false), _buffers_infos_index(0)
+    basic_recv_packet_handler(const size_t size = 1)
+        : _queue_error_for_next_call(false)
+        , _interleave_chans(false)
+        , _buffers_infos_index(0)
+        , _batch_index(0)
+        , _batch_count(0)
     {
 #ifdef ERROR_INJECT_DROPPED_PACKETS
         recvd_packets = 0;
@@ -80,7 +142,7 @@ public:
         set_alignment_failure_threshold(1000);
     }
 
-    ~recv_packet_handler(void)
+    ~basic_recv_packet_handler(void)
     {
         /* NOP */
     }
@@ -92,7 +154,31 @@ public:
             return;
         _props.resize(size);
         // re-initialize all buffers infos by re-creating the vector
-        _buffers_infos = std::vector<buffers_info_type>(4, buffers_info_type(size));
+        _buffers_infos =
+            std::vector<buffers_info_type>(NUM_BUFFERS_INFOS, buffers_info_type(size));
+        _pending = std::vector<pending_packet_type>(size);
+        _staged  = std::vector<staged_packets_type>(size);
+        _batch   = std::vector<buffers_info_type>(_batch.size(), buffers_info_type(size));
+        _batch_index = _batch_count = 0;
+    }
+
+    /*!
+     * Set the number of packets per channel to align in one go.
+     *
+     * Once the channels are aligned, up to batch_size - 1 further packets
+     * that are already waiting in the transports are taken from every channel
+     * right away. If they line up (same time on all channels, no messages or
+     * sequence errors), the following recv calls are served from this batch
+     * without running the alignment loop again. A packet that doesn't line up
+     * is kept and goes through the regular alignment logic next.
+     *
+     * \param batch_size number of packets per channel, 1 disables batching
+     */
+    void set_alignment_batch_size(const size_t batch_size)
+    {
+        _batch = std::vector<buffers_info_type>(
+            std::max<size_t>(batch_size, 1) - 1, buffers_info_type(this->size()));
+        _batch_index = _batch_count = 0;
     }
 
     //! Get the channel width of this handler
@@ -109,9 +195,30 @@ public:
         _header_offset_words32 = header_offset_words32;
     }
 
+    /*!
+     * Setup the unpacker for the headers of several packets at once.
+     *
+     * With an alignment batch (see set_alignment_batch_size()), the packets
+     * that are already waiting in a transport are then taken in one go, and
+     * their headers are unpacked by this function instead of one by one.
+     * Flow control is updated once per such batch. It must match the
+     * unpacker given to set_vrt_unpacker(), and uses the same offset.
+     *
+     * \param vrt_batch_unpacker the batch unpacker, or nullptr to disable it
+     */
+    void set_vrt_batch_unpacker(const vrt_batch_unpacker_type& vrt_batch_unpacker)
+    {
+        _vrt_batch_unpacker = vrt_batch_unpacker;
+    }
+
     /*!
      * Set the threshold for alignment failure.
      * How many packets throw out before giving up?
+     *
+     * The threshold grows by the largest skew between the channels that was
+     * measured so far (in packets, up to \p threshold), so a link that lags
+     * behind by many packets can still catch up.
+     *
      * \param threshold number of packets per channel
      */
     void set_alignment_failure_threshold(const size_t threshold)
@@ -123,12 +230,14 @@ public:
     void set_tick_rate(const double rate)
     {
         _tick_rate = rate;
+        update_ticks_per_samp();
     }
 
     //! Set the rate of samples per second
     void set_samp_rate(const double rate)
     {
         _samp_rate = rate;
+        update_ticks_per_samp();
     }
 
     /*!
@@ -146,6 +255,17 @@ public:
         _props.at(xport_chan).get_buff = get_buff;
     }
 
+    /*!
+     * Set the transport to wait on for a channel in prepare_recv_wait().
+     * It must be the transport that get_buff gets its buffers from.
+     * \param xport_chan which transport channel
+     * \param xport the transport
+     */
+    void set_xport_chan_wait_xport(const size_t xport_chan, zero_copy_if::sptr xport)
+    {
+        _props.at(xport_chan).wait_xport = xport;
+    }
+
     /*!
      * Flush all transports in the streamer:
      * The packet payload is discarded.
@@ -179,14 +299,82 @@ public:
         _props.at(xport_chan).handle_flowctrl_ack = handle_flowctrl_ack;
     }
 
-    //! Set the conversion routine for all channels
+    /*!
+     * Set the conversion routine for all channels.
+     *
+     * If id.num_inputs is larger than one, it must match the number of
+     * channels, and the converter is called once for all channels. Such a
+     * converter interleaves the channels into a single output buffer, so
+     * recv() then expects exactly one buffer.
+     */
     void set_converter(const uhd::convert::id_type& id)
     {
-        _num_outputs = id.num_outputs;
-        _converter   = uhd::convert::get_converter(id)();
+        if (id.num_inputs > 1 and id.num_inputs != this->size()) {
+            throw uhd::value_error("set_converter(): number of converter inputs must "
+                                   "be 1 or the number of channels");
+        }
+        _interleave_chans = id.num_inputs > 1;
+        _num_outputs      = id.num_outputs;
+        _converter_id     = id;
+        _signal_stats     = false;
+        _converter        = uhd::convert::get_converter(id)();
+        _make_worker_converters();
         this->set_scale_factor(1 / 32767.); // update after setting converter
         _bytes_per_otw_item = uhd::convert::get_bytes_per_item(id.input_format);
-        _bytes_per_cpu_item = uhd::convert::get_bytes_per_item(id.output_format);
+        // one sample of every channel per item when interleaving
+        _bytes_per_cpu_item = uhd::convert::get_bytes_per_item(id.output_format)
+                              * id.num_inputs;
+    }
+
+    /*!
+     * Measure the samples of every channel while converting them, see
+     * uhd::stream_stats_t::signal_stats. This switches to the "_stats"
+     * variant of the converter set by set_converter().
+     * \return false if there is no such converter for this format
+     */
+    bool enable_signal_stats(void)
+    {
+        uhd::convert::id_type id = _converter_id;
+        id.output_format += "_stats";
+        if (id.num_inputs != 1) {
+            return false;
+        }
+        try {
+            if (not boost::dynamic_pointer_cast<uhd::convert::stats_converter>(
+                    uhd::convert::get_converter(id)())) {
+                return false;
+            }
+        } catch (const uhd::key_error&) {
+            return false;
+        }
+        const double scale_factor = _scale_factor;
+        this->set_converter(id);
+        this->set_scale_factor(scale_factor);
+        _signal_accums.assign(this->size(), uhd::convert::signal_accum_t());
+        _stats.enable_signal_stats(this->size());
+        _signal_stats = true;
+        return true;
+    }
+
+    /*!
+     * Set the number of threads that convert the channels of a packet.
+     * With more than one thread, the calling thread converts some channels
+     * itself and hands the others to a worker pool. Every thread gets its own
+     * converter instance.
+     * \param num_threads number of converting threads, including the caller
+     */
+    void set_convert_threads(const size_t num_threads)
+    {
+        const size_t num_workers = std::min(num_threads, this->size()) - 1;
+        if (num_threads == 0 or num_workers == 0) {
+            _convert_pool.reset();
+        } else if (not _convert_pool or _convert_pool->get_num_workers() != num_workers) {
+            _convert_pool = std::make_shared<uhd::worker_pool>(num_workers);
+        }
+        _make_worker_converters();
+        if (_converter) {
+            this->set_scale_factor(_scale_factor);
+        }
     }
 
     //! Set the transport channel's overflow handler
@@ -199,14 +387,27 @@ public:
     //! Set the scale factor used in float conversion
     void set_scale_factor(const double scale_factor)
     {
+        _scale_factor = scale_factor;
         _converter->set_scalar(scale_factor);
+        for (auto& converter : _worker_converters) {
+            converter->set_scalar(scale_factor);
+        }
     }
 
-    //! Set the callback to issue stream commands
-    void set_issue_stream_cmd(
-        const size_t xport_chan, const issue_stream_cmd_type& issue_stream_cmd)
+    /*!
+     * Set the callback to issue stream commands
+     * \param xport_chan the channel
+     * \param issue_stream_cmd the callback
+     * \param group the control endpoint the callback writes to, e.g., the
+     *              motherboard index. Callbacks of different groups are
+     *              called concurrently.
+     */
+    void set_issue_stream_cmd(const size_t xport_chan,
+        const issue_stream_cmd_type& issue_stream_cmd,
+        const size_t group = 0)
     {
-        _props.at(xport_chan).issue_stream_cmd = issue_stream_cmd;
+        _props.at(xport_chan).issue_stream_cmd       = issue_stream_cmd;
+        _props.at(xport_chan).issue_stream_cmd_group = group;
     }
 
     //! Overload call to issue stream commands
@@ -219,9 +420,52 @@ public:
                 "single streamer will fail to time align.");
         }
 
+        // The channels of a group share a control endpoint, which takes the
+        // commands one after the other. Different groups don't wait for each
+        // other, so the commands of all but the first group are issued from
+        // their own threads.
+        std::map<size_t, std::vector<size_t>> groups;
         for (size_t i = 0; i < _props.size(); i++) {
-            if (_props[i].issue_stream_cmd)
+            if (_props[i].issue_stream_cmd) {
+                groups[_props[i].issue_stream_cmd_group].push_back(i);
+            }
+        }
+        const auto issue_group = [this, &stream_cmd](const std::vector<size_t>& chans) {
+            for (const size_t i : chans) {
                 _props[i].issue_stream_cmd(stream_cmd);
+            }
+        };
+        if (groups.size() <= 1) {
+            for (const auto& group : groups) {
+                issue_group(group.second);
+            }
+            return;
+        }
+
+        std::vector<std::future<void>> tasks;
+        for (auto it = std::next(groups.begin()); it != groups.end(); ++it) {
+            const std::vector<size_t>& chans = it->second;
+            tasks.emplace_back(std::async(
+                std::launch::async, [&issue_group, &chans]() { issue_group(chans); }));
+        }
+        std::exception_ptr error;
+        try {
+            issue_group(groups.begin()->second);
+        } catch (...) {
+            error = std::current_exception();
+        }
+        // Wait for all groups before throwing, the tasks refer to this frame
+        for (auto& task : tasks) {
+            try {
+                task.get();
+            } catch (...) {
+                if (not error) {
+                    error = std::current_exception();
+                }
+            }
+        }
+        if (error) {
+            std::rethrow_exception(error);
         }
     }
 
@@ -236,6 +480,13 @@ public:
         const double timeout,
         const bool one_packet)
     {
+        // all packets of this call share its timeout
+        const deadline_t deadline(timeout);
+        const stream_stats_counters::call_timer call_timer(_stats);
+        const trace_events::scoped_span trace_span(
+            "streamer", "recv", trace_events::sample(_trace_sample_count));
+        release_raw();
+
         // handle metadata queued from a previous receive
         if (_queue_error_for_next_call) {
             _queue_error_for_next_call = false;
@@ -247,7 +498,7 @@ public:
         }
 
         size_t accum_num_samps =
-            recv_one_packet(buffs, nsamps_per_buff, metadata, timeout);
+            recv_one_packet(buffs, nsamps_per_buff, metadata, deadline);
 
         if (one_packet or metadata.end_of_burst) {
 #ifdef UHD_TXRX_DEBUG_PRINTS
@@ -267,7 +518,7 @@ public:
             size_t num_samps = recv_one_packet(buffs,
                 nsamps_per_buff - accum_num_samps,
                 _queue_metadata,
-                timeout,
+                deadline,
                 accum_num_samps * _bytes_per_cpu_item);
 
             metadata.end_of_burst = _queue_metadata.end_of_burst;
@@ -291,32 +542,411 @@ public:
         return accum_num_samps;
     }
 
+    /*******************************************************************
+     * Receive into segments:
+     * Like recv(), but the conversion walks the segments of every
+     * buffer, see convert_segments().
+     ******************************************************************/
+    size_t recv_segments(const uhd::rx_streamer::segments_type& segments,
+        uhd::rx_metadata_t& metadata,
+        const double timeout,
+        const bool one_packet)
+    {
+        const size_t num_buffs = _interleave_chans ? 1 : this->size() * _num_outputs;
+        if (segments.size() != num_buffs) {
+            throw uhd::value_error(
+                str(boost::format("recv_segments(): Expected segments for %d buffers, "
+                                  "got %d")
+                    % num_buffs % segments.size()));
+        }
+        size_t nsamps_per_buff = std::numeric_limits<size_t>::max();
+        for (const auto& buff_segments : segments) {
+            size_t nsamps = 0;
+            for (const auto& segment : buff_segments) {
+                nsamps += segment.nsamps;
+            }
+            nsamps_per_buff = std::min(nsamps_per_buff, nsamps);
+        }
+
+        // recv() doesn't touch the buffers itself, the conversion uses the
+        // segments instead
+        _convert_segments = &segments;
+        try {
+            const size_t nsamps = recv(uhd::rx_streamer::buffs_type(nullptr, 0),
+                nsamps_per_buff,
+                metadata,
+                timeout,
+                one_packet);
+            _convert_segments = nullptr;
+            return nsamps;
+        } catch (...) {
+            _convert_segments = nullptr;
+            throw;
+        }
+    }
+
+    /*******************************************************************
+     * Receive without conversion:
+     * Hand out pointers to the payloads of the next set of aligned
+     * packets, and hold on to the buffers until release_raw().
+     ******************************************************************/
+    UHD_INLINE size_t recv_raw(std::vector<const void*>& buffs,
+        uhd::rx_metadata_t& metadata,
+        const double timeout)
+    {
+        const stream_stats_counters::call_timer call_timer(_stats);
+        release_raw();
+
+        // handle metadata queued from a previous receive
+        if (_queue_error_for_next_call) {
+            _queue_error_for_next_call = false;
+            metadata                   = _queue_metadata;
+            if (_queue_metadata.error_code != rx_metadata_t::ERROR_CODE_TIMEOUT)
+                return 0;
+        }
+
+        // get the next buffer if the current one has expired
+        if (get_curr_buffer_info().data_bytes_to_copy == 0) {
+            get_aligned_buffs(deadline_t(timeout));
+        }
+
+        buffers_info_type& info = get_curr_buffer_info();
+        metadata                = info.metadata;
+        set_time_of_fragment(metadata, info.fragment_offset_in_samps);
+        metadata.more_fragments  = false;
+        metadata.fragment_offset = info.fragment_offset_in_samps;
+        if (info.data_bytes_to_copy == 0) {
+            return 0;
+        }
+
+        // move the buffers out of the queue, the payload stays where it is
+        buffs.resize(this->size());
+        _raw_buffs.resize(this->size());
+        for (size_t i = 0; i < this->size(); i++) {
+            buffs[i] = info[i].copy_buff;
+            _raw_buffs[i].swap(info[i].buff);
+        }
+        const size_t nsamps = info.data_bytes_to_copy / _bytes_per_otw_item;
+        info.data_bytes_to_copy = 0;
+        stream_stats_counters::add(_stats.num_samps, nsamps);
+        return nsamps;
+    }
+
+    //! Release the buffers handed out by recv_raw()
+    UHD_INLINE void release_raw(void)
+    {
+        if (_raw_buffs.empty()) {
+            return;
+        }
+        for (auto& buff : _raw_buffs) {
+            buff.reset(); // effectively a release
+        }
+        _raw_buffs.clear();
+    }
+
+    //! The format of the payloads handed out by recv_raw()
+    std::string get_raw_format(void) const
+    {
+        return _converter_id.input_format;
+    }
+
+    /*******************************************************************
+     * Wait preparation:
+     * Report held data, or the descriptors of the channels that wait for
+     * a packet. Only channels without a packet at hand are waited on, so
+     * one fast channel doesn't wake the caller over and over.
+     ******************************************************************/
+    bool prepare_recv_wait(std::vector<int>& fds)
+    {
+        if (_queue_error_for_next_call or get_curr_buffer_info().data_bytes_to_copy > 0
+            or _batch_index < _batch_count) {
+            return true;
+        }
+        const size_t num_fds = fds.size();
+        for (size_t i = 0; i < _props.size(); i++) {
+            const zero_copy_if::sptr& xport = _props[i].wait_xport;
+            // Arms the transport's wakeup, so this comes first
+            const int fd = xport ? xport->get_recv_fd() : -1;
+            if (fd < 0) {
+                fds.resize(num_fds);
+                throw uhd::not_implemented_error(
+                    "prepare_recv_wait(): the transport can't be waited on");
+            }
+            if (not _pending[i].valid and _staged[i].index == _staged[i].count
+                and not xport->has_recv_buff()) {
+                fds.push_back(fd);
+            }
+        }
+        return fds.size() == num_fds;
+    }
+
+    /*******************************************************************
+     * Capture ring:
+     * Keep copies of the raw payloads, and only convert the samples that
+     * are extracted.
+     ******************************************************************/
+    void set_capture_ring(const size_t nsamps)
+    {
+        if (nsamps > 0 and _num_outputs != 1) {
+            throw uhd::not_implemented_error(
+                "set_capture_ring(): not supported with this conversion");
+        }
+        _capture_size    = nsamps;
+        _capture_written = 0;
+        _capture_records.clear();
+        _capture_ring.assign(nsamps > 0 ? this->size() : 0,
+            std::vector<uint8_t>(nsamps * _bytes_per_otw_item));
+    }
+
+    size_t capture(uhd::rx_metadata_t& metadata, const double timeout)
+    {
+        if (_capture_size == 0) {
+            throw uhd::runtime_error("capture(): call set_capture_ring() first");
+        }
+        uhd::rx_metadata_t packet_metadata;
+        size_t nsamps_captured = 0;
+        for (size_t i = 0; i < MAX_CAPTURE_PACKETS; i++) {
+            uhd::rx_metadata_t& md = (i == 0) ? metadata : packet_metadata;
+            const size_t nsamps =
+                recv_raw(_capture_raw_buffs, md, (i == 0) ? timeout : 0.0);
+            if (nsamps == 0) {
+                // report errors other than running out of packets
+                if (i > 0 and md.error_code != rx_metadata_t::ERROR_CODE_TIMEOUT) {
+                    metadata = md;
+                }
+                break;
+            }
+            if (nsamps <= _capture_size) {
+                add_to_capture_ring(_capture_raw_buffs, nsamps, md.time_spec);
+            }
+            release_raw();
+            nsamps_captured += nsamps;
+        }
+        return nsamps_captured;
+    }
+
+    size_t extract_capture(const uhd::rx_streamer::buffs_type& buffs,
+        const size_t nsamps_per_buff,
+        const uhd::time_spec_t& time_spec,
+        uhd::rx_metadata_t& metadata)
+    {
+        metadata.reset();
+        metadata.has_time_spec = false;
+        // the first packet that ends after time_spec
+        auto record = std::find_if(_capture_records.begin(),
+            _capture_records.end(),
+            [this, &time_spec](const capture_record_t& rec) {
+                return rec.time_spec + time_spec_t::from_ticks(rec.nsamps, _samp_rate)
+                       > time_spec;
+            });
+        if (record == _capture_records.end()) {
+            return 0;
+        }
+        size_t offset = 0;
+        if (record->time_spec < time_spec) {
+            offset = std::min<size_t>(record->nsamps - 1,
+                size_t((time_spec - record->time_spec).get_real_secs() * _samp_rate
+                       + 0.5));
+        }
+        metadata.has_time_spec = true;
+        metadata.time_spec =
+            record->time_spec + time_spec_t::from_ticks(offset, _samp_rate);
+
+        const auto convert_start = stream_stats_counters::clock::now();
+        size_t nsamps = 0;
+        while (nsamps < nsamps_per_buff) {
+            const size_t n = std::min(record->nsamps - offset, nsamps_per_buff - nsamps);
+            convert_from_capture_ring(buffs, record->pos + offset, nsamps, n);
+            nsamps += n;
+            // continue with the next packet if it follows without a gap
+            const auto next = std::next(record);
+            if (next == _capture_records.end()
+                or not is_contiguous_capture(*record, *next)) {
+                break;
+            }
+            record = next;
+            offset = 0;
+        }
+        stream_stats_counters::add(
+            _stats.convert_ns, stream_stats_counters::ns_since(convert_start));
+        return nsamps;
+    }
+
+    //! Return a snapshot of the streaming statistics
+    uhd::stream_stats_t get_stats(void) const
+    {
+        return _stats.get();
+    }
+
 private:
+    //! Most packets capture() takes in one call
+    static const size_t MAX_CAPTURE_PACKETS = 64;
+
+    //! A packet in the capture ring
+    struct capture_record_t
+    {
+        //! Position of the first sample, counted since the ring was set up
+        uint64_t pos;
+        size_t nsamps;
+        uhd::time_spec_t time_spec;
+    };
+
+    //! Copy the payloads of a packet into the capture ring
+    void add_to_capture_ring(const std::vector<const void*>& raw_buffs,
+        const size_t nsamps,
+        const uhd::time_spec_t& time_spec)
+    {
+        const size_t first = size_t(_capture_written % _capture_size);
+        const size_t first_nsamps = std::min(nsamps, _capture_size - first);
+        for (size_t i = 0; i < this->size(); i++) {
+            const uint8_t* src = static_cast<const uint8_t*>(raw_buffs[i]);
+            uint8_t* ring      = _capture_ring[i].data();
+            std::memcpy(ring + first * _bytes_per_otw_item,
+                src,
+                first_nsamps * _bytes_per_otw_item);
+            std::memcpy(ring,
+                src + first_nsamps * _bytes_per_otw_item,
+                (nsamps - first_nsamps) * _bytes_per_otw_item);
+        }
+        _capture_records.push_back({_capture_written, nsamps, time_spec});
+        _capture_written += nsamps;
+
+        // drop the packets that were overwritten
+        while (_capture_records.front().pos + _capture_size < _capture_written) {
+            _capture_records.pop_front();
+        }
+    }
+
+    //! True if packet b starts right where packet a ends
+    bool is_contiguous_capture(const capture_record_t& a, const capture_record_t& b) const
+    {
+        const time_spec_t expected =
+            a.time_spec + time_spec_t::from_ticks(a.nsamps, _samp_rate);
+        return std::abs((b.time_spec - expected).get_real_secs()) < 0.5 / _samp_rate;
+    }
+
+    //! Convert nsamps samples from position pos of the ring into the user's
+    //  buffers, at buffer_offset samples
+    void convert_from_capture_ring(const uhd::rx_streamer::buffs_type& buffs,
+        const uint64_t pos,
+        const size_t buffer_offset,
+        const size_t nsamps)
+    {
+        const size_t first        = size_t(pos % _capture_size);
+        const size_t first_nsamps = std::min(nsamps, _capture_size - first);
+        const size_t chunks[2][2] = {{first, first_nsamps}, {0, nsamps - first_nsamps}};
+        size_t out_offset         = buffer_offset;
+        for (const auto& chunk : chunks) {
+            if (chunk[1] == 0) {
+                continue;
+            }
+            std::vector<const void*>& in_ptrs = _interleave_in_ptrs;
+            in_ptrs.resize(this->size());
+            for (size_t i = 0; i < this->size(); i++) {
+                in_ptrs[i] = _capture_ring[i].data() + chunk[0] * _bytes_per_otw_item;
+            }
+            // the samples were measured when they were first received
+            set_signal_accum(*_converter, nullptr);
+            if (_interleave_chans) {
+                void* out =
+                    static_cast<char*>(buffs[0]) + out_offset * _bytes_per_cpu_item;
+                _converter->conv(in_ptrs, ref_vector<void*>(&out, 1), chunk[1]);
+            } else {
+                for (size_t i = 0; i < this->size(); i++) {
+                    void* out =
+                        static_cast<char*>(buffs[i]) + out_offset * _bytes_per_cpu_item;
+                    _converter->conv(in_ptrs[i], ref_vector<void*>(&out, 1), chunk[1]);
+                }
+            }
+            out_offset += chunk[1];
+        }
+    }
+
+    //! The capture ring of every channel, see set_capture_ring()
+    std::vector<std::vector<uint8_t>> _capture_ring;
+    size_t _capture_size      = 0;
+    uint64_t _capture_written = 0;
+    std::deque<capture_record_t> _capture_records;
+    std::vector<const void*> _capture_raw_buffs;
+
+    //! Streaming statistics, see get_stats()
+    stream_stats_counters _stats;
+
+    //! Buffers held for the caller of recv_raw()
+    std::vector<managed_recv_buffer::sptr> _raw_buffs;
+
     vrt_unpacker_type _vrt_unpacker;
+    vrt_batch_unpacker_type _vrt_batch_unpacker = nullptr;
     size_t _header_offset_words32;
-    double _tick_rate, _samp_rate;
+    double _tick_rate = 1.0, _samp_rate = 1.0;
+    //! Ticks per sample if that is a whole number, else 0. Packets that start
+    //! at different times can only be aligned sample by sample if it isn't 0.
+    uint64_t _ticks_per_samp = 1;
     bool _queue_error_for_next_call;
     size_t _alignment_failure_threshold;
+    //! Calls of recv(), to record a sample of them in a trace
+    size_t _trace_sample_count = 0;
+    //! Largest skew between channels seen while aligning, in packets
+    size_t _max_skew_packets = 0;
+    //! True from an overflow until the next aligned set of packets
+    bool _in_overflow_recovery = false;
+    stream_stats_counters::clock::time_point _overflow_start;
     rx_metadata_t _queue_metadata;
     struct xport_chan_props_type
     {
         xport_chan_props_type(void)
-            : packet_count(0), handle_overflow(&handle_overflow_nop), fc_update_window(0)
+            : issue_stream_cmd_group(0)
+            , packet_count(0)
+            , handle_overflow(&handle_overflow_nop)
+            , fc_update_window(0)
         {
         }
         get_buff_type get_buff;
         issue_stream_cmd_type issue_stream_cmd;
+        size_t issue_stream_cmd_group;
         size_t packet_count;
         handle_overflow_type handle_overflow;
         handle_flowctrl_type handle_flowctrl;
         handle_flowctrl_ack_type handle_flowctrl_ack;
         size_t fc_update_window;
+        //! The transport to wait on, see prepare_recv_wait()
+        zero_copy_if::sptr wait_xport;
     };
     std::vector<xport_chan_props_type> _props;
     size_t _num_outputs;
+    bool _interleave_chans;
     size_t _bytes_per_otw_item; // used in conversion
     size_t _bytes_per_cpu_item; // used in conversion
     uhd::convert::converter::sptr _converter; // used in conversion
+    uhd::convert::id_type _converter_id;
+    double _scale_factor = 1 / 32767.;
+    //! True if the converters are stats_converters, see enable_signal_stats()
+    bool _signal_stats = false;
+    //! The measurements of every channel
+    std::vector<uhd::convert::signal_accum_t> _signal_accums;
+
+    //! Point the converter at an accumulator if it measures the samples
+    UHD_INLINE void set_signal_accum(
+        uhd::convert::converter& converter, uhd::convert::signal_accum_t* accum)
+    {
+        if (_signal_stats) {
+            static_cast<uhd::convert::stats_converter&>(converter).set_accum(accum);
+        }
+    }
+    //! Optional pool for parallel conversion, and one converter per worker
+    uhd::worker_pool::sptr _convert_pool;
+    std::vector<uhd::convert::converter::sptr> _worker_converters;
+
+    void _make_worker_converters(void)
+    {
+        _worker_converters.clear();
+        if (not _converter or not _convert_pool) {
+            return;
+        }
+        for (size_t i = 0; i < _convert_pool->get_num_workers(); i++) {
+            _worker_converters.push_back(uhd::convert::get_converter(_converter_id)());
+        }
+    }
 
     //! information stored for a received buffer
     struct per_buffer_info_type
@@ -355,8 +985,8 @@ private:
             data_bytes_to_copy       = 0;
             fragment_offset_in_samps = 0;
             metadata.reset();
-            for (size_t i = 0; i < size(); i++)
-                at(i).reset();
+            for (size_t i = 0; i < this->size(); i++)
+                this->at(i).reset();
         }
         boost::dynamic_bitset<> indexes_todo; // used in alignment logic
         uint64_t alignment_time; // used in alignment logic
@@ -366,7 +996,8 @@ private:
         rx_metadata_t metadata; // packet description
     };
 
-    //! a circular queue of buffer infos
+    //! a circular queue of buffer infos: previous, current, next and a spare
+    static const size_t NUM_BUFFERS_INFOS = 4;
     std::vector<buffers_info_type> _buffers_infos;
     size_t _buffers_infos_index;
     buffers_info_type& get_curr_buffer_info(void)
@@ -375,15 +1006,16 @@ private:
     }
     buffers_info_type& get_prev_buffer_info(void)
     {
-        return _buffers_infos[(_buffers_infos_index + 3) % 4];
+        return _buffers_infos[(_buffers_infos_index + NUM_BUFFERS_INFOS - 1)
+                              % NUM_BUFFERS_INFOS];
     }
     buffers_info_type& get_next_buffer_info(void)
     {
-        return _buffers_infos[(_buffers_infos_index + 1) % 4];
+        return _buffers_infos[(_buffers_infos_index + 1) % NUM_BUFFERS_INFOS];
     }
     void increment_buffer_info(void)
     {
-        _buffers_infos_index = (_buffers_infos_index + 1) % 4;
+        _buffers_infos_index = (_buffers_infos_index + 1) % NUM_BUFFERS_INFOS;
     }
 
     //! possible return options for the packet receiver
@@ -395,6 +1027,34 @@ private:
         PACKET_SEQUENCE_ERROR
     };
 
+    //! a packet that was processed for a batch, but not used
+    struct pending_packet_type
+    {
+        pending_packet_type(void) : valid(false), type(PACKET_IF_DATA) {}
+        bool valid;
+        packet_type type;
+        std::exception_ptr error;
+        per_buffer_info_type info;
+    };
+    std::vector<pending_packet_type> _pending;
+
+    //! packets taken from a transport ahead of time, see stage_packets()
+    struct staged_packets_type
+    {
+        staged_packets_type(void) : count(0), index(0) {}
+        managed_recv_buffer::sptr buffs[vrt::chdr::if_hdr_batch_t::max_size];
+        //! headers of the first hdrs.size buffers
+        vrt::chdr::if_hdr_batch_t hdrs;
+        size_t count;
+        size_t index;
+    };
+    std::vector<staged_packets_type> _staged;
+
+    //! aligned sets of buffers beyond the current one, see set_alignment_batch_size()
+    std::vector<buffers_info_type> _batch;
+    size_t _batch_index;
+    size_t _batch_count;
+
 #ifdef ERROR_INJECT_DROPPED_PACKETS
     int recvd_packets;
 #endif
@@ -408,21 +1068,53 @@ private:
     UHD_INLINE packet_type get_and_process_single_packet(const size_t index,
         per_buffer_info_type& prev_buffer_info,
         per_buffer_info_type& curr_buffer_info,
-        double timeout)
+        const deadline_t& deadline)
     {
         managed_recv_buffer::sptr& buff = curr_buffer_info.buff;
         per_buffer_info_type& info      = curr_buffer_info;
+
+        // a packet left over from a batch has already been processed, only
+        // the time check depends on the packet before it
+        if (_pending[index].valid) {
+            _pending[index].valid = false;
+            if (_pending[index].error) {
+                std::rethrow_exception(_pending[index].error);
+            }
+            info = std::move(_pending[index].info);
+            if (_pending[index].type == PACKET_IF_DATA and info.ifpi.has_tsf
+                and prev_buffer_info.time > info.time) {
+                return PACKET_TIMESTAMP_ERROR;
+            }
+            return _pending[index].type;
+        }
+
+        staged_packets_type& staged = _staged[index];
         while (1) {
-            // get a single packet from the transport layer
-            buff = _props[index].get_buff(timeout);
-            if (buff.get() == nullptr)
+            // get a single packet, the staged ones come before the transport
+            const bool from_stage     = staged.index < staged.count;
+            const size_t staged_index = staged.index;
+            if (from_stage) {
+                buff.swap(staged.buffs[staged.index++]);
+            } else {
+                const auto get_buff_start = stream_stats_counters::clock::now();
+                buff = _props[index].get_buff(deadline.remaining());
+                stream_stats_counters::add(
+                    _stats.blocked_ns, stream_stats_counters::ns_since(get_buff_start));
+            }
+            if (buff.get() == nullptr) {
+                // A non-blocking poll (e.g., filling the alignment batch)
+                // finding nothing is not a timeout
+                if (not deadline.is_poll()) {
+                    stream_stats_counters::add(_stats.timeouts);
+                }
                 return PACKET_TIMEOUT_ERROR;
+            }
 
 #ifdef ERROR_INJECT_DROPPED_PACKETS
             if (++recvd_packets > 1000) {
                 recvd_packets = 0;
                 buff.reset();
-                buff = _props[index].get_buff(timeout);
+                buff = _props[index].get_buff(deadline.remaining());
                 if (buff.get() == nullptr)
                     return PACKET_TIMEOUT_ERROR;
             }
@@ -438,13 +1130,19 @@ private:
             info.ifpi                    = {};
             info.ifpi.num_packet_words32 = num_packet_words32 - _header_offset_words32;
             info.vrt_hdr = buff->cast<const uint32_t*>() + _header_offset_words32;
-            _vrt_unpacker(info.vrt_hdr, info.ifpi);
+            if (from_stage and staged_index < staged.hdrs.size
+                and staged.hdrs.valid[staged_index]) {
+                staged.hdrs.get_if_packet_info(staged_index, info.ifpi);
+            } else {
+                // also reports the bad headers of the batch
+                _vrt_unpacker(info.vrt_hdr, info.ifpi);
+            }
             info.time      = info.ifpi.tsf; // assumes has_tsf is true
             info.copy_buff = reinterpret_cast<const char*>(
                 info.vrt_hdr + info.ifpi.num_header_words32);
 
-            // handle flow control
-            if (_props[index].handle_flowctrl) {
+            // handle flow control, stage_packets() did it for the staged ones
+            if (_props[index].handle_flowctrl and not from_stage) {
                 if ((info.ifpi.packet_count % _props[index].fc_update_window) == 0) {
                     _props[index].handle_flowctrl(info.ifpi.packet_count);
                 }
@@ -470,6 +1168,11 @@ private:
         //-- The order of these checks is HOLY.
         //--------------------------------------------------------------
 
+        if (info.ifpi.packet_type == vrt::if_packet_info_t::PACKET_TYPE_DATA) {
+            stream_stats_counters::add(_stats.num_packets);
+            stream_stats_counters::add(_stats.num_bytes, buff->size());
+        }
+
         // 1) check for inline IF message packets
         if (info.ifpi.packet_type != vrt::if_packet_info_t::PACKET_TYPE_DATA) {
             return PACKET_INLINE_MESSAGE;
@@ -482,8 +1185,13 @@ private:
         const size_t expected_packet_count = _props[index].packet_count;
         _props[index].packet_count         = (info.ifpi.packet_count + 1) & seq_mask;
         if (expected_packet_count != info.ifpi.packet_count) {
-            // UHD_LOGGER_INFO("STREAMER") << "expected: " << expected_packet_count << "
-            // got: " << info.ifpi.packet_count;
+            UHD_TRACE(STREAMER,
+                trace,
+                "expected: ",
+                expected_packet_count,
+                " got: ",
+                info.ifpi.packet_count);
+            stream_stats_counters::add(_stats.seq_errors);
             if (_props[index].handle_flowctrl) {
                 // Always update flow control in this case, because we don't
                 // know which packet was dropped and what state the upstream
@@ -508,6 +1216,20 @@ private:
         get_prev_buffer_info().reset();
         get_curr_buffer_info().reset();
         get_next_buffer_info().reset();
+        for (auto& pending : _pending) {
+            pending.valid = false;
+            pending.error = nullptr;
+            pending.info.reset();
+        }
+        for (auto& set : _batch) {
+            set.reset();
+        }
+        _batch_index = _batch_count = 0;
+        for (auto& staged : _staged) {
+            for (; staged.index < staged.count; staged.index++) {
+                staged.buffs[staged.index].reset();
+            }
+        }
 
         for (size_t i = 0; i < _props.size(); i++) {
             per_buffer_info_type prev_buffer_info, curr_buffer_info;
@@ -517,9 +1239,11 @@ private:
                 // receive a single packet from the transport
                 try {
                     // call into get_and_process_single_packet()
-                    // to make sure flow control is handled
+                    // to make sure flow control is handled. Every packet
+                    // gets the full timeout, so this drains until the
+                    // transport has been quiet for that long.
                     if (get_and_process_single_packet(
-                            i, prev_buffer_info, curr_buffer_info, timeout)
+                            i, prev_buffer_info, curr_buffer_info, deadline_t(timeout))
                         == PACKET_TIMEOUT_ERROR)
                         break;
                 } catch (...) {
@@ -531,50 +1255,175 @@ private:
         }
     }
 
+    void update_ticks_per_samp(void)
+    {
+        const double ratio   = _tick_rate / _samp_rate;
+        const double rounded = std::round(ratio);
+        _ticks_per_samp      = (rounded >= 1 and std::abs(ratio - rounded) < 1e-6)
+                              ? uint64_t(rounded)
+                              : 0;
+    }
+
+    //! The time of the first sample after the packet in \p buff
+    UHD_INLINE uint64_t get_end_time(const per_buffer_info_type& buff) const
+    {
+        return buff.time
+               + buff.ifpi.num_payload_bytes / _bytes_per_otw_item * _ticks_per_samp;
+    }
+
+    /*!
+     * Drop \p nbytes from the start of the payload of \p buff, the packet
+     * then starts at \p time
+     */
+    static UHD_INLINE void advance_payload(
+        per_buffer_info_type& buff, const size_t nbytes, const uint64_t time)
+    {
+        buff.copy_buff += nbytes;
+        buff.ifpi.num_payload_bytes -= nbytes;
+        buff.ifpi.num_payload_words32 -= nbytes / sizeof(uint32_t);
+        buff.ifpi.sob = false;
+        buff.ifpi.tsf = time;
+        buff.time     = time;
+    }
+
+    /*!
+     * Make the packet in \p buff start at \p time, by dropping the samples
+     * before it. This is how channels whose packets don't start at the same
+     * times (e.g., after one of them lost a packet) are aligned without
+     * losing whole packets.
+     *
+     * \return true if the packet starts at \p time now, false if it has no
+     *         sample at that time
+     */
+    UHD_INLINE bool trim_to_time(per_buffer_info_type& buff, const uint64_t time)
+    {
+        if (buff.time == time) {
+            return true;
+        }
+        if (_ticks_per_samp == 0 or buff.time > time or get_end_time(buff) <= time
+            or (time - buff.time) % _ticks_per_samp != 0) {
+            return false;
+        }
+        const size_t nsamps = size_t((time - buff.time) / _ticks_per_samp);
+        const size_t nbytes = nsamps * _bytes_per_otw_item;
+        if (nbytes % sizeof(uint32_t) != 0) {
+            return false;
+        }
+        stream_stats_counters::update_max(_stats.max_align_skew_ticks, time - buff.time);
+        advance_payload(buff, nbytes, time);
+        stream_stats_counters::add(_stats.align_trimmed_samps, nsamps);
+        return true;
+    }
+
+    //! Count a packet that can't be aligned with \p time, and measure the skew
+    UHD_INLINE void count_align_drop(
+        const per_buffer_info_type& buff, const uint64_t time)
+    {
+        stream_stats_counters::add(_stats.align_drops);
+        if (time <= buff.time) {
+            return;
+        }
+        const uint64_t skew = time - buff.time;
+        stream_stats_counters::update_max(_stats.max_align_skew_ticks, skew);
+        const uint64_t packet_ticks = get_end_time(buff) - buff.time;
+        if (packet_ticks != 0) {
+            _max_skew_packets =
+                std::max(_max_skew_packets, size_t(skew / packet_ticks));
+        }
+    }
+
+    //! The number of packets to drop before the alignment fails, see
+    //! set_alignment_failure_threshold()
+    UHD_INLINE size_t get_alignment_failure_limit(void) const
+    {
+        const size_t threshold = _alignment_failure_threshold / this->size();
+        return _alignment_failure_threshold
+               + this->size() * std::min(_max_skew_packets, threshold);
+    }
+
     /*******************************************************************
      * Alignment check:
      * Check the received packet for alignment and mark accordingly.
      ******************************************************************/
     UHD_INLINE void alignment_check(const size_t index, buffers_info_type& info)
     {
-        // if alignment time was not valid or if the sequence id is newer:
+        per_buffer_info_type& buff = info[index];
+
+        // if alignment time was not valid or if the packet is newer:
         //  use this index's time as the alignment time
-        //  reset the indexes list and remove this index
-        if (not info.alignment_time_valid or info[index].time > info.alignment_time) {
+        //  keep the packets of the other channels that have a sample at
+        //  that time, and release the others
+        if (not info.alignment_time_valid or buff.time > info.alignment_time) {
             info.alignment_time_valid = true;
-            info.alignment_time       = info[index].time;
+            info.alignment_time       = buff.time;
             info.indexes_todo.set();
             info.indexes_todo.reset(index);
-            // release the other buffers
             for (size_t i = 0; i < info.size(); i++) {
-                if (i != index) {
+                if (i == index or not info[i].buff) {
+                    continue;
+                }
+                if (trim_to_time(info[i], buff.time)) {
+                    info.indexes_todo.reset(i);
+                } else {
+                    count_align_drop(info[i], buff.time);
                     info[i].reset();
                 }
             }
-            info.data_bytes_to_copy = info[index].ifpi.num_payload_bytes;
-            // reset start_of_burst and end_of_burst states
-            info.metadata.start_of_burst = info[index].ifpi.sob;
-            info.metadata.end_of_burst   = info[index].ifpi.eob;
         }
 
-        // if the sequence id matches:
+        // if the packet has a sample at the alignment time:
         //  remove this index from the list and continue
-        else if (info[index].time == info.alignment_time) {
+        else if (trim_to_time(buff, info.alignment_time)) {
             info.indexes_todo.reset(index);
-            // All channels should have sob set at the same time, so only
-            // set start_of burst if all channels have sob set.
-            info.metadata.start_of_burst &= info[index].ifpi.sob;
-            // If any channel indicates eob, no more data will be received for
-            // that channel so set end_of_burst for any eob.
-            info.metadata.end_of_burst |= info[index].ifpi.eob;
-        } else {
-            // Not going to use this buffer, so release it
-            info[index].reset();
         }
 
-        // if the sequence id is older:
-        //  continue with the same index to try again
-        // else if (info[index].time < info.alignment_time)...
+        // if the packet is older:
+        //  release it and continue with the same index to try again
+        else {
+            count_align_drop(buff, info.alignment_time);
+            buff.reset();
+        }
+    }
+
+    /*******************************************************************
+     * Finish an aligned set:
+     * All packets start at the same time now. Packets that are longer than
+     * the shortest one are split, and their rest goes into the next set.
+     ******************************************************************/
+    UHD_INLINE void finish_aligned_set(buffers_info_type& info)
+    {
+        size_t nbytes = info[0].ifpi.num_payload_bytes;
+        for (size_t i = 1; i < info.size(); i++) {
+            nbytes = std::min(nbytes, info[i].ifpi.num_payload_bytes);
+        }
+        info.data_bytes_to_copy = nbytes;
+        // All channels should have sob set at the same time, so only set
+        // start_of burst if all channels have sob set. If any channel
+        // indicates eob, no more data will be received for that channel so
+        // set end_of_burst for any eob.
+        info.metadata.start_of_burst = true;
+        info.metadata.end_of_burst   = false;
+        const bool can_split = _ticks_per_samp != 0 and nbytes % sizeof(uint32_t) == 0;
+        for (size_t i = 0; i < info.size(); i++) {
+            per_buffer_info_type& buff = info[i];
+            info.metadata.start_of_burst &= buff.ifpi.sob;
+            if (not can_split or buff.ifpi.num_payload_bytes == nbytes) {
+                info.metadata.end_of_burst |= buff.ifpi.eob;
+                continue;
+            }
+            // the rest shares the buffer, which is released when both are
+            pending_packet_type& pending = _pending[i];
+            pending.valid                = true;
+            pending.type                 = PACKET_IF_DATA;
+            pending.error                = nullptr;
+            pending.info                 = buff;
+            advance_payload(pending.info,
+                nbytes,
+                buff.time + nbytes / _bytes_per_otw_item * _ticks_per_samp);
+            buff.ifpi.num_payload_bytes   = nbytes;
+            buff.ifpi.num_payload_words32 = nbytes / sizeof(uint32_t);
+            buff.ifpi.eob                 = false;
+        }
     }
 
     /*******************************************************************
@@ -583,7 +1432,7 @@ private:
      * Handle all of the edge cases like inline messages and errors.
      * The logic will throw out older packets until it finds a match.
      ******************************************************************/
-    UHD_INLINE void get_aligned_buffs(double timeout)
+    UHD_INLINE void get_aligned_buffs(const deadline_t& deadline)
     {
         get_prev_buffer_info()
             .reset(); // no longer need the previous info - reset it for future use
@@ -594,6 +1443,12 @@ private:
         buffers_info_type& curr_info = get_curr_buffer_info();
         buffers_info_type& next_info = get_next_buffer_info();
 
+        // serve the next set of a batch, it is already aligned
+        if (_batch_index < _batch_count) {
+            std::swap(curr_info, _batch[_batch_index++]);
+            return;
+        }
+
         curr_info.metadata.error_code = rx_metadata_t::ERROR_CODE_NONE;
 
         // Loop until we get a message of an aligned set of buffers:
@@ -609,7 +1464,7 @@ private:
             // receive a single packet from the transport
             try {
                 packet = get_and_process_single_packet(
-                    index, prev_info[index], curr_info[index], timeout);
+                    index, prev_info[index], curr_info[index], deadline);
             }
 
             // handle the case where a bad header exists
@@ -644,8 +1499,8 @@ private:
                 case PACKET_INLINE_MESSAGE:
                     std::swap(curr_info, next_info); // save progress from curr -> next
                     curr_info.metadata.has_time_spec = next_info[index].ifpi.has_tsf;
-                    curr_info.metadata.time_spec =
-                        time_spec_t::from_ticks(next_info[index].time, _tick_rate);
+                    curr_info.metadata.time_ticks =
+                        time_ticks_t(next_info[index].time, _tick_rate);
                     curr_info.metadata.error_code =
                         rx_metadata_t::error_code_t(get_context_code(
                             next_info[index].vrt_hdr, next_info[index].ifpi));
@@ -660,10 +1515,19 @@ private:
                                 next_info[index].ifpi.packet_count);
                         }
 
+                        // the recovery lasts until the next aligned set
+                        if (not _in_overflow_recovery) {
+                            _in_overflow_recovery = true;
+                            _overflow_start       = stream_stats_counters::clock::now();
+                        }
                         rx_metadata_t metadata = curr_info.metadata;
                         _props[index].handle_overflow();
                         curr_info.metadata = metadata;
                         UHD_LOG_FASTPATH("O");
+                        stream_stats_counters::add(_stats.overflows);
+                    } else if (curr_info.metadata.error_code
+                               == rx_metadata_t::ERROR_CODE_LATE_COMMAND) {
+                        stream_stats_counters::add(_stats.late_packets);
                     }
                     next_info[index].buff.reset(); // No data, so release the buffer
                     next_info[index].copy_buff = nullptr;
@@ -682,12 +1546,12 @@ private:
                     alignment_check(index, curr_info);
                     std::swap(curr_info, next_info); // save progress from curr -> next
                     curr_info.metadata.has_time_spec = prev_info.metadata.has_time_spec;
-                    curr_info.metadata.time_spec =
-                        prev_info.metadata.time_spec
-                        + time_spec_t::from_ticks(
-                            prev_info[index].ifpi.num_payload_words32 * sizeof(uint32_t)
-                                / _bytes_per_otw_item,
-                            _samp_rate);
+                    curr_info.metadata.time_ticks = prev_info.metadata.time_ticks;
+                    curr_info.metadata.time_ticks.ticks += time_ticks_t::convert(
+                        prev_info[index].ifpi.num_payload_words32 * sizeof(uint32_t)
+                            / _bytes_per_otw_item,
+                        _samp_rate,
+                        _tick_rate);
                     curr_info.metadata.out_of_sequence = true;
                     curr_info.metadata.error_code = rx_metadata_t::ERROR_CODE_OVERFLOW;
                     UHD_LOG_FASTPATH("D");
@@ -695,7 +1559,7 @@ private:
             }
 
             // too many iterations: detect alignment failure
-            if (iterations++ > _alignment_failure_threshold) {
+            if (iterations++ > get_alignment_failure_limit()) {
                 UHD_LOGGER_ERROR("STREAMER")
                     << boost::format(
                            "The receive packet handler failed to time-align packets.\n"
@@ -710,13 +1574,183 @@ private:
             }
         }
 
+        finish_aligned_set(curr_info);
+        if (_in_overflow_recovery) {
+            const uint64_t recovery_ns = stream_stats_counters::ns_since(_overflow_start);
+            stream_stats_counters::add(_stats.overflow_recovery_ns, recovery_ns);
+            stream_stats_counters::update_max(
+                _stats.max_overflow_recovery_ns, recovery_ns);
+            _in_overflow_recovery = false;
+        }
+
         // set the metadata from the buffer information at index zero
         curr_info.metadata.has_time_spec = curr_info[0].ifpi.has_tsf;
-        curr_info.metadata.time_spec =
-            time_spec_t::from_ticks(curr_info[0].time, _tick_rate);
+        curr_info.metadata.time_ticks = time_ticks_t(curr_info[0].time, _tick_rate);
+        set_host_time(curr_info.metadata, curr_info[0].buff);
         curr_info.metadata.more_fragments  = false;
         curr_info.metadata.fragment_offset = 0;
         curr_info.metadata.error_code      = rx_metadata_t::ERROR_CODE_NONE;
+
+        if (not _batch.empty()) {
+            fill_alignment_batch(curr_info);
+        }
+    }
+
+    /*******************************************************************
+     * Fill the alignment batch:
+     * Take the packets that are already waiting after the aligned set in
+     * curr_info, as long as they line up on all channels.
+     ******************************************************************/
+    UHD_INLINE void fill_alignment_batch(buffers_info_type& curr_info)
+    {
+        _batch_index = _batch_count = 0;
+        if (curr_info.metadata.end_of_burst) {
+            return;
+        }
+        if (_vrt_batch_unpacker) {
+            for (size_t i = 0; i < this->size(); i++) {
+                stage_packets(i, _batch.size());
+            }
+        }
+        while (_batch_count < _batch.size()) {
+            buffers_info_type& set        = _batch[_batch_count];
+            buffers_info_type& prev = (_batch_count == 0)
+                                                ? curr_info
+                                                : _batch[_batch_count - 1];
+            set.reset();
+            for (size_t i = 0; i < this->size(); i++) {
+                // don't wait, only take what is already there
+                packet_type type         = PACKET_TIMEOUT_ERROR;
+                std::exception_ptr error = nullptr;
+                try {
+                    type = get_and_process_single_packet(
+                        i, prev[i], set[i], deadline_t::poll());
+                } catch (...) {
+                    // report it when the regular alignment logic gets here
+                    error = std::current_exception();
+                }
+                if (not error and type == PACKET_IF_DATA
+                    and (i == 0
+                            or (set[i].time == set[0].time
+                                   and set[i].ifpi.num_payload_bytes
+                                           == set[0].ifpi.num_payload_bytes))) {
+                    continue;
+                }
+                // keep the packets of this set for the regular alignment logic
+                const bool keep_last = error or type != PACKET_TIMEOUT_ERROR;
+                for (size_t j = 0; j < i + (keep_last ? 1 : 0); j++) {
+                    _pending[j].valid = true;
+                    _pending[j].type  = (j == i) ? type : PACKET_IF_DATA;
+                    _pending[j].error = (j == i) ? error : nullptr;
+                    _pending[j].info  = std::move(set[j]);
+                }
+                set.reset();
+                return;
+            }
+
+            set.indexes_todo.reset();
+            set.alignment_time_valid    = true;
+            set.alignment_time          = set[0].time;
+            set.data_bytes_to_copy      = set[0].ifpi.num_payload_bytes;
+            set.metadata.start_of_burst = true;
+            set.metadata.end_of_burst   = false;
+            for (size_t i = 0; i < this->size(); i++) {
+                set.metadata.start_of_burst &= set[i].ifpi.sob;
+                set.metadata.end_of_burst |= set[i].ifpi.eob;
+            }
+            set.metadata.has_time_spec   = set[0].ifpi.has_tsf;
+            set.metadata.time_ticks      = time_ticks_t(set[0].time, _tick_rate);
+            set_host_time(set.metadata, set[0].buff);
+            set.metadata.more_fragments  = false;
+            set.metadata.fragment_offset = 0;
+            set.metadata.error_code      = rx_metadata_t::ERROR_CODE_NONE;
+            _batch_count++;
+            if (set.metadata.end_of_burst) {
+                return;
+            }
+        }
+    }
+
+    /*******************************************************************
+     * Stage packets:
+     * Take up to num_packets packets that are already waiting in the
+     * transport of a channel, and unpack their headers in one go.
+     * get_and_process_single_packet() serves these before it asks the
+     * transport again. Flow control is updated once, with the newest
+     * packet that completes an update window.
+     ******************************************************************/
+    UHD_INLINE void stage_packets(const size_t index, const size_t num_packets)
+    {
+        staged_packets_type& staged = _staged[index];
+        if (staged.index < staged.count) {
+            return;
+        }
+        staged.index = staged.count = 0;
+
+        const uint32_t* packet_buffs[vrt::chdr::if_hdr_batch_t::max_size];
+        size_t num_packet_words32[vrt::chdr::if_hdr_batch_t::max_size];
+        size_t num_headers = 0;
+        const size_t max_packets =
+            std::min<size_t>(num_packets, vrt::chdr::if_hdr_batch_t::max_size);
+        while (staged.count < max_packets) {
+            managed_recv_buffer::sptr& buff = staged.buffs[staged.count];
+            buff = _props[index].get_buff(0.0);
+            if (not buff) {
+                break;
+            }
+            staged.count++;
+            // too small for a header: leave it to get_and_process_single_packet()
+            const size_t num_words32 = buff->size() / sizeof(uint32_t);
+            if (num_words32 < _header_offset_words32 + 2) {
+                break;
+            }
+            packet_buffs[num_headers] =
+                buff->cast<const uint32_t*>() + _header_offset_words32;
+            num_packet_words32[num_headers] = num_words32 - _header_offset_words32;
+            num_headers++;
+        }
+        _vrt_batch_unpacker(packet_buffs, num_packet_words32, num_headers, staged.hdrs);
+
+        if (_props[index].handle_flowctrl) {
+            for (size_t i = num_headers; i > 0; i--) {
+                if (staged.hdrs.valid[i - 1]
+                    and (staged.hdrs.packet_count[i - 1] % _props[index].fc_update_window)
+                            == 0) {
+                    _props[index].handle_flowctrl(staged.hdrs.packet_count[i - 1]);
+                    break;
+                }
+            }
+        }
+    }
+
+    //! Report the arrival time of \p buff, if its transport captured one
+    static UHD_INLINE void set_host_time(
+        rx_metadata_t& metadata, const managed_recv_buffer::sptr& buff)
+    {
+        const uint64_t ns           = buff ? buff->get_rx_timestamp() : 0;
+        metadata.has_host_time_spec = (ns != 0);
+        if (ns != 0) {
+            metadata.host_time_spec = time_spec_t(
+                time_t(ns / 1000000000), long(ns % 1000000000), 1e9);
+        }
+    }
+
+    /*!
+     * Set the time of a receive that starts \p offset samples into the
+     * current packet. The time is kept in ticks up to here, so this is the
+     * only conversion to a time_spec_t per receive.
+     */
+    UHD_INLINE void set_time_of_fragment(rx_metadata_t& metadata, const size_t offset)
+    {
+        if (not metadata.time_ticks.is_valid()) {
+            metadata.time_spec = time_spec_t(0.0);
+            return;
+        }
+        if (offset != 0) {
+            metadata.time_ticks.ticks +=
+                time_ticks_t::convert(offset, _samp_rate, _tick_rate);
+        }
+        metadata.time_spec = metadata.time_ticks.to_time_spec();
     }
 
     /*******************************************************************
@@ -728,21 +1762,20 @@ private:
     UHD_INLINE size_t recv_one_packet(const uhd::rx_streamer::buffs_type& buffs,
         const size_t nsamps_per_buff,
         uhd::rx_metadata_t& metadata,
-        const double timeout,
+        const deadline_t& deadline,
         const size_t buffer_offset_bytes = 0)
     {
         // get the next buffer if the current one has expired
         if (get_curr_buffer_info().data_bytes_to_copy == 0) {
             // perform receive with alignment logic
-            get_aligned_buffs(timeout);
+            get_aligned_buffs(deadline);
         }
 
         buffers_info_type& info = get_curr_buffer_info();
         metadata                = info.metadata;
 
         // interpolate the time spec (useful when this is a fragment)
-        metadata.time_spec +=
-            time_spec_t::from_ticks(info.fragment_offset_in_samps, _samp_rate);
+        set_time_of_fragment(metadata, info.fragment_offset_in_samps);
 
         // extract the number of samples available to copy
         const size_t nsamps_available = info.data_bytes_to_copy / _bytes_per_otw_item;
@@ -758,8 +1791,40 @@ private:
         _convert_bytes_to_copy       = bytes_to_copy;
 
         // perform N channels of conversion
-        for (size_t i = 0; i < this->size(); i++) {
-            convert_to_out_buff(i);
+        const auto convert_start = stream_stats_counters::clock::now();
+        if (_signal_stats) {
+            for (auto& accum : _signal_accums) {
+                accum.peak = 0.0;
+            }
+        }
+        if (_interleave_chans) {
+            convert_interleaved_to_out_buff();
+        } else if (_convert_pool) {
+            _convert_pool->run(
+                this->size(), [this](const size_t index, const size_t participant) {
+                    convert_to_out_buff(index,
+                        participant == 0 ? *_converter
+                                         : *_worker_converters[participant - 1]);
+                });
+        } else {
+            for (size_t i = 0; i < this->size(); i++) {
+                convert_to_out_buff(i, *_converter);
+            }
+        }
+        stream_stats_counters::add(
+            _stats.convert_ns, stream_stats_counters::ns_since(convert_start));
+        stream_stats_counters::add(_stats.num_samps, nsamps_to_copy_per_io_buff);
+        if (_signal_stats) {
+            for (size_t i = 0; i < this->size(); i++) {
+                _stats.store_signal(i, _signal_accums[i]);
+            }
+        }
+
+        // release the buffers if fully consumed
+        if (info.data_bytes_to_copy == bytes_to_copy) {
+            for (size_t i = 0; i < this->size(); i++) {
+                info[i].buff.reset(); // effectively a release
+            }
         }
 
         // update the copy buffer's availability
@@ -777,15 +1842,30 @@ private:
      *  buffer.
      *
      * - Calls the converter
-     * - Releases internal data buffers
      * - Updates read/write pointers
+     *
+     * This may run on a worker thread, so it must only touch the state of
+     * its own channel.
      */
-    inline void convert_to_out_buff(const size_t index)
+    inline void convert_to_out_buff(
+        const size_t index, uhd::convert::converter& converter)
     {
         // shortcut references to local data structures
         buffers_info_type& buff_info         = get_curr_buffer_info();
         per_buffer_info_type& info           = buff_info[index];
         const rx_streamer::buffs_type& buffs = *_convert_buffs;
+        set_signal_accum(converter, &_signal_accums[index]);
+
+        if (_convert_segments) {
+            const size_t bytes_per_samp = _num_outputs * _bytes_per_otw_item;
+            convert_segments(index * _num_outputs,
+                [&info, &converter, bytes_per_samp](
+                    const ref_vector<void*>& out_buffs, const size_t nsamps) {
+                    converter.conv(info.copy_buff, out_buffs, nsamps);
+                    info.copy_buff += nsamps * bytes_per_samp;
+                });
+            return;
+        }
 
         // fill IO buffs with pointers into the output buffer
         void* io_buffs[4 /*max interleave*/];
@@ -796,20 +1876,109 @@ private:
         const ref_vector<void*> out_buffs(io_buffs, _num_outputs);
 
         // perform the conversion operation
-        _converter->conv(info.copy_buff, out_buffs, _convert_nsamps);
+        converter.conv(info.copy_buff, out_buffs, _convert_nsamps);
 
         // advance the pointer for the source buffer
         info.copy_buff += _convert_bytes_to_copy;
+    }
+
+    /*! Run the conversion of all channels into the user's single, channel
+     *  interleaved output buffer.
+     */
+    inline void convert_interleaved_to_out_buff(void)
+    {
+        buffers_info_type& buff_info = get_curr_buffer_info();
+        std::vector<const void*>& in_ptrs = _interleave_in_ptrs;
+        in_ptrs.resize(this->size());
+        for (size_t i = 0; i < this->size(); i++) {
+            in_ptrs[i] = buff_info[i].copy_buff;
+        }
+        if (_convert_segments) {
+            convert_segments(0,
+                [this, &in_ptrs](
+                    const ref_vector<void*>& out_buffs, const size_t nsamps) {
+                    _converter->conv(in_ptrs, out_buffs, nsamps);
+                    for (auto& in_ptr : in_ptrs) {
+                        in_ptr = static_cast<const char*>(in_ptr)
+                                 + nsamps * _bytes_per_otw_item;
+                    }
+                });
+            for (size_t i = 0; i < this->size(); i++) {
+                buff_info[i].copy_buff += _convert_bytes_to_copy;
+            }
+            return;
+        }
+        void* io_buff =
+            reinterpret_cast<char*>((*_convert_buffs)[0]) + _convert_buffer_offset_bytes;
+        const ref_vector<void*> out_buffs(&io_buff, 1);
+
+        _converter->conv(in_ptrs, out_buffs, _convert_nsamps);
+
+        for (size_t i = 0; i < this->size(); i++) {
+            buff_info[i].copy_buff += _convert_bytes_to_copy;
+        }
+    }
 
-        // release the buffer if fully consumed
-        if (buff_info.data_bytes_to_copy == _convert_bytes_to_copy) {
-            info.buff.reset(); // effectively a release
+    /*! Convert _convert_nsamps samples into the segments of the outputs
+     *  first_output to first_output + _num_outputs - 1 (or just the first one
+     *  when interleaving), starting _convert_buffer_offset_bytes into their
+     *  concatenation.
+     *
+     * Calls \p conv(out_buffs, nsamps) for every run of samples that fits
+     * into the current segment of every output. It must advance the inputs.
+     */
+    template <typename conv_fn_type>
+    void convert_segments(const size_t first_output, const conv_fn_type& conv)
+    {
+        const size_t num_outputs = _interleave_chans ? 1 : _num_outputs;
+        const uhd::rx_streamer::segments_type& segments = *_convert_segments;
+        // Find the segment and the offset into it for every output
+        size_t segment[4 /*max interleave*/];
+        size_t offset[4 /*max interleave*/];
+        for (size_t i = 0; i < num_outputs; i++) {
+            const auto& buff_segments = segments[first_output + i];
+            segment[i] = 0;
+            offset[i]  = _convert_buffer_offset_bytes / _bytes_per_cpu_item;
+            while (segment[i] < buff_segments.size()
+                   and offset[i] >= buff_segments[segment[i]].nsamps) {
+                offset[i] -= buff_segments[segment[i]].nsamps;
+                segment[i]++;
+            }
+        }
+
+        void* io_buffs[4 /*max interleave*/];
+        size_t nsamps_left = _convert_nsamps;
+        while (nsamps_left) {
+            size_t nsamps = nsamps_left;
+            for (size_t i = 0; i < num_outputs; i++) {
+                const auto& seg = segments[first_output + i][segment[i]];
+                nsamps          = std::min(nsamps, seg.nsamps - offset[i]);
+                io_buffs[i] =
+                    static_cast<char*>(seg.buff) + offset[i] * _bytes_per_cpu_item;
+            }
+            conv(ref_vector<void*>(io_buffs, num_outputs), nsamps);
+            nsamps_left -= nsamps;
+            // Move on to the next non-empty segment where one is full
+            for (size_t i = 0; i < num_outputs; i++) {
+                const auto& buff_segments = segments[first_output + i];
+                offset[i] += nsamps;
+                while (segment[i] < buff_segments.size()
+                       and offset[i] >= buff_segments[segment[i]].nsamps) {
+                    offset[i] -= buff_segments[segment[i]].nsamps;
+                    segment[i]++;
+                }
+            }
         }
     }
 
+    //! Input pointers of the interleaving converter
+    std::vector<const void*> _interleave_in_ptrs;
+
     //! Shared variables for the worker threads
     size_t _convert_nsamps;
     const rx_streamer::buffs_type* _convert_buffs;
+    //! The segments of recv_segments(), which replace _convert_buffs
+    const rx_streamer::segments_type* _convert_segments = nullptr;
     size_t _convert_buffer_offset_bytes;
     size_t _convert_bytes_to_copy;
 
@@ -893,10 +2062,20 @@ private:
 #endif
 };
 
-class recv_packet_streamer : public recv_packet_handler, public rx_streamer
+typedef basic_recv_packet_handler<boost::function<managed_recv_buffer::sptr(double)>,
+    boost::function<void(const size_t)>>
+    recv_packet_handler;
+
+template <typename get_buff_fn_type, typename handle_flowctrl_fn_type>
+class basic_recv_packet_streamer
+    : public basic_recv_packet_handler<get_buff_fn_type, handle_flowctrl_fn_type>,
+      public rx_streamer
 {
 public:
-    recv_packet_streamer(const size_t max_num_samps)
+    typedef basic_recv_packet_handler<get_buff_fn_type, handle_flowctrl_fn_type>
+        handler_type;
+
+    basic_recv_packet_streamer(const size_t max_num_samps)
     {
         _max_num_samps = max_num_samps;
     }
@@ -917,19 +2096,79 @@ public:
         const double timeout,
         const bool one_packet)
     {
-        return recv_packet_handler::recv(
-            buffs, nsamps_per_buff, metadata, timeout, one_packet);
+        return handler_type::recv(buffs, nsamps_per_buff, metadata, timeout, one_packet);
+    }
+
+    size_t recv_segments(const rx_streamer::segments_type& segments,
+        uhd::rx_metadata_t& metadata,
+        const double timeout,
+        const bool one_packet)
+    {
+        return handler_type::recv_segments(segments, metadata, timeout, one_packet);
     }
 
     void issue_stream_cmd(const stream_cmd_t& stream_cmd)
     {
-        return recv_packet_handler::issue_stream_cmd(stream_cmd);
+        return handler_type::issue_stream_cmd(stream_cmd);
+    }
+
+    size_t recv_raw(rx_streamer::raw_buffs_type& buffs,
+        uhd::rx_metadata_t& metadata,
+        const double timeout)
+    {
+        return handler_type::recv_raw(buffs, metadata, timeout);
+    }
+
+    void release_raw(void)
+    {
+        handler_type::release_raw();
+    }
+
+    std::string get_raw_format(void) const
+    {
+        return handler_type::get_raw_format();
+    }
+
+    void set_capture_ring(const size_t nsamps)
+    {
+        handler_type::set_capture_ring(nsamps);
+    }
+
+    size_t capture(uhd::rx_metadata_t& metadata, const double timeout)
+    {
+        return handler_type::capture(metadata, timeout);
+    }
+
+    size_t extract_capture(const rx_streamer::buffs_type& buffs,
+        const size_t nsamps_per_buff,
+        const uhd::time_spec_t& time_spec,
+        uhd::rx_metadata_t& metadata)
+    {
+        return handler_type::extract_capture(buffs, nsamps_per_buff, time_spec, metadata);
+    }
+
+    uhd::stream_stats_t get_stats(void) const
+    {
+        return handler_type::get_stats();
+    }
+
+    bool prepare_recv_wait(std::vector<int>& fds)
+    {
+        return handler_type::prepare_recv_wait(fds);
     }
 
 private:
     size_t _max_num_samps;
 };
 
+typedef basic_recv_packet_streamer<boost::function<managed_recv_buffer::sptr(double)>,
+    boost::function<void(const size_t)>>
+    recv_packet_streamer;
+
+//! Receive streamer that gets its buffers straight from a zero-copy transport
+typedef basic_recv_packet_streamer<zero_copy_recv_buff_getter, no_recv_flowctrl>
+    zero_copy_recv_packet_streamer;
+
 }}} // namespace uhd::transport::sph
 
 #endif /* INCLUDED_LIBUHD_TRANSPORT_SUPER_RECV_PACKET_HANDLER_HPP */
@@ -14,14 +14,25 @@
 #include <uhd/stream.hpp>
 #include <uhd/transport/vrt_if_packet.hpp>
 #include <uhd/transport/zero_copy.hpp>
+#include <uhd/types/endianness.hpp>
 #include <uhd/types/metadata.hpp>
 #include <uhd/utils/byteswap.hpp>
 #include <uhd/utils/tasks.hpp>
 #include <uhd/utils/thread.hpp>
 #include <uhdlib/rfnoc/tx_stream_terminator.hpp>
+#include <uhdlib/transport/chdr_data_packer.hpp>
+#include <uhdlib/transport/stream_stats.hpp>
+#include <uhdlib/transport/tx_lead_time.hpp>
+#include <uhdlib/utils/deadline.hpp>
+#include <uhdlib/utils/trace_events.hpp>
+#include <uhdlib/utils/worker_pool.hpp>
+#include <boost/format.hpp>
 #include <boost/function.hpp>
+#include <algorithm>
 #include <chrono>
+#include <deque>
 #include <iostream>
+#include <mutex>
 #include <thread>
 #include <vector>
 
@@ -36,18 +47,62 @@
 
 namespace uhd { namespace transport { namespace sph {
 
+/***********************************************************************
+ * Send buffer getter for a zero-copy transport
+ *
+ * Can be used as the get_buff_fn_type of a basic_send_packet_handler
+ * in place of a type-erased function, so that the per-packet call
+ * into the transport does not go through a std::function.
+ **********************************************************************/
+struct zero_copy_send_buff_getter
+{
+    zero_copy_if::sptr xport;
+
+    UHD_INLINE managed_send_buffer::sptr operator()(const double timeout) const
+    {
+        return xport->get_send_buff(timeout);
+    }
+
+    explicit operator bool(void) const
+    {
+        return bool(xport);
+    }
+};
+
+/***********************************************************************
+ * Flow control for streamers whose transport does its own, or none.
+ * Compiles down to nothing.
+ **********************************************************************/
+struct no_send_flowctrl
+{
+    UHD_INLINE void operator()(const size_t) const {}
+
+    explicit operator bool(void) const
+    {
+        return false;
+    }
+};
+
 /***********************************************************************
  * Super send packet handler
  *
  * A send packet handler represents a group of channels.
  * The channel group shares a common sample rate.
  * All channels are sent in unison in send().
+ *
+ * The types of the per-packet callbacks are template parameters, see
+ * basic_recv_packet_handler.
  **********************************************************************/
-class send_packet_handler
+template <typename get_buff_fn_type,
+    typename post_send_cb_fn_type,
+    typename send_flowctrl_fn_type = no_send_flowctrl>
+class basic_send_packet_handler
 {
 public:
-    typedef std::function<managed_send_buffer::sptr(double)> get_buff_type;
-    typedef std::function<void(void)> post_send_cb_type;
+    typedef get_buff_fn_type get_buff_type;
+    typedef post_send_cb_fn_type post_send_cb_type;
+    typedef send_flowctrl_fn_type send_flowctrl_type;
+    typedef std::function<void(void)> flush_cb_type;
     typedef std::function<bool(uhd::async_metadata_t&, const double)> async_receiver_type;
     typedef void (*vrt_packer_type)(uint32_t*, vrt::if_packet_info_t&);
     // typedef std::function<void(uint32_t *, vrt::if_packet_info_t &)> vrt_packer_type;
@@ -56,14 +111,17 @@ public:
      * Make a new packet handler for send
      * \param size the number of transport channels
      */
-    send_packet_handler(const size_t size = 1)
-        : _next_packet_seq(0), _cached_metadata(false)
+    basic_send_packet_handler(const size_t size = 1)
+        : _raw_num_header_words32(0)
+        , _raw_has_time_spec(false)
+        , _next_packet_seq(0)
+        , _cached_metadata(false)
     {
         this->set_enable_trailer(true);
         this->resize(size);
     }
 
-    ~send_packet_handler(void)
+    ~basic_send_packet_handler(void)
     {
         /* NOP */
     }
@@ -92,12 +150,41 @@ public:
         _header_offset_words32 = header_offset_words32;
     }
 
+    /*!
+     * Pack the headers of data packets with vrt::chdr::pack_data_hdr(),
+     * specialized for the endianness of the transport, instead of with the
+     * packer from set_vrt_packer(). Raw sends still use the latter.
+     *
+     * All channels must have a SID, and the trailer must be disabled (see
+     * set_enable_trailer()), otherwise the generic packer is used.
+     *
+     * \param endianness the endianness of the transport
+     */
+    void set_chdr_data_packer(const uhd::endianness_t endianness)
+    {
+        if (endianness == uhd::ENDIANNESS_BIG) {
+            _data_hdr_packers[0] = &vrt::chdr::pack_data_hdr<true, false>;
+            _data_hdr_packers[1] = &vrt::chdr::pack_data_hdr<true, true>;
+            _data_hdr_to_otw     = &vrt::chdr::data_hdr_to_otw<true>;
+        } else {
+            _data_hdr_packers[0] = &vrt::chdr::pack_data_hdr<false, false>;
+            _data_hdr_packers[1] = &vrt::chdr::pack_data_hdr<false, true>;
+            _data_hdr_to_otw     = &vrt::chdr::data_hdr_to_otw<false>;
+        }
+        for (xport_chan_props_type& props : _props) {
+            props.sid_otw = _data_hdr_to_otw(props.sid);
+        }
+    }
+
     //! Set the stream ID for a specific channel (or no SID)
     void set_xport_chan_sid(
         const size_t xport_chan, const bool has_sid, const uint32_t sid = 0)
     {
         _props.at(xport_chan).has_sid = has_sid;
         _props.at(xport_chan).sid     = sid;
+        if (_data_hdr_to_otw) {
+            _props.at(xport_chan).sid_otw = _data_hdr_to_otw(sid);
+        }
     }
 
     void set_enable_trailer(const bool enable)
@@ -137,11 +224,37 @@ public:
         _props.at(xport_chan).go_postal = cb;
     }
 
+    /*!
+     * Set the flow control function, which is called with the size of every
+     * packet before it is sent and returns once the device has room for it.
+     * This saves wrapping the transport in a flow controlled transport.
+     * \param xport_chan which transport channel
+     * \param flowctrl flow control function
+     */
+    void set_xport_chan_flowctrl(
+        const size_t xport_chan, const send_flowctrl_type& flowctrl)
+    {
+        _props.at(xport_chan).flowctrl = flowctrl;
+    }
+
+    /*!
+     * Set the callback function to flush the transport at end-of-burst.
+     * This is used with transports that defer sending committed buffers.
+     * \param xport_chan which transport channel
+     * \param cb flush callback
+     */
+    void set_xport_chan_flush_cb(const size_t xport_chan, const flush_cb_type& cb)
+    {
+        _props.at(xport_chan).flush = cb;
+    }
+
     //! Set the conversion routine for all channels
     void set_converter(const uhd::convert::id_type& id)
     {
-        _num_inputs = id.num_inputs;
-        _converter  = uhd::convert::get_converter(id)();
+        _num_inputs   = id.num_inputs;
+        _converter_id = id;
+        _converter    = uhd::convert::get_converter(id)();
+        _make_worker_converters();
         this->set_scale_factor(32767.); // update after setting converter
         _bytes_per_otw_item = uhd::convert::get_bytes_per_item(id.output_format);
         _bytes_per_cpu_item = uhd::convert::get_bytes_per_item(id.input_format);
@@ -157,10 +270,35 @@ public:
         _max_samples_per_packet = num_samps;
     }
 
+    /*!
+     * Set the number of threads that convert the channels of a packet.
+     * With more than one thread, the calling thread converts some channels
+     * itself and hands the others to a worker pool. Every thread gets its own
+     * converter instance.
+     * \param num_threads number of converting threads, including the caller
+     */
+    void set_convert_threads(const size_t num_threads)
+    {
+        const size_t num_workers = std::min(num_threads, this->size()) - 1;
+        if (num_threads == 0 or num_workers == 0) {
+            _convert_pool.reset();
+        } else if (not _convert_pool or _convert_pool->get_num_workers() != num_workers) {
+            _convert_pool = std::make_shared<uhd::worker_pool>(num_workers);
+        }
+        _make_worker_converters();
+        if (_converter) {
+            this->set_scale_factor(_scale_factor);
+        }
+    }
+
     //! Set the scale factor used in float conversion
     void set_scale_factor(const double scale_factor)
     {
+        _scale_factor = scale_factor;
         _converter->set_scalar(scale_factor);
+        for (auto& converter : _worker_converters) {
+            converter->set_scalar(scale_factor);
+        }
     }
 
     //! Set the callback to get async messages
@@ -169,15 +307,73 @@ public:
         _async_receiver = async_receiver;
     }
 
+    //! Set the descriptor that is readable while the async receiver has messages
+    void set_async_msg_fd(const int fd)
+    {
+        _async_msg_fd = fd;
+    }
+
+    //! Return the descriptor from set_async_msg_fd(), or -1
+    int get_async_msg_fd(void) const
+    {
+        return _async_msg_fd;
+    }
+
+    /*!
+     * Set the controller that learns the lead time of timed bursts
+     * \param ctrl the controller, fed with the bursts and async messages
+     * \param apply if true, send() moves timed bursts to the earliest safe time
+     */
+    void set_lead_time_ctrl(const tx_lead_time_ctrl::sptr& ctrl, const bool apply)
+    {
+        _lead_time_ctrl  = ctrl;
+        _lead_time_apply = ctrl and apply;
+    }
+
+    //! Return the state of the lead time controller
+    uhd::tx_streamer::lead_time_t get_lead_time(void) const
+    {
+        if (not _lead_time_ctrl) {
+            throw uhd::not_implemented_error(
+                "get_lead_time() needs the lead_time stream arg");
+        }
+        return _lead_time_ctrl->get();
+    }
+
     //! Overload call to get async metadata
     bool recv_async_msg(uhd::async_metadata_t& async_metadata, double timeout = 0.1)
     {
-        if (_async_receiver)
-            return _async_receiver(async_metadata, timeout);
+        if (_async_receiver) {
+            if (not _async_receiver(async_metadata, timeout)) {
+                return false;
+            }
+            // This may run in another thread than send()
+            switch (async_metadata.event_code) {
+                case async_metadata_t::EVENT_CODE_UNDERFLOW:
+                case async_metadata_t::EVENT_CODE_UNDERFLOW_IN_PACKET:
+                    stream_stats_counters::add_shared(_stats.underflows);
+                    break;
+                case async_metadata_t::EVENT_CODE_TIME_ERROR:
+                    stream_stats_counters::add_shared(_stats.late_packets);
+                    break;
+                default:
+                    break;
+            }
+            if (_lead_time_ctrl) {
+                _lead_time_ctrl->on_async_msg(async_metadata);
+            }
+            return true;
+        }
         std::this_thread::sleep_for(std::chrono::microseconds(long(timeout * 1e6)));
         return false;
     }
 
+    //! Return a snapshot of the streaming statistics
+    uhd::stream_stats_t get_stats(void) const
+    {
+        return _stats.get();
+    }
+
     /*******************************************************************
      * Send:
      * The entry point for the fast-path send calls.
@@ -188,18 +384,16 @@ public:
         const uhd::tx_metadata_t& metadata,
         const double timeout)
     {
+        // all packets of this call share its timeout
+        const deadline_t deadline(timeout);
+        const stream_stats_counters::call_timer call_timer(_stats);
+        const trace_events::scoped_span trace_span(
+            "streamer", "send", trace_events::sample(_trace_sample_count));
         // translate the metadata to vrt if packet info
-        vrt::if_packet_info_t if_packet_info;
-        if_packet_info.packet_type = vrt::if_packet_info_t::PACKET_TYPE_DATA;
-        // if_packet_info.has_sid = false; //set per channel
-        if_packet_info.has_cid = false;
-        if_packet_info.has_tlr = _has_tlr;
-        if_packet_info.has_tsi = false;
-        if_packet_info.has_tsf = metadata.has_time_spec;
-        if_packet_info.tsf     = metadata.time_spec.to_ticks(_tick_rate);
-        if_packet_info.sob     = metadata.start_of_burst;
-        if_packet_info.eob     = metadata.end_of_burst;
-        if_packet_info.fc_ack  = false; // This is a data packet
+        vrt::if_packet_info_t if_packet_info = make_if_packet_info(metadata.has_time_spec);
+        if_packet_info.tsf = get_tsf(metadata);
+        if_packet_info.sob = metadata.start_of_burst;
+        if_packet_info.eob = metadata.end_of_burst;
 
         /*
          * Metadata is cached when we get a send requesting a start of burst with no
@@ -210,13 +404,18 @@ public:
             // If the new metada has a time_spec, do not use the cached time_spec.
             if (!metadata.has_time_spec) {
                 if_packet_info.has_tsf = _metadata_cache.has_time_spec;
-                if_packet_info.tsf     = _metadata_cache.time_spec.to_ticks(_tick_rate);
+                if_packet_info.tsf     = get_tsf(_metadata_cache);
             }
             if_packet_info.sob = _metadata_cache.start_of_burst;
             if_packet_info.eob = _metadata_cache.end_of_burst;
             _cached_metadata   = false;
         }
 
+        if (_lead_time_apply and if_packet_info.has_tsf and if_packet_info.sob
+            and nsamps_per_buff != 0) {
+            apply_lead_time(if_packet_info);
+        }
+
         if (nsamps_per_buff <= _max_samples_per_packet) {
 // TODO remove this code when sample counts of zero are supported by hardware
 #ifndef SSPH_DONT_PAD_TO_ONE
@@ -233,19 +432,113 @@ public:
                 } else {
                     // send requests with no samples are handled here (such as end of
                     // burst)
-                    return send_one_packet(_zero_buffs, 1, if_packet_info, timeout) & 0x0;
+                    return send_one_packet(_zero_buffs, 1, if_packet_info, deadline)
+                           & 0x0;
                 }
             }
 #endif
 
             size_t nsamps_sent =
-                send_one_packet(buffs, nsamps_per_buff, if_packet_info, timeout);
+                send_one_packet(buffs, nsamps_per_buff, if_packet_info, deadline);
 #ifdef UHD_TXRX_DEBUG_PRINTS
             dbg_print_send(nsamps_per_buff, nsamps_sent, metadata, timeout);
 #endif
             return nsamps_sent;
         }
+        size_t nsamps_sent =
+            send_fragments(buffs, nsamps_per_buff, if_packet_info, deadline);
+#ifdef UHD_TXRX_DEBUG_PRINTS
+        dbg_print_send(nsamps_per_buff, nsamps_sent, metadata, timeout);
+
+#endif
+        return nsamps_sent;
+    }
+
+    /*******************************************************************
+     * Send bursts:
+     * Send a queue of timed bursts, and attribute the async messages to
+     * them afterwards.
+     ******************************************************************/
+    size_t send_bursts(
+        const std::vector<uhd::tx_streamer::burst_t>& bursts, const double timeout)
+    {
+        const deadline_t deadline(timeout);
+        const stream_stats_counters::call_timer call_timer(_stats);
+        static const uint64_t zero = 0;
+        _zero_buffs.resize(this->size(), &zero);
+
+        size_t num_sent = 0;
+        for (const uhd::tx_streamer::burst_t& burst : bursts) {
+            if (burst.buffs.size() != this->size()) {
+                throw uhd::value_error(
+                    str(boost::format("send_bursts(): burst has %u buffers for %u "
+                                      "channels")
+                        % burst.buffs.size() % this->size()));
+            }
+            vrt::if_packet_info_t if_packet_info = make_if_packet_info(true);
+            if_packet_info.tsf = burst.time_spec.to_ticks(_tick_rate);
+            if_packet_info.sob = true;
+            if_packet_info.eob = true;
+
+            size_t nsamps_sent = 0;
+            if (burst.nsamps_per_buff == 0) {
+                // send one zero sample, the hardware doesn't take empty bursts
+                if (send_one_packet(_zero_buffs, 1, if_packet_info, deadline) == 0) {
+                    break;
+                }
+            } else {
+                nsamps_sent = send_fragments(
+                    burst.buffs, burst.nsamps_per_buff, if_packet_info, deadline);
+                if (nsamps_sent == 0) {
+                    // nothing of it went out, so the caller can send it again
+                    break;
+                }
+                if (nsamps_sent < burst.nsamps_per_buff) {
+                    vrt::if_packet_info_t eob_packet_info = make_if_packet_info(false);
+                    eob_packet_info.sob = false;
+                    eob_packet_info.eob = true;
+                    send_one_packet(_zero_buffs, 1, eob_packet_info, deadline);
+                }
+            }
+            add_pending_burst(burst, nsamps_sent);
+            num_sent++;
+            if (nsamps_sent < burst.nsamps_per_buff) {
+                break;
+            }
+        }
+        return num_sent;
+    }
+
+    size_t recv_burst_status(
+        std::vector<uhd::tx_streamer::burst_status_t>& status, const double timeout)
+    {
+        status.clear();
+        uhd::async_metadata_t async_metadata;
+        double wait = timeout;
+        while (recv_async_msg(async_metadata, wait)) {
+            wait = 0.0;
+            handle_burst_event(async_metadata, status);
+        }
+        return status.size();
+    }
+
+private:
+    /*!
+     * Send a buffer as one or more packets. Start and end of burst of
+     * if_packet_info go to the first and the last packet.
+     * \return the number of samples sent, fewer on timeout
+     */
+    UHD_INLINE size_t send_fragments(const uhd::tx_streamer::buffs_type& buffs,
+        const size_t nsamps_per_buff,
+        vrt::if_packet_info_t& if_packet_info,
+        const deadline_t& deadline)
+    {
+        if (nsamps_per_buff <= _max_samples_per_packet) {
+            return send_one_packet(buffs, nsamps_per_buff, if_packet_info, deadline);
+        }
         size_t total_num_samps_sent = 0;
+        const uint64_t first_tsf    = if_packet_info.tsf;
+        const bool eob              = if_packet_info.eob;
 
         // false until final fragment
         if_packet_info.eob = false;
@@ -259,60 +552,269 @@ public:
             const size_t num_samps_sent = send_one_packet(buffs,
                 _max_samples_per_packet,
                 if_packet_info,
-                timeout,
+                deadline,
                 total_num_samps_sent * _bytes_per_cpu_item);
             total_num_samps_sent += num_samps_sent;
             if (num_samps_sent == 0)
                 return total_num_samps_sent;
 
             // setup metadata for the next fragment
-            const time_spec_t time_spec =
-                metadata.time_spec
-                + time_spec_t::from_ticks(total_num_samps_sent, _samp_rate);
-            if_packet_info.tsf = time_spec.to_ticks(_tick_rate);
+            if_packet_info.tsf =
+                first_tsf
+                + time_ticks_t::convert(total_num_samps_sent, _samp_rate, _tick_rate);
             if_packet_info.sob = false;
         }
 
         // send the final fragment with the helper function
+        if_packet_info.eob = eob;
+        return total_num_samps_sent
+               + send_one_packet(buffs,
+                     final_length,
+                     if_packet_info,
+                     deadline,
+                     total_num_samps_sent * _bytes_per_cpu_item);
+    }
+
+    //! Most bursts to keep track of, older ones are dropped
+    static const size_t MAX_PENDING_BURSTS = 4096;
+
+    //! A burst sent by send_bursts() that isn't done yet
+    struct pending_burst_t
+    {
+        uhd::tx_streamer::burst_status_t status;
+        uhd::time_spec_t time_spec;
+        //! Per channel, true once the channel acknowledged this or a later burst
+        std::vector<bool> done;
+        size_t num_done;
+        size_t num_acks;
+    };
+
+    void add_pending_burst(
+        const uhd::tx_streamer::burst_t& burst, const size_t nsamps_sent)
+    {
+        pending_burst_t pending;
+        pending.status.id          = burst.id;
+        pending.status.nsamps_sent = nsamps_sent;
+        pending.status.acked       = false;
+        pending.status.event_code  = uhd::async_metadata_t::EVENT_CODE_BURST_ACK;
+        pending.time_spec          = burst.time_spec;
+        pending.done.resize(this->size(), false);
+        pending.num_done = 0;
+        pending.num_acks = 0;
+
+        std::lock_guard<std::mutex> lock(_bursts_mutex);
+        if (_pending_bursts.size() == MAX_PENDING_BURSTS) {
+            _pending_bursts.pop_front();
+        }
+        _pending_bursts.push_back(std::move(pending));
+    }
+
+    //! Attribute an async message to a pending burst, and move the bursts that
+    //  are done to status
+    void handle_burst_event(const uhd::async_metadata_t& async_metadata,
+        std::vector<uhd::tx_streamer::burst_status_t>& status)
+    {
+        std::lock_guard<std::mutex> lock(_bursts_mutex);
+        if (_pending_bursts.empty()) {
+            return;
+        }
+        const size_t chan =
+            (async_metadata.channel < this->size()) ? async_metadata.channel : 0;
+
+        // The message belongs to the last burst that started before it, or
+        // without a time, to the first one the channel isn't done with
+        size_t index = 0;
+        if (async_metadata.has_time_spec) {
+            const auto next = std::upper_bound(_pending_bursts.begin(),
+                _pending_bursts.end(),
+                async_metadata.time_spec,
+                [](const uhd::time_spec_t& time, const pending_burst_t& burst) {
+                    return time < burst.time_spec;
+                });
+            index = std::max<ptrdiff_t>(next - _pending_bursts.begin() - 1, 0);
+        } else {
+            while (index + 1 < _pending_bursts.size()
+                   and _pending_bursts[index].done[chan]) {
+                index++;
+            }
+        }
+
+        switch (async_metadata.event_code) {
+            case uhd::async_metadata_t::EVENT_CODE_BURST_ACK:
+                // the channel is done with this burst and all before it
+                for (size_t i = 0; i <= index; i++) {
+                    if (not _pending_bursts[i].done[chan]) {
+                        _pending_bursts[i].done[chan] = true;
+                        _pending_bursts[i].num_done++;
+                    }
+                }
+                _pending_bursts[index].num_acks++;
+                break;
+            case uhd::async_metadata_t::EVENT_CODE_USER_PAYLOAD:
+                break;
+            default:
+                if (_pending_bursts[index].status.event_code
+                    == uhd::async_metadata_t::EVENT_CODE_BURST_ACK) {
+                    _pending_bursts[index].status.event_code = async_metadata.event_code;
+                }
+                break;
+        }
+
+        while (not _pending_bursts.empty()
+               and _pending_bursts.front().num_done == this->size()) {
+            pending_burst_t& front = _pending_bursts.front();
+            front.status.acked     = (front.num_acks >= this->size());
+            status.push_back(front.status);
+            _pending_bursts.pop_front();
+        }
+    }
+
+public:
+
+    /*******************************************************************
+     * Send without conversion:
+     * Hand out the payload areas of the next frames, and pack the
+     * headers once the application has filled them.
+     ******************************************************************/
+    UHD_INLINE size_t get_send_buffs(
+        std::vector<void*>& buffs, const bool has_time_spec, const double timeout)
+    {
+        // get a buffer for each channel or timeout
+        if (not get_buffs(deadline_t(timeout))) {
+            return 0;
+        }
+
+        // pack a preliminary header to find out its length
+        vrt::if_packet_info_t if_packet_info = make_if_packet_info(has_time_spec);
+        if_packet_info.num_payload_bytes     = 0;
+        if_packet_info.num_payload_words32   = 0;
+        if_packet_info.packet_count          = _next_packet_seq;
+        buffs.resize(this->size());
+        for (size_t i = 0; i < this->size(); i++) {
+            uint32_t* otw_mem =
+                _props[i].buff->template cast<uint32_t*>() + _header_offset_words32;
+            if_packet_info.has_sid = _props[i].has_sid;
+            if_packet_info.sid     = _props[i].sid;
+            _vrt_packer(otw_mem, if_packet_info);
+            buffs[i] = otw_mem + if_packet_info.num_header_words32;
+        }
+        _raw_num_header_words32 = if_packet_info.num_header_words32;
+        _raw_has_time_spec      = has_time_spec;
+        return _max_samples_per_packet;
+    }
+
+    UHD_INLINE void commit_send_buffs(
+        const size_t nsamps_per_buff, const uhd::tx_metadata_t& metadata)
+    {
+        if (_raw_num_header_words32 == 0) {
+            throw uhd::runtime_error(
+                "commit_send_buffs(): no buffers, call get_send_buffs() first");
+        }
+        if (nsamps_per_buff > _max_samples_per_packet) {
+            throw uhd::value_error("commit_send_buffs(): too many samples for a packet");
+        }
+        if (metadata.has_time_spec != _raw_has_time_spec) {
+            throw uhd::value_error("commit_send_buffs(): has_time_spec does not match "
+                                   "the one given to get_send_buffs()");
+        }
+
+        vrt::if_packet_info_t if_packet_info = make_if_packet_info(metadata.has_time_spec);
+        if_packet_info.tsf = get_tsf(metadata);
+        if_packet_info.sob = metadata.start_of_burst;
         if_packet_info.eob = metadata.end_of_burst;
-        size_t nsamps_sent = total_num_samps_sent
-                             + send_one_packet(buffs,
-                                   final_length,
-                                   if_packet_info,
-                                   timeout,
-                                   total_num_samps_sent * _bytes_per_cpu_item);
-#ifdef UHD_TXRX_DEBUG_PRINTS
-        dbg_print_send(nsamps_per_buff, nsamps_sent, metadata, timeout);
+        if_packet_info.num_payload_bytes =
+            nsamps_per_buff * _num_inputs * _bytes_per_otw_item;
+        if_packet_info.num_payload_words32 =
+            (if_packet_info.num_payload_bytes + 3 /*round up*/) / sizeof(uint32_t);
+        if_packet_info.packet_count = _next_packet_seq;
 
-#endif
-        return nsamps_sent;
+        // pack the final headers in front of the samples
+        for (xport_chan_props_type& props : _props) {
+            uint32_t* otw_mem =
+                props.buff->template cast<uint32_t*>() + _header_offset_words32;
+            if_packet_info.has_sid = props.has_sid;
+            if_packet_info.sid     = props.sid;
+            _vrt_packer(otw_mem, if_packet_info);
+            UHD_ASSERT_THROW(if_packet_info.num_header_words32 == _raw_num_header_words32);
+            props.commit_size = (_header_offset_words32 + if_packet_info.num_packet_words32)
+                                * sizeof(uint32_t);
+        }
+
+        commit_buffs(if_packet_info.eob);
+        stream_stats_counters::add(_stats.num_samps, nsamps_per_buff);
+        if (_lead_time_ctrl and if_packet_info.sob and if_packet_info.has_tsf) {
+            _lead_time_ctrl->on_burst_start(
+                uhd::time_spec_t::from_ticks(if_packet_info.tsf, _tick_rate));
+        }
     }
 
 private:
+    //! Streaming statistics, see get_stats()
+    stream_stats_counters _stats;
+
     vrt_packer_type _vrt_packer;
+    //! see set_chdr_data_packer(), indexed by has_tsf
+    vrt::chdr::data_hdr_packer_type _data_hdr_packers[2] = {nullptr, nullptr};
+    uint32_t (*_data_hdr_to_otw)(uint32_t) = nullptr;
     size_t _header_offset_words32;
     double _tick_rate, _samp_rate;
     struct xport_chan_props_type
     {
-        xport_chan_props_type(void) : has_sid(false), sid(0) {}
+        xport_chan_props_type(void) : has_sid(false), sid(0), sid_otw(0), commit_size(0)
+        {
+        }
         get_buff_type get_buff;
         post_send_cb_type go_postal;
+        send_flowctrl_type flowctrl;
+        flush_cb_type flush;
         bool has_sid;
         uint32_t sid;
+        //! the SID in the endianness of set_chdr_data_packer()
+        uint32_t sid_otw;
         managed_send_buffer::sptr buff;
+        size_t commit_size;
     };
     std::vector<xport_chan_props_type> _props;
     size_t _num_inputs;
     size_t _bytes_per_otw_item; // used in conversion
     size_t _bytes_per_cpu_item; // used in conversion
     uhd::convert::converter::sptr _converter; // used in conversion
+    uhd::convert::id_type _converter_id;
+    double _scale_factor = 32767.;
+    //! Optional pool for parallel conversion, and one converter per worker
+    uhd::worker_pool::sptr _convert_pool;
+    std::vector<uhd::convert::converter::sptr> _worker_converters;
+
+    void _make_worker_converters(void)
+    {
+        _worker_converters.clear();
+        if (not _converter or not _convert_pool) {
+            return;
+        }
+        for (size_t i = 0; i < _convert_pool->get_num_workers(); i++) {
+            _worker_converters.push_back(uhd::convert::get_converter(_converter_id)());
+        }
+    }
     size_t _max_samples_per_packet;
     std::vector<const void*> _zero_buffs;
+    // header length of the frames handed out by get_send_buffs(), 0 if none
+    size_t _raw_num_header_words32;
+    bool _raw_has_time_spec;
     size_t _next_packet_seq;
     bool _has_tlr;
     async_receiver_type _async_receiver;
+    int _async_msg_fd = -1;
+    //! Optional, see set_lead_time_ctrl()
+    tx_lead_time_ctrl::sptr _lead_time_ctrl;
+    bool _lead_time_apply = false;
     bool _cached_metadata;
     uhd::tx_metadata_t _metadata_cache;
+    //! Calls of send(), to record a sample of them in a trace
+    size_t _trace_sample_count = 0;
+    //! The bursts of send_bursts(), guarded since recv_burst_status() may
+    //  run in another thread
+    std::mutex _bursts_mutex;
+    std::deque<pending_burst_t> _pending_bursts;
 
 #ifdef UHD_TXRX_DEBUG_PRINTS
     struct dbg_send_stat_t
@@ -376,13 +878,37 @@ private:
 
 #endif
 
+    //! Get the time of a send in ticks, preferring the exact tick count
+    UHD_INLINE uint64_t get_tsf(const uhd::tx_metadata_t& metadata) const
+    {
+        if (metadata.time_ticks.is_valid()) {
+            return time_ticks_t::convert(
+                metadata.time_ticks.ticks, metadata.time_ticks.tick_rate, _tick_rate);
+        }
+        return metadata.time_spec.to_ticks(_tick_rate);
+    }
+
+    //! Return the if packet info fields that are the same for all data packets
+    UHD_INLINE vrt::if_packet_info_t make_if_packet_info(const bool has_time_spec)
+    {
+        vrt::if_packet_info_t if_packet_info;
+        if_packet_info.packet_type = vrt::if_packet_info_t::PACKET_TYPE_DATA;
+        // if_packet_info.has_sid = false; //set per channel
+        if_packet_info.has_cid = false;
+        if_packet_info.has_tlr = _has_tlr;
+        if_packet_info.has_tsi = false;
+        if_packet_info.has_tsf = has_time_spec;
+        if_packet_info.fc_ack  = false; // This is a data packet
+        return if_packet_info;
+    }
+
     /*******************************************************************
      * Send a single packet:
      ******************************************************************/
     UHD_INLINE size_t send_one_packet(const uhd::tx_streamer::buffs_type& buffs,
         const size_t nsamps_per_buff,
         vrt::if_packet_info_t& if_packet_info,
-        const double timeout,
+        const deadline_t& deadline,
         const size_t buffer_offset_bytes = 0)
     {
         // load the rest of the if_packet_info in here
@@ -393,11 +919,8 @@ private:
         if_packet_info.packet_count = _next_packet_seq;
 
         // get a buffer for each channel or timeout
-        BOOST_FOREACH (xport_chan_props_type& props, _props) {
-            if (not props.buff)
-                props.buff = props.get_buff(timeout);
-            if (not props.buff)
-                return 0; // timeout
+        if (not get_buffs(deadline)) {
+            return 0;
         }
 
         // setup the data to share with converter threads
@@ -405,28 +928,118 @@ private:
         _convert_buffs               = &buffs;
         _convert_buffer_offset_bytes = buffer_offset_bytes;
         _convert_if_packet_info      = &if_packet_info;
+        _convert_data_hdr_packer     = nullptr;
+        if (_data_hdr_packers[0] and not _has_tlr) {
+            _convert_data_hdr_packer = _data_hdr_packers[if_packet_info.has_tsf ? 1 : 0];
+            _convert_data_hdr.packet_count      = if_packet_info.packet_count;
+            _convert_data_hdr.num_payload_bytes = if_packet_info.num_payload_bytes;
+            _convert_data_hdr.eob               = if_packet_info.eob;
+            _convert_data_hdr.tsf               = if_packet_info.tsf;
+        }
 
         // perform N channels of conversion
-        for (size_t i = 0; i < this->size(); i++) {
-            convert_to_in_buff(i);
+        const auto convert_start = stream_stats_counters::clock::now();
+        if (_convert_pool) {
+            _convert_pool->run(
+                this->size(), [this](const size_t index, const size_t participant) {
+                    convert_to_in_buff(index,
+                        participant == 0 ? *_converter
+                                         : *_worker_converters[participant - 1]);
+                });
+        } else {
+            for (size_t i = 0; i < this->size(); i++) {
+                convert_to_in_buff(i, *_converter);
+            }
         }
+        stream_stats_counters::add(
+            _stats.convert_ns, stream_stats_counters::ns_since(convert_start));
 
-        _next_packet_seq++; // increment sequence after commits
+        commit_buffs(if_packet_info.eob);
+        stream_stats_counters::add(_stats.num_samps, nsamps_per_buff);
+        // The burst counts as sent once its first packet got flow control credits
+        if (_lead_time_ctrl and if_packet_info.sob and if_packet_info.has_tsf) {
+            _lead_time_ctrl->on_burst_start(
+                uhd::time_spec_t::from_ticks(if_packet_info.tsf, _tick_rate));
+        }
         return nsamps_per_buff;
     }
 
-    /*! Run the conversion from the internal buffers to the user's input
-     *  buffer.
+    //! Move a timed start of burst to the earliest time with enough lead time
+    UHD_INLINE void apply_lead_time(vrt::if_packet_info_t& if_packet_info)
+    {
+        const long long earliest_tsf =
+            _lead_time_ctrl->get_earliest_time_spec().to_ticks(_tick_rate);
+        if (earliest_tsf > 0 and uint64_t(earliest_tsf) > if_packet_info.tsf) {
+            if_packet_info.tsf = uint64_t(earliest_tsf);
+            _lead_time_ctrl->count_adjusted();
+        }
+    }
+
+    //! Get a buffer for each channel that doesn't have one yet
+    // \return false on timeout
+    UHD_INLINE bool get_buffs(const deadline_t& deadline)
+    {
+        for (xport_chan_props_type& props : _props) {
+            if (props.buff) {
+                continue;
+            }
+            const auto get_buff_start = stream_stats_counters::clock::now();
+            props.buff                = props.get_buff(deadline.remaining());
+            stream_stats_counters::add(
+                _stats.blocked_ns, stream_stats_counters::ns_since(get_buff_start));
+            if (not props.buff) {
+                stream_stats_counters::add(_stats.timeouts);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    //! Commit the buffers of all channels and advance the sequence number
+    UHD_INLINE void commit_buffs(const bool eob)
+    {
+        // commit the samples to the zero-copy interface
+        for (xport_chan_props_type& props : _props) {
+            stream_stats_counters::add(_stats.num_packets);
+            stream_stats_counters::add(_stats.num_bytes, props.commit_size);
+            if (props.flowctrl) {
+                props.flowctrl(props.commit_size);
+            }
+            props.buff->commit(props.commit_size);
+            props.buff.reset(); // effectively a release
+
+            if (props.go_postal) {
+                props.go_postal();
+            }
+        }
+
+        // don't let the end of a burst linger in a batching transport
+        if (eob) {
+            for (xport_chan_props_type& props : _props) {
+                if (props.flush) {
+                    props.flush();
+                }
+            }
+        }
+
+        _raw_num_header_words32 = 0;
+        _next_packet_seq++; // increment sequence after commits
+    }
+
+    /*! Run the conversion from the user's input buffer to the internal
+     *  buffers.
      *
+     * - Packs the header
      * - Calls the converter
-     * - Releases internal data buffers
-     * - Updates read/write pointers
+     *
+     * This may run on a worker thread, so it must only touch the state of
+     * its own channel. The buffer is committed by send_one_packet().
      */
-    UHD_INLINE void convert_to_in_buff(const size_t index)
+    UHD_INLINE void convert_to_in_buff(
+        const size_t index, uhd::convert::converter& converter)
     {
         // shortcut references to local data structures
         managed_send_buffer::sptr& buff      = _props[index].buff;
-        vrt::if_packet_info_t if_packet_info = *_convert_if_packet_info;
         const tx_streamer::buffs_type& buffs = *_convert_buffs;
 
         // fill IO buffs with pointers into the output buffer
@@ -438,24 +1051,28 @@ private:
         const ref_vector<const void*> in_buffs(io_buffs, _num_inputs);
 
         // pack metadata into a vrt header
-        uint32_t* otw_mem      = buff->cast<uint32_t*>() + _header_offset_words32;
-        if_packet_info.has_sid = _props[index].has_sid;
-        if_packet_info.sid     = _props[index].sid;
-        _vrt_packer(otw_mem, if_packet_info);
-        otw_mem += if_packet_info.num_header_words32;
+        uint32_t* otw_mem = buff->cast<uint32_t*>() + _header_offset_words32;
+        size_t num_packet_words32;
+        if (_convert_data_hdr_packer) {
+            const size_t num_header_words32 =
+                _convert_data_hdr_packer(otw_mem, _props[index].sid_otw, _convert_data_hdr);
+            otw_mem += num_header_words32;
+            num_packet_words32 =
+                num_header_words32 + _convert_if_packet_info->num_payload_words32;
+        } else {
+            vrt::if_packet_info_t if_packet_info = *_convert_if_packet_info;
+            if_packet_info.has_sid               = _props[index].has_sid;
+            if_packet_info.sid                   = _props[index].sid;
+            _vrt_packer(otw_mem, if_packet_info);
+            otw_mem += if_packet_info.num_header_words32;
+            num_packet_words32 = if_packet_info.num_packet_words32;
+        }
 
         // perform the conversion operation
-        _converter->conv(in_buffs, otw_mem, _convert_nsamps);
+        converter.conv(in_buffs, otw_mem, _convert_nsamps);
 
-        // commit the samples to the zero-copy interface
-        const size_t num_vita_words32 =
-            _header_offset_words32 + if_packet_info.num_packet_words32;
-        buff->commit(num_vita_words32 * sizeof(uint32_t));
-        buff.reset(); // effectively a release
-
-        if (_props[index].go_postal) {
-            _props[index].go_postal();
-        }
+        const size_t num_vita_words32 = _header_offset_words32 + num_packet_words32;
+        _props[index].commit_size     = num_vita_words32 * sizeof(uint32_t);
     }
 
     //! Shared variables for the worker threads
@@ -463,12 +1080,30 @@ private:
     const tx_streamer::buffs_type* _convert_buffs;
     size_t _convert_buffer_offset_bytes;
     vrt::if_packet_info_t* _convert_if_packet_info;
+    vrt::chdr::data_hdr_packer_type _convert_data_hdr_packer;
+    vrt::chdr::data_hdr_t _convert_data_hdr;
 };
 
-class send_packet_streamer : public send_packet_handler, public tx_streamer
+typedef basic_send_packet_handler<std::function<managed_send_buffer::sptr(double)>,
+    std::function<void(void)>>
+    send_packet_handler;
+
+template <typename get_buff_fn_type,
+    typename post_send_cb_fn_type,
+    typename send_flowctrl_fn_type = no_send_flowctrl>
+class basic_send_packet_streamer
+    : public basic_send_packet_handler<get_buff_fn_type,
+          post_send_cb_fn_type,
+          send_flowctrl_fn_type>,
+      public tx_streamer
 {
 public:
-    send_packet_streamer(const size_t max_num_samps)
+    typedef basic_send_packet_handler<get_buff_fn_type,
+        post_send_cb_fn_type,
+        send_flowctrl_fn_type>
+        handler_type;
+
+    basic_send_packet_streamer(const size_t max_num_samps)
     {
         _max_num_samps = max_num_samps;
         this->set_max_samples_per_packet(_max_num_samps);
@@ -489,18 +1124,60 @@ public:
         const uhd::tx_metadata_t& metadata,
         const double timeout)
     {
-        return send_packet_handler::send(buffs, nsamps_per_buff, metadata, timeout);
+        return handler_type::send(buffs, nsamps_per_buff, metadata, timeout);
     }
 
     bool recv_async_msg(uhd::async_metadata_t& async_metadata, double timeout = 0.1)
     {
-        return send_packet_handler::recv_async_msg(async_metadata, timeout);
+        return handler_type::recv_async_msg(async_metadata, timeout);
+    }
+
+    size_t send_bursts(
+        const std::vector<tx_streamer::burst_t>& bursts, const double timeout)
+    {
+        return handler_type::send_bursts(bursts, timeout);
+    }
+
+    size_t recv_burst_status(
+        std::vector<tx_streamer::burst_status_t>& status, const double timeout)
+    {
+        return handler_type::recv_burst_status(status, timeout);
+    }
+
+    int get_async_msg_fd(void) const
+    {
+        return handler_type::get_async_msg_fd();
+    }
+
+    size_t get_send_buffs(
+        tx_streamer::raw_buffs_type& buffs, const bool has_time_spec, const double timeout)
+    {
+        return handler_type::get_send_buffs(buffs, has_time_spec, timeout);
+    }
+
+    void commit_send_buffs(const size_t nsamps_per_buff, const uhd::tx_metadata_t& metadata)
+    {
+        handler_type::commit_send_buffs(nsamps_per_buff, metadata);
+    }
+
+    uhd::stream_stats_t get_stats(void) const
+    {
+        return handler_type::get_stats();
+    }
+
+    lead_time_t get_lead_time(void) const
+    {
+        return handler_type::get_lead_time();
     }
 
 private:
     size_t _max_num_samps;
 };
 
+typedef basic_send_packet_streamer<std::function<managed_send_buffer::sptr(double)>,
+    std::function<void(void)>>
+    send_packet_streamer;
+
 }}} // namespace uhd::transport::sph
 
 #endif /* INCLUDED_LIBUHD_TRANSPORT_SUPER_SEND_PACKET_HANDLER_HPP */
@@ -8,11 +8,21 @@
 #include "udp_common.hpp"
 #include <uhd/transport/buffer_pool.hpp>
 #include <uhd/transport/tcp_zero_copy.hpp>
+#include <uhd/utils/byteswap.hpp>
 #include <uhd/utils/log.hpp>
 #include <uhdlib/utils/atomic.hpp>
 #include <boost/format.hpp>
 #include <boost/make_shared.hpp>
+#ifndef UHD_PLATFORM_WIN32
+#    include <sys/socket.h>
+#    include <sys/uio.h>
+#endif
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
 #include <thread>
 #include <vector>
 
@@ -20,8 +30,18 @@ using namespace uhd;
 using namespace uhd::transport;
 namespace asio = boost::asio;
 
-static const size_t DEFAULT_NUM_FRAMES = 32;
-static const size_t DEFAULT_FRAME_SIZE = 2048;
+static const size_t DEFAULT_NUM_FRAMES     = 32;
+static const size_t DEFAULT_FRAME_SIZE     = 2048;
+static const size_t DEFAULT_BUFF_ALIGNMENT = 16;
+
+//! Committed frames sent at once in stream mode
+static const size_t DEFAULT_STREAM_SEND_BATCH_SIZE = 16;
+//! Longest time a committed frame waits for its batch in stream mode
+static const double DEFAULT_STREAM_SEND_BATCH_TIMEOUT = 0.001;
+//! Stream mode frames start with their length as a 32-bit big endian word
+static const size_t STREAM_HDR_SIZE = sizeof(uint32_t);
+//! Room in front of a stream mode send buffer, so the header is in line
+static const size_t STREAM_HEADROOM = DEFAULT_BUFF_ALIGNMENT;
 
 /***********************************************************************
  * Reusable managed receiver buffer:
@@ -117,6 +137,413 @@ private:
     simple_claimer _claimer;
 };
 
+/***********************************************************************
+ * Stream mode receive buffer:
+ *  - a frame in the receiver's ring, released in place
+ **********************************************************************/
+class tcp_zero_copy_stream_mrb : public managed_recv_buffer
+{
+public:
+    tcp_zero_copy_stream_mrb(void) : _offset(0), _in_use(false)
+    { /*NOP*/
+    }
+
+    void release(void)
+    {
+        _in_use = false;
+    }
+
+    UHD_INLINE sptr get_new(char* ring, const size_t offset, const size_t len)
+    {
+        _offset = offset;
+        _in_use = true;
+        return make(this, ring + offset + STREAM_HDR_SIZE, len);
+    }
+
+    //! Offset of the frame's header in the ring
+    size_t get_offset(void) const
+    {
+        return _offset;
+    }
+
+    std::atomic<bool>& in_use(void)
+    {
+        return _in_use;
+    }
+
+private:
+    size_t _offset;
+    std::atomic<bool> _in_use;
+};
+
+/***********************************************************************
+ * Stream mode receiver:
+ *  - reads as much as fits from the socket into one ring
+ *  - cuts the length prefixed frames out of the ring and hands them out
+ *    in place, in order
+ *  - moves a partial frame at the end of the ring to its start, once no
+ *    frame that is in use sits there
+ **********************************************************************/
+class tcp_stream_receiver
+{
+public:
+    tcp_stream_receiver(int sock_fd,
+        const size_t num_frames,
+        const size_t frame_size,
+        const buffer_pool::mem_params_t& mem_params)
+        : _sock_fd(sock_fd)
+        , _frame_size(frame_size)
+        , _max_frame_bytes(frame_size + STREAM_HDR_SIZE)
+        , _ring_size(std::max<size_t>(num_frames, 2) * _max_frame_bytes)
+        , _ring_pool(
+              buffer_pool::make(1, _ring_size, DEFAULT_BUFF_ALIGNMENT, mem_params))
+        , _ring(static_cast<char*>(_ring_pool->at(0)))
+        , _parse_pos(0)
+        , _write_pos(0)
+        , _oldest(0)
+        , _num_in_use(0)
+    {
+        for (size_t i = 0; i < num_frames; i++) {
+            _mrbs.push_back(boost::make_shared<tcp_zero_copy_stream_mrb>());
+        }
+    }
+
+    managed_recv_buffer::sptr get_new(const double timeout)
+    {
+        const auto exit_time = std::chrono::steady_clock::now()
+                               + std::chrono::microseconds(int64_t(timeout * 1e6));
+        while (true) {
+            reap();
+            const size_t len = get_frame_len();
+            const bool ready = _write_pos - _parse_pos >= STREAM_HDR_SIZE + len;
+            if (ready and _num_in_use < _mrbs.size()) {
+                const size_t next   = (_oldest + _num_in_use++) % _mrbs.size();
+                const size_t offset = _parse_pos;
+                _parse_pos += STREAM_HDR_SIZE + len;
+                return _mrbs[next]->get_new(_ring, offset, len);
+            }
+
+            const double remaining = std::max(0.0,
+                std::chrono::duration<double>(
+                    exit_time - std::chrono::steady_clock::now())
+                    .count());
+            if (ready or not make_room(STREAM_HDR_SIZE + len)) {
+                // Either all buffers are in use, or the oldest one holds the
+                // room that the frame needs
+                if (not wait_for_oldest(remaining)) {
+                    return managed_recv_buffer::sptr();
+                }
+            } else if (not fill(remaining)) {
+                return managed_recv_buffer::sptr();
+            }
+        }
+    }
+
+private:
+    //! Forget the oldest buffers that were released
+    void reap(void)
+    {
+        while (_num_in_use > 0 and not _mrbs[_oldest]->in_use()) {
+            _oldest = (_oldest + 1) % _mrbs.size();
+            _num_in_use--;
+        }
+        if (_num_in_use == 0 and _parse_pos == _write_pos) {
+            _parse_pos = _write_pos = 0;
+        }
+    }
+
+    //! The length of the next frame, or the largest one if its header is partial
+    size_t get_frame_len(void) const
+    {
+        if (_write_pos - _parse_pos < STREAM_HDR_SIZE) {
+            return _frame_size;
+        }
+        uint32_t len = 0;
+        std::memcpy(&len, _ring + _parse_pos, sizeof(len));
+        len = uhd::ntohx(len);
+        if (len > _frame_size) {
+            throw uhd::io_error(str(
+                boost::format("TCP stream frame of %d bytes exceeds recv_frame_size %d")
+                % len % _frame_size));
+        }
+        return len;
+    }
+
+    //! The offset of the oldest frame that is in use, if it is ahead of the writes
+    size_t get_write_limit(void) const
+    {
+        if (_num_in_use > 0) {
+            const size_t oldest = _mrbs[_oldest]->get_offset();
+            if (oldest >= _write_pos) {
+                return oldest;
+            }
+        }
+        return _ring_size;
+    }
+
+    /*!
+     * Make sure that \p frame_bytes fit behind the current frame's start,
+     * moving it to the start of the ring if necessary.
+     * \return false if the frames that are in use are in the way
+     */
+    bool make_room(const size_t frame_bytes)
+    {
+        if (_parse_pos + frame_bytes <= get_write_limit()) {
+            return true;
+        }
+        if (_num_in_use > 0) {
+            // Frames of the previous lap are ahead, or frames of this lap
+            // are at the start
+            const size_t oldest = _mrbs[_oldest]->get_offset();
+            if (oldest > _parse_pos or oldest < frame_bytes) {
+                return false;
+            }
+        }
+        const size_t partial = _write_pos - _parse_pos;
+        std::memmove(_ring, _ring + _parse_pos, partial);
+        _parse_pos = 0;
+        _write_pos = partial;
+        return true;
+    }
+
+    bool wait_for_oldest(const double timeout)
+    {
+        return _num_in_use > 0
+               and spin_wait_with_timeout(_mrbs[_oldest]->in_use(), false, timeout);
+    }
+
+    //! Read as much as fits into the ring, waiting up to \p timeout for data
+    bool fill(const double timeout)
+    {
+        char* mem        = _ring + _write_pos;
+        const size_t len = get_write_limit() - _write_pos;
+        ssize_t ret      = -1;
+#ifdef MSG_DONTWAIT // try a non-blocking recv() if supported
+        ret = ::recv(_sock_fd, mem, len, MSG_DONTWAIT);
+#endif
+        if (ret <= 0) {
+            if (not wait_for_recv_ready(_sock_fd, timeout)) {
+                return false;
+            }
+            ret = ::recv(_sock_fd, mem, len, 0);
+        }
+        if (ret <= 0) {
+            return false; // closed or failed, look like a timeout
+        }
+        _write_pos += size_t(ret);
+        return true;
+    }
+
+    const int _sock_fd;
+    const size_t _frame_size, _max_frame_bytes, _ring_size;
+    buffer_pool::sptr _ring_pool;
+    char* _ring;
+    //! The next frame starts at _parse_pos, the next read goes to _write_pos
+    size_t _parse_pos, _write_pos;
+    std::vector<boost::shared_ptr<tcp_zero_copy_stream_mrb>> _mrbs;
+    //! The buffers from _oldest on are in use, in the order of the ring
+    size_t _oldest, _num_in_use;
+};
+
+class tcp_zero_copy_stream_msb;
+
+/***********************************************************************
+ * Stream mode sender:
+ *  - collects committed send buffers and writes them with a single call
+ *    once the batch is full, the oldest queued buffer has been waiting
+ *    longer than the timeout, or on an explicit flush
+ **********************************************************************/
+class tcp_stream_sender
+{
+public:
+    tcp_stream_sender(int sock_fd, const size_t batch_size, const double timeout)
+        : _sock_fd(sock_fd)
+        , _batch_size(batch_size)
+        , _timeout(std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+              std::chrono::duration<double>(timeout)))
+    {
+        _queue.reserve(batch_size);
+    }
+
+    //! Queue a committed buffer, and send the batch if required
+    void push(tcp_zero_copy_stream_msb* msb);
+
+    //! Send all queued buffers if the oldest one has waited too long
+    void flush_if_stale(void)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (not _queue.empty()
+            and std::chrono::steady_clock::now() - _first_queued > _timeout) {
+            _flush();
+        }
+    }
+
+    //! Send all queued buffers
+    void flush(void)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _flush();
+    }
+
+private:
+    void _flush(void);
+    void _send(const char* mem, size_t len);
+
+    const int _sock_fd;
+    const size_t _batch_size;
+    const std::chrono::steady_clock::duration _timeout;
+    std::mutex _mutex;
+    std::vector<tcp_zero_copy_stream_msb*> _queue;
+    std::chrono::steady_clock::time_point _first_queued;
+};
+
+/***********************************************************************
+ * Stream mode send buffer:
+ *  - commit writes the length in front of the data and queues the frame
+ *    in the sender
+ **********************************************************************/
+class tcp_zero_copy_stream_msb : public managed_send_buffer
+{
+public:
+    tcp_zero_copy_stream_msb(
+        void* mem, const size_t frame_size, tcp_stream_sender* sender)
+        : _mem(static_cast<char*>(mem) + STREAM_HEADROOM)
+        , _frame_size(frame_size)
+        , _sender(sender)
+        , _queued(false)
+    { /*NOP*/
+    }
+
+    void release(void)
+    {
+        const uint32_t len = uhd::htonx(uint32_t(size()));
+        std::memcpy(_mem - STREAM_HDR_SIZE, &len, sizeof(len));
+        _queued = true;
+        _sender->push(this);
+    }
+
+    UHD_INLINE sptr get_new(const double timeout, size_t& index)
+    {
+        if (not _claimer.claim_with_wait(timeout))
+            return sptr();
+        index++; // advances the caller's buffer
+        return make(this, _mem, _frame_size);
+    }
+
+    //! The header and the data
+    const char* get_frame(void) const
+    {
+        return _mem - STREAM_HDR_SIZE;
+    }
+
+    size_t get_frame_len(void) const
+    {
+        return STREAM_HDR_SIZE + size();
+    }
+
+    //! True while this buffer is committed but not yet sent by the sender
+    bool is_queued(void) const
+    {
+        return _queued;
+    }
+
+    void sent(void)
+    {
+        _queued = false;
+        _claimer.release();
+    }
+
+private:
+    char* _mem;
+    size_t _frame_size;
+    tcp_stream_sender* _sender;
+    std::atomic<bool> _queued;
+    simple_claimer _claimer;
+};
+
+void tcp_stream_sender::push(tcp_zero_copy_stream_msb* msb)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_queue.empty()) {
+        _first_queued = std::chrono::steady_clock::now();
+    }
+    _queue.push_back(msb);
+    if (_queue.size() >= _batch_size
+        or std::chrono::steady_clock::now() - _first_queued > _timeout) {
+        _flush();
+    }
+}
+
+void tcp_stream_sender::_flush(void)
+{
+    try {
+#ifdef UHD_PLATFORM_WIN32
+        for (tcp_zero_copy_stream_msb* msb : _queue) {
+            _send(msb->get_frame(), msb->get_frame_len());
+        }
+#else
+        std::vector<iovec> iovs(_queue.size());
+        for (size_t i = 0; i < _queue.size(); i++) {
+            iovs[i].iov_base = const_cast<char*>(_queue[i]->get_frame());
+            iovs[i].iov_len  = _queue[i]->get_frame_len();
+        }
+        size_t first = 0;
+        while (first < iovs.size()) {
+            msghdr msg;
+            std::memset(&msg, 0, sizeof(msg));
+            msg.msg_iov       = &iovs[first];
+            msg.msg_iovlen    = iovs.size() - first;
+            const ssize_t ret = ::sendmsg(_sock_fd, &msg, 0);
+            if (ret == -1 and (errno == ENOBUFS or errno == EINTR)) {
+                // Same retry logic as tcp_zero_copy_asio_msb::release()
+                std::this_thread::sleep_for(std::chrono::microseconds(1));
+                continue;
+            }
+            if (ret == -1) {
+                throw uhd::io_error(str(
+                    boost::format("TCP send error on socket: %s") % strerror(errno)));
+            }
+            // Skip what was written, which may end within a frame
+            size_t written = size_t(ret);
+            while (first < iovs.size() and written >= iovs[first].iov_len) {
+                written -= iovs[first++].iov_len;
+            }
+            if (written > 0) {
+                iovs[first].iov_base = static_cast<char*>(iovs[first].iov_base) + written;
+                iovs[first].iov_len -= written;
+            }
+        }
+#endif
+    } catch (...) {
+        for (tcp_zero_copy_stream_msb* msb : _queue) {
+            msb->sent();
+        }
+        _queue.clear();
+        throw;
+    }
+
+    for (tcp_zero_copy_stream_msb* msb : _queue) {
+        msb->sent();
+    }
+    _queue.clear();
+}
+
+void tcp_stream_sender::_send(const char* mem, size_t len)
+{
+    while (len > 0) {
+        const int ret = ::send(_sock_fd, mem, int(len), 0);
+        if (ret == -1 and errno == ENOBUFS) {
+            std::this_thread::sleep_for(std::chrono::microseconds(1));
+            continue;
+        }
+        if (ret <= 0) {
+            throw uhd::io_error("TCP send error on socket");
+        }
+        mem += ret;
+        len -= size_t(ret);
+    }
+}
+
 tcp_zero_copy::~tcp_zero_copy(void)
 {
     /* NOP */
@@ -144,8 +571,7 @@ public:
               size_t(hints.cast<double>("send_frame_size", DEFAULT_FRAME_SIZE)))
         , _num_send_frames(
               size_t(hints.cast<double>("num_send_frames", DEFAULT_NUM_FRAMES)))
-        , _recv_buffer_pool(buffer_pool::make(_num_recv_frames, _recv_frame_size))
-        , _send_buffer_pool(buffer_pool::make(_num_send_frames, _send_frame_size))
+        , _stream_mode(hints.has_key("stream_mode"))
         , _next_recv_buff_index(0)
         , _next_send_buff_index(0)
     {
@@ -166,25 +592,85 @@ public:
         asio::ip::tcp::no_delay option(true);
         _socket->set_option(option);
 
+        // resize the socket buffers, otherwise the OS tunes them
+        if (hints.has_key("recv_buff_size")) {
+            _socket->set_option(asio::socket_base::receive_buffer_size(
+                int(hints.cast<double>("recv_buff_size", 0.0))));
+        }
+        if (hints.has_key("send_buff_size")) {
+            _socket->set_option(asio::socket_base::send_buffer_size(
+                int(hints.cast<double>("send_buff_size", 0.0))));
+        }
+
+        const buffer_pool::mem_params_t mem_params = buffer_pool::get_mem_params(hints);
+        if (_stream_mode) {
+            UHD_LOGGER_TRACE("TCP") << "Using stream mode";
+            _stream_receiver.reset(new tcp_stream_receiver(
+                _sock_fd, get_num_recv_frames(), get_recv_frame_size(), mem_params));
+            const size_t batch_size = std::min(
+                size_t(hints.cast<double>(
+                    "send_batch_size", double(DEFAULT_STREAM_SEND_BATCH_SIZE))),
+                get_num_send_frames());
+            _stream_sender.reset(new tcp_stream_sender(_sock_fd,
+                std::max<size_t>(batch_size, 1),
+                hints.cast<double>(
+                    "send_batch_timeout", DEFAULT_STREAM_SEND_BATCH_TIMEOUT)));
+
+            // allocate re-usable managed send buffers, with room for the header
+            _send_buffer_pool = buffer_pool::make(get_num_send_frames(),
+                STREAM_HEADROOM + get_send_frame_size(),
+                DEFAULT_BUFF_ALIGNMENT,
+                mem_params);
+            for (size_t i = 0; i < get_num_send_frames(); i++) {
+                _stream_msb_pool.push_back(
+                    boost::make_shared<tcp_zero_copy_stream_msb>(_send_buffer_pool->at(i),
+                        get_send_frame_size(),
+                        _stream_sender.get()));
+            }
+            return;
+        }
+
         // allocate re-usable managed receive buffers
+        _recv_buffer_pool = buffer_pool::make(get_num_recv_frames(),
+            get_recv_frame_size(),
+            DEFAULT_BUFF_ALIGNMENT,
+            mem_params);
         for (size_t i = 0; i < get_num_recv_frames(); i++) {
             _mrb_pool.push_back(boost::make_shared<tcp_zero_copy_asio_mrb>(
                 _recv_buffer_pool->at(i), _sock_fd, get_recv_frame_size()));
         }
 
         // allocate re-usable managed send buffers
+        _send_buffer_pool = buffer_pool::make(get_num_send_frames(),
+            get_send_frame_size(),
+            DEFAULT_BUFF_ALIGNMENT,
+            mem_params);
         for (size_t i = 0; i < get_num_send_frames(); i++) {
             _msb_pool.push_back(boost::make_shared<tcp_zero_copy_asio_msb>(
                 _send_buffer_pool->at(i), _sock_fd, get_send_frame_size()));
         }
     }
 
+    ~tcp_zero_copy_asio_impl(void)
+    {
+        if (_stream_sender) {
+            try {
+                _stream_sender->flush();
+            } catch (const std::exception& ex) {
+                UHD_LOGGER_ERROR("TCP")
+                    << "Error flushing send buffers on destruction: " << ex.what();
+            }
+        }
+    }
+
     /*******************************************************************
      * Receive implementation:
      * Block on the managed buffer's get call and advance the index.
      ******************************************************************/
     managed_recv_buffer::sptr get_recv_buff(double timeout)
     {
+        if (_stream_receiver)
+            return _stream_receiver->get_new(timeout);
         if (_next_recv_buff_index == _num_recv_frames)
             _next_recv_buff_index = 0;
         return _mrb_pool[_next_recv_buff_index]->get_new(timeout, _next_recv_buff_index);
@@ -207,9 +693,26 @@ public:
     {
         if (_next_send_buff_index == _num_send_frames)
             _next_send_buff_index = 0;
+        if (_stream_sender) {
+            // Don't wait for a buffer that is only held back by the sender
+            if (_stream_msb_pool[_next_send_buff_index]->is_queued()) {
+                _stream_sender->flush();
+            } else {
+                _stream_sender->flush_if_stale();
+            }
+            return _stream_msb_pool[_next_send_buff_index]->get_new(
+                timeout, _next_send_buff_index);
+        }
         return _msb_pool[_next_send_buff_index]->get_new(timeout, _next_send_buff_index);
     }
 
+    void flush_send_buffs(void)
+    {
+        if (_stream_sender) {
+            _stream_sender->flush();
+        }
+    }
+
     size_t get_num_send_frames(void) const
     {
         return _num_send_frames;
@@ -223,11 +726,17 @@ private:
     // memory management -> buffers and fifos
     const size_t _recv_frame_size, _num_recv_frames;
     const size_t _send_frame_size, _num_send_frames;
+    const bool _stream_mode;
     buffer_pool::sptr _recv_buffer_pool, _send_buffer_pool;
     std::vector<boost::shared_ptr<tcp_zero_copy_asio_msb>> _msb_pool;
     std::vector<boost::shared_ptr<tcp_zero_copy_asio_mrb>> _mrb_pool;
     size_t _next_recv_buff_index, _next_send_buff_index;
 
+    // stream mode -> ring for receive, batches for send
+    std::unique_ptr<tcp_stream_receiver> _stream_receiver;
+    std::unique_ptr<tcp_stream_sender> _stream_sender;
+    std::vector<boost::shared_ptr<tcp_zero_copy_stream_msb>> _stream_msb_pool;
+
     // asio guts -> socket and service
     asio::io_service _io_service;
     boost::shared_ptr<asio::ip::tcp::socket> _socket;
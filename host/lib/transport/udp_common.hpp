@@ -9,7 +9,10 @@
 #define INCLUDED_LIBUHD_TRANSPORT_VRT_PACKET_HANDLER_HPP
 
 #include <uhd/config.hpp>
+#include <uhdlib/utils/deadline.hpp>
 #include <boost/asio.hpp>
+#include <cerrno>
+#include <climits>
 
 namespace uhd { namespace transport {
 
@@ -54,15 +57,22 @@ UHD_INLINE bool wait_for_recv_ready(int sock_fd, double timeout)
     // call select with timeout on receive socket
     return TEMP_FAILURE_RETRY(::select(sock_fd + 1, &rset, NULL, NULL, &tv)) > 0;
 #else
-    // calculate the total timeout in milliseconds (from seconds)
-    int total_timeout = int(timeout * 1000);
+    const deadline_t deadline(timeout);
 
     pollfd pfd_read;
     pfd_read.fd     = sock_fd;
     pfd_read.events = POLLIN;
 
-    // call poll with timeout on receive socket
-    return ::poll(&pfd_read, 1, total_timeout) > 0;
+    // call poll with timeout on receive socket. A signal doesn't end the
+    // wait early, it continues for the time that remains.
+    while (true) {
+        const int total_timeout =
+            int(std::min(deadline.remaining() * 1000, double(INT_MAX)));
+        const int ret = ::poll(&pfd_read, 1, total_timeout);
+        if (ret >= 0 or errno != EINTR) {
+            return ret > 0;
+        }
+    }
 #endif
 }
 
@@ -10,12 +10,30 @@
 #include <uhd/transport/udp_simple.hpp> //mtu
 #include <uhd/transport/udp_zero_copy.hpp>
 #include <uhd/utils/log.hpp>
+#include <uhdlib/transport/shared_frame_pool.hpp>
 #include <uhdlib/utils/atomic.hpp>
 #include <boost/format.hpp>
 #include <boost/make_shared.hpp>
 #include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
 #include <thread>
 #include <vector>
+#if defined(HAVE_RECVMMSG) || defined(HAVE_SENDMMSG)
+#    include <sys/socket.h>
+#endif
+#ifdef HAVE_LIBURING
+#    include <liburing.h>
+#endif
+#if defined(HAVE_RECVMMSG) && defined(UHD_PLATFORM_LINUX)
+#    include <linux/net_tstamp.h>
+#    include <time.h>
+#    ifdef SO_TIMESTAMPING
+#        define HAVE_SO_TIMESTAMPING
+#    endif
+#endif
 
 using namespace uhd;
 using namespace uhd::transport;
@@ -25,6 +43,84 @@ constexpr size_t UDP_ZERO_COPY_DEFAULT_FRAME_SIZE =
     1472; // Based on common 1500 byte MTU for 1GbE.
 constexpr size_t UDP_ZERO_COPY_DEFAULT_BUFF_SIZE =
     2500000; // 20ms of data for 1GbE link (in bytes)
+constexpr size_t UDP_ZERO_COPY_DEFAULT_RECV_BATCH_SIZE = 1; // No batching
+constexpr size_t UDP_ZERO_COPY_DEFAULT_SEND_BATCH_SIZE = 1; // No batching
+constexpr double UDP_ZERO_COPY_DEFAULT_SEND_BATCH_TIMEOUT = 0.001; // 1 ms
+constexpr size_t UDP_ZERO_COPY_BUFF_ALIGNMENT = 16;
+
+//! Options that select the receive and send implementation
+struct udp_zero_copy_opts
+{
+    size_t recv_batch_size    = UDP_ZERO_COPY_DEFAULT_RECV_BATCH_SIZE;
+    size_t send_batch_size    = UDP_ZERO_COPY_DEFAULT_SEND_BATCH_SIZE;
+    double send_batch_timeout = UDP_ZERO_COPY_DEFAULT_SEND_BATCH_TIMEOUT;
+    bool use_io_uring         = false;
+    //! Arrival time stamps to capture: "", "sw" (kernel) or "hw" (NIC)
+    std::string rx_timestamps;
+    //! Time in seconds to spin on non-blocking receives before sleeping
+    double recv_busy_poll = 0.0;
+    buffer_pool::mem_params_t mem_params;
+    //! Draw the frames from the process-wide shared_frame_pool
+    bool shared_frames = false;
+    //! The most frames the shared pool may allocate (0: no limit)
+    size_t max_shared_frames = 0;
+    //! Count the references to the buffers without atomics
+    bool single_threaded_buffers = false;
+};
+
+/*!
+ * Call \p try_recv, a non-blocking receive, until it returns something other
+ * than EAGAIN, or for at most \p busy_poll seconds (but no longer than
+ * \p timeout). The time spent spinning is taken off \p timeout, which is
+ * left for the blocking wait.
+ * \return the return value of the last call to \p try_recv
+ */
+template <typename recv_fn_t>
+UHD_INLINE ssize_t busy_poll_recv(
+    const recv_fn_t& try_recv, const double busy_poll, double& timeout)
+{
+    ssize_t ret = try_recv();
+    if (ret >= 0 or (errno != EAGAIN and errno != EWOULDBLOCK) or busy_poll <= 0.0) {
+        return ret;
+    }
+    const double spin = std::min(busy_poll, timeout);
+    const auto end    = std::chrono::steady_clock::now()
+                     + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                         std::chrono::duration<double>(spin));
+    do {
+        ret = try_recv();
+    } while (ret < 0 and (errno == EAGAIN or errno == EWOULDBLOCK)
+             and std::chrono::steady_clock::now() < end);
+    timeout -= spin;
+    return ret;
+}
+
+#ifdef HAVE_SO_TIMESTAMPING
+//! Room for the SCM_TIMESTAMPING control message of one datagram
+constexpr size_t UDP_ZERO_COPY_TIMESTAMP_CMSG_SIZE = 128;
+
+/*!
+ * Get the arrival time of a datagram from its SCM_TIMESTAMPING control
+ * message: the raw hardware time stamp if the NIC took one, the kernel's
+ * software time stamp otherwise.
+ * \return nanoseconds since the epoch, or 0 if there is none
+ */
+static uint64_t get_rx_timestamp(msghdr& msg)
+{
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr;
+         cmsg          = CMSG_NXTHDR(&msg, cmsg)) {
+        if (cmsg->cmsg_level != SOL_SOCKET or cmsg->cmsg_type != SCM_TIMESTAMPING) {
+            continue;
+        }
+        // Software, deprecated, and raw hardware time stamp
+        timespec ts[3];
+        std::memcpy(ts, CMSG_DATA(cmsg), sizeof(ts));
+        const timespec& t = (ts[2].tv_sec != 0 or ts[2].tv_nsec != 0) ? ts[2] : ts[0];
+        return uint64_t(t.tv_sec) * 1000000000 + uint64_t(t.tv_nsec);
+    }
+    return 0;
+}
+#endif /* HAVE_SO_TIMESTAMPING */
 /***********************************************************************
  * Check registry for correct fast-path setting (windows only)
  **********************************************************************/
@@ -65,23 +161,39 @@ static void check_registry_for_fast_send_threshold(const size_t mtu)
 class udp_zero_copy_asio_mrb : public managed_recv_buffer
 {
 public:
-    udp_zero_copy_asio_mrb(void* mem, int sock_fd, const size_t frame_size)
-        : _mem(mem), _sock_fd(sock_fd), _frame_size(frame_size), _len(0)
+    udp_zero_copy_asio_mrb(void* mem,
+        int sock_fd,
+        const size_t frame_size,
+        const double busy_poll     = 0.0,
+        shared_frame_pool* shared = nullptr)
+        : _mem(mem)
+        , _sock_fd(sock_fd)
+        , _frame_size(frame_size)
+        , _busy_poll(busy_poll)
+        , _len(0)
+        , _shared(shared)
     { /*NOP*/
     }
 
     void release(void)
     {
+        if (_shared) {
+            _shared->release(_mem);
+            _mem = nullptr;
+        }
         _claimer.release();
     }
 
-    UHD_INLINE sptr get_new(const double timeout, size_t& index)
+    UHD_INLINE sptr get_new(double timeout, size_t& index)
     {
-        if (not _claimer.claim_with_wait(timeout))
+        if (not claim(timeout))
             return sptr();
 
 #ifdef MSG_DONTWAIT // try a non-blocking recv() if supported
-        _len = ::recv(_sock_fd, (char*)_mem, _frame_size, MSG_DONTWAIT);
+        _len = busy_poll_recv(
+            [this]() { return ::recv(_sock_fd, (char*)_mem, _frame_size, MSG_DONTWAIT); },
+            _busy_poll,
+            timeout);
         if (_len > 0) {
             index++; // advances the caller's buffer
             return make(this, _mem, size_t(_len));
@@ -99,32 +211,180 @@ public:
             return make(this, _mem, size_t(_len));
         }
 
-        _claimer.release(); // undo claim
+        release(); // undo claim
         return sptr(); // null for timeout
     }
 
+    /*!
+     * Claim this buffer without performing a receive operation. Used by the
+     * batched receive path, which fills several buffers with one syscall.
+     * With a shared pool, this also takes the frame to receive into.
+     */
+    UHD_INLINE bool claim(const double timeout)
+    {
+        if (not _claimer.claim_with_wait(timeout))
+            return false;
+        if (_shared) {
+            _mem = _shared->acquire(timeout);
+            if (not _mem) {
+                _claimer.release();
+                return false;
+            }
+        }
+        return true;
+    }
+
+    //! Hand out a buffer that was claimed and filled by the batched path
+    UHD_INLINE sptr get_filled(const size_t len)
+    {
+        return make(this, _mem, len);
+    }
+
+    UHD_INLINE void* get_mem(void) const
+    {
+        return _mem;
+    }
+
 private:
     void* _mem;
     int _sock_fd;
     size_t _frame_size;
+    double _busy_poll;
     ssize_t _len;
+    shared_frame_pool* _shared;
     simple_claimer _claimer;
 };
 
+class udp_zero_copy_asio_msb;
+
+#ifdef HAVE_SENDMMSG
+/***********************************************************************
+ * Send batcher:
+ *  - collects released send buffers and pushes them out with a single
+ *    sendmmsg() call once the batch is full, the oldest queued buffer
+ *    has been waiting longer than the timeout, or on an explicit flush
+ *  - a timer thread sends a batch that is left waiting when the stream
+ *    pauses, so no packet is held back longer than the timeout
+ **********************************************************************/
+class udp_send_batcher
+{
+public:
+    udp_send_batcher(int sock_fd, const size_t batch_size, const double timeout)
+        : _sock_fd(sock_fd)
+        , _batch_size(batch_size)
+        , _timeout(std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+              std::chrono::duration<double>(timeout)))
+        , _msgs(batch_size)
+        , _iovs(batch_size)
+        , _stop(false)
+    {
+        _queue.reserve(batch_size);
+        _timer = std::thread([this]() { run_timer(); });
+    }
+
+    ~udp_send_batcher(void)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _timer_cond.notify_one();
+        _timer.join();
+    }
+
+    //! Queue a committed buffer, and send the batch if required
+    void push(udp_zero_copy_asio_msb* msb);
+
+    //! Send all queued buffers if the oldest one has waited too long
+    void flush_if_stale(void)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (not _queue.empty()
+            and std::chrono::steady_clock::now() - _first_queued > _timeout) {
+            _flush();
+        }
+    }
+
+    //! Send all queued buffers
+    void flush(void)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _flush();
+    }
+
+private:
+    void _flush(void);
+
+    //! Flush whatever has waited for the timeout, until the batcher is destroyed
+    void run_timer(void)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (not _stop) {
+            if (_queue.empty()) {
+                _timer_cond.wait(lock);
+                continue;
+            }
+            const auto exit_time = _first_queued + _timeout;
+            if (_timer_cond.wait_until(lock, exit_time) == std::cv_status::timeout
+                and not _queue.empty()
+                and std::chrono::steady_clock::now() >= _first_queued + _timeout) {
+                try {
+                    _flush();
+                } catch (const uhd::io_error& ex) {
+                    UHD_LOGGER_ERROR("UDP")
+                        << "Error sending a timed out send batch: " << ex.what();
+                }
+            }
+        }
+    }
+
+    const int _sock_fd;
+    const size_t _batch_size;
+    const std::chrono::steady_clock::duration _timeout;
+    std::chrono::steady_clock::time_point _first_queued;
+    std::vector<udp_zero_copy_asio_msb*> _queue;
+    std::vector<mmsghdr> _msgs;
+    std::vector<iovec> _iovs;
+    std::mutex _mutex;
+    std::condition_variable _timer_cond;
+    bool _stop;
+    std::thread _timer;
+};
+#else
+// Placeholder so the send buffers can carry a batcher pointer everywhere
+class udp_send_batcher;
+#endif /* HAVE_SENDMMSG */
+
 /***********************************************************************
  * Reusable managed send buffer:
  *  - commit performs the send operation
+ *  - when batching, commit queues the buffer in the batcher instead
  **********************************************************************/
 class udp_zero_copy_asio_msb : public managed_send_buffer
 {
 public:
-    udp_zero_copy_asio_msb(void* mem, int sock_fd, const size_t frame_size)
-        : _mem(mem), _sock_fd(sock_fd), _frame_size(frame_size)
+    udp_zero_copy_asio_msb(void* mem,
+        int sock_fd,
+        const size_t frame_size,
+        udp_send_batcher* batcher  = nullptr,
+        shared_frame_pool* shared = nullptr)
+        : _mem(mem)
+        , _sock_fd(sock_fd)
+        , _frame_size(frame_size)
+        , _batcher(batcher)
+        , _queued(false)
+        , _shared(shared)
     { /*NOP*/
     }
 
     void release(void)
     {
+#ifdef HAVE_SENDMMSG
+        if (_batcher) {
+            _batcher->push(this);
+            return;
+        }
+#endif
         // Retry logic because send may fail with ENOBUFS.
         // This is known to occur at least on some OSX systems.
         // But it should be safe to always check for the error.
@@ -142,24 +402,276 @@ public:
             }
             UHD_ASSERT_THROW(ret == ssize_t(size()));
         }
-        _claimer.release();
+        release_claim();
     }
 
     UHD_INLINE sptr get_new(const double timeout, size_t& index)
     {
         if (not _claimer.claim_with_wait(timeout))
             return sptr();
+        if (_shared) {
+            _mem = _shared->acquire(timeout);
+            if (not _mem) {
+                _claimer.release();
+                return sptr();
+            }
+        }
         index++; // advances the caller's buffer
         return make(this, _mem, _frame_size);
     }
 
+    UHD_INLINE void* get_mem(void) const
+    {
+        return _mem;
+    }
+
+    //! True while this buffer is committed but not yet sent by the batcher
+    UHD_INLINE bool is_queued(void) const
+    {
+        return _queued;
+    }
+
+    UHD_INLINE void set_queued(const bool queued)
+    {
+        _queued = queued;
+    }
+
+    //! Called once the buffer contents are on the wire
+    UHD_INLINE void release_claim(void)
+    {
+        if (_shared) {
+            _shared->release(_mem);
+            _mem = nullptr;
+        }
+        _queued = false;
+        _claimer.release();
+    }
+
 private:
     void* _mem;
     int _sock_fd;
     size_t _frame_size;
+    udp_send_batcher* _batcher;
+    std::atomic<bool> _queued;
+    shared_frame_pool* _shared;
     simple_claimer _claimer;
 };
 
+#ifdef HAVE_SENDMMSG
+void udp_send_batcher::push(udp_zero_copy_asio_msb* msb)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_queue.empty()) {
+        _first_queued = std::chrono::steady_clock::now();
+        _timer_cond.notify_one();
+    }
+    msb->set_queued(true);
+    _queue.push_back(msb);
+    if (_queue.size() >= _batch_size
+        or std::chrono::steady_clock::now() - _first_queued > _timeout) {
+        _flush();
+    }
+}
+
+void udp_send_batcher::_flush(void)
+{
+    const size_t num_msgs = _queue.size();
+    for (size_t i = 0; i < num_msgs; i++) {
+        _iovs[i].iov_base = _queue[i]->get_mem();
+        _iovs[i].iov_len  = _queue[i]->size();
+        std::memset(&_msgs[i], 0, sizeof(mmsghdr));
+        _msgs[i].msg_hdr.msg_iov    = &_iovs[i];
+        _msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    size_t num_sent = 0;
+    while (num_sent < num_msgs) {
+        const int ret =
+            ::sendmmsg(_sock_fd, &_msgs[num_sent], num_msgs - num_sent, 0);
+        if (ret == -1 and errno == ENOBUFS) {
+            // Same retry logic as the non-batched path, see
+            // udp_zero_copy_asio_msb::release()
+            std::this_thread::sleep_for(std::chrono::microseconds(1));
+            continue;
+        }
+        if (ret == -1) {
+            const int err = errno;
+            for (udp_zero_copy_asio_msb* msb : _queue) {
+                msb->release_claim();
+            }
+            _queue.clear();
+            throw uhd::io_error(
+                str(boost::format("sendmmsg error on socket: %s") % strerror(err)));
+        }
+        num_sent += size_t(ret);
+    }
+
+    for (udp_zero_copy_asio_msb* msb : _queue) {
+        msb->release_claim();
+    }
+    _queue.clear();
+}
+#endif /* HAVE_SENDMMSG */
+
+#ifdef HAVE_LIBURING
+class udp_uring_receiver;
+
+/***********************************************************************
+ * Managed receive buffer for the io_uring receiver:
+ *  - release re-arms the read on the buffer
+ **********************************************************************/
+class udp_zero_copy_uring_mrb : public managed_recv_buffer
+{
+public:
+    udp_zero_copy_uring_mrb(udp_uring_receiver* rx, const size_t index, void* mem)
+        : _rx(rx), _index(index), _mem(mem)
+    { /*NOP*/
+    }
+
+    void release(void);
+
+    UHD_INLINE sptr get_filled(const size_t len)
+    {
+        return make(this, _mem, len);
+    }
+
+    UHD_INLINE void* get_mem(void) const
+    {
+        return _mem;
+    }
+
+private:
+    udp_uring_receiver* _rx;
+    const size_t _index;
+    void* _mem;
+};
+
+/***********************************************************************
+ * io_uring receiver:
+ *  - registers all receive buffers with the ring as fixed buffers
+ *  - keeps one read in flight per buffer that is not handed out
+ *  - completions are handed out as managed receive buffers
+ **********************************************************************/
+class udp_uring_receiver
+{
+public:
+    udp_uring_receiver(int sock_fd,
+        buffer_pool::sptr pool,
+        const size_t frame_size,
+        const double busy_poll)
+        : _sock_fd(sock_fd), _frame_size(frame_size), _busy_poll(busy_poll)
+    {
+        const size_t num_frames = pool->size();
+        int ret = io_uring_queue_init(unsigned(num_frames), &_ring, 0);
+        if (ret < 0) {
+            throw uhd::os_error(str(
+                boost::format("Could not create io_uring: %s") % strerror(-ret)));
+        }
+
+        std::vector<iovec> iovs(num_frames);
+        for (size_t i = 0; i < num_frames; i++) {
+            iovs[i].iov_base = pool->at(i);
+            iovs[i].iov_len  = frame_size;
+            _mrbs.push_back(
+                boost::make_shared<udp_zero_copy_uring_mrb>(this, i, pool->at(i)));
+        }
+        ret = io_uring_register_buffers(&_ring, iovs.data(), unsigned(num_frames));
+        if (ret < 0) {
+            io_uring_queue_exit(&_ring);
+            throw uhd::os_error(str(boost::format("Could not register buffers with "
+                                                  "io_uring: %s")
+                                    % strerror(-ret)));
+        }
+
+        for (size_t i = 0; i < num_frames; i++) {
+            submit(i);
+        }
+    }
+
+    ~udp_uring_receiver(void)
+    {
+        io_uring_queue_exit(&_ring);
+    }
+
+    managed_recv_buffer::sptr get_recv_buff(double timeout)
+    {
+        struct io_uring_cqe* cqe = nullptr;
+        int ret                  = 0;
+        // Peeking doesn't enter the kernel, so spinning on it is cheap
+        busy_poll_recv(
+            [this, &cqe, &ret]() {
+                ret   = io_uring_peek_cqe(&_ring, &cqe);
+                errno = -ret;
+                return ret < 0 ? ssize_t(-1) : ssize_t(0);
+            },
+            _busy_poll,
+            timeout);
+        if (ret == -EAGAIN) {
+            struct __kernel_timespec ts;
+            ts.tv_sec  = int64_t(timeout);
+            ts.tv_nsec = int64_t((timeout - double(ts.tv_sec)) * 1e9);
+            ret        = io_uring_wait_cqe_timeout(&_ring, &cqe, &ts);
+        }
+        if (ret == -ETIME or ret == -EAGAIN or ret == -EINTR) {
+            return managed_recv_buffer::sptr(); // null for timeout
+        }
+        if (ret < 0) {
+            throw uhd::io_error(
+                str(boost::format("io_uring wait error: %s") % strerror(-ret)));
+        }
+
+        const size_t index = size_t(io_uring_cqe_get_data(cqe));
+        const int res      = cqe->res;
+        io_uring_cqe_seen(&_ring, cqe);
+
+        if (res > 0) {
+            return _mrbs[index]->get_filled(size_t(res));
+        }
+        // Nothing is handed out, so re-arm the read on the buffer, or it is
+        // lost to the ring for good
+        submit(index);
+        if (res == -EAGAIN or res == -EINTR) {
+            return managed_recv_buffer::sptr();
+        }
+        if (res == 0) {
+            throw uhd::io_error("socket closed");
+        }
+        throw uhd::io_error(
+            str(boost::format("recv error on socket: %s") % strerror(-res)));
+    }
+
+    //! Arm a fixed-buffer read into buffer \p index
+    void submit(const size_t index)
+    {
+        std::lock_guard<std::mutex> lock(_sq_mutex);
+        struct io_uring_sqe* sqe = io_uring_get_sqe(&_ring);
+        // The SQ has one entry per buffer, so it can't run out
+        UHD_ASSERT_THROW(sqe != nullptr);
+        io_uring_prep_read_fixed(sqe,
+            _sock_fd,
+            _mrbs[index]->get_mem(),
+            unsigned(_frame_size),
+            0,
+            int(index));
+        io_uring_sqe_set_data(sqe, reinterpret_cast<void*>(index));
+        io_uring_submit(&_ring);
+    }
+
+private:
+    const int _sock_fd;
+    const size_t _frame_size;
+    const double _busy_poll;
+    struct io_uring _ring;
+    std::mutex _sq_mutex;
+    std::vector<boost::shared_ptr<udp_zero_copy_uring_mrb>> _mrbs;
+};
+
+void udp_zero_copy_uring_mrb::release(void)
+{
+    _rx->submit(_index);
+}
+#endif /* HAVE_LIBURING */
+
 /***********************************************************************
  * Zero Copy UDP implementation with ASIO:
  *   This is the portable zero copy implementation for systems
@@ -174,17 +686,19 @@ public:
 
     udp_zero_copy_asio_impl(const std::string& addr,
         const std::string& port,
-        const zero_copy_xport_params& xport_params)
+        const zero_copy_xport_params& xport_params,
+        const udp_zero_copy_opts& opts = udp_zero_copy_opts())
         : _recv_frame_size(xport_params.recv_frame_size)
         , _num_recv_frames(xport_params.num_recv_frames)
         , _send_frame_size(xport_params.send_frame_size)
         , _num_send_frames(xport_params.num_send_frames)
-        , _recv_buffer_pool(buffer_pool::make(
-              xport_params.num_recv_frames, xport_params.recv_frame_size))
-        , _send_buffer_pool(buffer_pool::make(
-              xport_params.num_send_frames, xport_params.send_frame_size))
         , _next_recv_buff_index(0)
         , _next_send_buff_index(0)
+        , _recv_batch_size(std::min(opts.recv_batch_size, _num_recv_frames))
+        , _num_batch_ready(0)
+        , _recv_closed(false)
+        , _rx_timestamps(false)
+        , _busy_poll(opts.recv_busy_poll)
     {
         UHD_LOGGER_TRACE("UDP")
             << boost::format("Creating UDP transport to %s:%s") % addr % port;
@@ -207,19 +721,141 @@ public:
         UHD_LOGGER_TRACE("UDP") << boost::format("Local UDP socket endpoint: %s:%s")
                                        % get_local_addr() % get_local_port();
 
+        // io_uring reads into buffers that are registered up front, so it
+        // can't draw its frames from the shared pool
+        bool share_recv_frames = opts.shared_frames;
+#ifdef HAVE_LIBURING
+        if (opts.shared_frames and opts.use_io_uring) {
+            UHD_LOGGER_WARNING("UDP")
+                << "shared_frames is not supported for receiving with use_io_uring. "
+                   "Ignoring it for receive.";
+            share_recv_frames = false;
+        }
+#endif
+        if (share_recv_frames) {
+            _recv_shared_pool = shared_frame_pool::get(
+                get_recv_frame_size(), opts.max_shared_frames, opts.mem_params);
+        } else {
+            _recv_buffer_pool = buffer_pool::make(get_num_recv_frames(),
+                get_recv_frame_size(),
+                UDP_ZERO_COPY_BUFF_ALIGNMENT,
+                opts.mem_params);
+        }
+        if (opts.shared_frames) {
+            _send_shared_pool = shared_frame_pool::get(
+                get_send_frame_size(), opts.max_shared_frames, opts.mem_params);
+        } else {
+            _send_buffer_pool = buffer_pool::make(get_num_send_frames(),
+                get_send_frame_size(),
+                UDP_ZERO_COPY_BUFF_ALIGNMENT,
+                opts.mem_params);
+        }
+
         // allocate re-usable managed receive buffers
         for (size_t i = 0; i < get_num_recv_frames(); i++) {
             _mrb_pool.push_back(boost::make_shared<udp_zero_copy_asio_mrb>(
-                _recv_buffer_pool->at(i), _sock_fd, get_recv_frame_size()));
+                _recv_shared_pool ? nullptr : _recv_buffer_pool->at(i),
+                _sock_fd,
+                get_recv_frame_size(),
+                _busy_poll,
+                _recv_shared_pool.get()));
+            _mrb_pool.back()->set_single_threaded(opts.single_threaded_buffers);
         }
 
+        if (_busy_poll > 0.0) {
+            enable_busy_poll();
+        }
+
+#ifdef HAVE_LIBURING
+        if (opts.use_io_uring) {
+            UHD_LOGGER_TRACE("UDP") << "Using io_uring for receive";
+            _uring_receiver.reset(new udp_uring_receiver(
+                _sock_fd, _recv_buffer_pool, get_recv_frame_size(), _busy_poll));
+            _recv_batch_size = 1; // Doesn't apply
+        }
+#else
+        if (opts.use_io_uring) {
+            UHD_LOGGER_WARNING("UDP")
+                << "use_io_uring was specified, but io_uring support is not "
+                   "built in. Ignoring.";
+        }
+#endif
+
+        if (not opts.rx_timestamps.empty()) {
+            enable_rx_timestamps(opts);
+        }
+
+#ifdef HAVE_RECVMMSG
+        // Time stamps come as control messages, which only the batched path reads
+        if (_recv_batch_size > 1 or _rx_timestamps) {
+            UHD_LOGGER_TRACE("UDP") << "Using batched receive, up to "
+                                    << _recv_batch_size << " frames per recvmmsg()";
+            _recv_msgs.resize(_recv_batch_size);
+            _recv_iovs.resize(_recv_batch_size);
+            _recv_lens.resize(_num_recv_frames, 0);
+        }
+#    ifdef HAVE_SO_TIMESTAMPING
+        if (_rx_timestamps) {
+            _recv_cmsgs.resize(_recv_batch_size * UDP_ZERO_COPY_TIMESTAMP_CMSG_SIZE);
+            _recv_stamps.resize(_num_recv_frames, 0);
+        }
+#    endif
+#else
+        if (_recv_batch_size > 1) {
+            UHD_LOGGER_WARNING("UDP")
+                << "recv_batch_size was specified, but batched receive is not "
+                   "supported on this platform. Ignoring.";
+            _recv_batch_size = 1;
+        }
+#endif
+
+        // set up batched send if requested
+        udp_send_batcher* batcher = nullptr;
+        const size_t batch_size   = std::min(opts.send_batch_size, _num_send_frames);
+#ifdef HAVE_SENDMMSG
+        if (batch_size > 1) {
+            UHD_LOGGER_TRACE("UDP") << "Using batched send, up to " << batch_size
+                                    << " frames per sendmmsg()";
+            _send_batcher.reset(
+                new udp_send_batcher(_sock_fd, batch_size, opts.send_batch_timeout));
+            batcher = _send_batcher.get();
+        }
+#else
+        if (batch_size > 1) {
+            UHD_LOGGER_WARNING("UDP")
+                << "send_batch_size was specified, but batched send is not "
+                   "supported on this platform. Ignoring.";
+        }
+#endif
+
         // allocate re-usable managed send buffers
         for (size_t i = 0; i < get_num_send_frames(); i++) {
             _msb_pool.push_back(boost::make_shared<udp_zero_copy_asio_msb>(
-                _send_buffer_pool->at(i), _sock_fd, get_send_frame_size()));
+                _send_shared_pool ? nullptr : _send_buffer_pool->at(i),
+                _sock_fd,
+                get_send_frame_size(),
+                batcher,
+                _send_shared_pool.get()));
+            _msb_pool.back()->set_single_threaded(opts.single_threaded_buffers);
         }
     }
 
+    ~udp_zero_copy_asio_impl(void)
+    {
+#ifdef HAVE_SENDMMSG
+        if (_send_batcher) {
+            try {
+                _send_batcher->flush();
+            } catch (const uhd::exception& ex) {
+                UHD_LOGGER_ERROR("UDP")
+                    << "Error flushing send buffers on destruction: " << ex.what();
+            }
+            // Stop the timer before the socket is closed
+            _send_batcher.reset();
+        }
+#endif
+    }
+
     // get size for internal socket buffer
     template <typename Opt> size_t get_buff_size(void) const
     {
@@ -246,11 +882,162 @@ public:
      ******************************************************************/
     managed_recv_buffer::sptr get_recv_buff(double timeout)
     {
+#ifdef HAVE_LIBURING
+        if (_uring_receiver)
+            return _uring_receiver->get_recv_buff(timeout);
+#endif
+#ifdef HAVE_RECVMMSG
+        if (_recv_batch_size > 1 or _rx_timestamps)
+            return get_recv_buff_batched(timeout);
+#endif
         if (_next_recv_buff_index == _num_recv_frames)
             _next_recv_buff_index = 0;
         return _mrb_pool[_next_recv_buff_index]->get_new(timeout, _next_recv_buff_index);
     }
 
+    int get_recv_fd(void)
+    {
+#ifdef HAVE_LIBURING
+        // The completions are not tied to the socket becoming readable
+        if (_uring_receiver)
+            return -1;
+#endif
+        return _sock_fd;
+    }
+
+    bool has_recv_buff(void)
+    {
+        return _num_batch_ready > 0;
+    }
+
+#ifdef HAVE_RECVMMSG
+    /*******************************************************************
+     * Batched receive implementation:
+     * Claim as many consecutive buffers as are available (up to the
+     * batch size), fill them with a single recvmmsg() call, and then
+     * hand them out one by one on subsequent calls.
+     ******************************************************************/
+    managed_recv_buffer::sptr get_recv_buff_batched(double timeout)
+    {
+        if (_next_recv_buff_index == _num_recv_frames)
+            _next_recv_buff_index = 0;
+        const size_t first = _next_recv_buff_index;
+
+        // Frames left over from a previous batch are already claimed
+        if (_num_batch_ready > 0) {
+            _num_batch_ready--;
+            _next_recv_buff_index++;
+            return get_filled(first);
+        }
+
+        // An empty datagram came after the ones that were handed out
+        if (_recv_closed) {
+            _recv_closed = false;
+            throw uhd::io_error("socket closed");
+        }
+
+        if (not _mrb_pool[first]->claim(timeout))
+            return managed_recv_buffer::sptr();
+
+        // Opportunistically claim the following buffers, but don't wait
+        size_t num_claimed = 1;
+        while (num_claimed < _recv_batch_size
+               and _mrb_pool[(first + num_claimed) % _num_recv_frames]->claim(0.0)) {
+            num_claimed++;
+        }
+
+        for (size_t i = 0; i < num_claimed; i++) {
+            const size_t idx           = (first + i) % _num_recv_frames;
+            _recv_iovs[i].iov_base     = _mrb_pool[idx]->get_mem();
+            _recv_iovs[i].iov_len      = _recv_frame_size;
+            std::memset(&_recv_msgs[i], 0, sizeof(mmsghdr));
+            _recv_msgs[i].msg_hdr.msg_iov    = &_recv_iovs[i];
+            _recv_msgs[i].msg_hdr.msg_iovlen = 1;
+#    ifdef HAVE_SO_TIMESTAMPING
+            if (_rx_timestamps) {
+                _recv_msgs[i].msg_hdr.msg_control =
+                    &_recv_cmsgs[i * UDP_ZERO_COPY_TIMESTAMP_CMSG_SIZE];
+                _recv_msgs[i].msg_hdr.msg_controllen = UDP_ZERO_COPY_TIMESTAMP_CMSG_SIZE;
+            }
+#    endif
+        }
+
+        int num_rcvd = int(busy_poll_recv(
+            [this, num_claimed]() {
+                return ::recvmmsg(
+                    _sock_fd, _recv_msgs.data(), num_claimed, MSG_DONTWAIT, nullptr);
+            },
+            _busy_poll,
+            timeout));
+        if (num_rcvd < 0 and (errno == EAGAIN or errno == EWOULDBLOCK)) {
+            num_rcvd = 0;
+            if (wait_for_recv_ready(_sock_fd, timeout)) {
+                num_rcvd = ::recvmmsg(
+                    _sock_fd, _recv_msgs.data(), num_claimed, MSG_DONTWAIT, nullptr);
+                // A spurious wakeup counts as a timeout
+                if (num_rcvd < 0 and (errno == EAGAIN or errno == EWOULDBLOCK)) {
+                    num_rcvd = 0;
+                }
+            }
+        }
+        if (num_rcvd < 0) {
+            const int err = errno;
+            release_claimed(first, 0, num_claimed);
+            throw uhd::io_error(
+                str(boost::format("recvmmsg error on socket: %s") % strerror(err)));
+        }
+
+        // Undo the claims on every buffer that did not get filled
+        release_claimed(first, num_rcvd, num_claimed);
+        if (num_rcvd == 0)
+            return managed_recv_buffer::sptr(); // null for timeout
+
+        for (int i = 0; i < num_rcvd; i++) {
+            if (_recv_msgs[i].msg_len == 0) {
+                release_claimed(first, i, num_rcvd);
+                if (i == 0) {
+                    throw uhd::io_error("socket closed");
+                }
+                // Hand out the datagrams before it first
+                _recv_closed = true;
+                num_rcvd     = i;
+                break;
+            }
+            _recv_lens[(first + i) % _num_recv_frames] = _recv_msgs[i].msg_len;
+#    ifdef HAVE_SO_TIMESTAMPING
+            if (_rx_timestamps) {
+                _recv_stamps[(first + i) % _num_recv_frames] =
+                    get_rx_timestamp(_recv_msgs[i].msg_hdr);
+            }
+#    endif
+        }
+
+        _num_batch_ready = num_rcvd - 1;
+        _next_recv_buff_index++;
+        return get_filled(first);
+    }
+
+    //! Hand out the filled buffer at \p index, with its time stamp
+    UHD_INLINE managed_recv_buffer::sptr get_filled(const size_t index)
+    {
+#    ifdef HAVE_SO_TIMESTAMPING
+        if (_rx_timestamps) {
+            _mrb_pool[index]->set_rx_timestamp(_recv_stamps[index]);
+        }
+#    endif
+        return _mrb_pool[index]->get_filled(_recv_lens[index]);
+    }
+
+    //! Release the claimed buffers first+start ... first+end-1
+    UHD_INLINE void release_claimed(
+        const size_t first, const size_t start, const size_t end)
+    {
+        for (size_t i = start; i < end; i++) {
+            _mrb_pool[(first + i) % _num_recv_frames]->release();
+        }
+    }
+#endif /* HAVE_RECVMMSG */
+
     size_t get_num_recv_frames(void) const
     {
         return _num_recv_frames;
@@ -268,9 +1055,28 @@ public:
     {
         if (_next_send_buff_index == _num_send_frames)
             _next_send_buff_index = 0;
+#ifdef HAVE_SENDMMSG
+        if (_send_batcher) {
+            // Don't wait for a buffer that is only held back by the batcher
+            if (_msb_pool[_next_send_buff_index]->is_queued()) {
+                _send_batcher->flush();
+            } else {
+                _send_batcher->flush_if_stale();
+            }
+        }
+#endif
         return _msb_pool[_next_send_buff_index]->get_new(timeout, _next_send_buff_index);
     }
 
+    void flush_send_buffs(void)
+    {
+#ifdef HAVE_SENDMMSG
+        if (_send_batcher) {
+            _send_batcher->flush();
+        }
+#endif
+    }
+
     size_t get_num_send_frames(void) const
     {
         return _num_send_frames;
@@ -291,14 +1097,105 @@ public:
     }
 
 private:
+    /*!
+     * Let the kernel poll the NIC's receive queue instead of waiting for its
+     * interrupt, both in the non-blocking receives we spin on and in poll().
+     * Raising the time above net.core.busy_read requires CAP_NET_ADMIN.
+     */
+    void enable_busy_poll(void)
+    {
+#ifdef SO_BUSY_POLL
+        const int busy_poll_us = int(_busy_poll * 1e6);
+        if (::setsockopt(_sock_fd,
+                SOL_SOCKET,
+                SO_BUSY_POLL,
+                (const char*)&busy_poll_us,
+                sizeof(busy_poll_us))
+            != 0) {
+            UHD_LOGGER_DEBUG("UDP")
+                << "Could not set SO_BUSY_POLL, spinning in user space only: "
+                << strerror(errno);
+            return;
+        }
+#    ifdef SO_PREFER_BUSY_POLL
+        const int prefer = 1;
+        ::setsockopt(_sock_fd,
+            SOL_SOCKET,
+            SO_PREFER_BUSY_POLL,
+            (const char*)&prefer,
+            sizeof(prefer));
+#    endif
+        UHD_LOGGER_TRACE("UDP") << "Kernel busy polling for " << busy_poll_us << " us";
+#endif
+    }
+
+    //! Ask the kernel for arrival time stamps, see udp_zero_copy_opts
+    void enable_rx_timestamps(const udp_zero_copy_opts& opts)
+    {
+        if (opts.rx_timestamps != "sw" and opts.rx_timestamps != "hw") {
+            throw uhd::value_error("Invalid rx_timestamps: " + opts.rx_timestamps
+                                   + " (expected sw or hw)");
+        }
+#ifdef HAVE_SO_TIMESTAMPING
+        if (opts.use_io_uring) {
+            UHD_LOGGER_WARNING("UDP")
+                << "rx_timestamps is not supported with use_io_uring. Ignoring.";
+            return;
+        }
+        const int flags = (opts.rx_timestamps == "hw")
+                              ? (SOF_TIMESTAMPING_RX_HARDWARE
+                                    | SOF_TIMESTAMPING_RAW_HARDWARE)
+                              : (SOF_TIMESTAMPING_RX_SOFTWARE
+                                    | SOF_TIMESTAMPING_SOFTWARE);
+        if (::setsockopt(_sock_fd, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags))
+            != 0) {
+            UHD_LOGGER_WARNING("UDP")
+                << "Could not enable receive time stamps: " << strerror(errno);
+            return;
+        }
+        UHD_LOGGER_TRACE("UDP") << "Capturing " << opts.rx_timestamps
+                                << " receive time stamps";
+        _rx_timestamps = true;
+#else
+        UHD_LOGGER_WARNING("UDP")
+            << "rx_timestamps was specified, but receive time stamps are not "
+               "supported on this platform. Ignoring.";
+#endif
+    }
+
     // memory management -> buffers and fifos
     const size_t _recv_frame_size, _num_recv_frames;
     const size_t _send_frame_size, _num_send_frames;
     buffer_pool::sptr _recv_buffer_pool, _send_buffer_pool;
+    //! Used instead of the buffer pools with shared_frames
+    shared_frame_pool::sptr _recv_shared_pool, _send_shared_pool;
     std::vector<boost::shared_ptr<udp_zero_copy_asio_msb>> _msb_pool;
     std::vector<boost::shared_ptr<udp_zero_copy_asio_mrb>> _mrb_pool;
     size_t _next_recv_buff_index, _next_send_buff_index;
 
+    // batched receive state
+    size_t _recv_batch_size;
+    size_t _num_batch_ready;
+    //! True if a batch held an empty datagram, which is reported once it is handed out
+    bool _recv_closed;
+    bool _rx_timestamps;
+    const double _busy_poll;
+#ifdef HAVE_RECVMMSG
+    std::vector<mmsghdr> _recv_msgs;
+    std::vector<iovec> _recv_iovs;
+    std::vector<size_t> _recv_lens;
+#endif
+#ifdef HAVE_SO_TIMESTAMPING
+    std::vector<char> _recv_cmsgs;
+    std::vector<uint64_t> _recv_stamps;
+#endif
+#ifdef HAVE_SENDMMSG
+    std::unique_ptr<udp_send_batcher> _send_batcher;
+#endif
+#ifdef HAVE_LIBURING
+    std::unique_ptr<udp_uring_receiver> _uring_receiver;
+#endif
+
     // asio guts -> socket and service
     asio::io_service _io_service;
     socket_sptr _socket;
@@ -360,6 +1257,22 @@ udp_zero_copy::sptr udp_zero_copy::make(const std::string& addr,
         size_t(hints.cast<double>("recv_buff_size", default_buff_args.recv_buff_size));
     xport_params.send_buff_size =
         size_t(hints.cast<double>("send_buff_size", default_buff_args.send_buff_size));
+    udp_zero_copy_opts opts;
+    opts.recv_batch_size = size_t(
+        hints.cast<double>("recv_batch_size", UDP_ZERO_COPY_DEFAULT_RECV_BATCH_SIZE));
+    opts.send_batch_size = size_t(
+        hints.cast<double>("send_batch_size", UDP_ZERO_COPY_DEFAULT_SEND_BATCH_SIZE));
+    opts.send_batch_timeout = hints.cast<double>(
+        "send_batch_timeout", UDP_ZERO_COPY_DEFAULT_SEND_BATCH_TIMEOUT);
+    opts.use_io_uring  = hints.has_key("use_io_uring");
+    opts.rx_timestamps = hints.get("rx_timestamps", "");
+    opts.recv_busy_poll = hints.cast<double>("recv_busy_poll_us", 0.0) / 1e6;
+    opts.mem_params    = buffer_pool::get_mem_params(hints);
+    opts.shared_frames = hints.has_key("shared_frames");
+    opts.single_threaded_buffers = hints.has_key("single_threaded_buffers");
+    if (opts.shared_frames and not hints["shared_frames"].empty()) {
+        opts.max_shared_frames = size_t(hints.cast<double>("shared_frames", 0));
+    }
 
     if (xport_params.num_recv_frames == 0) {
         UHD_LOG_TRACE("UDP",
@@ -416,7 +1329,7 @@ udp_zero_copy::sptr udp_zero_copy::make(const std::string& addr,
 #endif
 
     udp_zero_copy_asio_impl::sptr udp_trans(
-        new udp_zero_copy_asio_impl(addr, port, xport_params));
+        new udp_zero_copy_asio_impl(addr, port, xport_params, opts));
 
     // call the helper to resize send and recv buffers
     buff_params_out.recv_buff_size =
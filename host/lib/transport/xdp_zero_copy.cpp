@@ -0,0 +1,679 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhdlib/transport/xdp_zero_copy.hpp>
+#include <xdp/xsk.h>
+#include <boost/asio.hpp>
+#include <boost/format.hpp>
+#include <boost/make_shared.hpp>
+#include <arpa/inet.h>
+#include <ifaddrs.h>
+#include <linux/if_link.h>
+#include <linux/if_xdp.h>
+#include <net/if.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+using namespace uhd;
+using namespace uhd::transport;
+
+namespace {
+
+constexpr size_t XDP_FRAME_SIZE         = XSK_UMEM__DEFAULT_FRAME_SIZE;
+constexpr size_t XDP_ETH_HDR_LEN        = 14;
+constexpr size_t XDP_IPV4_HDR_LEN       = 20;
+constexpr size_t XDP_UDP_HDR_LEN        = 8;
+constexpr size_t XDP_HEADERS_SIZE       = XDP_ETH_HDR_LEN + XDP_IPV4_HDR_LEN
+                                    + XDP_UDP_HDR_LEN; // Ethernet + IPv4 + UDP
+constexpr size_t XDP_MAX_PAYLOAD_SIZE   = XDP_FRAME_SIZE - XDP_HEADERS_SIZE;
+constexpr size_t XDP_DEFAULT_NUM_FRAMES = 32;
+constexpr uint16_t XDP_ETHERTYPE_IPV4   = 0x0800;
+constexpr uint8_t XDP_IP_PROTO_UDP      = 17;
+
+//! Round up to the next power of two (AF_XDP ring sizes must be powers of 2)
+uint32_t next_pow2(size_t value)
+{
+    uint32_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+//! One's complement checksum over the IPv4 header
+uint16_t ipv4_checksum(const uint8_t* hdr)
+{
+    uint32_t sum = 0;
+    for (size_t i = 0; i < XDP_IPV4_HDR_LEN; i += 2) {
+        sum += (uint32_t(hdr[i]) << 8) | hdr[i + 1];
+    }
+    while (sum >> 16) {
+        sum = (sum & 0xFFFF) + (sum >> 16);
+    }
+    return uint16_t(~sum);
+}
+
+//! Find the name of the interface that is on the same subnet as \p remote
+std::string find_ifname_for_addr(const in_addr_t remote, in_addr_t& local)
+{
+    struct ifaddrs* ifap = nullptr;
+    if (getifaddrs(&ifap) != 0) {
+        throw uhd::runtime_error("XDP: Could not enumerate network interfaces");
+    }
+    std::string ifname;
+    for (struct ifaddrs* ifa = ifap; ifa != nullptr; ifa = ifa->ifa_next) {
+        if (ifa->ifa_addr == nullptr or ifa->ifa_netmask == nullptr
+            or ifa->ifa_addr->sa_family != AF_INET) {
+            continue;
+        }
+        const in_addr_t if_addr =
+            reinterpret_cast<struct sockaddr_in*>(ifa->ifa_addr)->sin_addr.s_addr;
+        const in_addr_t if_mask =
+            reinterpret_cast<struct sockaddr_in*>(ifa->ifa_netmask)->sin_addr.s_addr;
+        if ((if_addr & if_mask) == (remote & if_mask)) {
+            ifname = ifa->ifa_name;
+            local  = if_addr;
+            break;
+        }
+    }
+    freeifaddrs(ifap);
+    return ifname;
+}
+
+//! Look up the IPv4 address of an interface by name
+in_addr_t get_if_ipv4(const std::string& ifname)
+{
+    struct ifaddrs* ifap = nullptr;
+    if (getifaddrs(&ifap) != 0) {
+        throw uhd::runtime_error("XDP: Could not enumerate network interfaces");
+    }
+    in_addr_t addr = 0;
+    for (struct ifaddrs* ifa = ifap; ifa != nullptr; ifa = ifa->ifa_next) {
+        if (ifa->ifa_addr != nullptr and ifa->ifa_addr->sa_family == AF_INET
+            and ifname == ifa->ifa_name) {
+            addr = reinterpret_cast<struct sockaddr_in*>(ifa->ifa_addr)->sin_addr.s_addr;
+            break;
+        }
+    }
+    freeifaddrs(ifap);
+    if (addr == 0) {
+        throw uhd::runtime_error("XDP: Interface " + ifname + " has no IPv4 address");
+    }
+    return addr;
+}
+
+//! Read the MAC address of a local interface
+void get_if_mac(const std::string& ifname, uint8_t* mac)
+{
+    const int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) {
+        throw uhd::runtime_error("XDP: Could not open socket for MAC lookup");
+    }
+    struct ifreq ifr;
+    std::memset(&ifr, 0, sizeof(ifr));
+    std::strncpy(ifr.ifr_name, ifname.c_str(), IFNAMSIZ - 1);
+    const int ret = ::ioctl(fd, SIOCGIFHWADDR, &ifr);
+    ::close(fd);
+    if (ret < 0) {
+        throw uhd::runtime_error("XDP: Could not read MAC address of " + ifname);
+    }
+    std::memcpy(mac, ifr.ifr_hwaddr.sa_data, 6);
+}
+
+/*! Look up the MAC address of a neighbour in the kernel's ARP table
+ *
+ * The kernel retains ownership of the NIC, so by the time we create a data
+ * transport, it will have resolved the device's address during discovery
+ * and control traffic.
+ */
+bool get_neigh_mac(const std::string& ifname, const std::string& ip_addr, uint8_t* mac)
+{
+    std::ifstream arp_table("/proc/net/arp");
+    std::string line;
+    std::getline(arp_table, line); // Skip header
+    while (std::getline(arp_table, line)) {
+        std::istringstream iss(line);
+        std::string ip, hw_type, flags, hw_addr, mask, dev;
+        if (!(iss >> ip >> hw_type >> flags >> hw_addr >> mask >> dev)) {
+            continue;
+        }
+        if (ip != ip_addr or dev != ifname) {
+            continue;
+        }
+        unsigned int bytes[6];
+        if (std::sscanf(hw_addr.c_str(),
+                "%x:%x:%x:%x:%x:%x",
+                &bytes[0],
+                &bytes[1],
+                &bytes[2],
+                &bytes[3],
+                &bytes[4],
+                &bytes[5])
+            != 6) {
+            return false;
+        }
+        for (size_t i = 0; i < 6; i++) {
+            mac[i] = uint8_t(bytes[i]);
+        }
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+class xdp_zero_copy_impl;
+
+/***********************************************************************
+ * Managed receive buffer:
+ *  - wraps one UMEM frame that was handed to us by the RX ring
+ *  - release returns the frame to the fill ring
+ **********************************************************************/
+class xdp_zero_copy_mrb : public managed_recv_buffer
+{
+public:
+    xdp_zero_copy_mrb(xdp_zero_copy_impl* xport, const uint64_t frame_addr)
+        : _xport(xport), _frame_addr(frame_addr)
+    {
+    }
+
+    void release(void);
+
+    UHD_INLINE sptr get_new(void* payload, const size_t len)
+    {
+        return make(this, payload, len);
+    }
+
+private:
+    xdp_zero_copy_impl* _xport;
+    const uint64_t _frame_addr;
+};
+
+/***********************************************************************
+ * Managed send buffer:
+ *  - wraps one UMEM frame, leaving room for the Ethernet/IP/UDP headers
+ *  - release fills in the headers and queues the frame on the TX ring
+ **********************************************************************/
+class xdp_zero_copy_msb : public managed_send_buffer
+{
+public:
+    xdp_zero_copy_msb(xdp_zero_copy_impl* xport, const uint64_t frame_addr)
+        : _xport(xport), _frame_addr(frame_addr)
+    {
+    }
+
+    void release(void);
+
+    UHD_INLINE sptr get_new(void* payload, const size_t len)
+    {
+        return make(this, payload, len);
+    }
+
+private:
+    xdp_zero_copy_impl* _xport;
+    const uint64_t _frame_addr;
+};
+
+/***********************************************************************
+ * AF_XDP transport implementation
+ *
+ * UMEM layout: The first num_recv_frames frames are receive frames, which
+ * are owned by the kernel (fill ring) until they show up in the RX ring.
+ * The remaining num_send_frames frames are send frames, which we track in a
+ * free list and reclaim from the completion ring.
+ **********************************************************************/
+class xdp_zero_copy_impl : public xdp_zero_copy
+{
+public:
+    xdp_zero_copy_impl(const std::string& addr,
+        const std::string& remote_port,
+        const zero_copy_xport_params& xport_params,
+        const device_addr_t& hints)
+        : _num_recv_frames(xport_params.num_recv_frames)
+        , _num_send_frames(xport_params.num_send_frames)
+        , _recv_frame_size(std::min(xport_params.recv_frame_size, XDP_MAX_PAYLOAD_SIZE))
+        , _send_frame_size(std::min(xport_params.send_frame_size, XDP_MAX_PAYLOAD_SIZE))
+        , _drop_count(0)
+    {
+        // Resolve the remote endpoint through the kernel
+        boost::asio::ip::udp::resolver resolver(_io_service);
+        boost::asio::ip::udp::resolver::query query(
+            boost::asio::ip::udp::v4(), addr, remote_port);
+        const boost::asio::ip::udp::endpoint remote = *resolver.resolve(query);
+        _remote_addr = remote.address().to_string();
+        _remote_ip   = htonl(remote.address().to_v4().to_ulong());
+        _remote_port = htons(remote.port());
+
+        // Figure out which interface to use
+        in_addr_t local_ip = 0;
+        if (hints.has_key("xdp_if")) {
+            _ifname  = hints["xdp_if"];
+            local_ip = get_if_ipv4(_ifname);
+        } else {
+            _ifname = find_ifname_for_addr(_remote_ip, local_ip);
+            if (_ifname.empty()) {
+                throw uhd::runtime_error(
+                    "XDP: Could not find a local interface on the subnet of "
+                    + _remote_addr);
+            }
+        }
+        _local_ip = local_ip;
+
+        // Reserve a local port with the kernel by binding a regular socket.
+        // Matching packets get redirected before they reach it.
+        _socket.reset(new boost::asio::ip::udp::socket(_io_service));
+        _socket->open(boost::asio::ip::udp::v4());
+        _socket->bind(boost::asio::ip::udp::endpoint(
+            boost::asio::ip::address_v4(ntohl(_local_ip)), 0));
+        _socket->connect(remote);
+        _local_port = htons(_socket->local_endpoint().port());
+
+        // Build the header template used for all outgoing frames
+        uint8_t remote_mac[6];
+        if (not get_neigh_mac(_ifname, _remote_addr, remote_mac)) {
+            throw uhd::runtime_error("XDP: No ARP entry for " + _remote_addr + " on "
+                                     + _ifname
+                                     + ". Make sure the device is reachable.");
+        }
+        init_hdr_template(remote_mac);
+
+        // Allocate the UMEM
+        const size_t num_frames = _num_recv_frames + _num_send_frames;
+        _umem_size              = num_frames * XDP_FRAME_SIZE;
+        if (posix_memalign(&_umem_area, getpagesize(), _umem_size) != 0) {
+            throw uhd::runtime_error("XDP: Could not allocate UMEM");
+        }
+        struct xsk_umem_config umem_cfg;
+        umem_cfg.fill_size      = next_pow2(_num_recv_frames);
+        umem_cfg.comp_size      = next_pow2(_num_send_frames);
+        umem_cfg.frame_size     = XDP_FRAME_SIZE;
+        umem_cfg.frame_headroom = 0;
+        umem_cfg.flags          = 0;
+        int ret =
+            xsk_umem__create(&_umem, _umem_area, _umem_size, &_fill, &_comp, &umem_cfg);
+        if (ret) {
+            std::free(_umem_area);
+            throw uhd::runtime_error(
+                str(boost::format("XDP: Could not create UMEM: %s") % strerror(-ret)));
+        }
+
+        // Create the socket. This also loads the default XDP program which
+        // redirects the traffic of this queue into the socket.
+        struct xsk_socket_config xsk_cfg;
+        std::memset(&xsk_cfg, 0, sizeof(xsk_cfg));
+        xsk_cfg.rx_size    = next_pow2(_num_recv_frames);
+        xsk_cfg.tx_size    = next_pow2(_num_send_frames);
+        xsk_cfg.xdp_flags  = hints.has_key("xdp_skb_mode") ? XDP_FLAGS_SKB_MODE : 0;
+        xsk_cfg.bind_flags = XDP_USE_NEED_WAKEUP;
+        if (hints.has_key("xdp_zerocopy")) {
+            xsk_cfg.bind_flags |= XDP_ZEROCOPY;
+        }
+        const uint32_t queue_id = hints.cast<uint32_t>("xdp_queue", 0);
+        ret                     = xsk_socket__create(
+            &_xsk, _ifname.c_str(), queue_id, _umem, &_rx, &_tx, &xsk_cfg);
+        if (ret) {
+            xsk_umem__delete(_umem);
+            std::free(_umem_area);
+            throw uhd::runtime_error(
+                str(boost::format("XDP: Could not create socket on %s queue %d: %s")
+                    % _ifname % queue_id % strerror(-ret)));
+        }
+        _xsk_fd = xsk_socket__fd(_xsk);
+
+        // Hand all receive frames to the kernel
+        for (size_t i = 0; i < _num_recv_frames; i++) {
+            _mrb_pool.push_back(
+                boost::make_shared<xdp_zero_copy_mrb>(this, i * XDP_FRAME_SIZE));
+            refill(i * XDP_FRAME_SIZE);
+        }
+        for (size_t i = _num_recv_frames; i < num_frames; i++) {
+            _msb_pool.push_back(
+                boost::make_shared<xdp_zero_copy_msb>(this, i * XDP_FRAME_SIZE));
+            _free_send_frames.push_back(_msb_pool.size() - 1);
+        }
+
+        UHD_LOG_TRACE("XDP",
+            "Created AF_XDP transport on " << _ifname << " queue " << queue_id
+                                           << " between " << get_local_addr() << ":"
+                                           << get_local_port() << " and "
+                                           << _remote_addr << ":" << remote_port);
+    }
+
+    ~xdp_zero_copy_impl(void)
+    {
+        xsk_socket__delete(_xsk);
+        xsk_umem__delete(_umem);
+        std::free(_umem_area);
+    }
+
+    /*******************************************************************
+     * Receive implementation:
+     * Peek at the RX ring, drop anything that isn't for us, and hand out
+     * the payload of the UMEM frame.
+     ******************************************************************/
+    managed_recv_buffer::sptr get_recv_buff(double timeout)
+    {
+        const auto exit_time = std::chrono::steady_clock::now()
+                               + std::chrono::microseconds(int64_t(timeout * 1e6));
+        while (true) {
+            uint32_t idx = 0;
+            if (xsk_ring_cons__peek(&_rx, 1, &idx) == 1) {
+                const struct xdp_desc* desc = xsk_ring_cons__rx_desc(&_rx, idx);
+                const uint64_t frame_addr   = desc->addr;
+                const uint32_t frame_len    = desc->len;
+                xsk_ring_cons__release(&_rx, 1);
+
+                uint8_t* frame = static_cast<uint8_t*>(
+                    xsk_umem__get_data(_umem_area, frame_addr));
+                size_t payload_len = 0;
+                if (parse_headers(frame, frame_len, payload_len)) {
+                    const size_t frame_idx = frame_addr / XDP_FRAME_SIZE;
+                    return _mrb_pool[frame_idx]->get_new(
+                        frame + XDP_HEADERS_SIZE, payload_len);
+                }
+                _drop_count++;
+                refill(frame_addr);
+                continue;
+            }
+
+            const auto now = std::chrono::steady_clock::now();
+            if (now >= exit_time) {
+                return managed_recv_buffer::sptr();
+            }
+            const int poll_ms = int(
+                std::chrono::duration_cast<std::chrono::milliseconds>(exit_time - now)
+                    .count());
+            pollfd pfd;
+            pfd.fd     = _xsk_fd;
+            pfd.events = POLLIN;
+            ::poll(&pfd, 1, std::max(poll_ms, 1));
+        }
+    }
+
+    size_t get_num_recv_frames(void) const
+    {
+        return _num_recv_frames;
+    }
+
+    size_t get_recv_frame_size(void) const
+    {
+        return _recv_frame_size;
+    }
+
+    /*******************************************************************
+     * Send implementation:
+     * Reclaim completed frames and hand out a free one.
+     ******************************************************************/
+    managed_send_buffer::sptr get_send_buff(double timeout)
+    {
+        const auto exit_time = std::chrono::steady_clock::now()
+                               + std::chrono::microseconds(int64_t(timeout * 1e6));
+        std::unique_lock<std::mutex> lock(_tx_mutex);
+        while (true) {
+            reclaim_send_frames();
+            if (not _free_send_frames.empty()) {
+                const size_t msb_idx = _free_send_frames.back();
+                _free_send_frames.pop_back();
+                const uint64_t frame_addr = (_num_recv_frames + msb_idx) * XDP_FRAME_SIZE;
+                uint8_t* frame            = static_cast<uint8_t*>(
+                    xsk_umem__get_data(_umem_area, frame_addr));
+                return _msb_pool[msb_idx]->get_new(
+                    frame + XDP_HEADERS_SIZE, _send_frame_size);
+            }
+            if (std::chrono::steady_clock::now() >= exit_time) {
+                return managed_send_buffer::sptr();
+            }
+            // All frames are in flight; make sure the kernel is working on them
+            kick_tx();
+            lock.unlock();
+            pollfd pfd;
+            pfd.fd     = _xsk_fd;
+            pfd.events = POLLOUT;
+            ::poll(&pfd, 1, 1);
+            lock.lock();
+        }
+    }
+
+    size_t get_num_send_frames(void) const
+    {
+        return _num_send_frames;
+    }
+
+    size_t get_send_frame_size(void) const
+    {
+        return _send_frame_size;
+    }
+
+    uint16_t get_local_port(void) const
+    {
+        return ntohs(_local_port);
+    }
+
+    std::string get_local_addr(void) const
+    {
+        struct in_addr addr;
+        addr.s_addr = _local_ip;
+        return std::string(inet_ntoa(addr));
+    }
+
+    uint32_t get_drop_count(void) const
+    {
+        return _drop_count;
+    }
+
+    //! Return a receive frame to the kernel
+    void refill(const uint64_t frame_addr)
+    {
+        std::lock_guard<std::mutex> lock(_fill_mutex);
+        uint32_t idx = 0;
+        // The fill ring is sized to hold all receive frames, so this can
+        // only fail transiently while the kernel is catching up
+        while (xsk_ring_prod__reserve(&_fill, 1, &idx) != 1) {
+        }
+        *xsk_ring_prod__fill_addr(&_fill, idx) = frame_addr;
+        xsk_ring_prod__submit(&_fill, 1);
+    }
+
+    //! Add headers to a send frame and queue it for transmission
+    void send_frame(const uint64_t frame_addr, const size_t payload_len)
+    {
+        uint8_t* frame = static_cast<uint8_t*>(xsk_umem__get_data(_umem_area, frame_addr));
+        std::memcpy(frame, _hdr_template, XDP_HEADERS_SIZE);
+        uint8_t* ip_hdr        = frame + XDP_ETH_HDR_LEN;
+        uint8_t* udp_hdr       = ip_hdr + XDP_IPV4_HDR_LEN;
+        const uint16_t ip_len  = htons(uint16_t(
+            XDP_IPV4_HDR_LEN + XDP_UDP_HDR_LEN + payload_len));
+        const uint16_t udp_len = htons(uint16_t(XDP_UDP_HDR_LEN + payload_len));
+        std::memcpy(ip_hdr + 2, &ip_len, 2);
+        const uint16_t csum = htons(ipv4_checksum(ip_hdr));
+        std::memcpy(ip_hdr + 10, &csum, 2);
+        std::memcpy(udp_hdr + 4, &udp_len, 2);
+
+        std::lock_guard<std::mutex> lock(_tx_mutex);
+        uint32_t idx = 0;
+        while (xsk_ring_prod__reserve(&_tx, 1, &idx) != 1) {
+            kick_tx();
+            reclaim_send_frames();
+        }
+        struct xdp_desc* desc = xsk_ring_prod__tx_desc(&_tx, idx);
+        desc->addr            = frame_addr;
+        desc->len             = uint32_t(XDP_HEADERS_SIZE + payload_len);
+        xsk_ring_prod__submit(&_tx, 1);
+        kick_tx();
+    }
+
+private:
+    //! Build Ethernet, IPv4 and UDP headers with all the static fields
+    void init_hdr_template(const uint8_t* remote_mac)
+    {
+        std::memset(_hdr_template, 0, sizeof(_hdr_template));
+        uint8_t* eth = _hdr_template;
+        std::memcpy(eth, remote_mac, 6);
+        get_if_mac(_ifname, eth + 6);
+        eth[12] = XDP_ETHERTYPE_IPV4 >> 8;
+        eth[13] = XDP_ETHERTYPE_IPV4 & 0xFF;
+
+        uint8_t* ip = eth + XDP_ETH_HDR_LEN;
+        ip[0]       = 0x45; // IPv4, 5 words of header
+        ip[6]       = 0x40; // Don't fragment
+        ip[8]       = 64; // TTL
+        ip[9]       = XDP_IP_PROTO_UDP;
+        std::memcpy(ip + 12, &_local_ip, 4);
+        std::memcpy(ip + 16, &_remote_ip, 4);
+
+        uint8_t* udp = ip + XDP_IPV4_HDR_LEN;
+        std::memcpy(udp, &_local_port, 2);
+        std::memcpy(udp + 2, &_remote_port, 2);
+        // UDP checksum is optional for IPv4 and left at zero
+    }
+
+    //! Check a received frame is a UDP packet from our peer to our port
+    bool parse_headers(const uint8_t* frame, const size_t len, size_t& payload_len) const
+    {
+        if (len < XDP_HEADERS_SIZE) {
+            return false;
+        }
+        if (frame[12] != (XDP_ETHERTYPE_IPV4 >> 8)
+            or frame[13] != (XDP_ETHERTYPE_IPV4 & 0xFF)) {
+            return false;
+        }
+        const uint8_t* ip = frame + XDP_ETH_HDR_LEN;
+        if (ip[0] != 0x45 or ip[9] != XDP_IP_PROTO_UDP
+            or std::memcmp(ip + 12, &_remote_ip, 4) != 0) {
+            return false;
+        }
+        const uint8_t* udp = ip + XDP_IPV4_HDR_LEN;
+        if (std::memcmp(udp + 2, &_local_port, 2) != 0) {
+            return false;
+        }
+        const size_t udp_len = (size_t(udp[4]) << 8) | udp[5];
+        if (udp_len < XDP_UDP_HDR_LEN
+            or udp_len - XDP_UDP_HDR_LEN > len - XDP_HEADERS_SIZE) {
+            return false;
+        }
+        payload_len = udp_len - XDP_UDP_HDR_LEN;
+        return true;
+    }
+
+    //! Move completed send frames back to the free list (needs _tx_mutex)
+    void reclaim_send_frames(void)
+    {
+        uint32_t idx             = 0;
+        const uint32_t num_compl = xsk_ring_cons__peek(&_comp, _num_send_frames, &idx);
+        for (uint32_t i = 0; i < num_compl; i++) {
+            const uint64_t addr = *xsk_ring_cons__comp_addr(&_comp, idx + i);
+            _free_send_frames.push_back(addr / XDP_FRAME_SIZE - _num_recv_frames);
+        }
+        if (num_compl) {
+            xsk_ring_cons__release(&_comp, num_compl);
+        }
+    }
+
+    //! Tell the kernel there's something on the TX ring (needs _tx_mutex)
+    void kick_tx(void)
+    {
+        if (xsk_ring_prod__needs_wakeup(&_tx)) {
+            ::sendto(_xsk_fd, nullptr, 0, MSG_DONTWAIT, nullptr, 0);
+        }
+    }
+
+    const size_t _num_recv_frames;
+    const size_t _num_send_frames;
+    const size_t _recv_frame_size;
+    const size_t _send_frame_size;
+
+    // Addressing
+    std::string _ifname;
+    std::string _remote_addr;
+    in_addr_t _remote_ip;
+    in_addr_t _local_ip;
+    uint16_t _remote_port; // Network byte order
+    uint16_t _local_port; // Network byte order
+    uint8_t _hdr_template[XDP_HEADERS_SIZE];
+    boost::asio::io_service _io_service;
+    std::unique_ptr<boost::asio::ip::udp::socket> _socket;
+
+    // AF_XDP guts
+    void* _umem_area = nullptr;
+    size_t _umem_size;
+    struct xsk_umem* _umem  = nullptr;
+    struct xsk_socket* _xsk = nullptr;
+    int _xsk_fd;
+    struct xsk_ring_prod _fill;
+    struct xsk_ring_cons _comp;
+    struct xsk_ring_cons _rx;
+    struct xsk_ring_prod _tx;
+    std::mutex _fill_mutex;
+    std::mutex _tx_mutex;
+
+    // Managed buffers
+    std::vector<boost::shared_ptr<xdp_zero_copy_mrb>> _mrb_pool;
+    std::vector<boost::shared_ptr<xdp_zero_copy_msb>> _msb_pool;
+    std::vector<size_t> _free_send_frames;
+
+    uint32_t _drop_count;
+};
+
+void xdp_zero_copy_mrb::release(void)
+{
+    _xport->refill(_frame_addr);
+}
+
+void xdp_zero_copy_msb::release(void)
+{
+    _xport->send_frame(_frame_addr, size());
+}
+
+/***********************************************************************
+ * XDP zero copy make function
+ **********************************************************************/
+xdp_zero_copy::sptr xdp_zero_copy::make(const std::string& addr,
+    const std::string& remote_port,
+    const zero_copy_xport_params& default_buff_args,
+    const device_addr_t& hints)
+{
+    zero_copy_xport_params xport_params = default_buff_args;
+    xport_params.recv_frame_size =
+        hints.cast<size_t>("recv_frame_size", xport_params.recv_frame_size);
+    xport_params.num_recv_frames =
+        hints.cast<size_t>("num_recv_frames", xport_params.num_recv_frames);
+    xport_params.send_frame_size =
+        hints.cast<size_t>("send_frame_size", xport_params.send_frame_size);
+    xport_params.num_send_frames =
+        hints.cast<size_t>("num_send_frames", xport_params.num_send_frames);
+
+    if (xport_params.num_recv_frames == 0) {
+        xport_params.num_recv_frames = XDP_DEFAULT_NUM_FRAMES;
+    }
+    if (xport_params.num_send_frames == 0) {
+        xport_params.num_send_frames = XDP_DEFAULT_NUM_FRAMES;
+    }
+    if (xport_params.recv_frame_size == 0
+        or xport_params.recv_frame_size > XDP_MAX_PAYLOAD_SIZE) {
+        xport_params.recv_frame_size = XDP_MAX_PAYLOAD_SIZE;
+    }
+    if (xport_params.send_frame_size == 0
+        or xport_params.send_frame_size > XDP_MAX_PAYLOAD_SIZE) {
+        xport_params.send_frame_size = XDP_MAX_PAYLOAD_SIZE;
+    }
+
+    return boost::make_shared<xdp_zero_copy_impl>(
+        addr, remote_port, xport_params, hints);
+}
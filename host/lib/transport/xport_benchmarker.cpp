@@ -6,11 +6,224 @@
 //
 
 #include "xport_benchmarker.hpp"
+#include <uhd/exception.hpp>
+#include <uhd/utils/thread.hpp>
+#include <boost/format.hpp>
+#include <algorithm>
 #include <chrono>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <sstream>
 #include <thread>
 
 namespace uhd { namespace transport {
 
+namespace {
+
+//! Upper limit of stored latency samples per stream, beyond that they are
+// replaced at random (reservoir sampling) to bound the memory use
+constexpr size_t MAX_LATENCY_SAMPLES = 1 << 20;
+
+//! CHDR sequence numbers are 12 bits wide
+constexpr size_t SEQ_MASK = 0xFFF;
+
+uint64_t get_time_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+void set_thread_cpu(const std::vector<size_t>& cpus, const size_t index)
+{
+    if (not cpus.empty()) {
+        uhd::set_thread_affinity({cpus[index % cpus.size()]});
+    }
+}
+
+void add_stream_results(xport_benchmarker::stream_results_t& total,
+    const xport_benchmarker::stream_results_t& stream)
+{
+    total.tx_packets += stream.tx_packets;
+    total.rx_packets += stream.rx_packets;
+    total.tx_bytes += stream.tx_bytes;
+    total.rx_bytes += stream.rx_bytes;
+    total.tx_timeouts += stream.tx_timeouts;
+    total.rx_timeouts += stream.rx_timeouts;
+    total.data_errors += stream.data_errors;
+    total.seq_errors += stream.seq_errors;
+    total.tx_rate += stream.tx_rate;
+    total.rx_rate += stream.rx_rate;
+}
+
+//! Sorts \p samples, returns (percentile, microseconds) pairs
+std::vector<std::pair<double, double>> get_percentiles(std::vector<uint64_t>& samples)
+{
+    std::vector<std::pair<double, double>> result;
+    if (samples.empty()) {
+        return result;
+    }
+    std::sort(samples.begin(), samples.end());
+    for (const double percentile : xport_benchmarker::get_latency_percentiles()) {
+        const size_t index = std::min(samples.size() - 1,
+            static_cast<size_t>(percentile / 100.0 * samples.size()));
+        result.push_back(std::make_pair(percentile, samples[index] / 1e3));
+    }
+    return result;
+}
+
+void write_json_stream(std::ostream& out, const xport_benchmarker::stream_results_t& s)
+{
+    out << "{\"tx_packets\": " << s.tx_packets << ", \"rx_packets\": " << s.rx_packets
+        << ", \"tx_bytes\": " << s.tx_bytes << ", \"rx_bytes\": " << s.rx_bytes
+        << ", \"tx_timeouts\": " << s.tx_timeouts
+        << ", \"rx_timeouts\": " << s.rx_timeouts
+        << ", \"data_errors\": " << s.data_errors
+        << ", \"seq_errors\": " << s.seq_errors << ", \"tx_rate\": " << s.tx_rate
+        << ", \"rx_rate\": " << s.rx_rate << ", \"latency_us\": {";
+    for (size_t i = 0; i < s.latency_us.size(); i++) {
+        out << (i ? ", " : "") << "\"p" << s.latency_us[i].first
+            << "\": " << s.latency_us[i].second;
+    }
+    out << "}}";
+}
+
+} // namespace
+
+//! Counters of one stream, each one is only written by one thread
+struct xport_benchmarker::stream_state_t
+{
+    uint64_t tx_packets  = 0;
+    uint64_t tx_timeouts = 0;
+    uint64_t rx_packets  = 0;
+    uint64_t rx_bytes    = 0;
+    uint64_t rx_timeouts = 0;
+    uint64_t data_errors = 0;
+    uint64_t seq_errors  = 0;
+    //! Latency samples in nanoseconds
+    std::vector<uint64_t> latency_ns;
+    //! Number of latency measurements, including the ones not stored
+    uint64_t num_latencies = 0;
+};
+
+const std::vector<double>& xport_benchmarker::get_latency_percentiles()
+{
+    static const std::vector<double> percentiles{50.0, 90.0, 99.0, 99.9, 99.99, 100.0};
+    return percentiles;
+}
+
+xport_benchmarker::results_t xport_benchmarker::run(
+    const std::vector<stream_t>& streams, const config_t& config)
+{
+    // Find the largest packet that fits all transports
+    size_t max_packet_size = std::numeric_limits<size_t>::max();
+    for (const stream_t& stream : streams) {
+        if (stream.tx_transport) {
+            max_packet_size =
+                std::min(max_packet_size, stream.tx_transport->get_send_frame_size());
+        }
+        if (stream.rx_transport) {
+            max_packet_size =
+                std::min(max_packet_size, stream.rx_transport->get_recv_frame_size());
+        }
+    }
+    if (streams.empty() or max_packet_size == std::numeric_limits<size_t>::max()) {
+        throw uhd::value_error("xport_benchmarker: No transports to benchmark");
+    }
+    if (config.packet_size > max_packet_size) {
+        throw uhd::value_error(
+            str(boost::format("xport_benchmarker: Packet size %d exceeds the "
+                              "transports' frame size %d")
+                % config.packet_size % max_packet_size));
+    }
+    // CHDR packets consist of 64-bit lines
+    const size_t packet_size =
+        (config.packet_size ? config.packet_size : max_packet_size) & ~size_t(7);
+    // Header and timestamp
+    if (packet_size < 16) {
+        throw uhd::value_error("xport_benchmarker: Packet size too small");
+    }
+
+    std::vector<vrt::if_packet_info_t> pkt_infos(streams.size());
+    std::vector<stream_state_t> states(streams.size());
+    for (size_t i = 0; i < streams.size(); i++) {
+        _initialize_chdr(packet_size, streams[i].sid, pkt_infos[i]);
+    }
+
+    _running = true;
+    const auto start_time = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < streams.size(); i++) {
+        if (streams[i].rx_transport) {
+            threads.emplace_back(&xport_benchmarker::_stream_rx,
+                this,
+                &states[i],
+                streams[i].rx_transport.get(),
+                &pkt_infos[i],
+                &config,
+                i);
+        }
+        if (streams[i].tx_transport) {
+            threads.emplace_back(&xport_benchmarker::_stream_tx,
+                this,
+                &states[i],
+                streams[i].tx_transport.get(),
+                &pkt_infos[i],
+                &config,
+                i);
+        }
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(config.duration_ms));
+
+    _running = false;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    const auto stop_time = std::chrono::steady_clock::now();
+
+    results_t results;
+    results.duration_s  = std::chrono::duration<double>(stop_time - start_time).count();
+    results.packet_size = packet_size;
+    std::vector<uint64_t> all_latencies;
+    for (size_t i = 0; i < streams.size(); i++) {
+        stream_state_t& state = states[i];
+        stream_results_t stream;
+        stream.tx_packets  = state.tx_packets;
+        stream.rx_packets  = state.rx_packets;
+        stream.tx_bytes    = state.tx_packets * pkt_infos[i].num_payload_bytes;
+        stream.rx_bytes    = state.rx_bytes;
+        stream.tx_timeouts = state.tx_timeouts;
+        stream.rx_timeouts = state.rx_timeouts;
+        stream.data_errors = state.data_errors;
+        stream.seq_errors  = state.seq_errors;
+        stream.tx_rate     = stream.tx_bytes / results.duration_s;
+        stream.rx_rate     = stream.rx_bytes / results.duration_s;
+        all_latencies.insert(
+            all_latencies.end(), state.latency_ns.begin(), state.latency_ns.end());
+        stream.latency_us = get_percentiles(state.latency_ns);
+        add_stream_results(results.total, stream);
+        results.streams.push_back(stream);
+    }
+    results.total.latency_us = get_percentiles(all_latencies);
+
+    return results;
+}
+
+std::vector<std::pair<device_addr_t, xport_benchmarker::results_t>>
+xport_benchmarker::sweep(const xport_factory_t& factory,
+    const std::vector<device_addr_t>& points,
+    const config_t& config)
+{
+    std::vector<std::pair<device_addr_t, results_t>> results;
+    for (const device_addr_t& point : points) {
+        UHD_LOG_DEBUG("XPORT_BENCH", "Benchmarking " << point.to_string());
+        results.push_back(std::make_pair(point, run(factory(point), config)));
+    }
+    return results;
+}
+
 const device_addr_t& xport_benchmarker::benchmark_throughput_chdr(
     zero_copy_if::sptr tx_transport,
     zero_copy_if::sptr rx_transport,
@@ -18,130 +231,157 @@ const device_addr_t& xport_benchmarker::benchmark_throughput_chdr(
     bool big_endian,
     uint32_t duration_ms)
 {
-    vrt::if_packet_info_t pkt_info;
-    _initialize_chdr(tx_transport, rx_transport, sid, pkt_info);
-    _reset_counters();
-    boost::posix_time::ptime start_time(boost::posix_time::microsec_clock::local_time());
-
-    _tx_thread.reset(new boost::thread(boost::bind(&xport_benchmarker::_stream_tx,
-        this,
-        tx_transport.get(),
-        &pkt_info,
-        big_endian)));
-    _rx_thread.reset(new boost::thread(boost::bind(&xport_benchmarker::_stream_rx,
-        this,
-        rx_transport.get(),
-        &pkt_info,
-        big_endian)));
-
-    std::this_thread::sleep_for(std::chrono::milliseconds(duration_ms));
-
-    _tx_thread->interrupt();
-    _rx_thread->interrupt();
-    _tx_thread->join();
-    _rx_thread->join();
-
-    boost::posix_time::ptime stop_time(boost::posix_time::microsec_clock::local_time());
-    double duration_s = ((double)(stop_time - start_time).total_microseconds()) / 1e6;
-
-    uint64_t tx_bytes = pkt_info.num_payload_words32 * sizeof(uint32_t) * _num_tx_packets;
-    uint64_t rx_bytes = pkt_info.num_payload_words32 * sizeof(uint32_t) * _num_rx_packets;
-    double tx_rate    = (((double)tx_bytes) / duration_s);
-    double rx_rate    = (((double)rx_bytes) / duration_s);
-
-    _results["TX-Bytes"] = (boost::format("%.2fMB") % (tx_bytes / (1024 * 1024))).str();
-    _results["RX-Bytes"] = (boost::format("%.2fMB") % (rx_bytes / (1024 * 1024))).str();
-    _results["TX-Throughput"] =
-        (boost::format("%.2fMB/s") % (tx_rate / (1024 * 1024))).str();
-    _results["RX-Throughput"] =
-        (boost::format("%.2fMB/s") % (rx_rate / (1024 * 1024))).str();
-    _results["TX-Timeouts"] = std::to_string(_num_tx_timeouts);
-    _results["RX-Timeouts"] = std::to_string(_num_rx_timeouts);
-    _results["Data-Errors"] = std::to_string(_num_data_errors);
-
+    config_t config;
+    config.duration_ms = duration_ms;
+    config.big_endian  = big_endian;
+    _results           = run({{tx_transport, rx_transport, sid}}, config).to_device_addr();
     return _results;
 }
 
-void xport_benchmarker::_stream_tx(
-    zero_copy_if* transport, vrt::if_packet_info_t* pkt_info, bool big_endian)
+device_addr_t xport_benchmarker::results_t::to_device_addr() const
 {
-    while (not boost::this_thread::interruption_requested()) {
+    device_addr_t results;
+    results["TX-Bytes"] =
+        (boost::format("%.2fMB") % (total.tx_bytes / (1024.0 * 1024))).str();
+    results["RX-Bytes"] =
+        (boost::format("%.2fMB") % (total.rx_bytes / (1024.0 * 1024))).str();
+    results["TX-Throughput"] =
+        (boost::format("%.2fMB/s") % (total.tx_rate / (1024 * 1024))).str();
+    results["RX-Throughput"] =
+        (boost::format("%.2fMB/s") % (total.rx_rate / (1024 * 1024))).str();
+    results["TX-Timeouts"] = std::to_string(total.tx_timeouts);
+    results["RX-Timeouts"] = std::to_string(total.rx_timeouts);
+    results["Data-Errors"] = std::to_string(total.data_errors);
+    results["Seq-Errors"]  = std::to_string(total.seq_errors);
+    for (const auto& latency : total.latency_us) {
+        results[str(boost::format("Latency-P%g") % latency.first)] =
+            (boost::format("%.1fus") % latency.second).str();
+    }
+    return results;
+}
+
+std::string xport_benchmarker::results_t::to_json() const
+{
+    std::ostringstream out;
+    out << "{\"duration_s\": " << duration_s << ", \"packet_size\": " << packet_size
+        << ", \"total\": ";
+    write_json_stream(out, total);
+    out << ", \"streams\": [";
+    for (size_t i = 0; i < streams.size(); i++) {
+        out << (i ? ", " : "");
+        write_json_stream(out, streams[i]);
+    }
+    out << "]}";
+    return out.str();
+}
+
+void xport_benchmarker::_stream_tx(stream_state_t* state,
+    zero_copy_if* transport,
+    const vrt::if_packet_info_t* exp_pkt_info,
+    const config_t* config,
+    const size_t index)
+{
+    set_thread_cpu(config->tx_cpus, index);
+    vrt::if_packet_info_t pkt_info = *exp_pkt_info;
+    while (_running.load(std::memory_order_relaxed)) {
         managed_send_buffer::sptr buff = transport->get_send_buff(_tx_timeout);
         if (buff) {
             uint32_t* packet_buff = buff->cast<uint32_t*>();
             // Populate packet
-            if (big_endian) {
-                vrt::if_hdr_pack_be(packet_buff, *pkt_info);
+            if (config->big_endian) {
+                vrt::if_hdr_pack_be(packet_buff, pkt_info);
             } else {
-                vrt::if_hdr_pack_le(packet_buff, *pkt_info);
+                vrt::if_hdr_pack_le(packet_buff, pkt_info);
+            }
+            if (config->measure_latency) {
+                const uint64_t now = get_time_ns();
+                std::memcpy(packet_buff + pkt_info.num_header_words32, &now, sizeof(now));
             }
             // send the buffer over the interface
-            buff->commit(sizeof(uint32_t) * (pkt_info->num_packet_words32));
-            _num_tx_packets++;
+            buff->commit(sizeof(uint32_t) * (pkt_info.num_packet_words32));
+            pkt_info.packet_count = (pkt_info.packet_count + 1) & SEQ_MASK;
+            state->tx_packets++;
         } else {
-            _num_tx_timeouts++;
+            state->tx_timeouts++;
         }
     }
 }
 
-void xport_benchmarker::_stream_rx(
-    zero_copy_if* transport, const vrt::if_packet_info_t* exp_pkt_info, bool big_endian)
+void xport_benchmarker::_stream_rx(stream_state_t* state,
+    zero_copy_if* transport,
+    const vrt::if_packet_info_t* exp_pkt_info,
+    const config_t* config,
+    const size_t index)
 {
-    while (not boost::this_thread::interruption_requested()) {
+    set_thread_cpu(config->rx_cpus, index);
+    std::mt19937_64 rng(index);
+    if (config->measure_latency) {
+        state->latency_ns.reserve(MAX_LATENCY_SAMPLES);
+    }
+    bool first_packet   = true;
+    size_t expected_seq = 0;
+    while (_running.load(std::memory_order_relaxed)) {
         managed_recv_buffer::sptr buff = transport->get_recv_buff(_rx_timeout);
         if (buff) {
+            const uint64_t now = get_time_ns();
             // Extract packet info
             vrt::if_packet_info_t pkt_info;
             pkt_info.link_type          = exp_pkt_info->link_type;
             pkt_info.num_packet_words32 = buff->size() / sizeof(uint32_t);
             const uint32_t* packet_buff = buff->cast<const uint32_t*>();
 
-            _num_rx_packets++;
+            state->rx_packets++;
 
             // unpacking can fail
             try {
-                if (big_endian) {
+                if (config->big_endian) {
                     vrt::if_hdr_unpack_be(packet_buff, pkt_info);
                 } else {
                     vrt::if_hdr_unpack_le(packet_buff, pkt_info);
                 }
+            } catch (const std::exception& ex) {
+                state->data_errors++;
+                continue;
+            }
+
+            if (exp_pkt_info->packet_type != pkt_info.packet_type
+                || exp_pkt_info->num_payload_bytes != pkt_info.num_payload_bytes) {
+                state->data_errors++;
+                continue;
+            }
+            if (not first_packet and pkt_info.packet_count != expected_seq) {
+                state->seq_errors++;
+            }
+            first_packet = false;
+            expected_seq = (pkt_info.packet_count + 1) & SEQ_MASK;
+            state->rx_bytes += pkt_info.num_payload_bytes;
 
-                if (exp_pkt_info->packet_type != pkt_info.packet_type
-                    || exp_pkt_info->num_payload_bytes != pkt_info.num_payload_bytes) {
-                    _num_data_errors++;
+            if (config->measure_latency) {
+                uint64_t sent;
+                std::memcpy(&sent, packet_buff + pkt_info.num_header_words32, sizeof(sent));
+                const uint64_t latency = now - sent;
+                state->num_latencies++;
+                if (state->latency_ns.size() < MAX_LATENCY_SAMPLES) {
+                    state->latency_ns.push_back(latency);
+                } else {
+                    const uint64_t slot = rng() % state->num_latencies;
+                    if (slot < MAX_LATENCY_SAMPLES) {
+                        state->latency_ns[slot] = latency;
+                    }
                 }
-            } catch (const std::exception& ex) {
-                _num_data_errors++;
             }
         } else {
-            _num_rx_timeouts++;
+            state->rx_timeouts++;
         }
     }
 }
 
-void xport_benchmarker::_reset_counters(void)
+void xport_benchmarker::_initialize_chdr(
+    size_t packet_size, uint32_t sid, vrt::if_packet_info_t& pkt_info)
 {
-    _num_tx_packets  = 0;
-    _num_rx_packets  = 0;
-    _num_tx_timeouts = 0;
-    _num_rx_timeouts = 0;
-    _num_data_errors = 0;
-}
-
-void xport_benchmarker::_initialize_chdr(zero_copy_if::sptr tx_transport,
-    zero_copy_if::sptr rx_transport,
-    uint32_t sid,
-    vrt::if_packet_info_t& pkt_info)
-{
-    _tx_timeout = 0.5;
-    _rx_timeout = 0.5;
-
-    size_t frame_size = std::min(
-        tx_transport->get_send_frame_size(), rx_transport->get_recv_frame_size());
-
     pkt_info.link_type           = vrt::if_packet_info_t::LINK_TYPE_CHDR;
     pkt_info.packet_type         = vrt::if_packet_info_t::PACKET_TYPE_DATA;
-    pkt_info.num_packet_words32  = (frame_size / sizeof(uint32_t));
+    pkt_info.num_packet_words32  = (packet_size / sizeof(uint32_t));
     pkt_info.num_payload_words32 = pkt_info.num_packet_words32 - 2;
     pkt_info.num_payload_bytes   = pkt_info.num_payload_words32 * sizeof(uint32_t);
     pkt_info.packet_count        = 0;
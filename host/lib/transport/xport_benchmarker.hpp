@@ -13,14 +13,107 @@
 #include <uhd/types/device_addr.hpp>
 #include <uhd/utils/log.hpp>
 #include <boost/shared_ptr.hpp>
-#include <boost/thread/thread.hpp>
+#include <atomic>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace uhd { namespace transport {
 
-// Test class to benchmark a low-level transport object with a VITA/C-VITA data stream
+/*! Test class to benchmark low-level transport objects with a CHDR data stream
+ *
+ * The benchmarker only talks to zero_copy_if objects, so it works the same
+ * for every transport type (UDP, DPDK, libusb, NI-RIO, liberio, ...). The
+ * caller creates the transports, or passes a factory to sweep().
+ */
 class xport_benchmarker : uhd::noncopyable
 {
 public:
+    //! One benchmarked stream. Leave a transport empty for TX- or RX-only.
+    struct stream_t
+    {
+        zero_copy_if::sptr tx_transport;
+        zero_copy_if::sptr rx_transport;
+        uint32_t sid;
+    };
+
+    struct config_t
+    {
+        uint32_t duration_ms = 1000;
+        bool big_endian      = false;
+        //! Packet size in bytes, 0 uses the largest frame all transports allow
+        size_t packet_size = 0;
+        //! CPUs to pin the TX threads to, stream i uses entry i % size
+        std::vector<size_t> tx_cpus;
+        //! CPUs to pin the RX threads to, stream i uses entry i % size
+        std::vector<size_t> rx_cpus;
+        /*! Measure the TX to RX latency of every packet
+         *
+         * The TX thread puts a host timestamp into every packet. This only
+         * makes sense if the packets come back to this host (loopback).
+         */
+        bool measure_latency = false;
+    };
+
+    struct stream_results_t
+    {
+        uint64_t tx_packets  = 0;
+        uint64_t rx_packets  = 0;
+        uint64_t tx_bytes    = 0;
+        uint64_t rx_bytes    = 0;
+        uint64_t tx_timeouts = 0;
+        uint64_t rx_timeouts = 0;
+        //! Packets with an unexpected type or size
+        uint64_t data_errors = 0;
+        //! Gaps in the CHDR sequence number
+        uint64_t seq_errors = 0;
+        //! Bytes per second
+        double tx_rate = 0.0;
+        double rx_rate = 0.0;
+        //! Latency percentiles in microseconds, as (percentile, latency)
+        std::vector<std::pair<double, double>> latency_us;
+    };
+
+    struct results_t
+    {
+        double duration_s = 0.0;
+        size_t packet_size = 0;
+        std::vector<stream_results_t> streams;
+        //! Sum of all streams. The latency percentiles cover all packets.
+        stream_results_t total;
+
+        //! Human-readable totals, same keys as benchmark_throughput_chdr()
+        device_addr_t to_device_addr() const;
+        //! All results as a JSON object
+        std::string to_json() const;
+    };
+
+    //! Creates the streams for one sweep point from its transport args
+    typedef std::function<std::vector<stream_t>(const device_addr_t& xport_args)>
+        xport_factory_t;
+
+    //! The latency percentiles that are reported
+    static const std::vector<double>& get_latency_percentiles();
+
+    /*! Run all streams concurrently for config.duration_ms
+     *
+     * Every stream gets its own TX and RX thread.
+     */
+    results_t run(const std::vector<stream_t>& streams, const config_t& config);
+
+    /*! Run a benchmark for each set of transport args in \p points
+     *
+     * Use this to sweep transport parameters such as send_frame_size,
+     * recv_frame_size or num_recv_frames. The transports of a point are
+     * released before the next point is created.
+     */
+    std::vector<std::pair<device_addr_t, results_t>> sweep(
+        const xport_factory_t& factory,
+        const std::vector<device_addr_t>& points,
+        const config_t& config);
+
+    //! Benchmark a single transport pair (legacy interface)
     const device_addr_t& benchmark_throughput_chdr(zero_copy_if::sptr tx_transport,
         zero_copy_if::sptr rx_transport,
         uint32_t sid,
@@ -28,31 +121,27 @@ public:
         uint32_t duration_ms);
 
 private:
-    void _stream_tx(
-        zero_copy_if* transport, vrt::if_packet_info_t* pkt_info, bool big_endian);
+    struct stream_state_t;
 
-    void _stream_rx(zero_copy_if* transport,
-        const vrt::if_packet_info_t* exp_pkt_info,
-        bool big_endian);
+    void _stream_tx(stream_state_t* state,
+        zero_copy_if* transport,
+        const vrt::if_packet_info_t* pkt_info,
+        const config_t* config,
+        const size_t index);
 
-    void _initialize_chdr(zero_copy_if::sptr tx_transport,
-        zero_copy_if::sptr rx_transport,
-        uint32_t sid,
-        vrt::if_packet_info_t& pkt_info);
-
-    void _reset_counters(void);
+    void _stream_rx(stream_state_t* state,
+        zero_copy_if* transport,
+        const vrt::if_packet_info_t* exp_pkt_info,
+        const config_t* config,
+        const size_t index);
 
-    boost::shared_ptr<boost::thread> _tx_thread;
-    boost::shared_ptr<boost::thread> _rx_thread;
+    static void _initialize_chdr(
+        size_t packet_size, uint32_t sid, vrt::if_packet_info_t& pkt_info);
 
-    uint64_t _num_tx_packets;
-    uint64_t _num_rx_packets;
-    uint64_t _num_tx_timeouts;
-    uint64_t _num_rx_timeouts;
-    uint64_t _num_data_errors;
+    std::atomic<bool> _running{false};
 
-    double _tx_timeout;
-    double _rx_timeout;
+    double _tx_timeout = 0.5;
+    double _rx_timeout = 0.5;
 
     device_addr_t _results;
 };
@@ -0,0 +1,190 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/transport/zero_copy_fault_inject.hpp>
+#include <uhd/utils/log.hpp>
+#include <boost/format.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <thread>
+
+using namespace uhd;
+using namespace uhd::transport;
+
+namespace {
+
+const char* const PROBABILITY_KEYS[] = {
+    "recv_fault_drop", "recv_fault_reorder", "recv_fault_dup", "recv_fault_delay"};
+
+double get_probability(const device_addr_t& args, const std::string& key)
+{
+    const double p = args.cast<double>(key, 0.0);
+    if (p < 0.0 or p > 1.0) {
+        throw uhd::value_error(
+            str(boost::format("%s must be within [0, 1], not %f") % key % p));
+    }
+    return p;
+}
+
+} // namespace
+
+/***********************************************************************
+ * Fault injecting transport:
+ * Only the streamer thread calls get_recv_buff(), so the counters are
+ * atomics only to be read from other threads.
+ **********************************************************************/
+class zero_copy_fault_inject_impl : public zero_copy_fault_inject
+{
+public:
+    zero_copy_fault_inject_impl(zero_copy_if::sptr transport, const device_addr_t& args)
+        : _transport(transport)
+        , _drop(get_probability(args, "recv_fault_drop"))
+        , _drop_burst(std::max<size_t>(1, args.cast<size_t>("recv_fault_drop_burst", 1)))
+        , _reorder(get_probability(args, "recv_fault_reorder"))
+        , _dup(get_probability(args, "recv_fault_dup"))
+        , _delay(get_probability(args, "recv_fault_delay"))
+        , _delay_time(args.cast<double>("recv_fault_delay_time", 0.001))
+        , _rng(args.cast<uint32_t>("recv_fault_seed", 1))
+    {
+        UHD_LOGGER_WARNING("XPORT")
+            << boost::format("Injecting receive faults: drop %f (burst %u), reorder %f, "
+                             "duplicate %f, delay %f (%f s)")
+                   % _drop % _drop_burst % _reorder % _dup % _delay % _delay_time;
+    }
+
+    /*******************************************************************
+     * Receive implementation:
+     * Return the packet that was held back (to reorder or duplicate it)
+     * first, then draw the faults for the next packet.
+     ******************************************************************/
+    managed_recv_buffer::sptr get_recv_buff(double timeout)
+    {
+        if (_next) {
+            managed_recv_buffer::sptr buff;
+            buff.swap(_next);
+            return buff;
+        }
+
+        managed_recv_buffer::sptr buff = _transport->get_recv_buff(timeout);
+        while (buff and (_drop_left > 0 or chance(_drop))) {
+            _drop_left = (_drop_left > 0 ? _drop_left : _drop_burst) - 1;
+            _dropped.fetch_add(1, std::memory_order_relaxed);
+            buff = _transport->get_recv_buff(timeout);
+        }
+        if (not buff) {
+            return buff;
+        }
+
+        if (chance(_delay)) {
+            _delayed.fetch_add(1, std::memory_order_relaxed);
+            std::this_thread::sleep_for(std::chrono::duration<double>(_delay_time));
+        }
+        if (chance(_dup)) {
+            _duplicated.fetch_add(1, std::memory_order_relaxed);
+            _next = buff;
+        } else if (chance(_reorder)) {
+            managed_recv_buffer::sptr later = _transport->get_recv_buff(timeout);
+            if (later) {
+                _reordered.fetch_add(1, std::memory_order_relaxed);
+                _next = buff;
+                return later;
+            }
+        }
+        return buff;
+    }
+
+    size_t get_num_recv_frames(void) const
+    {
+        return _transport->get_num_recv_frames();
+    }
+
+    size_t get_recv_frame_size(void) const
+    {
+        return _transport->get_recv_frame_size();
+    }
+
+    /*******************************************************************
+     * Send implementation:
+     * Pass the send buffer pointer from the underlying transport
+     ******************************************************************/
+    managed_send_buffer::sptr get_send_buff(double timeout)
+    {
+        return _transport->get_send_buff(timeout);
+    }
+
+    size_t get_num_send_frames(void) const
+    {
+        return _transport->get_num_send_frames();
+    }
+
+    size_t get_send_frame_size(void) const
+    {
+        return _transport->get_send_frame_size();
+    }
+
+    void flush_send_buffs(void)
+    {
+        _transport->flush_send_buffs();
+    }
+
+    stats_t get_stats(void) const
+    {
+        stats_t stats;
+        stats.dropped    = _dropped.load(std::memory_order_relaxed);
+        stats.reordered  = _reordered.load(std::memory_order_relaxed);
+        stats.duplicated = _duplicated.load(std::memory_order_relaxed);
+        stats.delayed    = _delayed.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+private:
+    bool chance(const double p)
+    {
+        return p > 0.0 and _uniform(_rng) < p;
+    }
+
+    // The linked transport
+    zero_copy_if::sptr _transport;
+
+    const double _drop;
+    const size_t _drop_burst;
+    const double _reorder;
+    const double _dup;
+    const double _delay;
+    const double _delay_time;
+
+    std::mt19937 _rng;
+    std::uniform_real_distribution<double> _uniform;
+
+    //! Packets still to drop in the current burst
+    size_t _drop_left = 0;
+    //! Packet to return on the next call
+    managed_recv_buffer::sptr _next;
+
+    std::atomic<uint64_t> _dropped{0};
+    std::atomic<uint64_t> _reordered{0};
+    std::atomic<uint64_t> _duplicated{0};
+    std::atomic<uint64_t> _delayed{0};
+};
+
+bool zero_copy_fault_inject::has_faults(const device_addr_t& args)
+{
+    for (const char* key : PROBABILITY_KEYS) {
+        if (args.has_key(key)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+zero_copy_fault_inject::sptr zero_copy_fault_inject::make(
+    zero_copy_if::sptr transport, const device_addr_t& args)
+{
+    return sptr(new zero_copy_fault_inject_impl(transport, args));
+}
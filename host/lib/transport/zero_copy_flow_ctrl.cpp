@@ -178,6 +178,11 @@ public:
         return _transport->get_send_frame_size();
     }
 
+    void flush_send_buffs(void)
+    {
+        _transport->flush_send_buffs();
+    }
+
 private:
     // The underlying transport
     zero_copy_if::sptr _transport;
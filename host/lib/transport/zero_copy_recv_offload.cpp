@@ -5,22 +5,25 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 //
 
-#include <uhd/transport/bounded_buffer.hpp>
 #include <uhd/transport/buffer_pool.hpp>
 #include <uhd/transport/zero_copy_recv_offload.hpp>
 #include <uhd/utils/log.hpp>
 #include <uhd/utils/safe_call.hpp>
 #include <uhd/utils/thread.hpp>
+#include <uhdlib/transport/spsc_bounded_buffer.hpp>
+#include <uhdlib/utils/event_fd.hpp>
 #include <boost/bind.hpp>
 #include <boost/format.hpp>
 #include <boost/make_shared.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/thread.hpp>
+#include <atomic>
 
 using namespace uhd;
 using namespace uhd::transport;
 
-typedef bounded_buffer<managed_recv_buffer::sptr> bounded_buffer_t;
+// The receive thread is the only producer and get_recv_buff() the only consumer
+typedef spsc_bounded_buffer<managed_recv_buffer::sptr> bounded_buffer_t;
 
 /***********************************************************************
  * Zero copy offload transport:
@@ -32,10 +35,14 @@ class zero_copy_recv_offload_impl : public zero_copy_recv_offload
 public:
     typedef boost::shared_ptr<zero_copy_recv_offload_impl> sptr;
 
-    zero_copy_recv_offload_impl(zero_copy_if::sptr transport, const double timeout)
+    zero_copy_recv_offload_impl(zero_copy_if::sptr transport,
+        const double timeout,
+        const std::vector<size_t>& cpu_affinity)
         : _transport(transport)
         , _timeout(timeout)
+        , _cpu_affinity(cpu_affinity)
         , _inbox(transport->get_num_recv_frames())
+        , _wake_requested(false)
         , _recv_done(false)
     {
         UHD_LOGGER_TRACE("XPORT") << "Created threaded transport";
@@ -73,11 +80,19 @@ public:
     // pulling pointers to managed receiver buffers quickly
     void enqueue_recv()
     {
+        set_thread_affinity(_cpu_affinity);
         while (not is_recv_done()) {
             managed_recv_buffer::sptr buff = _transport->get_recv_buff(_timeout);
             if (not buff)
                 continue;
-            _inbox.push_with_timed_wait(buff, _timeout);
+            if (not _inbox.push_with_timed_wait(buff, _timeout))
+                continue;
+            // Only wake a waiter that asked for it, see get_recv_fd()
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (_wake_requested.load(std::memory_order_relaxed)
+                and _wake_requested.exchange(false)) {
+                _recv_ready.post();
+            }
         }
     }
 
@@ -92,6 +107,22 @@ public:
         return ptr;
     }
 
+    int get_recv_fd(void)
+    {
+        // Drop the wakeups of earlier waits, then ask for one with the next
+        // frame. The caller checks has_recv_buff() after this.
+        while (_recv_ready.try_wait()) {
+        }
+        _wake_requested.store(true);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return _recv_ready.get_fd();
+    }
+
+    bool has_recv_buff(void)
+    {
+        return not _inbox.empty();
+    }
+
     size_t get_num_recv_frames() const
     {
         return _transport->get_num_recv_frames();
@@ -126,21 +157,27 @@ private:
     zero_copy_if::sptr _transport;
 
     const double _timeout;
+    const std::vector<size_t> _cpu_affinity;
 
     // Shared buffers
     bounded_buffer_t _inbox;
 
+    // Readable after a frame was pushed while a waiter asked for a wakeup
+    event_fd _recv_ready;
+    std::atomic<bool> _wake_requested;
+
     // Threading
     bool _recv_done;
     boost::thread _recv_thread;
     boost::mutex _recv_mutex;
 };
 
-zero_copy_recv_offload::sptr zero_copy_recv_offload::make(
-    zero_copy_if::sptr transport, const double timeout)
+zero_copy_recv_offload::sptr zero_copy_recv_offload::make(zero_copy_if::sptr transport,
+    const double timeout,
+    const std::vector<size_t>& cpu_affinity)
 {
     zero_copy_recv_offload_impl::sptr zero_copy_recv_offload(
-        new zero_copy_recv_offload_impl(transport, timeout));
+        new zero_copy_recv_offload_impl(transport, timeout, cpu_affinity));
 
     return zero_copy_recv_offload;
 }
@@ -9,7 +9,6 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/tokenizer.hpp>
 #include <boost/format.hpp>
-#include <boost/regex.hpp>
 #include <stdexcept>
 #include <sstream>
 
@@ -93,12 +92,15 @@ device_addrs_t uhd::separate_device_addr(const device_addr_t &dev_addr){
     device_addrs_t dev_addrs(1); //must be at least one (obviously)
     std::vector<std::string> global_keys; //keys that apply to all (no numerical suffix)
     for(const std::string &key:  dev_addr.keys()){
-        boost::cmatch matches;
-        if (not boost::regex_match(key.c_str(), matches, boost::regex("^(\\D+)(\\d*)$"))){
+        // A name without digits, then an optional index
+        const size_t num_pos = key.find_first_of("0123456789");
+        if (key.empty() or num_pos == 0 or (num_pos != std::string::npos
+                and key.find_first_not_of("0123456789", num_pos) != std::string::npos)){
             throw std::runtime_error("unknown key format: " + key);
         }
-        std::string key_part(matches[1].first, matches[1].second);
-        std::string num_part(matches[2].first, matches[2].second);
+        const std::string key_part = key.substr(0, num_pos);
+        const std::string num_part =
+            (num_pos == std::string::npos) ? std::string() : key.substr(num_pos);
         if (num_part.empty()){ //no number? save it for later
             global_keys.push_back(key);
             continue;
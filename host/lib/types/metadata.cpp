@@ -22,6 +22,9 @@ std::string rx_metadata_t::to_pp_string(bool compact) const
         if (has_time_spec) {
             ss << "Time: " << time_spec.get_real_secs() << " s\n";
         }
+        if (has_host_time_spec) {
+            ss << "Host time: " << host_time_spec.get_real_secs() << " s\n";
+        }
         if (more_fragments) {
             ss << "Fragmentation offset: " << fragment_offset << "\n";
         }
@@ -43,6 +46,9 @@ std::string rx_metadata_t::to_pp_string(bool compact) const
            << "\tEnd of burst: " << (end_of_burst ? "Yes" : "No")
            << "\nError Code: " << strerror()
            << "\tOut of sequence: " << (out_of_sequence ? "Yes" : "No");
+        if (has_host_time_spec) {
+            ss << "\nHost time of first sample: " << host_time_spec.get_real_secs();
+        }
     }
 
     return ss.str();
@@ -69,6 +69,7 @@ void export_metadata(py::module& m)
         // Properties
         .def_readonly("has_time_spec"  , &rx_metadata_t::has_time_spec  )
         .def_readonly("time_spec"      , &rx_metadata_t::time_spec      )
+        .def_readonly("time_ticks"     , &rx_metadata_t::time_ticks     )
         .def_readonly("more_fragments" , &rx_metadata_t::more_fragments )
         .def_readonly("start_of_burst" , &rx_metadata_t::start_of_burst )
         .def_readonly("end_of_burst"   , &rx_metadata_t::end_of_burst   )
@@ -82,6 +83,7 @@ void export_metadata(py::module& m)
         // Properties
         .def_readwrite("has_time_spec" , &tx_metadata_t::has_time_spec )
         .def_readwrite("time_spec"     , &tx_metadata_t::time_spec     )
+        .def_readwrite("time_ticks"    , &tx_metadata_t::time_ticks    )
         .def_readwrite("start_of_burst", &tx_metadata_t::start_of_burst)
         .def_readwrite("end_of_burst"  , &tx_metadata_t::end_of_burst  )
         ;
@@ -146,3 +146,14 @@ void spi_iface::write_spi(
         which_slave, config, data, num_bits, false
     );
 }
+
+void spi_iface::write_spi_list(
+    int which_slave,
+    const spi_config_t &config,
+    const std::vector<uint32_t> &data,
+    size_t num_bits
+){
+    for (const uint32_t word : data) {
+        write_spi(which_slave, config, word, num_bits);
+    }
+}
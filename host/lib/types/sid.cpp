@@ -7,13 +7,74 @@
 
 #include <uhd/types/sid.hpp>
 #include <uhd/exception.hpp>
-#include <uhd/utils/cast.hpp>
 #include <boost/format.hpp>
-#include <boost/regex.hpp>
-#include <boost/lexical_cast.hpp>
+#include <cstring>
 
 using namespace uhd;
 
+namespace {
+
+//! Parse a field of min_digits to max_digits digits at pos, and move pos past it
+bool parse_sid_field(const std::string& str,
+    size_t& pos,
+    const size_t min_digits,
+    const size_t max_digits,
+    const uint32_t base,
+    uint32_t& value)
+{
+    value             = 0;
+    size_t num_digits = 0;
+    for (; pos < str.size() and num_digits < max_digits; pos++, num_digits++) {
+        const char c = str[pos];
+        uint32_t digit;
+        if (c >= '0' and c <= '9') {
+            digit = uint32_t(c - '0');
+        } else if (base == 16 and c >= 'a' and c <= 'f') {
+            digit = uint32_t(c - 'a' + 10);
+        } else if (base == 16 and c >= 'A' and c <= 'F') {
+            digit = uint32_t(c - 'A' + 10);
+        } else {
+            break;
+        }
+        value = value * base + digit;
+    }
+    return num_digits >= min_digits;
+}
+
+//! Check for one of the separators at pos, and move pos past it
+bool parse_sid_separator(const std::string& str, size_t& pos, const char* separators)
+{
+    if (pos >= str.size() or std::strchr(separators, str[pos]) == nullptr) {
+        return false;
+    }
+    pos++;
+    return true;
+}
+
+/*! Parse "A.B>C.D" (decimal) or "AA:BB>CC:DD" (hex) without a regex
+ *
+ * Any of ".:/><" separates the source from the destination.
+ */
+bool parse_sid(const std::string& str,
+    const size_t min_digits,
+    const size_t max_digits,
+    const uint32_t base,
+    uint32_t fields[4])
+{
+    const char* addr_separator = (base == 10) ? "." : ":";
+    size_t pos                 = 0;
+    return parse_sid_field(str, pos, min_digits, max_digits, base, fields[0])
+           and parse_sid_separator(str, pos, addr_separator)
+           and parse_sid_field(str, pos, min_digits, max_digits, base, fields[1])
+           and parse_sid_separator(str, pos, ".:/><")
+           and parse_sid_field(str, pos, min_digits, max_digits, base, fields[2])
+           and parse_sid_separator(str, pos, addr_separator)
+           and parse_sid_field(str, pos, min_digits, max_digits, base, fields[3])
+           and pos == str.size();
+}
+
+} // namespace
+
 sid_t::sid_t()
     : _sid(0x0000), _set(false)
 {
@@ -74,23 +135,12 @@ void sid_t::set_sid(uint32_t new_sid)
 
 void sid_t::set_from_str(const std::string &sid_str)
 {
-    const std::string dec_regex = "(\\d{1,3})\\.(\\d{1,3})[.:/><](\\d{1,3})\\.(\\d{1,3})";
-    const std::string hex_regex = "([[:xdigit:]]{2}):([[:xdigit:]]{2})[.:/><]([[:xdigit:]]{2}):([[:xdigit:]]{2})";
-
-    boost::cmatch matches;
-    if (boost::regex_match(sid_str.c_str(), matches, boost::regex(dec_regex))) {
-        set_src_addr(boost::lexical_cast<size_t>(matches[1]));
-        set_src_endpoint(boost::lexical_cast<size_t>(matches[2]));
-        set_dst_addr(boost::lexical_cast<size_t>(matches[3]));
-        set_dst_endpoint(boost::lexical_cast<size_t>(matches[4]));
-        return;
-    }
-
-    if (boost::regex_match(sid_str.c_str(), matches, boost::regex(hex_regex))) {
-        set_src_addr(uhd::cast::hexstr_cast<size_t>(matches[1]));
-        set_src_endpoint(uhd::cast::hexstr_cast<size_t>(matches[2]));
-        set_dst_addr(uhd::cast::hexstr_cast<size_t>(matches[3]));
-        set_dst_endpoint(uhd::cast::hexstr_cast<size_t>(matches[4]));
+    uint32_t fields[4];
+    if (parse_sid(sid_str, 1, 3, 10, fields) or parse_sid(sid_str, 2, 2, 16, fields)) {
+        set_src_addr(fields[0]);
+        set_src_endpoint(fields[1]);
+        set_dst_addr(fields[2]);
+        set_dst_endpoint(fields[3]);
         return;
     }
 
@@ -9,6 +9,7 @@
 #define INCLUDED_UHD_TIME_SPEC_PYTHON_HPP
 
 #include <uhd/types/time_spec.hpp>
+#include <uhd/types/time_ticks.hpp>
 #include <pybind11/operators.h>
 
 void export_time_spec(py::module& m)
@@ -39,6 +40,29 @@ void export_time_spec(py::module& m)
         .def(py::self + double())
         .def(py::self - double())
         ;
+
+    using time_ticks_t = uhd::time_ticks_t;
+
+    py::class_<time_ticks_t>(m, "time_ticks")
+        // Constructors
+        .def(py::init<>())
+        .def(py::init<int64_t, double>())
+
+        // Methods
+        .def_static("from_time_spec", &time_ticks_t::from_time_spec)
+        .def_static("convert"       , &time_ticks_t::convert       )
+
+        .def("is_valid"    , &time_ticks_t::is_valid    )
+        .def("to_time_spec", &time_ticks_t::to_time_spec)
+        .def("to_rate"     , &time_ticks_t::to_rate     )
+
+        // Properties
+        .def_readwrite("ticks"    , &time_ticks_t::ticks    )
+        .def_readwrite("tick_rate", &time_ticks_t::tick_rate)
+
+        .def(py::self == py::self)
+        .def(py::self != py::self)
+        ;
 }
 
 #endif /* INCLUDED_UHD_TIME_SPEC_PYTHON_HPP */
@@ -0,0 +1,43 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/types/time_ticks.hpp>
+#include <cmath>
+
+using namespace uhd;
+
+namespace {
+
+//! Rates up to here are small enough for the integer conversion below
+constexpr double MAX_INTEGER_RATE = 3e9;
+
+bool is_integer_rate(const double rate)
+{
+    return rate > 0.0 and rate <= MAX_INTEGER_RATE and rate == std::floor(rate);
+}
+
+} // namespace
+
+int64_t time_ticks_t::convert(
+    const int64_t ticks, const double from_rate, const double to_rate)
+{
+    if (from_rate == to_rate) {
+        return ticks;
+    }
+    if (not is_integer_rate(from_rate) or not is_integer_rate(to_rate)) {
+        return time_spec_t::from_ticks(ticks, from_rate).to_ticks(to_rate);
+    }
+    // Split off the full seconds, so the products below can't overflow
+    const int64_t from    = int64_t(from_rate);
+    const int64_t to      = int64_t(to_rate);
+    const bool negative   = ticks < 0;
+    const uint64_t magn   = negative ? uint64_t(0) - uint64_t(ticks) : uint64_t(ticks);
+    const uint64_t secs   = magn / uint64_t(from);
+    const uint64_t remain = magn % uint64_t(from);
+    const uint64_t result =
+        secs * uint64_t(to) + (remain * uint64_t(to) + uint64_t(from) / 2) / uint64_t(from);
+    return negative ? -int64_t(result) : int64_t(result);
+}
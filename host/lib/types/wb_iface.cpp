@@ -7,6 +7,7 @@
 
 #include <uhd/types/wb_iface.hpp>
 #include <uhd/exception.hpp>
+#include <uhd/utils/scope_exit.hpp>
 
 using namespace uhd;
 
@@ -44,3 +45,38 @@ uint16_t wb_iface::peek16(const wb_iface::wb_addr_type)
 {
     throw uhd::not_implemented_error("peek16 not implemented");
 }
+
+void wb_iface::multi_poke32(
+    const std::vector<wb_addr_type>& addrs, const std::vector<uint32_t>& data)
+{
+    UHD_ASSERT_THROW(addrs.size() == data.size());
+    for (size_t i = 0; i < addrs.size(); i++) {
+        this->poke32(addrs[i], data[i]);
+    }
+}
+
+std::vector<uint32_t> wb_iface::multi_peek32(const std::vector<wb_addr_type>& addrs)
+{
+    std::vector<uint32_t> data;
+    data.reserve(addrs.size());
+    for (const wb_addr_type addr : addrs) {
+        data.push_back(this->peek32(addr));
+    }
+    return data;
+}
+
+void timed_wb_iface::poke32_schedule(const std::vector<timed_poke32_t>& writes)
+{
+    const time_spec_t cmd_time = this->get_time();
+    auto time_restorer =
+        uhd::utils::scope_exit::make([this, cmd_time]() { this->set_time(cmd_time); });
+    for (const timed_poke32_t& write : writes) {
+        this->set_time(write.time);
+        this->poke32(write.addr, write.data);
+    }
+}
+
+size_t timed_wb_iface::get_cmd_fifo_size(void)
+{
+    return 0;
+}
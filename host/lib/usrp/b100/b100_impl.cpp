@@ -251,6 +251,11 @@ b100_impl::b100_impl(const device_addr_t &device_addr){
     data_xport_args["num_recv_frames"] = device_addr.get("num_recv_frames", "16");
     data_xport_args["send_frame_size"] = device_addr.get("send_frame_size", "16384");
     data_xport_args["num_send_frames"] = device_addr.get("num_send_frames", "16");
+    for (const std::string key : {"usb_event_thread", "use_dev_mem"}) {
+        if (device_addr.has_key(key)) {
+            data_xport_args[key] = device_addr[key];
+        }
+    }
 
     //let packet padder know the LUT size in number of words32
     const size_t rx_lut_size = size_t(data_xport_args.cast<double>("recv_frame_size", 0.0));
@@ -31,6 +31,16 @@ uint32_t b200_local_spi_core::transact_spi(
     return _spi_core->transact_spi(which_slave, config, data, num_bits, readback);
 }
 
+void b200_local_spi_core::write_spi_list(
+    int which_slave,
+    const uhd::spi_config_t &config,
+    const std::vector<uint32_t> &data,
+    size_t num_bits)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _spi_core->write_spi_list(which_slave, config, data, num_bits);
+}
+
 void b200_local_spi_core::change_perif(perif_t perif)
 {
     std::lock_guard<std::mutex> lock(_mutex);
@@ -0,0 +1,233 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "b200_ctrl_demux.hpp"
+#include "b200_impl.hpp"
+#include <uhd/transport/vrt_if_packet.hpp>
+#include <uhd/utils/byteswap.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhdlib/transport/demux_turns.hpp>
+#include <uhdlib/transport/mpsc_bounded_buffer.hpp>
+#include <uhdlib/usrp/common/async_packet_handler.hpp>
+#include <boost/enable_shared_from_this.hpp>
+#include <boost/weak_ptr.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <mutex>
+
+using namespace uhd;
+using namespace uhd::transport;
+
+namespace {
+
+//! Smallest frame that holds a SID
+constexpr size_t MIN_FRAME_SIZE = 8;
+//! Most responses kept for control cores that are being destroyed
+constexpr size_t MAX_STRANDED_RESPONSES = 16;
+
+//! The part of a response that radio_ctrl_core_3000::push_response() reads
+typedef std::array<uint32_t, 8> resp_buff_type;
+
+} // namespace
+
+class b200_ctrl_demux_impl : public b200_ctrl_demux,
+                             public boost::enable_shared_from_this<b200_ctrl_demux_impl>
+{
+public:
+    b200_ctrl_demux_impl(zero_copy_if::sptr xport)
+        : _xport(xport), _async_md(1000 /*messages deep*/), _tick_rate(1.0)
+    {
+        /*NOP*/
+    }
+
+    void add_ctrl(const uint32_t resp_sid, radio_ctrl_core_3000::sptr ctrl)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_demux_mutex);
+            _ctrls[resp_sid] = ctrl;
+        }
+        // The pump is only called by the control core that holds it, so the
+        // raw pointer is valid whenever it is used, even during destruction.
+        boost::shared_ptr<b200_ctrl_demux_impl> self = shared_from_this();
+        radio_ctrl_core_3000* own_ctrl               = ctrl.get();
+        ctrl->set_response_pump([self, resp_sid, own_ctrl](double timeout) {
+            return self->pump_for_ctrl(resp_sid, own_ctrl, timeout);
+        });
+    }
+
+    void set_gpsdo_uart(b200_uart::sptr uart)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_demux_mutex);
+            _gpsdo_uart = uart;
+        }
+        boost::shared_ptr<b200_ctrl_demux_impl> self = shared_from_this();
+        uart->set_recv_pump([self](double timeout) { return self->pump(timeout); });
+    }
+
+    void set_tick_rate(const double rate)
+    {
+        _tick_rate.store(rate, std::memory_order_relaxed);
+    }
+
+    bool pump(const double timeout)
+    {
+        return _pump(timeout, 0, nullptr);
+    }
+
+    bool recv_async_msg(async_metadata_t& async_metadata, const double timeout)
+    {
+        return pop_with_demux_turns(_async_md,
+            async_metadata,
+            timeout,
+            [this](const double slice) { return _pump(slice, 0, nullptr); });
+    }
+
+private:
+    bool pump_for_ctrl(
+        const uint32_t own_sid, radio_ctrl_core_3000* own_ctrl, const double timeout)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_stranded_mutex);
+            for (auto it = _stranded.begin(); it != _stranded.end(); ++it) {
+                if (it->first == own_sid) {
+                    own_ctrl->push_response(it->second.data());
+                    _stranded.erase(it);
+                    return true;
+                }
+            }
+        }
+        return _pump(timeout, own_sid, own_ctrl);
+    }
+
+    /*!
+     * Dispatch up to DEMUX_BATCH frames. Only waits for the first one.
+     * Responses with \p own_sid go to \p own_ctrl, which is the caller.
+     */
+    bool _pump(
+        const double timeout, const uint32_t own_sid, radio_ctrl_core_3000* own_ctrl)
+    {
+        std::unique_lock<std::mutex> lock(_demux_mutex, std::try_to_lock);
+        if (not lock.owns_lock()) {
+            return false;
+        }
+        managed_recv_buffer::sptr buff = _xport->get_recv_buff(timeout);
+        for (size_t i = 0; buff and i < DEMUX_BATCH; i++) {
+            _dispatch(buff, own_sid, own_ctrl);
+            buff.reset();
+            if (i + 1 < DEMUX_BATCH) {
+                buff = _xport->get_recv_buff(0.0);
+            }
+        }
+        return true;
+    }
+
+    //! Must hold the demux mutex
+    void _dispatch(managed_recv_buffer::sptr buff,
+        const uint32_t own_sid,
+        radio_ctrl_core_3000* own_ctrl)
+    {
+        if (buff->size() < MIN_FRAME_SIZE) {
+            return;
+        }
+        const uint32_t* packet_buff = buff->cast<const uint32_t*>();
+        const uint32_t sid          = uhd::wtohx(packet_buff[1]);
+        switch (sid) {
+            // if the packet is a control response
+            case B200_RESP0_MSG_SID:
+            case B200_RESP1_MSG_SID:
+            case B200_LOCAL_RESP_SID: {
+                if (own_ctrl and sid == own_sid) {
+                    own_ctrl->push_response(packet_buff);
+                    break;
+                }
+                radio_ctrl_core_3000::sptr ctrl = _ctrls[sid].lock();
+                if (ctrl) {
+                    ctrl->push_response(packet_buff);
+                } else {
+                    // The control core is being destroyed and still waits
+                    // for its last responses, keep them for its pump
+                    resp_buff_type resp_buff = {};
+                    std::memcpy(resp_buff.data(),
+                        packet_buff,
+                        std::min(buff->size(), sizeof(resp_buff)));
+                    std::lock_guard<std::mutex> lock(_stranded_mutex);
+                    if (_stranded.size() == MAX_STRANDED_RESPONSES) {
+                        _stranded.pop_front();
+                    }
+                    _stranded.emplace_back(sid, resp_buff);
+                }
+                break;
+            }
+
+            // if the packet is a uart message
+            case B200_RX_GPS_UART_SID: {
+                b200_uart::sptr uart = _gpsdo_uart.lock();
+                if (uart) {
+                    uart->handle_uart_packet(buff);
+                }
+                break;
+            }
+
+            // or maybe the packet is a TX async message
+            case B200_TX_MSG0_SID:
+            case B200_TX_MSG1_SID: {
+                const size_t i = (sid == B200_TX_MSG0_SID) ? 0 : 1;
+
+                // extract packet info
+                vrt::if_packet_info_t if_packet_info;
+                if_packet_info.link_type          = vrt::if_packet_info_t::LINK_TYPE_CHDR;
+                if_packet_info.num_packet_words32 = buff->size() / sizeof(uint32_t);
+
+                // unpacking can fail
+                try {
+                    vrt::if_hdr_unpack_le(packet_buff, if_packet_info);
+                } catch (const std::exception& ex) {
+                    UHD_LOGGER_ERROR("B200")
+                        << "Error parsing ctrl packet: " << ex.what();
+                    break;
+                }
+
+                // fill in the async metadata
+                async_metadata_t metadata;
+                usrp::load_metadata_from_buff(uhd::wtohx<uint32_t>,
+                    metadata,
+                    if_packet_info,
+                    packet_buff,
+                    _tick_rate.load(std::memory_order_relaxed),
+                    i);
+                _async_md.push_with_haste(metadata);
+                usrp::standard_async_msg_prints(metadata);
+                break;
+            }
+
+            // doh!
+            default:
+                UHD_LOGGER_ERROR("B200") << "Got a ctrl packet with unknown SID " << sid;
+        }
+    }
+
+    const zero_copy_if::sptr _xport;
+    //! Held by the thread that dispatches, also guards the targets below
+    std::mutex _demux_mutex;
+    std::map<uint32_t, boost::weak_ptr<radio_ctrl_core_3000>> _ctrls;
+    boost::weak_ptr<b200_uart> _gpsdo_uart;
+    //! Filled by the dispatching thread, emptied by one consumer
+    mpsc_bounded_buffer<async_metadata_t> _async_md;
+    std::atomic<double> _tick_rate;
+    //! Responses for control cores that were already released
+    std::mutex _stranded_mutex;
+    std::deque<std::pair<uint32_t, resp_buff_type>> _stranded;
+};
+
+b200_ctrl_demux::sptr b200_ctrl_demux::make(zero_copy_if::sptr xport)
+{
+    return sptr(new b200_ctrl_demux_impl(xport));
+}
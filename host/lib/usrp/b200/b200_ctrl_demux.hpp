@@ -0,0 +1,60 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_B200_CTRL_DEMUX_HPP
+#define INCLUDED_B200_CTRL_DEMUX_HPP
+
+#include "b200_uart.hpp"
+#include <uhd/transport/zero_copy.hpp>
+#include <uhd/types/metadata.hpp>
+#include <uhd/utils/noncopyable.hpp>
+#include <uhdlib/usrp/cores/radio_ctrl_core_3000.hpp>
+#include <boost/shared_ptr.hpp>
+
+/*!
+ * Demuxes the control transport into control responses, TX async messages
+ * and GPSDO UART packets.
+ *
+ * There is no demux thread. Threads that wait for something that comes over
+ * the transport pull from it themselves: the control cores while they wait
+ * for a response, recv_async_msg(), the UART reader, and the TX streamers
+ * between packets (without blocking). The thread that gets the demux mutex
+ * dispatches every frame it pulls, the others wait on their own queues in the
+ * meantime. Nothing runs while the device is idle, and a response usually
+ * goes straight to the thread that waits for it.
+ */
+class b200_ctrl_demux : uhd::noncopyable
+{
+public:
+    typedef boost::shared_ptr<b200_ctrl_demux> sptr;
+
+    static sptr make(uhd::transport::zero_copy_if::sptr xport);
+
+    //! Deliver the responses with \p resp_sid to \p ctrl and set its response pump
+    virtual void add_ctrl(const uint32_t resp_sid, radio_ctrl_core_3000::sptr ctrl) = 0;
+
+    //! Deliver the GPSDO UART packets to \p uart and set its receive pump
+    virtual void set_gpsdo_uart(b200_uart::sptr uart) = 0;
+
+    //! Set the tick rate of the TX async message time stamps
+    virtual void set_tick_rate(const double rate) = 0;
+
+    /*!
+     * Dispatch the frames that are waiting on the transport.
+     * \param timeout the time to wait for the first frame
+     * \return false if another thread is dispatching
+     */
+    virtual bool pump(const double timeout) = 0;
+
+    /*!
+     * Receive a TX async message. The messages are kept in a lock-free queue,
+     * so don't call this from more than one thread at a time.
+     */
+    virtual bool recv_async_msg(
+        uhd::async_metadata_t& async_metadata, const double timeout) = 0;
+};
+
+#endif /* INCLUDED_B200_CTRL_DEMUX_HPP */
@@ -54,6 +54,8 @@ const static uint8_t B200_VREQ_GET_FPGA_HASH = 0x1D;
 const static uint8_t B200_VREQ_SET_FW_HASH = 0x1E;
 const static uint8_t B200_VREQ_GET_FW_HASH = 0x1F;
 const static uint8_t B200_VREQ_LOOP = 0x22;
+const static uint8_t B200_VREQ_GET_CONFIG = 0x28;
+const static uint8_t B200_VREQ_SET_DATA_DMA = 0x32;
 const static uint8_t B200_VREQ_FPGA_CONFIG = 0x55;
 //const static uint8_t B200_VREQ_FPGA_RESET = 0x62;
 const static uint8_t B200_VREQ_GPIF_RESET = 0x72;
@@ -277,6 +279,47 @@ public:
         */
     }
 
+    void set_data_dma_config(const size_t buffer_size, const size_t buffer_count) {
+        unsigned char data[4];
+        memset(data, 0x00, sizeof(data));
+        const int bytes_to_send = sizeof(data);
+
+        int ret = fx3_control_write(B200_VREQ_SET_DATA_DMA, uint16_t(buffer_size / 1024), uint16_t(buffer_count), data, bytes_to_send);
+        if (ret < 0)
+            throw uhd::io_error((boost::format("Failed to set data DMA config (%d: %s)") % ret % libusb_error_name(ret)).str());
+        else if (ret != bytes_to_send)
+            throw uhd::io_error((boost::format("Short write on set data DMA config (expecting: %d, returned: %d)") % bytes_to_send % ret).str());
+
+        // The FX3 rebuilds its DMA channels in the background and reports
+        // being busy until it is done
+        size_t wait_count = 0;
+        while (get_fx3_status() == FX3_STATE_BUSY) {
+            if (wait_count++ >= 100)
+                throw uhd::io_error("Timeout while the FX3 set up its data DMA buffers");
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+
+    std::pair<size_t, size_t> get_data_dma_config(void) {
+        // The FX3 config is a struct of 9 little endian 32-bit ints, the
+        // DMA buffer size and count are the 6th and 7th
+        unsigned char rx_data[36];
+        memset(rx_data, 0x00, sizeof(rx_data));
+        const int bytes_to_recv = sizeof(rx_data);
+
+        int ret = fx3_control_read(B200_VREQ_GET_CONFIG, 0x00, 0x00, rx_data, bytes_to_recv);
+        if (ret < 0)
+            throw uhd::io_error((boost::format("Failed to get FX3 config (%d: %s)") % ret % libusb_error_name(ret)).str());
+        else if (ret != bytes_to_recv)
+            throw uhd::io_error((boost::format("Short read on get FX3 config (expecting: %d, returned: %d)") % bytes_to_recv % ret).str());
+
+        auto get_int = [&rx_data](const size_t index) {
+            const unsigned char* p = rx_data + 4 * index;
+            return size_t(p[0]) | (size_t(p[1]) << 8) | (size_t(p[2]) << 16) | (size_t(p[3]) << 24);
+        };
+        return std::make_pair(get_int(5), get_int(6));
+    }
+
     uint8_t get_usb_speed(void) {
 
         unsigned char rx_data[1];
@@ -16,6 +16,7 @@
 #include <boost/shared_ptr.hpp>
 #include <uhd/utils/noncopyable.hpp>
 #include <stdint.h>
+#include <utility>
 
 enum b200_product_t {
     B200,
@@ -97,6 +98,16 @@ public:
     //! get the current status of the FX3
     virtual uint16_t get_compat_num(void) = 0;
 
+    /*!
+     * Ask the FX3 for data DMA buffers of \p buffer_size bytes (a multiple of
+     * 1024), \p buffer_count of them per direction. The FX3 keeps its buffers
+     * if it does not support the request, so check get_data_dma_config().
+     */
+    virtual void set_data_dma_config(const size_t buffer_size, const size_t buffer_count) = 0;
+
+    //! get the size (first) and number (second) of the FX3 data DMA buffers
+    virtual std::pair<size_t, size_t> get_data_dma_config(void) = 0;
+
     //! load a firmware image
     virtual void load_firmware(const std::string filestring, bool force=false) = 0;
 
@@ -25,6 +25,7 @@
 #include <cstdio>
 #include <ctime>
 #include <cmath>
+#include <algorithm>
 #include <chrono>
 
 #include "../../transport/libusb1_base.hpp"
@@ -426,11 +427,40 @@ b200_impl::b200_impl(const uhd::device_addr_t& device_addr, usb_device_handle::s
 
     _iface->reset_gpif();
 
+    uint8_t usb_speed = _iface->get_usb_speed();
+    UHD_LOGGER_INFO("B200") << "Operating over USB " << (int) usb_speed << "." ;
+
+    ////////////////////////////////////////////////////////////////////
+    // Set up the FX3 data DMA buffers
+    // More and larger buffers keep data flowing while the host is late.
+    // This rebuilds all FX3 DMA channels, so it happens before any
+    // transport is created.
+    ////////////////////////////////////////////////////////////////////
+    int max_recv_frame_size = B200_USB_DATA_MAX_RECV_FRAME_SIZE;
+    if (usb_speed == 3) {
+        const uint8_t fw_compat_minor = _iface->get_compat_num() & 0xFF;
+        if (fw_compat_minor >= B200_FW_DATA_DMA_COMPAT_NUM_MINOR) {
+            _iface->set_data_dma_config(
+                device_addr.cast<size_t>(
+                    "fx3_dma_buffer_size", B200_USB_DATA_DEFAULT_DMA_BUFFER_SIZE),
+                device_addr.cast<size_t>(
+                    "fx3_dma_buffer_count", B200_USB_DATA_DEFAULT_DMA_BUFFER_COUNT));
+        } else if (device_addr.has_key("fx3_dma_buffer_size")
+                   or device_addr.has_key("fx3_dma_buffer_count")) {
+            UHD_LOGGER_WARNING("B200")
+                << "The firmware cannot change the FX3 DMA buffers. Ignoring "
+                << "fx3_dma_buffer_size and fx3_dma_buffer_count.";
+        }
+        const std::pair<size_t, size_t> dma_config = _iface->get_data_dma_config();
+        UHD_LOGGER_DEBUG("B200") << "FX3 data DMA buffers: " << dma_config.second
+                                 << " x " << dma_config.first << " bytes";
+        max_recv_frame_size = std::max(max_recv_frame_size,
+            int(dma_config.first) - B200_USB_DATA_DMA_BUFFER_MARGIN);
+    }
+
     ////////////////////////////////////////////////////////////////////
     // Create control transport
     ////////////////////////////////////////////////////////////////////
-    uint8_t usb_speed = _iface->get_usb_speed();
-    UHD_LOGGER_INFO("B200") << "Operating over USB " << (int) usb_speed << "." ;
     const std::string min_frame_size = (usb_speed == 3) ? "1024" : "512";
 
     device_addr_t ctrl_xport_args;
@@ -450,22 +480,20 @@ b200_impl::b200_impl(const uhd::device_addr_t& device_addr, usb_device_handle::s
     _tree->create<double>(mb_path / "link_max_rate").set((usb_speed == 3) ? B200_MAX_RATE_USB3 : B200_MAX_RATE_USB2);
 
     ////////////////////////////////////////////////////////////////////
-    // Async task structure
+    // Control transport demuxer (no thread, its users pull from it)
     ////////////////////////////////////////////////////////////////////
-    _async_task_data.reset(new AsyncTaskData());
-    _async_task_data->async_md.reset(new async_md_type(1000/*messages deep*/));
+    _ctrl_demux = b200_ctrl_demux::make(_ctrl_transport);
     if (_gpsdo_capable)
     {
-        _async_task_data->gpsdo_uart = b200_uart::make(_ctrl_transport, B200_TX_GPS_UART_SID);
+        _gpsdo_uart = b200_uart::make(_ctrl_transport, B200_TX_GPS_UART_SID);
+        _ctrl_demux->set_gpsdo_uart(_gpsdo_uart);
     }
-    _async_task = uhd::msg_task::make(boost::bind(&b200_impl::handle_async_task, this, _ctrl_transport, _async_task_data));
 
     ////////////////////////////////////////////////////////////////////
     // Local control endpoint
     ////////////////////////////////////////////////////////////////////
     _local_ctrl = radio_ctrl_core_3000::make(false/*lilE*/, _ctrl_transport, zero_copy_if::sptr()/*null*/, B200_LOCAL_CTRL_SID);
-    _local_ctrl->hold_task(_async_task);
-    _async_task_data->local_ctrl = _local_ctrl; //weak
+    _ctrl_demux->add_ctrl(B200_LOCAL_RESP_SID, _local_ctrl);
     this->check_fpga_compat();
 
     /* Initialize the GPIOs, set the default bandsels to the lower range. Note
@@ -484,7 +512,7 @@ b200_impl::b200_impl(const uhd::device_addr_t& device_addr, usb_device_handle::s
             UHD_LOGGER_INFO("B200") << "Detecting internal GPSDO.... " << std::flush;
             try
             {
-                _gps = gps_ctrl::make(_async_task_data->gpsdo_uart);
+                _gps = gps_ctrl::make(_gpsdo_uart);
             }
             catch(std::exception &e)
             {
@@ -531,12 +559,12 @@ b200_impl::b200_impl(const uhd::device_addr_t& device_addr, usb_device_handle::s
             << " is too small. It will be set to "
             << B200_USB_DATA_MIN_RECV_FRAME_SIZE << ".";
         recv_frame_size = B200_USB_DATA_MIN_RECV_FRAME_SIZE;
-    } else if (recv_frame_size > B200_USB_DATA_MAX_RECV_FRAME_SIZE) {
+    } else if (recv_frame_size > max_recv_frame_size) {
         UHD_LOGGER_WARNING("B200")
             << "Requested recv_frame_size of " << recv_frame_size
             << " is too large. It will be set to "
-            << B200_USB_DATA_MAX_RECV_FRAME_SIZE << ".";
-        recv_frame_size = B200_USB_DATA_MAX_RECV_FRAME_SIZE;
+            << max_recv_frame_size << ".";
+        recv_frame_size = max_recv_frame_size;
     } else if (recv_frame_size % max_transfer == 0 or recv_frame_size % 8 != 0) {
         // The Cypress FX3 does not properly handle recv_frame_sizes that are
         // aligned to the maximum transfer size and the FPGA code requires the
@@ -562,6 +590,11 @@ b200_impl::b200_impl(const uhd::device_addr_t& device_addr, usb_device_handle::s
     data_xport_args["num_recv_frames"] = device_addr.get("num_recv_frames", "16");
     data_xport_args["send_frame_size"] = device_addr.get("send_frame_size", std::to_string(B200_USB_DATA_DEFAULT_FRAME_SIZE));
     data_xport_args["num_send_frames"] = device_addr.get("num_send_frames", "16");
+    for (const std::string key : {"usb_event_thread", "use_dev_mem"}) {
+        if (device_addr.has_key(key)) {
+            data_xport_args[key] = device_addr[key];
+        }
+    }
 
     // This may throw a uhd::usb_error, which will be caught by b200_make().
     _data_transport = usb_zero_copy::make(
@@ -674,6 +707,9 @@ b200_impl::b200_impl(const uhd::device_addr_t& device_addr, usb_device_handle::s
         .set_publisher(boost::bind(&time_core_3000::get_time_now, _radio_perifs[0].time64))
         .add_coerced_subscriber(boost::bind(&b200_impl::set_time, this, _1))
         .set(0.0);
+    _radio_perifs[0].time64->set_time_model(device_addr.cast<double>("time_model_error", 0.0));
+    _tree->create<double>(mb_path / "time" / "now_error")
+        .set_publisher(boost::bind(&time_core_3000::get_time_error, _radio_perifs[0].time64));
     //re-sync the times when the tick rate changes
     _tree->access<double>(mb_path / "tick_rate")
         .add_coerced_subscriber(boost::bind(&b200_impl::sync_times, this));
@@ -788,10 +824,7 @@ b200_impl::b200_impl(const uhd::device_addr_t& device_addr, usb_device_handle::s
 
 b200_impl::~b200_impl(void)
 {
-    UHD_SAFE_CALL
-    (
-         _async_task.reset();
-    )
+    /* NOP */
 }
 
 /***********************************************************************
@@ -815,8 +848,8 @@ void b200_impl::setup_radio(const size_t dspno)
             _ctrl_transport,
             zero_copy_if::sptr()/*null*/,
             sid);
-    perif.ctrl->hold_task(_async_task);
-    _async_task_data->radio_ctrl[dspno] = perif.ctrl; //weak
+    _ctrl_demux->add_ctrl(
+        (dspno == 0) ? B200_RESP0_MSG_SID : B200_RESP1_MSG_SID, perif.ctrl);
     _tree->access<time_spec_t>(mb_path / "time" / "cmd")
         .add_coerced_subscriber(boost::bind(&radio_ctrl_core_3000::set_time, perif.ctrl, _1));
     _tree->access<double>(mb_path / "tick_rate")
@@ -10,6 +10,7 @@
 
 #include "b200_iface.hpp"
 #include "b200_uart.hpp"
+#include "b200_ctrl_demux.hpp"
 #include "b200_cores.hpp"
 #include <uhd/device.hpp>
 #include <uhd/property_tree.hpp>
@@ -41,7 +42,9 @@
 #include <mutex>
 
 static const uint8_t  B200_FW_COMPAT_NUM_MAJOR = 8;
-static const uint8_t  B200_FW_COMPAT_NUM_MINOR = 0;
+static const uint8_t  B200_FW_COMPAT_NUM_MINOR = 1;
+//! First firmware minor version that lets the host set the data DMA buffers
+static const uint8_t  B200_FW_DATA_DMA_COMPAT_NUM_MINOR = 1;
 static const uint16_t B200_FPGA_COMPAT_NUM = 16;
 static const uint16_t B205_FPGA_COMPAT_NUM = 7;
 static const double          B200_BUS_CLOCK_RATE = 100e6;
@@ -87,6 +90,11 @@ static const int B200_USB_DATA_DEFAULT_FRAME_SIZE = 8176;
 // recv_frame_size values below this will be upped to this value
 static const int B200_USB_DATA_MIN_RECV_FRAME_SIZE = 40;
 static const int B200_USB_DATA_MAX_RECV_FRAME_SIZE = 16360;
+// recv_frame_size values must leave this much room in an FX3 data DMA buffer
+static const int B200_USB_DATA_DMA_BUFFER_MARGIN = 24;
+// FX3 data DMA buffers asked for over USB 3, see fx3_dma_buffer_size/count
+static const int B200_USB_DATA_DEFAULT_DMA_BUFFER_SIZE  = 16384;
+static const int B200_USB_DATA_DEFAULT_DMA_BUFFER_COUNT = 4;
 
 /*
  * VID/PID pairs for all B2xx products
@@ -153,17 +161,8 @@ private:
     std::mutex _transport_setup_mutex;
 
     //async ctrl + msgs
-    uhd::msg_task::sptr _async_task;
-    typedef uhd::transport::bounded_buffer<uhd::async_metadata_t> async_md_type;
-    struct AsyncTaskData
-    {
-        boost::shared_ptr<async_md_type> async_md;
-        boost::weak_ptr<radio_ctrl_core_3000> local_ctrl;
-        boost::weak_ptr<radio_ctrl_core_3000> radio_ctrl[2];
-        b200_uart::sptr gpsdo_uart;
-    };
-    boost::shared_ptr<AsyncTaskData> _async_task_data;
-    boost::optional<uhd::msg_task::msg_type_t> handle_async_task(uhd::transport::zero_copy_if::sptr, boost::shared_ptr<AsyncTaskData>);
+    b200_ctrl_demux::sptr _ctrl_demux;
+    b200_uart::sptr _gpsdo_uart;
 
     void register_loopback_self_test(uhd::wb_iface::sptr iface);
     void set_mb_eeprom(const uhd::usrp::mboard_eeprom_t &);
@@ -10,7 +10,6 @@
 #include "b200_impl.hpp"
 #include "b200_regs.hpp"
 #include <uhd/utils/math.hpp>
-#include <uhdlib/usrp/common/async_packet_handler.hpp>
 #include <uhdlib/usrp/common/validate_subdev_spec.hpp>
 #include <boost/bind.hpp>
 #include <boost/make_shared.hpp>
@@ -140,6 +139,7 @@ void b200_impl::set_auto_tick_rate(
 void b200_impl::update_tick_rate(const double new_tick_rate)
 {
     check_tick_rate_with_current_streamers(new_tick_rate);
+    _ctrl_demux->set_tick_rate(new_tick_rate);
 
     for (radio_perifs_t& perif : _radio_perifs) {
         boost::shared_ptr<sph::recv_packet_streamer> my_streamer =
@@ -299,91 +299,7 @@ static void b200_if_hdr_pack_le(
  **********************************************************************/
 bool b200_impl::recv_async_msg(async_metadata_t& async_metadata, double timeout)
 {
-    return _async_task_data->async_md->pop_with_timed_wait(async_metadata, timeout);
-}
-
-/*
- * This method is constantly called in a msg_task loop.
- * Incoming messages are dispatched in to the hosts radio_ctrl_cores.
- * The radio_ctrl_core queues are accessed via a weak_ptr to them, stored in
- * AsyncTaskData. During shutdown the radio_ctrl_core dtor's are called. An empty
- * peek32(0) is sent out to flush pending async messages. The response to those messages
- * can't be delivered to the ctrl_core queues anymore because the shared pointer
- * corresponding to the weak_ptrs is no longer valid. Those stranded messages are put into
- * a dump_queue implemented in msg_task. A radio_ctrl_core can search for missing messages
- * there.
- */
-boost::optional<uhd::msg_task::msg_type_t> b200_impl::handle_async_task(
-    uhd::transport::zero_copy_if::sptr xport, boost::shared_ptr<AsyncTaskData> data)
-{
-    managed_recv_buffer::sptr buff = xport->get_recv_buff();
-    if (not buff or buff->size() < 8)
-        return boost::none;
-
-    const uint32_t sid = uhd::wtohx(buff->cast<const uint32_t*>()[1]);
-    switch (sid) {
-        // if the packet is a control response
-        case B200_RESP0_MSG_SID:
-        case B200_RESP1_MSG_SID:
-        case B200_LOCAL_RESP_SID: {
-            radio_ctrl_core_3000::sptr ctrl;
-            if (sid == B200_RESP0_MSG_SID)
-                ctrl = data->radio_ctrl[0].lock();
-            if (sid == B200_RESP1_MSG_SID)
-                ctrl = data->radio_ctrl[1].lock();
-            if (sid == B200_LOCAL_RESP_SID)
-                ctrl = data->local_ctrl.lock();
-            if (ctrl) {
-                ctrl->push_response(buff->cast<const uint32_t*>());
-            } else {
-                return std::make_pair(sid,
-                    uhd::msg_task::buff_to_vector(buff->cast<uint8_t*>(), buff->size()));
-            }
-            break;
-        }
-
-        // if the packet is a uart message
-        case B200_RX_GPS_UART_SID: {
-            data->gpsdo_uart->handle_uart_packet(buff);
-            break;
-        }
-
-        // or maybe the packet is a TX async message
-        case B200_TX_MSG0_SID:
-        case B200_TX_MSG1_SID: {
-            const size_t i = (sid == B200_TX_MSG0_SID) ? 0 : 1;
-
-            // extract packet info
-            vrt::if_packet_info_t if_packet_info;
-            if_packet_info.num_packet_words32 = buff->size() / sizeof(uint32_t);
-            const uint32_t* packet_buff       = buff->cast<const uint32_t*>();
-
-            // unpacking can fail
-            try {
-                b200_if_hdr_unpack_le(packet_buff, if_packet_info);
-            } catch (const std::exception& ex) {
-                UHD_LOGGER_ERROR("B200") << "Error parsing ctrl packet: " << ex.what();
-                break;
-            }
-
-            // fill in the async metadata
-            async_metadata_t metadata;
-            load_metadata_from_buff(uhd::wtohx<uint32_t>,
-                metadata,
-                if_packet_info,
-                packet_buff,
-                _tick_rate,
-                i);
-            data->async_md->push_with_pop_on_full(metadata);
-            standard_async_msg_prints(metadata);
-            break;
-        }
-
-        // doh!
-        default:
-            UHD_LOGGER_ERROR("B200") << "Got a ctrl packet with unknown SID " << sid;
-    }
-    return boost::none;
+    return _ctrl_demux->recv_async_msg(async_metadata, timeout);
 }
 
 /***********************************************************************
@@ -450,6 +366,11 @@ rx_streamer::sptr b200_impl::get_rx_stream(const uhd::stream_args_t& args_)
         id.output_format = args.cpu_format;
         id.num_outputs   = 1;
         my_streamer->set_converter(id);
+        if (args.args.has_key("signal_stats")
+            and not my_streamer->enable_signal_stats()) {
+            UHD_LOGGER_WARNING("B200")
+                << "signal_stats is not supported for " << id.to_pp_string();
+        }
 
         perif.framer->clear();
         perif.framer->set_nsamps_per_packet(spp);
@@ -574,10 +495,18 @@ tx_streamer::sptr b200_impl::get_tx_stream(const uhd::stream_args_t& args_)
         perif.deframer->setup(args);
         perif.duc->setup(args);
 
+        // Nobody else pulls in the async messages while the application only
+        // sends, so check for them between packets, without blocking
+        zero_copy_if::sptr data_transport = _data_transport;
+        b200_ctrl_demux::sptr ctrl_demux  = _ctrl_demux;
         my_streamer->set_xport_chan_get_buff(
-            stream_i, boost::bind(&zero_copy_if::get_send_buff, _data_transport, _1));
-        my_streamer->set_async_receiver(boost::bind(
-            &async_md_type::pop_with_timed_wait, _async_task_data->async_md, _1, _2));
+            stream_i, [data_transport, ctrl_demux](double timeout) {
+                managed_send_buffer::sptr buff = data_transport->get_send_buff(timeout);
+                ctrl_demux->pump(0.0);
+                return buff;
+            });
+        my_streamer->set_async_receiver(
+            boost::bind(&b200_ctrl_demux::recv_async_msg, _ctrl_demux, _1, _2));
         my_streamer->set_xport_chan_sid(
             stream_i, true, radio_index ? B200_TX_DATA1_SID : B200_TX_DATA0_SID);
         my_streamer->set_enable_trailer(false); // TODO not implemented trailer support
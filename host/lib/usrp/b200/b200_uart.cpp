@@ -13,6 +13,7 @@
 #include <uhd/utils/log.hpp>
 #include <uhd/types/time_spec.hpp>
 #include <uhd/exception.hpp>
+#include <uhdlib/transport/demux_turns.hpp>
 
 using namespace uhd;
 using namespace uhd::transport;
@@ -67,10 +68,20 @@ struct b200_uart_impl : b200_uart
     std::string read_uart(double timeout)
     {
         std::string line;
-        _line_queue.pop_with_timed_wait(line, timeout);
+        if (not _recv_pump)
+        {
+            _line_queue.pop_with_timed_wait(line, timeout);
+            return line;
+        }
+        pop_with_demux_turns(_line_queue, line, timeout, _recv_pump);
         return line;
     }
 
+    void set_recv_pump(const std::function<bool(double)> &pump)
+    {
+        _recv_pump = pump;
+    }
+
     void handle_uart_packet(managed_recv_buffer::sptr buff)
     {
         const uint32_t *packet_buff = buff->cast<const uint32_t *>();
@@ -93,6 +104,7 @@ struct b200_uart_impl : b200_uart
     size_t _baud_div;
     bounded_buffer<std::string> _line_queue;
     std::string _line;
+    std::function<bool(double)> _recv_pump;
 };
 
 
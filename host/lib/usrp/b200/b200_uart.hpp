@@ -13,6 +13,7 @@
 #include <uhd/types/serial.hpp> //uart iface
 #include <uhd/utils/noncopyable.hpp>
 #include <boost/shared_ptr.hpp>
+#include <functional>
 
 class b200_uart: uhd::noncopyable, public uhd::uart_iface
 {
@@ -20,6 +21,13 @@ public:
     typedef boost::shared_ptr<b200_uart> sptr;
     static sptr make(uhd::transport::zero_copy_if::sptr, const uint32_t sid);
     virtual void handle_uart_packet(uhd::transport::managed_recv_buffer::sptr buff) = 0;
+
+    /*!
+     * Let read_uart() pull the UART packets in while it waits. The pump is
+     * called with the time it may block, and returns false if it can't pull
+     * right now.
+     */
+    virtual void set_recv_pump(const std::function<bool(double)> &pump) = 0;
 };
 
 
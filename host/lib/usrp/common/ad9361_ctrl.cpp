@@ -55,21 +55,44 @@ public:
     virtual void poke8(uint32_t reg, uint8_t val)
     {
         std::lock_guard<std::mutex> lock(_mutex);
+        _spi_iface->write_spi(_slave_num,
+            _get_spi_config(),
+            _get_write_word(reg, val),
+            AD9361_SPI_NUM_BITS);
+    }
+
+    virtual void poke8_list(const write_list_t& writes)
+    {
+        // Hold the lock for the whole list, so the indirect programming
+        // sequences aren't interleaved with other register accesses
+        std::lock_guard<std::mutex> lock(_mutex);
+        std::vector<uint32_t> words;
+        words.reserve(writes.size());
+        for (const auto& write : writes) {
+            words.push_back(_get_write_word(write.first, write.second));
+        }
+        _spi_iface->write_spi_list(
+            _slave_num, _get_spi_config(), words, AD9361_SPI_NUM_BITS);
+    }
 
+private:
+    static uhd::spi_config_t _get_spi_config()
+    {
         uhd::spi_config_t config;
         config.mosi_edge = uhd::spi_config_t::EDGE_FALL;
         config.miso_edge =
             uhd::spi_config_t::EDGE_FALL; // TODO (Ashish): FPGA SPI workaround. This
                                           // should be EDGE_RISE
+        return config;
+    }
 
-        uint32_t wr_word =
-            AD9361_SPI_WRITE_CMD
-            | ((uint32_t(reg) << AD9361_SPI_ADDR_SHIFT) & AD9361_SPI_ADDR_MASK)
-            | ((uint32_t(val) << AD9361_SPI_DATA_SHIFT) & AD9361_SPI_DATA_MASK);
-        _spi_iface->write_spi(_slave_num, config, wr_word, AD9361_SPI_NUM_BITS);
+    static uint32_t _get_write_word(uint32_t reg, uint8_t val)
+    {
+        return AD9361_SPI_WRITE_CMD
+               | ((uint32_t(reg) << AD9361_SPI_ADDR_SHIFT) & AD9361_SPI_ADDR_MASK)
+               | ((uint32_t(val) << AD9361_SPI_DATA_SHIFT) & AD9361_SPI_DATA_MASK);
     }
 
-private:
     uhd::spi_iface::sptr _spi_iface;
     uint32_t _slave_num;
     std::mutex _mutex;
@@ -181,6 +204,22 @@ public:
         return return_val;
     }
 
+    std::vector<double> set_fastlock_profiles(
+        const std::string& which, const std::vector<double>& freqs)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        // clip to known bounds, like tune() does
+        const meta_range_t freq_range = ad9361_ctrl::get_rf_freq_range();
+        std::vector<double> clipped_freqs;
+        for (const double freq : freqs) {
+            clipped_freqs.push_back(freq_range.clip(freq));
+        }
+
+        ad9361_device_t::direction_t direction = _get_direction_from_antenna(which);
+        return _device.set_fastlock_profiles(direction, clipped_freqs);
+    }
+
     //! get the current frequency for the given frontend
     double get_freq(const std::string& which)
     {
@@ -9,6 +9,8 @@
 #define INCLUDED_AD9361_CLIENT_H
 
 #include <boost/shared_ptr.hpp>
+#include <utility>
+#include <vector>
 
 namespace uhd { namespace usrp {
 
@@ -63,11 +65,25 @@ class ad9361_io
 {
 public:
     typedef boost::shared_ptr<ad9361_io> sptr;
+    //! A list of (register, value) writes
+    typedef std::vector<std::pair<uint32_t, uint8_t> > write_list_t;
 
     virtual ~ad9361_io() {}
 
     virtual uint8_t peek8(uint32_t reg) = 0;
     virtual void poke8(uint32_t reg, uint8_t val) = 0;
+
+    /*!
+     * Write a list of registers, in order. Used for the long indirect
+     * programming sequences (FIR and gain tables). Implementations can
+     * override this to hand the whole list to their transport at once.
+     */
+    virtual void poke8_list(const write_list_t& writes)
+    {
+        for (const auto& write : writes) {
+            poke8(write.first, write.second);
+        }
+    }
 };
 
 
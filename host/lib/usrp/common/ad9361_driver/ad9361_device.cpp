@@ -91,6 +91,7 @@ const double ad9361_device_t::AD9361_MAX_BW = 56e6;
 /* Startup RF frequencies */
 const double ad9361_device_t::DEFAULT_RX_FREQ = 800e6;
 const double ad9361_device_t::DEFAULT_TX_FREQ = 850e6;
+const size_t ad9361_device_t::AD9361_NUM_FASTLOCK_PROFILES = 8;
 
 /* Program either the RX or TX FIR filter.
  *
@@ -125,30 +126,41 @@ void ad9361_device_t::_program_fir_filter(direction_t direction, chain_t chain,
         reg_chain = 0x03 << 3;
     }
 
+    /* Skip the programming if the chains already hold these taps. Rate
+     * changes mostly end up with the same filter, and the indirect
+     * programming takes almost a thousand register writes. */
+    const std::vector<uint16_t> taps(coeffs, coeffs + num_taps);
+    fir_shadow_t& shadow = _fir_shadow[direction];
+    if (shadow.num_taps == size_t(num_taps)
+            and (chain == CHAIN_2 or shadow.taps[0] == taps)
+            and (chain == CHAIN_1 or shadow.taps[1] == taps)) {
+        return;
+    }
+
     /* Turn on the filter clock. */
     _io_iface->poke8(base + 5, reg_numtaps | reg_chain | 0x02);
     std::this_thread::sleep_for(std::chrono::milliseconds(1));
 
-    /* Zero the unused taps just in case they have stale data */
-    int addr;
-    for (addr = num_taps; addr < 128; addr++) {
-        _io_iface->poke8(base + 0, addr);
-        _io_iface->poke8(base + 1, 0x0);
-        _io_iface->poke8(base + 2, 0x0);
-        _io_iface->poke8(base + 5, reg_numtaps | reg_chain | (1 << 1) | (1 << 2));
-        _io_iface->poke8(base + 4, 0x00);
-        _io_iface->poke8(base + 4, 0x00);
+    /* Zero the unused taps just in case they have stale data, then iterate
+     * through indirect programming of filter coeffs using ADI recomended
+     * procedure. The writes go out as one list. */
+    ad9361_io::write_list_t writes;
+    writes.reserve(128 * 6);
+    auto add_tap_writes = [&](const int addr, const uint16_t coeff) {
+        writes.emplace_back(base + 0, addr);
+        writes.emplace_back(base + 1, coeff & 0xff);
+        writes.emplace_back(base + 2, (coeff >> 8) & 0xff);
+        writes.emplace_back(base + 5, reg_numtaps | reg_chain | (1 << 1) | (1 << 2));
+        writes.emplace_back(base + 4, 0x00);
+        writes.emplace_back(base + 4, 0x00);
+    };
+    for (int addr = num_taps; addr < 128; addr++) {
+        add_tap_writes(addr, 0x0);
     }
-
-    /* Iterate through indirect programming of filter coeffs using ADI recomended procedure */
-    for (addr = 0; addr < num_taps; addr++) {
-        _io_iface->poke8(base + 0, addr);
-        _io_iface->poke8(base + 1, (coeffs[addr]) & 0xff);
-        _io_iface->poke8(base + 2, (coeffs[addr] >> 8) & 0xff);
-        _io_iface->poke8(base + 5, reg_numtaps | reg_chain | (1 << 1) | (1 << 2));
-        _io_iface->poke8(base + 4, 0x00);
-        _io_iface->poke8(base + 4, 0x00);
+    for (int addr = 0; addr < num_taps; addr++) {
+        add_tap_writes(addr, coeffs[addr]);
     }
+    _io_iface->poke8_list(writes);
 
     /* UG-671 states (page 25) (paraphrased and clarified):
      " After the table has been programmed, write to register BASE+5 with the write bit D2 cleared and D1 high.
@@ -169,6 +181,20 @@ void ad9361_device_t::_program_fir_filter(direction_t direction, chain_t chain,
            page 25 of UG-671 */
         _io_iface->poke8(base + 5, reg_numtaps | reg_chain );
     }
+
+    /* The tap count is shared by both chains, so a chain that isn't
+     * programmed here only keeps its taps if the count didn't change. */
+    if (shadow.num_taps != size_t(num_taps)) {
+        shadow.taps[0].clear();
+        shadow.taps[1].clear();
+        shadow.num_taps = num_taps;
+    }
+    if (chain != CHAIN_2) {
+        shadow.taps[0] = taps;
+    }
+    if (chain != CHAIN_1) {
+        shadow.taps[1] = taps;
+    }
 }
 
 
@@ -1004,28 +1030,31 @@ void ad9361_device_t::_program_gain_table() {
      * gain table clock. */
     _io_iface->poke8(0x137, 0x1A);
 
-    /* IT'S PROGRAMMING TIME. */
+    /* IT'S PROGRAMMING TIME. The writes go out as one list. */
+    ad9361_io::write_list_t writes;
+    writes.reserve(91 * 7);
     uint8_t index = 0;
     for (; index < 77; index++) {
-        _io_iface->poke8(0x130, index);
-        _io_iface->poke8(0x131, gain_table[index][0]);
-        _io_iface->poke8(0x132, gain_table[index][1]);
-        _io_iface->poke8(0x133, gain_table[index][2]);
-        _io_iface->poke8(0x137, 0x1E);
-        _io_iface->poke8(0x134, 0x00);
-        _io_iface->poke8(0x134, 0x00);
+        writes.emplace_back(0x130, index);
+        writes.emplace_back(0x131, gain_table[index][0]);
+        writes.emplace_back(0x132, gain_table[index][1]);
+        writes.emplace_back(0x133, gain_table[index][2]);
+        writes.emplace_back(0x137, 0x1E);
+        writes.emplace_back(0x134, 0x00);
+        writes.emplace_back(0x134, 0x00);
     }
 
     /* Everything above the 77th index is zero. */
     for (; index < 91; index++) {
-        _io_iface->poke8(0x130, index);
-        _io_iface->poke8(0x131, 0x00);
-        _io_iface->poke8(0x132, 0x00);
-        _io_iface->poke8(0x133, 0x00);
-        _io_iface->poke8(0x137, 0x1E);
-        _io_iface->poke8(0x134, 0x00);
-        _io_iface->poke8(0x134, 0x00);
+        writes.emplace_back(0x130, index);
+        writes.emplace_back(0x131, 0x00);
+        writes.emplace_back(0x132, 0x00);
+        writes.emplace_back(0x133, 0x00);
+        writes.emplace_back(0x137, 0x1E);
+        writes.emplace_back(0x134, 0x00);
+        writes.emplace_back(0x134, 0x00);
     }
+    _io_iface->poke8_list(writes);
 
     /* Clear the write bit and stop the gain clock. */
     _io_iface->poke8(0x137, 0x1A);
@@ -1252,6 +1281,39 @@ void ad9361_device_t::_reprogram_gains()
  *
  * Calculate the VCO settings for the requested frquency, and then either
  * tune the RX or TX VCO. */
+/* Select the RX input port or the TX output band for a frequency. */
+void ad9361_device_t::_select_band(direction_t direction, const double value)
+{
+    if (direction == RX) {
+        if (value < _client_params->get_band_edge(AD9361_RX_BAND0)) {
+            _regs.inputsel = (_regs.inputsel & 0xC0) | 0x30; // Port C, balanced
+        } else if ((value
+                >= _client_params->get_band_edge(AD9361_RX_BAND0))
+                && (value
+                        < _client_params->get_band_edge(AD9361_RX_BAND1))) {
+            _regs.inputsel = (_regs.inputsel & 0xC0) | 0x0C; // Port B, balanced
+        } else if ((value
+                >= _client_params->get_band_edge(AD9361_RX_BAND1))
+                && (value <= 6e9)) {
+            _regs.inputsel = (_regs.inputsel & 0xC0) | 0x03; // Port A, balanced
+        } else {
+            throw uhd::runtime_error("[ad9361_device_t] [_select_band] INVALID_CODE_PATH");
+        }
+    } else {
+        if (value < _client_params->get_band_edge(AD9361_TX_BAND0)) {
+            _regs.inputsel = _regs.inputsel | 0x40;
+        } else if ((value
+                >= _client_params->get_band_edge(AD9361_TX_BAND0))
+                && (value <= 6e9)) {
+            _regs.inputsel = _regs.inputsel & 0xBF;
+        } else {
+            throw uhd::runtime_error("[ad9361_device_t] [_select_band] INVALID_CODE_PATH");
+        }
+    }
+
+    _io_iface->poke8(0x004, _regs.inputsel);
+}
+
 double ad9361_device_t::_tune_helper(direction_t direction, const double value)
 {
     /* The RFPLL runs from 6 GHz - 12 GHz */
@@ -1284,22 +1346,7 @@ double ad9361_device_t::_tune_helper(direction_t direction, const double value)
         _req_rx_freq = value;
 
         /* Set band-specific settings. */
-        if (value < _client_params->get_band_edge(AD9361_RX_BAND0)) {
-            _regs.inputsel = (_regs.inputsel & 0xC0) | 0x30; // Port C, balanced
-        } else if ((value
-                >= _client_params->get_band_edge(AD9361_RX_BAND0))
-                && (value
-                        < _client_params->get_band_edge(AD9361_RX_BAND1))) {
-            _regs.inputsel = (_regs.inputsel & 0xC0) | 0x0C; // Port B, balanced
-        } else if ((value
-                >= _client_params->get_band_edge(AD9361_RX_BAND1))
-                && (value <= 6e9)) {
-            _regs.inputsel = (_regs.inputsel & 0xC0) | 0x03; // Port A, balanced
-        } else {
-            throw uhd::runtime_error("[ad9361_device_t] [_tune_helper] INVALID_CODE_PATH");
-        }
-
-        _io_iface->poke8(0x004, _regs.inputsel);
+        _select_band(RX, value);
 
         /* Store vcodiv setting. */
         _regs.vcodivs = (_regs.vcodivs & 0xF0) | (i & 0x0F);
@@ -1330,17 +1377,7 @@ double ad9361_device_t::_tune_helper(direction_t direction, const double value)
         _req_tx_freq = value;
 
         /* Set band-specific settings. */
-        if (value < _client_params->get_band_edge(AD9361_TX_BAND0)) {
-            _regs.inputsel = _regs.inputsel | 0x40;
-        } else if ((value
-                >= _client_params->get_band_edge(AD9361_TX_BAND0))
-                && (value <= 6e9)) {
-            _regs.inputsel = _regs.inputsel & 0xBF;
-        } else {
-            throw uhd::runtime_error("[ad9361_device_t] [_tune_helper] INVALID_CODE_PATH");
-        }
-
-        _io_iface->poke8(0x004, _regs.inputsel);
+        _select_band(TX, value);
 
         /* Store vcodiv setting. */
         _regs.vcodivs = (_regs.vcodivs & 0x0F) | ((i & 0x0F) << 4);
@@ -1368,6 +1405,139 @@ double ad9361_device_t::_tune_helper(direction_t direction, const double value)
     }
 }
 
+/* Store the current synthesizer state in a fast-lock profile.
+ *
+ * The profile words are laid out as described in the AD9361 reference
+ * manual (and used by ADI's reference driver): the integer and fractional
+ * words, the VCO and loop filter settings of the synthesizer LUT, the VCO
+ * divider and the results of the VCO calibration. The RX synthesizer
+ * registers start at 0x231, the TX ones at 0x271. */
+void ad9361_device_t::_store_fastlock_profile(direction_t direction, const size_t profile)
+{
+    const uint16_t offs = (direction == RX) ? 0x000 : 0x040;
+    const uint8_t vcodiv = (direction == RX) ? (_regs.vcodivs & 0x0F)
+                                             : ((_regs.vcodivs >> 4) & 0x0F);
+
+    const uint8_t loop_filter_1 = _io_iface->peek8(0x23e + offs);
+    const uint8_t loop_filter_2 = _io_iface->peek8(0x23f + offs);
+    const uint8_t loop_filter_r3 = _io_iface->peek8(0x240 + offs) & 0x0F;
+    const uint8_t vco_bias = _io_iface->peek8(0x242 + offs);
+    const uint8_t charge_pump_curr = _io_iface->peek8(0x23b + offs) & 0x3F;
+    const uint8_t vco_tune_1 = _io_iface->peek8(0x238 + offs);
+
+    uint8_t words[16];
+    words[0] = _io_iface->peek8(0x231 + offs); // Integer word [7:0]
+    words[1] = _io_iface->peek8(0x232 + offs) & 0x07; // Integer word [10:8]
+    words[2] = _io_iface->peek8(0x233 + offs); // Fractional word [7:0]
+    words[3] = _io_iface->peek8(0x234 + offs); // Fractional word [15:8]
+    words[4] = _io_iface->peek8(0x235 + offs) & 0x7F; // Fractional word [22:16]
+    // VCO bias ref, VCO varactor
+    words[5] = ((vco_bias & 0x07) << 4) | (_io_iface->peek8(0x239 + offs) & 0x0F);
+    // VCO bias tcf, initial charge pump current
+    words[6] = (((vco_bias >> 3) & 0x03) << 6) | charge_pump_curr;
+    // Steady state charge pump current
+    words[7] = charge_pump_curr;
+    // Loop filter R3, C3, C1/C2 and R1; initial and steady state are the same
+    words[8] = (loop_filter_r3 << 4) | loop_filter_r3;
+    words[9] = ((loop_filter_2 & 0x0F) << 4) | (loop_filter_2 & 0x0F);
+    words[10] = ((loop_filter_1 & 0x0F) << 4) | ((loop_filter_1 >> 4) & 0x0F);
+    words[11] = (loop_filter_2 & 0xF0) | ((loop_filter_2 >> 4) & 0x0F);
+    // VCO varactor reference tcf, VCO divider
+    words[12] = (((_io_iface->peek8(0x250 + offs) >> 4) & 0x07) << 4) | vcodiv;
+    // VCO cal offset, VCO varactor reference
+    words[13] = (((vco_tune_1 >> 3) & 0x0F) << 4)
+                | (_io_iface->peek8(0x251 + offs) & 0x0F);
+    // VCO tune [7:0]
+    words[14] = _io_iface->peek8(0x237 + offs);
+    // ALC word, VCO tune [8]
+    words[15] = ((_io_iface->peek8(0x236 + offs) & 0x7F) << 1) | (vco_tune_1 & 0x01);
+
+    for (size_t word = 0; word < 16; word++) {
+        _io_iface->poke8(0x25c + offs, ((profile & 0x07) << 4) | word); // Program address
+        _io_iface->poke8(0x25d + offs, words[word]); // Program data
+        _io_iface->poke8(0x25f + offs, 0x03); // Write, with the program clock enabled
+    }
+    _io_iface->poke8(0x25f + offs, 0x00); // Stop the program clock
+
+    fastlock_profile_t entry;
+    entry.req_freq = (direction == RX) ? _req_rx_freq : _req_tx_freq;
+    entry.actual_freq = (direction == RX) ? _rx_freq : _tx_freq;
+    entry.vcodiv = vcodiv;
+    std::vector<fastlock_profile_t>& profiles =
+        (direction == RX) ? _rx_fastlock_profiles : _tx_fastlock_profiles;
+    if (profiles.size() <= profile) {
+        profiles.resize(profile + 1);
+    }
+    profiles[profile] = entry;
+}
+
+/* Switch the synthesizer to a fast-lock profile. */
+double ad9361_device_t::_recall_fastlock_profile(direction_t direction, const size_t profile)
+{
+    const uint16_t offs = (direction == RX) ? 0x000 : 0x040;
+    const fastlock_profile_t& entry = (direction == RX)
+                                          ? _rx_fastlock_profiles.at(profile)
+                                          : _tx_fastlock_profiles.at(profile);
+
+    _select_band(direction, entry.req_freq);
+
+    /* Select the profile through SPI, and enable fast-lock mode */
+    _io_iface->poke8(0x25a + offs, ((profile & 0x07) << 5) | 0x01);
+
+    const uint8_t last_gain_table = _curr_gain_table;
+    if (direction == RX) {
+        _regs.vcodivs = (_regs.vcodivs & 0xF0) | entry.vcodiv;
+        _req_rx_freq = entry.req_freq;
+        _rx_freq = entry.actual_freq;
+        _rx_fastlock_profile = static_cast<int>(profile);
+        _program_gain_table();
+    } else {
+        _regs.vcodivs = (_regs.vcodivs & 0x0F) | (entry.vcodiv << 4);
+        _req_tx_freq = entry.req_freq;
+        _tx_freq = entry.actual_freq;
+        _tx_fastlock_profile = static_cast<int>(profile);
+    }
+    if (_curr_gain_table != last_gain_table) {
+        _reprogram_gains();
+    }
+
+    /* There's no VCO calibration, so poll for lock instead of waiting for
+     * the worst-case lock time. */
+    const uint16_t lock_reg = (direction == RX) ? 0x247 : 0x287;
+    const auto exit_time = std::chrono::steady_clock::now() + std::chrono::milliseconds(2);
+    while ((_io_iface->peek8(lock_reg) & 0x02) == 0) {
+        if (std::chrono::steady_clock::now() > exit_time) {
+            throw uhd::runtime_error(str(
+                boost::format("[ad9361_device_t] %s PLL NOT LOCKED with fast-lock profile %d")
+                % ((direction == RX) ? "RX" : "TX") % profile));
+        }
+    }
+
+    return entry.actual_freq;
+}
+
+/* Leave fast-lock mode, if a profile is in use. */
+void ad9361_device_t::_exit_fastlock(direction_t direction)
+{
+    const uint16_t offs = (direction == RX) ? 0x000 : 0x040;
+    int& current_profile = (direction == RX) ? _rx_fastlock_profile : _tx_fastlock_profile;
+    if (current_profile >= 0) {
+        _io_iface->poke8(0x25a + offs, 0x00);
+        current_profile = -1;
+    }
+}
+
+/* Leave fast-lock mode and forget the profiles. */
+void ad9361_device_t::_clear_fastlock_profiles(direction_t direction)
+{
+    _exit_fastlock(direction);
+    if (direction == RX) {
+        _rx_fastlock_profiles.clear();
+    } else {
+        _tx_fastlock_profiles.clear();
+    }
+}
+
 /* Configure the various clock / sample rates in the RX and TX chains.
  *
  * Functionally, this function configures AD9361's RX and TX rates. For
@@ -1542,6 +1712,7 @@ void ad9361_device_t::initialize()
     _adcclock_freq = 0.0;
     _rx_bbf_tunediv = 0;
     _curr_gain_table = 0;
+    _fir_shadow.clear();
     _rx1_gain = 0;
     _rx2_gain = 0;
     _tx1_gain = 0;
@@ -1707,6 +1878,8 @@ void ad9361_device_t::initialize()
     _io_iface->poke8(0x013, 0x01); // enable ENSM
     std::this_thread::sleep_for(std::chrono::milliseconds(1));
 
+    _clear_fastlock_profiles(RX);
+    _clear_fastlock_profiles(TX);
     _calibrate_synth_charge_pumps();
 
     _tune_helper(RX, _rx_freq);
@@ -1847,6 +2020,8 @@ double ad9361_device_t::set_clock_rate(const double req_rate)
     _io_iface->poke8(0x013, 0x01); //enable ENSM
     std::this_thread::sleep_for(std::chrono::milliseconds(1));
 
+    _clear_fastlock_profiles(RX);
+    _clear_fastlock_profiles(TX);
     _calibrate_synth_charge_pumps();
 
     _tune_helper(RX, _rx_freq);
@@ -2064,6 +2239,18 @@ double ad9361_device_t::tune(direction_t direction, const double value)
         throw uhd::runtime_error("[ad9361_device_t] [tune] INVALID_CODE_PATH");
     }
 
+    /* Frequencies with a fast-lock profile only need a profile switch. */
+    const std::vector<fastlock_profile_t>& profiles =
+        (direction == RX) ? _rx_fastlock_profiles : _tx_fastlock_profiles;
+    for (size_t i = 0; i < profiles.size(); i++) {
+        if (freq_is_nearly_equal(value, profiles[i].req_freq)) {
+            return _recall_fastlock_profile(direction, i);
+        }
+    }
+
+    /* Otherwise, the synthesizer registers must be in control again. */
+    _exit_fastlock(direction);
+
     /* If we aren't already in the ALERT state, we will need to return to
      * the FDD state after tuning. */
     int not_in_alert = 0;
@@ -2128,6 +2315,34 @@ double ad9361_device_t::get_freq(direction_t direction)
         return _tx_freq;
 }
 
+std::vector<double> ad9361_device_t::set_fastlock_profiles(
+    direction_t direction, const std::vector<double>& freqs)
+{
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+
+    if (freqs.size() > AD9361_NUM_FASTLOCK_PROFILES) {
+        throw uhd::value_error(str(
+            boost::format("[ad9361_device_t] Can't store %d fast-lock profiles, the maximum is %d")
+            % freqs.size() % AD9361_NUM_FASTLOCK_PROFILES));
+    }
+
+    _clear_fastlock_profiles(direction);
+    // Make sure the first profile is recorded from a fresh tune
+    if (direction == RX) {
+        _req_rx_freq = 0.0;
+    } else {
+        _req_tx_freq = 0.0;
+    }
+
+    std::vector<double> actual_freqs;
+    for (size_t profile = 0; profile < freqs.size(); profile++) {
+        tune(direction, freqs[profile]);
+        _store_fastlock_profile(direction, profile);
+        actual_freqs.push_back(get_freq(direction));
+    }
+    return actual_freqs;
+}
+
 /* Set the gain of RX1, RX2, TX1, or TX2.
  *
  * Note that the 'value' passed to this function is the gain index
@@ -37,6 +37,7 @@ public:
         _tfir_factor(0), _rfir_factor(0),
         _rx1_agc_mode(GAIN_MODE_MANUAL), _rx2_agc_mode(GAIN_MODE_MANUAL),
         _rx1_agc_enable(false), _rx2_agc_enable(false),
+        _rx_fastlock_profile(-1), _tx_fastlock_profile(-1),
         _use_dc_offset_tracking(false), _use_iq_balance_tracking(false),
         _rx_filters{
             {"LPF_TIA", std::make_tuple(
@@ -199,6 +200,23 @@ public:
     /* Get the current RX or TX frequency. */
     double get_freq(direction_t direction);
 
+    /* Record fast-lock profiles for a list of RX or TX frequencies.
+     *
+     * Each frequency is tuned to with a regular tune(), and the resulting
+     * synthesizer state (dividers, VCO and loop filter settings, and the VCO
+     * calibration results) is stored in one of the chip's fast-lock profiles.
+     * Afterwards, tune() to any of these frequencies switches to the stored
+     * profile instead of setting up and calibrating the synthesizer again.
+     * The RF calibrations are not rerun on such a switch.
+     *
+     * Any previously recorded profiles of that direction are discarded, and
+     * an empty list disables fast-lock. Profiles are also discarded when the
+     * clock rate changes.
+     *
+     * Returns the actual frequencies of the profiles. */
+    std::vector<double> set_fastlock_profiles(
+        direction_t direction, const std::vector<double>& freqs);
+
     /* Set the gain of RX1, RX2, TX1, or TX2.
      *
      * Note that the 'value' passed to this function is the actual gain value,
@@ -258,6 +276,7 @@ public:
     static const double AD9361_MAX_BW;
     static const double DEFAULT_RX_FREQ;
     static const double DEFAULT_TX_FREQ;
+    static const size_t AD9361_NUM_FASTLOCK_PROFILES;
 
 private:    //Methods
     void _program_fir_filter(direction_t direction, int num_taps, uint16_t *coeffs);
@@ -284,7 +303,12 @@ private:    //Methods
     void _setup_synth(direction_t direction, double vcorate);
     double _tune_bbvco(const double rate);
     void _reprogram_gains();
+    void _select_band(direction_t direction, const double value);
     double _tune_helper(direction_t direction, const double value);
+    void _store_fastlock_profile(direction_t direction, const size_t profile);
+    double _recall_fastlock_profile(direction_t direction, const size_t profile);
+    void _exit_fastlock(direction_t direction);
+    void _clear_fastlock_profiles(direction_t direction);
     double _setup_rates(const double rate);
     double _get_temperature(const double cal_offset, const double timeout = 0.1);
     void _configure_bb_dc_tracking();
@@ -306,6 +330,13 @@ private:    //Methods
     void _set_filter_lp_tia_sec(direction_t direction, filter_info_base::sptr filter);
 
 private:    //Members
+    struct fastlock_profile_t
+    {
+        double req_freq;
+        double actual_freq;
+        uint8_t vcodiv;
+    };
+
     struct chip_regs_t
     {
         chip_regs_t():
@@ -320,6 +351,15 @@ private:    //Members
         uint8_t bbftune_mode;
     };
 
+    //! What was last programmed into the FIR filter of one direction
+    struct fir_shadow_t
+    {
+        fir_shadow_t(): num_taps(0) {}
+        size_t num_taps;
+        //! The taps of chain 1 and 2, empty if unknown
+        std::vector<uint16_t> taps[2];
+    };
+
     //Interfaces
     ad9361_params::sptr _client_params;
     ad9361_io::sptr     _io_iface;
@@ -346,6 +386,10 @@ private:    //Members
     bool                _rx1_agc_enable, _rx2_agc_enable;
     //Register soft-copies
     chip_regs_t         _regs;
+    std::map<direction_t, fir_shadow_t> _fir_shadow;
+    //Fast-lock profiles, and the one in use (-1 for none)
+    std::vector<fastlock_profile_t> _rx_fastlock_profiles, _tx_fastlock_profiles;
+    int                 _rx_fastlock_profile, _tx_fastlock_profile;
     //Synchronization
     std::recursive_mutex  _mutex;
     bool _use_dc_offset_tracking;
@@ -256,6 +256,11 @@ public:
             .set_coercer([this, key](const double freq) {
                 return this->_codec_ctrl->tune(key, freq);
             });
+        subtree->create<std::vector<double>>("fastlock/freqs")
+            .set(std::vector<double>())
+            .set_coercer([this, key](const std::vector<double>& freqs) {
+                return this->_codec_ctrl->set_fastlock_profiles(key, freqs);
+            });
 
         // Frontend corrections
         if (dir == RX_DIRECTION) {
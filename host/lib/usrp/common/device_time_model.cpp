@@ -0,0 +1,142 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/utils/log.hpp>
+#include <uhdlib/usrp/common/device_time_model.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace uhd;
+using namespace uhd::usrp;
+
+namespace {
+
+//! Readbacks further off the model than this many error estimates are a jump
+constexpr double JUMP_THRESHOLD = 5.0;
+
+} // namespace
+
+constexpr double device_time_model::DEFAULT_MAX_DRIFT;
+constexpr size_t device_time_model::DEFAULT_MAX_SAMPLES;
+
+device_time_model::device_time_model(const double max_drift, const size_t max_samples)
+    : _max_drift(max_drift)
+    , _max_samples(std::max<size_t>(max_samples, 1))
+    , _host_mean(0.0)
+    , _device_mean(0.0)
+    , _drift(1.0)
+    , _mean_var(0.0)
+    , _drift_var(0.0)
+{
+    /* NOP */
+}
+
+void device_time_model::reset(void)
+{
+    _samples.clear();
+}
+
+bool device_time_model::add_readback(const clock_type::time_point& host_before,
+    const clock_type::time_point& host_after,
+    const uhd::time_spec_t& device_time,
+    const double resolution)
+{
+    const clock_type::time_point host_mid = host_before + (host_after - host_before) / 2;
+    const double error =
+        std::max(std::chrono::duration<double>(host_after - host_before).count() / 2,
+            resolution);
+
+    bool fits = true;
+    if (is_valid()) {
+        const double offset = (device_time - get_time(host_mid)).get_real_secs();
+        if (std::abs(offset) > JUMP_THRESHOLD * (get_error(host_mid) + error)) {
+            UHD_LOG_DEBUG("TIME_MODEL",
+                "Device time is " << offset << " s off the model, starting over");
+            _samples.clear();
+            fits = false;
+        }
+    }
+    if (_samples.empty()) {
+        _host_origin   = host_mid;
+        _device_origin = device_time;
+    }
+
+    _samples.push_back(
+        {to_host_secs(host_mid), (device_time - _device_origin).get_real_secs(), error});
+    if (_samples.size() > _max_samples) {
+        _samples.pop_front();
+    }
+    fit();
+    return fits;
+}
+
+bool device_time_model::is_valid(void) const
+{
+    return not _samples.empty();
+}
+
+uhd::time_spec_t device_time_model::get_time(
+    const clock_type::time_point& host_time) const
+{
+    return _device_origin
+           + uhd::time_spec_t(
+                 _device_mean + _drift * (to_host_secs(host_time) - _host_mean));
+}
+
+double device_time_model::get_error(const clock_type::time_point& host_time) const
+{
+    if (not is_valid()) {
+        return std::numeric_limits<double>::infinity();
+    }
+    const double distance = to_host_secs(host_time) - _host_mean;
+    return std::sqrt(_mean_var + distance * distance * _drift_var);
+}
+
+double device_time_model::to_host_secs(const clock_type::time_point& host_time) const
+{
+    return std::chrono::duration<double>(host_time - _host_origin).count();
+}
+
+void device_time_model::fit(void)
+{
+    // Weighted means, the readbacks are weighted by their inverse variance
+    double weights = 0.0, host_sum = 0.0, device_sum = 0.0;
+    for (const sample_t& sample : _samples) {
+        const double weight = 1.0 / (sample.error * sample.error);
+        weights += weight;
+        host_sum += weight * sample.host;
+        device_sum += weight * sample.device;
+    }
+    _host_mean   = host_sum / weights;
+    _device_mean = device_sum / weights;
+
+    // The drift has a prior of 1 with a standard deviation of _max_drift
+    const double prior = 1.0 / (_max_drift * _max_drift);
+    double s_hh = 0.0, s_hd = 0.0;
+    for (const sample_t& sample : _samples) {
+        const double weight = 1.0 / (sample.error * sample.error);
+        s_hh += weight * (sample.host - _host_mean) * (sample.host - _host_mean);
+        s_hd += weight * (sample.host - _host_mean) * (sample.device - _device_mean);
+    }
+    _drift     = (s_hd + prior) / (s_hh + prior);
+    _mean_var  = 1.0 / weights;
+    _drift_var = 1.0 / (s_hh + prior);
+
+    // Scale the variances up if the readbacks scatter more than their errors
+    // say, e.g., because the round trips are asymmetric
+    double chi2 = 0.0;
+    for (const sample_t& sample : _samples) {
+        const double residual =
+            sample.device - _device_mean - _drift * (sample.host - _host_mean);
+        chi2 += residual * residual / (sample.error * sample.error);
+    }
+    const size_t dof = _samples.size() - 1;
+    if (dof > 0 and chi2 > dof) {
+        _mean_var *= chi2 / dof;
+        _drift_var *= chi2 / dof;
+    }
+}
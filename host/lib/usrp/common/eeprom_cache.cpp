@@ -0,0 +1,158 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/utils/log.hpp>
+#include <uhdlib/usrp/common/eeprom_cache.hpp>
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+using namespace uhd;
+using namespace uhd::usrp;
+
+namespace {
+
+//! Key, I2C address, offset and length of a read
+typedef std::tuple<std::string, uint16_t, uint16_t, size_t> entry_key_t;
+
+std::mutex& cache_mutex(void)
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::map<entry_key_t, byte_vector_t>& cache(void)
+{
+    static std::map<entry_key_t, byte_vector_t> entries;
+    return entries;
+}
+
+} // namespace
+
+const eeprom_cache_iface::check_regions_t eeprom_cache_iface::DB_EEPROM_CHECK_REGIONS =
+    {{0x00, 3}, {0x1f, 1}};
+
+eeprom_cache_iface::~eeprom_cache_iface(void)
+{
+    /* NOP */
+}
+
+void eeprom_cache_iface::clear(void)
+{
+    std::lock_guard<std::mutex> lock(cache_mutex());
+    cache().clear();
+}
+
+class eeprom_cache_iface_impl : public eeprom_cache_iface
+{
+public:
+    eeprom_cache_iface_impl(
+        i2c_iface::sptr iface, const std::string& key, const check_regions_t& check_regions)
+        : _iface(iface), _key(key), _check_regions(check_regions)
+    {
+        /* NOP */
+    }
+
+    byte_vector_t read_eeprom(uint16_t addr, uint16_t offset, size_t num_bytes)
+    {
+        if (not is_cacheable(offset, num_bytes)) {
+            return _iface->read_eeprom(addr, offset, num_bytes);
+        }
+
+        const entry_key_t entry_key(_key, addr, offset, num_bytes);
+        byte_vector_t cached;
+        {
+            std::lock_guard<std::mutex> lock(cache_mutex());
+            const auto it = cache().find(entry_key);
+            if (it != cache().end()) {
+                cached = it->second;
+            }
+        }
+        if (not cached.empty() and is_unchanged(addr, offset, cached)) {
+            return cached;
+        }
+
+        const byte_vector_t bytes = _iface->read_eeprom(addr, offset, num_bytes);
+        std::lock_guard<std::mutex> lock(cache_mutex());
+        if (bytes.size() == num_bytes) {
+            cache()[entry_key] = bytes;
+        } else {
+            cache().erase(entry_key);
+        }
+        return bytes;
+    }
+
+    void write_eeprom(uint16_t addr, uint16_t offset, const byte_vector_t& buf)
+    {
+        invalidate(addr);
+        _iface->write_eeprom(addr, offset, buf);
+    }
+
+    byte_vector_t read_i2c(uint16_t addr, size_t num_bytes)
+    {
+        return _iface->read_i2c(addr, num_bytes);
+    }
+
+    void write_i2c(uint16_t addr, const byte_vector_t& bytes)
+    {
+        // This might be a write to the EEPROM, too
+        invalidate(addr);
+        _iface->write_i2c(addr, bytes);
+    }
+
+private:
+    bool is_cacheable(const uint16_t offset, const size_t num_bytes) const
+    {
+        if (_key.empty() or _check_regions.empty()) {
+            return false;
+        }
+        return std::all_of(_check_regions.begin(),
+            _check_regions.end(),
+            [offset, num_bytes](const std::pair<uint16_t, size_t>& region) {
+                return region.first >= offset
+                       and region.first + region.second <= offset + num_bytes;
+            });
+    }
+
+    bool is_unchanged(
+        const uint16_t addr, const uint16_t offset, const byte_vector_t& cached) const
+    {
+        for (const auto& region : _check_regions) {
+            const byte_vector_t bytes =
+                _iface->read_eeprom(addr, region.first, region.second);
+            const auto cached_begin = cached.begin() + (region.first - offset);
+            if (bytes.size() != region.second
+                or not std::equal(bytes.begin(), bytes.end(), cached_begin)) {
+                UHD_LOG_DEBUG("EEPROM_CACHE",
+                    "EEPROM at I2C address " << addr << " of " << _key
+                                             << " has changed, reading it again");
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void invalidate(const uint16_t addr)
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex());
+        auto it = cache().lower_bound(entry_key_t(_key, addr, 0, 0));
+        while (it != cache().end() and std::get<0>(it->first) == _key
+               and std::get<1>(it->first) == addr) {
+            it = cache().erase(it);
+        }
+    }
+
+    i2c_iface::sptr _iface;
+    const std::string _key;
+    const check_regions_t _check_regions;
+};
+
+eeprom_cache_iface::sptr eeprom_cache_iface::make(
+    i2c_iface::sptr iface, const std::string& key, const check_regions_t& check_regions)
+{
+    return sptr(new eeprom_cache_iface_impl(iface, key, check_regions));
+}
@@ -0,0 +1,389 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhdlib/usrp/common/host_resampler.hpp>
+#include <boost/make_shared.hpp>
+#include <algorithm>
+#include <cmath>
+#ifdef __SSE2__
+#    include <emmintrin.h>
+#endif
+
+using namespace uhd;
+using namespace uhd::usrp;
+
+namespace {
+
+//! Taps per phase and per input or output sample, whichever rate is higher
+constexpr size_t TAPS_PER_SAMPLE = 24;
+//! Kaiser window parameter, gives about 80 dB stopband attenuation
+constexpr double KAISER_BETA = 8.0;
+
+//! Zeroth order modified Bessel function of the first kind
+double bessel_i0(const double x)
+{
+    double sum = 1.0, term = 1.0;
+    for (size_t k = 1; k < 50; k++) {
+        term *= (x / (2 * k)) * (x / (2 * k));
+        sum += term;
+    }
+    return sum;
+}
+
+size_t calc_taps_per_phase(const size_t interp, const size_t decim)
+{
+    const size_t taps = (TAPS_PER_SAMPLE * std::max(interp, decim) + interp - 1) / interp;
+    // An even number of taps is a multiple of 4 floats for the SIMD kernel
+    return std::max<size_t>(4, taps + (taps % 2));
+}
+
+/*! Multiply the interleaved I/Q samples in x with the taps and sum them
+ *
+ * \param taps every tap twice, once for I and once for Q
+ * \param x interleaved I/Q samples
+ * \param len number of floats in taps and x, a multiple of 4
+ */
+UHD_INLINE std::complex<float> dot_product(
+    const float* taps, const float* x, const size_t len)
+{
+#ifdef __SSE2__
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    size_t i    = 0;
+    for (; i + 8 <= len; i += 8) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(taps + i), _mm_loadu_ps(x + i)));
+        acc1 = _mm_add_ps(
+            acc1, _mm_mul_ps(_mm_loadu_ps(taps + i + 4), _mm_loadu_ps(x + i + 4)));
+    }
+    for (; i < len; i += 4) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(taps + i), _mm_loadu_ps(x + i)));
+    }
+    float sum[4];
+    _mm_storeu_ps(sum, _mm_add_ps(acc0, acc1));
+    return std::complex<float>(sum[0] + sum[2], sum[1] + sum[3]);
+#else
+    float re = 0, im = 0;
+    for (size_t i = 0; i < len; i += 2) {
+        re += taps[i] * x[i];
+        im += taps[i + 1] * x[i + 1];
+    }
+    return std::complex<float>(re, im);
+#endif
+}
+
+} // namespace
+
+/***********************************************************************
+ * Polyphase resampler
+ **********************************************************************/
+polyphase_resampler::polyphase_resampler(
+    const size_t interp, const size_t decim, const float scale)
+    : _interp(interp), _decim(decim), _taps_per_phase(calc_taps_per_phase(interp, decim))
+{
+    if (interp == 0 or decim == 0) {
+        throw uhd::value_error("polyphase_resampler: invalid resampling ratio");
+    }
+
+    // Kaiser windowed sinc lowpass at the interpolated rate, cut off at the
+    // lower Nyquist rate of the input and the output
+    const size_t num_taps = _interp * _taps_per_phase;
+    const double cutoff   = 0.5 / std::max(_interp, _decim);
+    const double center   = (num_taps - 1) / 2.0;
+    std::vector<double> prototype(num_taps);
+    double sum = 0;
+    for (size_t n = 0; n < num_taps; n++) {
+        const double t = n - center;
+        const double x = 2 * M_PI * cutoff * t;
+        const double r = t / (center + 1);
+        prototype[n]   = ((t == 0) ? 1.0 : std::sin(x) / x)
+                       * bessel_i0(KAISER_BETA * std::sqrt(1 - r * r))
+                       / bessel_i0(KAISER_BETA);
+        sum += prototype[n];
+    }
+
+    // Each phase sees every interp-th tap, so the gain is interp
+    const double gain = scale * _interp / sum;
+    _taps.resize(2 * num_taps);
+    for (size_t phase = 0; phase < _interp; phase++) {
+        float* phase_taps = &_taps[2 * phase * _taps_per_phase];
+        for (size_t i = 0; i < _taps_per_phase; i++) {
+            const double tap =
+                gain * prototype[phase + (_taps_per_phase - 1 - i) * _interp];
+            phase_taps[2 * i] = phase_taps[2 * i + 1] = float(tap);
+        }
+    }
+    reset();
+}
+
+void polyphase_resampler::push(const std::complex<int16_t>* in, const size_t nsamps)
+{
+    const size_t offset = _history.size();
+    _history.resize(offset + 2 * nsamps);
+    float* out = &_history[offset];
+    for (size_t i = 0; i < nsamps; i++) {
+        out[2 * i]     = in[i].real();
+        out[2 * i + 1] = in[i].imag();
+    }
+}
+
+size_t polyphase_resampler::pull(std::complex<float>* out, const size_t nsamps)
+{
+    const size_t len   = 2 * _taps_per_phase;
+    const size_t avail = _history.size() / 2;
+    size_t n           = 0;
+    while (n < nsamps and _in_index < avail) {
+        out[n++] = dot_product(&_taps[_phase * len],
+            &_history[2 * (_in_index + 1 - _taps_per_phase)],
+            len);
+        _phase += _decim;
+        _in_index += _phase / _interp;
+        _phase %= _interp;
+    }
+
+    // Keep the samples which are needed for the next output
+    const size_t drop = std::min(_in_index + 1 - _taps_per_phase, avail);
+    _history.erase(_history.begin(), _history.begin() + 2 * drop);
+    _in_index -= drop;
+    _num_dropped += drop;
+    return n;
+}
+
+double polyphase_resampler::get_output_position(void) const
+{
+    const double delay = (_interp * _taps_per_phase - 1) / (2.0 * _interp);
+    return _num_dropped + double(_in_index) + double(_phase) / _interp - delay;
+}
+
+void polyphase_resampler::reset(void)
+{
+    // Start with zeros in the history, so the first output only needs one
+    // input sample
+    _history.assign(2 * (_taps_per_phase - 1), 0.0f);
+    _in_index    = _taps_per_phase - 1;
+    _phase       = 0;
+    _num_dropped = -int64_t(_taps_per_phase - 1);
+}
+
+std::pair<size_t, size_t> polyphase_resampler::approximate_ratio(
+    const double ratio, const size_t max_factor)
+{
+    if (not(ratio > 0)) {
+        throw uhd::value_error("polyphase_resampler: invalid resampling ratio");
+    }
+    // Continued fraction expansion, stop before a factor gets too large
+    size_t p0 = 0, q0 = 1, p1 = 1, q1 = 0;
+    double x = ratio;
+    for (size_t i = 0; i < 64; i++) {
+        const double a_f = std::floor(x);
+        if (a_f > double(max_factor)) {
+            break;
+        }
+        const size_t a = size_t(a_f);
+        const size_t p = a * p1 + p0;
+        const size_t q = a * q1 + q0;
+        if (p > max_factor or q > max_factor) {
+            break;
+        }
+        p0 = p1;
+        q0 = q1;
+        p1 = p;
+        q1 = q;
+        if (x - a_f < 1e-9) {
+            break;
+        }
+        x = 1.0 / (x - a_f);
+    }
+    if (p1 == 0 or q1 == 0) {
+        throw uhd::value_error("polyphase_resampler: resampling ratio out of range");
+    }
+    return std::make_pair(p1, q1);
+}
+
+/***********************************************************************
+ * Resampling RX streamer
+ **********************************************************************/
+class resampling_rx_streamer : public uhd::rx_streamer
+{
+public:
+    resampling_rx_streamer(uhd::rx_streamer::sptr streamer,
+        const size_t interp,
+        const size_t decim,
+        const double input_rate,
+        const float scale)
+        : _streamer(streamer), _input_rate(input_rate)
+    {
+        const size_t num_chans = _streamer->get_num_channels();
+        for (size_t chan = 0; chan < num_chans; chan++) {
+            _resamplers.emplace_back(interp, decim, scale);
+            _in_buffs.emplace_back(_streamer->get_max_num_samps());
+        }
+        for (auto& buff : _in_buffs) {
+            _in_ptrs.push_back(buff.data());
+        }
+    }
+
+    size_t get_num_channels(void) const
+    {
+        return _streamer->get_num_channels();
+    }
+
+    size_t get_max_num_samps(void) const
+    {
+        const polyphase_resampler& resampler = _resamplers.front();
+        return (_streamer->get_max_num_samps() * resampler.get_interp()
+                   + resampler.get_decim() - 1)
+               / resampler.get_decim();
+    }
+
+    size_t recv(const buffs_type& buffs,
+        const size_t nsamps_per_buff,
+        rx_metadata_t& metadata,
+        const double timeout,
+        const bool one_packet)
+    {
+        metadata.reset();
+        if (_pending_error) {
+            metadata       = _error_md;
+            _pending_error = false;
+            return 0;
+        }
+
+        size_t produced = 0;
+        while (true) {
+            produced += pull(buffs, produced, nsamps_per_buff - produced, metadata);
+            if (_eob_pending and produced < nsamps_per_buff) {
+                // All output of the burst was written
+                metadata.end_of_burst = true;
+                reset();
+                break;
+            }
+            if (produced == nsamps_per_buff or (one_packet and produced > 0)) {
+                break;
+            }
+
+            rx_metadata_t in_md;
+            const size_t num_in = _streamer->recv(
+                _in_ptrs, _in_buffs.front().size(), in_md, timeout, true);
+            if (in_md.error_code != rx_metadata_t::ERROR_CODE_NONE) {
+                if (in_md.error_code != rx_metadata_t::ERROR_CODE_TIMEOUT) {
+                    reset();
+                }
+                if (produced == 0) {
+                    metadata = in_md;
+                } else if (in_md.error_code != rx_metadata_t::ERROR_CODE_TIMEOUT) {
+                    // Return the samples now and the error on the next call
+                    _error_md      = in_md;
+                    _pending_error = true;
+                }
+                break;
+            }
+            if (in_md.has_time_spec) {
+                _time_ref     = in_md.time_spec;
+                _time_ref_pos = _num_pushed;
+                _has_time     = true;
+            }
+            if (in_md.start_of_burst and produced == 0) {
+                metadata.start_of_burst = true;
+            }
+            for (size_t chan = 0; chan < _resamplers.size(); chan++) {
+                _resamplers[chan].push(_in_buffs[chan].data(), num_in);
+            }
+            _num_pushed += num_in;
+            _eob_pending = in_md.end_of_burst;
+        }
+        return produced;
+    }
+
+    void issue_stream_cmd(const stream_cmd_t& stream_cmd)
+    {
+        stream_cmd_t cmd(stream_cmd);
+        if (cmd.stream_mode != stream_cmd_t::STREAM_MODE_START_CONTINUOUS
+            and cmd.stream_mode != stream_cmd_t::STREAM_MODE_STOP_CONTINUOUS) {
+            // Input samples for the requested output, and the filter delay
+            const polyphase_resampler& resampler = _resamplers.front();
+            cmd.num_samps = (cmd.num_samps * resampler.get_decim()
+                                + resampler.get_interp() - 1)
+                                / resampler.get_interp()
+                            + resampler.get_taps_per_phase();
+        }
+        _streamer->issue_stream_cmd(cmd);
+    }
+
+    stream_stats_t get_stats(void) const
+    {
+        return _streamer->get_stats();
+    }
+
+private:
+    //! Resample into buffs from offset on, and set the time of the first sample
+    size_t pull(const buffs_type& buffs,
+        const size_t offset,
+        const size_t nsamps,
+        rx_metadata_t& metadata)
+    {
+        const double position = _resamplers.front().get_output_position();
+        size_t num_out        = 0;
+        for (size_t chan = 0; chan < _resamplers.size(); chan++) {
+            num_out = _resamplers[chan].pull(
+                reinterpret_cast<std::complex<float>*>(buffs[chan]) + offset, nsamps);
+        }
+        if (offset == 0 and num_out > 0 and _has_time) {
+            metadata.has_time_spec = true;
+            metadata.time_spec =
+                _time_ref + time_spec_t((position - _time_ref_pos) / _input_rate);
+        }
+        return num_out;
+    }
+
+    void reset(void)
+    {
+        for (auto& resampler : _resamplers) {
+            resampler.reset();
+        }
+        _num_pushed  = 0;
+        _has_time    = false;
+        _eob_pending = false;
+    }
+
+    uhd::rx_streamer::sptr _streamer;
+    const double _input_rate;
+    std::vector<polyphase_resampler> _resamplers;
+    std::vector<std::vector<std::complex<int16_t>>> _in_buffs;
+    std::vector<void*> _in_ptrs;
+
+    //! Input samples pushed since the last reset
+    int64_t _num_pushed = 0;
+    //! Time of the input sample at _time_ref_pos
+    time_spec_t _time_ref;
+    int64_t _time_ref_pos = 0;
+    bool _has_time        = false;
+    bool _eob_pending     = false;
+    bool _pending_error   = false;
+    rx_metadata_t _error_md;
+};
+
+uhd::rx_streamer::sptr uhd::usrp::make_resampling_rx_streamer(
+    uhd::rx_streamer::sptr streamer,
+    const double input_rate,
+    const double output_rate,
+    const float scale)
+{
+    const auto ratio =
+        polyphase_resampler::approximate_ratio(output_rate / input_rate, 1024);
+    const double actual_rate = input_rate * ratio.first / ratio.second;
+    UHD_LOG_INFO("RESAMPLER",
+        "Resampling RX from " << (input_rate / 1e6) << " Msps to " << (actual_rate / 1e6)
+                              << " Msps (" << ratio.first << "/" << ratio.second << ")");
+    if (std::abs(actual_rate - output_rate) > 1e-6 * output_rate) {
+        UHD_LOG_WARNING("RESAMPLER",
+            "Requested rate " << (output_rate / 1e6) << " Msps can't be resampled to "
+                              << "exactly, using " << (actual_rate / 1e6) << " Msps");
+    }
+    return boost::make_shared<resampling_rx_streamer>(
+        streamer, ratio.first, ratio.second, input_rate, scale);
+}
@@ -6,9 +6,11 @@
 
 #include "lmx2592_regs.hpp"
 #include <uhdlib/usrp/common/lmx2592.hpp>
+#include <uhdlib/utils/lru_cache.hpp>
 #include <uhdlib/utils/narrow.hpp>
 #include <chrono>
 #include <iomanip>
+#include <tuple>
 
 using namespace uhd;
 
@@ -165,101 +167,34 @@ public:
             throw runtime_error("Requested frequency is out of the supported range");
         }
 
-        // Find the largest possible divider
-        auto output_divider_index = 0;
-        for (auto limit : LMX2592_CHDIV_MIN_FREQ) {
-            // The second harmonic level is very bad when using the div-by-3
-            // Skip and let the div-by-4 cover the range
-            if (LMX2592_CHDIV_DIVIDERS[output_divider_index] == 3) {
-                output_divider_index++;
-                continue;
-            }
-            if (target_freq < limit) {
-                output_divider_index++;
-            } else {
-                break;
-            }
-        }
-        const auto output_divider = LMX2592_CHDIV_DIVIDERS[output_divider_index];
-        _set_chdiv_values(output_divider_index);
-
-        // Setup input signal path and PLL loop
-        const int vco_multiplier = target_freq > LMX2592_MAX_VCO_FREQ ? 2 : 1;
-
-        const auto target_vco_freq = target_freq * output_divider;
-        const auto core_vco_freq = target_vco_freq / vco_multiplier;
-
-        double input_freq = _ref_freq;
-
-        // Input Doubler stage
-        if (input_freq <= LMX2592_MAX_DOUBLER_INPUT_FREQ) {
-            _regs.osc_doubler = 1;
-            input_freq *= 2;
-        } else {
-            _regs.osc_doubler = 0;
+        // The solution only depends on these settings, so synthesizers can
+        // share it
+        const solution_key_t key(_ref_freq,
+            target_freq,
+            static_cast<int>(_regs.mash_order),
+            spur_dodging,
+            spur_dodging ? spur_dodging_threshold : 0.0);
+        solution_t solution;
+        if (not _get_solution_cache().get(key, solution)) {
+            solution = _solve(target_freq, spur_dodging, spur_dodging_threshold);
+            _get_solution_cache().put(key, solution);
         }
-
-        // Pre-R divider
-        _regs.pll_r_pre =
-            narrow_cast<uint16_t>(std::ceil(input_freq / LMX2592_MAX_MULT_INPUT_FREQ));
-        input_freq /= _regs.pll_r_pre;
-
-        // Multiplier
-        _regs.mult = narrow_cast<uint8_t>(std::floor(LMX2592_MAX_MULT_OUT_FREQ / input_freq));
-        input_freq *= _regs.mult;
-
-        // Post R divider
-        _regs.pll_r = narrow_cast<uint8_t>(std::ceil(input_freq / LMX2592_MAX_POSTR_DIV_OUT_FREQ));
-
-        // Default to divide by 2, will be increased later if N exceeds its limit
-        int prescaler = 2;
-        _regs.pll_n_pre = lmx2592_regs_t::pll_n_pre_t::PLL_N_PRE_DIVIDE_BY_2;
-
-        const int min_n_divider = LMX2592_MIN_N_DIV[_regs.mash_order];
-        double pfd_freq = input_freq / _regs.pll_r;
-        while (pfd_freq * (prescaler * min_n_divider) / vco_multiplier > core_vco_freq) {
-            _regs.pll_r++;
-            pfd_freq = input_freq / _regs.pll_r;
-        }
-
-        // Calculate N and frac
-        const auto N_dot_F = target_vco_freq / (pfd_freq * prescaler);
-        auto N = static_cast<uint16_t>(std::floor(N_dot_F));
-        if (N > MAX_N_DIVIDER) {
-            _regs.pll_n_pre = lmx2592_regs_t::pll_n_pre_t::PLL_N_PRE_DIVIDE_BY_4;
-            N /= 2;
-        }
-        const auto frac = N_dot_F - N;
-
-        // Increase VCO step size to threshold to avoid primary fractional spurs
-        const double min_vco_step_size = spur_dodging ? spur_dodging_threshold : 1;
-        // Calculate Fden
-        const auto initial_fden = static_cast<uint32_t>(std::floor(pfd_freq * prescaler / min_vco_step_size));
-        const auto fden = (spur_dodging) ? _find_fden(initial_fden) : initial_fden;
-        // Calculate Fnum
-        const auto initial_fnum = static_cast<uint32_t>(std::round(frac * fden));
-        const auto fnum = (spur_dodging) ? _find_fnum(N, initial_fnum, fden, prescaler, pfd_freq, output_divider, spur_dodging_threshold) : initial_fnum;
-
-        // Calculate mash_seed
-        // if spur_dodging is true, mash_seed is the first odd value less than fden
-        // else mash_seed is int(fden / 2);
-        const uint32_t mash_seed = (spur_dodging) ?
-            _find_mash_seed(fden) :
-            static_cast<uint32_t>(fden / 2);
-
-        // Calculate actual Fcore_vco, Fvco, F_lo frequencies
-        const auto actual_fvco = pfd_freq * prescaler * (N + double(fnum) / double(fden));
-        const auto actual_fcore_vco = actual_fvco / vco_multiplier;
-        const auto actual_f_lo = actual_fcore_vco * vco_multiplier / output_divider;
+        const double actual_f_lo = solution.actual_f_lo;
 
         // Write to registers
-        _regs.pll_n = N;
-        _regs.pll_num_lsb = narrow_cast<uint16_t>(fnum);
-        _regs.pll_num_msb = narrow_cast<uint16_t>(fnum >> 16);
-        _regs.pll_den_lsb = narrow_cast<uint16_t>(fden);
-        _regs.pll_den_msb = narrow_cast<uint16_t>(fden >> 16);
-        _regs.mash_seed_lsb = narrow_cast<uint16_t>(mash_seed);
-        _regs.mash_seed_msb = narrow_cast<uint16_t>(mash_seed >> 16);
+        _set_chdiv_values(solution.output_divider_index);
+        _regs.osc_doubler = solution.osc_doubler;
+        _regs.pll_r_pre = solution.pll_r_pre;
+        _regs.mult = solution.mult;
+        _regs.pll_r = solution.pll_r;
+        _regs.pll_n_pre = solution.pll_n_pre;
+        _regs.pll_n = solution.N;
+        _regs.pll_num_lsb = narrow_cast<uint16_t>(solution.fnum);
+        _regs.pll_num_msb = narrow_cast<uint16_t>(solution.fnum >> 16);
+        _regs.pll_den_lsb = narrow_cast<uint16_t>(solution.fden);
+        _regs.pll_den_msb = narrow_cast<uint16_t>(solution.fden >> 16);
+        _regs.mash_seed_lsb = narrow_cast<uint16_t>(solution.mash_seed);
+        _regs.mash_seed_msb = narrow_cast<uint16_t>(solution.mash_seed >> 16);
 
         UHD_LOGGER_TRACE("LMX2592") << "Tuned to " << actual_f_lo;
 
@@ -407,6 +342,133 @@ private: // Members
     bool _rewrite_regs;
     double _ref_freq;
 
+    //! Divider settings for a frequency
+    struct solution_t
+    {
+        int output_divider_index;
+        uint8_t osc_doubler;
+        uint16_t pll_r_pre;
+        uint8_t mult;
+        uint8_t pll_r;
+        lmx2592_regs_t::pll_n_pre_t pll_n_pre;
+        uint16_t N;
+        uint32_t fnum;
+        uint32_t fden;
+        uint32_t mash_seed;
+        double actual_f_lo;
+    };
+
+    //! Reference and target frequency, MASH order and spur dodging settings
+    using solution_key_t = std::tuple<double, double, int, bool, double>;
+
+    //! Recently used solutions, shared by all instances
+    static uhd::lru_cache<solution_key_t, solution_t>& _get_solution_cache()
+    {
+        static uhd::lru_cache<solution_key_t, solution_t> cache(1024);
+        return cache;
+    }
+
+    solution_t _solve(const double target_freq,
+        const bool spur_dodging,
+        const double spur_dodging_threshold)
+    {
+        solution_t solution;
+
+        // Find the largest possible divider
+        auto output_divider_index = 0;
+        for (auto limit : LMX2592_CHDIV_MIN_FREQ) {
+            // The second harmonic level is very bad when using the div-by-3
+            // Skip and let the div-by-4 cover the range
+            if (LMX2592_CHDIV_DIVIDERS[output_divider_index] == 3) {
+                output_divider_index++;
+                continue;
+            }
+            if (target_freq < limit) {
+                output_divider_index++;
+            } else {
+                break;
+            }
+        }
+        const auto output_divider = LMX2592_CHDIV_DIVIDERS[output_divider_index];
+
+        // Setup input signal path and PLL loop
+        const int vco_multiplier = target_freq > LMX2592_MAX_VCO_FREQ ? 2 : 1;
+
+        const auto target_vco_freq = target_freq * output_divider;
+        const auto core_vco_freq = target_vco_freq / vco_multiplier;
+
+        double input_freq = _ref_freq;
+
+        // Input Doubler stage
+        if (input_freq <= LMX2592_MAX_DOUBLER_INPUT_FREQ) {
+            solution.osc_doubler = 1;
+            input_freq *= 2;
+        } else {
+            solution.osc_doubler = 0;
+        }
+
+        // Pre-R divider
+        solution.pll_r_pre =
+            narrow_cast<uint16_t>(std::ceil(input_freq / LMX2592_MAX_MULT_INPUT_FREQ));
+        input_freq /= solution.pll_r_pre;
+
+        // Multiplier
+        solution.mult = narrow_cast<uint8_t>(std::floor(LMX2592_MAX_MULT_OUT_FREQ / input_freq));
+        input_freq *= solution.mult;
+
+        // Post R divider
+        solution.pll_r = narrow_cast<uint8_t>(std::ceil(input_freq / LMX2592_MAX_POSTR_DIV_OUT_FREQ));
+
+        // Default to divide by 2, will be increased later if N exceeds its limit
+        int prescaler = 2;
+        solution.pll_n_pre = lmx2592_regs_t::pll_n_pre_t::PLL_N_PRE_DIVIDE_BY_2;
+
+        const int min_n_divider = LMX2592_MIN_N_DIV[_regs.mash_order];
+        double pfd_freq = input_freq / solution.pll_r;
+        while (pfd_freq * (prescaler * min_n_divider) / vco_multiplier > core_vco_freq) {
+            solution.pll_r++;
+            pfd_freq = input_freq / solution.pll_r;
+        }
+
+        // Calculate N and frac
+        const auto N_dot_F = target_vco_freq / (pfd_freq * prescaler);
+        auto N = static_cast<uint16_t>(std::floor(N_dot_F));
+        if (N > MAX_N_DIVIDER) {
+            solution.pll_n_pre = lmx2592_regs_t::pll_n_pre_t::PLL_N_PRE_DIVIDE_BY_4;
+            N /= 2;
+        }
+        const auto frac = N_dot_F - N;
+
+        // Increase VCO step size to threshold to avoid primary fractional spurs
+        const double min_vco_step_size = spur_dodging ? spur_dodging_threshold : 1;
+        // Calculate Fden
+        const auto initial_fden = static_cast<uint32_t>(std::floor(pfd_freq * prescaler / min_vco_step_size));
+        const auto fden = (spur_dodging) ? _find_fden(initial_fden) : initial_fden;
+        // Calculate Fnum
+        const auto initial_fnum = static_cast<uint32_t>(std::round(frac * fden));
+        const auto fnum = (spur_dodging) ? _find_fnum(N, initial_fnum, fden, prescaler, pfd_freq, output_divider, spur_dodging_threshold) : initial_fnum;
+
+        // Calculate mash_seed
+        // if spur_dodging is true, mash_seed is the first odd value less than fden
+        // else mash_seed is int(fden / 2);
+        const uint32_t mash_seed = (spur_dodging) ?
+            _find_mash_seed(fden) :
+            static_cast<uint32_t>(fden / 2);
+
+        // Calculate actual Fcore_vco, Fvco, F_lo frequencies
+        const auto actual_fvco = pfd_freq * prescaler * (N + double(fnum) / double(fden));
+        const auto actual_fcore_vco = actual_fvco / vco_multiplier;
+        const auto actual_f_lo = actual_fcore_vco * vco_multiplier / output_divider;
+
+        solution.output_divider_index = output_divider_index;
+        solution.N = N;
+        solution.fnum = fnum;
+        solution.fden = fden;
+        solution.mash_seed = mash_seed;
+        solution.actual_f_lo = actual_f_lo;
+        return solution;
+    }
+
     void _set_chdiv_values(const int output_divider_index) {
 
         // Configure divide segments and mux
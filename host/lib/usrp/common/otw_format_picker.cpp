@@ -0,0 +1,42 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/convert.hpp>
+#include <uhd/exception.hpp>
+#include <uhdlib/usrp/common/otw_format_picker.hpp>
+#include <boost/format.hpp>
+
+using namespace uhd::usrp;
+
+otw_format_choice_t uhd::usrp::pick_otw_format(
+    const std::vector<std::string>& otw_formats,
+    const double samp_rate,
+    const size_t num_chans,
+    const size_t frame_size,
+    const size_t header_size,
+    const double link_rate)
+{
+    UHD_ASSERT_THROW(not otw_formats.empty());
+    otw_format_choice_t choice;
+    for (const std::string& otw_format : otw_formats) {
+        const size_t bpi = uhd::convert::get_bytes_per_item(otw_format);
+        if (frame_size < header_size + bpi) {
+            throw uhd::value_error(
+                str(boost::format("A frame of %d bytes can't hold a %s sample")
+                    % frame_size % otw_format));
+        }
+        choice.otw_format = otw_format;
+        choice.spp        = (frame_size - header_size) / bpi;
+        choice.bytes_per_sec =
+            samp_rate * num_chans * (choice.spp * bpi + header_size) / choice.spp;
+        choice.fits = link_rate <= 0.0
+                      or choice.bytes_per_sec <= link_rate * OTW_LINK_HEADROOM;
+        if (choice.fits) {
+            break;
+        }
+    }
+    return choice;
+}
@@ -6,31 +6,54 @@
 //
 
 #include <uhdlib/usrp/common/recv_packet_demuxer.hpp>
+#include <uhdlib/transport/demux_turns.hpp>
+#include <uhdlib/transport/spsc_bounded_buffer.hpp>
 #include <uhd/utils/log.hpp>
 #include <uhd/utils/byteswap.hpp>
 #include <uhd/transport/vrt_if_packet.hpp>
 #include <uhd/types/metadata.hpp>
 
+#include <boost/thread/locks.hpp>
 #include <boost/thread/mutex.hpp>
-#include <queue>
-#include <deque>
+#include <memory>
 #include <vector>
 
 using namespace uhd;
 using namespace uhd::usrp;
 using namespace uhd::transport;
 
+/*!
+ * Holds an overflow error packet for one channel. The packet never changes,
+ * so the same buffer is handed out again while it may still be in use.
+ */
 struct recv_pkt_demux_mrb : public managed_recv_buffer
 {
 public:
-    recv_pkt_demux_mrb(void){/*NOP*/}
+    recv_pkt_demux_mrb(const uint32_t sid)
+    {
+        vrt::if_packet_info_t info;
+        info.packet_type = vrt::if_packet_info_t::PACKET_TYPE_DATA;
+        info.num_payload_words32 = 1;
+        info.num_payload_bytes = info.num_payload_words32*sizeof(uint32_t);
+        info.has_sid = true;
+        info.sid = sid;
+        vrt::if_hdr_pack_le(buff, info);
+        buff[info.num_header_words32] = rx_metadata_t::ERROR_CODE_OVERFLOW;
+        len = info.num_packet_words32*sizeof(uint32_t);
+    }
 
     void release(void)
     {
-        delete this;
+        /* NOP */
+    }
+
+    managed_recv_buffer::sptr get_new(void)
+    {
+        return make(this, buff, len);
     }
 
     uint32_t buff[10];
+    size_t len;
 };
 
 static UHD_INLINE uint32_t extract_sid(managed_recv_buffer::sptr &buff){
@@ -42,6 +65,11 @@ recv_packet_demuxer::~recv_packet_demuxer(void){
     /* NOP */
 }
 
+/*!
+ * There is no demux thread, see recv_packet_demuxer_3000: the thread that
+ * gets the demux mutex drains the transport into lock-free per-channel
+ * queues, the others wait on their own queue.
+ */
 class recv_packet_demuxer_impl : public uhd::usrp::recv_packet_demuxer{
 public:
     recv_packet_demuxer_impl(
@@ -49,60 +77,60 @@ public:
         const size_t size,
         const uint32_t sid_base
     ):
-        _transport(transport), _sid_base(sid_base), _queues(size)
+        _transport(transport), _sid_base(sid_base)
     {
-        /* NOP */
+        // A queue can hold all frames of the transport and a report of an
+        // unknown SID, so pushes never fail
+        const size_t capacity = _transport->get_num_recv_frames() + 1;
+        for (size_t i = 0; i < size; i++) {
+            _queues.emplace_back(new queue_type(capacity));
+            _overflow_mrbs.emplace_back(new recv_pkt_demux_mrb(_sid_base + i));
+        }
     }
 
     managed_recv_buffer::sptr get_recv_buff(const size_t index, const double timeout){
-        boost::mutex::scoped_lock lock(_mutex);
         managed_recv_buffer::sptr buff;
+        pop_with_demux_turns(*_queues.at(index), buff, timeout, [this, index](const double slice){
+            boost::unique_lock<boost::mutex> lock(_demux_mutex, boost::try_to_lock);
+            if (not lock.owns_lock()) return false;
+            _demux(index, slice);
+            return true;
+        });
+        return buff;
+    }
 
-        //there is already an entry in the queue, so pop that
-        if (not _queues[index].wrapper.empty()){
-            std::swap(buff, _queues[index].wrapper.front());
-            _queues[index].wrapper.pop();
-            return buff;
-        }
-
-        while (true){
-            //otherwise call into the transport
-            buff = _transport->get_recv_buff(timeout);
-            if (buff.get() == NULL) return buff; //timeout
-
+private:
+    typedef spsc_bounded_buffer<managed_recv_buffer::sptr> queue_type;
+
+    /*!
+     * Drain up to DEMUX_BATCH frames from the transport into the queues, only
+     * waiting for the first one. Must hold the demux mutex.
+     * A frame with an unknown SID is reported to the channel at \p index.
+     */
+    void _demux(const size_t index, const double timeout){
+        bool reported = false;
+        managed_recv_buffer::sptr buff = _transport->get_recv_buff(timeout);
+        for (size_t i = 0; buff and i < DEMUX_BATCH; i++){
             //check the stream id to know which channel
             const size_t rx_index = extract_sid(buff) - _sid_base;
-            if (rx_index == index) return buff; //got expected message
-
-            //otherwise queue and try again
-            if (rx_index < _queues.size()) _queues[rx_index].wrapper.push(buff);
+            if (rx_index < _queues.size()) _queues[rx_index]->push_with_haste(buff);
             else
             {
                 UHD_LOGGER_ERROR("STREAMER") << "Got a data packet with unknown SID " << extract_sid(buff) ;
-                recv_pkt_demux_mrb *mrb = new recv_pkt_demux_mrb();
-                vrt::if_packet_info_t info;
-                info.packet_type = vrt::if_packet_info_t::PACKET_TYPE_DATA;
-                info.num_payload_words32 = 1;
-                info.num_payload_bytes = info.num_payload_words32*sizeof(uint32_t);
-                info.has_sid = true;
-                info.sid = _sid_base + index;
-                vrt::if_hdr_pack_le(mrb->buff, info);
-                mrb->buff[info.num_header_words32] = rx_metadata_t::ERROR_CODE_OVERFLOW;
-                return mrb->make(mrb, mrb->buff, info.num_packet_words32*sizeof(uint32_t));
+                if (not reported) _queues[index]->push_with_haste(_overflow_mrbs[index]->get_new());
+                reported = true;
             }
+            buff.reset();
+            if (i + 1 < DEMUX_BATCH) buff = _transport->get_recv_buff(0.0);
         }
     }
 
-private:
     transport::zero_copy_if::sptr _transport;
     const uint32_t _sid_base;
-    boost::mutex _mutex;
-    struct channel_guts_type{
-        channel_guts_type(void): wrapper(container){}
-        std::deque<managed_recv_buffer::sptr> container;
-        std::queue<managed_recv_buffer::sptr> wrapper;
-    };
-    std::vector<channel_guts_type> _queues;
+    //! Only pushed to by the thread that holds the demux mutex
+    std::vector<std::unique_ptr<queue_type>> _queues;
+    std::vector<std::unique_ptr<recv_pkt_demux_mrb>> _overflow_mrbs;
+    boost::mutex _demux_mutex;
 };
 
 recv_packet_demuxer::sptr recv_packet_demuxer::make(transport::zero_copy_if::sptr transport, const size_t size, const uint32_t sid_base){
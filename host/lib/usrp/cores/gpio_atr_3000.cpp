@@ -5,6 +5,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 //
 
+#include <uhd/exception.hpp>
 #include <uhd/types/dict.hpp>
 #include <uhd/utils/soft_register.hpp>
 #include <uhdlib/usrp/cores/gpio_atr_3000.hpp>
@@ -103,6 +104,58 @@ public:
         _atr_idle_reg.flush();
     }
 
+    virtual void set_gpio_out_sequence(const std::vector<sequence_entry_t>& entries)
+    {
+        timed_wb_iface::sptr timed_iface =
+            boost::dynamic_pointer_cast<timed_wb_iface>(_iface);
+        if (not timed_iface) {
+            throw uhd::not_implemented_error(
+                "set_gpio_out_sequence needs a timed register interface.");
+        }
+        const size_t max_len = get_max_sequence_len();
+        if (max_len > 0 and entries.size() > max_len) {
+            throw uhd::value_error(str(
+                boost::format("GPIO sequence has %u entries, but the command FIFO "
+                              "only holds %u. Split it into shorter sequences.")
+                % entries.size() % max_len));
+        }
+
+        //Every entry is a write to the IDLE register, which holds the static outputs.
+        //Work out the register values first, so nothing changes if an entry is invalid.
+        std::vector<timed_wb_iface::timed_poke32_t> writes;
+        writes.reserve(entries.size());
+        uint32_t gpio_out = _atr_idle_reg.get_gpio_out();
+        for (size_t i = 0; i < entries.size(); i++) {
+            if (i > 0 and entries[i].time < entries[i - 1].time) {
+                throw uhd::value_error(
+                    str(boost::format("GPIO sequence entry %u is earlier than the one "
+                                      "before it.")
+                        % i));
+            }
+            gpio_out = (entries[i].value & entries[i].mask)
+                       | (gpio_out & (~entries[i].mask));
+            writes.push_back({entries[i].time,
+                _atr_idle_reg.get_offset(),
+                _atr_idle_reg.get_reg_value(gpio_out)});
+        }
+        if (writes.empty()) {
+            return;
+        }
+
+        timed_iface->poke32_schedule(writes);
+        //The device now holds the last value, update the soft copy to match
+        _atr_idle_reg.set_gpio_out_with_mask(gpio_out, MASK_SET_ALL);
+        _atr_idle_reg.set(masked_reg_t::REGISTER, writes.back().data);
+        _atr_idle_reg.mark_flushed32(writes.back().data);
+    }
+
+    virtual size_t get_max_sequence_len()
+    {
+        timed_wb_iface::sptr timed_iface =
+            boost::dynamic_pointer_cast<timed_wb_iface>(_iface);
+        return timed_iface ? timed_iface->get_cmd_fifo_size() : 0;
+    }
+
     virtual uint32_t read_gpio()
     {
         //Read the state of the GPIO pins
@@ -187,11 +240,15 @@ protected:
     class atr_idle_reg_t : public masked_reg_t {
     public:
         atr_idle_reg_t(const wb_iface::wb_addr_type offset, masked_reg_t& atr_disable_reg):
-            masked_reg_t(offset),
+            masked_reg_t(offset), _offset(offset),
             _atr_idle_cache(0), _gpio_out_cache(0),
             _atr_disable_reg(atr_disable_reg)
         { }
 
+        wb_iface::wb_addr_type get_offset() const {
+            return _offset;
+        }
+
         virtual void set_with_mask(const uint32_t value, const uint32_t mask) {
             _atr_idle_cache = (value&mask)|(_atr_idle_cache&(~mask));
         }
@@ -208,15 +265,19 @@ protected:
             return _gpio_out_cache;
         }
 
+        //! The register value that outputs \p gpio_out on the static (non-ATR) bits
+        uint32_t get_reg_value(const uint32_t gpio_out) {
+            return (_atr_idle_cache & (~_atr_disable_reg.get())) |
+                   (gpio_out & _atr_disable_reg.get());
+        }
+
         virtual void flush() {
-            set(REGISTER,
-                (_atr_idle_cache & (~_atr_disable_reg.get())) |
-                (_gpio_out_cache & _atr_disable_reg.get())
-            );
+            set(REGISTER, get_reg_value(_gpio_out_cache));
             masked_reg_t::flush();
         }
 
     private:
+        const wb_iface::wb_addr_type _offset;
         uint32_t _atr_idle_cache;
         uint32_t _gpio_out_cache;
         masked_reg_t&   _atr_disable_reg;
@@ -115,6 +115,14 @@ public:
         return bytes;
     }
 
+    //override read_eeprom so we can write once, read all N bytes
+    //the default implementation calls read i2c once per byte
+    byte_vector_t read_eeprom(uint16_t addr, uint16_t offset, size_t num_bytes)
+    {
+        this->write_i2c(addr, byte_vector_t(1, uint8_t(offset)));
+        return this->read_i2c(addr, num_bytes);
+    }
+
 private:
     void i2c_wait(void) {
         for (size_t i = 0; i < 100; i++){
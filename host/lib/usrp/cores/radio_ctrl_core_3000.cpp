@@ -13,11 +13,15 @@
 #include <uhd/transport/vrt_if_packet.hpp>
 #include <uhdlib/usrp/common/async_packet_handler.hpp>
 #include <uhdlib/usrp/cores/radio_ctrl_core_3000.hpp>
+#include <uhdlib/utils/trace.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/thread.hpp>
 #include <boost/format.hpp>
 #include <boost/bind.hpp>
+#include <chrono>
+#include <map>
 #include <queue>
+#include <set>
 
 using namespace uhd;
 using namespace uhd::usrp;
@@ -90,6 +94,23 @@ public:
         return this->wait_for_ack(true);
     }
 
+    std::shared_future<uint32_t> peek32_async(const wb_addr_type addr)
+    {
+        const size_t seq = this->send_async_peek(addr);
+        return std::async(std::launch::deferred, [this, seq, addr]() {
+            const uint64_t res = this->wait_for_async_peek(seq);
+            return ((addr/4) & 0x1)? uint32_t(res >> 32) : uint32_t(res & 0xffffffff);
+        }).share();
+    }
+
+    std::shared_future<uint64_t> peek64_async(const wb_addr_type addr)
+    {
+        const size_t seq = this->send_async_peek(addr);
+        return std::async(std::launch::deferred, [this, seq]() {
+            return this->wait_for_async_peek(seq);
+        }).share();
+    }
+
     /*******************************************************************
      * Update methods for time
      ******************************************************************/
@@ -120,6 +141,36 @@ private:
         uint32_t data[8];
     };
 
+    /*******************************************************************
+     * Asynchronous peek helpers
+     ******************************************************************/
+    //! Send a readback request, its response is kept for wait_for_async_peek()
+    size_t send_async_peek(const wb_addr_type addr)
+    {
+        boost::mutex::scoped_lock lock(_mutex);
+        const size_t seq = _seq_out;
+        this->send_pkt(SR_READBACK, addr/8);
+        _async_seqs.insert(seq);
+        this->wait_for_ack(false);
+        return seq;
+    }
+
+    //! Collect responses until the one for seq has arrived, then return it
+    uint64_t wait_for_async_peek(const size_t seq)
+    {
+        boost::mutex::scoped_lock lock(_mutex);
+        while (not _async_results.count(seq)) {
+            if (not _async_seqs.count(seq)) {
+                throw uhd::io_error(str(boost::format(
+                    "Radio ctrl (%s) lost the response to an asynchronous peek") % _name));
+            }
+            this->recv_ack();
+        }
+        const uint64_t res = _async_results[seq];
+        _async_results.erase(seq);
+        return res;
+    }
+
     /*******************************************************************
      * Primary control and interaction private methods
      ******************************************************************/
@@ -155,7 +206,7 @@ private:
         //load payload
         pkt[packet_info.num_header_words32+0] = (_bige)? uhd::htonx(addr) : uhd::htowx(addr);
         pkt[packet_info.num_header_words32+1] = (_bige)? uhd::htonx(data) : uhd::htowx(data);
-        //UHD_LOGGER_INFO("radio_ctrl") << boost::format("0x%08x, 0x%08x\n") % addr % data;
+        UHD_TRACE(RADIO_CTRL, trace, "addr: 0x", std::hex, addr, " data: 0x", data);
         //send the buffer over the interface
         _outstanding_seqs.push(_seq_out);
         buff->commit(sizeof(uint32_t)*(packet_info.num_packet_words32));
@@ -167,123 +218,142 @@ private:
     {
         while (readback or (_outstanding_seqs.size() >= _resp_queue_size))
         {
-            //get seq to ack from outstanding packets list
-            UHD_ASSERT_THROW(not _outstanding_seqs.empty());
-            const size_t seq_to_ack = _outstanding_seqs.front();
-            _outstanding_seqs.pop();
-
-            //parse the packet
-            vrt::if_packet_info_t packet_info;
-            resp_buff_type resp_buff;
-            memset(&resp_buff, 0x00, sizeof(resp_buff));
-            uint32_t const *pkt = NULL;
-            managed_recv_buffer::sptr buff;
-
-            //get buffer from response endpoint - or die in timeout
-            if (_resp_xport)
+            const uint64_t res = this->recv_ack();
+            //return the readback value
+            if (readback and _outstanding_seqs.empty())
             {
-                buff = _resp_xport->get_recv_buff(_timeout);
-                try
-                {
-                    UHD_ASSERT_THROW(bool(buff));
-                    UHD_ASSERT_THROW(buff->size() > 0);
-                }
-                catch(const std::exception &ex)
-                {
-                    throw uhd::io_error(str(boost::format("Radio ctrl (%s) no response packet - %s") % _name % ex.what()));
-                }
-                pkt = buff->cast<const uint32_t *>();
-                packet_info.num_packet_words32 = buff->size()/sizeof(uint32_t);
+                return res;
             }
+        }
 
-            //get buffer from response endpoint - or die in timeout
-            else
-            {
-                /*
-                 * Couldn't get message with haste.
-                 * Now check both possible queues for messages.
-                 * Messages should come in on _resp_queue,
-                 * but could end up in dump_queue.
-                 * If we don't get a message --> Die in timeout.
-                 */
-                double accum_timeout = 0.0;
-                const double short_timeout = 0.005; // == 5ms
-                while(not ((_resp_queue.pop_with_haste(resp_buff))
-                        || (check_dump_queue(resp_buff))
-                        || (_resp_queue.pop_with_timed_wait(resp_buff, short_timeout))
-                        )){
-                    /*
-                     * If a message couldn't be received within a given timeout
-                     * --> throw AssertionError!
-                     */
-                    accum_timeout += short_timeout;
-                    UHD_ASSERT_THROW(accum_timeout < _timeout);
-                }
-
-                pkt = resp_buff.data;
-                packet_info.num_packet_words32 = sizeof(resp_buff)/sizeof(uint32_t);
-            }
+        return 0;
+    }
 
-            //parse the buffer
+    //! Receive the response to the oldest outstanding command, return its payload
+    UHD_INLINE uint64_t recv_ack(void)
+    {
+        //get seq to ack from outstanding packets list
+        UHD_ASSERT_THROW(not _outstanding_seqs.empty());
+        const size_t seq_to_ack = _outstanding_seqs.front();
+        _outstanding_seqs.pop();
+        const bool is_async_peek = _async_seqs.erase(seq_to_ack) > 0;
+
+        //parse the packet
+        vrt::if_packet_info_t packet_info;
+        resp_buff_type resp_buff;
+        memset(&resp_buff, 0x00, sizeof(resp_buff));
+        uint32_t const *pkt = NULL;
+        managed_recv_buffer::sptr buff;
+
+        //get buffer from response endpoint - or die in timeout
+        if (_resp_xport)
+        {
+            buff = _resp_xport->get_recv_buff(_timeout);
             try
             {
-                packet_info.link_type = _link_type;
-                if (_bige) vrt::if_hdr_unpack_be(pkt, packet_info);
-                else vrt::if_hdr_unpack_le(pkt, packet_info);
+                UHD_ASSERT_THROW(bool(buff));
+                UHD_ASSERT_THROW(buff->size() > 0);
             }
             catch(const std::exception &ex)
             {
-                UHD_LOGGER_ERROR("radio_ctrl") << "Radio ctrl bad VITA packet: " << ex.what() ;
-                if (buff){
-                    UHD_VAR(buff->size());
-                }
-                else{
-                    UHD_LOGGER_INFO("radio_ctrl") << "buff is NULL" ;
-                }
-                UHD_LOGGER_INFO("radio_ctrl") << std::hex << pkt[0] << std::dec ;
-                UHD_LOGGER_INFO("radio_ctrl") << std::hex << pkt[1] << std::dec ;
-                UHD_LOGGER_INFO("radio_ctrl") << std::hex << pkt[2] << std::dec ;
-                UHD_LOGGER_INFO("radio_ctrl") << std::hex << pkt[3] << std::dec ;
+                throw uhd::io_error(str(boost::format("Radio ctrl (%s) no response packet - %s") % _name % ex.what()));
             }
+            pkt = buff->cast<const uint32_t *>();
+            packet_info.num_packet_words32 = buff->size()/sizeof(uint32_t);
+        }
 
-            //check the buffer
-            try
-            {
-                UHD_ASSERT_THROW(packet_info.has_sid);
-                UHD_ASSERT_THROW(packet_info.sid == uint32_t((_sid >> 16) | (_sid << 16)));
-                UHD_ASSERT_THROW(packet_info.packet_count == (seq_to_ack & 0xfff));
-                UHD_ASSERT_THROW(packet_info.num_payload_words32 == 2);
-                UHD_ASSERT_THROW(packet_info.packet_type == _packet_type);
-            }
-            catch(const std::exception &ex)
-            {
-                throw uhd::io_error(str(boost::format("Radio ctrl (%s) packet parse error - %s") % _name % ex.what()));
+        //get buffer from response endpoint - or die in timeout
+        else
+        {
+            /*
+             * Couldn't get message with haste.
+             * Now check both possible queues for messages.
+             * Messages should come in on _resp_queue,
+             * but could end up in dump_queue.
+             * With a response pump, pull them in ourselves while waiting.
+             * If we don't get a message --> Die in timeout.
+             */
+            const auto exit_time = std::chrono::steady_clock::now()
+                + std::chrono::microseconds(int64_t(_timeout * 1e6));
+            const double short_timeout = 0.005; // == 5ms
+            while(not ((_resp_queue.pop_with_haste(resp_buff))
+                    || (check_dump_queue(resp_buff))
+                    || (not (_response_pump and _response_pump(short_timeout))
+                        and _resp_queue.pop_with_timed_wait(resp_buff, short_timeout))
+                    )){
+                /*
+                 * If a message couldn't be received within a given timeout
+                 * --> throw AssertionError!
+                 */
+                UHD_ASSERT_THROW(std::chrono::steady_clock::now() < exit_time);
             }
 
-            //return the readback value
-            if (readback and _outstanding_seqs.empty())
-            {
-                const uint64_t hi = (_bige)? uhd::ntohx(pkt[packet_info.num_header_words32+0]) : uhd::wtohx(pkt[packet_info.num_header_words32+0]);
-                const uint64_t lo = (_bige)? uhd::ntohx(pkt[packet_info.num_header_words32+1]) : uhd::wtohx(pkt[packet_info.num_header_words32+1]);
-                return ((hi << 32) | lo);
+            pkt = resp_buff.data;
+            packet_info.num_packet_words32 = sizeof(resp_buff)/sizeof(uint32_t);
+        }
+
+        //parse the buffer
+        try
+        {
+            packet_info.link_type = _link_type;
+            if (_bige) vrt::if_hdr_unpack_be(pkt, packet_info);
+            else vrt::if_hdr_unpack_le(pkt, packet_info);
+        }
+        catch(const std::exception &ex)
+        {
+            UHD_LOGGER_ERROR("radio_ctrl") << "Radio ctrl bad VITA packet: " << ex.what() ;
+            if (buff){
+                UHD_VAR(buff->size());
+            }
+            else{
+                UHD_LOGGER_INFO("radio_ctrl") << "buff is NULL" ;
             }
+            UHD_LOGGER_INFO("radio_ctrl") << std::hex << pkt[0] << std::dec ;
+            UHD_LOGGER_INFO("radio_ctrl") << std::hex << pkt[1] << std::dec ;
+            UHD_LOGGER_INFO("radio_ctrl") << std::hex << pkt[2] << std::dec ;
+            UHD_LOGGER_INFO("radio_ctrl") << std::hex << pkt[3] << std::dec ;
         }
 
-        return 0;
+        //check the buffer
+        try
+        {
+            UHD_ASSERT_THROW(packet_info.has_sid);
+            UHD_ASSERT_THROW(packet_info.sid == uint32_t((_sid >> 16) | (_sid << 16)));
+            UHD_ASSERT_THROW(packet_info.packet_count == (seq_to_ack & 0xfff));
+            UHD_ASSERT_THROW(packet_info.num_payload_words32 == 2);
+            UHD_ASSERT_THROW(packet_info.packet_type == _packet_type);
+        }
+        catch(const std::exception &ex)
+        {
+            throw uhd::io_error(str(boost::format("Radio ctrl (%s) packet parse error - %s") % _name % ex.what()));
+        }
+
+        const uint64_t hi = (_bige)? uhd::ntohx(pkt[packet_info.num_header_words32+0]) : uhd::wtohx(pkt[packet_info.num_header_words32+0]);
+        const uint64_t lo = (_bige)? uhd::ntohx(pkt[packet_info.num_header_words32+1]) : uhd::wtohx(pkt[packet_info.num_header_words32+1]);
+        const uint64_t res = ((hi << 32) | lo);
+        //keep the readback value of an asynchronous peek
+        if (is_async_peek)
+        {
+            _async_results[seq_to_ack] = res;
+        }
+        return res;
     }
 
     /*
      * If ctrl_core waits for a message that didn't arrive it can search for it in the dump queue.
      * This actually happens during shutdown.
-     * handle_async_task can't access radio_ctrl_cores queue anymore thus it returns the corresponding message.
+     * The task feeding push_response can't access radio_ctrl_cores queue anymore thus it returns the corresponding message.
      * msg_task class implements a dump_queue to store such messages.
      * With check_dump_queue we can check if a message we are waiting for got stranded there.
      * If a message got stuck we get it here and push it onto our own message_queue.
      */
     bool check_dump_queue(resp_buff_type& b) {
-        const size_t min_buff_size = 8; // Same value as in b200_io_impl->handle_async_task
+        const size_t min_buff_size = 8; // Header and SID
         uint32_t recv_sid = (((_sid)<<16)|((_sid)>>16));
         uhd::msg_task::msg_payload_t msg;
+        if (not _async_task) {
+            return false;
+        }
         do{
             msg = _async_task->get_msg_from_dump_queue(recv_sid);
         }
@@ -308,12 +378,18 @@ private:
         _async_task = task;
     }
 
+    void set_response_pump(const response_pump_t &pump)
+    {
+        _response_pump = pump;
+    }
+
     const vrt::if_packet_info_t::link_type_t _link_type;
     const vrt::if_packet_info_t::packet_type_t _packet_type;
     const bool _bige;
     const uhd::transport::zero_copy_if::sptr _ctrl_xport;
     const uhd::transport::zero_copy_if::sptr _resp_xport;
     uhd::msg_task::sptr _async_task;
+    response_pump_t _response_pump;
     const uint32_t _sid;
     const std::string _name;
     boost::mutex _mutex;
@@ -323,6 +399,10 @@ private:
     double _tick_rate;
     double _timeout;
     std::queue<size_t> _outstanding_seqs;
+    //! Asynchronous peeks that are waiting for their response
+    std::set<size_t> _async_seqs;
+    //! Responses to asynchronous peeks that nobody has collected yet
+    std::map<size_t, uint64_t> _async_results;
     bounded_buffer<resp_buff_type> _resp_queue;
     const size_t _resp_queue_size;
 };
@@ -244,13 +244,38 @@ public:
 
     double set_freq(const double requested_freq)
     {
-        double actual_freq;
-        int32_t freq_word;
+        return set_freq_word(get_freq_word(requested_freq));
+    }
+
+    dsp_freq_word_t get_freq_word(const double requested_freq)
+    {
+        dsp_freq_word_t freq_word;
         get_freq_and_freq_word(
-            requested_freq + _dsp_freq_offset, _tick_rate, actual_freq, freq_word);
-        _iface->poke32(REG_DSP_RX_FREQ, uint32_t(freq_word));
-        _current_freq = actual_freq;
-        return actual_freq;
+            requested_freq + _dsp_freq_offset, _tick_rate, freq_word.freq, freq_word.word);
+        return freq_word;
+    }
+
+    double set_freq_word(const dsp_freq_word_t& freq_word)
+    {
+        _iface->poke32(REG_DSP_RX_FREQ, uint32_t(freq_word.word));
+        _current_freq = freq_word.freq;
+        return _current_freq;
+    }
+
+    void set_freq_hops(const std::vector<dsp_freq_hop_t>& hops)
+    {
+        timed_wb_iface::sptr timed_iface =
+            boost::dynamic_pointer_cast<timed_wb_iface>(_iface);
+        if (not timed_iface) {
+            throw uhd::not_implemented_error(
+                "DSP frequency hops require a timed control interface");
+        }
+        const time_spec_t cmd_time = timed_iface->get_time();
+        for (const dsp_freq_hop_t& hop : hops) {
+            timed_iface->set_time(hop.time);
+            set_freq_word(hop.freq_word);
+        }
+        timed_iface->set_time(cmd_time);
     }
 
     double get_freq(void)
@@ -40,12 +40,7 @@ public:
         boost::lock_guard<boost::mutex> lock(_mutex);
 
         //load SPI divider
-        size_t spi_divider = _div;
-        if (config.use_custom_divider) {
-            //The resulting SPI frequency will be f_system/(2*(divider+1))
-            //This math ensures the frequency will be equal to or less than the target
-            spi_divider = (config.divider-1)/2;
-        }
+        const size_t spi_divider = get_divider(config);
 
         //conditionally send SPI divider
         if (spi_divider != _divider_cache) {
@@ -54,11 +49,7 @@ public:
         }
 
         //load control word
-        uint32_t ctrl_word = 0;
-        ctrl_word |= ((which_slave & 0xffffff) << 0);
-        ctrl_word |= ((num_bits & 0x3f) << 24);
-        if (config.mosi_edge == spi_config_t::EDGE_FALL) ctrl_word |= (1 << 31);
-        if (config.miso_edge == spi_config_t::EDGE_RISE) ctrl_word |= (1 << 30);
+        const uint32_t ctrl_word = get_ctrl_word(which_slave, config, num_bits);
 
         //conditionally send control word
         if (_ctrl_word_cache != ctrl_word)
@@ -82,6 +73,40 @@ public:
         return 0;
     }
 
+    void write_spi_list(
+        int which_slave,
+        const spi_config_t &config,
+        const std::vector<uint32_t> &data,
+        size_t num_bits
+    ){
+        boost::lock_guard<boost::mutex> lock(_mutex);
+
+        const size_t spi_divider = get_divider(config);
+        const uint32_t ctrl_word = get_ctrl_word(which_slave, config, num_bits);
+
+        //the settings go first, when they change, then all data words. The
+        //core runs the transactions back to back, so nothing is read back.
+        std::vector<wb_iface::wb_addr_type> addrs;
+        std::vector<uint32_t> words;
+        addrs.reserve(data.size() + 2);
+        words.reserve(data.size() + 2);
+        if (spi_divider != _divider_cache) {
+            addrs.push_back(SPI_DIV);
+            words.push_back(spi_divider);
+        }
+        if (ctrl_word != _ctrl_word_cache) {
+            addrs.push_back(SPI_CTRL);
+            words.push_back(ctrl_word);
+        }
+        for (const uint32_t word : data) {
+            addrs.push_back(SPI_DATA);
+            words.push_back(word << (32 - num_bits));
+        }
+        _iface->multi_poke32(addrs, words);
+        _divider_cache = spi_divider;
+        _ctrl_word_cache = ctrl_word;
+    }
+
     void set_shutdown(const bool shutdown)
     {
         _shutdown_cache = shutdown;
@@ -99,6 +124,26 @@ public:
     }
 
 private:
+    size_t get_divider(const spi_config_t &config) const
+    {
+        if (config.use_custom_divider) {
+            //The resulting SPI frequency will be f_system/(2*(divider+1))
+            //This math ensures the frequency will be equal to or less than the target
+            return (config.divider-1)/2;
+        }
+        return _div;
+    }
+
+    static uint32_t get_ctrl_word(
+        int which_slave, const spi_config_t &config, size_t num_bits)
+    {
+        uint32_t ctrl_word = 0;
+        ctrl_word |= ((which_slave & 0xffffff) << 0);
+        ctrl_word |= ((num_bits & 0x3f) << 24);
+        if (config.mosi_edge == spi_config_t::EDGE_FALL) ctrl_word |= (1 << 31);
+        if (config.miso_edge == spi_config_t::EDGE_RISE) ctrl_word |= (1 << 30);
+        return ctrl_word;
+    }
 
     wb_iface::sptr _iface;
     const size_t _base;
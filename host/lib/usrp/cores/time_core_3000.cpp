@@ -7,8 +7,10 @@
 
 #include <uhd/utils/safe_call.hpp>
 #include <uhd/utils/log.hpp>
+#include <uhdlib/usrp/common/device_time_model.hpp>
 #include <uhdlib/usrp/cores/time_core_3000.hpp>
 #include <chrono>
+#include <mutex>
 #include <thread>
 
 #define REG_TIME_HI       _base + 0
@@ -19,7 +21,11 @@
 #define CTRL_LATCH_TIME_PPS     (1 << 1)
 #define CTRL_LATCH_TIME_SYNC    (1 << 2)
 
+//! A time latched on PPS or sync is set within this time, don't model it before
+static const std::chrono::milliseconds LATCH_HOLD_TIME(1500);
+
 using namespace uhd;
+using namespace uhd::usrp;
 
 time_core_3000::~time_core_3000(void){
     /* NOP */
@@ -33,7 +39,8 @@ struct time_core_3000_impl : time_core_3000
     ):
         _iface(iface),
         _base(base),
-        _readback_bases(readback_bases)
+        _readback_bases(readback_bases),
+        _max_error(0.0)
     {
         this->set_tick_rate(1); //init to non zero
     }
@@ -48,7 +55,9 @@ struct time_core_3000_impl : time_core_3000
 
     void set_tick_rate(const double rate)
     {
+        std::lock_guard<std::mutex> lock(_model_mutex);
         _tick_rate = rate;
+        _model.reset();
     }
 
     void self_test(void)
@@ -77,8 +86,39 @@ struct time_core_3000_impl : time_core_3000
 
     uhd::time_spec_t get_time_now(void)
     {
+        std::lock_guard<std::mutex> lock(_model_mutex);
+        if (_max_error <= 0.0) {
+            const uint64_t ticks = _iface->peek64(_readback_bases.rb_now);
+            return time_spec_t::from_ticks(ticks, _tick_rate);
+        }
+
+        const auto host_before = device_time_model::clock_type::now();
+        if (host_before >= _hold_until
+            and _model.get_error(host_before) <= _max_error) {
+            return _model.get_time(host_before);
+        }
+        //calibrate the model with this readback
         const uint64_t ticks = _iface->peek64(_readback_bases.rb_now);
-        return time_spec_t::from_ticks(ticks, _tick_rate);
+        const auto host_after = device_time_model::clock_type::now();
+        const time_spec_t time = time_spec_t::from_ticks(ticks, _tick_rate);
+        _model.add_readback(host_before, host_after, time, 1.0 / _tick_rate);
+        return time;
+    }
+
+    void set_time_model(const double max_error)
+    {
+        std::lock_guard<std::mutex> lock(_model_mutex);
+        _max_error = max_error;
+        _model.reset();
+    }
+
+    double get_time_error(void)
+    {
+        std::lock_guard<std::mutex> lock(_model_mutex);
+        if (_max_error <= 0.0) {
+            return 0.0;
+        }
+        return _model.get_error(device_time_model::clock_type::now());
     }
 
     uhd::time_spec_t get_time_last_pps(void)
@@ -93,6 +133,7 @@ struct time_core_3000_impl : time_core_3000
         _iface->poke32(REG_TIME_HI, uint32_t(ticks >> 32));
         _iface->poke32(REG_TIME_LO, uint32_t(ticks >> 0));
         _iface->poke32(REG_TIME_CTRL, CTRL_LATCH_TIME_NOW);
+        reset_model(false);
     }
 
     void set_time_sync(const uhd::time_spec_t &time)
@@ -101,6 +142,7 @@ struct time_core_3000_impl : time_core_3000
         _iface->poke32(REG_TIME_HI, uint32_t(ticks >> 32));
         _iface->poke32(REG_TIME_LO, uint32_t(ticks >> 0));
         _iface->poke32(REG_TIME_CTRL, CTRL_LATCH_TIME_SYNC);
+        reset_model(true);
     }
 
     void set_time_next_pps(const uhd::time_spec_t &time)
@@ -109,12 +151,27 @@ struct time_core_3000_impl : time_core_3000
         _iface->poke32(REG_TIME_HI, uint32_t(ticks >> 32));
         _iface->poke32(REG_TIME_LO, uint32_t(ticks >> 0));
         _iface->poke32(REG_TIME_CTRL, CTRL_LATCH_TIME_PPS);
+        reset_model(true);
+    }
+
+    //! Start the model over, and read the time for a while if it's set on a latch
+    void reset_model(const bool latched)
+    {
+        std::lock_guard<std::mutex> lock(_model_mutex);
+        _model.reset();
+        if (latched) {
+            _hold_until = device_time_model::clock_type::now() + LATCH_HOLD_TIME;
+        }
     }
 
     wb_iface::sptr _iface;
     const size_t _base;
     const readback_bases_type _readback_bases;
     double _tick_rate;
+    std::mutex _model_mutex;
+    double _max_error;
+    device_time_model _model;
+    device_time_model::clock_type::time_point _hold_until;
 };
 
 time_core_3000::sptr time_core_3000::make(
@@ -61,6 +61,15 @@ public:
             E3XX_TUNE_TIMEOUT, this->_rpc_prefix + "catalina_tune", which, value);
     }
 
+    std::vector<double> set_fastlock_profiles(
+        const std::string& which, const std::vector<double>& freqs)
+    {
+        return _rpcc->request_with_token<std::vector<double>>(E3XX_TUNE_TIMEOUT,
+            this->_rpc_prefix + "set_fastlock_profiles",
+            which,
+            freqs);
+    }
+
     void set_dc_offset_auto(const std::string& which, const bool on)
     {
         _rpcc->request_with_token<void>(
@@ -46,6 +46,9 @@ namespace {
     const size_t EISCAT_NUM_FIR_SETS      = 1024; // BRAM must be at least EISCAT_NUM_FIR_TAPS * EISCAT_NUM_FIR_SETS
     const size_t EISCAT_FIR_INDEX_IMPULSE = 1002;
     const size_t EISCAT_FIR_INDEX_ZEROS   = 1003;
+    // Filter sets 640...959 hold the two banks of the fir_matrix property
+    const size_t EISCAT_FIR_MATRIX_BASE   = 640;
+    const size_t EISCAT_FIR_MATRIX_SIZE   = EISCAT_NUM_BEAMS * EISCAT_NUM_ANTENNAS;
 
     const uint32_t EISCAT_CONTRIB_LOWER   = 0<<0;
     const uint32_t EISCAT_CONTRIB_UPPER   = 1<<0;
@@ -139,6 +142,15 @@ UHD_RFNOC_RADIO_BLOCK_CONSTRUCTOR(eiscat_radio_ctrl)
             )
         ;
     }
+    // Not in the XML file either
+    _tree->create<std::vector<fir_tap_t>>(get_arg_path("fir_matrix", 0) / "value")
+        .add_coerced_subscriber([this](const std::vector<fir_tap_t> &taps){
+            this->load_fir_matrix(
+                taps,
+                this->get_arg<time_spec_t>("fir_ctrl_time", 0)
+            );
+        })
+    ;
 
 
     /**** Add subscribers for our special properties ************************/
@@ -535,6 +547,7 @@ void eiscat_radio_ctrl_impl::set_rx_streamer(bool active, const size_t port)
         ));
     }
     _rx_streamer_active[port] = active;
+    _graph_changed(true);
     if (not check_radio_config()) {
         throw std::runtime_error(str(
             boost::format("[%s]: Invalid radio configuration.")
@@ -739,16 +752,82 @@ void eiscat_radio_ctrl_impl::write_fir_taps(
         boost::format("Writing %d filter taps for filter index %d")
         % taps.size() % fir_idx
     ));
+    std::vector<uint32_t> reg_values;
     for (size_t i = 0; i < EISCAT_NUM_FIR_TAPS; i++) {
-        // Payload:
-        // - bottom 14 bits address, fir_idx * 16 + tap_index
-        // - top 18 bits are value
-        uint32_t reg_value = (fir_idx * 16) + i;;
-        if (taps.size() > i) {
-            reg_value |= (taps[i] & 0x3FFFF) << 14;
+        reg_values.push_back(
+            get_fir_tap_reg_value(fir_idx, i, (taps.size() > i) ? taps[i] : 0));
+    }
+    sr_write(get_sr_addr("SR_FIR_BRAM_WRITE_TAPS"), reg_values);
+}
+
+void eiscat_radio_ctrl_impl::load_fir_matrix(
+    const std::vector<eiscat_radio_ctrl_impl::fir_tap_t> &taps,
+    const uhd::time_spec_t &time_spec
+) {
+    if (taps.size() != EISCAT_FIR_MATRIX_SIZE * EISCAT_NUM_FIR_TAPS) {
+        throw uhd::value_error(str(
+            boost::format("Invalid FIR matrix size: %d taps, expected %d")
+            % taps.size() % (EISCAT_FIR_MATRIX_SIZE * EISCAT_NUM_FIR_TAPS)
+        ));
+    }
+    for (const auto &tap: taps) {
+        if (tap > EISCAT_MAX_TAP_VALUE or tap < EISCAT_MIN_TAP_VALUE) {
+            throw uhd::value_error(str(
+                boost::format("Filter tap in FIR matrix exceeds dynamic range "
+                              "(%d bits are allowed)")
+                % EISCAT_BITS_PER_TAP
+            ));
+        }
+    }
+
+    // Load the taps into the bank that's not in use, and then switch all
+    // filters over to it at once
+    const size_t fir_base =
+        EISCAT_FIR_MATRIX_BASE + _next_fir_matrix_bank * EISCAT_FIR_MATRIX_SIZE;
+    const bool send_now = (time_spec == uhd::time_spec_t(0.0));
+    UHD_LOG_DEBUG("EISCAT", str(
+        boost::format("Loading FIR matrix into filter indices %d...%d, "
+                      "switching over %s")
+        % fir_base % (fir_base + EISCAT_FIR_MATRIX_SIZE - 1)
+        % (send_now ? std::string("now")
+                    : str(boost::format("at time %f") % time_spec.get_real_secs()))
+    ));
+
+    // All writes go out as one pipelined batch. They are not timed, the
+    // switch over time is in the FIR control time registers.
+    std::vector<timed_sr_write_t> writes;
+    writes.reserve(taps.size() + EISCAT_FIR_MATRIX_SIZE + 2);
+    const uint32_t taps_addr = get_sr_addr("SR_FIR_BRAM_WRITE_TAPS");
+    for (size_t i = 0; i < EISCAT_FIR_MATRIX_SIZE; i++) {
+        for (size_t j = 0; j < EISCAT_NUM_FIR_TAPS; j++) {
+            writes.push_back({time_spec_t(0.0),
+                taps_addr,
+                get_fir_tap_reg_value(
+                    fir_base + i, j, taps[i * EISCAT_NUM_FIR_TAPS + j])});
+        }
+    }
+    if (not send_now) {
+        const uint64_t cmd_time_ticks = time_spec.to_ticks(EISCAT_TICK_RATE);
+        writes.push_back({time_spec_t(0.0),
+            get_sr_addr("SR_FIR_COMMANDS_CTRL_TIME_LO"),
+            uint32_t(cmd_time_ticks & 0xFFFFFFFF)});
+        writes.push_back({time_spec_t(0.0),
+            get_sr_addr("SR_FIR_COMMANDS_CTRL_TIME_HI"),
+            uint32_t((cmd_time_ticks >> 32) & 0xFFFFFFFF)});
+    }
+    const uint32_t reload_addr = get_sr_addr("SR_FIR_COMMANDS_RELOAD");
+    for (size_t beam = 0; beam < EISCAT_NUM_BEAMS; beam++) {
+        for (size_t ant = 0; ant < EISCAT_NUM_ANTENNAS; ant++) {
+            writes.push_back({time_spec_t(0.0),
+                reload_addr,
+                get_fir_select_reg_value(beam,
+                    ant,
+                    fir_base + beam * EISCAT_NUM_ANTENNAS + ant,
+                    send_now)});
         }
-        sr_write("SR_FIR_BRAM_WRITE_TAPS", reg_value);
     }
+    sr_write_schedule(writes);
+    _next_fir_matrix_bank = 1 - _next_fir_matrix_bank;
 }
 
 void eiscat_radio_ctrl_impl::select_filter(
@@ -779,12 +858,8 @@ void eiscat_radio_ctrl_impl::select_filter(
         << " and antenna " << antenna_index
     ;
     bool send_now = (time_spec == uhd::time_spec_t(0.0));
-    uint32_t reg_value = 0
-        | (fir_index * 16)
-        | (antenna_index & 0xF) << 14
-        | (beam_index & 0xF) << 18
-        | send_now << 22
-    ;
+    const uint32_t reg_value =
+        get_fir_select_reg_value(beam_index, antenna_index, fir_index, send_now);
     if (not send_now) {
         UHD_LOG_TRACE("EISCAT", str(
             boost::format("Filter selection will be applied at "
@@ -802,6 +877,42 @@ void eiscat_radio_ctrl_impl::select_filter(
     sr_write("SR_FIR_COMMANDS_RELOAD", reg_value);
 }
 
+uint32_t eiscat_radio_ctrl_impl::get_fir_tap_reg_value(
+    const size_t fir_idx,
+    const size_t tap_idx,
+    const fir_tap_t tap
+) {
+    // Payload:
+    // - bottom 14 bits address, fir_idx * 16 + tap_index
+    // - top 18 bits are value
+    return uint32_t((fir_idx * 16) + tap_idx) | (uint32_t(tap) & 0x3FFFF) << 14;
+}
+
+uint32_t eiscat_radio_ctrl_impl::get_fir_select_reg_value(
+    const size_t beam_index,
+    const size_t antenna_index,
+    const size_t fir_index,
+    const bool send_now
+) {
+    return 0
+        | uint32_t(fir_index * 16)
+        | (antenna_index & 0xF) << 14
+        | (beam_index & 0xF) << 18
+        | uint32_t(send_now) << 22
+    ;
+}
+
+uint32_t eiscat_radio_ctrl_impl::get_sr_addr(const std::string &reg)
+{
+    const fs_path reg_path = _root_path / "registers" / "sr" / reg;
+    if (not _tree->exists(reg_path)) {
+        throw uhd::key_error(str(
+            boost::format("Unknown settings register name: %s") % reg
+        ));
+    }
+    return uint32_t(_tree->access<size_t>(reg_path).get());
+}
+
 void eiscat_radio_ctrl_impl::set_fir_ctrl_time(
     const uhd::time_spec_t &time_spec
 ) {
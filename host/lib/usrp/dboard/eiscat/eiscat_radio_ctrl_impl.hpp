@@ -47,6 +47,17 @@ namespace uhd {
  * - fir_taps (vector<int32_t>): Updates FIR tap values in the BRAM. Port is
  *                               the filter index. Will always return an impulse
  *                               response, not the actual filter value.
+ * - fir_matrix (vector<int32_t>): Loads the taps of all 160 filters of the
+ *                                 FIR matrix at once and applies them at
+ *                                 fir_ctrl_time. The taps are ordered by beam,
+ *                                 then antenna, then tap, i.e. there are
+ *                                 10 * 16 * 10 values. The matrix is double
+ *                                 buffered in filter indices 640...959: The
+ *                                 taps go into the half that isn't in use,
+ *                                 while the other half keeps running until the
+ *                                 switch. Don't load another matrix before the
+ *                                 previous one was applied. fir_select does not
+ *                                 read back the filters selected this way.
  * - assert_adcs_deframers (bool): Writing this does nothing. Reading it back
  *                                 will run the initialization of ADCs and
  *                                 deframers. Return value is success.
@@ -188,6 +199,25 @@ private:
         const std::vector<fir_tap_t> &taps
     );
 
+    /*! Load and apply the filters of the whole FIR matrix
+     *
+     * The taps are written to the bank of filter sets that's not in use, and
+     * all beam and antenna contributions are switched over to them at
+     * \p time_spec. Everything goes out in one pipelined batch of commands.
+     *
+     * \param taps EISCAT_NUM_FIR_TAPS taps per filter, for every antenna of
+     *             every beam, i.e. taps[(beam * 16 + antenna) * 10 + tap]
+     * \param time_spec If non-zero, the filters get switched at this time.
+     *                  Otherwise, they get switched now.
+     *
+     * \throws uhd::value_error if the number of taps is wrong, or if any tap
+     *                          has more bits than allowed.
+     */
+    void load_fir_matrix(
+        const std::vector<fir_tap_t> &taps,
+        const uhd::time_spec_t &time_spec
+    );
+
     /*! Choose a filter to be applied between an output beam and antenna input
      *
      * \param beam_index Beam index
@@ -219,6 +249,27 @@ private:
      */
     void set_fir_ctrl_time(const uhd::time_spec_t &time_spec);
 
+    //! Returns the SR_FIR_BRAM_WRITE_TAPS value that writes one tap
+    static uint32_t get_fir_tap_reg_value(
+        const size_t fir_idx,
+        const size_t tap_idx,
+        const fir_tap_t tap
+    );
+
+    //! Returns the SR_FIR_COMMANDS_RELOAD value that selects one filter
+    static uint32_t get_fir_select_reg_value(
+        const size_t beam_index,
+        const size_t antenna_index,
+        const size_t fir_index,
+        const bool send_now
+    );
+
+    /*! Returns the address of a settings register by its name
+     *
+     * \throws uhd::key_error if \p reg is not a valid register name
+     */
+    uint32_t get_sr_addr(const std::string &reg);
+
     /*! Sets the digital gain on a specific antenna
      *
      * \param antenna_idx Antenna for which this gain setting applies
@@ -280,6 +331,9 @@ private:
     // number of active dboards.
     size_t _num_dboards = 0;
 
+    //! The bank of filter sets that the next FIR matrix is loaded into
+    size_t _next_fir_matrix_bank = 0;
+
     //! Additional block args; gets set during set_rpc_client()
     uhd::device_addr_t _block_args;
 
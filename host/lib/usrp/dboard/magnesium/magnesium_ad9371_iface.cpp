@@ -49,6 +49,21 @@ double magnesium_ad9371_iface::set_frequency(
     return actual_freq;
 }
 
+std::vector<double> magnesium_ad9371_iface::characterize_lo_freqs(
+    const std::vector<double>& freqs, const direction_t dir)
+{
+    // Note: Like set_frequency(), this applies to both channels. Every
+    // frequency is one tune, plus one to restore the current frequency.
+    auto which             = _get_which(dir, 0);
+    const uint64_t timeout = MAGNESIUM_TUNE_TIMEOUT * (freqs.size() + 1);
+    auto actual_freqs =
+        request<std::vector<double>>(timeout, "characterize_lo_freqs", which, freqs);
+    UHD_LOG_TRACE(_log_prefix,
+        _rpc_prefix << "characterize_lo_freqs returned " << actual_freqs.size()
+                    << " frequencies");
+    return actual_freqs;
+}
+
 double magnesium_ad9371_iface::set_gain(
     const double gain, const size_t chan, const direction_t dir)
 {
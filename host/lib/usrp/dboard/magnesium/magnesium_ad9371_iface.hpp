@@ -11,6 +11,7 @@
 #include <uhdlib/utils/rpc.hpp>
 #include <iostream>
 #include <string>
+#include <vector>
 
 class magnesium_ad9371_iface
 {
@@ -24,6 +25,13 @@ public:
 
     double get_frequency(const size_t chan, const uhd::direction_t dir);
 
+    /*! Pre-characterize AD9371 LO frequencies so retuning to them is faster
+     *
+     * \return the actual LO frequencies
+     */
+    std::vector<double> characterize_lo_freqs(
+        const std::vector<double>& freqs, const uhd::direction_t dir);
+
     double set_gain(const double gain, const size_t chan, const uhd::direction_t dir);
 
     double get_gain(const size_t chan, const uhd::direction_t dir);
@@ -307,6 +307,70 @@ double magnesium_radio_ctrl_impl::get_rx_frequency(const size_t chan)
     UHD_LOG_TRACE(unique_id(), "get_rx_frequency(chan=" << chan << ")");
     return radio_ctrl_impl::get_rx_frequency(chan);
 }
+std::vector<double> magnesium_radio_ctrl_impl::set_tx_hop_list(
+    const std::vector<double>& freqs, const size_t chan)
+{
+    UHD_LOG_TRACE(unique_id(),
+        "set_tx_hop_list(num_freqs=" << freqs.size() << ", chan=" << chan << ")");
+    std::lock_guard<std::mutex> l(_set_lock);
+    return _set_hop_list(freqs, chan, TX_DIRECTION);
+}
+
+std::vector<double> magnesium_radio_ctrl_impl::set_rx_hop_list(
+    const std::vector<double>& freqs, const size_t chan)
+{
+    UHD_LOG_TRACE(unique_id(),
+        "set_rx_hop_list(num_freqs=" << freqs.size() << ", chan=" << chan << ")");
+    std::lock_guard<std::mutex> l(_set_lock);
+    return _set_hop_list(freqs, chan, RX_DIRECTION);
+}
+
+std::vector<double> magnesium_radio_ctrl_impl::_set_hop_list(
+    const std::vector<double>& freqs, const size_t chan, const direction_t dir)
+{
+    const std::string ad9371_source = dir == TX_DIRECTION
+                                          ? this->get_tx_lo_source(MAGNESIUM_LO1, chan)
+                                          : this->get_rx_lo_source(MAGNESIUM_LO1, chan);
+    if (ad9371_source != "internal") {
+        throw uhd::runtime_error(
+            "Can't pre-load a hop list when the AD9371 LO source is not internal");
+    }
+    adf435x_iface::sptr lo_iface = dir == TX_DIRECTION ? _tx_lo : _rx_lo;
+    const double if_freq         = dir == TX_DIRECTION ? MAGNESIUM_TX_IF_FREQ
+                                                       : MAGNESIUM_RX_IF_FREQ;
+
+    // Work out the AD9371 LO frequencies the same way set_rx_frequency() and
+    // set_tx_frequency() do. This only updates the ADF4351 register settings,
+    // nothing is written to it.
+    std::vector<double> ad9371_freqs;
+    std::vector<double> adf4351_freqs;
+    for (const double req_freq : freqs) {
+        const double freq = MAGNESIUM_FREQ_RANGE.clip(req_freq);
+        const bool is_low_band =
+            dir == TX_DIRECTION
+                ? _map_freq_to_tx_band(_tx_band_map, freq) == tx_band::LOWBAND
+                : _map_freq_to_rx_band(_rx_band_map, freq) == rx_band::LOWBAND;
+        const double adf4351_freq =
+            is_low_band
+                ? _lo_set_frequency(lo_iface, if_freq - freq, _master_clock_rate, false)
+                : 0.0;
+        adf4351_freqs.push_back(adf4351_freq);
+        ad9371_freqs.push_back(adf4351_freq + freq);
+    }
+    if (_is_low_band[dir]) {
+        _lo_set_frequency(lo_iface, _adf4351_freq[dir], _master_clock_rate, false);
+    }
+
+    const std::vector<double> actual_ad9371_freqs =
+        _ad9371->characterize_lo_freqs(ad9371_freqs, dir);
+    UHD_ASSERT_THROW(actual_ad9371_freqs.size() == freqs.size());
+    std::vector<double> rf_freqs;
+    for (size_t i = 0; i < freqs.size(); i++) {
+        rf_freqs.push_back(actual_ad9371_freqs[i] - adf4351_freqs[i]);
+    }
+    return rf_freqs;
+}
+
 double magnesium_radio_ctrl_impl::set_rx_bandwidth(
     const double bandwidth, const size_t chan)
 {
@@ -88,6 +88,24 @@ public:
     double set_tx_bandwidth(const double bandwidth, const size_t chan);
     double set_rx_bandwidth(const double bandwidth, const size_t chan);
 
+    /*! Pre-load a list of RF frequencies for frequency hopping
+     *
+     * The AD9371 LO is tuned to each of the frequencies once, and the results
+     * are cached on the device. After that, set_rx_frequency() and
+     * set_tx_frequency() to any of these frequencies don't need to wait for the
+     * asynchronous tune on the device. The current frequency is restored, but
+     * the RF output is not valid while this runs, so it should be called
+     * before streaming. The cache is cleared when the master clock rate
+     * changes.
+     *
+     * \return the actual RF frequencies
+     * \throws uhd::runtime_error if the AD9371 LO source is not internal
+     */
+    std::vector<double> set_tx_hop_list(
+        const std::vector<double>& freqs, const size_t chan);
+    std::vector<double> set_rx_hop_list(
+        const std::vector<double>& freqs, const size_t chan);
+
     // RX LO
     std::vector<std::string> get_rx_lo_names(const size_t chan);
     std::vector<std::string> get_rx_lo_sources(
@@ -225,6 +243,9 @@ private:
         const double freq,
         const size_t chan);
 
+    std::vector<double> _set_hop_list(
+        const std::vector<double>& freqs, const size_t chan, const direction_t dir);
+
     /**************************************************************************
      * Private attributes
      *************************************************************************/
@@ -206,6 +206,10 @@ void magnesium_radio_ctrl_impl::_init_frontend_subtree(
             return this->set_tx_frequency(freq, chan_idx);
         })
         .set_publisher([this, chan_idx]() { return this->get_tx_frequency(chan_idx); });
+    subtree->create<std::vector<double>>(tx_fe_path / "freq" / "hop_list")
+        .set_coercer([this, chan_idx](const std::vector<double>& freqs) {
+            return this->set_tx_hop_list(freqs, chan_idx);
+        });
     subtree->create<meta_range_t>(tx_fe_path / "freq" / "range")
         .set(meta_range_t(MAGNESIUM_MIN_FREQ, MAGNESIUM_MAX_FREQ, 1.0))
         .add_coerced_subscriber([](const meta_range_t&) {
@@ -217,6 +221,10 @@ void magnesium_radio_ctrl_impl::_init_frontend_subtree(
             return this->set_rx_frequency(freq, chan_idx);
         })
         .set_publisher([this, chan_idx]() { return this->get_rx_frequency(chan_idx); });
+    subtree->create<std::vector<double>>(rx_fe_path / "freq" / "hop_list")
+        .set_coercer([this, chan_idx](const std::vector<double>& freqs) {
+            return this->set_rx_hop_list(freqs, chan_idx);
+        });
     subtree->create<meta_range_t>(rx_fe_path / "freq" / "range")
         .set(meta_range_t(MAGNESIUM_MIN_FREQ, MAGNESIUM_MAX_FREQ, 1.0))
         .add_coerced_subscriber([](const meta_range_t&) {
@@ -98,7 +98,9 @@ double rhodium_radio_ctrl_impl::set_rate(double requested_rate)
     auto new_rate = _rpcc->request_with_token<double>(
         SET_RATE_RPC_TIMEOUT_MS, "db_0_set_master_clock_rate", rate);
     // The lowband LO frequency will change with the master clock rate, so
-    // update the tuning of the device.
+    // update the tuning of the device. The LMK was reinitialized, so don't
+    // assume anything about the state of the lowband LO outputs.
+    _lowband_lo_enabled.clear();
     set_tx_frequency(get_tx_frequency(0), 0);
     set_rx_frequency(get_rx_frequency(0), 0);
 
@@ -225,7 +227,7 @@ double rhodium_radio_ctrl_impl::set_tx_frequency(
         }
         UHD_LOG_TRACE(
             unique_id(), "TX Lowband LO is " << (is_highband ? "disabled" : "enabled"));
-        _rpcc->notify_with_token(_rpc_prefix + "enable_tx_lowband_lo", (!is_highband));
+        _set_lowband_lo_enabled(!is_highband, TX_DIRECTION);
     }
     _update_tx_freq_switches(coerced_freq);
     const bool enable_corrections = is_highband
@@ -280,7 +282,7 @@ double rhodium_radio_ctrl_impl::set_rx_frequency(
         }
         UHD_LOG_TRACE(
             unique_id(), "RX Lowband LO is " << (is_highband ? "disabled" : "enabled"));
-        _rpcc->notify_with_token(_rpc_prefix + "enable_rx_lowband_lo", (!is_highband));
+        _set_lowband_lo_enabled(!is_highband, RX_DIRECTION);
     }
     _update_rx_freq_switches(coerced_freq);
     const bool enable_corrections = is_highband
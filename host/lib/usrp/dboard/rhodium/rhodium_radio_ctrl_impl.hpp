@@ -178,6 +178,13 @@ private:
     //! Get the current lowband intermediate frequency
     double _get_lowband_lo_freq() const;
 
+    //! Enable or disable the lowband LO output of the LMK. Does nothing if
+    //  the output is known to be in that state already.
+    void _set_lowband_lo_enabled(
+        const bool enabled,
+        const direction_t dir
+    );
+
     //! Configure LO1's export
     void _set_lo1_export_enabled(
         const bool enabled,
@@ -309,6 +316,10 @@ private:
     //! Reference to the RPC client
     uhd::rpc_client::sptr _rpcc;
 
+    //! Last state of the lowband LO outputs that was sent to MPM, per
+    //  direction. No entry means the state is unknown.
+    std::map<direction_t, bool> _lowband_lo_enabled;
+
     //! Reference to the SPI core
     uhd::spi_iface::sptr _spi;
 
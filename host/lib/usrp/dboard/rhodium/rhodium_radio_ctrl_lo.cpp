@@ -326,6 +326,22 @@ const std::string rhodium_radio_ctrl_impl::get_rx_lo_source(
     return (name == RHODIUM_LO1 or name == ALL_LOS) ? _rx_lo_source : "internal";
 }
 
+void rhodium_radio_ctrl_impl::_set_lowband_lo_enabled(
+    const bool enabled,
+    const direction_t dir
+) {
+    // Every call is an RPC round trip, so skip them while sweeping within
+    // the same band
+    const auto state = _lowband_lo_enabled.find(dir);
+    if (state != _lowband_lo_enabled.end() and state->second == enabled) {
+        return;
+    }
+    const auto rpc_name = (dir == RX_DIRECTION) ?
+        "enable_rx_lowband_lo" : "enable_tx_lowband_lo";
+    _rpcc->notify_with_token(_rpc_prefix + rpc_name, enabled);
+    _lowband_lo_enabled[dir] = enabled;
+}
+
 /******************************************************************************
  * Export Control
  *****************************************************************************/
@@ -568,17 +568,16 @@ private:    //Functions
         //Route SPI LEs through CPLD (will not assert them)
         _cpld_regs->rf0_reg2.set(rm::rf0_reg2_t::LO1_LE_CH1, bool2bin(lo == LO1 and (channel == CH1 or channel == BOTH)));
         _cpld_regs->rf0_reg2.set(rm::rf0_reg2_t::LO1_LE_CH2, bool2bin(lo == LO1 and (channel == CH2 or channel == BOTH)));
-        _cpld_regs->rf0_reg2.flush();
         _cpld_regs->if0_reg2.set(rm::if0_reg2_t::LO2_LE_CH1, bool2bin(lo == LO2 and (channel == CH1 or channel == BOTH)));
         _cpld_regs->if0_reg2.set(rm::if0_reg2_t::LO2_LE_CH2, bool2bin(lo == LO2 and (channel == CH2 or channel == BOTH)));
-        _cpld_regs->if0_reg2.flush();
+        //Everything else was flushed at the start of _commit(), so this only writes
+        //the routes that changed, in one batch
+        _cpld_regs->flush();
     }
 
     void _write_lo_spi(dboard_iface::unit_t unit, const std::vector<uint32_t> &regs)
     {
-        for(uint32_t reg:  regs) {
-            _db_iface->write_spi(unit, _spi_config, reg, 32);
-        }
+        _db_iface->write_spi_list(unit, _spi_config, regs, 32);
     }
 
     void _commit()
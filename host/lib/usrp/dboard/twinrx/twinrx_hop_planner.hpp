@@ -0,0 +1,127 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#ifndef INCLUDED_DBOARD_TWINRX_HOP_PLANNER_HPP
+#define INCLUDED_DBOARD_TWINRX_HOP_PLANNER_HPP
+
+#include <uhd/utils/math.hpp>
+#include <boost/optional.hpp>
+#include <vector>
+
+namespace uhd { namespace usrp { namespace dboard { namespace twinrx {
+
+/*!
+ * Plans which LO synthesizer serves each hop of a frequency hopping sequence
+ *
+ * When one channel of a TwinRX has its LO source disabled, the active channel
+ * can take its LOs either from its own synthesizers ("internal") or from the
+ * ones of the other channel ("companion"). While one set of synthesizers
+ * drives the active channel, the other one can tune to the next hop, so the
+ * lock time is hidden behind the dwell time.
+ *
+ * The planner keeps track of the frequency each set of synthesizers is tuned
+ * to. A hop uses a set that already holds its frequency, which avoids
+ * swapping and retuning on repeated frequencies, and the idle set is only
+ * preloaded when the next frequency isn't held by either set.
+ */
+class twinrx_hop_planner
+{
+public:
+    //! The synthesizers of the active channel
+    static const size_t SYNTH_INTERNAL = 0;
+    //! The synthesizers of the other channel
+    static const size_t SYNTH_COMPANION = 1;
+
+    struct hop_t
+    {
+        //! The RF frequency of this hop
+        double freq;
+        //! SYNTH_INTERNAL or SYNTH_COMPANION
+        size_t synth;
+        //! True if the synthesizers weren't tuned ahead and have to lock first
+        bool retune;
+        //! True if the idle synthesizers have to tune to preload_freq during this hop
+        bool preload;
+        //! The frequency of the next hop that isn't held by either synthesizer
+        double preload_freq;
+    };
+
+    twinrx_hop_planner(void)
+    {
+        reset();
+    }
+
+    //! Forget the state of the synthesizers, e.g. after tuning them elsewhere
+    void reset(void)
+    {
+        _synth_freq[SYNTH_INTERNAL]  = boost::none;
+        _synth_freq[SYNTH_COMPANION] = boost::none;
+        // A retune goes to the idle synthesizers, so the first hop uses the
+        // channel's own ones
+        _active = SYNTH_COMPANION;
+    }
+
+    /*!
+     * Plan a sequence of hops, starting from the state the last plan left
+     *
+     * \param freqs the RF frequencies, in the order they are visited
+     * \param repeat if true, the last hop preloads the first frequency, so the
+     *               sequence can be planned and run again without a retune
+     */
+    std::vector<hop_t> plan(const std::vector<double>& freqs, const bool repeat = false)
+    {
+        std::vector<hop_t> hops;
+        hops.reserve(freqs.size());
+        for (size_t i = 0; i < freqs.size(); i++) {
+            hop_t hop;
+            hop.freq         = freqs[i];
+            hop.retune       = false;
+            hop.preload      = false;
+            hop.preload_freq = 0.0;
+            // Stay on the synthesizers in use if they already hold the frequency
+            if (_holds(_active, hop.freq)) {
+                hop.synth = _active;
+            } else {
+                hop.synth  = _other(_active);
+                hop.retune = not _holds(hop.synth, hop.freq);
+            }
+            _synth_freq[hop.synth] = hop.freq;
+            _active                = hop.synth;
+
+            const bool has_next = (i + 1 < freqs.size()) or repeat;
+            if (has_next) {
+                const double next_freq = freqs[(i + 1) % freqs.size()];
+                const size_t idle      = _other(hop.synth);
+                if (not _holds(hop.synth, next_freq) and not _holds(idle, next_freq)) {
+                    hop.preload       = true;
+                    hop.preload_freq  = next_freq;
+                    _synth_freq[idle] = next_freq;
+                }
+            }
+            hops.push_back(hop);
+        }
+        return hops;
+    }
+
+private:
+    static size_t _other(const size_t synth)
+    {
+        return synth == SYNTH_INTERNAL ? SYNTH_COMPANION : SYNTH_INTERNAL;
+    }
+
+    bool _holds(const size_t synth, const double freq) const
+    {
+        return _synth_freq[synth]
+               and uhd::math::frequencies_are_equal(*_synth_freq[synth], freq);
+    }
+
+    boost::optional<double> _synth_freq[2];
+    size_t _active;
+};
+
+}}}} // namespace uhd::usrp::dboard::twinrx
+
+#endif /* INCLUDED_DBOARD_TWINRX_HOP_PLANNER_HPP */
@@ -92,6 +92,31 @@ public:
     // CPLD register write-only interface
     void poke32(const wb_addr_type addr, const uint32_t data) {
         boost::lock_guard<boost::mutex> lock(_mutex);
+        _poke32(addr, data);
+    }
+
+    // Batched CPLD register writes: The whole sequence goes out under one lock,
+    // so no other GPIO access can interleave with the address and enable cycles.
+    void multi_poke32(const std::vector<wb_addr_type>& addrs, const std::vector<uint32_t>& data) {
+        UHD_ASSERT_THROW(addrs.size() == data.size());
+        boost::lock_guard<boost::mutex> lock(_mutex);
+        for (size_t i = 0; i < addrs.size(); i++) {
+            _poke32(addrs[i], data[i]);
+        }
+    }
+
+    // Timed command interface
+    inline time_spec_t get_time() {
+        return _db_iface->get_command_time();
+    }
+
+    void set_time(const time_spec_t& t) {
+        boost::lock_guard<boost::mutex> lock(_mutex);
+        _db_iface->set_command_time(t);
+    }
+
+private:    //Functions
+    void _poke32(const wb_addr_type addr, const uint32_t data) {
         using namespace soft_reg_field;
 
         //Step 1: Write the reg offset and data to the GPIO bus and de-assert all enables
@@ -107,16 +132,6 @@ public:
             mask<uint32_t>(CPLD_FULL_ADDR)|mask<uint32_t>(CPLD_DATA));
     }
 
-    // Timed command interface
-    inline time_spec_t get_time() {
-        return _db_iface->get_command_time();
-    }
-
-    void set_time(const time_spec_t& t) {
-        boost::lock_guard<boost::mutex> lock(_mutex);
-        _db_iface->set_command_time(t);
-    }
-
 private:    //Members/definitions
     static const uint32_t GPIO_OUTPUT_MASK   = 0xFC06FE03;
     static const uint32_t GPIO_PINCTRL_MASK  = 0x00000000;
@@ -11,8 +11,14 @@
 #include <uhd/transport/vrt_if_packet.hpp>
 #include <uhd/transport/zero_copy.hpp>
 #include <uhd/types/sid.hpp>
+#include <uhd/utils/byteswap.hpp>
 #include <uhd/utils/log.hpp>
 #include <boost/shared_ptr.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 
 namespace uhd { namespace usrp {
 
@@ -25,6 +31,12 @@ struct rx_fc_cache_t
         , total_bytes_consumed(0)
         , total_packets_consumed(0)
         , seq_num(0)
+        , adaptive(false)
+        , big_endian(true)
+        , min_interval(0)
+        , max_interval(0)
+        , target_period(0.0)
+        , consumption_rate(0.0)
     {
     }
 
@@ -47,8 +59,78 @@ struct rx_fc_cache_t
         unpack;
     std::function<void(uint32_t* packet_buff, uhd::transport::vrt::if_packet_info_t&)>
         pack;
+
+    // Adaptive mode, see rx_fc_update_interval()
+    //! Use the adaptive mode
+    bool adaptive;
+    //! Endianness of the CHDR headers, used instead of to_host in adaptive mode
+    bool big_endian;
+    //! Smallest and largest interval in bytes
+    size_t min_interval;
+    size_t max_interval;
+    //! Targeted time between two flow control packets in seconds
+    double target_period;
+    //! Smoothed consumption rate in bytes per second
+    double consumption_rate;
+    //! Time of the last flow control packet
+    std::chrono::steady_clock::time_point last_fc_time;
 };
 
+/*! Return the number of bytes a received CHDR packet counts towards RX flow
+ * control, based on the first word of its header only.
+ *
+ * This is the packet length rounded up to full 32-bit words. Error responses
+ * and packets with a bad length count as zero bytes.
+ *
+ * \param chdr The first CHDR header word in host byte order
+ */
+inline uint32_t get_chdr_fc_byte_count(const uint32_t chdr)
+{
+    // Packet type 3 is a response, bit 28 is its error flag
+    if (((chdr >> 30) & 0x3) == 0x3 and (chdr & (1 << 28))) {
+        return 0;
+    }
+    const uint32_t bytes = chdr & 0xFFFF;
+    // A CHDR header has at least two 32-bit words
+    if (bytes < 2 * sizeof(uint32_t)) {
+        return 0;
+    }
+    return (bytes + 3) & ~uint32_t(3);
+}
+
+/*! Size the RX flow control interval in adaptive mode.
+ *
+ * Called whenever a flow control packet goes out. The consumption rate is
+ * measured between two flow control packets and smoothed, and the interval
+ * is set to the number of bytes the host consumes in the targeted period.
+ * The interval is limited to [min_interval, max_interval]. Callers set
+ * max_interval to a fraction of the flow control window (the transport
+ * buffer depth), so that the device never runs out of credit before the next
+ * update arrives.
+ *
+ * \param fc_cache RX flow control state information
+ * \param bytes Number of bytes consumed since the last flow control packet
+ * \param now Current time
+ */
+inline void rx_fc_update_interval(rx_fc_cache_t& fc_cache,
+    const uint32_t bytes,
+    const std::chrono::steady_clock::time_point now)
+{
+    const std::chrono::duration<double> elapsed = now - fc_cache.last_fc_time;
+    fc_cache.last_fc_time                       = now;
+    if (elapsed.count() <= 0.0) {
+        return;
+    }
+    const double rate = bytes / elapsed.count();
+    // The first measurement includes the time before streaming started
+    fc_cache.consumption_rate = (fc_cache.consumption_rate == 0.0)
+                                    ? rate
+                                    : 0.75 * fc_cache.consumption_rate + 0.25 * rate;
+    const double interval = fc_cache.consumption_rate * fc_cache.target_period;
+    fc_cache.interval     = std::max(fc_cache.min_interval,
+        std::min(fc_cache.max_interval, static_cast<size_t>(interval)));
+}
+
 /*! Send out RX flow control packets.
  *
  * This function handles updating the counters for the consumed
@@ -61,16 +143,26 @@ struct rx_fc_cache_t
  *             skip the counter update.
  */
 inline bool rx_flow_ctrl(
-    boost::shared_ptr<rx_fc_cache_t> fc_cache, uhd::transport::managed_buffer::sptr buff)
+    rx_fc_cache_t& fc_cache, const uhd::transport::managed_buffer* buff)
 {
     // If the caller supplied a buffer
-    if (buff) {
+    if (buff and fc_cache.adaptive) {
+        // Only look at the length field instead of unpacking the whole header
+        const uint32_t chdr = buff->cast<const uint32_t*>()[0];
+        const uint32_t bytes =
+            get_chdr_fc_byte_count(fc_cache.big_endian ? uhd::ntohx(chdr)
+                                                        : uhd::wtohx(chdr));
+        if (bytes > 0) {
+            fc_cache.total_bytes_consumed += bytes;
+            fc_cache.total_packets_consumed++;
+        }
+    } else if (buff) {
         // Unpack the header
         uhd::transport::vrt::if_packet_info_t packet_info;
         packet_info.num_packet_words32 = buff->size() / sizeof(uint32_t);
         const uint32_t* pkt            = buff->cast<const uint32_t*>();
         try {
-            fc_cache->unpack(pkt, packet_info);
+            fc_cache.unpack(pkt, packet_info);
         } catch (const std::exception& ex) {
             // Log and ignore
             UHD_LOGGER_ERROR("RX FLOW CTRL")
@@ -81,20 +173,20 @@ inline bool rx_flow_ctrl(
         // Update counters assuming the buffer is a consumed packet
         if (not packet_info.error) {
             const size_t bytes = 4 * (packet_info.num_header_words32 + packet_info.num_payload_words32);
-            fc_cache->total_bytes_consumed += bytes;
-            fc_cache->total_packets_consumed++;
+            fc_cache.total_bytes_consumed += bytes;
+            fc_cache.total_packets_consumed++;
         }
     }
 
     // Just return if there is no need to send a flow control packet
-    if (fc_cache->total_bytes_consumed - fc_cache->last_byte_count < fc_cache->interval) {
+    if (fc_cache.total_bytes_consumed - fc_cache.last_byte_count < fc_cache.interval) {
         return true;
     }
 
     // Time to send a flow control packet
     // Get a send buffer
     uhd::transport::managed_send_buffer::sptr fc_buff =
-        fc_cache->xport->get_send_buff(0.0);
+        fc_cache.xport->get_send_buff(0.0);
     if (not fc_buff) {
         throw uhd::runtime_error("rx_flowctrl timed out getting a send buffer");
     }
@@ -105,12 +197,12 @@ inline bool rx_flow_ctrl(
     packet_info.packet_type = uhd::transport::vrt::if_packet_info_t::PACKET_TYPE_FC;
     packet_info.num_payload_words32 = uhd::usrp::DEVICE3_FC_PACKET_LEN_IN_WORDS32;
     packet_info.num_payload_bytes   = packet_info.num_payload_words32 * sizeof(uint32_t);
-    packet_info.packet_count        = fc_cache->seq_num++;
+    packet_info.packet_count        = fc_cache.seq_num++;
     packet_info.sob                 = false;
     packet_info.eob                 = false;
     packet_info.error               = false;
     packet_info.fc_ack              = false;
-    packet_info.sid                 = fc_cache->sid.get();
+    packet_info.sid                 = fc_cache.sid.get();
     packet_info.has_sid             = true;
     packet_info.has_cid             = false;
     packet_info.has_tsi             = false;
@@ -118,22 +210,35 @@ inline bool rx_flow_ctrl(
     packet_info.has_tlr             = false;
 
     // Load Header:
-    fc_cache->pack(pkt, packet_info);
+    fc_cache.pack(pkt, packet_info);
     // Load Payload: Packet count, and byte count
     pkt[packet_info.num_header_words32 + uhd::usrp::DEVICE3_FC_PACKET_COUNT_OFFSET] =
-        fc_cache->from_host(fc_cache->total_packets_consumed);
+        fc_cache.from_host(fc_cache.total_packets_consumed);
     pkt[packet_info.num_header_words32 + uhd::usrp::DEVICE3_FC_BYTE_COUNT_OFFSET] =
-        fc_cache->from_host(fc_cache->total_bytes_consumed);
+        fc_cache.from_host(fc_cache.total_bytes_consumed);
 
     // send the buffer over the interface
     fc_buff->commit(sizeof(uint32_t) * (packet_info.num_packet_words32));
 
+    // Flow control ACKs can move the counters, only measure actual traffic
+    if (fc_cache.adaptive and buff) {
+        rx_fc_update_interval(fc_cache,
+            fc_cache.total_bytes_consumed - fc_cache.last_byte_count,
+            std::chrono::steady_clock::now());
+    }
+
     // update byte count
-    fc_cache->last_byte_count = fc_cache->total_bytes_consumed;
+    fc_cache.last_byte_count = fc_cache.total_bytes_consumed;
 
     return true;
 }
 
+inline bool rx_flow_ctrl(
+    boost::shared_ptr<rx_fc_cache_t> fc_cache, uhd::transport::managed_buffer::sptr buff)
+{
+    return rx_flow_ctrl(*fc_cache, buff.get());
+}
+
 /*! Handle RX flow control ACK packets.
  *
  */
@@ -166,6 +271,12 @@ struct tx_fc_cache_t
         , window_size(capacity)
         , fc_ack_seqnum(0)
         , fc_received(false)
+        , async_credit(false)
+        , async_fc_seen(0)
+        , async_byte_ack(0)
+        , async_seq_ack(0)
+        , async_fc_count(0)
+        , credit_waiting(false)
     {
     }
 
@@ -183,64 +294,190 @@ struct tx_fc_cache_t
         unpack;
     std::function<void(uint32_t* packet_buff, uhd::transport::vrt::if_packet_info_t&)>
         pack;
+
+    // Credit mode, see tx_flow_ctrl_harvest()
+    //! FC packets are received by tx_flow_ctrl_harvest() instead of tx_flow_ctrl()
+    bool async_credit;
+    //! Value of async_fc_count when the sender last picked up the counts
+    uint32_t async_fc_seen;
+    //! Counts of the last FC packet, written by the harvester
+    std::atomic<uint32_t> async_byte_ack;
+    std::atomic<uint32_t> async_seq_ack;
+    //! Number of FC packets harvested so far, published after the counts
+    std::atomic<uint32_t> async_fc_count;
+    //! Set while the sender waits for credit
+    std::atomic<bool> credit_waiting;
+    std::mutex credit_mutex;
+    std::condition_variable credit_cond;
 };
 
-inline bool tx_flow_ctrl(boost::shared_ptr<tx_fc_cache_t> fc_cache,
-    uhd::transport::zero_copy_if::sptr xport,
-    uhd::transport::managed_buffer::sptr buff)
+/*! Extract the counts from a TX flow control packet.
+ *
+ * \param fc_cache TX flow control state information
+ * \param buff A packet received on the TX data transport
+ * \param pkt_count Returns the number of packets the device consumed
+ * \param byte_count Returns the number of bytes the device consumed
+ * \return false if the buffer is not a valid flow control packet
+ */
+inline bool tx_flow_ctrl_unpack(const tx_fc_cache_t& fc_cache,
+    const uhd::transport::managed_recv_buffer::sptr& buff,
+    uint32_t& pkt_count,
+    uint32_t& byte_count)
+{
+    uhd::transport::vrt::if_packet_info_t if_packet_info;
+    if_packet_info.num_packet_words32 = buff->size() / sizeof(uint32_t);
+    const uint32_t* packet_buff       = buff->cast<const uint32_t*>();
+    try {
+        fc_cache.unpack(packet_buff, if_packet_info);
+    } catch (const std::exception& ex) {
+        UHD_LOGGER_ERROR("TX FLOW CTRL")
+            << "Error unpacking flow control packet: " << ex.what() << std::endl;
+        return false;
+    }
+
+    if (if_packet_info.packet_type
+        != uhd::transport::vrt::if_packet_info_t::PACKET_TYPE_FC) {
+        UHD_LOGGER_ERROR("TX FLOW CTRL")
+            << "Unexpected packet received by flow control handler: "
+            << if_packet_info.packet_type << std::endl;
+        return false;
+    }
+
+    const uint32_t* payload = &packet_buff[if_packet_info.num_header_words32];
+    pkt_count               = fc_cache.to_host(payload[0]);
+    byte_count              = fc_cache.to_host(payload[1]);
+    return true;
+}
+
+/*! Account for a packet if it fits into the flow control window.
+ *
+ * \return true if there was space and the counters were updated
+ */
+inline bool tx_flow_ctrl_reserve(tx_fc_cache_t& fc_cache, const size_t size)
+{
+    if (fc_cache.window_size - (fc_cache.byte_count - fc_cache.last_byte_ack) < size) {
+        return false;
+    }
+    fc_cache.byte_count += size;
+    // Round up to nearest word
+    if (fc_cache.byte_count % uhd::usrp::DEVICE3_LINE_SIZE) {
+        fc_cache.byte_count += uhd::usrp::DEVICE3_LINE_SIZE
+                               - (fc_cache.byte_count % uhd::usrp::DEVICE3_LINE_SIZE);
+    }
+    fc_cache.pkt_count++;
+    return true;
+}
+
+/*! Pick up the counts published by tx_flow_ctrl_harvest().
+ *
+ * Must only be called from the sending thread.
+ */
+inline void tx_flow_ctrl_update_credit(tx_fc_cache_t& fc_cache)
+{
+    const uint32_t fc_count = fc_cache.async_fc_count.load(std::memory_order_acquire);
+    if (fc_count == fc_cache.async_fc_seen) {
+        return;
+    }
+    fc_cache.async_fc_seen = fc_count;
+    // A later FC packet may have overwritten these in the meantime, which only
+    // means we see more credit
+    fc_cache.last_byte_ack = fc_cache.async_byte_ack.load(std::memory_order_relaxed);
+    fc_cache.last_seq_ack  = fc_cache.async_seq_ack.load(std::memory_order_relaxed);
+    fc_cache.fc_received   = true;
+}
+
+/*! Wait until the device has room for a packet, and account for it.
+ *
+ * \param fc_cache TX flow control state information
+ * \param xport The TX data transport the FC packets arrive on
+ * \param size The size of the packet in bytes
+ */
+inline bool tx_flow_ctrl(tx_fc_cache_t& fc_cache,
+    const uhd::transport::zero_copy_if::sptr& xport,
+    const size_t size)
 {
+    if (fc_cache.async_credit) {
+        while (true) {
+            tx_flow_ctrl_update_credit(fc_cache);
+            if (tx_flow_ctrl_reserve(fc_cache, size)) {
+                return true;
+            }
+
+            // Out of credit, sleep until the harvester got a new FC packet
+            std::unique_lock<std::mutex> lock(fc_cache.credit_mutex);
+            fc_cache.credit_waiting.store(true, std::memory_order_relaxed);
+            // Pairs with the fence in tx_flow_ctrl_harvest()
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const uint32_t seen = fc_cache.async_fc_seen;
+            fc_cache.credit_cond.wait_for(
+                lock, std::chrono::milliseconds(100), [&fc_cache, seen]() {
+                    return fc_cache.async_fc_count.load(std::memory_order_acquire)
+                           != seen;
+                });
+            fc_cache.credit_waiting.store(false, std::memory_order_relaxed);
+        }
+    }
+
     while (true) {
         // If there is space
-        if (fc_cache->window_size - (fc_cache->byte_count - fc_cache->last_byte_ack)
-            >= buff->size()) {
+        if (tx_flow_ctrl_reserve(fc_cache, size)) {
             // All is good - packet will be sent
-            fc_cache->byte_count += buff->size();
-            // Round up to nearest word
-            if (fc_cache->byte_count % uhd::usrp::DEVICE3_LINE_SIZE) {
-                fc_cache->byte_count +=
-                    uhd::usrp::DEVICE3_LINE_SIZE
-                    - (fc_cache->byte_count % uhd::usrp::DEVICE3_LINE_SIZE);
-            }
-            fc_cache->pkt_count++;
             return true;
         }
 
         // Look for a flow control message to update the space available in the buffer.
         uhd::transport::managed_recv_buffer::sptr buff = xport->get_recv_buff(0.1);
-        if (buff) {
-            uhd::transport::vrt::if_packet_info_t if_packet_info;
-            if_packet_info.num_packet_words32 = buff->size() / sizeof(uint32_t);
-            const uint32_t* packet_buff       = buff->cast<const uint32_t*>();
-            try {
-                fc_cache->unpack(packet_buff, if_packet_info);
-            } catch (const std::exception& ex) {
-                UHD_LOGGER_ERROR("TX FLOW CTRL")
-                    << "Error unpacking flow control packet: " << ex.what() << std::endl;
-                continue;
-            }
-
-            if (if_packet_info.packet_type
-                != uhd::transport::vrt::if_packet_info_t::PACKET_TYPE_FC) {
-                UHD_LOGGER_ERROR("TX FLOW CTRL")
-                    << "Unexpected packet received by flow control handler: "
-                    << if_packet_info.packet_type << std::endl;
-                continue;
-            }
-
-            const uint32_t* payload   = &packet_buff[if_packet_info.num_header_words32];
-            const uint32_t pkt_count  = fc_cache->to_host(payload[0]);
-            const uint32_t byte_count = fc_cache->to_host(payload[1]);
-
+        uint32_t pkt_count, byte_count;
+        if (buff and tx_flow_ctrl_unpack(fc_cache, buff, pkt_count, byte_count)) {
             // update the amount of space
-            fc_cache->last_byte_ack = byte_count;
-            fc_cache->last_seq_ack  = pkt_count;
+            fc_cache.last_byte_ack = byte_count;
+            fc_cache.last_seq_ack  = pkt_count;
 
-            fc_cache->fc_received = true;
+            fc_cache.fc_received = true;
         }
     }
     return false;
 }
 
+inline bool tx_flow_ctrl(boost::shared_ptr<tx_fc_cache_t> fc_cache,
+    uhd::transport::zero_copy_if::sptr xport,
+    uhd::transport::managed_buffer::sptr buff)
+{
+    return tx_flow_ctrl(*fc_cache, xport, buff->size());
+}
+
+/*! Receive TX flow control packets outside of the sending thread.
+ *
+ * In credit mode (tx_fc_cache_t::async_credit), this is run in a loop by a
+ * separate task and takes over receiving FC packets from tx_flow_ctrl(). The
+ * counts are published through atomics, so the sending thread never touches
+ * the receive side of the transport and only blocks when it runs out of
+ * credit.
+ *
+ * \param fc_cache TX flow control state information
+ * \param xport The TX data transport the FC packets arrive on
+ */
+inline void tx_flow_ctrl_harvest(
+    boost::shared_ptr<tx_fc_cache_t> fc_cache, uhd::transport::zero_copy_if::sptr xport)
+{
+    uhd::transport::managed_recv_buffer::sptr buff = xport->get_recv_buff(0.1);
+    uint32_t pkt_count, byte_count;
+    if (not buff or not tx_flow_ctrl_unpack(*fc_cache, buff, pkt_count, byte_count)) {
+        return;
+    }
+    fc_cache->async_seq_ack.store(pkt_count, std::memory_order_relaxed);
+    fc_cache->async_byte_ack.store(byte_count, std::memory_order_relaxed);
+    fc_cache->async_fc_count.fetch_add(1, std::memory_order_release);
+
+    // Either the sender sees the new count before it sleeps, or we see that
+    // it is waiting
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (fc_cache->credit_waiting.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(fc_cache->credit_mutex);
+        fc_cache->credit_cond.notify_one();
+    }
+}
+
 inline void tx_flow_ctrl_ack(boost::shared_ptr<tx_fc_cache_t> fc_cache,
     uhd::transport::zero_copy_if::sptr send_xport,
     uhd::sid_t send_sid)
@@ -19,6 +19,7 @@ device3_impl::device3_impl()
 {
     _type = uhd::device::USRP;
     _async_md.reset(new async_md_type(1000 /*messages deep*/));
+    _async_md_used = std::make_shared<std::atomic<bool>>(false);
     _tree = uhd::property_tree::make();
 };
 
@@ -161,19 +162,32 @@ void device3_impl::enumerate_rfnoc_blocks(size_t device_index,
         make_args.base_address = xport.send_sid.get_dst();
         make_args.device_index = device_index;
         make_args.tree         = subtree;
+        // Blocks of different mboards can be made concurrently, only the
+        // vector access needs to be serialized
+        uhd::rfnoc::block_ctrl_base::sptr block_ctrl =
+            uhd::rfnoc::block_ctrl_base::make(make_args, noc_id);
+        block_ctrl->set_graph_update_cb([this]() {
+            update_rx_streamers();
+            update_tx_streamers();
+        });
         { // Critical section for block_ctrl vector access
             boost::lock_guard<boost::mutex> lock(_block_ctrl_mutex);
-            _rfnoc_block_ctrl.push_back(
-                uhd::rfnoc::block_ctrl_base::make(make_args, noc_id));
-            _rfnoc_block_ctrl.back()->set_graph_update_cb([this]() {
-                update_rx_streamers();
-                update_tx_streamers();
-            });
+            _rfnoc_block_ctrl.push_back(block_ctrl);
         }
     }
 }
 
 
+double device3_impl::get_link_rate(const size_t mb_index)
+{
+    const uhd::fs_path link_rate_path =
+        uhd::fs_path("/mboards") / std::to_string(mb_index) / "link_max_rate";
+    if (not _tree->exists(link_rate_path)) {
+        return 0.0;
+    }
+    return _tree->access<double>(link_rate_path).get();
+}
+
 uhd::rfnoc::graph::sptr device3_impl::create_graph(const std::string& name)
 {
     // Create an async message handler
@@ -14,6 +14,7 @@
 #include "../../transport/super_recv_packet_handler.hpp"
 #include "../../transport/super_send_packet_handler.hpp"
 #include <uhd/device3.hpp>
+#include <uhd/rfnoc/dma_fifo_block_ctrl.hpp>
 #include <uhd/transport/bounded_buffer.hpp>
 #include <uhd/transport/chdr.hpp>
 #include <uhd/transport/vrt_if_packet.hpp>
@@ -26,6 +27,10 @@
 #include <uhdlib/rfnoc/rx_stream_terminator.hpp>
 #include <uhdlib/rfnoc/tx_stream_terminator.hpp>
 #include <uhdlib/rfnoc/xports.hpp>
+#include <uhdlib/transport/mpsc_bounded_buffer.hpp>
+#include <atomic>
+#include <list>
+#include <memory>
 
 namespace uhd { namespace usrp {
 
@@ -33,6 +38,7 @@ namespace uhd { namespace usrp {
  * Default settings (any device3 may override these)
  **********************************************************************/
 static const size_t DEVICE3_RX_FC_REQUEST_FREQ       = 32; // per flow-control window
+static const double DEVICE3_RX_FC_ADAPTIVE_PERIOD    = 0.001; // seconds
 static const size_t DEVICE3_TX_FC_RESPONSE_FREQ      = 8;
 static const size_t DEVICE3_FC_PACKET_LEN_IN_WORDS32 = 2;
 static const size_t DEVICE3_FC_PACKET_COUNT_OFFSET   = 0;
@@ -44,16 +50,118 @@ static const size_t DEVICE3_TX_MAX_HDR_LEN =
 static const size_t DEVICE3_RX_MAX_HDR_LEN =
     uhd::transport::vrt::chdr::max_if_hdr_words64 * sizeof(uint64_t); // Bytes
 
+struct rx_fc_cache_t;
+struct tx_fc_cache_t;
+
+//! Post-send callback of the TX streamer, sends flow control ACKs if needed
+struct device3_tx_flow_ctrl_ack_cb
+{
+    boost::shared_ptr<tx_fc_cache_t> fc_cache;
+    uhd::transport::zero_copy_if::sptr xport;
+    uhd::sid_t sid;
+
+    //! Defined in device3_io_impl.cpp
+    void operator()(void) const;
+
+    explicit operator bool(void) const
+    {
+        return bool(fc_cache);
+    }
+};
+
+//! Flow control of the TX streamer, waits for credit before each packet
+struct device3_tx_flow_ctrl_cb
+{
+    boost::shared_ptr<tx_fc_cache_t> fc_cache;
+    //! The transport the flow control packets arrive on
+    uhd::transport::zero_copy_if::sptr xport;
+
+    //! Defined in device3_io_impl.cpp
+    void operator()(const size_t size) const;
+
+    explicit operator bool(void) const
+    {
+        return bool(fc_cache);
+    }
+};
+
+/*! Receive buffer getter of the RX streamer, which also does the RX flow
+ * control accounting for every buffer it gets, unless fc_cache is empty
+ */
+struct device3_rx_buff_getter
+{
+    uhd::transport::zero_copy_if::sptr xport;
+    boost::shared_ptr<rx_fc_cache_t> fc_cache;
+
+    //! Defined in device3_io_impl.cpp
+    uhd::transport::managed_recv_buffer::sptr operator()(const double timeout) const;
+
+    explicit operator bool(void) const
+    {
+        return bool(xport);
+    }
+};
+
+typedef uhd::transport::sph::basic_send_packet_streamer<
+    uhd::transport::sph::zero_copy_send_buff_getter,
+    device3_tx_flow_ctrl_ack_cb,
+    device3_tx_flow_ctrl_cb>
+    device3_send_packet_streamer_base;
+
+typedef uhd::transport::sph::basic_recv_packet_streamer<device3_rx_buff_getter,
+    uhd::transport::sph::no_recv_flowctrl>
+    device3_recv_packet_streamer_base;
+
+/*! The DRAM FIFOs a streamer's channels go through, see the dram_buffer
+ * stream arg
+ *
+ * A periodic task reads back their fill levels for the streamer's
+ * get_stats().
+ */
+class device3_dram_buffers
+{
+public:
+    typedef std::shared_ptr<device3_dram_buffers> sptr;
+
+    explicit device3_dram_buffers(const size_t num_chans) : _buffers(num_chans) {}
+
+    //! Set the FIFO of channel \p chan
+    void set(const size_t chan,
+        uhd::rfnoc::dma_fifo_block_ctrl::sptr fifo,
+        const size_t port);
+
+    //! Start reading back the fill levels every \p period seconds
+    void start(const double period);
+
+    //! Add the fill levels to \p stats
+    void get_stats(uhd::stream_stats_t& stats) const;
+
+private:
+    void poll(void);
+
+    struct buffer_t
+    {
+        uhd::rfnoc::dma_fifo_block_ctrl::sptr fifo;
+        size_t port = 0;
+        std::atomic<uint64_t> bytes{0};
+        std::atomic<uint64_t> max_bytes{0};
+    };
+    std::vector<buffer_t> _buffers;
+
+    //! Declared last, so it stops before the buffers go away
+    uhd::task::sptr _poll_task;
+};
+
 // This class manages the lifetime of the TX async message handler task, transports, and
 // terminator
-class device3_send_packet_streamer : public uhd::transport::sph::send_packet_streamer
+class device3_send_packet_streamer : public device3_send_packet_streamer_base
 {
 public:
     device3_send_packet_streamer(const size_t max_num_samps,
         const uhd::rfnoc::tx_stream_terminator::sptr terminator,
         const both_xports_t data_xport,
         const both_xports_t async_msg_xport)
-        : uhd::transport::sph::send_packet_streamer(max_num_samps)
+        : device3_send_packet_streamer_base(max_num_samps)
         , _terminator(terminator)
         , _data_xport(data_xport)
         , _async_msg_xport(async_msg_xport)
@@ -76,22 +184,37 @@ public:
         _tx_async_msg_tasks.push_back(task);
     }
 
+    void set_dram_buffers(device3_dram_buffers::sptr dram_buffers)
+    {
+        _dram_buffers = dram_buffers;
+    }
+
+    uhd::stream_stats_t get_stats(void) const
+    {
+        uhd::stream_stats_t stats = device3_send_packet_streamer_base::get_stats();
+        if (_dram_buffers) {
+            _dram_buffers->get_stats(stats);
+        }
+        return stats;
+    }
+
 private:
     uhd::rfnoc::tx_stream_terminator::sptr _terminator;
     both_xports_t _data_xport;
     both_xports_t _async_msg_xport;
     std::vector<task::sptr> _tx_async_msg_tasks;
+    device3_dram_buffers::sptr _dram_buffers;
 };
 
 // This class manages the lifetime of the RX transports and terminator and provides access
 // to both
-class device3_recv_packet_streamer : public uhd::transport::sph::recv_packet_streamer
+class device3_recv_packet_streamer : public device3_recv_packet_streamer_base
 {
 public:
     device3_recv_packet_streamer(const size_t max_num_samps,
         const uhd::rfnoc::rx_stream_terminator::sptr terminator,
         const both_xports_t xport)
-        : uhd::transport::sph::recv_packet_streamer(max_num_samps)
+        : device3_recv_packet_streamer_base(max_num_samps)
         , _terminator(terminator)
         , _xport(xport)
     {
@@ -109,9 +232,24 @@ public:
         return _terminator;
     }
 
+    void set_dram_buffers(device3_dram_buffers::sptr dram_buffers)
+    {
+        _dram_buffers = dram_buffers;
+    }
+
+    uhd::stream_stats_t get_stats(void) const
+    {
+        uhd::stream_stats_t stats = device3_recv_packet_streamer_base::get_stats();
+        if (_dram_buffers) {
+            _dram_buffers->get_stats(stats);
+        }
+        return stats;
+    }
+
 private:
     uhd::rfnoc::rx_stream_terminator::sptr _terminator;
     both_xports_t _xport;
+    device3_dram_buffers::sptr _dram_buffers;
 };
 
 class device3_impl : public uhd::device3,
@@ -122,6 +260,8 @@ public:
      * device3-specific Types
      **********************************************************************/
     typedef uhd::transport::bounded_buffer<uhd::async_metadata_t> async_md_type;
+    typedef uhd::transport::mpsc_bounded_buffer<uhd::async_metadata_t>
+        async_event_ring_type;
 
     //! The purpose of a transport
     enum xport_type_t { CTRL = 0, ASYNC_MSG, TX_DATA, RX_DATA };
@@ -199,6 +339,49 @@ protected:
         const xport_type_t xport_type,
         const uhd::device_addr_t& args) = 0;
 
+    /*! \brief Get a transport for a streamer, recycled if possible.
+     *
+     * Like make_transport(), but the transports are kept in a pool. Once the
+     * streamer that used a transport is destroyed, the next request for the
+     * same address, type and args gets the same transport back, so
+     * re-creating a streamer doesn't set up its transports again. Idle
+     * transports to the same address with other args are released first.
+     * If _pool_streamer_xports is false, this is just make_transport().
+     *
+     * Must be called with the transport setup mutex held.
+     */
+    uhd::both_xports_t get_streamer_transport(const uhd::sid_t& address,
+        const xport_type_t xport_type,
+        const uhd::device_addr_t& args);
+
+    /*! Route a streamer channel through a DRAM FIFO, see the dram_buffer
+     * stream arg
+     *
+     * Takes a free port of a DmaFIFO block on the channel's motherboard and
+     * connects it to the channel's block. A channel whose block is a DmaFIFO
+     * is left alone.
+     *
+     * Must be called with the transport setup mutex held.
+     *
+     * \param block_id The channel's block, replaced with the FIFO
+     * \param block_port The channel's port on that block, replaced with the
+     *        FIFO's port
+     * \param args The channel's stream args
+     * \param dir Direction of the stream
+     * \throws uhd::runtime_error if there is no free FIFO port
+     */
+    void insert_dram_buffer(rfnoc::block_id_t& block_id,
+        size_t& block_port,
+        const uhd::device_addr_t& args,
+        const uhd::direction_t dir);
+
+    /*! Release the idle transports of the pool, see get_streamer_transport().
+     *
+     * Devices must call this in their destructor, before they tear down what
+     * their transports depend on.
+     */
+    void release_idle_transports();
+
     virtual uhd::device_addr_t get_tx_hints(size_t)
     {
         return uhd::device_addr_t();
@@ -214,6 +397,14 @@ protected:
     //! get mtu
     virtual size_t get_mtu(const size_t, const uhd::direction_t) = 0;
 
+    /*! Return the rate of the links between the host and a motherboard
+     *
+     * The default reads the motherboard's link_max_rate property.
+     *
+     * \return the rate in bytes per second, or 0 if it's unknown
+     */
+    virtual double get_link_rate(const size_t mb_index);
+
     /***********************************************************************
      * Channel-related
      **********************************************************************/
@@ -247,6 +438,9 @@ protected:
     // TODO: Maybe move these to private
     uhd::dict<std::string, boost::weak_ptr<uhd::rx_streamer>> _rx_streamers;
     uhd::dict<std::string, boost::weak_ptr<uhd::tx_streamer>> _tx_streamers;
+    //! Devices which keep streamer transports on their own clear this, see
+    // get_streamer_transport()
+    bool _pool_streamer_xports = true;
 
 private:
     /***********************************************************************
@@ -254,9 +448,27 @@ private:
      **********************************************************************/
     //! Buffer for async metadata
     boost::shared_ptr<async_md_type> _async_md;
+    //! Set once recv_async_msg() was called, _async_md is only fed after that
+    std::shared_ptr<std::atomic<bool>> _async_md_used;
 
     //! This mutex locks the get_xx_stream() functions.
     boost::mutex _transport_setup_mutex;
+
+    //! A transport made for a streamer, see get_streamer_transport()
+    struct pooled_xport_t
+    {
+        uhd::sid_t address;
+        xport_type_t xport_type;
+        std::string args;
+        uhd::both_xports_t xport;
+
+        //! True if no streamer uses the transport anymore
+        bool is_idle(void) const;
+    };
+    std::list<pooled_xport_t> _xport_pool;
+
+    //! Connects the DRAM FIFOs of insert_dram_buffer(), made on first use
+    rfnoc::graph::sptr _dram_buffer_graph;
 };
 
 }} /* namespace uhd::usrp */
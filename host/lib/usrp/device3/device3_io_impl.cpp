@@ -10,17 +10,24 @@
 #include "device3_flow_ctrl.hpp"
 #include "device3_impl.hpp"
 #include <uhd/rfnoc/constants.hpp>
+#include <uhd/rfnoc/dma_fifo_block_ctrl.hpp>
 #include <uhd/rfnoc/radio_ctrl.hpp>
 #include <uhd/rfnoc/rate_node_ctrl.hpp>
 #include <uhd/rfnoc/sink_block_ctrl_base.hpp>
 #include <uhd/rfnoc/source_block_ctrl_base.hpp>
+#include <uhd/transport/zero_copy_fault_inject.hpp>
 #include <uhd/transport/zero_copy_flow_ctrl.hpp>
 #include <uhd/utils/byteswap.hpp>
 #include <uhd/utils/log.hpp>
+#include <uhdlib/rfnoc/dram_buffer_args.hpp>
 #include <uhdlib/rfnoc/rx_stream_terminator.hpp>
 #include <uhdlib/rfnoc/tx_stream_terminator.hpp>
+#include <uhdlib/transport/buff_tuning.hpp>
 #include <uhdlib/usrp/common/async_packet_handler.hpp>
+#include <uhdlib/usrp/common/otw_format_picker.hpp>
+#include <uhdlib/utils/trace_events.hpp>
 #include <boost/atomic.hpp>
+#include <algorithm>
 
 #define UHD_TX_STREAMER_LOG() UHD_LOGGER_TRACE("STREAMER")
 #define UHD_RX_STREAMER_LOG() UHD_LOGGER_TRACE("STREAMER")
@@ -76,6 +83,164 @@ static void check_stream_sig_compatible(
     }
 }
 
+//! Fewest frames auto_buff_ms gives a transport
+static const size_t AUTO_BUFF_MIN_NUM_FRAMES = 8;
+
+/*! Size a channel's transport for the auto_buff_ms stream arg
+ *
+ * Picks the frame size, the number of frames and the socket buffer size so
+ * that the transport holds auto_buff_ms of data at the stream's rate, see
+ * uhd::transport::tune_xport_buffs(). Transport hints which are already set
+ * (e.g., from the device args) are kept. The decision is logged, so it can
+ * be reproduced with explicit hints.
+ *
+ * \param hints The transport hints of the channel, updated in place
+ * \param args The stream args, with a valid otw_format
+ * \param samp_rate The sample rate of the stream
+ * \param mtu The largest frame size of this stream
+ * \param dir Direction of the stream
+ */
+static void auto_tune_xport_hints(device_addr_t& hints,
+    const stream_args_t& args,
+    const double samp_rate,
+    const size_t mtu,
+    const uhd::direction_t dir)
+{
+    const std::string prefix = dir == uhd::RX_DIRECTION ? "recv" : "send";
+    const double buff_ms     = args.args.cast<double>("auto_buff_ms", 0.0);
+    if (buff_ms <= 0.0) {
+        return;
+    }
+    if (samp_rate <= 0.0 or samp_rate == rfnoc::rate_node_ctrl::RATE_UNDEFINED) {
+        UHD_LOGGER_WARNING("STREAMER")
+            << "auto_buff_ms: The sample rate of the stream is unknown, using the "
+               "default transport buffers.";
+        return;
+    }
+
+    const double bytes_per_sec =
+        samp_rate * convert::get_bytes_per_item(args.otw_format);
+    const size_t max_buff_size = get_max_sock_buff_size(dir);
+    const buff_tuning_t tuning = tune_xport_buffs(bytes_per_sec,
+        buff_ms,
+        hints.cast<size_t>(prefix + "_frame_size", mtu),
+        AUTO_BUFF_MIN_NUM_FRAMES,
+        max_buff_size);
+    auto set_hint = [&hints](const std::string& key, const size_t value) {
+        if (not hints.has_key(key)) {
+            hints[key] = std::to_string(value);
+        }
+    };
+    set_hint(prefix + "_frame_size", tuning.frame_size);
+    set_hint("num_" + prefix + "_frames", tuning.num_frames);
+    set_hint(prefix + "_buff_size", tuning.buff_size);
+
+    UHD_LOGGER_INFO("STREAMER")
+        << (dir == uhd::RX_DIRECTION ? "RX" : "TX") << " transport for " << buff_ms
+        << " ms at " << (samp_rate / 1e6) << " Msps " << args.otw_format << " ("
+        << (bytes_per_sec / 1e6) << " MB/s): " << prefix
+        << "_frame_size=" << hints[prefix + "_frame_size"] << ",num_" << prefix
+        << "_frames=" << hints["num_" + prefix + "_frames"] << "," << prefix
+        << "_buff_size=" << hints[prefix + "_buff_size"] << " (socket buffer limit: "
+        << (max_buff_size ? std::to_string(max_buff_size) : std::string("unknown"))
+        << ")";
+}
+
+//! Formats otw_format=auto chooses from, widest first
+static const std::vector<std::string> AUTO_OTW_FORMATS{"sc16", "sc12", "sc8"};
+
+/*! Resolve otw_format=auto
+ *
+ * Of the formats down to auto_otw_min (default: sc8) that the block's stream
+ * signature allows and the host can convert, picks the widest one whose
+ * channels fit on the motherboard's link, see uhd::usrp::pick_otw_format().
+ * The decision is logged, so it can be reproduced with an explicit
+ * otw_format.
+ *
+ * \param args The stream args, otw_format is updated in place
+ * \param stream_sig The signature of the block the stream connects to
+ * \param samp_rate The sample rate of the stream
+ * \param num_chans Number of channels of the stream on this motherboard
+ * \param frame_size The frame size of the stream's transports
+ * \param header_size The largest packet header
+ * \param link_rate Rate of the motherboard's link in bytes per second, or 0
+ * \param dir Direction of the stream
+ */
+static void pick_auto_otw_format(stream_args_t& args,
+    const rfnoc::stream_sig_t& stream_sig,
+    const double samp_rate,
+    const size_t num_chans,
+    const size_t frame_size,
+    const size_t header_size,
+    const double link_rate,
+    const uhd::direction_t dir)
+{
+    const std::string tx_rx = dir == uhd::RX_DIRECTION ? "RX" : "TX";
+    const std::string min_format = args.args.get("auto_otw_min", "sc8");
+    if (std::find(AUTO_OTW_FORMATS.begin(), AUTO_OTW_FORMATS.end(), min_format)
+        == AUTO_OTW_FORMATS.end()) {
+        throw uhd::value_error(
+            str(boost::format("[%s Streamer] Invalid auto_otw_min: %s") % tx_rx
+                % min_format));
+    }
+
+    const std::vector<convert::id_type> converter_ids = convert::get_converter_ids();
+    auto has_converter = [&](const std::string& otw_format) {
+        return std::any_of(converter_ids.begin(),
+            converter_ids.end(),
+            [&](const convert::id_type& id) {
+                return dir == uhd::RX_DIRECTION
+                           ? id.input_format == otw_format + "_item32_le"
+                                 and id.output_format == args.cpu_format
+                           : id.input_format == args.cpu_format
+                                 and id.output_format == otw_format + "_item32_le";
+            });
+    };
+    std::vector<std::string> otw_formats;
+    for (const std::string& otw_format : AUTO_OTW_FORMATS) {
+        if ((stream_sig.item_type.empty() or stream_sig.item_type == otw_format)
+            and has_converter(otw_format)) {
+            otw_formats.push_back(otw_format);
+        }
+        if (otw_format == min_format) {
+            break;
+        }
+    }
+    if (otw_formats.empty()) {
+        throw uhd::runtime_error(
+            str(boost::format("[%s Streamer] otw_format=auto: No format down to %s "
+                              "fits stream_sig.item_type = '%s' and cpu_format = '%s'")
+                % tx_rx % min_format % stream_sig.item_type % args.cpu_format));
+    }
+
+    if (samp_rate <= 0.0 or samp_rate == rfnoc::rate_node_ctrl::RATE_UNDEFINED) {
+        args.otw_format = otw_formats.front();
+        UHD_LOGGER_WARNING("STREAMER")
+            << tx_rx << " otw_format=auto: The sample rate of the stream is unknown, "
+            << "using " << args.otw_format;
+        return;
+    }
+    const otw_format_choice_t choice = pick_otw_format(
+        otw_formats, samp_rate, num_chans, frame_size, header_size, link_rate);
+    args.otw_format = choice.otw_format;
+    const std::string decision = str(
+        boost::format("%s otw_format=auto: %d channel(s) at %f Msps need %f MB/s of "
+                      "%s with %d samples per packet on a %s link")
+        % tx_rx % num_chans % (samp_rate / 1e6) % (choice.bytes_per_sec / 1e6)
+        % choice.otw_format % choice.spp
+        % (link_rate > 0.0 ? str(boost::format("%f MB/s") % (link_rate / 1e6))
+                           : std::string("rate unknown")));
+    if (choice.fits) {
+        UHD_LOGGER_INFO("STREAMER") << decision;
+    } else {
+        UHD_LOGGER_WARNING("STREAMER")
+            << decision << ", which exceeds "
+            << static_cast<int>(OTW_LINK_HEADROOM * 100)
+            << "% of the link. This can cause "
+            << (dir == uhd::RX_DIRECTION ? "overflows (O)." : "underruns (U).");
+    }
+}
+
 /*! \brief Returns a list of rx or tx channels for a streamer.
  *
  * If the given stream args contain instructions to set up channels,
@@ -189,8 +354,10 @@ struct async_tx_info_t
 {
     size_t stream_channel;
     size_t device_channel;
-    boost::shared_ptr<device3_impl::async_md_type> async_queue;
+    boost::shared_ptr<device3_impl::async_event_ring_type> async_queue;
     boost::shared_ptr<device3_impl::async_md_type> old_async_queue;
+    //! The device-wide queue is only fed once somebody drains it
+    std::shared_ptr<std::atomic<bool>> old_async_queue_used;
 };
 
 /*! Handle incoming messages.
@@ -243,21 +410,227 @@ static void handle_tx_async_msgs(boost::shared_ptr<async_tx_info_t> async_info,
             << "Unexpected flow control message found in async message handling"
             << std::endl;
     } else {
-        async_info->async_queue->push_with_pop_on_full(metadata);
-        metadata.channel = async_info->device_channel;
-        async_info->old_async_queue->push_with_pop_on_full(metadata);
+        // If the application doesn't drain the ring, new messages are
+        // dropped. They are still printed below.
+        async_info->async_queue->push_with_haste(metadata);
+        if (async_info->old_async_queue_used->load(std::memory_order_relaxed)) {
+            metadata.channel = async_info->device_channel;
+            async_info->old_async_queue->push_with_pop_on_full(metadata);
+        }
         standard_async_msg_prints(metadata);
     }
 }
 
 bool device3_impl::recv_async_msg(async_metadata_t& async_metadata, double timeout)
 {
+    _async_md_used->store(true, std::memory_order_relaxed);
     return _async_md->pop_with_timed_wait(async_metadata, timeout);
 }
 
+/***********************************************************************
+ * Streamer transports
+ **********************************************************************/
+bool device3_impl::pooled_xport_t::is_idle(void) const
+{
+    // The pool holds one reference, or two if both directions share a transport
+    const long num_refs = (xport.recv == xport.send) ? 2 : 1;
+    return (not xport.recv or xport.recv.use_count() == num_refs)
+           and (not xport.send or xport.send.use_count() == num_refs);
+}
+
+both_xports_t device3_impl::get_streamer_transport(
+    const sid_t& address, const xport_type_t xport_type, const device_addr_t& args)
+{
+    if (not _pool_streamer_xports) {
+        return make_transport(address, xport_type, args);
+    }
+    const std::string args_str = args.to_string();
+    for (auto it = _xport_pool.begin(); it != _xport_pool.end();) {
+        if (it->address.get_dst() != address.get_dst() or it->xport_type != xport_type
+            or not it->is_idle()) {
+            ++it;
+        } else if (it->args == args_str) {
+            // Drop what the device sent after the last streamer was gone
+            while (it->xport.recv and it->xport.recv->get_recv_buff(0.0)) {
+            }
+            UHD_LOGGER_DEBUG("DEVICE3")
+                << "Recycling transport to " << address.get_dst() << " (" << args_str
+                << ")";
+            return it->xport;
+        } else {
+            it = _xport_pool.erase(it);
+        }
+    }
+
+    pooled_xport_t pooled;
+    pooled.address    = address;
+    pooled.xport_type = xport_type;
+    pooled.args       = args_str;
+    try {
+        pooled.xport = make_transport(address, xport_type, args);
+    } catch (const uhd::exception&) {
+        // Idle transports may hold the resources this one needs
+        if (_xport_pool.empty()) {
+            throw;
+        }
+        release_idle_transports();
+        pooled.xport = make_transport(address, xport_type, args);
+    }
+    _xport_pool.push_back(pooled);
+    return pooled.xport;
+}
+
+void device3_impl::release_idle_transports()
+{
+    _xport_pool.remove_if([](const pooled_xport_t& pooled) { return pooled.is_idle(); });
+}
+
+/***********************************************************************
+ * DRAM buffers
+ **********************************************************************/
+//! Default of the dram_buffer_poll_ms stream arg
+static const double DRAM_BUFFER_POLL_MS = 10.0;
+//! Defaults of the lead_time_init and lead_time_margin stream args
+static const double LEAD_TIME_INIT   = 0.01;
+static const double LEAD_TIME_MARGIN = 0.25;
+
+void device3_dram_buffers::set(
+    const size_t chan, rfnoc::dma_fifo_block_ctrl::sptr fifo, const size_t port)
+{
+    _buffers.at(chan).fifo = fifo;
+    _buffers.at(chan).port = port;
+}
+
+void device3_dram_buffers::start(const double period)
+{
+    _poll_task = task::make_periodic([this]() { poll(); }, period, "dram_buffers");
+}
+
+void device3_dram_buffers::poll(void)
+{
+    for (buffer_t& buffer : _buffers) {
+        const uint64_t bytes = buffer.fifo->get_bytes_occupied(buffer.port);
+        buffer.bytes         = bytes;
+        // Only this task writes max_bytes
+        if (bytes > buffer.max_bytes) {
+            buffer.max_bytes = bytes;
+        }
+    }
+}
+
+void device3_dram_buffers::get_stats(stream_stats_t& stats) const
+{
+    for (const buffer_t& buffer : _buffers) {
+        stats.dram_buffer_bytes.push_back(buffer.bytes);
+        stats.dram_buffer_max_bytes.push_back(buffer.max_bytes);
+        stats.dram_buffer_size.push_back(buffer.fifo->get_depth(buffer.port));
+    }
+}
+
+//! True if nothing is connected to \p port of a node
+static bool is_port_free(const rfnoc::node_ctrl_base::node_map_t& nodes, const size_t port)
+{
+    return nodes.count(port) == 0 or nodes.at(port).expired();
+}
+
+void device3_impl::insert_dram_buffer(rfnoc::block_id_t& block_id,
+    size_t& block_port,
+    const device_addr_t& args,
+    const uhd::direction_t dir)
+{
+    if (has_block<rfnoc::dma_fifo_block_ctrl>(block_id)) {
+        return;
+    }
+    const size_t mb_index = block_id.get_device_no();
+    const rfnoc::node_ctrl_base::sptr block = get_block_ctrl(block_id);
+
+    // The host side of a FIFO port must be free. The other side may still
+    // be connected to this channel's block, from an earlier streamer.
+    rfnoc::dma_fifo_block_ctrl::sptr fifo;
+    size_t fifo_port = rfnoc::ANY_PORT;
+    for (const rfnoc::block_id_t& fifo_id : find_blocks<rfnoc::dma_fifo_block_ctrl>(
+             str(boost::format("%d/DmaFIFO") % mb_index))) {
+        auto candidate = get_block_ctrl<rfnoc::dma_fifo_block_ctrl>(fifo_id);
+        const auto block_side = dir == uhd::RX_DIRECTION
+                                    ? candidate->list_upstream_nodes()
+                                    : candidate->list_downstream_nodes();
+        const auto host_side = dir == uhd::RX_DIRECTION
+                                   ? candidate->list_downstream_nodes()
+                                   : candidate->list_upstream_nodes();
+        for (const size_t port : candidate->get_input_ports()) {
+            if ((is_port_free(block_side, port) or block_side.at(port).lock() == block)
+                and is_port_free(host_side, port)) {
+                fifo      = candidate;
+                fifo_port = port;
+                break;
+            }
+        }
+        if (fifo) {
+            break;
+        }
+    }
+    if (not fifo) {
+        throw uhd::runtime_error(
+            str(boost::format("dram_buffer: No free DmaFIFO port on motherboard %d. "
+                              "TX streams may hold them, see the skip_dram device arg.")
+                % mb_index));
+    }
+
+    if (args.has_key("dram_buffer_size")) {
+        const uint32_t size      = rfnoc::get_dram_buffer_size(args, fifo_port);
+        const uint32_t base_addr = uint32_t(fifo_port) * size;
+        for (const size_t port : fifo->get_input_ports()) {
+            const bool in_use =
+                port != fifo_port
+                and (not is_port_free(fifo->list_upstream_nodes(), port)
+                        or not is_port_free(fifo->list_downstream_nodes(), port));
+            if (in_use and base_addr < fifo->get_base_addr(port) + fifo->get_depth(port)
+                and fifo->get_base_addr(port) < base_addr + size) {
+                throw uhd::runtime_error(str(
+                    boost::format("dram_buffer: %d bytes at port %d of %s would overlap "
+                                  "port %d, which is in use")
+                    % size % fifo_port % fifo->get_block_id() % port));
+            }
+        }
+        if (base_addr != fifo->get_base_addr(fifo_port)
+            or size != fifo->get_depth(fifo_port)) {
+            fifo->resize(base_addr, size, fifo_port);
+        }
+    }
+
+    if (not _dram_buffer_graph) {
+        _dram_buffer_graph = create_graph("dram_buffer");
+    }
+    // The FIFO forwards what it gets, so it is sized for the largest packets
+    if (dir == uhd::RX_DIRECTION) {
+        _dram_buffer_graph->connect(block_id,
+            block_port,
+            fifo->get_block_id(),
+            fifo_port,
+            rfnoc::MAX_PACKET_SIZE);
+    } else {
+        _dram_buffer_graph->connect(fifo->get_block_id(),
+            fifo_port,
+            block_id,
+            block_port,
+            rfnoc::MAX_PACKET_SIZE);
+    }
+    block_id   = fifo->get_block_id();
+    block_port = fifo_port;
+}
+
 /***********************************************************************
  * Receive streamer
  **********************************************************************/
+managed_recv_buffer::sptr device3_rx_buff_getter::operator()(const double timeout) const
+{
+    managed_recv_buffer::sptr buff = xport->get_recv_buff(timeout);
+    if (buff and fc_cache) {
+        rx_flow_ctrl(*fc_cache, buff.get());
+    }
+    return buff;
+}
+
 void device3_impl::update_rx_streamers()
 {
     for (const std::string& block_id : _rx_streamers.keys()) {
@@ -291,6 +664,7 @@ void device3_impl::update_rx_streamers()
 
 rx_streamer::sptr device3_impl::get_rx_stream(const stream_args_t& args_)
 {
+    UHD_TRACE_SPAN("device3", "get_rx_stream");
     boost::mutex::scoped_lock lock(_transport_setup_mutex);
     stream_args_t args = sanitize_stream_args(args_);
 
@@ -307,6 +681,11 @@ rx_streamer::sptr device3_impl::get_rx_stream(const stream_args_t& args_)
     // it will be connected to each upstream block.
     rfnoc::rx_stream_terminator::sptr recv_terminator =
         rfnoc::rx_stream_terminator::make();
+    device3_dram_buffers::sptr dram_buffers;
+    if (rfnoc::use_dram_buffer(args.args)) {
+        dram_buffers = std::make_shared<device3_dram_buffers>(chan_list.size());
+    }
+    const bool auto_otw = args.otw_format == "auto";
     for (size_t stream_i = 0; stream_i < chan_list.size(); stream_i++) {
         // First, configure blocks and create transport
 
@@ -318,6 +697,9 @@ rx_streamer::sptr device3_impl::get_rx_stream(const stream_args_t& args_)
         size_t mb_index = block_id.get_device_no();
         size_t suggested_block_port =
             args.args.cast<size_t>("block_port", rfnoc::ANY_PORT);
+        if (dram_buffers) {
+            insert_dram_buffer(block_id, suggested_block_port, args.args, RX_DIRECTION);
+        }
 
         // Access to this channel's block control
         uhd::rfnoc::source_block_ctrl_base::sptr blk_ctrl =
@@ -330,10 +712,14 @@ rx_streamer::sptr device3_impl::get_rx_stream(const stream_args_t& args_)
         const size_t terminator_port = recv_terminator->connect_upstream(blk_ctrl);
         blk_ctrl->set_downstream_port(block_port, terminator_port);
         recv_terminator->set_upstream_port(terminator_port, block_port);
-
-        // Check if the block connection is compatible (spp and item type)
-        check_stream_sig_compatible(
-            blk_ctrl->get_output_signature(block_port), args, "RX");
+        if (dram_buffers) {
+            auto fifo = get_block_ctrl<rfnoc::dma_fifo_block_ctrl>(block_id);
+            dram_buffers->set(stream_i, fifo, block_port);
+            UHD_LOGGER_INFO("STREAMER")
+                << "RX channel " << stream_i << " buffered by " << block_id << ":"
+                << block_port << " (" << (fifo->get_depth(block_port) / 1024 / 1024)
+                << " MiB)";
+        }
 
         // Setup the DSP transport hints
         device_addr_t rx_hints = get_rx_hints(mb_index);
@@ -367,11 +753,38 @@ rx_streamer::sptr device3_impl::get_rx_stream(const stream_args_t& args_)
                 << mtu;
             rx_hints["recv_frame_size"] = std::to_string(mtu);
         }
+        if (auto_otw) {
+            // Fewer, larger packets spend less of the link on headers
+            if (not rx_hints.has_key("recv_frame_size")) {
+                rx_hints["recv_frame_size"] = std::to_string(mtu);
+            }
+            if (args.otw_format == "auto") {
+                pick_auto_otw_format(args,
+                    blk_ctrl->get_output_signature(block_port),
+                    recv_terminator->get_output_samp_rate(),
+                    std::count_if(chan_list.begin(),
+                        chan_list.end(),
+                        [mb_index](const rfnoc::block_id_t& chan) {
+                            return chan.get_device_no() == mb_index;
+                        }),
+                    rx_hints.cast<size_t>("recv_frame_size", mtu),
+                    stream_options.rx_max_len_hdr,
+                    get_link_rate(mb_index),
+                    RX_DIRECTION);
+            }
+        }
+
+        // Check if the block connection is compatible (spp and item type)
+        check_stream_sig_compatible(
+            blk_ctrl->get_output_signature(block_port), args, "RX");
+
+        auto_tune_xport_hints(
+            rx_hints, args, recv_terminator->get_output_samp_rate(), mtu, RX_DIRECTION);
 
         // allocate sid and create transport
         uhd::sid_t stream_address = blk_ctrl->get_address(block_port);
         UHD_RX_STREAMER_LOG() << "creating rx stream " << rx_hints.to_string();
-        both_xports_t xport = make_transport(stream_address, RX_DATA, rx_hints);
+        both_xports_t xport = get_streamer_transport(stream_address, RX_DATA, rx_hints);
         UHD_RX_STREAMER_LOG() << std::hex << "data_sid = " << xport.send_sid << std::dec
                               << " actual recv_buff_size = " << xport.recv_buff_size;
 
@@ -398,6 +811,16 @@ rx_streamer::sptr device3_impl::get_rx_stream(const stream_args_t& args_)
         fc_cache->sid      = xport.send_sid;
         fc_cache->xport    = xport.send;
         fc_cache->interval = fc_handle_window;
+        if (args.args.has_key("fc_adaptive")) {
+            fc_cache->adaptive     = true;
+            fc_cache->big_endian   = (xport.endianness == ENDIANNESS_BIG);
+            fc_cache->min_interval = fc_handle_window;
+            // Keep at least half the window as credit for the device
+            fc_cache->max_interval = std::max(fc_handle_window, fc_window / 2);
+            fc_cache->target_period = args.args.cast<double>(
+                "fc_adaptive_period", DEVICE3_RX_FC_ADAPTIVE_PERIOD);
+            fc_cache->last_fc_time = std::chrono::steady_clock::now();
+        }
         if (xport.endianness == ENDIANNESS_BIG) {
             fc_cache->to_host   = uhd::ntohx<uint32_t>;
             fc_cache->from_host = uhd::htonx<uint32_t>;
@@ -409,10 +832,21 @@ rx_streamer::sptr device3_impl::get_rx_stream(const stream_args_t& args_)
             fc_cache->pack      = vrt::chdr::if_hdr_pack_le;
             fc_cache->unpack    = vrt::chdr::if_hdr_unpack_le;
         }
-        xport.recv = zero_copy_flow_ctrl::make(
-            xport.recv, 0, [fc_cache](managed_buffer::sptr buff) {
-                return rx_flow_ctrl(fc_cache, buff);
-            });
+        // The streamer's buffer getter does the flow control accounting,
+        // unless faults are injected, which must come after it
+        boost::shared_ptr<rx_fc_cache_t> getter_fc_cache = fc_cache;
+        if (zero_copy_fault_inject::has_faults(rx_hints)) {
+            xport.recv = zero_copy_flow_ctrl::make(
+                xport.recv, 0, [fc_cache](managed_buffer::sptr buff) {
+                    return rx_flow_ctrl(fc_cache, buff);
+                });
+            getter_fc_cache.reset();
+            // Draw different faults for every channel
+            device_addr_t fault_args      = rx_hints;
+            fault_args["recv_fault_seed"] = std::to_string(
+                rx_hints.cast<uint32_t>("recv_fault_seed", 1) + stream_i);
+            xport.recv = zero_copy_fault_inject::make(xport.recv, fault_args);
+        }
 
         // Configure the block
         // Note: We need to set_destination() after writing to SR_CLEAR_TX_FC.
@@ -457,25 +891,38 @@ rx_streamer::sptr device3_impl::get_rx_stream(const stream_args_t& args_)
             my_streamer = boost::make_shared<device3_recv_packet_streamer>(
                 spp, recv_terminator, xport);
             my_streamer->resize(chan_list.size());
+            my_streamer->set_convert_threads(
+                args.args.cast<size_t>("convert_threads", 1));
+            my_streamer->set_alignment_batch_size(
+                args.args.cast<size_t>("align_batch", 1));
         }
 
         // init some streamer stuff
         std::string conv_endianness;
         if (xport.endianness == ENDIANNESS_BIG) {
             my_streamer->set_vrt_unpacker(&vrt::chdr::if_hdr_unpack_be);
+            my_streamer->set_vrt_batch_unpacker(&vrt::chdr::if_hdr_unpack_batch_be);
             conv_endianness = "be";
         } else {
             my_streamer->set_vrt_unpacker(&vrt::chdr::if_hdr_unpack_le);
+            my_streamer->set_vrt_batch_unpacker(&vrt::chdr::if_hdr_unpack_batch_le);
             conv_endianness = "le";
         }
 
-        // set the converter
+        // set the converter, one for all channels when interleaving them
         uhd::convert::id_type id;
-        id.input_format  = args.otw_format + "_item32_" + conv_endianness;
-        id.num_inputs    = 1;
+        id.input_format = args.otw_format + "_item32_" + conv_endianness;
+        id.num_inputs   = args.args.has_key("interleave_channels")
+                            ? chan_list.size()
+                            : 1;
         id.output_format = args.cpu_format;
         id.num_outputs   = 1;
         my_streamer->set_converter(id);
+        if (args.args.has_key("signal_stats")
+            and not my_streamer->enable_signal_stats()) {
+            UHD_LOGGER_WARNING("STREAMER")
+                << "signal_stats is not supported for " << id.to_pp_string();
+        }
 
         // Give the streamer a functor to handle flow control ACK messages
         my_streamer->set_xport_handle_flowctrl_ack(
@@ -485,9 +932,10 @@ rx_streamer::sptr device3_impl::get_rx_stream(const stream_args_t& args_)
 
         // Give the streamer a functor to get the recv_buffer
         my_streamer->set_xport_chan_get_buff(stream_i,
-            [xport](double timeout) { return xport.recv->get_recv_buff(timeout); },
+            device3_rx_buff_getter{xport.recv, getter_fc_cache},
             true /*flush*/
         );
+        my_streamer->set_xport_chan_wait_xport(stream_i, xport.recv);
 
         // Give the streamer a functor to handle overruns
         // bind requires a weak_ptr to break the a streamer->streamer circular dependency
@@ -499,11 +947,25 @@ rx_streamer::sptr device3_impl::get_rx_stream(const stream_args_t& args_)
                 recv_terminator->handle_overrun(weak_ptr, stream_i);
             });
 
-        // Give the streamer a functor issue stream cmd
-        my_streamer->set_issue_stream_cmd(
-            stream_i, [blk_ctrl, block_port](const stream_cmd_t& stream_cmd) {
+        // Give the streamer a functor issue stream cmd. The blocks of different
+        // motherboards can take their stream commands at the same time.
+        my_streamer->set_issue_stream_cmd(stream_i,
+            [blk_ctrl, block_port](const stream_cmd_t& stream_cmd) {
                 blk_ctrl->issue_stream_cmd(stream_cmd, block_port);
-            });
+            },
+            blk_ctrl->get_block_id().get_device_no());
+    }
+
+    if (args.args.has_key("fast_overflow_recovery")) {
+        recv_terminator->set_overflow_recovery(true,
+            args.args.cast<double>("overflow_restart_delay",
+                rfnoc::rx_stream_terminator::DEFAULT_FAST_RESTART_DELAY));
+    }
+
+    if (dram_buffers) {
+        my_streamer->set_dram_buffers(dram_buffers);
+        dram_buffers->start(
+            args.args.cast<double>("dram_buffer_poll_ms", DRAM_BUFFER_POLL_MS) / 1e3);
     }
 
     // Notify all blocks in this chain that they are connected to an active streamer
@@ -526,6 +988,16 @@ rx_streamer::sptr device3_impl::get_rx_stream(const stream_args_t& args_)
 /***********************************************************************
  * Transmit streamer
  **********************************************************************/
+void device3_tx_flow_ctrl_ack_cb::operator()(void) const
+{
+    tx_flow_ctrl_ack(fc_cache, xport, sid);
+}
+
+void device3_tx_flow_ctrl_cb::operator()(const size_t size) const
+{
+    tx_flow_ctrl(*fc_cache, xport, size);
+}
+
 void device3_impl::update_tx_streamers()
 {
     for (const std::string& block_id : _tx_streamers.keys()) {
@@ -558,6 +1030,7 @@ void device3_impl::update_tx_streamers()
 
 tx_streamer::sptr device3_impl::get_tx_stream(const uhd::stream_args_t& args_)
 {
+    UHD_TRACE_SPAN("device3", "get_tx_stream");
     boost::mutex::scoped_lock lock(_transport_setup_mutex);
     stream_args_t args = sanitize_stream_args(args_);
 
@@ -567,8 +1040,10 @@ tx_streamer::sptr device3_impl::get_tx_stream(const uhd::stream_args_t& args_)
     generate_channel_list(args, chan_list, chan_args);
     // Note: All 'args.args' are merged into chan_args now.
 
-    // shared async queue for all channels in streamer
-    boost::shared_ptr<async_md_type> async_md(new async_md_type(1000 /*messages deep*/));
+    // shared async queue for all channels in streamer, fed by one async message
+    // task per channel
+    boost::shared_ptr<async_event_ring_type> async_md(new async_event_ring_type(
+        1024 /*messages deep*/, args.args.has_key("async_msg_fd")));
 
     // II. Iterate over all channels
     boost::shared_ptr<device3_send_packet_streamer> my_streamer;
@@ -577,6 +1052,11 @@ tx_streamer::sptr device3_impl::get_tx_stream(const uhd::stream_args_t& args_)
     // it will be connected to each downstream block.
     rfnoc::tx_stream_terminator::sptr send_terminator =
         rfnoc::tx_stream_terminator::make();
+    device3_dram_buffers::sptr dram_buffers;
+    if (rfnoc::use_dram_buffer(args.args)) {
+        dram_buffers = std::make_shared<device3_dram_buffers>(chan_list.size());
+    }
+    const bool auto_otw = args.otw_format == "auto";
     for (size_t stream_i = 0; stream_i < chan_list.size(); stream_i++) {
         // First, configure the downstream blocks and create the transports
 
@@ -587,6 +1067,9 @@ tx_streamer::sptr device3_impl::get_tx_stream(const uhd::stream_args_t& args_)
         size_t mb_index = block_id.get_device_no();
         size_t suggested_block_port =
             args.args.cast<size_t>("block_port", rfnoc::ANY_PORT);
+        if (dram_buffers) {
+            insert_dram_buffer(block_id, suggested_block_port, args.args, TX_DIRECTION);
+        }
 
         // Access to this channel's block control
         uhd::rfnoc::sink_block_ctrl_base::sptr blk_ctrl =
@@ -600,10 +1083,14 @@ tx_streamer::sptr device3_impl::get_tx_stream(const uhd::stream_args_t& args_)
         const size_t terminator_port = send_terminator->connect_downstream(blk_ctrl);
         blk_ctrl->set_upstream_port(block_port, terminator_port);
         send_terminator->set_downstream_port(terminator_port, block_port);
-
-        // Check if the block connection is compatible (spp and item type)
-        check_stream_sig_compatible(
-            blk_ctrl->get_input_signature(block_port), args, "TX");
+        if (dram_buffers) {
+            auto fifo = get_block_ctrl<rfnoc::dma_fifo_block_ctrl>(block_id);
+            dram_buffers->set(stream_i, fifo, block_port);
+            UHD_LOGGER_INFO("STREAMER")
+                << "TX channel " << stream_i << " buffered by " << block_id << ":"
+                << block_port << " (" << (fifo->get_depth(block_port) / 1024 / 1024)
+                << " MiB)";
+        }
 
         // Setup the dsp transport hints
         device_addr_t tx_hints = get_tx_hints(mb_index);
@@ -638,14 +1125,41 @@ tx_streamer::sptr device3_impl::get_tx_stream(const uhd::stream_args_t& args_)
                 << mtu;
             tx_hints["send_frame_size"] = std::to_string(mtu);
         }
+        if (auto_otw) {
+            // Fewer, larger packets spend less of the link on headers
+            if (not tx_hints.has_key("send_frame_size")) {
+                tx_hints["send_frame_size"] = std::to_string(mtu);
+            }
+            if (args.otw_format == "auto") {
+                pick_auto_otw_format(args,
+                    blk_ctrl->get_input_signature(block_port),
+                    send_terminator->get_input_samp_rate(),
+                    std::count_if(chan_list.begin(),
+                        chan_list.end(),
+                        [mb_index](const rfnoc::block_id_t& chan) {
+                            return chan.get_device_no() == mb_index;
+                        }),
+                    tx_hints.cast<size_t>("send_frame_size", mtu),
+                    stream_options.tx_max_len_hdr,
+                    get_link_rate(mb_index),
+                    TX_DIRECTION);
+            }
+        }
+
+        // Check if the block connection is compatible (spp and item type)
+        check_stream_sig_compatible(
+            blk_ctrl->get_input_signature(block_port), args, "TX");
+
+        auto_tune_xport_hints(
+            tx_hints, args, send_terminator->get_input_samp_rate(), mtu, TX_DIRECTION);
 
         const size_t fifo_size = blk_ctrl->get_fifo_size(block_port);
         // Allocate sid and create transport
         uhd::sid_t stream_address = blk_ctrl->get_address(block_port);
         UHD_TX_STREAMER_LOG() << "creating tx stream " << tx_hints.to_string();
-        both_xports_t xport = make_transport(stream_address, TX_DATA, tx_hints);
+        both_xports_t xport = get_streamer_transport(stream_address, TX_DATA, tx_hints);
         both_xports_t async_xport =
-            make_transport(stream_address, ASYNC_MSG, device_addr_t(""));
+            get_streamer_transport(stream_address, ASYNC_MSG, device_addr_t(""));
         UHD_TX_STREAMER_LOG() << std::hex << "data_sid = " << xport.send_sid << std::dec;
 
         // Configure flow control
@@ -676,7 +1190,12 @@ tx_streamer::sptr device3_impl::get_tx_stream(const uhd::stream_args_t& args_)
             fc_cache->pack      = vrt::chdr::if_hdr_pack_le;
             fc_cache->unpack    = vrt::chdr::if_hdr_unpack_le;
         }
-        xport.send = zero_copy_flow_ctrl::make(xport.send,
+        // FC packets are received by a separate task, see below
+        fc_cache->async_credit = args.args.has_key("fc_async");
+        // The streamer waits for credit before sending each data packet. The
+        // FC ACKs are rare and take credit on top of what they account for
+        // themselves, so they keep going through a flow controlled transport.
+        zero_copy_if::sptr fc_ack_xport = zero_copy_flow_ctrl::make(xport.send,
             [fc_cache, xport](managed_buffer::sptr buff) {
                 return tx_flow_ctrl(fc_cache, xport.recv, buff);
             },
@@ -750,6 +1269,8 @@ tx_streamer::sptr device3_impl::get_tx_stream(const uhd::stream_args_t& args_)
             my_streamer = boost::make_shared<device3_send_packet_streamer>(
                 spp, send_terminator, xport, async_xport);
             my_streamer->resize(chan_list.size());
+            my_streamer->set_convert_threads(
+                args.args.cast<size_t>("convert_threads", 1));
         }
 
         // init some streamer stuff
@@ -761,6 +1282,7 @@ tx_streamer::sptr device3_impl::get_tx_stream(const uhd::stream_args_t& args_)
             my_streamer->set_vrt_packer(&vrt::chdr::if_hdr_pack_le);
             conv_endianness = "le";
         }
+        my_streamer->set_chdr_data_packer(xport.endianness);
 
         // set the converter
         uhd::convert::id_type id;
@@ -775,6 +1297,7 @@ tx_streamer::sptr device3_impl::get_tx_stream(const uhd::stream_args_t& args_)
         async_tx_info->device_channel  = mb_index;
         async_tx_info->async_queue     = async_md;
         async_tx_info->old_async_queue = _async_md;
+        async_tx_info->old_async_queue_used = _async_md_used;
 
         task::sptr async_task =
             task::make([async_tx_info, async_xport, xport, send_terminator]() {
@@ -787,15 +1310,26 @@ tx_streamer::sptr device3_impl::get_tx_stream(const uhd::stream_args_t& args_)
                     [send_terminator]() { return send_terminator->get_tick_rate(); });
             });
         my_streamer->add_async_msg_task(async_task);
+        if (fc_cache->async_credit) {
+            my_streamer->add_async_msg_task(task::make(
+                [fc_cache, xport]() { tx_flow_ctrl_harvest(fc_cache, xport.recv); },
+                "uhd_tx_fc"));
+        }
 
         // Give the streamer a functor to get the send buffer
-        my_streamer->set_xport_chan_get_buff(stream_i,
-            [xport](const double timeout) { return xport.send->get_send_buff(timeout); });
+        my_streamer->set_xport_chan_get_buff(
+            stream_i, sph::zero_copy_send_buff_getter{xport.send});
+        my_streamer->set_xport_chan_flowctrl(
+            stream_i, device3_tx_flow_ctrl_cb{fc_cache, xport.recv});
+        // Make sure the end of a burst doesn't wait in a batching transport
+        my_streamer->set_xport_chan_flush_cb(
+            stream_i, [xport]() { xport.send->flush_send_buffs(); });
         // Give the streamer a functor handled received async messages
         my_streamer->set_async_receiver(
             [async_md](uhd::async_metadata_t& md, const double timeout) {
                 return async_md->pop_with_timed_wait(md, timeout);
             });
+        my_streamer->set_async_msg_fd(async_md->get_event_fd());
         my_streamer->set_xport_chan_sid(stream_i, true, xport.send_sid);
         // CHDR does not support trailers
         my_streamer->set_enable_trailer(false);
@@ -803,10 +1337,29 @@ tx_streamer::sptr device3_impl::get_tx_stream(const uhd::stream_args_t& args_)
         // Avoid sending FC ACKs if the transport is lossless or the user
         // has explictly requested not to send them
         if (not(xport.lossless or tx_hints.has_key("send_no_fc_acks"))) {
-            my_streamer->set_xport_chan_post_send_cb(stream_i, [fc_cache, xport]() {
-                tx_flow_ctrl_ack(fc_cache, xport.send, xport.send_sid);
-            });
+            my_streamer->set_xport_chan_post_send_cb(stream_i,
+                device3_tx_flow_ctrl_ack_cb{fc_cache, fc_ack_xport, xport.send_sid});
+        }
+    }
+
+    if (dram_buffers) {
+        my_streamer->set_dram_buffers(dram_buffers);
+        dram_buffers->start(
+            args.args.cast<double>("dram_buffer_poll_ms", DRAM_BUFFER_POLL_MS) / 1e3);
+    }
+
+    if (args.args.has_key("lead_time")) {
+        const std::string mode = args.args.get("lead_time");
+        if (mode != "measure" and mode != "auto") {
+            throw uhd::value_error(
+                "lead_time stream arg must be measure or auto, not " + mode);
         }
+        my_streamer->set_lead_time_ctrl(
+            std::make_shared<transport::tx_lead_time_ctrl>(
+                args.args.cast<double>("lead_time_init", LEAD_TIME_INIT),
+                args.args.cast<double>("lead_time_min", 0.0),
+                args.args.cast<double>("lead_time_margin", LEAD_TIME_MARGIN)),
+            mode == "auto");
     }
 
     // Notify all blocks in this chain that they are connected to an active streamer
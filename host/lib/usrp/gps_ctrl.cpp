@@ -8,17 +8,20 @@
 #include <uhd/usrp/gps_ctrl.hpp>
 
 #include <uhd/utils/log.hpp>
+#include <uhd/utils/safe_call.hpp>
+#include <uhd/utils/thread.hpp>
 #include <uhd/exception.hpp>
 #include <uhd/types/sensors.hpp>
 #include <boost/algorithm/string.hpp>
 #include <boost/thread/thread.hpp>
-#include <boost/tokenizer.hpp>
 #include <boost/format.hpp>
-#include <boost/regex.hpp>
-#include <boost/thread/mutex.hpp>
 #include <boost/date_time.hpp>
-#include <boost/tuple/tuple.hpp>
+#include <atomic>
+#include <cctype>
+#include <condition_variable>
 #include <ctime>
+#include <map>
+#include <mutex>
 #include <string>
 #include <thread>
 #include <chrono>
@@ -35,6 +38,7 @@ namespace {
     constexpr int GPS_LOCK_FRESHNESS        = 2500;
     constexpr int GPS_TIMEOUT_DELAY_MS      = 200;
     constexpr int GPSDO_COMMAND_DELAY_MS    = 200;
+    constexpr int GPS_POLL_INTERVAL_MS      = 10;
 }
 
 /*!
@@ -47,83 +51,91 @@ gps_ctrl::~gps_ctrl(void){
 
 class gps_ctrl_impl : public gps_ctrl{
 private:
-    std::map<std::string, boost::tuple<std::string, boost::system_time, bool> > sentences;
-    boost::mutex cache_mutex;
-    boost::system_time _last_cache_update;
+    //! The latest sentence of one type
+    struct sentence_t
+    {
+        std::string msg;
+        std::chrono::steady_clock::time_point time;
+        //! Number of sentences of this type received so far
+        uint64_t count = 0;
+    };
+
+    // The reader thread parses the UART output into _sentences, the sensor
+    // getters only wait for it if they need a sentence that isn't there yet
+    std::map<std::string, sentence_t> _sentences;
+    std::mutex _sentence_mutex;
+    std::condition_variable _sentence_cond;
+    boost::thread _reader_thread;
+    std::once_flag _reader_started;
+    std::atomic<bool> _reader_done{false};
 
     std::string get_sentence(const std::string which, const int max_age_ms, const int timeout, const bool wait_for_next = false)
     {
-        std::string sentence;
-        boost::system_time now = boost::get_system_time();
-        boost::system_time exit_time = now + milliseconds(timeout);
-        boost::posix_time::time_duration age;
-
-        if (wait_for_next)
+        start_reader();
+
+        std::unique_lock<std::mutex> lock(_sentence_mutex);
+        const sentence_t& sentence = _sentences[which];
+        const uint64_t count = sentence.count;
+        const auto ready = [&]() {
+            return sentence.count > 0
+                   and (not wait_for_next or sentence.count > count)
+                   and std::chrono::steady_clock::now() - sentence.time
+                           < std::chrono::milliseconds(max_age_ms);
+        };
+        if (not _sentence_cond.wait_for(lock, std::chrono::milliseconds(timeout), ready))
         {
-            boost::lock_guard<boost::mutex> lock(cache_mutex);
-            update_cache();
-            //mark sentence as touched
-            if (sentences.find(which) != sentences.end())
-                sentences[which].get<2>() = true;
+            throw uhd::value_error("gps ctrl: No " + which + " message found");
         }
-        while (1)
-        {
-            try
-            {
-                boost::lock_guard<boost::mutex> lock(cache_mutex);
-
-                // update cache if older than a millisecond
-                if (now - _last_cache_update > milliseconds(1))
-                {
-                    update_cache();
-                }
 
-                if (sentences.find(which) == sentences.end())
-                {
-                    age = milliseconds(max_age_ms);
-                } else {
-                    age = boost::get_system_time() - sentences[which].get<1>();
-                }
-                if (age < milliseconds(max_age_ms) and (not (wait_for_next and sentences[which].get<2>())))
-                {
-                    sentence = sentences[which].get<0>();
-                    sentences[which].get<2>() = true;
-                }
-            } catch(std::exception &e) {
-                UHD_LOGGER_DEBUG("GPS") << "get_sentence: " << e.what();
-            }
+        return sentence.msg;
+    }
 
-            if (not sentence.empty() or now > exit_time)
-            {
-                break;
-            }
+    static bool is_upper_hex(const char c)
+    {
+        return std::isdigit(static_cast<unsigned char>(c)) or (c >= 'A' and c <= 'F');
+    }
 
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
-            now = boost::get_system_time();
-        }
+    static uint32_t hex_value(const char c)
+    {
+        return std::isdigit(static_cast<unsigned char>(c)) ? uint32_t(c - '0')
+                                                            : uint32_t(c - 'A' + 10);
+    }
 
-        if (sentence.empty())
-        {
-            throw uhd::value_error("gps ctrl: No " + which + " message found");
+    //! Servo messages start with a date: "dd-dd-dd"
+    static bool is_servo_msg(const std::string& msg)
+    {
+        if (msg.length() < 8)
+            return false;
+        for (size_t i = 0; i < 8; i++) {
+            if ((i % 3 == 2) ? msg[i] != '-'
+                             : not std::isdigit(static_cast<unsigned char>(msg[i])))
+                return false;
         }
+        return true;
+    }
 
-        return sentence;
+    //! NMEA sentences from the GPSDO look like "$GP...,*HH"
+    static bool is_nmea_msg(const std::string& msg)
+    {
+        const size_t len = msg.length();
+        return len >= 7 and msg.compare(0, 3, "$GP") == 0 and msg[len-4] == ','
+               and msg[len-3] == '*' and is_upper_hex(msg[len-2])
+               and is_upper_hex(msg[len-1]);
     }
 
-    static bool is_nmea_checksum_ok(std::string nmea)
+    static bool is_nmea_checksum_ok(const std::string& nmea)
     {
         if (nmea.length() < 5 || nmea[0] != '$' || nmea[nmea.length()-3] != '*')
             return false;
-
-        std::stringstream ss;
-        uint32_t string_crc;
-        uint32_t calculated_crc = 0;
+        if (not is_upper_hex(nmea[nmea.length()-2]) or not is_upper_hex(nmea[nmea.length()-1]))
+            return false;
 
         // get crc from string
-        ss << std::hex << nmea.substr(nmea.length()-2, 2);
-        ss >> string_crc;
+        const uint32_t string_crc =
+            hex_value(nmea[nmea.length()-2]) << 4 | hex_value(nmea[nmea.length()-1]);
 
         // calculate crc
+        uint32_t calculated_crc = 0;
         for (size_t i = 1; i < nmea.length()-3; i++)
             calculated_crc ^= nmea[i];
 
@@ -131,14 +143,12 @@ private:
         return (string_crc == calculated_crc);
     }
 
+  //! Read everything the UART has, and store the latest sentence of each type
   void update_cache() {
     if(not gps_detected()) {
         return;
     }
 
-    const std::list<std::string> keys{"GPGGA", "GPRMC", "SERVO"};
-    static const boost::regex servo_regex("^\\d\\d-\\d\\d-\\d\\d.*$");
-    static const boost::regex gp_msg_regex("^\\$GP.*,\\*[0-9A-F]{2}$");
     std::map<std::string,std::string> msgs;
 
     // Get all GPSDO messages available
@@ -162,11 +172,11 @@ private:
         }
 
         // Look for SERVO message
-        if (boost::regex_search(msg, servo_regex, boost::regex_constants::match_continuous))
+        if (is_servo_msg(msg))
         {
             msgs["SERVO"] = msg;
         }
-        else if (boost::regex_match(msg, gp_msg_regex) and is_nmea_checksum_ok(msg))
+        else if (is_nmea_msg(msg) and is_nmea_checksum_ok(msg))
         {
             msgs[msg.substr(1,5)] = msg;
         }
@@ -175,19 +185,47 @@ private:
             UHD_LOGGER_WARNING("GPS") << __FUNCTION__ << ": Malformed GPSDO string: " << msg ;
         }
     }
+    if (msgs.empty()) {
+        return;
+    }
 
-    boost::system_time time = boost::get_system_time();
+    const auto time = std::chrono::steady_clock::now();
 
     // Update sentences with newly read data
-    for(std::string key:  keys)
+    std::lock_guard<std::mutex> lock(_sentence_mutex);
+    for (const char* key : {"GPGGA", "GPRMC", "SERVO"})
     {
-        if (not msgs[key].empty())
+        const auto msg = msgs.find(key);
+        if (msg != msgs.end())
         {
-            sentences[key] = boost::make_tuple(msgs[key], time, false);
+            sentence_t& sentence = _sentences[key];
+            sentence.msg  = msg->second;
+            sentence.time = time;
+            sentence.count++;
         }
     }
+    _sentence_cond.notify_all();
+  }
 
-    _last_cache_update = time;
+  //! Start polling the UART in the background, on the first sensor access
+  void start_reader() {
+    if(not gps_detected()) {
+        return;
+    }
+    std::call_once(_reader_started, [this]() {
+        _reader_thread = boost::thread([this]() {
+            while (not _reader_done) {
+                try {
+                    update_cache();
+                } catch (const std::exception& e) {
+                    UHD_LOGGER_DEBUG("GPS") << "update_cache: " << e.what();
+                }
+                std::this_thread::sleep_for(
+                    std::chrono::milliseconds(GPS_POLL_INTERVAL_MS));
+            }
+        });
+        set_thread_name(&_reader_thread, "gps_reader");
+    });
   }
 
 public:
@@ -260,7 +298,10 @@ public:
   }
 
   ~gps_ctrl_impl(void){
-    /* NOP */
+    _reader_done = true;
+    if (_reader_thread.joinable()) {
+        UHD_SAFE_CALL(_reader_thread.join();)
+    }
   }
 
   //return a list of supported sensors
@@ -323,16 +364,16 @@ private:
   }
 
   //helper function to retrieve a field from an NMEA sentence
-  std::string get_token(std::string sentence, size_t offset) {
-    boost::tokenizer<boost::escaped_list_separator<char> > tok(sentence);
-    std::vector<std::string> toked;
-    tok.assign(sentence); //this can throw
-    toked.assign(tok.begin(), tok.end());
-
-    if(toked.size() <= offset) {
-        throw uhd::value_error(str(boost::format("Invalid response \"%s\"") % sentence));
+  static std::string get_token(const std::string& sentence, size_t offset) {
+    size_t start = 0;
+    for (size_t i = 0; i < offset; i++) {
+        start = sentence.find(',', start);
+        if(start == std::string::npos) {
+            throw uhd::value_error(str(boost::format("Invalid response \"%s\"") % sentence));
+        }
+        start++;
     }
-    return toked[offset];
+    return sentence.substr(start, sentence.find(',', start) - start);
   }
 
   ptime get_time(void) {
@@ -115,6 +115,10 @@ device_addrs_t mpmd_find_with_addr(
             UHD_LOG_TRACE(
                 "MPMD FIND", "Found device that matches hints: " << new_addr.to_string());
             addrs.push_back(new_addr);
+            // Serials are unique, no need to wait for more replies
+            if (hint_.has_key("serial")) {
+                break;
+            }
         } else {
             UHD_LOG_DEBUG(
                 "MPMD FIND", "Found device, but does not match hint: " << recv_addr);
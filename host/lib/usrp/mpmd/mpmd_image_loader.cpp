@@ -208,6 +208,13 @@ static bool mpmd_image_loader(const image_loader::image_loader_args_t& image_loa
             UHD_LOG_TRACE("MPMD IMAGE LOADER", "FPGA images read from file.");
         }
     }
+    // Components whose MD5 hash matches the installed component are skipped,
+    // unless the user asks for the update to be forced
+    if (image_loader_args.args.has_key("force")) {
+        for (auto& comp : all_component_files) {
+            comp.metadata["force"] = "True";
+        }
+    }
     // Call RPC to update the component
     UHD_LOG_INFO("MPMD IMAGE LOADER", "Starting update. This may take a while.");
     tree->access<uhd::usrp::component_files_t>("/mboards/0/components/fpga")
@@ -19,7 +19,6 @@
 #include <boost/asio.hpp>
 #include <boost/make_shared.hpp>
 #include <boost/thread.hpp>
-#include <future>
 #include <memory>
 #include <mutex>
 #include <random>
@@ -38,7 +37,7 @@ const size_t MPMD_CROSSBAR_MAX_LADDR = 255;
 //! Most pessimistic time for a CHDR query to go to device and back
 const double MPMD_CHDR_MAX_RTT = 0.02;
 //! MPM Compatibility number
-const std::vector<size_t> MPM_COMPAT_NUM = {1, 2};
+const std::vector<size_t> MPM_COMPAT_NUM = {1, 3};
 
 /*************************************************************************
  * Helper functions
@@ -147,6 +146,7 @@ const size_t mpmd_impl::MPM_DISCOVERY_PORT              = 49600;
 const std::string mpmd_impl::MPM_DISCOVERY_PORT_KEY     = "discovery_port";
 const size_t mpmd_impl::MPM_RPC_PORT                    = 49601;
 const std::string mpmd_impl::MPM_RPC_PORT_KEY           = "rpc_port";
+const std::string mpmd_impl::MPM_KEEP_XPORTS_KEY        = "keep_xports";
 const std::string mpmd_impl::MPM_RPC_GET_LAST_ERROR_CMD = "get_last_error";
 const std::string mpmd_impl::MPM_DISCOVERY_CMD          = "MPM-DISC";
 const std::string mpmd_impl::MPM_ECHO_CMD               = "MPM-ECHO";
@@ -159,21 +159,30 @@ mpmd_impl::mpmd_impl(const device_addr_t& device_args)
 {
     const device_addrs_t mb_args = separate_device_addr(device_args);
     const size_t num_mboards     = mb_args.size();
-    _mb.reserve(num_mboards);
-    const bool serialize_init = device_args.has_key("serialize_init");
-    const bool skip_init      = device_args.has_key("skip_init");
+    const bool serialize_init    = device_args.has_key("serialize_init");
+    const bool skip_init         = device_args.has_key("skip_init");
     UHD_LOGGER_INFO("MPMD") << "Initializing " << num_mboards << " device(s) "
                             << (serialize_init ? "serially " : "in parallel ")
                             << "with args: " << device_args.to_string();
+    // Mboards which keep their streamer links also recycle them, see
+    // mpmd_mboard_impl::make_transport()
+    for (const auto& this_mb_args : mb_args) {
+        if (this_mb_args.has_key(MPM_KEEP_XPORTS_KEY)) {
+            _pool_streamer_xports = false;
+        }
+    }
+
+    // All phases that set up the mboards can run in parallel. Each phase
+    // depends on the previous one having finished for all mboards.
+    uhd::staged_init init("MPMD", serialize_init);
 
     // First, claim all the devices (so we own them and no one else can claim
     // them).
-    // This can be parallelized as long as uptrs are stored in the right spot;
-    // they need to be correctly indexed.
-    for (size_t mb_i = 0; mb_i < num_mboards; ++mb_i) {
+    _mb.resize(num_mboards);
+    init.run("claim", num_mboards, [this, &mb_args](const size_t mb_i) {
         UHD_LOG_DEBUG("MPMD", "Claiming mboard " << mb_i);
-        _mb.push_back(claim_and_make(mb_args[mb_i]));
-    }
+        _mb[mb_i] = claim_and_make(mb_args[mb_i]);
+    });
 
     // Next figure out the number of base xport addresses. This way, we
     // can run _mb[*]->init() in parallel on all the _mb.
@@ -184,12 +193,12 @@ mpmd_impl::mpmd_impl(const device_addr_t& device_args)
     }
 
     if (not skip_init) {
-        // Run the actual device initialization. This can run in parallel.
-        for (size_t mb_i = 0; mb_i < num_mboards; ++mb_i) {
-            // Note: This is the only place we do compat number checks. They're
-            // effectively disabled for skip_init=1
+        // Run the actual device initialization.
+        // Note: This is the only place we do compat number checks. They're
+        // effectively disabled for skip_init=1
+        init.run("setup_mb", num_mboards, [this, &base_xport_addr](const size_t mb_i) {
             setup_mb(_mb[mb_i].get(), mb_i, base_xport_addr[mb_i]);
-        }
+        });
     } else {
         UHD_LOG_DEBUG("MPMD", "Claimed device, but skipped init.");
     }
@@ -205,11 +214,11 @@ mpmd_impl::mpmd_impl(const device_addr_t& device_args)
     }
 
     if (not skip_init) {
-        // This can be parallelized, because the blocks of individual mboards
+        // This is parallelized, because the blocks of individual mboards
         // live on different subtrees.
-        for (size_t mb_i = 0; mb_i < mb_args.size(); ++mb_i) {
+        init.run("setup_rfnoc_blocks", num_mboards, [this, &mb_args](const size_t mb_i) {
             setup_rfnoc_blocks(_mb[mb_i].get(), mb_i, mb_args[mb_i]);
-        }
+        });
 
         // FIXME this section only makes sense for when the time source is external.
         // So, check for that, or something similar.
@@ -223,7 +232,8 @@ mpmd_impl::mpmd_impl(const device_addr_t& device_args)
         // Blocks will finalize their own setup in this function. They have
         // (and might need) full access to the prop tree, the timekeepers, etc.
         // This is already internally parallelized.
-        setup_rpc_blocks(filtered_block_args, serialize_init);
+        setup_rpc_blocks(filtered_block_args, init);
+        init.log_report();
     } else {
         UHD_LOG_INFO("MPMD", "Claimed device without full initialization.");
     }
@@ -231,6 +241,7 @@ mpmd_impl::mpmd_impl(const device_addr_t& device_args)
 
 mpmd_impl::~mpmd_impl()
 {
+    release_idle_transports();
     _rfnoc_block_ctrl.clear();
     _tree.reset();
     _mb.clear();
@@ -279,14 +290,26 @@ void mpmd_impl::setup_rfnoc_blocks(mpmd_mboard_impl* mb,
     for (size_t xbar_index = 0; xbar_index < mb->num_xbars; xbar_index++) {
         // Pull the number of blocks and base port from the args, if available.
         // Otherwise, get the values from MPM.
+        // If both values come from MPM, both queries are in flight at once.
+        const bool query_num_blocks = not ctrl_xport_args.has_key("rfnoc_num_blocks");
+        const bool query_base_port  = not ctrl_xport_args.has_key("rfnoc_base_port");
+        std::vector<std::string> queries;
+        if (query_num_blocks) {
+            queries.push_back("get_num_blocks");
+        }
+        if (query_base_port) {
+            queries.push_back("get_base_port");
+        }
+        std::vector<uhd::rpc_client::future<size_t>> replies;
+        for (const auto& query : queries) {
+            replies.push_back(mb->rpc->async_request<size_t>(query, xbar_index));
+        }
         const size_t num_blocks =
-            ctrl_xport_args.has_key("rfnoc_num_blocks")
-                ? ctrl_xport_args.cast<size_t>("rfnoc_num_blocks", 0)
-                : mb->rpc->request<size_t>("get_num_blocks", xbar_index);
+            query_num_blocks ? replies.front().get()
+                             : ctrl_xport_args.cast<size_t>("rfnoc_num_blocks", 0);
         const size_t base_port =
-            ctrl_xport_args.has_key("rfnoc_base_port")
-                ? ctrl_xport_args.cast<size_t>("rfnoc_base_port", 0)
-                : mb->rpc->request<size_t>("get_base_port", xbar_index);
+            query_base_port ? replies.back().get()
+                            : ctrl_xport_args.cast<size_t>("rfnoc_base_port", 0);
         const size_t local_addr = mb->get_xbar_local_addr(xbar_index);
         UHD_LOGGER_TRACE("MPMD")
             << "Enumerating RFNoC blocks for xbar " << xbar_index
@@ -317,43 +340,40 @@ void mpmd_impl::setup_rfnoc_blocks(mpmd_mboard_impl* mb,
 }
 
 void mpmd_impl::setup_rpc_blocks(
-    const device_addr_t& block_args, const bool serialize_init)
+    const device_addr_t& block_args, uhd::staged_init& init)
 {
-    std::vector<std::future<void>> task_list;
-    // If we don't force async, most compilers, at least now, will default to
-    // deferred.
-    const auto launch_policy = serialize_init ? std::launch::deferred
-                                              : std::launch::async;
-
-    // Preload all the tasks (they might start running on emplace_back)
+    std::vector<uhd::rfnoc::block_id_t> rpc_block_ids;
     for (const auto& block_ctrl : _rfnoc_block_ctrl) {
         auto rpc_block_id = block_ctrl->get_block_id();
         if (has_block<uhd::rfnoc::rpc_block_ctrl>(rpc_block_id)) {
-            const size_t mboard_idx = rpc_block_id.get_device_no();
-            auto rpc_block_ctrl =
-                get_block_ctrl<uhd::rfnoc::rpc_block_ctrl>(rpc_block_id);
-            auto rpc_sptr = _mb[mboard_idx]->rpc;
-            task_list.emplace_back(std::async(
-                launch_policy, [rpc_block_id, rpc_block_ctrl, &block_args, rpc_sptr]() {
-                    UHD_LOGGER_DEBUG("MPMD")
-                        << "Adding RPC access to block: " << rpc_block_id
-                        << " Block args: " << block_args.to_string();
-                    rpc_block_ctrl->set_rpc_client(rpc_sptr, block_args);
-                }));
+            rpc_block_ids.push_back(rpc_block_id);
         }
     }
 
     // Execute all the calls to set_rpc_client(), either concurrently, or
     // serially
-    for (auto& task : task_list) {
-        task.get();
-    }
+    init.run("setup_rpc_blocks",
+        rpc_block_ids.size(),
+        [this, &rpc_block_ids, &block_args](const size_t block_idx) {
+            const auto& rpc_block_id = rpc_block_ids[block_idx];
+            const size_t mboard_idx  = rpc_block_id.get_device_no();
+            auto rpc_block_ctrl =
+                get_block_ctrl<uhd::rfnoc::rpc_block_ctrl>(rpc_block_id);
+            UHD_LOGGER_DEBUG("MPMD") << "Adding RPC access to block: " << rpc_block_id
+                                     << " Block args: " << block_args.to_string();
+            rpc_block_ctrl->set_rpc_client(_mb[mboard_idx]->rpc, block_args);
+        });
 }
 
 size_t mpmd_impl::get_mtu(const size_t mb_index, const uhd::direction_t dir) {
     return _mb[mb_index]->get_mtu(dir);
 }
 
+double mpmd_impl::get_link_rate(const size_t mb_index)
+{
+    return _mb[mb_index]->get_link_rate();
+}
+
 /*****************************************************************************
  * Factory & Registry
  ****************************************************************************/
@@ -16,9 +16,12 @@
 #include <uhd/types/dict.hpp>
 #include <uhd/utils/tasks.hpp>
 #include <uhdlib/utils/rpc.hpp>
+#include <uhdlib/utils/staged_init.hpp>
 #include <boost/optional.hpp>
+#include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 
 /*************************************************************************
  * RPC timeout constants for MPMD
@@ -126,6 +129,10 @@ public:
 
     size_t get_mtu(const uhd::direction_t dir) const;
 
+    //! Return the rate of the links to this motherboard in bytes per second,
+    // or 0 if it's unknown
+    double get_link_rate() const;
+
 
     uhd::device_addr_t get_rx_hints() const;
     uhd::device_addr_t get_tx_hints() const;
@@ -147,6 +154,13 @@ public:
         _allow_claim_failure_flag = allow;
     }
 
+    /*! Return the health metrics MPM reported along with its most recent log
+     * records.
+     *
+     * Empty if logs have not been read yet, or if MPM can't report health.
+     */
+    uhd::device_addr_t get_mpm_health() const;
+
 private:
     /*! Reference to the RPC client that handles claiming
      */
@@ -169,8 +183,33 @@ private:
 
     uhd::task::sptr claim_device_and_make_task();
 
+    /*! Ask MPM for a link to \p sid and open the host side of it
+     *
+     * \param xport_info_out The chosen link, to be passed to commit_xport()
+     */
+    uhd::both_xports_t request_xport(const sid_t& sid,
+        usrp::device3_impl::xport_type_t xport_type,
+        const std::string& xport_type_str,
+        const uhd::device_addr_t& xport_args,
+        xport::mpmd_xport_mgr::xport_info_t& xport_info_out);
+
+    //! Have MPM route the device side of a link to its host side
+    void commit_xport(const xport::mpmd_xport_mgr::xport_info_t& xport_info);
+
+    /*! Return a kept link to \p sid, or negotiate and keep a new one
+     *
+     * Only used if the keep_xports device arg is given.
+     */
+    uhd::both_xports_t get_kept_transport(const sid_t& sid,
+        usrp::device3_impl::xport_type_t xport_type,
+        const std::string& xport_type_str,
+        const uhd::device_addr_t& xport_args);
+
     /*! Read out the log buffer from the MPM device and send it to native
      * logging system.
+     *
+     * Only records that were not read before are transferred. Falls back to
+     * draining the entire log buffer if MPM does not support log streaming.
      */
     void dump_logs(const bool dump_to_null = false);
 
@@ -189,6 +228,25 @@ private:
     uhd::device_addr_t send_args;
     uhd::device_addr_t recv_args;
 
+    //! A streamer link which outlives its streamer, see get_kept_transport()
+    struct kept_link_t
+    {
+        sid_t sid;
+        usrp::device3_impl::xport_type_t xport_type;
+        std::string args;
+        xport::mpmd_xport_mgr::xport_info_t xport_info;
+        uhd::both_xports_t xports;
+        //! True if MPM currently routes this SID to this link
+        bool committed;
+
+        //! True if no streamer uses this link
+        bool is_idle() const;
+    };
+
+    //! True if streamer links are kept (keep_xports device arg)
+    bool _keep_links = false;
+    std::list<kept_link_t> _kept_links;
+
     /*! This flag is only used within the claim() function. Go look there if you
      * really need to know what it does.
      */
@@ -199,6 +257,16 @@ private:
      */
     std::atomic<bool> _allow_claim_failure_latch{false};
 
+    //! How logs are read back from MPM
+    enum class log_mode_t { UNKNOWN, STREAM, BUFFER };
+
+    //! Protects the log stream state below
+    mutable std::mutex _log_mutex;
+    log_mode_t _log_mode = log_mode_t::UNKNOWN;
+    //! Cursor into the MPM log stream (sequence number of the next record)
+    uint64_t _log_cursor = 0;
+    //! Most recent health metrics reported by MPM
+    uhd::device_addr_t _mpm_health;
 };
 
 
@@ -224,6 +292,9 @@ public:
     static const size_t MPM_RPC_PORT;
     //! Device arg key to override the RPC port
     static const std::string MPM_RPC_PORT_KEY;
+    //! Device arg key to keep streamer links to MPM after their streamers
+    // are gone
+    static const std::string MPM_KEEP_XPORTS_KEY;
     //! This is the command that needs to be sent to the discovery port to
     // trigger a response.
     static const std::string MPM_DISCOVERY_CMD;
@@ -249,6 +320,8 @@ public:
     //! get mtu
     size_t get_mtu(const size_t, const uhd::direction_t);
 
+    double get_link_rate(const size_t mb_index);
+
 private:
     uhd::device_addr_t get_rx_hints(size_t mb_index);
     uhd::device_addr_t get_tx_hints(size_t mb_index);
@@ -280,8 +353,7 @@ private:
         mpmd_mboard_impl* mb, const size_t mb_i, const uhd::device_addr_t& block_args);
 
     //! Configure all blocks that require access to an RPC client
-    void setup_rpc_blocks(
-        const uhd::device_addr_t& block_args, const bool serialize_init);
+    void setup_rpc_blocks(const uhd::device_addr_t& block_args, uhd::staged_init& init);
 
     /*! Return the index of the motherboard given the local address of a
      * crossbar
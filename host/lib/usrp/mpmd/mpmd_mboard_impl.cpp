@@ -11,6 +11,7 @@
 #include <uhd/utils/safe_call.hpp>
 #include <chrono>
 #include <thread>
+#include <tuple>
 
 namespace {
 /*************************************************************************
@@ -26,6 +27,15 @@ const std::string MPMD_MEAS_LATENCY_KEY = "measure_rpc_latency";
 constexpr size_t MPMD_MEAS_LATENCY_DURATION = 1000;
 
 using log_buf_t = std::vector<std::map<std::string, std::string>>;
+//! One streamed log record: Index into the name table, log level, message
+using log_stream_record_t = std::tuple<size_t, int, std::string>;
+//! Reply of get_log_stream: Next cursor, number of dropped records, name
+// table, records, health metrics
+using log_stream_t = std::tuple<uint64_t,
+    uint64_t,
+    std::vector<std::string>,
+    std::vector<log_stream_record_t>,
+    std::map<std::string, std::string>>;
 
 
 /*************************************************************************
@@ -151,6 +161,43 @@ void forward_logs(log_buf_t&& log_buf)
     }
 }
 
+/*! Forward records from a log stream to UHD's native logging system.
+ *
+ * Levels are Python log levels (CRITICAL = 50, ..., DEBUG = 10, TRACE = 1).
+ */
+void forward_log_stream(const log_stream_t& log_stream)
+{
+    const auto& dropped = std::get<1>(log_stream);
+    const auto& names   = std::get<2>(log_stream);
+    if (dropped > 0) {
+        UHD_LOG_WARNING("MPMD", "MPM log buffer overflowed, " << dropped
+                                                              << " records were lost.");
+    }
+    for (const auto& log_record : std::get<3>(log_stream)) {
+        const size_t name_idx = std::get<0>(log_record);
+        if (name_idx >= names.size()) {
+            UHD_LOG_ERROR("MPMD", "Invalid logging structure returned from MPM device!");
+            continue;
+        }
+        const std::string& name    = names[name_idx];
+        const int level            = std::get<1>(log_record);
+        const std::string& message = std::get<2>(log_record);
+        if (level >= 50) {
+            UHD_LOG_FATAL(name, message);
+        } else if (level >= 40) {
+            UHD_LOG_ERROR(name, message);
+        } else if (level >= 30) {
+            UHD_LOG_WARNING(name, message);
+        } else if (level >= 20) {
+            UHD_LOG_INFO(name, message);
+        } else if (level >= 10) {
+            UHD_LOG_DEBUG(name, message);
+        } else {
+            UHD_LOG_TRACE(name, message);
+        }
+    }
+}
+
 /*! Return a new rpc_client with given addr and mb args
  */
 uhd::rpc_client::sptr make_mpm_rpc_client(const std::string& rpc_server_addr,
@@ -268,18 +315,23 @@ mpmd_mboard_impl::mpmd_mboard_impl(
                              << " number of crossbars: " << num_xbars;
 
     _claimer_task = claim_device_and_make_task();
+    _keep_links   = mb_args_.has_key(mpmd_impl::MPM_KEEP_XPORTS_KEY);
     if (mb_args_.has_key(MPMD_MEAS_LATENCY_KEY)) {
         measure_rpc_latency(rpc, MPMD_MEAS_LATENCY_DURATION);
     }
 
+    // Device and dboard info are independent, so send both requests before
+    // waiting on either of them.
+    auto device_info_future  = rpc->async_request<dev_info>("get_device_info");
+    auto dboards_info_future = rpc->async_request<std::vector<dev_info>>("get_dboard_info");
     /// Get device info
-    const auto device_info_dict = rpc->request<dev_info>("get_device_info");
+    const auto device_info_dict = device_info_future.get();
     for (const auto& info_pair : device_info_dict) {
         device_info[info_pair.first] = info_pair.second;
     }
     UHD_LOGGER_TRACE("MPMD") << "MPM reports device info: " << device_info.to_string();
     /// Get dboard info
-    const auto dboards_info = rpc->request<std::vector<dev_info>>("get_dboard_info");
+    const auto dboards_info = dboards_info_future.get();
     UHD_ASSERT_THROW(this->dboard_info.size() == 0);
     for (const auto& dboard_info_dict : dboards_info) {
         uhd::device_addr_t this_db_info;
@@ -304,7 +356,8 @@ mpmd_mboard_impl::~mpmd_mboard_impl()
 {
     // Destroy the claimer task to avoid spurious asynchronous reclaim call
     // after the unclaim.
-    UHD_SAFE_CALL(dump_logs(); _claimer_task.reset(); _xport_mgr.reset();
+    UHD_SAFE_CALL(dump_logs(); _claimer_task.reset(); _kept_links.clear();
+                  _xport_mgr.reset();
                   if (not rpc->request_with_token<bool>("unclaim")) {
                       UHD_LOG_WARNING("MPMD", "Failure to ack unclaim!");
                   });
@@ -353,6 +406,45 @@ uhd::both_xports_t mpmd_mboard_impl::make_transport(const sid_t& sid,
     UHD_LOGGER_TRACE("MPMD") << __func__
                              << "(): Creating new transport of type: " << xport_type_str;
 
+    if (_keep_links and xport_type != mpmd_impl::CTRL) {
+        return get_kept_transport(sid, xport_type, xport_type_str, xport_args);
+    }
+    xport::mpmd_xport_mgr::xport_info_t xport_info_out;
+    auto xports =
+        request_xport(sid, xport_type, xport_type_str, xport_args, xport_info_out);
+    commit_xport(xport_info_out);
+    return xports;
+}
+
+size_t mpmd_mboard_impl::get_mtu(const uhd::direction_t dir) const
+{
+    return _xport_mgr->get_mtu(dir);
+}
+
+double mpmd_mboard_impl::get_link_rate() const
+{
+    return _xport_mgr->get_link_rate();
+}
+
+uhd::device_addr_t mpmd_mboard_impl::get_rx_hints() const
+{
+    return recv_args;
+}
+
+uhd::device_addr_t mpmd_mboard_impl::get_tx_hints() const
+{
+    return send_args;
+}
+
+/*****************************************************************************
+ * Private methods
+ ****************************************************************************/
+uhd::both_xports_t mpmd_mboard_impl::request_xport(const sid_t& sid,
+    usrp::device3_impl::xport_type_t xport_type,
+    const std::string& xport_type_str,
+    const uhd::device_addr_t& xport_args,
+    xport::mpmd_xport_mgr::xport_info_t& xport_info_out)
+{
     using namespace uhd::mpmd::xport;
     const auto xport_info_list =
         rpc->request_with_token<mpmd_xport_mgr::xport_info_list_t>(
@@ -364,36 +456,85 @@ uhd::both_xports_t mpmd_mboard_impl::make_transport(const sid_t& sid,
         throw uhd::runtime_error("No viable transport path found!");
     }
 
-    xport::mpmd_xport_mgr::xport_info_t xport_info_out;
-    auto xports = _xport_mgr->make_transport(
+    return _xport_mgr->make_transport(
         xport_info_list, xport_type, xport_args, xport_info_out);
+}
 
-    if (not rpc->request_with_token<bool>("commit_xport", xport_info_out)) {
+void mpmd_mboard_impl::commit_xport(const xport::mpmd_xport_mgr::xport_info_t& xport_info)
+{
+    if (not rpc->request_with_token<bool>("commit_xport", xport_info)) {
         UHD_LOG_ERROR("MPMD", "Failed to create UDP transport!");
         throw uhd::runtime_error("commit_xport() failed!");
     }
-
-    return xports;
 }
 
-size_t mpmd_mboard_impl::get_mtu(const uhd::direction_t dir) const
+bool mpmd_mboard_impl::kept_link_t::is_idle() const
 {
-    return _xport_mgr->get_mtu(dir);
+    // We hold one reference, or two if both directions share a transport
+    const long num_refs = (xports.recv == xports.send) ? 2 : 1;
+    return (not xports.recv or xports.recv.use_count() == num_refs)
+           and (not xports.send or xports.send.use_count() == num_refs);
 }
 
-uhd::device_addr_t mpmd_mboard_impl::get_rx_hints() const
+uhd::both_xports_t mpmd_mboard_impl::get_kept_transport(const sid_t& sid,
+    usrp::device3_impl::xport_type_t xport_type,
+    const std::string& xport_type_str,
+    const uhd::device_addr_t& xport_args)
 {
-    return recv_args;
-}
+    // MPM routes a SID to one link at a time. Committing a link takes that
+    // route away from all other links kept for the same SID.
+    auto route_to = [this, &sid, xport_type](kept_link_t& link) {
+        commit_xport(link.xport_info);
+        for (auto& other : _kept_links) {
+            if (other.sid == sid and other.xport_type == xport_type) {
+                other.committed = false;
+            }
+        }
+        link.committed = true;
+    };
 
-uhd::device_addr_t mpmd_mboard_impl::get_tx_hints() const
-{
-    return send_args;
+    const std::string args_str = xport_args.to_string();
+    for (auto& link : _kept_links) {
+        if (not(link.sid == sid) or link.xport_type != xport_type
+            or link.args != args_str or not link.is_idle()) {
+            continue;
+        }
+        // If MPM still routes to this link, rebinding needs no RPC at all.
+        // Otherwise, its socket is still open and only the route is updated.
+        if (not link.committed) {
+            route_to(link);
+        }
+        // Drop what the device sent after the last streamer was gone
+        while (link.xports.recv and link.xports.recv->get_recv_buff(0.0)) {
+        }
+        UHD_LOGGER_DEBUG("MPMD") << "Rebinding " << xport_type_str << " streamer to "
+                                 << sid.to_pp_string_hex() << " (" << args_str << ")";
+        return link.xports;
+    }
+
+    kept_link_t link;
+    link.sid        = sid;
+    link.xport_type = xport_type;
+    link.args       = args_str;
+    link.committed  = false;
+    try {
+        link.xports =
+            request_xport(sid, xport_type, xport_type_str, xport_args, link.xport_info);
+    } catch (const uhd::exception&) {
+        // Idle links may hold the resources this one needs
+        const size_t num_kept = _kept_links.size();
+        _kept_links.remove_if([](const kept_link_t& kept) { return kept.is_idle(); });
+        if (_kept_links.size() == num_kept) {
+            throw;
+        }
+        link.xports =
+            request_xport(sid, xport_type, xport_type_str, xport_args, link.xport_info);
+    }
+    _kept_links.push_back(link);
+    route_to(_kept_links.back());
+    return _kept_links.back().xports;
 }
 
-/*****************************************************************************
- * Private methods
- ****************************************************************************/
 bool mpmd_mboard_impl::claim()
 {
     try {
@@ -430,6 +571,9 @@ uhd::task::sptr mpmd_mboard_impl::claim_device_and_make_task()
     // Save token for both RPC clients
     _claim_rpc->set_token(rpc_token);
     rpc->set_token(rpc_token);
+    // The claim RPC can block for up to the RPC timeout, which is longer than
+    // the claim lasts on the device. It gets a thread of its own, so it can't
+    // hold up the reclaims of other devices on the housekeeping threads.
     return uhd::task::make([this] {
         auto now = std::chrono::steady_clock::now();
         if (not this->claim()) {
@@ -443,13 +587,41 @@ uhd::task::sptr mpmd_mboard_impl::claim_device_and_make_task()
         }
         std::this_thread::sleep_until(
             now + std::chrono::milliseconds(MPMD_RECLAIM_INTERVAL_MS));
-    });
+    }, "mpmd_claimer");
 }
 
 void mpmd_mboard_impl::dump_logs(const bool dump_to_null)
 {
     // We need to use _claim_rpc instead of rpc because this currently only
     // gets called in the claimer loop.
+    std::lock_guard<std::mutex> l(_log_mutex);
+    if (_log_mode != log_mode_t::BUFFER) {
+        log_stream_t log_stream;
+        try {
+            log_stream = _claim_rpc->request_with_token<log_stream_t>(
+                "get_log_stream", _log_cursor);
+        } catch (const uhd::runtime_error&) {
+            // Older versions of MPM can't stream logs. Only fall back if the
+            // very first call fails, anything later is a real error.
+            if (_log_mode == log_mode_t::STREAM) {
+                throw;
+            }
+            UHD_LOG_DEBUG("MPMD", "MPM can't stream logs, reading log buffer instead.");
+            _log_mode = log_mode_t::BUFFER;
+        }
+        if (_log_mode != log_mode_t::BUFFER) {
+            _log_mode   = log_mode_t::STREAM;
+            _log_cursor = std::get<0>(log_stream);
+            _mpm_health = uhd::device_addr_t();
+            for (const auto& metric : std::get<4>(log_stream)) {
+                _mpm_health[metric.first] = metric.second;
+            }
+            if (not dump_to_null) {
+                forward_log_stream(log_stream);
+            }
+            return;
+        }
+    }
     if (dump_to_null) {
         _claim_rpc->request_with_token<log_buf_t>("get_log_buf");
     } else {
@@ -458,6 +630,12 @@ void mpmd_mboard_impl::dump_logs(const bool dump_to_null)
 }
 
 
+uhd::device_addr_t mpmd_mboard_impl::get_mpm_health() const
+{
+    std::lock_guard<std::mutex> l(_log_mutex);
+    return _mpm_health;
+}
+
 /*****************************************************************************
  * Factory
  ****************************************************************************/
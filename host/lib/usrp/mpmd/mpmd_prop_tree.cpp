@@ -13,12 +13,60 @@
 #include <uhd/types/eeprom.hpp>
 #include <uhd/types/sensors.hpp>
 #include <uhd/usrp/mboard_eeprom.hpp>
+#include <boost/algorithm/string/predicate.hpp>
+#include <algorithm>
+#include <map>
 
 using namespace uhd;
 using namespace uhd::mpmd;
 
 namespace {
 
+//! Size of the chunks in which component files are uploaded to MPM
+constexpr size_t MPMD_UPLOAD_CHUNK_SIZE = 1024 * 1024;
+//! First MPM compat number which supports chunked uploads
+const std::vector<size_t> MPM_UPLOAD_COMPAT_NUM = {1, 3};
+
+uhd::usrp::component_files_t _get_component_info(
+    const std::string& comp_name, mpmd_mboard_impl* mb);
+
+/*! Check if the device already has the given component file installed
+ *
+ * This compares the MD5 hash of the component file, if there is one, with the
+ * hash MPM reports for the installed component. Setting the "force" metadata
+ * to "True" makes this always return false.
+ */
+bool _is_component_installed(
+    const uhd::usrp::component_file_t& comp, mpmd_mboard_impl* mb)
+{
+    if (comp.metadata.get("force", "") == "True" or not comp.metadata.has_key("md5")) {
+        return false;
+    }
+    const auto installed_info =
+        _get_component_info(comp.metadata.get("id", ""), mb)[0].metadata;
+    return boost::iequals(installed_info.get("md5", ""), comp.metadata.get("md5"));
+}
+
+/*! Upload a component file in chunks, for a later call to update_component
+ */
+void _upload_component(const uhd::usrp::component_file_t& comp, mpmd_mboard_impl* mb)
+{
+    const std::string& filename = comp.metadata.get("filename");
+    size_t offset               = 0;
+    do {
+        const size_t chunk_size =
+            std::min(MPMD_UPLOAD_CHUNK_SIZE, comp.data.size() - offset);
+        const std::vector<uint8_t> chunk(comp.data.cbegin() + offset,
+            comp.data.cbegin() + offset + chunk_size);
+        mb->rpc->notify_with_token(MPMD_DEFAULT_INIT_TIMEOUT,
+            "upload_component_chunk",
+            filename,
+            offset,
+            chunk);
+        offset += chunk_size;
+    } while (offset < comp.data.size());
+}
+
 /*! Update a component using all required files. For example, when updating the FPGA image
  * (.bit or .bin), users can provide a new overlay image (DTS) to apply in addition.
  *
@@ -34,6 +82,11 @@ uhd::usrp::component_files_t _update_component(
     // Also construct a copy of just the metadata to store in the property tree
     uhd::usrp::component_files_t all_comps_copy;
 
+    // Older versions of MPM need the data with the update_component call
+    const bool upload_chunks =
+        mb->rpc->request<std::vector<size_t>>("get_mpm_compat_num")
+        >= MPM_UPLOAD_COMPAT_NUM;
+
     for (const auto& comp : comps) {
         // Make a map for update components args
         std::map<std::string, std::string> metadata;
@@ -44,16 +97,30 @@ uhd::usrp::component_files_t _update_component(
             metadata[key]           = comp.metadata[key];
             comp_copy.metadata[key] = comp.metadata[key];
         }
-        // Copy to the update component args
-        all_data.push_back(comp.data);
-        all_metadata.push_back(metadata);
         // Copy to the property tree
         all_comps_copy.push_back(comp_copy);
+        if (_is_component_installed(comp, mb)) {
+            UHD_LOG_INFO("MPMD",
+                "Component `" << metadata["id"]
+                              << "' is already installed, skipping update.");
+            continue;
+        }
+        // Copy to the update component args
+        if (upload_chunks) {
+            _upload_component(comp, mb);
+            metadata["uploaded"] = "True";
+            all_data.push_back({});
+        } else {
+            all_data.push_back(comp.data);
+        }
+        all_metadata.push_back(metadata);
     }
 
     // Now call update component
-    mb->rpc->notify_with_token(
-        MPMD_DEFAULT_INIT_TIMEOUT, "update_component", all_metadata, all_data);
+    if (not all_metadata.empty()) {
+        mb->rpc->notify_with_token(
+            MPMD_DEFAULT_INIT_TIMEOUT, "update_component", all_metadata, all_data);
+    }
     return all_comps_copy;
 }
 
@@ -97,6 +164,8 @@ void mpmd_impl::init_property_tree(
     tree->create<size_t>(mb_path / "link_max_rate").set(125000000);
     tree->create<std::string>(mb_path / "mpm_version")
         .set(mb->device_info.get("mpm_version", "UNKNOWN"));
+    tree->create<uhd::device_addr_t>(mb_path / "mpm_health")
+        .set_publisher([mb]() { return mb->get_mpm_health(); });
     tree->create<std::string>(mb_path / "fpga_version")
         .set(mb->device_info.get("fpga_version", "UNKNOWN"));
     tree->create<std::string>(mb_path / "fpga_version_hash")
@@ -148,6 +217,23 @@ void mpmd_impl::init_property_tree(
                 return sensor_value_t("", "", "");
             });
     }
+    // Reads all of the above in a single RPC call, see
+    // multi_usrp::get_mboard_sensors()
+    tree->create<std::map<std::string, sensor_value_t>>(mb_path / "sensor_values")
+        .set_publisher([mb, sensor_list]() {
+            const auto sensor_maps =
+                mb->rpc->request_server_batch_with_token<sensor_value_t::sensor_map_t>(
+                    MPMD_DEFAULT_INIT_TIMEOUT, "get_mb_sensor", sensor_list);
+            std::map<std::string, sensor_value_t> sensor_values;
+            for (size_t i = 0; i < sensor_list.size(); i++) {
+                sensor_values.emplace(sensor_list[i], sensor_value_t(sensor_maps[i]));
+            }
+            return sensor_values;
+        })
+        .set_coercer([](const std::map<std::string, sensor_value_t>&)
+                         -> std::map<std::string, sensor_value_t> {
+            throw uhd::runtime_error("Trying to write read-only sensor values!");
+        });
 
     /*** EEPROM *********************************************************/
     tree->create<uhd::usrp::mboard_eeprom_t>(mb_path / "eeprom")
@@ -9,6 +9,7 @@
 #include <uhd/transport/udp_zero_copy.hpp>
 #include <uhd/utils/byteswap.hpp>
 #include <uhd/rfnoc/constants.hpp>
+#include <uhdlib/utils/cpu_affinity.hpp>
 
 using namespace uhd;
 using namespace uhd::mpmd::xport;
@@ -40,7 +41,11 @@ mpmd_xport_ctrl_liberio::mpmd_xport_ctrl_liberio(const uhd::device_addr_t& mb_ar
     , _recv_args(filter_args(mb_args, "recv"))
     , _send_args(filter_args(mb_args, "send"))
 {
-    // nop
+    for (const char* key : {"dma_batch", "dma_poll"}) {
+        if (mb_args.has_key(key)) {
+            _data_hints[key] = mb_args[key];
+        }
+    }
 }
 
 
@@ -148,7 +153,8 @@ uhd::both_xports_t mpmd_xport_ctrl_liberio::make_transport(
             if (not _data_dma_xport) {
                 _data_dma_xport =
                     make_muxed_liberio_xport(tx_dev, rx_dev, default_buff_args,
-                        uhd::rfnoc::MAX_NUM_BLOCKS * uhd::rfnoc::MAX_NUM_PORTS);
+                        uhd::rfnoc::MAX_NUM_BLOCKS * uhd::rfnoc::MAX_NUM_PORTS,
+                        _data_hints);
             }
 
             UHD_LOGGER_TRACE("MPMD")
@@ -156,8 +162,8 @@ uhd::both_xports_t mpmd_xport_ctrl_liberio::make_transport(
             xports.recv = _data_dma_xport->make_stream(xports.recv_sid.get_dst());
         }
         else {
-            xports.recv =
-                transport::liberio_zero_copy::make(tx_dev, rx_dev, default_buff_args);
+            xports.recv = transport::liberio_zero_copy::make(
+                tx_dev, rx_dev, default_buff_args, _data_hints);
         }
     }
 
@@ -185,10 +191,15 @@ uhd::transport::muxed_zero_copy_if::sptr
 mpmd_xport_ctrl_liberio::make_muxed_liberio_xport(const std::string& tx_dev,
     const std::string& rx_dev,
     const uhd::transport::zero_copy_xport_params& buff_args,
-    const size_t max_muxed_ports)
+    const size_t max_muxed_ports,
+    const uhd::device_addr_t& hints)
 {
-    auto base_xport = transport::liberio_zero_copy::make(tx_dev, rx_dev, buff_args);
-
-    return uhd::transport::muxed_zero_copy_if::make(
-        base_xport, extract_sid_from_pkt, max_muxed_ports);
+    auto base_xport =
+        transport::liberio_zero_copy::make(tx_dev, rx_dev, buff_args, hints);
+
+    return uhd::transport::muxed_zero_copy_if::make(base_xport,
+        extract_sid_from_pkt,
+        max_muxed_ports,
+        _mb_args.has_key("inline_demux"),
+        uhd::parse_cpu_list(_mb_args.get("demux_cpu", "")));
 }
@@ -37,9 +37,12 @@ private:
         const std::string& tx_dev,
         const std::string& rx_dev,
         const uhd::transport::zero_copy_xport_params& buff_args,
-        const size_t max_muxed_ports);
+        const size_t max_muxed_ports,
+        const uhd::device_addr_t& hints = uhd::device_addr_t());
 
     const uhd::device_addr_t _mb_args;
+    //! DMA batching and polling hints for the data transports
+    uhd::device_addr_t _data_hints;
     const uhd::dict<std::string, std::string> _recv_args;
     const uhd::dict<std::string, std::string> _send_args;
 
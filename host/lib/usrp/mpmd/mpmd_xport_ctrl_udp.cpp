@@ -11,6 +11,10 @@
 #include <uhd/transport/udp_constants.hpp>
 #include <uhd/transport/udp_simple.hpp>
 #include <uhd/transport/udp_zero_copy.hpp>
+#include <uhdlib/transport/udp_hints.hpp>
+#ifdef HAVE_XDP
+#    include <uhdlib/transport/xdp_zero_copy.hpp>
+#endif
 
 
 using namespace uhd;
@@ -36,6 +40,9 @@ const size_t MPMD_UDP_10GE_DEFAULT_SEND_FRAME_SIZE = 4000;
 //! Default 10GbE receive frame size
 const size_t MPMD_UDP_10GE_DEFAULT_RECV_FRAME_SIZE = 4000;
 
+//! Minimum number of UMEM frames per direction for AF_XDP transports
+const size_t MPMD_XDP_NUM_FRAMES = 64;
+
 //!
 const double MPMD_BUFFER_DEPTH = 50.0e-3; // s
 //! For MTU discovery, the time we wait for a packet before calling it
@@ -230,21 +237,47 @@ uhd::both_xports_t mpmd_xport_ctrl_udp::make_transport(
             xport_args.cast<size_t>("recv_buff_size",
             default_buff_args.recv_buff_size);
     }
+    // Create both_xports_t object and finish:
+    both_xports_t xports;
+    xports.endianness = uhd::ENDIANNESS_BIG;
+    xports.send_sid   = sid_t(xport_info["send_sid"]);
+    xports.recv_sid   = xports.send_sid.reversed();
+
+#ifdef HAVE_XDP
+    if (_mb_args.has_key("use_xdp")) {
+        // There are no socket buffers, all buffering happens in UMEM frames
+        if (xport_type != usrp::device3_impl::TX_DATA) {
+            default_buff_args.num_recv_frames =
+                std::max(default_buff_args.num_recv_frames, MPMD_XDP_NUM_FRAMES);
+        }
+        default_buff_args.num_send_frames =
+            std::max(default_buff_args.num_send_frames, MPMD_XDP_NUM_FRAMES);
+        auto recv = transport::xdp_zero_copy::make(
+            xport_info["ipv4"], xport_info["port"], default_buff_args, _mb_args);
+        xport_info["src_port"] = std::to_string(recv->get_local_port());
+        xport_info["src_ipv4"] = recv->get_local_addr();
+        xports.recv_buff_size =
+            recv->get_recv_frame_size() * recv->get_num_recv_frames();
+        xports.send_buff_size =
+            recv->get_send_frame_size() * recv->get_num_send_frames();
+        xports.recv = recv; // Note: This is a type cast!
+        xports.send = recv; // This too
+        return xports;
+    }
+#endif
+
     transport::udp_zero_copy::buff_params buff_params;
     auto recv                     = transport::udp_zero_copy::make(xport_info["ipv4"],
         xport_info["port"],
         default_buff_args,
-        buff_params);
+        buff_params,
+        transport::get_udp_xport_hints(
+            _mb_args, xport_args, xport_type == usrp::device3_impl::TX_DATA));
     const uint16_t port           = recv->get_local_port();
     const std::string src_ip_addr = recv->get_local_addr();
     xport_info["src_port"]        = std::to_string(port);
     xport_info["src_ipv4"]        = src_ip_addr;
 
-    // Create both_xports_t object and finish:
-    both_xports_t xports;
-    xports.endianness     = uhd::ENDIANNESS_BIG;
-    xports.send_sid       = sid_t(xport_info["send_sid"]);
-    xports.recv_sid       = xports.send_sid.reversed();
     xports.recv_buff_size = buff_params.recv_buff_size;
     xports.send_buff_size = buff_params.send_buff_size;
     xports.recv           = recv; // Note: This is a type cast!
@@ -14,6 +14,11 @@
 #ifdef HAVE_DPDK
 #    include "mpmd_xport_ctrl_dpdk_udp.hpp"
 #endif
+#include <uhdlib/usrp/common/link_load_balancer.hpp>
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <unordered_map>
 
 uhd::dict<std::string, std::string> uhd::mpmd::xport::filter_args(
     const uhd::device_addr_t& args, const std::string& prefix)
@@ -51,7 +56,7 @@ public:
         }
 
         // Run our incredibly smart selection algorithm
-        xport_info_out                 = select_xport_option(xport_info_list);
+        xport_info_out = select_xport_option(xport_info_list, xport_type);
         const std::string xport_medium = xport_info_out.at("type");
         UHD_LOG_TRACE("MPMD", __func__ << "(): xport medium is " << xport_medium);
 
@@ -59,8 +64,16 @@ public:
         UHD_ASSERT_THROW(_xport_ctrls.at(xport_medium));
         // When we've picked our preferred option, pass it to the transport
         // implementation for execution:
-        return _xport_ctrls.at(xport_medium)
-            ->make_transport(xport_info_out, xport_type, xport_args);
+        auto xports = _xport_ctrls.at(xport_medium)
+                          ->make_transport(xport_info_out, xport_type, xport_args);
+        if (xport_type == uhd::usrp::device3_impl::RX_DATA) {
+            _link_loads.add_xport(
+                get_link(xport_info_out), uhd::RX_DIRECTION, xports.recv);
+        } else if (xport_type == uhd::usrp::device3_impl::TX_DATA) {
+            _link_loads.add_xport(
+                get_link(xport_info_out), uhd::TX_DIRECTION, xports.send);
+        }
+        return xports;
     }
 
     size_t get_mtu(const uhd::direction_t dir) const
@@ -80,33 +93,85 @@ public:
         return mtu;
     }
 
+    double get_link_rate() const
+    {
+        return _all_link_speeds_known ? _link_rate : 0.0;
+    }
 
 private:
     /**************************************************************************
      * Private methods / helpers
      *************************************************************************/
     /*! Picks a transport option based on available data
+     *
+     * Control transports take the first valid option, i.e., the one MPM
+     * ranks highest. Data transports take the valid option whose link carries
+     * the fewest live data transports in their direction, relative to its
+     * link speed. MPM's ranking breaks ties. Unlike MPM's allocation count,
+     * this knows when streamers are gone.
      *
      * \param xport_info_list List of available options, they all need to be
      *                        valid choices.
+     * \param xport_type The kind of transport the option is for
      *
      * \returns One element of \p xport_info_list based on a selection
      *          algorithm.
      */
-    xport_info_t select_xport_option(const xport_info_list_t& xport_info_list) const
+    xport_info_t select_xport_option(const xport_info_list_t& xport_info_list,
+        const uhd::usrp::device3_impl::xport_type_t xport_type)
     {
-        for (const auto& xport_info : xport_info_list) {
+        std::vector<size_t> valid_options;
+        for (size_t i = 0; i < xport_info_list.size(); i++) {
+            const auto& xport_info         = xport_info_list[i];
             const std::string xport_medium = xport_info.at("type");
             if (_xport_ctrls.count(xport_medium) != 0 and _xport_ctrls.at(xport_medium)
                 and _xport_ctrls.at(xport_medium)->is_valid(xport_info)) {
-                return xport_info;
+                valid_options.push_back(i);
             }
         }
+        if (valid_options.empty()) {
+            throw uhd::runtime_error(
+                "Could not select a transport option! "
+                "Either a transport hint was not specified or the specified "
+                "hint does not support communication with RFNoC blocks.");
+        }
+        // Control transports are made first, so this also makes the links
+        // known to get_link_rate() before any streamer is
+        std::vector<size_t> links;
+        for (const size_t option : valid_options) {
+            links.push_back(get_link(xport_info_list[option]));
+        }
+        if (xport_type != uhd::usrp::device3_impl::RX_DATA
+            and xport_type != uhd::usrp::device3_impl::TX_DATA) {
+            return xport_info_list[valid_options.front()];
+        }
+        const uhd::direction_t dir = xport_type == uhd::usrp::device3_impl::RX_DATA
+                                         ? uhd::RX_DIRECTION
+                                         : uhd::TX_DIRECTION;
+        const size_t link = _link_loads.pick(dir, links);
+        return xport_info_list[valid_options[std::distance(
+            links.begin(), std::find(links.begin(), links.end(), link))]];
+    }
 
-        throw uhd::runtime_error(
-            "Could not select a transport option! "
-            "Either a transport hint was not specified or the specified "
-            "hint does not support communication with RFNoC blocks.");
+    //! Return the index of the link an option uses in _link_loads, adding
+    // the link if it's new
+    size_t get_link(const xport_info_t& xport_info)
+    {
+        const std::string link_name =
+            xport_info.at("type") + ":"
+            + (xport_info.count("ipv4") ? xport_info.at("ipv4") : std::string());
+        if (_link_indexes.count(link_name) == 0) {
+            // link_speed is in Mbit/s, links without one count as equally fast
+            const double link_rate =
+                xport_info.count("link_speed")
+                    ? std::stod(xport_info.at("link_speed")) * 1e6 / 8
+                    : 1.0;
+            _link_rate += link_rate;
+            _all_link_speeds_known =
+                _all_link_speeds_known and xport_info.count("link_speed");
+            _link_indexes[link_name] = _link_loads.add_link(link_rate);
+        }
+        return _link_indexes.at(link_name);
     }
 
     //! Create an instance of an xport manager implementation
@@ -165,6 +230,18 @@ private:
 
     //! Motherboard args, can contain things like 'recv_buff_size'
     const uhd::device_addr_t _mb_args;
+
+    //! Load of the links seen in transport options, see select_xport_option()
+    uhd::usrp::link_load_balancer _link_loads;
+
+    //! Index into _link_loads by medium and IP address, see get_link()
+    std::unordered_map<std::string, size_t> _link_indexes;
+
+    //! Sum of the rates of the links in _link_loads
+    double _link_rate = 0.0;
+
+    //! False once a link without a link_speed was seen
+    bool _all_link_speeds_known = true;
 };
 
 mpmd_xport_mgr::uptr mpmd_xport_mgr::make(const uhd::device_addr_t& mb_args)
@@ -98,6 +98,13 @@ public:
     /*! Return the path MTU for whatever this manager lets us do
      */
     virtual size_t get_mtu(const uhd::direction_t dir) const = 0;
+
+    /*! Return the summed rate of the links seen in transport options
+     *
+     * \returns the rate in bytes per second, or 0 if a link's speed is
+     *          unknown
+     */
+    virtual double get_link_rate() const = 0;
 };
 
 }}} /* namespace uhd::mpmd::xport */
@@ -20,6 +20,7 @@
 #include <uhd/utils/soft_register.hpp>
 #include <uhdlib/usrp/gpio_defs.hpp>
 #include <uhdlib/rfnoc/legacy_compat.hpp>
+#include <uhdlib/usrp/common/host_resampler.hpp>
 #include <boost/assign/list_of.hpp>
 #include <boost/format.hpp>
 #include <boost/algorithm/string.hpp>
@@ -27,6 +28,11 @@
 #include <cmath>
 #include <bitset>
 #include <chrono>
+#include <exception>
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
 #include <thread>
 
 using namespace uhd;
@@ -69,6 +75,40 @@ static void do_samp_rate_warning_message(
     }
 }
 
+/*!
+ * Call fn(mboard) for all motherboards at once, so their control transactions
+ * overlap. Once all calls are done, the first exception is rethrown.
+ */
+static void for_each_mboard_parallel(
+    const size_t num_mboards,
+    const std::function<void(size_t)> &fn
+){
+    if (num_mboards == 1){
+        fn(0);
+        return;
+    }
+    std::vector<std::future<void>> tasks;
+    for (size_t m = 0; m < num_mboards; m++){
+        tasks.emplace_back(std::async(std::launch::async, fn, m));
+    }
+    std::exception_ptr error;
+    for (auto &task : tasks){
+        try {
+            task.get();
+        } catch (...) {
+            if (not error) error = std::current_exception();
+        }
+    }
+    if (error) std::rethrow_exception(error);
+}
+
+//! Number of times set_time_unknown_pps() tries before it gives up
+static const size_t MAX_TIME_SYNC_ATTEMPTS = 2;
+//! Largest difference of the PPS times of two synchronized boards. Boards
+//! that took different edges are a whole PPS period apart, so this only
+//! covers the tick rounding of boards with different clock rates.
+static const double MAX_PPS_TIME_DEVIATION = 1e-3;
+
 /*static void do_tune_freq_results_message(
     const tune_request_t &tune_req,
     const tune_result_t &tune_result,
@@ -379,6 +419,38 @@ static double derive_freq_from_xx_subdev_and_dsp(
     return actual_rf_freq - actual_dsp_freq * xx_sign;
 }
 
+/***********************************************************************
+ * Tune tables for frequency hopping
+ **********************************************************************/
+struct tune_table_t
+{
+    boost::shared_ptr<property<double> > rf_freq;
+    boost::shared_ptr<property<double> > dsp_freq;
+    std::vector<tune_request_t> requests;
+    std::vector<tune_result_t> hops;
+};
+
+static tune_result_t tune_to_hop(const tune_table_t &table, const size_t hop)
+{
+    if (hop >= table.hops.size()) {
+        throw uhd::index_error(str(
+            boost::format("Tune table has %u hops, can't tune to hop %u")
+            % table.hops.size() % hop));
+    }
+    const tune_request_t &tune_request = table.requests[hop];
+    const tune_result_t &tune_result = table.hops[hop];
+
+    // Only go through the frontend's tuning if the RF frequency changes
+    if (tune_request.rf_freq_policy != tune_request_t::POLICY_NONE
+        and table.rf_freq->get() != tune_result.actual_rf_freq) {
+        table.rf_freq->set(tune_result.target_rf_freq);
+    }
+    if (tune_request.dsp_freq_policy != tune_request_t::POLICY_NONE) {
+        table.dsp_freq->set(tune_result.target_dsp_freq);
+    }
+    return tune_result;
+}
+
 /***********************************************************************
  * Multi USRP Implementation
  **********************************************************************/
@@ -392,6 +464,17 @@ public:
         if (is_device3() and not addr.has_key("recover_mb_eeprom")) {
             _legacy_compat = rfnoc::legacy_compat::make(get_device3(), addr);
         }
+
+        // Time is polled often, so skip the tree lookups for it
+        for (size_t mboard = 0; mboard < get_num_mboards(); mboard++) {
+            const fs_path time_path = mb_root(mboard) / "time";
+            _time_now_props.push_back(_tree->exists(time_path / "now")
+                ? _tree->access_handle<time_spec_t>(time_path / "now")
+                : boost::shared_ptr<property<time_spec_t> >());
+            _time_pps_props.push_back(_tree->exists(time_path / "pps")
+                ? _tree->access_handle<time_spec_t>(time_path / "pps")
+                : boost::shared_ptr<property<time_spec_t> >());
+        }
     }
 
     device::sptr get_device(void){
@@ -586,10 +669,16 @@ public:
     }
 
     time_spec_t get_time_now(size_t mboard = 0){
+        if (mboard < _time_now_props.size() and _time_now_props[mboard]) {
+            return _time_now_props[mboard]->get();
+        }
         return _tree->access<time_spec_t>(mb_root(mboard) / "time/now").get();
     }
 
     time_spec_t get_time_last_pps(size_t mboard = 0){
+        if (mboard < _time_pps_props.size() and _time_pps_props[mboard]) {
+            return _time_pps_props[mboard]->get();
+        }
         return _tree->access<time_spec_t>(mb_root(mboard) / "time/pps").get();
     }
 
@@ -608,45 +697,62 @@ public:
             _tree->access<time_spec_t>(mb_root(mboard) / "time/pps").set(time_spec);
             return;
         }
-        for (size_t m = 0; m < get_num_mboards(); m++){
+        // Arm all boards at once, so they are done well within one PPS period
+        for_each_mboard_parallel(get_num_mboards(), [this, &time_spec](size_t m){
             set_time_next_pps(time_spec, m);
-        }
+        });
     }
 
     void set_time_unknown_pps(const time_spec_t &time_spec){
-        UHD_LOGGER_INFO("MULTI_USRP")
-            << "    1) catch time transition at pps edge";
-        auto end_time = std::chrono::steady_clock::now()
-                            + std::chrono::milliseconds(1100);
-        time_spec_t time_start_last_pps = get_time_last_pps();
-        while (time_start_last_pps == get_time_last_pps())
-        {
-            if (std::chrono::steady_clock::now() > end_time) {
+        for (size_t attempt = 1; ; attempt++){
+            UHD_LOGGER_INFO("MULTI_USRP")
+                << "    1) catch time transition at pps edge";
+            const time_spec_t time_last_pps = get_time_last_pps();
+            if (not _wait_for_pps_edge(time_last_pps)){
                 throw uhd::runtime_error(
                     "Board 0 may not be getting a PPS signal!\n"
                     "No PPS detected within the time interval.\n"
                     "See the application notes for your device.\n"
                 );
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
-        }
 
-        UHD_LOGGER_INFO("MULTI_USRP")
-            << "    2) set times next pps (synchronously)";
-        set_time_next_pps(time_spec, ALL_MBOARDS);
-        std::this_thread::sleep_for(std::chrono::seconds(1));
+            const time_spec_t time_edge_pps = get_time_last_pps();
 
-        //verify that the time registers are read to be within a few RTT
-        for (size_t m = 1; m < get_num_mboards(); m++){
-            time_spec_t time_0 = this->get_time_now(0);
-            time_spec_t time_i = this->get_time_now(m);
-            if (time_i < time_0 or (time_i - time_0) > time_spec_t(0.01)){ //10 ms: greater than RTT but not too big
+            UHD_LOGGER_INFO("MULTI_USRP")
+                << "    2) set times next pps (synchronously)";
+            set_time_next_pps(time_spec, ALL_MBOARDS);
+            if (not _wait_for_pps_edge(time_edge_pps)){
+                throw uhd::runtime_error(
+                    "Board 0 lost its PPS signal while setting the time!\n"
+                    "No PPS detected within the time interval.\n"
+                    "See the application notes for your device.\n"
+                );
+            }
+
+            // The time latched at the last PPS is the same on all boards if
+            // they took the same edge, so round trips need no slack
+            const size_t num_mboards = get_num_mboards();
+            std::vector<time_spec_t> pps_times(num_mboards);
+            for_each_mboard_parallel(num_mboards, [this, &pps_times](size_t m){
+                pps_times[m] = get_time_last_pps(m);
+            });
+            bool synchronized = true;
+            for (size_t m = 1; m < num_mboards; m++){
+                const time_spec_t deviation = pps_times[m] - pps_times[0];
+                if (std::abs(deviation.get_real_secs()) < MAX_PPS_TIME_DEVIATION){
+                    continue;
+                }
+                synchronized = false;
                 UHD_LOGGER_WARNING("MULTI_USRP") << boost::format(
                     "Detected time deviation between board %d and board 0.\n"
-                    "Board 0 time is %f seconds.\n"
-                    "Board %d time is %f seconds.\n"
-                ) % m % time_0.get_real_secs() % m % time_i.get_real_secs();
+                    "Board 0 time at the last PPS is %f seconds.\n"
+                    "Board %d time at the last PPS is %f seconds.\n"
+                ) % m % pps_times[0].get_real_secs() % m % pps_times[m].get_real_secs();
             }
+            if (synchronized or attempt == MAX_TIME_SYNC_ATTEMPTS){
+                return;
+            }
+            UHD_LOGGER_WARNING("MULTI_USRP") << "Retrying to synchronize the times";
         }
     }
 
@@ -965,6 +1071,11 @@ public:
         return {};
     }
 
+    std::map<std::string, sensor_value_t> get_mboard_sensors(
+        size_t mboard, double max_age){
+        return _get_sensors(mb_root(mboard) / "sensors", max_age);
+    }
+
     void set_user_register(const uint8_t addr, const uint32_t data, size_t mboard){
         if (mboard != ALL_MBOARDS){
             typedef std::pair<uint8_t, uint32_t> user_reg_t;
@@ -992,6 +1103,9 @@ public:
      * RX methods
      ******************************************************************/
     rx_streamer::sptr get_rx_stream(const stream_args_t &args) {
+        if (args.args.has_key("host_resample")) {
+            return get_resampling_rx_stream(args);
+        }
         _check_link_rate(args, false);
         if (is_device3()) {
             return _legacy_compat->get_rx_stream(args);
@@ -999,6 +1113,24 @@ public:
         return this->get_device()->get_rx_stream(args);
     }
 
+    //! Receive sc16 samples from the device, and resample them on the host
+    rx_streamer::sptr get_resampling_rx_stream(const stream_args_t &args_) {
+        stream_args_t args(args_);
+        const double output_rate = args.args.cast<double>("host_resample", 0.0);
+        args.args.pop("host_resample");
+        if (args.cpu_format != "fc32") {
+            throw uhd::value_error("host_resample requires the fc32 CPU format");
+        }
+        if (not (output_rate > 0)) {
+            throw uhd::value_error("host_resample requires an output rate");
+        }
+        const double fullscale = args.args.cast<double>("fullscale", 1.0);
+        args.cpu_format = "sc16";
+        const size_t chan = args.channels.empty() ? 0 : args.channels.front();
+        return make_resampling_rx_streamer(get_rx_stream(args),
+            get_rx_rate(chan), output_rate, float(fullscale / 32767.));
+    }
+
     void set_rx_subdev_spec(const subdev_spec_t &spec, size_t mboard){
         if (mboard != ALL_MBOARDS){
             _tree->access<subdev_spec_t>(mb_root(mboard) / "rx_subdev_spec").set(spec);
@@ -1074,7 +1206,25 @@ public:
     }
 
     tune_result_t set_rx_freq(const tune_request_t &tune_request, size_t chan){
+        warn_on_external_rx_lo(tune_request, chan);
+        return tune_rx_chan(tune_request, chan);
+    }
 
+    std::vector<tune_result_t> set_rx_freq(
+        const tune_request_t &tune_request, const std::vector<size_t> &chans
+    ){
+        std::vector<tune_result_t> results(chans.size());
+        if (chans.empty()) {
+            return results;
+        }
+        warn_on_external_rx_lo(tune_request, chans.front());
+        for_each_chan_by_mboard(chans, true, [&](const size_t i){
+            results[i] = tune_rx_chan(tune_request, chans[i]);
+        });
+        return results;
+    }
+
+    void warn_on_external_rx_lo(const tune_request_t &tune_request, size_t chan){
         // If any mixer is driven by an external LO the daughterboard assumes that no CORDIC correction is
         // necessary. Since the LO might be sourced from another daughterboard which would normally apply a
         // cordic correction a manual DSP tune policy should be used to ensure identical configurations across
@@ -1094,7 +1244,9 @@ public:
                 }
             }
         }
+    }
 
+    tune_result_t tune_rx_chan(const tune_request_t &tune_request, size_t chan){
         tune_result_t result = tune_xx_subdev_and_dsp(RX_SIGN,
                 _tree->subtree(rx_dsp_root(chan)),
                 _tree->subtree(rx_rf_fe_root(chan)),
@@ -1107,6 +1259,28 @@ public:
         return derive_freq_from_xx_subdev_and_dsp(RX_SIGN, _tree->subtree(rx_dsp_root(chan)), _tree->subtree(rx_rf_fe_root(chan)));
     }
 
+    std::vector<tune_result_t> set_rx_tune_table(
+        const std::vector<tune_request_t> &tune_requests, size_t chan
+    ){
+        tune_table_t table;
+        table.rf_freq = _tree->access_handle<double>(rx_rf_fe_root(chan) / "freq" / "value");
+        table.dsp_freq = _tree->access_handle<double>(rx_dsp_root(chan) / "freq" / "value");
+        table.requests = tune_requests;
+        for (const tune_request_t &tune_request : tune_requests) {
+            table.hops.push_back(set_rx_freq(tune_request, chan));
+        }
+        _rx_tune_tables[chan] = table;
+        return table.hops;
+    }
+
+    tune_result_t set_rx_freq_hop(size_t hop, size_t chan){
+        if (not _rx_tune_tables.count(chan)) {
+            throw uhd::index_error(str(
+                boost::format("No RX tune table was set for channel %u") % chan));
+        }
+        return tune_to_hop(_rx_tune_tables.at(chan), hop);
+    }
+
     freq_range_t get_rx_freq_range(size_t chan){
         return make_overall_tune_range(
             _tree->access<meta_range_t>(rx_rf_fe_root(chan) / "freq" / "range").get(),
@@ -1532,6 +1706,12 @@ public:
         }
     }
 
+    void set_rx_gain(double gain, const std::string &name, const std::vector<size_t> &chans){
+        for_each_chan_by_mboard(chans, true, [&](const size_t i){
+            set_rx_gain(gain, name, chans[i]);
+        });
+    }
+
     void set_rx_gain_profile(const std::string& profile, const size_t chan){
         if (chan != ALL_CHANS) {
             if (_tree->exists(rx_rf_fe_root(chan) / "gains/all/profile/value")) {
@@ -1680,6 +1860,10 @@ public:
         return sensor_names;
     }
 
+    std::map<std::string, sensor_value_t> get_rx_sensors(size_t chan, double max_age){
+        return _get_sensors(rx_rf_fe_root(chan) / "sensors", max_age);
+    }
+
     void set_rx_dc_offset(const bool enb, size_t chan){
         if (chan != ALL_CHANS){
             if (_tree->exists(rx_fe_root(chan) / "dc_offset" / "enable")) {
@@ -1923,10 +2107,42 @@ public:
         return result;
     }
 
+    std::vector<tune_result_t> set_tx_freq(
+        const tune_request_t &tune_request, const std::vector<size_t> &chans
+    ){
+        std::vector<tune_result_t> results(chans.size());
+        for_each_chan_by_mboard(chans, false, [&](const size_t i){
+            results[i] = set_tx_freq(tune_request, chans[i]);
+        });
+        return results;
+    }
+
     double get_tx_freq(size_t chan){
         return derive_freq_from_xx_subdev_and_dsp(TX_SIGN, _tree->subtree(tx_dsp_root(chan)), _tree->subtree(tx_rf_fe_root(chan)));
     }
 
+    std::vector<tune_result_t> set_tx_tune_table(
+        const std::vector<tune_request_t> &tune_requests, size_t chan
+    ){
+        tune_table_t table;
+        table.rf_freq = _tree->access_handle<double>(tx_rf_fe_root(chan) / "freq" / "value");
+        table.dsp_freq = _tree->access_handle<double>(tx_dsp_root(chan) / "freq" / "value");
+        table.requests = tune_requests;
+        for (const tune_request_t &tune_request : tune_requests) {
+            table.hops.push_back(set_tx_freq(tune_request, chan));
+        }
+        _tx_tune_tables[chan] = table;
+        return table.hops;
+    }
+
+    tune_result_t set_tx_freq_hop(size_t hop, size_t chan){
+        if (not _tx_tune_tables.count(chan)) {
+            throw uhd::index_error(str(
+                boost::format("No TX tune table was set for channel %u") % chan));
+        }
+        return tune_to_hop(_tx_tune_tables.at(chan), hop);
+    }
+
     freq_range_t get_tx_freq_range(size_t chan){
         return make_overall_tune_range(
             _tree->access<meta_range_t>(tx_rf_fe_root(chan) / "freq" / "range").get(),
@@ -1947,6 +2163,12 @@ public:
         }
     }
 
+    void set_tx_gain(double gain, const std::string &name, const std::vector<size_t> &chans){
+        for_each_chan_by_mboard(chans, false, [&](const size_t i){
+            set_tx_gain(gain, name, chans[i]);
+        });
+    }
+
     void set_tx_gain_profile(const std::string& profile, const size_t chan){
         if (chan != ALL_CHANS) {
             if (_tree->exists(tx_rf_fe_root(chan) / "gains/all/profile/value")) {
@@ -2077,6 +2299,10 @@ public:
         return sensor_names;
     }
 
+    std::map<std::string, sensor_value_t> get_tx_sensors(size_t chan, double max_age){
+        return _get_sensors(tx_rf_fe_root(chan) / "sensors", max_age);
+    }
+
     void set_tx_dc_offset(const std::complex<double> &offset, size_t chan){
         if (chan != ALL_CHANS){
             if (_tree->exists(tx_fe_root(chan) / "dc_offset" / "value")) {
@@ -2493,10 +2719,87 @@ public:
     }
 
 private:
+    /*! Wait until the PPS time of board 0 is no longer \p time_last_pps
+     *
+     * \return false if no PPS edge arrived within a second
+     */
+    bool _wait_for_pps_edge(const time_spec_t &time_last_pps){
+        const auto end_time = std::chrono::steady_clock::now()
+                              + std::chrono::milliseconds(1100);
+        while (time_last_pps == get_time_last_pps()){
+            if (std::chrono::steady_clock::now() > end_time){
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
     device::sptr _dev;
     property_tree::sptr _tree;
     bool _is_device3;
     uhd::rfnoc::legacy_compat::sptr _legacy_compat;
+    //! Handles to the time/now and time/pps properties, per motherboard
+    std::vector<boost::shared_ptr<property<time_spec_t> > > _time_now_props;
+    std::vector<boost::shared_ptr<property<time_spec_t> > > _time_pps_props;
+    //! Tune tables for frequency hopping, per channel
+    std::map<size_t, tune_table_t> _rx_tune_tables;
+    std::map<size_t, tune_table_t> _tx_tune_tables;
+    //! Gain groups, by the path of their RF frontend
+    std::mutex _gain_groups_mutex;
+    std::map<std::string, gain_group::sptr> _rx_gain_groups;
+    std::map<std::string, gain_group::sptr> _tx_gain_groups;
+    //! Sensor values read by _get_sensors(), by the path of their sensors
+    struct sensor_snapshot_t
+    {
+        std::chrono::steady_clock::time_point time;
+        std::map<std::string, sensor_value_t> values;
+    };
+    std::mutex _sensor_snapshots_mutex;
+    std::map<std::string, sensor_snapshot_t> _sensor_snapshots;
+
+    /*! Read all sensors below \p path, or return a snapshot that's at most
+     *  \p max_age seconds old.
+     *
+     * If the device provides a sensor_values property next to the sensors,
+     * it's used to read as many of them as the device can in one go. Any
+     * sensors it leaves out are read one by one.
+     */
+    std::map<std::string, sensor_value_t> _get_sensors(
+        const fs_path& path, const double max_age)
+    {
+        const auto now = std::chrono::steady_clock::now();
+        if (max_age > 0.0) {
+            std::lock_guard<std::mutex> lock(_sensor_snapshots_mutex);
+            const auto snapshot = _sensor_snapshots.find(path);
+            if (snapshot != _sensor_snapshots.end()
+                and now - snapshot->second.time
+                        <= std::chrono::duration<double>(max_age)) {
+                return snapshot->second.values;
+            }
+        }
+
+        std::map<std::string, sensor_value_t> values;
+        if (not _tree->exists(path)) {
+            return values;
+        }
+        const fs_path batch_path = path.branch_path() / "sensor_values";
+        if (_tree->exists(batch_path)) {
+            values =
+                _tree->access<std::map<std::string, sensor_value_t>>(batch_path).get();
+        }
+        for (const std::string& name : _tree->list(path)) {
+            if (not values.count(name)) {
+                values.emplace(name, _tree->access<sensor_value_t>(path / name).get());
+            }
+        }
+
+        if (max_age > 0.0) {
+            std::lock_guard<std::mutex> lock(_sensor_snapshots_mutex);
+            _sensor_snapshots[path] = sensor_snapshot_t{now, values};
+        }
+        return values;
+    }
 
     struct mboard_chan_pair{
         size_t mboard, chan;
@@ -2533,6 +2836,58 @@ private:
         return mcp;
     }
 
+    /*!
+     * Call fn(i) for every index i into chans.
+     *
+     * The channels of a motherboard are handled in the order given, but
+     * different motherboards are handled concurrently, so that their
+     * control-path round trips overlap. A failing call skips the remaining
+     * channels of its motherboard; the error of the first failing channel
+     * in chans is rethrown once all motherboards are done.
+     */
+    void for_each_chan_by_mboard(
+        const std::vector<size_t> &chans,
+        const bool rx,
+        const std::function<void(size_t)> &fn
+    ){
+        std::map<size_t, std::vector<size_t>> indexes_by_mboard;
+        for (size_t i = 0; i < chans.size(); i++) {
+            const size_t mboard = rx ? rx_chan_to_mcp(chans[i]).mboard
+                                     : tx_chan_to_mcp(chans[i]).mboard;
+            indexes_by_mboard[mboard].push_back(i);
+        }
+        if (indexes_by_mboard.size() <= 1) {
+            for (size_t i = 0; i < chans.size(); i++) {
+                fn(i);
+            }
+            return;
+        }
+
+        std::vector<std::exception_ptr> errors(chans.size());
+        std::vector<std::thread> threads;
+        for (const auto &mboard_indexes : indexes_by_mboard) {
+            const std::vector<size_t> &indexes = mboard_indexes.second;
+            threads.emplace_back([&fn, &errors, &indexes](){
+                for (const size_t i : indexes) {
+                    try {
+                        fn(i);
+                    } catch (...) {
+                        errors[i] = std::current_exception();
+                        return;
+                    }
+                }
+            });
+        }
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+        for (const std::exception_ptr &error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+    }
+
     fs_path mb_root(const size_t mboard)
     {
         try
@@ -2686,6 +3041,24 @@ private:
     }
 
     gain_group::sptr rx_gain_group(size_t chan){
+        // The gain elements of a frontend don't change, so keep its group
+        // (and the distribution plan the group caches)
+        const fs_path fe_root = rx_rf_fe_root(chan);
+        std::lock_guard<std::mutex> lock(_gain_groups_mutex);
+        gain_group::sptr &gg = _rx_gain_groups[fe_root];
+        if (not gg) gg = make_rx_gain_group(chan);
+        return gg;
+    }
+
+    gain_group::sptr tx_gain_group(size_t chan){
+        const fs_path fe_root = tx_rf_fe_root(chan);
+        std::lock_guard<std::mutex> lock(_gain_groups_mutex);
+        gain_group::sptr &gg = _tx_gain_groups[fe_root];
+        if (not gg) gg = make_tx_gain_group(chan);
+        return gg;
+    }
+
+    gain_group::sptr make_rx_gain_group(size_t chan){
         mboard_chan_pair mcp = rx_chan_to_mcp(chan);
         const subdev_spec_pair_t spec = get_rx_subdev_spec(mcp.mboard).at(mcp.chan);
         gain_group::sptr gg = gain_group::make();
@@ -2698,7 +3071,7 @@ private:
         return gg;
     }
 
-    gain_group::sptr tx_gain_group(size_t chan){
+    gain_group::sptr make_tx_gain_group(size_t chan){
         mboard_chan_pair mcp = tx_chan_to_mcp(chan);
         const subdev_spec_pair_t spec = get_tx_subdev_spec(mcp.mboard).at(mcp.chan);
         gain_group::sptr gg = gain_group::make();
@@ -2715,6 +3088,10 @@ private:
     // Assumption is that all mboards use the same link
     // and that the rate sum is evenly distributed among the mboards
     bool _check_link_rate(const stream_args_t &args, bool is_tx) {
+        if (args.otw_format == "auto") {
+            // The streamer picks a format that fits, or warns itself
+            return true;
+        }
         bool link_rate_is_ok = true;
         size_t bytes_per_sample = convert::get_bytes_per_item(args.otw_format.empty() ? "sc16" : args.otw_format);
         double max_link_rate = 0;
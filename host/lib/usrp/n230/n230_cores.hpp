@@ -32,6 +32,12 @@ public:
         size_t num_bits,
         bool readback);
 
+    virtual void write_spi_list(
+        int which_slave,
+        const spi_config_t &config,
+        const std::vector<uint32_t> &data,
+        size_t num_bits);
+
     void change_perif(perif_t perif);
     void restore_perif();
 
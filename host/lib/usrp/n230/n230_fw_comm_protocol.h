@@ -36,6 +36,19 @@ extern "C" {
 #define FW_COMM_CMD_PEEK32          0x00000020
 #define FW_COMM_CMD_BLOCK_POKE32    0x00000030
 #define FW_COMM_CMD_BLOCK_PEEK32    0x00000040
+#define FW_COMM_CMD_MULTI_POKE32    0x00000050
+#define FW_COMM_CMD_MULTI_PEEK32    0x00000060
+
+/*!
+ * Multi-operation commands carry independent operations in the data field:
+ * - MULTI_POKE32: data_words/2 pokes as (address, value) pairs
+ * - MULTI_PEEK32: data_words peeks, one address per word. The reply has the
+ *   peeked values in place of the addresses.
+ * The operations run in order. Firmware that predates these commands replies
+ * with FW_COMM_ERR_CMD_ERROR and runs none of them.
+ */
+#define FW_COMM_MAX_MULTI_POKES     (FW_COMM_MAX_DATA_WORDS / 2)
+#define FW_COMM_MAX_MULTI_PEEKS     FW_COMM_MAX_DATA_WORDS
 
 #define FW_COMM_ERR_PKT_ERROR       0x80000000
 #define FW_COMM_ERR_CMD_ERROR       0x40000000
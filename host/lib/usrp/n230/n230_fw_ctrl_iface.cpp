@@ -13,6 +13,7 @@
 #include <boost/format.hpp>
 #include <boost/asio.hpp> //used for htonl and ntohl
 #include "n230_fw_comm_protocol.h"
+#include <algorithm>
 #include <cstring>
 
 namespace uhd { namespace usrp { namespace n230 {
@@ -37,7 +38,7 @@ n230_fw_ctrl_iface::n230_fw_ctrl_iface(
     const uint16_t product_id,
     const bool verbose) :
     _product_id(product_id), _verbose(verbose), _udp_xport(udp_xport),
-    _seq_num(0)
+    _seq_num(0), _multi_ops(true)
 {
     flush();
     peek32(0);
@@ -88,6 +89,131 @@ uint32_t n230_fw_ctrl_iface::peek32(const wb_addr_type addr)
     return 0;
 }
 
+void n230_fw_ctrl_iface::multi_poke32(
+    const std::vector<wb_addr_type>& addrs, const std::vector<uint32_t>& data)
+{
+    UHD_ASSERT_THROW(addrs.size() == data.size());
+    {
+        boost::mutex::scoped_lock lock(_mutex);
+        if (_multi_ops) {
+            std::vector<fw_comm_pkt_t> requests;
+            for (size_t first = 0; first < addrs.size(); first += FW_COMM_MAX_MULTI_POKES) {
+                const size_t num_ops =
+                    std::min<size_t>(addrs.size() - first, FW_COMM_MAX_MULTI_POKES);
+                fw_comm_pkt_t request;
+                std::memset(&request, 0, sizeof(request));
+                request.flags = uhd::htonx<uint32_t>(FW_COMM_FLAGS_ACK | FW_COMM_CMD_MULTI_POKE32);
+                request.data_words = uhd::htonx<uint32_t>(2 * num_ops);
+                for (size_t i = 0; i < num_ops; i++) {
+                    request.data[2 * i]     = uhd::htonx<uint32_t>(addrs[first + i]);
+                    request.data[2 * i + 1] = uhd::htonx<uint32_t>(data[first + i]);
+                }
+                requests.push_back(request);
+            }
+            if (_transact_with_retries(requests)) {
+                return;
+            }
+        }
+    }
+    // The firmware predates multi-operation packets
+    wb_iface::multi_poke32(addrs, data);
+}
+
+std::vector<uint32_t> n230_fw_ctrl_iface::multi_peek32(
+    const std::vector<wb_addr_type>& addrs)
+{
+    {
+        boost::mutex::scoped_lock lock(_mutex);
+        if (_multi_ops) {
+            std::vector<fw_comm_pkt_t> requests;
+            for (size_t first = 0; first < addrs.size(); first += FW_COMM_MAX_MULTI_PEEKS) {
+                const size_t num_ops =
+                    std::min<size_t>(addrs.size() - first, FW_COMM_MAX_MULTI_PEEKS);
+                fw_comm_pkt_t request;
+                std::memset(&request, 0, sizeof(request));
+                request.flags = uhd::htonx<uint32_t>(FW_COMM_FLAGS_ACK | FW_COMM_CMD_MULTI_PEEK32);
+                request.data_words = uhd::htonx<uint32_t>(num_ops);
+                for (size_t i = 0; i < num_ops; i++) {
+                    request.data[i] = uhd::htonx<uint32_t>(addrs[first + i]);
+                }
+                requests.push_back(request);
+            }
+            if (_transact_with_retries(requests)) {
+                std::vector<uint32_t> data;
+                data.reserve(addrs.size());
+                for (const fw_comm_pkt_t& reply : requests) {
+                    for (size_t i = 0; i < uhd::ntohx<uint32_t>(reply.data_words); i++) {
+                        data.push_back(uhd::ntohx<uint32_t>(reply.data[i]));
+                    }
+                }
+                return data;
+            }
+        }
+    }
+    // The firmware predates multi-operation packets
+    return wb_iface::multi_peek32(addrs);
+}
+
+bool n230_fw_ctrl_iface::_transact_with_retries(std::vector<fw_comm_pkt_t>& requests)
+{
+    for (size_t i = 1; i <= NUM_RETRIES; i++) {
+        try {
+            // Every attempt starts from the requests as they were passed in
+            std::vector<fw_comm_pkt_t> replies = requests;
+            if (not _transact(replies)) {
+                _multi_ops = false;
+                return false;
+            }
+            requests.swap(replies);
+            return true;
+        } catch(const std::exception &ex) {
+            const std::string error_msg = str(boost::format(
+                "udp fw multi peek/poke failure #%u\n%s") % i % ex.what());
+            if (_verbose) UHD_LOGGER_WARNING("N230") << error_msg ;
+            if (i == NUM_RETRIES) throw uhd::io_error(error_msg);
+        }
+    }
+    return false;
+}
+
+bool n230_fw_ctrl_iface::_transact(std::vector<fw_comm_pkt_t>& requests)
+{
+    const uint32_t first_seq = _seq_num;
+    for (fw_comm_pkt_t& request : requests) {
+        request.id = uhd::htonx<uint32_t>(FW_COMM_GENERATE_ID(_product_id));
+        request.sequence = uhd::htonx<uint32_t>(_seq_num++);
+    }
+
+    //Keep up to PIPELINE_DEPTH requests in flight. The firmware answers them in order.
+    _flush();
+    size_t num_sent = 0;
+    for (size_t i = 0; i < requests.size(); i++) {
+        while (num_sent < requests.size() and num_sent < i + PIPELINE_DEPTH) {
+            _udp_xport->send(boost::asio::buffer(&requests[num_sent], sizeof(fw_comm_pkt_t)));
+            num_sent++;
+        }
+
+        fw_comm_pkt_t reply;
+        const size_t nbytes = _udp_xport->recv(boost::asio::buffer(&reply, sizeof(reply)), 1.0);
+        if (nbytes == 0) throw uhd::io_error("udp fw multi peek/poke - reply timed out");
+
+        //Sanity checks
+        const size_t flags = uhd::ntohx<uint32_t>(reply.flags);
+        UHD_ASSERT_THROW(nbytes == sizeof(reply));
+        UHD_ASSERT_THROW(uhd::ntohx<uint32_t>(reply.sequence) == first_seq + i);
+        if (flags & FW_COMM_ERR_CMD_ERROR) {
+            //Unknown command: Nothing ran, and the other replies will say the same
+            _flush();
+            return false;
+        }
+        UHD_ASSERT_THROW(not (flags & FW_COMM_FLAGS_ERROR_MASK));
+        UHD_ASSERT_THROW(flags & FW_COMM_FLAGS_ACK);
+        UHD_ASSERT_THROW(reply.data_words == requests[i].data_words);
+        requests[i] = reply;
+    }
+    return true;
+}
+
 void n230_fw_ctrl_iface::_poke32(const wb_addr_type addr, const uint32_t data)
 {
     //Load request struct
@@ -11,6 +11,7 @@
 #include <uhd/types/wb_iface.hpp>
 #include <uhd/transport/udp_simple.hpp>
 #include <boost/thread/mutex.hpp>
+#include "n230_fw_comm_protocol.h"
 #include <vector>
 
 namespace uhd { namespace usrp { namespace n230 {
@@ -27,6 +28,8 @@ public:
     // -- uhd::wb_iface --
     void poke32(const wb_addr_type addr, const uint32_t data);
     uint32_t peek32(const wb_addr_type addr);
+    void multi_poke32(const std::vector<wb_addr_type>& addrs, const std::vector<uint32_t>& data);
+    std::vector<uint32_t> multi_peek32(const std::vector<wb_addr_type>& addrs);
     void flush();
 
     static uhd::wb_iface::sptr make(
@@ -46,6 +49,8 @@ public:
 private:
     void _poke32(const wb_addr_type addr, const uint32_t data);
     uint32_t _peek32(const wb_addr_type addr);
+    bool _transact(std::vector<fw_comm_pkt_t>& requests);
+    bool _transact_with_retries(std::vector<fw_comm_pkt_t>& requests);
     void _flush(void);
 
     const uint16_t               _product_id;
@@ -53,8 +58,12 @@ private:
     uhd::transport::udp_simple::sptr    _udp_xport;
     uint32_t                     _seq_num;
     boost::mutex                        _mutex;
+    //! Cleared when the firmware turns out not to support them
+    bool                                _multi_ops;
 
     static const size_t NUM_RETRIES = 3;
+    //! Number of multi-operation packets in flight
+    static const size_t PIPELINE_DEPTH = 4;
 };
 
 }}} //namespace
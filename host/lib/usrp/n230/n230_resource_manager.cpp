@@ -118,7 +118,10 @@ n230_resource_manager::n230_resource_manager(
     _check_fw_compat();
 
     //Start the device claimer
-    _claimer_task = uhd::task::make(boost::bind(&n230_resource_manager::_claimer_loop, this));
+    _claimer_task = uhd::task::make_periodic(
+        boost::bind(&n230_resource_manager::_claimer_loop, this),
+        N230_CLAIMER_TIMEOUT_IN_MS / 2000.0,
+        "n230_claimer");
 
     //Create common settings interface
     const sid_t core_sid = _generate_sid(CORE, _get_conn(PRI_ETH).type);
@@ -286,7 +289,6 @@ void n230_resource_manager::_claimer_loop()
         _fw_ctrl->poke32(N230_FW_HOST_SHMEM_OFFSET(claim_time), time(NULL));
         _fw_ctrl->poke32(N230_FW_HOST_SHMEM_OFFSET(claim_src), get_process_hash());
     }
-    std::this_thread::sleep_for(std::chrono::milliseconds(N230_CLAIMER_TIMEOUT_IN_MS / 2));
 }
 
 void n230_resource_manager::_initialize_radio(size_t instance)
@@ -0,0 +1,584 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/usrp/rx_channelizer.hpp>
+#include <boost/enable_shared_from_this.hpp>
+#include <boost/format.hpp>
+#include <boost/make_shared.hpp>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#ifdef __SSE2__
+#    include <emmintrin.h>
+#endif
+
+using namespace uhd;
+using namespace uhd::usrp;
+
+namespace {
+
+typedef std::complex<float> fc32_t;
+
+//! Kaiser window parameter, gives about 80 dB stopband attenuation
+constexpr double KAISER_BETA = 8.0;
+
+//! Zeroth order modified Bessel function of the first kind
+double bessel_i0(const double x)
+{
+    double sum = 1.0, term = 1.0;
+    for (size_t k = 1; k < 50; k++) {
+        term *= (x / (2 * k)) * (x / (2 * k));
+        sum += term;
+    }
+    return sum;
+}
+
+/*! acc[i] += taps[i] * x[i] for interleaved I/Q samples
+ *
+ * \param taps every tap twice, once for I and once for Q
+ * \param len number of floats, a multiple of 4
+ */
+UHD_INLINE void multiply_accumulate(
+    float* acc, const float* taps, const float* x, const size_t len)
+{
+#ifdef __SSE2__
+    for (size_t i = 0; i < len; i += 4) {
+        _mm_storeu_ps(acc + i,
+            _mm_add_ps(_mm_loadu_ps(acc + i),
+                _mm_mul_ps(_mm_loadu_ps(taps + i), _mm_loadu_ps(x + i))));
+    }
+#else
+    for (size_t i = 0; i < len; i++) {
+        acc[i] += taps[i] * x[i];
+    }
+#endif
+}
+
+//! In-place forward radix-2 FFT
+class radix2_fft
+{
+public:
+    radix2_fft(const size_t size) : _size(size), _bitrev(size), _twiddles(size / 2)
+    {
+        size_t num_bits = 0;
+        while ((size_t(1) << num_bits) < size) {
+            num_bits++;
+        }
+        for (size_t i = 0; i < size; i++) {
+            size_t rev = 0;
+            for (size_t bit = 0; bit < num_bits; bit++) {
+                rev |= ((i >> bit) & 1) << (num_bits - 1 - bit);
+            }
+            _bitrev[i] = rev;
+        }
+        for (size_t k = 0; k < size / 2; k++) {
+            _twiddles[k] = std::polar(1.0f, float(-2 * M_PI * k / size));
+        }
+    }
+
+    void operator()(fc32_t* data) const
+    {
+        for (size_t i = 0; i < _size; i++) {
+            if (i < _bitrev[i]) {
+                std::swap(data[i], data[_bitrev[i]]);
+            }
+        }
+        for (size_t len = 2; len <= _size; len *= 2) {
+            const size_t stride = _size / len;
+            for (size_t start = 0; start < _size; start += len) {
+                for (size_t k = 0; k < len / 2; k++) {
+                    const fc32_t t = _twiddles[k * stride] * data[start + k + len / 2];
+                    data[start + k + len / 2] = data[start + k] - t;
+                    data[start + k] += t;
+                }
+            }
+        }
+    }
+
+private:
+    const size_t _size;
+    std::vector<size_t> _bitrev;
+    std::vector<fc32_t> _twiddles;
+};
+
+//! Threads which run one job on ranges of blocks, together with the caller
+class block_workers
+{
+public:
+    typedef std::function<void(size_t worker, size_t begin, size_t end)> job_t;
+
+    block_workers(const size_t num_threads)
+    {
+        for (size_t i = 1; i < num_threads; i++) {
+            _threads.emplace_back([this, i]() { this->worker_loop(i); });
+        }
+    }
+
+    ~block_workers(void)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _exit = true;
+        }
+        _start_cond.notify_all();
+        for (auto& thread : _threads) {
+            thread.join();
+        }
+    }
+
+    size_t get_num_workers(void) const
+    {
+        return _threads.size() + 1;
+    }
+
+    //! Split num_blocks among the workers, and wait until they are done
+    void run(const job_t& job, const size_t num_blocks)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _job        = &job;
+            _num_blocks = num_blocks;
+            _num_busy   = _threads.size();
+            _generation++;
+        }
+        _start_cond.notify_all();
+        run_share(0);
+        std::unique_lock<std::mutex> lock(_mutex);
+        _done_cond.wait(lock, [this]() { return _num_busy == 0; });
+    }
+
+private:
+    void run_share(const size_t worker)
+    {
+        const size_t num_workers = get_num_workers();
+        const size_t begin       = _num_blocks * worker / num_workers;
+        const size_t end         = _num_blocks * (worker + 1) / num_workers;
+        if (begin != end) {
+            (*_job)(worker, begin, end);
+        }
+    }
+
+    void worker_loop(const size_t worker)
+    {
+        size_t generation = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _start_cond.wait(
+                    lock, [&]() { return _exit or _generation != generation; });
+                if (_exit) {
+                    return;
+                }
+                generation = _generation;
+            }
+            run_share(worker);
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _num_busy--;
+            }
+            _done_cond.notify_one();
+        }
+    }
+
+    std::vector<std::thread> _threads;
+    std::mutex _mutex;
+    std::condition_variable _start_cond;
+    std::condition_variable _done_cond;
+    const job_t* _job  = nullptr;
+    size_t _num_blocks = 0;
+    size_t _num_busy   = 0;
+    size_t _generation = 0;
+    bool _exit         = false;
+};
+
+} // namespace
+
+rx_channelizer::~rx_channelizer(void)
+{
+    /* NOP */
+}
+
+/***********************************************************************
+ * Channelizer implementation
+ *
+ * Output n of channel c is the wideband input x, mixed down by c/M cycles per
+ * sample, low pass filtered with h and decimated by M:
+ *
+ *   y_c[n] = sum_m h[m] x[s] exp(-j 2 pi c s / M), with s = nM + M - 1 - m
+ *
+ * Splitting m = tM + (M - 1 - q) makes the mixing term depend on q only, so
+ * y[n] is the FFT of w[q] = sum_t h[tM + M - 1 - q] x[(n - t)M + q]. w is
+ * computed as T multiply-accumulates over a whole block of M samples each.
+ **********************************************************************/
+class rx_channelizer_impl : public rx_channelizer,
+                            public boost::enable_shared_from_this<rx_channelizer_impl>
+{
+public:
+    rx_channelizer_impl(uhd::rx_streamer::sptr streamer,
+        const size_t num_chans,
+        const double samp_rate,
+        const size_t num_threads,
+        const size_t taps_per_chan,
+        const size_t max_buffered)
+        : _streamer(streamer)
+        , _num_chans(num_chans)
+        , _samp_rate(samp_rate)
+        , _taps_per_chan(taps_per_chan)
+        , _max_buffered(max_buffered)
+        , _fft(num_chans)
+        , _workers(num_threads)
+        , _scratch(num_threads, std::vector<fc32_t>(num_chans))
+        , _chans(num_chans)
+    {
+        const size_t num_taps = _num_chans * _taps_per_chan;
+        const double cutoff   = 0.5 / _num_chans;
+        const double center   = (num_taps - 1) / 2.0;
+        std::vector<double> prototype(num_taps);
+        double sum = 0;
+        for (size_t n = 0; n < num_taps; n++) {
+            const double t = n - center;
+            const double x = 2 * M_PI * cutoff * t;
+            const double r = t / (center + 1);
+            prototype[n]   = ((t == 0) ? 1.0 : std::sin(x) / x)
+                           * bessel_i0(KAISER_BETA * std::sqrt(1 - r * r))
+                           / bessel_i0(KAISER_BETA);
+            sum += prototype[n];
+        }
+
+        // _taps[t] holds h[tM + M - 1 - q] for all q, every tap twice
+        _taps.resize(2 * num_taps);
+        for (size_t t = 0; t < _taps_per_chan; t++) {
+            for (size_t q = 0; q < _num_chans; q++) {
+                const float tap = float(
+                    prototype[t * _num_chans + _num_chans - 1 - q] / sum);
+                _taps[2 * (t * _num_chans + q)]     = tap;
+                _taps[2 * (t * _num_chans + q) + 1] = tap;
+            }
+        }
+
+        // Receive enough for a few blocks, but at least a packet
+        _recv_size = std::max(_streamer->get_max_num_samps(), 8 * _num_chans);
+        reset();
+    }
+
+    size_t get_num_chans(void) const
+    {
+        return _num_chans;
+    }
+
+    double get_chan_rate(void) const
+    {
+        return _samp_rate / _num_chans;
+    }
+
+    double get_chan_freq(const size_t chan) const
+    {
+        const double freq = get_chan_rate() * chan;
+        return (chan < (_num_chans + 1) / 2) ? freq : freq - _samp_rate;
+    }
+
+    uhd::rx_streamer::sptr get_channel_streamer(const size_t chan);
+
+    size_t recv(const size_t chan,
+        fc32_t* buff,
+        const size_t nsamps,
+        rx_metadata_t& metadata,
+        const double timeout,
+        const bool one_packet)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        metadata.reset();
+        chan_state_t& state = _chans.at(chan);
+        if (state.error_code != rx_metadata_t::ERROR_CODE_NONE) {
+            metadata.error_code = state.error_code;
+            state.error_code    = rx_metadata_t::ERROR_CODE_NONE;
+            return 0;
+        }
+
+        const size_t min_samps = one_packet ? 1 : std::min(nsamps, _max_buffered);
+        while (state.samps.size() - state.head < min_samps) {
+            rx_metadata_t in_md;
+            process(timeout, in_md);
+            if (in_md.error_code == rx_metadata_t::ERROR_CODE_TIMEOUT) {
+                if (state.samps.size() == state.head) {
+                    metadata.error_code = in_md.error_code;
+                    return 0;
+                }
+                break;
+            }
+            if (state.error_code != rx_metadata_t::ERROR_CODE_NONE) {
+                // All channels were flushed
+                metadata.error_code = state.error_code;
+                state.error_code    = rx_metadata_t::ERROR_CODE_NONE;
+                return 0;
+            }
+        }
+
+        const size_t num_out = std::min(nsamps, state.samps.size() - state.head);
+        std::copy(state.samps.begin() + state.head,
+            state.samps.begin() + state.head + num_out,
+            buff);
+        if (_has_time) {
+            // The output is delayed by half the filter length
+            const double in_index = double(state.head_index * _num_chans + _num_chans - 1)
+                                    - (_num_chans * _taps_per_chan - 1) / 2.0;
+            metadata.has_time_spec = true;
+            metadata.time_spec =
+                _time_ref + time_spec_t((in_index - _time_ref_pos) / _samp_rate);
+        }
+        metadata.start_of_burst = state.start_of_burst;
+        state.start_of_burst    = false;
+        state.head += num_out;
+        state.head_index += num_out;
+        if (state.head == state.samps.size()) {
+            metadata.end_of_burst = state.end_of_burst;
+            state.end_of_burst    = false;
+        }
+        compact(state);
+        return num_out;
+    }
+
+    size_t get_max_num_samps(void) const
+    {
+        return _recv_size / _num_chans;
+    }
+
+    void issue_stream_cmd(const stream_cmd_t& stream_cmd)
+    {
+        stream_cmd_t cmd(stream_cmd);
+        cmd.num_samps *= _num_chans;
+        _streamer->issue_stream_cmd(cmd);
+    }
+
+private:
+    struct chan_state_t
+    {
+        std::vector<fc32_t> samps;
+        //! Index of the first sample which was not received yet
+        size_t head = 0;
+        //! Output index of samps[head], since the last reset
+        int64_t head_index = 0;
+        bool start_of_burst = false;
+        bool end_of_burst   = false;
+        rx_metadata_t::error_code_t error_code = rx_metadata_t::ERROR_CODE_NONE;
+    };
+
+    //! Receive from the wideband stream and split the complete blocks
+    void process(const double timeout, rx_metadata_t& in_md)
+    {
+        const size_t history = (_taps_per_chan - 1) * _num_chans;
+        const size_t offset  = _input.size();
+        _input.resize(offset + _recv_size);
+        const size_t num_in =
+            _streamer->recv(&_input[offset], _recv_size, in_md, timeout);
+        _input.resize(offset + num_in);
+        if (in_md.error_code != rx_metadata_t::ERROR_CODE_NONE
+            and in_md.error_code != rx_metadata_t::ERROR_CODE_TIMEOUT) {
+            reset();
+            for (auto& state : _chans) {
+                state.error_code = in_md.error_code;
+            }
+            return;
+        }
+        if (in_md.has_time_spec) {
+            _time_ref     = in_md.time_spec;
+            _time_ref_pos = _input_index + int64_t(offset - history);
+            _has_time     = true;
+        }
+        for (auto& state : _chans) {
+            state.start_of_burst |= in_md.start_of_burst;
+        }
+
+        const size_t num_blocks = (_input.size() - history) / _num_chans;
+        if (num_blocks == 0) {
+            return;
+        }
+        _output.resize(num_blocks * _num_chans);
+        _workers.run(
+            [this](size_t worker, size_t begin, size_t end) {
+                this->split_blocks(worker, begin, end);
+            },
+            num_blocks);
+
+        // Hand the output to the channels, dropping what they don't pick up
+        for (size_t chan = 0; chan < _num_chans; chan++) {
+            chan_state_t& state = _chans[chan];
+            for (size_t n = 0; n < num_blocks; n++) {
+                state.samps.push_back(_output[n * _num_chans + chan]);
+            }
+            const size_t num_held = state.samps.size() - state.head;
+            if (num_held > _max_buffered) {
+                const size_t num_dropped = num_held - _max_buffered;
+                state.head += num_dropped;
+                state.head_index += num_dropped;
+                state.error_code = rx_metadata_t::ERROR_CODE_OVERFLOW;
+            }
+            state.end_of_burst |= in_md.end_of_burst;
+            compact(state);
+        }
+
+        // Keep the history for the next blocks
+        const size_t consumed = num_blocks * _num_chans;
+        _input.erase(_input.begin(), _input.begin() + consumed);
+        _input_index += consumed;
+        if (in_md.end_of_burst) {
+            reset_input();
+        }
+    }
+
+    void split_blocks(const size_t worker, const size_t begin, const size_t end)
+    {
+        fc32_t* w        = _scratch[worker].data();
+        const size_t len = 2 * _num_chans;
+        for (size_t n = begin; n < end; n++) {
+            std::fill(w, w + _num_chans, fc32_t());
+            for (size_t t = 0; t < _taps_per_chan; t++) {
+                // Block n - t, counted from the oldest block of the history
+                const fc32_t* x = &_input[(n + _taps_per_chan - 1 - t) * _num_chans];
+                multiply_accumulate(reinterpret_cast<float*>(w),
+                    &_taps[t * len],
+                    reinterpret_cast<const float*>(x),
+                    len);
+            }
+            _fft(w);
+            std::copy(w, w + _num_chans, &_output[n * _num_chans]);
+        }
+    }
+
+    void compact(chan_state_t& state)
+    {
+        if (state.head > state.samps.size() / 2) {
+            state.samps.erase(state.samps.begin(), state.samps.begin() + state.head);
+            state.head = 0;
+        }
+    }
+
+    //! Zero the history and drop an incomplete block, but keep counting samples
+    void reset_input(void)
+    {
+        const size_t history = (_taps_per_chan - 1) * _num_chans;
+        _input_index +=
+            int64_t(_input.size()) - int64_t(std::min(_input.size(), history));
+        _input.assign(history, fc32_t());
+    }
+
+    //! Drop everything and start over
+    void reset(void)
+    {
+        _input.clear();
+        reset_input();
+        _input_index = 0;
+        _has_time    = false;
+        for (auto& state : _chans) {
+            state.samps.clear();
+            state.head       = 0;
+            state.head_index = 0;
+        }
+    }
+
+    uhd::rx_streamer::sptr _streamer;
+    const size_t _num_chans;
+    const double _samp_rate;
+    const size_t _taps_per_chan;
+    const size_t _max_buffered;
+    const radix2_fft _fft;
+    block_workers _workers;
+    std::vector<std::vector<fc32_t>> _scratch;
+    std::vector<float> _taps;
+    size_t _recv_size;
+
+    std::mutex _mutex;
+    //! History and received samples, in blocks of _num_chans
+    std::vector<fc32_t> _input;
+    //! Input index of the first sample after the history, since the last reset
+    int64_t _input_index = 0;
+    std::vector<fc32_t> _output;
+    std::vector<chan_state_t> _chans;
+    time_spec_t _time_ref;
+    int64_t _time_ref_pos = 0;
+    bool _has_time        = false;
+};
+
+/***********************************************************************
+ * Channel streamer
+ **********************************************************************/
+class channel_rx_streamer : public uhd::rx_streamer
+{
+public:
+    channel_rx_streamer(
+        boost::shared_ptr<rx_channelizer_impl> channelizer, const size_t chan)
+        : _channelizer(channelizer), _chan(chan)
+    {
+    }
+
+    size_t get_num_channels(void) const
+    {
+        return 1;
+    }
+
+    size_t get_max_num_samps(void) const
+    {
+        return _channelizer->get_max_num_samps();
+    }
+
+    size_t recv(const buffs_type& buffs,
+        const size_t nsamps_per_buff,
+        rx_metadata_t& metadata,
+        const double timeout,
+        const bool one_packet)
+    {
+        return _channelizer->recv(_chan,
+            reinterpret_cast<fc32_t*>(buffs[0]),
+            nsamps_per_buff,
+            metadata,
+            timeout,
+            one_packet);
+    }
+
+    void issue_stream_cmd(const stream_cmd_t& stream_cmd)
+    {
+        _channelizer->issue_stream_cmd(stream_cmd);
+    }
+
+private:
+    boost::shared_ptr<rx_channelizer_impl> _channelizer;
+    const size_t _chan;
+};
+
+uhd::rx_streamer::sptr rx_channelizer_impl::get_channel_streamer(const size_t chan)
+{
+    if (chan >= _num_chans) {
+        throw uhd::index_error(
+            str(boost::format("rx_channelizer: channel %u out of range") % chan));
+    }
+    return boost::make_shared<channel_rx_streamer>(shared_from_this(), chan);
+}
+
+rx_channelizer::sptr rx_channelizer::make(uhd::rx_streamer::sptr streamer,
+    const size_t num_chans,
+    const double samp_rate,
+    const size_t num_threads,
+    const size_t taps_per_chan,
+    const size_t max_buffered)
+{
+    if (not streamer or streamer->get_num_channels() != 1) {
+        throw uhd::value_error("rx_channelizer: requires a single channel streamer");
+    }
+    if (num_chans < 2 or (num_chans & (num_chans - 1)) != 0) {
+        throw uhd::value_error("rx_channelizer: number of channels must be a power of 2");
+    }
+    if (num_threads < 1 or taps_per_chan < 1 or max_buffered < 1 or not(samp_rate > 0)) {
+        throw uhd::value_error("rx_channelizer: invalid parameters");
+    }
+    return boost::make_shared<rx_channelizer_impl>(
+        streamer, num_chans, samp_rate, num_threads, taps_per_chan, max_buffered);
+}
@@ -356,6 +356,11 @@ public:
         _stc->issue_stream_cmd(stream_cmd);
     }
 
+    uhd::stream_stats_t get_stats(void) const
+    {
+        return sph::recv_packet_handler::get_stats();
+    }
+
 private:
     size_t _max_num_samps;
     soft_time_ctrl::sptr _stc;
@@ -416,6 +421,11 @@ public:
         return _stc->get_async_queue().pop_with_timed_wait(async_metadata, timeout);
     }
 
+    uhd::stream_stats_t get_stats(void) const
+    {
+        return sph::send_packet_handler::get_stats();
+    }
+
 private:
     size_t _max_num_samps;
     soft_time_ctrl::sptr _stc;
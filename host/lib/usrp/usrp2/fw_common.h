@@ -23,7 +23,7 @@ extern "C" {
 #define USRP2_FPGA_COMPAT_NUM 10
 #define N200_FPGA_COMPAT_NUM 11
 #define USRP2_FW_COMPAT_NUM 12
-#define USRP2_FW_VER_MINOR 4
+#define USRP2_FW_VER_MINOR 5
 
 //used to differentiate control packets over data port
 #define USRP2_INVALID_VRT_HEADER 0
@@ -90,6 +90,9 @@ typedef enum{
     USRP2_CTRL_ID_GET_THIS_REGISTER_FOR_ME_BRO = 'r',
     USRP2_CTRL_ID_OMG_GOT_REGISTER_SO_BAD_DUDE = 'R',
 
+    USRP2_CTRL_ID_GET_THESE_REGISTERS_FOR_ME_BRO = 'm',
+    USRP2_CTRL_ID_OMG_GOT_REGISTERS_SO_BAD_DUDE = 'M',
+
     USRP2_CTRL_ID_HOLLER_AT_ME_BRO = 'l',
     USRP2_CTRL_ID_HOLLER_BACK_DUDE = 'L',
 
@@ -116,6 +119,20 @@ typedef enum{
     USRP2_REG_ACTION_FW_POKE32   = 6
 } usrp2_reg_action_t;
 
+//most register operations in one GET_THESE_REGISTERS packet
+#define USRP2_CTRL_MAX_REG_OPS 32
+
+/*!
+ * The register operations of a GET_THESE_REGISTERS packet follow the
+ * usrp2_ctrl_data_t, whose multi_reg_args hold their number. They run in
+ * order, and the reply carries them back with the peeked data filled in.
+ */
+typedef struct{
+    uint32_t addr;
+    uint32_t data;
+    uint32_t action;
+} usrp2_reg_op_t;
+
 typedef struct{
     uint32_t proto_ver;
     uint32_t id;
@@ -143,6 +160,9 @@ typedef struct{
         struct {
             uint32_t len;
         } echo_args;
+        struct {
+            uint32_t num_ops;
+        } multi_reg_args;
     } data;
 } usrp2_ctrl_data_t;
 
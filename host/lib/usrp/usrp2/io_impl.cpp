@@ -25,6 +25,7 @@
 #include <boost/asio.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/make_shared.hpp>
+#include <atomic>
 #include <iostream>
 #include <chrono>
 #include <thread>
@@ -51,6 +52,9 @@ static const size_t vrt_send_header_offset_words32 = 1;
  * flow control monitor for a single tx channel
  *  - the pirate thread calls update
  *  - the get send buffer calls check
+ *  - the sequence numbers are atomics, so check only takes the lock and
+ *    waits when there are no credits left, and update only notifies when
+ *    there is a waiter
  **********************************************************************/
 class flow_control_monitor{
 public:
@@ -63,6 +67,7 @@ public:
      */
     flow_control_monitor(seq_type max_seqs_out):_max_seqs_out(max_seqs_out){
         this->clear();
+        _num_waiters = 0;
         _ready_fcn = boost::bind(&flow_control_monitor::ready, this);
     }
 
@@ -78,7 +83,7 @@ public:
      * \return the sequence to be sent to the dsp
      */
     UHD_INLINE seq_type get_curr_seq_out(void){
-        return _last_seq_out++;
+        return _last_seq_out.fetch_add(1, std::memory_order_relaxed);
     }
 
     /*!
@@ -87,10 +92,16 @@ public:
      * \return false on timeout
      */
     UHD_INLINE bool check_fc_condition(double timeout){
-        boost::mutex::scoped_lock lock(_fc_mutex);
         if (this->ready()) return true;
+
+        boost::mutex::scoped_lock lock(_fc_mutex);
+        // Register before checking again, so an update either sees the waiter
+        // or happened before the check
+        _num_waiters++;
         boost::this_thread::disable_interruption di; //disable because the wait can throw
-        return _fc_cond.timed_wait(lock, to_time_dur(timeout), _ready_fcn);
+        const bool ready = _fc_cond.timed_wait(lock, to_time_dur(timeout), _ready_fcn);
+        _num_waiters--;
+        return ready;
     }
 
     /*!
@@ -98,20 +109,25 @@ public:
      * \param seq the last sequence number to be ACK'd
      */
     UHD_INLINE void update_fc_condition(seq_type seq){
-        boost::mutex::scoped_lock lock(_fc_mutex);
         _last_seq_ack = seq;
+        if (_num_waiters == 0) return;
+        // Wait until the waiter is blocked on the condition, so the
+        // notification is not lost
+        boost::mutex::scoped_lock lock(_fc_mutex);
         lock.unlock();
         _fc_cond.notify_one();
     }
 
 private:
     bool ready(void){
-        return seq_type(_last_seq_out -_last_seq_ack) < _max_seqs_out;
+        return seq_type(_last_seq_out.load(std::memory_order_relaxed) - _last_seq_ack)
+               < _max_seqs_out;
     }
 
     boost::mutex _fc_mutex;
     boost::condition _fc_cond;
-    seq_type _last_seq_out, _last_seq_ack;
+    std::atomic<seq_type> _last_seq_out, _last_seq_ack;
+    std::atomic<size_t> _num_waiters;
     const seq_type _max_seqs_out;
     boost::function<bool(void)> _ready_fcn;
 };
@@ -442,11 +458,16 @@ rx_streamer::sptr usrp2_impl::get_rx_stream(const uhd::stream_args_t &args_){
     id.output_format = args.cpu_format;
     id.num_outputs = 1;
     my_streamer->set_converter(id);
+    if (args.args.has_key("signal_stats") and not my_streamer->enable_signal_stats()){
+        UHD_LOGGER_WARNING("USRP2")
+            << "signal_stats is not supported for " << id.to_pp_string();
+    }
 
     //bind callbacks for the handler
     for (size_t chan_i = 0; chan_i < args.channels.size(); chan_i++){
         const size_t chan = args.channels[chan_i];
         size_t num_chan_so_far = 0;
+        size_t mb_index = 0;
         for(const std::string &mb:  _mbc.keys()){
             num_chan_so_far += _mbc[mb].rx_chan_occ;
             if (chan < num_chan_so_far){
@@ -457,11 +478,16 @@ rx_streamer::sptr usrp2_impl::get_rx_stream(const uhd::stream_args_t &args_){
                 my_streamer->set_xport_chan_get_buff(chan_i, boost::bind(
                     &zero_copy_if::get_recv_buff, _mbc[mb].rx_dsp_xports[dsp], _1
                 ), true /*flush*/);
+                my_streamer->set_xport_chan_wait_xport(
+                    chan_i, _mbc[mb].rx_dsp_xports[dsp]);
+                //the motherboards take their stream commands concurrently
                 my_streamer->set_issue_stream_cmd(chan_i, boost::bind(
-                    &rx_dsp_core_200::issue_stream_command, _mbc[mb].rx_dsps[dsp], _1));
+                    &rx_dsp_core_200::issue_stream_command, _mbc[mb].rx_dsps[dsp], _1),
+                    mb_index);
                 _mbc[mb].rx_streamers[dsp] = my_streamer; //store weak pointer
                 break;
             }
+            mb_index++;
         }
     }
 
@@ -24,9 +24,8 @@
 #include <boost/functional/hash.hpp>
 #include <boost/filesystem.hpp>
 #include <algorithm>
+#include <cstring>
 #include <iostream>
-#include <chrono>
-#include <thread>
 #include <uhd/utils/platform.hpp>
 
 using namespace uhd;
@@ -62,7 +61,8 @@ public:
     usrp2_iface_impl(udp_simple::sptr ctrl_transport):
         _ctrl_transport(ctrl_transport),
         _ctrl_seq_num(0),
-        _protocol_compat(0) //initialized below...
+        _protocol_compat(0), //initialized below...
+        _multi_reg_ops(true)
     {
         //Obtain the firmware's compat number.
         //Save the response compat number for communication.
@@ -88,7 +88,8 @@ public:
     void lock_device(bool lock){
         if (lock){
             this->pokefw(U2_FW_REG_LOCK_GPID, get_process_hash());
-            _lock_task = task::make(boost::bind(&usrp2_iface_impl::lock_task, this));
+            _lock_task = task::make_periodic(
+                boost::bind(&usrp2_iface_impl::lock_task, this), 1.5, "usrp2_lock");
         }
         else{
             _lock_task.reset(); //shutdown the task
@@ -97,18 +98,27 @@ public:
     }
 
     bool is_device_locked(void){
+        //read everything in one go, this runs for every device during discovery
+        std::vector<usrp2_reg_op_t> ops = {
+            {U2_REG_COMPAT_NUM_RB, 0, USRP2_REG_ACTION_FPGA_PEEK32},
+            {U2_FW_REG_LOCK_TIME, 0, USRP2_REG_ACTION_FW_PEEK32},
+            {U2_FW_REG_LOCK_GPID, 0, USRP2_REG_ACTION_FW_PEEK32},
+            {U2_REG_TIME64_LO_RB_IMM, 0, USRP2_REG_ACTION_FPGA_PEEK32}
+        };
+        this->transact_regs(ops);
+
         //never assume lock with fpga image mismatch
-        if ((this->peek32(U2_REG_COMPAT_NUM_RB) >> 16) != USRP2_FPGA_COMPAT_NUM) return false;
+        if ((ops[0].data >> 16) != USRP2_FPGA_COMPAT_NUM) return false;
 
-        uint32_t lock_time = this->peekfw(U2_FW_REG_LOCK_TIME);
-        uint32_t lock_gpid = this->peekfw(U2_FW_REG_LOCK_GPID);
+        uint32_t lock_time = ops[1].data;
+        uint32_t lock_gpid = ops[2].data;
 
         //may not be the right tick rate, but this is ok for locking purposes
         const uint32_t lock_timeout_time = uint32_t(3*100e6);
 
         //if the difference is larger, assume not locked anymore
         if ((lock_time & 1) == 0) return false; //bit0 says unlocked
-        const uint32_t time_diff = this->get_curr_time() - lock_time;
+        const uint32_t time_diff = (ops[3].data | 1) - lock_time;
         if (time_diff >= lock_timeout_time) return false;
 
         //otherwise only lock if the device hash is different that ours
@@ -118,8 +128,6 @@ public:
     void lock_task(void){
         //re-lock in task
         this->pokefw(U2_FW_REG_LOCK_TIME, this->get_curr_time());
-        //sleep for a bit
-        std::this_thread::sleep_for(std::chrono::milliseconds(1500));
     }
 
     uint32_t get_curr_time(void){
@@ -155,19 +163,86 @@ public:
         return this->get_reg<uint32_t, USRP2_REG_ACTION_FW_PEEK32>(addr);
     }
 
+    void multi_poke32(
+        const std::vector<wb_addr_type> &addrs, const std::vector<uint32_t> &data
+    ){
+        UHD_ASSERT_THROW(addrs.size() == data.size());
+        std::vector<usrp2_reg_op_t> ops(addrs.size());
+        for (size_t i = 0; i < ops.size(); i++){
+            ops[i] = {addrs[i], data[i], USRP2_REG_ACTION_FPGA_POKE32};
+        }
+        this->transact_regs(ops);
+    }
+
+    std::vector<uint32_t> multi_peek32(const std::vector<wb_addr_type> &addrs){
+        std::vector<usrp2_reg_op_t> ops(addrs.size());
+        for (size_t i = 0; i < ops.size(); i++){
+            ops[i] = {addrs[i], 0, USRP2_REG_ACTION_FPGA_PEEK32};
+        }
+        this->transact_regs(ops);
+        std::vector<uint32_t> data(ops.size());
+        for (size_t i = 0; i < ops.size(); i++){
+            data[i] = ops[i].data;
+        }
+        return data;
+    }
+
     template <class T, usrp2_reg_action_t action>
     T get_reg(wb_addr_type addr, T data = 0){
+        return T(this->get_reg(addr, uint32_t(data), action));
+    }
+
+    uint32_t get_reg(wb_addr_type addr, uint32_t data, uint32_t action){
         //setup the out data
         usrp2_ctrl_data_t out_data = usrp2_ctrl_data_t();
         out_data.id = htonl(USRP2_CTRL_ID_GET_THIS_REGISTER_FOR_ME_BRO);
         out_data.data.reg_args.addr = htonl(addr);
-        out_data.data.reg_args.data = htonl(uint32_t(data));
-        out_data.data.reg_args.action = action;
+        out_data.data.reg_args.data = htonl(data);
+        out_data.data.reg_args.action = uint8_t(action);
 
         //send and recv
         usrp2_ctrl_data_t in_data = this->ctrl_send_and_recv(out_data, MIN_PROTO_COMPAT_REG);
         UHD_ASSERT_THROW(ntohl(in_data.id) == USRP2_CTRL_ID_OMG_GOT_REGISTER_SO_BAD_DUDE);
-        return T(ntohl(in_data.data.reg_args.data));
+        return ntohl(in_data.data.reg_args.data);
+    }
+
+    //! Run the register operations in order, fills in the peeked data
+    void transact_regs(std::vector<usrp2_reg_op_t> &ops){
+        for (size_t first = 0; first < ops.size(); first += USRP2_CTRL_MAX_REG_OPS){
+            const size_t num_ops = std::min<size_t>(ops.size() - first, USRP2_CTRL_MAX_REG_OPS);
+            if (_multi_reg_ops and this->transact_regs_multi(&ops[first], num_ops)) continue;
+
+            //the firmware predates multi-register packets, one packet per operation
+            _multi_reg_ops = false;
+            for (size_t i = first; i < ops.size(); i++){
+                ops[i].data = this->get_reg(ops[i].addr, ops[i].data, ops[i].action);
+            }
+            return;
+        }
+    }
+
+    //! \return false if the firmware doesn't know multi-register packets
+    bool transact_regs_multi(usrp2_reg_op_t *ops, const size_t num_ops){
+        //setup the out data
+        usrp2_ctrl_data_t out_data = usrp2_ctrl_data_t();
+        out_data.id = htonl(USRP2_CTRL_ID_GET_THESE_REGISTERS_FOR_ME_BRO);
+        out_data.data.multi_reg_args.num_ops = htonl(uint32_t(num_ops));
+        std::vector<usrp2_reg_op_t> ops_otw(num_ops);
+        for (size_t i = 0; i < num_ops; i++){
+            ops_otw[i].addr = htonl(ops[i].addr);
+            ops_otw[i].data = htonl(ops[i].data);
+            ops_otw[i].action = htonl(ops[i].action);
+        }
+
+        //send and recv
+        usrp2_ctrl_data_t in_data = this->ctrl_send_and_recv(
+            out_data, MIN_PROTO_COMPAT_REG, USRP2_FW_COMPAT_NUM, &ops_otw);
+        if (ntohl(in_data.id) == USRP2_CTRL_ID_HUH_WHAT) return false;
+        UHD_ASSERT_THROW(ntohl(in_data.id) == USRP2_CTRL_ID_OMG_GOT_REGISTERS_SO_BAD_DUDE);
+        for (size_t i = 0; i < num_ops; i++){
+            ops[i].data = ntohl(ops_otw[i].data);
+        }
+        return true;
     }
 
 /***********************************************************************
@@ -244,19 +319,36 @@ public:
         return result;
     }
 
+    //override read_eeprom so we can read as many bytes per transaction as
+    //the control protocol allows, the default reads one byte at a time
+    byte_vector_t read_eeprom(uint16_t addr, uint16_t offset, size_t num_bytes){
+        const size_t max_chunk = sizeof(usrp2_ctrl_data_t().data.i2c_args.data);
+        byte_vector_t bytes;
+        bytes.reserve(num_bytes);
+        while (bytes.size() < num_bytes){
+            const size_t chunk = std::min(max_chunk, num_bytes - bytes.size());
+            this->write_i2c(addr, byte_vector_t(1, uint8_t(offset + bytes.size())));
+            const byte_vector_t result = this->read_i2c(addr, chunk);
+            bytes.insert(bytes.end(), result.begin(), result.end());
+        }
+        return bytes;
+    }
+
 /***********************************************************************
  * Send/Recv over control
  **********************************************************************/
+    //! With \p reg_ops, sends them after the data and replaces them with the reply's
     usrp2_ctrl_data_t ctrl_send_and_recv(
         const usrp2_ctrl_data_t &out_data,
         uint32_t lo = USRP2_FW_COMPAT_NUM,
-        uint32_t hi = USRP2_FW_COMPAT_NUM
+        uint32_t hi = USRP2_FW_COMPAT_NUM,
+        std::vector<usrp2_reg_op_t> *reg_ops = NULL
     ){
         boost::mutex::scoped_lock lock(_ctrl_mutex);
 
         for (size_t i = 0; i < CTRL_RECV_RETRIES; i++){
             try{
-                return ctrl_send_and_recv_internal(out_data, lo, hi, CTRL_RECV_TIMEOUT/CTRL_RECV_RETRIES);
+                return ctrl_send_and_recv_internal(out_data, lo, hi, CTRL_RECV_TIMEOUT/CTRL_RECV_RETRIES, reg_ops);
             }
             catch(const timeout_error &e){
                 UHD_LOGGER_ERROR("USRP2")
@@ -271,13 +363,19 @@ public:
     usrp2_ctrl_data_t ctrl_send_and_recv_internal(
         const usrp2_ctrl_data_t &out_data,
         uint32_t lo, uint32_t hi,
-        const double timeout
+        const double timeout,
+        std::vector<usrp2_reg_op_t> *reg_ops
     ){
+        const size_t reg_ops_len = (reg_ops == NULL)? 0 : reg_ops->size()*sizeof(usrp2_reg_op_t);
+
         //fill in the seq number and send
+        std::vector<uint8_t> out_mem(sizeof(usrp2_ctrl_data_t) + reg_ops_len);
         usrp2_ctrl_data_t out_copy = out_data;
         out_copy.proto_ver = htonl(_protocol_compat);
         out_copy.seq = htonl(++_ctrl_seq_num);
-        _ctrl_transport->send(boost::asio::buffer(&out_copy, sizeof(usrp2_ctrl_data_t)));
+        std::memcpy(out_mem.data(), &out_copy, sizeof(usrp2_ctrl_data_t));
+        if (reg_ops_len) std::memcpy(&out_mem[sizeof(usrp2_ctrl_data_t)], reg_ops->data(), reg_ops_len);
+        _ctrl_transport->send(boost::asio::buffer(out_mem));
 
         //loop until we get the packet or timeout
         uint8_t usrp2_ctrl_data_in_mem[udp_simple::mtu]; //allocate max bytes for recv
@@ -296,6 +394,10 @@ public:
                   % compat % this->images_warn_help_message()));
             }
             if (len >= sizeof(usrp2_ctrl_data_t) and ntohl(ctrl_data_in->seq) == _ctrl_seq_num){
+                if (reg_ops_len and ntohl(ctrl_data_in->id) == USRP2_CTRL_ID_OMG_GOT_REGISTERS_SO_BAD_DUDE){
+                    if (len < sizeof(usrp2_ctrl_data_t) + reg_ops_len) continue; //bad packet
+                    std::memcpy(reg_ops->data(), usrp2_ctrl_data_in_mem + sizeof(usrp2_ctrl_data_t), reg_ops_len);
+                }
                 return *ctrl_data_in;
             }
             if (len == 0) break; //timeout
@@ -407,6 +509,8 @@ private:
     boost::mutex _ctrl_mutex;
     uint32_t _ctrl_seq_num;
     uint32_t _protocol_compat;
+    //cleared when the firmware turns out not to support them
+    bool _multi_reg_ops;
 
     //lock thread stuff
     task::sptr _lock_task;
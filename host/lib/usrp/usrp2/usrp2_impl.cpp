@@ -7,6 +7,7 @@
 #include "usrp2_impl.hpp"
 #include "fw_common.h"
 #include <uhdlib/usrp/common/apply_corrections.hpp>
+#include <uhdlib/usrp/common/eeprom_cache.hpp>
 #include <uhd/utils/log.hpp>
 
 #include <uhd/exception.hpp>
@@ -167,6 +168,8 @@ device_addrs_t usrp2_find(const device_addr_t &hint_){
                 (not hint.has_key("serial") or hint["serial"] == new_addr["serial"])
             ){
                 usrp2_addrs.push_back(new_addr);
+                //serials are unique, no need to wait for more replies
+                if (hint.has_key("serial")) break;
             }
 
             //dont break here, it will exit the while loop
@@ -729,10 +732,14 @@ usrp2_impl::usrp2_impl(const device_addr_t &_device_addr) :
         ////////////////////////////////////////////////////////////////
 
         //read the dboard eeprom to extract the dboard ids
+        //the contents are cached in case the device is made again
+        _mbc[mb].db_eeprom_iface = eeprom_cache_iface::make(_mbc[mb].iface,
+            _mbc[mb].iface->mb_eeprom["serial"],
+            eeprom_cache_iface::DB_EEPROM_CHECK_REGIONS);
         dboard_eeprom_t rx_db_eeprom, tx_db_eeprom, gdb_eeprom;
-        rx_db_eeprom.load(*_mbc[mb].iface, USRP2_I2C_ADDR_RX_DB);
-        tx_db_eeprom.load(*_mbc[mb].iface, USRP2_I2C_ADDR_TX_DB);
-        gdb_eeprom.load(*_mbc[mb].iface, USRP2_I2C_ADDR_TX_DB ^ 5);
+        rx_db_eeprom.load(*_mbc[mb].db_eeprom_iface, USRP2_I2C_ADDR_RX_DB);
+        tx_db_eeprom.load(*_mbc[mb].db_eeprom_iface, USRP2_I2C_ADDR_TX_DB);
+        gdb_eeprom.load(*_mbc[mb].db_eeprom_iface, USRP2_I2C_ADDR_TX_DB ^ 5);
 
         //disable rx dc offset if LFRX
         if (rx_db_eeprom.id == 0x000f) _tree->access<bool>(rx_fe_path / "dc_offset" / "enable").set(false);
@@ -808,9 +815,9 @@ usrp2_impl::~usrp2_impl(void){UHD_SAFE_CALL(
 )}
 
 void usrp2_impl::set_db_eeprom(const std::string &mb, const std::string &type, const uhd::usrp::dboard_eeprom_t &db_eeprom){
-    if (type == "rx") db_eeprom.store(*_mbc[mb].iface, USRP2_I2C_ADDR_RX_DB);
-    if (type == "tx") db_eeprom.store(*_mbc[mb].iface, USRP2_I2C_ADDR_TX_DB);
-    if (type == "gdb") db_eeprom.store(*_mbc[mb].iface, USRP2_I2C_ADDR_TX_DB ^ 5);
+    if (type == "rx") db_eeprom.store(*_mbc[mb].db_eeprom_iface, USRP2_I2C_ADDR_RX_DB);
+    if (type == "tx") db_eeprom.store(*_mbc[mb].db_eeprom_iface, USRP2_I2C_ADDR_TX_DB);
+    if (type == "gdb") db_eeprom.store(*_mbc[mb].db_eeprom_iface, USRP2_I2C_ADDR_TX_DB ^ 5);
 }
 
 sensor_value_t usrp2_impl::get_mimo_locked(const std::string &mb){
@@ -19,6 +19,7 @@
 #include <uhdlib/usrp/cores/time64_core_200.hpp>
 #include <uhdlib/usrp/cores/user_settings_core_200.hpp>
 #include <uhdlib/usrp/cores/gpio_core_200.hpp>
+#include <uhdlib/utils/hashed_dict.hpp>
 #include <uhd/property_tree.hpp>
 #include <uhd/usrp/gps_ctrl.hpp>
 #include <uhd/device.hpp>
@@ -76,6 +77,7 @@ public:
 private:
     struct mb_container_type{
         usrp2_iface::sptr iface;
+        uhd::i2c_iface::sptr db_eeprom_iface;
         usrp2_fifo_ctrl::sptr fifo_ctrl;
         uhd::spi_iface::sptr spiface;
         uhd::timed_wb_iface::sptr wbiface;
@@ -97,7 +99,7 @@ private:
         size_t rx_chan_occ, tx_chan_occ;
         mb_container_type(void): rx_chan_occ(0), tx_chan_occ(0){}
     };
-    uhd::dict<std::string, mb_container_type> _mbc;
+    uhd::hashed_dict<std::string, mb_container_type> _mbc;
 
     void set_mb_eeprom(const std::string &, const uhd::usrp::mboard_eeprom_t &);
     void set_db_eeprom(const std::string &, const std::string &, const uhd::usrp::dboard_eeprom_t &);
@@ -16,6 +16,7 @@
 #include <boost/thread/mutex.hpp>
 
 #include <string.h>
+#include <algorithm>
 #include <map>
 
 /****************************************************************************
@@ -56,12 +57,18 @@ struct uhd_usrp {
 struct uhd_tx_streamer {
     size_t usrp_index;
     uhd::tx_streamer::sptr streamer;
+    //! Cached, so streaming calls don't ask the streamer every time
+    size_t num_channels = 0;
     std::string last_error;
 };
 
 struct uhd_rx_streamer {
     size_t usrp_index;
     uhd::rx_streamer::sptr streamer;
+    //! Cached, so streaming calls don't ask the streamer every time
+    size_t num_channels = 0;
+    //! Reused by recv_raw(), so it doesn't allocate on every call
+    uhd::rx_streamer::raw_buffs_type raw_buffs;
     std::string last_error;
 };
 
@@ -123,11 +130,32 @@ uhd_error uhd_rx_streamer_recv(
     size_t *items_recvd
 ){
     UHD_SAFE_C_SAVE_ERROR(h,
-        uhd::rx_streamer::buffs_type buffs_cpp(buffs, h->streamer->get_num_channels());
+        uhd::rx_streamer::buffs_type buffs_cpp(buffs, h->num_channels);
         *items_recvd = h->streamer->recv(buffs_cpp, samps_per_buff, (*md)->rx_metadata_cpp, timeout, one_packet);
     )
 }
 
+uhd_error uhd_rx_streamer_recv_raw(
+    uhd_rx_streamer_handle h,
+    const void **buffs,
+    uhd_rx_metadata_handle *md,
+    double timeout,
+    size_t *items_recvd
+){
+    UHD_SAFE_C_SAVE_ERROR(h,
+        *items_recvd = h->streamer->recv_raw(h->raw_buffs, (*md)->rx_metadata_cpp, timeout);
+        std::copy(h->raw_buffs.begin(), h->raw_buffs.end(), buffs);
+    )
+}
+
+uhd_error uhd_rx_streamer_release_raw(
+    uhd_rx_streamer_handle h
+){
+    UHD_SAFE_C_SAVE_ERROR(h,
+        h->streamer->release_raw();
+    )
+}
+
 uhd_error uhd_rx_streamer_issue_stream_cmd(
     uhd_rx_streamer_handle h,
     const uhd_stream_cmd_t *stream_cmd
@@ -199,7 +227,7 @@ uhd_error uhd_tx_streamer_send(
     size_t *items_sent
 ){
     UHD_SAFE_C_SAVE_ERROR(h,
-        uhd::tx_streamer::buffs_type buffs_cpp(buffs, h->streamer->get_num_channels());
+        uhd::tx_streamer::buffs_type buffs_cpp(buffs, h->num_channels);
         *items_sent = h->streamer->send(
             buffs_cpp,
             samps_per_buff,
@@ -319,6 +347,7 @@ uhd_error uhd_usrp_get_rx_stream(
 
         usrp_ptr &usrp = get_usrp_ptrs()[h_u->usrp_index];
         h_s->streamer = usrp.ptr->get_rx_stream(stream_args_c_to_cpp(stream_args));
+        h_s->num_channels = h_s->streamer->get_num_channels();
         h_s->usrp_index     = h_u->usrp_index;
     )
 }
@@ -339,6 +368,7 @@ uhd_error uhd_usrp_get_tx_stream(
 
         usrp_ptr &usrp = get_usrp_ptrs()[h_u->usrp_index];
         h_s->streamer = usrp.ptr->get_tx_stream(stream_args_c_to_cpp(stream_args));
+        h_s->num_channels = h_s->streamer->get_num_channels();
         h_s->usrp_index     = h_u->usrp_index;
     )
 }
@@ -6,9 +6,15 @@
 
 #include "x300_claim.hpp"
 #include "x300_fw_common.h"
+#include <uhd/exception.hpp>
+#include <uhd/utils/log.hpp>
 #include <uhd/utils/platform.hpp>
+#include <uhd/utils/tasks.hpp>
+#include <algorithm>
 #include <chrono>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 using namespace uhd;
 using namespace uhd::usrp::x300;
@@ -17,12 +23,6 @@ using namespace uhd::usrp::x300;
  * claimer logic
  **********************************************************************/
 
-void uhd::usrp::x300::claimer_loop(wb_iface::sptr iface)
-{
-    claim(iface);
-    std::this_thread::sleep_for(std::chrono::seconds(1));
-}
-
 claim_status_t uhd::usrp::x300::claim_status(wb_iface::sptr iface)
 {
     claim_status_t claim_status = CLAIMED_BY_OTHER; // Default to most restrictive
@@ -53,8 +53,10 @@ claim_status_t uhd::usrp::x300::claim_status(wb_iface::sptr iface)
 
 void uhd::usrp::x300::claim(wb_iface::sptr iface)
 {
-    iface->poke32(X300_FW_SHMEM_ADDR(X300_FW_SHMEM_CLAIM_TIME), uint32_t(time(NULL)));
-    iface->poke32(X300_FW_SHMEM_ADDR(X300_FW_SHMEM_CLAIM_SRC), get_process_hash());
+    // One firmware transaction for both writes
+    iface->multi_poke32({X300_FW_SHMEM_ADDR(X300_FW_SHMEM_CLAIM_TIME),
+                            X300_FW_SHMEM_ADDR(X300_FW_SHMEM_CLAIM_SRC)},
+        {uint32_t(time(NULL)), get_process_hash()});
 }
 
 bool uhd::usrp::x300::try_to_claim(wb_iface::sptr iface, long timeout_ms)
@@ -87,3 +89,101 @@ void uhd::usrp::x300::release(wb_iface::sptr iface)
     iface->poke32(X300_FW_SHMEM_ADDR(X300_FW_SHMEM_CLAIM_TIME), 0);
     iface->poke32(X300_FW_SHMEM_ADDR(X300_FW_SHMEM_CLAIM_SRC), 0);
 }
+
+/***********************************************************************
+ * claim keeper
+ **********************************************************************/
+namespace {
+
+//! The firmware drops a claim that wasn't renewed for 2 seconds
+constexpr double CLAIM_RENEW_PERIOD = 1.0;
+
+//! Renews the claims of all devices in the process from one periodic task
+class claim_renewer
+{
+public:
+    typedef std::shared_ptr<claim_renewer> sptr;
+
+    //! Keepers hold on to the renewer, so it outlives the last of them
+    static sptr get(void)
+    {
+        static sptr renewer = std::make_shared<claim_renewer>();
+        return renewer;
+    }
+
+    void add(wb_iface::sptr iface)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _ifaces.push_back(iface);
+        if (not _task) {
+            _task = uhd::task::make_periodic(
+                [this]() { this->_renew_all(); }, CLAIM_RENEW_PERIOD, "x300_claimer");
+        }
+    }
+
+    void remove(wb_iface::sptr iface)
+    {
+        uhd::task::sptr task;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _ifaces.erase(std::remove(_ifaces.begin(), _ifaces.end(), iface),
+                _ifaces.end());
+            if (_ifaces.empty()) {
+                task = std::move(_task);
+            }
+        }
+        // Stopping the task waits for a running renewal, which needs the mutex
+        task.reset();
+    }
+
+private:
+    void _renew_all(void)
+    {
+        // Holding the mutex, so no device gets claimed after its keeper is gone
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (const auto& iface : _ifaces) {
+            try {
+                claim(iface);
+            } catch (const uhd::exception& ex) {
+                // Don't let one unreachable device stop the others' renewals
+                UHD_LOG_WARNING(
+                    "X300", "Failed to renew the device claim: " << ex.what());
+            }
+        }
+    }
+
+    std::mutex _mutex;
+    std::vector<wb_iface::sptr> _ifaces;
+    uhd::task::sptr _task;
+};
+
+class claim_keeper_impl : public claim_keeper
+{
+public:
+    claim_keeper_impl(wb_iface::sptr iface)
+        : _renewer(claim_renewer::get()), _iface(iface)
+    {
+        _renewer->add(_iface);
+    }
+
+    ~claim_keeper_impl(void)
+    {
+        _renewer->remove(_iface);
+    }
+
+private:
+    claim_renewer::sptr _renewer;
+    wb_iface::sptr _iface;
+};
+
+} // namespace
+
+claim_keeper::~claim_keeper(void)
+{
+    /* NOP */
+}
+
+claim_keeper::sptr claim_keeper::make(wb_iface::sptr iface)
+{
+    return std::make_shared<claim_keeper_impl>(iface);
+}
@@ -8,6 +8,8 @@
 #define INCLUDED_X300_CLAIM_HPP
 
 #include <uhd/types/wb_iface.hpp>
+#include <uhd/utils/noncopyable.hpp>
+#include <memory>
 
 namespace uhd { namespace usrp { namespace x300 {
 
@@ -15,11 +17,27 @@ namespace uhd { namespace usrp { namespace x300 {
 enum claim_status_t { UNCLAIMED, CLAIMED_BY_US, CLAIMED_BY_OTHER };
 
 claim_status_t claim_status(uhd::wb_iface::sptr iface);
-void claimer_loop(uhd::wb_iface::sptr iface);
 void claim(uhd::wb_iface::sptr iface);
 bool try_to_claim(uhd::wb_iface::sptr iface, long timeout = 2000);
 void release(uhd::wb_iface::sptr iface);
 
+/*! Keeps a device claimed for as long as it exists
+ *
+ * The claims of all devices in the process are renewed together, by one
+ * periodic housekeeping task. Every renewal is a single firmware transaction.
+ * After the keeper is destroyed, the device's claim is no longer renewed.
+ */
+class claim_keeper : uhd::noncopyable
+{
+public:
+    typedef std::shared_ptr<claim_keeper> sptr;
+
+    virtual ~claim_keeper(void) = 0;
+
+    //! Start renewing the claim of the device behind \p iface
+    static sptr make(uhd::wb_iface::sptr iface);
+};
+
 }}} // namespace uhd::usrp::x300
 
 #endif /* INCLUDED_X300_CLAIM_HPP */
@@ -175,6 +175,20 @@ void x300_dboard_iface::write_spi(
     _config.spi->write_spi(int(slave), config, data, num_bits);
 }
 
+void x300_dboard_iface::write_spi_list(unit_t unit,
+    const spi_config_t& config,
+    const std::vector<uint32_t>& data,
+    size_t num_bits)
+{
+    uint32_t slave = 0;
+    if (unit == UNIT_TX)
+        slave |= _config.tx_spi_slaveno;
+    if (unit == UNIT_RX)
+        slave |= _config.rx_spi_slaveno;
+
+    _config.spi->write_spi_list(int(slave), config, data, num_bits);
+}
+
 uint32_t x300_dboard_iface::read_write_spi(
     unit_t unit, const spi_config_t& config, uint32_t data, size_t num_bits)
 {
@@ -37,10 +37,12 @@ public:
         , _blank_eeprom("blank_eeprom", false)
         , _enable_tx_dual_eth("enable_tx_dual_eth", false)
         , _use_dpdk("use_dpdk", false)
+        , _use_xdp("use_xdp", false)
         , _fpga_option("fpga", "")
         , _download_fpga("download-fpga", false)
         , _recv_frame_size("recv_frame_size", DATA_FRAME_MAX_SIZE)
         , _send_frame_size("send_frame_size", DATA_FRAME_MAX_SIZE)
+        , _recv_offload_cpu("recv_offload_cpu", "")
     {
         // nop
     }
@@ -125,6 +127,10 @@ public:
     {
         return _use_dpdk.get();
     }
+    bool get_use_xdp() const
+    {
+        return _use_xdp.get();
+    }
     std::string get_fpga_option() const
     {
         return _fpga_option.get();
@@ -141,6 +147,11 @@ public:
     {
         return _send_frame_size.get();
     }
+    // CPU list or "nic", see uhd::get_cpu_affinity_arg()
+    std::string get_recv_offload_cpu() const
+    {
+        return _recv_offload_cpu.get();
+    }
     device_addr_t get_orig_args() const
     {
         return _orig_args;
@@ -259,10 +270,19 @@ private:
 #else
             UHD_LOG_WARNING("DPDK",
                 "Detected use_dpdk argument, but DPDK support not built in.");
+#endif
+        }
+        if (dev_args.has_key("use_xdp")) {
+#ifdef HAVE_XDP
+            _use_xdp.set(true);
+#else
+            UHD_LOG_WARNING("XDP",
+                "Detected use_xdp argument, but AF_XDP support not built in.");
 #endif
         }
         PARSE_DEFAULT(_recv_frame_size)
         PARSE_DEFAULT(_send_frame_size)
+        PARSE_DEFAULT(_recv_offload_cpu)
 
         // Sanity check params
         _enforce_range(_master_clock_rate, MIN_TICK_RATE, MAX_TICK_RATE);
@@ -291,10 +311,12 @@ private:
     constrained_device_args_t::bool_arg _blank_eeprom;
     constrained_device_args_t::bool_arg _enable_tx_dual_eth;
     constrained_device_args_t::bool_arg _use_dpdk;
+    constrained_device_args_t::bool_arg _use_xdp;
     constrained_device_args_t::str_arg<true> _fpga_option;
     constrained_device_args_t::bool_arg _download_fpga;
     constrained_device_args_t::num_arg<size_t> _recv_frame_size;
     constrained_device_args_t::num_arg<size_t> _send_frame_size;
+    constrained_device_args_t::str_arg<false> _recv_offload_cpu;
 
     device_addr_t _orig_args;
 };
@@ -20,7 +20,12 @@
 #    include <uhdlib/transport/dpdk_simple.hpp>
 #    include <uhdlib/transport/dpdk_zero_copy.hpp>
 #endif
+#ifdef HAVE_XDP
+#    include <uhdlib/transport/xdp_zero_copy.hpp>
+#endif
+#include <uhdlib/transport/udp_hints.hpp>
 #include <uhdlib/usrp/cores/i2c_core_100_wb32.hpp>
+#include <uhdlib/utils/cpu_affinity.hpp>
 #include <boost/asio.hpp>
 #include <string>
 
@@ -161,6 +166,10 @@ device_addrs_t eth_manager::find(const device_addr_t& hint)
             and (not hint.has_key("serial") or hint["serial"] == new_addr["serial"])
             and (not hint.has_key("product") or hint["product"] == new_addr["product"])) {
             addrs.push_back(new_addr);
+            // Serials are unique, no need to wait for more replies
+            if (hint.has_key("serial")) {
+                break;
+            }
         }
     }
 
@@ -216,9 +225,31 @@ both_xports_t eth_manager::make_transport(both_xports_t xports,
                                       ? _next_rx_src_addr
                                       : _next_src_addr;
 
+    // Data transports go to the least loaded link, starting the search at
+    // next_src_addr so equal loads still alternate
+    const bool is_data = xport_type == uhd::usrp::device3_impl::RX_DATA
+                         || xport_type == uhd::usrp::device3_impl::TX_DATA;
+    const uhd::direction_t dir = xport_type == uhd::usrp::device3_impl::TX_DATA
+                                     ? uhd::TX_DIRECTION
+                                     : uhd::RX_DIRECTION;
+    size_t conn_index = next_src_addr;
+    if (xport_type == uhd::usrp::device3_impl::RX_DATA
+        || (xport_type == uhd::usrp::device3_impl::TX_DATA
+               && _args.get_enable_tx_dual_eth())) {
+        std::vector<size_t> candidates;
+        for (size_t i = 0; i < eth_conns.size(); i++) {
+            candidates.push_back((next_src_addr + i) % eth_conns.size());
+        }
+        conn_index = _link_loads.pick(dir, candidates);
+        UHD_LOGGER_DEBUG("X300")
+            << "Assigning data transport to " << eth_conns[conn_index].addr
+            << ", which has " << _link_loads.get_num_xports(conn_index, dir)
+            << " live transport(s) in this direction";
+    }
+
     // Decide on the IP/Interface pair based on the endpoint index
-    x300_eth_conn_t conn         = eth_conns[next_src_addr];
-    const uint32_t xbar_src_addr = next_src_addr == 0 ? x300::SRC_ADDR0 : x300::SRC_ADDR1;
+    x300_eth_conn_t conn         = eth_conns[conn_index];
+    const uint32_t xbar_src_addr = conn_index == 0 ? x300::SRC_ADDR0 : x300::SRC_ADDR1;
     const uint32_t xbar_src_dst  = conn.type == X300_IFACE_ETH0 ? x300::XB_DST_E0
                                                                : x300::XB_DST_E1;
 
@@ -298,6 +329,49 @@ both_xports_t eth_manager::make_transport(both_xports_t xports,
 
 #else
         UHD_LOG_WARNING("X300", "Cannot create DPDK transport, falling back to UDP");
+#endif
+    } else if (_args.get_use_xdp()) {
+#ifdef HAVE_XDP
+        // Like DPDK, the UMEM frames are the only buffering we have
+        default_buff_args.num_recv_frames = ETH_MSG_NUM_FRAMES;
+        default_buff_args.num_send_frames = ETH_MSG_NUM_FRAMES;
+        if (xport_type == uhd::usrp::device3_impl::CTRL) {
+            default_buff_args.num_recv_frames =
+                uhd::rfnoc::CMD_FIFO_SIZE / uhd::rfnoc::MAX_CMD_PKT_SIZE;
+        } else if (xport_type == uhd::usrp::device3_impl::TX_DATA) {
+            size_t default_frame_size = conn.link_rate == MAX_RATE_1GIGE
+                                            ? GE_DATA_FRAME_SEND_SIZE
+                                            : XGE_DATA_FRAME_SEND_SIZE;
+            default_buff_args.send_frame_size = args.cast<size_t>(
+                "send_frame_size", std::min(default_frame_size, send_mtu));
+            default_buff_args.num_send_frames =
+                args.cast<size_t>("num_send_frames", default_buff_args.num_send_frames);
+        } else if (xport_type == uhd::usrp::device3_impl::RX_DATA) {
+            size_t default_frame_size = conn.link_rate == MAX_RATE_1GIGE
+                                            ? GE_DATA_FRAME_RECV_SIZE
+                                            : XGE_DATA_FRAME_RECV_SIZE;
+            default_buff_args.recv_frame_size = args.cast<size_t>(
+                "recv_frame_size", std::min(default_frame_size, recv_mtu));
+            default_buff_args.num_recv_frames =
+                args.cast<size_t>("num_recv_frames", default_buff_args.num_recv_frames);
+        }
+
+        // The transport may reduce the frame sizes to fit its UMEM frames
+        auto recv = transport::xdp_zero_copy::make(conn.addr,
+            BOOST_STRINGIZE(X300_VITA_UDP_PORT),
+            default_buff_args,
+            _args.get_orig_args());
+
+        xports.recv = recv; // Note: This is a type cast!
+        xports.send = xports.recv;
+        xports.recv_buff_size =
+            (recv->get_recv_frame_size() - X300_UDP_RESERVED_FRAME_SIZE)
+            * recv->get_num_recv_frames();
+        xports.send_buff_size =
+            (recv->get_send_frame_size() - X300_UDP_RESERVED_FRAME_SIZE)
+            * recv->get_num_send_frames();
+#else
+        UHD_LOG_WARNING("X300", "Cannot create AF_XDP transport, falling back to UDP");
 #endif
     }
     if (!xports.recv) {
@@ -340,17 +414,33 @@ both_xports_t eth_manager::make_transport(both_xports_t xports,
                 args.cast<size_t>("recv_buff_size", default_buff_args.recv_buff_size);
         }
 
+        device_addr_t hints = get_udp_xport_hints(_args.get_orig_args(),
+            args,
+            xport_type == uhd::usrp::device3_impl::TX_DATA);
+        // The receive offload thread hands the buffers to the streamer thread,
+        // so their reference counts must be atomic
+        if (xport_type == uhd::usrp::device3_impl::RX_DATA
+            and hints.has_key("single_threaded_buffers")) {
+            UHD_LOG_WARNING("X300",
+                "Ignoring single_threaded_buffers for the RX data transport");
+            hints.pop("single_threaded_buffers");
+        }
+
         // make a new transport - fpga has no idea how to talk to us on this yet
         udp_zero_copy::buff_params buff_params;
-        xports.recv = udp_zero_copy::make(conn.addr,
+        udp_zero_copy::sptr udp_xport = udp_zero_copy::make(conn.addr,
             BOOST_STRINGIZE(X300_VITA_UDP_PORT),
             default_buff_args,
-            buff_params);
+            buff_params,
+            hints);
+        xports.recv = udp_xport;
 
         // Create a threaded transport for the receive chain only
         if (xport_type == uhd::usrp::device3_impl::RX_DATA) {
-            xports.recv = zero_copy_recv_offload::make(
-                xports.recv, x300::RECV_OFFLOAD_BUFFER_TIMEOUT);
+            xports.recv = zero_copy_recv_offload::make(xports.recv,
+                x300::RECV_OFFLOAD_BUFFER_TIMEOUT,
+                get_cpu_affinity_arg(
+                    _args.get_recv_offload_cpu(), udp_xport->get_local_addr()));
         }
 
         xports.send = xports.recv;
@@ -373,6 +463,10 @@ both_xports_t eth_manager::make_transport(both_xports_t xports,
     buff->commit(8);
     buff.reset();
 
+    if (is_data) {
+        _link_loads.add_xport(
+            conn_index, dir, dir == uhd::RX_DIRECTION ? xports.recv : xports.send);
+    }
     return xports;
 }
 
@@ -637,6 +731,11 @@ void eth_manager::discover_eth(
     if (eth_conns.size() == 0)
         throw uhd::assertion_error(
             "X300 Initialization Error: No ethernet interfaces specified.");
+
+    _link_loads = uhd::usrp::link_load_balancer();
+    for (const auto& conn : eth_conns) {
+        _link_loads.add_link(conn.link_rate);
+    }
 }
 
 eth_manager::frame_size_t eth_manager::determine_max_frame_size(
@@ -16,6 +16,7 @@
 #include <uhd/transport/udp_zero_copy.hpp>
 #include <uhd/types/device_addr.hpp>
 #include <uhdlib/rfnoc/xports.hpp>
+#include <uhdlib/usrp/common/link_load_balancer.hpp>
 #include <functional>
 #include <vector>
 
@@ -115,6 +116,8 @@ private:
     size_t _next_src_addr    = 0;
     size_t _next_tx_src_addr = 0;
     size_t _next_rx_src_addr = 0;
+    //! Load of the eth_conns, for assigning data transports to them
+    uhd::usrp::link_load_balancer _link_loads;
 
     frame_size_t _max_frame_sizes;
 
@@ -22,7 +22,7 @@ extern "C" {
 #define X300_REVISION_COMPAT 7
 #define X300_REVISION_MIN    2
 #define X300_FW_COMPAT_MAJOR 6
-#define X300_FW_COMPAT_MINOR 0
+#define X300_FW_COMPAT_MINOR 1
 #define X300_FPGA_COMPAT_MAJOR 0x24
 
 //shared memory sections - in between the stack and the program space
@@ -72,6 +72,10 @@ extern "C" {
 #define X300_FW_COMMS_FLAGS_ERROR      (1 << 1)
 #define X300_FW_COMMS_FLAGS_POKE32     (1 << 2)
 #define X300_FW_COMMS_FLAGS_PEEK32     (1 << 3)
+#define X300_FW_COMMS_FLAGS_MULTI      (1 << 4)
+
+//most operations in one multi-operation packet
+#define X300_FW_COMMS_MAX_OPS 64
 
 #define X300_FPGA_PROG_FLAGS_ACK       (1 << 0)
 #define X300_FPGA_PROG_FLAGS_ERROR     (1 << 1)
@@ -123,6 +127,20 @@ typedef struct
     uint32_t data;
 } x300_fw_comms_t;
 
+/*!
+ * A multi-operation packet is a x300_fw_comms_t with the MULTI flag, whose
+ * addr field holds the number of operations, followed by that many
+ * operations. Each operation has the PEEK32 or POKE32 flag, and they run in
+ * order. The reply has the same layout with the peeked data filled in.
+ * Firmware that predates this only replies with the x300_fw_comms_t.
+ */
+typedef struct
+{
+    uint32_t flags;
+    uint32_t addr;
+    uint32_t data;
+} x300_fw_comms_op_t;
+
 typedef struct
 {
     uint32_t flags;
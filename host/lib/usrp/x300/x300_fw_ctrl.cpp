@@ -17,12 +17,24 @@
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/format.hpp>
 #include <boost/thread/mutex.hpp>
+#include <algorithm>
 #include <chrono>
 #include <thread>
 
 using namespace uhd;
 using namespace uhd::niusrprio;
 
+namespace {
+
+//! A multi-operation request or reply, see x300_fw_comms_op_t
+struct x300_fw_comms_multi_t
+{
+    x300_fw_comms_t hdr;
+    x300_fw_comms_op_t ops[X300_FW_COMMS_MAX_OPS];
+};
+
+} // namespace
+
 class x300_ctrl_iface : public wb_iface
 {
 public:
@@ -77,6 +89,31 @@ public:
         return 0;
     }
 
+    void multi_poke32(
+        const std::vector<wb_addr_type>& addrs, const std::vector<uint32_t>& data)
+    {
+        UHD_ASSERT_THROW(addrs.size() == data.size());
+        std::vector<x300_fw_comms_op_t> ops(addrs.size());
+        for (size_t i = 0; i < ops.size(); i++) {
+            ops[i] = {X300_FW_COMMS_FLAGS_POKE32, addrs[i], data[i]};
+        }
+        this->transact(ops);
+    }
+
+    std::vector<uint32_t> multi_peek32(const std::vector<wb_addr_type>& addrs)
+    {
+        std::vector<x300_fw_comms_op_t> ops(addrs.size());
+        for (size_t i = 0; i < ops.size(); i++) {
+            ops[i] = {X300_FW_COMMS_FLAGS_PEEK32, addrs[i], 0};
+        }
+        this->transact(ops);
+        std::vector<uint32_t> data(ops.size());
+        for (size_t i = 0; i < ops.size(); i++) {
+            data[i] = ops[i].data;
+        }
+        return data;
+    }
+
 protected:
     bool errors;
 
@@ -85,7 +122,38 @@ protected:
     virtual void __flush()                                              = 0;
     virtual std::string __loc_info()                                    = 0;
 
+    //! Run the operations in order, fills in the data of the peeks
+    virtual void __transact(x300_fw_comms_op_t* ops, const size_t num_ops)
+    {
+        for (size_t i = 0; i < num_ops; i++) {
+            if (ops[i].flags & X300_FW_COMMS_FLAGS_PEEK32) {
+                ops[i].data = this->__peek32(ops[i].addr);
+            } else {
+                this->__poke32(ops[i].addr, ops[i].data);
+            }
+        }
+    }
+
     boost::mutex reg_access;
+
+private:
+    void transact(std::vector<x300_fw_comms_op_t>& ops)
+    {
+        for (size_t i = 1; i <= num_retries; i++) {
+            boost::mutex::scoped_lock lock(reg_access);
+            try {
+                return this->__transact(ops.data(), ops.size());
+            } catch (const uhd::io_error& ex) {
+                std::string error_msg =
+                    str(boost::format("%s: x300 fw communication failure #%u\n%s")
+                        % __loc_info() % i % ex.what());
+                if (errors)
+                    UHD_LOGGER_ERROR("X300") << error_msg;
+                if (i == num_retries)
+                    throw uhd::io_error(error_msg);
+            }
+        }
+    }
 };
 
 
@@ -96,7 +164,7 @@ class x300_ctrl_iface_enet : public x300_ctrl_iface
 {
 public:
     x300_ctrl_iface_enet(uhd::transport::udp_simple::sptr udp, bool enable_errors = true)
-        : x300_ctrl_iface(enable_errors), udp(udp), seq(0)
+        : x300_ctrl_iface(enable_errors), udp(udp), seq(0), multi_ops(true)
     {
         try {
             this->peek32(0);
@@ -169,6 +237,64 @@ protected:
         return uhd::ntohx<uint32_t>(reply.data);
     }
 
+    virtual void __transact(x300_fw_comms_op_t* ops, const size_t num_ops)
+    {
+        for (size_t first = 0; first < num_ops; first += X300_FW_COMMS_MAX_OPS) {
+            const size_t chunk_size =
+                std::min<size_t>(num_ops - first, X300_FW_COMMS_MAX_OPS);
+            if (not multi_ops or not this->__transact_multi(ops + first, chunk_size)) {
+                // The firmware predates multi-operation packets
+                multi_ops = false;
+                return x300_ctrl_iface::__transact(ops + first, num_ops - first);
+            }
+        }
+    }
+
+    //! \return false if the firmware didn't run the operations
+    bool __transact_multi(x300_fw_comms_op_t* ops, const size_t num_ops)
+    {
+        // load request struct
+        x300_fw_comms_multi_t request = x300_fw_comms_multi_t();
+        request.hdr.flags =
+            uhd::htonx<uint32_t>(X300_FW_COMMS_FLAGS_ACK | X300_FW_COMMS_FLAGS_MULTI);
+        request.hdr.sequence = uhd::htonx<uint32_t>(seq++);
+        request.hdr.addr     = uhd::htonx<uint32_t>(num_ops);
+        for (size_t i = 0; i < num_ops; i++) {
+            request.ops[i].flags = uhd::htonx(ops[i].flags);
+            request.ops[i].addr  = uhd::htonx(ops[i].addr);
+            request.ops[i].data  = uhd::htonx(ops[i].data);
+        }
+        const size_t request_size =
+            sizeof(x300_fw_comms_t) + num_ops * sizeof(x300_fw_comms_op_t);
+
+        // send request
+        __flush();
+        udp->send(boost::asio::buffer(&request, request_size));
+
+        // recv reply
+        x300_fw_comms_multi_t reply = x300_fw_comms_multi_t();
+        const size_t nbytes = udp->recv(boost::asio::buffer(&reply, sizeof(reply)), 1.0);
+        if (nbytes == 0)
+            throw uhd::io_error("x300 fw multi peek/poke - reply timed out");
+
+        // sanity checks
+        const size_t flags = uhd::ntohx<uint32_t>(reply.hdr.flags);
+        UHD_ASSERT_THROW(not(flags & X300_FW_COMMS_FLAGS_ERROR));
+        UHD_ASSERT_THROW(flags & X300_FW_COMMS_FLAGS_ACK);
+        UHD_ASSERT_THROW(reply.hdr.sequence == request.hdr.sequence);
+        if (nbytes == sizeof(x300_fw_comms_t)) {
+            return false;
+        }
+        UHD_ASSERT_THROW(nbytes == request_size);
+
+        // return results!
+        for (size_t i = 0; i < num_ops; i++) {
+            UHD_ASSERT_THROW(reply.ops[i].addr == request.ops[i].addr);
+            ops[i].data = uhd::ntohx<uint32_t>(reply.ops[i].data);
+        }
+        return true;
+    }
+
     virtual void __flush(void)
     {
         char buff[X300_FW_COMMS_MTU] = {};
@@ -184,6 +310,8 @@ protected:
 private:
     uhd::transport::udp_simple::sptr udp;
     size_t seq;
+    //! Cleared when the firmware turns out not to support them
+    bool multi_ops;
 };
 
 
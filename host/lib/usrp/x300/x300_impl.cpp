@@ -21,6 +21,7 @@
 #include <uhd/utils/paths.hpp>
 #include <uhd/utils/safe_call.hpp>
 #include <uhd/utils/static.hpp>
+#include <uhdlib/usrp/common/eeprom_cache.hpp>
 #include <boost/algorithm/string.hpp>
 #include <boost/make_shared.hpp>
 #include <chrono>
@@ -176,33 +177,21 @@ x300_impl::x300_impl(const uhd::device_addr_t& dev_addr) : device3_impl(), _sid_
     const device_addrs_t device_args = separate_device_addr(dev_addr);
     _mb.resize(device_args.size());
 
-    // Serialize the initialization process
-    if (dev_addr.has_key("serialize_init") or device_args.size() == 1) {
-        for (size_t i = 0; i < device_args.size(); i++) {
-            this->setup_mb(i, device_args[i]);
-        }
-        return;
-    }
-
-
-    // Initialize groups of USRPs in parallel
-    size_t total_usrps = device_args.size();
-    size_t num_usrps   = 0;
-    while (num_usrps < total_usrps) {
-        size_t init_usrps = std::min(total_usrps - num_usrps, x300::MAX_INIT_THREADS);
-        boost::thread_group setup_threads;
-        for (size_t i = 0; i < init_usrps; i++) {
-            const size_t index = num_usrps + i;
-            setup_threads.create_thread([this, index, device_args]() {
-                this->setup_mb(index, device_args[index]);
-            });
-        }
-        setup_threads.join_all();
-        num_usrps += init_usrps;
-    }
+    // Initialize the USRPs in parallel, unless serialized. At most
+    // MAX_INIT_THREADS of them are set up at any time, the next one starts as
+    // soon as another one is done.
+    uhd::staged_init init("X300", dev_addr.has_key("serialize_init"));
+    init.run("setup_mb",
+        device_args.size(),
+        [this, &device_args, &init](const size_t mb_i) {
+            this->setup_mb(mb_i, device_args[mb_i], init);
+        },
+        x300::MAX_INIT_THREADS);
+    init.log_report();
 }
 
-void x300_impl::setup_mb(const size_t mb_i, const uhd::device_addr_t& dev_addr)
+void x300_impl::setup_mb(
+    const size_t mb_i, const uhd::device_addr_t& dev_addr, uhd::staged_init& init)
 {
     const fs_path mb_path  = fs_path("/mboards") / mb_i;
     mboard_members_t& mb   = _mb[mb_i];
@@ -228,14 +217,15 @@ void x300_impl::setup_mb(const size_t mb_i, const uhd::device_addr_t& dev_addr)
     if (not try_to_claim(mb.zpu_ctrl)) {
         throw uhd::runtime_error("Failed to claim device");
     }
-    mb.claimer_task =
-        uhd::task::make([&mb]() { claimer_loop(mb.zpu_ctrl); }, "x300_claimer");
+    mb.claimer = claim_keeper::make(mb.zpu_ctrl);
 
     // extract the FW path for the X300
     // and live load fw over ethernet link
     if (mb.args.has_fw_file()) {
         const std::string x300_fw_image = find_image_path(mb.args.get_fw_file());
-        x300_load_fw(mb.zpu_ctrl, x300_fw_image);
+        init.time_step("load_fw", mb_i, [&mb, &x300_fw_image]() {
+            x300_load_fw(mb.zpu_ctrl, x300_fw_image);
+        });
     }
 
     // check compat numbers
@@ -467,11 +457,13 @@ void x300_impl::setup_mb(const size_t mb_i, const uhd::device_addr_t& dev_addr)
 
     //////////////// RFNOC /////////////////
     const size_t n_rfnoc_blocks = mb.zpu_ctrl->peek32(SR_ADDR(SET0_BASE, ZPU_RB_NUM_CE));
-    enumerate_rfnoc_blocks(mb_i,
-        n_rfnoc_blocks,
-        x300::XB_DST_PCI + 1, /* base port */
-        uhd::sid_t(x300::SRC_ADDR0, 0, x300::DST_ADDR + mb_i, 0),
-        dev_addr);
+    init.time_step("enumerate_rfnoc_blocks", mb_i, [&]() {
+        enumerate_rfnoc_blocks(mb_i,
+            n_rfnoc_blocks,
+            x300::XB_DST_PCI + 1, /* base port */
+            uhd::sid_t(x300::SRC_ADDR0, 0, x300::DST_ADDR + mb_i, 0),
+            dev_addr);
+    });
     //////////////// RFNOC /////////////////
 
     // If we have a radio, we must configure its codec control:
@@ -485,36 +477,45 @@ void x300_impl::setup_mb(const size_t mb_i, const uhd::device_addr_t& dev_addr)
             radio_ids.resize(2);
         }
 
-        for (const rfnoc::block_id_t& id : radio_ids) {
-            rfnoc::x300_radio_ctrl_impl::sptr radio(
-                get_block_ctrl<rfnoc::x300_radio_ctrl_impl>(id));
-            mb.radios.push_back(radio);
-            radio->setup_radio(mb.zpu_i2c,
-                mb.clock,
-                mb.args.get_ignore_cal_file(),
-                mb.args.get_self_cal_adc_delay());
-        }
+        init.time_step("setup_radios", mb_i, [&]() {
+            // Reading the dboard EEPROMs over the ZPU I2C master is slow, so
+            // keep their contents around in case the device is made again
+            const i2c_iface::sptr db_i2c = eeprom_cache_iface::make(mb.zpu_i2c,
+                mb_eeprom.get("serial", ""),
+                eeprom_cache_iface::DB_EEPROM_CHECK_REGIONS);
+            for (const rfnoc::block_id_t& id : radio_ids) {
+                rfnoc::x300_radio_ctrl_impl::sptr radio(
+                    get_block_ctrl<rfnoc::x300_radio_ctrl_impl>(id));
+                mb.radios.push_back(radio);
+                radio->setup_radio(db_i2c,
+                    mb.clock,
+                    mb.args.get_ignore_cal_file(),
+                    mb.args.get_self_cal_adc_delay());
+            }
+        });
 
         ////////////////////////////////////////////////////////////////////
         // ADC test and cal
         ////////////////////////////////////////////////////////////////////
-        if (mb.args.get_self_cal_adc_delay()) {
-            rfnoc::x300_radio_ctrl_impl::self_cal_adc_xfer_delay(mb.radios,
-                mb.clock,
-                [this, &mb](const double timeout) {
-                    return this->wait_for_clk_locked(
-                        mb, fw_regmap_t::clk_status_reg_t::LMK_LOCK, timeout);
-                },
-                true /* Apply ADC delay */);
-        }
-        if (mb.args.get_ext_adc_self_test()) {
-            rfnoc::x300_radio_ctrl_impl::extended_adc_test(
-                mb.radios, mb.args.get_ext_adc_self_test_duration());
-        } else {
-            for (size_t i = 0; i < mb.radios.size(); i++) {
-                mb.radios.at(i)->self_test_adc();
+        init.time_step("adc_test_and_cal", mb_i, [&]() {
+            if (mb.args.get_self_cal_adc_delay()) {
+                rfnoc::x300_radio_ctrl_impl::self_cal_adc_xfer_delay(mb.radios,
+                    mb.clock,
+                    [this, &mb](const double timeout) {
+                        return this->wait_for_clk_locked(
+                            mb, fw_regmap_t::clk_status_reg_t::LMK_LOCK, timeout);
+                    },
+                    true /* Apply ADC delay */);
             }
-        }
+            if (mb.args.get_ext_adc_self_test()) {
+                rfnoc::x300_radio_ctrl_impl::extended_adc_test(
+                    mb.radios, mb.args.get_ext_adc_self_test_duration());
+            } else {
+                for (size_t i = 0; i < mb.radios.size(); i++) {
+                    mb.radios.at(i)->self_test_adc();
+                }
+            }
+        });
 
         ////////////////////////////////////////////////////////////////////
         // Synchronize times (dboard initialization can desynchronize them)
@@ -532,10 +533,11 @@ void x300_impl::setup_mb(const size_t mb_i, const uhd::device_addr_t& dev_addr)
 
 x300_impl::~x300_impl(void)
 {
+    release_idle_transports();
     try {
         for (mboard_members_t& mb : _mb) {
-            // kill the claimer task and unclaim the device
-            mb.claimer_task.reset();
+            // stop renewing the claim and unclaim the device
+            mb.claimer.reset();
             if (mb.xport_path == xport_path_t::NIRIO) {
                 std::dynamic_pointer_cast<pcie_manager>(mb.conn_mgr)
                     ->release_ctrl_iface([&mb]() { release(mb.zpu_ctrl); });
@@ -9,6 +9,7 @@
 #ifndef INCLUDED_X300_IMPL_HPP
 #define INCLUDED_X300_IMPL_HPP
 
+#include "x300_claim.hpp"
 #include "x300_clock_ctrl.hpp"
 #include "x300_conn_mgr.hpp"
 #include "x300_defaults.hpp"
@@ -23,6 +24,7 @@
 #include <uhd/usrp/gps_ctrl.hpp>
 #include <uhd/usrp/subdev_spec.hpp>
 #include <uhdlib/usrp/cores/i2c_core_100_wb32.hpp>
+#include <uhdlib/utils/staged_init.hpp>
 #include <atomic>
 #include <memory>
 
@@ -32,7 +34,8 @@ class x300_impl : public uhd::usrp::device3_impl
 {
 public:
     x300_impl(const uhd::device_addr_t&);
-    void setup_mb(const size_t which, const uhd::device_addr_t&);
+    void setup_mb(
+        const size_t which, const uhd::device_addr_t&, uhd::staged_init& init);
     ~x300_impl(void);
 
 protected:
@@ -50,7 +53,7 @@ private:
         uhd::usrp::x300::x300_device_args_t args;
 
         bool initialization_done = false;
-        uhd::task::sptr claimer_task;
+        uhd::usrp::x300::claim_keeper::sptr claimer;
         uhd::usrp::x300::xport_path_t xport_path;
         uhd::device_addr_t send_args;
         uhd::device_addr_t recv_args;
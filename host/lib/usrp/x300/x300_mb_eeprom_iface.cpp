@@ -119,11 +119,18 @@ public:
             if (num_bytes == 0)
                 return bytes;
 
+            // Read all words in one go, that's a single round trip over Ethernet
+            std::vector<wb_iface::wb_addr_type> addrs;
+            for (size_t word = offset / 4; word <= (offset + num_bytes - 1) / 4; word++) {
+                addrs.push_back(X300_FW_SHMEM_ADDR(X300_FW_SHMEM_IDENT + word));
+            }
+            const std::vector<uint32_t> words = _wb->multi_peek32(addrs);
+
             size_t bytes_read = 0;
-            for (size_t word = offset / 4; bytes_read < num_bytes; word++) {
-                uint32_t value =
-                    byteswap(_wb->peek32(X300_FW_SHMEM_ADDR(X300_FW_SHMEM_IDENT + word)));
-                for (size_t byte = offset % 4; byte < 4 and bytes_read < num_bytes;
+            for (size_t word = 0; bytes_read < num_bytes; word++) {
+                uint32_t value = byteswap(words.at(word));
+                for (size_t byte = (word == 0) ? offset % 4 : 0;
+                     byte < 4 and bytes_read < num_bytes;
                      byte++) {
                     bytes.push_back(uint8_t((value >> (byte * 8)) & 0xff));
                     bytes_read++;
@@ -14,11 +14,13 @@
 #include "x310_lvbitx.hpp"
 #include <uhd/transport/nirio_zero_copy.hpp>
 #include <uhd/transport/zero_copy.hpp>
+#include <uhd/transport/zero_copy_recv_offload.hpp>
 #include <uhd/types/device_addr.hpp>
 #include <uhd/utils/byteswap.hpp>
 #include <uhd/utils/log.hpp>
 #include <uhd/utils/static.hpp>
 #include <uhdlib/usrp/cores/i2c_core_100_wb32.hpp>
+#include <uhdlib/utils/cpu_affinity.hpp>
 #include <unordered_map>
 #include <mutex>
 
@@ -46,6 +48,9 @@ constexpr size_t PCIE_MSG_NUM_FRAMES         = 64;
 constexpr size_t PCIE_MAX_MUXED_CTRL_XPORTS  = 32;
 constexpr size_t PCIE_MAX_MUXED_ASYNC_XPORTS = 4;
 constexpr size_t PCIE_MAX_CHANNELS           = 6;
+constexpr uint32_t PCIE_CTRL_CHANNEL         = 0;
+constexpr uint32_t PCIE_ASYNC_MSG_CHANNEL    = 1;
+constexpr uint32_t PCIE_FIRST_DATA_CHANNEL   = 2;
 constexpr size_t MAX_RATE_PCIE               = 800000000; // bytes/s
 }
 
@@ -278,19 +283,16 @@ void pcie_manager::release_ctrl_iface(std::function<void(void)>&& release_fn)
 uint32_t pcie_manager::allocate_pcie_dma_chan(
     const uhd::sid_t& tx_sid, const uhd::usrp::device3_impl::xport_type_t xport_type)
 {
-    constexpr uint32_t CTRL_CHANNEL       = 0;
-    constexpr uint32_t ASYNC_MSG_CHANNEL  = 1;
-    constexpr uint32_t FIRST_DATA_CHANNEL = 2;
     if (xport_type == uhd::usrp::device3_impl::CTRL) {
-        return CTRL_CHANNEL;
+        return PCIE_CTRL_CHANNEL;
     } else if (xport_type == uhd::usrp::device3_impl::ASYNC_MSG) {
-        return ASYNC_MSG_CHANNEL;
+        return PCIE_ASYNC_MSG_CHANNEL;
     } else {
         // sid_t has no comparison defined, so we need to convert it uint32_t
         uint32_t raw_sid = tx_sid.get();
 
         if (_dma_chan_pool.count(raw_sid) == 0) {
-            size_t channel = _dma_chan_pool.size() + FIRST_DATA_CHANNEL;
+            size_t channel = _dma_chan_pool.size() + PCIE_FIRST_DATA_CHANNEL;
             if (channel > PCIE_MAX_CHANNELS) {
                 throw uhd::runtime_error(
                     "Trying to allocate more DMA channels than are available");
@@ -329,6 +331,13 @@ both_xports_t pcie_manager::make_transport(both_xports_t xports,
     xports.endianness              = ENDIANNESS_LITTLE;
     xports.lossless                = true;
     const uint32_t dma_channel_num = allocate_pcie_dma_chan(xports.send_sid, xport_type);
+    // Only the DMA tuning keys, the buffer sizes are already in default_buff_args
+    uhd::device_addr_t data_hints;
+    for (const char* key : {"pcie_poll", "pcie_recv_batch"}) {
+        if (args.has_key(key)) {
+            data_hints[key] = args[key];
+        }
+    }
     if (xport_type == uhd::usrp::device3_impl::CTRL) {
         // Transport for control stream
         if (not _ctrl_dma_xport) {
@@ -358,7 +367,7 @@ both_xports_t pcie_manager::make_transport(both_xports_t xports,
         default_buff_args.recv_frame_size = PCIE_MSG_FRAME_SIZE;
         default_buff_args.num_recv_frames = PCIE_MSG_NUM_FRAMES;
         xports.recv                       = nirio_zero_copy::make(
-            _rio_fpga_interface, dma_channel_num, default_buff_args);
+            _rio_fpga_interface, dma_channel_num, default_buff_args, data_hints);
     } else if (xport_type == uhd::usrp::device3_impl::RX_DATA) {
         default_buff_args.send_frame_size = PCIE_MSG_FRAME_SIZE;
         default_buff_args.num_send_frames = PCIE_MSG_NUM_FRAMES;
@@ -368,7 +377,21 @@ both_xports_t pcie_manager::make_transport(both_xports_t xports,
             args.cast<size_t>("num_recv_frames", PCIE_RX_DATA_NUM_FRAMES);
         default_buff_args.recv_buff_size = args.cast<size_t>("recv_buff_size", 0);
         xports.recv                      = nirio_zero_copy::make(
-            _rio_fpga_interface, dma_channel_num, default_buff_args);
+            _rio_fpga_interface, dma_channel_num, default_buff_args, data_hints);
+
+        // Service the DMA channel from its own thread, if the user placed the
+        // threads. Each channel gets the next CPU of the list, so the channels
+        // of a multi-channel stream don't share a core.
+        const std::vector<size_t> cpus =
+            get_cpu_affinity_arg(_args.get_recv_offload_cpu());
+        if (not cpus.empty()) {
+            const size_t cpu =
+                cpus[(dma_channel_num - PCIE_FIRST_DATA_CHANNEL) % cpus.size()];
+            UHD_LOGGER_DEBUG("X300") << "Servicing PCIe DMA channel " << dma_channel_num
+                                     << " from CPU " << cpu;
+            xports.recv = zero_copy_recv_offload::make(
+                xports.recv, RECV_OFFLOAD_BUFFER_TIMEOUT, {cpu});
+        }
     }
 
     xports.send = xports.recv;
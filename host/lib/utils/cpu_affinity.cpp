@@ -0,0 +1,77 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/transport/if_addrs.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhdlib/utils/cpu_affinity.hpp>
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+#include <fstream>
+
+std::vector<size_t> uhd::parse_cpu_list(const std::string& cpu_list)
+{
+    std::vector<size_t> cpus;
+    std::vector<std::string> entries;
+    const std::string trimmed = boost::algorithm::trim_copy(cpu_list);
+    if (trimmed.empty()) {
+        return cpus;
+    }
+    boost::split(entries, trimmed, boost::is_any_of(":,"));
+    try {
+        for (const std::string& entry : entries) {
+            const size_t dash = entry.find('-');
+            if (dash == std::string::npos) {
+                cpus.push_back(boost::lexical_cast<size_t>(entry));
+                continue;
+            }
+            const size_t first = boost::lexical_cast<size_t>(entry.substr(0, dash));
+            const size_t last  = boost::lexical_cast<size_t>(entry.substr(dash + 1));
+            if (last < first) {
+                throw uhd::value_error("Invalid CPU range: " + entry);
+            }
+            for (size_t cpu = first; cpu <= last; cpu++) {
+                cpus.push_back(cpu);
+            }
+        }
+    } catch (const boost::bad_lexical_cast&) {
+        throw uhd::value_error("Invalid CPU list: " + cpu_list);
+    }
+    return cpus;
+}
+
+std::vector<size_t> uhd::get_net_local_cpus(const std::string& local_addr)
+{
+    for (const auto& if_addr : uhd::transport::get_if_addrs()) {
+        if (if_addr.inet != local_addr or if_addr.name.empty()) {
+            continue;
+        }
+        std::ifstream cpulist("/sys/class/net/" + if_addr.name + "/device/local_cpulist");
+        std::string line;
+        if (cpulist and std::getline(cpulist, line)) {
+            return parse_cpu_list(line);
+        }
+        UHD_LOG_DEBUG(
+            "UHD", "Can't determine the CPUs local to network interface " << if_addr.name);
+        break;
+    }
+    return std::vector<size_t>();
+}
+
+std::vector<size_t> uhd::get_cpu_affinity_arg(
+    const std::string& arg, const std::string& local_addr)
+{
+    if (arg != "nic") {
+        return parse_cpu_list(arg);
+    }
+    const std::vector<size_t> cpus = get_net_local_cpus(local_addr);
+    if (cpus.empty()) {
+        UHD_LOG_WARNING("UHD",
+            "Can't find the CPUs local to the NIC for address "
+                << local_addr << ", leaving the thread affinity alone");
+    }
+    return cpus;
+}
@@ -0,0 +1,149 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/utils/log.hpp>
+#include <uhd/utils/paths.hpp>
+#include <uhdlib/utils/discovery_cache.hpp>
+#include <boost/filesystem.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+using namespace uhd;
+
+namespace {
+//! The keys of a discovered device that are stored in the cache
+const std::vector<std::string> CACHED_KEYS{
+    "type", "serial", "addr", "mgmt_addr", "name", "product"};
+//! The keys of a hint that a cached device has to match
+const std::vector<std::string> MATCH_KEYS{"type", "serial", "name", "product"};
+//! The keys of a hint for which discovery doesn't broadcast
+const std::vector<std::string> ADDR_KEYS{"addr", "mgmt_addr", "resource"};
+
+bool has_addr(const device_addr_t& dev_addr)
+{
+    return (dev_addr.has_key("addr") and not dev_addr["addr"].empty())
+           or (dev_addr.has_key("mgmt_addr") and not dev_addr["mgmt_addr"].empty());
+}
+} // namespace
+
+constexpr char discovery_cache::ENABLE_KEY[];
+
+discovery_cache::discovery_cache(const std::string& path) : _path(path)
+{
+    std::ifstream cache_file(_path);
+    std::string line;
+    while (cache_file and std::getline(cache_file, line)) {
+        const device_addr_t entry(line);
+        if (entry.has_key("serial") and has_addr(entry)) {
+            _entries.push_back(entry);
+        }
+    }
+    UHD_LOG_TRACE("DISCOVERY",
+        "Loaded " << _entries.size() << " cached device(s) from " << _path);
+}
+
+std::string discovery_cache::get_default_path()
+{
+    return (boost::filesystem::path(get_app_path()) / ".uhd" / "discovery_cache")
+        .string();
+}
+
+bool discovery_cache::can_use(const device_addr_t& hint)
+{
+    if (not hint.has_key(ENABLE_KEY)) {
+        return false;
+    }
+    // Multi-device hints carry numbered addresses (addr0, addr1, ...)
+    if (separate_device_addr(hint).size() > 1) {
+        return false;
+    }
+    return std::none_of(ADDR_KEYS.cbegin(),
+        ADDR_KEYS.cend(),
+        [&hint](const std::string& key) { return hint.has_key(key); });
+}
+
+device_addrs_t discovery_cache::get_hints(const device_addr_t& hint) const
+{
+    device_addrs_t hints;
+    for (const device_addr_t& entry : _entries) {
+        const bool matches = std::all_of(MATCH_KEYS.cbegin(),
+            MATCH_KEYS.cend(),
+            [&hint, &entry](const std::string& key) {
+                return not hint.has_key(key) or not entry.has_key(key)
+                       or hint[key] == entry[key];
+            });
+        if (not matches) {
+            continue;
+        }
+        device_addr_t dev_hint = hint;
+        dev_hint["serial"]     = entry["serial"];
+        if (not hint.has_key("type") and entry.has_key("type")) {
+            dev_hint["type"] = entry["type"];
+        }
+        for (const char* key : {"addr", "mgmt_addr"}) {
+            if (entry.has_key(key)) {
+                dev_hint[key] = entry[key];
+            }
+        }
+        hints.push_back(dev_hint);
+    }
+    return hints;
+}
+
+void discovery_cache::add(const device_addrs_t& dev_addrs)
+{
+    for (const device_addr_t& dev_addr : dev_addrs) {
+        if (not dev_addr.has_key("serial") or dev_addr["serial"].empty()
+            or not has_addr(dev_addr)) {
+            continue;
+        }
+        device_addr_t entry;
+        for (const std::string& key : CACHED_KEYS) {
+            if (dev_addr.has_key(key)) {
+                entry[key] = dev_addr[key];
+            }
+        }
+        remove(entry);
+        _entries.push_back(entry);
+    }
+}
+
+void discovery_cache::remove(const device_addr_t& dev_hint)
+{
+    const std::string serial = dev_hint.get("serial", "");
+    _entries.erase(std::remove_if(_entries.begin(),
+                       _entries.end(),
+                       [&serial](const device_addr_t& entry) {
+                           return entry["serial"] == serial;
+                       }),
+        _entries.end());
+}
+
+void discovery_cache::save() const
+{
+    // Write to a temporary file first, so concurrent readers never see a
+    // partially written cache
+    const std::string tmp_path = _path + ".tmp";
+    try {
+        boost::filesystem::create_directories(
+            boost::filesystem::path(_path).parent_path());
+        {
+            std::ofstream cache_file(tmp_path, std::ios::trunc);
+            for (const device_addr_t& entry : _entries) {
+                cache_file << entry.to_string() << std::endl;
+            }
+            if (not cache_file) {
+                throw std::runtime_error("write failed");
+            }
+        }
+        boost::filesystem::rename(tmp_path, _path);
+    } catch (const std::exception& ex) {
+        std::remove(tmp_path.c_str());
+        UHD_LOG_WARNING(
+            "DISCOVERY", "Could not write discovery cache " << _path << ": " << ex.what());
+    }
+}
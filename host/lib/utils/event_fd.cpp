@@ -0,0 +1,114 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhdlib/utils/event_fd.hpp>
+#include <cerrno>
+#include <cstring>
+#include <stdint.h>
+#ifndef _WIN32
+#    include <fcntl.h>
+#    include <unistd.h>
+#endif
+#ifdef HAVE_EVENTFD
+#    include <sys/eventfd.h>
+#endif
+
+using namespace uhd;
+
+#ifdef HAVE_EVENTFD
+event_fd::event_fd(void)
+{
+    // In semaphore mode, every read takes one off the count
+    _read_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK | EFD_SEMAPHORE);
+    if (_read_fd < 0) {
+        throw uhd::os_error(
+            std::string("Could not create an eventfd: ") + std::strerror(errno));
+    }
+    _write_fd = _read_fd;
+}
+
+event_fd::~event_fd(void)
+{
+    ::close(_read_fd);
+}
+
+void event_fd::post(void)
+{
+    const uint64_t one = 1;
+    while (::write(_write_fd, &one, sizeof(one)) < 0 and errno == EINTR) {
+    }
+}
+
+bool event_fd::try_wait(void)
+{
+    uint64_t value;
+    ssize_t ret;
+    while ((ret = ::read(_read_fd, &value, sizeof(value))) < 0 and errno == EINTR) {
+    }
+    return ret == sizeof(value);
+}
+
+#elif !defined(_WIN32)
+// One byte in the pipe per count
+event_fd::event_fd(void)
+{
+    int fds[2];
+    if (::pipe(fds) != 0) {
+        throw uhd::os_error(
+            std::string("Could not create a pipe: ") + std::strerror(errno));
+    }
+    _read_fd  = fds[0];
+    _write_fd = fds[1];
+    for (const int fd : fds) {
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+        ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+}
+
+event_fd::~event_fd(void)
+{
+    ::close(_read_fd);
+    ::close(_write_fd);
+}
+
+void event_fd::post(void)
+{
+    const char one = 1;
+    while (::write(_write_fd, &one, 1) < 0 and errno == EINTR) {
+    }
+}
+
+bool event_fd::try_wait(void)
+{
+    char value;
+    ssize_t ret;
+    while ((ret = ::read(_read_fd, &value, 1)) < 0 and errno == EINTR) {
+    }
+    return ret == 1;
+}
+
+#else
+event_fd::event_fd(void)
+{
+    /* NOP */
+}
+
+event_fd::~event_fd(void)
+{
+    /* NOP */
+}
+
+void event_fd::post(void)
+{
+    /* NOP */
+}
+
+bool event_fd::try_wait(void)
+{
+    return false;
+}
+#endif
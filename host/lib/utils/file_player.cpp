@@ -0,0 +1,650 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/utils/file_player.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhd/utils/thread.hpp>
+#include <uhdlib/transport/spsc_bounded_buffer.hpp>
+#include <uhdlib/utils/cpu_affinity.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/format.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <thread>
+#ifdef _WIN32
+#    include <io.h>
+#else
+#    include <unistd.h>
+#endif
+#ifdef HAVE_MMAP
+#    include <sys/mman.h>
+#endif
+
+using namespace uhd;
+using uhd::transport::spsc_bounded_buffer;
+
+namespace {
+
+constexpr size_t FILE_PLAYER_DEFAULT_BLOCK_SIZE = 1024 * 1024;
+constexpr size_t FILE_PLAYER_DEFAULT_NUM_BLOCKS = 64;
+constexpr size_t FILE_PLAYER_DEFAULT_READAHEAD  = 64 * 1024 * 1024;
+//! How long the prefetch thread sleeps when it is far enough ahead
+constexpr auto FILE_PLAYER_PREFETCH_POLL_INTERVAL = std::chrono::milliseconds(1);
+//! How often a waiting reader thread checks if it should stop, in seconds
+constexpr double FILE_PLAYER_READER_POLL_INTERVAL = 0.1;
+
+/***********************************************************************
+ * Platform file I/O
+ **********************************************************************/
+#ifdef _WIN32
+int sys_open(const std::string& path)
+{
+    return _open(path.c_str(), _O_RDONLY | _O_BINARY);
+}
+
+int64_t sys_read(const int fd, void* buf, const size_t len)
+{
+    return _read(fd, buf, unsigned(len));
+}
+
+int64_t sys_rewind(const int fd)
+{
+    return _lseeki64(fd, 0, SEEK_SET);
+}
+
+int sys_close(const int fd)
+{
+    return _close(fd);
+}
+#else
+int sys_open(const std::string& path)
+{
+    return ::open(path.c_str(), O_RDONLY);
+}
+
+int64_t sys_read(const int fd, void* buf, const size_t len)
+{
+    return ::read(fd, buf, len);
+}
+
+int64_t sys_rewind(const int fd)
+{
+    return ::lseek(fd, 0, SEEK_SET);
+}
+
+int sys_close(const int fd)
+{
+    return ::close(fd);
+}
+#endif
+
+std::string errno_str(const int err)
+{
+    return std::strerror(err);
+}
+
+int open_file(const std::string& path)
+{
+    const int fd = sys_open(path);
+    if (fd < 0) {
+        throw uhd::os_error(
+            str(boost::format("Could not open %s: %s") % path % errno_str(errno)));
+    }
+    return fd;
+}
+
+//! Read exactly \p len bytes
+void read_file(const int fd, char* mem, size_t len)
+{
+    while (len) {
+        const int64_t ret = sys_read(fd, mem, len);
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw uhd::io_error(errno_str(errno));
+        }
+        if (ret == 0) {
+            throw uhd::io_error("Unexpected end of file");
+        }
+        mem += ret;
+        len -= size_t(ret);
+    }
+}
+
+struct file_player_opts
+{
+    bool use_mmap     = false;
+    bool loop         = false;
+    size_t block_size = FILE_PLAYER_DEFAULT_BLOCK_SIZE;
+    size_t num_blocks = FILE_PLAYER_DEFAULT_NUM_BLOCKS;
+    size_t readahead  = FILE_PLAYER_DEFAULT_READAHEAD;
+    bool lock         = false;
+    std::vector<size_t> reader_cpus;
+};
+
+/***********************************************************************
+ * Player for files that are completely in memory: mapped, or read in
+ * once because they fit into the read buffers
+ **********************************************************************/
+class memory_file_player : public file_player
+{
+public:
+    memory_file_player(const std::vector<std::string>& files,
+        const uint64_t size,
+        const file_player_opts& opts)
+        : _size(size), _opts(opts)
+    {
+        if (not _opts.use_mmap) {
+            _load(files);
+            return;
+        }
+        try {
+            _map(files);
+        } catch (...) {
+            _unmap();
+            throw;
+        }
+    }
+
+    ~memory_file_player(void)
+    {
+        _stop = true;
+        if (_prefetch_thread.joinable()) {
+            _prefetch_thread.join();
+        }
+        if (_opts.use_mmap) {
+            _unmap();
+        }
+    }
+
+    size_t get_buffs(std::vector<const void*>& buffs, const double)
+    {
+        if (_done) {
+            return 0;
+        }
+        const size_t num_bytes =
+            size_t(std::min<uint64_t>(_opts.block_size, _size - _pos));
+        if (_prefetch_thread.joinable()
+            and _consumed + num_bytes > _prefetched.load(std::memory_order_acquire)) {
+            _num_waits++;
+        }
+        buffs.resize(_bases.size());
+        for (size_t i = 0; i < _bases.size(); i++) {
+            buffs[i] = _bases[i] + _pos;
+        }
+        return num_bytes;
+    }
+
+    void consume(const size_t num_bytes)
+    {
+        if (num_bytes > _size - _pos) {
+            throw uhd::value_error(
+                "file_player: Consumed more than get_buffs() returned");
+        }
+        _pos += num_bytes;
+        _consumed.store(_consumed.load(std::memory_order_relaxed) + num_bytes,
+            std::memory_order_release);
+        if (_pos == _size) {
+            _pos = 0;
+            if (_opts.loop) {
+                _num_loops++;
+            } else {
+                _done = true;
+            }
+        }
+    }
+
+    bool is_done(void) const
+    {
+        return _done;
+    }
+
+    uint64_t get_size(void) const
+    {
+        return _size;
+    }
+
+    stats_t get_stats(void) const
+    {
+        stats_t stats;
+        stats.bytes_played = _consumed.load(std::memory_order_relaxed) * _bases.size();
+        stats.num_loops    = _num_loops;
+        stats.num_waits    = _num_waits;
+        return stats;
+    }
+
+private:
+    void _map(const std::vector<std::string>& files)
+    {
+#ifdef HAVE_MMAP
+        bool locked = _opts.lock;
+        for (const std::string& file : files) {
+            const int fd = open_file(file);
+            void* base   = mmap(nullptr, size_t(_size), PROT_READ, MAP_SHARED, fd, 0);
+            const int err = errno;
+            sys_close(fd);
+            if (base == MAP_FAILED) {
+                throw uhd::os_error(
+                    str(boost::format("Could not map %s: %s") % file % errno_str(err)));
+            }
+            _bases.push_back(static_cast<const char*>(base));
+            madvise(base, size_t(_size), MADV_SEQUENTIAL);
+            if (locked and mlock(base, size_t(_size))) {
+                UHD_LOG_WARNING("FILE_PLAYER",
+                    "Could not lock " << file << " into memory (" << errno_str(errno)
+                                      << "), prefetching instead.");
+                locked = false;
+            }
+        }
+        if (not locked) {
+            _prefetch_thread = std::thread([this]() { _prefetch(); });
+        }
+#else
+        (void)files;
+#endif
+    }
+
+    void _unmap(void)
+    {
+#ifdef HAVE_MMAP
+        for (const char* base : _bases) {
+            munmap(const_cast<char*>(base), size_t(_size));
+        }
+#endif
+        _bases.clear();
+    }
+
+    //! Read the files into memory, only done if they fit into the read buffers
+    void _load(const std::vector<std::string>& files)
+    {
+        for (const std::string& file : files) {
+            _buffers.emplace_back(size_t(_size));
+            const int fd = open_file(file);
+            try {
+                read_file(fd, _buffers.back().data(), size_t(_size));
+            } catch (const uhd::io_error& ex) {
+                sys_close(fd);
+                throw uhd::io_error(
+                    str(boost::format("Could not read %s: %s") % file % ex.what()));
+            }
+            sys_close(fd);
+            _bases.push_back(_buffers.back().data());
+        }
+    }
+
+#ifdef HAVE_MMAP
+    /*! Fault in the pages ahead of the playback position
+     *
+     * Reading one byte per page maps the page into this process, so send()
+     * finds it in memory and doesn't block on the disk.
+     */
+    void _prefetch(void)
+    {
+        set_thread_affinity(_opts.reader_cpus);
+        const size_t page_size = size_t(sysconf(_SC_PAGESIZE));
+        const uint64_t window  = _opts.loop ? std::min<uint64_t>(_opts.readahead, _size)
+                                           : _opts.readahead;
+        uint64_t prefetched = 0;
+        while (not _stop) {
+            uint64_t target = _consumed.load(std::memory_order_acquire) + window;
+            if (not _opts.loop) {
+                target = std::min(target, _size);
+            }
+            if (prefetched >= target) {
+                if (not _opts.loop and prefetched == _size) {
+                    return;
+                }
+                std::this_thread::sleep_for(FILE_PLAYER_PREFETCH_POLL_INTERVAL);
+                continue;
+            }
+            const uint64_t offset = prefetched % _size;
+            const size_t chunk    = size_t(
+                std::min<uint64_t>(std::min<uint64_t>(_opts.block_size, _size - offset),
+                    target - prefetched));
+            const size_t page_offset = size_t(offset % page_size);
+            for (const char* base : _bases) {
+                const char* start = base + offset - page_offset;
+                madvise(const_cast<char*>(start), chunk + page_offset, MADV_WILLNEED);
+                volatile char sink;
+                for (size_t i = 0; i < chunk + page_offset; i += page_size) {
+                    sink = start[i];
+                }
+                (void)sink;
+            }
+            prefetched += chunk;
+            _prefetched.store(prefetched, std::memory_order_release);
+        }
+    }
+#endif
+
+    const uint64_t _size;
+    const file_player_opts _opts;
+    std::vector<const char*> _bases;
+    std::vector<std::vector<char>> _buffers;
+    //! Position in the current pass
+    uint64_t _pos = 0;
+    bool _done    = false;
+    uint64_t _num_loops = 0;
+    uint64_t _num_waits = 0;
+    //! Bytes per file played back over all passes
+    std::atomic<uint64_t> _consumed{0};
+    //! Bytes per file faulted in over all passes
+    std::atomic<uint64_t> _prefetched{0};
+    std::atomic<bool> _stop{false};
+    std::thread _prefetch_thread;
+};
+
+//! A block of memory and the number of bytes in it. mem == nullptr ends a file.
+struct block_t
+{
+    char* mem  = nullptr;
+    size_t len = 0;
+};
+
+/***********************************************************************
+ * One file and its reader thread:
+ *  - the reader thread pops empty blocks from _free, reads into them and
+ *    pushes them into _full
+ *  - the send thread pops blocks from _full and pushes them back into
+ *    _free once they are played back
+ **********************************************************************/
+class player_file
+{
+public:
+    player_file(const std::string& path,
+        const uint64_t size,
+        const file_player_opts& opts,
+        const std::vector<size_t>& cpus)
+        : _path(path)
+        , _size(size)
+        , _opts(opts)
+        , _cpus(cpus)
+        , _fd(open_file(path))
+        , _mem(opts.block_size * opts.num_blocks)
+        , _free(opts.num_blocks)
+        , _full(opts.num_blocks + 1)
+    {
+        for (size_t i = 0; i < _opts.num_blocks; i++) {
+            block_t block;
+            block.mem = _mem.data() + i * _opts.block_size;
+            _free.push_with_haste(block);
+        }
+        _thread = std::thread([this]() { _run(); });
+    }
+
+    ~player_file(void)
+    {
+        _stop = true;
+        _thread.join();
+        sys_close(_fd);
+    }
+
+    //! Called by the send thread
+    bool get_block(block_t& block, const double timeout, bool& waited)
+    {
+        _check_error();
+        if (_full.pop_with_haste(block)) {
+            return true;
+        }
+        waited = true;
+        if (_full.pop_with_timed_wait(block, timeout)) {
+            return true;
+        }
+        _check_error();
+        return false;
+    }
+
+    //! Called by the send thread
+    void put_block(const block_t& block)
+    {
+        _free.push_with_wait(block);
+    }
+
+    //! Written by the reader thread, read by anybody
+    std::atomic<uint64_t> num_loops{0};
+
+private:
+    void _check_error(void)
+    {
+        if (_failed.load(std::memory_order_acquire)) {
+            throw uhd::io_error(_error);
+        }
+    }
+
+    void _run(void)
+    {
+        set_thread_affinity(_cpus);
+        try {
+            uint64_t pos = 0;
+            block_t block;
+            while (not _stop) {
+                if (not _free.pop_with_timed_wait(
+                        block, FILE_PLAYER_READER_POLL_INTERVAL)) {
+                    continue;
+                }
+                block.len = size_t(std::min<uint64_t>(_opts.block_size, _size - pos));
+                read_file(_fd, block.mem, block.len);
+                _full.push_with_wait(block);
+                pos += block.len;
+                if (pos < _size) {
+                    continue;
+                }
+                if (not _opts.loop) {
+                    _full.push_with_wait(block_t());
+                    return;
+                }
+                if (sys_rewind(_fd) < 0) {
+                    throw uhd::io_error(errno_str(errno));
+                }
+                pos = 0;
+                num_loops.store(num_loops.load(std::memory_order_relaxed) + 1,
+                    std::memory_order_relaxed);
+            }
+        } catch (const std::exception& ex) {
+            _error = str(boost::format("Reading %s failed: %s") % _path % ex.what());
+            _failed.store(true, std::memory_order_release);
+        }
+    }
+
+    const std::string _path;
+    const uint64_t _size;
+    const file_player_opts _opts;
+    const std::vector<size_t> _cpus;
+    const int _fd;
+    std::vector<char> _mem;
+    spsc_bounded_buffer<block_t> _free;
+    spsc_bounded_buffer<block_t> _full;
+    std::thread _thread;
+    std::atomic<bool> _stop{false};
+    std::atomic<bool> _failed{false};
+    std::string _error;
+};
+
+/***********************************************************************
+ * Player that reads ahead on one thread per file
+ **********************************************************************/
+class read_file_player : public file_player
+{
+public:
+    read_file_player(const std::vector<std::string>& files,
+        const uint64_t size,
+        const file_player_opts& opts)
+        : _size(size), _blocks(files.size())
+    {
+        for (size_t i = 0; i < files.size(); i++) {
+            std::vector<size_t> cpus;
+            if (not opts.reader_cpus.empty()) {
+                cpus = {opts.reader_cpus[i % opts.reader_cpus.size()]};
+            }
+            _files.emplace_back(new player_file(files[i], size, opts, cpus));
+        }
+    }
+
+    size_t get_buffs(std::vector<const void*>& buffs, const double timeout)
+    {
+        if (_done) {
+            return 0;
+        }
+        // A previous call may have gotten some of the blocks already
+        bool waited = false;
+        for (size_t i = _num_blocks; i < _files.size(); i++) {
+            const bool got_block = _files[i]->get_block(_blocks[i], timeout, waited);
+            if (waited) {
+                _num_waits++;
+                waited = false;
+            }
+            if (not got_block) {
+                return 0;
+            }
+            _num_blocks++;
+        }
+        // All files end at the same block
+        if (not _blocks[0].mem) {
+            _done = true;
+            return 0;
+        }
+        buffs.resize(_files.size());
+        for (size_t i = 0; i < _files.size(); i++) {
+            buffs[i] = _blocks[i].mem + _offset;
+        }
+        return _blocks[0].len - _offset;
+    }
+
+    void consume(const size_t num_bytes)
+    {
+        if (_num_blocks != _files.size() or num_bytes > _blocks[0].len - _offset) {
+            throw uhd::value_error(
+                "file_player: Consumed more than get_buffs() returned");
+        }
+        _offset += num_bytes;
+        _bytes_played += num_bytes;
+        if (_offset == _blocks[0].len) {
+            for (size_t i = 0; i < _files.size(); i++) {
+                _files[i]->put_block(_blocks[i]);
+            }
+            _num_blocks = 0;
+            _offset     = 0;
+        }
+    }
+
+    bool is_done(void) const
+    {
+        return _done;
+    }
+
+    uint64_t get_size(void) const
+    {
+        return _size;
+    }
+
+    stats_t get_stats(void) const
+    {
+        stats_t stats;
+        stats.bytes_played = _bytes_played * _files.size();
+        // The reader may be a pass ahead, don't count loops that didn't
+        // start playing yet
+        stats.num_loops = std::min(
+            _files[0]->num_loops.load(std::memory_order_relaxed), _bytes_played / _size);
+        stats.num_waits = _num_waits;
+        return stats;
+    }
+
+private:
+    const uint64_t _size;
+    std::vector<std::unique_ptr<player_file>> _files;
+    //! The blocks that are being played back, one per file
+    std::vector<block_t> _blocks;
+    size_t _num_blocks     = 0;
+    size_t _offset         = 0;
+    bool _done             = false;
+    uint64_t _bytes_played = 0;
+    uint64_t _num_waits    = 0;
+};
+
+} // namespace
+
+file_player::~file_player(void)
+{
+    /* NOP */
+}
+
+file_player::sptr file_player::make(const std::vector<std::string>& files,
+    const size_t item_size,
+    const device_addr_t& args)
+{
+    if (files.empty()) {
+        throw uhd::value_error("file_player: No files given");
+    }
+    if (item_size == 0) {
+        throw uhd::value_error("file_player: Item size must be non-zero");
+    }
+
+    file_player_opts opts;
+#ifdef HAVE_MMAP
+    const std::string default_mode = "mmap";
+#else
+    const std::string default_mode = "read";
+#endif
+    const std::string mode = args.get("mode", default_mode);
+    if (mode != "mmap" and mode != "read") {
+        throw uhd::value_error("file_player: Invalid mode: " + mode);
+    }
+    opts.use_mmap = (mode == "mmap");
+#ifndef HAVE_MMAP
+    if (opts.use_mmap) {
+        UHD_LOG_WARNING("FILE_PLAYER",
+            "Memory mapped files are not supported on this platform, using read "
+            "mode.");
+        opts.use_mmap = false;
+    }
+#endif
+    opts.loop       = args.has_key("loop");
+    opts.lock       = args.has_key("lock");
+    opts.num_blocks = args.cast<size_t>("num_blocks", FILE_PLAYER_DEFAULT_NUM_BLOCKS);
+    opts.readahead  = args.cast<size_t>("readahead", FILE_PLAYER_DEFAULT_READAHEAD);
+    opts.reader_cpus = parse_cpu_list(args.get("reader_cpus", ""));
+    if (opts.num_blocks < 2) {
+        throw uhd::value_error("file_player: num_blocks must be at least 2");
+    }
+    const size_t block_size =
+        args.cast<size_t>("block_size", FILE_PLAYER_DEFAULT_BLOCK_SIZE);
+    opts.block_size =
+        std::max<size_t>(1, (block_size + item_size - 1) / item_size) * item_size;
+
+    // Play back whole items, and only as much as the shortest file has
+    uint64_t size = 0;
+    for (size_t i = 0; i < files.size(); i++) {
+        boost::system::error_code ec;
+        const uint64_t file_size = boost::filesystem::file_size(files[i], ec);
+        if (ec) {
+            throw uhd::os_error(
+                str(boost::format("Could not open %s: %s") % files[i] % ec.message()));
+        }
+        if (i > 0 and file_size != size) {
+            UHD_LOG_WARNING("FILE_PLAYER",
+                "The files have different sizes, playing back as much as the "
+                "shortest one has.");
+        }
+        size = (i == 0) ? file_size : std::min(size, file_size);
+    }
+    size -= size % item_size;
+    if (size == 0) {
+        throw uhd::value_error("file_player: The files don't contain a whole item");
+    }
+
+    if (opts.use_mmap
+        or size <= uint64_t(opts.block_size) * uint64_t(opts.num_blocks)) {
+        return sptr(new memory_file_player(files, size, opts));
+    }
+    return sptr(new read_file_player(files, size, opts));
+}
@@ -0,0 +1,701 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/convert.hpp>
+#include <uhd/exception.hpp>
+#include <uhd/utils/file_recorder.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhd/utils/safe_call.hpp>
+#include <uhd/utils/thread.hpp>
+#include <uhdlib/transport/spsc_bounded_buffer.hpp>
+#include <uhdlib/utils/cpu_affinity.hpp>
+#include <boost/format.hpp>
+#include <algorithm>
+#include <atomic>
+#include <complex>
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <thread>
+#ifdef _WIN32
+#    include <io.h>
+#else
+#    include <unistd.h>
+#endif
+#ifdef HAVE_LIBURING
+#    include <liburing.h>
+#endif
+
+using namespace uhd;
+using uhd::transport::spsc_bounded_buffer;
+
+namespace {
+
+constexpr size_t FILE_RECORDER_DEFAULT_BLOCK_SIZE     = 1024 * 1024;
+constexpr size_t FILE_RECORDER_DEFAULT_NUM_BLOCKS     = 64;
+constexpr size_t FILE_RECORDER_DEFAULT_IO_URING_DEPTH = 4;
+//! Alignment of memory, sizes and file offsets for O_DIRECT
+constexpr size_t FILE_RECORDER_DIRECT_IO_ALIGNMENT = 4096;
+
+/***********************************************************************
+ * Platform file I/O
+ **********************************************************************/
+#ifdef _WIN32
+int sys_open(const std::string& path, const bool)
+{
+    return _open(path.c_str(),
+        _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY,
+        _S_IREAD | _S_IWRITE);
+}
+
+int64_t sys_write(const int fd, const void* buf, const size_t len)
+{
+    return _write(fd, buf, unsigned(len));
+}
+
+int sys_truncate(const int fd, const uint64_t len)
+{
+    return _chsize_s(fd, int64_t(len));
+}
+
+int sys_close(const int fd)
+{
+    return _close(fd);
+}
+#else
+int sys_open(const std::string& path, const bool direct_io)
+{
+    int flags = O_WRONLY | O_CREAT | O_TRUNC;
+#    ifdef HAVE_O_DIRECT
+    if (direct_io) {
+        flags |= O_DIRECT;
+    }
+#    else
+    (void)direct_io;
+#    endif
+    return ::open(path.c_str(), flags, 0644);
+}
+
+int64_t sys_write(const int fd, const void* buf, const size_t len)
+{
+    return ::write(fd, buf, len);
+}
+
+int sys_truncate(const int fd, const uint64_t len)
+{
+    return ::ftruncate(fd, off_t(len));
+}
+
+int sys_close(const int fd)
+{
+    return ::close(fd);
+}
+#endif
+
+std::string errno_str(const int err)
+{
+    return std::strerror(err);
+}
+
+size_t gcd(size_t a, size_t b)
+{
+    while (b) {
+        const size_t t = a % b;
+        a              = b;
+        b              = t;
+    }
+    return a;
+}
+
+struct file_recorder_opts
+{
+    size_t block_size     = FILE_RECORDER_DEFAULT_BLOCK_SIZE;
+    size_t num_blocks     = FILE_RECORDER_DEFAULT_NUM_BLOCKS;
+    bool direct_io        = false;
+    bool use_io_uring     = false;
+    size_t io_uring_depth = FILE_RECORDER_DEFAULT_IO_URING_DEPTH;
+    uint64_t preallocate  = 0;
+    bool compress         = false;
+    std::vector<size_t> writer_cpus;
+};
+
+//! A block of memory and the number of bytes in it. mem == nullptr ends a file.
+struct block_t
+{
+    char* mem    = nullptr;
+    size_t len   = 0;
+    size_t index = 0;
+};
+
+/***********************************************************************
+ * One file and its writer thread:
+ *  - the receive thread pops empty blocks from _free and pushes full
+ *    blocks into _full
+ *  - the writer thread writes the full blocks and pushes them back into
+ *    _free
+ **********************************************************************/
+class recorder_file
+{
+public:
+    recorder_file(const std::string& path, const file_recorder_opts& opts)
+        : _path(path)
+        , _opts(opts)
+        , _mem(opts.block_size * opts.num_blocks + FILE_RECORDER_DIRECT_IO_ALIGNMENT)
+        , _free(opts.num_blocks)
+        , _full(opts.num_blocks + 1)
+    {
+        _direct_io = _opts.direct_io;
+        _fd        = sys_open(_path, _direct_io);
+        if (_fd < 0 and _direct_io and errno == EINVAL) {
+            UHD_LOG_WARNING("FILE_RECORDER",
+                "The file system of " << _path
+                                      << " does not support direct I/O, using "
+                                         "buffered writes.");
+            _direct_io = false;
+            _fd        = sys_open(_path, false);
+        }
+        if (_fd < 0) {
+            throw uhd::os_error(str(
+                boost::format("Could not open %s: %s") % _path % errno_str(errno)));
+        }
+        if (_opts.preallocate) {
+            _preallocate();
+        }
+        if (_opts.compress) {
+            uhd::convert::id_type id;
+            id.input_format  = "sc16";
+            id.num_inputs    = 1;
+            id.output_format = "sc16_compressed";
+            id.num_outputs   = 1;
+            _compressor      = uhd::convert::get_converter(id)();
+            _compressed.resize(uhd::convert::get_max_compressed_size(
+                _opts.block_size / sizeof(std::complex<int16_t>)));
+        }
+
+        // The memory is touched here already, so the first pass through the
+        // ring doesn't page fault on the receive thread.
+        const size_t misalign =
+            size_t(_mem.data()) % FILE_RECORDER_DIRECT_IO_ALIGNMENT;
+        _base = _mem.data()
+                + (misalign ? FILE_RECORDER_DIRECT_IO_ALIGNMENT - misalign : 0);
+        for (size_t i = 0; i < _opts.num_blocks; i++) {
+            block_t block;
+            block.mem   = _base + i * _opts.block_size;
+            block.index = i;
+            _free.push_with_haste(block);
+        }
+
+        _thread = std::thread([this]() { _run(); });
+    }
+
+    ~recorder_file(void)
+    {
+        if (_thread.joinable()) {
+            _full.push_with_wait(block_t());
+            _thread.join();
+        }
+        if (_fd >= 0) {
+            sys_close(_fd);
+        }
+    }
+
+    //! Called by the receive thread
+    bool get_block(block_t& block, const double timeout)
+    {
+        _check_error();
+        if (_free.pop_with_haste(block)) {
+            return true;
+        }
+        num_waits++;
+        if (_free.pop_with_timed_wait(block, timeout)) {
+            return true;
+        }
+        _check_error();
+        return false;
+    }
+
+    //! Called by the receive thread
+    void put_block(const block_t& block)
+    {
+        _full.push_with_wait(block);
+        const size_t queued =
+            size_t(++_num_pushed - blocks_written.load(std::memory_order_relaxed));
+        if (queued > max_blocks_queued) {
+            max_blocks_queued = queued;
+        }
+    }
+
+    //! Called by the receive thread, writes the rest and closes the file
+    void close(void)
+    {
+        if (not _thread.joinable()) {
+            return;
+        }
+        _full.push_with_wait(block_t());
+        _thread.join();
+        _check_error();
+        if (_opts.preallocate
+            and sys_truncate(_fd, bytes_written.load(std::memory_order_relaxed))) {
+            throw uhd::io_error(str(boost::format("Could not truncate %s: %s") % _path
+                                    % errno_str(errno)));
+        }
+        const int fd = _fd;
+        _fd          = -1;
+        if (sys_close(fd)) {
+            throw uhd::io_error(
+                str(boost::format("Could not close %s: %s") % _path % errno_str(errno)));
+        }
+    }
+
+    //! Written by the writer thread, read by anybody
+    std::atomic<uint64_t> bytes_written{0};
+    std::atomic<uint64_t> blocks_written{0};
+    //! Only used by the receive thread
+    uint64_t num_waits       = 0;
+    size_t max_blocks_queued = 0;
+
+private:
+    void _preallocate(void)
+    {
+#ifdef HAVE_POSIX_FALLOCATE
+        const int ret = posix_fallocate(_fd, 0, off_t(_opts.preallocate));
+        if (ret) {
+            UHD_LOG_WARNING("FILE_RECORDER",
+                "Could not preallocate " << _path << ": " << errno_str(ret));
+        }
+#else
+        UHD_LOG_WARNING("FILE_RECORDER",
+            "File preallocation is not supported on this platform, ignoring.");
+#endif
+    }
+
+    void _check_error(void)
+    {
+        if (_failed.load(std::memory_order_acquire)) {
+            throw uhd::io_error(_error);
+        }
+    }
+
+    void _fail(const std::string& error)
+    {
+        _error = error;
+        _failed.store(true, std::memory_order_release);
+    }
+
+    void _run(void)
+    {
+        set_thread_affinity(_opts.writer_cpus);
+        try {
+#ifdef HAVE_LIBURING
+            if (_opts.use_io_uring) {
+                _run_io_uring();
+                return;
+            }
+#endif
+            _run_sync();
+        } catch (const std::exception& ex) {
+            _fail(str(boost::format("Writing to %s failed: %s") % _path % ex.what()));
+            // Keep handing back blocks until the end, so the receive thread
+            // sees the error instead of waiting for a free block.
+            block_t block;
+            while (not _got_end) {
+                _full.pop_with_wait(block);
+                if (block.mem) {
+                    _free.push_with_wait(block);
+                } else {
+                    _got_end = true;
+                }
+            }
+        }
+    }
+
+    //! Write all of \p len bytes with write()
+    void _write(const char* mem, size_t len)
+    {
+        while (len) {
+            // The last block of a direct I/O file may have an unaligned size
+            if (_direct_io and len % FILE_RECORDER_DIRECT_IO_ALIGNMENT) {
+                _disable_direct_io();
+            }
+            const int64_t ret = sys_write(_fd, mem, len);
+            if (ret < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw uhd::io_error(errno_str(errno));
+            }
+            mem += ret;
+            len -= size_t(ret);
+        }
+    }
+
+    void _disable_direct_io(void)
+    {
+#ifdef HAVE_O_DIRECT
+        const int flags = fcntl(_fd, F_GETFL);
+        if (flags < 0 or fcntl(_fd, F_SETFL, flags & ~O_DIRECT) < 0) {
+            throw uhd::io_error(errno_str(errno));
+        }
+#endif
+        _direct_io = false;
+    }
+
+    void _run_sync(void)
+    {
+        block_t block;
+        while (true) {
+            _full.pop_with_wait(block);
+            if (not block.mem) {
+                _got_end = true;
+                return;
+            }
+            if (_compressor) {
+                _write_compressed(block);
+            } else {
+                _write(block.mem, block.len);
+                _written(block, block.len);
+            }
+        }
+    }
+
+    //! Compress a block of sc16 samples into _compressed and write that
+    void _write_compressed(const block_t& block)
+    {
+        const size_t num_samps = block.len / sizeof(std::complex<int16_t>);
+        const void* in         = block.mem;
+        void* out              = _compressed.data();
+        _compressor->conv(in, out, num_samps);
+        const size_t len = num_samps ? uhd::convert::get_compressed_size(out) : 0;
+        _write(_compressed.data(), len);
+        _written(block, len);
+    }
+
+#ifdef HAVE_LIBURING
+    /*! Keep up to io_uring_depth writes in flight
+     *
+     * The blocks are registered with the ring as fixed buffers, so the
+     * kernel doesn't have to map them for every write.
+     */
+    void _run_io_uring(void)
+    {
+        struct io_uring ring;
+        int ret = io_uring_queue_init(unsigned(_opts.io_uring_depth), &ring, 0);
+        if (ret < 0) {
+            throw uhd::os_error("Could not create io_uring: " + errno_str(-ret));
+        }
+        std::shared_ptr<void> ring_guard(nullptr, [&ring](void*) {
+            io_uring_queue_exit(&ring);
+        });
+        std::vector<iovec> iovs(_opts.num_blocks);
+        for (size_t i = 0; i < _opts.num_blocks; i++) {
+            iovs[i].iov_base = _base + i * _opts.block_size;
+            iovs[i].iov_len  = _opts.block_size;
+        }
+        ret = io_uring_register_buffers(&ring, iovs.data(), unsigned(iovs.size()));
+        if (ret < 0) {
+            throw uhd::os_error(
+                "Could not register buffers with io_uring: " + errno_str(-ret));
+        }
+
+        block_t block;
+        std::vector<block_t> in_flight(_opts.num_blocks);
+        size_t num_in_flight = 0;
+        uint64_t offset      = 0;
+        bool done            = false;
+        while (not done or num_in_flight) {
+            // Submit what is there, and only wait for new blocks if there is
+            // no write to wait for
+            if (not done and num_in_flight < _opts.io_uring_depth
+                and (num_in_flight ? _full.pop_with_haste(block)
+                                   : (_full.pop_with_wait(block), true))) {
+                if (not block.mem) {
+                    _got_end = true;
+                    done     = true;
+                    continue;
+                }
+                // An unaligned tail can't be written with direct I/O
+                if (_direct_io and block.len % FILE_RECORDER_DIRECT_IO_ALIGNMENT) {
+                    _reap_all(ring, in_flight, num_in_flight);
+                    _disable_direct_io();
+                }
+                struct io_uring_sqe* sqe = io_uring_get_sqe(&ring);
+                io_uring_prep_write_fixed(sqe,
+                    _fd,
+                    block.mem,
+                    unsigned(block.len),
+                    offset,
+                    int(block.index));
+                io_uring_sqe_set_data(sqe, reinterpret_cast<void*>(block.index));
+                ret = io_uring_submit(&ring);
+                if (ret < 0) {
+                    throw uhd::io_error("io_uring submit error: " + errno_str(-ret));
+                }
+                in_flight[block.index] = block;
+                offset += block.len;
+                num_in_flight++;
+                continue;
+            }
+            _reap(ring, in_flight, num_in_flight);
+        }
+    }
+
+    //! Wait for one write to complete
+    void _reap(
+        struct io_uring& ring, std::vector<block_t>& in_flight, size_t& num_in_flight)
+    {
+        struct io_uring_cqe* cqe = nullptr;
+        const int ret            = io_uring_wait_cqe(&ring, &cqe);
+        if (ret == -EINTR) {
+            return;
+        }
+        if (ret < 0) {
+            throw uhd::io_error("io_uring wait error: " + errno_str(-ret));
+        }
+        const size_t index = size_t(io_uring_cqe_get_data(cqe));
+        const int res      = cqe->res;
+        io_uring_cqe_seen(&ring, cqe);
+        if (res < 0) {
+            throw uhd::io_error(errno_str(-res));
+        }
+        const block_t block = in_flight[index];
+        if (size_t(res) != block.len) {
+            throw uhd::io_error(str(
+                boost::format("Short write (%d of %d bytes)") % res % block.len));
+        }
+        num_in_flight--;
+        _written(block, block.len);
+    }
+
+    void _reap_all(
+        struct io_uring& ring, std::vector<block_t>& in_flight, size_t& num_in_flight)
+    {
+        while (num_in_flight) {
+            _reap(ring, in_flight, num_in_flight);
+        }
+    }
+#endif
+
+    void _written(const block_t& block, const size_t num_bytes)
+    {
+        bytes_written.store(
+            bytes_written.load(std::memory_order_relaxed) + num_bytes,
+            std::memory_order_relaxed);
+        blocks_written.store(blocks_written.load(std::memory_order_relaxed) + 1,
+            std::memory_order_relaxed);
+        _free.push_with_wait(block);
+    }
+
+    const std::string _path;
+    const file_recorder_opts _opts;
+    int _fd         = -1;
+    bool _direct_io = false;
+    std::vector<char> _mem;
+    char* _base = nullptr;
+    spsc_bounded_buffer<block_t> _free;
+    spsc_bounded_buffer<block_t> _full;
+    uint64_t _num_pushed = 0;
+    std::thread _thread;
+    //! Only used by the writer thread
+    bool _got_end = false;
+    uhd::convert::converter::sptr _compressor;
+    std::vector<char> _compressed;
+    std::atomic<bool> _failed{false};
+    std::string _error;
+};
+
+/***********************************************************************
+ * File recorder implementation
+ **********************************************************************/
+class file_recorder_impl : public file_recorder
+{
+public:
+    file_recorder_impl(const std::vector<std::string>& files,
+        const size_t item_size,
+        const device_addr_t& args)
+    {
+        if (files.empty()) {
+            throw uhd::value_error("file_recorder: No files given");
+        }
+        if (item_size == 0) {
+            throw uhd::value_error("file_recorder: Item size must be non-zero");
+        }
+
+        file_recorder_opts opts;
+        opts.num_blocks =
+            args.cast<size_t>("num_blocks", FILE_RECORDER_DEFAULT_NUM_BLOCKS);
+        opts.direct_io    = args.has_key("direct_io");
+        opts.use_io_uring = args.has_key("io_uring");
+        opts.io_uring_depth =
+            args.cast<size_t>("io_uring_depth", FILE_RECORDER_DEFAULT_IO_URING_DEPTH);
+        opts.preallocate = args.cast<uint64_t>("preallocate", 0);
+        opts.compress    = args.has_key("compress");
+        if (opts.num_blocks < 2 or opts.io_uring_depth == 0) {
+            throw uhd::value_error(
+                "file_recorder: num_blocks must be at least 2 and io_uring_depth "
+                "at least 1");
+        }
+        opts.io_uring_depth = std::min(opts.io_uring_depth, opts.num_blocks);
+#ifndef HAVE_O_DIRECT
+        if (opts.direct_io) {
+            UHD_LOG_WARNING("FILE_RECORDER",
+                "Direct I/O is not supported on this platform, ignoring direct_io.");
+            opts.direct_io = false;
+        }
+#endif
+        if (opts.compress) {
+            if (item_size != sizeof(std::complex<int16_t>)) {
+                throw uhd::value_error("file_recorder: compress requires sc16 items");
+            }
+            // Compressed blocks have arbitrary sizes, they can't be written
+            // with direct I/O or from the registered buffers
+            if (opts.direct_io or opts.use_io_uring) {
+                UHD_LOG_WARNING("FILE_RECORDER",
+                    "direct_io and io_uring can't be used with compress, ignoring.");
+                opts.direct_io    = false;
+                opts.use_io_uring = false;
+            }
+        }
+#ifndef HAVE_LIBURING
+        if (opts.use_io_uring) {
+            UHD_LOG_WARNING("FILE_RECORDER",
+                "UHD was built without io_uring support, ignoring io_uring.");
+            opts.use_io_uring = false;
+        }
+#endif
+
+        // Blocks hold whole items, and keep the file offsets aligned for
+        // direct I/O
+        const size_t alignment =
+            item_size / gcd(item_size, FILE_RECORDER_DIRECT_IO_ALIGNMENT)
+            * FILE_RECORDER_DIRECT_IO_ALIGNMENT;
+        const size_t block_size =
+            args.cast<size_t>("block_size", FILE_RECORDER_DEFAULT_BLOCK_SIZE);
+        opts.block_size = std::max<size_t>(1, (block_size + alignment - 1) / alignment)
+                          * alignment;
+        _block_size = opts.block_size;
+
+        const std::vector<size_t> writer_cpus =
+            parse_cpu_list(args.get("writer_cpus", ""));
+        for (size_t i = 0; i < files.size(); i++) {
+            if (not writer_cpus.empty()) {
+                opts.writer_cpus = {writer_cpus[i % writer_cpus.size()]};
+            }
+            _files.emplace_back(new recorder_file(files[i], opts));
+        }
+        _blocks.resize(files.size());
+    }
+
+    ~file_recorder_impl(void)
+    {
+        UHD_SAFE_CALL(close();)
+    }
+
+    size_t get_buffs(std::vector<void*>& buffs, const double timeout)
+    {
+        if (_closed) {
+            throw uhd::runtime_error("file_recorder: get_buffs() after close()");
+        }
+        // A previous call may have gotten some of the blocks already
+        for (size_t i = _num_blocks; i < _files.size(); i++) {
+            if (not _files[i]->get_block(_blocks[i], timeout)) {
+                return 0;
+            }
+            _num_blocks++;
+        }
+        buffs.resize(_files.size());
+        for (size_t i = 0; i < _files.size(); i++) {
+            buffs[i] = _blocks[i].mem + _fill;
+        }
+        return _block_size - _fill;
+    }
+
+    void commit(const size_t num_bytes)
+    {
+        if (num_bytes > _block_size - _fill or _num_blocks != _files.size()) {
+            throw uhd::value_error("file_recorder: Commit without matching buffers");
+        }
+        _fill += num_bytes;
+        if (_fill == _block_size) {
+            _flush();
+        }
+    }
+
+    void close(void)
+    {
+        if (_closed) {
+            return;
+        }
+        _closed = true;
+        if (_fill) {
+            _flush();
+        }
+        // Close all files, even if one fails
+        std::string error;
+        for (auto& file : _files) {
+            try {
+                file->close();
+            } catch (const uhd::exception& ex) {
+                error = ex.what();
+            }
+        }
+        if (not error.empty()) {
+            throw uhd::io_error(error);
+        }
+    }
+
+    size_t get_block_size(void) const
+    {
+        return _block_size;
+    }
+
+    stats_t get_stats(void) const
+    {
+        stats_t stats;
+        for (const auto& file : _files) {
+            stats.bytes_written += file->bytes_written.load(std::memory_order_relaxed);
+            stats.blocks_written += file->blocks_written.load(std::memory_order_relaxed);
+            stats.num_waits += file->num_waits;
+            stats.max_blocks_queued =
+                std::max(stats.max_blocks_queued, file->max_blocks_queued);
+        }
+        return stats;
+    }
+
+private:
+    void _flush(void)
+    {
+        for (size_t i = 0; i < _files.size(); i++) {
+            _blocks[i].len = _fill;
+            _files[i]->put_block(_blocks[i]);
+        }
+        _num_blocks = 0;
+        _fill       = 0;
+    }
+
+    size_t _block_size = 0;
+    std::vector<std::unique_ptr<recorder_file>> _files;
+    //! The blocks that are being filled, one per file
+    std::vector<block_t> _blocks;
+    size_t _num_blocks = 0;
+    size_t _fill       = 0;
+    bool _closed       = false;
+};
+
+} // namespace
+
+file_recorder::~file_recorder(void)
+{
+    /* NOP */
+}
+
+file_recorder::sptr file_recorder::make(const std::vector<std::string>& files,
+    const size_t item_size,
+    const device_addr_t& args)
+{
+    return sptr(new file_recorder_impl(files, item_size, args));
+}
@@ -10,18 +10,12 @@
 #include <uhd/types/dict.hpp>
 #include <uhd/utils/algorithm.hpp>
 #include <uhd/exception.hpp>
-#include <boost/bind.hpp>
 #include <algorithm>
+#include <mutex>
 #include <vector>
 
 using namespace uhd;
 
-static bool compare_by_step_size(
-    const size_t &rhs, const size_t &lhs, std::vector<gain_fcns_t> &fcns
-){
-    return fcns.at(rhs).get_range().step() > fcns.at(lhs).get_range().step();
-}
-
 /*!
  * Get a multiple of step with the following relation:
  *     result = step*floor(num/step)
@@ -89,46 +83,27 @@ public:
     void set_value(double gain, const std::string &name){
         if (not name.empty()) return _name_to_fcns.get(name).set_value(gain);
 
-        std::vector<gain_fcns_t> all_fcns = get_all_fcns();
-        if (all_fcns.size() == 0) return; //nothing to set!
-
-        //get the max step size among the gains
-        double max_step = 0;
-        for(const gain_fcns_t &fcns:  all_fcns){
-            max_step = std::max(max_step, fcns.get_range().step());
-        }
+        std::lock_guard<std::mutex> lock(_plan_mutex);
+        const plan_t &plan = get_plan();
+        if (plan.fcns.size() == 0) return; //nothing to set!
 
         //create gain bucket to distribute power
         std::vector<double> gain_bucket;
+        gain_bucket.reserve(plan.fcns.size());
 
         //distribute power according to priority (round to max step)
         double gain_left_to_distribute = gain;
-        for(const gain_fcns_t &fcns:  all_fcns){
-            const gain_range_t range = fcns.get_range();
+        for(const gain_range_t &range:  plan.ranges){
             gain_bucket.push_back(floor_step(uhd::clip(
                 gain_left_to_distribute, range.start(), range.stop()
-            ), max_step));
+            ), plan.max_step));
             gain_left_to_distribute -= gain_bucket.back();
         }
 
-        //get a list of indexes sorted by step size large to small
-        std::vector<size_t> indexes_step_size_dec;
-        for (size_t i = 0; i < all_fcns.size(); i++){
-            indexes_step_size_dec.push_back(i);
-        }
-        std::sort(
-            indexes_step_size_dec.begin(), indexes_step_size_dec.end(),
-            boost::bind(&compare_by_step_size, _1, _2, all_fcns)
-        );
-        UHD_ASSERT_THROW(
-            all_fcns.at(indexes_step_size_dec.front()).get_range().step() >=
-            all_fcns.at(indexes_step_size_dec.back()).get_range().step()
-        );
-
         //distribute the remainder (less than max step)
         //fill in the largest step sizes first that are less than the remainder
-        for(size_t i:  indexes_step_size_dec){
-            const gain_range_t range = all_fcns.at(i).get_range();
+        for(size_t i:  plan.indexes_step_size_dec){
+            const gain_range_t &range = plan.ranges.at(i);
             double additional_gain = floor_step(uhd::clip(
                 gain_bucket.at(i) + gain_left_to_distribute, range.start(), range.stop()
             ), range.step()) - gain_bucket.at(i);
@@ -140,7 +115,7 @@ public:
         //now write the bucket out to the individual gain values
         for (size_t i = 0; i < gain_bucket.size(); i++){
             UHD_LOGGER_DEBUG("UHD") << i << ": " << gain_bucket.at(i) ;
-            all_fcns.at(i).set_value(gain_bucket.at(i));
+            plan.fcns.at(i).set_value(gain_bucket.at(i));
         }
     }
 
@@ -159,9 +134,70 @@ public:
         }
         _registry[priority].push_back(gain_fcns);
         _name_to_fcns[name] = gain_fcns;
+        std::lock_guard<std::mutex> lock(_plan_mutex);
+        _plan.fcns.clear();
     }
 
 private:
+    /*!
+     * How set_value() distributes gain: the gain elements in order, their
+     * ranges, and the order in which the remainder is filled in. Rebuilding
+     * this needs a lot of get_range() calls, so it is kept until an element
+     * is registered or a range changes.
+     */
+    struct plan_t{
+        std::vector<gain_fcns_t> fcns;
+        std::vector<gain_range_t> ranges;
+        //! indexes sorted by step size large to small
+        std::vector<size_t> indexes_step_size_dec;
+        //! the max step size among the gains
+        double max_step = 0;
+    };
+
+    //! Get the distribution plan, updated to the current ranges
+    const plan_t &get_plan(void){
+        if (_plan.fcns.empty()){
+            _plan.fcns = get_all_fcns();
+            _plan.ranges.clear();
+        }
+
+        //read each range once, and only redo the rest if one of them changed
+        bool ranges_changed = _plan.ranges.size() != _plan.fcns.size();
+        _plan.ranges.resize(_plan.fcns.size());
+        for (size_t i = 0; i < _plan.fcns.size(); i++){
+            const gain_range_t range = _plan.fcns.at(i).get_range();
+            if (ranges_changed or not (range == _plan.ranges.at(i))){
+                _plan.ranges.at(i) = range;
+                ranges_changed = true;
+            }
+        }
+        if (not ranges_changed) return _plan;
+
+        _plan.max_step = 0;
+        for(const gain_range_t &range:  _plan.ranges){
+            _plan.max_step = std::max(_plan.max_step, range.step());
+        }
+
+        _plan.indexes_step_size_dec.clear();
+        for (size_t i = 0; i < _plan.ranges.size(); i++){
+            _plan.indexes_step_size_dec.push_back(i);
+        }
+        const std::vector<gain_range_t> &ranges = _plan.ranges;
+        std::sort(
+            _plan.indexes_step_size_dec.begin(), _plan.indexes_step_size_dec.end(),
+            [&ranges](const size_t rhs, const size_t lhs){
+                return ranges.at(rhs).step() > ranges.at(lhs).step();
+            }
+        );
+        if (not _plan.indexes_step_size_dec.empty()){
+            UHD_ASSERT_THROW(
+                ranges.at(_plan.indexes_step_size_dec.front()).step() >=
+                ranges.at(_plan.indexes_step_size_dec.back()).step()
+            );
+        }
+        return _plan;
+    }
+
     //! get the gain function sets in order (highest priority first)
     std::vector<gain_fcns_t> get_all_fcns(void){
         std::vector<gain_fcns_t> all_fcns;
@@ -174,6 +210,8 @@ private:
 
     uhd::dict<size_t, std::vector<gain_fcns_t> > _registry;
     uhd::dict<std::string, gain_fcns_t> _name_to_fcns;
+    std::mutex _plan_mutex;
+    plan_t _plan;
 };
 
 /***********************************************************************
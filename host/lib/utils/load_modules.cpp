@@ -5,12 +5,15 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 //
 
+#include <uhd/utils/log.hpp>
 #include <uhd/utils/paths.hpp>
-#include <uhd/utils/static.hpp>
 #include <uhd/exception.hpp>
+#include <uhdlib/utils/load_modules.hpp>
 #include <boost/format.hpp>
 #include <boost/filesystem.hpp>
+#include <chrono>
 #include <iostream>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -59,39 +62,54 @@ static void load_module(const std::string &file_name){
  * This will recurse into sub-directories.
  * Does not throw, prints to std error.
  * \param path the filesystem path
+ * \return the number of modules loaded
  */
-static void load_module_path(const fs::path &path){
+static size_t load_module_path(const fs::path &path){
     if (not fs::exists(path)){
         //std::cerr << boost::format("Module path \"%s\" not found.") % path.string() << std::endl;
-        return;
+        return 0;
     }
 
     //try to load the files in this path
     if (fs::is_directory(path)){
+        size_t num_loaded = 0;
         for(
             fs::directory_iterator dir_itr(path);
             dir_itr != fs::directory_iterator();
             ++dir_itr
         ){
-            load_module_path(dir_itr->path());
+            num_loaded += load_module_path(dir_itr->path());
         }
-        return;
+        return num_loaded;
     }
 
     //its not a directory, try to load it
     try{
         load_module(path.string());
+        return 1;
     }
     catch(const std::exception &err){
         std::cerr << boost::format("Error: %s") % err.what() << std::endl;
     }
+    return 0;
 }
 
 /*!
  * Load all the modules given in the module paths.
+ * This used to happen when the library was loaded, which made every process
+ * pay for scanning the module paths, whether it used a device or not.
  */
-UHD_STATIC_BLOCK(load_modules){
-    for(const fs::path &path:  uhd::get_module_paths()){
-        load_module_path(path);
-    }
+void uhd::load_modules(void){
+    static std::once_flag modules_loaded;
+    std::call_once(modules_loaded, [](){
+        const auto start = std::chrono::steady_clock::now();
+        size_t num_loaded = 0;
+        for(const fs::path &path:  uhd::get_module_paths()){
+            num_loaded += load_module_path(path);
+        }
+        UHD_LOG_DEBUG("UHD", "Loaded " << num_loaded << " module(s) in "
+            << std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::steady_clock::now() - start).count() / 1000.0
+            << " ms");
+    });
 }
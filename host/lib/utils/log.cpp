@@ -6,15 +6,17 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 //
 
-#include <uhd/transport/bounded_buffer.hpp>
 #include <uhd/utils/log.hpp>
 #include <uhd/utils/log_add.hpp>
 #include <uhd/utils/paths.hpp>
 #include <uhd/utils/static.hpp>
 #include <uhd/version.hpp>
 #include <uhdlib/utils/isatty.hpp>
+#include <uhdlib/utils/per_thread_queue.hpp>
+#include <uhdlib/utils/trace.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/make_shared.hpp>
+#include <algorithm>
 #include <atomic>
 #include <cctype>
 #include <fstream>
@@ -24,6 +26,10 @@
 
 namespace pt                  = boost::posix_time;
 constexpr double READ_TIMEOUT = 0.5; // Waiting time to read from the queue
+// Number of log records / fastpath messages each thread can queue before
+// further ones are dropped
+constexpr size_t LOG_QUEUE_SIZE      = 256;
+constexpr size_t FASTPATH_QUEUE_SIZE = 256;
 
 // Don't make these static const std::string -- we need their lifetime guaranteed!
 #define PURPLE "\033[0;35m" // purple
@@ -180,10 +186,10 @@ public:
         , _exit(false)
         ,
 #ifndef UHD_LOG_FASTPATH_DISABLE
-        _fastpath_queue(10)
+        _fastpath_queue(FASTPATH_QUEUE_SIZE)
         ,
 #endif
-        _log_queue(10)
+        _log_queue(LOG_QUEUE_SIZE)
     {
         // allow override from macro definition
 #ifdef UHD_LOG_MIN_LEVEL
@@ -228,10 +234,9 @@ public:
             _pop_fastpath_task = std::make_shared<std::thread>(
                 std::thread([this]() { this->pop_fastpath_task(); }));
         } else {
-            _pop_fastpath_task = std::make_shared<std::thread>(
-                std::thread([this]() { this->pop_fastpath_dummy_task(); }));
             _publish_log_msg("Fastpath logging disabled at runtime.");
         }
+        _fastpath_enabled = enable_fastpath;
 #else
         {
             _publish_log_msg("Fastpath logging disabled at compile time.");
@@ -242,24 +247,10 @@ public:
     ~log_resource(void)
     {
         _exit = true;
-
-#ifndef BOOST_MSVC // push a final message is required, since the pop_with_wait() function
-                   // will be used.
-        // We push a final message to kick the pop task out of it's wait state.
-        // This wouldn't be necessary if pop_with_wait() could fail. Should
-        // that ever get fixed, we can remove this.
-        auto final_message    = uhd::log::logging_info(pt::microsec_clock::local_time(),
-            uhd::log::trace,
-            __FILE__,
-            __LINE__,
-            "LOGGING",
-            boost::this_thread::get_id());
-        final_message.message = "";
-        push(final_message);
-#    ifndef UHD_LOG_FASTPATH_DISABLE
-        push_fastpath("");
-#    endif
-#endif // BOOST_MSVC
+        _log_queue.wake();
+#ifndef UHD_LOG_FASTPATH_DISABLE
+        _fastpath_queue.wake();
+#endif
 
         _pop_task->join();
         {
@@ -268,15 +259,18 @@ public:
         }
         _pop_task.reset();
 #ifndef UHD_LOG_FASTPATH_DISABLE
-        _pop_fastpath_task->join();
-        _pop_fastpath_task.reset();
+        if (_pop_fastpath_task) {
+            _pop_fastpath_task->join();
+            _pop_fastpath_task.reset();
+        }
 #endif
     }
 
     void push(const uhd::log::logging_info& log_info)
     {
-        static const double PUSH_TIMEOUT = 0.25; // seconds
-        _log_queue.push_with_timed_wait(log_info, PUSH_TIMEOUT);
+        // Never wait, logging must not change the timing of the caller. If
+        // this thread's queue is full, the record is dropped and counted.
+        _log_queue.push(log_info);
     }
 
 #ifndef UHD_LOG_FASTPATH_DISABLE
@@ -284,7 +278,9 @@ public:
     {
         // Never wait. If the buffer is full, we just don't see the message.
         // Too bad.
-        _fastpath_queue.push_with_haste(message);
+        if (_fastpath_enabled) {
+            _fastpath_queue.push(message);
+        }
     }
 #endif
 
@@ -305,27 +301,16 @@ public:
 
     void pop_task()
     {
-        uhd::log::logging_info log_info;
-        log_info.message = "";
+        std::vector<uhd::log::logging_info> records;
 
         // For the lifetime of this thread, we run the following loop:
         while (!_exit) {
-#ifdef BOOST_MSVC
-            // Some versions of MSVC will hang if threads are being joined after main has
-            // completed, so we need to guarantee a timeout here
-            if (_log_queue.pop_with_timed_wait(log_info, READ_TIMEOUT)) {
-                _handle_log_info(log_info);
-            }
-#else
-            _log_queue.pop_with_wait(log_info); // Blocking call
-            _handle_log_info(log_info);
-#endif // BOOST_MSVC
+            _log_queue.wait(READ_TIMEOUT);
+            _drain_log_queue(records);
         }
 
         // Exit procedure: Clear the queue
-        while (_log_queue.pop_with_haste(log_info)) {
-            _handle_log_info(log_info);
-        }
+        _drain_log_queue(records);
 
         // Terminate this thread.
     }
@@ -333,44 +318,14 @@ public:
     void pop_fastpath_task()
     {
 #ifndef UHD_LOG_FASTPATH_DISABLE
-        std::string msg;
-        while (!_exit) {
-#    ifdef BOOST_MSVC
-            // Some versions of MSVC will hang if threads are being joined after main has
-            // completed, so we need to guarantee a timeout here
-            if (_fastpath_queue.pop_with_timed_wait(msg, READ_TIMEOUT)) {
-                std::cerr << msg << std::flush;
-            }
-#    else
-            _fastpath_queue.pop_with_wait(msg);
-            std::cerr << msg << std::flush;
-#    endif // BOOST_MSVC
-        }
-
-        // Exit procedure: Clear the queue
-        while (_fastpath_queue.pop_with_haste(msg)) {
-            std::cerr << msg << std::flush;
-        }
-#endif
-    }
-
-    void pop_fastpath_dummy_task()
-    {
-#ifndef UHD_LOG_FASTPATH_DISABLE
-        std::string msg;
+        auto print_msg = [](const std::string& msg) { std::cerr << msg << std::flush; };
         while (!_exit) {
-#    ifdef BOOST_MSVC
-            // Some versions of MSVC will hang if threads are being joined after main has
-            // completed, so we need to guarantee a timeout here
-            _fastpath_queue.pop_with_timed_wait(msg, READ_TIMEOUT);
-#    else
-            _fastpath_queue.pop_with_wait(msg);
-#    endif // BOOST_MSVC
+            _fastpath_queue.wait(READ_TIMEOUT);
+            _fastpath_queue.drain(print_msg);
         }
 
         // Exit procedure: Clear the queue
-        while (_fastpath_queue.pop_with_haste(msg))
-            ;
+        _fastpath_queue.drain(print_msg);
 #endif
     }
 
@@ -387,6 +342,40 @@ public:
     }
 
 private:
+    /*! Pop all records from all threads' queues and hand them to the loggers
+     *
+     * Records are sorted by time first, because each thread has its own
+     * queue. If records were dropped, a warning is emitted.
+     */
+    void _drain_log_queue(std::vector<uhd::log::logging_info>& records)
+    {
+        records.clear();
+        _log_queue.drain(
+            [&records](uhd::log::logging_info& log_info) {
+                records.push_back(std::move(log_info));
+            });
+        std::stable_sort(records.begin(),
+            records.end(),
+            [](const uhd::log::logging_info& lhs, const uhd::log::logging_info& rhs) {
+                return lhs.time < rhs.time;
+            });
+        for (const auto& log_info : records) {
+            _handle_log_info(log_info);
+        }
+        const size_t dropped = _log_queue.get_and_reset_dropped();
+        if (dropped > 0) {
+            auto log_msg = uhd::log::logging_info(pt::microsec_clock::local_time(),
+                uhd::log::warning,
+                __FILE__,
+                __LINE__,
+                "LOGGING",
+                boost::this_thread::get_id());
+            log_msg.message =
+                std::to_string(dropped) + " log messages were dropped (queue full).";
+            _handle_log_info(log_msg);
+        }
+    }
+
     std::shared_ptr<std::thread> _pop_task;
 #ifndef UHD_LOG_FASTPATH_DISABLE
     std::shared_ptr<std::thread> _pop_fastpath_task;
@@ -472,7 +461,7 @@ private:
             component,
             boost::this_thread::get_id());
         log_msg.message = msg;
-        _log_queue.push_with_timed_wait(log_msg, 0.25);
+        _log_queue.push(log_msg);
     }
 
     std::mutex _logmap_mutex;
@@ -480,9 +469,10 @@ private:
     using level_logfn_pair = std::pair<uhd::log::severity_level, uhd::log::log_fn_t>;
     std::map<std::string, level_logfn_pair> _loggers;
 #ifndef UHD_LOG_FASTPATH_DISABLE
-    uhd::transport::bounded_buffer<std::string> _fastpath_queue;
+    uhd::per_thread_queue<std::string> _fastpath_queue;
+    std::atomic<bool> _fastpath_enabled{false};
 #endif
-    uhd::transport::bounded_buffer<uhd::log::logging_info> _log_queue;
+    uhd::per_thread_queue<uhd::log::logging_info> _log_queue;
 };
 
 UHD_SINGLETON_FCN(log_resource, log_rs);
@@ -518,6 +508,11 @@ uhd::_log::log::~log(void)
     }
 }
 
+bool uhd::_log::is_enabled(const uhd::log::severity_level level)
+{
+    return level >= log_rs().global_level;
+}
+
 #ifndef UHD_LOG_FASTPATH_DISABLE
 void uhd::_log::log_fastpath(const std::string& msg)
 {
@@ -10,6 +10,7 @@
 #include <uhdlib/utils/prefs.hpp>
 #include <uhdlib/utils/paths.hpp>
 #include <boost/filesystem.hpp>
+#include <chrono>
 #include <cstdlib>
 
 using namespace uhd;
@@ -65,14 +66,13 @@ namespace {
 
         return args;
     }
-}
 
-config_parser& uhd::prefs::get_uhd_config()
-{
-    static config_parser _conf_files{};
-    static bool init_done = false;
-    if (not init_done) {
+    //! Read the config files, in the order in which they override each other
+    config_parser read_conf_files()
+    {
         UHD_LOG_TRACE("CONF", "Initializing config file object...");
+        const auto start = std::chrono::steady_clock::now();
+        config_parser _conf_files{};
         const std::string sys_conf_file = path_expandvars(UHD_SYS_CONF_FILE);
         _update_conf_file(sys_conf_file, "system", _conf_files);
         const std::string user_conf_file =
@@ -88,9 +88,18 @@ config_parser& uhd::prefs::get_uhd_config()
         } catch (const std::exception &) {
             // nop
         }
-        UHD_LOG_TRACE("PREFS", "Done initializing.");
+        UHD_LOG_DEBUG("PREFS", "Read config files in "
+            << std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::steady_clock::now() - start).count() / 1000.0
+            << " ms");
+        return _conf_files;
     }
+}
 
+config_parser& uhd::prefs::get_uhd_config()
+{
+    // The files are read and parsed once per process
+    static config_parser _conf_files = read_conf_files();
     return _conf_files;
 }
 
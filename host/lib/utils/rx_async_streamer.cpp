@@ -0,0 +1,347 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhd/utils/rx_async_streamer.hpp>
+#include <uhd/utils/thread.hpp>
+#include <uhdlib/utils/cpu_affinity.hpp>
+#include <uhdlib/utils/event_fd.hpp>
+#include <boost/format.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+using namespace uhd;
+
+namespace {
+
+constexpr size_t RX_ASYNC_DEFAULT_NUM_THREADS  = 1;
+constexpr double RX_ASYNC_DEFAULT_POLL_TIMEOUT = 100e-6;
+//! How long an idle worker waits for a stream before checking if it should stop
+constexpr auto RX_ASYNC_IDLE_INTERVAL = std::chrono::milliseconds(100);
+
+//! A stream and the buffer it is receiving into
+struct async_stream_t
+{
+    size_t index;
+    rx_streamer::sptr rx_stream;
+    std::vector<std::vector<void*>> pool;
+    size_t samps_per_buff;
+    size_t item_size;
+    rx_async_streamer::callback_t callback;
+
+    //! Guards free_buffs and paused, which release() touches too
+    std::mutex mutex;
+    //! Indices of the buffers in the pool that can be received into
+    std::deque<size_t> free_buffs;
+    //! True while the stream waits for a buffer and isn't scheduled
+    bool paused = false;
+
+    // Only touched by the worker that currently holds the stream
+    bool filling     = false;
+    size_t buff      = 0;
+    size_t num_samps = 0;
+    rx_metadata_t first_metadata;
+    std::vector<void*> buffs;
+};
+
+class rx_async_streamer_impl : public rx_async_streamer
+{
+public:
+    rx_async_streamer_impl(const size_t num_threads,
+        const double poll_timeout,
+        const std::vector<size_t>& worker_cpus)
+        : _num_threads(num_threads)
+        , _poll_timeout(poll_timeout)
+        , _worker_cpus(worker_cpus)
+    {
+        /* NOP */
+    }
+
+    ~rx_async_streamer_impl(void)
+    {
+        stop();
+    }
+
+    size_t add_stream(rx_streamer::sptr rx_stream,
+        const std::vector<std::vector<void*>>& pool,
+        const size_t samps_per_buff,
+        const size_t item_size,
+        const callback_t& callback)
+    {
+        if (not _workers.empty()) {
+            throw uhd::runtime_error(
+                "rx_async_streamer: Cannot add streams while running");
+        }
+        if (pool.empty() or samps_per_buff == 0 or item_size == 0) {
+            throw uhd::value_error(
+                "rx_async_streamer: Need at least one buffer of at least one sample");
+        }
+        for (const auto& buffs : pool) {
+            if (buffs.size() != rx_stream->get_num_channels()) {
+                throw uhd::value_error(
+                    str(boost::format("rx_async_streamer: Buffer has %d channels, the "
+                                      "streamer %d")
+                        % buffs.size() % rx_stream->get_num_channels()));
+            }
+        }
+        std::unique_ptr<async_stream_t> stream(new async_stream_t);
+        stream->index          = _streams.size();
+        stream->rx_stream      = rx_stream;
+        stream->pool           = pool;
+        stream->samps_per_buff = samps_per_buff;
+        stream->item_size      = item_size;
+        stream->callback       = callback;
+        for (size_t i = 0; i < pool.size(); i++) {
+            stream->free_buffs.push_back(i);
+        }
+        _streams.push_back(std::move(stream));
+        return _streams.size() - 1;
+    }
+
+    void start(void)
+    {
+        if (not _workers.empty()) {
+            return;
+        }
+        _stop = false;
+        // Streams that paused before stop() may have been scheduled since
+        {
+            std::lock_guard<std::mutex> lock(_ready_mutex);
+            _ready.clear();
+        }
+        for (auto& stream : _streams) {
+            {
+                std::lock_guard<std::mutex> lock(stream->mutex);
+                stream->paused = false;
+            }
+            _schedule(stream.get());
+        }
+        for (size_t i = 0; i < _num_threads; i++) {
+            std::vector<size_t> cpus;
+            if (not _worker_cpus.empty()) {
+                cpus = {_worker_cpus[i % _worker_cpus.size()]};
+            }
+            _workers.emplace_back([this, cpus]() {
+                set_thread_affinity(cpus);
+                _worker();
+            });
+        }
+    }
+
+    void stop(void)
+    {
+        if (_workers.empty()) {
+            return;
+        }
+        _stop = true;
+        _ready_cond.notify_all();
+        for (auto& worker : _workers) {
+            worker.join();
+        }
+        _workers.clear();
+        // Drop the partially filled buffers
+        for (auto& stream : _streams) {
+            if (stream->filling) {
+                stream->filling = false;
+                std::lock_guard<std::mutex> lock(stream->mutex);
+                stream->free_buffs.push_front(stream->buff);
+            }
+        }
+    }
+
+    bool get_completed(buffer_t& buffer, const double timeout)
+    {
+        std::unique_lock<std::mutex> lock(_completed_mutex);
+        if (not _completed_cond.wait_for(lock,
+                std::chrono::duration<double>(timeout),
+                [this]() { return not _completed.empty(); })) {
+            return false;
+        }
+        buffer = std::move(_completed.front());
+        _completed.pop_front();
+        _completed_fd.try_wait();
+        return true;
+    }
+
+    void release(const buffer_t& buffer)
+    {
+        if (buffer.stream >= _streams.size()) {
+            throw uhd::value_error("rx_async_streamer: Invalid stream index");
+        }
+        async_stream_t& stream = *_streams[buffer.stream];
+        const auto it = std::find(stream.pool.begin(), stream.pool.end(), buffer.buffs);
+        if (it == stream.pool.end()) {
+            throw uhd::value_error(
+                "rx_async_streamer: Buffer is not from the pool of its stream");
+        }
+        _release(stream, size_t(it - stream.pool.begin()));
+    }
+
+    int get_completed_fd(void) const
+    {
+        return _completed_fd.get_fd();
+    }
+
+private:
+    void _worker(void)
+    {
+        while (not _stop) {
+            async_stream_t* stream = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(_ready_mutex);
+                if (not _ready_cond.wait_for(lock, RX_ASYNC_IDLE_INTERVAL, [this]() {
+                        return _stop or not _ready.empty();
+                    })
+                    or _stop) {
+                    continue;
+                }
+                stream = _ready.front();
+                _ready.pop_front();
+            }
+            if (_service(*stream)) {
+                _schedule(stream);
+            }
+        }
+    }
+
+    /*! Receive what the stream has right now
+     *
+     * \return false if the stream ran out of buffers and was paused
+     */
+    bool _service(async_stream_t& stream)
+    {
+        if (not stream.filling) {
+            std::lock_guard<std::mutex> lock(stream.mutex);
+            if (stream.free_buffs.empty()) {
+                stream.paused = true;
+                return false;
+            }
+            stream.buff = stream.free_buffs.front();
+            stream.free_buffs.pop_front();
+            stream.filling   = true;
+            stream.num_samps = 0;
+        }
+
+        const std::vector<void*>& base = stream.pool[stream.buff];
+        stream.buffs.resize(base.size());
+        for (size_t i = 0; i < base.size(); i++) {
+            stream.buffs[i] =
+                static_cast<char*>(base[i]) + stream.num_samps * stream.item_size;
+        }
+        rx_metadata_t metadata;
+        const size_t num_samps = stream.rx_stream->recv(stream.buffs,
+            stream.samps_per_buff - stream.num_samps,
+            metadata,
+            _poll_timeout);
+        if (stream.num_samps == 0) {
+            stream.first_metadata = metadata;
+        }
+        stream.num_samps += num_samps;
+
+        // A timeout only means that the stream has no more data right now
+        const bool error =
+            metadata.error_code != rx_metadata_t::ERROR_CODE_NONE
+            and metadata.error_code != rx_metadata_t::ERROR_CODE_TIMEOUT;
+        if (stream.num_samps == stream.samps_per_buff or error
+            or metadata.end_of_burst) {
+            _deliver(stream, metadata);
+        }
+        return true;
+    }
+
+    void _deliver(async_stream_t& stream, const rx_metadata_t& metadata)
+    {
+        buffer_t buffer;
+        buffer.stream    = stream.index;
+        buffer.buffs     = stream.pool[stream.buff];
+        buffer.num_samps = stream.num_samps;
+        buffer.metadata  = metadata;
+        if (stream.first_metadata.has_time_spec) {
+            buffer.metadata.has_time_spec = true;
+            buffer.metadata.time_spec     = stream.first_metadata.time_spec;
+            buffer.metadata.time_ticks    = stream.first_metadata.time_ticks;
+        }
+        buffer.metadata.start_of_burst = stream.first_metadata.start_of_burst;
+        stream.filling = false;
+
+        if (not stream.callback) {
+            std::lock_guard<std::mutex> lock(_completed_mutex);
+            _completed.push_back(std::move(buffer));
+            _completed_fd.post();
+            _completed_cond.notify_one();
+            return;
+        }
+        try {
+            stream.callback(buffer);
+        } catch (const std::exception& ex) {
+            UHD_LOG_ERROR("RX_ASYNC",
+                boost::format("Callback of stream %d threw: %s") % stream.index
+                    % ex.what());
+        }
+        _release(stream, stream.buff);
+    }
+
+    void _release(async_stream_t& stream, const size_t buff)
+    {
+        std::lock_guard<std::mutex> lock(stream.mutex);
+        stream.free_buffs.push_back(buff);
+        if (stream.paused) {
+            stream.paused = false;
+            _schedule(&stream);
+        }
+    }
+
+    void _schedule(async_stream_t* stream)
+    {
+        std::lock_guard<std::mutex> lock(_ready_mutex);
+        _ready.push_back(stream);
+        _ready_cond.notify_one();
+    }
+
+    const size_t _num_threads;
+    const double _poll_timeout;
+    const std::vector<size_t> _worker_cpus;
+
+    std::vector<std::unique_ptr<async_stream_t>> _streams;
+    std::vector<std::thread> _workers;
+    std::atomic<bool> _stop{false};
+
+    //! Streams that are waiting for a worker, served round-robin
+    std::deque<async_stream_t*> _ready;
+    std::mutex _ready_mutex;
+    std::condition_variable _ready_cond;
+
+    std::deque<buffer_t> _completed;
+    std::mutex _completed_mutex;
+    std::condition_variable _completed_cond;
+    //! Counts the entries of _completed
+    event_fd _completed_fd;
+};
+
+} // namespace
+
+rx_async_streamer::~rx_async_streamer(void)
+{
+    /* NOP */
+}
+
+rx_async_streamer::sptr rx_async_streamer::make(const device_addr_t& args)
+{
+    const size_t num_threads =
+        args.cast<size_t>("num_threads", RX_ASYNC_DEFAULT_NUM_THREADS);
+    if (num_threads == 0) {
+        throw uhd::value_error("rx_async_streamer: num_threads must be at least 1");
+    }
+    return sptr(new rx_async_streamer_impl(num_threads,
+        args.cast<double>("poll_timeout", RX_ASYNC_DEFAULT_POLL_TIMEOUT),
+        parse_cpu_list(args.get("worker_cpus", ""))));
+}
@@ -0,0 +1,599 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhd/utils/shm_stream.hpp>
+#include <boost/format.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <new>
+#include <thread>
+#ifdef HAVE_SHM_OPEN
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+#ifdef HAVE_FUTEX
+#    include <linux/futex.h>
+#    include <sys/syscall.h>
+#    include <time.h>
+#endif
+
+using namespace uhd;
+
+#ifdef HAVE_SHM_OPEN
+namespace {
+
+constexpr size_t SHM_STREAM_DEFAULT_NUM_SLOTS = 256;
+//! "UHDSHM01", written last when the ring is ready
+constexpr uint64_t SHM_STREAM_MAGIC    = 0x55484453484d3031;
+constexpr uint32_t SHM_STREAM_VERSION  = 1;
+constexpr size_t SHM_STREAM_ALIGNMENT  = 64;
+constexpr size_t SHM_STREAM_FORMAT_LEN = 32;
+//! The sequence number of a slot that is being written
+constexpr uint64_t SHM_STREAM_SLOT_INVALID = ~uint64_t(0);
+//! How often subscribers check for new slots without futexes
+constexpr auto SHM_STREAM_POLL_INTERVAL = std::chrono::microseconds(100);
+
+// The atomics are shared between processes, which only works if they are
+// plain memory and not emulated with a lock of this process.
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2 and ATOMIC_INT_LOCK_FREE == 2,
+    "Shared memory streams need lock-free atomics");
+
+/*! The start of the shared memory, followed by the slots
+ *
+ * All fields but the atomics are written once by the publisher before it
+ * sets the magic.
+ */
+struct shm_header_t
+{
+    std::atomic<uint64_t> magic;
+    uint32_t version;
+    uint32_t num_channels;
+    uint64_t item_size;
+    uint64_t samps_per_slot;
+    uint64_t num_slots;
+    //! Bytes per slot, including its header
+    uint64_t slot_size;
+    //! Bytes per channel in a slot
+    uint64_t channel_size;
+    char format[SHM_STREAM_FORMAT_LEN];
+
+    //! Number of slots published so far
+    alignas(SHM_STREAM_ALIGNMENT) std::atomic<uint64_t> head;
+    //! Incremented when subscribers are woken up
+    std::atomic<uint32_t> wake_seq;
+    //! Subscribers that are sleeping on wake_seq
+    std::atomic<uint32_t> num_waiters;
+    std::atomic<uint32_t> closed;
+};
+
+//! The start of a slot, followed by the samples of each channel
+struct shm_slot_t
+{
+    //! Index of the published slot that this holds, like a seqlock
+    std::atomic<uint64_t> seq;
+    uint64_t nsamps;
+    int64_t full_secs;
+    double frac_secs;
+    int64_t ticks;
+    double tick_rate;
+    uint64_t fragment_offset;
+    uint32_t error_code;
+    uint8_t has_time_spec;
+    uint8_t more_fragments;
+    uint8_t start_of_burst;
+    uint8_t end_of_burst;
+    uint8_t out_of_sequence;
+};
+
+size_t round_up(const size_t size)
+{
+    return (size + SHM_STREAM_ALIGNMENT - 1) / SHM_STREAM_ALIGNMENT
+           * SHM_STREAM_ALIGNMENT;
+}
+
+//! Size of the shared memory of a ring
+size_t get_shm_size(const shm_header_t& header)
+{
+    return round_up(sizeof(shm_header_t)) + header.num_slots * header.slot_size;
+}
+
+void write_metadata(shm_slot_t& slot, const size_t nsamps, const rx_metadata_t& md)
+{
+    slot.nsamps          = nsamps;
+    slot.full_secs       = md.time_spec.get_full_secs();
+    slot.frac_secs       = md.time_spec.get_frac_secs();
+    slot.ticks           = md.time_ticks.ticks;
+    slot.tick_rate       = md.time_ticks.tick_rate;
+    slot.fragment_offset = md.fragment_offset;
+    slot.error_code      = uint32_t(md.error_code);
+    slot.has_time_spec   = md.has_time_spec;
+    slot.more_fragments  = md.more_fragments;
+    slot.start_of_burst  = md.start_of_burst;
+    slot.end_of_burst    = md.end_of_burst;
+    slot.out_of_sequence = md.out_of_sequence;
+}
+
+void read_metadata(const shm_slot_t& slot, rx_metadata_t& md)
+{
+    md.reset();
+    md.time_spec       = time_spec_t(slot.full_secs, slot.frac_secs);
+    md.time_ticks      = time_ticks_t(slot.ticks, slot.tick_rate);
+    md.fragment_offset = size_t(slot.fragment_offset);
+    md.error_code      = rx_metadata_t::error_code_t(slot.error_code);
+    md.has_time_spec   = slot.has_time_spec != 0;
+    md.more_fragments  = slot.more_fragments != 0;
+    md.start_of_burst  = slot.start_of_burst != 0;
+    md.end_of_burst    = slot.end_of_burst != 0;
+    md.out_of_sequence = slot.out_of_sequence != 0;
+}
+
+std::string errno_str(const int err)
+{
+    return std::strerror(err);
+}
+
+std::string get_shm_path(const std::string& name)
+{
+    if (name.empty() or name.find('/') != std::string::npos) {
+        throw uhd::value_error(
+            "Invalid shared memory stream name, it must not be empty or contain "
+            "slashes: "
+            + name);
+    }
+    return "/" + name;
+}
+
+void* map_shm(const int fd, const size_t size, const std::string& path)
+{
+    void* base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) {
+        const int err = errno;
+        ::close(fd);
+        throw uhd::os_error(
+            str(boost::format("Could not map %s: %s") % path % errno_str(err)));
+    }
+    ::close(fd);
+    return base;
+}
+
+#ifdef HAVE_FUTEX
+// The futexes are not private, they are shared between processes
+void futex_wait(std::atomic<uint32_t>& word,
+    const uint32_t value,
+    const std::chrono::steady_clock::duration timeout)
+{
+    const auto timeout_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(timeout).count();
+    timespec ts;
+    ts.tv_sec  = time_t(timeout_ns / 1000000000);
+    ts.tv_nsec = long(timeout_ns % 1000000000);
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, value, &ts,
+        nullptr, 0);
+}
+
+void futex_wake(std::atomic<uint32_t>& word)
+{
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, INT_MAX,
+        nullptr, nullptr, 0);
+}
+#endif
+
+//! The parts of the mapped ring that publishers and subscribers share
+class shm_ring_t
+{
+public:
+    shm_ring_t(void* base, const size_t size)
+        : _base(static_cast<uint8_t*>(base))
+        , _size(size)
+        , _header(static_cast<shm_header_t*>(base))
+    {
+    }
+
+    ~shm_ring_t(void)
+    {
+        munmap(_base, _size);
+    }
+
+    shm_header_t& header(void) const
+    {
+        return *_header;
+    }
+
+    shm_slot_t& slot(const uint64_t pos) const
+    {
+        return *reinterpret_cast<shm_slot_t*>(_base + round_up(sizeof(shm_header_t))
+                                              + (pos % _header->num_slots)
+                                                    * _header->slot_size);
+    }
+
+    uint8_t* channel(shm_slot_t& slot, const size_t chan) const
+    {
+        return reinterpret_cast<uint8_t*>(&slot) + round_up(sizeof(shm_slot_t))
+               + chan * _header->channel_size;
+    }
+
+private:
+    uint8_t* const _base;
+    const size_t _size;
+    shm_header_t* const _header;
+};
+
+/***********************************************************************
+ * Publisher
+ **********************************************************************/
+class rx_stream_publisher_impl : public rx_stream_publisher
+{
+public:
+    rx_stream_publisher_impl(const std::string& name,
+        const size_t num_channels,
+        const size_t item_size,
+        const size_t samps_per_slot,
+        const std::string& format,
+        const size_t num_slots)
+        : _path(get_shm_path(name))
+    {
+        if (num_channels == 0 or item_size == 0 or samps_per_slot == 0
+            or num_slots < 2) {
+            throw uhd::value_error("rx_stream_publisher: num_channels, item_size and "
+                                   "samps_per_slot must not be 0, and num_slots must "
+                                   "be at least 2");
+        }
+        if (format.size() >= SHM_STREAM_FORMAT_LEN) {
+            throw uhd::value_error("rx_stream_publisher: format is too long: " + format);
+        }
+
+        shm_header_t layout;
+        layout.num_slots    = num_slots;
+        layout.channel_size = round_up(samps_per_slot * item_size);
+        layout.slot_size =
+            round_up(sizeof(shm_slot_t)) + num_channels * layout.channel_size;
+        const size_t size = get_shm_size(layout);
+
+        // Replace what a crashed publisher left behind
+        shm_unlink(_path.c_str());
+        const int fd = shm_open(_path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0666);
+        if (fd < 0) {
+            throw uhd::os_error(
+                str(boost::format("Could not create shared memory %s: %s") % _path
+                    % errno_str(errno)));
+        }
+        if (ftruncate(fd, off_t(size)) != 0) {
+            const int err = errno;
+            ::close(fd);
+            shm_unlink(_path.c_str());
+            throw uhd::os_error(
+                str(boost::format("Could not size shared memory %s: %s") % _path
+                    % errno_str(err)));
+        }
+        try {
+            _ring.reset(new shm_ring_t(map_shm(fd, size, _path), size));
+        } catch (...) {
+            shm_unlink(_path.c_str());
+            throw;
+        }
+
+        shm_header_t& header = *new (&_ring->header()) shm_header_t();
+        header.version        = SHM_STREAM_VERSION;
+        header.num_channels   = uint32_t(num_channels);
+        header.item_size      = item_size;
+        header.samps_per_slot = samps_per_slot;
+        header.num_slots      = num_slots;
+        header.slot_size      = layout.slot_size;
+        header.channel_size   = layout.channel_size;
+        std::strncpy(header.format, format.c_str(), SHM_STREAM_FORMAT_LEN);
+        for (size_t i = 0; i < num_slots; i++) {
+            new (&_ring->slot(i)) shm_slot_t();
+            _ring->slot(i).seq.store(SHM_STREAM_SLOT_INVALID, std::memory_order_relaxed);
+        }
+        header.magic.store(SHM_STREAM_MAGIC, std::memory_order_release);
+    }
+
+    ~rx_stream_publisher_impl(void)
+    {
+        _ring->header().closed.store(1);
+        _wake();
+        shm_unlink(_path.c_str());
+    }
+
+    size_t get_buffs(std::vector<void*>& buffs)
+    {
+        shm_slot_t& slot = _begin_slot();
+        buffs.resize(_ring->header().num_channels);
+        for (size_t chan = 0; chan < buffs.size(); chan++) {
+            buffs[chan] = _ring->channel(slot, chan);
+        }
+        return size_t(_ring->header().samps_per_slot);
+    }
+
+    void commit(const size_t nsamps, const rx_metadata_t& metadata)
+    {
+        shm_header_t& header = _ring->header();
+        if (nsamps > header.samps_per_slot) {
+            throw uhd::value_error(
+                str(boost::format("rx_stream_publisher: %d samples don't fit in a "
+                                  "slot of %d")
+                    % nsamps % header.samps_per_slot));
+        }
+        shm_slot_t& slot = _begin_slot();
+        write_metadata(slot, nsamps, metadata);
+        slot.seq.store(_pos, std::memory_order_release);
+        _writing = false;
+        header.head.store(++_pos, std::memory_order_release);
+        _wake();
+    }
+
+    size_t publish_raw(
+        rx_streamer& rx_stream, rx_metadata_t& metadata, const double timeout)
+    {
+        const size_t nsamps = rx_stream.recv_raw(_raw_buffs, metadata, timeout);
+        if (metadata.error_code == rx_metadata_t::ERROR_CODE_TIMEOUT) {
+            rx_stream.release_raw();
+            return 0;
+        }
+        const size_t item_size = size_t(_ring->header().item_size);
+        if (nsamps > _ring->header().samps_per_slot
+            or (nsamps > 0 and _raw_buffs.size() != _ring->header().num_channels)) {
+            rx_stream.release_raw();
+            throw uhd::value_error(
+                str(boost::format("rx_stream_publisher: A packet of %d channels with "
+                                  "%d samples doesn't fit in a slot")
+                    % _raw_buffs.size() % nsamps));
+        }
+        get_buffs(_buffs);
+        for (size_t chan = 0; chan < _buffs.size() and nsamps > 0; chan++) {
+            std::memcpy(_buffs[chan], _raw_buffs[chan], nsamps * item_size);
+        }
+        rx_stream.release_raw();
+        commit(nsamps, metadata);
+        return nsamps;
+    }
+
+    uint64_t get_num_published(void) const
+    {
+        return _pos;
+    }
+
+private:
+    //! Mark the next slot as being written, so subscribers don't trust it
+    shm_slot_t& _begin_slot(void)
+    {
+        shm_slot_t& slot = _ring->slot(_pos);
+        if (not _writing) {
+            slot.seq.store(SHM_STREAM_SLOT_INVALID, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            _writing = true;
+        }
+        return slot;
+    }
+
+    void _wake(void)
+    {
+        shm_header_t& header = _ring->header();
+        // Orders the store to head before the load of num_waiters, see
+        // rx_stream_subscriber_impl::_wait()
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (header.num_waiters.load(std::memory_order_relaxed) > 0) {
+            header.wake_seq.fetch_add(1);
+#ifdef HAVE_FUTEX
+            futex_wake(header.wake_seq);
+#endif
+        }
+    }
+
+    const std::string _path;
+    std::unique_ptr<shm_ring_t> _ring;
+    //! Index of the next slot to publish
+    uint64_t _pos = 0;
+    //! True between _begin_slot() and commit()
+    bool _writing = false;
+    std::vector<void*> _buffs;
+    rx_streamer::raw_buffs_type _raw_buffs;
+};
+
+/***********************************************************************
+ * Subscriber
+ **********************************************************************/
+class rx_stream_subscriber_impl : public rx_stream_subscriber
+{
+public:
+    rx_stream_subscriber_impl(const std::string& name)
+    {
+        const std::string path = get_shm_path(name);
+        const int fd           = shm_open(path.c_str(), O_RDWR, 0);
+        if (fd < 0) {
+            throw uhd::os_error(
+                str(boost::format("Could not open shared memory %s: %s") % path
+                    % errno_str(errno)));
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0 or size_t(st.st_size) < sizeof(shm_header_t)) {
+            ::close(fd);
+            throw uhd::os_error("Shared memory " + path + " is not a stream ring");
+        }
+        const size_t size = size_t(st.st_size);
+        _ring.reset(new shm_ring_t(map_shm(fd, size, path), size));
+
+        const shm_header_t& header = _ring->header();
+        if (header.magic.load(std::memory_order_acquire) != SHM_STREAM_MAGIC
+            or header.version != SHM_STREAM_VERSION or header.num_slots == 0
+            or get_shm_size(header) > size) {
+            throw uhd::os_error("Shared memory " + path
+                                + " is not a stream ring, or it is not ready yet");
+        }
+        _pos = header.head.load(std::memory_order_acquire);
+    }
+
+    size_t get_num_channels(void) const
+    {
+        return _ring->header().num_channels;
+    }
+
+    size_t get_item_size(void) const
+    {
+        return size_t(_ring->header().item_size);
+    }
+
+    size_t get_samps_per_slot(void) const
+    {
+        return size_t(_ring->header().samps_per_slot);
+    }
+
+    std::string get_format(void) const
+    {
+        const char* format = _ring->header().format;
+        return std::string(format, strnlen(format, SHM_STREAM_FORMAT_LEN));
+    }
+
+    size_t recv(std::vector<const void*>& buffs,
+        rx_metadata_t& metadata,
+        const double timeout)
+    {
+        release();
+        metadata.reset();
+        if (not _wait(timeout)) {
+            metadata.error_code = rx_metadata_t::ERROR_CODE_TIMEOUT;
+            return 0;
+        }
+
+        const shm_header_t& header = _ring->header();
+        const uint64_t head        = header.head.load(std::memory_order_acquire);
+        shm_slot_t& slot           = _ring->slot(_pos);
+        // The publisher reuses the slot of _pos once it is a ring ahead
+        if (head - _pos >= header.num_slots
+            or slot.seq.load(std::memory_order_acquire) != _pos) {
+            return _overflow(head, metadata);
+        }
+        read_metadata(slot, metadata);
+        const size_t nsamps = size_t(std::min(slot.nsamps, header.samps_per_slot));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) != _pos) {
+            return _overflow(header.head.load(std::memory_order_acquire), metadata);
+        }
+
+        buffs.resize(header.num_channels);
+        for (size_t chan = 0; chan < buffs.size(); chan++) {
+            buffs[chan] = _ring->channel(slot, chan);
+        }
+        _held = true;
+        return nsamps;
+    }
+
+    bool release(void)
+    {
+        if (not _held) {
+            return true;
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const bool valid = _ring->slot(_pos).seq.load(std::memory_order_relaxed) == _pos;
+        _held            = false;
+        _pos++;
+        return valid;
+    }
+
+    bool is_closed(void) const
+    {
+        return _ring->header().closed.load() != 0;
+    }
+
+private:
+    //! Skip to the newest slot after falling behind
+    size_t _overflow(const uint64_t head, rx_metadata_t& metadata)
+    {
+        UHD_LOG_FASTPATH("O");
+        _pos                = head - 1;
+        metadata.error_code = rx_metadata_t::ERROR_CODE_OVERFLOW;
+        return 0;
+    }
+
+    //! Wait until the slot of _pos is published, return false on timeout
+    bool _wait(const double timeout)
+    {
+        typedef std::chrono::steady_clock clock;
+        shm_header_t& header = _ring->header();
+        const auto exit_time = clock::now()
+                               + std::chrono::duration_cast<clock::duration>(
+                                     std::chrono::duration<double>(timeout));
+        while (header.head.load(std::memory_order_acquire) <= _pos) {
+            const auto now = clock::now();
+            if (is_closed() or now >= exit_time) {
+                return false;
+            }
+#ifdef HAVE_FUTEX
+            // Announce the wait before checking head again, so the publisher
+            // either sees the waiter or this sees the new head
+            header.num_waiters.fetch_add(1);
+            const uint32_t wake_seq = header.wake_seq.load();
+            if (header.head.load() <= _pos and not is_closed()) {
+                futex_wait(header.wake_seq, wake_seq, exit_time - now);
+            }
+            header.num_waiters.fetch_sub(1);
+#else
+            std::this_thread::sleep_for(
+                std::min<clock::duration>(exit_time - now, SHM_STREAM_POLL_INTERVAL));
+#endif
+        }
+        return true;
+    }
+
+    std::unique_ptr<shm_ring_t> _ring;
+    //! Index of the next slot to read, or of the held one
+    uint64_t _pos = 0;
+    bool _held    = false;
+};
+
+} // namespace
+#endif // HAVE_SHM_OPEN
+
+rx_stream_publisher::~rx_stream_publisher(void)
+{
+    /* NOP */
+}
+
+rx_stream_publisher::sptr rx_stream_publisher::make(const std::string& name,
+    const size_t num_channels,
+    const size_t item_size,
+    const size_t samps_per_slot,
+    const std::string& format,
+    const device_addr_t& args)
+{
+#ifdef HAVE_SHM_OPEN
+    return sptr(new rx_stream_publisher_impl(name,
+        num_channels,
+        item_size,
+        samps_per_slot,
+        format,
+        args.cast<size_t>("num_slots", SHM_STREAM_DEFAULT_NUM_SLOTS)));
+#else
+    (void)name, (void)num_channels, (void)item_size, (void)samps_per_slot,
+        (void)format, (void)args;
+    throw uhd::not_implemented_error(
+        "Shared memory streams are not supported on this platform");
+#endif
+}
+
+rx_stream_subscriber::~rx_stream_subscriber(void)
+{
+    /* NOP */
+}
+
+rx_stream_subscriber::sptr rx_stream_subscriber::make(const std::string& name)
+{
+#ifdef HAVE_SHM_OPEN
+    return sptr(new rx_stream_subscriber_impl(name));
+#else
+    (void)name;
+    throw uhd::not_implemented_error(
+        "Shared memory streams are not supported on this platform");
+#endif
+}
@@ -0,0 +1,580 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/types/endianness.hpp>
+#include <uhd/utils/safe_call.hpp>
+#include <uhd/utils/sigmf_recorder.hpp>
+#include <uhd/version.hpp>
+#include <boost/format.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+
+using namespace uhd;
+
+namespace {
+
+constexpr uint64_t SIGMF_DEFAULT_INDEX_INTERVAL = 1024 * 1024;
+constexpr char SIGMF_INDEX_MAGIC[8]             = "UHDSIGX";
+constexpr uint32_t SIGMF_INDEX_VERSION          = 1;
+constexpr size_t SIGMF_INDEX_HEADER_SIZE        = 32;
+constexpr size_t SIGMF_INDEX_ENTRY_SIZE         = 40;
+
+#ifdef UHD_BIG_ENDIAN
+#    define SIGMF_ENDIAN "_be"
+#else
+#    define SIGMF_ENDIAN "_le"
+#endif
+
+struct sigmf_type_t
+{
+    const char* cpu_format;
+    const char* datatype;
+    size_t item_size;
+};
+
+const sigmf_type_t SIGMF_TYPES[] = {{"fc64", "cf64" SIGMF_ENDIAN, 16},
+    {"fc32", "cf32" SIGMF_ENDIAN, 8},
+    {"sc16", "ci16" SIGMF_ENDIAN, 4},
+    {"sc8", "ci8", 2},
+    {"f64", "rf64" SIGMF_ENDIAN, 8},
+    {"f32", "rf32" SIGMF_ENDIAN, 4},
+    {"s16", "ri16" SIGMF_ENDIAN, 2},
+    {"s8", "ri8", 1}};
+
+/***********************************************************************
+ * Index file encoding
+ **********************************************************************/
+template <typename T> void put(char*& buf, const T value)
+{
+    std::memcpy(buf, &value, sizeof(T));
+    buf += sizeof(T);
+}
+
+template <typename T> T get(const char*& buf)
+{
+    T value;
+    std::memcpy(&value, buf, sizeof(T));
+    buf += sizeof(T);
+    return value;
+}
+
+void encode_entry(const sigmf_index::entry_t& entry, char* buf)
+{
+    put<uint64_t>(buf, entry.sample_offset);
+    put<int64_t>(buf, entry.time_spec.get_full_secs());
+    put<double>(buf, entry.time_spec.get_frac_secs());
+    put<double>(buf, entry.freq);
+    put<uint32_t>(buf, entry.flags);
+    put<uint32_t>(buf, 0);
+}
+
+sigmf_index::entry_t decode_entry(const char* buf)
+{
+    sigmf_index::entry_t entry;
+    entry.sample_offset     = get<uint64_t>(buf);
+    const int64_t full_secs = get<int64_t>(buf);
+    const double frac_secs  = get<double>(buf);
+    entry.time_spec         = time_spec_t(time_t(full_secs), frac_secs);
+    entry.freq              = get<double>(buf);
+    entry.flags             = get<uint32_t>(buf);
+    return entry;
+}
+
+/***********************************************************************
+ * JSON output
+ **********************************************************************/
+std::string json_string(const std::string& value)
+{
+    std::string json = "\"";
+    for (const char c : value) {
+        if (c == '"' or c == '\\') {
+            json += '\\';
+            json += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            json += str(boost::format("\\u%04x") % int(c));
+        } else {
+            json += c;
+        }
+    }
+    return json + "\"";
+}
+
+std::string json_number(const double value)
+{
+    return str(boost::format("%.17g") % value);
+}
+
+struct capture_t
+{
+    uint64_t sample_offset;
+    bool has_time_spec;
+    time_spec_t time_spec;
+    double freq;
+};
+
+struct annotation_t
+{
+    uint64_t sample_offset;
+    std::string comment;
+};
+
+} // namespace
+
+/***********************************************************************
+ * SigMF recorder
+ **********************************************************************/
+class sigmf_recorder_impl : public sigmf_recorder
+{
+public:
+    sigmf_recorder_impl(const std::vector<std::string>& bases,
+        const info_t& info,
+        const sigmf_type_t& type,
+        const device_addr_t& args)
+        : _info(info)
+        , _datatype(type.datatype)
+        , _item_size(type.item_size)
+        , _index_interval(
+              args.cast<uint64_t>("index_interval", SIGMF_DEFAULT_INDEX_INTERVAL))
+        , _streams(bases.size())
+    {
+        if (_index_interval == 0) {
+            throw uhd::value_error("sigmf_recorder: index_interval must be non-zero");
+        }
+
+        std::vector<std::string> data_files;
+        for (size_t i = 0; i < bases.size(); i++) {
+            stream_t& stream = _streams[i];
+            stream.base      = bases[i];
+            data_files.push_back(stream.base + ".sigmf-data");
+
+            const std::string index_file = stream.base + ".sigmf-idx";
+            stream.index.open(index_file.c_str(), std::ios::binary | std::ios::trunc);
+            if (not stream.index) {
+                throw uhd::os_error(str(boost::format("Could not open %s: %s")
+                                        % index_file % std::strerror(errno)));
+            }
+            char header[SIGMF_INDEX_HEADER_SIZE] = {};
+            char* buf                            = header;
+            std::memcpy(buf, SIGMF_INDEX_MAGIC, sizeof(SIGMF_INDEX_MAGIC));
+            buf += sizeof(SIGMF_INDEX_MAGIC);
+            put<uint32_t>(buf, SIGMF_INDEX_VERSION);
+            put<uint32_t>(buf, uint32_t(SIGMF_INDEX_ENTRY_SIZE));
+            put<double>(buf, _info.rate);
+            put<uint32_t>(buf, uint32_t(_item_size));
+            stream.index.write(header, sizeof(header));
+        }
+        _recorder = file_recorder::make(data_files, _item_size, args);
+    }
+
+    ~sigmf_recorder_impl(void)
+    {
+        UHD_SAFE_CALL(close();)
+    }
+
+    size_t get_buffs(std::vector<void*>& buffs, const double timeout)
+    {
+        return _recorder->get_buffs(buffs, timeout);
+    }
+
+    void commit(const size_t num_bytes, const rx_metadata_t& metadata)
+    {
+        if (metadata.error_code == rx_metadata_t::ERROR_CODE_OVERFLOW) {
+            _overflow = true;
+        }
+        if (num_bytes == 0) {
+            return;
+        }
+
+        uint32_t flags   = 0;
+        int64_t num_lost = 0;
+        if (_num_samps == 0) {
+            flags |= sigmf_index::INDEX_START;
+        }
+        if (_overflow) {
+            flags |= sigmf_index::INDEX_OVERFLOW;
+        }
+        if (metadata.has_time_spec) {
+            flags |= sigmf_index::INDEX_TIME;
+            if (_has_time) {
+                num_lost = (metadata.time_spec - _expected_time()).to_ticks(_info.rate);
+                if (num_lost != 0) {
+                    flags |= sigmf_index::INDEX_GAP;
+                }
+            }
+            _has_time   = true;
+            _ref_time   = metadata.time_spec;
+            _ref_offset = _num_samps;
+        }
+        for (stream_t& stream : _streams) {
+            const uint32_t stream_flags =
+                flags | (stream.tuned ? uint32_t(sigmf_index::INDEX_TUNE) : 0);
+            stream.tuned = false;
+            if ((stream_flags & ~sigmf_index::INDEX_TIME) == 0
+                and _num_samps - stream.last_entry < _index_interval) {
+                continue;
+            }
+            stream.last_entry = _num_samps;
+            sigmf_index::entry_t entry;
+            entry.sample_offset = _num_samps;
+            entry.time_spec     = metadata.time_spec;
+            entry.freq          = stream.freq;
+            entry.flags         = stream_flags;
+            _write_entry(stream, entry);
+
+            if (stream_flags
+                & (sigmf_index::INDEX_START | sigmf_index::INDEX_GAP
+                      | sigmf_index::INDEX_OVERFLOW | sigmf_index::INDEX_TUNE)) {
+                stream.captures.push_back({_num_samps,
+                    metadata.has_time_spec,
+                    metadata.time_spec,
+                    stream.freq});
+            }
+            if (stream_flags & sigmf_index::INDEX_OVERFLOW) {
+                stream.annotations.push_back({_num_samps,
+                    (stream_flags & sigmf_index::INDEX_GAP)
+                        ? str(boost::format("Overflow, %d samples lost") % num_lost)
+                        : "Overflow"});
+            }
+        }
+
+        _overflow = false;
+        _recorder->commit(num_bytes);
+        _num_samps += num_bytes / _item_size;
+    }
+
+    void set_freq(const double freq, const size_t chan)
+    {
+        stream_t& stream = _streams.at(chan);
+        stream.freq      = freq;
+        stream.tuned     = (_num_samps > 0);
+    }
+
+    void close(void)
+    {
+        if (_closed) {
+            return;
+        }
+        _closed = true;
+        // Close all files, even if one fails
+        std::string error;
+        try {
+            _recorder->close();
+        } catch (const uhd::exception& ex) {
+            error = ex.what();
+        }
+        for (stream_t& stream : _streams) {
+            sigmf_index::entry_t entry;
+            entry.sample_offset = _num_samps;
+            entry.freq          = stream.freq;
+            entry.flags         = sigmf_index::INDEX_END;
+            if (_has_time) {
+                entry.time_spec = _expected_time();
+                entry.flags |= sigmf_index::INDEX_TIME;
+            }
+            try {
+                _write_entry(stream, entry);
+                stream.index.close();
+                _write_meta(stream);
+            } catch (const uhd::exception& ex) {
+                error = ex.what();
+            }
+        }
+        if (not error.empty()) {
+            throw uhd::io_error(error);
+        }
+    }
+
+    uint64_t get_num_samps(void) const
+    {
+        return _num_samps;
+    }
+
+    file_recorder::stats_t get_stats(void) const
+    {
+        return _recorder->get_stats();
+    }
+
+private:
+    struct stream_t
+    {
+        std::string base;
+        std::ofstream index;
+        double freq = 0.0;
+        //! True if the next sample starts a new capture segment
+        bool tuned = false;
+        //! The sample offset of the last index entry
+        uint64_t last_entry = 0;
+        std::vector<capture_t> captures;
+        std::vector<annotation_t> annotations;
+    };
+
+    //! The time of the next sample, if there was no gap
+    time_spec_t _expected_time(void) const
+    {
+        return _ref_time
+               + time_spec_t::from_ticks(
+                   static_cast<long long>(_num_samps - _ref_offset), _info.rate);
+    }
+
+    void _write_entry(stream_t& stream, const sigmf_index::entry_t& entry)
+    {
+        char buf[SIGMF_INDEX_ENTRY_SIZE];
+        encode_entry(entry, buf);
+        // Flush every entry, so the index is usable while recording
+        stream.index.write(buf, sizeof(buf));
+        stream.index.flush();
+        if (not stream.index) {
+            throw uhd::io_error(
+                "sigmf_recorder: Could not write the index of " + stream.base);
+        }
+    }
+
+    void _write_meta(const stream_t& stream) const
+    {
+        const std::string meta_file = stream.base + ".sigmf-meta";
+        std::ofstream meta(meta_file.c_str(), std::ios::trunc);
+        meta << "{\n    \"global\": {\n";
+        meta << "        \"core:datatype\": " << json_string(_datatype) << ",\n";
+        meta << "        \"core:sample_rate\": " << json_number(_info.rate) << ",\n";
+        meta << "        \"core:version\": \"1.0.0\",\n";
+        meta << "        \"core:recorder\": "
+             << json_string("UHD " + uhd::get_version_string()) << ",\n";
+        if (not _info.hw.empty()) {
+            meta << "        \"core:hw\": " << json_string(_info.hw) << ",\n";
+        }
+        if (not _info.description.empty()) {
+            meta << "        \"core:description\": " << json_string(_info.description)
+                 << ",\n";
+        }
+        meta << "        \"core:extensions\": [\n"
+             << "            {\"name\": \"uhd\", \"version\": \"1.0.0\", "
+                "\"optional\": true}\n"
+             << "        ]\n    },\n";
+
+        meta << "    \"captures\": [";
+        for (size_t i = 0; i < stream.captures.size(); i++) {
+            const capture_t& capture = stream.captures[i];
+            meta << (i ? ",\n" : "\n") << "        {\"core:sample_start\": "
+                 << capture.sample_offset
+                 << ", \"core:frequency\": " << json_number(capture.freq);
+            if (capture.has_time_spec) {
+                meta << ", \"uhd:full_secs\": " << capture.time_spec.get_full_secs()
+                     << ", \"uhd:frac_secs\": "
+                     << json_number(capture.time_spec.get_frac_secs());
+            }
+            meta << "}";
+        }
+        meta << "\n    ],\n";
+
+        meta << "    \"annotations\": [";
+        for (size_t i = 0; i < stream.annotations.size(); i++) {
+            const annotation_t& annotation = stream.annotations[i];
+            meta << (i ? ",\n" : "\n") << "        {\"core:sample_start\": "
+                 << annotation.sample_offset
+                 << ", \"core:comment\": " << json_string(annotation.comment) << "}";
+        }
+        meta << "\n    ]\n}\n";
+
+        meta.close();
+        if (not meta) {
+            throw uhd::io_error("sigmf_recorder: Could not write " + meta_file);
+        }
+    }
+
+    const info_t _info;
+    const std::string _datatype;
+    const size_t _item_size;
+    const uint64_t _index_interval;
+    std::vector<stream_t> _streams;
+    file_recorder::sptr _recorder;
+    bool _closed = false;
+
+    uint64_t _num_samps = 0;
+    bool _overflow      = false;
+    //! The time of the sample at _ref_offset, from the last time stamp
+    bool _has_time = false;
+    time_spec_t _ref_time;
+    uint64_t _ref_offset = 0;
+};
+
+sigmf_recorder::~sigmf_recorder(void)
+{
+    /* NOP */
+}
+
+sigmf_recorder::sptr sigmf_recorder::make(const std::vector<std::string>& bases,
+    const info_t& info,
+    const device_addr_t& args)
+{
+    if (bases.empty()) {
+        throw uhd::value_error("sigmf_recorder: No files given");
+    }
+    if (info.rate <= 0.0) {
+        throw uhd::value_error("sigmf_recorder: The sample rate must be positive");
+    }
+    if (args.has_key("compress")) {
+        throw uhd::value_error("sigmf_recorder: SigMF recordings can't be compressed");
+    }
+    for (const sigmf_type_t& type : SIGMF_TYPES) {
+        if (info.cpu_format == type.cpu_format) {
+            return std::make_shared<sigmf_recorder_impl>(bases, info, type, args);
+        }
+    }
+    throw uhd::value_error(
+        "sigmf_recorder: No SigMF type for CPU format " + info.cpu_format);
+}
+
+/***********************************************************************
+ * Index reader
+ **********************************************************************/
+class sigmf_index_impl : public sigmf_index
+{
+public:
+    sigmf_index_impl(const std::string& path)
+        : _path(path), _file(path.c_str(), std::ios::binary)
+    {
+        if (not _file) {
+            throw uhd::os_error(str(
+                boost::format("Could not open %s: %s") % path % std::strerror(errno)));
+        }
+        char header[SIGMF_INDEX_HEADER_SIZE];
+        _file.read(header, sizeof(header));
+        const char* buf = header;
+        if (not _file
+            or std::memcmp(buf, SIGMF_INDEX_MAGIC, sizeof(SIGMF_INDEX_MAGIC)) != 0) {
+            throw uhd::value_error("sigmf_index: Not an index: " + path);
+        }
+        buf += sizeof(SIGMF_INDEX_MAGIC);
+        const uint32_t version    = get<uint32_t>(buf);
+        const uint32_t entry_size = get<uint32_t>(buf);
+        _rate                     = get<double>(buf);
+        _item_size                = get<uint32_t>(buf);
+        if (version != SIGMF_INDEX_VERSION or entry_size != SIGMF_INDEX_ENTRY_SIZE) {
+            throw uhd::value_error(
+                str(boost::format("sigmf_index: Unsupported index version %d in %s")
+                    % version % path));
+        }
+
+        // A recording that was cut short may end in a partial entry
+        _file.seekg(0, std::ios::end);
+        _num_entries =
+            (size_t(_file.tellg()) - SIGMF_INDEX_HEADER_SIZE) / SIGMF_INDEX_ENTRY_SIZE;
+    }
+
+    double get_rate(void) const
+    {
+        return _rate;
+    }
+
+    size_t get_item_size(void) const
+    {
+        return _item_size;
+    }
+
+    size_t get_num_entries(void) const
+    {
+        return _num_entries;
+    }
+
+    entry_t get_entry(const size_t index) const
+    {
+        if (index >= _num_entries) {
+            throw uhd::index_error(
+                str(boost::format("sigmf_index: Entry %d of %d") % index % _num_entries));
+        }
+        std::lock_guard<std::mutex> lock(_mutex);
+        char buf[SIGMF_INDEX_ENTRY_SIZE];
+        _file.seekg(SIGMF_INDEX_HEADER_SIZE + index * SIGMF_INDEX_ENTRY_SIZE);
+        _file.read(buf, sizeof(buf));
+        if (not _file) {
+            _file.clear();
+            throw uhd::io_error("sigmf_index: Could not read " + _path);
+        }
+        return decode_entry(buf);
+    }
+
+    uint64_t find(const time_spec_t& time_spec) const
+    {
+        _check_time();
+        // Find the first entry after the time, the sample is in the one before
+        size_t begin = 0, end = _num_entries;
+        while (begin < end) {
+            const size_t mid = begin + (end - begin) / 2;
+            if (get_entry(mid).time_spec <= time_spec) {
+                begin = mid + 1;
+            } else {
+                end = mid;
+            }
+        }
+        if (begin == 0) {
+            return get_entry(0).sample_offset;
+        }
+        const entry_t entry = get_entry(begin - 1);
+        if (entry.flags & INDEX_END) {
+            return entry.sample_offset;
+        }
+        const uint64_t offset = entry.sample_offset
+                                + (time_spec - entry.time_spec).to_ticks(_rate);
+        // A time in a gap maps to the first sample after it
+        return begin < _num_entries
+                   ? std::min(offset, get_entry(begin).sample_offset)
+                   : offset;
+    }
+
+    time_spec_t get_time(const uint64_t sample_offset) const
+    {
+        _check_time();
+        size_t begin = 0, end = _num_entries;
+        while (begin < end) {
+            const size_t mid = begin + (end - begin) / 2;
+            if (get_entry(mid).sample_offset <= sample_offset) {
+                begin = mid + 1;
+            } else {
+                end = mid;
+            }
+        }
+        const entry_t entry = get_entry(begin == 0 ? 0 : begin - 1);
+        if (not(entry.flags & INDEX_TIME)) {
+            throw uhd::runtime_error(
+                "sigmf_index: No time stamp for this sample in " + _path);
+        }
+        return entry.time_spec
+               + time_spec_t::from_ticks(
+                   static_cast<long long>(sample_offset)
+                       - static_cast<long long>(entry.sample_offset),
+                   _rate);
+    }
+
+private:
+    void _check_time(void) const
+    {
+        if (_num_entries == 0 or not(get_entry(0).flags & INDEX_TIME)) {
+            throw uhd::runtime_error("sigmf_index: No time stamps in " + _path);
+        }
+    }
+
+    const std::string _path;
+    mutable std::mutex _mutex;
+    mutable std::ifstream _file;
+    double _rate;
+    size_t _item_size;
+    size_t _num_entries;
+};
+
+sigmf_index::~sigmf_index(void)
+{
+    /* NOP */
+}
+
+sigmf_index::sptr sigmf_index::make(const std::string& path)
+{
+    return std::make_shared<sigmf_index_impl>(path);
+}
@@ -0,0 +1,149 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/utils/log.hpp>
+#include <uhdlib/utils/staged_init.hpp>
+#include <uhdlib/utils/trace_events.hpp>
+#include <boost/format.hpp>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <sstream>
+#include <thread>
+
+using namespace uhd;
+
+staged_init::staged_init(const std::string& log_id, const bool serialize)
+    : _log_id(log_id), _serialize(serialize)
+{
+    // nop
+}
+
+void staged_init::run(const std::string& name,
+    const size_t num_units,
+    const std::function<void(size_t)>& phase_fn,
+    const size_t max_threads)
+{
+    std::vector<duration_t> unit_times(num_units, duration_t(0.0));
+    std::vector<std::exception_ptr> errors(num_units);
+    auto run_unit = [&](const size_t unit) {
+        const trace_events::scoped_span trace_span("init", [this, &name, unit]() {
+            return str(boost::format("%s %s %d") % _log_id % name % unit);
+        });
+        const auto start = std::chrono::steady_clock::now();
+        try {
+            phase_fn(unit);
+        } catch (...) {
+            errors[unit] = std::current_exception();
+        }
+        unit_times[unit] = std::chrono::steady_clock::now() - start;
+        return not errors[unit];
+    };
+
+    size_t phase_index;
+    {
+        std::lock_guard<std::mutex> lock(_timings_mutex);
+        phase_index = _timings.size();
+        _timings.push_back({name, false, duration_t(0.0), {}});
+    }
+    UHD_LOG_TRACE(_log_id, "Init phase " << name << " for " << num_units << " unit(s)");
+    const auto start = std::chrono::steady_clock::now();
+    if (_serialize or num_units <= 1) {
+        for (size_t unit = 0; unit < num_units; unit++) {
+            if (not run_unit(unit)) {
+                break;
+            }
+        }
+    } else {
+        const size_t num_threads =
+            (max_threads == 0) ? num_units : std::min(num_units, max_threads);
+        std::atomic<size_t> next_unit(0);
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < num_threads; i++) {
+            threads.emplace_back([&]() {
+                for (size_t unit = next_unit++; unit < num_units; unit = next_unit++) {
+                    run_unit(unit);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(_timings_mutex);
+        _timings[phase_index].total = std::chrono::steady_clock::now() - start;
+        _timings[phase_index].units = unit_times;
+    }
+
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+void staged_init::time_step(
+    const std::string& name, const size_t unit, const std::function<void()>& step_fn)
+{
+    const trace_events::scoped_span trace_span("init", [this, &name, unit]() {
+        return str(boost::format("%s %s %d") % _log_id % name % unit);
+    });
+    const auto start = std::chrono::steady_clock::now();
+    try {
+        step_fn();
+    } catch (...) {
+        _add_timing(name, unit, std::chrono::steady_clock::now() - start);
+        throw;
+    }
+    _add_timing(name, unit, std::chrono::steady_clock::now() - start);
+}
+
+std::string staged_init::get_report() const
+{
+    std::lock_guard<std::mutex> lock(_timings_mutex);
+    std::ostringstream report;
+    report << "Initialization times:";
+    for (const timing_t& timing : _timings) {
+        report << "\n" << (timing.is_step ? "    " : "  ") << timing.name << ": ";
+        if (not timing.is_step) {
+            report << boost::format("%.3f s, ") % timing.total.count();
+        }
+        const auto slowest = std::max_element(timing.units.begin(), timing.units.end());
+        if (slowest == timing.units.end()) {
+            report << "no units";
+            continue;
+        }
+        report << boost::format("slowest unit %d took %.3f s")
+                      % std::distance(timing.units.begin(), slowest)
+                      % slowest->count();
+    }
+    return report.str();
+}
+
+void staged_init::log_report() const
+{
+    UHD_LOG_DEBUG(_log_id, get_report());
+}
+
+void staged_init::_add_timing(
+    const std::string& name, const size_t unit, const duration_t time)
+{
+    std::lock_guard<std::mutex> lock(_timings_mutex);
+    // Steps are listed after the phase they ran in, i.e., the last phase
+    auto step = std::find_if(
+        _timings.rbegin(), _timings.rend(), [&name](const timing_t& timing) {
+            return not timing.is_step or timing.name == name;
+        });
+    if (step == _timings.rend() or not step->is_step) {
+        _timings.push_back({name, true, duration_t(0.0), {}});
+        step = _timings.rbegin();
+    }
+    if (step->units.size() <= unit) {
+        step->units.resize(unit + 1, duration_t(0.0));
+    }
+    step->units[unit] = time;
+}
@@ -0,0 +1,190 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhd/utils/stream_selector.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+#ifndef _WIN32
+#    include <poll.h>
+#endif
+
+using namespace uhd;
+
+namespace {
+
+constexpr double STREAM_SELECTOR_DEFAULT_POLL_INTERVAL = 1e-3;
+
+//! A streamer and how to wait for it
+struct selector_entry_t
+{
+    rx_streamer::sptr rx_stream;
+    tx_streamer::sptr tx_stream;
+    //! False once the RX streamer turned out not to support waiting
+    bool waitable = true;
+};
+
+class stream_selector_impl : public stream_selector
+{
+public:
+    stream_selector_impl(const double poll_interval)
+        : _poll_interval(std::chrono::duration_cast<clock::duration>(
+              std::chrono::duration<double>(poll_interval)))
+        , _last_polled(clock::now())
+    {
+    }
+
+    size_t add_rx_streamer(rx_streamer::sptr rx_stream)
+    {
+        selector_entry_t entry;
+        entry.rx_stream = rx_stream;
+        _entries.push_back(entry);
+        return _entries.size() - 1;
+    }
+
+    size_t add_tx_streamer(tx_streamer::sptr tx_stream)
+    {
+        if (tx_stream->get_async_msg_fd() < 0) {
+            throw uhd::value_error("stream_selector: the TX streamer has no async "
+                                   "message descriptor, make it with async_msg_fd");
+        }
+        selector_entry_t entry;
+        entry.tx_stream = tx_stream;
+        _entries.push_back(entry);
+        return _entries.size() - 1;
+    }
+
+    std::vector<size_t> wait(const double timeout)
+    {
+        const auto exit_time = clock::now()
+                               + std::chrono::duration_cast<clock::duration>(
+                                     std::chrono::duration<double>(timeout));
+        std::vector<size_t> ready;
+        while (true) {
+            bool has_polled = false;
+            _fds.clear();
+            _owners.clear();
+            for (size_t i = 0; i < _entries.size(); i++) {
+                selector_entry_t& entry = _entries[i];
+                if (entry.tx_stream) {
+                    _fds.push_back(entry.tx_stream->get_async_msg_fd());
+                } else if (entry.waitable) {
+                    if (_prepare_rx(entry)) {
+                        ready.push_back(i);
+                        continue;
+                    }
+                }
+                has_polled |= not entry.waitable;
+                _owners.resize(_fds.size(), i);
+            }
+
+            const auto now     = clock::now();
+            const bool polling = has_polled and now - _last_polled >= _poll_interval;
+            // Don't sleep if anything is ready, only pick up the rest
+            auto wait_time = std::max(exit_time - now, clock::duration::zero());
+            if (not ready.empty() or polling) {
+                wait_time = clock::duration::zero();
+            } else if (has_polled) {
+                wait_time = std::min(wait_time, _last_polled + _poll_interval - now);
+            }
+            _poll(wait_time, ready);
+
+            if (has_polled
+                and (polling or clock::now() - _last_polled >= _poll_interval)) {
+                for (size_t i = 0; i < _entries.size(); i++) {
+                    if (_entries[i].rx_stream and not _entries[i].waitable) {
+                        ready.push_back(i);
+                    }
+                }
+                _last_polled = clock::now();
+            }
+            if (not ready.empty() or clock::now() >= exit_time) {
+                std::sort(ready.begin(), ready.end());
+                ready.erase(std::unique(ready.begin(), ready.end()), ready.end());
+                return ready;
+            }
+        }
+    }
+
+private:
+    typedef std::chrono::steady_clock clock;
+
+    //! Return true if the streamer has data, else add its descriptors
+    bool _prepare_rx(selector_entry_t& entry)
+    {
+        try {
+            return entry.rx_stream->prepare_recv_wait(_fds);
+        } catch (const uhd::not_implemented_error& ex) {
+            UHD_LOGGER_DEBUG("STREAM_SELECTOR")
+                << "Polling a streamer that can't be waited on: " << ex.what();
+            entry.waitable = false;
+            return false;
+        }
+    }
+
+    //! Wait for the descriptors, and add the owners of readable ones to ready
+    void _poll(const clock::duration wait_time, std::vector<size_t>& ready)
+    {
+#ifndef _WIN32
+        _pollfds.resize(_fds.size());
+        for (size_t i = 0; i < _fds.size(); i++) {
+            _pollfds[i].fd      = _fds[i];
+            _pollfds[i].events  = POLLIN;
+            _pollfds[i].revents = 0;
+        }
+        // Round up, so a short wait doesn't turn into a busy loop
+        const auto timeout_ms =
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                wait_time + std::chrono::milliseconds(1) - clock::duration(1))
+                .count();
+        const int ret = ::poll(_pollfds.data(), _pollfds.size(), int(timeout_ms));
+        if (ret < 0 and errno != EINTR) {
+            throw uhd::os_error(std::string("stream_selector: poll() failed: ")
+                                + std::strerror(errno));
+        }
+        for (size_t i = 0; ret > 0 and i < _pollfds.size(); i++) {
+            if (_pollfds[i].revents != 0) {
+                ready.push_back(_owners[i]);
+            }
+        }
+#else
+        // There are no descriptors to wait on, all RX streamers are polled
+        std::this_thread::sleep_for(wait_time);
+#endif
+    }
+
+    const clock::duration _poll_interval;
+    clock::time_point _last_polled;
+    std::vector<selector_entry_t> _entries;
+    //! The descriptors of the current wait, and the entries they belong to
+    std::vector<int> _fds;
+    std::vector<size_t> _owners;
+#ifndef _WIN32
+    std::vector<pollfd> _pollfds;
+#endif
+};
+
+} // namespace
+
+stream_selector::~stream_selector(void)
+{
+    /* NOP */
+}
+
+stream_selector::sptr stream_selector::make(const device_addr_t& args)
+{
+    const double poll_interval =
+        args.cast<double>("poll_interval", STREAM_SELECTOR_DEFAULT_POLL_INTERVAL);
+    if (poll_interval <= 0.0) {
+        throw uhd::value_error("stream_selector: poll_interval must be positive");
+    }
+    return sptr(new stream_selector_impl(poll_interval));
+}
@@ -12,11 +12,19 @@
 #include <uhd/exception.hpp>
 #include <boost/thread/thread.hpp>
 #include <boost/thread/barrier.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
 #include <exception>
 #include <iostream>
-#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <thread>
-#include <atomic>
+#include <vector>
 
 using namespace uhd;
 
@@ -29,7 +37,7 @@ public:
         _task = std::thread([this, task_fcn](){ this->task_loop(task_fcn); });
         if (not name.empty()) {
 #ifdef HAVE_PTHREAD_SETNAME
-            pthread_setname_np(_task->native_handle(), name.substr(0,16).c_str());
+            pthread_setname_np(_task.native_handle(), name.substr(0,16).c_str());
 #endif /* HAVE_PTHREAD_SETNAME */
         }
     }
@@ -72,6 +80,228 @@ task::sptr task::make(const task_fcn_type &task_fcn, const std::string &name){
     return task::sptr(new task_impl(task_fcn, name));
 }
 
+/***********************************************************************
+ * Periodic tasks, run by a pool of housekeeping threads
+ **********************************************************************/
+namespace {
+
+constexpr size_t DEFAULT_NUM_HOUSEKEEPING_THREADS = 2;
+
+size_t get_num_housekeeping_threads(void)
+{
+    const char* num_threads_env = std::getenv("UHD_HOUSEKEEPING_THREADS");
+    if (num_threads_env != nullptr) {
+        try {
+            const int num_threads = std::stoi(num_threads_env);
+            if (num_threads > 0) {
+                return size_t(num_threads);
+            }
+        } catch (const std::exception&) {
+            // Fall through to the warning
+        }
+        UHD_LOG_WARNING("UHD",
+            "Ignoring invalid value of UHD_HOUSEKEEPING_THREADS: " << num_threads_env);
+    }
+    return DEFAULT_NUM_HOUSEKEEPING_THREADS;
+}
+
+class housekeeping_executor
+{
+public:
+    typedef std::shared_ptr<housekeeping_executor> sptr;
+    typedef std::chrono::steady_clock clock;
+
+    struct entry_t
+    {
+        task::task_fcn_type task_fcn;
+        clock::duration period;
+        std::string name;
+        bool cancelled;
+        bool running;
+        std::thread::id runner;
+    };
+    typedef std::shared_ptr<entry_t> entry_sptr;
+
+    /*! Return the executor, which exists for as long as a periodic task does
+     *
+     * Without periodic tasks, there are no housekeeping threads.
+     */
+    static sptr get(void)
+    {
+        static std::mutex instance_mutex;
+        static std::weak_ptr<housekeeping_executor> instance;
+        std::lock_guard<std::mutex> l(instance_mutex);
+        sptr executor = instance.lock();
+        if (not executor) {
+            executor = std::make_shared<housekeeping_executor>(
+                get_num_housekeeping_threads());
+            instance = executor;
+        }
+        return executor;
+    }
+
+    housekeeping_executor(const size_t num_threads) : _state(std::make_shared<state_t>())
+    {
+        for (size_t i = 0; i < num_threads; i++) {
+            auto state = _state;
+            _threads.emplace_back(new boost::thread([state]() { worker_loop(state); }));
+            set_thread_name(_threads.back().get(), "uhd_housekeep");
+        }
+    }
+
+    ~housekeeping_executor(void)
+    {
+        {
+            std::lock_guard<std::mutex> l(_state->mutex);
+            _state->stop = true;
+        }
+        _state->cond.notify_all();
+        for (auto& thread : _threads) {
+            // The last periodic task may be destroyed by another one's
+            // callback. That worker keeps the state alive until it exits.
+            if (thread->get_id() == boost::this_thread::get_id()) {
+                thread->detach();
+            } else {
+                thread->join();
+            }
+        }
+    }
+
+    //! Schedule a new entry, its first call is due right away
+    void add(entry_sptr entry)
+    {
+        {
+            std::lock_guard<std::mutex> l(_state->mutex);
+            _state->queue.emplace(clock::now(), entry);
+        }
+        _state->cond.notify_all();
+    }
+
+    /*! Unschedule an entry and wait until it's no longer running
+     *
+     * Cancelling an entry from its own callback does not wait, but the
+     * entry won't be rescheduled either.
+     */
+    void cancel(entry_sptr entry)
+    {
+        std::unique_lock<std::mutex> lock(_state->mutex);
+        entry->cancelled = true;
+        for (auto it = _state->queue.begin(); it != _state->queue.end(); ++it) {
+            if (it->second == entry) {
+                _state->queue.erase(it);
+                break;
+            }
+        }
+        if (entry->runner != std::this_thread::get_id()) {
+            _state->cond.wait(lock, [entry]() { return not entry->running; });
+        }
+    }
+
+private:
+    struct state_t
+    {
+        std::mutex mutex;
+        std::condition_variable cond;
+        //! Entries by the time their next call is due
+        std::multimap<clock::time_point, entry_sptr> queue;
+        bool stop = false;
+    };
+
+    static void worker_loop(std::shared_ptr<state_t> state)
+    {
+        std::unique_lock<std::mutex> lock(state->mutex);
+        while (not state->stop) {
+            if (state->queue.empty()) {
+                state->cond.wait(lock);
+                continue;
+            }
+            const auto next = state->queue.begin();
+            if (next->first > clock::now()) {
+                state->cond.wait_until(lock, next->first);
+                continue;
+            }
+            entry_sptr entry = next->second;
+            state->queue.erase(next);
+            entry->running    = true;
+            entry->runner     = std::this_thread::get_id();
+            const auto start  = clock::now();
+            lock.unlock();
+            const bool keep_going = run(*entry);
+            lock.lock();
+            entry->running = false;
+            entry->runner  = std::thread::id();
+            if (keep_going and not entry->cancelled) {
+                state->queue.emplace(
+                    std::max(start + entry->period, clock::now()), entry);
+            }
+            // Wakes up cancel() as well as the other workers
+            state->cond.notify_all();
+        }
+    }
+
+    //! Call the entry's function, return false if it should not be called again
+    static bool run(const entry_t& entry)
+    {
+        try {
+            entry.task_fcn();
+            return true;
+        } catch (const std::exception& e) {
+            UHD_LOGGER_ERROR("UHD")
+                << "An unexpected exception was caught in periodic task "
+                << (entry.name.empty() ? "(unnamed)" : entry.name)
+                << ". The task will now stop, things may not work. " << e.what();
+        } catch (...) {
+            UHD_LOGGER_ERROR("UHD")
+                << "An unknown exception was caught in periodic task "
+                << (entry.name.empty() ? "(unnamed)" : entry.name)
+                << ". The task will now stop, things may not work.";
+        }
+        return false;
+    }
+
+    std::shared_ptr<state_t> _state;
+    std::vector<std::unique_ptr<boost::thread>> _threads;
+};
+
+} // namespace
+
+class periodic_task_impl : public task
+{
+public:
+    periodic_task_impl(
+        const task_fcn_type& task_fcn, const double period, const std::string& name)
+        : _executor(housekeeping_executor::get())
+        , _entry(std::make_shared<housekeeping_executor::entry_t>())
+    {
+        _entry->task_fcn = task_fcn;
+        _entry->period =
+            std::chrono::duration_cast<housekeeping_executor::clock::duration>(
+                std::chrono::duration<double>(period));
+        _entry->name      = name;
+        _entry->cancelled = false;
+        _entry->running   = false;
+        _executor->add(_entry);
+    }
+
+    ~periodic_task_impl(void)
+    {
+        _executor->cancel(_entry);
+    }
+
+private:
+    housekeeping_executor::sptr _executor;
+    housekeeping_executor::entry_sptr _entry;
+};
+
+task::sptr task::make_periodic(
+    const task_fcn_type& task_fcn, const double period, const std::string& name)
+{
+    if (period <= 0.0) {
+        throw uhd::value_error("task::make_periodic(): Period must be positive");
+    }
+    return task::sptr(new periodic_task_impl(task_fcn, period, name));
+}
+
 msg_task::~msg_task(void){
     /* NOP */
 }
@@ -110,3 +110,65 @@ void uhd::set_thread_name(
     UHD_LOG_DEBUG("UHD", "Setting thread name is not implemented; wanted to set to " << name);
 #endif /* HAVE_THREAD_SETNAME_DUMMY */
 }
+
+/***********************************************************************
+ * Pthread API to set affinity
+ **********************************************************************/
+#ifdef HAVE_PTHREAD_SETAFFINITY_NP
+    #include <pthread.h>
+
+    void uhd::set_thread_affinity(const std::vector<size_t>& cpu_affinity_list){
+        if (cpu_affinity_list.empty()) return;
+
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        for (const size_t cpu_num : cpu_affinity_list) {
+            if (cpu_num >= CPU_SETSIZE) {
+                UHD_LOG_WARNING("UHD",
+                    "CPU index " << cpu_num << " in affinity list out of range");
+                continue;
+            }
+            CPU_SET(cpu_num, &cpu_set);
+        }
+        const int ret =
+            pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpu_set);
+        if (ret != 0) {
+            UHD_LOG_WARNING("UHD", "Failed to set desired affinity for thread");
+        }
+    }
+#endif /* HAVE_PTHREAD_SETAFFINITY_NP */
+
+/***********************************************************************
+ * Windows API to set affinity
+ **********************************************************************/
+#ifdef HAVE_WIN_SETTHREADAFFINITYMASK
+    #include <windows.h>
+
+    void uhd::set_thread_affinity(const std::vector<size_t>& cpu_affinity_list){
+        if (cpu_affinity_list.empty()) return;
+
+        DWORD_PTR cpu_set = 0;
+        for (const size_t cpu_num : cpu_affinity_list) {
+            if (cpu_num >= 8 * sizeof(DWORD_PTR)) {
+                UHD_LOG_WARNING("UHD",
+                    "CPU index " << cpu_num << " in affinity list out of range");
+                continue;
+            }
+            cpu_set |= (DWORD_PTR(1) << cpu_num);
+        }
+        if (SetThreadAffinityMask(GetCurrentThread(), cpu_set) == 0) {
+            UHD_LOG_WARNING("UHD", "Failed to set desired affinity for thread");
+        }
+    }
+#endif /* HAVE_WIN_SETTHREADAFFINITYMASK */
+
+/***********************************************************************
+ * Unimplemented API to set affinity
+ **********************************************************************/
+#ifdef HAVE_THREAD_SETAFFINITY_DUMMY
+    void uhd::set_thread_affinity(const std::vector<size_t>& cpu_affinity_list){
+        if (not cpu_affinity_list.empty()) {
+            UHD_LOG_DEBUG("UHD", "Setting thread affinity is not implemented");
+        }
+    }
+#endif /* HAVE_THREAD_SETAFFINITY_DUMMY */
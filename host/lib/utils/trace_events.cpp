@@ -0,0 +1,236 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/utils/log.hpp>
+#include <uhd/utils/safe_call.hpp>
+#include <uhd/utils/static.hpp>
+#include <uhdlib/utils/trace_events.hpp>
+#include <boost/format.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+#ifdef _WIN32
+#    include <process.h>
+#    define getpid _getpid
+#else
+#    include <unistd.h>
+#endif
+
+using namespace uhd;
+
+std::atomic<bool> trace_events::_enabled(false);
+
+namespace {
+
+//! Events per thread at most, later ones are dropped
+constexpr size_t MAX_EVENTS_PER_THREAD = 1 << 20;
+
+struct trace_event_t
+{
+    //! 'X' for a span, 'C' for a counter
+    char phase;
+    const char* category;
+    std::string name;
+    trace_events::clock::time_point time;
+    //! Duration of a span, or value of a counter
+    double value;
+};
+
+//! The events of one thread. The mutex is only contended while writing.
+struct thread_events_t
+{
+    std::mutex mutex;
+    std::vector<trace_event_t> events;
+    size_t num_dropped = 0;
+    size_t tid         = 0;
+};
+
+//! All threads' events, and where they go
+struct trace_state_t
+{
+    ~trace_state_t(void);
+
+    std::mutex mutex;
+    std::string path;
+    trace_events::clock::time_point start_time;
+    std::vector<std::shared_ptr<thread_events_t>> threads;
+};
+
+trace_state_t& get_state(void)
+{
+    static trace_state_t state;
+    return state;
+}
+
+thread_events_t& get_thread_events(void)
+{
+    thread_local std::shared_ptr<thread_events_t> thread_events;
+    if (not thread_events) {
+        thread_events = std::make_shared<thread_events_t>();
+        trace_state_t& state = get_state();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        thread_events->tid = state.threads.size() + 1;
+        state.threads.push_back(thread_events);
+    }
+    return *thread_events;
+}
+
+void record(trace_event_t&& event)
+{
+    thread_events_t& thread_events = get_thread_events();
+    std::lock_guard<std::mutex> lock(thread_events.mutex);
+    if (thread_events.events.size() >= MAX_EVENTS_PER_THREAD) {
+        thread_events.num_dropped++;
+        return;
+    }
+    thread_events.events.push_back(std::move(event));
+}
+
+/*! Write the trace and stop recording
+ *
+ * \param quiet don't log, the logger may be gone at exit
+ * \return the number of dropped events
+ */
+size_t write_trace(trace_state_t& state, const bool quiet);
+
+trace_state_t::~trace_state_t(void)
+{
+    // Write the trace when the process exits
+    UHD_SAFE_CALL(write_trace(*this, true);)
+}
+
+std::string escape_json(const std::string& str)
+{
+    std::string escaped;
+    escaped.reserve(str.size());
+    for (const char c : str) {
+        if (c == '"' or c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+            escaped += buf;
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+double to_us(const trace_events::clock::duration duration)
+{
+    return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+size_t write_trace(trace_state_t& state, const bool quiet)
+{
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (not trace_events::_enabled.exchange(false)) {
+        return 0;
+    }
+
+    std::ofstream out(state.path.c_str());
+    if (not out) {
+        throw uhd::os_error("Could not open trace file " + state.path);
+    }
+    const int pid      = int(getpid());
+    size_t num_dropped = 0;
+    bool first         = true;
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    for (auto& thread_events : state.threads) {
+        std::lock_guard<std::mutex> thread_lock(thread_events->mutex);
+        for (const trace_event_t& event : thread_events->events) {
+            out << (first ? "" : ",\n")
+                << boost::format("{\"ph\":\"%c\",\"cat\":\"%s\",\"name\":\"%s\","
+                                 "\"pid\":%d,\"tid\":%d,\"ts\":%.3f,")
+                       % event.phase % event.category % escape_json(event.name) % pid
+                       % thread_events->tid % to_us(event.time - state.start_time);
+            if (event.phase == 'X') {
+                out << boost::format("\"dur\":%.3f}") % event.value;
+            } else {
+                out << boost::format("\"args\":{\"value\":%g}}") % event.value;
+            }
+            first = false;
+        }
+        num_dropped += thread_events->num_dropped;
+        thread_events->events.clear();
+        thread_events->events.shrink_to_fit();
+    }
+    out << "\n]}\n";
+    if (not out) {
+        throw uhd::os_error("Could not write trace file " + state.path);
+    }
+    if (not quiet) {
+        if (num_dropped > 0) {
+            UHD_LOGGER_WARNING("TRACE") << "Dropped " << num_dropped
+                                        << " trace events, the buffers were full";
+        }
+        UHD_LOGGER_INFO("TRACE") << "Wrote trace file " << state.path;
+    }
+    return num_dropped;
+}
+
+} // namespace
+
+UHD_STATIC_BLOCK(trace_events_from_env)
+{
+    const char* trace_file_env = std::getenv("UHD_TRACE_FILE");
+    if (trace_file_env != nullptr and trace_file_env[0] != '\0') {
+        trace_events::start(trace_file_env);
+    }
+}
+
+void trace_events::start(const std::string& path)
+{
+    trace_state_t& state = get_state();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (is_enabled()) {
+        return;
+    }
+    for (auto& thread_events : state.threads) {
+        std::lock_guard<std::mutex> thread_lock(thread_events->mutex);
+        thread_events->events.clear();
+        thread_events->num_dropped = 0;
+    }
+    state.path       = path;
+    state.start_time = clock::now();
+    _enabled.store(true);
+    UHD_LOGGER_INFO("TRACE") << "Recording a trace into " << path;
+}
+
+void trace_events::start(const uhd::device_addr_t& args)
+{
+    if (args.has_key("trace_file")) {
+        start(args["trace_file"]);
+    }
+}
+
+void trace_events::stop(void)
+{
+    write_trace(get_state(), false);
+}
+
+void trace_events::complete(
+    const char* category, const std::string& name, clock::time_point start)
+{
+    if (not is_enabled()) {
+        return;
+    }
+    record({'X', category, name, start, to_us(clock::now() - start)});
+}
+
+void trace_events::counter(const char* category, const std::string& name, double value)
+{
+    if (not is_enabled()) {
+        return;
+    }
+    record({'C', category, name, clock::now(), value});
+}
@@ -33,8 +33,10 @@ class MultiUSRP(lib.usrp.multi_usrp):
 
         for chan in channels:
             super(MultiUSRP, self).set_rx_rate(rate, chan)
-            super(MultiUSRP, self).set_rx_freq(lib.types.tune_request(freq), chan)
-            super(MultiUSRP, self).set_rx_gain(gain, chan)
+        # Tune all channels in one call, so several motherboards are tuned
+        # concurrently
+        super(MultiUSRP, self).set_rx_freq(lib.types.tune_request(freq), list(channels))
+        super(MultiUSRP, self).set_rx_gain(gain, list(channels))
 
         st_args = lib.usrp.stream_args("fc32", "sc16")
         st_args.channels = channels
@@ -49,20 +51,18 @@ class MultiUSRP(lib.usrp.multi_usrp):
         stream_cmd.stream_now = True
         streamer.issue_stream_cmd(stream_cmd)
 
-        samps = np.array([], dtype=np.complex64)
+        # Receive straight into the result, recv_fill() only returns early on
+        # errors
         while recv_samps < num_samps:
-            samps = streamer.recv(recv_buffer, metadata)
+            recv_samps += streamer.recv_fill(result, metadata, offset=recv_samps)
 
             if metadata.error_code != lib.types.rx_metadata_error_code.none:
                 print(metadata.strerror())
-            if samps:
-                real_samps = min(num_samps - recv_samps, samps)
-                result[:, recv_samps:recv_samps + real_samps] = recv_buffer[:, 0:real_samps]
-                recv_samps += real_samps
 
         stream_cmd = lib.types.stream_cmd(lib.types.stream_mode.stop_cont)
         streamer.issue_stream_cmd(stream_cmd)
 
+        samps = streamer.recv(recv_buffer, metadata)
         while samps:
             samps = streamer.recv(recv_buffer, metadata)
 
@@ -89,8 +89,10 @@ class MultiUSRP(lib.usrp.multi_usrp):
         """
         for chan in channels:
             super(MultiUSRP, self).set_tx_rate(rate, chan)
-            super(MultiUSRP, self).set_tx_freq(lib.types.tune_request(freq), chan)
-            super(MultiUSRP, self).set_tx_gain(gain, chan)
+        # Tune all channels in one call, so several motherboards are tuned
+        # concurrently
+        super(MultiUSRP, self).set_tx_freq(lib.types.tune_request(freq), list(channels))
+        super(MultiUSRP, self).set_tx_gain(gain, list(channels))
 
         st_args = lib.usrp.stream_args("fc32", "sc16")
         st_args.channels = channels
@@ -126,6 +128,55 @@ class MultiUSRP(lib.usrp.multi_usrp):
         return send_samps
 
 
+class RXStreamIterator(object):
+    """
+    Iterates over blocks of samples from an RX streamer without allocating
+
+    The blocks are received into a ring of preallocated arrays with
+    recv_fill(), which releases the GIL while it waits for the samples. A
+    block stays valid for the next num_blocks - 1 iterations, so it can be
+    handed to another thread for processing in the meantime. Streaming has to
+    be started and stopped with stream commands as usual:
+
+        for samps, metadata in RXStreamIterator(streamer, 100000):
+            process(samps)
+    """
+    def __init__(self, streamer, block_size, num_blocks=4, dtype=np.complex64,
+                 timeout=0.1):
+        """
+        :param streamer: the RX streamer to receive from
+        :param block_size: samples per channel and block
+        :param num_blocks: number of blocks in the ring
+        :param dtype: numpy dtype matching the CPU format of the streamer
+        :param timeout: timeout of every recv() call (s)
+        """
+        channels = streamer.get_num_channels()
+        self._streamer = streamer
+        self._timeout = timeout
+        self._blocks = [np.empty((channels, block_size), dtype=dtype)
+                        for _ in range(num_blocks)]
+        self._metadata = [lib.types.rx_metadata() for _ in range(num_blocks)]
+        self._index = 0
+
+    def __iter__(self):
+        return self
+
+    def __next__(self):
+        """
+        Receive the next block
+        :return: a view of the samples received into the block (a full block
+                 unless an error or the end of a burst stopped it early), and
+                 the metadata
+        """
+        block = self._blocks[self._index]
+        metadata = self._metadata[self._index]
+        self._index = (self._index + 1) % len(self._blocks)
+        num_samps = self._streamer.recv_fill(block, metadata, self._timeout)
+        return block[:, :num_samps], metadata
+
+    next = __next__
+
+
 SubdevSpecPair = lib.usrp.subdev_spec_pair
 SubdevSpec = lib.usrp.subdev_spec
 GPIOAtrReg = lib.usrp.gpio_atr_reg
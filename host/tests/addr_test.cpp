@@ -88,3 +88,19 @@ BOOST_AUTO_TEST_CASE(test_map_device_addr)
     BOOST_CHECK_EQUAL(dev_addr["key1"], "val1");
     BOOST_CHECK_EQUAL(dev_addr["key2"], "val2");
 }
+
+BOOST_AUTO_TEST_CASE(test_separate_device_addr)
+{
+    const uhd::device_addrs_t dev_addrs = uhd::separate_device_addr(
+        uhd::device_addr_t("type=x300,addr0=192.168.10.2,addr12=192.168.20.2"));
+    BOOST_REQUIRE_EQUAL(dev_addrs.size(), 13);
+    BOOST_CHECK_EQUAL(dev_addrs[0]["addr"], "192.168.10.2");
+    BOOST_CHECK_EQUAL(dev_addrs[12]["addr"], "192.168.20.2");
+    BOOST_CHECK_EQUAL(dev_addrs[5]["type"], "x300");
+    BOOST_CHECK(not dev_addrs[5].has_key("addr"));
+
+    BOOST_CHECK_THROW(
+        uhd::separate_device_addr(uhd::device_addr_t("0addr=foo")), std::runtime_error);
+    BOOST_CHECK_THROW(
+        uhd::separate_device_addr(uhd::device_addr_t("addr0a=foo")), std::runtime_error);
+}
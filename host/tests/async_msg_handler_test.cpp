@@ -0,0 +1,99 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "mock_zero_copy.hpp"
+#include <uhdlib/rfnoc/async_msg_handler.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <thread>
+
+using namespace uhd::rfnoc;
+using uhd::transport::vrt::if_packet_info_t;
+
+namespace {
+
+async_msg_handler::sptr make_msg_handler(void)
+{
+    auto xport = boost::make_shared<mock_zero_copy>(if_packet_info_t::LINK_TYPE_CHDR);
+    return async_msg_handler::make(xport, xport, uhd::sid_t(0), uhd::ENDIANNESS_BIG);
+}
+
+async_msg_t make_msg(const async_msg_t::event_code_t event_code)
+{
+    async_msg_t msg;
+    msg.event_code = event_code;
+    return msg;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_async_msg_dispatch)
+{
+    auto msg_handler = make_msg_handler();
+    size_t num_acks = 0, num_underflows = 0;
+    auto count_ack       = [&num_acks](const async_msg_t&) { num_acks++; };
+    auto count_underflow = [&num_underflows](const async_msg_t&) { num_underflows++; };
+    BOOST_CHECK_EQUAL(
+        msg_handler->register_event_handler(async_msg_t::EVENT_CODE_BURST_ACK, count_ack),
+        1);
+    BOOST_CHECK_EQUAL(msg_handler->register_event_handler(
+                          async_msg_t::EVENT_CODE_UNDERFLOW, count_underflow),
+        1);
+    BOOST_CHECK_EQUAL(
+        msg_handler->register_event_handler(async_msg_t::EVENT_CODE_BURST_ACK, count_ack),
+        2);
+
+    msg_handler->post_async_msg(make_msg(async_msg_t::EVENT_CODE_BURST_ACK));
+    BOOST_CHECK_EQUAL(num_acks, 2);
+    BOOST_CHECK_EQUAL(num_underflows, 0);
+
+    // A message with several event codes goes to all of their handlers
+    msg_handler->post_async_msg(make_msg(async_msg_t::event_code_t(
+        async_msg_t::EVENT_CODE_BURST_ACK | async_msg_t::EVENT_CODE_UNDERFLOW)));
+    BOOST_CHECK_EQUAL(num_acks, 4);
+    BOOST_CHECK_EQUAL(num_underflows, 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_async_msg_register_while_dispatching)
+{
+    auto msg_handler = make_msg_handler();
+    std::atomic<size_t> num_msgs(0);
+    std::atomic<bool> running(true);
+    std::thread poster([&]() {
+        while (running) {
+            msg_handler->post_async_msg(make_msg(async_msg_t::EVENT_CODE_SEQ_ERROR));
+        }
+    });
+
+    // Handlers that are registered while messages are dispatched start
+    // receiving them
+    constexpr size_t num_handlers = 100;
+    for (size_t i = 0; i < num_handlers; i++) {
+        BOOST_CHECK_EQUAL(
+            msg_handler->register_event_handler(async_msg_t::EVENT_CODE_SEQ_ERROR,
+                [&num_msgs](const async_msg_t&) { num_msgs++; }),
+            int(i + 1));
+    }
+    const size_t num_msgs_registered = num_msgs;
+    while (num_msgs < num_msgs_registered + num_handlers) {
+        std::this_thread::yield();
+    }
+    running = false;
+    poster.join();
+
+    // A handler may register other handlers
+    size_t num_nested = 0;
+    msg_handler->register_event_handler(
+        async_msg_t::EVENT_CODE_USER_PAYLOAD, [&](const async_msg_t&) {
+            msg_handler->register_event_handler(async_msg_t::EVENT_CODE_USER_PAYLOAD,
+                [&num_nested](const async_msg_t&) { num_nested++; });
+        });
+    msg_handler->post_async_msg(make_msg(async_msg_t::EVENT_CODE_USER_PAYLOAD));
+    BOOST_CHECK_EQUAL(num_nested, 0);
+    msg_handler->post_async_msg(make_msg(async_msg_t::EVENT_CODE_USER_PAYLOAD));
+    BOOST_CHECK_EQUAL(num_nested, 1);
+}
@@ -7,6 +7,8 @@
 
 #include <uhd/exception.hpp>
 #include <uhd/rfnoc/block_id.hpp>
+#include <uhd/rfnoc/constants.hpp>
+#include <boost/regex.hpp>
 #include <boost/test/unit_test.hpp>
 #include <iostream>
 
@@ -109,3 +111,28 @@ BOOST_AUTO_TEST_CASE(test_block_id_cmp)
     BOOST_CHECK(block_id_t("0/FFT_1") < block_id_t("1/aaaaaaaaa_0"));
     BOOST_CHECK(not(block_id_t("0/FFT_1") > block_id_t("1/aaaaaaaaa_0")));
 }
+
+BOOST_AUTO_TEST_CASE(test_block_id_syntax)
+{
+    // The parser accepts exactly what the regular expressions do
+    const std::vector<std::string> strs{"", "FFT", "0/FFT_1", "00/Filter_12",
+        "12/FFT", "FFT_1", "FFT2", "FFT_123", "FFT_", "_1", "/FFT", "0/", "0FFT",
+        "0//FFT", "0/1FFT", "0/FFT_1_2", "0/F-T", "0/FFT_1a", "a1b2c3_99", "1/a",
+        "0/FFT/1"};
+    for (const std::string& str : strs) {
+        BOOST_CHECK_MESSAGE(
+            block_id_t::is_valid_block_id(str)
+                == boost::regex_match(str, boost::regex(VALID_BLOCKID_REGEX)),
+            "is_valid_block_id(\"" << str << "\")");
+        BOOST_CHECK_MESSAGE(
+            block_id_t::is_valid_blockname(str)
+                == boost::regex_match(str, boost::regex(VALID_BLOCKNAME_REGEX)),
+            "is_valid_blockname(\"" << str << "\")");
+    }
+
+    // A device number that doesn't fit is rejected
+    block_id_t block_id("0/FFT_1");
+    BOOST_CHECK(not block_id.set("123456789012345678901234567890/FFT_1"));
+    BOOST_CHECK(not block_id.match("123456789012345678901234567890/FFT_1"));
+    BOOST_CHECK_EQUAL(block_id.to_string(), "0/FFT_1");
+}
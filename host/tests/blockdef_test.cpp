@@ -81,3 +81,14 @@ BOOST_AUTO_TEST_CASE(test_regs)
     BOOST_CHECK_EQUAL(user_regs["RB_FFT_RESET"], 0);
     BOOST_CHECK_EQUAL(user_regs["RB_MAGNITUDE_OUT"], 1);
 }
+
+BOOST_AUTO_TEST_CASE(test_cache)
+{
+    // Block definitions are only made once per NoC ID
+    blockdef::sptr fft = blockdef::make_from_noc_id(0xFF70000000000000);
+    BOOST_CHECK(fft == blockdef::make_from_noc_id(0xFF70000000000000));
+    BOOST_CHECK(fft != blockdef::make_from_noc_id(0xF112000000000001));
+    // Lookups that fail are cached as well
+    BOOST_CHECK(not blockdef::make_from_noc_id(0x0123456789ABCDEF));
+    BOOST_CHECK(not blockdef::make_from_noc_id(0x0123456789ABCDEF));
+}
@@ -0,0 +1,45 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhdlib/transport/buff_tuning.hpp>
+#include <boost/test/unit_test.hpp>
+
+using uhd::transport::buff_tuning_t;
+using uhd::transport::tune_xport_buffs;
+
+BOOST_AUTO_TEST_CASE(test_tune_xport_buffs_fast)
+{
+    // 200 Msps sc16 for 10 ms: MTU sized frames, all of it buffered
+    const buff_tuning_t tuning = tune_xport_buffs(800e6, 10.0, 8000, 8, 0);
+    BOOST_CHECK_EQUAL(tuning.frame_size, 8000);
+    BOOST_CHECK_EQUAL(tuning.num_frames, 1000);
+    BOOST_CHECK_EQUAL(tuning.buff_size, 8000000);
+
+    // The socket buffer is limited, the frames are not
+    const buff_tuning_t limited = tune_xport_buffs(800e6, 10.0, 8000, 8, 4000000);
+    BOOST_CHECK_EQUAL(limited.num_frames, 1000);
+    BOOST_CHECK_EQUAL(limited.buff_size, 4000000);
+
+    // Very long buffering caps the number of frames
+    const buff_tuning_t capped = tune_xport_buffs(800e6, 1000.0, 8000, 8, 0);
+    BOOST_CHECK_EQUAL(capped.num_frames, 4096);
+    BOOST_CHECK_EQUAL(capped.buff_size, 800000000);
+}
+
+BOOST_AUTO_TEST_CASE(test_tune_xport_buffs_slow)
+{
+    // 1 Msps sc16 for 10 ms is 40000 bytes, which fills 8 frames of 5000
+    const buff_tuning_t tuning = tune_xport_buffs(4e6, 10.0, 8000, 8, 0);
+    BOOST_CHECK_EQUAL(tuning.frame_size, 5000);
+    BOOST_CHECK_EQUAL(tuning.num_frames, 8);
+    BOOST_CHECK_EQUAL(tuning.buff_size, 40000);
+
+    // Frames don't get tiny, and there are always enough of them
+    const buff_tuning_t tiny = tune_xport_buffs(4e3, 10.0, 8000, 8, 0);
+    BOOST_CHECK_EQUAL(tiny.frame_size, 512);
+    BOOST_CHECK_EQUAL(tiny.num_frames, 8);
+    BOOST_CHECK_EQUAL(tiny.buff_size, 8 * 512);
+}
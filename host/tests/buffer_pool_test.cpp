@@ -0,0 +1,63 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/transport/buffer_pool.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cstring>
+
+using namespace uhd::transport;
+
+namespace {
+
+void check_pool(buffer_pool::sptr pool, const size_t num_buffs, const size_t buff_size)
+{
+    BOOST_REQUIRE(pool);
+    BOOST_REQUIRE_EQUAL(pool->size(), num_buffs);
+    for (size_t i = 0; i < num_buffs; i++) {
+        BOOST_CHECK_EQUAL(size_t(pool->at(i)) % 64, 0);
+        if (i > 0) {
+            BOOST_CHECK_GE(size_t(pool->at(i)) - size_t(pool->at(i - 1)), buff_size);
+        }
+        // Must be writable all the way
+        std::memset(pool->at(i), int(i), buff_size);
+    }
+    BOOST_CHECK_EQUAL(static_cast<unsigned char*>(pool->at(num_buffs - 1))[0],
+        (num_buffs - 1) & 0xFF);
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_buffer_pool)
+{
+    check_pool(buffer_pool::make(100, 1000, 64), 100, 1000);
+}
+
+BOOST_AUTO_TEST_CASE(test_buffer_pool_mem_params)
+{
+    // Falls back to regular pages if no hugepages are reserved
+    buffer_pool::mem_params_t mem_params;
+    mem_params.hugepage_size = size_t(1) << 21;
+    check_pool(buffer_pool::make(300, 8000, 64, mem_params), 300, 8000);
+
+    mem_params.hugepage_size = 0;
+    mem_params.numa_node     = 0;
+    check_pool(buffer_pool::make(10, 8000, 64, mem_params), 10, 8000);
+}
+
+BOOST_AUTO_TEST_CASE(test_buffer_pool_get_mem_params)
+{
+    buffer_pool::mem_params_t mem_params =
+        buffer_pool::get_mem_params(uhd::device_addr_t(""));
+    BOOST_CHECK_EQUAL(mem_params.hugepage_size, 0);
+    BOOST_CHECK_EQUAL(mem_params.numa_node, -1);
+
+    mem_params = buffer_pool::get_mem_params(uhd::device_addr_t("hugepages,numa_node=1"));
+    BOOST_CHECK_EQUAL(mem_params.hugepage_size, size_t(1) << 21);
+    BOOST_CHECK_EQUAL(mem_params.numa_node, 1);
+
+    mem_params = buffer_pool::get_mem_params(uhd::device_addr_t("hugepages=1G"));
+    BOOST_CHECK_EQUAL(mem_params.hugepage_size, size_t(1) << 30);
+}
@@ -5,12 +5,14 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 //
 
+#include <uhd/exception.hpp>
 #include <uhd/transport/chdr.hpp>
 #include <uhd/utils/byteswap.hpp>
 #include <boost/format.hpp>
 #include <boost/test/unit_test.hpp>
 #include <cstdlib>
 #include <iostream>
+#include <vector>
 
 using namespace uhd::transport::vrt;
 
@@ -135,3 +137,89 @@ BOOST_AUTO_TEST_CASE(test_with_chdr_err)
     if_packet_info.num_payload_bytes   = 16;
     pack_and_unpack(if_packet_info);
 }
+
+BOOST_AUTO_TEST_CASE(test_with_chdr_batch)
+{
+    static const size_t NUM_PACKETS = 6;
+    uint32_t packet_buffs[NUM_PACKETS][32] = {{0}};
+    const uint32_t* packet_ptrs[NUM_PACKETS];
+    size_t num_packet_words32[NUM_PACKETS];
+
+    // a mix of types and flags, every packet has a different length and time
+    const if_packet_info_t::packet_type_t types[NUM_PACKETS] = {
+        if_packet_info_t::PACKET_TYPE_DATA,
+        if_packet_info_t::PACKET_TYPE_DATA,
+        if_packet_info_t::PACKET_TYPE_FC,
+        if_packet_info_t::PACKET_TYPE_RESP,
+        if_packet_info_t::PACKET_TYPE_DATA,
+        if_packet_info_t::PACKET_TYPE_DATA};
+    std::vector<if_packet_info_t> if_packet_infos_in(NUM_PACKETS);
+    for (size_t i = 0; i < NUM_PACKETS; i++) {
+        if_packet_info_t& if_packet_info   = if_packet_infos_in[i];
+        if_packet_info.packet_type         = types[i];
+        if_packet_info.eob                 = (i == 1);
+        if_packet_info.fc_ack              = (i == 2);
+        if_packet_info.error               = false;
+        if_packet_info.packet_count        = 4090 + i;
+        if_packet_info.has_tsf             = (i % 3 != 2);
+        if_packet_info.tsf                 = 0x1234567890ABCDEFull + i;
+        if_packet_info.sid                 = 0xAABBCC00 + i;
+        if_packet_info.num_payload_words32 = 8 + i;
+        if_packet_info.num_payload_bytes   = 4 * (8 + i) - (i % 4);
+        if (i % 2) {
+            chdr::if_hdr_pack_be(packet_buffs[i], if_packet_info);
+        } else {
+            chdr::if_hdr_pack_le(packet_buffs[i], if_packet_info);
+        }
+        packet_ptrs[i]        = packet_buffs[i];
+        num_packet_words32[i] = if_packet_info.num_packet_words32;
+    }
+    // the last packet claims to be longer than its buffer
+    num_packet_words32[NUM_PACKETS - 1] -= 1;
+
+    chdr::if_hdr_batch_t batch_be, batch_le;
+    chdr::if_hdr_unpack_batch_be(packet_ptrs, num_packet_words32, NUM_PACKETS, batch_be);
+    chdr::if_hdr_unpack_batch_le(packet_ptrs, num_packet_words32, NUM_PACKETS, batch_le);
+    BOOST_CHECK_EQUAL(batch_be.size, NUM_PACKETS);
+    BOOST_CHECK_EQUAL(batch_le.size, NUM_PACKETS);
+    BOOST_CHECK(not batch_be.valid[NUM_PACKETS - 1]);
+
+    // every valid packet must unpack like it does one at a time
+    for (size_t i = 0; i < NUM_PACKETS - 1; i++) {
+        const chdr::if_hdr_batch_t& batch = (i % 2) ? batch_be : batch_le;
+        BOOST_REQUIRE(batch.valid[i]);
+        if_packet_info_t single, batched;
+        single.num_packet_words32  = num_packet_words32[i];
+        batched.num_packet_words32 = num_packet_words32[i];
+        if (i % 2) {
+            chdr::if_hdr_unpack_be(packet_buffs[i], single);
+        } else {
+            chdr::if_hdr_unpack_le(packet_buffs[i], single);
+        }
+        batch.get_if_packet_info(i, batched);
+        BOOST_CHECK_EQUAL(batch.num_packet_bytes[i],
+            if_packet_infos_in[i].num_payload_bytes + 4 * single.num_header_words32);
+        BOOST_CHECK_EQUAL(single.packet_type, batched.packet_type);
+        BOOST_CHECK_EQUAL(single.packet_count, batched.packet_count);
+        BOOST_CHECK_EQUAL(single.eob, batched.eob);
+        BOOST_CHECK_EQUAL(single.error, batched.error);
+        BOOST_CHECK_EQUAL(single.fc_ack, batched.fc_ack);
+        BOOST_CHECK_EQUAL(single.sid, batched.sid);
+        BOOST_CHECK_EQUAL(single.has_tsf, batched.has_tsf);
+        if (single.has_tsf) {
+            BOOST_CHECK_EQUAL(single.tsf, batched.tsf);
+        }
+        BOOST_CHECK_EQUAL(single.num_header_words32, batched.num_header_words32);
+        BOOST_CHECK_EQUAL(single.num_payload_words32, batched.num_payload_words32);
+        BOOST_CHECK_EQUAL(single.num_payload_bytes, batched.num_payload_bytes);
+    }
+    BOOST_CHECK(batch_be.eob[1]);
+    BOOST_CHECK(batch_le.fc_ack[2]);
+    BOOST_CHECK_EQUAL(batch_le.tsf[2], 0);
+
+    BOOST_CHECK_THROW(chdr::if_hdr_unpack_batch_be(packet_ptrs,
+                          num_packet_words32,
+                          chdr::if_hdr_batch_t::max_size + 1,
+                          batch_be),
+        uhd::value_error);
+}
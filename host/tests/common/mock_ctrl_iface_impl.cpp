@@ -36,3 +36,14 @@ uint64_t mock_ctrl_iface_impl::send_cmd_pkt(const size_t addr,
     }
     return 0;
 }
+
+void mock_ctrl_iface_impl::send_cmd_batch(cmd_batch& batch)
+{
+    for (auto& cmd : batch.get_cmds()) {
+        const uint64_t value =
+            send_cmd_pkt(cmd.addr, cmd.data, cmd.readback, cmd.timestamp);
+        if (cmd.readback) {
+            cmd.result.set_value(value);
+        }
+    }
+}
@@ -24,6 +24,13 @@ class mock_ctrl_iface_impl : public uhd::rfnoc::ctrl_iface
         const bool readback      = false,
         const uint64_t timestamp = 0);
 
+    void send_cmd_batch(cmd_batch& batch);
+
     void set_cmd_fifo_size(const size_t) {}
+
+    size_t get_cmd_fifo_size(void) const
+    {
+        return 1;
+    }
 };
 #endif /* INCLUDED_MOCK_CTRL_IFACE_IMPL_HPP */
@@ -29,7 +29,7 @@ uhd::transport::managed_recv_buffer::sptr mock_zero_copy::get_recv_buff(double)
     }
 
     uhd::transport::managed_recv_buffer::sptr mrb =
-        _mrb.get_new(_rx_mems.front(), _rx_lens.front());
+        (new mock_mrb())->get_new(_rx_mems.front(), _rx_lens.front());
 
     if (not _reuse_recv_memory) {
         _rx_mems.pop_front();
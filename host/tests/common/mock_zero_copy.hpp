@@ -53,11 +53,15 @@ private:
 };
 
 
+/*! Every received frame gets its own mock_mrb, so a receiver can hold
+ * several frames at once like with a real transport
+ */
 class mock_mrb : public uhd::transport::managed_recv_buffer
 {
 public:
     void release(void)
-    { /* nop */
+    {
+        delete this;
     }
 
     sptr get_new(boost::shared_array<uint8_t> mem, size_t len)
@@ -129,6 +133,11 @@ public:
     template <uhd::endianness_t endianness = uhd::ENDIANNESS_BIG>
     void pop_send_packet(uhd::transport::vrt::if_packet_info_t& ifpi);
 
+    //! Like pop_send_packet(), but also return the payload words as sent
+    template <uhd::endianness_t endianness = uhd::ENDIANNESS_BIG>
+    void pop_send_packet(
+        uhd::transport::vrt::if_packet_info_t& ifpi, std::vector<uint32_t>& payload);
+
 private:
     std::list<boost::shared_array<uint8_t>> _tx_mems;
     std::list<size_t> _tx_lens;
@@ -137,7 +146,6 @@ private:
     std::list<size_t> _rx_lens;
 
     mock_msb _msb;
-    mock_mrb _mrb;
 
     uhd::transport::vrt::if_packet_info_t::link_type_t _link_type;
     size_t _recv_frame_size = DEFAULT_RECV_FRAME_SIZE;
@@ -227,6 +235,17 @@ void mock_zero_copy::pop_send_packet(uhd::transport::vrt::if_packet_info_t& ifpi
     _tx_lens.pop_front();
 }
 
+template <uhd::endianness_t endianness>
+void mock_zero_copy::pop_send_packet(
+    uhd::transport::vrt::if_packet_info_t& ifpi, std::vector<uint32_t>& payload)
+{
+    const boost::shared_array<uint8_t> mem = _tx_mems.front();
+    pop_send_packet<endianness>(ifpi);
+    const uint32_t* words = reinterpret_cast<const uint32_t*>(mem.get());
+    payload.assign(words + ifpi.num_header_words32,
+        words + ifpi.num_header_words32 + ifpi.num_payload_words32);
+}
+
 template <uhd::endianness_t endianness>
 void mock_zero_copy::push_back_flow_ctrl_packet(
     uhd::transport::vrt::if_packet_info_t::packet_type_t type,
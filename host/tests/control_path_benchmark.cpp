@@ -0,0 +1,478 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Benchmarks of the control path: register peeks and pokes through the
+// control cores, property tree accesses, expert resolves, and creating and
+// destroying streamers. Everything runs on mock transports, so no hardware is
+// needed. The results are written as CSV or JSON, one record per benchmark,
+// so they can be compared across commits.
+
+#include "../lib/transport/super_recv_packet_handler.hpp"
+#include "../lib/transport/super_send_packet_handler.hpp"
+#include "common/mock_zero_copy.hpp"
+#include <uhd/convert.hpp>
+#include <uhd/property_tree.hpp>
+#include <uhd/utils/safe_main.hpp>
+#include <uhd/utils/thread.hpp>
+#include <uhd/version.hpp>
+#include <uhdlib/experts/expert_container.hpp>
+#include <uhdlib/experts/expert_factory.hpp>
+#include <uhdlib/rfnoc/ctrl_iface.hpp>
+#include <uhdlib/usrp/cores/radio_ctrl_core_3000.hpp>
+#include <boost/algorithm/string.hpp>
+#include <boost/format.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/program_options.hpp>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+namespace po = boost::program_options;
+using namespace uhd::transport;
+using namespace uhd::experts;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr uint32_t CTRL_SID     = 0x00100020;
+constexpr size_t STREAMER_SPP   = 2000;
+constexpr size_t CTRL_BATCH_LEN = 64;
+
+//! Keeps the compiler from dropping the benchmarked calls
+volatile double g_sink = 0.0;
+
+/*! A mock transport that answers every command packet
+ *
+ * The commands that were sent since the last call are turned into responses
+ * when the response side is read. A response echoes the address and data of
+ * its command.
+ */
+class mock_ctrl_responder : public mock_zero_copy
+{
+public:
+    typedef boost::shared_ptr<mock_ctrl_responder> sptr;
+
+    mock_ctrl_responder(const uhd::endianness_t endianness,
+        const vrt::if_packet_info_t::packet_type_t resp_type,
+        const size_t num_recv_frames)
+        : mock_zero_copy(vrt::if_packet_info_t::LINK_TYPE_CHDR)
+        , _endianness(endianness)
+        , _resp_type(resp_type)
+        , _num_recv_frames(num_recv_frames)
+    {
+    }
+
+    managed_send_buffer::sptr get_send_buff(double timeout)
+    {
+        _num_cmds++;
+        return mock_zero_copy::get_send_buff(timeout);
+    }
+
+    managed_recv_buffer::sptr get_recv_buff(double timeout)
+    {
+        for (; _num_cmds > 0; _num_cmds--) {
+            vrt::if_packet_info_t ifpi;
+            std::vector<uint32_t> payload;
+            if (_endianness == uhd::ENDIANNESS_BIG) {
+                pop_send_packet<uhd::ENDIANNESS_BIG>(ifpi, payload);
+            } else {
+                pop_send_packet<uhd::ENDIANNESS_LITTLE>(ifpi, payload);
+            }
+            ifpi.packet_type = _resp_type;
+            ifpi.sid         = uhd::sid_t(ifpi.sid).reversed().get();
+            ifpi.has_tsf     = false;
+            if (_endianness == uhd::ENDIANNESS_BIG) {
+                push_back_recv_packet<uint32_t, uhd::ENDIANNESS_BIG>(ifpi, payload);
+            } else {
+                push_back_recv_packet<uint32_t, uhd::ENDIANNESS_LITTLE>(ifpi, payload);
+            }
+        }
+        return mock_zero_copy::get_recv_buff(timeout);
+    }
+
+    size_t get_num_recv_frames(void) const
+    {
+        return _num_recv_frames;
+    }
+
+private:
+    const uhd::endianness_t _endianness;
+    const vrt::if_packet_info_t::packet_type_t _resp_type;
+    const size_t _num_recv_frames;
+    size_t _num_cmds = 0;
+};
+
+//! Copies one node of the expert graph into the next one
+class copy_worker_t : public worker_node_t
+{
+public:
+    copy_worker_t(
+        const node_retriever_t& db, const std::string& in, const std::string& out)
+        : worker_node_t(in + "->" + out), _in(db, in), _out(db, out)
+    {
+        bind_accessor(_in);
+        bind_accessor(_out);
+    }
+
+private:
+    void resolve()
+    {
+        _out = _in.get();
+    }
+
+    data_reader_t<int> _in;
+    data_writer_t<int> _out;
+};
+
+//! Result of one benchmark
+struct ctrl_result_t
+{
+    std::string group;
+    std::string name;
+    //! Window, number of nodes, graph depth or number of channels
+    size_t option;
+    size_t iterations;
+    double ns_per_op;
+};
+
+//! Time \p iterations calls of \p op, which gets the iteration index
+template <typename op_type>
+ctrl_result_t measure(const std::string& group,
+    const std::string& name,
+    const size_t option,
+    const size_t iterations,
+    op_type&& op)
+{
+    const auto start = clock_type::now();
+    for (size_t i = 0; i < iterations; i++) {
+        op(i);
+    }
+    const double elapsed_time =
+        std::chrono::duration<double>(clock_type::now() - start).count();
+    return ctrl_result_t{
+        group, name, option, iterations, elapsed_time / iterations * 1e9};
+}
+
+/***********************************************************************
+ * Register access through the RFNoC block control
+ **********************************************************************/
+void benchmark_ctrl_iface(
+    const size_t iterations, const size_t window, std::vector<ctrl_result_t>& results)
+{
+    auto xport = boost::make_shared<mock_ctrl_responder>(
+        uhd::ENDIANNESS_BIG, vrt::if_packet_info_t::PACKET_TYPE_RESP, window);
+    uhd::both_xports_t xports;
+    xports.send       = xport;
+    xports.recv       = xport;
+    xports.send_sid   = uhd::sid_t(CTRL_SID);
+    xports.recv_sid   = uhd::sid_t(CTRL_SID).reversed();
+    xports.endianness = uhd::ENDIANNESS_BIG;
+    uhd::rfnoc::ctrl_iface::sptr ctrl = uhd::rfnoc::ctrl_iface::make(xports);
+
+    results.push_back(measure("ctrl_iface", "poke", window, iterations, [&](size_t i) {
+        ctrl->send_cmd_pkt(i & 0xff, i);
+    }));
+    results.push_back(measure("ctrl_iface", "peek", window, iterations, [&](size_t i) {
+        g_sink = double(ctrl->send_cmd_pkt(0, i & 0xff, true));
+    }));
+
+    // Timed per batch, reported per command
+    const size_t num_batches = std::max<size_t>(iterations / CTRL_BATCH_LEN, 1);
+    ctrl_result_t result =
+        measure("ctrl_iface", "batch_peek", window, num_batches, [&](size_t) {
+            uhd::rfnoc::ctrl_iface::cmd_batch batch;
+            std::vector<uhd::rfnoc::ctrl_iface::cmd_batch::readback_t> readbacks;
+            for (size_t i = 0; i < CTRL_BATCH_LEN; i++) {
+                readbacks.push_back(batch.add_readback(0, i));
+            }
+            ctrl->send_cmd_batch(batch);
+            g_sink = double(readbacks.back().get());
+        });
+    result.iterations *= CTRL_BATCH_LEN;
+    result.ns_per_op /= CTRL_BATCH_LEN;
+    results.push_back(result);
+}
+
+/***********************************************************************
+ * Register access through the radio control core of the 3rd gen. devices
+ **********************************************************************/
+void benchmark_radio_ctrl(
+    const size_t iterations, const size_t window, std::vector<ctrl_result_t>& results)
+{
+    auto xport = boost::make_shared<mock_ctrl_responder>(
+        uhd::ENDIANNESS_LITTLE, vrt::if_packet_info_t::PACKET_TYPE_CONTEXT, window);
+    radio_ctrl_core_3000::sptr ctrl =
+        radio_ctrl_core_3000::make(false /*lilE*/, xport, xport, CTRL_SID, "bench");
+
+    results.push_back(measure("radio_ctrl", "poke32", window, iterations, [&](size_t i) {
+        ctrl->poke32(4 * (i & 0xff), uint32_t(i));
+    }));
+    results.push_back(measure("radio_ctrl", "peek32", window, iterations, [&](size_t i) {
+        g_sink = double(ctrl->peek32(4 * (i & 0xff)));
+    }));
+    results.push_back(measure("radio_ctrl", "peek64", window, iterations, [&](size_t i) {
+        g_sink = double(ctrl->peek64(4 * (i & 0xff)));
+    }));
+}
+
+/***********************************************************************
+ * Property tree
+ **********************************************************************/
+void benchmark_property_tree(
+    const size_t iterations, const size_t num_nodes, std::vector<ctrl_result_t>& results)
+{
+    uhd::property_tree::sptr tree = uhd::property_tree::make();
+    std::string path;
+    for (size_t i = 0; i < num_nodes; i++) {
+        path = str(boost::format("/mboards/0/rx_frontends/%u/freq/value") % i);
+        tree->create<double>(path).set(0.0);
+    }
+    // The last node, with a coercer and a subscriber like most device nodes
+    uhd::property<double>& prop = tree->access<double>(path);
+    prop.set_coercer([](const double value) { return std::max(value, 0.0); });
+    prop.add_coerced_subscriber([](const double value) { g_sink = value; });
+
+    results.push_back(
+        measure("property_tree", "get_by_path", num_nodes, iterations, [&](size_t) {
+            g_sink = tree->access<double>(path).get();
+        }));
+    results.push_back(
+        measure("property_tree", "set_by_path", num_nodes, iterations, [&](size_t i) {
+            tree->access<double>(path).set(double(i));
+        }));
+    results.push_back(measure("property_tree", "get", num_nodes, iterations, [&](size_t) {
+        g_sink = prop.get();
+    }));
+    results.push_back(
+        measure("property_tree", "set", num_nodes, iterations, [&](size_t i) {
+            prop.set(double(i));
+        }));
+    results.push_back(
+        measure("property_tree", "exists", num_nodes, iterations, [&](size_t) {
+            g_sink = tree->exists(path);
+        }));
+}
+
+/***********************************************************************
+ * Expert framework: a chain of workers behind a property node
+ **********************************************************************/
+void benchmark_experts(
+    const size_t iterations, const size_t depth, std::vector<ctrl_result_t>& results)
+{
+    expert_container::sptr container = expert_factory::create_container("benchmark");
+    uhd::property_tree::sptr tree    = uhd::property_tree::make();
+    expert_factory::add_prop_node<int>(
+        container, tree, "chain/0", 0, uhd::experts::AUTO_RESOLVE_ON_WRITE);
+    for (size_t i = 1; i <= depth; i++) {
+        const std::string in  = "chain/" + std::to_string(i - 1);
+        const std::string out = "chain/" + std::to_string(i);
+        expert_factory::add_data_node<int>(container, out, 0);
+        expert_factory::add_worker_node<copy_worker_t>(
+            container, container->node_retriever(), in, out);
+    }
+    container->resolve_all();
+    uhd::property<int>& head = tree->access<int>("chain/0");
+
+    // Every resolve runs all workers, so scale the iterations down
+    const size_t num_resolves = std::max<size_t>(iterations / depth, 1);
+    results.push_back(
+        measure("experts", "resolve_on_write", depth, num_resolves, [&](size_t i) {
+            head.set(int(i));
+        }));
+    results.push_back(measure("experts", "resolve_all", depth, num_resolves, [&](size_t) {
+        container->resolve_all(true);
+    }));
+}
+
+/***********************************************************************
+ * Streamer setup and teardown, without the device specific parts
+ **********************************************************************/
+void benchmark_streamers(
+    const size_t iterations, const size_t num_chans, std::vector<ctrl_result_t>& results)
+{
+    mock_zero_copy::sptr xport(new mock_zero_copy(vrt::if_packet_info_t::LINK_TYPE_CHDR));
+
+    // Setting up a streamer looks up converters and allocates buffers
+    const size_t num_streamers = std::max<size_t>(iterations / 100, 1);
+    results.push_back(
+        measure("streamer", "rx_create_destroy", num_chans, num_streamers, [&](size_t) {
+            sph::recv_packet_streamer streamer(STREAMER_SPP);
+            streamer.resize(num_chans);
+            streamer.set_vrt_unpacker(&vrt::chdr::if_hdr_unpack_be);
+            streamer.set_tick_rate(1.0);
+            streamer.set_samp_rate(1.0);
+            uhd::convert::id_type id;
+            id.input_format  = "sc16_item32_be";
+            id.num_inputs    = 1;
+            id.output_format = "fc32";
+            id.num_outputs   = 1;
+            streamer.set_converter(id);
+            for (size_t chan = 0; chan < num_chans; chan++) {
+                streamer.set_xport_chan_get_buff(chan,
+                    [xport](double timeout) { return xport->get_recv_buff(timeout); },
+                    false /* flush */);
+            }
+        }));
+    results.push_back(
+        measure("streamer", "tx_create_destroy", num_chans, num_streamers, [&](size_t) {
+            sph::send_packet_streamer streamer(STREAMER_SPP);
+            streamer.resize(num_chans);
+            streamer.set_vrt_packer(&vrt::chdr::if_hdr_pack_be);
+            streamer.set_tick_rate(1.0);
+            streamer.set_samp_rate(1.0);
+            uhd::convert::id_type id;
+            id.input_format  = "fc32";
+            id.num_inputs    = 1;
+            id.output_format = "sc16_item32_be";
+            id.num_outputs   = 1;
+            streamer.set_converter(id);
+            streamer.set_enable_trailer(false);
+            for (size_t chan = 0; chan < num_chans; chan++) {
+                streamer.set_xport_chan_get_buff(chan,
+                    [xport](double timeout) { return xport->get_send_buff(timeout); });
+            }
+        }));
+}
+
+std::vector<std::string> split_list(const std::string& list)
+{
+    std::vector<std::string> items;
+    boost::split(items, list, boost::is_any_of(":,"), boost::token_compress_on);
+    items.erase(std::remove(items.begin(), items.end(), ""), items.end());
+    return items;
+}
+
+std::vector<size_t> split_size_list(const std::string& list)
+{
+    std::vector<size_t> values;
+    for (const std::string& item : split_list(list)) {
+        values.push_back(boost::lexical_cast<size_t>(item));
+    }
+    return values;
+}
+
+void print_results(const std::vector<ctrl_result_t>& results,
+    const std::string& output,
+    const std::string& label)
+{
+    if (output == "json") {
+        std::cout << "[";
+    } else {
+        std::cout << "label,group,benchmark,option,iterations,ns_per_op,ops_per_sec\n";
+    }
+    for (size_t i = 0; i < results.size(); i++) {
+        const ctrl_result_t& r = results[i];
+        if (output == "json") {
+            std::cout << (i ? "," : "") << "\n  {\"label\": \"" << label
+                      << "\", \"group\": \"" << r.group << "\", \"benchmark\": \""
+                      << r.name << "\", \"option\": " << r.option
+                      << ", \"iterations\": " << r.iterations
+                      << ", \"ns_per_op\": " << r.ns_per_op
+                      << ", \"ops_per_sec\": " << 1e9 / r.ns_per_op << "}";
+        } else {
+            std::cout << label << "," << r.group << "," << r.name << "," << r.option
+                      << "," << r.iterations << "," << r.ns_per_op << ","
+                      << 1e9 / r.ns_per_op << "\n";
+        }
+    }
+    if (output == "json") {
+        std::cout << "\n]" << std::endl;
+    }
+}
+
+} // namespace
+
+int UHD_SAFE_MAIN(int argc, char* argv[])
+{
+    po::options_description desc("Allowed options");
+    // clang-format off
+    desc.add_options()
+        ("help", "help message")
+        ("groups", po::value<std::string>()->default_value("ctrl_iface:radio_ctrl:property_tree:experts:streamer"), "Benchmark groups to run")
+        ("iterations", po::value<double>()->default_value(1e5), "Operations per benchmark (fewer for the slow ones)")
+        ("window", po::value<std::string>()->default_value("1:16"), "Control responses that may be outstanding")
+        ("nodes", po::value<std::string>()->default_value("100:1000"), "Property tree sizes")
+        ("depth", po::value<std::string>()->default_value("4:32"), "Expert graph depths")
+        ("channels", po::value<std::string>()->default_value("1:4"), "Streamer channels")
+        ("output-format", po::value<std::string>()->default_value("csv"), "csv or json")
+        ("label", po::value<std::string>()->default_value(uhd::get_version_string()), "Label for the results, e.g. a commit hash")
+    ;
+    // clang-format on
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help")) {
+        std::cout << boost::format("UHD Control Path Benchmark %s") % desc << std::endl;
+        std::cout
+            << "    Benchmark of register accesses, property tree accesses, expert\n"
+               "    resolves and streamer setup. All benchmarks use mock transports.\n"
+               "    No parameters are needed to run this benchmark.\n"
+            << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    uhd::set_thread_priority_safe();
+
+    const size_t iterations = std::max<size_t>(size_t(vm["iterations"].as<double>()), 1);
+    const std::vector<std::string> groups = split_list(vm["groups"].as<std::string>());
+    const auto has_group = [&groups](const std::string& group) {
+        return std::find(groups.begin(), groups.end(), group) != groups.end();
+    };
+
+    std::vector<ctrl_result_t> results;
+    typedef std::function<void(std::vector<ctrl_result_t>&)> benchmark_fn_t;
+    const auto run = [&results](const benchmark_fn_t& fn) {
+        const size_t first = results.size();
+        fn(results);
+        for (size_t i = first; i < results.size(); i++) {
+            std::cerr << results[i].group << " " << results[i].name << " ("
+                      << results[i].option << "): " << results[i].ns_per_op
+                      << " ns/op" << std::endl;
+        }
+    };
+
+    for (const size_t window : split_size_list(vm["window"].as<std::string>())) {
+        if (has_group("ctrl_iface")) {
+            run([&](std::vector<ctrl_result_t>& r) {
+                benchmark_ctrl_iface(iterations, window, r);
+            });
+        }
+        if (has_group("radio_ctrl")) {
+            run([&](std::vector<ctrl_result_t>& r) {
+                benchmark_radio_ctrl(iterations, window, r);
+            });
+        }
+    }
+    if (has_group("property_tree")) {
+        for (const size_t nodes : split_size_list(vm["nodes"].as<std::string>())) {
+            run([&](std::vector<ctrl_result_t>& r) {
+                benchmark_property_tree(iterations, nodes, r);
+            });
+        }
+    }
+    if (has_group("experts")) {
+        for (const size_t depth : split_size_list(vm["depth"].as<std::string>())) {
+            run([&](std::vector<ctrl_result_t>& r) {
+                benchmark_experts(iterations, std::max<size_t>(depth, 1), r);
+            });
+        }
+    }
+    if (has_group("streamer")) {
+        for (const size_t chans : split_size_list(vm["channels"].as<std::string>())) {
+            run([&](std::vector<ctrl_result_t>& r) {
+                benchmark_streamers(iterations, std::max<size_t>(chans, 1), r);
+            });
+        }
+    }
+
+    print_results(
+        results, vm["output-format"].as<std::string>(), vm["label"].as<std::string>());
+    return EXIT_SUCCESS;
+}
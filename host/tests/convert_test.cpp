@@ -6,10 +6,16 @@
 //
 
 #include <uhd/convert.hpp>
+#include <uhd/exception.hpp>
+#include <uhd/utils/byteswap.hpp>
 #include <stdint.h>
+#include <boost/filesystem.hpp>
 #include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <cmath>
 #include <complex>
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <vector>
 
@@ -383,6 +389,184 @@ BOOST_AUTO_TEST_CASE(test_convert_types_sc16_to_fc32)
     }
 }
 
+/***********************************************************************
+ * Test that all priorities of a converter agree with the generic one.
+ * This covers the AVX2 and AVX-512 converters, which are only registered
+ * if the CPU running the test supports them.
+ **********************************************************************/
+static bool has_converter(const convert::id_type& id, const int prio)
+{
+    try {
+        convert::get_converter(id, prio);
+    } catch (const uhd::key_error&) {
+        return false;
+    }
+    return true;
+}
+
+template <typename host_type>
+static void test_convert_prios_loopback(const std::string& host_format,
+    const std::string& wire_format,
+    const double scalar)
+{
+    convert::id_type to_wire;
+    to_wire.input_format  = host_format;
+    to_wire.num_inputs    = 1;
+    to_wire.output_format = wire_format;
+    to_wire.num_outputs   = 1;
+
+    convert::id_type from_wire;
+    from_wire.input_format  = wire_format;
+    from_wire.num_inputs    = 1;
+    from_wire.output_format = host_format;
+    from_wire.num_outputs   = 1;
+
+    const size_t max_samps = 100;
+    std::vector<host_type> input(max_samps);
+    for (host_type& in : input)
+        in = host_type(
+            (std::rand() / (RAND_MAX / 2.0)) - 1, (std::rand() / (RAND_MAX / 2.0)) - 1);
+
+    for (int prio = 1; prio <= 5; prio++) {
+        const bool test_to_wire   = has_converter(to_wire, prio);
+        const bool test_from_wire = has_converter(from_wire, prio);
+        // odd sizes to hit the scalar tails of the SIMD loops
+        for (size_t nsamps = 1; nsamps <= max_samps; nsamps += 7) {
+            std::vector<uint32_t> interm(nsamps);
+            std::vector<host_type> expected(nsamps), actual(nsamps);
+
+            // generic to wire, then generic or the priority under test back
+            std::vector<const void*> input0(1, &input[0]), input1(1, &interm[0]);
+            std::vector<void*> output0(1, &interm[0]), output1(1, &expected[0]),
+                output2(1, &actual[0]);
+            convert::converter::sptr c0 = convert::get_converter(to_wire, 0)();
+            c0->set_scalar(scalar);
+            c0->conv(input0, output0, nsamps);
+            convert::converter::sptr c1 = convert::get_converter(from_wire, 0)();
+            c1->set_scalar(1 / scalar);
+            c1->conv(input1, output1, nsamps);
+
+            if (test_from_wire) {
+                convert::converter::sptr c2 = convert::get_converter(from_wire, prio)();
+                c2->set_scalar(1 / scalar);
+                c2->conv(input1, output2, nsamps);
+                for (size_t i = 0; i < nsamps; i++) {
+                    MY_CHECK_CLOSE(expected[i].real(), actual[i].real(), 1e-6);
+                    MY_CHECK_CLOSE(expected[i].imag(), actual[i].imag(), 1e-6);
+                }
+            }
+
+            // the priority under test to wire, then generic back to host
+            if (test_to_wire) {
+                convert::converter::sptr c2 = convert::get_converter(to_wire, prio)();
+                c2->set_scalar(scalar);
+                c2->conv(input0, output0, nsamps);
+                c1->conv(input1, output2, nsamps);
+                for (size_t i = 0; i < nsamps; i++) {
+                    MY_CHECK_CLOSE(expected[i].real(), actual[i].real(), 1.5 / scalar);
+                    MY_CHECK_CLOSE(expected[i].imag(), actual[i].imag(), 1.5 / scalar);
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_convert_prios_sc16)
+{
+    for (const std::string wire_format : {"sc16_item32_le", "sc16_item32_be"}) {
+        test_convert_prios_loopback<fc32_t>("fc32", wire_format, 32767.);
+        test_convert_prios_loopback<fc64_t>("fc64", wire_format, 32767.);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_convert_prios_sc8)
+{
+    for (const std::string wire_format : {"sc8_item32_le", "sc8_item32_be"}) {
+        test_convert_prios_loopback<fc32_t>("fc32", wire_format, 127.);
+        test_convert_prios_loopback<fc64_t>("fc64", wire_format, 127.);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_convert_prios_sc12)
+{
+    for (const std::string wire_format : {"sc12_item32_le", "sc12_item32_be"}) {
+        test_convert_prios_loopback<fc32_t>("fc32", wire_format, 2047.);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_convert_shared_tables)
+{
+    // Table converters of the same type share their tables, but converters
+    // with different scalars must still scale differently
+    convert::id_type id;
+    id.input_format  = "sc16_item32_be";
+    id.num_inputs    = 1;
+    id.output_format = "fc32";
+    id.num_outputs   = 1;
+    const int table_prio = 1;
+    BOOST_REQUIRE(has_converter(id, table_prio));
+
+    const uint32_t item = uhd::htonx(uint32_t((100 << 16) | uint16_t(-200)));
+    std::vector<const void*> input(1, &item);
+    std::vector<convert::converter::sptr> converters;
+    std::vector<fc32_t> outputs(4);
+    for (size_t i = 0; i < outputs.size(); i++) {
+        converters.push_back(convert::get_converter(id, table_prio)());
+        converters.back()->set_scalar(i % 2 ? 1.0 : 0.5);
+    }
+    for (size_t i = 0; i < outputs.size(); i++) {
+        std::vector<void*> output(1, &outputs[i]);
+        converters[i]->conv(input, output, 1);
+        const float scalar = i % 2 ? 1.0f : 0.5f;
+        BOOST_CHECK_EQUAL(outputs[i], fc32_t(100 * scalar, -200 * scalar));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_convert_usrp1_scalar)
+{
+    // The SIMD kernels must apply any scalar just like the generic converters
+    convert::id_type in_id, out_id;
+    in_id.input_format   = "sc16_item16_usrp1";
+    in_id.num_inputs     = 1;
+    in_id.output_format  = "fc32";
+    in_id.num_outputs    = 1;
+    out_id.input_format  = "fc32";
+    out_id.num_inputs    = 1;
+    out_id.output_format = "sc16_item16_usrp1";
+    out_id.num_outputs   = 1;
+
+    for (const double scalar : {1. / 32767, 1. / 1000, 3.}) {
+        for (size_t nsamps = 1; nsamps < 16; nsamps++) {
+            std::vector<int16_t> input(2 * nsamps);
+            for (size_t i = 0; i < input.size(); i++) {
+                input[i] = int16_t(std::rand() - RAND_MAX / 2);
+            }
+            std::vector<fc32_t> output(nsamps);
+            convert::converter::sptr c0 = convert::get_converter(in_id)();
+            c0->set_scalar(scalar);
+            c0->conv(std::vector<const void*>(1, input.data()),
+                std::vector<void*>(1, output.data()),
+                nsamps);
+            for (size_t i = 0; i < nsamps; i++) {
+                const float re = input[2 * i + 0] * float(scalar);
+                const float im = input[2 * i + 1] * float(scalar);
+                BOOST_CHECK_EQUAL(output[i], fc32_t(re, im));
+            }
+
+            // Converting back truncates, which may be off by one
+            std::vector<int16_t> loopback(2 * nsamps);
+            convert::converter::sptr c1 = convert::get_converter(out_id)();
+            c1->set_scalar(1. / scalar);
+            c1->conv(std::vector<const void*>(1, output.data()),
+                std::vector<void*>(1, loopback.data()),
+                nsamps);
+            for (size_t i = 0; i < loopback.size(); i++) {
+                BOOST_CHECK_LE(std::abs(loopback[i] - input[i]), 1);
+            }
+        }
+    }
+}
+
 /***********************************************************************
  * Test sc8 conversions
  **********************************************************************/
@@ -651,3 +835,219 @@ BOOST_AUTO_TEST_CASE(test_convert_types_f32_and_f32)
         test_convert_types_f32(nsamps, id);
     }
 }
+
+/***********************************************************************
+ * Test channel-interleaving conversion
+ **********************************************************************/
+BOOST_AUTO_TEST_CASE(test_convert_interleave_channels)
+{
+    const size_t nchans = 5;
+    // more than one internal block and an odd remainder
+    const size_t nsamps = 517;
+
+    convert::id_type single_id;
+    single_id.input_format  = "sc16_item32_le";
+    single_id.num_inputs    = 1;
+    single_id.output_format = "fc32";
+    single_id.num_outputs   = 1;
+    convert::id_type id = single_id;
+    id.num_inputs       = nchans;
+
+    std::vector<std::vector<uint32_t>> input(nchans, std::vector<uint32_t>(nsamps));
+    std::vector<const void*> input_ptrs;
+    for (auto& in : input) {
+        for (uint32_t& item : in)
+            item = uint32_t(std::rand());
+        input_ptrs.push_back(in.data());
+    }
+
+    std::vector<fc32_t> output(nsamps * nchans);
+    std::vector<void*> output0(1, output.data());
+    convert::converter::sptr c0 = convert::get_converter(id)();
+    c0->set_scalar(1 / 32767.);
+    c0->conv(input_ptrs, output0, nsamps);
+
+    convert::converter::sptr c1 = convert::get_converter(single_id)();
+    c1->set_scalar(1 / 32767.);
+    for (size_t ch = 0; ch < nchans; ch++) {
+        std::vector<fc32_t> expected(nsamps);
+        std::vector<const void*> input1(1, input_ptrs[ch]);
+        std::vector<void*> output1(1, expected.data());
+        c1->conv(input1, output1, nsamps);
+        for (size_t i = 0; i < nsamps; i++) {
+            BOOST_CHECK_EQUAL(output[i * nchans + ch], expected[i]);
+        }
+    }
+}
+
+/***********************************************************************
+ * Test benchmark mode
+ **********************************************************************/
+BOOST_AUTO_TEST_CASE(test_convert_benchmark_mode)
+{
+    const boost::filesystem::path cache_file =
+        boost::filesystem::temp_directory_path()
+        / boost::filesystem::unique_path("convert_benchmark_%%%%%%%%.txt");
+    convert::set_benchmark_mode(true, cache_file.string());
+
+    convert::id_type in_id;
+    in_id.input_format  = "fc32";
+    in_id.num_inputs    = 1;
+    in_id.output_format = "sc16_item32_le";
+    in_id.num_outputs   = 1;
+
+    convert::id_type out_id;
+    out_id.input_format  = "sc16_item32_le";
+    out_id.num_inputs    = 1;
+    out_id.output_format = "fc32";
+    out_id.num_outputs   = 1;
+
+    // whichever converter wins has to convert correctly
+    const size_t nsamps = 37;
+    std::vector<fc32_t> input(nsamps), output(nsamps);
+    for (fc32_t& in : input)
+        in = fc32_t(
+            (std::rand() / (RAND_MAX / 2.0)) - 1, (std::rand() / (RAND_MAX / 2.0)) - 1);
+    loopback(nsamps, in_id, out_id, input, output);
+    for (size_t i = 0; i < nsamps; i++) {
+        MY_CHECK_CLOSE(input[i].real(), output[i].real(), float(0.01));
+        MY_CHECK_CLOSE(input[i].imag(), output[i].imag(), float(0.01));
+    }
+
+    // the winners have to be persisted
+    std::ifstream file(cache_file.string().c_str());
+    std::string line;
+    bool found_in = false, found_out = false;
+    while (std::getline(file, line)) {
+        found_in  = found_in or line.find("fc32 1 sc16_item32_le 1 ") == 0;
+        found_out = found_out or line.find("sc16_item32_le 1 fc32 1 ") == 0;
+    }
+    BOOST_CHECK(found_in);
+    BOOST_CHECK(found_out);
+
+    convert::set_benchmark_mode(false);
+    boost::filesystem::remove(cache_file);
+}
+
+/***********************************************************************
+ * Test compressed sc16
+ **********************************************************************/
+BOOST_AUTO_TEST_CASE(test_convert_sc16_compressed)
+{
+    convert::id_type in_id;
+    in_id.input_format  = "sc16";
+    in_id.num_inputs    = 1;
+    in_id.output_format = "sc16_compressed";
+    in_id.num_outputs   = 1;
+    convert::id_type out_id;
+    out_id.input_format  = "sc16_compressed";
+    out_id.num_inputs    = 1;
+    out_id.output_format = "sc16";
+    out_id.num_outputs   = 1;
+    convert::converter::sptr c0 = convert::get_converter(in_id)();
+    convert::converter::sptr c1 = convert::get_converter(out_id)();
+
+    // A slow tone, sc12 samples in sc16 words, and full scale noise
+    const size_t nsamps = 1001;
+    std::vector<sc16_t> tone(nsamps), sc12(nsamps), noise(nsamps);
+    for (size_t i = 0; i < nsamps; i++) {
+        const double phase = 2 * M_PI * i / 100;
+        tone[i]  = sc16_t(
+            int16_t(30000 * std::cos(phase)), int16_t(30000 * std::sin(phase)));
+        sc12[i] = sc16_t(int16_t(tone[i].real() & ~0xF), int16_t(tone[i].imag() & ~0xF));
+        noise[i] = sc16_t(int16_t(std::rand()), int16_t(std::rand()));
+    }
+
+    std::vector<size_t> sizes;
+    for (const auto* input : {&tone, &sc12, &noise}) {
+        std::vector<uint8_t> block(convert::get_max_compressed_size(nsamps));
+        std::vector<sc16_t> output(nsamps);
+        std::vector<const void*> input0(1, input->data());
+        std::vector<void*> output0(1, block.data());
+        c0->conv(input0, output0, nsamps);
+        BOOST_CHECK_EQUAL(convert::get_compressed_num_samps(block.data()), nsamps);
+        const size_t size = convert::get_compressed_size(block.data());
+        BOOST_CHECK_LE(size, block.size());
+        sizes.push_back(size);
+
+        std::vector<const void*> input1(1, block.data());
+        std::vector<void*> output1(1, output.data());
+        c1->conv(input1, output1, nsamps);
+        BOOST_CHECK_EQUAL_COLLECTIONS(
+            input->begin(), input->end(), output.begin(), output.end());
+        BOOST_CHECK_THROW(c1->conv(input1, output1, nsamps - 1), uhd::value_error);
+    }
+    BOOST_CHECK_LT(sizes[0], nsamps * sizeof(sc16_t) * 3 / 4);
+    BOOST_CHECK_LT(sizes[1], sizes[0]);
+}
+
+BOOST_AUTO_TEST_CASE(test_convert_sc16_to_fc32_stats)
+{
+    // an odd number, to leave samples for the scalar code after the SIMD loop
+    const size_t nsamps = 2051;
+    std::vector<uint32_t> input(nsamps);
+    double ref_sum_i = 0, ref_sum_q = 0, ref_sum_sq = 0, ref_peak = 0;
+    for (size_t i = 0; i < nsamps; i++) {
+        const int16_t re = int16_t(std::rand()), im = int16_t(std::rand());
+        input[i]         = (uint32_t(uint16_t(re)) << 16) | uint16_t(im);
+        const double fre = re / 32767., fim = im / 32767.;
+        ref_sum_i += fre;
+        ref_sum_q += fim;
+        ref_sum_sq += fre * fre + fim * fim;
+        ref_peak = std::max(ref_peak, std::max(std::abs(fre), std::abs(fim)));
+    }
+
+    for (const std::string endianness : {"le", "be"}) {
+        std::vector<uint32_t> wire(input);
+        if (endianness == "be") {
+            for (uint32_t& item : wire) {
+                item = uhd::htonx(item);
+            }
+        }
+        convert::id_type plain_id;
+        plain_id.input_format  = "sc16_item32_" + endianness;
+        plain_id.num_inputs    = 1;
+        plain_id.output_format = "fc32";
+        plain_id.num_outputs   = 1;
+        convert::id_type stats_id = plain_id;
+        stats_id.output_format    = "fc32_stats";
+
+        std::vector<fc32_t> ref_output(nsamps);
+        convert::converter::sptr c0 = convert::get_converter(plain_id)();
+        c0->set_scalar(1 / 32767.);
+        std::vector<const void*> input0(1, wire.data());
+        std::vector<void*> output0(1, ref_output.data());
+        c0->conv(input0, output0, nsamps);
+
+        for (const int prio : {0, 1, 2, 3, 4}) {
+            if (not has_converter(stats_id, prio)) {
+                continue;
+            }
+            auto c1 = boost::dynamic_pointer_cast<convert::stats_converter>(
+                convert::get_converter(stats_id, prio)());
+            BOOST_REQUIRE(c1);
+            c1->set_scalar(1 / 32767.);
+
+            // the output doesn't change, with or without measuring
+            std::vector<fc32_t> output(nsamps);
+            std::vector<void*> output1(1, output.data());
+            c1->conv(input0, output1, nsamps);
+            BOOST_CHECK(output == ref_output);
+
+            convert::signal_accum_t accum;
+            c1->set_accum(&accum);
+            c1->conv(input0, output1, nsamps);
+            BOOST_CHECK(output == ref_output);
+            BOOST_CHECK_EQUAL(accum.num_samps, nsamps);
+            MY_CHECK_CLOSE(accum.sum_i, ref_sum_i, 1e-3);
+            MY_CHECK_CLOSE(accum.sum_q, ref_sum_q, 1e-3);
+            MY_CHECK_CLOSE(accum.sum_sq, ref_sum_sq, 1e-3);
+            MY_CHECK_CLOSE(accum.peak, ref_peak, 1e-6);
+
+            // the sums keep running
+            c1->conv(input0, output1, nsamps);
+            BOOST_CHECK_EQUAL(accum.num_samps, 2 * nsamps);
+            MY_CHECK_CLOSE(accum.sum_sq, 2 * ref_sum_sq, 2e-3);
+        }
+    }
+}
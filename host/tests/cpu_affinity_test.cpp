@@ -0,0 +1,42 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhdlib/utils/cpu_affinity.hpp>
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(test_parse_cpu_list)
+{
+    BOOST_CHECK(uhd::parse_cpu_list("").empty());
+
+    const std::vector<size_t> single{3};
+    const std::vector<size_t> single_result = uhd::parse_cpu_list("3");
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        single.begin(), single.end(), single_result.begin(), single_result.end());
+
+    // Device arg style and sysfs style
+    const std::vector<size_t> mixed{0, 2, 4, 5, 6, 7};
+    const std::vector<size_t> mixed_colon = uhd::parse_cpu_list("0:2:4-7");
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        mixed.begin(), mixed.end(), mixed_colon.begin(), mixed_colon.end());
+    const std::vector<size_t> mixed_comma = uhd::parse_cpu_list("0,2,4-7\n");
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        mixed.begin(), mixed.end(), mixed_comma.begin(), mixed_comma.end());
+
+    BOOST_CHECK_THROW(uhd::parse_cpu_list("5-2"), uhd::value_error);
+    BOOST_CHECK_THROW(uhd::parse_cpu_list("two"), uhd::value_error);
+    BOOST_CHECK_THROW(uhd::parse_cpu_list("1::2"), uhd::value_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_cpu_affinity_arg)
+{
+    const std::vector<size_t> cpus{1, 2};
+    const std::vector<size_t> result = uhd::get_cpu_affinity_arg("1-2", "127.0.0.1");
+    BOOST_CHECK_EQUAL_COLLECTIONS(cpus.begin(), cpus.end(), result.begin(), result.end());
+    // The loopback interface has no NUMA node
+    BOOST_CHECK(uhd::get_cpu_affinity_arg("nic", "127.0.0.1").empty());
+}
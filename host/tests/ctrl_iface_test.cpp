@@ -0,0 +1,119 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "common/mock_zero_copy.hpp"
+#include <uhd/exception.hpp>
+#include <uhd/utils/byteswap.hpp>
+#include <uhdlib/rfnoc/ctrl_iface.hpp>
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+using namespace uhd::transport;
+using namespace uhd::rfnoc;
+
+namespace {
+
+constexpr uint32_t CTRL_SID = 0x00100020;
+
+uhd::both_xports_t make_xports(mock_zero_copy::sptr xport)
+{
+    uhd::both_xports_t xports;
+    xports.send       = xport;
+    xports.recv       = xport;
+    xports.send_sid   = uhd::sid_t(CTRL_SID);
+    xports.recv_sid   = uhd::sid_t(CTRL_SID).reversed();
+    xports.endianness = uhd::ENDIANNESS_BIG;
+    return xports;
+}
+
+void push_ack(mock_zero_copy::sptr xport, const size_t seq, const uint64_t payload)
+{
+    vrt::if_packet_info_t ifpi;
+    ifpi.packet_type         = vrt::if_packet_info_t::PACKET_TYPE_RESP;
+    ifpi.num_payload_words32 = 2;
+    ifpi.num_payload_bytes   = 2 * sizeof(uint32_t);
+    ifpi.packet_count        = seq;
+    ifpi.sid                 = uhd::sid_t(CTRL_SID).reversed().get();
+    ifpi.has_sid             = true;
+    ifpi.has_tsf             = false;
+    xport->push_back_recv_packet(ifpi,
+        std::vector<uint32_t>{uhd::htonx(uint32_t(payload >> 32)),
+            uhd::htonx(uint32_t(payload & 0xFFFFFFFF))});
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_ctrl_iface_batch)
+{
+    mock_zero_copy::sptr xport(new mock_zero_copy(vrt::if_packet_info_t::LINK_TYPE_CHDR));
+    ctrl_iface::sptr ctrl = ctrl_iface::make(make_xports(xport));
+
+    // Every command gets a response, readbacks keep its payload
+    ctrl_iface::cmd_batch batch;
+    batch.add_cmd(1, 0x10);
+    ctrl_iface::cmd_batch::readback_t rb1 = batch.add_readback(2, 0x20);
+    batch.add_cmd(3, 0x30);
+    ctrl_iface::cmd_batch::readback_t rb2 = batch.add_readback(4, 0x40);
+    BOOST_CHECK_EQUAL(batch.size(), 4);
+    for (size_t seq = 0; seq < batch.size(); seq++) {
+        push_ack(xport, seq, 0x1111111100000000 | seq);
+    }
+    ctrl->send_cmd_batch(batch);
+    BOOST_CHECK_EQUAL(rb1.get(), 0x1111111100000001);
+    BOOST_CHECK_EQUAL(rb2.get(), 0x1111111100000003);
+
+    // The commands went out in order
+    for (uint32_t addr = 1; addr <= 4; addr++) {
+        vrt::if_packet_info_t ifpi;
+        std::vector<uint32_t> payload;
+        xport->pop_send_packet(ifpi, payload);
+        BOOST_CHECK_EQUAL(ifpi.packet_type, vrt::if_packet_info_t::PACKET_TYPE_CMD);
+        BOOST_CHECK_EQUAL(ifpi.packet_count, addr - 1);
+        BOOST_REQUIRE_EQUAL(payload.size(), 2);
+        BOOST_CHECK_EQUAL(uhd::ntohx(payload[0]), addr);
+        BOOST_CHECK_EQUAL(uhd::ntohx(payload[1]), addr * 0x10);
+    }
+
+    // Single commands still work after a batch
+    push_ack(xport, 4, 0xABCD);
+    BOOST_CHECK_EQUAL(ctrl->send_cmd_pkt(5, 0, true), 0xABCD);
+    // Response to the dummy peek on destruction
+    push_ack(xport, 5, 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_ctrl_iface_batch_no_response)
+{
+    mock_zero_copy::sptr xport(new mock_zero_copy(vrt::if_packet_info_t::LINK_TYPE_CHDR));
+    ctrl_iface::sptr ctrl = ctrl_iface::make(make_xports(xport));
+
+    ctrl_iface::cmd_batch batch;
+    ctrl_iface::cmd_batch::readback_t rb1 = batch.add_readback(1, 0);
+    ctrl_iface::cmd_batch::readback_t rb2 = batch.add_readback(2, 0);
+    // Only the first command is acknowledged
+    push_ack(xport, 0, 42);
+    BOOST_CHECK_THROW(ctrl->send_cmd_batch(batch), uhd::io_error);
+    BOOST_CHECK_EQUAL(rb1.get(), 42);
+    BOOST_CHECK_THROW(rb2.get(), uhd::io_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_ctrl_iface_fifo_size)
+{
+    mock_zero_copy::sptr xport(new mock_zero_copy(vrt::if_packet_info_t::LINK_TYPE_CHDR));
+    ctrl_iface::sptr ctrl = ctrl_iface::make(make_xports(xport));
+
+    // Limited by the response frames of the transport
+    BOOST_REQUIRE_EQUAL(xport->get_num_recv_frames(), 1);
+    ctrl->set_cmd_fifo_size(3000);
+    BOOST_CHECK_EQUAL(ctrl->get_cmd_fifo_size(), 1);
+    // Three lines per command packet
+    ctrl->set_cmd_fifo_size(2);
+    BOOST_CHECK_EQUAL(ctrl->get_cmd_fifo_size(), 0);
+    ctrl->set_cmd_fifo_size(3);
+    BOOST_CHECK_EQUAL(ctrl->get_cmd_fifo_size(), 1);
+
+    // Response to the dummy peek on destruction
+    push_ack(xport, 0, 0);
+}
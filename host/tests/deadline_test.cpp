@@ -0,0 +1,45 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhdlib/utils/deadline.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+
+using uhd::deadline_t;
+
+BOOST_AUTO_TEST_CASE(test_deadline)
+{
+    const deadline_t::clock::time_point start = deadline_t::clock::now();
+    const deadline_t deadline(0.5, start);
+    BOOST_CHECK(not deadline.is_poll());
+    BOOST_CHECK(deadline.get_exit_time() == start + std::chrono::milliseconds(500));
+    BOOST_CHECK_CLOSE(deadline.remaining(start), 0.5, 1e-6);
+    BOOST_CHECK_CLOSE(
+        deadline.remaining(start + std::chrono::milliseconds(200)), 0.3, 1e-6);
+    BOOST_CHECK(not deadline.expired(start + std::chrono::milliseconds(499)));
+
+    // Once it has passed, waits turn into polls
+    BOOST_CHECK(deadline.expired(start + std::chrono::milliseconds(500)));
+    BOOST_CHECK_EQUAL(deadline.remaining(start + std::chrono::seconds(1)), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(test_deadline_poll)
+{
+    for (const double timeout : {0.0, -1.0, std::nan("")}) {
+        const deadline_t deadline(timeout);
+        BOOST_CHECK(deadline.is_poll());
+        BOOST_CHECK(deadline.expired());
+        BOOST_CHECK_EQUAL(deadline.remaining(), 0.0);
+    }
+    BOOST_CHECK(deadline_t::poll().is_poll());
+    BOOST_CHECK_EQUAL(deadline_t::poll().remaining(), 0.0);
+
+    // Huge timeouts don't overflow the clock
+    const deadline_t::clock::time_point start = deadline_t::clock::now();
+    const deadline_t forever(1e300, start);
+    BOOST_CHECK(forever.get_exit_time() > start);
+    BOOST_CHECK_CLOSE(forever.remaining(start), double(deadline_t::MAX_TIMEOUT), 1e-6);
+}
@@ -0,0 +1,102 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/transport/bounded_buffer.hpp>
+#include <uhdlib/transport/demux_turns.hpp>
+#include <uhdlib/transport/spsc_bounded_buffer.hpp>
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+using namespace uhd::transport;
+
+BOOST_AUTO_TEST_CASE(test_demux_turns_timeout)
+{
+    spsc_bounded_buffer<int> queue(4);
+    int elem           = 0;
+    size_t num_demuxes = 0;
+    const auto demux   = [&num_demuxes](const double slice) {
+        num_demuxes++;
+        std::this_thread::sleep_for(std::chrono::duration<double>(slice));
+        return true;
+    };
+
+    // A poll takes one turn, and doesn't wait
+    BOOST_CHECK(not pop_with_demux_turns(queue, elem, 0.0, demux));
+    BOOST_CHECK_EQUAL(num_demuxes, 1);
+
+    // A timeout is cut into slices
+    const auto start = std::chrono::steady_clock::now();
+    BOOST_CHECK(not pop_with_demux_turns(queue, elem, 0.01, demux));
+    BOOST_CHECK(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(10));
+    BOOST_CHECK_GT(num_demuxes, 2);
+
+    // What the demuxer pushed for itself is popped right away
+    BOOST_CHECK(pop_with_demux_turns(queue, elem, 1.0, [&queue](const double) {
+        queue.push_with_haste(42);
+        return true;
+    }));
+    BOOST_CHECK_EQUAL(elem, 42);
+}
+
+BOOST_AUTO_TEST_CASE(test_demux_turns_no_turn)
+{
+    // Another thread demuxes all the time, so this one only ever waits
+    spsc_bounded_buffer<int> queue(4);
+    std::thread pusher([&queue]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        queue.push_with_haste(7);
+    });
+    int elem = 0;
+    BOOST_CHECK(
+        pop_with_demux_turns(queue, elem, 1.0, [](const double) { return false; }));
+    BOOST_CHECK_EQUAL(elem, 7);
+    pusher.join();
+}
+
+BOOST_AUTO_TEST_CASE(test_demux_turns_threads)
+{
+    // Two channels take turns demuxing one source of channel numbers
+    constexpr int NUM_ELEMS = 1000;
+    bounded_buffer<int> source(2 * NUM_ELEMS);
+    for (int i = 0; i < NUM_ELEMS; i++) {
+        source.push_with_haste(0);
+        source.push_with_haste(1);
+    }
+    spsc_bounded_buffer<int> queue0(2 * NUM_ELEMS), queue1(2 * NUM_ELEMS);
+    spsc_bounded_buffer<int>* queues[2] = {&queue0, &queue1};
+    std::mutex demux_mutex;
+    const auto demux = [&](const double slice) {
+        std::unique_lock<std::mutex> lock(demux_mutex, std::try_to_lock);
+        if (not lock.owns_lock()) {
+            return false;
+        }
+        int chan = 0;
+        for (size_t i = 0; i < DEMUX_BATCH and source.pop_with_timed_wait(chan, slice);
+             i++) {
+            queues[chan]->push_with_haste(chan);
+        }
+        return true;
+    };
+
+    std::atomic<int> num_received[2] = {{0}, {0}};
+    const auto receive = [&](const int chan) {
+        int elem = 0;
+        while (pop_with_demux_turns(*queues[chan], elem, 0.1, demux)) {
+            if (elem == chan) {
+                num_received[chan]++;
+            }
+        }
+    };
+    std::thread chan0(receive, 0);
+    std::thread chan1(receive, 1);
+    chan0.join();
+    chan1.join();
+    BOOST_CHECK_EQUAL(num_received[0], NUM_ELEMS);
+    BOOST_CHECK_EQUAL(num_received[1], NUM_ELEMS);
+}
@@ -0,0 +1,160 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "../lib/usrp/device3/device3_flow_ctrl.hpp"
+#include "common/mock_zero_copy.hpp"
+#include <uhd/transport/chdr.hpp>
+#include <uhd/utils/byteswap.hpp>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace uhd::transport;
+using namespace uhd::usrp;
+
+namespace {
+
+boost::shared_ptr<rx_fc_cache_t> make_adaptive_fc_cache(mock_zero_copy::sptr xport)
+{
+    boost::shared_ptr<rx_fc_cache_t> fc_cache(new rx_fc_cache_t());
+    fc_cache->to_host       = uhd::ntohx<uint32_t>;
+    fc_cache->from_host     = uhd::htonx<uint32_t>;
+    fc_cache->pack          = vrt::chdr::if_hdr_pack_be;
+    fc_cache->unpack        = vrt::chdr::if_hdr_unpack_be;
+    fc_cache->xport         = xport;
+    fc_cache->interval      = 1000;
+    fc_cache->adaptive      = true;
+    fc_cache->min_interval  = 1000;
+    fc_cache->max_interval  = 100000;
+    fc_cache->target_period = 0.001;
+    fc_cache->last_fc_time  = std::chrono::steady_clock::now();
+    return fc_cache;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_chdr_fc_byte_count)
+{
+    // Data packet, 100 bytes
+    BOOST_CHECK_EQUAL(get_chdr_fc_byte_count(100), 100);
+    // Lengths are rounded up to full words
+    BOOST_CHECK_EQUAL(get_chdr_fc_byte_count(101), 104);
+    // Error responses don't count
+    BOOST_CHECK_EQUAL(get_chdr_fc_byte_count((0x3 << 30) | (1 << 28) | 16), 0);
+    // Other responses do
+    BOOST_CHECK_EQUAL(get_chdr_fc_byte_count((0x3 << 30) | 16), 16);
+    // Too short to be a CHDR packet
+    BOOST_CHECK_EQUAL(get_chdr_fc_byte_count(4), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_rx_fc_update_interval)
+{
+    rx_fc_cache_t fc_cache;
+    fc_cache.min_interval  = 1000;
+    fc_cache.max_interval  = 100000;
+    fc_cache.target_period = 0.001;
+    auto now               = std::chrono::steady_clock::now();
+    fc_cache.last_fc_time  = now;
+
+    // 50 MB/s: 50000 bytes per 1 ms
+    now += std::chrono::milliseconds(1);
+    rx_fc_update_interval(fc_cache, 50000, now);
+    BOOST_CHECK_EQUAL(fc_cache.interval, 50000);
+    BOOST_CHECK(fc_cache.last_fc_time == now);
+
+    // A much faster sample only moves the smoothed rate by a quarter, and the
+    // interval is capped
+    now += std::chrono::milliseconds(1);
+    rx_fc_update_interval(fc_cache, 1000000, now);
+    BOOST_CHECK_EQUAL(fc_cache.interval, 100000);
+
+    // Slow consumption shrinks the interval down to the minimum
+    for (size_t i = 0; i < 50; i++) {
+        now += std::chrono::milliseconds(1);
+        rx_fc_update_interval(fc_cache, 10, now);
+    }
+    BOOST_CHECK_EQUAL(fc_cache.interval, 1000);
+}
+
+BOOST_AUTO_TEST_CASE(test_rx_flow_ctrl_adaptive)
+{
+    mock_zero_copy::sptr xport(new mock_zero_copy(vrt::if_packet_info_t::LINK_TYPE_CHDR));
+    auto fc_cache = make_adaptive_fc_cache(xport);
+
+    vrt::if_packet_info_t packet_info;
+    packet_info.packet_type         = vrt::if_packet_info_t::PACKET_TYPE_DATA;
+    packet_info.num_payload_words32 = 100;
+    packet_info.num_payload_bytes   = packet_info.num_payload_words32 * sizeof(uint32_t);
+    packet_info.has_tsf             = false;
+    std::vector<uint32_t> recv_data(packet_info.num_payload_words32, 0);
+
+    // Header is two words, so each packet counts 408 bytes. The third one
+    // crosses the interval of 1000 bytes and triggers a flow control packet.
+    const size_t num_packets = 3;
+    for (size_t i = 0; i < num_packets; i++) {
+        xport->push_back_recv_packet(packet_info, recv_data);
+    }
+    for (size_t i = 0; i < num_packets; i++) {
+        BOOST_CHECK(rx_flow_ctrl(fc_cache, xport->get_recv_buff(1.0)));
+    }
+    BOOST_CHECK_EQUAL(fc_cache->total_bytes_consumed, num_packets * 408);
+    BOOST_CHECK_EQUAL(fc_cache->total_packets_consumed, num_packets);
+    BOOST_CHECK_EQUAL(fc_cache->last_byte_count, num_packets * 408);
+    BOOST_CHECK_GE(fc_cache->interval, fc_cache->min_interval);
+    BOOST_CHECK_LE(fc_cache->interval, fc_cache->max_interval);
+    BOOST_CHECK_GT(fc_cache->consumption_rate, 0.0);
+
+    vrt::if_packet_info_t fc_info;
+    std::vector<uint32_t> payload;
+    xport->pop_send_packet(fc_info, payload);
+    BOOST_CHECK_EQUAL(fc_info.packet_type, vrt::if_packet_info_t::PACKET_TYPE_FC);
+    BOOST_REQUIRE_GT(payload.size(), DEVICE3_FC_BYTE_COUNT_OFFSET);
+    BOOST_CHECK_EQUAL(
+        uhd::ntohx(payload[DEVICE3_FC_PACKET_COUNT_OFFSET]), num_packets);
+    BOOST_CHECK_EQUAL(
+        uhd::ntohx(payload[DEVICE3_FC_BYTE_COUNT_OFFSET]), num_packets * 408);
+}
+
+BOOST_AUTO_TEST_CASE(test_tx_flow_ctrl_async_credit)
+{
+    constexpr uint32_t fc_window = 10000;
+
+    mock_zero_copy::sptr xport(new mock_zero_copy(vrt::if_packet_info_t::LINK_TYPE_CHDR));
+    xport->push_back_flow_ctrl_packet(
+        vrt::if_packet_info_t::PACKET_TYPE_FC, 1 /*packet*/, fc_window /*bytes*/);
+
+    boost::shared_ptr<tx_fc_cache_t> fc_cache(new tx_fc_cache_t(fc_window));
+    fc_cache->to_host      = uhd::ntohx<uint32_t>;
+    fc_cache->from_host    = uhd::htonx<uint32_t>;
+    fc_cache->pack         = vrt::chdr::if_hdr_pack_be;
+    fc_cache->unpack       = vrt::chdr::if_hdr_unpack_be;
+    fc_cache->async_credit = true;
+    // The window is full
+    fc_cache->byte_count = fc_window;
+
+    managed_send_buffer::sptr send_buffer = xport->get_send_buff(0.0);
+    BOOST_REQUIRE(send_buffer);
+
+    // The sender must wait for the harvester, and never touch the transport
+    std::thread harvester([fc_cache, xport]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        tx_flow_ctrl_harvest(fc_cache, xport);
+    });
+    BOOST_CHECK(tx_flow_ctrl(fc_cache, nullptr, send_buffer));
+    harvester.join();
+
+    BOOST_CHECK_EQUAL(fc_cache->async_fc_count.load(), 1);
+    BOOST_CHECK_EQUAL(fc_cache->last_byte_ack, fc_window);
+    BOOST_CHECK_EQUAL(fc_cache->last_seq_ack, 1);
+    BOOST_CHECK(fc_cache->fc_received);
+    BOOST_CHECK_EQUAL(fc_cache->pkt_count, 1);
+    BOOST_CHECK_GE(fc_cache->byte_count, fc_window + send_buffer->size());
+
+    // With credit left, no new FC packet is needed
+    BOOST_CHECK(tx_flow_ctrl(fc_cache, nullptr, send_buffer));
+    BOOST_CHECK_EQUAL(fc_cache->pkt_count, 2);
+}
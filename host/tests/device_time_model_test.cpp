@@ -0,0 +1,90 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhdlib/usrp/common/device_time_model.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+
+using namespace uhd;
+using namespace uhd::usrp;
+
+namespace {
+
+typedef device_time_model::clock_type clock_type;
+
+const clock_type::time_point HOST_START = clock_type::now();
+
+clock_type::time_point host_time(const double secs)
+{
+    return HOST_START
+           + std::chrono::duration_cast<clock_type::duration>(
+                 std::chrono::duration<double>(secs));
+}
+
+//! Read a device time that runs at 1 + drift with a round trip of rtt
+bool add_readback(device_time_model& model,
+    const double host_secs,
+    const double drift,
+    const double rtt = 100e-6)
+{
+    return model.add_readback(host_time(host_secs - rtt / 2),
+        host_time(host_secs + rtt / 2),
+        time_spec_t(10.0 + host_secs * (1.0 + drift)),
+        1.0 / 100e6);
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_single_readback)
+{
+    device_time_model model;
+    BOOST_CHECK(not model.is_valid());
+    BOOST_CHECK(std::isinf(model.get_error(host_time(0.0))));
+
+    BOOST_CHECK(add_readback(model, 1.0, 0.0));
+    BOOST_REQUIRE(model.is_valid());
+    BOOST_CHECK_CLOSE(model.get_time(host_time(2.0)).get_real_secs(), 12.0, 1e-6);
+
+    // The error is the half round trip, plus the drift prior further away
+    BOOST_CHECK_CLOSE(model.get_error(host_time(1.0)), 50e-6, 1.0);
+    BOOST_CHECK_CLOSE(model.get_error(host_time(11.0)),
+        std::sqrt(50e-6 * 50e-6 + 10.0 * 10.0 * 100e-6 * 100e-6),
+        1.0);
+
+    model.reset();
+    BOOST_CHECK(not model.is_valid());
+}
+
+BOOST_AUTO_TEST_CASE(test_drift_fit)
+{
+    const double drift = 20e-6;
+    device_time_model model;
+    for (int i = 0; i < 10; i++) {
+        BOOST_CHECK(add_readback(model, 1.0 + i, drift));
+    }
+
+    // 100 s after the last readback, the drift is 2 ms
+    const double expected = 10.0 + 110.0 * (1.0 + drift);
+    const double actual   = model.get_time(host_time(110.0)).get_real_secs();
+    const double error    = model.get_error(host_time(110.0));
+    BOOST_CHECK_SMALL(actual - expected, error);
+    BOOST_CHECK_LT(error, 100.0 * 20e-6);
+    // Ten readbacks know the time better than one
+    BOOST_CHECK_LT(model.get_error(host_time(5.5)), 50e-6);
+}
+
+BOOST_AUTO_TEST_CASE(test_jump)
+{
+    device_time_model model;
+    BOOST_CHECK(add_readback(model, 1.0, 0.0));
+    BOOST_CHECK(add_readback(model, 2.0, 0.0));
+
+    // The device time was set to 0 at host time 2.5
+    BOOST_CHECK(not model.add_readback(
+        host_time(3.0 - 50e-6), host_time(3.0 + 50e-6), time_spec_t(0.5), 1e-8));
+    BOOST_CHECK_CLOSE(model.get_time(host_time(4.0)).get_real_secs(), 1.5, 1e-3);
+    BOOST_CHECK_CLOSE(model.get_error(host_time(3.0)), 50e-6, 1.0);
+}
@@ -15,6 +15,18 @@ DEFAULT_U_THRESHOLD = 1000
 DEFAULT_D_THRESHOLD = 50
 DEFAULT_S_THRESHOLD = 50
 
+# Metrics that are compared against the baseline:
+# name -> (better, relative tolerance, absolute tolerance)
+PERF_METRICS = {
+    'rx_rate': ('higher', 0.01, 0),
+    'tx_rate': ('higher', 0.01, 0),
+    'cpu_usage_max': ('lower', 0.25, 10.0),
+    'rx_latency_p50_us': ('lower', 0.5, 10.0),
+    'rx_latency_p99_us': ('lower', 1.0, 100.0),
+    'tx_latency_p50_us': ('lower', 0.5, 10.0),
+    'tx_latency_p99_us': ('lower', 1.0, 100.0),
+}
+
 class uhd_benchmark_rate_test(uhd_example_test_case):
     """
     Run benchmark_rate in various configurations.
@@ -94,6 +106,18 @@ class uhd_benchmark_rate_test(uhd_example_test_case):
         run_results['num_tx_underruns'] = int(match.group(2)) if match else -1
         match = re.search(r'(Num timeouts \(Rx\)):\s*(.*)', app.stdout)
         run_results['num_timeouts_rx'] = int(match.group(2)) if match else -1
+        # Achieved rates per channel, in samples per second
+        if run_results['num_rx_samples'] > 0:
+            run_results['rx_rate'] = 1.0 * run_results['num_rx_samples'] / n_chans / duration
+        if run_results['num_tx_samples'] > 0:
+            run_results['tx_rate'] = 1.0 * run_results['num_tx_samples'] / n_chans / duration
+        for direction, call in (('rx', 'RX recv()'), ('tx', 'TX send()')):
+            match = re.search(re.escape(call) + r' latency \(us\):(.*)', app.stdout)
+            if not match:
+                continue
+            for stat, value in re.findall(r'(\S+)\s+([0-9.]+)', match.group(1)):
+                key = '{}_latency_{}_us'.format(direction, stat.replace('.', '_'))
+                run_results[key] = float(value)
         run_results['passed'] = all([
             run_results['return_code'] == 0,
             run_results['num_rx_dropped'] == 0,
@@ -105,6 +129,8 @@ class uhd_benchmark_rate_test(uhd_example_test_case):
             # run_results['rel_rx_samples_error'] < rel_samp_err_threshold,
             # run_results['rel_tx_samples_error'] < rel_samp_err_threshold,
         ])
+        self.check_baseline(
+            test_name, run_results, test_args.get('baseline-metrics', PERF_METRICS))
         self.report_example_results(test_name, run_results)
         return run_results
 
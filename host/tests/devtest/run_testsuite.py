@@ -28,6 +28,12 @@ def setup_parser():
     parser.add_argument('--build-dir', help='Build dir (where examples/ and utils/ are)')
     parser.add_argument('--build-type', default='Release')
     parser.add_argument('--python-interp', default=sys.executable)
+    parser.add_argument('--baseline-dir',
+                        help='Directory with the performance baselines of each '
+                             'device. Results that are worse fail the tests.')
+    parser.add_argument('--update-baselines', action='store_true',
+                        help='Store the results as the new baselines instead '
+                             'of comparing against them')
     return parser
 
 def setup_env(args):
@@ -110,6 +116,13 @@ def main():
         )
         env['_UHD_TEST_LOGFILE'] = os.path.join(args.log_dir, logfile_name)
         env['_UHD_TEST_RESULTSFILE'] = os.path.join(args.log_dir, resultsfile_name)
+        if args.baseline_dir:
+            baselinefile_name = "baseline{}.yaml".format(
+                args_str.replace('type=', '_').replace('serial=', '_').replace(',', '')
+            )
+            env['_UHD_TEST_BASELINEFILE'] = \
+                os.path.join(args.baseline_dir, baselinefile_name)
+            env['_UHD_TEST_UPDATE_BASELINE'] = "1" if args.update_baselines else ""
         env['_UHD_TEST_LOG_LEVEL'] = str(logging.INFO)
         env['_UHD_TEST_PRINT_LEVEL'] = str(logging.WARNING)
         env['_UHD_BUILD_DIR'] = str(args.build_dir)
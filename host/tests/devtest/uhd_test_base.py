@@ -48,6 +48,65 @@ def filter_stderr(stderr, run_results=None):
     run_results['errors'] = errstr.strip()
     return run_results
 
+def read_cpu_times():
+    """
+    Returns a list of (busy, total) jiffies per CPU core, or None if the OS
+    doesn't provide them (only Linux does).
+    """
+    try:
+        with open('/proc/stat') as stat_file:
+            lines = stat_file.readlines()
+    except (IOError, OSError):
+        return None
+    cpu_times = []
+    for line in lines:
+        fields = line.split()
+        if not fields or not re.match(r'cpu\d+$', fields[0]):
+            continue
+        times = [int(x) for x in fields[1:]]
+        # idle and iowait are the 4th and 5th field
+        idle = sum(times[3:5])
+        cpu_times.append((sum(times) - idle, sum(times)))
+    return cpu_times or None
+
+def cpu_usage(start_times, end_times):
+    """
+    Returns the percentage of time each core was busy between two calls to
+    read_cpu_times().
+    """
+    if not start_times or not end_times or len(start_times) != len(end_times):
+        return None
+    return [
+        round(100.0 * (end[0] - start[0]) / max(end[1] - start[1], 1), 1)
+        for start, end in zip(start_times, end_times)
+    ]
+
+def compare_to_baseline(results, baseline, metrics):
+    """
+    Compares the performance metrics in results against the baseline.
+
+    metrics is a dictionary metric name -> (better, rel_tolerance,
+    abs_tolerance), where better is either 'higher' or 'lower'. A metric
+    regresses if it's worse than the baseline by more than both tolerances.
+    Metrics that are missing from either dictionary are not compared.
+
+    Returns a list of strings describing the regressions.
+    """
+    regressions = []
+    for metric, (better, rel_tolerance, abs_tolerance) in sorted(iteritems(metrics)):
+        if results.get(metric) is None or baseline.get(metric) is None:
+            continue
+        value = results[metric]
+        reference = baseline[metric]
+        slack = max(abs(reference) * rel_tolerance, abs_tolerance)
+        if better == 'higher':
+            regressed = value < reference - slack
+        else:
+            regressed = value > reference + slack
+        if regressed:
+            regressions.append("{}: {} (baseline: {})".format(metric, value, reference))
+    return regressions
+
 #--------------------------------------------------------------------------
 # Application
 #--------------------------------------------------------------------------
@@ -62,6 +121,7 @@ class shell_application(object):
         self.stderr = ''
         self.returncode = None
         self.exec_time = None
+        self.cpu_usage = None
 
     def run(self, args=None):
         """Test executor."""
@@ -69,6 +129,7 @@ class shell_application(object):
         cmd_line = [self.name]
         cmd_line.extend(args)
         start_time = time.time()
+        start_cpu_times = read_cpu_times()
         env = os.environ
         env["UHD_LOG_FASTPATH_DISABLE"] = "1"
         try:
@@ -83,6 +144,7 @@ class shell_application(object):
             self.stdout, self.stderr = proc.communicate()
             self.returncode = proc.returncode
             self.exec_time = time.time() - start_time
+            self.cpu_usage = cpu_usage(start_cpu_times, read_cpu_times())
         except OSError as ex:
             raise RuntimeError("Failed to execute command: `{}'\n{}"
                                .format(cmd_line, str(ex)))
@@ -116,6 +178,11 @@ class uhd_test_case(unittest.TestCase):
             self.results[self.usrp_info['serial']] = {}
         if self.name not in self.results[self.usrp_info['serial']]:
             self.results[self.usrp_info['serial']][self.name] = {}
+        self.baseline = {}
+        self.baseline_file = os.getenv('_UHD_TEST_BASELINEFILE', "")
+        self.update_baseline = bool(os.getenv('_UHD_TEST_UPDATE_BASELINE', ""))
+        if self.baseline_file and os.path.isfile(self.baseline_file):
+            self.baseline = yaml.safe_load(open(self.baseline_file).read()) or {}
         self.setup_logger()
         self.set_up()
 
@@ -148,6 +215,9 @@ class uhd_test_case(unittest.TestCase):
         if self.results_file:
             open(self.results_file, 'w').write(
                 yaml.dump(self.results, default_flow_style=False))
+        if self.baseline_file and self.update_baseline:
+            open(self.baseline_file, 'w').write(
+                yaml.dump(self.baseline, default_flow_style=False))
         time.sleep(15)
 
     def report_result(self, testname, key, value):
@@ -158,6 +228,29 @@ class uhd_test_case(unittest.TestCase):
             self.results[self.usrp_info['serial']][self.name][testname] = {}
         self.results[self.usrp_info['serial']][self.name][testname][key] = value
 
+    def check_baseline(self, testname, run_results, metrics):
+        """ Compare the performance metrics of a test against the stored
+        baseline. See compare_to_baseline() for the format of metrics.
+
+        If baselines are being updated, the metrics are stored as the new
+        baseline instead. Otherwise, any regressions are stored in
+        run_results['regressions'] and the test fails.
+        """
+        baseline = self.baseline.setdefault(self.name, {}).setdefault(testname, {})
+        if self.update_baseline:
+            for metric in metrics:
+                if run_results.get(metric) is not None:
+                    baseline[metric] = run_results[metric]
+            return
+        if not baseline:
+            self.log.info('No baseline for %s, skipping comparison', testname)
+            return
+        regressions = compare_to_baseline(run_results, baseline, metrics)
+        for regression in regressions:
+            self.log.warning('Performance regression in %s: %s', testname, regression)
+        run_results['regressions'] = regressions
+        run_results['passed'] = run_results['passed'] and not regressions
+
     def create_addr_args_str(self, argname="args"):
         """ Returns an args string, usually '--args "type=XXX,serial=YYY" """
         if len(self.args_str) == 0:
@@ -203,6 +296,9 @@ class uhd_example_test_case(uhd_test_case):
             'passed': False,
         }
         run_results = filter_stderr(app.stderr, run_results)
+        if app.cpu_usage:
+            run_results['cpu_usage'] = app.cpu_usage
+            run_results['cpu_usage_max'] = max(app.cpu_usage)
         self.log.info('STDERR Output:')
         self.log.info(str(app.stderr))
         return (app, run_results)
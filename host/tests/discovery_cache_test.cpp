@@ -0,0 +1,70 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhdlib/utils/discovery_cache.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace uhd;
+
+BOOST_AUTO_TEST_CASE(test_discovery_cache_can_use)
+{
+    BOOST_CHECK(not discovery_cache::can_use(device_addr_t("serial=1234")));
+    BOOST_CHECK(discovery_cache::can_use(device_addr_t("discovery_cache,serial=1234")));
+    BOOST_CHECK(
+        not discovery_cache::can_use(device_addr_t("discovery_cache,addr=192.168.10.2")));
+    BOOST_CHECK(not discovery_cache::can_use(
+        device_addr_t("discovery_cache,mgmt_addr0=10.0.0.2,mgmt_addr1=10.0.0.3")));
+}
+
+BOOST_AUTO_TEST_CASE(test_discovery_cache)
+{
+    const std::string path =
+        (boost::filesystem::temp_directory_path()
+            / boost::filesystem::unique_path("uhd_discovery_cache_test_%%%%%%%%"))
+            .string();
+
+    {
+        discovery_cache cache(path);
+        BOOST_CHECK(cache.get_entries().empty());
+        device_addrs_t found;
+        found.push_back(device_addr_t(
+            "type=x300,addr=192.168.10.2,serial=1234,name=,product=X310,fpga=HG"));
+        found.push_back(device_addr_t("type=n3xx,mgmt_addr=10.0.0.2,serial=5678"));
+        // No serial or no address, these can't be validated
+        found.push_back(device_addr_t("type=x300,addr=192.168.40.2,serial="));
+        found.push_back(device_addr_t("type=b200,serial=9abc"));
+        cache.add(found);
+        BOOST_REQUIRE_EQUAL(cache.get_entries().size(), 2);
+        // Only the identifying keys are cached
+        BOOST_CHECK(not cache.get_entries()[0].has_key("fpga"));
+        cache.save();
+    }
+
+    discovery_cache cache(path);
+    BOOST_REQUIRE_EQUAL(cache.get_entries().size(), 2);
+
+    device_addrs_t hints = cache.get_hints(device_addr_t("discovery_cache"));
+    BOOST_REQUIRE_EQUAL(hints.size(), 2);
+    BOOST_CHECK_EQUAL(hints[0]["addr"], "192.168.10.2");
+    BOOST_CHECK_EQUAL(hints[0]["type"], "x300");
+    BOOST_CHECK_EQUAL(hints[0]["serial"], "1234");
+    BOOST_CHECK(hints[0].has_key("discovery_cache"));
+    BOOST_CHECK_EQUAL(hints[1]["mgmt_addr"], "10.0.0.2");
+
+    hints = cache.get_hints(device_addr_t("serial=5678"));
+    BOOST_REQUIRE_EQUAL(hints.size(), 1);
+    BOOST_CHECK_EQUAL(hints[0]["type"], "n3xx");
+    BOOST_CHECK(cache.get_hints(device_addr_t("type=x300,serial=5678")).empty());
+
+    // A rediscovered device moves, a stale one is removed
+    cache.add({device_addr_t("type=x300,addr=192.168.20.2,serial=1234")});
+    cache.remove(device_addr_t("type=n3xx,mgmt_addr=10.0.0.2,serial=5678"));
+    BOOST_REQUIRE_EQUAL(cache.get_entries().size(), 1);
+    BOOST_CHECK_EQUAL(cache.get_entries()[0]["addr"], "192.168.20.2");
+
+    boost::filesystem::remove(path);
+}
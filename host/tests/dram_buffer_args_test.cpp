@@ -0,0 +1,46 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhdlib/rfnoc/dram_buffer_args.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace uhd::rfnoc;
+
+BOOST_AUTO_TEST_CASE(test_use_dram_buffer)
+{
+    BOOST_CHECK(not use_dram_buffer(uhd::device_addr_t()));
+    BOOST_CHECK(use_dram_buffer(uhd::device_addr_t("dram_buffer")));
+    BOOST_CHECK(use_dram_buffer(uhd::device_addr_t("dram_buffer=1")));
+    BOOST_CHECK(use_dram_buffer(uhd::device_addr_t("dram_buffer=true")));
+    BOOST_CHECK(not use_dram_buffer(uhd::device_addr_t("dram_buffer=0")));
+    BOOST_CHECK(not use_dram_buffer(uhd::device_addr_t("dram_buffer=false")));
+    BOOST_CHECK_THROW(
+        use_dram_buffer(uhd::device_addr_t("dram_buffer=maybe")), uhd::value_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_get_dram_buffer_size)
+{
+    const auto size_args = [](const std::string& size) {
+        return uhd::device_addr_t("dram_buffer_size=" + size);
+    };
+
+    BOOST_CHECK_EQUAL(get_dram_buffer_size(size_args("8192"), 0), 8192);
+    BOOST_CHECK_EQUAL(get_dram_buffer_size(size_args("33554432"), 3), 33554432);
+    // Too small, not a power of 2, or not a number
+    BOOST_CHECK_THROW(get_dram_buffer_size(size_args("0"), 0), uhd::value_error);
+    BOOST_CHECK_THROW(get_dram_buffer_size(size_args("4096"), 0), uhd::value_error);
+    BOOST_CHECK_THROW(get_dram_buffer_size(size_args("12288"), 0), uhd::value_error);
+    BOOST_CHECK_THROW(get_dram_buffer_size(size_args("-8192"), 0), uhd::value_error);
+    BOOST_CHECK_THROW(get_dram_buffer_size(size_args("1e6"), 0), uhd::value_error);
+
+    // The depth has 32 bits, so 2^32 doesn't fit even on port 0
+    BOOST_CHECK_THROW(get_dram_buffer_size(size_args("4294967296"), 0), uhd::value_error);
+    BOOST_CHECK_THROW(get_dram_buffer_size(size_args("4294967295"), 0), uhd::value_error);
+    BOOST_CHECK_EQUAL(get_dram_buffer_size(size_args("2147483648"), 1), 2147483648u);
+    // Port 2 would end past the address space
+    BOOST_CHECK_THROW(get_dram_buffer_size(size_args("2147483648"), 2), uhd::value_error);
+}
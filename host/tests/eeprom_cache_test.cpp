@@ -0,0 +1,123 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhdlib/usrp/common/eeprom_cache.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/test/unit_test.hpp>
+#include <map>
+
+using namespace uhd;
+using namespace uhd::usrp;
+
+namespace {
+
+//! EEPROMs which count the bytes read from them
+class mock_eeprom_iface : public i2c_iface
+{
+public:
+    void write_i2c(uint16_t addr, const byte_vector_t& bytes)
+    {
+        // The first byte sets the address, the rest is written from there
+        if (bytes.empty()) {
+            return;
+        }
+        _ptr[addr] = bytes[0];
+        for (size_t i = 1; i < bytes.size(); i++) {
+            mem(addr)[_ptr[addr]++] = bytes[i];
+        }
+    }
+
+    byte_vector_t read_i2c(uint16_t addr, size_t num_bytes)
+    {
+        byte_vector_t bytes;
+        for (size_t i = 0; i < num_bytes; i++) {
+            bytes.push_back(mem(addr)[_ptr[addr]++]);
+        }
+        bytes_read += num_bytes;
+        return bytes;
+    }
+
+    byte_vector_t read_eeprom(uint16_t addr, uint16_t offset, size_t num_bytes)
+    {
+        write_i2c(addr, byte_vector_t(1, uint8_t(offset)));
+        return read_i2c(addr, num_bytes);
+    }
+
+    byte_vector_t& mem(const uint16_t addr)
+    {
+        auto& bytes = _mem[addr];
+        bytes.resize(256, 0xff);
+        return bytes;
+    }
+
+    size_t bytes_read = 0;
+
+private:
+    std::map<uint16_t, byte_vector_t> _mem;
+    std::map<uint16_t, uint8_t> _ptr;
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_eeprom_cache)
+{
+    eeprom_cache_iface::clear();
+    auto mock = boost::make_shared<mock_eeprom_iface>();
+    for (size_t i = 0; i < 32; i++) {
+        mock->mem(0x50)[i] = uint8_t(i);
+    }
+
+    // Nothing cached yet
+    auto iface = eeprom_cache_iface::make(
+        mock, "1234", eeprom_cache_iface::DB_EEPROM_CHECK_REGIONS);
+    const byte_vector_t bytes = iface->read_eeprom(0x50, 0, 32);
+    BOOST_CHECK_EQUAL(bytes.size(), 32);
+    BOOST_CHECK_EQUAL(mock->bytes_read, 32);
+
+    // A new session only reads the check regions
+    mock->bytes_read = 0;
+    iface            = eeprom_cache_iface::make(
+        mock, "1234", eeprom_cache_iface::DB_EEPROM_CHECK_REGIONS);
+    BOOST_CHECK(iface->read_eeprom(0x50, 0, 32) == bytes);
+    BOOST_CHECK_EQUAL(mock->bytes_read, 4);
+
+    // Contents are not shared between motherboards or addresses
+    mock->bytes_read = 0;
+    auto other_iface = eeprom_cache_iface::make(
+        mock, "5678", eeprom_cache_iface::DB_EEPROM_CHECK_REGIONS);
+    other_iface->read_eeprom(0x50, 0, 32);
+    iface->read_eeprom(0x51, 0, 32);
+    BOOST_CHECK_EQUAL(mock->bytes_read, 64);
+
+    // A change in the check regions is detected
+    mock->bytes_read      = 0;
+    mock->mem(0x50)[0x1f] = 0x42;
+    BOOST_CHECK_EQUAL(iface->read_eeprom(0x50, 0, 32).at(0x1f), 0x42);
+    BOOST_CHECK_EQUAL(mock->bytes_read, 4 + 32);
+
+    // Writes through the cache drop the contents
+    iface->write_eeprom(0x50, 0x10, byte_vector_t(1, 0x24));
+    mock->bytes_read = 0;
+    BOOST_CHECK_EQUAL(iface->read_eeprom(0x50, 0, 32).at(0x10), 0x24);
+    BOOST_CHECK_EQUAL(mock->bytes_read, 32);
+
+    // Reads which don't cover the check regions are passed through
+    mock->bytes_read = 0;
+    iface->read_eeprom(0x50, 4, 8);
+    iface->read_eeprom(0x50, 4, 8);
+    BOOST_CHECK_EQUAL(mock->bytes_read, 16);
+}
+
+BOOST_AUTO_TEST_CASE(test_eeprom_cache_no_key)
+{
+    eeprom_cache_iface::clear();
+    auto mock  = boost::make_shared<mock_eeprom_iface>();
+    auto iface = eeprom_cache_iface::make(
+        mock, "", eeprom_cache_iface::DB_EEPROM_CHECK_REGIONS);
+    iface->read_eeprom(0x50, 0, 32);
+    iface->read_eeprom(0x50, 0, 32);
+    BOOST_CHECK_EQUAL(mock->bytes_read, 64);
+}
@@ -49,6 +49,11 @@ UHD_INLINE uhd_error throw_unknown_exception(dummy_handle_t* handle)
     UHD_SAFE_C_SAVE_ERROR(handle, throw 1;)
 }
 
+UHD_INLINE uhd_error no_exception(dummy_handle_t* handle)
+{
+    UHD_SAFE_C_SAVE_ERROR(handle, (void)handle;)
+}
+
 // There are enough non-standard names that we can't just use a conversion function
 static const uhd::dict<std::string, std::string> pretty_exception_names =
     boost::assign::map_list_of("assertion_error", "AssertionError")(
@@ -129,3 +134,21 @@ BOOST_AUTO_TEST_CASE(test_unknown_exception)
     BOOST_CHECK_EQUAL(error_code, UHD_ERROR_UNKNOWN);
     BOOST_CHECK_EQUAL(handle.last_error, "Unrecognized exception caught.");
 }
+
+BOOST_AUTO_TEST_CASE(test_no_exception)
+{
+    dummy_handle_t handle;
+    throw_unknown_exception(&handle);
+
+    // Success clears the errors of a previous call, repeatedly
+    for (size_t i = 0; i < 2; i++) {
+        BOOST_CHECK_EQUAL(no_exception(&handle), UHD_ERROR_NONE);
+        BOOST_CHECK_EQUAL(handle.last_error, "None");
+        BOOST_CHECK_EQUAL(get_c_global_error_string(), "None");
+    }
+
+    throw_unknown_exception(&handle);
+    BOOST_CHECK_EQUAL(get_c_global_error_string(), "Unrecognized exception caught.");
+    no_exception(&handle);
+    BOOST_CHECK_EQUAL(get_c_global_error_string(), "None");
+}
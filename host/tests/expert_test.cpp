@@ -142,6 +142,34 @@ private:
 
 //=============================================================================
 
+class copy_worker_t : public worker_node_t
+{
+public:
+    copy_worker_t(const node_retriever_t& db,
+        const std::string& in,
+        const std::string& out,
+        boost::shared_ptr<int> count)
+        : worker_node_t(in + "->" + out), _in(db, in), _out(db, out), _count(count)
+    {
+        bind_accessor(_in);
+        bind_accessor(_out);
+    }
+
+private:
+    void resolve()
+    {
+        _out = _in.get();
+        (*_count)++;
+    }
+
+    data_reader_t<int> _in;
+    data_writer_t<int> _out;
+
+    boost::shared_ptr<int> _count;
+};
+
+//=============================================================================
+
 #define DUMP_VARS                                                                     \
     BOOST_TEST_MESSAGE(str(                                                           \
         boost::format(                                                                \
@@ -265,3 +293,133 @@ BOOST_AUTO_TEST_CASE(test_experts)
     container->resolve_to("Consume_G");
     VALIDATE_ALL_DEPENDENCIES
 }
+
+BOOST_AUTO_TEST_CASE(test_experts_incremental)
+{
+    expert_container::sptr container = expert_factory::create_container("incremental");
+    uhd::property_tree::sptr tree    = uhd::property_tree::make();
+    boost::shared_ptr<int> x_count   = boost::make_shared<int>(0);
+    boost::shared_ptr<int> z_count   = boost::make_shared<int>(0);
+
+    // Two independent chains: X -> Y and Z -> W
+    expert_factory::add_prop_node<int>(
+        container, tree, "X", 0, uhd::experts::AUTO_RESOLVE_ON_WRITE);
+    expert_factory::add_data_node<int>(container, "Y", 0);
+    expert_factory::add_prop_node<int>(container, tree, "Z", 0);
+    expert_factory::add_data_node<int>(container, "W", 0);
+    expert_factory::add_worker_node<copy_worker_t>(
+        container, container->node_retriever(), "X", "Y", x_count);
+    expert_factory::add_worker_node<copy_worker_t>(
+        container, container->node_retriever(), "Z", "W", z_count);
+    container->resolve_all();
+    BOOST_CHECK_EQUAL(*x_count, 1);
+    BOOST_CHECK_EQUAL(*z_count, 1);
+
+    // A dirty node outside the changed node's cone is left alone
+    tree->access<int>("Z").set(2);
+    tree->access<int>("X").set(1);
+    BOOST_CHECK_EQUAL(*x_count, 2);
+    BOOST_CHECK_EQUAL(*z_count, 1);
+    BOOST_CHECK(container->node_retriever().lookup("Z").is_dirty());
+
+    container->resolve_to("W");
+    BOOST_CHECK_EQUAL(*x_count, 2);
+    BOOST_CHECK_EQUAL(*z_count, 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_experts_parallel)
+{
+    expert_container::sptr container = expert_factory::create_container("parallel");
+    uhd::property_tree::sptr tree    = uhd::property_tree::make();
+    boost::shared_ptr<int> count     = boost::make_shared<int>(0);
+    container->set_resolve_threads(4);
+
+    // Four independent chains of two workers each: IN_i -> MID_i -> OUT_i
+    std::vector<std::string> chains{"0", "1", "2", "3"};
+    for (const std::string& i : chains) {
+        expert_factory::add_prop_node<int>(
+            container, tree, "IN_" + i, 0, uhd::experts::AUTO_RESOLVE_ON_WRITE);
+        expert_factory::add_data_node<int>(container, "MID_" + i, 0);
+        expert_factory::add_data_node<int>(container, "OUT_" + i, 0);
+    }
+    // The count is shared, so count the resolves of one chain only
+    for (const std::string& i : chains) {
+        expert_factory::add_worker_node<copy_worker_t>(container,
+            container->node_retriever(),
+            "IN_" + i,
+            "MID_" + i,
+            i == "0" ? count : boost::make_shared<int>(0));
+        expert_factory::add_worker_node<copy_worker_t>(container,
+            container->node_retriever(),
+            "MID_" + i,
+            "OUT_" + i,
+            i == "0" ? count : boost::make_shared<int>(0));
+    }
+    for (const std::string& i : chains) {
+        tree->access<int>("IN_" + i).set(std::stoi(i) + 10);
+    }
+    container->resolve_all(true);
+    for (const std::string& i : chains) {
+        const data_node_t<int>& out = dynamic_cast<const data_node_t<int>&>(
+            container->node_retriever().lookup("OUT_" + i));
+        BOOST_CHECK_EQUAL(out.get(), std::stoi(i) + 10);
+    }
+    BOOST_CHECK_EQUAL(*count, 4);
+
+    const std::string dot = container->to_dot();
+    BOOST_CHECK(dot.find("label=\"IN_0->MID_0\",shape=box,xlabel=\"level 1\"")
+                != std::string::npos);
+    BOOST_CHECK(dot.find("label=\"MID_0->OUT_0\",shape=box,xlabel=\"level 3\"")
+                != std::string::npos);
+}
+
+//=============================================================================
+
+class handle_worker_t : public worker_node_t
+{
+public:
+    handle_worker_t(
+        const data_node_handle_t<int>& in, const data_node_handle_t<int>& out)
+        : worker_node_t("handle_worker"), _in(in), _out(out)
+    {
+        bind_accessor(_in);
+        bind_accessor(_out);
+    }
+
+private:
+    void resolve()
+    {
+        _out = _in.get() * 2;
+    }
+
+    data_reader_t<int> _in;
+    data_writer_t<int> _out;
+};
+
+BOOST_AUTO_TEST_CASE(test_experts_handles)
+{
+    expert_container::sptr container = expert_factory::create_container("handles");
+    uhd::property_tree::sptr tree    = uhd::property_tree::make();
+
+    // Workers can be bound to typed handles instead of node names
+    expert_factory::add_prop_node<int>(
+        container, tree, "IN", 0, uhd::experts::AUTO_RESOLVE_ON_WRITE);
+    const data_node_handle_t<int> in =
+        container->node_retriever().get_handle<int>("IN");
+    const data_node_handle_t<int> out =
+        expert_factory::add_data_node<int>(container, "OUT", 0);
+    BOOST_CHECK(in.is_valid());
+    BOOST_CHECK(out.is_valid());
+    BOOST_CHECK(not data_node_handle_t<int>().is_valid());
+    expert_factory::add_worker_node<handle_worker_t>(container, in, out);
+    container->resolve_all();
+
+    tree->access<int>("IN").set(21);
+    BOOST_CHECK_EQUAL(out.node().get(), 42);
+    BOOST_CHECK(not in.node().is_dirty());
+
+    BOOST_CHECK_THROW(container->node_retriever().get_handle<double>("IN"),
+        uhd::type_error);
+    BOOST_CHECK_THROW(container->node_retriever().get_handle<int>("NONE"),
+        uhd::lookup_error);
+}
@@ -0,0 +1,236 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Measures how fast the receive packet handler recovers from transport
+// faults (dropped, reordered, duplicated and delayed packets), and its
+// throughput while they happen. The packets come from mock transports, through
+// the same fault injecting transport that devices use with the recv_fault_*
+// device args.
+
+#include "../lib/transport/super_recv_packet_handler.hpp"
+#include "common/mock_zero_copy.hpp"
+#include <uhd/convert.hpp>
+#include <uhd/transport/zero_copy_fault_inject.hpp>
+#include <uhd/utils/safe_main.hpp>
+#include <boost/format.hpp>
+#include <boost/program_options.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+namespace po = boost::program_options;
+using namespace uhd::transport;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+//! What happened while receiving all packets
+struct recovery_result_t
+{
+    size_t num_samps          = 0;
+    double elapsed_time       = 0.0;
+    size_t num_errors         = 0;
+    size_t num_recoveries     = 0;
+    double total_recovery_us  = 0.0;
+    double max_recovery_us    = 0.0;
+    uint64_t total_lost_samps = 0;
+    uint64_t max_lost_samps   = 0;
+    //! Samples that came with an earlier time than expected
+    uint64_t repeated_samps = 0;
+};
+
+//! Queue \p num_packets packets of \p spp samples with consecutive times
+mock_zero_copy::sptr make_mock_xport(const size_t num_packets, const size_t spp)
+{
+    const size_t payload_w32 = spp; // sc16_item32_be
+    const size_t frame_size =
+        payload_w32 * sizeof(uint32_t) + (vrt::max_if_hdr_words32 + 1) * sizeof(uint32_t);
+    auto xport = boost::make_shared<mock_zero_copy>(
+        vrt::if_packet_info_t::LINK_TYPE_VRLP, frame_size, frame_size);
+
+    vrt::if_packet_info_t ifpi;
+    ifpi.packet_type         = vrt::if_packet_info_t::PACKET_TYPE_DATA;
+    ifpi.num_payload_words32 = payload_w32;
+    ifpi.has_sid             = false;
+    ifpi.has_cid             = false;
+    ifpi.has_tsi             = false;
+    ifpi.has_tsf             = true;
+    ifpi.has_tlr             = false;
+    const std::vector<uint32_t> data(payload_w32, 0);
+    for (size_t i = 0; i < num_packets; i++) {
+        ifpi.packet_count = i & 0xfff;
+        ifpi.tsf          = i * spp;
+        xport->push_back_recv_packet(ifpi, data);
+    }
+    return xport;
+}
+
+recovery_result_t benchmark_recovery(const size_t num_chans,
+    const size_t spp,
+    const size_t num_packets,
+    const std::string& cpu_format,
+    const uhd::device_addr_t& fault_args,
+    std::vector<zero_copy_fault_inject::stats_t>& fault_stats)
+{
+    // One tick per sample, so the time specs count samples
+    sph::recv_packet_handler handler(num_chans);
+    handler.set_vrt_unpacker(&vrt::if_hdr_unpack_be);
+    handler.set_tick_rate(1.0);
+    handler.set_samp_rate(1.0);
+    uhd::convert::id_type id;
+    id.input_format  = "sc16_item32_be";
+    id.num_inputs    = 1;
+    id.output_format = cpu_format;
+    id.num_outputs   = 1;
+    handler.set_converter(id);
+
+    std::vector<zero_copy_fault_inject::sptr> xports;
+    for (size_t chan = 0; chan < num_chans; chan++) {
+        uhd::device_addr_t chan_args = fault_args;
+        chan_args["recv_fault_seed"] = std::to_string(
+            fault_args.cast<uint32_t>("recv_fault_seed", 1) + chan);
+        auto xport =
+            zero_copy_fault_inject::make(make_mock_xport(num_packets, spp), chan_args);
+        handler.set_xport_chan_get_buff(
+            chan, [xport](double timeout) { return xport->get_recv_buff(timeout); });
+        xports.push_back(xport);
+    }
+
+    const size_t bpi = uhd::convert::get_bytes_per_item(cpu_format);
+    std::vector<std::vector<uint8_t>> buffer(num_chans, std::vector<uint8_t>(spp * bpi));
+    std::vector<void*> buffs;
+    for (auto& chan_buffer : buffer) {
+        buffs.push_back(chan_buffer.data());
+    }
+
+    // Receive until the mock transports run dry. A recovery starts with the
+    // first error and ends with the next call that returns samples.
+    recovery_result_t result;
+    uhd::rx_metadata_t md;
+    uint64_t next_samp = 0;
+    bool recovering    = false;
+    auto error_time    = clock_type::now();
+    const auto start   = clock_type::now();
+    const size_t limit = num_packets * 10;
+    for (size_t call = 0; call < limit; call++) {
+        const size_t nsamps = handler.recv(buffs, spp, md, 0.0, true);
+        if (md.error_code == uhd::rx_metadata_t::ERROR_CODE_TIMEOUT) {
+            break;
+        }
+        if (md.error_code != uhd::rx_metadata_t::ERROR_CODE_NONE) {
+            result.num_errors++;
+            if (not recovering) {
+                recovering = true;
+                error_time = clock_type::now();
+            }
+            continue;
+        }
+        if (nsamps == 0) {
+            continue;
+        }
+        const uint64_t samp = uint64_t(md.time_spec.to_ticks(1.0));
+        if (recovering) {
+            recovering = false;
+            const double us =
+                std::chrono::duration<double, std::micro>(clock_type::now() - error_time)
+                    .count();
+            result.num_recoveries++;
+            result.total_recovery_us += us;
+            result.max_recovery_us = std::max(result.max_recovery_us, us);
+        }
+        if (samp >= next_samp) {
+            result.total_lost_samps += samp - next_samp;
+            result.max_lost_samps = std::max(result.max_lost_samps, samp - next_samp);
+        } else {
+            result.repeated_samps += std::min<uint64_t>(next_samp - samp, nsamps);
+        }
+        result.num_samps += nsamps;
+        next_samp = std::max(next_samp, samp + nsamps);
+    }
+    result.elapsed_time =
+        std::chrono::duration<double>(clock_type::now() - start).count();
+
+    fault_stats.clear();
+    for (const auto& xport : xports) {
+        fault_stats.push_back(xport->get_stats());
+    }
+    return result;
+}
+
+} // namespace
+
+int UHD_SAFE_MAIN(int argc, char* argv[])
+{
+    po::options_description desc("Allowed options");
+    // clang-format off
+    desc.add_options()
+        ("help", "help message")
+        ("channels", po::value<size_t>()->default_value(2), "Number of channels")
+        ("spp", po::value<size_t>()->default_value(364), "Samples per packet")
+        ("packets", po::value<size_t>()->default_value(20000), "Packets per channel")
+        ("format", po::value<std::string>()->default_value("fc32"), "CPU format")
+        ("drop", po::value<double>()->default_value(1e-3), "Probability of dropping a packet")
+        ("drop-burst", po::value<size_t>()->default_value(1), "Packets dropped in a row")
+        ("reorder", po::value<double>()->default_value(0.0), "Probability of swapping a packet with the next one")
+        ("dup", po::value<double>()->default_value(0.0), "Probability of duplicating a packet")
+        ("delay", po::value<double>()->default_value(0.0), "Probability of stalling before a packet")
+        ("delay-time", po::value<double>()->default_value(0.001), "Duration of a stall in seconds")
+        ("seed", po::value<uint32_t>()->default_value(1), "Seed of the random faults")
+    ;
+    // clang-format on
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help")) {
+        std::cout << boost::format("UHD Fault Recovery Benchmark %s") % desc << std::endl;
+        std::cout
+            << "    Injects faults into mock transports and measures how fast the\n"
+               "    receive packet handler gets back to aligned samples.\n"
+            << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    uhd::device_addr_t fault_args;
+    fault_args["recv_fault_drop"]       = std::to_string(vm["drop"].as<double>());
+    fault_args["recv_fault_drop_burst"] = std::to_string(vm["drop-burst"].as<size_t>());
+    fault_args["recv_fault_reorder"]    = std::to_string(vm["reorder"].as<double>());
+    fault_args["recv_fault_dup"]        = std::to_string(vm["dup"].as<double>());
+    fault_args["recv_fault_delay"]      = std::to_string(vm["delay"].as<double>());
+    fault_args["recv_fault_delay_time"] = std::to_string(vm["delay-time"].as<double>());
+    fault_args["recv_fault_seed"]       = std::to_string(vm["seed"].as<uint32_t>());
+
+    const size_t num_chans = vm["channels"].as<size_t>();
+    std::vector<zero_copy_fault_inject::stats_t> fault_stats;
+    const recovery_result_t r = benchmark_recovery(num_chans,
+        vm["spp"].as<size_t>(),
+        vm["packets"].as<size_t>(),
+        vm["format"].as<std::string>(),
+        fault_args,
+        fault_stats);
+
+    std::cout << "Injected faults per channel (dropped/reordered/duplicated/delayed):\n";
+    for (size_t chan = 0; chan < num_chans; chan++) {
+        const auto& s = fault_stats[chan];
+        std::cout << boost::format("  %u: %u/%u/%u/%u\n") % chan % s.dropped
+                         % s.reordered % s.duplicated % s.delayed;
+    }
+    const size_t n = std::max<size_t>(r.num_recoveries, 1);
+    std::cout << boost::format("Samples per channel:   %u in %.3f s (%.3f Msps)\n")
+                     % r.num_samps % r.elapsed_time
+                     % (r.num_samps / r.elapsed_time / 1e6)
+              << boost::format("Errors returned:       %u\n") % r.num_errors
+              << boost::format("Recoveries:            %u\n") % r.num_recoveries
+              << boost::format("Recovery time:         %.3f us mean, %.3f us max\n")
+                     % (r.total_recovery_us / n) % r.max_recovery_us
+              << boost::format("Samples lost:          %u total, %.1f mean, %u max\n")
+                     % r.total_lost_samps % (double(r.total_lost_samps) / n)
+                     % r.max_lost_samps
+              << boost::format("Samples repeated:      %u\n") % r.repeated_samps;
+    return EXIT_SUCCESS;
+}
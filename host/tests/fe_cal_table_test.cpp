@@ -0,0 +1,49 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhdlib/usrp/common/fe_cal_table.hpp>
+#include <boost/test/unit_test.hpp>
+
+using uhd::usrp::fe_cal_table;
+
+namespace {
+
+// Out of order on purpose, the table sorts its points
+std::vector<fe_cal_table::point_t> make_points()
+{
+    return {{3e9, {0.3, -0.3}},
+        {1e9, {0.1, -0.1}},
+        {2e9, {0.2, -0.2}},
+        {4e9, {0.5, -0.5}}};
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_fe_cal_table_points)
+{
+    fe_cal_table table(make_points());
+    BOOST_CHECK_EQUAL(table.size(), 4);
+    BOOST_CHECK_EQUAL(table.get(3e9), std::complex<double>(0.3, -0.3));
+    // Within the epsilon counts as the same point
+    BOOST_CHECK_EQUAL(table.get(3e9 + 0.05), std::complex<double>(0.3, -0.3));
+    BOOST_CHECK_EQUAL(table.get(2e9 - 0.05), std::complex<double>(0.2, -0.2));
+    // Outside of the range, the closest end is used
+    BOOST_CHECK_EQUAL(table.get(1e8), std::complex<double>(0.1, -0.1));
+    BOOST_CHECK_EQUAL(table.get(6e9), std::complex<double>(0.5, -0.5));
+}
+
+BOOST_AUTO_TEST_CASE(test_fe_cal_table_interp)
+{
+    fe_cal_table table(make_points());
+    const std::complex<double> corr = table.get(3.5e9);
+    BOOST_CHECK_CLOSE(corr.real(), 0.4, 1e-9);
+    BOOST_CHECK_CLOSE(corr.imag(), -0.4, 1e-9);
+    // Cached results are the same
+    BOOST_CHECK_EQUAL(table.get(3.5e9), corr);
+    BOOST_CHECK_CLOSE(table.get(2.25e9).real(), 0.225, 1e-9);
+    // Below the second point, the first point is used without interpolation
+    BOOST_CHECK_EQUAL(table.get(1.5e9), std::complex<double>(0.1, -0.1));
+}
@@ -0,0 +1,138 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/utils/file_player.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <fstream>
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+//! Write \p num_items counting items into each of \p num_files files
+std::vector<std::string> make_files(const size_t num_files, const size_t num_items)
+{
+    std::vector<std::string> files;
+    for (size_t f = 0; f < num_files; f++) {
+        files.push_back(
+            (fs::temp_directory_path() / fs::unique_path("uhd-player-%%%%-%%%%.dat"))
+                .string());
+        std::vector<uint32_t> items(num_items);
+        for (size_t i = 0; i < num_items; i++) {
+            items[i] = uint32_t(i * num_files + f);
+        }
+        std::ofstream out(files.back().c_str(), std::ios::binary);
+        out.write(reinterpret_cast<const char*>(items.data()),
+            items.size() * sizeof(uint32_t));
+    }
+    return files;
+}
+
+void remove_files(const std::vector<std::string>& files)
+{
+    for (const std::string& file : files) {
+        fs::remove(file);
+    }
+}
+
+/*! Play back \p num_items items (or until done) in chunks of up to \p spb
+ *  items and check them. Return the number of items played back.
+ */
+size_t play(uhd::file_player::sptr player,
+    const size_t num_files,
+    const size_t file_items,
+    const size_t num_items,
+    const size_t spb)
+{
+    std::vector<const void*> buffs;
+    size_t num_played = 0;
+    while (num_played < num_items and not player->is_done()) {
+        const size_t num_bytes = player->get_buffs(buffs, 1.0);
+        if (player->is_done()) {
+            break;
+        }
+        BOOST_REQUIRE(num_bytes > 0);
+        BOOST_REQUIRE_EQUAL(num_bytes % sizeof(uint32_t), 0);
+        BOOST_REQUIRE_EQUAL(buffs.size(), num_files);
+        const size_t n = std::min(
+            std::min(spb, num_bytes / sizeof(uint32_t)), num_items - num_played);
+        for (size_t f = 0; f < num_files; f++) {
+            const uint32_t* items = static_cast<const uint32_t*>(buffs[f]);
+            for (size_t i = 0; i < n; i++) {
+                const size_t index = (num_played + i) % file_items;
+                if (items[i] != uint32_t(index * num_files + f)) {
+                    BOOST_FAIL("Wrong item " << num_played + i << " in file " << f);
+                }
+            }
+        }
+        player->consume(n * sizeof(uint32_t));
+        num_played += n;
+    }
+    return num_played;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_file_player_modes)
+{
+    const std::vector<std::string> files = make_files(2, 100000);
+    for (const std::string args : {"mode=mmap,block_size=4000",
+             "mode=mmap,block_size=4000,readahead=10000,lock",
+             "mode=read,block_size=4000,num_blocks=4",
+             "mode=read,block_size=4000,num_blocks=200"}) {
+        BOOST_TEST_MESSAGE("Testing " << args);
+        auto player = uhd::file_player::make(files, sizeof(uint32_t), args);
+        BOOST_CHECK_EQUAL(player->get_size(), 100000 * sizeof(uint32_t));
+        BOOST_CHECK_EQUAL(play(player, files.size(), 100000, 200000, 777), 100000);
+        BOOST_CHECK(player->is_done());
+        BOOST_CHECK_EQUAL(
+            player->get_stats().bytes_played, 2 * 100000 * sizeof(uint32_t));
+        BOOST_CHECK_EQUAL(player->get_stats().num_loops, 0);
+    }
+    remove_files(files);
+}
+
+BOOST_AUTO_TEST_CASE(test_file_player_loop)
+{
+    const std::vector<std::string> files = make_files(1, 10000);
+    for (const std::string args : {"mode=mmap,loop,block_size=4096,readahead=8192",
+             "mode=read,loop,block_size=4096,num_blocks=2",
+             "mode=read,loop"}) {
+        BOOST_TEST_MESSAGE("Testing " << args);
+        auto player = uhd::file_player::make(files, sizeof(uint32_t), args);
+        BOOST_CHECK_EQUAL(play(player, files.size(), 10000, 35000, 1000), 35000);
+        BOOST_CHECK(not player->is_done());
+        BOOST_CHECK_EQUAL(player->get_stats().num_loops, 3);
+    }
+    remove_files(files);
+}
+
+BOOST_AUTO_TEST_CASE(test_file_player_sizes)
+{
+    // A partial item at the end is dropped, the shortest file wins
+    std::vector<std::string> files = make_files(1, 1000);
+    const std::vector<std::string> short_file = make_files(1, 500);
+    std::ofstream(files[0].c_str(), std::ios::binary | std::ios::app) << "xx";
+    files.push_back(short_file[0]);
+    auto player = uhd::file_player::make(files, sizeof(uint32_t));
+    BOOST_CHECK_EQUAL(player->get_size(), 500 * sizeof(uint32_t));
+    player.reset();
+    remove_files(files);
+}
+
+BOOST_AUTO_TEST_CASE(test_file_player_errors)
+{
+    BOOST_CHECK_THROW(uhd::file_player::make({}, 4), uhd::value_error);
+    BOOST_CHECK_THROW(
+        uhd::file_player::make({"/nonexistent-dir/file.dat"}, 4), uhd::os_error);
+    const std::vector<std::string> files = make_files(1, 10);
+    BOOST_CHECK_THROW(uhd::file_player::make(files, 4, uhd::device_addr_t("mode=foo")),
+        uhd::value_error);
+    remove_files(files);
+}
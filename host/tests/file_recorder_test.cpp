@@ -0,0 +1,186 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/convert.hpp>
+#include <uhd/exception.hpp>
+#include <uhd/utils/file_recorder.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <complex>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+std::vector<std::string> make_temp_files(const size_t num_files)
+{
+    std::vector<std::string> files;
+    for (size_t i = 0; i < num_files; i++) {
+        files.push_back(
+            (fs::temp_directory_path() / fs::unique_path("uhd-recorder-%%%%-%%%%.dat"))
+                .string());
+    }
+    return files;
+}
+
+std::vector<uint32_t> read_file(const std::string& file)
+{
+    std::ifstream in(file.c_str(), std::ios::binary);
+    const std::vector<char> bytes(
+        (std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    std::vector<uint32_t> items(bytes.size() / sizeof(uint32_t));
+    std::memcpy(items.data(), bytes.data(), items.size() * sizeof(uint32_t));
+    BOOST_CHECK_EQUAL(bytes.size() % sizeof(uint32_t), 0);
+    return items;
+}
+
+//! Record \p num_items counting items per file, in chunks of up to \p spb items
+void record(const std::vector<std::string>& files,
+    const std::string& args,
+    const size_t num_items,
+    const size_t spb)
+{
+    auto recorder = uhd::file_recorder::make(files, sizeof(uint32_t), args);
+    std::vector<void*> buffs;
+    size_t num_recorded = 0;
+    while (num_recorded < num_items) {
+        const size_t num_bytes = recorder->get_buffs(buffs, 1.0);
+        BOOST_REQUIRE(num_bytes > 0);
+        BOOST_REQUIRE_EQUAL(num_bytes % sizeof(uint32_t), 0);
+        BOOST_REQUIRE_EQUAL(buffs.size(), files.size());
+        const size_t n = std::min(
+            std::min(spb, num_bytes / sizeof(uint32_t)), num_items - num_recorded);
+        for (size_t f = 0; f < files.size(); f++) {
+            uint32_t* items = static_cast<uint32_t*>(buffs[f]);
+            for (size_t i = 0; i < n; i++) {
+                items[i] = uint32_t((num_recorded + i) * files.size() + f);
+            }
+        }
+        recorder->commit(n * sizeof(uint32_t));
+        num_recorded += n;
+    }
+    recorder->close();
+    const uhd::file_recorder::stats_t stats = recorder->get_stats();
+    BOOST_CHECK_EQUAL(stats.bytes_written, num_items * sizeof(uint32_t) * files.size());
+}
+
+void check_files(const std::vector<std::string>& files, const size_t num_items)
+{
+    for (size_t f = 0; f < files.size(); f++) {
+        const std::vector<uint32_t> items = read_file(files[f]);
+        BOOST_REQUIRE_EQUAL(items.size(), num_items);
+        for (size_t i = 0; i < num_items; i++) {
+            if (items[i] != uint32_t(i * files.size() + f)) {
+                BOOST_FAIL("Wrong item " << i << " in file " << f);
+            }
+        }
+        fs::remove(files[f]);
+    }
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_file_recorder_single_file)
+{
+    const std::vector<std::string> files = make_temp_files(1);
+    // A partial last block, and chunks that don't divide the block size
+    record(files, "block_size=4096,num_blocks=4", 10000, 333);
+    check_files(files, 10000);
+}
+
+BOOST_AUTO_TEST_CASE(test_file_recorder_multi_file)
+{
+    const std::vector<std::string> files = make_temp_files(3);
+    record(files, "block_size=8192,num_blocks=2", 50000, 1000);
+    check_files(files, 50000);
+}
+
+BOOST_AUTO_TEST_CASE(test_file_recorder_options)
+{
+    // Unsupported options must fall back to something that works
+    const std::vector<std::string> files = make_temp_files(2);
+    record(files,
+        "block_size=10000,num_blocks=8,direct_io,io_uring,preallocate=1000000",
+        12345,
+        4000);
+    check_files(files, 12345);
+}
+
+BOOST_AUTO_TEST_CASE(test_file_recorder_compress)
+{
+    // The counting items are sc16 samples with a slowly changing I and Q, so
+    // the recording must be smaller than the samples
+    const std::vector<std::string> files = make_temp_files(1);
+    const size_t num_items               = 10000;
+    auto recorder                        = uhd::file_recorder::make(
+        files, sizeof(uint32_t), uhd::device_addr_t("block_size=4096,compress"));
+    std::vector<void*> buffs;
+    for (size_t num_recorded = 0; num_recorded < num_items;) {
+        const size_t num_bytes = recorder->get_buffs(buffs, 1.0);
+        const size_t n = std::min(num_bytes / sizeof(uint32_t), num_items - num_recorded);
+        uint32_t* items = static_cast<uint32_t*>(buffs[0]);
+        for (size_t i = 0; i < n; i++) {
+            items[i] = uint32_t(num_recorded + i);
+        }
+        recorder->commit(n * sizeof(uint32_t));
+        num_recorded += n;
+    }
+    recorder->close();
+    const uint64_t bytes_written = recorder->get_stats().bytes_written;
+    BOOST_CHECK_LT(bytes_written, num_items * sizeof(uint32_t) / 2);
+
+    // Decode the blocks one after the other
+    std::ifstream in(files[0].c_str(), std::ios::binary);
+    const std::vector<char> bytes(
+        (std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    BOOST_REQUIRE_EQUAL(bytes.size(), bytes_written);
+    uhd::convert::id_type id;
+    id.input_format  = "sc16_compressed";
+    id.num_inputs    = 1;
+    id.output_format = "sc16";
+    id.num_outputs   = 1;
+    auto decompressor = uhd::convert::get_converter(id)();
+    std::vector<uint32_t> items;
+    for (size_t offset = 0; offset < bytes.size();) {
+        const char* block      = &bytes[offset];
+        const size_t num_samps = uhd::convert::get_compressed_num_samps(block);
+        items.resize(items.size() + num_samps);
+        const void* in_buff = block;
+        void* out_buff      = &items[items.size() - num_samps];
+        decompressor->conv(in_buff, out_buff, num_samps);
+        offset += uhd::convert::get_compressed_size(block);
+    }
+    BOOST_REQUIRE_EQUAL(items.size(), num_items);
+    for (size_t i = 0; i < num_items; i++) {
+        BOOST_REQUIRE_EQUAL(items[i], uint32_t(i));
+    }
+    fs::remove(files[0]);
+
+    BOOST_CHECK_THROW(uhd::file_recorder::make(files, 8, uhd::device_addr_t("compress")),
+        uhd::value_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_file_recorder_block_size)
+{
+    const std::vector<std::string> files = make_temp_files(1);
+    // Rounded up to whole items and the direct I/O alignment
+    auto recorder =
+        uhd::file_recorder::make(files, 12, uhd::device_addr_t("block_size=5000"));
+    BOOST_CHECK_EQUAL(recorder->get_block_size(), 12288);
+    recorder->close();
+    fs::remove(files[0]);
+}
+
+BOOST_AUTO_TEST_CASE(test_file_recorder_errors)
+{
+    BOOST_CHECK_THROW(uhd::file_recorder::make({}, 4), uhd::value_error);
+    BOOST_CHECK_THROW(
+        uhd::file_recorder::make({"/nonexistent-dir/file.dat"}, 4), uhd::os_error);
+}
@@ -119,3 +119,29 @@ BOOST_AUTO_TEST_CASE(test_gain_group_priority)
     // test the the higher priority gain got filled first (gain 2)
     BOOST_CHECK_CLOSE(g2.get_value(), g2.get_range().stop(), tolerance);
 }
+
+BOOST_AUTO_TEST_CASE(test_gain_group_range_change)
+{
+    gain_group::sptr gg = get_gain_group(1, 0);
+    gg->set_value(50);
+    BOOST_CHECK_CLOSE(g1.get_value(), 50.0, tolerance);
+
+    // A new element with a range that changes between calls
+    double max_gain = 10;
+    double gain3    = 0;
+    gain_fcns_t gain_fcns;
+    gain_fcns.get_range = [&max_gain]() { return gain_range_t(0, max_gain, 1); };
+    gain_fcns.get_value = [&gain3]() { return gain3; };
+    gain_fcns.set_value = [&gain3](const double gain) { gain3 = gain; };
+    gg->register_fcns("g3", gain_fcns, 2);
+
+    gg->set_value(50);
+    BOOST_CHECK_CLOSE(gain3, 10.0, tolerance);
+    BOOST_CHECK_CLOSE(g1.get_value(), 40.0, tolerance);
+
+    max_gain = 20;
+    gg->set_value(50);
+    BOOST_CHECK_CLOSE(gain3, 20.0, tolerance);
+    BOOST_CHECK_CLOSE(g1.get_value(), 30.0, tolerance);
+    BOOST_CHECK_CLOSE(gg->get_value(), 50.0, tolerance);
+}
@@ -0,0 +1,126 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhdlib/usrp/cores/gpio_atr_3000.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/test/unit_test.hpp>
+#include <map>
+
+using namespace uhd;
+using namespace uhd::usrp::gpio_atr;
+
+namespace {
+
+constexpr wb_iface::wb_addr_type GPIO_BASE = 0x100;
+constexpr wb_iface::wb_addr_type IDLE_REG  = GPIO_BASE + 0;
+
+//! Keeps the register values, and the schedules it gets
+class mock_timed_wb_iface : public timed_wb_iface
+{
+public:
+    mock_timed_wb_iface(const size_t fifo_size) : fifo_size(fifo_size) {}
+
+    void poke32(const wb_addr_type addr, const uint32_t data)
+    {
+        regs[addr] = data;
+    }
+
+    uint32_t peek32(const wb_addr_type addr)
+    {
+        return regs[addr];
+    }
+
+    uint64_t peek64(const wb_addr_type addr)
+    {
+        return regs[addr];
+    }
+
+    time_spec_t get_time(void)
+    {
+        return _time;
+    }
+
+    void set_time(const time_spec_t& t)
+    {
+        _time = t;
+    }
+
+    void poke32_schedule(const std::vector<timed_poke32_t>& writes)
+    {
+        schedules.push_back(writes);
+        for (const auto& write : writes) {
+            regs[write.addr] = write.data;
+        }
+    }
+
+    size_t get_cmd_fifo_size(void)
+    {
+        return fifo_size;
+    }
+
+    const size_t fifo_size;
+    std::map<wb_addr_type, uint32_t> regs;
+    std::vector<std::vector<timed_poke32_t>> schedules;
+
+private:
+    time_spec_t _time;
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_gpio_out_sequence)
+{
+    auto iface = boost::make_shared<mock_timed_wb_iface>(8);
+    auto gpio  = gpio_atr_3000::make_write_only(iface, GPIO_BASE);
+    // The upper half is driven by the ATR engine, its idle state is 0xAB00
+    gpio->set_atr_mode(MODE_GPIO, 0x00FF);
+    gpio->set_atr_reg(ATR_REG_IDLE, 0xAB00, 0xFF00);
+    BOOST_CHECK_EQUAL(gpio->get_max_sequence_len(), 8);
+
+    gpio->set_gpio_out_sequence({{time_spec_t(1.0), 0x000F, 0x0005},
+        {time_spec_t(1.5), 0x00F0, 0x00A0},
+        {time_spec_t(2.0), 0x000F, 0x0000}});
+
+    BOOST_REQUIRE_EQUAL(iface->schedules.size(), 1);
+    const auto& writes = iface->schedules.front();
+    BOOST_REQUIRE_EQUAL(writes.size(), 3);
+    const uint32_t expected[] = {0xAB05, 0xABA5, 0xABA0};
+    const double times[]      = {1.0, 1.5, 2.0};
+    for (size_t i = 0; i < 3; i++) {
+        BOOST_CHECK_EQUAL(writes[i].addr, IDLE_REG);
+        BOOST_CHECK_EQUAL(writes[i].data, expected[i]);
+        BOOST_CHECK_EQUAL(writes[i].time.get_real_secs(), times[i]);
+    }
+
+    // The soft copy follows the last entry, so it's not written again
+    gpio->set_gpio_out(0x00A0, 0x00F0);
+    BOOST_CHECK_EQUAL(iface->regs[IDLE_REG], 0xABA0);
+    gpio->set_gpio_out(0x0001, 0x000F);
+    BOOST_CHECK_EQUAL(iface->regs[IDLE_REG], 0xABA1);
+}
+
+BOOST_AUTO_TEST_CASE(test_gpio_out_sequence_errors)
+{
+    auto iface = boost::make_shared<mock_timed_wb_iface>(2);
+    auto gpio  = gpio_atr_3000::make_write_only(iface, GPIO_BASE);
+    gpio->set_atr_mode(MODE_GPIO, 0xFFFF);
+
+    // Longer than the command FIFO
+    BOOST_CHECK_THROW(gpio->set_gpio_out_sequence({{time_spec_t(1.0), 0x1, 0x1},
+                          {time_spec_t(2.0), 0x1, 0x0},
+                          {time_spec_t(3.0), 0x1, 0x1}}),
+        uhd::value_error);
+    // Not sorted
+    BOOST_CHECK_THROW(gpio->set_gpio_out_sequence({{time_spec_t(2.0), 0x1, 0x1},
+                          {time_spec_t(1.0), 0x1, 0x0}}),
+        uhd::value_error);
+    BOOST_CHECK(iface->schedules.empty());
+
+    // Nothing was applied to the soft copy either
+    gpio->set_gpio_out(0x2, 0x2);
+    BOOST_CHECK_EQUAL(iface->regs[IDLE_REG], 0x2);
+}
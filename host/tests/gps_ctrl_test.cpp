@@ -0,0 +1,94 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/usrp/gps_ctrl.hpp>
+#include <boost/format.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+//! A UART with a GPS at the other end, which sends the lines it is given
+class mock_gps_uart : public uhd::uart_iface
+{
+public:
+    void write_uart(const std::string&) {}
+
+    std::string read_uart(double timeout)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (not _lines.empty()) {
+                const std::string line = _lines.front();
+                _lines.pop_front();
+                return line;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(int64_t(timeout * 1e6)));
+        return "";
+    }
+
+    //! Queue an NMEA sentence, adding the checksum
+    void send_nmea(const std::string& body)
+    {
+        uint8_t crc = 0;
+        for (const char c : body) {
+            crc ^= uint8_t(c);
+        }
+        send_line(str(boost::format("$%s*%02X\r\n") % body % int(crc)));
+    }
+
+    void send_line(const std::string& line)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _lines.push_back(line);
+    }
+
+private:
+    std::mutex _mutex;
+    std::deque<std::string> _lines;
+};
+
+const std::string GPGGA = "GPGGA,120000.00,4807.038,N,01131.000,E,1,08,0.9,545.4,M,,";
+const std::string GPRMC =
+    "GPRMC,120000.00,A,4807.038,N,01131.000,E,022.4,084.4,010219,003.1,";
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_gps_ctrl_nmea)
+{
+    auto uart = boost::make_shared<mock_gps_uart>();
+    // Detected as a generic NMEA GPS. Anything sent before the detection
+    // starts gets flushed.
+    std::thread detect_sender([uart]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        uart->send_nmea(GPGGA);
+    });
+    uhd::gps_ctrl::sptr gps = uhd::gps_ctrl::make(uart);
+    detect_sender.join();
+    BOOST_REQUIRE(gps->gps_detected());
+
+    uart->send_line("$GPGGA,garbage,*00\r\n");
+    uart->send_nmea(GPGGA);
+    uart->send_nmea(GPRMC);
+    BOOST_CHECK_EQUAL(gps->get_sensor("gps_gpgga").value, "$" + GPGGA + "*3F");
+    BOOST_CHECK(gps->get_sensor("gps_locked").to_bool());
+    BOOST_CHECK_THROW(gps->get_sensor("gps_servo"), uhd::value_error);
+
+    // gps_time waits for the next GPRMC sentence
+    std::thread sender([uart]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        uart->send_nmea(
+            "GPRMC,120001.00,A,4807.038,N,01131.000,E,022.4,084.4,010219,003.1,");
+    });
+    BOOST_CHECK_EQUAL(gps->get_sensor("gps_time").to_int(), 1549022401);
+    sender.join();
+}
@@ -159,3 +159,40 @@ BOOST_AUTO_TEST_CASE(test_mini_cycle_downstream_and_upstream)
     BOOST_REQUIRE_EQUAL(result.size(), 1);
     BOOST_REQUIRE(result[0] == node_A);
 }
+
+BOOST_AUTO_TEST_CASE(test_cached_search_follows_graph_changes)
+{
+    MAKE_NODE(node_A);
+    MAKE_NODE(node_B);
+    MAKE_RESULT_NODE(node_C0);
+    MAKE_RESULT_NODE(node_C1);
+
+    connect_nodes(node_A, node_B);
+    connect_nodes(node_B, node_C0);
+    std::vector<result_node::sptr> result = node_A->find_downstream_node<result_node>();
+    BOOST_REQUIRE_EQUAL(result.size(), 1);
+    BOOST_CHECK(result[0] == node_C0);
+    // Repeated searches return the same result
+    result = node_A->find_downstream_node<result_node>();
+    BOOST_REQUIRE_EQUAL(result.size(), 1);
+    BOOST_CHECK(result[0] == node_C0);
+
+    // A connection further down the graph shows up in the next search
+    connect_nodes(node_B, node_C1);
+    result = node_A->find_downstream_node<result_node>();
+    BOOST_CHECK_EQUAL(result.size(), 2);
+
+    // So does a disconnect
+    node_C0->disconnect();
+    result = node_A->find_downstream_node<result_node>();
+    BOOST_REQUIRE_EQUAL(result.size(), 1);
+    BOOST_CHECK(result[0] == node_C1);
+
+    // Searches for other types aren't affected by the cached result
+    BOOST_CHECK_EQUAL(node_A->find_downstream_node<test_node>().size(), 1);
+
+    // Nodes that went away since are not returned
+    result.clear();
+    node_C1.reset();
+    BOOST_CHECK(node_A->find_downstream_node<result_node>().empty());
+}
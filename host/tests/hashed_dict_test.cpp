@@ -0,0 +1,135 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhdlib/utils/hashed_dict.hpp>
+#include <boost/test/unit_test.hpp>
+#include <string>
+#include <utility>
+
+BOOST_AUTO_TEST_CASE(test_hashed_dict_init)
+{
+    uhd::hashed_dict<int, int> d;
+    d[-1] = 3;
+    d[0]  = 4;
+    d[1]  = 5;
+    BOOST_CHECK_EQUAL(d.size(), 3);
+    BOOST_CHECK(d.has_key(0));
+    BOOST_CHECK(not d.has_key(2));
+    BOOST_CHECK(d.keys()[1] == 0);
+    BOOST_CHECK(d.vals()[1] == 4);
+    BOOST_CHECK_EQUAL(d[-1], 3);
+    BOOST_CHECK_EQUAL(d.get(2, 7), 7);
+}
+
+BOOST_AUTO_TEST_CASE(test_const_hashed_dict)
+{
+    uhd::hashed_dict<int, int> tmp;
+    tmp[-1]                             = 3;
+    tmp[0]                              = 4;
+    const uhd::hashed_dict<int, int> d = tmp;
+    BOOST_CHECK_EQUAL(d[0], 4);
+    BOOST_CHECK_THROW(d[2], uhd::key_error);
+    BOOST_CHECK_THROW(d.get(2), uhd::key_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_hashed_dict_order)
+{
+    // Keys keep their insertion order, like in uhd::dict
+    uhd::hashed_dict<std::string, size_t> d;
+    for (size_t i = 0; i < 1000; i++) {
+        d[std::to_string(999 - i)] = i;
+    }
+    d["500"] = 42;
+    const std::vector<std::string> keys = d.keys();
+    BOOST_REQUIRE_EQUAL(keys.size(), 1000);
+    for (size_t i = 0; i < 1000; i++) {
+        BOOST_CHECK_EQUAL(keys[i], std::to_string(999 - i));
+    }
+    BOOST_CHECK_EQUAL(d.vals()[499], 42);
+}
+
+BOOST_AUTO_TEST_CASE(test_hashed_dict_pop)
+{
+    uhd::hashed_dict<int, int> d;
+    d[-1] = 3;
+    d[0]  = 4;
+    d[1]  = 5;
+    BOOST_CHECK_EQUAL(d.pop(0), 4);
+    BOOST_CHECK(not d.has_key(0));
+    BOOST_CHECK(d.keys()[0] == -1);
+    BOOST_CHECK(d.keys()[1] == 1);
+    BOOST_CHECK_THROW(d.pop(0), uhd::key_error);
+    // A popped key goes to the end when it is added again
+    d[0] = 6;
+    BOOST_CHECK(d.keys()[2] == 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_hashed_dict_update)
+{
+    typedef uhd::hashed_dict<std::string, std::string> dict_ss;
+    dict_ss d1;
+    d1["key1"] = "val1";
+    d1["key2"] = "val2";
+    dict_ss d2;
+    d2["key2"] = "val2x";
+    d2["key3"] = "val3";
+    const dict_ss d3 = d1;
+
+    d1.update(d2, false /* don't throw cause of conflict */);
+    BOOST_CHECK_EQUAL(d1["key1"], "val1");
+    BOOST_CHECK_EQUAL(d1["key2"], "val2x");
+    BOOST_CHECK_EQUAL(d1["key3"], "val3");
+
+    dict_ss d4 = d3;
+    BOOST_CHECK_THROW(d4.update(d2), uhd::value_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_hashed_dict_copy)
+{
+    typedef uhd::hashed_dict<std::string, int> dict_si;
+    dict_si d0;
+    d0["a"] = 1;
+    d0["b"] = 2;
+
+    // Copies have their own index
+    dict_si d1 = d0;
+    d1["a"]    = 3;
+    BOOST_CHECK_EQUAL(d0["a"], 1);
+    BOOST_CHECK_EQUAL(d1["a"], 3);
+    d1 = d0;
+    BOOST_CHECK(d0 == d1);
+    d0.pop("b");
+    BOOST_CHECK(d1.has_key("b"));
+
+    dict_si d2 = std::move(d1);
+    BOOST_CHECK_EQUAL(d2["b"], 2);
+    d2["c"] = 4;
+    BOOST_CHECK_EQUAL(d2.keys()[2], "c");
+}
+
+BOOST_AUTO_TEST_CASE(test_hashed_dict_equals)
+{
+    typedef uhd::hashed_dict<std::string, std::string> dict_ss;
+    dict_ss d0;
+    d0["key1"] = "val1";
+    d0["key2"] = "val2";
+    // Same keys and vals, different order
+    dict_ss d1;
+    d1["key2"] = "val2";
+    d1["key1"] = "val1";
+    // Same keys, different vals
+    dict_ss d2;
+    d2["key1"] = "val1";
+    d2["key2"] = "val3";
+    // Subset of d0
+    dict_ss d3;
+    d3["key1"] = "val1";
+
+    BOOST_CHECK(d0 == d1);
+    BOOST_CHECK(d1 == d0);
+    BOOST_CHECK(d0 != d2);
+    BOOST_CHECK(d0 != d3);
+}
@@ -0,0 +1,103 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhdlib/usrp/common/host_resampler.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+
+using namespace uhd;
+using namespace uhd::usrp;
+
+namespace {
+
+constexpr double INPUT_RATE = 1e6;
+constexpr double TONE_FREQ  = 10e3;
+
+typedef std::pair<size_t, size_t> ratio_t;
+
+//! Streams a complex tone with time specs, in packets of 100 samples
+class mock_rx_streamer : public uhd::rx_streamer
+{
+public:
+    size_t get_num_channels(void) const
+    {
+        return 1;
+    }
+
+    size_t get_max_num_samps(void) const
+    {
+        return 100;
+    }
+
+    size_t recv(const buffs_type& buffs,
+        const size_t nsamps_per_buff,
+        rx_metadata_t& metadata,
+        const double,
+        const bool)
+    {
+        metadata.reset();
+        metadata.has_time_spec = true;
+        metadata.time_spec     = time_spec_t::from_ticks(_num_sent, INPUT_RATE);
+        const size_t nsamps    = std::min<size_t>(nsamps_per_buff, 100);
+        auto* out              = reinterpret_cast<std::complex<int16_t>*>(buffs[0]);
+        for (size_t i = 0; i < nsamps; i++) {
+            const double phase = 2 * M_PI * TONE_FREQ * (_num_sent + i) / INPUT_RATE;
+            out[i]             = std::complex<int16_t>(
+                int16_t(16000 * std::cos(phase)), int16_t(16000 * std::sin(phase)));
+        }
+        _num_sent += nsamps;
+        return nsamps;
+    }
+
+    void issue_stream_cmd(const stream_cmd_t&) {}
+
+private:
+    size_t _num_sent = 0;
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_approximate_ratio)
+{
+    BOOST_CHECK(polyphase_resampler::approximate_ratio(0.04, 1024) == ratio_t(1, 25));
+    BOOST_CHECK(
+        polyphase_resampler::approximate_ratio(44.1 / 48, 1024) == ratio_t(147, 160));
+    BOOST_CHECK(polyphase_resampler::approximate_ratio(1.5, 1024) == ratio_t(3, 2));
+    // Irrational ratios are approximated within the limit
+    const auto ratio = polyphase_resampler::approximate_ratio(std::sqrt(2.0), 100);
+    BOOST_CHECK(ratio.first <= 100 and ratio.second <= 100);
+    BOOST_CHECK_CLOSE(double(ratio.first) / ratio.second, std::sqrt(2.0), 0.01);
+    BOOST_CHECK_THROW(polyphase_resampler::approximate_ratio(0, 1024), uhd::value_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_resampling_rx_streamer)
+{
+    const double output_rate = INPUT_RATE * 3 / 4;
+    auto streamer            = make_resampling_rx_streamer(
+        boost::make_shared<mock_rx_streamer>(), INPUT_RATE, output_rate, 1 / 16000.f);
+    BOOST_CHECK_EQUAL(streamer->get_max_num_samps(), 75);
+
+    const size_t nsamps = 1000;
+    std::vector<std::complex<float>> buff(nsamps);
+    rx_metadata_t md;
+    BOOST_REQUIRE_EQUAL(streamer->recv(&buff.front(), nsamps, md, 0.1, false), nsamps);
+    BOOST_CHECK_EQUAL(md.error_code, rx_metadata_t::ERROR_CODE_NONE);
+    BOOST_REQUIRE(md.has_time_spec);
+
+    // Once the filter is settled, the output is the tone at the output
+    // rate, and the time spec includes the filter delay
+    const double t0 = md.time_spec.get_real_secs();
+    for (size_t i = 200; i < nsamps; i++) {
+        const double phase = 2 * M_PI * TONE_FREQ * (t0 + i / output_rate);
+        BOOST_CHECK_SMALL(std::abs(buff[i] - std::polar(1.0f, float(phase))), 2e-3f);
+    }
+
+    // The next call continues where this one stopped
+    BOOST_REQUIRE_EQUAL(streamer->recv(&buff.front(), 10, md, 0.1, false), 10);
+    BOOST_REQUIRE(md.has_time_spec);
+    BOOST_CHECK_CLOSE(md.time_spec.get_real_secs(), t0 + nsamps / output_rate, 1e-6);
+}
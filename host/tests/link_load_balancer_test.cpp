@@ -0,0 +1,68 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "common/mock_zero_copy.hpp"
+#include <uhdlib/usrp/common/link_load_balancer.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/test/unit_test.hpp>
+
+using uhd::usrp::link_load_balancer;
+
+namespace {
+
+uhd::transport::zero_copy_if::sptr make_xport()
+{
+    return boost::make_shared<mock_zero_copy>(
+        uhd::transport::vrt::if_packet_info_t::LINK_TYPE_CHDR);
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_link_load_balancer_equal_links)
+{
+    link_load_balancer loads;
+    BOOST_CHECK_EQUAL(loads.add_link(1.25e9), 0);
+    BOOST_CHECK_EQUAL(loads.add_link(1.25e9), 1);
+    BOOST_CHECK_THROW(loads.pick(uhd::RX_DIRECTION, {}), uhd::value_error);
+
+    // Ties go to the first candidate
+    BOOST_CHECK_EQUAL(loads.pick(uhd::RX_DIRECTION, {1, 0}), 1);
+    auto rx0 = make_xport();
+    loads.add_xport(0, uhd::RX_DIRECTION, rx0);
+    BOOST_CHECK_EQUAL(loads.get_num_xports(0, uhd::RX_DIRECTION), 1);
+    BOOST_CHECK_EQUAL(loads.pick(uhd::RX_DIRECTION, {0, 1}), 1);
+    // The directions are independent
+    BOOST_CHECK_EQUAL(loads.pick(uhd::TX_DIRECTION, {0, 1}), 0);
+
+    auto rx1 = make_xport();
+    loads.add_xport(1, uhd::RX_DIRECTION, rx1);
+    BOOST_CHECK_EQUAL(loads.pick(uhd::RX_DIRECTION, {0, 1}), 0);
+
+    // Destroying a transport frees its link
+    rx0.reset();
+    BOOST_CHECK_EQUAL(loads.get_num_xports(0, uhd::RX_DIRECTION), 0);
+    BOOST_CHECK_EQUAL(loads.pick(uhd::RX_DIRECTION, {1, 0}), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_link_load_balancer_mixed_links)
+{
+    link_load_balancer loads;
+    loads.add_link(125e6); // 1 GbE
+    loads.add_link(1.25e9); // 10 GbE
+
+    // The fast link takes about ten times as many transports
+    std::vector<uhd::transport::zero_copy_if::sptr> xports;
+    for (size_t i = 0; i < 9; i++) {
+        const size_t link = loads.pick(uhd::TX_DIRECTION, {0, 1});
+        BOOST_CHECK_EQUAL(link, 1);
+        xports.push_back(make_xport());
+        loads.add_xport(link, uhd::TX_DIRECTION, xports.back());
+    }
+    xports.push_back(make_xport());
+    loads.add_xport(1, uhd::TX_DIRECTION, xports.back());
+    BOOST_CHECK_EQUAL(loads.get_num_xports(1, uhd::TX_DIRECTION), 10);
+    BOOST_CHECK_EQUAL(loads.pick(uhd::TX_DIRECTION, {1, 0}), 0);
+}
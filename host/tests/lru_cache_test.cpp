@@ -0,0 +1,53 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhdlib/utils/lru_cache.hpp>
+#include <boost/test/unit_test.hpp>
+#include <string>
+#include <tuple>
+
+BOOST_AUTO_TEST_CASE(test_lru_cache)
+{
+    uhd::lru_cache<int, std::string> cache(2);
+    std::string value;
+    BOOST_CHECK(not cache.get(1, value));
+
+    cache.put(1, "one");
+    cache.put(2, "two");
+    BOOST_CHECK_EQUAL(cache.size(), 2);
+    BOOST_REQUIRE(cache.get(1, value));
+    BOOST_CHECK_EQUAL(value, "one");
+
+    // 2 is now the least recently used entry
+    cache.put(3, "three");
+    BOOST_CHECK_EQUAL(cache.size(), 2);
+    BOOST_CHECK(not cache.get(2, value));
+    BOOST_CHECK(cache.get(1, value));
+    BOOST_CHECK(cache.get(3, value));
+    BOOST_CHECK_EQUAL(value, "three");
+
+    // Replacing doesn't evict anything
+    cache.put(1, "uno");
+    BOOST_CHECK(cache.get(3, value));
+    BOOST_REQUIRE(cache.get(1, value));
+    BOOST_CHECK_EQUAL(value, "uno");
+
+    cache.clear();
+    BOOST_CHECK_EQUAL(cache.size(), 0);
+    BOOST_CHECK(not cache.get(1, value));
+}
+
+BOOST_AUTO_TEST_CASE(test_lru_cache_tuple_key)
+{
+    uhd::lru_cache<std::tuple<double, double, bool>, double> cache(16);
+    cache.put(std::make_tuple(10e6, 2.4e9, true), 2.4e9);
+    cache.put(std::make_tuple(10e6, 2.4e9, false), 2.4e9 + 1);
+
+    double value = 0;
+    BOOST_REQUIRE(cache.get(std::make_tuple(10e6, 2.4e9, false), value));
+    BOOST_CHECK_EQUAL(value, 2.4e9 + 1);
+    BOOST_CHECK(not cache.get(std::make_tuple(20e6, 2.4e9, false), value));
+}
@@ -0,0 +1,64 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/transport/zero_copy.hpp>
+#include <boost/test/unit_test.hpp>
+#include <utility>
+
+using namespace uhd::transport;
+
+namespace {
+
+class counting_mrb : public managed_recv_buffer
+{
+public:
+    void release(void)
+    {
+        num_releases++;
+    }
+
+    sptr get_new(void)
+    {
+        return make(this, _mem, sizeof(_mem));
+    }
+
+    size_t num_releases = 0;
+
+private:
+    char _mem[64];
+};
+
+void check_ref_counting(const bool single_threaded)
+{
+    counting_mrb mrb;
+    mrb.set_single_threaded(single_threaded);
+    for (size_t i = 1; i <= 2; i++) {
+        managed_recv_buffer::sptr buff = mrb.get_new();
+        BOOST_CHECK_EQUAL(mrb.ref_count(), 1);
+        {
+            managed_recv_buffer::sptr copy = buff;
+            BOOST_CHECK_EQUAL(mrb.ref_count(), 2);
+        }
+        managed_recv_buffer::sptr moved = std::move(buff);
+        BOOST_CHECK_EQUAL(mrb.ref_count(), 1);
+        BOOST_CHECK_EQUAL(mrb.num_releases, i - 1);
+        moved.reset();
+        BOOST_CHECK_EQUAL(mrb.ref_count(), 0);
+        BOOST_CHECK_EQUAL(mrb.num_releases, i);
+    }
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_managed_buffer_ref_count)
+{
+    check_ref_counting(false);
+}
+
+BOOST_AUTO_TEST_CASE(test_managed_buffer_single_threaded_ref_count)
+{
+    check_ref_counting(true);
+}
@@ -0,0 +1,121 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhdlib/transport/mpsc_bounded_buffer.hpp>
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <thread>
+#ifndef _WIN32
+#    include <poll.h>
+#endif
+
+using namespace uhd::transport;
+
+static const double timeout = 0.01 /*secs*/;
+
+BOOST_AUTO_TEST_CASE(test_mpsc_bounded_buffer_with_haste)
+{
+    mpsc_bounded_buffer<int> bb(2);
+    BOOST_CHECK_EQUAL(bb.capacity(), 2);
+
+    int val;
+    BOOST_CHECK(not bb.pop_with_haste(val));
+    BOOST_CHECK(not bb.pop_with_timed_wait(val, 0.0));
+    BOOST_CHECK(not bb.pop_with_timed_wait(val, timeout));
+    // wrap around the ring several times, a full buffer drops the new element
+    for (int i = 0; i < 10; i++) {
+        BOOST_CHECK(bb.push_with_haste(2 * i));
+        BOOST_CHECK(bb.push_with_haste(2 * i + 1));
+        BOOST_CHECK(not bb.push_with_haste(-1));
+        BOOST_CHECK(bb.pop_with_haste(val));
+        BOOST_CHECK_EQUAL(val, 2 * i);
+        BOOST_CHECK(bb.pop_with_timed_wait(val, timeout));
+        BOOST_CHECK_EQUAL(val, 2 * i + 1);
+        BOOST_CHECK(not bb.pop_with_haste(val));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_mpsc_bounded_buffer_releases_popped)
+{
+    mpsc_bounded_buffer<std::shared_ptr<int>> bb(4);
+
+    std::shared_ptr<int> elem = std::make_shared<int>(5);
+    BOOST_CHECK(bb.push_with_haste(elem));
+    BOOST_CHECK_EQUAL(elem.use_count(), 2);
+    std::shared_ptr<int> popped;
+    BOOST_CHECK(bb.pop_with_haste(popped));
+    BOOST_CHECK_EQUAL(*popped, 5);
+    popped.reset();
+    BOOST_CHECK_EQUAL(elem.use_count(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_mpsc_bounded_buffer_threaded)
+{
+    static const int num_producers = 4;
+    static const int num_elems     = 50000;
+    mpsc_bounded_buffer<int> bb(8);
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < num_producers; p++) {
+        producers.emplace_back([&bb, p]() {
+            for (int i = 0; i < num_elems; i++) {
+                while (not bb.push_with_haste(i * num_producers + p)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // Every producer's elements arrive complete and in order
+    std::vector<int> next(num_producers, 0);
+    bool in_order = true;
+    int val;
+    for (int i = 0; i < num_producers * num_elems; i++) {
+        while (not bb.pop_with_timed_wait(val, timeout)) {
+        }
+        const int p = val % num_producers;
+        in_order    = in_order and (val / num_producers == next[p]);
+        next[p]++;
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    BOOST_CHECK(in_order);
+    BOOST_CHECK(not bb.pop_with_haste(val));
+}
+
+#ifndef _WIN32
+BOOST_AUTO_TEST_CASE(test_mpsc_bounded_buffer_event_fd)
+{
+    BOOST_CHECK_EQUAL(mpsc_bounded_buffer<int>(4).get_event_fd(), -1);
+
+    mpsc_bounded_buffer<int> bb(4, true);
+    pollfd pfd = {bb.get_event_fd(), POLLIN, 0};
+    BOOST_REQUIRE(pfd.fd >= 0);
+    BOOST_CHECK_EQUAL(poll(&pfd, 1, 0), 0);
+
+    // Readable until the last element is popped
+    BOOST_CHECK(bb.push_with_haste(1));
+    BOOST_CHECK(bb.push_with_haste(2));
+    BOOST_CHECK_EQUAL(poll(&pfd, 1, 0), 1);
+    int val;
+    BOOST_CHECK(bb.pop_with_haste(val));
+    BOOST_CHECK_EQUAL(poll(&pfd, 1, 0), 1);
+    BOOST_CHECK(bb.pop_with_haste(val));
+    BOOST_CHECK_EQUAL(poll(&pfd, 1, 0), 0);
+
+    // A producer on another thread wakes up the event loop
+    std::thread producer([&bb]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        bb.push_with_haste(3);
+    });
+    BOOST_CHECK_EQUAL(poll(&pfd, 1, 1000), 1);
+    BOOST_CHECK(bb.pop_with_haste(val));
+    BOOST_CHECK_EQUAL(val, 3);
+    producer.join();
+    BOOST_CHECK_EQUAL(poll(&pfd, 1, 0), 0);
+}
+#endif
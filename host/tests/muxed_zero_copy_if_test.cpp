@@ -0,0 +1,74 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "common/mock_zero_copy.hpp"
+#include <uhd/transport/muxed_zero_copy_if.hpp>
+#include <uhd/types/sid.hpp>
+#include <uhd/utils/byteswap.hpp>
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+using namespace uhd::transport;
+
+namespace {
+
+uint32_t classify_by_dst(void* pkt, size_t)
+{
+    return uhd::sid_t(uhd::ntohx(static_cast<const uint32_t*>(pkt)[1])).get_dst();
+}
+
+void push_packet(mock_zero_copy::sptr xport, const uint32_t dst, const uint32_t marker)
+{
+    vrt::if_packet_info_t ifpi;
+    ifpi.packet_type         = vrt::if_packet_info_t::PACKET_TYPE_DATA;
+    ifpi.num_payload_words32 = 1;
+    ifpi.num_payload_bytes   = sizeof(uint32_t);
+    ifpi.packet_count        = 0;
+    ifpi.sid                 = dst;
+    ifpi.has_sid             = true;
+    ifpi.has_tsf             = false;
+    xport->push_back_recv_packet(ifpi, std::vector<uint32_t>(1, marker));
+}
+
+uint32_t get_marker(managed_recv_buffer::sptr buff)
+{
+    BOOST_REQUIRE(buff);
+    // No timestamp, so the payload follows the two header words
+    return buff->cast<const uint32_t*>()[2];
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_muxed_inline_demux)
+{
+    mock_zero_copy::sptr base(new mock_zero_copy(vrt::if_packet_info_t::LINK_TYPE_CHDR));
+    push_packet(base, 1, 0xA);
+    push_packet(base, 2, 0xB);
+    push_packet(base, 1, 0xC);
+    push_packet(base, 3, 0xD); // No such stream
+    push_packet(base, 2, 0xE);
+    push_packet(base, 2, 0xF); // Stream is gone by then
+    push_packet(base, 1, 0x10);
+
+    muxed_zero_copy_if::sptr muxed =
+        muxed_zero_copy_if::make(base, &classify_by_dst, 4, true /*inline_demux*/);
+    zero_copy_if::sptr stream1 = muxed->make_stream(1);
+    zero_copy_if::sptr stream2 = muxed->make_stream(2);
+
+    // Each call demuxes until it finds a frame of its own
+    BOOST_CHECK_EQUAL(get_marker(stream1->get_recv_buff(0.1)), 0xA);
+    BOOST_CHECK_EQUAL(get_marker(stream2->get_recv_buff(0.1)), 0xB);
+    BOOST_CHECK_EQUAL(get_marker(stream1->get_recv_buff(0.1)), 0xC);
+    BOOST_CHECK_EQUAL(get_marker(stream2->get_recv_buff(0.1)), 0xE);
+    BOOST_CHECK_EQUAL(muxed->get_num_dropped_frames(), 1);
+
+    stream2.reset();
+    BOOST_CHECK_EQUAL(get_marker(stream1->get_recv_buff(0.1)), 0x10);
+    BOOST_CHECK_EQUAL(muxed->get_num_dropped_frames(), 2);
+
+    // Nothing left
+    BOOST_CHECK(not stream1->get_recv_buff(0.0));
+}
@@ -117,6 +117,25 @@ BOOST_AUTO_TEST_CASE(test_add_funcs)
     BOOST_CHECK_EQUAL(e.get_int(), 7);
 }
 
+BOOST_AUTO_TEST_CASE(test_get_funcs)
+{
+    function_table::sptr ft = function_table::make();
+
+    function_table::function_ptr add_int = ft->get_function("ADD", two_int_args);
+    BOOST_REQUIRE(add_int);
+    expression_container::expr_list_type two_int_values{E(2), E(3)};
+    BOOST_CHECK_EQUAL(add_int(two_int_values).get_int(), 5);
+    BOOST_CHECK_THROW(ft->get_function("ADD", one_bool_arg), uhd::syntax_error);
+    BOOST_CHECK_THROW(ft->get_function("NO_SUCH_FUNC", no_args), uhd::syntax_error);
+
+    // A function expression keeps its lookup, and evaluates the same every time
+    expression_function::sptr add_expr = expression_function::make("ADD", ft);
+    add_expr->add(E(2));
+    add_expr->add(E(3));
+    BOOST_CHECK_EQUAL(add_expr->eval().get_int(), 5);
+    BOOST_CHECK_EQUAL(add_expr->eval().get_int(), 5);
+}
+
 int dummy_true_counter = 0;
 // Some bogus function to test the registry
 expression_literal dummy_true(expression_container::expr_list_type)
@@ -0,0 +1,69 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhdlib/usrp/common/otw_format_picker.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace uhd::usrp;
+
+namespace {
+
+const std::vector<std::string> OTW_FORMATS{"sc16", "sc12", "sc8"};
+constexpr size_t FRAME_SIZE  = 8000;
+constexpr size_t HEADER_SIZE = 16;
+// 10 GbE
+constexpr double LINK_RATE = 1.25e9;
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_otw_format_picker_widest_fit)
+{
+    // 2 x 122.88 Msps of sc16 need ~986 MB/s, which fits on 10 GbE
+    auto choice = pick_otw_format(
+        OTW_FORMATS, 122.88e6, 2, FRAME_SIZE, HEADER_SIZE, LINK_RATE);
+    BOOST_CHECK_EQUAL(choice.otw_format, "sc16");
+    BOOST_CHECK_EQUAL(choice.spp, (FRAME_SIZE - HEADER_SIZE) / 4);
+    BOOST_CHECK_CLOSE(
+        choice.bytes_per_sec, 2 * 122.88e6 * FRAME_SIZE / choice.spp, 1e-9);
+    BOOST_CHECK(choice.fits);
+
+    // 4 x 122.88 Msps only fit with sc8
+    choice = pick_otw_format(
+        OTW_FORMATS, 122.88e6, 4, FRAME_SIZE, HEADER_SIZE, LINK_RATE);
+    BOOST_CHECK_EQUAL(choice.otw_format, "sc8");
+    BOOST_CHECK(choice.fits);
+
+    // 3 x 122.88 Msps fit with sc12
+    choice = pick_otw_format(
+        OTW_FORMATS, 122.88e6, 3, FRAME_SIZE, HEADER_SIZE, LINK_RATE);
+    BOOST_CHECK_EQUAL(choice.otw_format, "sc12");
+    BOOST_CHECK_EQUAL(choice.spp, (FRAME_SIZE - HEADER_SIZE) / 3);
+    BOOST_CHECK(choice.fits);
+}
+
+BOOST_AUTO_TEST_CASE(test_otw_format_picker_no_fit)
+{
+    // Nothing fits, so the narrowest format is the best there is
+    auto choice =
+        pick_otw_format(OTW_FORMATS, 200e6, 4, FRAME_SIZE, HEADER_SIZE, LINK_RATE);
+    BOOST_CHECK_EQUAL(choice.otw_format, "sc8");
+    BOOST_CHECK(not choice.fits);
+
+    // The header overhead of small packets can make the difference
+    choice = pick_otw_format({"sc16"}, 140e6, 2, 8000, 16, LINK_RATE);
+    BOOST_CHECK(choice.fits);
+    choice = pick_otw_format({"sc16"}, 140e6, 2, 64, 16, LINK_RATE);
+    BOOST_CHECK(not choice.fits);
+
+    // An unknown link rate takes the widest format
+    choice = pick_otw_format(OTW_FORMATS, 200e6, 4, FRAME_SIZE, HEADER_SIZE, 0.0);
+    BOOST_CHECK_EQUAL(choice.otw_format, "sc16");
+    BOOST_CHECK(choice.fits);
+
+    BOOST_CHECK_THROW(pick_otw_format(OTW_FORMATS, 1e6, 1, 18, 16, LINK_RATE),
+        uhd::value_error);
+}
@@ -21,7 +21,11 @@
 #include <uhd/types/sid.hpp>
 #include <uhd/utils/safe_main.hpp>
 #include <uhd/utils/thread.hpp>
+#include <uhd/version.hpp>
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
 #include <boost/program_options.hpp>
+#include <algorithm>
 #include <chrono>
 #include <vector>
 
@@ -29,53 +33,118 @@ namespace po = boost::program_options;
 using namespace uhd::transport;
 using namespace uhd::usrp;
 
-void benchmark_recv_packet_handler(const size_t spp, const std::string& format)
+// Receive streamer with type-erased callbacks, as used by most devices
+struct dynamic_recv_dispatch
 {
-    const size_t bpi        = uhd::convert::get_bytes_per_item(format);
-    const size_t frame_size = bpi * spp + DEVICE3_RX_MAX_HDR_LEN;
+    typedef sph::recv_packet_streamer streamer_type;
+    static constexpr const char* name = "dynamic";
+    static streamer_type::get_buff_type make_get_buff(mock_zero_copy::sptr xport)
+    {
+        return [xport](double timeout) { return xport->get_recv_buff(timeout); };
+    }
+};
 
-    mock_zero_copy::sptr xport(new mock_zero_copy(
-        vrt::if_packet_info_t::LINK_TYPE_CHDR, frame_size, frame_size));
+// Receive streamer with the transport call known at compile time
+struct static_recv_dispatch
+{
+    typedef sph::zero_copy_recv_packet_streamer streamer_type;
+    static constexpr const char* name = "static";
+    static streamer_type::get_buff_type make_get_buff(mock_zero_copy::sptr xport)
+    {
+        return sph::zero_copy_recv_buff_getter{xport};
+    }
+};
 
-    xport->set_reuse_recv_memory(true);
+//! Parameters and result of one streaming benchmark run
+struct streamer_result_t
+{
+    std::string direction;
+    std::string dispatch;
+    std::string cpu_format;
+    std::string otw_format;
+    size_t num_chans;
+    size_t spp;
+    //! RX: alignment batch size, TX: 1 with time spec, 0 without
+    size_t option;
+    size_t iterations;
+    double ns_per_sample;
+    double samples_per_sec;
+};
+
+//! Fill in the timing results, the time is per call of all channels
+void set_timing(streamer_result_t& result, const double elapsed_time)
+{
+    const double samps = double(result.iterations) * result.spp * result.num_chans;
+    result.ns_per_sample   = elapsed_time / samps * 1e9;
+    result.samples_per_sec = samps / elapsed_time;
+}
+
+//! Return the number of 32-bit words that hold \p spp items of \p otw_format
+size_t get_payload_words32(const size_t spp, const std::string& otw_format)
+{
+    const size_t bytes = spp * uhd::convert::get_bytes_per_item(otw_format);
+    return (bytes + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+}
 
-    sph::recv_packet_streamer streamer(spp);
+template <typename dispatch_type>
+streamer_result_t benchmark_recv_packet_handler(const size_t spp,
+    const std::string& format,
+    const std::string& otw_format = "sc16_item32_be",
+    const size_t num_chans        = 1,
+    const size_t align_batch      = 1,
+    const size_t iterations       = 1e7)
+{
+    const size_t bpi         = uhd::convert::get_bytes_per_item(format);
+    const size_t payload_w32 = get_payload_words32(spp, otw_format);
+    const size_t frame_size  = payload_w32 * sizeof(uint32_t) + DEVICE3_RX_MAX_HDR_LEN;
+
+    typename dispatch_type::streamer_type streamer(spp);
+    streamer.resize(num_chans);
     streamer.set_vrt_unpacker(&vrt::chdr::if_hdr_unpack_be);
     streamer.set_tick_rate(1.0);
     streamer.set_samp_rate(1.0);
+    streamer.set_alignment_batch_size(align_batch);
 
     uhd::convert::id_type id;
     id.output_format = format;
     id.num_inputs    = 1;
-    id.input_format  = "sc16_item32_be";
+    id.input_format  = otw_format;
     id.num_outputs   = 1;
     streamer.set_converter(id);
 
-    streamer.set_xport_chan_get_buff(0,
-        [xport](double timeout) { return xport->get_recv_buff(timeout); },
-        false // flush
-    );
-
-    // Create packet for packet handler to read
+    // Create packet for packet handler to read. Every channel returns the
+    // same packet over and over, so the channels are always aligned.
     vrt::if_packet_info_t packet_info;
     packet_info.packet_type         = vrt::if_packet_info_t::PACKET_TYPE_DATA;
-    packet_info.num_payload_words32 = spp;
-    packet_info.num_payload_bytes   = packet_info.num_payload_words32 * sizeof(uint32_t);
+    packet_info.num_payload_words32 = payload_w32;
+    packet_info.num_payload_bytes   = spp * uhd::convert::get_bytes_per_item(otw_format);
     packet_info.has_tsf             = true;
     packet_info.tsf                 = 1;
+    std::vector<uint32_t> recv_data(payload_w32, 0);
+
+    std::vector<mock_zero_copy::sptr> xports;
+    for (size_t chan = 0; chan < num_chans; chan++) {
+        mock_zero_copy::sptr xport(new mock_zero_copy(
+            vrt::if_packet_info_t::LINK_TYPE_CHDR, frame_size, frame_size));
+        xport->set_reuse_recv_memory(true);
+        xport->push_back_recv_packet(packet_info, recv_data);
+        streamer.set_xport_chan_get_buff(chan,
+            dispatch_type::make_get_buff(xport),
+            false // flush
+        );
+        xports.push_back(xport);
+    }
 
-    std::vector<uint32_t> recv_data(spp, 0);
-    xport->push_back_recv_packet(packet_info, recv_data);
-
-    // Allocate buffer
-    std::vector<uint8_t> buffer(spp * bpi);
+    // Allocate buffers
+    std::vector<std::vector<uint8_t>> buffer(num_chans, std::vector<uint8_t>(spp * bpi));
     std::vector<void*> buffers;
-    buffers.push_back(buffer.data());
+    for (auto& chan_buffer : buffer) {
+        buffers.push_back(chan_buffer.data());
+    }
 
     // Run benchmark
     uhd::rx_metadata_t md;
-    const auto start_time   = std::chrono::steady_clock::now();
-    const size_t iterations = 1e7;
+    const auto start_time = std::chrono::steady_clock::now();
 
     for (size_t i = 0; i < iterations; i++) {
         streamer.recv(buffers, spp, md, 1.0, true);
@@ -83,48 +152,90 @@ void benchmark_recv_packet_handler(const size_t spp, const std::string& format)
 
     const auto end_time = std::chrono::steady_clock::now();
     const std::chrono::duration<double> elapsed_time(end_time - start_time);
-    const double time_per_packet = elapsed_time.count() / iterations;
 
-    std::cout << format << ": " << time_per_packet / spp * 1e9 << " ns/sample, "
-              << time_per_packet * 1e9 << " ns/packet\n";
+    streamer_result_t result{"rx",
+        dispatch_type::name,
+        format,
+        otw_format,
+        num_chans,
+        spp,
+        align_batch,
+        iterations,
+        0.0,
+        0.0};
+    set_timing(result, elapsed_time.count());
+    return result;
 }
 
-void benchmark_send_packet_handler(
-    const size_t spp, const std::string& format, bool use_time_spec)
+// Send streamer with type-erased callbacks, as used by most devices
+struct dynamic_send_dispatch
 {
-    const size_t bpi        = uhd::convert::get_bytes_per_item(format);
-    const size_t frame_size = bpi * spp + DEVICE3_TX_MAX_HDR_LEN;
-
-    mock_zero_copy::sptr xport(new mock_zero_copy(
-        vrt::if_packet_info_t::LINK_TYPE_CHDR, frame_size, frame_size));
+    typedef sph::send_packet_streamer streamer_type;
+    static constexpr const char* name = "dynamic";
+    static streamer_type::get_buff_type make_get_buff(mock_zero_copy::sptr xport)
+    {
+        return [xport](double timeout) { return xport->get_send_buff(timeout); };
+    }
+};
 
-    xport->set_reuse_send_memory(true);
+// Send streamer with the transport call known at compile time
+struct static_send_dispatch
+{
+    typedef sph::basic_send_packet_streamer<sph::zero_copy_send_buff_getter,
+        std::function<void(void)>>
+        streamer_type;
+    static constexpr const char* name = "static";
+    static streamer_type::get_buff_type make_get_buff(mock_zero_copy::sptr xport)
+    {
+        return sph::zero_copy_send_buff_getter{xport};
+    }
+};
+
+template <typename dispatch_type>
+streamer_result_t benchmark_send_packet_handler(const size_t spp,
+    const std::string& format,
+    bool use_time_spec,
+    const std::string& otw_format = "sc16_item32_be",
+    const size_t num_chans        = 1,
+    const size_t iterations       = 1e7)
+{
+    const size_t bpi         = uhd::convert::get_bytes_per_item(format);
+    const size_t payload_w32 = get_payload_words32(spp, otw_format);
+    const size_t frame_size  = payload_w32 * sizeof(uint32_t) + DEVICE3_TX_MAX_HDR_LEN;
 
-    sph::send_packet_streamer streamer(spp);
+    typename dispatch_type::streamer_type streamer(spp);
+    streamer.resize(num_chans);
     streamer.set_vrt_packer(&vrt::chdr::if_hdr_pack_be);
 
     uhd::convert::id_type id;
     id.input_format  = format;
     id.num_inputs    = 1;
-    id.output_format = "sc16_item32_be";
+    id.output_format = otw_format;
     id.num_outputs   = 1;
     streamer.set_converter(id);
     streamer.set_enable_trailer(false);
 
-    streamer.set_xport_chan_get_buff(
-        0, [xport](double timeout) { return xport->get_send_buff(timeout); });
+    std::vector<mock_zero_copy::sptr> xports;
+    for (size_t chan = 0; chan < num_chans; chan++) {
+        mock_zero_copy::sptr xport(new mock_zero_copy(
+            vrt::if_packet_info_t::LINK_TYPE_CHDR, frame_size, frame_size));
+        xport->set_reuse_send_memory(true);
+        streamer.set_xport_chan_get_buff(chan, dispatch_type::make_get_buff(xport));
+        xports.push_back(xport);
+    }
 
-    // Allocate buffer
-    std::vector<uint8_t> buffer(spp * bpi);
-    std::vector<void*> buffers;
-    buffers.push_back(buffer.data());
+    // Allocate buffers
+    std::vector<std::vector<uint8_t>> buffer(num_chans, std::vector<uint8_t>(spp * bpi));
+    std::vector<const void*> buffers;
+    for (auto& chan_buffer : buffer) {
+        buffers.push_back(chan_buffer.data());
+    }
 
     // Run benchmark
     uhd::tx_metadata_t md;
     md.has_time_spec = use_time_spec;
 
-    const auto start_time   = std::chrono::steady_clock::now();
-    const size_t iterations = 1e7;
+    const auto start_time = std::chrono::steady_clock::now();
 
     for (size_t i = 0; i < iterations; i++) {
         if (use_time_spec) {
@@ -135,13 +246,22 @@ void benchmark_send_packet_handler(
 
     const auto end_time = std::chrono::steady_clock::now();
     const std::chrono::duration<double> elapsed_time(end_time - start_time);
-    const double time_per_packet = elapsed_time.count() / iterations;
 
-    std::cout << format << ": " << time_per_packet / spp * 1e9 << " ns/sample, "
-              << time_per_packet * 1e9 << " ns/packet\n";
+    streamer_result_t result{"tx",
+        dispatch_type::name,
+        format,
+        otw_format,
+        num_chans,
+        spp,
+        use_time_spec ? 1u : 0u,
+        iterations,
+        0.0,
+        0.0};
+    set_timing(result, elapsed_time.count());
+    return result;
 }
 
-void benchmark_device3_rx_flow_ctrl(bool send_flow_control_packet)
+void benchmark_device3_rx_flow_ctrl(bool send_flow_control_packet, bool adaptive = false)
 {
     // Arbitrary sizes
     constexpr uint32_t fc_window = 10000;
@@ -158,6 +278,14 @@ void benchmark_device3_rx_flow_ctrl(bool send_flow_control_packet)
     fc_cache->unpack    = vrt::chdr::if_hdr_unpack_be;
     fc_cache->xport     = xport;
     fc_cache->interval  = fc_window;
+    if (adaptive) {
+        // Pin the interval so every iteration does the same amount of work
+        fc_cache->adaptive      = true;
+        fc_cache->min_interval  = fc_window;
+        fc_cache->max_interval  = fc_window;
+        fc_cache->target_period = 0.001;
+        fc_cache->last_fc_time  = std::chrono::steady_clock::now();
+    }
 
     // Create data buffer to pass to flow control function. Number of payload
     // words is arbitrary, just has to fit in the buffer.
@@ -228,7 +356,7 @@ void benchmark_device3_handle_rx_flow_ctrl_ack()
     std::cout << elapsed_time.count() / iterations * 1e9 << " ns per call\n";
 }
 
-void benchmark_device3_tx_flow_ctrl(bool send_flow_control_packet)
+void benchmark_device3_tx_flow_ctrl(bool send_flow_control_packet, bool async = false)
 {
     // Arbitrary sizes
     constexpr uint32_t fc_window = 10000;
@@ -247,6 +375,12 @@ void benchmark_device3_tx_flow_ctrl(bool send_flow_control_packet)
     xport->push_back_flow_ctrl_packet(
         vrt::if_packet_info_t::PACKET_TYPE_FC, 1 /*packet*/, fc_window /*bytes*/);
 
+    // In credit mode, the harvester's work is not part of the benchmark.
+    // Pretend that it got a new flow control packet before every call.
+    fc_cache->async_credit = async;
+    fc_cache->async_byte_ack.store(fc_window);
+    fc_cache->async_seq_ack.store(1);
+
     // Run benchmark
     const auto start_time                 = std::chrono::steady_clock::now();
     constexpr size_t iterations           = 1e7;
@@ -255,6 +389,9 @@ void benchmark_device3_tx_flow_ctrl(bool send_flow_control_packet)
     for (size_t i = 0; i < iterations; i++) {
         fc_cache->byte_count    = send_flow_control_packet ? fc_window : 0;
         fc_cache->last_byte_ack = 0;
+        if (async and send_flow_control_packet) {
+            fc_cache->async_fc_count.fetch_add(1, std::memory_order_release);
+        }
 
         tx_flow_ctrl(fc_cache, xport, send_buffer);
     }
@@ -299,10 +436,172 @@ void benchmark_device3_tx_flow_ctrl_ack()
     std::cout << elapsed_time.count() / iterations * 1e9 << " ns per call\n";
 }
 
+void print_result(const streamer_result_t& result)
+{
+    std::cout << result.cpu_format << ": " << result.ns_per_sample << " ns/sample, "
+              << result.ns_per_sample * result.spp * result.num_chans << " ns/packet\n";
+}
+
+//! Split a list like "1:2:4" (',' also works)
+std::vector<std::string> split_list(const std::string& list)
+{
+    std::vector<std::string> items;
+    boost::split(items, list, boost::is_any_of(":,"), boost::token_compress_on);
+    items.erase(std::remove(items.begin(), items.end(), ""), items.end());
+    return items;
+}
+
+std::vector<size_t> split_size_list(const std::string& list)
+{
+    std::vector<size_t> values;
+    for (const std::string& item : split_list(list)) {
+        values.push_back(boost::lexical_cast<size_t>(item));
+    }
+    return values;
+}
+
+//! Return the (cpu format, otw format) pairs of all registered converters
+// of one direction that the packet handlers can use
+std::vector<std::pair<std::string, std::string>> get_converter_pairs(const bool rx)
+{
+    std::vector<std::pair<std::string, std::string>> pairs;
+    for (const auto& id : uhd::convert::get_converter_ids()) {
+        if (id.num_inputs != 1 or id.num_outputs != 1) {
+            continue;
+        }
+        const std::string& otw = rx ? id.input_format : id.output_format;
+        const std::string& cpu = rx ? id.output_format : id.input_format;
+        // Only converters from and to the wire, e.g. not sc16 -> sc16
+        if (otw.find('_') == std::string::npos or cpu.find('_') != std::string::npos) {
+            continue;
+        }
+        try {
+            uhd::convert::get_bytes_per_item(otw);
+            uhd::convert::get_bytes_per_item(cpu);
+        } catch (const uhd::key_error&) {
+            continue;
+        }
+        pairs.push_back(std::make_pair(cpu, otw));
+    }
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+    return pairs;
+}
+
+/*! Run the streamer benchmarks for all combinations of the parameters
+ *
+ * The results are written as CSV or JSON, one record per run, so they can be
+ * compared across commits.
+ */
+void run_sweep(const po::variables_map& vm)
+{
+    const std::vector<size_t> channels =
+        split_size_list(vm["channels"].as<std::string>());
+    const std::vector<size_t> spps = split_size_list(vm["spp"].as<std::string>());
+    const std::vector<size_t> batches =
+        split_size_list(vm["align-batch"].as<std::string>());
+    const std::vector<std::string> directions =
+        split_list(vm["direction"].as<std::string>());
+    const std::string formats    = vm["formats"].as<std::string>();
+    const std::string otw_format = vm["otw-format"].as<std::string>();
+    const std::string output     = vm["output-format"].as<std::string>();
+    const std::string label      = vm["label"].as<std::string>();
+    const size_t samples         = size_t(vm["samples"].as<double>());
+
+    std::vector<streamer_result_t> results;
+    auto run = [&](const streamer_result_t& result) {
+        results.push_back(result);
+        std::cerr << result.direction << " " << result.cpu_format << " <-> "
+                  << result.otw_format << ", " << result.num_chans << " ch, spp "
+                  << result.spp << ": " << result.ns_per_sample << " ns/sample"
+                  << std::endl;
+    };
+
+    for (const std::string& direction : directions) {
+        const bool rx = (direction == "rx");
+        if (not rx and direction != "tx") {
+            throw uhd::value_error("Invalid direction: " + direction);
+        }
+        std::vector<std::pair<std::string, std::string>> pairs;
+        if (formats == "all") {
+            pairs = get_converter_pairs(rx);
+        } else {
+            for (const std::string& format : split_list(formats)) {
+                pairs.push_back(std::make_pair(format, otw_format));
+            }
+        }
+        for (const auto& pair : pairs) {
+            for (const size_t num_chans : channels) {
+                for (const size_t spp : spps) {
+                    const size_t iterations =
+                        std::max<size_t>(samples / (spp * num_chans), 1);
+                    if (rx) {
+                        for (const size_t batch : batches) {
+                            run(benchmark_recv_packet_handler<static_recv_dispatch>(spp,
+                                pair.first,
+                                pair.second,
+                                num_chans,
+                                batch,
+                                iterations));
+                        }
+                    } else {
+                        run(benchmark_send_packet_handler<static_send_dispatch>(
+                            spp, pair.first, true, pair.second, num_chans, iterations));
+                    }
+                }
+            }
+        }
+    }
+
+    if (output == "json") {
+        std::cout << "[";
+    } else {
+        std::cout << "label,direction,dispatch,cpu_format,otw_format,channels,spp,"
+                     "option,iterations,ns_per_sample,samples_per_sec\n";
+    }
+    for (size_t i = 0; i < results.size(); i++) {
+        const streamer_result_t& r = results[i];
+        if (output == "json") {
+            std::cout << (i ? "," : "") << "\n  {\"label\": \"" << label
+                      << "\", \"direction\": \"" << r.direction
+                      << "\", \"dispatch\": \"" << r.dispatch
+                      << "\", \"cpu_format\": \"" << r.cpu_format
+                      << "\", \"otw_format\": \"" << r.otw_format
+                      << "\", \"channels\": " << r.num_chans << ", \"spp\": " << r.spp
+                      << ", \"option\": " << r.option
+                      << ", \"iterations\": " << r.iterations
+                      << ", \"ns_per_sample\": " << r.ns_per_sample
+                      << ", \"samples_per_sec\": " << r.samples_per_sec << "}";
+        } else {
+            std::cout << label << "," << r.direction << "," << r.dispatch << ","
+                      << r.cpu_format << "," << r.otw_format << "," << r.num_chans
+                      << "," << r.spp << "," << r.option << "," << r.iterations << ","
+                      << r.ns_per_sample << "," << r.samples_per_sec << "\n";
+        }
+    }
+    if (output == "json") {
+        std::cout << "\n]" << std::endl;
+    }
+}
+
 int UHD_SAFE_MAIN(int argc, char* argv[])
 {
     po::options_description desc("Allowed options");
-    desc.add_options()("help", "help message");
+    // clang-format off
+    desc.add_options()
+        ("help", "help message")
+        ("sweep", "Only run the streamer benchmarks, for all combinations of the options below, and print machine-readable results")
+        ("direction", po::value<std::string>()->default_value("rx:tx"), "Directions to benchmark (rx, tx)")
+        ("channels", po::value<std::string>()->default_value("1:2:4:8:16"), "Numbers of channels")
+        ("spp", po::value<std::string>()->default_value("364:1000:2000"), "Samples per packet")
+        ("formats", po::value<std::string>()->default_value("sc16:fc32:fc64"), "CPU formats, or 'all' for every registered converter")
+        ("otw-format", po::value<std::string>()->default_value("sc16_item32_be"), "Wire format, unless --formats is 'all'")
+        ("align-batch", po::value<std::string>()->default_value("1:8"), "RX alignment batch sizes (1: align every packet)")
+        ("samples", po::value<double>()->default_value(1e9), "Samples per run, summed over all channels")
+        ("output-format", po::value<std::string>()->default_value("csv"), "csv or json")
+        ("label", po::value<std::string>()->default_value(uhd::get_version_string()), "Label for the results, e.g. a commit hash")
+    ;
+    // clang-format on
 
     po::variables_map vm;
     po::store(po::parse_command_line(argc, argv, desc), vm);
@@ -321,6 +620,11 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
 
     uhd::set_thread_priority_safe();
 
+    if (vm.count("sweep")) {
+        run_sweep(vm);
+        return EXIT_SUCCESS;
+    }
+
     const char* formats[]   = {"sc16", "fc32", "fc64"};
     constexpr size_t rx_spp = 2000;
     constexpr size_t tx_spp = 1000;
@@ -330,10 +634,18 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
     std::cout << "----------------------------------------------------------\n";
     std::cout << "spp: " << rx_spp << "\n";
 
+    std::cout << "*** type-erased callbacks ***\n";
     for (size_t i = 0; i < std::extent<decltype(formats)>::value; i++) {
-        benchmark_recv_packet_handler(rx_spp, formats[i]);
+        print_result(
+            benchmark_recv_packet_handler<dynamic_recv_dispatch>(rx_spp, formats[i]));
     }
+    std::cout << "\n";
 
+    std::cout << "*** static dispatch ***\n";
+    for (size_t i = 0; i < std::extent<decltype(formats)>::value; i++) {
+        print_result(
+            benchmark_recv_packet_handler<static_recv_dispatch>(rx_spp, formats[i]));
+    }
     std::cout << "\n";
 
     std::cout << "----------------------------------------------------------\n";
@@ -343,13 +655,22 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
 
     std::cout << "*** without timespec ***\n";
     for (size_t i = 0; i < std::extent<decltype(formats)>::value; i++) {
-        benchmark_send_packet_handler(tx_spp, formats[i], false);
+        print_result(benchmark_send_packet_handler<dynamic_send_dispatch>(
+            tx_spp, formats[i], false));
     }
     std::cout << "\n";
 
     std::cout << "*** with timespec ***\n";
     for (size_t i = 0; i < std::extent<decltype(formats)>::value; i++) {
-        benchmark_send_packet_handler(tx_spp, formats[i], true);
+        print_result(benchmark_send_packet_handler<dynamic_send_dispatch>(
+            tx_spp, formats[i], true));
+    }
+    std::cout << "\n";
+
+    std::cout << "*** with timespec, static dispatch ***\n";
+    for (size_t i = 0; i < std::extent<decltype(formats)>::value; i++) {
+        print_result(benchmark_send_packet_handler<static_send_dispatch>(
+            tx_spp, formats[i], true));
     }
     std::cout << "\n";
 
@@ -364,6 +685,14 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
     benchmark_device3_tx_flow_ctrl(true);
     std::cout << "\n";
 
+    std::cout << "*** device3_tx_flow_ctrl async with no flow control packet ***\n";
+    benchmark_device3_tx_flow_ctrl(false, true);
+    std::cout << "\n";
+
+    std::cout << "*** device3_tx_flow_ctrl async with flow control packet ***\n";
+    benchmark_device3_tx_flow_ctrl(true, true);
+    std::cout << "\n";
+
     std::cout << "*** device3_tx_flow_ctrl_ack ***\n";
     benchmark_device3_tx_flow_ctrl_ack();
     std::cout << "\n";
@@ -376,6 +705,14 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
     benchmark_device3_rx_flow_ctrl(true);
     std::cout << "\n";
 
+    std::cout << "*** device3_rx_flow_ctrl adaptive with no flow control packet ***\n";
+    benchmark_device3_rx_flow_ctrl(false, true);
+    std::cout << "\n";
+
+    std::cout << "*** device3_rx_flow_ctrl adaptive with flow control packet ***\n";
+    benchmark_device3_rx_flow_ctrl(true, true);
+    std::cout << "\n";
+
     std::cout << "*** device3_handle_rx_flow_ctrl_ack ***\n";
     benchmark_device3_handle_rx_flow_ctrl_ack();
     std::cout << "\n";
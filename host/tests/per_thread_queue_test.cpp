@@ -0,0 +1,79 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhdlib/utils/per_thread_queue.hpp>
+#include <boost/test/unit_test.hpp>
+#include <thread>
+#include <vector>
+
+using namespace uhd;
+
+BOOST_AUTO_TEST_CASE(test_per_thread_queue_drop)
+{
+    per_thread_queue<int> queue(2);
+    BOOST_CHECK(queue.push(0));
+    BOOST_CHECK(queue.push(1));
+    // Full, must not block
+    BOOST_CHECK(not queue.push(2));
+    BOOST_CHECK(not queue.push(3));
+    BOOST_CHECK_EQUAL(queue.get_and_reset_dropped(), 2);
+    BOOST_CHECK_EQUAL(queue.get_and_reset_dropped(), 0);
+
+    std::vector<int> values;
+    BOOST_CHECK_EQUAL(queue.drain([&values](int val) { values.push_back(val); }), 2);
+    BOOST_REQUIRE_EQUAL(values.size(), 2);
+    BOOST_CHECK_EQUAL(values[0], 0);
+    BOOST_CHECK_EQUAL(values[1], 1);
+
+    // There's space again
+    BOOST_CHECK(queue.push(4));
+    BOOST_CHECK_EQUAL(queue.drain([](int) {}), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_per_thread_queue_threads)
+{
+    constexpr int num_threads = 4;
+    constexpr int num_elems   = 100;
+    per_thread_queue<int> queue(num_elems);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; t++) {
+        threads.emplace_back([&queue, t]() {
+            for (int i = 0; i < num_elems; i++) {
+                queue.push(t * num_elems + i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Every thread's elements arrive in order, even after the thread exited
+    std::vector<int> last(num_threads, -1);
+    const size_t count = queue.drain([&last](int val) {
+        const int t = val / num_elems;
+        BOOST_CHECK_GT(val, last[t]);
+        last[t] = val;
+    });
+    BOOST_CHECK_EQUAL(count, num_threads * num_elems);
+    BOOST_CHECK_EQUAL(queue.get_and_reset_dropped(), 0);
+    // Rings of exited threads are gone
+    BOOST_CHECK_EQUAL(queue.drain([](int) {}), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_per_thread_queue_wait)
+{
+    per_thread_queue<int> queue(4);
+    // Times out
+    queue.wait(0.01);
+    std::thread producer([&queue]() { queue.push(1); });
+    producer.join();
+    // Returns immediately, a push is pending
+    queue.wait(10.0);
+    BOOST_CHECK_EQUAL(queue.drain([](int) {}), 1);
+    queue.wake();
+    queue.wait(10.0);
+}
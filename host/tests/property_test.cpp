@@ -6,6 +6,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 //
 
+#include <uhd/exception.hpp>
 #include <uhd/property_tree.hpp>
 #include <boost/bind.hpp>
 #include <boost/test/unit_test.hpp>
@@ -221,6 +222,79 @@ BOOST_AUTO_TEST_CASE(test_prop_tree)
     BOOST_CHECK(not tree->exists("/test/prop1"));
 }
 
+BOOST_AUTO_TEST_CASE(test_prop_tree_handle)
+{
+    uhd::property_tree::sptr tree = uhd::property_tree::make();
+    tree->create<int>("/test/prop0").set(42);
+    tree->create<int>("/test/prop1");
+
+    auto handle = tree->access_handle<int>("/test/prop0");
+    BOOST_CHECK_EQUAL(handle->get(), 42);
+    tree->access<int>("/test/prop0").set(34);
+    BOOST_CHECK_EQUAL(handle->get(), 34);
+    BOOST_CHECK_THROW(tree->access_handle<int>("/test"), uhd::runtime_error);
+    BOOST_CHECK_THROW(tree->access_handle<int>("/test/prop2"), uhd::lookup_error);
+
+    // Handles outlive removal from the tree
+    tree->remove("/test/prop0");
+    BOOST_CHECK_EQUAL(handle->get(), 34);
+
+    // Listing keeps the creation order
+    tree->create<int>("/test/prop10");
+    tree->create<int>("/test/prop2");
+    const std::vector<std::string> keys = tree->list("/test");
+    BOOST_REQUIRE_EQUAL(keys.size(), 3);
+    BOOST_CHECK_EQUAL(keys[0], "prop1");
+    BOOST_CHECK_EQUAL(keys[1], "prop10");
+    BOOST_CHECK_EQUAL(keys[2], "prop2");
+}
+
+BOOST_AUTO_TEST_CASE(test_prop_defer_scope)
+{
+    uhd::property_tree::sptr tree = uhd::property_tree::make();
+    uhd::property<int>& prop0     = tree->create<int>("/prop0");
+    uhd::property<int>& prop1     = tree->create<int>("/prop1");
+    prop0.set(1);
+
+    setter_type setter0, setter1;
+    prop0.add_coerced_subscriber(boost::bind(&setter_type::doit, &setter0, _1));
+    prop1.add_desired_subscriber(boost::bind(&setter_type::doit, &setter1, _1));
+
+    {
+        uhd::property_defer_scope defer;
+        prop0.set(2);
+        prop1.set(3);
+        prop0.set(4);
+        {
+            // Nested scopes don't commit
+            uhd::property_defer_scope nested;
+            prop0.set(5);
+            nested.commit();
+        }
+        BOOST_CHECK_EQUAL(setter0._count, 0);
+        BOOST_CHECK_EQUAL(prop0.get(), 1);
+        BOOST_CHECK_EQUAL(prop0.get_desired(), 5);
+        defer.commit();
+        BOOST_CHECK_EQUAL(setter0._count, 1);
+        BOOST_CHECK_EQUAL(setter0._x, 5);
+        BOOST_CHECK_EQUAL(setter1._count, 1);
+        BOOST_CHECK_EQUAL(setter1._x, 3);
+
+        // Sets after the commit take effect immediately
+        prop0.set(6);
+        BOOST_CHECK_EQUAL(setter0._count, 2);
+    }
+
+    // Leaving the scope commits, too
+    {
+        uhd::property_defer_scope defer;
+        prop1.set(7);
+        prop1.set(8);
+    }
+    BOOST_CHECK_EQUAL(setter1._count, 2);
+    BOOST_CHECK_EQUAL(setter1._x, 8);
+}
+
 BOOST_AUTO_TEST_CASE(test_prop_subtree)
 {
     uhd::property_tree::sptr tree = uhd::property_tree::make();
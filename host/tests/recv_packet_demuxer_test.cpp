@@ -0,0 +1,197 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/utils/byteswap.hpp>
+#include <uhdlib/usrp/common/recv_packet_demuxer_3000.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace uhd::transport;
+using uhd::usrp::recv_packet_demuxer_3000;
+
+namespace {
+
+//! A frame of three little-endian words: header, SID and a marker
+class frame_mrb : public managed_recv_buffer
+{
+public:
+    frame_mrb(const uint32_t sid, const uint32_t marker, std::atomic<size_t>& num_live)
+        : _num_live(num_live)
+    {
+        _num_live++;
+        _words[0] = 0;
+        _words[1] = uhd::htowx(sid);
+        _words[2] = marker;
+    }
+
+    void release(void)
+    {
+        _num_live--;
+        delete this;
+    }
+
+    sptr get(void)
+    {
+        return make(this, _words, sizeof(_words));
+    }
+
+private:
+    std::atomic<size_t>& _num_live;
+    uint32_t _words[3];
+};
+
+/*! Hands out queued frames, thread-safe unlike mock_zero_copy
+ *
+ * Like a real transport, it only has so many frames: push() waits while all
+ * of them are queued or held by the receiver.
+ */
+class frame_queue_xport : public zero_copy_if
+{
+public:
+    typedef boost::shared_ptr<frame_queue_xport> sptr;
+
+    void push(const uint32_t sid, const uint32_t marker)
+    {
+        while (_num_live >= NUM_FRAMES) {
+            std::this_thread::yield();
+        }
+        std::lock_guard<std::mutex> lock(_mutex);
+        _frames.push_back((new frame_mrb(sid, marker, _num_live))->get());
+    }
+
+    managed_recv_buffer::sptr get_recv_buff(double)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        managed_recv_buffer::sptr buff;
+        if (not _frames.empty()) {
+            buff.swap(_frames.front());
+            _frames.pop_front();
+        }
+        return buff;
+    }
+
+    size_t get_num_recv_frames(void) const
+    {
+        return NUM_FRAMES;
+    }
+    size_t get_recv_frame_size(void) const
+    {
+        return 12;
+    }
+    managed_send_buffer::sptr get_send_buff(double)
+    {
+        return managed_send_buffer::sptr();
+    }
+    size_t get_num_send_frames(void) const
+    {
+        return 0;
+    }
+    size_t get_send_frame_size(void) const
+    {
+        return 0;
+    }
+
+private:
+    static constexpr size_t NUM_FRAMES = 64;
+    std::atomic<size_t> _num_live{0};
+    std::mutex _mutex;
+    std::deque<managed_recv_buffer::sptr> _frames;
+};
+
+uint32_t get_marker(managed_recv_buffer::sptr buff)
+{
+    BOOST_REQUIRE(buff);
+    return buff->cast<const uint32_t*>()[2];
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_recv_packet_demuxer_3000)
+{
+    auto xport = boost::make_shared<frame_queue_xport>();
+    auto demux = recv_packet_demuxer_3000::make(xport);
+    demux->realloc_sid(1);
+    demux->realloc_sid(2);
+    xport->push(1, 0xA);
+    xport->push(2, 0xB);
+    xport->push(3, 0xC); // Unknown SID, dropped
+    xport->push(2, 0xD);
+    xport->push(1, 0xE);
+
+    // One call drains everything, the rest is queued in order
+    BOOST_CHECK_EQUAL(get_marker(demux->get_recv_buff(2, 0.1)), 0xB);
+    BOOST_CHECK_EQUAL(get_marker(demux->get_recv_buff(1, 0.1)), 0xA);
+    BOOST_CHECK_EQUAL(get_marker(demux->get_recv_buff(1, 0.1)), 0xE);
+    BOOST_CHECK_EQUAL(get_marker(demux->get_recv_buff(2, 0.1)), 0xD);
+    BOOST_CHECK(not demux->get_recv_buff(1, 0.0));
+
+    // Flushing drops the queued frames of that SID only
+    xport->push(1, 0x10);
+    xport->push(2, 0x11);
+    xport->push(2, 0x12);
+    BOOST_CHECK_EQUAL(get_marker(demux->get_recv_buff(1, 0.1)), 0x10);
+    demux->realloc_sid(2);
+    BOOST_CHECK(not demux->get_recv_buff(2, 0.0));
+
+    // The proxy receives its SID
+    zero_copy_if::sptr proxy = demux->make_proxy(5);
+    xport->push(1, 0x13);
+    xport->push(5, 0x14);
+    BOOST_CHECK_EQUAL(get_marker(proxy->get_recv_buff(0.1)), 0x14);
+    BOOST_CHECK_EQUAL(get_marker(demux->get_recv_buff(1, 0.1)), 0x13);
+}
+
+BOOST_AUTO_TEST_CASE(test_recv_packet_demuxer_3000_threads)
+{
+    constexpr size_t NUM_SIDS   = 2;
+    constexpr uint32_t NUM_PKTS = 10000;
+    auto xport = boost::make_shared<frame_queue_xport>();
+    auto demux = recv_packet_demuxer_3000::make(xport);
+    for (uint32_t sid = 0; sid < NUM_SIDS; sid++) {
+        demux->realloc_sid(sid);
+    }
+
+    std::thread producer([&]() {
+        for (uint32_t i = 0; i < NUM_PKTS; i++) {
+            for (uint32_t sid = 0; sid < NUM_SIDS; sid++) {
+                xport->push(sid, i);
+            }
+            if (i % 64 == 0) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    // Each consumer checks the order of its frames, every thread demuxes
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    std::vector<size_t> num_ok(NUM_SIDS, 0);
+    std::vector<std::thread> consumers;
+    for (uint32_t sid = 0; sid < NUM_SIDS; sid++) {
+        consumers.emplace_back([&, sid]() {
+            uint32_t expected = 0;
+            while (expected < NUM_PKTS
+                   and std::chrono::steady_clock::now() < deadline) {
+                managed_recv_buffer::sptr buff = demux->get_recv_buff(sid, 0.01);
+                if (buff and buff->cast<const uint32_t*>()[2] == expected) {
+                    num_ok[sid]++;
+                }
+                expected += buff ? 1 : 0;
+            }
+        });
+    }
+    producer.join();
+    for (auto& consumer : consumers) {
+        consumer.join();
+    }
+    for (uint32_t sid = 0; sid < NUM_SIDS; sid++) {
+        BOOST_CHECK_EQUAL(num_ok[sid], NUM_PKTS);
+    }
+}
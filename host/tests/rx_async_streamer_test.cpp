@@ -0,0 +1,249 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/utils/rx_async_streamer.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#ifndef _WIN32
+#    include <poll.h>
+#endif
+
+namespace {
+
+/*! Streams counting samples in packets of up to spp samples per channel
+ *
+ * Every few calls, it times out instead, like a real streamer that is
+ * polled faster than the data arrives. After num_samps samples, it ends the
+ * burst.
+ */
+class mock_rx_streamer : public uhd::rx_streamer
+{
+public:
+    mock_rx_streamer(const size_t num_chans, const size_t spp, const size_t num_samps)
+        : _num_chans(num_chans), _spp(spp), _num_samps(num_samps)
+    {
+    }
+
+    size_t get_num_channels(void) const
+    {
+        return _num_chans;
+    }
+
+    size_t get_max_num_samps(void) const
+    {
+        return _spp;
+    }
+
+    size_t recv(const buffs_type& buffs,
+        const size_t nsamps_per_buff,
+        uhd::rx_metadata_t& metadata,
+        const double timeout = 0.1,
+        const bool = false)
+    {
+        metadata.reset();
+        if (_sent == _num_samps or ++_calls % 3 == 0) {
+            std::this_thread::sleep_for(std::chrono::duration<double>(timeout));
+            metadata.error_code = uhd::rx_metadata_t::ERROR_CODE_TIMEOUT;
+            return 0;
+        }
+        const size_t n = std::min(std::min(nsamps_per_buff, _spp), _num_samps - _sent);
+        for (size_t chan = 0; chan < _num_chans; chan++) {
+            uint32_t* items = static_cast<uint32_t*>(buffs[chan]);
+            for (size_t i = 0; i < n; i++) {
+                items[i] = uint32_t((_sent + i) * _num_chans + chan);
+            }
+        }
+        metadata.has_time_spec  = true;
+        metadata.time_spec      = uhd::time_spec_t::from_ticks(_sent, 1e6);
+        metadata.start_of_burst = (_sent == 0);
+        _sent += n;
+        metadata.end_of_burst = (_sent == _num_samps);
+        return n;
+    }
+
+    void issue_stream_cmd(const uhd::stream_cmd_t&)
+    {
+        /* NOP */
+    }
+
+private:
+    const size_t _num_chans;
+    const size_t _spp;
+    const size_t _num_samps;
+    size_t _sent  = 0;
+    size_t _calls = 0;
+};
+
+//! Boost.Test isn't thread-safe, the callbacks of all streams share this lock
+std::mutex check_mutex;
+
+//! Checks the buffers of one stream in order
+struct stream_checker
+{
+    stream_checker(const size_t num_chans) : num_chans(num_chans) {}
+
+    void check(const uhd::rx_async_streamer::buffer_t& buffer)
+    {
+        std::lock_guard<std::mutex> lock(check_mutex);
+        BOOST_CHECK_EQUAL(buffer.buffs.size(), num_chans);
+        BOOST_CHECK(buffer.metadata.has_time_spec);
+        BOOST_CHECK_EQUAL(buffer.metadata.time_spec.to_ticks(1e6), num_samps);
+        BOOST_CHECK_EQUAL(buffer.metadata.start_of_burst, num_samps == 0);
+        for (size_t chan = 0; chan < num_chans; chan++) {
+            const uint32_t* items = static_cast<const uint32_t*>(buffer.buffs[chan]);
+            for (size_t i = 0; i < buffer.num_samps; i++) {
+                if (items[i] != uint32_t((num_samps + i) * num_chans + chan)) {
+                    BOOST_FAIL("Wrong sample " << num_samps + i);
+                }
+            }
+        }
+        num_samps += buffer.num_samps;
+        num_buffs++;
+        if (buffer.metadata.end_of_burst) {
+            done = true;
+        }
+    }
+
+    const size_t num_chans;
+    size_t num_samps = 0;
+    size_t num_buffs = 0;
+    std::atomic<bool> done{false};
+};
+
+//! Pool of num_buffs buffers with num_chans channels of spb samples each
+struct buffer_pool
+{
+    buffer_pool(const size_t num_buffs, const size_t num_chans, const size_t spb)
+        : mem(num_buffs * num_chans, std::vector<uint32_t>(spb))
+    {
+        for (size_t b = 0; b < num_buffs; b++) {
+            pool.emplace_back();
+            for (size_t chan = 0; chan < num_chans; chan++) {
+                pool.back().push_back(mem[b * num_chans + chan].data());
+            }
+        }
+    }
+
+    std::vector<std::vector<uint32_t>> mem;
+    std::vector<std::vector<void*>> pool;
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_rx_async_streamer_callback)
+{
+    constexpr size_t NUM_STREAMS = 6;
+    constexpr size_t NUM_SAMPS   = 100000;
+    auto async                   = uhd::rx_async_streamer::make(
+        uhd::device_addr_t("num_threads=2,poll_timeout=0.0001"));
+    std::vector<std::unique_ptr<buffer_pool>> pools;
+    std::vector<std::unique_ptr<stream_checker>> checkers;
+    for (size_t s = 0; s < NUM_STREAMS; s++) {
+        const size_t num_chans = 1 + s % 2;
+        pools.emplace_back(new buffer_pool(3, num_chans, 1000));
+        checkers.emplace_back(new stream_checker(num_chans));
+        stream_checker* checker = checkers.back().get();
+        BOOST_CHECK_EQUAL(
+            async->add_stream(boost::make_shared<mock_rx_streamer>(
+                                  num_chans, 364, NUM_SAMPS + s),
+                pools.back()->pool,
+                1000,
+                sizeof(uint32_t),
+                [checker](const uhd::rx_async_streamer::buffer_t& buffer) {
+                    checker->check(buffer);
+                }),
+            s);
+    }
+    async->start();
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    for (auto& checker : checkers) {
+        while (not checker->done and std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    async->stop();
+    for (size_t s = 0; s < NUM_STREAMS; s++) {
+        BOOST_CHECK(checkers[s]->done);
+        BOOST_CHECK_EQUAL(checkers[s]->num_samps, NUM_SAMPS + s);
+        // Full buffers, only the last one is cut short by the end of burst
+        BOOST_CHECK_EQUAL(checkers[s]->num_buffs, (NUM_SAMPS + s + 999) / 1000);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_rx_async_streamer_completion_queue)
+{
+    constexpr size_t NUM_STREAMS = 3;
+    constexpr size_t NUM_SAMPS   = 20000;
+    auto async = uhd::rx_async_streamer::make(uhd::device_addr_t("num_threads=1"));
+    std::vector<std::unique_ptr<buffer_pool>> pools;
+    std::vector<std::unique_ptr<stream_checker>> checkers;
+    for (size_t s = 0; s < NUM_STREAMS; s++) {
+        pools.emplace_back(new buffer_pool(2, 1, 512));
+        checkers.emplace_back(new stream_checker(1));
+        async->add_stream(boost::make_shared<mock_rx_streamer>(1, 100, NUM_SAMPS),
+            pools.back()->pool,
+            512,
+            sizeof(uint32_t));
+    }
+    async->start();
+
+#ifndef _WIN32
+    // The descriptor is readable while buffers are waiting
+    pollfd pfd = {async->get_completed_fd(), POLLIN, 0};
+    BOOST_CHECK_EQUAL(poll(&pfd, 1, 1000), 1);
+#endif
+
+    // Holding on to the buffers pauses the streams, nothing gets lost
+    std::vector<uhd::rx_async_streamer::buffer_t> held;
+    uhd::rx_async_streamer::buffer_t buffer;
+    while (async->get_completed(buffer, 0.5)) {
+        held.push_back(buffer);
+    }
+    BOOST_CHECK_EQUAL(held.size(), 2 * NUM_STREAMS);
+#ifndef _WIN32
+    BOOST_CHECK_EQUAL(poll(&pfd, 1, 0), 0);
+#endif
+    for (const auto& buffer : held) {
+        checkers[buffer.stream]->check(buffer);
+        async->release(buffer);
+    }
+
+    size_t num_done = 0;
+    while (num_done < NUM_STREAMS and async->get_completed(buffer, 1.0)) {
+        checkers[buffer.stream]->check(buffer);
+        num_done += buffer.metadata.end_of_burst ? 1 : 0;
+        async->release(buffer);
+    }
+    async->stop();
+    for (auto& checker : checkers) {
+        BOOST_CHECK(checker->done);
+        BOOST_CHECK_EQUAL(checker->num_samps, NUM_SAMPS);
+    }
+
+    // Buffers that aren't from the pool of their stream are rejected
+    buffer_pool other(1, 1, 512);
+    buffer.buffs = other.pool[0];
+    BOOST_CHECK_THROW(async->release(buffer), uhd::value_error);
+    buffer.stream = NUM_STREAMS;
+    BOOST_CHECK_THROW(async->release(buffer), uhd::value_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_rx_async_streamer_errors)
+{
+    BOOST_CHECK_THROW(uhd::rx_async_streamer::make(uhd::device_addr_t("num_threads=0")),
+        uhd::value_error);
+    auto async       = uhd::rx_async_streamer::make();
+    auto rx_stream   = boost::make_shared<mock_rx_streamer>(2, 100, 1000);
+    buffer_pool pool(1, 1, 100);
+    BOOST_CHECK_THROW(
+        async->add_stream(rx_stream, pool.pool, 100, 4), uhd::value_error);
+    BOOST_CHECK_THROW(async->add_stream(rx_stream, {}, 100, 4), uhd::value_error);
+}
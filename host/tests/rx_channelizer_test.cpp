@@ -0,0 +1,137 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/usrp/rx_channelizer.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <complex>
+
+using namespace uhd;
+using namespace uhd::usrp;
+
+namespace {
+
+constexpr double SAMP_RATE   = 1.6e6;
+constexpr size_t NUM_CHANS   = 16;
+constexpr size_t TONE_CHAN   = 3;
+constexpr double TONE_OFFSET = 10e3;
+constexpr double TONE_FREQ   = TONE_CHAN * SAMP_RATE / NUM_CHANS + TONE_OFFSET;
+
+//! Streams a complex fc32 tone with time specs, in packets of 1000 samples
+class mock_rx_streamer : public uhd::rx_streamer
+{
+public:
+    size_t get_num_channels(void) const
+    {
+        return 1;
+    }
+
+    size_t get_max_num_samps(void) const
+    {
+        return 1000;
+    }
+
+    size_t recv(const buffs_type& buffs,
+        const size_t nsamps_per_buff,
+        rx_metadata_t& metadata,
+        const double,
+        const bool)
+    {
+        metadata.reset();
+        metadata.has_time_spec = true;
+        metadata.time_spec     = time_spec_t::from_ticks(_num_sent, SAMP_RATE);
+        const size_t nsamps    = std::min<size_t>(nsamps_per_buff, 1000);
+        auto* out              = reinterpret_cast<std::complex<float>*>(buffs[0]);
+        for (size_t i = 0; i < nsamps; i++) {
+            out[i] = std::polar(
+                1.0f, float(2 * M_PI * TONE_FREQ * (_num_sent + i) / SAMP_RATE));
+        }
+        _num_sent += nsamps;
+        return nsamps;
+    }
+
+    void issue_stream_cmd(const stream_cmd_t&) {}
+
+private:
+    size_t _num_sent = 0;
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_channelizer_params)
+{
+    auto streamer = boost::make_shared<mock_rx_streamer>();
+    BOOST_CHECK_THROW(rx_channelizer::make(streamer, 12, SAMP_RATE), uhd::value_error);
+    BOOST_CHECK_THROW(rx_channelizer::make(streamer, 16, SAMP_RATE, 0), uhd::value_error);
+
+    auto channelizer = rx_channelizer::make(streamer, NUM_CHANS, SAMP_RATE);
+    BOOST_CHECK_EQUAL(channelizer->get_num_chans(), NUM_CHANS);
+    BOOST_CHECK_CLOSE(channelizer->get_chan_rate(), SAMP_RATE / NUM_CHANS, 1e-9);
+    BOOST_CHECK_CLOSE(channelizer->get_chan_freq(1), SAMP_RATE / NUM_CHANS, 1e-9);
+    BOOST_CHECK_CLOSE(channelizer->get_chan_freq(15), -SAMP_RATE / NUM_CHANS, 1e-9);
+    BOOST_CHECK_THROW(channelizer->get_channel_streamer(NUM_CHANS), uhd::index_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_channelizer_tone)
+{
+    auto channelizer = rx_channelizer::make(
+        boost::make_shared<mock_rx_streamer>(), NUM_CHANS, SAMP_RATE, 2);
+    const double chan_rate = channelizer->get_chan_rate();
+    const size_t nsamps    = 500;
+    std::vector<std::complex<float>> buff(nsamps);
+    rx_metadata_t md;
+
+    // The tone comes out of its channel, mixed down by the channel center
+    // frequency, and the time spec includes the filter delay
+    auto tone_streamer = channelizer->get_channel_streamer(TONE_CHAN);
+    BOOST_REQUIRE_EQUAL(tone_streamer->recv(&buff.front(), nsamps, md, 0.1), nsamps);
+    BOOST_CHECK_EQUAL(md.error_code, rx_metadata_t::ERROR_CODE_NONE);
+    BOOST_REQUIRE(md.has_time_spec);
+    const double t0 = md.time_spec.get_real_secs();
+    for (size_t i = 100; i < nsamps; i++) {
+        const double phase = 2 * M_PI * TONE_OFFSET * (t0 + i / chan_rate);
+        BOOST_CHECK_SMALL(std::abs(buff[i] - std::polar(1.0f, float(phase))), 1e-2f);
+    }
+
+    // The next call continues where this one stopped
+    BOOST_REQUIRE_EQUAL(tone_streamer->recv(&buff.front(), 10, md, 0.1), 10);
+    BOOST_REQUIRE(md.has_time_spec);
+    BOOST_CHECK_CLOSE(md.time_spec.get_real_secs(), t0 + nsamps / chan_rate, 1e-6);
+
+    // The other channels only see the leakage
+    for (size_t chan = 0; chan < NUM_CHANS; chan++) {
+        if (chan == TONE_CHAN) {
+            continue;
+        }
+        auto streamer = channelizer->get_channel_streamer(chan);
+        BOOST_REQUIRE_EQUAL(streamer->recv(&buff.front(), nsamps, md, 0.1), nsamps);
+        for (size_t i = 100; i < nsamps; i++) {
+            BOOST_CHECK_SMALL(std::abs(buff[i]), 1e-3f);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_channelizer_overflow)
+{
+    auto channelizer = rx_channelizer::make(
+        boost::make_shared<mock_rx_streamer>(), NUM_CHANS, SAMP_RATE, 1, 16, 1000);
+    std::vector<std::complex<float>> buff(500);
+    rx_metadata_t md;
+
+    // Channel 1 is not received, so it overflows while channel 0 is
+    auto streamer0 = channelizer->get_channel_streamer(0);
+    for (size_t i = 0; i < 4; i++) {
+        BOOST_REQUIRE_EQUAL(streamer0->recv(&buff.front(), 500, md, 0.1), 500);
+        BOOST_CHECK_EQUAL(md.error_code, rx_metadata_t::ERROR_CODE_NONE);
+    }
+    auto streamer1 = channelizer->get_channel_streamer(1);
+    BOOST_CHECK_EQUAL(streamer1->recv(&buff.front(), 100, md, 0.1), 0);
+    BOOST_CHECK_EQUAL(md.error_code, rx_metadata_t::ERROR_CODE_OVERFLOW);
+    BOOST_CHECK_EQUAL(streamer1->recv(&buff.front(), 100, md, 0.1), 100);
+    BOOST_CHECK_EQUAL(md.error_code, rx_metadata_t::ERROR_CODE_NONE);
+}
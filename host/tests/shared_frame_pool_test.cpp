@@ -0,0 +1,79 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhdlib/transport/shared_frame_pool.hpp>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace uhd::transport;
+
+BOOST_AUTO_TEST_CASE(test_shared_frame_pool_grows_on_demand)
+{
+    shared_frame_pool pool(1000, 0);
+    BOOST_CHECK_EQUAL(pool.get_num_allocated(), 0);
+
+    std::set<void*> frames;
+    for (size_t i = 0; i < shared_frame_pool::CHUNK_FRAMES + 1; i++) {
+        void* frame = pool.acquire(0.0);
+        BOOST_REQUIRE(frame != nullptr);
+        BOOST_CHECK_EQUAL(reinterpret_cast<size_t>(frame) % 16, 0);
+        frames.insert(frame);
+    }
+    BOOST_CHECK_EQUAL(frames.size(), shared_frame_pool::CHUNK_FRAMES + 1);
+    BOOST_CHECK_EQUAL(pool.get_num_allocated(), 2 * shared_frame_pool::CHUNK_FRAMES);
+    BOOST_CHECK_EQUAL(pool.get_num_free(), shared_frame_pool::CHUNK_FRAMES - 1);
+
+    // Released frames are handed out again before the pool grows
+    for (void* frame : frames) {
+        pool.release(frame);
+    }
+    for (size_t i = 0; i < 2 * shared_frame_pool::CHUNK_FRAMES; i++) {
+        BOOST_CHECK(pool.acquire(0.0) != nullptr);
+    }
+    BOOST_CHECK_EQUAL(pool.get_num_allocated(), 2 * shared_frame_pool::CHUNK_FRAMES);
+}
+
+BOOST_AUTO_TEST_CASE(test_shared_frame_pool_max_frames)
+{
+    shared_frame_pool pool(1000, 3);
+    std::vector<void*> frames;
+    for (size_t i = 0; i < 3; i++) {
+        frames.push_back(pool.acquire(0.0));
+        BOOST_REQUIRE(frames.back() != nullptr);
+    }
+    BOOST_CHECK_EQUAL(pool.get_num_allocated(), 3);
+    BOOST_CHECK(pool.acquire(0.01) == nullptr);
+
+    // A waiting transport gets the next frame that is released
+    std::thread releaser([&pool, &frames]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        pool.release(frames[1]);
+    });
+    BOOST_CHECK(pool.acquire(5.0) == frames[1]);
+    releaser.join();
+    BOOST_CHECK_EQUAL(pool.get_num_allocated(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(test_shared_frame_pool_get)
+{
+    shared_frame_pool::sptr pool = shared_frame_pool::get(1234, 1);
+    BOOST_CHECK_EQUAL(pool->get_frame_size(), 1234);
+    BOOST_CHECK(shared_frame_pool::get(1234, 0) == pool);
+    BOOST_CHECK(shared_frame_pool::get(4321, 0) != pool);
+
+    // The second caller lifted the limit
+    BOOST_CHECK(pool->acquire(0.0) != nullptr);
+    BOOST_CHECK(pool->acquire(0.0) != nullptr);
+
+    // The pool goes away with its last user
+    std::weak_ptr<shared_frame_pool> weak_pool = pool;
+    pool.reset();
+    BOOST_CHECK(weak_pool.expired());
+    BOOST_CHECK_EQUAL(shared_frame_pool::get(1234, 1)->get_num_allocated(), 0);
+}
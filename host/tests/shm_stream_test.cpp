@@ -0,0 +1,177 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/utils/shm_stream.hpp>
+#include <boost/format.hpp>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#ifndef _WIN32
+#    include <unistd.h>
+#endif
+
+using namespace uhd;
+
+namespace {
+
+constexpr size_t NUM_CHANNELS   = 2;
+constexpr size_t SAMPS_PER_SLOT = 16;
+constexpr size_t NUM_SLOTS      = 4;
+
+//! A ring name that doesn't collide with parallel test runs
+std::string get_ring_name(void)
+{
+#ifndef _WIN32
+    return str(boost::format("uhd_shm_stream_test_%d") % getpid());
+#else
+    return "uhd_shm_stream_test";
+#endif
+}
+
+//! Make a publisher, or nothing if the platform has no shared memory
+rx_stream_publisher::sptr make_publisher(void)
+{
+    try {
+        return rx_stream_publisher::make(get_ring_name(),
+            NUM_CHANNELS,
+            sizeof(uint32_t),
+            SAMPS_PER_SLOT,
+            "u32",
+            device_addr_t(str(boost::format("num_slots=%d") % NUM_SLOTS)));
+    } catch (const uhd::not_implemented_error&) {
+        BOOST_TEST_MESSAGE("Shared memory streams not supported, skipping");
+        return rx_stream_publisher::sptr();
+    }
+}
+
+//! Publish a slot where every sample of channel c is value + c
+void publish(rx_stream_publisher& publisher, const uint32_t value, const size_t nsamps)
+{
+    std::vector<void*> buffs;
+    BOOST_REQUIRE_EQUAL(publisher.get_buffs(buffs), SAMPS_PER_SLOT);
+    BOOST_REQUIRE_EQUAL(buffs.size(), NUM_CHANNELS);
+    for (size_t chan = 0; chan < NUM_CHANNELS; chan++) {
+        std::fill_n(static_cast<uint32_t*>(buffs[chan]), nsamps, value + uint32_t(chan));
+    }
+    rx_metadata_t md;
+    md.has_time_spec  = true;
+    md.time_spec      = time_spec_t(value, 0.25);
+    md.start_of_burst = (value == 0);
+    publisher.commit(nsamps, md);
+}
+
+void check_slot(
+    rx_stream_subscriber& subscriber, const uint32_t value, const size_t nsamps)
+{
+    std::vector<const void*> buffs;
+    rx_metadata_t md;
+    BOOST_REQUIRE_EQUAL(subscriber.recv(buffs, md, 0.0), nsamps);
+    BOOST_CHECK_EQUAL(md.error_code, rx_metadata_t::ERROR_CODE_NONE);
+    BOOST_CHECK(md.has_time_spec);
+    BOOST_CHECK_EQUAL(md.time_spec.get_full_secs(), value);
+    BOOST_CHECK_CLOSE(md.time_spec.get_frac_secs(), 0.25, 1e-9);
+    BOOST_CHECK_EQUAL(md.start_of_burst, value == 0);
+    BOOST_REQUIRE_EQUAL(buffs.size(), NUM_CHANNELS);
+    for (size_t chan = 0; chan < NUM_CHANNELS; chan++) {
+        const uint32_t* samps = static_cast<const uint32_t*>(buffs[chan]);
+        for (size_t i = 0; i < nsamps; i++) {
+            BOOST_REQUIRE_EQUAL(samps[i], value + chan);
+        }
+    }
+    BOOST_CHECK(subscriber.release());
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_shm_stream_fan_out)
+{
+    auto publisher = make_publisher();
+    if (not publisher) {
+        return;
+    }
+    auto subscriber1 = rx_stream_subscriber::make(get_ring_name());
+    auto subscriber2 = rx_stream_subscriber::make(get_ring_name());
+    BOOST_CHECK_EQUAL(subscriber1->get_num_channels(), NUM_CHANNELS);
+    BOOST_CHECK_EQUAL(subscriber1->get_item_size(), sizeof(uint32_t));
+    BOOST_CHECK_EQUAL(subscriber1->get_samps_per_slot(), SAMPS_PER_SLOT);
+    BOOST_CHECK_EQUAL(subscriber1->get_format(), "u32");
+
+    std::vector<const void*> buffs;
+    rx_metadata_t md;
+    BOOST_CHECK_EQUAL(subscriber1->recv(buffs, md, 0.01), 0);
+    BOOST_CHECK_EQUAL(md.error_code, rx_metadata_t::ERROR_CODE_TIMEOUT);
+
+    // Every subscriber gets every slot
+    for (uint32_t value = 0; value < 3; value++) {
+        publish(*publisher, value, SAMPS_PER_SLOT - value);
+    }
+    BOOST_CHECK_EQUAL(publisher->get_num_published(), 3);
+    for (uint32_t value = 0; value < 3; value++) {
+        check_slot(*subscriber1, value, SAMPS_PER_SLOT - value);
+    }
+    for (uint32_t value = 0; value < 3; value++) {
+        check_slot(*subscriber2, value, SAMPS_PER_SLOT - value);
+    }
+
+    // A subscriber that opens later starts with the next slot
+    auto subscriber3 = rx_stream_subscriber::make(get_ring_name());
+    publish(*publisher, 3, SAMPS_PER_SLOT);
+    check_slot(*subscriber3, 3, SAMPS_PER_SLOT);
+
+    BOOST_CHECK(not subscriber1->is_closed());
+    publisher.reset();
+    BOOST_CHECK(subscriber1->is_closed());
+    BOOST_CHECK_THROW(rx_stream_subscriber::make(get_ring_name()), uhd::os_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_shm_stream_overflow)
+{
+    auto publisher = make_publisher();
+    if (not publisher) {
+        return;
+    }
+    auto subscriber = rx_stream_subscriber::make(get_ring_name());
+
+    // A slot that is overwritten while it is held is reported by release()
+    publish(*publisher, 0, SAMPS_PER_SLOT);
+    std::vector<const void*> buffs;
+    rx_metadata_t md;
+    BOOST_REQUIRE_EQUAL(subscriber->recv(buffs, md, 0.0), SAMPS_PER_SLOT);
+    for (uint32_t value = 1; value <= NUM_SLOTS; value++) {
+        publish(*publisher, value, SAMPS_PER_SLOT);
+    }
+    BOOST_CHECK(not subscriber->release());
+
+    // Falling a ring behind skips to the newest slot
+    BOOST_CHECK_EQUAL(subscriber->recv(buffs, md, 0.0), 0);
+    BOOST_CHECK_EQUAL(md.error_code, rx_metadata_t::ERROR_CODE_OVERFLOW);
+    check_slot(*subscriber, NUM_SLOTS, SAMPS_PER_SLOT);
+
+    BOOST_CHECK_THROW(publisher->commit(SAMPS_PER_SLOT + 1, md), uhd::value_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_shm_stream_wait)
+{
+    auto publisher = make_publisher();
+    if (not publisher) {
+        return;
+    }
+    auto subscriber = rx_stream_subscriber::make(get_ring_name());
+
+    // A waiting subscriber is woken up by the publisher
+    std::thread publisher_thread([&publisher]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        publish(*publisher, 7, SAMPS_PER_SLOT);
+    });
+    std::vector<const void*> buffs;
+    rx_metadata_t md;
+    BOOST_CHECK_EQUAL(subscriber->recv(buffs, md, 5.0), SAMPS_PER_SLOT);
+    BOOST_CHECK_EQUAL(md.time_spec.get_full_secs(), 7);
+    BOOST_CHECK(subscriber->release());
+    publisher_thread.join();
+}
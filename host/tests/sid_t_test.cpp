@@ -152,4 +152,13 @@ BOOST_AUTO_TEST_CASE(test_sid_t_from_str)
     BOOST_REQUIRE_THROW(sid_t fail_sid("01:02:03:4"), uhd::value_error);
     BOOST_REQUIRE_THROW(sid_t fail_sid("01:02:03:004"), uhd::value_error);
     BOOST_REQUIRE_THROW(sid_t fail_sid("1.2.3.0004"), uhd::value_error);
+    BOOST_REQUIRE_THROW(sid_t fail_sid("1.2>3.4 "), uhd::value_error);
+    BOOST_REQUIRE_THROW(sid_t fail_sid("1:2>3:4"), uhd::value_error);
+    BOOST_REQUIRE_THROW(sid_t fail_sid("0g:02>03:04"), uhd::value_error);
+
+    sid = "0A:fF<20:1b";
+    BOOST_CHECK_EQUAL(sid.get_src_addr(), (uint32_t)0x0a);
+    BOOST_CHECK_EQUAL(sid.get_src_endpoint(), (uint32_t)0xff);
+    BOOST_CHECK_EQUAL(sid.get_dst_addr(), (uint32_t)0x20);
+    BOOST_CHECK_EQUAL(sid.get_dst_endpoint(), (uint32_t)0x1b);
 }
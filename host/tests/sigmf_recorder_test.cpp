@@ -0,0 +1,153 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/utils/sigmf_recorder.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+#include <iterator>
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+constexpr double RATE    = 1e6;
+constexpr size_t SPB     = 1000;
+const char* const EXTS[] = {".sigmf-data", ".sigmf-meta", ".sigmf-idx"};
+
+std::string read_file(const std::string& file)
+{
+    std::ifstream in(file.c_str(), std::ios::binary);
+    return std::string(
+        (std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+}
+
+//! Record SPB samples per stream that start at \p time
+void record(uhd::sigmf_recorder::sptr recorder, const double time)
+{
+    std::vector<void*> buffs;
+    BOOST_REQUIRE(recorder->get_buffs(buffs, 1.0) >= SPB * sizeof(uint32_t));
+    for (void* buff : buffs) {
+        std::fill_n(static_cast<uint32_t*>(buff), SPB, 0x00010002);
+    }
+    uhd::rx_metadata_t metadata;
+    metadata.has_time_spec = true;
+    metadata.time_spec     = uhd::time_spec_t(time);
+    recorder->commit(SPB * sizeof(uint32_t), metadata);
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_sigmf_recorder)
+{
+    std::vector<std::string> bases;
+    for (size_t i = 0; i < 2; i++) {
+        bases.push_back(
+            (fs::temp_directory_path() / fs::unique_path("uhd-sigmf-%%%%-%%%%"))
+                .string());
+    }
+    uhd::sigmf_recorder::info_t info;
+    info.cpu_format  = "sc16";
+    info.rate        = RATE;
+    info.description = "A \"test\"";
+    auto recorder    = uhd::sigmf_recorder::make(
+        bases, info, uhd::device_addr_t("block_size=65536,index_interval=2048"));
+    recorder->set_freq(1e9, 0);
+    recorder->set_freq(1e9, 1);
+
+    record(recorder, 10.0);
+    record(recorder, 10.001);
+    record(recorder, 10.002);
+    // 500 samples are lost in an overflow
+    uhd::rx_metadata_t metadata;
+    metadata.error_code = uhd::rx_metadata_t::ERROR_CODE_OVERFLOW;
+    recorder->commit(0, metadata);
+    record(recorder, 10.0035);
+    // Only stream 0 is retuned
+    recorder->set_freq(2e9, 0);
+    for (size_t i = 0; i < 4; i++) {
+        record(recorder, 10.0045 + i * 0.001);
+    }
+    recorder->close();
+    BOOST_CHECK_EQUAL(recorder->get_num_samps(), 8 * SPB);
+
+    // The data file holds the samples, the metadata the discontinuities
+    BOOST_CHECK_EQUAL(fs::file_size(bases[0] + ".sigmf-data"), 8 * SPB * 4);
+    const std::string meta = read_file(bases[0] + ".sigmf-meta");
+    BOOST_CHECK(meta.find("\"core:datatype\": \"ci16_le\"") != std::string::npos);
+    BOOST_CHECK(
+        meta.find("\"core:description\": \"A \\\"test\\\"\"") != std::string::npos);
+    BOOST_CHECK(meta.find("\"core:sample_start\": 3000, \"core:frequency\": 1000000000")
+                != std::string::npos);
+    BOOST_CHECK(meta.find("\"core:sample_start\": 4000, \"core:frequency\": 2000000000")
+                != std::string::npos);
+    BOOST_CHECK(meta.find("Overflow, 500 samples lost") != std::string::npos);
+    BOOST_CHECK(
+        read_file(bases[1] + ".sigmf-meta").find("2000000000") == std::string::npos);
+
+    // Entries at the start, the overflow, the retune, after index_interval
+    // samples and at the end
+    auto index = uhd::sigmf_index::make(bases[0] + ".sigmf-idx");
+    BOOST_CHECK_EQUAL(index->get_rate(), RATE);
+    BOOST_CHECK_EQUAL(index->get_item_size(), 4);
+    BOOST_REQUIRE_EQUAL(index->get_num_entries(), 5);
+    const uint64_t expected_offsets[] = {0, 3000, 4000, 7000, 8000};
+    const uint32_t expected_flags[]   = {uhd::sigmf_index::INDEX_START,
+        uhd::sigmf_index::INDEX_OVERFLOW | uhd::sigmf_index::INDEX_GAP,
+        uhd::sigmf_index::INDEX_TUNE,
+        0,
+        uhd::sigmf_index::INDEX_END};
+    for (size_t i = 0; i < 5; i++) {
+        const uhd::sigmf_index::entry_t entry = index->get_entry(i);
+        BOOST_CHECK_EQUAL(entry.sample_offset, expected_offsets[i]);
+        BOOST_CHECK_EQUAL(entry.flags, expected_flags[i] | uhd::sigmf_index::INDEX_TIME);
+    }
+    BOOST_CHECK_EQUAL(index->get_entry(2).freq, 2e9);
+    // Stream 1 wasn't retuned, so its periodic entry comes earlier
+    auto index1 = uhd::sigmf_index::make(bases[1] + ".sigmf-idx");
+    BOOST_REQUIRE_EQUAL(index1->get_num_entries(), 4);
+    BOOST_CHECK_EQUAL(index1->get_entry(2).sample_offset, 6000);
+
+    BOOST_CHECK_EQUAL(index->find(uhd::time_spec_t(9.0)), 0);
+    BOOST_CHECK_EQUAL(index->find(uhd::time_spec_t(10.0005)), 500);
+    // In the gap
+    BOOST_CHECK_EQUAL(index->find(uhd::time_spec_t(10.003)), 3000);
+    BOOST_CHECK_EQUAL(index->find(uhd::time_spec_t(10.0036)), 3100);
+    BOOST_CHECK_EQUAL(index->find(uhd::time_spec_t(10.008)), 7500);
+    BOOST_CHECK_EQUAL(index->find(uhd::time_spec_t(100.0)), 8000);
+    BOOST_CHECK_CLOSE(index->get_time(3100).get_real_secs(), 10.0036, 1e-9);
+    BOOST_CHECK_CLOSE(index->get_time(7500).get_real_secs(), 10.008, 1e-9);
+    BOOST_CHECK_THROW(index->get_entry(5), uhd::index_error);
+
+    for (const std::string& base : bases) {
+        for (const char* ext : EXTS) {
+            fs::remove(base + ext);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_sigmf_recorder_invalid)
+{
+    const std::string base =
+        (fs::temp_directory_path() / fs::unique_path("uhd-sigmf-%%%%-%%%%")).string();
+    uhd::sigmf_recorder::info_t info;
+    info.rate       = RATE;
+    info.cpu_format = "sc12";
+    BOOST_CHECK_THROW(uhd::sigmf_recorder::make({base}, info), uhd::value_error);
+
+    // The data file is not an index
+    info.cpu_format = "fc32";
+    auto recorder   = uhd::sigmf_recorder::make({base}, info);
+    record(recorder, 1.0);
+    recorder->close();
+    BOOST_CHECK_THROW(uhd::sigmf_index::make(base + ".sigmf-data"), uhd::value_error);
+    BOOST_CHECK_THROW(uhd::sigmf_index::make(base + ".nonexistent"), uhd::os_error);
+    BOOST_CHECK_EQUAL(uhd::sigmf_index::make(base + ".sigmf-idx")->get_num_entries(), 2);
+    for (const char* ext : EXTS) {
+        fs::remove(base + ext);
+    }
+}
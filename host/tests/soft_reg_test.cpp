@@ -6,6 +6,7 @@
 
 #include <uhd/utils/soft_register.hpp>
 #include <boost/test/unit_test.hpp>
+#include <sstream>
 
 using namespace uhd;
 
@@ -32,3 +33,87 @@ BOOST_AUTO_TEST_CASE(test_soft_reg_field)
     BOOST_CHECK_EQUAL(soft_reg_field::shift(test_reg4), 0);
     BOOST_CHECK_EQUAL(soft_reg_field::mask<size_t>(test_reg4), ~size_t(0) & 0x1FFFFFFFF);
 }
+
+namespace {
+
+//! Records the accesses as a string, e.g. "p32:4=1 m32:[8=2,12=3]"
+class logging_wb_iface : public wb_iface
+{
+public:
+    void poke16(const wb_addr_type addr, const uint16_t data)
+    {
+        log << "p16:" << addr << "=" << data << " ";
+    }
+
+    void poke32(const wb_addr_type addr, const uint32_t data)
+    {
+        log << "p32:" << addr << "=" << data << " ";
+    }
+
+    void multi_poke32(
+        const std::vector<wb_addr_type>& addrs, const std::vector<uint32_t>& data)
+    {
+        log << "m32:[";
+        for (size_t i = 0; i < addrs.size(); i++) {
+            log << (i ? "," : "") << addrs[i] << "=" << data[i];
+        }
+        log << "] ";
+    }
+
+    std::stringstream log;
+};
+
+class test_regmap_t : public soft_regmap_t
+{
+public:
+    UHD_DEFINE_SOFT_REG_FIELD(VALUE, /* width */ 16, /* shift */ 0);
+
+    test_regmap_t()
+        : soft_regmap_t("test")
+        , reg0(0, OPTIMIZED_FLUSH)
+        , reg1(4, OPTIMIZED_FLUSH)
+        , reg2(8, OPTIMIZED_FLUSH)
+        , reg3(12, OPTIMIZED_FLUSH)
+        , reg4(16, OPTIMIZED_FLUSH)
+    {
+        add_to_map(reg0, "reg0");
+        add_to_map(reg1, "reg1");
+        add_to_map(reg2, "reg2");
+        add_to_map(reg3, "reg3");
+        add_to_map(reg4, "reg4");
+    }
+
+    soft_reg32_wo_t reg0;
+    soft_reg32_wo_sync_t reg1;
+    soft_reg16_wo_t reg2;
+    soft_reg32_wo_t reg3;
+    soft_reg32_wo_t reg4;
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_soft_regmap_batched_flush)
+{
+    logging_wb_iface iface;
+    test_regmap_t regmap;
+    regmap.initialize(iface);
+
+    // Consecutive 32-bit writes are batched, the 16-bit write keeps its place
+    regmap.reg0.set(test_regmap_t::VALUE, 1);
+    regmap.reg1.set(test_regmap_t::VALUE, 2);
+    regmap.reg2.set(test_regmap_t::VALUE, 3);
+    regmap.reg3.set(test_regmap_t::VALUE, 4);
+    regmap.reg4.set(test_regmap_t::VALUE, 5);
+    regmap.flush();
+    BOOST_CHECK_EQUAL(iface.log.str(), "m32:[0=1,4=2] p16:8=3 m32:[12=4,16=5] ");
+
+    // Clean registers are skipped
+    iface.log.str("");
+    regmap.flush();
+    BOOST_CHECK_EQUAL(iface.log.str(), "");
+
+    regmap.reg1.set(test_regmap_t::VALUE, 6);
+    regmap.reg4.set(test_regmap_t::VALUE, 7);
+    regmap.flush();
+    BOOST_CHECK_EQUAL(iface.log.str(), "m32:[4=6,16=7] ");
+}
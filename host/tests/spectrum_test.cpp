@@ -0,0 +1,42 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/utils/byteswap.hpp>
+#include <uhdlib/rfnoc/spectrum.hpp>
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+using namespace uhd::rfnoc;
+
+namespace {
+
+//! Pack magnitudes into the I half of sc16 items, like the FFT block does
+std::vector<uint32_t> make_items(const std::vector<uint16_t>& mags, const bool big_endian)
+{
+    std::vector<uint32_t> items;
+    for (const uint16_t mag : mags) {
+        const uint32_t word = uint32_t(mag) << 16;
+        items.push_back(big_endian ? uhd::htonx(word) : uhd::htowx(word));
+    }
+    return items;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_spectrum_magnitudes_to_db)
+{
+    const std::vector<uint16_t> mags{32767, 16384, 3277, 0};
+    for (const bool big_endian : {false, true}) {
+        const auto items = make_items(mags, big_endian);
+        std::vector<float> power_db(mags.size());
+        spectrum_magnitudes_to_db(items.data(), mags.size(), big_endian, power_db.data());
+        BOOST_CHECK_SMALL(power_db[0], 1e-4f);
+        BOOST_CHECK_CLOSE(power_db[1], -6.02f, 0.1);
+        BOOST_CHECK_CLOSE(power_db[2], -20.0f, 0.1);
+        // An empty bin reads like one LSB
+        BOOST_CHECK_CLOSE(power_db[3], -90.31f, 0.1);
+    }
+}
@@ -10,8 +10,13 @@
 #include <boost/bind.hpp>
 #include <boost/shared_array.hpp>
 #include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <complex>
+#include <future>
 #include <list>
+#include <thread>
 #include <vector>
 
 using namespace uhd::transport;
@@ -113,6 +118,75 @@ BOOST_AUTO_TEST_CASE(test_sph_recv_one_channel_normal)
         handler.recv(&buff.front(), buff.size(), metadata, 1.0, true), uhd::io_error);
 }
 
+////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_sph_recv_one_channel_static_dispatch)
+{
+    ////////////////////////////////////////////////////////////////////////
+    uhd::convert::id_type id;
+    id.input_format  = "sc16_item32_be";
+    id.num_inputs    = 1;
+    id.output_format = "fc32";
+    id.num_outputs   = 1;
+
+    mock_zero_copy::sptr xport =
+        boost::make_shared<mock_zero_copy>(vrt::if_packet_info_t::LINK_TYPE_VRLP);
+
+    vrt::if_packet_info_t ifpi;
+    ifpi.packet_type         = vrt::if_packet_info_t::PACKET_TYPE_DATA;
+    ifpi.num_payload_words32 = 0;
+    ifpi.packet_count        = 0;
+    ifpi.sob                 = true;
+    ifpi.eob                 = false;
+    ifpi.has_sid             = false;
+    ifpi.has_cid             = false;
+    ifpi.has_tsi             = true;
+    ifpi.has_tsf             = true;
+    ifpi.tsi                 = 0;
+    ifpi.tsf                 = 0;
+    ifpi.has_tlr             = false;
+
+    static const double TICK_RATE        = 100e6;
+    static const double SAMP_RATE        = 10e6;
+    static const size_t NUM_PKTS_TO_TEST = 30;
+
+    // generate a bunch of packets
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        ifpi.num_payload_words32 = 10 + i % 10;
+        std::vector<uint32_t> data(ifpi.num_payload_words32, 0);
+        xport->push_back_recv_packet(ifpi, data);
+        ifpi.packet_count++;
+        ifpi.tsf += ifpi.num_payload_words32 * size_t(TICK_RATE / SAMP_RATE);
+    }
+
+    // create a receive packet handler that calls the transport directly
+    sph::basic_recv_packet_handler<sph::zero_copy_recv_buff_getter, sph::no_recv_flowctrl>
+        handler(1);
+    handler.set_vrt_unpacker(&uhd::transport::vrt::if_hdr_unpack_be);
+    handler.set_tick_rate(TICK_RATE);
+    handler.set_samp_rate(SAMP_RATE);
+    handler.set_xport_chan_get_buff(0, sph::zero_copy_recv_buff_getter{xport});
+    handler.set_converter(id);
+
+    // check the received packets
+    size_t num_accum_samps = 0;
+    std::vector<std::complex<float>> buff(20);
+    uhd::rx_metadata_t metadata;
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        std::cout << "data check " << i << std::endl;
+        size_t num_samps_ret =
+            handler.recv(&buff.front(), buff.size(), metadata, 1.0, true);
+        BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_NONE);
+        BOOST_CHECK_TS_CLOSE(
+            metadata.time_spec, uhd::time_spec_t::from_ticks(num_accum_samps, SAMP_RATE));
+        BOOST_CHECK_EQUAL(num_samps_ret, 10 + i % 10);
+        num_accum_samps += num_samps_ret;
+    }
+
+    // subsequent receives should be a timeout
+    handler.recv(&buff.front(), buff.size(), metadata, 1.0, true);
+    BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_TIMEOUT);
+}
+
 ////////////////////////////////////////////////////////////////////////
 BOOST_AUTO_TEST_CASE(test_sph_recv_one_channel_sequence_error)
 {
@@ -290,6 +364,12 @@ BOOST_AUTO_TEST_CASE(test_sph_recv_one_channel_inline_message)
         }
     }
 
+    // the recovery ended with the packet after the overflow
+    const uhd::stream_stats_t stats = handler.get_stats();
+    BOOST_CHECK_EQUAL(stats.overflows, 1);
+    BOOST_CHECK_GT(stats.overflow_recovery_ns, 0);
+    BOOST_CHECK_EQUAL(stats.max_overflow_recovery_ns, stats.overflow_recovery_ns);
+
     // subsequent receives should be a timeout
     for (size_t i = 0; i < 3; i++) {
         std::cout << "timeout check " << i << std::endl;
@@ -609,6 +689,109 @@ BOOST_AUTO_TEST_CASE(test_sph_recv_multi_channel_time_error)
         handler.recv(buffs, NUM_SAMPS_PER_BUFF, metadata, 1.0, true), uhd::io_error);
 }
 
+////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_sph_recv_multi_channel_skew)
+{
+    ////////////////////////////////////////////////////////////////////////
+    uhd::convert::id_type id;
+    id.input_format  = "sc16_item32_be";
+    id.num_inputs    = 1;
+    id.output_format = "fc32";
+    id.num_outputs   = 1;
+
+    vrt::if_packet_info_t ifpi;
+    ifpi.packet_type         = vrt::if_packet_info_t::PACKET_TYPE_DATA;
+    ifpi.num_payload_words32 = 10;
+    ifpi.sob                 = false;
+    ifpi.eob                 = false;
+    ifpi.has_sid             = false;
+    ifpi.has_cid             = false;
+    ifpi.has_tsi             = true;
+    ifpi.has_tsf             = true;
+    ifpi.tsi                 = 0;
+    ifpi.has_tlr             = false;
+
+    static const double TICK_RATE          = 100e6;
+    static const double SAMP_RATE          = 10e6;
+    static const size_t TICKS_PER_SAMP     = 10;
+    static const size_t NUM_PKTS_TO_TEST   = 30;
+    static const size_t NUM_SAMPS_PER_BUFF = 20;
+    static const size_t NCHANNELS          = 2;
+    // Channel 1 starts 2.4 packets later, so its packets never start at the
+    // same time as the packets of channel 0
+    static const size_t SKEW_SAMPS = 24;
+
+    std::vector<mock_zero_copy::sptr> xports;
+    for (size_t i = 0; i < NCHANNELS; i++) {
+        xports.push_back(
+            boost::make_shared<mock_zero_copy>(vrt::if_packet_info_t::LINK_TYPE_VRLP));
+    }
+
+    // generate a bunch of packets, every sample holds its time in samples
+    for (size_t ch = 0; ch < NCHANNELS; ch++) {
+        const size_t first_samp = ch * SKEW_SAMPS;
+        for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+            const size_t samp = first_samp + i * ifpi.num_payload_words32;
+            ifpi.packet_count = i;
+            ifpi.tsf          = samp * TICKS_PER_SAMP;
+            std::vector<uint32_t> data(ifpi.num_payload_words32);
+            for (size_t j = 0; j < data.size(); j++) {
+                data[j] = uhd::htonx(uint32_t(samp + j) << 16);
+            }
+            xports[ch]->push_back_recv_packet(ifpi, data);
+        }
+    }
+
+    // create the super receive packet handler
+    sph::recv_packet_handler handler(NCHANNELS);
+    handler.set_vrt_unpacker(&vrt::if_hdr_unpack_be);
+    handler.set_tick_rate(TICK_RATE);
+    handler.set_samp_rate(SAMP_RATE);
+    for (size_t ch = 0; ch < NCHANNELS; ch++) {
+        mock_zero_copy::sptr xport = xports[ch];
+        handler.set_xport_chan_get_buff(
+            ch, [xport](double timeout) { return xport->get_recv_buff(timeout); });
+    }
+    handler.set_converter(id);
+    handler.set_scale_factor(1.0);
+
+    // all samples that both channels have are received, aligned
+    size_t samp = SKEW_SAMPS;
+    std::complex<float> mem[NUM_SAMPS_PER_BUFF * NCHANNELS];
+    std::vector<std::complex<float>*> buffs(NCHANNELS);
+    for (size_t ch = 0; ch < NCHANNELS; ch++) {
+        buffs[ch] = &mem[ch * NUM_SAMPS_PER_BUFF];
+    }
+    uhd::rx_metadata_t metadata;
+    while (samp < NUM_PKTS_TO_TEST * ifpi.num_payload_words32) {
+        std::cout << "data check " << samp << std::endl;
+        const size_t num_samps_ret =
+            handler.recv(buffs, NUM_SAMPS_PER_BUFF, metadata, 1.0, true);
+        BOOST_REQUIRE_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_NONE);
+        BOOST_REQUIRE(num_samps_ret > 0);
+        BOOST_CHECK(metadata.has_time_spec);
+        BOOST_CHECK_TS_CLOSE(
+            metadata.time_spec, uhd::time_spec_t::from_ticks(samp, SAMP_RATE));
+        for (size_t ch = 0; ch < NCHANNELS; ch++) {
+            for (size_t j = 0; j < num_samps_ret; j++) {
+                BOOST_CHECK_EQUAL(buffs[ch][j].real(), float(samp + j));
+            }
+        }
+        samp += num_samps_ret;
+    }
+    BOOST_CHECK_EQUAL(samp, NUM_PKTS_TO_TEST * ifpi.num_payload_words32);
+
+    // the first two packets of channel 0 were dropped, the third was trimmed
+    const uhd::stream_stats_t stats = handler.get_stats();
+    BOOST_CHECK_EQUAL(stats.align_drops, 2);
+    BOOST_CHECK_EQUAL(stats.align_trimmed_samps, SKEW_SAMPS % 10);
+    BOOST_CHECK_EQUAL(stats.max_align_skew_ticks, SKEW_SAMPS * TICKS_PER_SAMP);
+
+    // channel 1 has no partner for its last samples
+    handler.recv(buffs, NUM_SAMPS_PER_BUFF, metadata, 1.0, true);
+    BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_TIMEOUT);
+}
+
 ////////////////////////////////////////////////////////////////////////
 BOOST_AUTO_TEST_CASE(test_sph_recv_multi_channel_exception)
 {
@@ -775,6 +958,9 @@ BOOST_AUTO_TEST_CASE(test_sph_recv_multi_channel_fragment)
         BOOST_CHECK(metadata.has_time_spec);
         BOOST_CHECK_TS_CLOSE(
             metadata.time_spec, uhd::time_spec_t::from_ticks(num_accum_samps, SAMP_RATE));
+        BOOST_CHECK_EQUAL(metadata.time_ticks.tick_rate, TICK_RATE);
+        BOOST_CHECK_EQUAL(metadata.time_ticks.ticks,
+            int64_t(num_accum_samps * size_t(TICK_RATE / SAMP_RATE)));
         BOOST_CHECK_EQUAL(num_samps_ret, i % 10);
         num_accum_samps += num_samps_ret;
     }
@@ -794,3 +980,998 @@ BOOST_AUTO_TEST_CASE(test_sph_recv_multi_channel_fragment)
     BOOST_REQUIRE_THROW(
         handler.recv(buffs, NUM_SAMPS_PER_BUFF, metadata, 1.0, true), uhd::io_error);
 }
+
+////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_sph_recv_multi_channel_convert_threads)
+{
+    ////////////////////////////////////////////////////////////////////////
+    uhd::convert::id_type id;
+    id.input_format  = "sc16_item32_be";
+    id.num_inputs    = 1;
+    id.output_format = "sc16";
+    id.num_outputs   = 1;
+
+    vrt::if_packet_info_t ifpi;
+    ifpi.packet_type         = vrt::if_packet_info_t::PACKET_TYPE_DATA;
+    ifpi.num_payload_words32 = 0;
+    ifpi.packet_count        = 0;
+    ifpi.sob                 = true;
+    ifpi.eob                 = false;
+    ifpi.has_sid             = false;
+    ifpi.has_cid             = false;
+    ifpi.has_tsi             = true;
+    ifpi.has_tsf             = true;
+    ifpi.tsi                 = 0;
+    ifpi.tsf                 = 0;
+    ifpi.has_tlr             = false;
+
+    static const double TICK_RATE          = 100e6;
+    static const double SAMP_RATE          = 10e6;
+    static const size_t NUM_PKTS_TO_TEST   = 30;
+    static const size_t NUM_SAMPS_PER_BUFF = 20;
+    static const size_t NCHANNELS          = 4;
+
+    std::vector<mock_zero_copy::sptr> xports;
+    for (size_t i = 0; i < NCHANNELS; i++) {
+        xports.push_back(
+            boost::make_shared<mock_zero_copy>(vrt::if_packet_info_t::LINK_TYPE_VRLP));
+    }
+
+    // generate a bunch of packets, I is the channel and Q the packet number
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        ifpi.num_payload_words32 = 10 + i % 10;
+        for (size_t ch = 0; ch < NCHANNELS; ch++) {
+            std::vector<uint32_t> data(
+                ifpi.num_payload_words32, uhd::htonx<uint32_t>(((ch + 1) << 16) | i));
+            xports[ch]->push_back_recv_packet(ifpi, data);
+        }
+        ifpi.packet_count++;
+        ifpi.tsf += ifpi.num_payload_words32 * size_t(TICK_RATE / SAMP_RATE);
+    }
+
+    // create the super receive packet handler, convert with 3 threads
+    sph::recv_packet_handler handler(NCHANNELS);
+    handler.set_vrt_unpacker(&vrt::if_hdr_unpack_be);
+    handler.set_tick_rate(TICK_RATE);
+    handler.set_samp_rate(SAMP_RATE);
+    for (size_t ch = 0; ch < NCHANNELS; ch++) {
+        mock_zero_copy::sptr xport = xports[ch];
+        handler.set_xport_chan_get_buff(
+            ch, [xport](double timeout) { return xport->get_recv_buff(timeout); });
+    }
+    handler.set_converter(id);
+    handler.set_convert_threads(3);
+
+    // check the received packets
+    std::complex<int16_t> mem[NUM_SAMPS_PER_BUFF * NCHANNELS];
+    std::vector<std::complex<int16_t>*> buffs(NCHANNELS);
+    for (size_t ch = 0; ch < NCHANNELS; ch++) {
+        buffs[ch] = &mem[ch * NUM_SAMPS_PER_BUFF];
+    }
+    uhd::rx_metadata_t metadata;
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        std::cout << "data check " << i << std::endl;
+        size_t num_samps_ret =
+            handler.recv(buffs, NUM_SAMPS_PER_BUFF, metadata, 1.0, true);
+        BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_NONE);
+        BOOST_REQUIRE_EQUAL(num_samps_ret, 10 + i % 10);
+        for (size_t ch = 0; ch < NCHANNELS; ch++) {
+            for (size_t n = 0; n < num_samps_ret; n++) {
+                BOOST_CHECK_EQUAL(buffs[ch][n].real(), int16_t(ch + 1));
+                BOOST_CHECK_EQUAL(buffs[ch][n].imag(), int16_t(i));
+            }
+        }
+    }
+
+    // subsequent receives should be a timeout
+    handler.recv(buffs, NUM_SAMPS_PER_BUFF, metadata, 1.0, true);
+    BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_TIMEOUT);
+}
+
+BOOST_AUTO_TEST_CASE(test_sph_recv_multi_channel_align_batch)
+{
+    ////////////////////////////////////////////////////////////////////////
+    uhd::convert::id_type id;
+    id.input_format  = "sc16_item32_be";
+    id.num_inputs    = 1;
+    id.output_format = "sc16";
+    id.num_outputs   = 1;
+
+    vrt::if_packet_info_t ifpi;
+    ifpi.packet_type         = vrt::if_packet_info_t::PACKET_TYPE_DATA;
+    ifpi.num_payload_words32 = 0;
+    ifpi.packet_count        = 0;
+    ifpi.sob                 = true;
+    ifpi.eob                 = false;
+    ifpi.has_sid             = false;
+    ifpi.has_cid             = false;
+    ifpi.has_tsi             = true;
+    ifpi.has_tsf             = true;
+    ifpi.tsi                 = 0;
+    ifpi.tsf                 = 0;
+    ifpi.has_tlr             = false;
+
+    static const double TICK_RATE          = 100e6;
+    static const double SAMP_RATE          = 10e6;
+    static const size_t NUM_PKTS_TO_TEST   = 30;
+    static const size_t NUM_SAMPS_PER_BUFF = 20;
+    static const size_t NCHANNELS          = 4;
+    static const size_t LOST_PKT           = 15; // in the middle of a batch
+
+    std::vector<mock_zero_copy::sptr> xports;
+    for (size_t i = 0; i < NCHANNELS; i++) {
+        xports.push_back(
+            boost::make_shared<mock_zero_copy>(vrt::if_packet_info_t::LINK_TYPE_VRLP));
+    }
+
+    // generate a bunch of packets, I is the channel and Q the packet number
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        ifpi.num_payload_words32 = 10 + i % 10;
+        for (size_t ch = 0; ch < NCHANNELS; ch++) {
+            if (i == LOST_PKT and ch == 2) {
+                continue; // simulates a lost packet
+            }
+            std::vector<uint32_t> data(
+                ifpi.num_payload_words32, uhd::htonx<uint32_t>(((ch + 1) << 16) | i));
+            xports[ch]->push_back_recv_packet(ifpi, data);
+        }
+        ifpi.packet_count++;
+        ifpi.tsf += ifpi.num_payload_words32 * size_t(TICK_RATE / SAMP_RATE);
+    }
+
+    // create the super receive packet handler, align 4 packets at once
+    sph::recv_packet_handler handler(NCHANNELS);
+    handler.set_vrt_unpacker(&vrt::if_hdr_unpack_be);
+    handler.set_tick_rate(TICK_RATE);
+    handler.set_samp_rate(SAMP_RATE);
+    for (size_t ch = 0; ch < NCHANNELS; ch++) {
+        mock_zero_copy::sptr xport = xports[ch];
+        handler.set_xport_chan_get_buff(
+            ch, [xport](double timeout) { return xport->get_recv_buff(timeout); });
+    }
+    handler.set_converter(id);
+    handler.set_alignment_batch_size(4);
+
+    // check the received packets
+    size_t num_accum_samps = 0;
+    std::complex<int16_t> mem[NUM_SAMPS_PER_BUFF * NCHANNELS];
+    std::vector<std::complex<int16_t>*> buffs(NCHANNELS);
+    for (size_t ch = 0; ch < NCHANNELS; ch++) {
+        buffs[ch] = &mem[ch * NUM_SAMPS_PER_BUFF];
+    }
+    uhd::rx_metadata_t metadata;
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        std::cout << "data check " << i << std::endl;
+        size_t num_samps_ret =
+            handler.recv(buffs, NUM_SAMPS_PER_BUFF, metadata, 1.0, true);
+        BOOST_CHECK_TS_CLOSE(metadata.time_spec,
+            uhd::time_spec_t::from_ticks(num_accum_samps, SAMP_RATE));
+        if (i == LOST_PKT) {
+            // must get the soft overflow here
+            BOOST_REQUIRE(metadata.error_code == uhd::rx_metadata_t::ERROR_CODE_OVERFLOW);
+            BOOST_REQUIRE(metadata.out_of_sequence == true);
+            num_accum_samps += 10 + i % 10;
+            continue;
+        }
+        BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_NONE);
+        BOOST_CHECK(not metadata.more_fragments);
+        BOOST_CHECK(metadata.has_time_spec);
+        BOOST_REQUIRE_EQUAL(num_samps_ret, 10 + i % 10);
+        for (size_t ch = 0; ch < NCHANNELS; ch++) {
+            for (size_t n = 0; n < num_samps_ret; n++) {
+                BOOST_CHECK_EQUAL(buffs[ch][n].real(), int16_t(ch + 1));
+                BOOST_CHECK_EQUAL(buffs[ch][n].imag(), int16_t(i));
+            }
+        }
+        num_accum_samps += num_samps_ret;
+    }
+
+    // subsequent receives should be a timeout
+    for (size_t i = 0; i < 3; i++) {
+        std::cout << "timeout check " << i << std::endl;
+        handler.recv(buffs, NUM_SAMPS_PER_BUFF, metadata, 1.0, true);
+        BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_TIMEOUT);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_sph_recv_multi_channel_align_batch_chdr)
+{
+    ////////////////////////////////////////////////////////////////////////
+    uhd::convert::id_type id;
+    id.input_format  = "sc16_item32_be";
+    id.num_inputs    = 1;
+    id.output_format = "sc16";
+    id.num_outputs   = 1;
+
+    vrt::if_packet_info_t ifpi;
+    ifpi.link_type           = vrt::if_packet_info_t::LINK_TYPE_CHDR;
+    ifpi.packet_type         = vrt::if_packet_info_t::PACKET_TYPE_DATA;
+    ifpi.num_payload_words32 = 0;
+    ifpi.packet_count        = 0;
+    ifpi.eob                 = false;
+    ifpi.has_sid             = true;
+    ifpi.sid                 = 0x12340000;
+    ifpi.has_tsf             = true;
+    ifpi.tsf                 = 0;
+
+    static const double TICK_RATE          = 100e6;
+    static const double SAMP_RATE          = 10e6;
+    static const size_t NUM_PKTS_TO_TEST   = 30;
+    static const size_t NUM_SAMPS_PER_BUFF = 20;
+    static const size_t NCHANNELS          = 4;
+    static const size_t LOST_PKT           = 15; // in the middle of a batch
+    static const size_t FC_WINDOW          = 1;
+
+    std::vector<mock_zero_copy::sptr> xports;
+    for (size_t i = 0; i < NCHANNELS; i++) {
+        xports.push_back(
+            boost::make_shared<mock_zero_copy>(vrt::if_packet_info_t::LINK_TYPE_CHDR));
+    }
+
+    // generate a bunch of packets, I is the channel and Q the packet number
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        ifpi.num_payload_words32 = 10 + i % 10;
+        ifpi.num_payload_bytes   = ifpi.num_payload_words32 * sizeof(uint32_t);
+        for (size_t ch = 0; ch < NCHANNELS; ch++) {
+            if (i == LOST_PKT and ch == 2) {
+                continue; // simulates a lost packet
+            }
+            std::vector<uint32_t> data(
+                ifpi.num_payload_words32, uhd::htonx<uint32_t>(((ch + 1) << 16) | i));
+            xports[ch]->push_back_recv_packet(ifpi, data);
+        }
+        ifpi.packet_count++;
+        ifpi.tsf += ifpi.num_payload_words32 * size_t(TICK_RATE / SAMP_RATE);
+    }
+
+    // create the super receive packet handler, align 4 packets at once and
+    // unpack the headers of the staged packets in one go
+    sph::recv_packet_handler handler(NCHANNELS);
+    handler.set_vrt_unpacker(&vrt::chdr::if_hdr_unpack_be);
+    handler.set_vrt_batch_unpacker(&vrt::chdr::if_hdr_unpack_batch_be);
+    handler.set_tick_rate(TICK_RATE);
+    handler.set_samp_rate(SAMP_RATE);
+    std::vector<size_t> fc_seqs[NCHANNELS];
+    for (size_t ch = 0; ch < NCHANNELS; ch++) {
+        mock_zero_copy::sptr xport = xports[ch];
+        handler.set_xport_chan_get_buff(
+            ch, [xport](double timeout) { return xport->get_recv_buff(timeout); });
+        std::vector<size_t>* seqs = &fc_seqs[ch];
+        handler.set_xport_handle_flowctrl(
+            ch, [seqs](const size_t seq) { seqs->push_back(seq); }, FC_WINDOW);
+    }
+    handler.set_converter(id);
+    handler.set_alignment_batch_size(4);
+
+    // check the received packets
+    size_t num_accum_samps = 0;
+    std::complex<int16_t> mem[NUM_SAMPS_PER_BUFF * NCHANNELS];
+    std::vector<std::complex<int16_t>*> buffs(NCHANNELS);
+    for (size_t ch = 0; ch < NCHANNELS; ch++) {
+        buffs[ch] = &mem[ch * NUM_SAMPS_PER_BUFF];
+    }
+    uhd::rx_metadata_t metadata;
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        std::cout << "data check " << i << std::endl;
+        size_t num_samps_ret =
+            handler.recv(buffs, NUM_SAMPS_PER_BUFF, metadata, 1.0, true);
+        BOOST_CHECK_EQUAL(metadata.time_ticks.ticks,
+            int64_t(num_accum_samps * size_t(TICK_RATE / SAMP_RATE)));
+        if (i == LOST_PKT) {
+            // must get the soft overflow here
+            BOOST_REQUIRE(metadata.error_code == uhd::rx_metadata_t::ERROR_CODE_OVERFLOW);
+            BOOST_REQUIRE(metadata.out_of_sequence == true);
+            num_accum_samps += 10 + i % 10;
+            continue;
+        }
+        BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_NONE);
+        BOOST_CHECK(metadata.has_time_spec);
+        BOOST_REQUIRE_EQUAL(num_samps_ret, 10 + i % 10);
+        for (size_t ch = 0; ch < NCHANNELS; ch++) {
+            for (size_t n = 0; n < num_samps_ret; n++) {
+                BOOST_CHECK_EQUAL(buffs[ch][n].real(), int16_t(ch + 1));
+                BOOST_CHECK_EQUAL(buffs[ch][n].imag(), int16_t(i));
+            }
+        }
+        num_accum_samps += num_samps_ret;
+    }
+
+    // flow control saw the last completed window, but only once per staged batch
+    for (size_t ch = 0; ch < NCHANNELS; ch++) {
+        BOOST_REQUIRE(not fc_seqs[ch].empty());
+        BOOST_CHECK_EQUAL(
+            *std::max_element(fc_seqs[ch].begin(), fc_seqs[ch].end()), 29);
+        BOOST_CHECK_LT(fc_seqs[ch].size(), NUM_PKTS_TO_TEST / FC_WINDOW);
+    }
+
+    // subsequent receives should be a timeout
+    handler.recv(buffs, NUM_SAMPS_PER_BUFF, metadata, 1.0, true);
+    BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_TIMEOUT);
+}
+
+BOOST_AUTO_TEST_CASE(test_sph_recv_multi_channel_interleaved)
+{
+    ////////////////////////////////////////////////////////////////////////
+    static const size_t NCHANNELS = 4;
+
+    uhd::convert::id_type id;
+    id.input_format  = "sc16_item32_be";
+    id.num_inputs    = NCHANNELS;
+    id.output_format = "sc16";
+    id.num_outputs   = 1;
+
+    vrt::if_packet_info_t ifpi;
+    ifpi.packet_type         = vrt::if_packet_info_t::PACKET_TYPE_DATA;
+    ifpi.num_payload_words32 = 0;
+    ifpi.packet_count        = 0;
+    ifpi.sob                 = true;
+    ifpi.eob                 = false;
+    ifpi.has_sid             = false;
+    ifpi.has_cid             = false;
+    ifpi.has_tsi             = true;
+    ifpi.has_tsf             = true;
+    ifpi.tsi                 = 0;
+    ifpi.tsf                 = 0;
+    ifpi.has_tlr             = false;
+
+    static const double TICK_RATE          = 100e6;
+    static const double SAMP_RATE          = 10e6;
+    static const size_t NUM_PKTS_TO_TEST   = 30;
+    static const size_t NUM_SAMPS_PER_BUFF = 25;
+
+    std::vector<mock_zero_copy::sptr> xports;
+    for (size_t i = 0; i < NCHANNELS; i++) {
+        xports.push_back(
+            boost::make_shared<mock_zero_copy>(vrt::if_packet_info_t::LINK_TYPE_VRLP));
+    }
+
+    // generate a bunch of packets, I is the channel and Q the packet number
+    std::vector<int16_t> expected_pkt;
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        ifpi.num_payload_words32 = 10 + i % 10;
+        for (size_t ch = 0; ch < NCHANNELS; ch++) {
+            std::vector<uint32_t> data(
+                ifpi.num_payload_words32, uhd::htonx<uint32_t>(((ch + 1) << 16) | i));
+            xports[ch]->push_back_recv_packet(ifpi, data);
+        }
+        expected_pkt.insert(expected_pkt.end(), ifpi.num_payload_words32, int16_t(i));
+        ifpi.packet_count++;
+        ifpi.tsf += ifpi.num_payload_words32 * size_t(TICK_RATE / SAMP_RATE);
+    }
+
+    // create the super receive packet handler with a single output buffer
+    sph::recv_packet_handler handler(NCHANNELS);
+    handler.set_vrt_unpacker(&vrt::if_hdr_unpack_be);
+    handler.set_tick_rate(TICK_RATE);
+    handler.set_samp_rate(SAMP_RATE);
+    for (size_t ch = 0; ch < NCHANNELS; ch++) {
+        mock_zero_copy::sptr xport = xports[ch];
+        handler.set_xport_chan_get_buff(
+            ch, [xport](double timeout) { return xport->get_recv_buff(timeout); });
+    }
+    handler.set_converter(id);
+
+    // check the received samples, buffers span several packets
+    std::complex<int16_t> mem[NUM_SAMPS_PER_BUFF * NCHANNELS];
+    std::vector<std::complex<int16_t>*> buffs(1, mem);
+    uhd::rx_metadata_t metadata;
+    size_t total_samps = 0;
+    while (total_samps < expected_pkt.size()) {
+        std::cout << "data check " << total_samps << std::endl;
+        const size_t num_samps_ret =
+            handler.recv(buffs, NUM_SAMPS_PER_BUFF, metadata, 1.0, false);
+        BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_NONE);
+        BOOST_REQUIRE(num_samps_ret > 0);
+        BOOST_REQUIRE(total_samps + num_samps_ret <= expected_pkt.size());
+        for (size_t n = 0; n < num_samps_ret; n++) {
+            for (size_t ch = 0; ch < NCHANNELS; ch++) {
+                BOOST_CHECK_EQUAL(mem[n * NCHANNELS + ch].real(), int16_t(ch + 1));
+                BOOST_CHECK_EQUAL(
+                    mem[n * NCHANNELS + ch].imag(), expected_pkt[total_samps + n]);
+            }
+        }
+        total_samps += num_samps_ret;
+    }
+
+    // subsequent receives should be a timeout
+    handler.recv(buffs, NUM_SAMPS_PER_BUFF, metadata, 1.0, true);
+    BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_TIMEOUT);
+
+    // the number of converter inputs has to match the number of channels
+    id.num_inputs = 2;
+    BOOST_CHECK_THROW(handler.set_converter(id), uhd::value_error);
+}
+
+////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_sph_recv_multi_channel_segments)
+{
+    ////////////////////////////////////////////////////////////////////////
+    static const size_t NCHANNELS = 2;
+
+    vrt::if_packet_info_t ifpi;
+    ifpi.packet_type         = vrt::if_packet_info_t::PACKET_TYPE_DATA;
+    ifpi.num_payload_words32 = 0;
+    ifpi.packet_count        = 0;
+    ifpi.sob                 = true;
+    ifpi.eob                 = false;
+    ifpi.has_sid             = false;
+    ifpi.has_cid             = false;
+    ifpi.has_tsi             = true;
+    ifpi.has_tsf             = true;
+    ifpi.tsi                 = 0;
+    ifpi.tsf                 = 0;
+    ifpi.has_tlr             = false;
+
+    static const double TICK_RATE        = 100e6;
+    static const double SAMP_RATE        = 10e6;
+    static const size_t NUM_PKTS_TO_TEST = 30;
+
+    // Once per channel, then once interleaved into a single buffer
+    for (const bool interleave : {false, true}) {
+        uhd::convert::id_type id;
+        id.input_format  = "sc16_item32_be";
+        id.num_inputs    = interleave ? NCHANNELS : 1;
+        id.output_format = "sc16";
+        id.num_outputs   = 1;
+
+        ifpi.packet_count = 0;
+        ifpi.tsf          = 0;
+
+        std::vector<mock_zero_copy::sptr> xports;
+        for (size_t i = 0; i < NCHANNELS; i++) {
+            xports.push_back(boost::make_shared<mock_zero_copy>(
+                vrt::if_packet_info_t::LINK_TYPE_VRLP));
+        }
+
+        // generate a bunch of packets, I is the channel and Q the packet number
+        std::vector<int16_t> expected_pkt;
+        for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+            ifpi.num_payload_words32 = 10 + i % 10;
+            for (size_t ch = 0; ch < NCHANNELS; ch++) {
+                std::vector<uint32_t> data(ifpi.num_payload_words32,
+                    uhd::htonx<uint32_t>(((ch + 1) << 16) | i));
+                xports[ch]->push_back_recv_packet(ifpi, data);
+            }
+            expected_pkt.insert(expected_pkt.end(), ifpi.num_payload_words32, int16_t(i));
+            ifpi.packet_count++;
+            ifpi.tsf += ifpi.num_payload_words32 * size_t(TICK_RATE / SAMP_RATE);
+        }
+
+        sph::recv_packet_streamer streamer(20);
+        streamer.resize(NCHANNELS);
+        streamer.set_vrt_unpacker(&vrt::if_hdr_unpack_be);
+        streamer.set_tick_rate(TICK_RATE);
+        streamer.set_samp_rate(SAMP_RATE);
+        for (size_t ch = 0; ch < NCHANNELS; ch++) {
+            mock_zero_copy::sptr xport = xports[ch];
+            streamer.set_xport_chan_get_buff(
+                ch, [xport](double timeout) { return xport->get_recv_buff(timeout); });
+        }
+        streamer.set_converter(id);
+        uhd::rx_streamer& rx_stream = streamer;
+
+        // Segments that split packets, including an empty one. The second
+        // buffer is larger, only as many samples as the first one holds are
+        // received.
+        const std::vector<std::vector<size_t>> segment_sizes = {
+            {7, 0, 13, 5, 40}, {3, 3, 3, 100}};
+        const size_t num_buffs      = interleave ? 1 : NCHANNELS;
+        const size_t samps_per_item = interleave ? NCHANNELS : 1;
+        std::vector<std::vector<std::complex<int16_t>>> mem(num_buffs);
+        uhd::rx_streamer::segments_type segments(num_buffs);
+        for (size_t b = 0; b < num_buffs; b++) {
+            for (const size_t nsamps : segment_sizes[b]) {
+                mem[b].resize(mem[b].size() + nsamps * samps_per_item);
+            }
+            size_t offset = 0;
+            for (const size_t nsamps : segment_sizes[b]) {
+                segments[b].push_back({&mem[b][offset], nsamps});
+                offset += nsamps * samps_per_item;
+            }
+        }
+
+        uhd::rx_metadata_t metadata;
+        size_t total_samps = 0;
+        while (total_samps < expected_pkt.size()) {
+            std::cout << "data check " << total_samps << std::endl;
+            std::fill(mem[0].begin(), mem[0].end(), std::complex<int16_t>());
+            const size_t num_samps_ret = rx_stream.recv_segments(segments, metadata, 1.0);
+            BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_NONE);
+            BOOST_REQUIRE(num_samps_ret > 0);
+            BOOST_REQUIRE(num_samps_ret <= 65);
+            BOOST_REQUIRE(total_samps + num_samps_ret <= expected_pkt.size());
+            // The segments lie back to back in mem
+            for (size_t b = 0; b < num_buffs; b++) {
+                for (size_t n = 0; n < num_samps_ret * samps_per_item; n++) {
+                    const size_t ch = interleave ? n % NCHANNELS : b;
+                    BOOST_CHECK_EQUAL(mem[b][n].real(), int16_t(ch + 1));
+                    BOOST_CHECK_EQUAL(mem[b][n].imag(),
+                        expected_pkt[total_samps + n / samps_per_item]);
+                }
+            }
+            total_samps += num_samps_ret;
+        }
+
+        // subsequent receives should be a timeout
+        rx_stream.recv_segments(segments, metadata, 1.0, true);
+        BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_TIMEOUT);
+
+        // one list of segments per buffer
+        segments.push_back(segments.front());
+        BOOST_CHECK_THROW(
+            rx_stream.recv_segments(segments, metadata, 1.0), uhd::value_error);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_sph_recv_multi_channel_raw)
+{
+    ////////////////////////////////////////////////////////////////////////
+    uhd::convert::id_type id;
+    id.input_format  = "sc16_item32_be";
+    id.num_inputs    = 1;
+    id.output_format = "sc16";
+    id.num_outputs   = 1;
+
+    vrt::if_packet_info_t ifpi;
+    ifpi.packet_type         = vrt::if_packet_info_t::PACKET_TYPE_DATA;
+    ifpi.num_payload_words32 = 0;
+    ifpi.packet_count        = 0;
+    ifpi.sob                 = true;
+    ifpi.eob                 = false;
+    ifpi.has_sid             = false;
+    ifpi.has_cid             = false;
+    ifpi.has_tsi             = true;
+    ifpi.has_tsf             = true;
+    ifpi.tsi                 = 0;
+    ifpi.tsf                 = 0;
+    ifpi.has_tlr             = false;
+
+    static const double TICK_RATE        = 100e6;
+    static const double SAMP_RATE        = 10e6;
+    static const size_t NUM_PKTS_TO_TEST = 10;
+    static const size_t NCHANNELS        = 2;
+
+    std::vector<mock_zero_copy::sptr> xports;
+    for (size_t i = 0; i < NCHANNELS; i++) {
+        xports.push_back(
+            boost::make_shared<mock_zero_copy>(vrt::if_packet_info_t::LINK_TYPE_VRLP));
+    }
+
+    // generate a bunch of packets, the payload word is channel and packet number
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        ifpi.num_payload_words32 = 10 + i % 10;
+        for (size_t ch = 0; ch < NCHANNELS; ch++) {
+            std::vector<uint32_t> data(
+                ifpi.num_payload_words32, uhd::htonx<uint32_t>(((ch + 1) << 16) | i));
+            xports[ch]->push_back_recv_packet(ifpi, data);
+        }
+        ifpi.packet_count++;
+        ifpi.tsf += ifpi.num_payload_words32 * size_t(TICK_RATE / SAMP_RATE);
+    }
+
+    // create the super receive packet handler
+    sph::recv_packet_handler handler(NCHANNELS);
+    handler.set_vrt_unpacker(&vrt::if_hdr_unpack_be);
+    handler.set_tick_rate(TICK_RATE);
+    handler.set_samp_rate(SAMP_RATE);
+    for (size_t ch = 0; ch < NCHANNELS; ch++) {
+        mock_zero_copy::sptr xport = xports[ch];
+        handler.set_xport_chan_get_buff(
+            ch, [xport](double timeout) { return xport->get_recv_buff(timeout); });
+    }
+    handler.set_converter(id);
+
+    // consume part of the first packet with a regular recv
+    std::vector<std::complex<int16_t>> mem(4 * NCHANNELS);
+    std::vector<std::complex<int16_t>*> buffs(NCHANNELS);
+    for (size_t ch = 0; ch < NCHANNELS; ch++) {
+        buffs[ch] = &mem[ch * 4];
+    }
+    uhd::rx_metadata_t metadata;
+    BOOST_CHECK_EQUAL(handler.recv(buffs, 4, metadata, 1.0, true), 4);
+    BOOST_CHECK(metadata.more_fragments);
+
+    // the rest of the packets come without conversion
+    std::vector<const void*> raw_buffs;
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        std::cout << "data check " << i << std::endl;
+        const size_t num_samps_ret = handler.recv_raw(raw_buffs, metadata, 1.0);
+        BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_NONE);
+        BOOST_CHECK(not metadata.more_fragments);
+        BOOST_CHECK_EQUAL(metadata.fragment_offset, (i == 0) ? 4 : 0);
+        BOOST_REQUIRE_EQUAL(num_samps_ret, 10 + i % 10 - ((i == 0) ? 4 : 0));
+        BOOST_REQUIRE_EQUAL(raw_buffs.size(), NCHANNELS);
+        for (size_t ch = 0; ch < NCHANNELS; ch++) {
+            const uint32_t* words = reinterpret_cast<const uint32_t*>(raw_buffs[ch]);
+            for (size_t n = 0; n < num_samps_ret; n++) {
+                BOOST_CHECK_EQUAL(uhd::ntohx(words[n]), ((ch + 1) << 16) | i);
+            }
+        }
+        handler.release_raw();
+    }
+
+    // subsequent receives should be a timeout
+    BOOST_CHECK_EQUAL(handler.recv_raw(raw_buffs, metadata, 1.0), 0);
+    BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_TIMEOUT);
+}
+
+////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_sph_recv_host_time)
+{
+    ////////////////////////////////////////////////////////////////////////
+    uhd::convert::id_type id;
+    id.input_format  = "sc16_item32_be";
+    id.num_inputs    = 1;
+    id.output_format = "fc32";
+    id.num_outputs   = 1;
+
+    mock_zero_copy xport(vrt::if_packet_info_t::LINK_TYPE_VRLP);
+
+    vrt::if_packet_info_t ifpi;
+    ifpi.packet_type         = vrt::if_packet_info_t::PACKET_TYPE_DATA;
+    ifpi.num_payload_words32 = 10;
+    ifpi.packet_count        = 0;
+    ifpi.sob                 = true;
+    ifpi.eob                 = false;
+    ifpi.has_sid             = false;
+    ifpi.has_cid             = false;
+    ifpi.has_tsi             = true;
+    ifpi.has_tsf             = true;
+    ifpi.tsi                 = 0;
+    ifpi.tsf                 = 0;
+    ifpi.has_tlr             = false;
+
+    static const double TICK_RATE        = 100e6;
+    static const double SAMP_RATE        = 10e6;
+    static const size_t NUM_PKTS_TO_TEST = 3;
+    // 2020-01-01 00:00:00.000000500, plus one microsecond per packet
+    static const uint64_t FIRST_STAMP_NS = 1577836800000000500ull;
+
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        std::vector<uint32_t> data(ifpi.num_payload_words32, 0);
+        xport.push_back_recv_packet(ifpi, data);
+        ifpi.packet_count++;
+        ifpi.tsf += ifpi.num_payload_words32 * size_t(TICK_RATE / SAMP_RATE);
+    }
+
+    uhd::transport::sph::recv_packet_handler handler(1);
+    handler.set_vrt_unpacker(&uhd::transport::vrt::if_hdr_unpack_be);
+    handler.set_tick_rate(TICK_RATE);
+    handler.set_samp_rate(SAMP_RATE);
+    // Stamp the packets like a transport which captures arrival times; the
+    // last one has no time stamp
+    size_t num_stamped = 0;
+    handler.set_xport_chan_get_buff(0, [&xport, &num_stamped](double timeout) {
+        managed_recv_buffer::sptr buff = xport.get_recv_buff(timeout);
+        if (buff and num_stamped < NUM_PKTS_TO_TEST - 1) {
+            buff->set_rx_timestamp(FIRST_STAMP_NS + 1000 * num_stamped++);
+        }
+        return buff;
+    });
+    handler.set_converter(id);
+
+    std::vector<std::complex<float>> buff(10);
+    uhd::rx_metadata_t metadata;
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        BOOST_CHECK_EQUAL(handler.recv(&buff.front(), buff.size(), metadata, 1.0, true),
+            buff.size());
+        if (i == NUM_PKTS_TO_TEST - 1) {
+            BOOST_CHECK(not metadata.has_host_time_spec);
+            continue;
+        }
+        BOOST_CHECK(metadata.has_host_time_spec);
+        BOOST_CHECK_EQUAL(metadata.host_time_spec.get_full_secs(), 1577836800);
+        BOOST_CHECK_CLOSE(
+            metadata.host_time_spec.get_frac_secs(), 500e-9 + i * 1e-6, 0.001);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_sph_recv_deadline)
+{
+    ////////////////////////////////////////////////////////////////////////
+    uhd::convert::id_type id;
+    id.input_format  = "sc16_item32_be";
+    id.num_inputs    = 1;
+    id.output_format = "fc32";
+    id.num_outputs   = 1;
+
+    mock_zero_copy xport(vrt::if_packet_info_t::LINK_TYPE_VRLP);
+
+    vrt::if_packet_info_t ifpi;
+    ifpi.packet_type         = vrt::if_packet_info_t::PACKET_TYPE_DATA;
+    ifpi.num_payload_words32 = 10;
+    ifpi.packet_count        = 0;
+    ifpi.sob                 = true;
+    ifpi.eob                 = false;
+    ifpi.has_sid             = false;
+    ifpi.has_cid             = false;
+    ifpi.has_tsi             = true;
+    ifpi.has_tsf             = true;
+    ifpi.tsi                 = 0;
+    ifpi.tsf                 = 0;
+    ifpi.has_tlr             = false;
+
+    static const double TICK_RATE        = 100e6;
+    static const double SAMP_RATE        = 10e6;
+    static const size_t NUM_PKTS_TO_TEST = 3;
+    static const double TIMEOUT          = 0.015;
+
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        std::vector<uint32_t> data(ifpi.num_payload_words32, 0);
+        xport.push_back_recv_packet(ifpi, data);
+        ifpi.packet_count++;
+        ifpi.tsf += ifpi.num_payload_words32 * size_t(TICK_RATE / SAMP_RATE);
+    }
+
+    uhd::transport::sph::recv_packet_handler handler(1);
+    handler.set_vrt_unpacker(&uhd::transport::vrt::if_hdr_unpack_be);
+    handler.set_tick_rate(TICK_RATE);
+    handler.set_samp_rate(SAMP_RATE);
+    // Every packet takes 10 ms to arrive, so the third one comes after the
+    // timeout of the call
+    std::vector<double> timeouts;
+    handler.set_xport_chan_get_buff(0, [&xport, &timeouts](double timeout) {
+        timeouts.push_back(timeout);
+        managed_recv_buffer::sptr buff = xport.get_recv_buff(timeout);
+        if (buff) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return buff;
+    });
+    handler.set_converter(id);
+
+    // The packets that arrived are received, but every wait only gets what
+    // is left of the timeout of the call
+    std::vector<std::complex<float>> buff(40);
+    uhd::rx_metadata_t metadata;
+    BOOST_CHECK_EQUAL(handler.recv(&buff.front(), buff.size(), metadata, TIMEOUT, false),
+        NUM_PKTS_TO_TEST * 10);
+    BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_NONE);
+    BOOST_REQUIRE_EQUAL(timeouts.size(), NUM_PKTS_TO_TEST + 1);
+    BOOST_CHECK(timeouts[0] > 0.0 and timeouts[0] <= TIMEOUT);
+    BOOST_CHECK(timeouts[1] < TIMEOUT - 0.009);
+    BOOST_CHECK_EQUAL(timeouts[2], 0.0);
+    BOOST_CHECK_EQUAL(timeouts[3], 0.0);
+    BOOST_CHECK_EQUAL(handler.get_stats().timeouts, 1);
+}
+
+/***********************************************************************
+ * Test stream commands that go to several control endpoints
+ **********************************************************************/
+BOOST_AUTO_TEST_CASE(test_sph_recv_issue_stream_cmd_groups)
+{
+    const size_t NCHANNELS = 4;
+    sph::recv_packet_handler handler(NCHANNELS);
+
+    // Channels 0 and 1 are on one motherboard, 2 and 3 on another. Channel 0
+    // only returns once channel 2 got its command, which needs concurrency.
+    std::promise<void> chan2_issued;
+    std::shared_future<void> chan2_issued_future = chan2_issued.get_future().share();
+    std::vector<size_t> order[2];
+    bool concurrent = false;
+    for (size_t chan = 0; chan < NCHANNELS; chan++) {
+        const size_t group = chan / 2;
+        handler.set_issue_stream_cmd(chan,
+            [&, chan, group](const uhd::stream_cmd_t&) {
+                order[group].push_back(chan);
+                if (chan == 0) {
+                    concurrent = chan2_issued_future.wait_for(std::chrono::seconds(5))
+                                 == std::future_status::ready;
+                } else if (chan == 2) {
+                    chan2_issued.set_value();
+                }
+            },
+            group);
+    }
+
+    uhd::stream_cmd_t stream_cmd(uhd::stream_cmd_t::STREAM_MODE_START_CONTINUOUS);
+    stream_cmd.stream_now = false;
+    handler.issue_stream_cmd(stream_cmd);
+    BOOST_CHECK(concurrent);
+    BOOST_CHECK(order[0] == std::vector<size_t>({0, 1}));
+    BOOST_CHECK(order[1] == std::vector<size_t>({2, 3}));
+
+    // An error on one motherboard is thrown once all of them are done
+    std::atomic<size_t> num_issued(0);
+    for (size_t chan = 0; chan < NCHANNELS; chan++) {
+        handler.set_issue_stream_cmd(chan,
+            [&, chan](const uhd::stream_cmd_t&) {
+                if (chan == 3) {
+                    throw uhd::io_error("no response");
+                }
+                num_issued++;
+            },
+            chan == 0 ? 0 : 1);
+    }
+    BOOST_CHECK_THROW(handler.issue_stream_cmd(stream_cmd), uhd::io_error);
+    BOOST_CHECK_EQUAL(num_issued.load(), 3);
+}
+
+////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_sph_recv_multi_channel_capture_ring)
+{
+    ////////////////////////////////////////////////////////////////////////
+    uhd::convert::id_type id;
+    id.input_format  = "sc16_item32_be";
+    id.num_inputs    = 1;
+    id.output_format = "sc16";
+    id.num_outputs   = 1;
+
+    vrt::if_packet_info_t ifpi;
+    ifpi.packet_type         = vrt::if_packet_info_t::PACKET_TYPE_DATA;
+    ifpi.num_payload_words32 = 10;
+    ifpi.packet_count        = 0;
+    ifpi.sob                 = true;
+    ifpi.eob                 = false;
+    ifpi.has_sid             = false;
+    ifpi.has_cid             = false;
+    ifpi.has_tsi             = true;
+    ifpi.has_tsf             = true;
+    ifpi.tsi                 = 0;
+    ifpi.tsf                 = 0;
+    ifpi.has_tlr             = false;
+
+    static const double TICK_RATE        = 100e6;
+    static const double SAMP_RATE        = 10e6;
+    static const size_t NUM_PKTS_TO_TEST = 8;
+    static const size_t NCHANNELS        = 2;
+    static const size_t GAP_PKT          = 6;
+    static const size_t GAP_SAMPS        = 100;
+
+    std::vector<mock_zero_copy::sptr> xports;
+    for (size_t i = 0; i < NCHANNELS; i++) {
+        xports.push_back(
+            boost::make_shared<mock_zero_copy>(vrt::if_packet_info_t::LINK_TYPE_VRLP));
+    }
+
+    // the payload words are the channel and the sample index, and the
+    // device drops some samples before one of the packets
+    size_t samp_index = 0;
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        if (i == GAP_PKT) {
+            samp_index += GAP_SAMPS;
+        }
+        ifpi.tsf = samp_index * size_t(TICK_RATE / SAMP_RATE);
+        for (size_t ch = 0; ch < NCHANNELS; ch++) {
+            std::vector<uint32_t> data;
+            for (size_t n = 0; n < ifpi.num_payload_words32; n++) {
+                data.push_back(uhd::htonx<uint32_t>(((ch + 1) << 16) | (samp_index + n)));
+            }
+            xports[ch]->push_back_recv_packet(ifpi, data);
+        }
+        ifpi.packet_count++;
+        samp_index += ifpi.num_payload_words32;
+    }
+
+    // create the super receive packet handler
+    sph::recv_packet_handler handler(NCHANNELS);
+    handler.set_vrt_unpacker(&vrt::if_hdr_unpack_be);
+    handler.set_tick_rate(TICK_RATE);
+    handler.set_samp_rate(SAMP_RATE);
+    for (size_t ch = 0; ch < NCHANNELS; ch++) {
+        mock_zero_copy::sptr xport = xports[ch];
+        handler.set_xport_chan_get_buff(
+            ch, [xport](double timeout) { return xport->get_recv_buff(timeout); });
+    }
+    handler.set_converter(id);
+    handler.set_capture_ring(45);
+
+    uhd::rx_metadata_t metadata;
+    BOOST_CHECK_EQUAL(handler.capture(metadata, 1.0), 80);
+    BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_NONE);
+    BOOST_CHECK_TS_CLOSE(metadata.time_spec, uhd::time_spec_t(0.0));
+
+    std::vector<std::complex<int16_t>> mem(50 * NCHANNELS);
+    std::vector<std::complex<int16_t>*> buffs(NCHANNELS);
+    for (size_t ch = 0; ch < NCHANNELS; ch++) {
+        buffs[ch] = &mem[ch * 50];
+    }
+    const auto check_samps = [&](const size_t first, const size_t nsamps) {
+        for (size_t ch = 0; ch < NCHANNELS; ch++) {
+            for (size_t n = 0; n < nsamps; n++) {
+                BOOST_CHECK_EQUAL(buffs[ch][n].real(), int16_t(ch + 1));
+                BOOST_CHECK_EQUAL(buffs[ch][n].imag(), int16_t(first + n));
+            }
+        }
+    };
+
+    // a window that ends at the gap
+    BOOST_CHECK_EQUAL(handler.extract_capture(
+                          buffs, 30, uhd::time_spec_t(0, 42, SAMP_RATE), metadata),
+        18);
+    BOOST_CHECK(metadata.has_time_spec);
+    BOOST_CHECK_TS_CLOSE(metadata.time_spec, uhd::time_spec_t(0, 42, SAMP_RATE));
+    check_samps(42, 18);
+
+    // the ring only holds the last packets, the older ones were overwritten
+    BOOST_CHECK_EQUAL(
+        handler.extract_capture(buffs, 5, uhd::time_spec_t(0.0), metadata), 5);
+    BOOST_CHECK_TS_CLOSE(metadata.time_spec, uhd::time_spec_t(0, 40, SAMP_RATE));
+    check_samps(40, 5);
+
+    // the packets after the gap, which wrap around the end of the ring
+    BOOST_CHECK_EQUAL(handler.extract_capture(buffs,
+                          50,
+                          uhd::time_spec_t(0, 60 + GAP_SAMPS, SAMP_RATE),
+                          metadata),
+        20);
+    check_samps(60 + GAP_SAMPS, 20);
+
+    // nothing was captured that late
+    BOOST_CHECK_EQUAL(
+        handler.extract_capture(buffs, 50, uhd::time_spec_t(1.0), metadata), 0);
+    BOOST_CHECK(not metadata.has_time_spec);
+}
+
+////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_sph_recv_signal_stats)
+{
+    ////////////////////////////////////////////////////////////////////////
+    uhd::convert::id_type id;
+    id.input_format  = "sc16_item32_be";
+    id.num_inputs    = 1;
+    id.output_format = "fc32";
+    id.num_outputs   = 1;
+
+    mock_zero_copy xport(vrt::if_packet_info_t::LINK_TYPE_VRLP);
+
+    vrt::if_packet_info_t ifpi;
+    ifpi.packet_type         = vrt::if_packet_info_t::PACKET_TYPE_DATA;
+    ifpi.num_payload_words32 = 10;
+    ifpi.packet_count        = 0;
+    ifpi.sob                 = true;
+    ifpi.eob                 = false;
+    ifpi.has_sid             = false;
+    ifpi.has_cid             = false;
+    ifpi.has_tsi             = true;
+    ifpi.has_tsf             = true;
+    ifpi.tsi                 = 0;
+    ifpi.tsf                 = 0;
+    ifpi.has_tlr             = false;
+
+    // I counts up, Q is constant, the first packet has the larger peak
+    for (size_t i = 0; i < 2; i++) {
+        std::vector<uint32_t> data(ifpi.num_payload_words32);
+        for (size_t j = 0; j < data.size(); j++) {
+            const int16_t re = int16_t(i == 0 ? j : j - 5);
+            data[j]          = uhd::htonx((uint32_t(uint16_t(re)) << 16) | 2);
+        }
+        xport.push_back_recv_packet(ifpi, data);
+        ifpi.packet_count++;
+        ifpi.tsf += ifpi.num_payload_words32 * 10;
+    }
+
+    uhd::transport::sph::recv_packet_handler handler(1);
+    handler.set_vrt_unpacker(&uhd::transport::vrt::if_hdr_unpack_be);
+    handler.set_tick_rate(100e6);
+    handler.set_samp_rate(10e6);
+    handler.set_xport_chan_get_buff(
+        0, [&xport](double timeout) { return xport.get_recv_buff(timeout); });
+    handler.set_converter(id);
+    handler.set_scale_factor(1.0);
+    BOOST_CHECK(handler.get_stats().signal_stats.empty());
+    BOOST_REQUIRE(handler.enable_signal_stats());
+
+    std::vector<std::complex<float>> buff(10);
+    uhd::rx_metadata_t metadata;
+    handler.recv(&buff.front(), buff.size(), metadata, 1.0, true);
+    BOOST_CHECK_EQUAL(metadata.error_code, uhd::rx_metadata_t::ERROR_CODE_NONE);
+    // the converter still uses the scale factor
+    BOOST_CHECK_EQUAL(buff[9].real(), 9.0f);
+    uhd::stream_stats_t stats = handler.get_stats();
+    BOOST_REQUIRE_EQUAL(stats.signal_stats.size(), 1);
+    BOOST_CHECK_EQUAL(stats.signal_stats[0].num_samps, 10);
+    BOOST_CHECK_CLOSE(stats.signal_stats[0].sum_i, 45.0, 0.001);
+    BOOST_CHECK_CLOSE(stats.signal_stats[0].sum_q, 20.0, 0.001);
+    BOOST_CHECK_CLOSE(stats.signal_stats[0].sum_sq, 285.0 + 40.0, 0.001);
+    BOOST_CHECK_EQUAL(stats.signal_stats[0].peak, 9.0);
+
+    handler.recv(&buff.front(), buff.size(), metadata, 1.0, true);
+    stats = handler.get_stats();
+    BOOST_CHECK_EQUAL(stats.signal_stats[0].num_samps, 20);
+    BOOST_CHECK_CLOSE(stats.signal_stats[0].sum_i, 45.0 - 5.0, 0.001);
+    BOOST_CHECK_EQUAL(stats.signal_stats[0].peak, 5.0);
+    BOOST_CHECK_EQUAL(stats.signal_stats[0].max_peak, 9.0);
+}
@@ -11,7 +11,9 @@
 #include <boost/shared_array.hpp>
 #include <boost/test/unit_test.hpp>
 #include <complex>
+#include <deque>
 #include <list>
+#include <memory>
 #include <vector>
 
 using namespace uhd::transport;
@@ -75,6 +77,155 @@ BOOST_AUTO_TEST_CASE(test_sph_send_one_channel_one_packet_mode)
     }
 }
 
+/***********************************************************************
+ * A post-send callback that counts the packets, for the static variant
+ **********************************************************************/
+struct counting_post_send_cb
+{
+    size_t* num_calls;
+
+    void operator()(void) const
+    {
+        (*num_calls)++;
+    }
+
+    explicit operator bool(void) const
+    {
+        return num_calls != nullptr;
+    }
+};
+
+/***********************************************************************
+ * Flow control that records the packet sizes
+ **********************************************************************/
+struct recording_send_flowctrl
+{
+    std::vector<size_t>* sizes;
+
+    void operator()(const size_t size) const
+    {
+        sizes->push_back(size);
+    }
+
+    explicit operator bool(void) const
+    {
+        return sizes != nullptr;
+    }
+};
+
+////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_sph_send_one_channel_static_dispatch)
+{
+    ////////////////////////////////////////////////////////////////////////
+    uhd::convert::id_type id;
+    id.input_format  = "fc32";
+    id.num_inputs    = 1;
+    id.output_format = "sc16_item32_be";
+    id.num_outputs   = 1;
+
+    mock_zero_copy::sptr xport =
+        boost::make_shared<mock_zero_copy>(vrt::if_packet_info_t::LINK_TYPE_VRLP);
+
+    static const double TICK_RATE        = 100e6;
+    static const double SAMP_RATE        = 10e6;
+    static const size_t NUM_PKTS_TO_TEST = 30;
+
+    // create a send packet handler that calls the transport directly
+    sph::basic_send_packet_handler<sph::zero_copy_send_buff_getter, counting_post_send_cb>
+        handler(1);
+    size_t num_post_send_calls = 0;
+    handler.set_vrt_packer(&vrt::if_hdr_pack_be);
+    handler.set_tick_rate(TICK_RATE);
+    handler.set_samp_rate(SAMP_RATE);
+    handler.set_xport_chan_get_buff(0, sph::zero_copy_send_buff_getter{xport});
+    handler.set_xport_chan_post_send_cb(0, counting_post_send_cb{&num_post_send_calls});
+    handler.set_converter(id);
+    handler.set_max_samples_per_packet(20);
+
+    // allocate metadata and buffer
+    std::vector<std::complex<float>> buff(20);
+    uhd::tx_metadata_t metadata;
+    metadata.has_time_spec = true;
+    metadata.time_spec     = uhd::time_spec_t(0.0);
+
+    // generate the test data
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        metadata.start_of_burst = (i == 0);
+        metadata.end_of_burst   = (i == NUM_PKTS_TO_TEST - 1);
+        const size_t num_sent   = handler.send(&buff.front(), 10 + i % 10, metadata, 1.0);
+        BOOST_CHECK_EQUAL(num_sent, 10 + i % 10);
+        metadata.time_spec += uhd::time_spec_t(0, num_sent, SAMP_RATE);
+    }
+    BOOST_CHECK_EQUAL(num_post_send_calls, NUM_PKTS_TO_TEST);
+
+    // check the sent packets
+    size_t num_accum_samps = 0;
+    vrt::if_packet_info_t ifpi;
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        std::cout << "data check " << i << std::endl;
+        xport->pop_send_packet(ifpi);
+        BOOST_CHECK_EQUAL(ifpi.num_payload_words32, 10 + i % 10);
+        BOOST_CHECK_EQUAL(ifpi.tsf, num_accum_samps * TICK_RATE / SAMP_RATE);
+        num_accum_samps += ifpi.num_payload_words32;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_sph_send_flowctrl)
+{
+    ////////////////////////////////////////////////////////////////////////
+    uhd::convert::id_type id;
+    id.input_format  = "fc32";
+    id.num_inputs    = 1;
+    id.output_format = "sc16_item32_be";
+    id.num_outputs   = 1;
+
+    mock_zero_copy::sptr xport =
+        boost::make_shared<mock_zero_copy>(vrt::if_packet_info_t::LINK_TYPE_VRLP);
+
+    static const double TICK_RATE        = 100e6;
+    static const double SAMP_RATE        = 10e6;
+    static const size_t NUM_PKTS_TO_TEST = 10;
+
+    // the flow control is called with every packet before it is sent
+    sph::basic_send_packet_handler<sph::zero_copy_send_buff_getter,
+        counting_post_send_cb,
+        recording_send_flowctrl>
+        handler(1);
+    size_t num_post_send_calls = 0;
+    std::vector<size_t> sizes;
+    handler.set_vrt_packer(&vrt::if_hdr_pack_be);
+    handler.set_tick_rate(TICK_RATE);
+    handler.set_samp_rate(SAMP_RATE);
+    handler.set_xport_chan_get_buff(0, sph::zero_copy_send_buff_getter{xport});
+    handler.set_xport_chan_post_send_cb(0, counting_post_send_cb{&num_post_send_calls});
+    handler.set_xport_chan_flowctrl(0, recording_send_flowctrl{&sizes});
+    handler.set_converter(id);
+    handler.set_max_samples_per_packet(20);
+
+    std::vector<std::complex<float>> buff(20);
+    uhd::tx_metadata_t metadata;
+    metadata.has_time_spec = true;
+    metadata.time_spec     = uhd::time_spec_t(0.0);
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        metadata.start_of_burst = (i == 0);
+        metadata.end_of_burst   = (i == NUM_PKTS_TO_TEST - 1);
+        BOOST_CHECK_EQUAL(handler.send(&buff.front(), 10 + i, metadata, 1.0), 10 + i);
+    }
+    BOOST_CHECK_EQUAL(num_post_send_calls, NUM_PKTS_TO_TEST);
+    BOOST_REQUIRE_EQUAL(sizes.size(), NUM_PKTS_TO_TEST);
+
+    vrt::if_packet_info_t ifpi;
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        xport->pop_send_packet(ifpi);
+        BOOST_CHECK_EQUAL(ifpi.num_payload_words32, 10 + i);
+        const size_t num_packet_words32 = ifpi.num_header_words32
+                                          + ifpi.num_payload_words32
+                                          + (ifpi.has_tlr ? 1 : 0);
+        BOOST_CHECK_EQUAL(sizes[i], num_packet_words32 * sizeof(uint32_t));
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////
 BOOST_AUTO_TEST_CASE(test_sph_send_one_channel_full_buffer_mode)
 {
@@ -127,3 +278,450 @@ BOOST_AUTO_TEST_CASE(test_sph_send_one_channel_full_buffer_mode)
         num_accum_samps += ifpi.num_payload_words32;
     }
 }
+
+////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_sph_send_one_channel_time_ticks)
+{
+    ////////////////////////////////////////////////////////////////////////
+    uhd::convert::id_type id;
+    id.input_format  = "fc32";
+    id.num_inputs    = 1;
+    id.output_format = "sc16_item32_be";
+    id.num_outputs   = 1;
+
+    mock_zero_copy xport(vrt::if_packet_info_t::LINK_TYPE_VRLP);
+
+    static const double TICK_RATE = 100e6;
+    static const double SAMP_RATE = 10e6;
+
+    sph::send_packet_handler handler(1);
+    handler.set_vrt_packer(&vrt::if_hdr_pack_be);
+    handler.set_tick_rate(TICK_RATE);
+    handler.set_samp_rate(SAMP_RATE);
+    handler.set_xport_chan_get_buff(
+        0, [&xport](double timeout) { return xport.get_send_buff(timeout); });
+    handler.set_converter(id);
+    handler.set_max_samples_per_packet(20);
+
+    // A sample index far into a capture, the time_spec is ignored
+    const int64_t first_samp = int64_t(SAMP_RATE) * 3600 * 24 * 3 + 7;
+    std::vector<std::complex<float>> buff(50);
+    uhd::tx_metadata_t metadata;
+    metadata.start_of_burst = true;
+    metadata.end_of_burst   = true;
+    metadata.has_time_spec  = true;
+    metadata.time_spec      = uhd::time_spec_t(1.0);
+    metadata.time_ticks     = uhd::time_ticks_t(first_samp, SAMP_RATE);
+    BOOST_CHECK_EQUAL(handler.send(&buff.front(), buff.size(), metadata, 1.0), 50);
+
+    vrt::if_packet_info_t ifpi;
+    for (size_t i = 0; i < 3; i++) {
+        xport.pop_send_packet(ifpi);
+        BOOST_CHECK(ifpi.has_tsf);
+        BOOST_CHECK_EQUAL(
+            ifpi.tsf, uint64_t(first_samp + 20 * i) * uint64_t(TICK_RATE / SAMP_RATE));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_sph_send_multi_channel_convert_threads)
+{
+    ////////////////////////////////////////////////////////////////////////
+    uhd::convert::id_type id;
+    id.input_format  = "fc32";
+    id.num_inputs    = 1;
+    id.output_format = "sc16_item32_be";
+    id.num_outputs   = 1;
+
+    static const double TICK_RATE        = 100e6;
+    static const double SAMP_RATE        = 10e6;
+    static const size_t NUM_PKTS_TO_TEST = 30;
+    static const size_t NCHANNELS        = 4;
+
+    std::vector<mock_zero_copy::sptr> xports;
+    for (size_t i = 0; i < NCHANNELS; i++) {
+        xports.push_back(
+            boost::make_shared<mock_zero_copy>(vrt::if_packet_info_t::LINK_TYPE_VRLP));
+    }
+
+    // create the super send packet handler, convert with 4 threads
+    sph::send_packet_handler handler(NCHANNELS);
+    handler.set_vrt_packer(&vrt::if_hdr_pack_be);
+    handler.set_tick_rate(TICK_RATE);
+    handler.set_samp_rate(SAMP_RATE);
+    for (size_t ch = 0; ch < NCHANNELS; ch++) {
+        mock_zero_copy::sptr xport = xports[ch];
+        handler.set_xport_chan_get_buff(
+            ch, [xport](double timeout) { return xport->get_send_buff(timeout); });
+    }
+    handler.set_convert_threads(NCHANNELS);
+    handler.set_converter(id);
+    handler.set_max_samples_per_packet(20);
+
+    // allocate metadata and buffer
+    std::vector<std::complex<float>> mem(20 * NCHANNELS);
+    std::vector<std::complex<float>*> buffs(NCHANNELS);
+    for (size_t ch = 0; ch < NCHANNELS; ch++) {
+        buffs[ch] = &mem[ch * 20];
+    }
+    uhd::tx_metadata_t metadata;
+    metadata.has_time_spec = true;
+    metadata.time_spec     = uhd::time_spec_t(0.0);
+
+    // generate the test data
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        metadata.start_of_burst = (i == 0);
+        metadata.end_of_burst   = (i == NUM_PKTS_TO_TEST - 1);
+        const size_t num_sent   = handler.send(buffs, 10 + i % 10, metadata, 1.0);
+        BOOST_CHECK_EQUAL(num_sent, 10 + i % 10);
+        metadata.time_spec += uhd::time_spec_t(0, num_sent, SAMP_RATE);
+    }
+
+    // check the sent packets on every channel
+    for (size_t ch = 0; ch < NCHANNELS; ch++) {
+        size_t num_accum_samps = 0;
+        vrt::if_packet_info_t ifpi;
+        for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+            std::cout << "data check " << ch << "/" << i << std::endl;
+            xports[ch]->pop_send_packet(ifpi);
+            BOOST_CHECK_EQUAL(ifpi.num_payload_words32, 10 + i % 10);
+            BOOST_CHECK(ifpi.has_tsf);
+            BOOST_CHECK_EQUAL(ifpi.tsf, num_accum_samps * TICK_RATE / SAMP_RATE);
+            BOOST_CHECK_EQUAL(ifpi.sob, i == 0);
+            BOOST_CHECK_EQUAL(ifpi.eob, i == NUM_PKTS_TO_TEST - 1);
+            num_accum_samps += ifpi.num_payload_words32;
+        }
+    }
+}
+
+/***********************************************************************
+ * Send the same samples through the generic CHDR packer and through
+ * set_chdr_data_packer(), the packets must be the same
+ **********************************************************************/
+template <uhd::endianness_t endianness>
+static void check_chdr_data_packer(void)
+{
+    const bool big_endian = (endianness == uhd::ENDIANNESS_BIG);
+    uhd::convert::id_type id;
+    id.input_format  = "sc16";
+    id.num_inputs    = 1;
+    id.output_format = big_endian ? "sc16_item32_be" : "sc16_item32_le";
+    id.num_outputs   = 1;
+
+    static const double TICK_RATE        = 100e6;
+    static const double SAMP_RATE        = 10e6;
+    static const size_t NUM_PKTS_TO_TEST = 12;
+    static const size_t NCHANNELS        = 2;
+
+    std::vector<mock_zero_copy::sptr> xports[2];
+    std::vector<std::unique_ptr<sph::send_packet_handler>> handlers;
+    for (size_t h = 0; h < 2; h++) {
+        handlers.emplace_back(new sph::send_packet_handler(NCHANNELS));
+        sph::send_packet_handler& handler = *handlers.back();
+        handler.set_vrt_packer(
+            big_endian ? &vrt::chdr::if_hdr_pack_be : &vrt::chdr::if_hdr_pack_le);
+        if (h == 1) {
+            handler.set_chdr_data_packer(endianness);
+        }
+        handler.set_enable_trailer(false);
+        handler.set_tick_rate(TICK_RATE);
+        handler.set_samp_rate(SAMP_RATE);
+        for (size_t ch = 0; ch < NCHANNELS; ch++) {
+            xports[h].push_back(
+                boost::make_shared<mock_zero_copy>(vrt::if_packet_info_t::LINK_TYPE_CHDR));
+            mock_zero_copy::sptr xport = xports[h].back();
+            handler.set_xport_chan_get_buff(
+                ch, [xport](double timeout) { return xport->get_send_buff(timeout); });
+            handler.set_xport_chan_sid(ch, true, 0xAB000010 + ch);
+        }
+        handler.set_converter(id);
+        handler.set_max_samples_per_packet(20);
+    }
+
+    // bursts of 3 packets, every other one with a time
+    std::vector<std::complex<int16_t>> mem(20 * NCHANNELS);
+    std::vector<std::complex<int16_t>*> buffs(NCHANNELS);
+    for (size_t n = 0; n < mem.size(); n++) {
+        mem[n] = std::complex<int16_t>(int16_t(n), int16_t(-n));
+    }
+    for (size_t ch = 0; ch < NCHANNELS; ch++) {
+        buffs[ch] = &mem[ch * 20];
+    }
+    uhd::tx_metadata_t metadata;
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        metadata.start_of_burst = (i % 3 == 0);
+        metadata.end_of_burst   = (i % 3 == 2);
+        metadata.has_time_spec  = metadata.start_of_burst and (i % 2 == 0);
+        metadata.time_ticks     = uhd::time_ticks_t(1000 * i + 0x100000000ll, TICK_RATE);
+        for (auto& handler : handlers) {
+            BOOST_CHECK_EQUAL(handler->send(buffs, 10 + i % 10, metadata, 1.0), 10 + i % 10);
+        }
+    }
+
+    for (size_t ch = 0; ch < NCHANNELS; ch++) {
+        for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+            vrt::if_packet_info_t ifpi[2];
+            std::vector<uint32_t> payload[2];
+            for (size_t h = 0; h < 2; h++) {
+                xports[h][ch]->pop_send_packet<endianness>(ifpi[h], payload[h]);
+            }
+            BOOST_CHECK_EQUAL(ifpi[1].packet_type, vrt::if_packet_info_t::PACKET_TYPE_DATA);
+            BOOST_CHECK_EQUAL(ifpi[0].num_packet_words32, ifpi[1].num_packet_words32);
+            BOOST_CHECK_EQUAL(ifpi[0].num_payload_bytes, ifpi[1].num_payload_bytes);
+            BOOST_CHECK_EQUAL(ifpi[0].packet_count, ifpi[1].packet_count);
+            BOOST_CHECK_EQUAL(ifpi[1].packet_count, i);
+            BOOST_CHECK_EQUAL(ifpi[1].sid, 0xAB000010 + ch);
+            BOOST_CHECK_EQUAL(ifpi[0].eob, ifpi[1].eob);
+            BOOST_CHECK_EQUAL(ifpi[1].has_tsf, i % 6 == 0);
+            BOOST_CHECK_EQUAL(ifpi[0].has_tsf, ifpi[1].has_tsf);
+            if (ifpi[1].has_tsf) {
+                BOOST_CHECK_EQUAL(ifpi[0].tsf, ifpi[1].tsf);
+                BOOST_CHECK_EQUAL(ifpi[1].tsf, 1000 * i + 0x100000000ull);
+            }
+            BOOST_CHECK(payload[0] == payload[1]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_sph_send_multi_channel_chdr_data_packer)
+{
+    check_chdr_data_packer<uhd::ENDIANNESS_BIG>();
+    check_chdr_data_packer<uhd::ENDIANNESS_LITTLE>();
+}
+
+BOOST_AUTO_TEST_CASE(test_sph_send_one_channel_raw)
+{
+    ////////////////////////////////////////////////////////////////////////
+    uhd::convert::id_type id;
+    id.input_format  = "fc32";
+    id.num_inputs    = 1;
+    id.output_format = "sc16_item32_be";
+    id.num_outputs   = 1;
+
+    mock_zero_copy xport(vrt::if_packet_info_t::LINK_TYPE_VRLP);
+
+    static const double TICK_RATE        = 100e6;
+    static const double SAMP_RATE        = 10e6;
+    static const size_t NUM_PKTS_TO_TEST = 30;
+
+    // create the super send packet handler
+    sph::send_packet_handler handler(1);
+    handler.set_vrt_packer(&vrt::if_hdr_pack_be);
+    handler.set_tick_rate(TICK_RATE);
+    handler.set_samp_rate(SAMP_RATE);
+    handler.set_xport_chan_get_buff(
+        0, [&xport](double timeout) { return xport.get_send_buff(timeout); });
+    handler.set_converter(id);
+    handler.set_max_samples_per_packet(20);
+
+    // nothing to commit yet
+    uhd::tx_metadata_t metadata;
+    BOOST_CHECK_THROW(handler.commit_send_buffs(1, metadata), uhd::runtime_error);
+
+    // fill the frames in place, only the first packet has a time spec
+    std::vector<void*> buffs;
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        metadata.has_time_spec  = (i == 0);
+        metadata.time_spec      = uhd::time_spec_t(0.0);
+        metadata.start_of_burst = (i == 0);
+        metadata.end_of_burst   = (i == NUM_PKTS_TO_TEST - 1);
+        BOOST_REQUIRE_EQUAL(handler.get_send_buffs(buffs, metadata.has_time_spec, 1.0), 20);
+        BOOST_REQUIRE_EQUAL(buffs.size(), 1);
+        uint32_t* items = reinterpret_cast<uint32_t*>(buffs[0]);
+        for (size_t n = 0; n < 10 + i % 10; n++) {
+            items[n] = uhd::htonx<uint32_t>((i << 16) | n);
+        }
+        if (i == 1) {
+            BOOST_CHECK_THROW(handler.commit_send_buffs(21, metadata), uhd::value_error);
+        }
+        handler.commit_send_buffs(10 + i % 10, metadata);
+    }
+
+    // check the sent packets
+    vrt::if_packet_info_t ifpi;
+    for (size_t i = 0; i < NUM_PKTS_TO_TEST; i++) {
+        std::cout << "data check " << i << std::endl;
+        std::vector<uint32_t> payload;
+        xport.pop_send_packet(ifpi, payload);
+        BOOST_CHECK_EQUAL(ifpi.num_payload_words32, 10 + i % 10);
+        BOOST_CHECK_EQUAL(ifpi.packet_count, i % 16);
+        BOOST_CHECK_EQUAL(ifpi.has_tsf, i == 0);
+        BOOST_CHECK_EQUAL(ifpi.sob, i == 0);
+        BOOST_CHECK_EQUAL(ifpi.eob, i == NUM_PKTS_TO_TEST - 1);
+        for (size_t n = 0; n < ifpi.num_payload_words32; n++) {
+            BOOST_CHECK_EQUAL(uhd::ntohx(payload[n]), uint32_t((i << 16) | n));
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_sph_send_bursts)
+{
+    ////////////////////////////////////////////////////////////////////////
+    uhd::convert::id_type id;
+    id.input_format  = "fc32";
+    id.num_inputs    = 1;
+    id.output_format = "sc16_item32_be";
+    id.num_outputs   = 1;
+
+    static const double TICK_RATE = 100e6;
+    static const double SAMP_RATE = 10e6;
+    static const size_t NCHANNELS = 2;
+
+    std::vector<std::unique_ptr<mock_zero_copy>> xports;
+    std::deque<uhd::async_metadata_t> async_msgs;
+    sph::send_packet_streamer streamer(20);
+    streamer.resize(NCHANNELS);
+    streamer.set_vrt_packer(&vrt::if_hdr_pack_be);
+    streamer.set_tick_rate(TICK_RATE);
+    streamer.set_samp_rate(SAMP_RATE);
+    for (size_t ch = 0; ch < NCHANNELS; ch++) {
+        xports.emplace_back(new mock_zero_copy(vrt::if_packet_info_t::LINK_TYPE_VRLP));
+        mock_zero_copy* xport = xports.back().get();
+        streamer.set_xport_chan_get_buff(
+            ch, [xport](double timeout) { return xport->get_send_buff(timeout); });
+    }
+    streamer.set_async_receiver(
+        [&async_msgs](uhd::async_metadata_t& async_metadata, const double) {
+            if (async_msgs.empty()) {
+                return false;
+            }
+            async_metadata = async_msgs.front();
+            async_msgs.pop_front();
+            return true;
+        });
+    streamer.set_converter(id);
+
+    // A short burst, one that takes three packets, and an empty one
+    std::vector<std::complex<float>> buff(50);
+    const std::vector<const void*> buffs(NCHANNELS, &buff.front());
+    const std::vector<uhd::tx_streamer::burst_t> bursts = {
+        {10, buffs, 10, uhd::time_spec_t(1.0)},
+        {11, buffs, 50, uhd::time_spec_t(2.0)},
+        {12, buffs, 0, uhd::time_spec_t(3.0)}};
+    BOOST_CHECK_EQUAL(streamer.send_bursts(bursts, 1.0), 3);
+
+    const size_t expected_lens[] = {10, 20, 20, 10, 1};
+    const bool expected_sob[]    = {true, true, false, false, true};
+    const bool expected_eob[]    = {true, false, false, true, true};
+    const double expected_time[] = {
+        1.0, 2.0, 2.0 + 20 / SAMP_RATE, 2.0 + 40 / SAMP_RATE, 3.0};
+    for (size_t ch = 0; ch < NCHANNELS; ch++) {
+        vrt::if_packet_info_t ifpi;
+        for (size_t i = 0; i < 5; i++) {
+            xports[ch]->pop_send_packet(ifpi);
+            BOOST_CHECK_EQUAL(ifpi.num_payload_words32, expected_lens[i]);
+            BOOST_CHECK(ifpi.has_tsf);
+            BOOST_CHECK_EQUAL(ifpi.tsf, uint64_t(expected_time[i] * TICK_RATE + 0.5));
+            BOOST_CHECK_EQUAL(ifpi.sob, expected_sob[i]);
+            BOOST_CHECK_EQUAL(ifpi.eob, expected_eob[i]);
+        }
+    }
+
+    // Channel 0 is late for the second burst, and doesn't acknowledge it
+    const auto push_msg = [&async_msgs](const size_t channel,
+                              const uhd::async_metadata_t::event_code_t event_code,
+                              const double time) {
+        uhd::async_metadata_t async_metadata;
+        async_metadata.channel       = channel;
+        async_metadata.has_time_spec = true;
+        async_metadata.time_spec     = uhd::time_spec_t(time);
+        async_metadata.event_code    = event_code;
+        async_msgs.push_back(async_metadata);
+    };
+    push_msg(0, uhd::async_metadata_t::EVENT_CODE_BURST_ACK, 1.1);
+    push_msg(1, uhd::async_metadata_t::EVENT_CODE_BURST_ACK, 1.1);
+    push_msg(0, uhd::async_metadata_t::EVENT_CODE_TIME_ERROR, 2.0);
+    push_msg(1, uhd::async_metadata_t::EVENT_CODE_BURST_ACK, 2.1);
+    push_msg(0, uhd::async_metadata_t::EVENT_CODE_BURST_ACK, 3.1);
+
+    std::vector<uhd::tx_streamer::burst_status_t> status;
+    BOOST_REQUIRE_EQUAL(streamer.recv_burst_status(status, 0.0), 2);
+    BOOST_CHECK_EQUAL(status[0].id, 10);
+    BOOST_CHECK_EQUAL(status[0].nsamps_sent, 10);
+    BOOST_CHECK(status[0].acked);
+    BOOST_CHECK_EQUAL(status[0].event_code, uhd::async_metadata_t::EVENT_CODE_BURST_ACK);
+    BOOST_CHECK_EQUAL(status[1].id, 11);
+    BOOST_CHECK_EQUAL(status[1].nsamps_sent, 50);
+    BOOST_CHECK(not status[1].acked);
+    BOOST_CHECK_EQUAL(status[1].event_code, uhd::async_metadata_t::EVENT_CODE_TIME_ERROR);
+
+    // The last burst is done once channel 1 acknowledges it too
+    BOOST_CHECK_EQUAL(streamer.recv_burst_status(status, 0.0), 0);
+    push_msg(1, uhd::async_metadata_t::EVENT_CODE_BURST_ACK, 3.1);
+    BOOST_REQUIRE_EQUAL(streamer.recv_burst_status(status, 0.0), 1);
+    BOOST_CHECK_EQUAL(status[0].id, 12);
+    BOOST_CHECK(status[0].acked);
+}
+
+////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE(test_sph_send_lead_time)
+{
+    ////////////////////////////////////////////////////////////////////////
+    uhd::convert::id_type id;
+    id.input_format  = "fc32";
+    id.num_inputs    = 1;
+    id.output_format = "sc16_item32_be";
+    id.num_outputs   = 1;
+
+    mock_zero_copy xport(vrt::if_packet_info_t::LINK_TYPE_VRLP);
+    std::deque<uhd::async_metadata_t> async_msgs;
+
+    static const double TICK_RATE = 100e6;
+    static const double SAMP_RATE = 10e6;
+
+    sph::send_packet_streamer streamer(20);
+    streamer.resize(1);
+    streamer.set_vrt_packer(&vrt::if_hdr_pack_be);
+    streamer.set_tick_rate(TICK_RATE);
+    streamer.set_samp_rate(SAMP_RATE);
+    streamer.set_xport_chan_get_buff(
+        0, [&xport](double timeout) { return xport.get_send_buff(timeout); });
+    streamer.set_async_receiver(
+        [&async_msgs](uhd::async_metadata_t& async_metadata, const double) {
+            if (async_msgs.empty()) {
+                return false;
+            }
+            async_metadata = async_msgs.front();
+            async_msgs.pop_front();
+            return true;
+        });
+    streamer.set_converter(id);
+    BOOST_CHECK_THROW(streamer.get_lead_time(), uhd::not_implemented_error);
+    streamer.set_lead_time_ctrl(
+        std::make_shared<tx_lead_time_ctrl>(0.01, 0.0, 0.25), true);
+
+    std::vector<std::complex<float>> buff(10);
+    uhd::tx_metadata_t metadata;
+    metadata.start_of_burst = true;
+    metadata.end_of_burst   = true;
+    metadata.has_time_spec  = true;
+    metadata.time_spec      = uhd::time_spec_t(1.0);
+
+    // Without a device time, the time spec is kept
+    BOOST_CHECK(not streamer.get_lead_time().valid);
+    BOOST_CHECK_EQUAL(streamer.send(&buff.front(), buff.size(), metadata, 1.0), 10);
+    vrt::if_packet_info_t ifpi;
+    xport.pop_send_packet(ifpi);
+    BOOST_CHECK_EQUAL(ifpi.tsf, uint64_t(1.0 * TICK_RATE));
+
+    // The burst was late, and the device is at 5 s now. The burst went out
+    // before the device time was known, so it doesn't count.
+    uhd::async_metadata_t async_metadata;
+    async_metadata.has_time_spec = true;
+    async_metadata.time_spec     = uhd::time_spec_t(5.0);
+    async_metadata.event_code    = uhd::async_metadata_t::EVENT_CODE_TIME_ERROR;
+    async_msgs.push_back(async_metadata);
+    BOOST_CHECK(streamer.recv_async_msg(async_metadata, 0.0));
+    BOOST_CHECK(streamer.get_lead_time().valid);
+    BOOST_CHECK_EQUAL(streamer.get_lead_time().num_late, 0);
+
+    // So the next one is moved to the earliest time
+
+    metadata.time_spec = uhd::time_spec_t(2.0);
+    BOOST_CHECK_EQUAL(streamer.send(&buff.front(), buff.size(), metadata, 1.0), 10);
+    xport.pop_send_packet(ifpi);
+    BOOST_CHECK_GE(ifpi.tsf, uint64_t(5.01 * TICK_RATE));
+    BOOST_CHECK_LT(ifpi.tsf, uint64_t(6.0 * TICK_RATE));
+    BOOST_CHECK_EQUAL(streamer.get_lead_time().num_adjusted, 1);
+}
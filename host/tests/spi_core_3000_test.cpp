@@ -0,0 +1,92 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhdlib/usrp/cores/spi_core_3000.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/test/unit_test.hpp>
+#include <utility>
+#include <vector>
+
+using namespace uhd;
+
+namespace {
+
+constexpr wb_iface::wb_addr_type SPI_BASE = 0x100;
+constexpr wb_iface::wb_addr_type SPI_DIV  = SPI_BASE + 0;
+constexpr wb_iface::wb_addr_type SPI_CTRL = SPI_BASE + 4;
+constexpr wb_iface::wb_addr_type SPI_DATA = SPI_BASE + 8;
+constexpr wb_iface::wb_addr_type SPI_RB   = 0x200;
+
+//! Records the writes, and how many multi-writes they came in
+class mock_wb_iface : public wb_iface
+{
+public:
+    void poke32(const wb_addr_type addr, const uint32_t data)
+    {
+        writes.push_back(std::make_pair(addr, data));
+    }
+
+    uint32_t peek32(const wb_addr_type)
+    {
+        return 0;
+    }
+
+    void multi_poke32(
+        const std::vector<wb_addr_type>& addrs, const std::vector<uint32_t>& data)
+    {
+        num_multi_pokes++;
+        for (size_t i = 0; i < addrs.size(); i++) {
+            poke32(addrs[i], data[i]);
+        }
+    }
+
+    std::vector<std::pair<wb_addr_type, uint32_t>> writes;
+    size_t num_multi_pokes = 0;
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_spi_write_list)
+{
+    auto iface = boost::make_shared<mock_wb_iface>();
+    auto spi   = spi_core_3000::make(iface, SPI_BASE, SPI_RB);
+    const std::vector<uint32_t> data{0x123456, 0xabcdef, 0x000001};
+
+    // The list writes the same registers as single writes do
+    spi_config_t config(spi_config_t::EDGE_FALL);
+    for (const uint32_t word : data) {
+        spi->write_spi(1, config, word, 24);
+    }
+    const auto single_writes = iface->writes;
+    BOOST_CHECK_EQUAL(iface->num_multi_pokes, 0);
+
+    auto list_iface = boost::make_shared<mock_wb_iface>();
+    auto list_spi   = spi_core_3000::make(list_iface, SPI_BASE, SPI_RB);
+    list_spi->write_spi_list(1, config, data, 24);
+    BOOST_CHECK_EQUAL(list_iface->num_multi_pokes, 1);
+    BOOST_REQUIRE_EQUAL(list_iface->writes.size(), single_writes.size());
+    for (size_t i = 0; i < single_writes.size(); i++) {
+        BOOST_CHECK_EQUAL(list_iface->writes[i].first, single_writes[i].first);
+        BOOST_CHECK_EQUAL(list_iface->writes[i].second, single_writes[i].second);
+    }
+    // Divider and control word, then the data in the upper bits
+    BOOST_REQUIRE_EQUAL(single_writes.size(), 5);
+    BOOST_CHECK_EQUAL(single_writes[0].first, SPI_DIV);
+    BOOST_CHECK_EQUAL(single_writes[1].first, SPI_CTRL);
+    BOOST_CHECK_EQUAL(single_writes[2].first, SPI_DATA);
+    BOOST_CHECK_EQUAL(single_writes[2].second, 0x12345600);
+
+    // Unchanged settings aren't written again
+    list_iface->writes.clear();
+    list_spi->write_spi_list(1, config, data, 24);
+    BOOST_CHECK_EQUAL(list_iface->writes.size(), data.size());
+
+    // A new slave updates the control word only
+    list_iface->writes.clear();
+    list_spi->write_spi_list(2, config, data, 24);
+    BOOST_REQUIRE_EQUAL(list_iface->writes.size(), data.size() + 1);
+    BOOST_CHECK_EQUAL(list_iface->writes[0].first, SPI_CTRL);
+}
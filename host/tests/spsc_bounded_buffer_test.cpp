@@ -0,0 +1,101 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhdlib/transport/spsc_bounded_buffer.hpp>
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <thread>
+
+using namespace uhd::transport;
+
+static const double timeout = 0.01 /*secs*/;
+
+BOOST_AUTO_TEST_CASE(test_spsc_bounded_buffer_with_timed_wait)
+{
+    spsc_bounded_buffer<int> bb(3);
+    BOOST_CHECK_EQUAL(bb.capacity(), 3);
+
+    // push elements, check for timeout
+    BOOST_CHECK(bb.push_with_timed_wait(0, timeout));
+    BOOST_CHECK(bb.push_with_timed_wait(1, timeout));
+    BOOST_CHECK(bb.push_with_timed_wait(2, timeout));
+    BOOST_CHECK(not bb.push_with_timed_wait(3, timeout));
+
+    int val;
+    // pop elements, check for timeout and check values
+    BOOST_CHECK(bb.pop_with_timed_wait(val, timeout));
+    BOOST_CHECK_EQUAL(val, 0);
+    BOOST_CHECK(bb.pop_with_timed_wait(val, timeout));
+    BOOST_CHECK_EQUAL(val, 1);
+    BOOST_CHECK(bb.pop_with_timed_wait(val, timeout));
+    BOOST_CHECK_EQUAL(val, 2);
+    BOOST_CHECK(not bb.pop_with_timed_wait(val, timeout));
+}
+
+BOOST_AUTO_TEST_CASE(test_spsc_bounded_buffer_with_haste)
+{
+    spsc_bounded_buffer<int> bb(2);
+
+    int val;
+    BOOST_CHECK(not bb.pop_with_haste(val));
+    // wrap around the ring several times
+    for (int i = 0; i < 10; i++) {
+        BOOST_CHECK(bb.push_with_haste(2 * i));
+        BOOST_CHECK(bb.push_with_haste(2 * i + 1));
+        BOOST_CHECK(not bb.push_with_haste(-1));
+        BOOST_CHECK(bb.pop_with_haste(val));
+        BOOST_CHECK_EQUAL(val, 2 * i);
+        BOOST_CHECK(bb.pop_with_haste(val));
+        BOOST_CHECK_EQUAL(val, 2 * i + 1);
+        BOOST_CHECK(not bb.pop_with_haste(val));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_spsc_bounded_buffer_releases_popped)
+{
+    spsc_bounded_buffer<std::shared_ptr<int>> bb(4);
+
+    std::shared_ptr<int> elem = std::make_shared<int>(5);
+    BOOST_CHECK(bb.push_with_haste(elem));
+    BOOST_CHECK_EQUAL(elem.use_count(), 2);
+    std::shared_ptr<int> popped;
+    BOOST_CHECK(bb.pop_with_haste(popped));
+    BOOST_CHECK_EQUAL(*popped, 5);
+    popped.reset();
+    BOOST_CHECK_EQUAL(elem.use_count(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_spsc_bounded_buffer_threaded)
+{
+    static const int num_elems = 100000;
+    spsc_bounded_buffer<int> bb(7);
+
+    std::thread producer([&bb]() {
+        for (int i = 0; i < num_elems; i++) {
+            if (i % 2) {
+                bb.push_with_wait(i);
+            } else {
+                while (not bb.push_with_timed_wait(i, timeout)) {
+                }
+            }
+        }
+    });
+
+    int val;
+    bool in_order = true;
+    for (int i = 0; i < num_elems; i++) {
+        if (i % 3) {
+            bb.pop_with_wait(val);
+        } else {
+            while (not bb.pop_with_timed_wait(val, timeout)) {
+            }
+        }
+        in_order = in_order and (val == i);
+    }
+    producer.join();
+    BOOST_CHECK(in_order);
+    BOOST_CHECK(not bb.pop_with_haste(val));
+}
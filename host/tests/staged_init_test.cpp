@@ -0,0 +1,82 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhdlib/utils/staged_init.hpp>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(test_staged_init_parallel)
+{
+    uhd::staged_init init("TEST", false);
+    constexpr size_t num_units   = 6;
+    constexpr size_t max_threads = 2;
+    std::atomic<size_t> running(0);
+    std::atomic<size_t> max_running(0);
+    std::vector<int> done(num_units, 0);
+
+    init.run("setup",
+        num_units,
+        [&](const size_t unit) {
+            const size_t now_running = ++running;
+            size_t prev_max          = max_running;
+            while (now_running > prev_max
+                   and not max_running.compare_exchange_weak(prev_max, now_running)) {
+            }
+            init.time_step("step", unit, []() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            });
+            done[unit] = 1;
+            running--;
+        },
+        max_threads);
+
+    BOOST_CHECK(std::all_of(done.begin(), done.end(), [](int d) { return d == 1; }));
+    BOOST_CHECK_LE(max_running.load(), max_threads);
+    const std::string report = init.get_report();
+    BOOST_CHECK(report.find("setup") != std::string::npos);
+    BOOST_CHECK(report.find("step") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(test_staged_init_errors)
+{
+    // All units run, the first error is rethrown
+    uhd::staged_init init("TEST", false);
+    std::atomic<size_t> num_run(0);
+    BOOST_CHECK_THROW(init.run("fail",
+                          4,
+                          [&](const size_t unit) {
+                              num_run++;
+                              if (unit == 1) {
+                                  throw uhd::runtime_error("unit 1");
+                              }
+                              if (unit == 2) {
+                                  throw uhd::value_error("unit 2");
+                              }
+                          }),
+        uhd::runtime_error);
+    BOOST_CHECK_EQUAL(num_run.load(), 4);
+
+    // Serialized, it runs in order and stops at the first error
+    uhd::staged_init serial_init("TEST", true);
+    std::vector<size_t> order;
+    BOOST_CHECK_THROW(serial_init.run("fail",
+                          4,
+                          [&](const size_t unit) {
+                              order.push_back(unit);
+                              if (unit == 2) {
+                                  throw uhd::value_error("unit 2");
+                              }
+                          }),
+        uhd::value_error);
+    const std::vector<size_t> expected_order{0, 1, 2};
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        order.begin(), order.end(), expected_order.begin(), expected_order.end());
+}
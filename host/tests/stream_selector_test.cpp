@@ -0,0 +1,164 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/utils/stream_selector.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#ifndef _WIN32
+#    include <unistd.h>
+#endif
+
+namespace {
+
+/*! A streamer that is ready when data is held, or its descriptor is readable
+ *
+ * Without a descriptor, it can't be waited on, like a streamer on a
+ * transport without one.
+ */
+class mock_rx_streamer : public uhd::rx_streamer
+{
+public:
+    mock_rx_streamer(const int fd) : _fd(fd) {}
+
+    size_t get_num_channels(void) const
+    {
+        return 1;
+    }
+
+    size_t get_max_num_samps(void) const
+    {
+        return 100;
+    }
+
+    size_t recv(const buffs_type&,
+        const size_t,
+        uhd::rx_metadata_t& metadata,
+        const double = 0.1,
+        const bool = false)
+    {
+        metadata.reset();
+        metadata.error_code = uhd::rx_metadata_t::ERROR_CODE_TIMEOUT;
+        return 0;
+    }
+
+    void issue_stream_cmd(const uhd::stream_cmd_t&)
+    {
+        /* NOP */
+    }
+
+    bool prepare_recv_wait(std::vector<int>& fds)
+    {
+        if (_fd < 0) {
+            return uhd::rx_streamer::prepare_recv_wait(fds);
+        }
+        if (has_data) {
+            return true;
+        }
+        fds.push_back(_fd);
+        return false;
+    }
+
+    bool has_data = false;
+
+private:
+    const int _fd;
+};
+
+class mock_tx_streamer : public uhd::tx_streamer
+{
+public:
+    mock_tx_streamer(const int fd) : _fd(fd) {}
+
+    size_t get_num_channels(void) const
+    {
+        return 1;
+    }
+
+    size_t get_max_num_samps(void) const
+    {
+        return 100;
+    }
+
+    size_t send(const buffs_type&, const size_t, const uhd::tx_metadata_t&, const double)
+    {
+        return 0;
+    }
+
+    bool recv_async_msg(uhd::async_metadata_t&, double)
+    {
+        return false;
+    }
+
+    int get_async_msg_fd(void) const
+    {
+        return _fd;
+    }
+
+private:
+    const int _fd;
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_stream_selector_polled)
+{
+    auto selector = uhd::stream_selector::make(uhd::device_addr_t("poll_interval=0.01"));
+    auto rx_stream = boost::make_shared<mock_rx_streamer>(-1);
+    BOOST_CHECK_EQUAL(selector->add_rx_streamer(rx_stream), 0);
+
+    // A streamer that can't be waited on is reported once per interval
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < 3; i++) {
+        const std::vector<size_t> ready = selector->wait(1.0);
+        BOOST_REQUIRE_EQUAL(ready.size(), 1);
+        BOOST_CHECK_EQUAL(ready[0], 0);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    BOOST_CHECK(elapsed >= std::chrono::milliseconds(20));
+
+    BOOST_CHECK_THROW(
+        selector->add_tx_streamer(boost::make_shared<mock_tx_streamer>(-1)),
+        uhd::value_error);
+}
+
+#ifndef _WIN32
+BOOST_AUTO_TEST_CASE(test_stream_selector_wait)
+{
+    int rx_pipe[2], tx_pipe[2];
+    BOOST_REQUIRE_EQUAL(::pipe(rx_pipe), 0);
+    BOOST_REQUIRE_EQUAL(::pipe(tx_pipe), 0);
+
+    auto selector  = uhd::stream_selector::make();
+    auto idle      = boost::make_shared<mock_rx_streamer>(rx_pipe[0]);
+    auto held      = boost::make_shared<mock_rx_streamer>(rx_pipe[0]);
+    auto tx_stream = boost::make_shared<mock_tx_streamer>(tx_pipe[0]);
+    BOOST_CHECK_EQUAL(selector->add_rx_streamer(idle), 0);
+    BOOST_CHECK_EQUAL(selector->add_tx_streamer(tx_stream), 1);
+    BOOST_CHECK_EQUAL(selector->add_rx_streamer(held), 2);
+
+    BOOST_CHECK(selector->wait(0.01).empty());
+
+    // Held data is reported without waiting
+    held->has_data = true;
+    std::vector<size_t> ready = selector->wait(1.0);
+    BOOST_REQUIRE_EQUAL(ready.size(), 1);
+    BOOST_CHECK_EQUAL(ready[0], 2);
+
+    // Readable descriptors wake up all of their streamers
+    held->has_data = false;
+    const char byte = 0;
+    BOOST_REQUIRE_EQUAL(::write(rx_pipe[1], &byte, 1), 1);
+    BOOST_REQUIRE_EQUAL(::write(tx_pipe[1], &byte, 1), 1);
+    ready = selector->wait(1.0);
+    BOOST_CHECK_EQUAL(ready.size(), 3);
+
+    for (const int fd : {rx_pipe[0], rx_pipe[1], tx_pipe[0], tx_pipe[1]}) {
+        ::close(fd);
+    }
+}
+#endif
@@ -0,0 +1,75 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhdlib/transport/stream_stats.hpp>
+#include <boost/test/unit_test.hpp>
+#include <thread>
+
+using namespace uhd::transport;
+
+BOOST_AUTO_TEST_CASE(test_stream_stats_counters)
+{
+    stream_stats_counters counters;
+    stream_stats_counters::add(counters.num_packets);
+    stream_stats_counters::add(counters.num_bytes, 1000);
+    stream_stats_counters::add_shared(counters.underflows, 2);
+
+    const uhd::stream_stats_t stats = counters.get();
+    BOOST_CHECK_EQUAL(stats.num_packets, 1);
+    BOOST_CHECK_EQUAL(stats.num_bytes, 1000);
+    BOOST_CHECK_EQUAL(stats.underflows, 2);
+    BOOST_CHECK_EQUAL(stats.overflows, 0);
+    BOOST_CHECK_EQUAL(stats.num_calls, 0);
+    BOOST_CHECK_EQUAL(stats.latency_hist.size(), uhd::stream_stats_t::NUM_LATENCY_BINS);
+}
+
+BOOST_AUTO_TEST_CASE(test_stream_stats_call_timer)
+{
+    stream_stats_counters counters;
+    {
+        const stream_stats_counters::call_timer timer(counters);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    const uhd::stream_stats_t stats = counters.get();
+    BOOST_CHECK_EQUAL(stats.num_calls, 1);
+    // 2 ms or more lands in bin 12 ([2048, 4096) us) or above
+    uint64_t num_binned = 0;
+    for (size_t i = 0; i < stats.latency_hist.size(); i++) {
+        if (i < 12) {
+            BOOST_CHECK_EQUAL(stats.latency_hist[i], 0);
+        }
+        num_binned += stats.latency_hist[i];
+    }
+    BOOST_CHECK_EQUAL(num_binned, 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_stream_stats_signal)
+{
+    stream_stats_counters counters;
+    BOOST_CHECK(counters.get().signal_stats.empty());
+
+    counters.enable_signal_stats(2);
+    uhd::convert::signal_accum_t accum;
+    accum.num_samps = 4;
+    accum.sum_i     = 1.0;
+    accum.sum_q     = -1.0;
+    accum.sum_sq    = 2.0;
+    accum.peak      = 0.5;
+    counters.store_signal(1, accum);
+    accum.peak = 0.25;
+    counters.store_signal(1, accum);
+
+    const uhd::stream_stats_t stats = counters.get();
+    BOOST_REQUIRE_EQUAL(stats.signal_stats.size(), 2);
+    BOOST_CHECK_EQUAL(stats.signal_stats[0].num_samps, 0);
+    BOOST_CHECK_EQUAL(stats.signal_stats[1].num_samps, 4);
+    BOOST_CHECK_EQUAL(stats.signal_stats[1].sum_i, 1.0);
+    BOOST_CHECK_EQUAL(stats.signal_stats[1].sum_q, -1.0);
+    BOOST_CHECK_EQUAL(stats.signal_stats[1].sum_sq, 2.0);
+    // the peak of the last packet, and of all packets
+    BOOST_CHECK_EQUAL(stats.signal_stats[1].peak, 0.25);
+    BOOST_CHECK_EQUAL(stats.signal_stats[1].max_peak, 0.5);
+}
@@ -5,8 +5,10 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 //
 
+#include <uhd/exception.hpp>
 #include <uhd/utils/tasks.hpp>
 #include <boost/test/unit_test.hpp>
+#include <atomic>
 #include <chrono>
 #include <iostream>
 #include <thread>
@@ -26,3 +28,58 @@ BOOST_AUTO_TEST_CASE(tasks_test)
         test_vec.push_back(uhd::task::make([i]() { test_tasks_sleep(i); }));
     }
 }
+
+BOOST_AUTO_TEST_CASE(tasks_periodic_test)
+{
+    std::atomic<size_t> num_calls(0);
+    {
+        auto periodic = uhd::task::make_periodic([&num_calls]() { num_calls++; }, 0.01);
+        std::this_thread::sleep_for(std::chrono::milliseconds(105));
+    }
+    // The first call is right away, then one every 10 ms
+    const size_t num_calls_at_exit = num_calls;
+    BOOST_CHECK_GE(num_calls_at_exit, 5);
+    BOOST_CHECK_LE(num_calls_at_exit, 12);
+    // No calls after the task is gone
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    BOOST_CHECK_EQUAL(num_calls, num_calls_at_exit);
+
+    BOOST_CHECK_THROW(uhd::task::make_periodic([]() {}, 0.0), uhd::value_error);
+}
+
+BOOST_AUTO_TEST_CASE(tasks_periodic_shared_threads_test)
+{
+    // Many more periodic tasks than housekeeping threads all get their turn,
+    // and destroying them waits for calls in progress
+    static const size_t N_TASKS = 50;
+    std::vector<std::atomic<size_t>> num_calls(N_TASKS);
+    std::vector<uhd::task::sptr> test_vec;
+    for (size_t i = 0; i < N_TASKS; i++) {
+        num_calls[i] = 0;
+        test_vec.push_back(uhd::task::make_periodic(
+            [&num_calls, i]() {
+                test_tasks_sleep(1);
+                num_calls[i]++;
+            },
+            0.005));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    test_vec.clear();
+    for (size_t i = 0; i < N_TASKS; i++) {
+        BOOST_CHECK_GE(num_calls[i], 1);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(tasks_periodic_exception_test)
+{
+    std::atomic<size_t> num_calls(0);
+    auto periodic = uhd::task::make_periodic(
+        [&num_calls]() {
+            num_calls++;
+            throw uhd::runtime_error("Stop");
+        },
+        0.001);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    // A task which throws is not called again
+    BOOST_CHECK_EQUAL(num_calls, 1);
+}
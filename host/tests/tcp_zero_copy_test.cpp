@@ -0,0 +1,141 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/transport/tcp_zero_copy.hpp>
+#include <uhd/utils/byteswap.hpp>
+#include <boost/asio.hpp>
+#include <boost/test/unit_test.hpp>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <vector>
+
+using namespace uhd::transport;
+namespace asio = boost::asio;
+
+namespace {
+
+constexpr size_t FRAME_SIZE = 128;
+
+//! A stream mode transport, connected to a plain socket on the loopback
+struct stream_fixture
+{
+    stream_fixture(const std::string& args)
+        : acceptor(io_service,
+              asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0))
+        , peer(io_service)
+    {
+        const std::string port = std::to_string(acceptor.local_endpoint().port());
+        xport = tcp_zero_copy::make("127.0.0.1", port, uhd::device_addr_t(args));
+        acceptor.accept(peer);
+    }
+
+    //! Write frames of the given lengths, the payload bytes count up
+    void write_frames(const std::vector<size_t>& lens)
+    {
+        std::vector<uint8_t> bytes;
+        uint8_t value = 0;
+        for (const size_t len : lens) {
+            const uint32_t hdr       = uhd::htonx(uint32_t(len));
+            const uint8_t* hdr_bytes = reinterpret_cast<const uint8_t*>(&hdr);
+            bytes.insert(bytes.end(), hdr_bytes, hdr_bytes + sizeof(hdr));
+            for (size_t i = 0; i < len; i++) {
+                bytes.push_back(value++);
+            }
+        }
+        asio::write(peer, asio::buffer(bytes));
+    }
+
+    asio::io_service io_service;
+    asio::ip::tcp::acceptor acceptor;
+    asio::ip::tcp::socket peer;
+    zero_copy_if::sptr xport;
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_tcp_stream_send)
+{
+    stream_fixture fixture("stream_mode,send_batch_size=4,send_frame_size=128");
+
+    std::vector<size_t> lens;
+    for (size_t i = 0; i < 10; i++) {
+        lens.push_back(4 * i + 1);
+        managed_send_buffer::sptr buff = fixture.xport->get_send_buff(1.0);
+        BOOST_REQUIRE(buff);
+        BOOST_CHECK_EQUAL(buff->size(), FRAME_SIZE);
+        std::memset(buff->cast<uint8_t*>(), int(i), lens.back());
+        buff->commit(lens.back());
+    }
+    fixture.xport->flush_send_buffs();
+
+    // Only the lengths and the data go out, no padding
+    for (size_t i = 0; i < lens.size(); i++) {
+        uint32_t hdr = 0;
+        asio::read(fixture.peer, asio::buffer(&hdr, sizeof(hdr)));
+        BOOST_CHECK_EQUAL(uhd::ntohx(hdr), lens[i]);
+        std::vector<uint8_t> data(lens[i]);
+        asio::read(fixture.peer, asio::buffer(data));
+        for (const uint8_t byte : data) {
+            BOOST_CHECK_EQUAL(byte, i);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_tcp_stream_recv)
+{
+    // A small ring, so frames end up split at its end and held buffers are
+    // in the way of the reads
+    stream_fixture fixture("stream_mode,num_recv_frames=4,recv_frame_size=128");
+
+    std::vector<size_t> lens;
+    for (size_t i = 0; i < 200; i++) {
+        lens.push_back((i * 37) % (FRAME_SIZE + 1));
+    }
+    fixture.write_frames(lens);
+
+    std::deque<managed_recv_buffer::sptr> held;
+    uint8_t value = 0;
+    for (size_t i = 0; i < lens.size(); i++) {
+        managed_recv_buffer::sptr buff = fixture.xport->get_recv_buff(1.0);
+        BOOST_REQUIRE(buff);
+        BOOST_REQUIRE_EQUAL(buff->size(), lens[i]);
+        for (size_t j = 0; j < lens[i]; j++) {
+            BOOST_REQUIRE_EQUAL(buff->cast<const uint8_t*>()[j], value++);
+        }
+        // Keep two buffers, and release them a little out of order
+        held.push_back(buff);
+        if (held.size() == 3) {
+            held.erase(held.begin() + (i % 2));
+        }
+    }
+    held.clear();
+    BOOST_CHECK(not fixture.xport->get_recv_buff(0.0));
+}
+
+BOOST_AUTO_TEST_CASE(test_tcp_stream_recv_all_in_use)
+{
+    stream_fixture fixture("stream_mode,num_recv_frames=2,recv_frame_size=128");
+    fixture.write_frames({10, 20, 30});
+
+    managed_recv_buffer::sptr buff0 = fixture.xport->get_recv_buff(1.0);
+    managed_recv_buffer::sptr buff1 = fixture.xport->get_recv_buff(1.0);
+    BOOST_REQUIRE(buff0 and buff1);
+    // Both buffers are in use, the third frame has to wait
+    BOOST_CHECK(not fixture.xport->get_recv_buff(0.01));
+    buff0.reset();
+    managed_recv_buffer::sptr buff2 = fixture.xport->get_recv_buff(1.0);
+    BOOST_REQUIRE(buff2);
+    BOOST_CHECK_EQUAL(buff2->size(), 30);
+}
+
+BOOST_AUTO_TEST_CASE(test_tcp_stream_recv_too_large)
+{
+    stream_fixture fixture("stream_mode,recv_frame_size=128");
+    fixture.write_frames({FRAME_SIZE + 1});
+    BOOST_CHECK_THROW(fixture.xport->get_recv_buff(1.0), uhd::io_error);
+}
@@ -0,0 +1,49 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/types/time_ticks.hpp>
+#include <boost/test/unit_test.hpp>
+
+using uhd::time_spec_t;
+using uhd::time_ticks_t;
+
+BOOST_AUTO_TEST_CASE(test_time_ticks_convert)
+{
+    // Integer ratios in both directions
+    BOOST_CHECK_EQUAL(time_ticks_t::convert(1000, 30.72e6, 61.44e6), 2000);
+    BOOST_CHECK_EQUAL(time_ticks_t::convert(2000, 61.44e6, 30.72e6), 1000);
+    // Odd ratios round to the nearest tick
+    BOOST_CHECK_EQUAL(time_ticks_t::convert(1, 3.0, 2.0), 1);
+    BOOST_CHECK_EQUAL(time_ticks_t::convert(2, 3.0, 2.0), 1);
+    BOOST_CHECK_EQUAL(time_ticks_t::convert(-1000, 30.72e6, 61.44e6), -2000);
+
+    // A week at 200 MHz is still exact, and so is one more sample
+    const int64_t week = int64_t(7) * 24 * 3600 * 200000000;
+    BOOST_CHECK_EQUAL(time_ticks_t::convert(week + 1, 200e6, 200e6 / 4), week / 4);
+    BOOST_CHECK_EQUAL(
+        time_ticks_t::convert(week / 4 + 1, 200e6 / 4, 200e6), week + 4);
+
+    // Non-integer rates go through time_spec_t
+    BOOST_CHECK_EQUAL(time_ticks_t::convert(3, 200e6 / 3, 200e6), 9);
+}
+
+BOOST_AUTO_TEST_CASE(test_time_ticks_time_spec)
+{
+    const time_ticks_t invalid;
+    BOOST_CHECK(not invalid.is_valid());
+
+    const time_ticks_t ticks(int64_t(200e6) * 3600 + 5, 200e6);
+    BOOST_CHECK(ticks.is_valid());
+    const time_spec_t time = ticks.to_time_spec();
+    BOOST_CHECK_EQUAL(time.get_full_secs(), 3600);
+    BOOST_CHECK_EQUAL(time.to_ticks(200e6), ticks.ticks);
+    BOOST_CHECK(time_ticks_t::from_time_spec(time, 200e6) == ticks);
+
+    const time_ticks_t samps = ticks.to_rate(100e6);
+    BOOST_CHECK_EQUAL(samps.tick_rate, 100e6);
+    BOOST_CHECK_EQUAL(samps.ticks, int64_t(100e6) * 3600 + 3);
+    BOOST_CHECK(samps != ticks);
+}
@@ -0,0 +1,76 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhdlib/utils/trace_events.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+std::string read_file(const std::string& path)
+{
+    std::ifstream in(path.c_str());
+    std::stringstream contents;
+    contents << in.rdbuf();
+    return contents.str();
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_trace_events)
+{
+    const std::string path =
+        (boost::filesystem::temp_directory_path()
+            / boost::filesystem::unique_path("uhd-trace-%%%%-%%%%.json"))
+            .string();
+
+    // Nothing is recorded before start()
+    BOOST_CHECK(not uhd::trace_events::is_enabled());
+    {
+        UHD_TRACE_SPAN("test", "not_recorded");
+    }
+
+    uhd::trace_events::start(path);
+    BOOST_REQUIRE(uhd::trace_events::is_enabled());
+    {
+        UHD_TRACE_SPAN("test", "outer");
+        const uhd::trace_events::scoped_span span(
+            "test", []() { return std::string("quoted \"name\""); });
+        UHD_TRACE_COUNTER("test", "count", 42);
+    }
+    std::thread([]() { UHD_TRACE_SPAN("test", "other_thread"); }).join();
+
+    // Only every SAMPLE_INTERVAL-th call is sampled
+    size_t count       = 0;
+    size_t num_sampled = 0;
+    for (size_t i = 0; i < 3 * uhd::trace_events::SAMPLE_INTERVAL; i++) {
+        num_sampled += uhd::trace_events::sample(count) ? 1 : 0;
+    }
+    BOOST_CHECK_EQUAL(num_sampled, 3);
+
+    uhd::trace_events::stop();
+    BOOST_CHECK(not uhd::trace_events::is_enabled());
+    {
+        UHD_TRACE_SPAN("test", "after_stop");
+    }
+
+    const std::string trace = read_file(path);
+    boost::filesystem::remove(path);
+    BOOST_CHECK_EQUAL(trace.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["), 0);
+    BOOST_CHECK(trace.find("\"name\":\"not_recorded\"") == std::string::npos);
+    BOOST_CHECK(trace.find("\"name\":\"after_stop\"") == std::string::npos);
+    BOOST_CHECK(trace.find("\"ph\":\"X\",\"cat\":\"test\",\"name\":\"outer\"")
+                != std::string::npos);
+    BOOST_CHECK(trace.find("\"name\":\"quoted \\\"name\\\"\"") != std::string::npos);
+    BOOST_CHECK(trace.find("\"ph\":\"C\",\"cat\":\"test\",\"name\":\"count\"")
+                != std::string::npos);
+    BOOST_CHECK(trace.find("\"args\":{\"value\":42}") != std::string::npos);
+    BOOST_CHECK(trace.find("\"name\":\"other_thread\",\"pid\"") != std::string::npos);
+    BOOST_CHECK(trace.find("\"tid\":2") != std::string::npos);
+}
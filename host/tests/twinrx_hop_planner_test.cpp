@@ -0,0 +1,79 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "twinrx_hop_planner.hpp"
+#include <boost/test/unit_test.hpp>
+
+using namespace uhd::usrp::dboard::twinrx;
+
+namespace {
+
+constexpr size_t INTERNAL  = twinrx_hop_planner::SYNTH_INTERNAL;
+constexpr size_t COMPANION = twinrx_hop_planner::SYNTH_COMPANION;
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_twinrx_hop_planner_alternates)
+{
+    twinrx_hop_planner planner;
+    const std::vector<double> freqs{1e9, 1.1e9, 1.2e9};
+    auto hops = planner.plan(freqs);
+    BOOST_REQUIRE_EQUAL(hops.size(), freqs.size());
+
+    // Only the first hop waits for a lock, every other one was preloaded
+    BOOST_CHECK(hops[0].retune);
+    BOOST_CHECK_EQUAL(hops[0].synth, INTERNAL);
+    BOOST_CHECK(not hops[1].retune);
+    BOOST_CHECK(not hops[2].retune);
+    BOOST_CHECK_NE(hops[0].synth, hops[1].synth);
+    BOOST_CHECK_NE(hops[1].synth, hops[2].synth);
+    BOOST_CHECK(hops[0].preload);
+    BOOST_CHECK_EQUAL(hops[0].preload_freq, 1.1e9);
+    BOOST_CHECK(hops[1].preload);
+    BOOST_CHECK_EQUAL(hops[1].preload_freq, 1.2e9);
+    // Nothing comes after the last hop
+    BOOST_CHECK(not hops[2].preload);
+}
+
+BOOST_AUTO_TEST_CASE(test_twinrx_hop_planner_reuses_synths)
+{
+    twinrx_hop_planner planner;
+    // Dwelling twice on a frequency keeps the synthesizers, and going back to
+    // the frequency before uses the ones still tuned to it
+    auto hops = planner.plan({1e9, 1e9, 2e9, 1e9});
+    BOOST_REQUIRE_EQUAL(hops.size(), 4);
+    BOOST_CHECK_EQUAL(hops[1].synth, hops[0].synth);
+    BOOST_CHECK(not hops[0].preload);
+    BOOST_CHECK(hops[1].preload);
+    BOOST_CHECK_NE(hops[2].synth, hops[1].synth);
+    BOOST_CHECK(not hops[2].preload);
+    BOOST_CHECK_EQUAL(hops[3].synth, hops[1].synth);
+    for (size_t i = 1; i < hops.size(); i++) {
+        BOOST_CHECK(not hops[i].retune);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_twinrx_hop_planner_repeat)
+{
+    twinrx_hop_planner planner;
+    const std::vector<double> freqs{1e9, 1.1e9, 1.2e9};
+    auto hops = planner.plan(freqs, true);
+    BOOST_CHECK(hops.back().preload);
+    BOOST_CHECK_EQUAL(hops.back().preload_freq, freqs.front());
+
+    // The next pass continues where the last one stopped, without a retune
+    hops = planner.plan(freqs, true);
+    BOOST_CHECK_EQUAL(hops.front().synth, COMPANION);
+    for (const auto& hop : hops) {
+        BOOST_CHECK(not hop.retune);
+    }
+
+    // After a reset, the synthesizers have to lock again
+    planner.reset();
+    hops = planner.plan(freqs);
+    BOOST_CHECK(hops.front().retune);
+    BOOST_CHECK_EQUAL(hops.front().synth, INTERNAL);
+}
@@ -0,0 +1,116 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhdlib/transport/tx_lead_time.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace uhd::transport;
+
+namespace {
+
+//! The device time when the test starts
+constexpr double DEVICE_START = 100.0;
+//! How long async messages take to reach the host
+constexpr double RETURN_LATENCY = 100e-6;
+
+class lead_time_fixture
+{
+public:
+    lead_time_fixture(const double init_lead, const double min_lead)
+        : ctrl(init_lead, min_lead, 0.25), start(tx_lead_time_ctrl::clock::now())
+    {
+    }
+
+    //! The host time \p secs after the start of the test
+    tx_lead_time_ctrl::clock::time_point at(const double secs) const
+    {
+        return start
+               + std::chrono::duration_cast<tx_lead_time_ctrl::clock::duration>(
+                   std::chrono::duration<double>(secs));
+    }
+
+    //! Send a burst at device time \p time_spec, \p lead seconds before it
+    void send_burst(const double time_spec, const double lead)
+    {
+        ctrl.on_burst_start(
+            uhd::time_spec_t(time_spec), at(time_spec - lead - DEVICE_START));
+    }
+
+    //! Deliver a message about an event at device time \p time
+    void push_msg(
+        const uhd::async_metadata_t::event_code_t event_code, const double time)
+    {
+        uhd::async_metadata_t async_metadata;
+        async_metadata.has_time_spec = true;
+        async_metadata.time_spec     = uhd::time_spec_t(time);
+        async_metadata.event_code    = event_code;
+        ctrl.on_async_msg(async_metadata, at(time - DEVICE_START + RETURN_LATENCY));
+    }
+
+    tx_lead_time_ctrl ctrl;
+    const tx_lead_time_ctrl::clock::time_point start;
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_tx_lead_time_late_burst)
+{
+    lead_time_fixture fixture(0.001, 0.0);
+    auto lead_time = fixture.ctrl.get(fixture.at(0.0));
+    BOOST_CHECK(not lead_time.valid);
+    BOOST_CHECK_EQUAL(lead_time.min_lead_time, 0.001);
+    BOOST_CHECK_EQUAL(fixture.ctrl.get_earliest_time_spec().get_real_secs(), 0.0);
+
+    // The first message gives the device time
+    fixture.push_msg(uhd::async_metadata_t::EVENT_CODE_BURST_ACK, DEVICE_START);
+    lead_time = fixture.ctrl.get(fixture.at(1.0));
+    BOOST_CHECK(lead_time.valid);
+    // The estimate trails by the return latency
+    BOOST_CHECK_CLOSE(
+        lead_time.time_now.get_real_secs(), DEVICE_START + 1.0 - RETURN_LATENCY, 1e-6);
+
+    // A burst with 1 ms lead time reaches the radio 2 ms late, so sending
+    // takes 3 ms (plus the return latency, which the estimates share)
+    fixture.send_burst(DEVICE_START + 0.5, 0.001);
+    fixture.push_msg(uhd::async_metadata_t::EVENT_CODE_TIME_ERROR, DEVICE_START + 0.502);
+    // The other channel's message about the same burst doesn't count again
+    fixture.push_msg(uhd::async_metadata_t::EVENT_CODE_TIME_ERROR, DEVICE_START + 0.502);
+    lead_time = fixture.ctrl.get(fixture.at(1.0));
+    BOOST_CHECK_EQUAL(lead_time.num_late, 1);
+    BOOST_CHECK_CLOSE(lead_time.min_lead_time, (0.003 + RETURN_LATENCY) * 1.25, 0.01);
+    const auto earliest = fixture.ctrl.get_earliest_time_spec(fixture.at(2.0));
+    BOOST_CHECK_CLOSE(earliest.get_real_secs(),
+        DEVICE_START + 2.0 - RETURN_LATENCY + lead_time.min_lead_time,
+        1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(test_tx_lead_time_acks)
+{
+    lead_time_fixture fixture(0.01, 0.002);
+    fixture.push_msg(uhd::async_metadata_t::EVENT_CODE_BURST_ACK, DEVICE_START);
+
+    // An acknowledged burst shows that its lead time is enough
+    fixture.send_burst(DEVICE_START + 0.1, 0.005);
+    fixture.push_msg(uhd::async_metadata_t::EVENT_CODE_BURST_ACK, DEVICE_START + 0.101);
+    const double lead = fixture.ctrl.get(fixture.at(0.2)).min_lead_time;
+    BOOST_CHECK_CLOSE(lead, 0.005 + RETURN_LATENCY, 0.01);
+
+    // Bursts that keep being acknowledged at the lead time make it try less
+    double time_spec = DEVICE_START + 0.2;
+    for (size_t i = 0; i < tx_lead_time_ctrl::PROBE_ACKS; i++) {
+        fixture.send_burst(time_spec, 0.005);
+        fixture.push_msg(uhd::async_metadata_t::EVENT_CODE_BURST_ACK, time_spec + 0.001);
+        time_spec += 0.01;
+    }
+    BOOST_CHECK_CLOSE(fixture.ctrl.get(fixture.at(2.0)).min_lead_time,
+        lead * (1.0 - tx_lead_time_ctrl::PROBE_STEP),
+        0.01);
+
+    // Never below the minimum
+    fixture.send_burst(time_spec, 0.0005);
+    fixture.push_msg(uhd::async_metadata_t::EVENT_CODE_BURST_ACK, time_spec + 0.001);
+    BOOST_CHECK_EQUAL(fixture.ctrl.get(fixture.at(2.0)).min_lead_time, 0.002);
+}
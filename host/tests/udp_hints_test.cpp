@@ -0,0 +1,108 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/transport/udp_zero_copy.hpp>
+#include <uhdlib/transport/udp_hints.hpp>
+#include <boost/asio.hpp>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <thread>
+
+using namespace uhd::transport;
+
+BOOST_AUTO_TEST_CASE(test_udp_xport_hints)
+{
+    // Like the args an X3x0 is made with, and the ones it filters for RX
+    // streaming
+    const uhd::device_addr_t dev_args(
+        "addr=192.168.40.2,recv_batch_size=8,shared_frames,num_recv_frames=512,"
+        "recv_frame_size=8000,send_buff_size=1000000");
+    const uhd::device_addr_t xport_args(
+        "recv_batch_size=16,num_recv_frames=512,recv_frame_size=8000");
+
+    const uhd::device_addr_t hints = get_udp_xport_hints(dev_args, xport_args, false);
+    // The transport options get there, the transport args win
+    BOOST_CHECK_EQUAL(hints.cast<size_t>("recv_batch_size", 0), 16);
+    BOOST_CHECK(hints.has_key("shared_frames"));
+    // The device resolves the buffer sizes itself
+    BOOST_CHECK(not hints.has_key("num_recv_frames"));
+    BOOST_CHECK(not hints.has_key("recv_frame_size"));
+    BOOST_CHECK(not hints.has_key("send_buff_size"));
+
+    // Send batching is only for TX streaming
+    const uhd::device_addr_t batch_args("send_batch_size=8");
+    BOOST_CHECK(
+        not get_udp_xport_hints(batch_args, {}, false).has_key("send_batch_size"));
+    BOOST_CHECK(get_udp_xport_hints(batch_args, {}, true).has_key("send_batch_size"));
+}
+
+BOOST_AUTO_TEST_CASE(test_udp_xport_hints_transport)
+{
+    zero_copy_xport_params default_buff_args;
+    default_buff_args.recv_frame_size = 1472;
+    default_buff_args.send_frame_size = 1472;
+    default_buff_args.num_recv_frames = 4;
+    default_buff_args.num_send_frames = 4;
+    default_buff_args.recv_buff_size  = 0;
+    default_buff_args.send_buff_size  = 0;
+
+    // A device arg meant for the data transports doesn't resize a transport
+    // that the device sized itself, e.g. a control transport
+    udp_zero_copy::buff_params buff_params;
+    auto xport = udp_zero_copy::make("127.0.0.1",
+        "49152",
+        default_buff_args,
+        buff_params,
+        get_udp_xport_hints(
+            uhd::device_addr_t("num_recv_frames=512,recv_batch_size=4"),
+            uhd::device_addr_t(),
+            false));
+    BOOST_CHECK_EQUAL(xport->get_num_recv_frames(), 4);
+    BOOST_CHECK_EQUAL(xport->get_recv_frame_size(), 1472);
+    BOOST_CHECK(not xport->get_recv_buff(0.0));
+}
+
+#ifdef UHD_PLATFORM_LINUX
+BOOST_AUTO_TEST_CASE(test_udp_xport_hints_send_batch)
+{
+    namespace asio = boost::asio;
+    asio::io_service io_service;
+    asio::ip::udp::socket sink(
+        io_service, asio::ip::udp::endpoint(asio::ip::address_v4::loopback(), 0));
+
+    zero_copy_xport_params default_buff_args;
+    default_buff_args.recv_frame_size = 1472;
+    default_buff_args.send_frame_size = 1472;
+    default_buff_args.num_recv_frames = 4;
+    default_buff_args.num_send_frames = 4;
+    default_buff_args.recv_buff_size  = 0;
+    default_buff_args.send_buff_size  = 0;
+
+    // The batch size comes from the device args of a TX data transport
+    udp_zero_copy::buff_params buff_params;
+    auto xport = udp_zero_copy::make("127.0.0.1",
+        std::to_string(sink.local_endpoint().port()),
+        default_buff_args,
+        buff_params,
+        get_udp_xport_hints(
+            uhd::device_addr_t("send_batch_size=4,send_batch_timeout=10"),
+            uhd::device_addr_t(),
+            true));
+    managed_send_buffer::sptr buff = xport->get_send_buff(1.0);
+    BOOST_REQUIRE(buff);
+    buff->commit(64);
+    buff.reset();
+
+    // The packet waits for its batch until it is flushed
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    BOOST_CHECK_EQUAL(sink.available(), 0);
+    xport->flush_send_buffs();
+    for (size_t i = 0; i < 100 and sink.available() == 0; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    BOOST_CHECK_EQUAL(sink.available(), 64);
+}
+#endif
@@ -0,0 +1,111 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include <uhd/exception.hpp>
+#include <uhd/transport/udp_zero_copy.hpp>
+#include <boost/asio.hpp>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace uhd::transport;
+namespace asio = boost::asio;
+
+#ifdef UHD_PLATFORM_LINUX
+namespace {
+
+constexpr size_t NUM_FRAMES = 4;
+
+//! A transport connected to a plain socket on the loopback
+struct udp_fixture
+{
+    udp_fixture(const std::string& hints)
+        : peer(io_service,
+              asio::ip::udp::endpoint(asio::ip::address_v4::loopback(), 0))
+    {
+        zero_copy_xport_params default_buff_args;
+        default_buff_args.recv_frame_size = 1472;
+        default_buff_args.send_frame_size = 1472;
+        default_buff_args.num_recv_frames = NUM_FRAMES;
+        default_buff_args.num_send_frames = NUM_FRAMES;
+        default_buff_args.recv_buff_size  = 0;
+        default_buff_args.send_buff_size  = 0;
+
+        udp_zero_copy::buff_params buff_params;
+        xport = udp_zero_copy::make("127.0.0.1",
+            std::to_string(peer.local_endpoint().port()),
+            default_buff_args,
+            buff_params,
+            uhd::device_addr_t(hints));
+        xport_endpoint = asio::ip::udp::endpoint(
+            asio::ip::address_v4::loopback(), xport->get_local_port());
+    }
+
+    //! Send a datagram of \p len bytes from the peer to the transport
+    void send_to_xport(const size_t len)
+    {
+        const std::vector<char> data(len, 'x');
+        peer.send_to(asio::buffer(data), xport_endpoint);
+    }
+
+    //! Wait up to a second for \p num datagrams to arrive at the peer
+    size_t wait_for_peer(const size_t num)
+    {
+        std::vector<char> data(2048);
+        size_t num_rcvd = 0;
+        for (size_t i = 0; i < 100 and num_rcvd < num; i++) {
+            while (peer.available() > 0) {
+                peer.receive(asio::buffer(data));
+                num_rcvd++;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return num_rcvd;
+    }
+
+    asio::io_service io_service;
+    asio::ip::udp::socket peer;
+    asio::ip::udp::endpoint xport_endpoint;
+    udp_zero_copy::sptr xport;
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_udp_send_batch_timeout)
+{
+    udp_fixture fixture("send_batch_size=4,send_batch_timeout=0.02");
+
+    // Less than a batch, and then the stream pauses without a flush
+    for (size_t i = 0; i < 2; i++) {
+        managed_send_buffer::sptr buff = fixture.xport->get_send_buff(1.0);
+        BOOST_REQUIRE(buff);
+        buff->commit(64);
+    }
+    BOOST_CHECK_EQUAL(fixture.wait_for_peer(2), 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_udp_recv_batch_empty_datagram)
+{
+    udp_fixture fixture("recv_batch_size=4");
+
+    // More rounds than buffers, so a buffer that isn't released runs out
+    for (size_t round = 0; round < 2 * NUM_FRAMES; round++) {
+        fixture.send_to_xport(100);
+        fixture.send_to_xport(0);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        // The datagram before the empty one is still handed out
+        managed_recv_buffer::sptr buff = fixture.xport->get_recv_buff(1.0);
+        BOOST_REQUIRE(buff);
+        BOOST_CHECK_EQUAL(buff->size(), 100);
+        buff.reset();
+        BOOST_CHECK_THROW(fixture.xport->get_recv_buff(1.0), uhd::io_error);
+    }
+    BOOST_CHECK(not fixture.xport->get_recv_buff(0.0));
+}
+#endif
@@ -0,0 +1,103 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+#include "common/mock_zero_copy.hpp"
+#include <uhd/exception.hpp>
+#include <uhd/transport/zero_copy_fault_inject.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace uhd::transport;
+
+namespace {
+
+constexpr size_t NUM_PACKETS = 10;
+
+//! A mock transport with packets whose payload is their index
+mock_zero_copy::sptr make_xport(void)
+{
+    auto xport =
+        boost::make_shared<mock_zero_copy>(vrt::if_packet_info_t::LINK_TYPE_NONE);
+    vrt::if_packet_info_t ifpi;
+    ifpi.packet_type         = vrt::if_packet_info_t::PACKET_TYPE_DATA;
+    ifpi.num_payload_words32 = 1;
+    ifpi.has_sid             = false;
+    ifpi.has_cid             = false;
+    ifpi.has_tsi             = false;
+    ifpi.has_tsf             = false;
+    ifpi.has_tlr             = false;
+    for (uint32_t i = 0; i < NUM_PACKETS; i++) {
+        ifpi.packet_count = i;
+        xport->push_back_recv_packet(ifpi, std::vector<uint32_t>(1, i));
+    }
+    return xport;
+}
+
+//! Return the indexes of all packets that come out of \p xport
+std::vector<uint32_t> recv_all(zero_copy_if::sptr xport)
+{
+    std::vector<uint32_t> indexes;
+    while (managed_recv_buffer::sptr buff = xport->get_recv_buff(0.0)) {
+        // The payload is the last word of the packet
+        indexes.push_back(
+            buff->cast<const uint32_t*>()[buff->size() / sizeof(uint32_t) - 1]);
+    }
+    return indexes;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_fault_inject_args)
+{
+    BOOST_CHECK(not zero_copy_fault_inject::has_faults(uhd::device_addr_t("")));
+    BOOST_CHECK(zero_copy_fault_inject::has_faults(
+        uhd::device_addr_t("recv_fault_drop=0.1,recv_frame_size=1000")));
+    BOOST_CHECK_THROW(zero_copy_fault_inject::make(
+                          make_xport(), uhd::device_addr_t("recv_fault_dup=2")),
+        uhd::value_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_fault_inject_none)
+{
+    auto xport = zero_copy_fault_inject::make(
+        make_xport(), uhd::device_addr_t("recv_fault_drop=0"));
+    const std::vector<uint32_t> indexes = recv_all(xport);
+    BOOST_REQUIRE_EQUAL(indexes.size(), NUM_PACKETS);
+    for (uint32_t i = 0; i < NUM_PACKETS; i++) {
+        BOOST_CHECK_EQUAL(indexes[i], i);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_fault_inject_drop)
+{
+    auto xport = zero_copy_fault_inject::make(
+        make_xport(), uhd::device_addr_t("recv_fault_drop=1,recv_fault_drop_burst=3"));
+    BOOST_CHECK(recv_all(xport).empty());
+    BOOST_CHECK_EQUAL(xport->get_stats().dropped, NUM_PACKETS);
+}
+
+BOOST_AUTO_TEST_CASE(test_fault_inject_dup)
+{
+    auto xport = zero_copy_fault_inject::make(
+        make_xport(), uhd::device_addr_t("recv_fault_dup=1"));
+    const std::vector<uint32_t> indexes = recv_all(xport);
+    BOOST_REQUIRE_EQUAL(indexes.size(), 2 * NUM_PACKETS);
+    for (uint32_t i = 0; i < 2 * NUM_PACKETS; i++) {
+        BOOST_CHECK_EQUAL(indexes[i], i / 2);
+    }
+    BOOST_CHECK_EQUAL(xport->get_stats().duplicated, NUM_PACKETS);
+}
+
+BOOST_AUTO_TEST_CASE(test_fault_inject_reorder)
+{
+    auto xport = zero_copy_fault_inject::make(
+        make_xport(), uhd::device_addr_t("recv_fault_reorder=1"));
+    const std::vector<uint32_t> indexes = recv_all(xport);
+    BOOST_REQUIRE_EQUAL(indexes.size(), NUM_PACKETS);
+    for (uint32_t i = 0; i < NUM_PACKETS; i++) {
+        BOOST_CHECK_EQUAL(indexes[i], i ^ 1);
+    }
+    BOOST_CHECK_EQUAL(xport->get_stats().reordered, NUM_PACKETS / 2);
+}
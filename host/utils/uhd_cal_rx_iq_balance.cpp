@@ -100,6 +100,7 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
     desc.add_options()
         ("help", "help message")
         ("verbose", "enable some verbose")
+        ("fast", "Search the corrections with fewer captures: a coarse grid, then the neighbours of the best correction")
         ("args", po::value<std::string>(&args)->default_value(""), "Device address args [default = \"\"]")
         ("subdev", po::value<std::string>(&subdev), "Subdevice specification (default: first subdevice, often 'A')")
         ("tx_wave_ampl", po::value<double>(&tx_wave_ampl)->default_value(0.7), "Transmit wave amplitude")
@@ -207,74 +208,36 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
             compute_tone_dbrms(buff, bb_tone_freq / actual_rx_rate)
             - compute_tone_dbrms(buff, bb_imag_freq / actual_rx_rate);
 
-        // bounds and results from searching
-        double phase_corr_start = -1.0;
-        double phase_corr_stop  = 1.0;
-        double phase_corr_step =
-            (phase_corr_stop - phase_corr_start) / (num_search_steps + 1);
-        double ampl_corr_start = -1.0;
-        double ampl_corr_stop  = 1.0;
-        double ampl_corr_step =
-            (ampl_corr_stop - ampl_corr_start) / (num_search_steps + 1);
+        // search for the best correction
         double best_suppression = 0;
-        double best_phase_corr  = 0;
-        double best_ampl_corr   = 0;
-        while (phase_corr_step >= precision or ampl_corr_step >= precision) {
-            for (double phase_corr = phase_corr_start + phase_corr_step;
-                 phase_corr <= phase_corr_stop - phase_corr_step;
-                 phase_corr += phase_corr_step) {
-                for (double ampl_corr = ampl_corr_start + ampl_corr_step;
-                     ampl_corr <= ampl_corr_stop - ampl_corr_step;
-                     ampl_corr += ampl_corr_step) {
-                    const std::complex<double> correction(ampl_corr, phase_corr);
-                    usrp->set_rx_iq_balance(correction);
-
-                    // receive some samples
-                    capture_samples(usrp, rx_stream, buff, nsamps);
-                    // check for TX errors in the current captured iteration
-                    if (has_tx_error(tx_stream)) {
-                        if (vm.count("verbose")) {
-                            std::cout << "[WARNING] TX error detected! "
-                                      << "Repeating current iteration" << std::endl;
-                        }
-                        // Undo the correction step:
-                        ampl_corr -= ampl_corr_step;
-                        tx_error_count++;
-                        if (tx_error_count >= MAX_NUM_TX_ERRORS) {
-                            throw uhd::runtime_error(
-                                "Too many TX errors. Aborting calibration.");
-                        }
-                        continue;
-                    }
-                    const double tone_dbrms =
-                        compute_tone_dbrms(buff, bb_tone_freq / actual_rx_rate);
-                    const double imag_dbrms =
-                        compute_tone_dbrms(buff, bb_imag_freq / actual_rx_rate);
-                    const double suppression = tone_dbrms - imag_dbrms;
-
-                    if (suppression > best_suppression) {
-                        best_suppression = suppression;
-                        best_phase_corr  = phase_corr;
-                        best_ampl_corr   = ampl_corr;
-                    }
-                }
-            }
-
-            phase_corr_start = best_phase_corr - phase_corr_step;
-            phase_corr_stop  = best_phase_corr + phase_corr_step;
-            phase_corr_step =
-                (phase_corr_stop - phase_corr_start) / (num_search_steps + 1);
-            ampl_corr_start = best_ampl_corr - ampl_corr_step;
-            ampl_corr_stop  = best_ampl_corr + ampl_corr_step;
-            ampl_corr_step  = (ampl_corr_stop - ampl_corr_start) / (num_search_steps + 1);
-        }
+        std::complex<double> best_corr;
+        search_correction(
+            [&](const std::complex<double>& correction) {
+                usrp->set_rx_iq_balance(correction);
+                capture_samples_without_tx_error(usrp,
+                    rx_stream,
+                    tx_stream,
+                    buff,
+                    nsamps,
+                    tx_error_count,
+                    vm.count("verbose") > 0);
+                const double tone_dbrms =
+                    compute_tone_dbrms(buff, bb_tone_freq / actual_rx_rate);
+                const double imag_dbrms =
+                    compute_tone_dbrms(buff, bb_imag_freq / actual_rx_rate);
+                return tone_dbrms - imag_dbrms;
+            },
+            precision,
+            vm.count("fast") > 0,
+            best_corr,
+            best_suppression);
 
         if (best_suppression > initial_suppression) // keep result
         {
             result_t result;
             result.freq      = rx_lo;
-            result.real_corr = best_ampl_corr;
-            result.imag_corr = best_phase_corr;
+            result.real_corr = best_corr.real();
+            result.imag_corr = best_corr.imag();
             result.best      = best_suppression;
             result.delta     = best_suppression - initial_suppression;
             results.push_back(result);
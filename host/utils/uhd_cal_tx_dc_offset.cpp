@@ -105,6 +105,7 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
     desc.add_options()
         ("help", "help message")
         ("verbose", "enable some verbose")
+        ("fast", "Search the corrections with fewer captures: a coarse grid, then the neighbours of the best correction")
         ("args", po::value<std::string>(&args)->default_value(""), "device address args [default = \"\"]")
         ("subdev", po::value<std::string>(&subdev), "Subdevice specification (default: first subdevice, often 'A')")
         ("tx_wave_freq", po::value<double>(&tx_wave_freq)->default_value(507.123e3), "Transmit wave frequency in Hz")
@@ -212,66 +213,29 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
         const double initial_dc_dbrms =
             compute_tone_dbrms(buff, bb_dc_freq / actual_rx_rate);
 
-        // bounds and results from searching
-        double i_corr_start  = -1.0;
-        double i_corr_stop   = 1.0;
-        double i_corr_step   = (i_corr_stop - i_corr_start) / (num_search_steps + 1);
-        double q_corr_start  = -1.0;
-        double q_corr_stop   = 1.0;
-        double q_corr_step   = (q_corr_stop - q_corr_start) / (num_search_steps + 1);
+        // search for the correction with the lowest DC offset
         double best_dc_dbrms = initial_dc_dbrms;
-        double best_i_corr   = 0;
-        double best_q_corr   = 0;
-        while (i_corr_step >= precision or q_corr_step >= precision) {
-            for (double i_corr = i_corr_start + i_corr_step;
-                 i_corr <= i_corr_stop - i_corr_step;
-                 i_corr += i_corr_step) {
-                for (double q_corr = q_corr_start + q_corr_step;
-                     q_corr <= q_corr_stop - q_corr_step;
-                     q_corr += q_corr_step) {
-                    const std::complex<double> correction(i_corr, q_corr);
-                    usrp->set_tx_dc_offset(correction);
-
-                    // receive some samples
-                    capture_samples(usrp, rx_stream, buff, nsamps);
-                    // check for TX errors in the current captured iteration
-                    if (has_tx_error(tx_stream)) {
-                        std::cout << "[WARNING] TX error detected! "
-                                  << "Repeating current iteration" << std::endl;
-                        // Undo the Q correction step
-                        q_corr -= q_corr_step;
-                        tx_error_count++;
-                        if (tx_error_count >= MAX_NUM_TX_ERRORS) {
-                            throw uhd::runtime_error(
-                                "Too many TX errors. Aborting calibration.");
-                        }
-                        continue;
-                    }
-                    const double dc_dbrms =
-                        compute_tone_dbrms(buff, bb_dc_freq / actual_rx_rate);
-
-                    if (dc_dbrms < best_dc_dbrms) {
-                        best_dc_dbrms = dc_dbrms;
-                        best_i_corr   = i_corr;
-                        best_q_corr   = q_corr;
-                    }
-                }
-            }
-
-            i_corr_start = best_i_corr - i_corr_step;
-            i_corr_stop  = best_i_corr + i_corr_step;
-            i_corr_step  = (i_corr_stop - i_corr_start) / (num_search_steps + 1);
-            q_corr_start = best_q_corr - q_corr_step;
-            q_corr_stop  = best_q_corr + q_corr_step;
-            q_corr_step  = (q_corr_stop - q_corr_start) / (num_search_steps + 1);
-        }
+        std::complex<double> best_corr;
+        double neg_best_dc_dbrms = -best_dc_dbrms;
+        search_correction(
+            [&](const std::complex<double>& correction) {
+                usrp->set_tx_dc_offset(correction);
+                capture_samples_without_tx_error(
+                    usrp, rx_stream, tx_stream, buff, nsamps, tx_error_count, true);
+                return -compute_tone_dbrms(buff, bb_dc_freq / actual_rx_rate);
+            },
+            precision,
+            vm.count("fast") > 0,
+            best_corr,
+            neg_best_dc_dbrms);
+        best_dc_dbrms = -neg_best_dc_dbrms;
 
         if (best_dc_dbrms < initial_dc_dbrms) // keep result
         {
             result_t result;
             result.freq      = tx_lo;
-            result.real_corr = best_i_corr;
-            result.imag_corr = best_q_corr;
+            result.real_corr = best_corr.real();
+            result.imag_corr = best_corr.imag();
             result.best      = best_dc_dbrms;
             result.delta     = initial_dc_dbrms - best_dc_dbrms;
             results.push_back(result);
@@ -19,6 +19,7 @@
 #include <boost/format.hpp>
 #include <boost/program_options.hpp>
 #include <cstdlib>
+#include <future>
 #include <iostream>
 #include <sstream>
 #include <vector>
@@ -286,8 +287,32 @@ static std::string get_device_pp_string(property_tree::sptr tree)
     ss << boost::format("Device: %s") % (tree->access<std::string>("/name").get())
        << std::endl;
     // ss << std::endl;
+    // The motherboards don't share their control paths, so query them
+    // concurrently; many of the properties are register or RPC reads
+    std::vector<std::future<std::string>> mboard_strings;
     for (const std::string& name : tree->list("/mboards")) {
-        ss << make_border(get_mboard_pp_string(tree, "/mboards/" + name));
+        mboard_strings.push_back(std::async(std::launch::async,
+            [tree, name]() { return get_mboard_pp_string(tree, "/mboards/" + name); }));
+    }
+    for (auto& mboard_string : mboard_strings) {
+        ss << make_border(mboard_string.get());
+    }
+    return ss.str();
+}
+
+static std::string get_snapshot_pp_string(const device_addrs_t& device_addrs)
+{
+    std::stringstream ss;
+    ss << "Discovered devices (not initialized):" << std::endl;
+    for (const device_addr_t& device_addr : device_addrs) {
+        std::stringstream dev_ss;
+        dev_ss << boost::format("Device: %s") % device_addr.get("type", "unknown")
+               << std::endl;
+        for (const std::string& key : device_addr.keys()) {
+            if (key != "type" and not device_addr[key].empty())
+                dev_ss << boost::format("%s: %s") % key % device_addr[key] << std::endl;
+        }
+        ss << make_border(dev_ss.str());
     }
     return ss.str();
 }
@@ -316,6 +341,7 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
         ("range", po::value<std::string>(), "query a range (gain, bandwidth, frequency, ...)  from the property tree")
         ("vector", "when querying a string, interpret that as std::vector")
         ("init-only", "skip all queries, only initialize device")
+        ("snapshot", "only print what discovery reports about the devices, without initializing them")
     ;
     // clang-format on
 
@@ -334,6 +360,16 @@ int UHD_SAFE_MAIN(int argc, char* argv[])
         return EXIT_SUCCESS;
     }
 
+    if (vm.count("snapshot")) {
+        const device_addrs_t device_addrs = device::find(vm["args"].as<std::string>());
+        if (device_addrs.empty()) {
+            std::cerr << "No devices found." << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::cout << make_border(get_snapshot_pp_string(device_addrs)) << std::endl;
+        return EXIT_SUCCESS;
+    }
+
     device::sptr dev         = device::make(vm["args"].as<std::string>());
     property_tree::sptr tree = dev->get_tree();
 
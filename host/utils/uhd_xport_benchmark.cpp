@@ -0,0 +1,254 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+
+// Benchmark UDP transports against a remote reflector or sink, e.g. to
+// qualify the NIC, driver and CPU setup of a new host.
+
+#include "xport_benchmarker.hpp"
+#include <uhd/exception.hpp>
+#include <uhd/transport/udp_zero_copy.hpp>
+#include <uhd/utils/safe_main.hpp>
+#include <uhdlib/utils/cpu_affinity.hpp>
+#include <boost/algorithm/string.hpp>
+#include <boost/format.hpp>
+#include <boost/program_options.hpp>
+#include <fstream>
+#include <iostream>
+
+namespace po = boost::program_options;
+using namespace uhd::transport;
+
+namespace {
+
+//! Expand "key=v1:v2:v3" sweeps into the cartesian product of all values
+std::vector<uhd::device_addr_t> make_sweep_points(
+    const uhd::device_addr_t& base, const std::vector<std::string>& sweeps)
+{
+    std::vector<uhd::device_addr_t> points{base};
+    for (const std::string& sweep : sweeps) {
+        const size_t eq = sweep.find('=');
+        if (eq == std::string::npos) {
+            throw uhd::value_error("Invalid sweep, expected key=v1:v2:...: " + sweep);
+        }
+        const std::string key = sweep.substr(0, eq);
+        std::vector<std::string> values;
+        boost::split(values, sweep.substr(eq + 1), boost::is_any_of(":"));
+        std::vector<uhd::device_addr_t> new_points;
+        for (const auto& point : points) {
+            for (const std::string& value : values) {
+                uhd::device_addr_t new_point = point;
+                new_point[key]               = value;
+                new_points.push_back(new_point);
+            }
+        }
+        points = new_points;
+    }
+    return points;
+}
+
+//! Parse "TX_CPUS/RX_CPUS" (or "none") into a benchmark config
+void apply_affinity(const std::string& affinity, xport_benchmarker::config_t& config)
+{
+    config.tx_cpus.clear();
+    config.rx_cpus.clear();
+    if (affinity == "none") {
+        return;
+    }
+    const size_t slash = affinity.find('/');
+    if (slash == std::string::npos) {
+        throw uhd::value_error("Invalid affinity, expected TX_CPUS/RX_CPUS: " + affinity);
+    }
+    config.tx_cpus = uhd::parse_cpu_list(affinity.substr(0, slash));
+    config.rx_cpus = uhd::parse_cpu_list(affinity.substr(slash + 1));
+}
+
+void print_text(std::ostream& out,
+    const uhd::device_addr_t& point,
+    const std::string& affinity,
+    const xport_benchmarker::results_t& results)
+{
+    out << boost::format("Transport args: %s, affinity: %s, packet size: %d")
+               % point.to_string() % affinity % results.packet_size
+        << std::endl;
+    for (size_t i = 0; i < results.streams.size(); i++) {
+        const auto& stream = results.streams[i];
+        out << boost::format("  Stream %d: TX %.2f MB/s, RX %.2f MB/s, "
+                             "%d TX timeouts, %d RX timeouts, "
+                             "%d data errors, %d sequence errors")
+                   % i % (stream.tx_rate / 1e6) % (stream.rx_rate / 1e6)
+                   % stream.tx_timeouts % stream.rx_timeouts % stream.data_errors
+                   % stream.seq_errors
+            << std::endl;
+    }
+    const uhd::device_addr_t totals = results.to_device_addr();
+    for (const std::string& key : totals.keys()) {
+        out << "  " << key << ": " << totals[key] << std::endl;
+    }
+}
+
+void print_csv_header(std::ostream& out)
+{
+    out << "args,affinity,packet_size,stream,tx_packets,rx_packets,tx_bytes,rx_bytes,"
+           "tx_timeouts,rx_timeouts,data_errors,seq_errors,tx_rate,rx_rate";
+    for (const double percentile : xport_benchmarker::get_latency_percentiles()) {
+        out << ",latency_p" << percentile << "_us";
+    }
+    out << std::endl;
+}
+
+void print_csv_line(std::ostream& out,
+    const uhd::device_addr_t& point,
+    const std::string& affinity,
+    const size_t packet_size,
+    const std::string& stream_name,
+    const xport_benchmarker::stream_results_t& s)
+{
+    out << "\"" << point.to_string() << "\"," << affinity << "," << packet_size << ","
+        << stream_name << "," << s.tx_packets << "," << s.rx_packets << ","
+        << s.tx_bytes << "," << s.rx_bytes << "," << s.tx_timeouts << ","
+        << s.rx_timeouts << "," << s.data_errors << "," << s.seq_errors << ","
+        << s.tx_rate << "," << s.rx_rate;
+    for (size_t i = 0; i < xport_benchmarker::get_latency_percentiles().size(); i++) {
+        out << ",";
+        if (i < s.latency_us.size()) {
+            out << s.latency_us[i].second;
+        }
+    }
+    out << std::endl;
+}
+
+} // namespace
+
+int UHD_SAFE_MAIN(int argc, char* argv[])
+{
+    std::string addr, ports, args, mode, format, output_file;
+    std::vector<std::string> sweeps, affinities;
+    std::vector<size_t> packet_sizes;
+    double duration;
+    uint32_t sid;
+
+    po::options_description desc("Transport benchmark options");
+    // clang-format off
+    desc.add_options()
+        ("help", "help message")
+        ("addr", po::value<std::string>(&addr), "IP address of the remote end")
+        ("ports", po::value<std::string>(&ports)->default_value("49153"), "UDP ports of the remote end, one stream per port (e.g. 49153:49154)")
+        ("mode", po::value<std::string>(&mode)->default_value("loopback"), "loopback: the remote end reflects the packets back; tx: the remote end only receives")
+        ("args", po::value<std::string>(&args)->default_value(""), "Transport args for all runs (e.g. num_recv_frames=128,recv_batch_size=16)")
+        ("sweep", po::value<std::vector<std::string>>(&sweeps), "Sweep a transport arg, e.g. recv_frame_size=1472:4000:8000. Can be given several times, all combinations are run.")
+        ("packet-size", po::value<std::vector<size_t>>(&packet_sizes), "Packet size in bytes, can be given several times (default: largest frame size)")
+        ("affinity", po::value<std::vector<std::string>>(&affinities), "CPU placement as TX_CPUS/RX_CPUS (e.g. 2/3 or 2-3/4-5), or none. Can be given several times.")
+        ("duration", po::value<double>(&duration)->default_value(5.0), "Duration of every run in seconds")
+        ("sid", po::value<uint32_t>(&sid)->default_value(0), "SID to put into the packets")
+        ("latency", "Measure per-packet latency (loopback mode only)")
+        ("big-endian", "Send big-endian CHDR packets")
+        ("format", po::value<std::string>(&format)->default_value("text"), "Output format: text, csv or json")
+        ("output", po::value<std::string>(&output_file), "Write the results to this file instead of stdout")
+    ;
+    // clang-format on
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help") or not vm.count("addr")) {
+        std::cout << "UHD Transport Benchmark " << desc << std::endl
+                  << "Benchmarks UDP transports with a CHDR data stream. In loopback "
+                     "mode, the remote end must send every packet back to where it "
+                     "came from."
+                  << std::endl;
+        return vm.count("help") ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    if (mode != "loopback" and mode != "tx") {
+        throw uhd::value_error("Invalid mode: " + mode);
+    }
+    if (format != "text" and format != "csv" and format != "json") {
+        throw uhd::value_error("Invalid format: " + format);
+    }
+    if (packet_sizes.empty()) {
+        packet_sizes.push_back(0);
+    }
+    if (affinities.empty()) {
+        affinities.push_back("none");
+    }
+    std::vector<std::string> port_list;
+    boost::split(port_list, ports, boost::is_any_of(":,"));
+
+    const bool loopback = (mode == "loopback");
+    xport_benchmarker::xport_factory_t factory =
+        [&](const uhd::device_addr_t& xport_args) {
+            std::vector<xport_benchmarker::stream_t> streams;
+            for (const std::string& port : port_list) {
+                zero_copy_xport_params default_buff_args;
+                default_buff_args.recv_frame_size = 8000;
+                default_buff_args.send_frame_size = 8000;
+                default_buff_args.num_recv_frames = 32;
+                default_buff_args.num_send_frames = 32;
+                udp_zero_copy::buff_params buff_params;
+                zero_copy_if::sptr xport = udp_zero_copy::make(
+                    addr, port, default_buff_args, buff_params, xport_args);
+                streams.push_back({xport, loopback ? xport : zero_copy_if::sptr(), sid});
+            }
+            return streams;
+        };
+
+    xport_benchmarker::config_t config;
+    config.duration_ms     = uint32_t(duration * 1000);
+    config.big_endian      = bool(vm.count("big-endian"));
+    config.measure_latency = loopback and vm.count("latency");
+
+    std::ofstream file;
+    if (vm.count("output")) {
+        file.open(output_file.c_str());
+    }
+    std::ostream& out = vm.count("output") ? file : std::cout;
+
+    const std::vector<uhd::device_addr_t> points =
+        make_sweep_points(uhd::device_addr_t(args), sweeps);
+    xport_benchmarker benchmarker;
+    bool first = true;
+    if (format == "csv") {
+        print_csv_header(out);
+    } else if (format == "json") {
+        out << "[";
+    }
+    for (const std::string& affinity : affinities) {
+        apply_affinity(affinity, config);
+        for (const size_t packet_size : packet_sizes) {
+            config.packet_size = packet_size;
+            for (const auto& result : benchmarker.sweep(factory, points, config)) {
+                if (format == "csv") {
+                    for (size_t i = 0; i < result.second.streams.size(); i++) {
+                        print_csv_line(out,
+                            result.first,
+                            affinity,
+                            result.second.packet_size,
+                            std::to_string(i),
+                            result.second.streams[i]);
+                    }
+                    print_csv_line(out,
+                        result.first,
+                        affinity,
+                        result.second.packet_size,
+                        "total",
+                        result.second.total);
+                } else if (format == "json") {
+                    out << (first ? "" : ",") << std::endl
+                        << "{\"args\": \"" << result.first.to_string()
+                        << "\", \"affinity\": \"" << affinity
+                        << "\", \"results\": " << result.second.to_json() << "}";
+                } else {
+                    print_text(out, result.first, affinity, result.second);
+                }
+                first = false;
+            }
+        }
+    }
+    if (format == "json") {
+        out << std::endl << "]" << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -12,6 +12,7 @@
 #include <uhd/utils/paths.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/format.hpp>
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <complex>
@@ -144,13 +145,22 @@ private:
 static inline double compute_tone_dbrms(const std::vector<samp_type>& samples,
     const double freq) // freq is fractional
 {
-    // shift the samples so the tone at freq is down at DC
-    // and average the samples to measure the DC component
-    samp_type average = 0;
-    for (size_t i = 0; i < samples.size(); i++)
-        average += samp_type(std::polar(1.0, -freq * tau * i)) * samples[i];
+    // Goertzel filter: correlates the samples with the tone at freq like a
+    // single DFT bin, but with one real multiply per sample instead of a
+    // sin/cos evaluation. Only the magnitude of the result is needed, which
+    // saves the final phase correction.
+    const double w     = tau * freq;
+    const double coeff = 2 * std::cos(w);
+    std::complex<double> s1 = 0, s2 = 0;
+    for (const samp_type& sample : samples) {
+        const std::complex<double> s0 = std::complex<double>(sample) + coeff * s1 - s2;
+        s2 = s1;
+        s1 = s0;
+    }
+    const std::complex<double> average =
+        (s1 - std::polar(1.0, -w) * s2) / double(samples.size());
 
-    return 20 * std::log10(std::abs(average / float(samples.size())));
+    return 20 * std::log10(std::abs(average));
 }
 
 /***********************************************************************
@@ -389,6 +399,118 @@ bool has_tx_error(uhd::tx_streamer::sptr tx_stream)
                  | uhd::async_metadata_t::EVENT_CODE_SEQ_ERROR_IN_BURST);
 }
 
+/*! Capture samples like capture_samples(), and capture again if the
+ *  transmitter reported an error in the meantime
+ *
+ * \param tx_error_count counts the errors, throws if there are too many
+ */
+static void capture_samples_without_tx_error(uhd::usrp::multi_usrp::sptr usrp,
+    uhd::rx_streamer::sptr rx_stream,
+    uhd::tx_streamer::sptr tx_stream,
+    std::vector<samp_type>& buff,
+    const size_t nsamps_requested,
+    size_t& tx_error_count,
+    const bool verbose)
+{
+    capture_samples(usrp, rx_stream, buff, nsamps_requested);
+    while (has_tx_error(tx_stream)) {
+        if (verbose) {
+            std::cout << "[WARNING] TX error detected! "
+                      << "Repeating current iteration" << std::endl;
+        }
+        tx_error_count++;
+        if (tx_error_count >= MAX_NUM_TX_ERRORS) {
+            throw uhd::runtime_error("Too many TX errors. Aborting calibration.");
+        }
+        capture_samples(usrp, rx_stream, buff, nsamps_requested);
+    }
+}
+
+/***********************************************************************
+ * Search for the best correction
+ **********************************************************************/
+/*!
+ * Find the correction within -1...1 (real and imaginary part) which
+ * maximizes \p measure.
+ *
+ * The grid search measures a grid of num_search_steps x num_search_steps
+ * corrections and then zooms in on the best one, until the grid step is
+ * below \p precision. The fast search starts with the same grid, but then
+ * only measures the 8 neighbours of the best correction and halves the step
+ * each time, which takes about half as many captures.
+ *
+ * \param measure returns the figure of merit of a correction
+ * \param precision the step at which to stop
+ * \param fast use the fast search
+ * \param best_corr returns the best correction
+ * \param best_value the value to beat on input, the best value on output
+ */
+template <typename measure_t>
+static void search_correction(const measure_t& measure,
+    const double precision,
+    const bool fast,
+    std::complex<double>& best_corr,
+    double& best_value)
+{
+    double real_corr_start = -1.0;
+    double real_corr_stop  = 1.0;
+    double real_corr_step =
+        (real_corr_stop - real_corr_start) / (num_search_steps + 1);
+    double imag_corr_start = -1.0;
+    double imag_corr_stop  = 1.0;
+    double imag_corr_step =
+        (imag_corr_stop - imag_corr_start) / (num_search_steps + 1);
+    best_corr = 0;
+    while (real_corr_step >= precision or imag_corr_step >= precision) {
+        for (double imag_corr = imag_corr_start + imag_corr_step;
+             imag_corr <= imag_corr_stop - imag_corr_step;
+             imag_corr += imag_corr_step) {
+            for (double real_corr = real_corr_start + real_corr_step;
+                 real_corr <= real_corr_stop - real_corr_step;
+                 real_corr += real_corr_step) {
+                const std::complex<double> correction(real_corr, imag_corr);
+                const double value = measure(correction);
+                if (value > best_value) {
+                    best_value = value;
+                    best_corr  = correction;
+                }
+            }
+        }
+        if (fast) {
+            break;
+        }
+        real_corr_start = best_corr.real() - real_corr_step;
+        real_corr_stop  = best_corr.real() + real_corr_step;
+        real_corr_step  = (real_corr_stop - real_corr_start) / (num_search_steps + 1);
+        imag_corr_start = best_corr.imag() - imag_corr_step;
+        imag_corr_stop  = best_corr.imag() + imag_corr_step;
+        imag_corr_step  = (imag_corr_stop - imag_corr_start) / (num_search_steps + 1);
+    }
+    if (not fast) {
+        return;
+    }
+
+    double step = std::max(real_corr_step, imag_corr_step) / 2;
+    while (step >= precision) {
+        const std::complex<double> center = best_corr;
+        for (int imag_i = -1; imag_i <= 1; imag_i++) {
+            for (int real_i = -1; real_i <= 1; real_i++) {
+                if (real_i == 0 and imag_i == 0) {
+                    continue;
+                }
+                const std::complex<double> correction =
+                    center + std::complex<double>(real_i * step, imag_i * step);
+                const double value = measure(correction);
+                if (value > best_value) {
+                    best_value = value;
+                    best_corr  = correction;
+                }
+            }
+        }
+        step /= 2;
+    }
+}
+
 void wait_for_lo_lock(uhd::usrp::multi_usrp::sptr usrp)
 {
     std::this_thread::sleep_for(std::chrono::milliseconds(50));
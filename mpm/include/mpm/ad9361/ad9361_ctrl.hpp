@@ -46,6 +46,7 @@ void export_catalina(py::module& top_module)
         .def("set_active_chains", &ad9361_ctrl::set_active_chains)
         .def("set_timing_mode", &ad9361_ctrl::set_timing_mode)
         .def("tune", &ad9361_ctrl::tune)
+        .def("set_fastlock_profiles", &ad9361_ctrl::set_fastlock_profiles)
         .def("set_dc_offset", &ad9361_ctrl::set_dc_offset)
         .def("set_dc_offset_auto", &ad9361_ctrl::set_dc_offset_auto)
         .def("set_iq_balance", &ad9361_ctrl::set_iq_balance)
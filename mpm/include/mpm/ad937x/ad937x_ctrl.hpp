@@ -236,6 +236,31 @@ public:
      */
     virtual double get_freq(const std::string& which) = 0;
 
+    /*! \brief Pre-characterize RF frequencies for fast retuning
+     *
+     * Tunes the RF PLL for the direction specified in which to each of freqs
+     * and waits for lock, then restores the current frequency. A later
+     * set_freq() to one of these frequencies skips the frequency readback,
+     * and is a no-op if the PLL is already locked there. The list is cleared
+     * when the clocking changes.
+     *
+     * \param which frontend string to specify direction to characterize
+     * \param freqs list of RF frequencies
+     * \return actual frequencies
+     */
+    virtual std::vector<double> characterize_lo_freqs(
+        const std::string& which, const std::vector<double>& freqs) = 0;
+
+    /*! \brief Returns true if set_freq() to value can use the LO cache
+     *
+     * \param which frontend string to specify direction
+     * \param value RF frequency
+     */
+    virtual bool has_cached_lo_freq(const std::string& which, const double value) = 0;
+
+    //! Forget all pre-characterized frequencies
+    virtual void clear_lo_cache() = 0;
+
     /*! \brief Returns the LO lock status
      *
      * Note there's only one LO per direction, so the channel doesn't really
@@ -370,6 +395,9 @@ void export_mykonos(py::module& top_module)
                 return false;
         })
         .def("get_freq", &ad937x_ctrl::get_freq)
+        .def("characterize_lo_freqs", &ad937x_ctrl::characterize_lo_freqs)
+        .def("has_cached_lo_freq", &ad937x_ctrl::has_cached_lo_freq)
+        .def("clear_lo_cache", &ad937x_ctrl::clear_lo_cache)
         .def("get_lo_locked", &ad937x_ctrl::get_lo_locked)
         .def("set_fir", &ad937x_ctrl::set_fir)
         .def("get_fir", &ad937x_ctrl::get_fir)
@@ -10,6 +10,7 @@
 #include <boost/noncopyable.hpp>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace mpm { namespace spi {
 
@@ -36,6 +37,16 @@ public:
      */
     virtual uint32_t transfer24_16(const uint32_t data) = 0;
 
+    /*! Write many 24-bit xfers, discarding the read data.
+     *
+     * This is the same as calling transfer24_8() for every value in \p data,
+     * but the xfers are handed to the driver in batches instead of one at a
+     * time.
+     *
+     * \param data The write data for the xfers, in order
+     */
+    virtual void write24(const std::vector<uint32_t>& data) = 0;
+
     /*!
      * \param device The path to the spidev used (e.g. "/dev/spidev0.0")
      * \param speed_hz Transaction speed in Hz
@@ -10,6 +10,9 @@
 #include <boost/noncopyable.hpp>
 #include <cstdint>
 #include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 namespace mpm { namespace types {
 
@@ -37,6 +40,27 @@ public:
     //! Read data from \p addr
     uint32_t peek32(const uint32_t addr);
 
+    //! Read data from all addresses in \p addrs, in order
+    std::vector<uint32_t> peeks32(const std::vector<uint32_t>& addrs);
+
+    //! Write a list of (address, data) pairs, in order
+    void pokes32(const std::vector<std::pair<uint32_t, uint32_t>>& addr_vals);
+
+    /*! Read-modify-write: Write \p data to the bits of \p addr that are set
+     * in \p mask, and leave the other bits as they are
+     *
+     * \returns the value that was written
+     */
+    uint32_t modify32(const uint32_t addr, const uint32_t mask, const uint32_t data);
+
+    /*! Apply a list of (address, mask, data) read-modify-writes, in order
+     *
+     * See modify32(). Every entry reads the register again, so several entries
+     * can modify the same register.
+     */
+    void modifies32(
+        const std::vector<std::tuple<uint32_t, uint32_t, uint32_t>>& addr_mask_vals);
+
 private:
     void log(mpm::types::log_level_t level, const std::string path, const char* comment);
 
@@ -8,6 +8,8 @@
 
 #include <boost/noncopyable.hpp>
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace mpm { namespace types {
 
@@ -26,6 +28,19 @@ public:
      */
     virtual void poke8(const uint32_t addr, const uint8_t data) = 0;
 
+    /*! Write a series of 8-bit values, in order
+     *
+     * The default implementation calls poke8() for every (address, value)
+     * pair. Buses which can queue writes (like SPI) override this to send
+     * them in batches.
+     */
+    virtual void pokes8(const std::vector<std::pair<uint32_t, uint8_t>>& addr_vals)
+    {
+        for (const auto& addr_val : addr_vals) {
+            poke8(addr_val.first, addr_val.second);
+        }
+    }
+
     /*! Return a 16-bit value from a given address
      */
     virtual uint16_t peek16(const uint32_t addr) = 0;
@@ -24,6 +24,14 @@ void export_types(py::module& top_module)
     py::class_<regs_iface, std::shared_ptr<regs_iface>>(m, "regs_iface")
         .def("peek8", &regs_iface::peek8)
         .def("poke8", &regs_iface::poke8)
+        .def("pokes8",
+            [](regs_iface& self, py::iterable addr_vals) {
+                std::vector<std::pair<uint32_t, uint8_t>> pokes;
+                for (const auto& addr_val : addr_vals) {
+                    pokes.push_back(addr_val.cast<std::pair<uint32_t, uint8_t>>());
+                }
+                self.pokes8(pokes);
+            })
         .def("peek16", &regs_iface::peek16)
         .def("poke16", &regs_iface::poke16);
 
@@ -45,5 +53,34 @@ void export_types(py::module& top_module)
         .def("open", &mmap_regs_iface::open)
         .def("close", &mmap_regs_iface::close)
         .def("peek32", &mmap_regs_iface::peek32)
-        .def("poke32", &mmap_regs_iface::poke32);
+        .def("poke32", &mmap_regs_iface::poke32)
+        .def("peeks32",
+            [](mmap_regs_iface& self, py::iterable addrs) {
+                std::vector<uint32_t> addr_list;
+                for (const auto& addr : addrs) {
+                    addr_list.push_back(addr.cast<uint32_t>());
+                }
+                py::list data;
+                for (const uint32_t value : self.peeks32(addr_list)) {
+                    data.append(value);
+                }
+                return data;
+            })
+        .def("pokes32",
+            [](mmap_regs_iface& self, py::iterable addr_vals) {
+                std::vector<std::pair<uint32_t, uint32_t>> pokes;
+                for (const auto& addr_val : addr_vals) {
+                    pokes.push_back(addr_val.cast<std::pair<uint32_t, uint32_t>>());
+                }
+                self.pokes32(pokes);
+            })
+        .def("modify32", &mmap_regs_iface::modify32)
+        .def("modifies32", [](mmap_regs_iface& self, py::iterable addr_mask_vals) {
+            std::vector<std::tuple<uint32_t, uint32_t, uint32_t>> modifies;
+            for (const auto& addr_mask_val : addr_mask_vals) {
+                modifies.push_back(
+                    addr_mask_val.cast<std::tuple<uint32_t, uint32_t, uint32_t>>());
+            }
+            self.modifies32(modifies);
+        });
 }
@@ -417,6 +417,35 @@ public:
         return device.get_freq(dir);
     }
 
+    virtual std::vector<double> characterize_lo_freqs(
+        const std::string& which, const std::vector<double>& freqs)
+    {
+        const auto dir = _get_direction_from_antenna(which);
+        std::vector<double> clipped_freqs;
+        clipped_freqs.reserve(freqs.size());
+        for (const double freq : freqs) {
+            clipped_freqs.push_back(get_rf_freq_range().clip(freq));
+        }
+
+        std::lock_guard<std::mutex> lock(*spi_mutex);
+        return device.characterize_lo_freqs(dir, clipped_freqs);
+    }
+
+    virtual bool has_cached_lo_freq(const std::string& which, const double value)
+    {
+        const auto dir           = _get_direction_from_antenna(which);
+        const auto clipped_value = get_rf_freq_range().clip(value);
+
+        std::lock_guard<std::mutex> lock(*spi_mutex);
+        return device.has_cached_lo_freq(dir, clipped_value);
+    }
+
+    virtual void clear_lo_cache()
+    {
+        std::lock_guard<std::mutex> lock(*spi_mutex);
+        device.clear_lo_cache();
+    }
+
     virtual bool get_lo_locked(const std::string& which)
     {
         const auto dir           = _get_direction_from_antenna(which);
@@ -15,6 +15,7 @@
 #include <fstream>
 #include <functional>
 #include <iostream>
+#include <mutex>
 #include <thread>
 
 using namespace mpm::ad937x::device;
@@ -116,7 +117,22 @@ std::string ad937x_device::_get_arm_binary_path() const
 
 std::vector<uint8_t> ad937x_device::_get_arm_binary()
 {
+    // The binary is the same for all devices, so it's only read from storage
+    // again when the file changes. On N310, that's once for both daughterboards
+    // and all re-inits.
+    static std::mutex cache_mutex;
+    static std::string cached_path;
+    static std::time_t cached_write_time = 0;
+    static std::vector<uint8_t> cached_binary;
+
     const auto path = _get_arm_binary_path();
+    boost::system::error_code ec;
+    const std::time_t write_time = boost::filesystem::last_write_time(path, ec);
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    if (!ec && path == cached_path && write_time == cached_write_time) {
+        return cached_binary;
+    }
+
     std::ifstream file(path, std::ios::binary);
     if (!file.is_open()) {
         throw mpm::runtime_error("Could not open AD9371 ARM binary at path " + path);
@@ -128,6 +144,11 @@ std::vector<uint8_t> ad937x_device::_get_arm_binary()
     if (file.bad()) {
         throw mpm::runtime_error("Error reading AD9371 ARM binary at path " + path);
     }
+    if (!ec) {
+        cached_path       = path;
+        cached_write_time = write_time;
+        cached_binary     = binary;
+    }
     return binary;
 }
 
@@ -339,6 +360,7 @@ uint8_t ad937x_device::get_lo_source(const uhd::direction_t direction) const
 }
 void ad937x_device::begin_initialization()
 {
+    clear_lo_cache();
     CALL_API(MYKONOS_initialize(mykonos_config.device));
 
     _verify_product_id();
@@ -487,6 +509,7 @@ double ad937x_device::set_clock_rate(const double req_rate)
 {
     const auto rate = static_cast<uint32_t>(req_rate / 1000.0);
 
+    clear_lo_cache();
     const auto state                               = _move_to_config_state();
     mykonos_config.device->clocks->deviceClock_kHz = rate;
     CALL_API(MYKONOS_initDigitalClocks(mykonos_config.device));
@@ -531,6 +554,14 @@ double ad937x_device::tune(
             MPM_THROW_INVALID_CODE_PATH();
     }
 
+    auto& lo_cache       = _get_lo_cache(direction);
+    const auto cached_it = lo_cache.find(integer_value);
+    const bool is_cached = cached_it != lo_cache.end();
+    if (is_cached and *config_value == integer_value
+        and get_pll_lock_status(locked_pll)) {
+        return cached_it->second;
+    }
+
     const auto state = _move_to_config_state();
     *config_value    = integer_value;
     CALL_API(MYKONOS_setRfPllFrequency(mykonos_config.device, pll, integer_value));
@@ -542,7 +573,57 @@ double ad937x_device::tune(
     }
     _restore_from_config_state(state);
 
-    return get_freq(direction);
+    if (is_cached) {
+        return cached_it->second;
+    }
+    const double actual_freq = get_freq(direction);
+    if (wait_for_lock) {
+        lo_cache[integer_value] = actual_freq;
+    }
+    return actual_freq;
+}
+
+std::vector<double> ad937x_device::characterize_lo_freqs(
+    const direction_t direction, const std::vector<double>& freqs)
+{
+    const uint64_t prev_freq = (direction == TX_DIRECTION)
+                                   ? mykonos_config.device->tx->txPllLoFrequency_Hz
+                                   : mykonos_config.device->rx->rxPllLoFrequency_Hz;
+    std::vector<double> actual_freqs;
+    actual_freqs.reserve(freqs.size());
+    for (const double freq : freqs) {
+        if (has_cached_lo_freq(direction, freq)) {
+            actual_freqs.push_back(
+                _get_lo_cache(direction).at(static_cast<uint64_t>(freq)));
+            continue;
+        }
+        actual_freqs.push_back(tune(direction, freq, true));
+    }
+    tune(direction, static_cast<double>(prev_freq), false);
+    return actual_freqs;
+}
+
+bool ad937x_device::has_cached_lo_freq(const direction_t direction, const double value)
+{
+    return _get_lo_cache(direction).count(static_cast<uint64_t>(value)) > 0;
+}
+
+void ad937x_device::clear_lo_cache()
+{
+    _rx_lo_cache.clear();
+    _tx_lo_cache.clear();
+}
+
+std::map<uint64_t, double>& ad937x_device::_get_lo_cache(const direction_t direction)
+{
+    switch (direction) {
+        case TX_DIRECTION:
+            return _tx_lo_cache;
+        case RX_DIRECTION:
+            return _rx_lo_cache;
+        default:
+            MPM_THROW_INVALID_CODE_PATH();
+    }
 }
 
 double ad937x_device::set_bw_filter(const direction_t direction, const double value)
@@ -794,6 +875,7 @@ int16_t ad937x_device::get_temperature()
 
 void ad937x_device::set_master_clock_rate(const mcr_t rate)
 {
+    clear_lo_cache();
     switch (rate) {
         case MCR_125_00MHZ: {
             mykonos_config.device->clocks->deviceClock_kHz   = 125000;
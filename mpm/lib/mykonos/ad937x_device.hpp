@@ -20,7 +20,9 @@
 #include <boost/filesystem.hpp>
 #include <boost/noncopyable.hpp>
 #include <functional>
+#include <map>
 #include <memory>
+#include <vector>
 
 class ad937x_device : public boost::noncopyable
 {
@@ -80,6 +82,19 @@ public:
         const uhd::direction_t direction, const double value, const bool wait_for_lock);
     double get_freq(const uhd::direction_t direction);
 
+    /*! Tune to each of freqs, wait for the PLL to lock and store the actual
+     *  frequency in the LO cache. The original frequency is restored after.
+     *
+     * A later tune() to a cached frequency skips reading back the PLL
+     * frequency from the ARM, and is a no-op if the PLL is already there.
+     *
+     * \return the actual frequencies
+     */
+    std::vector<double> characterize_lo_freqs(
+        const uhd::direction_t direction, const std::vector<double>& freqs);
+    bool has_cached_lo_freq(const uhd::direction_t direction, const double value);
+    void clear_lo_cache();
+
     bool get_pll_lock_status(const uint8_t pll, const bool wait_for_lock = false);
 
     void set_fir(
@@ -117,6 +132,11 @@ private:
     ad937x_config_t mykonos_config;
     ad937x_gain_ctrl_config_t gain_ctrl;
 
+    //! Actual frequencies of locked RF PLL tunes, by requested frequency
+    std::map<uint64_t, double> _rx_lo_cache;
+    std::map<uint64_t, double> _tx_lo_cache;
+    std::map<uint64_t, double>& _get_lo_cache(const uhd::direction_t direction);
+
     void _apply_gain_pins(
         const uhd::direction_t direction, mpm::ad937x::device::chain_t chain);
     void _setup_rf();
@@ -138,3 +138,41 @@ int transfer(
     return 0;
 }
 
+int transfer_batch(
+        int fd,
+        uint8_t *tx, uint32_t len, uint32_t num_transfers,
+        uint32_t speed_hz, uint8_t bits_per_word, uint16_t delay_us
+) {
+    struct spi_ioc_transfer tr[SPIDEV_MAX_BATCH];
+    int err;
+
+    while (num_transfers > 0) {
+        const uint32_t n = num_transfers < SPIDEV_MAX_BATCH ?
+            num_transfers : SPIDEV_MAX_BATCH;
+        memset(tr, 0, n * sizeof(tr[0]));
+        for (uint32_t i = 0; i < n; i++) {
+            tr[i].tx_buf = (unsigned long) (tx + i * len);
+            tr[i].len = len;
+            tr[i].speed_hz = speed_hz;
+            tr[i].delay_usecs = delay_us;
+            tr[i].bits_per_word = bits_per_word;
+            // Release chip select between the transactions, but not after
+            // the last one (cs_change would keep it asserted there)
+            tr[i].cs_change = (i + 1 < n);
+            tr[i].tx_nbits = 1; // Standard SPI
+            tr[i].rx_nbits = 1; // Standard SPI
+        }
+
+        err = ioctl(fd, SPI_IOC_MESSAGE(n), tr);
+        if (err < 0) {
+            fprintf(stderr, "%s: Failed ioctl: %d\n", __func__, err);
+            perror("ioctl: \n");
+            return err;
+        }
+
+        tx += n * len;
+        num_transfers -= n;
+    }
+
+    return 0;
+}
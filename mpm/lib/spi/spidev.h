@@ -43,3 +43,32 @@ int transfer(
         uint32_t speed_hz, uint8_t bits_per_word, uint16_t delay_us
 );
 
+/*! Maximum number of transfers that transfer_batch() puts into one ioctl
+ *
+ * The kernel limits the size of a SPI_IOC_MESSAGE() to 511 transfers, and the
+ * spidev buffer to 4096 bytes (see the bufsiz module parameter).
+ */
+#define SPIDEV_MAX_BATCH 256
+
+/*! Do many write-only SPI transactions over spidev
+ *
+ * Every transaction is \p len bytes long and gets its own chip select cycle,
+ * same as calling transfer() for each of them. Up to SPIDEV_MAX_BATCH
+ * transactions are sent with a single ioctl.
+ *
+ * \param tx Buffer of data to be written, \p num_transfers * \p len bytes
+ * \param len Number of bytes in each transaction
+ * \param num_transfers Number of transactions
+ * \param speed_hz Speed of this transaction in Hz
+ * \param bits_per_word 8, dude
+ * \param delay_us Delay between transfers
+ *
+ * Assumption: spidev was configured properly beforehand.
+ *
+ * \returns 0 if all is golden
+ */
+int transfer_batch(
+        int fd,
+        uint8_t *tx, uint32_t len, uint32_t num_transfers,
+        uint32_t speed_hz, uint8_t bits_per_word, uint16_t delay_us
+);
@@ -14,6 +14,7 @@ extern "C" {
 #include <linux/spi/spidev.h>
 #include <boost/format.hpp>
 #include <iostream>
+#include <vector>
 
 using namespace mpm::spi;
 
@@ -79,6 +80,25 @@ public:
         return uint32_t(rx[1] << 8 | rx[2]);
     }
 
+    void write24(const std::vector<uint32_t>& data)
+    {
+        if (data.empty()) {
+            return;
+        }
+
+        std::vector<uint8_t> tx;
+        tx.reserve(3 * data.size());
+        for (const uint32_t word : data) {
+            tx.push_back(uint8_t(word >> 16));
+            tx.push_back(uint8_t(word >> 8));
+            tx.push_back(uint8_t(word));
+        }
+
+        if (transfer_batch(_fd, tx.data(), 3, data.size(), _speed, _bits, _delay) != 0) {
+            throw mpm::runtime_error(str(boost::format("SPI Transaction failed!")));
+        }
+    }
+
 private:
     int _fd;
     const uint32_t _mode;
@@ -93,6 +93,49 @@ uint32_t mmap_regs_iface::peek32(const uint32_t addr)
     return _mmap[addr / sizeof(uint32_t)];
 }
 
+// The bulk accessors go through volatile pointers, so the compiler can't
+// combine or reorder the register accesses of one call.
+std::vector<uint32_t> mmap_regs_iface::peeks32(const std::vector<uint32_t>& addrs)
+{
+    MPM_ASSERT_THROW(_mmap);
+    const volatile uint32_t* regs = _mmap;
+    std::vector<uint32_t> data;
+    data.reserve(addrs.size());
+    for (const uint32_t addr : addrs) {
+        data.push_back(uint32_t(regs[addr / sizeof(uint32_t)]));
+    }
+    return data;
+}
+
+void mmap_regs_iface::pokes32(const std::vector<std::pair<uint32_t, uint32_t>>& addr_vals)
+{
+    MPM_ASSERT_THROW(_mmap);
+    volatile uint32_t* regs = _mmap;
+    for (const auto& addr_val : addr_vals) {
+        regs[addr_val.first / sizeof(uint32_t)] = addr_val.second;
+    }
+}
+
+uint32_t mmap_regs_iface::modify32(
+    const uint32_t addr, const uint32_t mask, const uint32_t data)
+{
+    MPM_ASSERT_THROW(_mmap);
+    volatile uint32_t* reg = _mmap + addr / sizeof(uint32_t);
+    const uint32_t value   = (*reg & ~mask) | (data & mask);
+    *reg                   = value;
+    return value;
+}
+
+void mmap_regs_iface::modifies32(
+    const std::vector<std::tuple<uint32_t, uint32_t, uint32_t>>& addr_mask_vals)
+{
+    for (const auto& addr_mask_val : addr_mask_vals) {
+        modify32(std::get<0>(addr_mask_val),
+            std::get<1>(addr_mask_val),
+            std::get<2>(addr_mask_val));
+    }
+}
+
 void mmap_regs_iface::log(
     mpm::types::log_level_t level, const std::string path, const char* comment)
 {
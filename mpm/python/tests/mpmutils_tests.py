@@ -0,0 +1,66 @@
+#
+# Copyright 2019 Ettus Research, a National Instruments Brand
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+"""
+Tests related to usrp_mpm.mpmutils
+"""
+
+import threading
+import time
+from base_tests import TestBase
+from usrp_mpm.mpmutils import PhaseTimer
+
+
+class TestPhaseTimer(TestBase):
+    """
+    Tests the init phase bookkeeping of usrp_mpm.mpmutils.PhaseTimer.
+    """
+    def test_phases(self):
+        """
+        Test that phases are recorded in the order in which they finish,
+        and that running a phase again replaces its duration.
+        """
+        timer = PhaseTimer()
+        with timer.phase('slow'):
+            time.sleep(0.05)
+        with timer.phase('fast'):
+            pass
+        timings = timer.get()
+        self.assertEqual(list(timings.keys()), ['slow', 'fast'])
+        self.assertGreaterEqual(timings['slow'], 0.05)
+        with timer.phase('slow'):
+            pass
+        timings = timer.get()
+        self.assertEqual(list(timings.keys()), ['fast', 'slow'])
+        self.assertLess(timings['slow'], 0.05)
+
+    def test_exception(self):
+        """
+        Test that a phase which raises is still recorded.
+        """
+        timer = PhaseTimer()
+        with self.assertRaises(RuntimeError):
+            with timer.phase('broken'):
+                raise RuntimeError("broken phase")
+        self.assertIn('broken', timer.get())
+
+    def test_threads(self):
+        """
+        Test that phases can be timed from several threads at once.
+        """
+        timer = PhaseTimer()
+        def _phase(idx):
+            with timer.phase('phase{}'.format(idx)):
+                time.sleep(0.01)
+        threads = [
+            threading.Thread(target=_phase, args=(idx,)) for idx in range(8)
+        ]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+        self.assertEqual(
+            sorted(timer.get().keys()),
+            sorted('phase{}'.format(idx) for idx in range(8)))
@@ -10,9 +10,10 @@ USRP MPM Python Unit testing framework
 import unittest
 import sys
 from sys_utils_tests import TestNet
+from mpmutils_tests import TestPhaseTimer
 
 TESTS = {
-    '__all__': {TestNet},
+    '__all__': {TestNet, TestPhaseTimer},
     'n3xx': set(),
 }
 
@@ -31,7 +31,11 @@ class LMK04828(object):
         """
         Apply a series of pokes.
         pokes8((0,1),(0,2)) is the same as calling poke8(0,1), poke8(0,2).
+        Buses that support it write all the values in one batch.
         """
+        if hasattr(self.regs_iface, 'pokes8'):
+            self.regs_iface.pokes8(addr_vals)
+            return
         for addr, val in addr_vals:
             self.poke8(addr, val)
 
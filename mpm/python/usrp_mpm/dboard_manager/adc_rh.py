@@ -56,7 +56,11 @@ class AD9695Rh(object):
         """
         Apply a series of pokes.
         pokes8((0,1),(0,2)) is the same as calling poke8(0,1), poke8(0,2).
+        Buses that support it write all the values in one batch.
         """
+        if hasattr(self.regs, 'pokes8'):
+            self.regs.pokes8(addr_vals)
+            return
         for addr, val in addr_vals:
             self.regs.poke8(addr, val)
 
@@ -10,7 +10,7 @@ dboard base implementation module
 from builtins import object
 from six import iteritems
 from usrp_mpm.mpmlog import get_logger
-from usrp_mpm.mpmutils import to_native_str
+from usrp_mpm.mpmutils import to_native_str, PhaseTimer
 
 class DboardManagerBase(object):
     """
@@ -52,6 +52,8 @@ class DboardManagerBase(object):
             self.spi_chipselect
         )
         self.log.debug("spidev device node map: {}".format(self._spi_nodes))
+        # Subclasses record the durations of their init phases here
+        self._init_timer = PhaseTimer()
 
 
     def _init_spi_nodes(self, spi_devices, chip_select_map):
@@ -72,6 +74,13 @@ class DboardManagerBase(object):
             for spi_device, chip_select in iteritems(chip_select_map)
         }
 
+    def get_init_timings(self):
+        """
+        Returns a dictionary phase name -> duration in seconds of the most
+        recent run of every initialization phase of this dboard.
+        """
+        return dict(self._init_timer.get())
+
     def init(self, args):
         """
         Run the dboard initialization. This typically happens at the beginning
@@ -337,9 +337,15 @@ class Magnesium(BfrfsEEPROM, DboardManagerBase):
         call can take a long time to execute, and we want to release the GIL
         during that time.
 
+        Frequencies that were pre-characterized with characterize_lo_freqs()
+        are tuned synchronously, which skips the polling delay of the
+        asynchronous path.
+
         Note: This overrides the set_freq() call provided from self.mykonos.
         """
         self.log.trace("Tuning {} {} {}".format(which, freq, wait_for_lock))
+        if self.mykonos.has_cached_lo_freq(which, freq):
+            return self.mykonos.set_freq(which, freq, wait_for_lock)
         async_exec(self.mykonos, "set_freq", which, freq, wait_for_lock)
         return self.mykonos.get_freq(which)
 
@@ -464,11 +464,13 @@ class MagnesiumInitManager(object):
         jesdcore.send_sysref_pulse()
         time.sleep(0.001) # 17us... ish.
         jesdcore.send_sysref_pulse()
-        async_exec(self.mykonos, "finish_initialization")
+        with self.mg_class._init_timer.phase('mykonos_init'):
+            async_exec(self.mykonos, "finish_initialization")
         # According to the AD9371 user guide, p.57, the RF cal must come before
         # the framer/deframer init. We tried otherwise, and failed. So don't
         # move this anywhere else.
-        self.init_rf_cal(args)
+        with self.mg_class._init_timer.phase('rf_cal'):
+            self.init_rf_cal(args)
         self.log.trace("Starting JESD204b Link Initialization...")
         # Generally, enable the source before the sink. Start with the DAC side.
         self.log.trace("Starting FPGA framer...")
@@ -538,27 +540,30 @@ class MagnesiumInitManager(object):
             db_clk_control.reset_mmcm()
             jesdcore.reset()
             self.log.trace("Initializing LMK...")
-            self.mg_class.lmk = self._init_lmk(
-                self._spi_ifaces['lmk'],
-                ref_clock_freq,
-                master_clock_rate,
-                self._spi_ifaces['phase_dac'],
-                self.INIT_PHASE_DAC_WORD,
-                self.PHASE_DAC_SPI_ADDR,
-            )
+            with self.mg_class._init_timer.phase('lmk'):
+                self.mg_class.lmk = self._init_lmk(
+                    self._spi_ifaces['lmk'],
+                    ref_clock_freq,
+                    master_clock_rate,
+                    self._spi_ifaces['phase_dac'],
+                    self.INIT_PHASE_DAC_WORD,
+                    self.PHASE_DAC_SPI_ADDR,
+                )
             db_clk_control.enable_mmcm()
             # Synchronize DB Clocks
-            self._sync_db_clock(
-                dboard_ctrl_regs,
-                master_clock_rate,
-                ref_clock_freq,
-                args)
+            with self.mg_class._init_timer.phase('clock_sync'):
+                self._sync_db_clock(
+                    dboard_ctrl_regs,
+                    master_clock_rate,
+                    ref_clock_freq,
+                    args)
             self.log.debug(
                 "Sample Clocks and Phase DAC Configured Successfully!")
             # Clocks and PPS are now fully active!
             if args.get('skip_rfic', None) == None:
                 self.mykonos.set_master_clock_rate(master_clock_rate)
-                self.init_jesd(jesdcore, master_clock_rate, args)
+                with self.mg_class._init_timer.phase('jesd'):
+                    self.init_jesd(jesdcore, master_clock_rate, args)
             jesdcore = None # Help with garbage collection
             # That's all that requires access to the dboard regs!
         return True
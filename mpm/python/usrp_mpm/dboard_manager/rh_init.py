@@ -322,14 +322,15 @@ class RhodiumInitManager(object):
             jesdcore.reset()
             # Configure and bringup the LMK's clocks.
             self.log.trace("Initializing LMK...")
-            self.rh_class.lmk = self._init_lmk(
-                self._spi_ifaces['lmk'],
-                self.rh_class.ref_clock_freq,
-                self.rh_class.sampling_clock_rate,
-                self._spi_ifaces['phase_dac'],
-                self.INIT_PHASE_DAC_WORD,
-                self.PHASE_DAC_SPI_ADDR
-            )
+            with self.rh_class._init_timer.phase('lmk'):
+                self.rh_class.lmk = self._init_lmk(
+                    self._spi_ifaces['lmk'],
+                    self.rh_class.ref_clock_freq,
+                    self.rh_class.sampling_clock_rate,
+                    self._spi_ifaces['phase_dac'],
+                    self.INIT_PHASE_DAC_WORD,
+                    self.PHASE_DAC_SPI_ADDR
+                )
             self.log.trace("LMK Initialized!")
             # Deassert FPGA's MMCM reset, poll for lock, and enable outputs.
             db_clk_control.enable_mmcm()
@@ -337,20 +338,22 @@ class RhodiumInitManager(object):
             # 3. Synchronize DB Clocks.
             # The clock synchronzation driver receives the master_clock_rate, which for
             # Rhodium is half the sampling_clock_rate.
-            self._sync_db_clock(
-                radio_regs,
-                self.rh_class.ref_clock_freq,
-                self.rh_class.sampling_clock_rate / 2,
-                args)
+            with self.rh_class._init_timer.phase('clock_sync'):
+                self._sync_db_clock(
+                    radio_regs,
+                    self.rh_class.ref_clock_freq,
+                    self.rh_class.sampling_clock_rate / 2,
+                    args)
 
             # 4. DAC Configuration.
-            self.dac.config()
-
             # 5. ADC Configuration.
-            self.adc.config()
+            with self.rh_class._init_timer.phase('converters'):
+                self.dac.config()
+                self.adc.config()
 
             # 6-7. JESD204B Initialization.
-            self.init_jesd(jesdcore, self.rh_class.sampling_clock_rate)
+            with self.rh_class._init_timer.phase('jesd'):
+                self.init_jesd(jesdcore, self.rh_class.sampling_clock_rate)
             # [Optional] Perform RX eyescan.
             if perform_rx_eyescan:
                 self.log.info("Performing RX eye scan on ADC to FPGA link...")
@@ -364,7 +367,8 @@ class RhodiumInitManager(object):
             db_clk_control = None
 
         # 8. CPLD Gain Tables Initialization.
-        self.gain_table_loader.init()
+        with self.rh_class._init_timer.phase('gain_tables'):
+            self.gain_table_loader.init()
 
         return True
 
@@ -112,9 +112,39 @@ class EthDispatcherTable(object):
                     address. String format, ("aa:bb:cc:dd:ee:ff"), case does
                     not matter.
         """
-        udp_port = int(udp_port)
-        if mac_addr is None:
-            mac_addr = get_mac_addr(ip_addr)
+        self.set_routes(((sid, ip_addr, udp_port, mac_addr),))
+
+    def set_routes(self, routes):
+        """
+        Sets up many routes at once. Every route is a tuple with the arguments
+        of set_route(): (sid, ip_addr, udp_port[, mac_addr]).
+
+        The register writes of all routes go to the device in a single
+        pokes32() call, and every destination IP address is looked up only
+        once.
+        """
+        mac_addrs = {}
+        pokes = []
+        for route in routes:
+            sid, ip_addr, udp_port = route[:3]
+            mac_addr = route[3] if len(route) > 3 else None
+            if mac_addr is None:
+                if ip_addr not in mac_addrs:
+                    mac_addrs[ip_addr] = get_mac_addr(ip_addr)
+                mac_addr = mac_addrs[ip_addr]
+            pokes.extend(self._get_route_pokes(sid, ip_addr, int(udp_port), mac_addr))
+        for addr, data in pokes:
+            self.log.trace("Writing to address 0x{:04X}: 0x{:04X}".format(
+                addr, data
+            ))
+        with self._regs:
+            self._regs.pokes32(pokes)
+
+    def _get_route_pokes(self, sid, ip_addr, udp_port, mac_addr):
+        """
+        Returns the (address, value) pairs that route sid to ip_addr, udp_port
+        and mac_addr.
+        """
         if mac_addr is None:
             self.log.error(
                 "Could not resolve a MAC address for IP address `{}'".format(ip_addr)
@@ -152,27 +182,12 @@ class EthDispatcherTable(object):
         ip_addr_int = int(netaddr.IPAddress(ip_addr))
         mac_addr_int = int(netaddr.EUI(mac_addr))
         dst_offset = 4 * table_addr
-
-        def poke_and_trace(addr, data):
-            " Do a poke32() and log.trace() "
-            self.log.trace("Writing to address 0x{:04X}: 0x{:04X}".format(
-                addr, data
-            ))
-            self.poke32(addr, data)
-
-        with self._regs:
-            poke_and_trace(
-                ip_base_offset + dst_offset,
-                ip_addr_int
-            )
-            poke_and_trace(
-                mac_lo_base_offset + dst_offset,
-                mac_addr_int & 0xFFFFFFFF,
-            )
-            poke_and_trace(
-                port_mac_hi_base_offset + dst_offset,
-                (udp_port << 16) | (mac_addr_int >> 32)
-            )
+        return [
+            (ip_base_offset + dst_offset, ip_addr_int),
+            (mac_lo_base_offset + dst_offset, mac_addr_int & 0xFFFFFFFF),
+            (port_mac_hi_base_offset + dst_offset,
+             (udp_port << 16) | (mac_addr_int >> 32)),
+        ]
 
     def set_forward_policy(self, forward_eth, forward_bcast):
         """
@@ -15,6 +15,7 @@ import select
 import datetime
 import math
 import re
+import threading
 from usrp_mpm.mpmlog import get_logger
 
 
@@ -158,6 +159,110 @@ class GPSDIface(object):
         return result if (resp_class == "") else result.get(resp_class, [{}])[0]
 
 
+class GPSDWatcher(object):
+    """
+    Keeps a snapshot of the latest reports from GPSd.
+
+    A background thread keeps a WATCH connection to GPSd open and stores the
+    latest TPV report with a valid mode and the latest SKY report. Readers get
+    the snapshot without talking to GPSd, so they only wait if no report has
+    come in yet. If the connection to GPSd drops, the thread reconnects.
+    """
+    GPSD_ADDR = ('localhost', 2947)
+    # GPSd sends a TPV report every second, so this is plenty
+    SOCKET_TIMEOUT = 10
+    RECONNECT_INTERVAL = 5
+
+    def __init__(self, log):
+        self.log = log
+        self._cond = threading.Condition()
+        self._tpv = {}
+        self._sky = {}
+        self._running = True
+        self._thread = threading.Thread(target=self._watch, name="GPSDWatcher")
+        self._thread.daemon = True
+        self._thread.start()
+
+    def stop(self):
+        """Stop the background thread after its next report or timeout"""
+        self._running = False
+
+    def get_tpv(self, timeout=0):
+        """
+        Return the latest TPV report with a non-trivial mode. Waits up to
+        timeout seconds if there is none yet, and returns an empty dict if none
+        arrives in time.
+        """
+        return self.wait_for(lambda tpv, sky: tpv, timeout)[0]
+
+    def get_sky(self, timeout=0):
+        """
+        Return the latest SKY report. Waits up to timeout seconds if there is
+        none yet, and returns an empty dict if none arrives in time.
+        """
+        return self.wait_for(lambda tpv, sky: sky, timeout)[1]
+
+    def wait_for(self, predicate, timeout):
+        """
+        Wait until predicate(tpv, sky) is true for the latest reports, or until
+        timeout seconds are up. Returns the latest (tpv, sky) reports either
+        way.
+        """
+        end_time = time.time() + timeout
+        with self._cond:
+            while not predicate(self._tpv, self._sky):
+                remaining = end_time - time.time()
+                if remaining <= 0:
+                    break
+                self._cond.wait(remaining)
+            return self._tpv, self._sky
+
+    def _watch(self):
+        """Read reports from GPSd until stop() is called"""
+        while self._running:
+            try:
+                gpsd_socket = socket.create_connection(
+                    self.GPSD_ADDR, self.SOCKET_TIMEOUT)
+            except socket.error as ex:
+                self.log.debug("Could not connect to GPSd: %s", str(ex))
+                time.sleep(self.RECONNECT_INTERVAL)
+                continue
+            try:
+                gpsd_socket.sendall(b'?WATCH={"enable":true};')
+                buf = b''
+                while self._running:
+                    data = gpsd_socket.recv(4096)
+                    if not data:
+                        raise socket.error("GPSd closed the connection")
+                    buf += data
+                    lines = buf.split(b'\n')
+                    buf = lines.pop()
+                    for line in lines:
+                        self._handle_report(line)
+            except socket.error as ex:
+                self.log.warning("Lost the connection to GPSd: %s", str(ex))
+                time.sleep(self.RECONNECT_INTERVAL)
+            finally:
+                gpsd_socket.close()
+
+    def _handle_report(self, line):
+        """Store a TPV or SKY report in the snapshot"""
+        try:
+            report = json.loads(line.decode('ascii'))
+        except ValueError:
+            self.log.warning("JSON decode error: %s", line)
+            return
+        resp_class = report.get('class', '')
+        with self._cond:
+            if resp_class == 'TPV' and report.get('mode', 0) > 0:
+                self._tpv = report
+            elif resp_class == 'SKY':
+                self._sky = report
+            else:
+                return
+            self._cond.notify_all()
+
+
 class GPSDIfaceExtension(object):
     """
     Wrapper class that facilitates the 'extension' of a `context` object. The
@@ -176,13 +281,19 @@ class GPSDIfaceExtension(object):
             # we can call `get_gps_time`
             print(self.get_gps_time())
     """
+    # How long a sensor read waits for the first report after startup
+    SENSOR_TIMEOUT = 15
+
     def __init__(self):
-        self._gpsd_iface = GPSDIface()
-        self._gpsd_iface.open()
-        self._log = self._gpsd_iface.log
+        try:
+            self._log = get_logger('GPSDIface')
+        except AssertionError:
+            from usrp_mpm.mpmlog import get_main_logger
+            self._log = get_main_logger('GPSDIface')
+        self._watcher = GPSDWatcher(self._log)
 
     def __del__(self):
-        self._gpsd_iface.close()
+        self._watcher.stop()
 
     def extend(self, context):
         """Register the GSPDIfaceExtension object's public function with `context`"""
@@ -204,44 +315,38 @@ class GPSDIfaceExtension(object):
         just after 2.000s to return 2 second. This effect is similar to get gps time on
         the next edge of pps.
         """
-        def parse_time(time_str):
-            """parse a string of time in format of %Y-%m-%dT%H:%M:%S.%fZ
-               return in unit second
+        def parse_time(tpv):
+            """parse the time of a TPV report in format of %Y-%m-%dT%H:%M:%S.%fZ
+               return in unit second, or 0 if there is none
             """
-            time_dt = datetime.datetime.strptime(time_str, "%Y-%m-%dT%H:%M:%S.%fZ")
+            if 'time' not in tpv:
+                return 0
+            time_dt = datetime.datetime.strptime(tpv['time'], "%Y-%m-%dT%H:%M:%S.%fZ")
             epoch_dt = datetime.datetime(1970, 1, 1)
             return (time_dt - epoch_dt).total_seconds()
-        # Read responses from GPSD until we get a non-trivial mode and until next second.
-        gps_time_prev = 0
-        while True:
-            gps_info = self._gpsd_iface.get_gps_info(resp_class='tpv', timeout=15)
-            gps_mode = gps_info.get("mode", 0)
-            gps_time = parse_time(gps_info.get("time", ""))
-            if gps_mode == 0:
-                self._log.warning("GPSD reported invalid mode."
-                                  "Return from GPSD is %s", gps_info)
-                continue
-            if gps_time_prev == 0:
-                gps_time_prev = gps_time
-                continue
-            else:
-                if int(gps_time) - int(gps_time_prev) >= 1:
-                    return {
-                        'name': 'gps_time',
-                        'type': 'INTEGER',
-                        'unit': 'seconds',
-                        'value': str(int(gps_time)),
-                    }
+        # Wait for the first report with a time, and then for the next second
+        gps_time_prev = int(parse_time(self._watcher.wait_for(
+            lambda tpv, sky: parse_time(tpv), self.SENSOR_TIMEOUT)[0]))
+        gps_time = int(parse_time(self._watcher.wait_for(
+            lambda tpv, sky: int(parse_time(tpv)) > gps_time_prev,
+            self.SENSOR_TIMEOUT)[0]))
+        if gps_time_prev == 0 or gps_time <= gps_time_prev:
+            raise RuntimeError("GPSd reported no time within {} seconds".format(
+                self.SENSOR_TIMEOUT))
+        return {
+            'name': 'gps_time',
+            'type': 'INTEGER',
+            'unit': 'seconds',
+            'value': str(gps_time),
+        }
 
     def get_gps_tpv_sensor(self):
-        """Get a TPV response from GPSd as a sensor dict"""
-        self._log.trace("Polling GPS TPV results from GPSD")
-        # Read responses from GPSD until we get a non-trivial mode
-        while True:
-            gps_info = self._gpsd_iface.get_gps_info(resp_class='tpv', timeout=15)
-            self._log.trace("GPS info: {}".format(gps_info))
-            if gps_info.get("mode", 0) > 0:
-                break
+        """Get the latest TPV response from GPSd as a sensor dict"""
+        gps_info = self._watcher.get_tpv(self.SENSOR_TIMEOUT)
+        self._log.trace("GPS info: {}".format(gps_info))
+        if not gps_info:
+            raise RuntimeError("GPSd reported no TPV within {} seconds".format(
+                self.SENSOR_TIMEOUT))
         # Return the JSON'd results
         gps_tpv = json.dumps(gps_info)
         return {
@@ -252,10 +357,8 @@ class GPSDIfaceExtension(object):
         }
 
     def get_gps_sky_sensor(self):
-        """Get a SKY response from GPSd as a sensor dict"""
-        self._log.trace("Polling GPS SKY results from GPSD")
-        # Just get the first SKY result
-        gps_info = self._gpsd_iface.get_gps_info(resp_class='sky', timeout=15)
+        """Get the latest SKY response from GPSd as a sensor dict"""
+        gps_info = self._watcher.get_sky(self.SENSOR_TIMEOUT)
         # Return the JSON'd results
         gps_sky = json.dumps(gps_info)
         return {
@@ -283,16 +386,12 @@ class GPSDIfaceExtension(object):
 
             return checksum
 
-        self._log.trace("Polling GPS TPV and SKY results from GPSD")
-        # Read responses from GPSD until we get both a SKY response and TPV
-        # response in non-trivial mode
-        while True:
-            gps_info = self._gpsd_iface.get_gps_info(resp_class='', timeout=15)
-            self._log.trace("GPS info: {}".format(gps_info))
-            tpv_sensor_data = gps_info.get('tpv', [{}])[0]
-            sky_sensor_data = gps_info.get('sky', [{}])[0]
-            if tpv_sensor_data and sky_sensor_data and tpv_sensor_data.get("mode", 0) > 0:
-                break
+        # Wait for both a SKY response and a TPV response in non-trivial mode
+        tpv_sensor_data, sky_sensor_data = self._watcher.wait_for(
+            lambda tpv, sky: tpv and sky, self.SENSOR_TIMEOUT)
+        if not (tpv_sensor_data and sky_sensor_data):
+            raise RuntimeError("GPSd reported no TPV and SKY within {} seconds".format(
+                self.SENSOR_TIMEOUT))
 
         gpgga = "$GPGGA,"
 
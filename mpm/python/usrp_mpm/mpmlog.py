@@ -9,6 +9,7 @@ MPM Logging
 
 from __future__ import print_function
 import copy
+import itertools
 import logging
 from logging import CRITICAL, ERROR, WARNING, INFO, DEBUG
 from logging import handlers
@@ -59,11 +60,19 @@ class LossyQueueHandler(handlers.QueueHandler):
     """
     Like QueueHandler, except it'll try and keep the youngest, not oldest,
     entries.
+
+    Every record is tagged with a running sequence number (mpm_seq), which is
+    used as the cursor for MPMLogger.get_log_records_since().
     """
+    def __init__(self, queue):
+        handlers.QueueHandler.__init__(self, queue)
+        self._seq = itertools.count()
+
     def enqueue(self, record):
         """
         Replaces logging.handlers.QueueHandler.enqueue()
         """
+        record.mpm_seq = next(self._seq)
         self.queue.appendleft(record)
 
 class MPMLogger(logging.getLoggerClass()):
@@ -108,6 +117,32 @@ class MPMLogger(logging.getLoggerClass()):
             'msecs': int(record.msecs),
         } for record in records]
 
+    def get_log_records_since(self, cursor):
+        """
+        Return all records in the logging queue that are at least as new as
+        cursor, without removing them from the queue.
+
+        Returns a tuple (next_cursor, dropped, records). next_cursor is the
+        value to pass in on the next call, dropped is the number of records
+        that were lost since the last call (because the queue overflowed),
+        and records is a list of log records, oldest first.
+
+        If cursor is larger than any sequence number handed out so far (e.g.,
+        because MPM was restarted), it is treated like 0.
+        """
+        # Copy first, C++ logging may append from another thread. Newest
+        # records are on the left.
+        snapshot = [r for r in list(self.py_log_buf) if hasattr(r, 'mpm_seq')]
+        if not snapshot:
+            return cursor, 0, []
+        newest_seq = snapshot[0].mpm_seq
+        oldest_seq = snapshot[-1].mpm_seq
+        if cursor > newest_seq + 1:
+            cursor = 0
+        dropped = max(0, oldest_seq - cursor)
+        records = [r for r in reversed(snapshot) if r.mpm_seq >= cursor]
+        return newest_seq + 1, dropped, records
+
 
 LOGGER = None # Logger singleton
 def get_main_logger(
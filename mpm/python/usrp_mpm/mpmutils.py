@@ -8,6 +8,8 @@ Miscellaneous utilities for MPM
 """
 
 import time
+import threading
+from collections import OrderedDict
 from contextlib import contextmanager
 
 def poll_with_timeout(state_check, timeout_ms, interval_ms):
@@ -185,3 +187,50 @@ def lock_guard(lockable):
     yield
     lockable.unlock()
 
+class PhaseTimer(object):
+    """Records how long the phases of a (potentially long) procedure take
+
+    Example:
+    >>> timer = PhaseTimer(log)
+    >>> with timer.phase('lmk'):
+    >>>    init_lmk()
+    >>> timer.get() # {'lmk': 1.23}
+
+    Running a phase again overwrites its previous duration. Phases may be
+    timed from several threads at once.
+
+    Arguments:
+    log -- If given, the duration of every phase is logged at debug level
+    """
+    def __init__(self, log=None):
+        self.log = log
+        self._lock = threading.Lock()
+        self._durations = OrderedDict()
+
+    @contextmanager
+    def phase(self, name):
+        """Time the following scope as phase `name'. The duration is also
+        recorded if the scope raises.
+        """
+        start_time = time.time()
+        try:
+            yield
+        finally:
+            self.set(name, time.time() - start_time)
+
+    def set(self, name, duration):
+        """Record the duration of a phase (in seconds) which was timed
+        elsewhere.
+        """
+        with self._lock:
+            self._durations.pop(name, None)
+            self._durations[name] = duration
+        if self.log is not None:
+            self.log.debug("Phase `{}' took {:.3f} s.".format(name, duration))
+
+    def get(self):
+        """Return a dictionary phase name -> duration in seconds, in the
+        order in which the phases finished.
+        """
+        with self._lock:
+            return OrderedDict(self._durations)
@@ -16,6 +16,7 @@ from builtins import str
 from builtins import object
 from six import iteritems, itervalues
 from usrp_mpm.mpmlog import get_logger
+from usrp_mpm.mpmutils import PhaseTimer, str2bool
 from usrp_mpm.sys_utils.udev import get_eeprom_paths
 from usrp_mpm.sys_utils.udev import get_spidev_nodes
 from usrp_mpm.sys_utils import dtoverlay
@@ -183,6 +184,8 @@ class PeriphManagerBase(object):
         self._default_args = ""
         # Set up logging
         self.log = get_logger('PeriphManager')
+        # Durations of the initialization phases, see get_init_timings()
+        self._init_timer = PhaseTimer(self.log)
         self.claimed = False
         try:
             self._eeprom_head, self._eeprom_rawdata = \
@@ -207,7 +210,8 @@ class PeriphManagerBase(object):
         """
         Apply FPGA overlay
         """
-        self._init_mboard_overlays()
+        with self._init_timer.phase('overlay'):
+            self._init_mboard_overlays()
 
     def init_dboards(self, args):
         """
@@ -224,11 +228,12 @@ class PeriphManagerBase(object):
             ]
         else:
             override_db_pids = []
-        self._init_dboards(
-            self.dboard_infos,
-            override_db_pids,
-            self._default_args
-        )
+        with self._init_timer.phase('dboards'):
+            self._init_dboards(
+                self.dboard_infos,
+                override_db_pids,
+                self._default_args
+            )
         self._device_initialized = True
         self._initialization_status = "No errors."
 
@@ -417,8 +422,8 @@ class PeriphManagerBase(object):
                 len(override_dboard_pids) < len(dboard_infos):
             self.log.warning("--override-db-pids is going to skip dboards.")
             dboard_infos = dboard_infos[:len(override_dboard_pids)]
+        dboard_ctors = []
         for dboard_idx, dboard_info in enumerate(dboard_infos):
-            self.log.debug("Initializing dboard %d...", dboard_idx)
             db_pid = dboard_info.get('pid')
             db_class = get_dboard_class_from_pid(db_pid)
             if db_class is None:
@@ -436,8 +441,27 @@ class PeriphManagerBase(object):
                 'spi_nodes': spi_nodes,
                 'default_args': default_args,
             })
-            # This will actually instantiate the dboard class:
-            self.dboards.append(db_class(dboard_idx, **dboard_info))
+            dboard_ctors.append((dboard_idx, db_class, dboard_info))
+        def _init_dboard(dboard_idx, db_class, dboard_info):
+            " Instantiate the dboard class (this powers up the dboard) "
+            self.log.debug("Initializing dboard %d...", dboard_idx)
+            with self._init_timer.phase('dboard{}'.format(dboard_idx)):
+                return db_class(dboard_idx, **dboard_info)
+        # The daughterboards are independent of each other, so bring them up
+        # in parallel unless asked otherwise
+        if len(dboard_ctors) <= 1 \
+                or str2bool(default_args.get('serialize_init', False)):
+            self.dboards.extend(
+                _init_dboard(*ctor_args) for ctor_args in dboard_ctors)
+        else:
+            with futures.ThreadPoolExecutor(
+                    max_workers=len(dboard_ctors)) as executor:
+                db_futures = [
+                    executor.submit(_init_dboard, *ctor_args)
+                    for ctor_args in dboard_ctors
+                ]
+                # Keep the slot order
+                self.dboards.extend(x.result() for x in db_futures)
         self.log.info("Initialized %d daughterboard(s).", len(self.dboards))
 
     ###########################################################################
@@ -470,20 +494,21 @@ class PeriphManagerBase(object):
             return False
         if len(self.dboards) == 0:
             return True
-        if args.get("serialize_init", False):
-            self.log.debug("Initializing dboards serially...")
-            return all((dboard.init(args) for dboard in self.dboards))
-        self.log.debug("Initializing dboards in parallel...")
-        num_workers = len(self.dboards)
-        with futures.ThreadPoolExecutor(max_workers=num_workers) as executor:
-            init_futures = [
-                executor.submit(dboard.init, args)
-                for dboard in self.dboards
-            ]
-            return all([
-                x.result()
-                for x in futures.as_completed(init_futures)
-            ])
+        with self._init_timer.phase('dboards_init'):
+            if args.get("serialize_init", False):
+                self.log.debug("Initializing dboards serially...")
+                return all((dboard.init(args) for dboard in self.dboards))
+            self.log.debug("Initializing dboards in parallel...")
+            num_workers = len(self.dboards)
+            with futures.ThreadPoolExecutor(max_workers=num_workers) as executor:
+                init_futures = [
+                    executor.submit(dboard.init, args)
+                    for dboard in self.dboards
+                ]
+                return all([
+                    x.result()
+                    for x in futures.as_completed(init_futures)
+                ])
 
     def deinit(self):
         """
@@ -582,6 +607,23 @@ class PeriphManagerBase(object):
         else:
             self.device_info['rpc_connection'] = conn_type
 
+    @no_claim
+    def get_init_timings(self):
+        """
+        Returns a dictionary phase name -> duration in seconds, with the
+        durations of the most recent run of every initialization phase of
+        the motherboard and the daughterboards. Daughterboard phases are
+        prefixed with `db<slot>_'.
+        """
+        timings = dict(self._init_timer.get())
+        for slot, dboard in enumerate(self.dboards):
+            if hasattr(dboard, 'get_init_timings'):
+                timings.update({
+                    'db{}_{}'.format(slot, phase): duration
+                    for phase, duration in iteritems(dboard.get_init_timings())
+                })
+        return timings
+
     @no_claim
     def get_dboard_info(self):
         """
@@ -600,11 +642,38 @@ class PeriphManagerBase(object):
         """
         return list(self.updateable_components.keys())
 
+    def upload_component_chunk(self, filename, offset, data):
+        """
+        Upload a part of a component file, to be installed by a later call to
+        update_component(). This lets the client stream large files instead
+        of sending them with a single RPC call.
+        :param filename: Name of the component file
+        :param offset: Position of data in the file. An offset of 0 starts a
+                       new file, all others must continue the previous chunk.
+        :param data: Binary string with the file contents at offset
+        """
+        filepath = self._get_upload_path(filename)
+        if offset == 0:
+            open_mode = 'wb'
+        else:
+            if not os.path.isfile(filepath) \
+                    or os.path.getsize(filepath) != offset:
+                raise RuntimeError(
+                    "Component file chunk for {} at offset {} does not "
+                    "continue the upload".format(filename, offset))
+            open_mode = 'ab'
+        with open(filepath, open_mode) as comp_file:
+            comp_file.write(data)
+        return True
+
     def update_component(self, metadata_l, data_l):
         """
         Updates the device component specified by comp_dict
         :param metadata_l: List of dictionary of strings containing metadata
-        :param data_l: List of binary string with the file contents to be written
+        :param data_l: List of binary string with the file contents to be written.
+                       If the metadata of a component has 'uploaded' set to
+                       'True', its data is empty, and the file was already
+                       sent with upload_component_chunk().
         """
         # We need a 'metadata' and a 'data' for each file we want to update
         assert (len(metadata_l) == len(data_l)),\
@@ -621,11 +690,20 @@ class PeriphManagerBase(object):
                 ))
                 raise KeyError("Update component not implemented for {}".format(id_str))
             self.log.trace("Updating component: {}".format(id_str))
+            filepath = self._get_upload_path(filename)
+            if metadata.get('uploaded') == 'True':
+                self.log.trace("Using uploaded file {}".format(filepath))
+            else:
+                self.log.trace("Writing data to {}".format(filepath))
+                with open(filepath, 'wb') as f:
+                    f.write(data)
+            comp_hash = md5()
+            with open(filepath, 'rb') as comp_file:
+                for chunk in iter(lambda: comp_file.read(1024 * 1024), b''):
+                    comp_hash.update(chunk)
+            comp_hash = comp_hash.hexdigest()
             if 'md5' in metadata:
                 given_hash = metadata['md5']
-                comp_hash = md5()
-                comp_hash.update(data)
-                comp_hash = comp_hash.hexdigest()
                 if comp_hash == given_hash:
                     self.log.trace("Component file hash matched: {}".format(
                         comp_hash
@@ -640,30 +718,30 @@ class PeriphManagerBase(object):
                 self.log.trace("Loading unverified {} image.".format(
                     id_str
                 ))
-            basepath = os.path.join(os.sep, "tmp", "uploads")
-            filepath = os.path.join(basepath, filename)
-            if not os.path.isdir(basepath):
-                self.log.trace("Creating directory {}".format(basepath))
-                os.makedirs(basepath)
-            self.log.trace("Writing data to {}".format(filepath))
-            with open(filepath, 'wb') as f:
-                f.write(data)
+            # Forget the hash of the current component while it's replaced
+            self._set_component_hash(id_str, "")
             update_func = \
                 getattr(self, self.updateable_components[id_str]['callback'])
             self.log.info("Updating component `%s'", id_str)
-            update_func(filepath, metadata)
+            if update_func(filepath, metadata):
+                self._set_component_hash(id_str, comp_hash)
         return True
 
     @no_claim
     def get_component_info(self, component_name):
         """
-        Returns the metadata for the requested component
+        Returns the metadata for the requested component. If it is known, this
+        includes the MD5 hash of the file that was used to install the
+        component ('md5'), so clients can skip redundant updates.
         :param component_name: string name of the component
         :return: Dictionary of strings containg metadata
         """
         if component_name in self.updateable_components:
-            metadata = self.updateable_components.get(component_name)
+            metadata = dict(self.updateable_components.get(component_name))
             metadata['id'] = component_name
+            comp_hash = self._get_component_hash(component_name)
+            if comp_hash:
+                metadata['md5'] = comp_hash
             self.log.trace("Component info: {}".format(metadata))
             # Convert all values to str
             return dict([a, str(x)] for a, x in metadata.items())
@@ -672,6 +750,60 @@ class PeriphManagerBase(object):
                            .format(component_name))
             return {}
 
+    def _get_upload_path(self, filename):
+        """
+        Returns the path that component file uploads are written to, and
+        creates the upload directory if needed.
+        """
+        basepath = os.path.join(os.sep, "tmp", "uploads")
+        if not os.path.isdir(basepath):
+            self.log.trace("Creating directory {}".format(basepath))
+            os.makedirs(basepath)
+        return os.path.join(basepath, os.path.basename(filename))
+
+    def _get_component_hash_path(self, component_name):
+        """
+        Returns the path of the installed component and the path of the file
+        which stores its hash, or (None, None) if the component has no fixed
+        path.
+        """
+        comp_path = self.updateable_components[component_name].get('path')
+        if not comp_path:
+            return None, None
+        comp_path = comp_path.format(self.device_info.get('product'))
+        return comp_path, comp_path + '.md5'
+
+    def _get_component_hash(self, component_name):
+        """
+        Returns the MD5 hash of the file that was used to install a component,
+        or an empty string if it is not known.
+        """
+        comp_path, hash_path = self._get_component_hash_path(component_name)
+        if hash_path is None or not os.path.isfile(hash_path):
+            return ""
+        # If the component was replaced by other means after the last update,
+        # the hash is stale
+        if os.path.isfile(comp_path) and \
+                os.path.getmtime(comp_path) > os.path.getmtime(hash_path):
+            return ""
+        with open(hash_path, 'r') as hash_file:
+            return hash_file.read().strip()
+
+    def _set_component_hash(self, component_name, comp_hash):
+        """
+        Stores the MD5 hash of the file that was used to install a component
+        """
+        _, hash_path = self._get_component_hash_path(component_name)
+        if hash_path is None:
+            return
+        try:
+            with open(hash_path, 'w') as hash_file:
+                hash_file.write(comp_hash)
+        except (IOError, OSError) as ex:
+            # Not fatal, the next update won't be skipped
+            self.log.warning("Could not store hash of component `%s': %s",
+                             component_name, str(ex))
+
     ###########################################################################
     # Crossbar control
     ###########################################################################
@@ -901,6 +1033,21 @@ class PeriphManagerBase(object):
         """
         raise NotImplementedError("commit_xport() not implemented.")
 
+    def commit_xports(self, xport_infos):
+        """
+        Commit many transports with a single call, e.g. all transports of a
+        streamer.
+
+        Arguments:
+        xport_infos -- A list of dictionaries, every one like the xport_info
+                       argument of commit_xport()
+
+        Returns True if all transports were committed. Device classes can
+        override this to program the routes of all transports at once, by
+        default they are committed one after the other.
+        """
+        return all([self.commit_xport(xport_info) for xport_info in xport_infos])
+
     #######################################################################
     # Claimer API
     #######################################################################
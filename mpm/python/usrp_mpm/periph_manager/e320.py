@@ -428,6 +428,24 @@ class e320(ZynqComponents, PeriphManagerBase):
         elif self.mboard_info['rpc_connection'] == 'local':
             return self._xport_mgrs['liberio'].commit_xport(sid, xport_info)
 
+    def commit_xports(self, xport_infos):
+        """
+        See PeriphManagerBase.commit_xports() for docs.
+
+        Over the network, the Ethernet dispatcher routes of all transports are
+        programmed in one go.
+        """
+        if self.mboard_info['rpc_connection'] != 'remote':
+            return super(e320, self).commit_xports(xport_infos)
+        sid_xport_infos = []
+        for xport_info in xport_infos:
+            sid = SID(xport_info['send_sid'])
+            self._available_endpoints.remove(sid.src_ep)
+            self.log.debug("Committing transport for SID %s, xport info: %s",
+                           str(sid), str(xport_info))
+            sid_xport_infos.append((sid, xport_info))
+        return self._xport_mgrs['udp'].commit_xports(sid_xport_infos)
+
     ###########################################################################
     # Device info
     ###########################################################################
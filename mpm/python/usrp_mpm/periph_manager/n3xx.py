@@ -251,7 +251,8 @@ class n3xx(ZynqComponents, PeriphManagerBase):
             if not self._device_initialized:
                 # Don't try and figure out what's going on. Just give up.
                 return
-            self._init_peripherals(args)
+            with self._init_timer.phase('peripherals'):
+                self._init_peripherals(args)
         except Exception as ex:
             self.log.error("Failed to initialize motherboard: %s", str(ex))
             self._initialization_status = str(ex)
@@ -429,7 +430,8 @@ class n3xx(ZynqComponents, PeriphManagerBase):
         # successful clocking configuration).
         args['clock_source'] = args.get('clock_source', self._clock_source)
         args['time_source'] = args.get('time_source', self._time_source)
-        self.set_sync_source(args)
+        with self._init_timer.phase('clocking'):
+            self.set_sync_source(args)
         # Uh oh, some hard coded product-related info: The N300 has no LO
         # source connectors on the front panel, so we assume that if this was
         # selected, it was an artifact from N310-related code. The user gets
@@ -448,8 +450,9 @@ class n3xx(ZynqComponents, PeriphManagerBase):
             'pps_export',
             N3XX_DEFAULT_ENABLE_PPS_EXPORT
         ))
-        for xport_mgr in itervalues(self._xport_mgrs):
-            xport_mgr.init(args)
+        with self._init_timer.phase('xports'):
+            for xport_mgr in itervalues(self._xport_mgrs):
+                xport_mgr.init(args)
         return result
 
     def deinit(self):
@@ -550,6 +553,24 @@ class n3xx(ZynqComponents, PeriphManagerBase):
         elif self.device_info['rpc_connection'] == 'local':
             return self._xport_mgrs['liberio'].commit_xport(sid, xport_info)
 
+    def commit_xports(self, xport_infos):
+        """
+        See PeriphManagerBase.commit_xports() for docs.
+
+        Over the network, the Ethernet dispatcher routes of all transports are
+        programmed in one go.
+        """
+        if self.device_info['rpc_connection'] != 'remote':
+            return super(n3xx, self).commit_xports(xport_infos)
+        sid_xport_infos = []
+        for xport_info in xport_infos:
+            sid = SID(xport_info['send_sid'])
+            self._available_endpoints.remove(sid.src_ep)
+            self.log.debug("Committing transport for SID %s, xport info: %s",
+                           str(sid), str(xport_info))
+            sid_xport_infos.append((sid, xport_info))
+        return self._xport_mgrs['udp'].commit_xports(sid_xport_infos)
+
     ###########################################################################
     # Device info
     ###########################################################################
@@ -338,15 +338,11 @@ class MboardRegsControl(object):
         """
         self.log.trace("%s PPS/Trig output!",
                        "Enabling" if enable else "Disabling")
-        mask = 0xFFFFFFFF ^ (0b1 << self.MB_CLOCK_CTRL_PPS_OUT_EN)
+        mask = 0b1 << self.MB_CLOCK_CTRL_PPS_OUT_EN
         with self.regs:
-            # mask the bit to clear it:
-            reg_val = self.peek32(self.MB_CLOCK_CTRL) & mask
-            if enable:
-                # set the bit if desired:
-                reg_val = reg_val | (0b1 << self.MB_CLOCK_CTRL_PPS_OUT_EN)
-            self.log.trace("Writing MB_CLOCK_CTRL to 0x{:08X}".format(reg_val))
-            self.poke32(self.MB_CLOCK_CTRL, reg_val)
+            reg_val = self.regs.modify32(
+                self.MB_CLOCK_CTRL, mask, mask if enable else 0)
+            self.log.trace("Wrote MB_CLOCK_CTRL to 0x{:08X}".format(reg_val))
 
     def enable_ref_clk(self, enable):
         """
@@ -354,15 +350,12 @@ class MboardRegsControl(object):
         """
         self.log.trace("%s the Reference Clock!",
                        "Enabling" if enable else "Disabling")
-        mask = 0xFFFFFFFF ^ (0b1 << self.MB_CLOCK_CTRL_DISABLE_REF_CLK)
+        mask = 0b1 << self.MB_CLOCK_CTRL_DISABLE_REF_CLK
         with self.regs:
-            # mask the bit to clear it and therefore enable the clock:
-            reg_val = self.peek32(self.MB_CLOCK_CTRL) & mask
-            if not enable:
-                # set the bit if not enabled (note this is a DISABLE bit when = 1):
-                reg_val = reg_val | (0b1 << self.MB_CLOCK_CTRL_DISABLE_REF_CLK)
-            self.log.trace("Writing MB_CLOCK_CTRL to 0x{:08X}".format(reg_val))
-            self.poke32(self.MB_CLOCK_CTRL, reg_val)
+            # Note this is a DISABLE bit when = 1:
+            reg_val = self.regs.modify32(
+                self.MB_CLOCK_CTRL, mask, 0 if enable else mask)
+            self.log.trace("Wrote MB_CLOCK_CTRL to 0x{:08X}".format(reg_val))
 
     def reset_meas_clk_mmcm(self, reset=True):
         """
@@ -370,15 +363,11 @@ class MboardRegsControl(object):
         """
         self.log.trace("%s measurement clock MMCM reset...",
                        "Asserting" if reset else "Clearing")
-        mask = 0xFFFFFFFF ^ (0b1 << self.MB_CLOCK_CTRL_MEAS_CLK_RESET)
+        mask = 0b1 << self.MB_CLOCK_CTRL_MEAS_CLK_RESET
         with self.regs:
-            # mask the bit to clear it
-            reg_val = self.peek32(self.MB_CLOCK_CTRL) & mask
-            if reset:
-                # set the bit if desired
-                reg_val = reg_val | (0b1 << self.MB_CLOCK_CTRL_MEAS_CLK_RESET)
-            self.log.trace("Writing MB_CLOCK_CTRL to 0x{:08X}".format(reg_val))
-            self.poke32(self.MB_CLOCK_CTRL, reg_val)
+            reg_val = self.regs.modify32(
+                self.MB_CLOCK_CTRL, mask, mask if reset else 0)
+            self.log.trace("Wrote MB_CLOCK_CTRL to 0x{:08X}".format(reg_val))
 
     def get_meas_clock_mmcm_lock(self):
         """
@@ -401,8 +390,8 @@ class MboardRegsControl(object):
         Returns a string with the type (ie HG, XG, AA, etc.)
         """
         with self.regs:
-            sfp0_info_rb = self.peek32(self.MB_SFP0_INFO)
-            sfp1_info_rb = self.peek32(self.MB_SFP1_INFO)
+            sfp0_info_rb, sfp1_info_rb = self.regs.peeks32(
+                (self.MB_SFP0_INFO, self.MB_SFP1_INFO))
         # Print the registers values as 32-bit hex values
         self.log.trace("SFP0 Info: 0x{0:0{1}X}".format(sfp0_info_rb, 8))
         self.log.trace("SFP1 Info: 0x{0:0{1}X}".format(sfp1_info_rb, 8))
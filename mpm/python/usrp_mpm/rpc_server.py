@@ -8,6 +8,9 @@ Implemented RPC Servers
 """
 
 from __future__ import print_function
+import os
+import time
+import resource
 import traceback
 import copy
 from random import choice
@@ -25,14 +28,14 @@ from builtins import range
 from six import iteritems
 from mprpc import RPCServer
 from usrp_mpm.mpmlog import get_main_logger
-from usrp_mpm.mpmutils import to_binary_str
+from usrp_mpm.mpmutils import to_binary_str, to_native_str
 from usrp_mpm.sys_utils import watchdog
 from usrp_mpm.sys_utils import net
 
 TIMEOUT_INTERVAL = 5.0 # Seconds before claim expires (default value)
 TOKEN_LEN = 16 # Length of the token string
 # Compatibility number for MPM
-MPM_COMPAT_NUM = (1, 2)
+MPM_COMPAT_NUM = (1, 3)
 
 def no_claim(func):
     " Decorator for functions that require no token check "
@@ -50,7 +53,8 @@ class MPMServer(RPCServer):
     RPC calls to appropiate calls in the periph_manager and dboard_managers.
     """
     # This is a list of methods in this class which require a claim
-    default_claimed_methods = ['init', 'update_component', 'reclaim', 'unclaim']
+    default_claimed_methods = ['init', 'update_component', 'reclaim', 'unclaim',
+                               'batch']
 
     ###########################################################################
     # RPC Server Initialization
@@ -69,6 +73,7 @@ class MPMServer(RPCServer):
             TIMEOUT_INTERVAL
         ))
         self.session_id = None
+        self._start_time = time.time()
         # Create the periph_manager for this device
         # This call will be forwarded to the device specific implementation
         # e.g. in periph_manager/n3xx.py
@@ -88,6 +93,9 @@ class MPMServer(RPCServer):
                 to_binary_str(device_info.get("serial", "n/a"))
         self._db_methods = []
         self._mb_methods = []
+        # Maps every registered command to its component method, so batch()
+        # can call it without going through the per-call wrapper.
+        self._batch_methods = {}
         self.claimed_methods = copy.copy(self.default_claimed_methods)
         self._last_error = ""
         self._init_rpc_calls(self.periph_manager)
@@ -123,6 +131,7 @@ class MPMServer(RPCServer):
                     )
         self._db_methods = []
         self._mb_methods = []
+        self._batch_methods = {}
         # Register new ones:
         self._update_component_commands(mgr, '', '_mb_methods')
         for db_slot, dboard in enumerate(mgr.dboards):
@@ -152,9 +161,11 @@ class MPMServer(RPCServer):
             command_name = namespace + method_name
             if getattr(new_rpc_method, '_notok', False):
                 self._add_safe_command(new_rpc_method, command_name)
+                self._batch_methods[command_name] = new_rpc_method
             else:
                 self._add_claimed_command(new_rpc_method, command_name)
                 self.claimed_methods.append(command_name)
+                self._batch_methods[command_name] = new_rpc_method
             getattr(self, storage).append(command_name)
 
 
@@ -427,6 +438,105 @@ class MPMServer(RPCServer):
             for record in log_records
         ]
 
+    def batch(self, token, calls):
+        """
+        Execute a list of RPC calls in one go, and return the list of their
+        return values.
+
+        `calls` is a list of (method_name, args) pairs, where args is a list
+        of the arguments for that call (without a token). Only motherboard and
+        daughterboard methods may be batched. The token is checked and the
+        claim timer is reset only once for the whole batch.
+
+        Calls are executed in order. The first call that fails aborts the
+        batch, and its exception is raised.
+        """
+        if not self._check_token_valid(token):
+            self.log.warning(
+                "Attempt to run batch without valid claim from {}".format(
+                    self.client_host
+                )
+            )
+            err_msg = "batch() called without valid claim."
+            self._last_error = err_msg
+            raise RuntimeError(err_msg)
+        self._reset_timer()
+        results = []
+        for method_name, args in calls:
+            method_name = to_native_str(method_name)
+            if method_name not in self._batch_methods:
+                err_msg = "batch(): Unknown method `{}'".format(method_name)
+                self.log.error(err_msg)
+                self._last_error = err_msg
+                raise RuntimeError(err_msg)
+            function = self._batch_methods[method_name]
+            try:
+                results.append(function(*args))
+            except Exception as ex:
+                self.log.error(
+                    "Uncaught exception in method %s (batched) :%s \n %s ",
+                    method_name, str(ex), traceback.format_exc()
+                )
+                self._last_error = str(ex)
+                raise
+        if not self._state.claim_status.value:
+            self.log.error("Lost claim during batched API call!")
+        return results
+
+    def get_log_stream(self, token, cursor):
+        """
+        Return the log records that were created since the last call, plus a
+        set of health metrics. Unlike get_log_buf(), this does not drain the
+        log buffer, so it can be polled by several clients.
+
+        Pass in 0 as the cursor on the first call, and the returned cursor on
+        subsequent calls.
+
+        To keep the reply small, logger names are sent once in a name table,
+        and log levels are sent as integers. The reply is a list:
+        [next_cursor, dropped, names, records, health], where every record is
+        a list [name_index, level, message], and health is a dictionary
+        str -> str.
+        """
+        if not self._check_token_valid(token):
+            self.log.warning(
+                "Attempt to read logs without valid claim from {}".format(
+                    self.client_host
+                )
+            )
+            err_msg = "get_log_stream() called without valid claim."
+            self._last_error = err_msg
+            raise RuntimeError(err_msg)
+        next_cursor, dropped, log_records = \
+            get_main_logger().get_log_records_since(int(cursor))
+        names = []
+        name_index = {}
+        records = []
+        for record in log_records:
+            if record.name not in name_index:
+                name_index[record.name] = len(names)
+                names.append(record.name)
+            records.append(
+                [name_index[record.name], record.levelno, str(record.message)])
+        return [next_cursor, dropped, names, records, self._get_health()]
+
+    def _get_health(self):
+        """
+        Return some health metrics of the MPM process as a dictionary
+        str -> str.
+        """
+        usage = resource.getrusage(resource.RUSAGE_SELF)
+        health = {
+            'uptime': "{:.0f}".format(time.time() - self._start_time),
+            'cpu_time': "{:.2f}".format(usage.ru_utime + usage.ru_stime),
+            'max_rss_kb': str(usage.ru_maxrss),
+        }
+        try:
+            health['load_avg'] = "{:.2f}".format(os.getloadavg()[0])
+        except OSError:
+            pass
+        return health
+
     ###########################################################################
     # Session initialization
     ###########################################################################
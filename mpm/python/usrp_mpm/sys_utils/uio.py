@@ -202,3 +202,36 @@ class UIO(object):
         """
         assert not self._read_only
         return self._uio.poke32(addr, val)
+
+    def peeks32(self, addrs):
+        """
+        Returns a list with the 32-bit values at all the addresses in addrs.
+        The registers are read in one call into C++.
+        """
+        return self._uio.peeks32(addrs)
+
+    def pokes32(self, addr_vals):
+        """
+        Apply a series of pokes in one call into C++.
+        pokes32(((0, 1), (4, 2))) is the same as calling poke32(0, 1),
+        poke32(4, 2).
+        """
+        assert not self._read_only
+        return self._uio.pokes32(addr_vals)
+
+    def modify32(self, addr, mask, val):
+        """
+        Writes the bits of val that are set in mask to addr, and leaves the
+        other bits as they are. Returns the new register value.
+        """
+        assert not self._read_only
+        return self._uio.modify32(addr, mask, val)
+
+    def modifies32(self, addr_mask_vals):
+        """
+        Apply a series of modify32() calls in one call into C++.
+        modifies32(((0, 0x1, 1), (0, 0x2, 0))) is the same as calling
+        modify32(0, 0x1, 1), modify32(0, 0x2, 0).
+        """
+        assert not self._read_only
+        return self._uio.modifies32(addr_mask_vals)
@@ -212,15 +212,17 @@ class XportMgrUDP(object):
             eth_dispatcher = eth_dispatchers[eth_iface]
             self.log.debug("Preloading {} dispatch table".format(eth_iface))
             try:
+                routes = []
                 for dst_addr, udp_data in iteritems(data):
                     sid = SID()
                     sid.set_dst_addr(int(dst_addr))
-                    eth_dispatcher.set_route(
+                    routes.append((
                         sid,
                         udp_data['ip_addr'],
                         udp_data['port'],
                         udp_data.get('mac_addr', None)
-                    )
+                    ))
+                eth_dispatcher.set_routes(routes)
             except ValueError as ex:
                 self.log.warning(
                     "Bad values in preloading table file: %s",
@@ -303,6 +305,51 @@ class XportMgrUDP(object):
         Saves the transport configuration to the device.
         Returns the status of the commit.
         """
+        return self.commit_xports(((sid, xport_info),))
+
+    def commit_xports(self, sid_xport_infos):
+        """
+        Commit many transports at once
+
+        sid_xport_infos -- A list of (sid, xport_info) tuples, see
+                           commit_xport().
+
+        The crossbar routes are set one by one, but the Ethernet dispatcher
+        routes of each interface are programmed in one go.
+        Returns the status of the commit.
+        """
+        eth_routes = {}
+        for sid, xport_info in sid_xport_infos:
+            eth_iface, route = self._prepare_xport(sid, xport_info)
+            eth_routes.setdefault(eth_iface, []).append(route)
+        for eth_iface, routes in iteritems(eth_routes):
+            self._eth_dispatchers[eth_iface].set_routes(routes)
+        self.log.trace("%d UDP transport(s) successfully committed!",
+                       len(sid_xport_infos))
+        for sid, xport_info in sid_xport_infos:
+            eth_iface = net.ip_addr_to_iface(xport_info['ipv4'], self._chdr_ifaces)
+            self._previous_block_ep[sid.src_addr] = sid.get_dst_block()
+            if xport_info.get('xport_type') == 'TX_DATA':
+                self._allocations[eth_iface] = \
+                    {'tx': self._allocations.get(eth_iface, {}).get('tx', 0) + 1}
+            if xport_info.get('xport_type') == 'RX_DATA':
+                self._allocations[eth_iface] = \
+                    {'rx': self._allocations.get(eth_iface, {}).get('rx', 0) + 1}
+            self.log.trace(
+                "New link allocations for %s: TX: %d  RX: %d",
+                eth_iface,
+                self._allocations.get(eth_iface, {}).get('tx', 0),
+                self._allocations.get(eth_iface, {}).get('rx', 0),
+            )
+        return True
+
+    def _prepare_xport(self, sid, xport_info):
+        """
+        Sanity check a transport and set its crossbar route.
+
+        Returns the Ethernet interface and the Ethernet dispatcher route for
+        EthDispatcherTable.set_routes().
+        """
         self.log.trace("Sanity checking xport_info %s...", str(xport_info))
         assert xport_info['type'] == 'UDP'
         assert any([xport_info['ipv4'] == x['ip_addr']
@@ -327,21 +374,5 @@ class XportMgrUDP(object):
                        eth_iface, xbar_port)
         xbar_iface = lib.xbar.xbar(self.get_xbar_dev(eth_iface))
         xbar_iface.set_route(sid.src_addr, xbar_port)
-        self._eth_dispatchers[eth_iface].set_route(
-            sid.reversed(), sender_addr, sender_port)
-        self.log.trace("UDP transport successfully committed!")
-        self._previous_block_ep[sid.src_addr] = sid.get_dst_block()
-        if xport_info.get('xport_type') == 'TX_DATA':
-            self._allocations[eth_iface] = \
-                {'tx': self._allocations.get(eth_iface, {}).get('tx', 0) + 1}
-        if xport_info.get('xport_type') == 'RX_DATA':
-            self._allocations[eth_iface] = \
-                {'rx': self._allocations.get(eth_iface, {}).get('rx', 0) + 1}
-        self.log.trace(
-            "New link allocations for %s: TX: %d  RX: %d",
-            eth_iface,
-            self._allocations.get(eth_iface, {}).get('tx', 0),
-            self._allocations.get(eth_iface, {}).get('rx', 0),
-        )
-        return True
+        return eth_iface, (sid.reversed(), sender_addr, sender_port, mac_addr)
 
@@ -34,7 +34,14 @@
 
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/condition_variable.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+#include <boost/shared_ptr.hpp>
 #include <csignal>
+#include <map>
+#include <algorithm>
+#include <sys/time.h>
+#include <sys/resource.h>
 
 namespace po = boost::program_options;
 
@@ -1033,6 +1040,528 @@ std::vector<size_t> get_channels(const std::string& channel_list, size_t max = -
     return channel_nums;
 }
 
+/***********************************************************************
+ * Soak benchmark
+ **********************************************************************/
+
+typedef struct SoakParams {
+    std::string rx_cpu;
+    std::string tx_cpu;
+    std::string otw_rx;
+    std::string otw_tx;
+    size_t num_rx_streamers;            // 0: one per RX channel
+    size_t num_tx_streamers;            // 0: one per TX channel
+    size_t samps_per_buff;              // 0: max samples per packet
+    double start_delay;
+    double recv_timeout;
+    double send_timeout;
+    double duration;                    // 0: until CTRL+C
+    double reconfig_interval;           // 0: no reconfiguration
+    std::vector<std::string> reconfig;  // "rate", "freq", "gain"
+    std::vector<double> rates;
+    double freq_min, freq_max;          // 0: channel's own range
+    size_t num_ctrl_threads;
+    double ctrl_interval;
+    double report_interval;
+    std::string log_file;               // empty: stdout
+    unsigned int seed;
+} SOAK_PARAMS;
+
+static boost::posix_time::time_duration seconds_to_duration(double secs)
+{
+    return boost::posix_time::microseconds(int64_t(secs * 1e6));
+}
+
+/*!
+ * Statistics of one soak activity between two reports
+ *
+ * Every call is timed, and its samples are counted (if any). Events are
+ * anything worth counting that isn't a successful call (overflows,
+ * underflows, timeouts, errors...).
+ */
+class soak_stats
+{
+public:
+    typedef boost::shared_ptr<soak_stats> sptr;
+
+    soak_stats(const std::string& name) :
+        _name(name), _num_calls(0), _total_us(0), _max_us(0), _num_samps(0)
+    {
+        /* NOP */
+    }
+
+    const std::string& name(void) const
+    {
+        return _name;
+    }
+
+    void add_call(const boost::posix_time::time_duration& duration, size_t nsamps = 0)
+    {
+        const uint64_t us = uint64_t(std::max<int64_t>(duration.total_microseconds(), 0));
+        boost::mutex::scoped_lock l(_mutex);
+        _num_calls++;
+        _total_us += us;
+        _max_us = std::max(_max_us, us);
+        _num_samps += nsamps;
+    }
+
+    void add_event(const std::string& event)
+    {
+        boost::mutex::scoped_lock l(_mutex);
+        _events[event]++;
+    }
+
+    //! Return the statistics as a JSON member and start over
+    std::string take_json(double elapsed)
+    {
+        boost::mutex::scoped_lock l(_mutex);
+        std::string events;
+        for (std::map<std::string, uint64_t>::const_iterator it = _events.begin(); it != _events.end(); ++it)
+        {
+            events += str(boost::format("%s\"%s\":%u") % (events.empty() ? "" : ",") % it->first % it->second);
+        }
+        const std::string json = str(boost::format(
+            "\"%s\":{\"calls\":%u,\"mean_us\":%.1f,\"max_us\":%u,\"samps\":%u,\"msps\":%.3f,\"events\":{%s}}")
+            % _name
+            % _num_calls
+            % (_num_calls ? double(_total_us) / _num_calls : 0.0)
+            % _max_us
+            % _num_samps
+            % (elapsed > 0 ? _num_samps / elapsed / 1e6 : 0.0)
+            % events
+        );
+        _num_calls = _total_us = _max_us = _num_samps = 0;
+        _events.clear();
+        return json;
+    }
+
+private:
+    const std::string _name;
+    boost::mutex _mutex;
+    uint64_t _num_calls;
+    uint64_t _total_us;
+    uint64_t _max_us;
+    uint64_t _num_samps;
+    std::map<std::string, uint64_t> _events;
+};
+
+static void soak_rx_thread(
+    uhd::rx_streamer::sptr rx_stream,
+    const std::string& rx_cpu,
+    size_t samps_per_buff,
+    const uhd::time_spec_t& start_time,
+    double timeout,
+    soak_stats::sptr stats)
+{
+    uhd::set_thread_priority_safe();
+
+    const size_t bytes_per_samp = uhd::convert::get_bytes_per_item(rx_cpu);
+    std::vector<char> buff(samps_per_buff * bytes_per_samp);
+    std::vector<void *> buffs(rx_stream->get_num_channels(), &buff.front()); //same buffer for each channel
+    uhd::rx_metadata_t md;
+
+    uhd::stream_cmd_t cmd(uhd::stream_cmd_t::STREAM_MODE_START_CONTINUOUS);
+    cmd.stream_now = false;
+    cmd.time_spec = start_time;
+    rx_stream->issue_stream_cmd(cmd);
+
+    bool restart = false;
+    while (running)
+    {
+        if (restart)
+        {
+            // Streaming stopped on an error: start over right away
+            cmd.stream_now = true;
+            rx_stream->issue_stream_cmd(cmd);
+            restart = false;
+        }
+
+        const boost::system_time call_start = boost::get_system_time();
+        const size_t recv_samps = rx_stream->recv(buffs, samps_per_buff, md, timeout);
+        stats->add_call(boost::get_system_time() - call_start, recv_samps * rx_stream->get_num_channels());
+
+        switch (md.error_code)
+        {
+            case uhd::rx_metadata_t::ERROR_CODE_NONE:
+                break;
+            case uhd::rx_metadata_t::ERROR_CODE_OVERFLOW:
+                stats->add_event(md.out_of_sequence ? "seq_error" : "overflow");
+                break;
+            case uhd::rx_metadata_t::ERROR_CODE_TIMEOUT:
+                stats->add_event("timeout");
+                break;
+            case uhd::rx_metadata_t::ERROR_CODE_LATE_COMMAND:
+                stats->add_event("late_command");
+                restart = true;
+                break;
+            case uhd::rx_metadata_t::ERROR_CODE_BROKEN_CHAIN:
+                stats->add_event("broken_chain");
+                restart = true;
+                break;
+            default:
+                stats->add_event("error");
+                break;
+        }
+    }
+
+    rx_stream->issue_stream_cmd(uhd::stream_cmd_t(uhd::stream_cmd_t::STREAM_MODE_STOP_CONTINUOUS));
+}
+
+static void soak_tx_thread(
+    uhd::tx_streamer::sptr tx_stream,
+    const std::string& tx_cpu,
+    size_t samps_per_buff,
+    const uhd::time_spec_t& start_time,
+    double timeout,
+    soak_stats::sptr stats)
+{
+    uhd::set_thread_priority_safe();
+
+    const size_t bytes_per_samp = uhd::convert::get_bytes_per_item(tx_cpu);
+    std::vector<char> buff(samps_per_buff * bytes_per_samp, 0);
+    std::vector<const void *> buffs(tx_stream->get_num_channels(), &buff.front()); //same buffer for each channel
+    uhd::tx_metadata_t md;
+    md.start_of_burst = true;
+    md.has_time_spec = true;
+    md.time_spec = start_time;
+    uhd::async_metadata_t async_md;
+
+    while (running)
+    {
+        const boost::system_time call_start = boost::get_system_time();
+        const size_t sent_samps = tx_stream->send(buffs, samps_per_buff, md, timeout + (md.has_time_spec ? 1.0 : 0.0));
+        stats->add_call(boost::get_system_time() - call_start, sent_samps * tx_stream->get_num_channels());
+        if (sent_samps < samps_per_buff)
+            stats->add_event("timeout");
+        md.start_of_burst = false;
+        md.has_time_spec = false;
+
+        // Drain the async messages without blocking the data path
+        while (tx_stream->recv_async_msg(async_md, 0))
+        {
+            switch (async_md.event_code)
+            {
+                case uhd::async_metadata_t::EVENT_CODE_BURST_ACK:
+                    break;
+                case uhd::async_metadata_t::EVENT_CODE_UNDERFLOW:
+                case uhd::async_metadata_t::EVENT_CODE_UNDERFLOW_IN_PACKET:
+                    stats->add_event("underflow");
+                    break;
+                case uhd::async_metadata_t::EVENT_CODE_SEQ_ERROR:
+                case uhd::async_metadata_t::EVENT_CODE_SEQ_ERROR_IN_BURST:
+                    stats->add_event("seq_error");
+                    break;
+                case uhd::async_metadata_t::EVENT_CODE_TIME_ERROR:
+                    stats->add_event("late_packet");
+                    break;
+                default:
+                    stats->add_event("error");
+                    break;
+            }
+        }
+    }
+
+    md.end_of_burst = true;
+    tx_stream->send(buffs, 0, md, timeout);
+}
+
+/*!
+ * Randomly retune, change the gain or the rate of the streaming channels
+ *
+ * Every change is a control transaction which competes with the streamers,
+ * so its duration is recorded, and failures are counted instead of aborting.
+ */
+static void soak_reconfig_thread(
+    uhd::usrp::multi_usrp::sptr usrp,
+    const std::vector<size_t>& rx_channel_nums,
+    const std::vector<size_t>& tx_channel_nums,
+    const SOAK_PARAMS& params,
+    soak_stats::sptr stats)
+{
+    boost::random::mt19937 rng(params.seed);
+    boost::random::uniform_real_distribution<double> unit(0.0, 1.0);
+    const size_t num_chans = rx_channel_nums.size() + tx_channel_nums.size();
+
+    boost::mutex::scoped_lock l(stop_mutex);
+    while (running)
+    {
+        abort_event.timed_wait(l, seconds_to_duration(params.reconfig_interval));
+        if (running == false)
+            break;
+        l.unlock();
+
+        const std::string& action = params.reconfig.at(size_t(unit(rng) * params.reconfig.size()) % params.reconfig.size());
+        const size_t index = size_t(unit(rng) * num_chans) % num_chans;
+        const bool rx = (index < rx_channel_nums.size());
+        const size_t chan = rx ? rx_channel_nums[index] : tx_channel_nums[index - rx_channel_nums.size()];
+
+        const boost::system_time call_start = boost::get_system_time();
+        try
+        {
+            if (action == "rate")
+            {
+                if (params.rates.empty() == false)
+                {
+                    const double rate = params.rates.at(size_t(unit(rng) * params.rates.size()) % params.rates.size());
+                    if (rx)
+                        usrp->set_rx_rate(rate);
+                    else
+                        usrp->set_tx_rate(rate);
+                }
+            }
+            else if (action == "freq")
+            {
+                const uhd::freq_range_t range = rx ? usrp->get_rx_freq_range(chan) : usrp->get_tx_freq_range(chan);
+                const double freq_min = (params.freq_min > 0) ? params.freq_min : range.start();
+                const double freq_max = (params.freq_max > 0) ? params.freq_max : range.stop();
+                const uhd::tune_request_t tune_request(freq_min + unit(rng) * (freq_max - freq_min));
+                if (rx)
+                    usrp->set_rx_freq(tune_request, chan);
+                else
+                    usrp->set_tx_freq(tune_request, chan);
+            }
+            else if (action == "gain")
+            {
+                const uhd::gain_range_t range = rx ? usrp->get_rx_gain_range(chan) : usrp->get_tx_gain_range(chan);
+                const double gain = range.start() + unit(rng) * (range.stop() - range.start());
+                if (rx)
+                    usrp->set_rx_gain(gain, chan);
+                else
+                    usrp->set_tx_gain(gain, chan);
+            }
+            stats->add_call(boost::get_system_time() - call_start);
+        }
+        catch (const std::exception& e)
+        {
+            stats->add_event(action + "_error");
+            std::stringstream ss;
+            ss << HEADER_WARN"(" << get_stringified_time() << ") Reconfiguration failed: " << e.what() << std::endl;
+            std::cout << ss.str();
+        }
+
+        l.lock();
+    }
+}
+
+/*!
+ * Generate control traffic: read-only transactions, back to back or paced
+ */
+static void soak_ctrl_thread(
+    uhd::usrp::multi_usrp::sptr usrp,
+    double interval,
+    soak_stats::sptr stats)
+{
+    const std::vector<std::string> sensor_names = usrp->get_mboard_sensor_names(0);
+    const bool has_ref_locked = (std::find(sensor_names.begin(), sensor_names.end(), "ref_locked") != sensor_names.end());
+
+    for (size_t n = 0; running; n++)
+    {
+        const boost::system_time call_start = boost::get_system_time();
+        try
+        {
+            // Alternate between a timekeeper read and a sensor read
+            if ((n % 2 == 0) || (has_ref_locked == false))
+                usrp->get_time_now();
+            else
+                usrp->get_mboard_sensor("ref_locked");
+            stats->add_call(boost::get_system_time() - call_start);
+        }
+        catch (const std::exception&)
+        {
+            stats->add_event("error");
+        }
+
+        if (interval > 0)
+            boost::this_thread::sleep(seconds_to_duration(interval));
+    }
+}
+
+static bool soak_threads_joined = false;
+
+static double get_cpu_seconds(void)
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return
+        usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6 +
+        usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+}
+
+/*!
+ * Write one line of JSON per report interval:
+ * {"time":..., "elapsed":..., "interval":..., "cpu_percent":..., "stats":{"rx0":{...}, ...}}
+ * "cpu_percent" is the CPU time of the whole process, so it exceeds 100 with
+ * several busy threads.
+ */
+static void soak_report_thread(
+    const std::vector<soak_stats::sptr>& stats,
+    double interval,
+    std::ostream* log)
+{
+    const boost::system_time start = boost::get_system_time();
+    boost::system_time last_report = start;
+    double last_cpu = get_cpu_seconds();
+
+    boost::mutex::scoped_lock l(stop_mutex);
+    bool last = false;
+    while (last == false)
+    {
+        abort_event.timed_wait(l, last_report + seconds_to_duration(interval));
+        last = soak_threads_joined;
+        l.unlock();
+
+        const boost::system_time now = boost::get_system_time();
+        const double elapsed = (now - last_report).total_microseconds() / 1e6;
+        if ((elapsed < interval) && (last == false))
+        {
+            // Woken up early, but not to stop
+            l.lock();
+            continue;
+        }
+        const double cpu = get_cpu_seconds();
+        struct timeval tv;
+        gettimeofday(&tv, NULL);
+
+        std::string json = str(boost::format("{\"time\":%.6f,\"elapsed\":%.3f,\"interval\":%.3f,\"cpu_percent\":%.1f,\"stats\":{")
+            % (tv.tv_sec + tv.tv_usec / 1e6)
+            % ((now - start).total_microseconds() / 1e6)
+            % elapsed
+            % (elapsed > 0 ? 100.0 * (cpu - last_cpu) / elapsed : 0.0)
+        );
+        for (size_t n = 0; n < stats.size(); n++)
+            json += (n ? "," : "") + stats[n]->take_json(elapsed);
+        json += "}}";
+        *log << json << std::endl;
+
+        last_report = now;
+        last_cpu = cpu;
+        l.lock();
+    }
+}
+
+static void run_soak_benchmark(
+    uhd::usrp::multi_usrp::sptr usrp,
+    const std::vector<size_t>& rx_channel_nums,
+    const std::vector<size_t>& tx_channel_nums,
+    const SOAK_PARAMS& params)
+{
+    boost::thread_group thread_group;
+    std::vector<soak_stats::sptr> stats;
+
+    std::ofstream log_file;
+    if (params.log_file.empty() == false)
+    {
+        log_file.open(params.log_file.c_str(), std::ios::out);
+        if (log_file.is_open() == false)
+            throw std::runtime_error("Cannot open soak log file: " + params.log_file);
+        std::cout << boost::format(HEADER "Writing soak reports to \"%s\"") % params.log_file << std::endl;
+    }
+
+    // Spread the channels over the streamers
+    std::vector<std::vector<size_t> > rx_streamer_chans(std::min(rx_channel_nums.size(), params.num_rx_streamers ? params.num_rx_streamers : rx_channel_nums.size()));
+    for (size_t n = 0; n < rx_channel_nums.size(); n++)
+        rx_streamer_chans[n % rx_streamer_chans.size()].push_back(rx_channel_nums[n]);
+    std::vector<std::vector<size_t> > tx_streamer_chans(std::min(tx_channel_nums.size(), params.num_tx_streamers ? params.num_tx_streamers : tx_channel_nums.size()));
+    for (size_t n = 0; n < tx_channel_nums.size(); n++)
+        tx_streamer_chans[n % tx_streamer_chans.size()].push_back(tx_channel_nums[n]);
+
+    // Create all streamers before any of them starts
+    std::vector<uhd::rx_streamer::sptr> rx_streams;
+    for (size_t n = 0; n < rx_streamer_chans.size(); n++)
+    {
+        uhd::stream_args_t stream_args(params.rx_cpu, params.otw_rx);
+        stream_args.channels = rx_streamer_chans[n];
+        rx_streams.push_back(usrp->get_rx_stream(stream_args));
+        std::cout << boost::format(HEADER_RX"Soak streamer rx%d on %d channel(s)") % n % rx_streamer_chans[n].size() << std::endl;
+    }
+    std::vector<uhd::tx_streamer::sptr> tx_streams;
+    for (size_t n = 0; n < tx_streamer_chans.size(); n++)
+    {
+        uhd::stream_args_t stream_args(params.tx_cpu, params.otw_tx);
+        stream_args.channels = tx_streamer_chans[n];
+        tx_streams.push_back(usrp->get_tx_stream(stream_args));
+        std::cout << boost::format(HEADER_TX"Soak streamer tx%d on %d channel(s)") % n % tx_streamer_chans[n].size() << std::endl;
+    }
+
+    running = true;
+    const uhd::time_spec_t start_time = usrp->get_time_now() + uhd::time_spec_t(params.start_delay);
+
+    for (size_t n = 0; n < rx_streams.size(); n++)
+    {
+        stats.push_back(soak_stats::sptr(new soak_stats(str(boost::format("rx%d") % n))));
+        thread_group.create_thread(boost::bind(&soak_rx_thread,
+            rx_streams[n],
+            params.rx_cpu,
+            params.samps_per_buff ? params.samps_per_buff : rx_streams[n]->get_max_num_samps(),
+            start_time,
+            params.recv_timeout + params.start_delay,
+            stats.back()));
+    }
+    for (size_t n = 0; n < tx_streams.size(); n++)
+    {
+        stats.push_back(soak_stats::sptr(new soak_stats(str(boost::format("tx%d") % n))));
+        thread_group.create_thread(boost::bind(&soak_tx_thread,
+            tx_streams[n],
+            params.tx_cpu,
+            params.samps_per_buff ? params.samps_per_buff : tx_streams[n]->get_max_num_samps(),
+            start_time,
+            params.send_timeout + params.start_delay,
+            stats.back()));
+    }
+    if ((params.reconfig_interval > 0) && (params.reconfig.empty() == false))
+    {
+        stats.push_back(soak_stats::sptr(new soak_stats("reconfig")));
+        thread_group.create_thread(boost::bind(&soak_reconfig_thread,
+            usrp,
+            boost::cref(rx_channel_nums),
+            boost::cref(tx_channel_nums),
+            boost::cref(params),
+            stats.back()));
+    }
+    for (size_t n = 0; n < params.num_ctrl_threads; n++)
+    {
+        stats.push_back(soak_stats::sptr(new soak_stats(str(boost::format("ctrl%d") % n))));
+        thread_group.create_thread(boost::bind(&soak_ctrl_thread,
+            usrp,
+            params.ctrl_interval,
+            stats.back()));
+    }
+    boost::thread report_thread(boost::bind(&soak_report_thread,
+        boost::cref(stats),
+        params.report_interval,
+        (log_file.is_open() ? static_cast<std::ostream*>(&log_file) : &std::cout)));
+
+    std::cout << HEADER << "(" << get_stringified_time() << ") Soaking..." << std::endl;
+    {
+        boost::mutex::scoped_lock l_stop(stop_mutex);
+        if (stop_signal_called == false)
+        {
+            if (params.duration > 0)
+            {
+                std::cout << boost::format(HEADER "Soaking for: %f seconds (host wall clock)") % params.duration << std::endl;
+                abort_event.timed_wait(l_stop, seconds_to_duration(params.duration));
+            }
+            else
+            {
+                std::cout << HEADER "Waiting for CTRL+C..." << std::endl;
+                abort_event.wait(l_stop);
+            }
+        }
+        running = false;
+        abort_event.notify_all();
+    }
+
+    std::cout << HEADER << "(" << get_stringified_time() << ") Stopping..." << std::endl;
+    thread_group.join_all();
+    {
+        // The last report covers the shutdown of the streamers
+        boost::mutex::scoped_lock l_stop(stop_mutex);
+        soak_threads_joined = true;
+        abort_event.notify_all();
+    }
+    report_thread.join();
+}
+
 /***********************************************************************
  * Main code + dispatcher
  **********************************************************************/
@@ -1077,6 +1606,16 @@ int UHD_SAFE_MAIN(int argc, char *argv[]){
     std::string tx_ant, rx_ant;
     std::string tx_subdev, rx_subdev;
     std::string set_time_mode;
+    size_t soak_rx_streamers, soak_tx_streamers;
+    double soak_reconfig_interval;
+    std::string soak_reconfig;
+    std::string soak_rates;
+    double soak_freq_min, soak_freq_max;
+    size_t soak_ctrl_threads;
+    double soak_ctrl_interval;
+    double soak_report_interval;
+    std::string soak_log;
+    unsigned int soak_seed;
 
     //setup the program options
     po::options_description desc("Allowed options");
@@ -1154,6 +1693,19 @@ int UHD_SAFE_MAIN(int argc, char *argv[]){
         ("ignore-bad-packets", "continue receiving after a bad packet")
         ("ignore-timeout", "continue receiving after timeout")
         ("ignore-unexpected", "continue receiving after unexpected error")
+        ("soak", "run the soak benchmark instead of the RX/TX rate tests")
+        ("soak-rx-streamers", po::value<size_t>(&soak_rx_streamers)->default_value(0), "number of RX streamers to spread the RX channels over (0: one per channel)")
+        ("soak-tx-streamers", po::value<size_t>(&soak_tx_streamers)->default_value(0), "number of TX streamers to spread the TX channels over (0: one per channel)")
+        ("soak-reconfig-interval", po::value<double>(&soak_reconfig_interval)->default_value(0.0), "seconds between random reconfigurations while streaming (0 disables)")
+        ("soak-reconfig", po::value<std::string>(&soak_reconfig)->default_value("freq,gain"), "what to reconfigure: any of rate, freq, gain")
+        ("soak-rates", po::value<std::string>(&soak_rates)->default_value(""), "rates to choose from when reconfiguring the rate (sps, comma separated)")
+        ("soak-freq-min", po::value<double>(&soak_freq_min)->default_value(0.0), "lowest frequency when retuning (Hz, 0: channel's range)")
+        ("soak-freq-max", po::value<double>(&soak_freq_max)->default_value(0.0), "highest frequency when retuning (Hz, 0: channel's range)")
+        ("soak-ctrl-threads", po::value<size_t>(&soak_ctrl_threads)->default_value(0), "number of threads generating control traffic")
+        ("soak-ctrl-interval", po::value<double>(&soak_ctrl_interval)->default_value(0.0), "seconds between the transactions of each control thread (0: back to back)")
+        ("soak-report-interval", po::value<double>(&soak_report_interval)->default_value(1.0), "seconds between soak reports")
+        ("soak-log", po::value<std::string>(&soak_log)->default_value(""), "soak report file, one JSON object per line (default: stdout)")
+        ("soak-seed", po::value<unsigned int>(&soak_seed)->default_value(0), "seed of the random reconfigurations (0: time based)")
         // record TX/RX times
         // Optional interruption
         // simulate u / o at random / pulses
@@ -1192,6 +1744,8 @@ int UHD_SAFE_MAIN(int argc, char *argv[]){
         "    Specify --rate to set both RX & TX.\n"
         "    Specify --rx-rate to set custom RX rate.\n"
         "    Specify --tx-rate to set custom TX rate.\n"
+        "    Specify --soak to stream on all selected channels while reconfiguring\n"
+        "        them and generating control traffic, and to log periodic reports.\n"
         << std::endl;
         return ~0;
     }
@@ -1433,6 +1987,46 @@ int UHD_SAFE_MAIN(int argc, char *argv[]){
 
         std::cout << boost::format(HEADER "Time now:  %f seconds (%llu ticks)") % time_start.get_real_secs() % time_start.to_ticks(usrp->get_master_clock_rate()) << std::endl;
 
+        if (vm.count("soak") > 0)
+        {
+            SOAK_PARAMS soak_params;
+            soak_params.rx_cpu = rx_cpu;
+            soak_params.tx_cpu = tx_cpu;
+            soak_params.otw_rx = rx_otw;
+            soak_params.otw_tx = tx_otw;
+            soak_params.num_rx_streamers = soak_rx_streamers;
+            soak_params.num_tx_streamers = soak_tx_streamers;
+            soak_params.samps_per_buff = samps_per_buff;
+            soak_params.start_delay = std::max(std::max(recv_start_delay, send_start_delay), 0.1); // MAGIC
+            soak_params.recv_timeout = recv_timeout;
+            soak_params.send_timeout = send_timeout;
+            soak_params.duration = duration;
+            soak_params.reconfig_interval = soak_reconfig_interval;
+            if (soak_reconfig.empty() == false)
+                boost::split(soak_params.reconfig, soak_reconfig, boost::is_any_of(","));
+            std::vector<std::string> rate_strings;
+            if (soak_rates.empty() == false)
+                boost::split(rate_strings, soak_rates, boost::is_any_of(","));
+            for (size_t n = 0; n < rate_strings.size(); n++)
+                soak_params.rates.push_back(boost::lexical_cast<double>(rate_strings[n]));
+            soak_params.freq_min = soak_freq_min;
+            soak_params.freq_max = soak_freq_max;
+            soak_params.num_ctrl_threads = soak_ctrl_threads;
+            soak_params.ctrl_interval = soak_ctrl_interval;
+            soak_params.report_interval = soak_report_interval;
+            soak_params.log_file = soak_log;
+            soak_params.seed = soak_seed ? soak_seed : (unsigned int)time(NULL);
+            std::cout << boost::format(HEADER "Soak reconfiguration seed: %u") % soak_params.seed << std::endl;
+
+            std::signal(SIGINT, &sig_int_handler);
+            run_soak_benchmark(usrp, rx_channel_nums, tx_channel_nums, soak_params);
+
+            if (interactive)
+                set_nonblock(false);
+            std::cout << std::endl << "Done!" << std::endl;
+            return EXIT_SUCCESS;
+        }
+
         boost::thread_group thread_group;
 
         {
@@ -0,0 +1,502 @@
+//
+// Copyright 2019 Ettus Research, a National Instruments Brand
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+//
+// Streaming CHDR capture analyzer.
+//
+// Unlike chdr_log, which reads the whole capture into memory first, this maps
+// the pcap file and analyzes the packets as they are read, so captures of any
+// size can be processed. Packets are handed to worker threads by their SID, so
+// each flow is analyzed in order by one worker. The statistics of all flows are
+// printed at the end.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <pcap.h>
+#include <netinet/in.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+
+#include "uhd_dump.h"
+
+// pcap file format
+#define PCAP_MAGIC 0xa1b2c3d4
+#define PCAP_MAGIC_NSEC 0xa1b23c4d
+#define PCAP_FILE_HEADER_SIZE 24
+#define PCAP_RECORD_HEADER_SIZE 16
+#define LINKTYPE_ETHERNET 1
+
+#define ETH_TYPE_IP 0x0800
+#define IP_PROTO_UDP 17
+
+// Packets are passed to the workers in batches of this many
+#define BATCH_SIZE 256
+// Number of batches queued per worker
+#define QUEUE_DEPTH 64
+// Maximum number of flows per worker
+#define MAX_FLOWS 4096
+#define MAX_WORKERS 64
+
+/*
+  A packet in the mapped capture file
+*/
+struct packet_desc {
+  const u8 *chdr;           // Start of the CHDR header
+  u32 chdr_len;             // Bytes of CHDR packet captured
+  struct timeval ts;        // Capture time stamp
+};
+
+struct batch {
+  int count;
+  struct packet_desc packets[BATCH_SIZE];
+};
+
+/*
+  Statistics of one flow, a flow being all packets with the same SID
+*/
+struct flow_stats {
+  u32 sid;
+  int in_use;
+  u64 packets;
+  u64 bytes;
+  u64 data_packets;
+  u64 context_packets;
+  u64 eobs;
+  u64 seq_errors;           // Number of gaps in the sequence
+  u64 seq_lost;             // Number of packets missing in those gaps
+  u32 last_seq;
+  u64 timed_packets;
+  u64 time_regressions;     // VITA time stamps which went backwards
+  u64 first_time;
+  u64 last_time;
+  u64 fc_packets;           // Source flow control packets
+  u32 last_fc_seq;
+  u64 tx_responses[6];      // ACK, EOB, underrun, seq error, time error, mid-burst seq error
+  u64 tx_other_errors;
+  struct timeval first_ts;
+  struct timeval last_ts;
+};
+
+/*
+  A worker thread and its queue of batches
+*/
+struct worker {
+  pthread_t thread;
+  pthread_mutex_t mutex;
+  pthread_cond_t not_empty;
+  pthread_cond_t not_full;
+  struct batch *queue;
+  int head;                 // Next batch to analyze
+  int tail;                 // Next batch to fill
+  int done;                 // No more batches will be queued
+  struct flow_stats *flows;
+  int num_flows;
+};
+
+void usage()
+{
+  fprintf(stderr,"Usage: chdr_stats [-j num_workers] [-p udp_port] filename.pcap\n");
+  exit(2);
+}
+
+static u16 read_u16(const u8 *p)
+{
+  u16 x;
+  memcpy(&x,p,sizeof(x));
+  return x;
+}
+
+static u32 read_u32(const u8 *p)
+{
+  u32 x;
+  memcpy(&x,p,sizeof(x));
+  return x;
+}
+
+static u64 read_u64(const u8 *p)
+{
+  u64 x;
+  memcpy(&x,p,sizeof(x));
+  return x;
+}
+
+// Find the stats of a flow, or start new ones.
+static struct flow_stats *get_flow(struct worker *worker, const u32 sid)
+{
+  u32 x;
+  x = (sid * 2654435761u) % MAX_FLOWS;
+
+  // Open addressing with linear probing
+  while (worker->flows[x].in_use) {
+    if (worker->flows[x].sid == sid)
+      return &worker->flows[x];
+    x = (x + 1) % MAX_FLOWS;
+  }
+  if (worker->num_flows == MAX_FLOWS - 1)
+    return NULL;
+  worker->num_flows++;
+  worker->flows[x].in_use = TRUE;
+  worker->flows[x].sid = sid;
+  return &worker->flows[x];
+}
+
+// Update the stats of a flow with the next packet of it.
+static void analyze_packet(struct worker *worker, const struct packet_desc *packet)
+{
+  struct flow_stats *flow;
+  u32 chdr_type, sid, seq, expected, error_code;
+  u8 endpoint;
+  int direction, has_time, is_context, x;
+  const u8 *payload;
+  u64 vita_time;
+
+  chdr_type = swapint(read_u32(packet->chdr));
+  sid = swapint(read_u32(packet->chdr+4));
+
+  if ((flow = get_flow(worker,sid)) == NULL) {
+    fprintf(stderr,"Too many flows, ignoring SID 0x%08x\n",sid);
+    return;
+  }
+
+  seq = (chdr_type >> 16) & 0xFFF;
+  is_context = ((chdr_type & EXT_CONTEXT) == EXT_CONTEXT);
+  has_time = ((chdr_type & HAS_TIME) == HAS_TIME);
+  payload = packet->chdr + CHDR_SIZE + (has_time ? VITA_TIME_SIZE : 0);
+
+  // By convention the host uses SID address 0.x, see get_connection_endpoints()
+  direction = ((sid >> 24) == 0) ? H2U : U2H;
+  endpoint = ((direction == H2U) ? sid : (sid >> 16)) & 0x3;
+
+  if (flow->packets == 0) {
+    flow->first_ts = packet->ts;
+  } else {
+    expected = (flow->last_seq + 1) & 0xFFF;
+    if (seq != expected) {
+      flow->seq_errors++;
+      flow->seq_lost += (seq - expected) & 0xFFF;
+    }
+  }
+  flow->last_seq = seq;
+  flow->last_ts = packet->ts;
+  flow->packets++;
+  flow->bytes += chdr_type & (SIZE);
+
+  if (is_context)
+    flow->context_packets++;
+  else
+    flow->data_packets++;
+  if ((chdr_type & EOB) == EOB)
+    flow->eobs++;
+
+  if (has_time && packet->chdr_len >= CHDR_SIZE + VITA_TIME_SIZE) {
+    vita_time = swaplong(read_u64(packet->chdr+CHDR_SIZE));
+    if (flow->timed_packets == 0)
+      flow->first_time = vita_time;
+    else if (vita_time < flow->last_time)
+      flow->time_regressions++;
+    flow->last_time = vita_time;
+    flow->timed_packets++;
+  }
+
+  if (!is_context || payload + 8 > packet->chdr + packet->chdr_len)
+    return;
+
+  if (endpoint == SRC_FLOW_CTRL && direction == H2U) {
+    flow->fc_packets++;
+    flow->last_fc_seq = swapint(read_u32(payload+4));
+  } else if (endpoint == RADIO && direction == U2H) {
+    // TX Response packet.
+    error_code = swapint(read_u32(payload));
+    switch(error_code)
+      {
+      case TX_ACK: x = 0; break;
+      case TX_EOB: x = 1; break;
+      case TX_UNDERRUN: x = 2; break;
+      case TX_SEQ_ERROR: x = 3; break;
+      case TX_TIME_ERROR: x = 4; break;
+      case TX_MIDBURST_SEQ_ERROR: x = 5; break;
+      default: x = -1;
+      }
+    if (x < 0)
+      flow->tx_other_errors++;
+    else
+      flow->tx_responses[x]++;
+  }
+}
+
+static void *worker_loop(void *arg)
+{
+  struct worker *worker = (struct worker *)arg;
+  struct batch *batch;
+  int x;
+
+  while (1) {
+    pthread_mutex_lock(&worker->mutex);
+    while (worker->head == worker->tail && !worker->done)
+      pthread_cond_wait(&worker->not_empty,&worker->mutex);
+    if (worker->head == worker->tail) {
+      pthread_mutex_unlock(&worker->mutex);
+      break;
+    }
+    batch = &worker->queue[worker->head % QUEUE_DEPTH];
+    pthread_mutex_unlock(&worker->mutex);
+
+    for (x = 0; x < batch->count; x++)
+      analyze_packet(worker,&batch->packets[x]);
+
+    pthread_mutex_lock(&worker->mutex);
+    worker->head++;
+    pthread_cond_signal(&worker->not_full);
+    pthread_mutex_unlock(&worker->mutex);
+  }
+  return NULL;
+}
+
+// The batch the reader fills next. It is owned by the reader until it is queued.
+static struct batch *filling_batch(struct worker *worker)
+{
+  pthread_mutex_lock(&worker->mutex);
+  while (worker->tail - worker->head == QUEUE_DEPTH)
+    pthread_cond_wait(&worker->not_full,&worker->mutex);
+  pthread_mutex_unlock(&worker->mutex);
+  return &worker->queue[worker->tail % QUEUE_DEPTH];
+}
+
+static void queue_batch(struct worker *worker)
+{
+  pthread_mutex_lock(&worker->mutex);
+  worker->tail++;
+  pthread_cond_signal(&worker->not_empty);
+  pthread_mutex_unlock(&worker->mutex);
+}
+
+static void print_flow(const struct flow_stats *flow)
+{
+  double duration;
+  duration = (double)(flow->last_ts.tv_sec - flow->first_ts.tv_sec)
+    + (double)(flow->last_ts.tv_usec - flow->first_ts.tv_usec)/1000000;
+
+  fprintf(stdout,"\nSID %02x.%02x->%02x.%02x\n",
+	  flow->sid>>24,(flow->sid>>16)&0xFF,(flow->sid>>8)&0xFF,flow->sid&0xFF);
+  fprintf(stdout,"  Packets: %lu (%lu data, %lu context, %lu EOB), %lu bytes\n",
+	  flow->packets,flow->data_packets,flow->context_packets,flow->eobs,flow->bytes);
+  if (duration > 0)
+    fprintf(stdout,"  Rate: %.1f packets/s, %.3f MB/s over %f s\n",
+	    (double)flow->packets/duration,(double)flow->bytes/duration/1e6,duration);
+  fprintf(stdout,"  Sequence errors: %lu (%lu packets missing)\n",flow->seq_errors,flow->seq_lost);
+  if (flow->timed_packets)
+    fprintf(stdout,"  Time: %016lx -> %016lx in %lu packets, %lu regressions\n",
+	    flow->first_time,flow->last_time,flow->timed_packets,flow->time_regressions);
+  if (flow->fc_packets)
+    fprintf(stdout,"  Src Flow Ctrl: %lu packets, last SeqID = 0x%04x\n",
+	    flow->fc_packets,flow->last_fc_seq);
+  if (flow->tx_responses[0] || flow->tx_responses[1] || flow->tx_responses[2]
+      || flow->tx_responses[3] || flow->tx_responses[4] || flow->tx_responses[5]
+      || flow->tx_other_errors)
+    fprintf(stdout,"  TX responses: %lu ACK, %lu EOB, %lu Underrun, %lu Sequence Error, "
+	    "%lu Time Error, %lu Mid-Burst Seq Error, %lu Unknown Error\n",
+	    flow->tx_responses[0],flow->tx_responses[1],flow->tx_responses[2],
+	    flow->tx_responses[3],flow->tx_responses[4],flow->tx_responses[5],
+	    flow->tx_other_errors);
+}
+
+static int compare_flows(const void *a, const void *b)
+{
+  const struct flow_stats *x = (const struct flow_stats *)a;
+  const struct flow_stats *y = (const struct flow_stats *)b;
+  return (x->sid > y->sid) - (x->sid < y->sid);
+}
+
+int main(int argc, char *argv[])
+{
+  struct worker workers[MAX_WORKERS];
+  struct batch *batches[MAX_WORKERS];
+  struct flow_stats *all_flows;
+  struct stat file_stat;
+  const u8 *file, *record, *end, *packet;
+  u32 magic, caplen, ts_sec, ts_frac, ip_header_len;
+  int num_workers, swapped, nsec, fd, c, x, y, num_flows;
+  u16 udp_port;
+  u64 total_packets, chdr_packets;
+  struct packet_desc *desc;
+
+  num_workers = 4;
+  udp_port = CHDR_PORT;
+
+  while ((c = getopt(argc, argv, "j:p:")) != -1) {
+    switch(c) {
+    case 'j':
+      num_workers = atoi(optarg);
+      if (num_workers < 1 || num_workers > MAX_WORKERS)
+	usage();
+      break;
+    case 'p':
+      udp_port = (u16)atoi(optarg);
+      break;
+    case'?':
+    default:
+      usage();
+    }
+  }
+
+  if (argc - optind != 1) {
+    usage();
+  }
+
+  // Map the whole capture file, it is read once from start to end.
+  if ((fd = open(argv[optind],O_RDONLY)) < 0 || fstat(fd,&file_stat) < 0) {
+    fprintf(stderr,"Can't open pcap file for reading: %s\n",argv[optind]);
+    exit(2);
+  }
+  if (file_stat.st_size < PCAP_FILE_HEADER_SIZE) {
+    fprintf(stderr,"File is too short to be a pcap file: %s\n",argv[optind]);
+    exit(2);
+  }
+  file = mmap(NULL,file_stat.st_size,PROT_READ,MAP_PRIVATE,fd,0);
+  if (file == MAP_FAILED) {
+    fprintf(stderr,"Can't map pcap file: %s\n",argv[optind]);
+    exit(2);
+  }
+  madvise((void *)file,file_stat.st_size,MADV_SEQUENTIAL);
+  end = file + file_stat.st_size;
+
+  // Parse the pcap file header
+  magic = read_u32(file);
+  swapped = (magic == swapint(PCAP_MAGIC) || magic == swapint(PCAP_MAGIC_NSEC));
+  if (swapped)
+    magic = swapint(magic);
+  if (magic != PCAP_MAGIC && magic != PCAP_MAGIC_NSEC) {
+    fprintf(stderr,"Not a pcap file: %s\n",argv[optind]);
+    exit(2);
+  }
+  nsec = (magic == PCAP_MAGIC_NSEC);
+  x = read_u32(file+20);
+  if ((swapped ? swapint(x) : x) != LINKTYPE_ETHERNET) {
+    fprintf(stderr,"Only Ethernet captures are supported.\n");
+    exit(2);
+  }
+
+  // Start workers
+  for (x = 0; x < num_workers; x++) {
+    pthread_mutex_init(&workers[x].mutex,NULL);
+    pthread_cond_init(&workers[x].not_empty,NULL);
+    pthread_cond_init(&workers[x].not_full,NULL);
+    workers[x].queue = malloc(QUEUE_DEPTH * sizeof(struct batch));
+    workers[x].flows = calloc(MAX_FLOWS,sizeof(struct flow_stats));
+    if (workers[x].queue == NULL || workers[x].flows == NULL) {
+      fprintf(stderr,"Out of memory.\n");
+      exit(2);
+    }
+    workers[x].head = workers[x].tail = 0;
+    workers[x].done = FALSE;
+    workers[x].num_flows = 0;
+    pthread_create(&workers[x].thread,NULL,worker_loop,&workers[x]);
+    batches[x] = filling_batch(&workers[x]);
+    batches[x]->count = 0;
+  }
+
+  // Walk the records, hand every CHDR packet to the worker of its flow.
+  total_packets = chdr_packets = 0;
+  record = file + PCAP_FILE_HEADER_SIZE;
+  while (record + PCAP_RECORD_HEADER_SIZE <= end) {
+    ts_sec = read_u32(record);
+    ts_frac = read_u32(record+4);
+    caplen = read_u32(record+8);
+    if (swapped) {
+      ts_sec = swapint(ts_sec);
+      ts_frac = swapint(ts_frac);
+      caplen = swapint(caplen);
+    }
+    packet = record + PCAP_RECORD_HEADER_SIZE;
+    if (packet + caplen > end) {
+      fprintf(stderr,"Capture file is truncated, stopping after %lu packets.\n",total_packets);
+      break;
+    }
+    record = packet + caplen;
+    total_packets++;
+
+    // Only UDP over IPv4 from or to the CHDR port
+    if (caplen < ETH_SIZE + IP_SIZE + UDP_SIZE + CHDR_SIZE
+	|| ntohs(read_u16(packet+12)) != ETH_TYPE_IP
+	|| packet[ETH_SIZE+9] != IP_PROTO_UDP)
+      continue;
+    ip_header_len = (packet[ETH_SIZE] & 0xF) * 4;
+    if (caplen < ETH_SIZE + ip_header_len + UDP_SIZE + CHDR_SIZE
+	|| (ntohs(read_u16(packet+ETH_SIZE+ip_header_len)) != udp_port
+	    && ntohs(read_u16(packet+ETH_SIZE+ip_header_len+2)) != udp_port))
+      continue;
+    chdr_packets++;
+
+    // Hash the SID to pick the worker
+    y = (swapint(read_u32(packet+ETH_SIZE+ip_header_len+UDP_SIZE+4)) * 2654435761u) % num_workers;
+    desc = &batches[y]->packets[batches[y]->count++];
+    desc->chdr = packet + ETH_SIZE + ip_header_len + UDP_SIZE;
+    desc->chdr_len = caplen - (ETH_SIZE + ip_header_len + UDP_SIZE);
+    desc->ts.tv_sec = ts_sec;
+    desc->ts.tv_usec = nsec ? ts_frac / 1000 : ts_frac;
+
+    if (batches[y]->count == BATCH_SIZE) {
+      queue_batch(&workers[y]);
+      batches[y] = filling_batch(&workers[y]);
+      batches[y]->count = 0;
+    }
+  }
+
+  // Queue the partial batches and wait for the workers
+  for (x = 0; x < num_workers; x++) {
+    if (batches[x]->count)
+      queue_batch(&workers[x]);
+    pthread_mutex_lock(&workers[x].mutex);
+    workers[x].done = TRUE;
+    pthread_cond_signal(&workers[x].not_empty);
+    pthread_mutex_unlock(&workers[x].mutex);
+  }
+  for (x = 0; x < num_workers; x++)
+    pthread_join(workers[x].thread,NULL);
+
+  fprintf(stdout,"\n===================================================================\n");
+  fprintf(stdout,"\n Total packet count in capture file: %lu\n",total_packets);
+  fprintf(stdout,"\n Total CHDR packet count in capture file: %lu\n",chdr_packets);
+  fprintf(stdout,"\n===================================================================\n");
+
+  // Merge and sort the flows of all workers
+  num_flows = 0;
+  for (x = 0; x < num_workers; x++)
+    num_flows += workers[x].num_flows;
+  all_flows = malloc((num_flows + 1) * sizeof(struct flow_stats));
+  num_flows = 0;
+  for (x = 0; x < num_workers; x++)
+    for (y = 0; y < MAX_FLOWS; y++)
+      if (workers[x].flows[y].in_use)
+	all_flows[num_flows++] = workers[x].flows[y];
+  qsort(all_flows,num_flows,sizeof(struct flow_stats),compare_flows);
+
+  for (x = 0; x < num_flows; x++)
+    print_flow(&all_flows[x]);
+  fprintf(stdout,"\n");
+
+  munmap((void *)file,file_stat.st_size);
+  close(fd);
+  // Normal Exit
+  return(0);
+}